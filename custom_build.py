@@ -23,6 +23,10 @@ dummy_ext_path.write_text(
     "PyMODINIT_FUNC PyInit_so(void) { return PyModule_Create(&moduledef); }\n"
 )
 
+# Link the in-tree plugins into the `libbabeltrace2` library instead
+# of shipping them as separate shared objects.
+library_built_in_plugins = os.environ.get("BABELTRACE_LIBRARY_BUILT_IN_PLUGINS") == "1"
+
 win_msys_prefix = r"c:\msys64\msys2_shell.cmd -defterm -no-start -ucrt64 -where . -c"
 
 env = None
@@ -66,6 +70,9 @@ def bt_build(src_dir, build_dir):
     cmd = f"{configure_path} --prefix {prepare_path(build_dir)} "
     cmd += "--disable-debug-info --enable-python-bindings --disable-man-pages"
 
+    if library_built_in_plugins:
+        cmd += " --enable-library-built-in-plugins"
+
     if sys.platform == "win32":
         python_path = prepare_path(Path(sys.executable))
         py_include = sysconfig.get_path("include").replace("\\", "/")
@@ -113,6 +120,10 @@ def bt_patch_lib(path):
 
 def bt_get_plugin_paths(build_dir):
     paths: list[Path] = []
+
+    if library_built_in_plugins:
+        return paths
+
     ext = ".dll" if sys.platform == "win32" else ".so"
     for plugin in ["ctf", "text", "utils"]:
         paths.append(
@@ -15,6 +15,7 @@ extern "C" {
 
 struct bt_ctf_stream;
 struct bt_ctf_event;
+struct bt_ctf_event_class;
 
 /*
  * bt_ctf_stream_get_discarded_events_count: get the number of discarded
@@ -64,6 +65,67 @@ extern void bt_ctf_stream_append_discarded_events(struct bt_ctf_stream *stream,
 extern int bt_ctf_stream_append_event(struct bt_ctf_stream *stream,
 		struct bt_ctf_event *event);
 
+/*
+ * bt_ctf_stream_append_event_with_payload: append an event to the stream
+ * from payload member values.
+ *
+ * Append an event of class "event_class" to the stream's current packet,
+ * setting the members of its payload field, in order, to the variable
+ * arguments which follow "event_class":
+ *
+ * * Unsigned integer or enumeration (unsigned container): uint64_t.
+ * * Signed integer or enumeration (signed container): int64_t.
+ * * Floating point number: double.
+ * * String: const char *.
+ *
+ * The event header is automatically populated like with
+ * bt_ctf_stream_append_event(). Neither the stream class nor
+ * "event_class" may have a context field type, and each member of the
+ * payload field type must be one of the types above.
+ *
+ * Unlike bt_ctf_stream_append_event(), this function reuses the events
+ * of previously flushed packets instead of creating a new event object
+ * each time, which makes it suitable to write many events with little
+ * overhead.
+ *
+ * @param stream Stream instance.
+ * @param event_class Class of the event to append (part of the stream's
+ *	class).
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_stream_append_event_with_payload(
+		struct bt_ctf_stream *stream,
+		struct bt_ctf_event_class *event_class, ...);
+
+/*
+ * bt_ctf_stream_borrow_thread_stream: borrow the calling thread's
+ * sub-stream of a stream.
+ *
+ * Return the sub-stream of "stream" which belongs to the calling
+ * thread, creating it on the first call from this thread. A sub-stream
+ * has the same class as "stream", its own ID and its own stream file,
+ * and is named after "stream" with a "-N" suffix.
+ *
+ * Different threads may concurrently call
+ * bt_ctf_stream_append_event_with_payload(),
+ * bt_ctf_stream_append_discarded_events() and bt_ctf_stream_flush() on
+ * their own sub-streams without any synchronization, all the
+ * sub-streams sharing the trace's single metadata file. Any other use
+ * of the CTF writer objects from more than one thread at a time
+ * requires external synchronization.
+ *
+ * Call this function once per thread and keep the returned sub-stream:
+ * it takes a writer-wide lock.
+ *
+ * @param stream Stream instance.
+ *
+ * Returns a sub-stream instance (borrowed reference, valid as long as
+ * the trace exists) on success, NULL on error.
+ */
+extern struct bt_ctf_stream *bt_ctf_stream_borrow_thread_stream(
+		struct bt_ctf_stream *stream);
+
 /*
  * bt_ctf_stream_get_packet_header: get a stream's packet header.
  *
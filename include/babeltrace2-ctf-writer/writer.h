@@ -145,6 +145,86 @@ extern void bt_ctf_writer_flush_metadata(struct bt_ctf_writer *writer);
 extern int bt_ctf_writer_set_byte_order(struct bt_ctf_writer *writer,
 		enum bt_ctf_byte_order byte_order);
 
+/*
+ * What bt_ctf_stream_flush() does when the background flushing queue
+ * of the writer is full (see bt_ctf_writer_set_background_flush()).
+ */
+enum bt_ctf_writer_flush_queue_full_policy {
+	/* Wait until the queue has enough room for the packet */
+	BT_CTF_WRITER_FLUSH_QUEUE_FULL_POLICY_BLOCK = 0,
+
+	/*
+	 * Drop the packet, adding its events to the stream's discarded
+	 * events count (see bt_ctf_stream_get_discarded_events_count()).
+	 */
+	BT_CTF_WRITER_FLUSH_QUEUE_FULL_POLICY_DROP = 1,
+};
+
+/*
+ * bt_ctf_writer_set_background_flush: make the writer's streams write
+ * their packets on a background thread.
+ *
+ * Once this is set, bt_ctf_stream_flush() serializes the stream's
+ * current packet to memory and queues it instead of writing it to the
+ * stream file itself: a background thread of the writer writes the
+ * queued packets. The queue holds at most "max_queued_bytes" bytes of
+ * packets (except that a single larger packet is always accepted);
+ * "full_policy" indicates what bt_ctf_stream_flush() does when it's
+ * full.
+ *
+ * Because the stream file is written later, bt_ctf_stream_flush() may
+ * report the write error of a previous packet.
+ *
+ * This must be called before creating any stream.
+ *
+ * @param writer Writer instance.
+ * @param max_queued_bytes Maximum size (bytes) of the queued packets.
+ * @param full_policy What to do when the queue is full.
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_writer_set_background_flush(struct bt_ctf_writer *writer,
+		uint64_t max_queued_bytes,
+		enum bt_ctf_writer_flush_queue_full_policy full_policy);
+
+/*
+ * bt_ctf_writer_set_ctf_version: set the CTF version of the trace's
+ * metadata.
+ *
+ * With "major_version" 2, the metadata file and
+ * bt_ctf_writer_get_metadata_string() contain a CTF 2 JSON text
+ * sequence instead of TSDL. Defaults to 1.
+ *
+ * This must be called before creating any stream.
+ *
+ * @param writer Writer instance.
+ * @param major_version Major version of CTF (1 or 2).
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_writer_set_ctf_version(struct bt_ctf_writer *writer,
+		unsigned int major_version);
+
+/*
+ * bt_ctf_writer_set_write_index: set whether or not the writer's
+ * streams write index files.
+ *
+ * When enabled, which is the default, each stream of which the packet
+ * context has the "timestamp_begin", "timestamp_end" and "packet_size"
+ * fields writes an LTTng-compatible index file (one entry per packet)
+ * in the "index" directory of the trace, so that a reader doesn't
+ * need to index the stream file itself.
+ *
+ * This must be called before creating any stream.
+ *
+ * @param writer Writer instance.
+ * @param write_index BT_CTF_TRUE to write index files.
+ *
+ * Returns 0 on success, a negative value on error.
+ */
+extern int bt_ctf_writer_set_write_index(struct bt_ctf_writer *writer,
+		bt_ctf_bool write_index);
+
 /*
  * bt_ctf_writer_get and bt_ctf_writer_put: increment and decrement the
  * writer's reference count.
@@ -79,6 +79,7 @@
 #include <babeltrace2/trace-ir/event.h>
 #include <babeltrace2/trace-ir/field-class.h>
 #include <babeltrace2/trace-ir/field-location.h>
+#include <babeltrace2/trace-ir/field-path-handle.h>
 #include <babeltrace2/trace-ir/field-path.h>
 #include <babeltrace2/trace-ir/field.h>
 #include <babeltrace2/trace-ir/packet.h>
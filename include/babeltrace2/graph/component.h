@@ -383,6 +383,84 @@ extern bt_logging_level bt_component_get_logging_level(
 
 /*! @} */
 
+/*!
+@name Statistics
+@{
+*/
+
+/*!
+@brief
+    Returns the statistics of the component \bt_p{component}.
+
+Those statistics are only accumulated when you call
+bt_graph_enable_statistics() with the trace processing graph of
+\bt_p{component}; they're all 0 otherwise.
+
+For a \bt_src_comp or a \bt_flt_comp, the statistics cover the
+"next" method calls of all its \bt_p_msg_iter. For a \bt_sink_comp,
+they cover its "consume" method calls.
+
+The inclusive duration of a call is the whole time spent in it, while
+its exclusive duration doesn't count the time spent in the calls which
+it made to the "next" methods of upstream message iterators.
+
+@param[in] component
+    Component of which to get the statistics.
+@param[out] call_count
+    <strong>On success</strong>, \bt_p{*call_count} is the number of
+    "next" or "consume" method calls of \bt_p{component}.
+@param[out] message_count
+    <strong>On success</strong>, \bt_p{*message_count} is the total
+    number of messages which the message iterators of \bt_p{component}
+    returned (always 0 for a sink component).
+@param[out] inclusive_duration_ns
+    <strong>On success</strong>, \bt_p{*inclusive_duration_ns} is the
+    total inclusive duration (ns) of the calls.
+@param[out] exclusive_duration_ns
+    <strong>On success</strong>, \bt_p{*exclusive_duration_ns} is the
+    total exclusive duration (ns) of the calls.
+
+@bt_pre_not_null{component}
+@bt_pre_not_null{call_count}
+@bt_pre_not_null{message_count}
+@bt_pre_not_null{inclusive_duration_ns}
+@bt_pre_not_null{exclusive_duration_ns}
+
+@sa bt_graph_enable_statistics() &mdash;
+    Makes a trace processing graph accumulate the statistics of its
+    components.
+*/
+extern void bt_component_get_statistics(const bt_component *component,
+		uint64_t *call_count, uint64_t *message_count,
+		uint64_t *inclusive_duration_ns,
+		uint64_t *exclusive_duration_ns) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the current and peak memory usage which the component
+    \bt_p{component} reported with bt_self_component_add_memory_usage().
+
+@param[in] component
+    Component of which to get the memory usage.
+@param[out] usage
+    <strong>On success</strong>, \bt_p{*usage} is the current memory
+    usage (bytes) of \bt_p{component}.
+@param[out] peak_usage
+    <strong>On success</strong>, \bt_p{*peak_usage} is the peak memory
+    usage (bytes) of \bt_p{component}.
+
+@bt_pre_not_null{component}
+@bt_pre_not_null{usage}
+@bt_pre_not_null{peak_usage}
+
+@sa bt_graph_get_memory_usage() &mdash;
+    Returns the total memory usage of a trace processing graph.
+*/
+extern void bt_component_get_memory_usage(const bt_component *component,
+		uint64_t *usage, uint64_t *peak_usage) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Common reference count
 @{
@@ -1477,6 +1477,68 @@ and what you can and cannot do with a configured graph.
 */
 extern bt_graph_run_once_status bt_graph_run_once(bt_graph *graph) __BT_NOEXCEPT;
 
+/*!
+@brief
+    Status codes for bt_graph_wait().
+*/
+typedef enum bt_graph_wait_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_GRAPH_WAIT_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Other error.
+	*/
+	BT_GRAPH_WAIT_STATUS_ERROR	= __BT_FUNC_STATUS_ERROR,
+} bt_graph_wait_status;
+
+/*!
+@brief
+    Waits until any wait file descriptor of the \bt_p_comp of the
+    trace processing graph \bt_p{graph} is ready for reading, or for
+    at most \bt_p{timeout_us}&nbsp;µs.
+
+Call this function when bt_graph_run() or bt_graph_run_once()
+returns "try again" instead of sleeping for a fixed duration: a
+component which can only make progress once a file descriptor is
+readable (a socket or an inotify instance, for example) registers it
+with bt_self_component_add_wait_fd(), so that this function returns
+as soon as there's something to read.
+
+Without any wait file descriptor, this function sleeps for
+\bt_p{timeout_us}&nbsp;µs. This function also returns early when the
+current thread receives a signal, for example the one which makes
+a signal handler set an \bt_intr of \bt_p{graph}.
+
+This function returns immediately if \bt_p{graph} is interrupted
+(see bt_graph_borrow_default_interrupter() and
+bt_graph_add_interrupter()). Setting an interrupter from another
+thread doesn't make this function return before the timeout.
+
+@param[in] graph
+    Trace processing graph of which to wait for the components.
+@param[in] timeout_us
+    Maximum duration (µs) to wait.
+
+@retval #BT_GRAPH_WAIT_STATUS_OK
+    Success: any wait file descriptor is ready, the timeout expired,
+    the current thread received a signal, or \bt_p{graph} is
+    interrupted.
+@retval #BT_GRAPH_WAIT_STATUS_ERROR
+    Other error.
+
+@bt_pre_not_null{graph}
+@bt_pre_graph_not_faulty{graph}
+
+@sa bt_self_component_add_wait_fd() &mdash;
+    Adds a wait file descriptor to a component.
+*/
+extern bt_graph_wait_status bt_graph_wait(bt_graph *graph,
+		uint64_t timeout_us) __BT_NOEXCEPT;
+
 /*! @} */
 
 /*!
@@ -1576,6 +1638,176 @@ extern bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 
 /*! @} */
 
+/*!
+@name Message batch size
+@{
+*/
+
+/*!
+@brief
+    Sets the message batch size of the trace processing graph
+    \bt_p{graph} to \bt_p{batch_size}.
+
+The message batch size of a graph is the capacity of the message array
+which a \bt_msg_iter of this graph passes to the
+\link api-msg-iter-cls-meth-next "next" method\endlink of its class.
+
+A larger batch size makes each message iterator call its "next" method
+less often, reducing the per-call overhead of high-throughput graphs,
+at the cost of more messages being in flight at once.
+
+The default message batch size of a graph is 15.
+
+@param[in] graph
+    Trace processing graph of which to set the message batch size.
+@param[in] batch_size
+    New message batch size of \bt_p{graph}.
+
+@bt_pre_not_null{graph}
+@bt_pre_graph_not_configured{graph}
+@pre
+    \bt_p{batch_size} is greater than 0.
+
+@sa bt_graph_get_message_batch_size() &mdash;
+    Returns the message batch size of a trace processing graph.
+*/
+extern void bt_graph_set_message_batch_size(bt_graph *graph,
+		uint64_t batch_size) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the message batch size of the trace processing graph
+    \bt_p{graph}.
+
+See bt_graph_set_message_batch_size().
+
+@param[in] graph
+    Trace processing graph of which to get the message batch size.
+
+@returns
+    Message batch size of \bt_p{graph}.
+
+@bt_pre_not_null{graph}
+
+@sa bt_graph_set_message_batch_size() &mdash;
+    Sets the message batch size of a trace processing graph.
+*/
+extern uint64_t bt_graph_get_message_batch_size(const bt_graph *graph)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Statistics
+@{
+*/
+
+/*!
+@brief
+    Makes the trace processing graph \bt_p{graph} accumulate the
+    statistics of its \bt_p_comp.
+
+Once you call this function, \bt_p{graph} measures each call to the
+"next" method of a \bt_msg_iter and to the "consume" method of a
+\bt_sink_comp, accumulating the results into the statistics of the
+corresponding component.
+
+Get the statistics of a component with bt_component_get_statistics().
+
+Measuring a call costs two reads of a monotonic clock: \bt_p{graph}
+doesn't accumulate any statistics by default.
+
+@param[in] graph
+    Trace processing graph of which to accumulate the component
+    statistics.
+
+@bt_pre_not_null{graph}
+@bt_pre_graph_not_configured{graph}
+
+@sa bt_component_get_statistics() &mdash;
+    Returns the statistics of a component.
+*/
+extern void bt_graph_enable_statistics(bt_graph *graph) __BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Memory budget
+@{
+*/
+
+/*!
+@brief
+    Sets the memory budget of the trace processing graph \bt_p{graph}
+    to \bt_p{budget} bytes.
+
+The \bt_p_comp of \bt_p{graph} report their memory usage with
+bt_self_component_add_memory_usage(), and may compare the total memory
+usage of \bt_p{graph} to its budget to adapt (see
+bt_self_component_get_graph_memory_budget()).
+
+The budget is advisory: the library never refuses an allocation.
+
+You may call this function at any time.
+
+@param[in] graph
+    Trace processing graph of which to set the memory budget.
+@param[in] budget
+    New memory budget of \bt_p{graph} (bytes), or 0 for no budget.
+
+@bt_pre_not_null{graph}
+
+@sa bt_graph_get_memory_budget() &mdash;
+    Returns the memory budget of a graph.
+*/
+extern void bt_graph_set_memory_budget(bt_graph *graph,
+		uint64_t budget) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the memory budget (bytes) of the trace processing graph
+    \bt_p{graph}, or 0 if it has none.
+
+@param[in] graph
+    Trace processing graph of which to get the memory budget.
+
+@returns
+    Memory budget of \bt_p{graph}, or 0 if none.
+
+@bt_pre_not_null{graph}
+
+@sa bt_graph_set_memory_budget() &mdash;
+    Sets the memory budget of a graph.
+*/
+extern uint64_t bt_graph_get_memory_budget(const bt_graph *graph)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the current and peak total memory usage which the
+    \bt_p_comp of the trace processing graph \bt_p{graph} reported.
+
+@param[in] graph
+    Trace processing graph of which to get the memory usage.
+@param[out] usage
+    <strong>On success</strong>, \bt_p{*usage} is the current total
+    memory usage (bytes) of \bt_p{graph}.
+@param[out] peak_usage
+    <strong>On success</strong>, \bt_p{*peak_usage} is the peak total
+    memory usage (bytes) of \bt_p{graph}.
+
+@bt_pre_not_null{graph}
+@bt_pre_not_null{usage}
+@bt_pre_not_null{peak_usage}
+
+@sa bt_component_get_memory_usage() &mdash;
+    Returns the memory usage of a component.
+*/
+extern void bt_graph_get_memory_usage(const bt_graph *graph,
+		uint64_t *usage, uint64_t *peak_usage) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Listeners
 @{
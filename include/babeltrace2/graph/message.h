@@ -3059,6 +3059,34 @@ extern void bt_message_get_ref(const bt_message *message) __BT_NOEXCEPT;
 */
 extern void bt_message_put_ref(const bt_message *message) __BT_NOEXCEPT;
 
+/*!
+@brief
+    Decrements the \ref api-fund-shared-object "reference count" of
+    each of the \bt_p{count} messages of the array \bt_p{messages}.
+
+This function is equivalent to calling bt_message_put_ref() for each
+message of \bt_p{messages}, but with a single library call. Use it to
+release a whole message batch, for example the one which
+bt_message_iterator_next() returns.
+
+@param[in] messages
+    @parblock
+    Array of messages of which to decrement the reference count.
+
+    Any message of \bt_p{messages} can be \c NULL.
+    @endparblock
+@param[in] count
+    Number of messages in \bt_p{messages}.
+
+@pre
+    \bt_p{messages} is not \c NULL, unless \bt_p{count} is 0.
+
+@sa bt_message_put_ref() &mdash;
+    Decrements the reference count of a message.
+*/
+extern void bt_message_put_refs(const bt_message * const *messages,
+		uint64_t count) __BT_NOEXCEPT;
+
 /*!
 @brief
     Decrements the reference count of the message \bt_p{_message}, and
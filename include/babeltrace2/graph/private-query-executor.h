@@ -35,11 +35,35 @@ from within a \bt_comp_cls
 A query method receives a private query executor as its
 \bt_p{query_executor} parameter.
 
-As of \bt_name_version_min_maj, this API only offers the
+This API offers the
 bt_private_query_executor_as_query_executor_const() function to
 \ref api-fund-c-typing "upcast" a private query executor to a
 \c const query executor. You need this to get the
 \ref api-qexec-prop-log-lvl "logging level" of the query executor.
+
+<h1>Query stash</h1>
+
+A query method often builds expensive intermediate state to compute
+its result (for example, parsed metadata or indexes of the files of a
+trace), and then the user creates a \bt_comp from the same component
+class and with equivalent parameters, which builds the same state
+again.
+
+To avoid this, the query method may give such state to the
+component class of the query executor with
+bt_private_query_executor_stash(), keyed by a \bt_val of its choice,
+typically a normalized subset of its parameters. The
+\ref api-comp-cls-dev-meth-init "initialization method" of a
+component of the same class then takes the state back with
+bt_self_component_take_query_stash() and the same key.
+
+Using the query stash is opt-in: the library never stashes anything
+by itself.
+
+The component class keeps a bounded number of stashed states: when
+it's full, stashing a new state destroys the oldest one. The
+component class also destroys the remaining stashed states when it's
+destroyed.
 */
 
 /*! @{ */
@@ -86,6 +110,95 @@ bt_private_query_executor_as_query_executor_const(
 
 /*! @} */
 
+/*!
+@name Query stash
+@{
+*/
+
+/*!
+@brief
+    User function which destroys the stashed state \bt_p{data}.
+
+@param[in] data
+    Stashed state to destroy.
+
+@sa bt_private_query_executor_stash() &mdash;
+    Stashes a state for a future component.
+*/
+typedef void (*bt_private_query_executor_stash_destroy_func)(void *data);
+
+/*!
+@brief
+    Status codes for bt_private_query_executor_stash().
+*/
+typedef enum bt_private_query_executor_stash_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_PRIVATE_QUERY_EXECUTOR_STASH_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_PRIVATE_QUERY_EXECUTOR_STASH_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_private_query_executor_stash_status;
+
+/*!
+@brief
+    Stashes the state \bt_p{data}, keyed by \bt_p{key}, within the
+    \bt_comp_cls of the query executor \bt_p{query_executor}.
+
+The \ref api-comp-cls-dev-meth-init "initialization method" of a
+future \bt_comp of the same class may take \bt_p{data} back with
+bt_self_component_take_query_stash() and a key equal to \bt_p{key}
+(see bt_value_is_equal()).
+
+This function copies \bt_p{key}.
+
+If the component class already has a stashed state with a key equal
+to \bt_p{key}, then this function destroys it first.
+
+The library calls \bt_p{destroy_func} with \bt_p{data} if it destroys
+\bt_p{data} before any component takes it: when it evicts it to make
+room for a newer stashed state, and when it destroys the component
+class.
+
+On error, this function doesn't take the ownership of \bt_p{data}.
+
+@param[in] query_executor
+    Private query executor of which to stash a state within the
+    component class.
+@param[in] key
+    Key of \bt_p{data}.
+@param[in] data
+    State to stash.
+@param[in] destroy_func
+    Function which destroys \bt_p{data}.
+
+@retval #BT_PRIVATE_QUERY_EXECUTOR_STASH_STATUS_OK
+    Success.
+@retval #BT_PRIVATE_QUERY_EXECUTOR_STASH_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{query_executor}
+@bt_pre_not_null{key}
+@bt_pre_not_null{data}
+@bt_pre_not_null{destroy_func}
+
+@sa bt_self_component_take_query_stash() &mdash;
+    Takes a stashed state.
+*/
+extern bt_private_query_executor_stash_status
+bt_private_query_executor_stash(
+		bt_private_query_executor *query_executor,
+		const bt_value *key, void *data,
+		bt_private_query_executor_stash_destroy_func destroy_func)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
 /*! @} */
 
 #ifdef __cplusplus
@@ -655,6 +655,231 @@ uint64_t bt_self_component_get_graph_mip_version(
 
 /*! @} */
 
+/*!
+@name Wait file descriptors
+@{
+*/
+
+/*!
+@brief
+    Status codes for bt_self_component_add_wait_fd().
+*/
+typedef enum bt_self_component_add_wait_fd_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_OK			= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_self_component_add_wait_fd_status;
+
+/*!
+@brief
+    Adds the file descriptor \bt_p{fd} to the wait file descriptors of
+    the trace processing \bt_graph which contains the \bt_comp
+    \bt_p{self_component}.
+
+bt_graph_wait() returns as soon as any wait file descriptor of the
+graph is ready for reading. Add a file descriptor of which the
+readiness makes a \bt_msg_iter of \bt_p{self_component} able to
+make progress after it returns "try again".
+
+Remove \bt_p{fd} with bt_self_component_remove_wait_fd() before
+closing it.
+
+@param[in] self_component
+    Component instance.
+@param[in] fd
+    File descriptor to add.
+
+@retval #BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_OK
+    Success.
+@retval #BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{self_component}
+@pre
+    \bt_p{fd} is greater than or equal to 0.
+
+@sa bt_self_component_remove_wait_fd() &mdash;
+    Removes a wait file descriptor from a component.
+@sa bt_graph_wait() &mdash;
+    Waits for the wait file descriptors of a graph.
+*/
+extern bt_self_component_add_wait_fd_status bt_self_component_add_wait_fd(
+		bt_self_component *self_component, int fd) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Removes the file descriptor \bt_p{fd}, which you added with
+    bt_self_component_add_wait_fd(), from the wait file descriptors of
+    the trace processing \bt_graph which contains the \bt_comp
+    \bt_p{self_component}.
+
+@param[in] self_component
+    Component instance.
+@param[in] fd
+    File descriptor to remove.
+
+@bt_pre_not_null{self_component}
+@pre
+    \bt_p{fd} is a wait file descriptor which you added with
+    bt_self_component_add_wait_fd().
+
+@sa bt_self_component_add_wait_fd() &mdash;
+    Adds a wait file descriptor to a component.
+*/
+extern void bt_self_component_remove_wait_fd(
+		bt_self_component *self_component, int fd) __BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Memory accounting
+@{
+*/
+
+/*!
+@brief
+    Adds \bt_p{delta} bytes to the memory usage of the \bt_comp
+    \bt_p{self_component}.
+
+A component reports the memory which it owns and of which the size
+depends on its input (caches, queued messages, buffers, mapped
+regions, and the rest) with this function so that the user of its
+trace processing \bt_graph knows where the memory goes: report an
+allocation with a positive \bt_p{delta}, and its release with a
+negative \bt_p{delta}.
+
+Get the memory usage of a component with
+bt_component_get_memory_usage(), and the total memory usage of a
+graph with bt_graph_get_memory_usage().
+
+Reporting is cheap, but not free: report when a significant amount of
+memory changes hands rather than on each small allocation.
+
+You may call this function from any thread, as well as from the
+finalization method of \bt_p{self_component}.
+
+@param[in] self_component
+    Component instance.
+@param[in] delta
+    Number of bytes to add to the memory usage of
+    \bt_p{self_component} (negative to remove bytes).
+
+@bt_pre_not_null{self_component}
+@pre
+    The memory usage of \bt_p{self_component} plus \bt_p{delta} is
+    greater than or equal to 0.
+
+@sa bt_self_component_get_graph_memory_budget() &mdash;
+    Returns the memory budget of the graph of a component.
+*/
+extern void bt_self_component_add_memory_usage(
+		bt_self_component *self_component, int64_t delta) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the memory budget (bytes) of the trace processing \bt_graph
+    which contains the \bt_comp \bt_p{self_component}, or 0 if it has
+    none.
+
+When the total memory usage of the graph, which
+bt_self_component_get_graph_memory_usage() returns, exceeds its
+budget, a component should adapt, for example by shrinking its
+caches, by writing its buffers sooner, or by making its message
+iterators return "try again" instead of reading ahead.
+
+The budget is advisory: the library never refuses an allocation.
+
+You may call this function from any thread.
+
+@param[in] self_component
+    Component instance.
+
+@returns
+    Memory budget of the graph of \bt_p{self_component}, or 0 if
+    none.
+
+@bt_pre_not_null{self_component}
+
+@sa bt_graph_set_memory_budget() &mdash;
+    Sets the memory budget of a graph.
+*/
+extern uint64_t bt_self_component_get_graph_memory_budget(
+		const bt_self_component *self_component) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the current total memory usage (bytes) which the
+    \bt_p_comp of the trace processing \bt_graph which contains the
+    \bt_comp \bt_p{self_component} reported.
+
+You may call this function from any thread.
+
+@param[in] self_component
+    Component instance.
+
+@returns
+    Total memory usage of the graph of \bt_p{self_component}.
+
+@bt_pre_not_null{self_component}
+
+@sa bt_self_component_add_memory_usage() &mdash;
+    Adds to the memory usage of a component.
+*/
+extern uint64_t bt_self_component_get_graph_memory_usage(
+		const bt_self_component *self_component) __BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Query stash
+@{
+*/
+
+/*!
+@brief
+    Takes the state which a query method of the \bt_comp_cls of the
+    \bt_comp \bt_p{self_component} stashed with the key \bt_p{key}
+    (see bt_private_query_executor_stash()), or returns \c NULL if
+    there's none.
+
+The keys are equal as per bt_value_is_equal().
+
+On success, the ownership of the returned state belongs to the
+caller: the library removes it from the component class and won't
+destroy it.
+
+Only call this function from the
+\ref api-comp-cls-dev-meth-init "initialization method" of
+\bt_p{self_component}.
+
+@param[in] self_component
+    Component instance.
+@param[in] key
+    Key of the stashed state to take.
+
+@returns
+    Stashed state having the key \bt_p{key}, or \c NULL if none.
+
+@bt_pre_not_null{self_component}
+@bt_pre_not_null{key}
+
+@sa bt_private_query_executor_stash() &mdash;
+    Stashes a state for a future component.
+*/
+extern void *bt_self_component_take_query_stash(
+		bt_self_component *self_component,
+		const bt_value *key) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Interruption query of a sink component
 @{
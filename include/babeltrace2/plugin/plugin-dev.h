@@ -349,6 +349,20 @@ any other <code>BT_PLUGIN*()</code> macro.
 	_BT_HIDDEN extern struct __bt_plugin_component_class_descriptor_attribute const *__BT_PLUGIN_COMPONENT_CLASS_DESCRIPTOR_ATTRIBUTES_BEGIN_SYMBOL __BT_PLUGIN_COMPONENT_CLASS_DESCRIPTOR_ATTRIBUTES_BEGIN_EXTRA; \
 	_BT_HIDDEN extern struct __bt_plugin_component_class_descriptor_attribute const *__BT_PLUGIN_COMPONENT_CLASS_DESCRIPTOR_ATTRIBUTES_END_SYMBOL __BT_PLUGIN_COMPONENT_CLASS_DESCRIPTOR_ATTRIBUTES_END_EXTRA; \
 	\
+	__BT_PLUGIN_MODULE_SECTION_ACCESSORS
+
+/*
+ * Defines the functions which return the beginning and end of the
+ * plugin sections (internal use).
+ *
+ * A plugin which is linked into the library itself (see the
+ * `--enable-library-built-in-plugins` configuration option) doesn't
+ * define them: the library defines them once for all its sections.
+ */
+#ifdef __BT_PLUGIN_IN_LIBBABELTRACE2
+# define __BT_PLUGIN_MODULE_SECTION_ACCESSORS
+#else
+# define __BT_PLUGIN_MODULE_SECTION_ACCESSORS \
 	_BT_EXPORT struct __bt_plugin_descriptor const * const *__bt_get_begin_section_plugin_descriptors(void) \
 	{ \
 		return &__BT_PLUGIN_DESCRIPTOR_BEGIN_SYMBOL; \
@@ -381,6 +395,7 @@ any other <code>BT_PLUGIN*()</code> macro.
 	{ \
 		return &__BT_PLUGIN_COMPONENT_CLASS_DESCRIPTOR_ATTRIBUTES_END_SYMBOL; \
 	}
+#endif
 
 /*! @} */
 
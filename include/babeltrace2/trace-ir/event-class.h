@@ -940,8 +940,11 @@ See the \ref api-tir-ev-cls-prop-p-fc "payload field class" property.
 @bt_pre_not_null{field_class}
 @bt_pre_is_struct_fc{field_class}
 @pre
-    \bt_p{field_class}, or any of its contained field classes,
-    isn't already part of a \bt_stream_cls or of an event class.
+    \bt_p{field_class}, or any of its contained field classes, isn't
+    already part of a \bt_stream_cls or of an event class, unless
+    \bt_p{field_class} already is the specific context field class of
+    another event class and bt_field_class_is_shareable() returns
+    #BT_TRUE for it.
 @pre
     If any of the field classes recursively contained in
     \bt_p{field_class} has a
@@ -1020,8 +1023,11 @@ property.
 @bt_pre_not_null{field_class}
 @bt_pre_is_struct_fc{field_class}
 @pre
-    \bt_p{field_class}, or any of its contained field classes,
-    isn't already part of a \bt_stream_cls or of an event class.
+    \bt_p{field_class}, or any of its contained field classes, isn't
+    already part of a \bt_stream_cls or of an event class, unless
+    \bt_p{field_class} already is the payload field class of another
+    event class and bt_field_class_is_shareable() returns #BT_TRUE for
+    it.
 @pre
     If any of the field classes recursively contained in
     \bt_p{field_class} has a
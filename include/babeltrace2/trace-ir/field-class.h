@@ -940,6 +940,11 @@ A structure field class has the following specific property:
     bt_field_class_structure_borrow_member_by_index_const(), and
     bt_field_class_structure_borrow_member_by_name_const().
 
+    Get the index of a member from its name once with
+    bt_field_class_structure_get_member_index_by_name() to
+    borrow the corresponding member fields of many structure fields
+    by index afterwards.
+
     A structure field class member is a
     \ref api-fund-unique-object "unique object": it
     belongs to the structure field class which contains it.
@@ -2126,6 +2131,48 @@ extern uint64_t bt_field_class_get_graph_mip_version(
 
 /*! @} */
 
+/*!
+@name Sharing
+@{
+*/
+
+/*!
+@brief
+    Returns whether or not you can share the field class
+    \bt_p{field_class} with another \bt_ev_cls or \bt_stream_cls.
+
+A field class is shareable when:
+
+- It's the root field class of a scope of an event class or of a stream
+  class, that is, you set it with
+  bt_stream_class_set_packet_context_field_class(),
+  bt_stream_class_set_event_common_context_field_class(),
+  bt_event_class_set_specific_context_field_class(), or
+  bt_event_class_set_payload_field_class().
+
+- All the \ref api-tir-fc-link "links to other field classes" of the
+  field classes it recursively contains which use a \bt_field_path
+  target a field class within \bt_p{field_class} itself.
+
+You may pass a shareable field class to the same function which you used
+to make it the root field class of a scope, for another event class or
+stream class, possibly of another \bt_trace_cls. This makes it possible
+for a \bt_flt_comp to reuse the field classes of its upstream trace
+classes instead of copying them.
+
+@param[in] field_class
+    Field class of which to get whether or not it's shareable.
+
+@returns
+    #BT_TRUE if \bt_p{field_class} is shareable.
+
+@bt_pre_not_null{field_class}
+*/
+extern bt_bool bt_field_class_is_shareable(
+		const bt_field_class *field_class) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Boolean field class
 @{
@@ -4542,6 +4589,43 @@ bt_field_class_structure_borrow_member_by_name_const(
 		const bt_field_class *field_class, const char *name)
 		__BT_NOEXCEPT;
 
+/*!
+@brief
+    Sets \bt_p{*index} to the index of the member having the name
+    \bt_p{name} within the \bt_struct_fc \bt_p{field_class}.
+
+See the \ref api-tir-fc-struct-prop-members "members" property.
+
+Use this function to resolve a member name once, and then
+bt_field_structure_borrow_member_field_by_index() to borrow the
+corresponding member field of each instance of \bt_p{field_class},
+instead of calling bt_field_structure_borrow_member_field_by_name()
+for each one of them.
+
+@param[in] field_class
+    Structure field class of which to get the index of the member
+    having the name \bt_p{name}.
+@param[in] name
+    Name of the member of which to get the index.
+@param[out] index
+    If this function returns #BT_TRUE, <code>*index</code> is the index
+    of the member of \bt_p{field_class} having the name \bt_p{name}.
+
+    This index remains valid as long as \bt_p{field_class} exists.
+
+@returns
+    #BT_TRUE if \bt_p{field_class} has a member having the name
+    \bt_p{name}.
+
+@bt_pre_not_null{field_class}
+@bt_pre_is_struct_fc{field_class}
+@bt_pre_not_null{name}
+@bt_pre_not_null{index}
+*/
+extern bt_bool bt_field_class_structure_get_member_index_by_name(
+		const bt_field_class *field_class, const char *name,
+		uint64_t *index) __BT_NOEXCEPT;
+
 /*! @} */
 
 /*!
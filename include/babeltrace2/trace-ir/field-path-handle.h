@@ -0,0 +1,486 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 EfficiOS Inc. and Linux Foundation
+ */
+
+#ifndef BABELTRACE2_TRACE_IR_FIELD_PATH_HANDLE_H
+#define BABELTRACE2_TRACE_IR_FIELD_PATH_HANDLE_H
+
+/* IWYU pragma: private, include <babeltrace2/babeltrace.h> */
+
+#ifndef __BT_IN_BABELTRACE_H
+# error "Please include <babeltrace2/babeltrace.h> instead."
+#endif
+
+#include <stdint.h>
+
+#include <babeltrace2/trace-ir/field-path.h>
+#include <babeltrace2/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+@defgroup api-tir-field-path-handle Field path handle
+@ingroup api-tir
+
+@brief
+    Pre-resolved path to a \bt_field of the \bt_p_ev of a given
+    \bt_ev_cls.
+
+A <strong><em>field path handle</em></strong> indicates how to reach a
+given \bt_field, from a given <em>root scope</em>, within any \bt_ev
+of a given \bt_ev_cls.
+
+Build a field path handle once with bt_field_path_handle_create() and
+the <code>bt_field_path_handle_append_*()</code> functions, and then
+borrow the target field of any event of its event class with a single
+call to bt_field_path_handle_borrow_field_from_event(), instead of
+borrowing each intermediate field in turn.
+
+For example, to reach the field which the path
+<code>payload.a.b[3].c</code> would designate:
+
+@code
+bt_field_path_handle *handle = bt_field_path_handle_create(
+    event_class, BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD);
+
+bt_field_path_handle_append_structure_member_by_name(handle, "a");
+bt_field_path_handle_append_structure_member_by_name(handle, "b");
+bt_field_path_handle_append_array_element(handle, 3);
+bt_field_path_handle_append_structure_member_by_name(handle, "c");
+@endcode
+
+Each append function looks up the named member or option of the
+current target field class once, so that borrowing a field from an
+event only follows indexes.
+
+A field path handle is available within a trace processing \bt_graph
+having any effective \bt_mip (MIP) version.
+
+A field path handle is a \ref api-fund-shared-object "shared object": get
+a new reference with bt_field_path_handle_get_ref() and put an existing
+reference with bt_field_path_handle_put_ref().
+
+The type of a field path handle is #bt_field_path_handle.
+
+@attention
+    Once you create a field path handle for an event class, do \em not
+    modify the field classes which its items traverse.
+*/
+
+/*! @{ */
+
+/*!
+@name Type
+@{
+
+@typedef struct bt_field_path_handle bt_field_path_handle;
+
+@brief
+    Field path handle.
+
+@}
+*/
+
+/*!
+@name Creation
+@{
+*/
+
+/*!
+@brief
+    Creates an empty field path handle for the \bt_p_ev of the
+    \bt_ev_cls \bt_p{event_class} of which the root scope is
+    \bt_p{root_scope}.
+
+The target field class of the returned field path handle is the root
+field class of \bt_p{root_scope}.
+
+@param[in] event_class
+    Class of the events from which to borrow fields with the created
+    field path handle.
+@param[in] root_scope
+    Root scope of the created field path handle.
+
+@returns
+    New field path handle reference, or \c NULL on memory error.
+
+@bt_pre_not_null{event_class}
+@pre
+    \bt_p{event_class} belongs to a \bt_stream_cls.
+@pre
+    \bt_p{event_class} or its stream class has a field class for
+    \bt_p{root_scope}.
+*/
+extern bt_field_path_handle *bt_field_path_handle_create(
+		const bt_event_class *event_class,
+		bt_field_path_scope root_scope) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Status codes for the <code>bt_field_path_handle_append_*()</code>
+    functions.
+*/
+typedef enum bt_field_path_handle_append_item_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    No such member or option.
+	*/
+	BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_NOT_FOUND	= __BT_FUNC_STATUS_NOT_FOUND,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_field_path_handle_append_item_status;
+
+/*!
+@brief
+    Appends, to the field path handle \bt_p{handle}, the member named
+    \bt_p{name} of its current target \bt_struct_fc.
+
+On success, the target field class of \bt_p{handle} becomes the field
+class of this member.
+
+@param[in] handle
+    Field path handle to which to append the structure member.
+@param[in] name
+    Name of the structure member to append.
+
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK
+    Success.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_NOT_FOUND
+    The target structure field class of \bt_p{handle} has no member
+    named \bt_p{name}: \bt_p{handle} is unchanged.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{handle}
+@bt_pre_not_null{name}
+@pre
+    The target field class of \bt_p{handle}
+    (bt_field_path_handle_borrow_field_class_const()) is a
+    structure field class.
+*/
+extern bt_field_path_handle_append_item_status
+bt_field_path_handle_append_structure_member_by_name(
+		bt_field_path_handle *handle, const char *name) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Appends, to the field path handle \bt_p{handle}, the element at
+    index \bt_p{index} of its current target \bt_array_fc.
+
+On success, the target field class of \bt_p{handle} becomes the
+element field class of this array field class.
+
+bt_field_path_handle_borrow_field_from_event() returns \c NULL when
+\bt_p{index} is greater than or equal to the length of the
+corresponding \bt_darray_field.
+
+@param[in] handle
+    Field path handle to which to append the array element.
+@param[in] index
+    Index of the array element to append.
+
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK
+    Success.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{handle}
+@pre
+    The target field class of \bt_p{handle} is an array field class.
+@pre
+    If the target field class of \bt_p{handle} is a \bt_sarray_fc,
+    \bt_p{index} is less than its length.
+*/
+extern bt_field_path_handle_append_item_status
+bt_field_path_handle_append_array_element(
+		bt_field_path_handle *handle, uint64_t index) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Appends, to the field path handle \bt_p{handle}, the content of its
+    current target \bt_opt_fc.
+
+On success, the target field class of \bt_p{handle} becomes the
+optional field class of this option field class.
+
+bt_field_path_handle_borrow_field_from_event() returns \c NULL when
+the corresponding \bt_opt_field has no field.
+
+@param[in] handle
+    Field path handle to which to append the option content.
+
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK
+    Success.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{handle}
+@pre
+    The target field class of \bt_p{handle} is an option field class.
+*/
+extern bt_field_path_handle_append_item_status
+bt_field_path_handle_append_option_content(
+		bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Appends, to the field path handle \bt_p{handle}, the option named
+    \bt_p{name} of its current target \bt_var_fc.
+
+On success, the target field class of \bt_p{handle} becomes the field
+class of this option.
+
+bt_field_path_handle_borrow_field_from_event() returns \c NULL when
+the selected option of the corresponding \bt_var_field is another one.
+
+@param[in] handle
+    Field path handle to which to append the variant option.
+@param[in] name
+    Name of the variant option to append.
+
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK
+    Success.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_NOT_FOUND
+    The target variant field class of \bt_p{handle} has no option named
+    \bt_p{name}: \bt_p{handle} is unchanged.
+@retval #BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{handle}
+@bt_pre_not_null{name}
+@pre
+    The target field class of \bt_p{handle} is a variant field class.
+*/
+extern bt_field_path_handle_append_item_status
+bt_field_path_handle_append_variant_option_by_name(
+		bt_field_path_handle *handle, const char *name) __BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Properties
+@{
+*/
+
+/*!
+@brief
+    Borrows the event class of the field path handle \bt_p{handle}.
+
+@param[in] handle
+    Field path handle of which to borrow the event class.
+
+@returns
+    \em Borrowed reference of the event class of \bt_p{handle}.
+
+@bt_pre_not_null{handle}
+*/
+extern const bt_event_class *bt_field_path_handle_borrow_event_class_const(
+		const bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Returns the root scope of the field path handle \bt_p{handle}.
+
+@param[in] handle
+    Field path handle of which to get the root scope.
+
+@returns
+    Root scope of \bt_p{handle}.
+
+@bt_pre_not_null{handle}
+*/
+extern bt_field_path_scope bt_field_path_handle_get_root_scope(
+		const bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Borrows the class of the target field of the field path handle
+    \bt_p{handle}.
+
+@param[in] handle
+    Field path handle of which to borrow the target field class.
+
+@returns
+    \em Borrowed reference of the target field class of \bt_p{handle}.
+
+@bt_pre_not_null{handle}
+*/
+extern const bt_field_class *bt_field_path_handle_borrow_field_class_const(
+		const bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Field access
+@{
+*/
+
+/*!
+@brief
+    Borrows the target field of the field path handle \bt_p{handle}
+    from the event \bt_p{event}.
+
+@param[in] handle
+    Field path handle to follow.
+@param[in] event
+    Event from which to borrow the target field of \bt_p{handle}.
+
+@returns
+    @parblock
+    \em Borrowed reference of the target field of \bt_p{handle} within
+    \bt_p{event}, or \c NULL if \bt_p{event} has no such field, that
+    is, if:
+
+    - The root scope of \bt_p{handle} is
+      #BT_FIELD_PATH_SCOPE_PACKET_CONTEXT and \bt_p{event} has no
+      packet.
+    - An array element index of \bt_p{handle} is out of bounds.
+    - An \bt_opt_field has no field.
+    - A \bt_var_field has another selected option.
+
+    The returned field remains valid as long as \bt_p{event} exists.
+    @endparblock
+
+@bt_pre_not_null{handle}
+@bt_pre_not_null{event}
+@pre
+    The class of \bt_p{event} is the event class of \bt_p{handle}
+    (bt_field_path_handle_borrow_event_class_const()).
+
+@sa bt_field_path_handle_borrow_field_from_event_const() &mdash;
+    \c const version of this function.
+*/
+extern bt_field *bt_field_path_handle_borrow_field_from_event(
+		const bt_field_path_handle *handle, bt_event *event)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Borrows the target field of the field path handle \bt_p{handle}
+    from the event \bt_p{event} (\c const version).
+
+See bt_field_path_handle_borrow_field_from_event().
+*/
+extern const bt_field *bt_field_path_handle_borrow_field_from_event_const(
+		const bt_field_path_handle *handle, const bt_event *event)
+		__BT_NOEXCEPT;
+
+/*! @} */
+
+/*!
+@name Reference count
+@{
+*/
+
+/*!
+@brief
+    Increments the \ref api-fund-shared-object "reference count" of
+    the field path handle \bt_p{handle}.
+
+@param[in] handle
+    @parblock
+    Field path handle of which to increment the reference count.
+
+    Can be \c NULL.
+    @endparblock
+
+@sa bt_field_path_handle_put_ref() &mdash;
+    Decrements the reference count of a field path handle.
+*/
+extern void bt_field_path_handle_get_ref(
+		const bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Decrements the \ref api-fund-shared-object "reference count" of
+    the field path handle \bt_p{handle}.
+
+@param[in] handle
+    @parblock
+    Field path handle of which to decrement the reference count.
+
+    Can be \c NULL.
+    @endparblock
+
+@sa bt_field_path_handle_get_ref() &mdash;
+    Increments the reference count of a field path handle.
+*/
+extern void bt_field_path_handle_put_ref(
+		const bt_field_path_handle *handle) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Decrements the reference count of the field path handle
+    \bt_p{_handle}, and then sets \bt_p{_handle} to \c NULL.
+
+@param _handle
+    @parblock
+    Field path handle of which to decrement the reference count.
+
+    Can contain \c NULL.
+    @endparblock
+
+@bt_pre_assign_expr{_handle}
+*/
+#define BT_FIELD_PATH_HANDLE_PUT_REF_AND_RESET(_handle)	\
+	do {						\
+		bt_field_path_handle_put_ref(_handle);	\
+		(_handle) = NULL;			\
+	} while (0)
+
+/*!
+@brief
+    Decrements the reference count of the field path handle
+    \bt_p{_dst}, sets \bt_p{_dst} to \bt_p{_src}, and then sets
+    \bt_p{_src} to \c NULL.
+
+This macro effectively moves a field path handle reference from the
+expression \bt_p{_src} to the expression \bt_p{_dst}, putting the
+existing \bt_p{_dst} reference.
+
+@param _dst
+    @parblock
+    Destination expression.
+
+    Can contain \c NULL.
+    @endparblock
+@param _src
+    @parblock
+    Source expression.
+
+    Can contain \c NULL.
+    @endparblock
+
+@bt_pre_assign_expr{_dst}
+@bt_pre_assign_expr{_src}
+*/
+#define BT_FIELD_PATH_HANDLE_MOVE_REF(_dst, _src)	\
+	do {						\
+		bt_field_path_handle_put_ref(_dst);	\
+		(_dst) = (_src);			\
+		(_src) = NULL;				\
+	} while (0)
+
+/*! @} */
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE2_TRACE_IR_FIELD_PATH_HANDLE_H */
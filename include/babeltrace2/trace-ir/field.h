@@ -397,6 +397,12 @@ Borrow a field from an array field at a given index with
 bt_field_array_borrow_element_field_by_index() and
 bt_field_array_borrow_element_field_by_index_const().
 
+When the elements of an array field are \bt_p_int_field or
+\bt_p_real_field, set or get the values of many of them at once with
+bt_field_array_integer_unsigned_set_values(),
+bt_field_array_integer_signed_set_values(),
+bt_field_array_real_set_values(), and their getter counterparts.
+
 <h1>\anchor api-tir-field-struct Structure field</h1>
 
 A <strong><em>structure field</em></strong> is a \bt_struct_fc instance.
@@ -413,6 +419,10 @@ Borrow the field of a member from a structure field by name with
 bt_field_structure_borrow_member_field_by_name() and
 bt_field_structure_borrow_member_field_by_name_const().
 
+To borrow the same member field from many structure fields, get its
+index once with bt_field_class_structure_get_member_index_by_name()
+and borrow it by index.
+
 <h1>\anchor api-tir-field-opt Option field</h1>
 
 An <strong><em>option field</em></strong> is an \bt_opt_fc instance.
@@ -531,6 +541,70 @@ extern const bt_field_class *bt_field_borrow_class_const(
 
 /*! @} */
 
+/*!
+@name Copy
+@{
+*/
+
+/*!
+@brief
+    Status codes for bt_field_copy().
+*/
+typedef enum bt_field_copy_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_FIELD_COPY_STATUS_OK			= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_FIELD_COPY_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_field_copy_status;
+
+/*!
+@brief
+    Copies the value of the field \bt_p{src_field} to the field
+    \bt_p{dst_field}, recursively.
+
+The classes of \bt_p{src_field} and \bt_p{dst_field} may be the same
+field class or two distinct field classes having the same structure,
+for example when a \bt_flt_comp copies the field classes of its
+upstream \bt_trace_cls.
+
+This function is equivalent to setting each field which \bt_p{src_field}
+recursively contains with the field-specific setters, including the
+lengths of \bt_p_darray_field and of dynamic \bt_p_blob_field, whether or
+not \bt_p_opt_field have a field, and the selected options of
+\bt_p_var_field. However, it directly copies the underlying data, for
+example with a single memory copy for a BLOB field, instead of calling
+one function per field.
+
+@param[in] src_field
+    Field of which to copy the value.
+@param[in] dst_field
+    Field to which to copy the value of \bt_p{src_field}.
+
+@retval #BT_FIELD_COPY_STATUS_OK
+    Success.
+@retval #BT_FIELD_COPY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{src_field}
+@bt_pre_not_null{dst_field}
+@bt_pre_hot{dst_field}
+@pre
+    The classes of \bt_p{src_field} and \bt_p{dst_field} have the
+    same type and, recursively, the same members, options, element
+    field classes, and static lengths.
+*/
+extern bt_field_copy_status bt_field_copy(const bt_field *src_field,
+		bt_field *dst_field) __BT_NOEXCEPT;
+
+/*! @} */
+
 /*!
 @name Boolean field
 @{
@@ -1420,6 +1494,135 @@ extern bt_field_array_dynamic_set_length_status
 bt_field_array_dynamic_set_length(bt_field *field, uint64_t length)
 		__BT_NOEXCEPT;
 
+/*!
+@brief
+    Sets the values of the \bt_p{count} \bt_p{field} elements,
+    which are \bt_p_uint_field, starting at index \bt_p{index}, to
+    the values of \bt_p{values}.
+
+This function is equivalent to calling
+bt_field_integer_unsigned_set_value() for each of those element fields,
+but checks its preconditions once.
+
+@param[in] field
+    Array field of which to set the values of the element fields.
+@param[in] index
+    Index of the first element field of \bt_p{field} of which to set
+    the value.
+@param[in] values
+    Array of \bt_p{count} values.
+@param[in] count
+    Number of element fields of \bt_p{field} of which to set the value.
+
+@bt_pre_not_null{field}
+@bt_pre_is_array_field{field}
+@bt_pre_hot{field}
+@bt_pre_not_null{values}
+@pre
+    \bt_p{index} + \bt_p{count} is less than or equal to the length
+    of \bt_p{field} (as returned by bt_field_array_get_length()).
+@pre
+    The element field class of the class of \bt_p{field} is an
+    unsigned integer field class.
+@pre
+    Each value of \bt_p{values} is within the
+    \ref api-tir-fc-int-prop-size "field value range" of the element
+    field class.
+
+@sa bt_field_array_integer_unsigned_get_values() &mdash;
+    Returns the values of the unsigned integer element fields of an
+    array field.
+*/
+extern void bt_field_array_integer_unsigned_set_values(bt_field *field,
+		uint64_t index, const uint64_t *values, uint64_t count)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets \bt_p{values} to the values of the \bt_p{count}
+    \bt_p{field} elements, which are \bt_p_uint_field, starting at
+    index \bt_p{index}.
+
+@param[in] field
+    Array field of which to get the values of the element fields.
+@param[in] index
+    Index of the first element field of \bt_p{field} of which to get
+    the value.
+@param[out] values
+    Array of \bt_p{count} values to set.
+@param[in] count
+    Number of element fields of \bt_p{field} of which to get the value.
+
+@bt_pre_not_null{field}
+@bt_pre_is_array_field{field}
+@bt_pre_not_null{values}
+@pre
+    \bt_p{index} + \bt_p{count} is less than or equal to the length
+    of \bt_p{field}.
+@pre
+    The element field class of the class of \bt_p{field} is an
+    unsigned integer field class.
+
+@sa bt_field_array_integer_unsigned_set_values() &mdash;
+    Sets the values of the unsigned integer element fields of an array
+    field.
+*/
+extern void bt_field_array_integer_unsigned_get_values(const bt_field *field,
+		uint64_t index, uint64_t *values, uint64_t count)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets the values of the \bt_p{count} \bt_p{field} elements,
+    which are \bt_p_sint_field, starting at index \bt_p{index}, to
+    the values of \bt_p{values}.
+
+See bt_field_array_integer_unsigned_set_values().
+*/
+extern void bt_field_array_integer_signed_set_values(bt_field *field,
+		uint64_t index, const int64_t *values, uint64_t count)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets \bt_p{values} to the values of the \bt_p{count}
+    \bt_p{field} elements, which are \bt_p_sint_field, starting at
+    index \bt_p{index}.
+
+See bt_field_array_integer_unsigned_get_values().
+*/
+extern void bt_field_array_integer_signed_get_values(const bt_field *field,
+		uint64_t index, int64_t *values, uint64_t count)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets the values of the \bt_p{count} \bt_p{field} elements,
+    which are \bt_p_real_field, starting at index \bt_p{index}, to
+    the values of \bt_p{values}.
+
+If the element fields are single-precision real fields, then this
+function converts each value to \c float, like
+bt_field_real_single_precision_set_value() does.
+
+See bt_field_array_integer_unsigned_set_values().
+*/
+extern void bt_field_array_real_set_values(bt_field *field,
+		uint64_t index, const double *values, uint64_t count)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Sets \bt_p{values} to the values of the \bt_p{count}
+    \bt_p{field} elements, which are \bt_p_real_field, starting at
+    index \bt_p{index}.
+
+See bt_field_array_integer_unsigned_get_values().
+*/
+extern void bt_field_array_real_get_values(const bt_field *field,
+		uint64_t index, double *values, uint64_t count)
+		__BT_NOEXCEPT;
+
 /*! @} */
 
 /*!
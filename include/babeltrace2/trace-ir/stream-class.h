@@ -1246,8 +1246,11 @@ bt_stream_class_set_supports_packets()).
 @bt_pre_not_null{field_class}
 @bt_pre_is_struct_fc{field_class}
 @pre
-    \bt_p{field_class}, or any of its contained field classes,
-    isn't already part of a stream class or of an \bt_ev_cls.
+    \bt_p{field_class}, or any of its contained field classes, isn't
+    already part of a stream class or of an \bt_ev_cls, unless
+    \bt_p{field_class} already is the packet context field class of
+    another stream class and bt_field_class_is_shareable() returns
+    #BT_TRUE for it.
 @pre
     If any of the field classes recursively contained in
     \bt_p{field_class} has a
@@ -1336,8 +1339,11 @@ property.
 @bt_pre_not_null{field_class}
 @bt_pre_is_struct_fc{field_class}
 @pre
-    \bt_p{field_class}, or any of its contained field classes,
-    isn't already part of a stream class or of an \bt_ev_cls.
+    \bt_p{field_class}, or any of its contained field classes, isn't
+    already part of a stream class or of an \bt_ev_cls, unless
+    \bt_p{field_class} already is the event common context field class
+    of another stream class and bt_field_class_is_shareable() returns
+    #BT_TRUE for it.
 @pre
     If any of the field classes recursively contained in
     \bt_p{field_class} has a
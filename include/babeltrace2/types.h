@@ -47,6 +47,7 @@ typedef struct bt_field_class_variant_with_selector_field_integer_signed_option
 typedef struct bt_field_class_variant_with_selector_field_integer_unsigned_option bt_field_class_variant_with_selector_field_integer_unsigned_option;
 typedef struct bt_field_location bt_field_location;
 typedef struct bt_field_path bt_field_path;
+typedef struct bt_field_path_handle bt_field_path_handle;
 typedef struct bt_field_path_item bt_field_path_item;
 typedef struct bt_graph bt_graph;
 typedef struct bt_integer_range_set bt_integer_range_set;
@@ -91,6 +92,7 @@ typedef struct bt_stream_class bt_stream_class;
 typedef struct bt_trace bt_trace;
 typedef struct bt_trace_class bt_trace_class;
 typedef struct bt_value bt_value;
+typedef struct bt_value_map_builder bt_value_map_builder;
 
 /*!
 @defgroup api-common-types Common C types
@@ -97,6 +97,12 @@ Deep-copy a value with bt_value_copy().
 
 Extend a map value with bt_value_map_extend().
 
+Build a <em>compact</em> map value, which is immutable, with a
+\ref api-val-map-builder "map value builder" (#bt_value_map_builder).
+A compact map value is cheaper to create, to look up, and to destroy
+than a map value which bt_value_map_create() returns when it contains
+many entries: prefer it for large results of \ref api-qexec "queries".
+
 The following table shows the available functions and types for each
 type of value:
 
@@ -2279,6 +2285,334 @@ extern bt_value_map_extend_status bt_value_map_extend(
 
 /*! @} */
 
+/*!
+@name Map value builder
+@anchor api-val-map-builder
+@{
+
+A <strong><em>map value builder</em></strong> accumulates entries and
+then builds a <em>compact</em> map value containing them with
+bt_value_map_builder_build().
+
+A compact map value is a map value (#BT_VALUE_TYPE_MAP): read it with
+bt_value_map_get_size(), bt_value_map_has_entry(),
+bt_value_map_borrow_entry_value_const(),
+bt_value_map_foreach_entry_const(), and the other map value functions
+which don't modify it. However, a compact map value is
+\ref api-fund-freezing "frozen" and stays so: you may not modify it,
+nor any scalar value which it contains.
+
+The advantage of a compact map value is that a single memory
+allocation contains its entries as well as its scalar (null, boolean,
+integer, real, and string) values, in key order: building, looking up,
+and destroying a compact map value is cheaper than doing the same with
+a map value which bt_value_map_create() returns.
+
+Map value builders are \ref api-fund-shared-object "shared objects": get
+a new reference with bt_value_map_builder_get_ref() and put an existing
+reference with bt_value_map_builder_put_ref().
+*/
+
+/*!
+@brief
+    Creates and returns an empty map value builder.
+
+@returns
+    New map value builder reference, or \c NULL on memory error.
+*/
+extern bt_value_map_builder *bt_value_map_builder_create(void)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Status codes for the <code>bt_value_map_builder_add_*()</code>
+    functions.
+*/
+typedef enum bt_value_map_builder_add_entry_status {
+	/*!
+	@brief
+	    Success.
+	*/
+	BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK		= __BT_FUNC_STATUS_OK,
+
+	/*!
+	@brief
+	    Out of memory.
+	*/
+	BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR	= __BT_FUNC_STATUS_MEMORY_ERROR,
+} bt_value_map_builder_add_entry_status;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the value
+    \bt_p{entry_value} to the map value builder \bt_p{builder}.
+
+To add an entry having a null value, pass #bt_value_null as
+\bt_p{entry_value}.
+
+If you add more than one entry with the key \bt_p{key}, then the map
+value which bt_value_map_builder_build() builds contains the last one.
+
+If \bt_p{entry_value} is a scalar value, then this function copies its
+raw value: the map value which bt_value_map_builder_build() builds
+doesn't contain \bt_p{entry_value} itself. Otherwise, this function
+gets a reference on \bt_p{entry_value}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] entry_value
+    Value of the entry to add.
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+@bt_pre_not_null{entry_value}
+
+@bt_post_success_frozen{entry_value}
+*/
+extern bt_value_map_builder_add_entry_status bt_value_map_builder_add_entry(
+		bt_value_map_builder *builder, const char *key,
+		const bt_value *entry_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the boolean raw value
+    \bt_p{raw_value} to the map value builder \bt_p{builder}.
+
+Unlike bt_value_map_insert_bool_entry(), this function doesn't create
+any boolean value.
+
+See bt_value_map_builder_add_entry() for the behaviour when you add
+more than one entry with the key \bt_p{key}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] raw_value
+    Boolean raw value of the entry to add.
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+*/
+extern bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_bool_entry(bt_value_map_builder *builder,
+		const char *key, bt_bool raw_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the unsigned integer raw
+    value \bt_p{raw_value} to the map value builder \bt_p{builder}.
+
+Unlike bt_value_map_insert_unsigned_integer_entry(), this function
+doesn't create any unsigned integer value.
+
+See bt_value_map_builder_add_entry() for the behaviour when you add
+more than one entry with the key \bt_p{key}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] raw_value
+    Unsigned integer raw value of the entry to add.
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+*/
+extern bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_unsigned_integer_entry(
+		bt_value_map_builder *builder, const char *key,
+		uint64_t raw_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the signed integer raw
+    value \bt_p{raw_value} to the map value builder \bt_p{builder}.
+
+Unlike bt_value_map_insert_signed_integer_entry(), this function
+doesn't create any signed integer value.
+
+See bt_value_map_builder_add_entry() for the behaviour when you add
+more than one entry with the key \bt_p{key}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] raw_value
+    Signed integer raw value of the entry to add.
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+*/
+extern bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_signed_integer_entry(
+		bt_value_map_builder *builder, const char *key,
+		int64_t raw_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the real raw value
+    \bt_p{raw_value} to the map value builder \bt_p{builder}.
+
+Unlike bt_value_map_insert_real_entry(), this function doesn't create
+any real value.
+
+See bt_value_map_builder_add_entry() for the behaviour when you add
+more than one entry with the key \bt_p{key}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] raw_value
+    Real raw value of the entry to add.
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+*/
+extern bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_real_entry(bt_value_map_builder *builder,
+		const char *key, double raw_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Adds an entry with the key \bt_p{key} and the string raw value
+    \bt_p{raw_value} to the map value builder \bt_p{builder}.
+
+Unlike bt_value_map_insert_string_entry(), this function doesn't
+create any string value.
+
+See bt_value_map_builder_add_entry() for the behaviour when you add
+more than one entry with the key \bt_p{key}.
+
+@param[in] builder
+    Map value builder to which to add an entry.
+@param[in] key
+    Key of the entry to add (copied).
+@param[in] raw_value
+    String raw value of the entry to add (copied).
+
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_OK
+    Success.
+@retval #BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR
+    Out of memory.
+
+@bt_pre_not_null{builder}
+@bt_pre_not_null{key}
+@bt_pre_not_null{raw_value}
+*/
+extern bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_string_entry(bt_value_map_builder *builder,
+		const char *key, const char *raw_value) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Builds and returns a compact map value containing the entries
+    which you added to the map value builder \bt_p{builder}.
+
+The returned value has the type #BT_VALUE_TYPE_MAP and is
+\ref api-fund-freezing "frozen".
+
+On success, \bt_p{builder} becomes empty: you may reuse it to build
+another compact map value.
+
+@param[in] builder
+    Map value builder to use.
+
+@returns
+    New compact map value reference, or \c NULL on memory error.
+
+@bt_pre_not_null{builder}
+*/
+extern bt_value *bt_value_map_builder_build(bt_value_map_builder *builder)
+		__BT_NOEXCEPT;
+
+/*!
+@brief
+    Increments the \ref api-fund-shared-object "reference count" of
+    the map value builder \bt_p{builder}.
+
+@param[in] builder
+    @parblock
+    Map value builder of which to increment the reference count.
+
+    Can be \c NULL.
+    @endparblock
+
+@sa bt_value_map_builder_put_ref() &mdash;
+    Decrements the reference count of a map value builder.
+*/
+extern void bt_value_map_builder_get_ref(
+		const bt_value_map_builder *builder) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Decrements the \ref api-fund-shared-object "reference count" of
+    the map value builder \bt_p{builder}.
+
+@param[in] builder
+    @parblock
+    Map value builder of which to decrement the reference count.
+
+    Can be \c NULL.
+    @endparblock
+
+@sa bt_value_map_builder_get_ref() &mdash;
+    Increments the reference count of a map value builder.
+*/
+extern void bt_value_map_builder_put_ref(
+		const bt_value_map_builder *builder) __BT_NOEXCEPT;
+
+/*!
+@brief
+    Decrements the reference count of the map value builder
+    \bt_p{_builder}, and then sets \bt_p{_builder} to \c NULL.
+
+@param _builder
+    @parblock
+    Map value builder of which to decrement the reference count.
+
+    Can contain \c NULL.
+    @endparblock
+
+@bt_pre_assign_expr{_builder}
+*/
+#define BT_VALUE_MAP_BUILDER_PUT_REF_AND_RESET(_builder)	\
+	do {							\
+		bt_value_map_builder_put_ref(_builder);		\
+		(_builder) = NULL;				\
+	} while (0)
+
+/*! @} */
+
 /*!
 @name General
 @{
@@ -9,6 +9,7 @@
 #include "logging/log.h"
 
 #include <stdbool.h>
+#include <sys/stat.h>
 
 #include "autodisc.h"
 #include "common/common.h"
@@ -315,6 +316,120 @@ end:
 	return status;
 }
 
+/*
+ * Cached result of a `babeltrace.support-info` query for a directory
+ * or file input.
+ */
+struct support_info_cache_entry {
+	/* Queried component class (strong reference) */
+	const bt_component_class *comp_cls;
+
+	/* Modification time of the input when queried */
+	time_t mtime;
+
+	bt_query_executor_query_status status;
+
+	/* Query result (strong reference), or `NULL` if `status` isn't OK */
+	const bt_value *result;
+};
+
+static
+void support_info_cache_entry_destroy(struct support_info_cache_entry *entry)
+{
+	bt_component_class_put_ref(entry->comp_cls);
+	bt_value_put_ref(entry->result);
+	g_free(entry);
+}
+
+/*
+ * Process-wide cache of `babeltrace.support-info` query results:
+ * `gchar *` key (component class address, input type, and input),
+ * owned by the hash table, to `struct support_info_cache_entry *`,
+ * owned by the hash table.
+ *
+ * An entry holds a reference on its component class, so that another
+ * component class can't get the same address.
+ */
+static GHashTable *support_info_cache;
+
+/*
+ * Like simple_query() with the `babeltrace.support-info` object, but
+ * reuses the result of a previous query for the same component class
+ * and the same directory or file `input`, if `input` wasn't modified
+ * since.
+ *
+ * Only caches the successful results and the unknown object status,
+ * which don't depend on anything else than the input.
+ */
+static
+bt_query_executor_query_status cached_support_info_query(
+		const bt_component_class *comp_cls, const char *input,
+		const char *input_type, const bt_value *params,
+		bt_logging_level log_level, const bt_value **result)
+{
+	bt_query_executor_query_status status;
+	struct support_info_cache_entry *entry;
+	struct stat st;
+	gchar *key = NULL;
+
+	if (strcmp(input_type, "string") == 0 || stat(input, &st) != 0) {
+		/* Can't tell whether or not the input changed */
+		status = simple_query(comp_cls, "babeltrace.support-info",
+			params, log_level, result);
+		goto end;
+	}
+
+	key = g_strdup_printf("%p:%s:%s", (const void *) comp_cls,
+		input_type, input);
+
+	if (!support_info_cache) {
+		support_info_cache = g_hash_table_new_full(g_str_hash,
+			g_str_equal, g_free,
+			(GDestroyNotify) support_info_cache_entry_destroy);
+		BT_ASSERT(support_info_cache);
+	}
+
+	entry = g_hash_table_lookup(support_info_cache, key);
+	if (entry && entry->mtime == st.st_mtime) {
+		BT_LOGD("babeltrace.support-info query: using cached result: "
+			"component-class-name=%s, input=%s, type=%s",
+			bt_component_class_get_name(comp_cls), input,
+			input_type);
+		status = entry->status;
+		*result = entry->result;
+		bt_value_get_ref(*result);
+		goto end;
+	}
+
+	status = simple_query(comp_cls, "babeltrace.support-info", params,
+		log_level, result);
+
+	if (status != BT_QUERY_EXECUTOR_QUERY_STATUS_OK &&
+			status != BT_QUERY_EXECUTOR_QUERY_STATUS_UNKNOWN_OBJECT) {
+		goto end;
+	}
+
+	entry = g_new0(struct support_info_cache_entry, 1);
+	BT_ASSERT(entry);
+	entry->comp_cls = comp_cls;
+	bt_component_class_get_ref(entry->comp_cls);
+	entry->mtime = st.st_mtime;
+	entry->status = status;
+
+	if (status == BT_QUERY_EXECUTOR_QUERY_STATUS_OK) {
+		entry->result = *result;
+		bt_value_get_ref(entry->result);
+	}
+
+	g_hash_table_replace(support_info_cache, key, entry);
+
+	/* Moved to the hash table */
+	key = NULL;
+
+end:
+	g_free(key);
+	return status;
+}
 
 /*
  * Query all known source components to see if any of them can handle `input`
@@ -406,8 +521,9 @@ auto_source_discovery_internal_status support_info_query_all_sources(
 				"type=%s", plugin_name, source_cc_name, input, input_type);
 
 			BT_VALUE_PUT_REF_AND_RESET(query_result);
-			query_status = simple_query(cc, "babeltrace.support-info",
-				query_params, log_level, &query_result);
+			query_status = cached_support_info_query(cc, input,
+				input_type, query_params, log_level,
+				&query_result);
 
 			if (query_status == BT_QUERY_EXECUTOR_QUERY_STATUS_OK) {
 				double weight;
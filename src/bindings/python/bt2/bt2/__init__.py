@@ -58,6 +58,7 @@ from bt2.error import (
     _MessageIteratorErrorCause,
 )
 from bt2.event_class import EventClassLogLevel, _EventClass, _EventClassConst
+from bt2.event_field_extractor import EventFieldStringColumn, extract_event_fields
 from bt2.field import (
     _ArrayField,
     _ArrayFieldConst,
@@ -290,6 +291,7 @@ from bt2.trace_collection_message_iterator import (
     ComponentSpec,
     TraceCollectionMessageIterator,
 )
+from bt2.trace_collection_pool import count_event_messages, merge_values, process_trace_collections
 from bt2.utils import Stop, TryAgain, UnknownObject, _ListenerHandle, _OverflowError
 from bt2.value import (
     ArrayValue,
@@ -417,6 +419,8 @@ __all__ = [
     EventClassLogLevel,
     _EventClass,
     _EventClassConst,
+    EventFieldStringColumn,
+    extract_event_fields,
     _ArrayField,
     _ArrayFieldConst,
     _BitArrayField,
@@ -642,6 +646,9 @@ __all__ = [
     AutoSourceComponentSpec,
     ComponentSpec,
     TraceCollectionMessageIterator,
+    count_event_messages,
+    merge_values,
+    process_trace_collections,
     Stop,
     TryAgain,
     UnknownObject,
@@ -13,6 +13,8 @@ typing = typing_mod._typing_mod
 
 
 class ClockOffset:
+    __slots__ = ("_seconds", "_cycles")
+
     def __init__(self, seconds: int = 0, cycles: int = 0):
         bt2_utils._check_int64(seconds)
         bt2_utils._check_int64(cycles)
@@ -39,6 +41,8 @@ ClockClassOffset = ClockOffset
 
 
 class ClockOrigin:
+    __slots__ = ("_namespace", "_name", "_uid")
+
     def __init__(
         self,
         namespace: typing.Optional[str],
@@ -69,18 +73,20 @@ class ClockOrigin:
 
 
 class _UnixEpochClockOrigin:
-    pass
+    __slots__ = ()
 
 
 class _UnknownClockOrigin:
-    pass
+    __slots__ = ()
 
 
 unix_epoch_clock_origin = _UnixEpochClockOrigin()
 unknown_clock_origin = _UnknownClockOrigin()
 
 
-class _ClockClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsConst):
+class _ClockClassConst(bt2_object._CachedSharedObject, bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.clock_class_get_ref(ptr)
@@ -184,6 +190,8 @@ class _ClockClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsCo
 
 
 class _ClockClass(bt2_user_attrs._WithUserAttrs, _ClockClassConst):
+    __slots__ = ()
+
     @staticmethod
     def _borrow_user_attributes_ptr(ptr):
         return native_bt.clock_class_borrow_user_attributes(ptr)
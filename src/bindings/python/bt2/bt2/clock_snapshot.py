@@ -13,6 +13,8 @@ from bt2 import utils as bt2_utils
 
 @functools.total_ordering
 class _ClockSnapshotConst(bt2_object._UniqueObject):
+    __slots__ = ()
+
     @property
     def clock_class(self) -> bt2_clock_class._ClockClassConst:
         return bt2_clock_class._ClockClassConst._create_from_ptr_and_get_ref(
@@ -43,4 +45,4 @@ class _ClockSnapshotConst(bt2_object._UniqueObject):
 
 
 class _UnknownClockSnapshot:
-    pass
+    __slots__ = ()
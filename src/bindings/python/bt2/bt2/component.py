@@ -202,6 +202,18 @@ class _ComponentConst:
             self._bt_borrow_component_class_ptr(self._ptr), self._bt_comp_cls_type
         )
 
+    @property
+    def memory_usage(self) -> int:
+        usage, _ = native_bt.component_get_memory_usage(self._bt_as_component_ptr(self._ptr))
+        return usage
+
+    @property
+    def peak_memory_usage(self) -> int:
+        _, peak_usage = native_bt.component_get_memory_usage(
+            self._bt_as_component_ptr(self._ptr)
+        )
+        return peak_usage
+
     def __eq__(self, other: object) -> bool:
         if not hasattr(other, "addr"):
             return False
@@ -446,7 +458,8 @@ def _trim_docstring(docstring):
 #
 # It can also implement the __next__() and _user_finalize() methods
 # (again, do NOT use __del__()), which don't accept any parameters
-# other than `self`.
+# other than `self`. __next__() returns either a single message or a
+# non-empty list or tuple of messages.
 #
 # When the user-defined class is destroyed, this metaclass's __del__()
 # method is called: the native BT component class pointer is put (not
@@ -728,6 +741,24 @@ class _UserComponent(metaclass=_UserComponentType):
             self._bt_as_self_component_ptr(self._bt_ptr)
         )
 
+    def _add_memory_usage(self, delta: int):
+        bt2_utils._check_int64(delta)
+        native_bt.self_component_add_memory_usage(
+            self._bt_as_self_component_ptr(self._bt_ptr), delta
+        )
+
+    @property
+    def _graph_memory_budget(self) -> int:
+        return native_bt.self_component_get_graph_memory_budget(
+            self._bt_as_self_component_ptr(self._bt_ptr)
+        )
+
+    @property
+    def _graph_memory_usage(self) -> int:
+        return native_bt.self_component_get_graph_memory_usage(
+            self._bt_as_self_component_ptr(self._bt_ptr)
+        )
+
     def __init__(self, config, params, obj):
         pass
 
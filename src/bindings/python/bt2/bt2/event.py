@@ -16,6 +16,7 @@ typing = typing_mod._typing_mod
 
 
 class _EventConst(bt2_object._UniqueObject, collections.abc.Mapping):
+    __slots__ = ()
     _borrow_class_ptr = staticmethod(native_bt.event_borrow_class_const)
     _borrow_packet_ptr = staticmethod(native_bt.event_borrow_packet_const)
     _borrow_stream_ptr = staticmethod(native_bt.event_borrow_stream_const)
@@ -160,6 +161,7 @@ class _EventConst(bt2_object._UniqueObject, collections.abc.Mapping):
 
 
 class _Event(_EventConst):
+    __slots__ = ()
     _borrow_class_ptr = staticmethod(native_bt.event_borrow_class)
     _borrow_packet_ptr = staticmethod(native_bt.event_borrow_packet)
     _borrow_stream_ptr = staticmethod(native_bt.event_borrow_stream)
@@ -41,7 +41,9 @@ class EventClassLogLevel(enum.Enum):
     DEBUG = native_bt.EVENT_CLASS_LOG_LEVEL_DEBUG
 
 
-class _EventClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsConst):
+class _EventClassConst(bt2_object._CachedSharedObject, bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.event_class_get_ref(ptr)
@@ -131,6 +133,7 @@ class _EventClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsCo
 
 
 class _EventClass(bt2_user_attrs._WithUserAttrs, _EventClassConst):
+    __slots__ = ()
     _borrow_stream_class_ptr = staticmethod(native_bt.event_class_borrow_stream_class)
     _borrow_specific_context_field_class_ptr = staticmethod(
         native_bt.event_class_borrow_specific_context_field_class
@@ -0,0 +1,115 @@
+# SPDX-License-Identifier: MIT
+#
+# Copyright (c) 2026 EfficiOS, Inc.
+
+import collections
+
+from bt2 import event_class as bt2_event_class
+from bt2 import field_class as bt2_field_class
+from bt2 import message as bt2_message
+from bt2 import native_bt, typing_mod
+
+typing = typing_mod._typing_mod
+
+# Strings of a string column: `data[offsets[i]:offsets[i + 1]]` is the
+# UTF-8 string of the `i`th event.
+EventFieldStringColumn = collections.namedtuple("EventFieldStringColumn", ["offsets", "data"])
+
+_FieldPath = typing.Union[str, typing.Sequence[str]]
+_Column = typing.Union[memoryview, EventFieldStringColumn]
+
+
+# Returns the buffer protocol format of the values of a field of which
+# the class is `fc` (also the kind of a payload member for
+# native_bt.bt2_create_event_messages()).
+def _column_kind(fc: bt2_field_class._FieldClassConst) -> str:
+    if isinstance(fc, bt2_field_class._BoolFieldClassConst):
+        return "B"
+    elif isinstance(fc, bt2_field_class._UnsignedIntegerFieldClassConst):
+        return "Q"
+    elif isinstance(fc, bt2_field_class._SignedIntegerFieldClassConst):
+        return "q"
+    elif isinstance(fc, bt2_field_class._RealFieldClassConst):
+        return "d"
+    elif isinstance(fc, bt2_field_class._StringFieldClassConst):
+        return "s"
+
+    raise TypeError("unsupported field class type: '{}'".format(fc.__class__.__name__))
+
+
+# Returns the `(member_indexes, kind)` pair of the payload field at
+# `path` for the event class `ec`.
+def _resolve_column(ec: bt2_event_class._EventClassConst, path: _FieldPath):
+    names = (path,) if isinstance(path, str) else tuple(path)
+
+    if len(names) == 0:
+        raise ValueError("empty field path")
+
+    fc = ec.payload_field_class
+
+    if fc is None:
+        raise ValueError("event class '{}' has no payload field class".format(ec.name))
+
+    indexes = []
+
+    for name in names:
+        if not isinstance(fc, bt2_field_class._StructureFieldClassConst):
+            raise TypeError(
+                "cannot get member '{}' of a non-structure field class ('{}')".format(
+                    name, fc.__class__.__name__
+                )
+            )
+
+        for index in range(len(fc)):
+            member = fc.member_at_index(index)
+
+            if member.name == name:
+                indexes.append(index)
+                fc = member.field_class
+                break
+        else:
+            raise KeyError(name)
+
+    return tuple(indexes), _column_kind(fc)
+
+
+def extract_event_fields(
+    event_class: bt2_event_class._EventClassConst,
+    field_paths: typing.Iterable[_FieldPath],
+    messages: typing.Iterable[bt2_message._MessageConst],
+) -> typing.Dict[_FieldPath, _Column]:
+    """
+    Extracts, in one pass over `messages` without creating any field
+    object, the payload fields at `field_paths` of the events of the
+    class `event_class`, skipping any other message.
+
+    A field path is the name of a payload member or a sequence of member
+    names through nested structures.
+
+    Returns a dictionary which maps each field path to its column:
+
+    • For a boolean, integer, or real field: a flat memory view of
+      which the format is `B`, `Q`, `q`, or `d`, with one value per
+      event.
+
+    • For a string field: an `EventFieldStringColumn` object.
+
+    The memory views support the buffer protocol, so that, for example,
+    `numpy.frombuffer()` and `pyarrow.py_buffer()` wrap them without
+    copying.
+    """
+    field_paths = list(field_paths)
+    columns = [_resolve_column(event_class, path) for path in field_paths]
+    buffers = native_bt.bt2_extract_event_payload_fields(messages, event_class._ptr, columns)
+    res = {}
+
+    for path, (_, kind), buf in zip(field_paths, columns, buffers):
+        if kind == "s":
+            offsets, data = buf
+            col = EventFieldStringColumn(memoryview(offsets).cast("q"), bytes(data))
+        else:
+            col = memoryview(buf).cast(kind)
+
+        res[path if isinstance(path, str) else tuple(path)] = col
+
+    return res
@@ -50,6 +50,7 @@ def _get_leaf_field(field):
 
 
 class _FieldConst(bt2_object._UniqueObject):
+    __slots__ = ()
     _create_field_from_ptr = staticmethod(_create_field_from_const_ptr)
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         bt2_field_class._create_field_class_from_const_ptr_and_get_ref
@@ -79,6 +80,7 @@ class _FieldConst(bt2_object._UniqueObject):
 
 
 class _Field(_FieldConst):
+    __slots__ = ()
     _create_field_from_ptr = staticmethod(_create_field_from_ptr)
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         bt2_field_class._create_field_class_from_ptr_and_get_ref
@@ -91,6 +93,7 @@ class _Field(_FieldConst):
 
 
 class _BitArrayFieldConst(_FieldConst):
+    __slots__ = ()
     _NAME = "Const bit array"
 
     @property
@@ -125,6 +128,7 @@ class _BitArrayFieldConst(_FieldConst):
 
 
 class _BitArrayField(_BitArrayFieldConst, _Field):
+    __slots__ = ()
     _NAME = "Bit array"
 
     @property
@@ -139,6 +143,8 @@ class _BitArrayField(_BitArrayFieldConst, _Field):
 
 @functools.total_ordering
 class _NumericFieldConst(_FieldConst):
+    __slots__ = ()
+
     @staticmethod
     def _extract_value(other):
         if isinstance(other, _BoolFieldConst) or isinstance(other, bool):
@@ -245,6 +251,8 @@ class _NumericFieldConst(_FieldConst):
 
 
 class _NumericField(_NumericFieldConst, _Field):
+    __slots__ = ()
+
     def __hash__(self) -> int:
         # Non const field are not hashable as their value may be modified
         # without changing the underlying Python object.
@@ -252,6 +260,8 @@ class _NumericField(_NumericFieldConst, _Field):
 
 
 class _IntegralFieldConst(_NumericFieldConst, numbers.Integral):
+    __slots__ = ()
+
     def __lshift__(self, other):
         return self._value << self._extract_value(other)
 
@@ -287,10 +297,11 @@ class _IntegralFieldConst(_NumericFieldConst, numbers.Integral):
 
 
 class _IntegralField(_IntegralFieldConst, _NumericField):
-    pass
+    __slots__ = ()
 
 
 class _BoolFieldConst(_IntegralFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const boolean"
 
     @property
@@ -320,6 +331,7 @@ class _BoolFieldConst(_IntegralFieldConst, _FieldConst):
 
 
 class _BoolField(_BoolFieldConst, _IntegralField, _Field):
+    __slots__ = ()
     _NAME = "Boolean"
 
     @property
@@ -333,12 +345,16 @@ class _BoolField(_BoolFieldConst, _IntegralField, _Field):
 
 
 class _IntegerFieldConst(_IntegralFieldConst, _FieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._IntegerFieldClassConst:
         return self._cls
 
 
 class _IntegerField(_IntegerFieldConst, _IntegralField, _Field):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._IntegerFieldClass:
         return self._cls
@@ -353,6 +369,7 @@ class _IntegerField(_IntegerFieldConst, _IntegralField, _Field):
 
 
 class _UnsignedIntegerFieldConst(_IntegerFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const unsigned integer"
 
     @property
@@ -372,6 +389,7 @@ class _UnsignedIntegerFieldConst(_IntegerFieldConst, _FieldConst):
 
 
 class _UnsignedIntegerField(_UnsignedIntegerFieldConst, _IntegerField, _Field):
+    __slots__ = ()
     _NAME = "Unsigned integer"
 
     @property
@@ -395,6 +413,7 @@ class _UnsignedIntegerField(_UnsignedIntegerFieldConst, _IntegerField, _Field):
 
 
 class _SignedIntegerFieldConst(_IntegerFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const signed integer"
 
     @property
@@ -414,6 +433,7 @@ class _SignedIntegerFieldConst(_IntegerFieldConst, _FieldConst):
 
 
 class _SignedIntegerField(_SignedIntegerFieldConst, _IntegerField, _Field):
+    __slots__ = ()
     _NAME = "Signed integer"
 
     @property
@@ -437,6 +457,7 @@ class _SignedIntegerField(_SignedIntegerFieldConst, _IntegerField, _Field):
 
 
 class _RealFieldConst(_NumericFieldConst, numbers.Real):
+    __slots__ = ()
     _NAME = "Const real"
 
     @property
@@ -452,6 +473,7 @@ class _RealFieldConst(_NumericFieldConst, numbers.Real):
 
 
 class _SinglePrecisionRealFieldConst(_RealFieldConst):
+    __slots__ = ()
     _NAME = "Const single-precision real"
 
     @property
@@ -464,6 +486,7 @@ class _SinglePrecisionRealFieldConst(_RealFieldConst):
 
 
 class _DoublePrecisionRealFieldConst(_RealFieldConst):
+    __slots__ = ()
     _NAME = "Const double-precision real"
 
     @property
@@ -476,6 +499,7 @@ class _DoublePrecisionRealFieldConst(_RealFieldConst):
 
 
 class _RealField(_RealFieldConst, _NumericField):
+    __slots__ = ()
     _NAME = "Real"
 
     @property
@@ -484,6 +508,7 @@ class _RealField(_RealFieldConst, _NumericField):
 
 
 class _SinglePrecisionRealField(_SinglePrecisionRealFieldConst, _RealField):
+    __slots__ = ()
     _NAME = "Single-precision real"
 
     @property
@@ -497,6 +522,7 @@ class _SinglePrecisionRealField(_SinglePrecisionRealFieldConst, _RealField):
 
 
 class _DoublePrecisionRealField(_DoublePrecisionRealFieldConst, _RealField):
+    __slots__ = ()
     _NAME = "Double-precision real"
 
     @property
@@ -510,6 +536,8 @@ class _DoublePrecisionRealField(_DoublePrecisionRealFieldConst, _RealField):
 
 
 class _EnumerationFieldConst(_IntegerFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._EnumerationFieldClassConst:
         return self._cls
@@ -568,6 +596,7 @@ class _SignedEnumerationField(_SignedEnumerationFieldConst, _EnumerationField, _
 
 @functools.total_ordering
 class _StringFieldConst(_FieldConst):
+    __slots__ = ()
     _NAME = "Const string"
 
     @property
@@ -615,8 +644,16 @@ class _StringFieldConst(_FieldConst):
     def __len__(self) -> int:
         return native_bt.field_string_get_length(self._ptr)
 
+    # Read-only view of the UTF-8 value, without copy, which keeps this
+    # field object, and therefore its owner, alive. Changing the value
+    # of a non-const string field invalidates it.
+    @property
+    def data(self) -> memoryview:
+        return native_bt.bt2_field_string_memoryview(self, self._ptr)
+
 
 class _StringField(_StringFieldConst, _Field):
+    __slots__ = ()
     _NAME = "String"
 
     @property
@@ -642,6 +679,8 @@ class _StringField(_StringFieldConst, _Field):
 
 
 class _ContainerFieldConst(_FieldConst):
+    __slots__ = ()
+
     def __bool__(self) -> bool:
         return len(self) != 0
 
@@ -659,10 +698,11 @@ class _ContainerFieldConst(_FieldConst):
 
 
 class _ContainerField(_ContainerFieldConst, _Field):
-    pass
+    __slots__ = ()
 
 
 class _StructureFieldConst(_ContainerFieldConst, collections.abc.Mapping):
+    __slots__ = ()
     _NAME = "Const structure"
     _borrow_member_field_ptr_by_index = staticmethod(
         native_bt.field_structure_borrow_member_field_by_index_const
@@ -733,6 +773,7 @@ class _StructureFieldConst(_ContainerFieldConst, collections.abc.Mapping):
 
 
 class _StructureField(_StructureFieldConst, _ContainerField, collections.abc.MutableMapping):
+    __slots__ = ()
     _NAME = "Structure"
     _borrow_member_field_ptr_by_index = staticmethod(
         native_bt.field_structure_borrow_member_field_by_index
@@ -767,6 +808,7 @@ class _StructureField(_StructureFieldConst, _ContainerField, collections.abc.Mut
 
 
 class _OptionFieldConst(_FieldConst):
+    __slots__ = ()
     _NAME = "Const option"
     _borrow_field_ptr = staticmethod(native_bt.field_option_borrow_field_const)
 
@@ -803,6 +845,7 @@ class _OptionFieldConst(_FieldConst):
 
 
 class _OptionField(_OptionFieldConst, _Field):
+    __slots__ = ()
     _NAME = "Option"
     _borrow_field_ptr = staticmethod(native_bt.field_option_borrow_field)
 
@@ -823,18 +866,24 @@ class _OptionField(_OptionFieldConst, _Field):
 
 
 class _OptionFieldWithBoolSelectorFieldConst(_OptionFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._OptionFieldClassWithBoolSelectorFieldConst:
         return self._cls
 
 
 class _OptionFieldWithBoolSelectorField(_OptionFieldWithBoolSelectorFieldConst, _OptionField):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._OptionFieldClassWithBoolSelectorField:
         return self._cls
 
 
 class _OptionFieldWithUnsignedIntegerSelectorFieldConst(_OptionFieldConst):
+    __slots__ = ()
+
     @property
     def cls(
         self,
@@ -845,12 +894,16 @@ class _OptionFieldWithUnsignedIntegerSelectorFieldConst(_OptionFieldConst):
 class _OptionFieldWithUnsignedIntegerSelectorField(
     _OptionFieldWithUnsignedIntegerSelectorFieldConst, _OptionField
 ):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._OptionFieldClassWithUnsignedIntegerSelectorField:
         return self._cls
 
 
 class _OptionFieldWithSignedIntegerSelectorFieldConst(_OptionFieldConst):
+    __slots__ = ()
+
     @property
     def cls(
         self,
@@ -861,12 +914,15 @@ class _OptionFieldWithSignedIntegerSelectorFieldConst(_OptionFieldConst):
 class _OptionFieldWithSignedIntegerSelectorField(
     _OptionFieldWithSignedIntegerSelectorFieldConst, _OptionField
 ):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._OptionFieldClassWithSignedIntegerSelectorField:
         return self._cls
 
 
 class _VariantFieldConst(_ContainerFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const variant"
     _borrow_selected_option_field_ptr = staticmethod(
         native_bt.field_variant_borrow_selected_option_field_const
@@ -909,6 +965,7 @@ class _VariantFieldConst(_ContainerFieldConst, _FieldConst):
 
 
 class _VariantField(_VariantFieldConst, _ContainerField, _Field):
+    __slots__ = ()
     _NAME = "Variant"
     _borrow_selected_option_field_ptr = staticmethod(
         native_bt.field_variant_borrow_selected_option_field
@@ -932,6 +989,8 @@ class _VariantField(_VariantFieldConst, _ContainerField, _Field):
 
 
 class _VariantFieldWithUnsignedIntegerSelectorFieldConst(_VariantFieldConst):
+    __slots__ = ()
+
     @property
     def cls(
         self,
@@ -942,12 +1001,16 @@ class _VariantFieldWithUnsignedIntegerSelectorFieldConst(_VariantFieldConst):
 class _VariantFieldWithUnsignedIntegerSelectorField(
     _VariantFieldWithUnsignedIntegerSelectorFieldConst, _VariantField
 ):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._VariantFieldClassWithUnsignedIntegerSelector:
         return self._cls
 
 
 class _VariantFieldWithSignedIntegerSelectorFieldConst(_VariantFieldConst):
+    __slots__ = ()
+
     @property
     def cls(
         self,
@@ -958,12 +1021,15 @@ class _VariantFieldWithSignedIntegerSelectorFieldConst(_VariantFieldConst):
 class _VariantFieldWithSignedIntegerSelectorField(
     _VariantFieldWithSignedIntegerSelectorFieldConst, _VariantField
 ):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._VariantFieldClassWithSignedIntegerSelector:
         return self._cls
 
 
 class _ArrayFieldConst(_ContainerFieldConst, _FieldConst, collections.abc.Sequence):
+    __slots__ = ()
     _borrow_element_field_ptr_by_index = staticmethod(
         native_bt.field_array_borrow_element_field_by_index_const
     )
@@ -1016,8 +1082,39 @@ class _ArrayFieldConst(_ContainerFieldConst, _FieldConst, collections.abc.Sequen
     def _repr(self):
         return "[{}]".format(", ".join([repr(v) for v in self]))
 
+    # Returns a view of the values of the elements, packed in the native
+    # byte order, with the buffer protocol format:
+    #
+    #   - `B` for boolean elements.
+    #   - `Q` for unsigned integer elements.
+    #   - `q` for signed integer elements.
+    #   - `d` for real elements.
+    #
+    # The elements of an array field are distinct field objects, so this
+    # is a copy (which the returned view owns), but in a single pass
+    # without creating any Python object per element.
+    def to_memoryview(self) -> memoryview:
+        elem_fc = self.cls.element_field_class
+
+        if isinstance(elem_fc, bt2_field_class._BoolFieldClassConst):
+            kind = "B"
+        elif isinstance(elem_fc, bt2_field_class._UnsignedIntegerFieldClassConst):
+            kind = "Q"
+        elif isinstance(elem_fc, bt2_field_class._SignedIntegerFieldClassConst):
+            kind = "q"
+        elif isinstance(elem_fc, bt2_field_class._RealFieldClassConst):
+            kind = "d"
+        else:
+            raise TypeError(
+                "unsupported element field class type: '{}'".format(elem_fc.__class__.__name__)
+            )
+
+        values = native_bt.bt2_field_array_pack(self._ptr, kind)
+        return memoryview(values).cast(kind)
+
 
 class _ArrayField(_ArrayFieldConst, _ContainerField, _Field, collections.abc.MutableSequence):
+    __slots__ = ()
     _borrow_element_field_ptr_by_index = staticmethod(
         native_bt.field_array_borrow_element_field_by_index
     )
@@ -1039,6 +1136,7 @@ class _ArrayField(_ArrayFieldConst, _ContainerField, _Field, collections.abc.Mut
 
 
 class _StaticArrayFieldConst(_ArrayFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const static array"
 
     @property
@@ -1050,6 +1148,7 @@ class _StaticArrayFieldConst(_ArrayFieldConst, _FieldConst):
 
 
 class _StaticArrayField(_StaticArrayFieldConst, _ArrayField, _Field):
+    __slots__ = ()
     _NAME = "Static array"
 
     @property
@@ -1072,6 +1171,7 @@ class _StaticArrayField(_StaticArrayFieldConst, _ArrayField, _Field):
 
 
 class _DynamicArrayFieldConst(_ArrayFieldConst, _FieldConst):
+    __slots__ = ()
     _NAME = "Const dynamic array"
 
     @property
@@ -1083,6 +1183,7 @@ class _DynamicArrayFieldConst(_ArrayFieldConst, _FieldConst):
 
 
 class _DynamicArrayField(_DynamicArrayFieldConst, _ArrayField, _Field):
+    __slots__ = ()
     _NAME = "Dynamic array"
 
     @property
@@ -1109,18 +1210,24 @@ class _DynamicArrayField(_DynamicArrayFieldConst, _ArrayField, _Field):
 
 
 class _DynamicArrayFieldWithLengthFieldConst(_DynamicArrayFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicArrayFieldClassWithLengthFieldConst:
         return self._cls
 
 
 class _DynamicArrayFieldWithLengthField(_DynamicArrayFieldWithLengthFieldConst, _DynamicArrayField):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicArrayFieldClassWithLengthField:
         return self._cls
 
 
 class _BlobFieldConst(_FieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._BlobFieldClassConst:
         return self._cls
@@ -1136,19 +1243,26 @@ class _BlobFieldConst(_FieldConst):
     def _repr(self):
         return str(self.data.tobytes())
 
+    # Read-only view of the data, without copy, which keeps this field
+    # object, and therefore its owner, alive.
     @property
     def data(self) -> memoryview:
-        return native_bt.field_blob_get_data_const(self._ptr)
+        return native_bt.bt2_field_blob_memoryview(self, self._ptr, False)
 
 
 class _BlobField(_BlobFieldConst, _Field):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._BlobFieldClass:
         return self._cls
 
+    # Writable view of the data, without copy, which keeps this field
+    # object, and therefore its owner, alive. Changing the length of a
+    # dynamic blob field invalidates it.
     @property
     def data(self) -> memoryview:
-        return native_bt.field_blob_get_data(self._ptr)
+        return native_bt.bt2_field_blob_memoryview(self, self._ptr, True)
 
     @data.setter
     def data(self, data: typing.Union[bytes, bytearray, memoryview]):
@@ -1156,24 +1270,32 @@ class _BlobField(_BlobFieldConst, _Field):
 
 
 class _StaticBlobFieldConst(_BlobFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._StaticBlobFieldClassConst:
         return self._cls
 
 
 class _StaticBlobField(_StaticBlobFieldConst, _BlobField):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._StaticBlobFieldClass:
         return self._cls
 
 
 class _DynamicBlobFieldConst(_BlobFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicBlobFieldClassConst:
         return self._cls
 
 
 class _DynamicBlobField(_DynamicBlobFieldConst, _BlobField):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicBlobFieldClass:
         return self._cls
@@ -1185,12 +1307,16 @@ class _DynamicBlobField(_DynamicBlobFieldConst, _BlobField):
 
 
 class _DynamicBlobFieldWithLengthFieldConst(_DynamicBlobFieldConst):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicBlobFieldClassWithLengthFieldConst:
         return self._cls
 
 
 class _DynamicBlobFieldWithLengthField(_DynamicBlobFieldWithLengthFieldConst, _DynamicBlobField):
+    __slots__ = ()
+
     @property
     def cls(self) -> bt2_field_class._DynamicBlobFieldClassWithLengthField:
         return self._cls
@@ -48,7 +48,9 @@ class IntegerDisplayBase(enum.IntEnum):
     HEXADECIMAL = native_bt.FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_HEXADECIMAL
 
 
-class _FieldClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsConst):
+class _FieldClassConst(bt2_object._CachedSharedObject, bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.field_class_get_ref(ptr)
@@ -67,6 +69,8 @@ class _FieldClassConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsCo
 
 
 class _FieldClass(bt2_user_attrs._WithUserAttrs, _FieldClassConst):
+    __slots__ = ()
+
     @staticmethod
     def _borrow_user_attributes_ptr(ptr):
         return native_bt.field_class_borrow_user_attributes(ptr)
@@ -77,14 +81,18 @@ class _FieldClass(bt2_user_attrs._WithUserAttrs, _FieldClassConst):
 
 
 class _BoolFieldClassConst(_FieldClassConst):
+    __slots__ = ()
     _NAME = "Const boolean"
 
 
 class _BoolFieldClass(_BoolFieldClassConst, _FieldClass):
+    __slots__ = ()
     _NAME = "Boolean"
 
 
 class _BitArrayFieldClassFlagConst:
+    __slots__ = ("_label", "_ranges")
+
     def __init__(self, ptr):
         self._label = native_bt.field_class_bit_array_flag_get_label(ptr)
         self._ranges = bt2_integer_range_set.UnsignedIntegerRangeSet._create_from_ptr_and_get_ref(
@@ -101,6 +109,7 @@ class _BitArrayFieldClassFlagConst:
 
 
 class _BitArrayFieldClassConst(_FieldClassConst, typing.Mapping[str, _BitArrayFieldClassFlagConst]):
+    __slots__ = ()
     _NAME = "Const bit array"
 
     @property
@@ -148,6 +157,7 @@ class _BitArrayFieldClassConst(_FieldClassConst, typing.Mapping[str, _BitArrayFi
 
 
 class _BitArrayFieldClass(_BitArrayFieldClassConst, _FieldClass):
+    __slots__ = ()
     _NAME = "Bit array"
 
     def add_flag(
@@ -187,6 +197,8 @@ class _BitArrayFieldClass(_BitArrayFieldClassConst, _FieldClass):
 
 
 class _IntegerFieldClassConst(_FieldClassConst):
+    __slots__ = ()
+
     @property
     def field_value_range(self) -> int:
         return native_bt.field_class_integer_get_field_value_range(self._ptr)
@@ -199,6 +211,8 @@ class _IntegerFieldClassConst(_FieldClassConst):
 
 
 class _IntegerFieldClass(_FieldClass, _IntegerFieldClassConst):
+    __slots__ = ()
+
     def _set_field_value_range(self, size):
         if size < 1 or size > 64:
             raise ValueError("Value is outside valid range [1, 64] ({})".format(size))
@@ -214,48 +228,58 @@ class _IntegerFieldClass(_FieldClass, _IntegerFieldClassConst):
 
 
 class _UnsignedIntegerFieldClassConst(_IntegerFieldClassConst, _FieldClassConst):
+    __slots__ = ()
     _NAME = "Const unsigned integer"
 
 
 class _UnsignedIntegerFieldClass(_UnsignedIntegerFieldClassConst, _IntegerFieldClass, _FieldClass):
+    __slots__ = ()
     _NAME = "Unsigned integer"
 
 
 class _SignedIntegerFieldClassConst(_IntegerFieldClassConst, _FieldClassConst):
+    __slots__ = ()
     _NAME = "Const signed integer"
 
 
 class _SignedIntegerFieldClass(_SignedIntegerFieldClassConst, _IntegerFieldClass, _FieldClass):
+    __slots__ = ()
     _NAME = "Signed integer"
 
 
 class _RealFieldClassConst(_FieldClassConst):
-    pass
+    __slots__ = ()
 
 
 class _SinglePrecisionRealFieldClassConst(_RealFieldClassConst):
+    __slots__ = ()
     _NAME = "Const single-precision real"
 
 
 class _DoublePrecisionRealFieldClassConst(_RealFieldClassConst):
+    __slots__ = ()
     _NAME = "Const double-precision real"
 
 
 class _RealFieldClass(_FieldClass, _RealFieldClassConst):
-    pass
+    __slots__ = ()
 
 
 class _SinglePrecisionRealFieldClass(_RealFieldClass):
+    __slots__ = ()
     _NAME = "Single-precision real"
 
 
 class _DoublePrecisionRealFieldClass(_RealFieldClass):
+    __slots__ = ()
     _NAME = "Double-precision real"
 
 
 # an enumeration field class mapping does not have a reference count, so
 # we copy the properties here to avoid eventual memory access errors.
 class _EnumerationFieldClassMapping:
+    __slots__ = ("_label", "_ranges")
+
     def __init__(self, mapping_ptr):
         self._label = native_bt.field_class_enumeration_mapping_get_label(
             self._as_enumeration_field_class_mapping_ptr(mapping_ptr)
@@ -424,14 +448,18 @@ class _SignedEnumerationFieldClass(
 
 
 class _StringFieldClassConst(_FieldClassConst):
+    __slots__ = ()
     _NAME = "Const string"
 
 
 class _StringFieldClass(_StringFieldClassConst, _FieldClass):
+    __slots__ = ()
     _NAME = "String"
 
 
 class _StructureFieldClassMemberConst(bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ("_owning_struct_fc", "_member_ptr")
+
     @property
     def _ptr(self):
         return self._member_ptr
@@ -465,6 +493,7 @@ class _StructureFieldClassMemberConst(bt2_user_attrs._WithUserAttrsConst):
 
 
 class _StructureFieldClassMember(bt2_user_attrs._WithUserAttrs, _StructureFieldClassMemberConst):
+    __slots__ = ()
     _borrow_field_class_ptr = staticmethod(
         native_bt.field_class_structure_member_borrow_field_class
     )
@@ -483,6 +512,7 @@ class _StructureFieldClassMember(bt2_user_attrs._WithUserAttrs, _StructureFieldC
 
 
 class _StructureFieldClassConst(_FieldClassConst, collections.abc.Mapping):
+    __slots__ = ()
     _NAME = "Const structure"
     _borrow_member_ptr_by_index = staticmethod(
         native_bt.field_class_structure_borrow_member_by_index_const
@@ -524,6 +554,7 @@ class _StructureFieldClassConst(_FieldClassConst, collections.abc.Mapping):
 
 
 class _StructureFieldClass(_StructureFieldClassConst, _FieldClass):
+    __slots__ = ()
     _NAME = "Structure"
     _borrow_member_by_index = staticmethod(native_bt.field_class_structure_borrow_member_by_index)
     _borrow_member_ptr_by_name = staticmethod(native_bt.field_class_structure_borrow_member_by_name)
@@ -580,6 +611,7 @@ class _StructureFieldClass(_StructureFieldClassConst, _FieldClass):
 
 
 class _OptionFieldClassConst(_FieldClassConst):
+    __slots__ = ()
     _NAME = "Const option"
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         _create_field_class_from_const_ptr_and_get_ref
@@ -593,6 +625,7 @@ class _OptionFieldClassConst(_FieldClassConst):
 
 
 class _OptionFieldClassWithSelectorFieldConst(_OptionFieldClassConst):
+    __slots__ = ()
     _NAME = "Const option (with selector)"
 
     @property
@@ -622,6 +655,7 @@ _OptionWithSelectorFieldClassConst = _OptionFieldClassWithSelectorFieldConst
 
 
 class _OptionFieldClassWithBoolSelectorFieldConst(_OptionFieldClassWithSelectorFieldConst):
+    __slots__ = ()
     _NAME = "Const option (with boolean selector)"
 
     @property
@@ -635,6 +669,7 @@ _OptionWithBoolSelectorFieldClassConst = _OptionFieldClassWithBoolSelectorFieldC
 
 
 class _OptionFieldClassWithIntegerSelectorFieldConst(_OptionFieldClassWithSelectorFieldConst):
+    __slots__ = ()
     _NAME = "Const option (with integer selector)"
 
     @property
@@ -650,6 +685,7 @@ _OptionWithIntegerSelectorFieldClassConst = _OptionFieldClassWithIntegerSelector
 class _OptionFieldClassWithUnsignedIntegerSelectorFieldConst(
     _OptionFieldClassWithIntegerSelectorFieldConst
 ):
+    __slots__ = ()
     _NAME = "Const option (with unsigned integer selector)"
     _range_set_pycls = bt2_integer_range_set._UnsignedIntegerRangeSetConst
     _borrow_selector_ranges_ptr = staticmethod(
@@ -665,6 +701,7 @@ _OptionWithUnsignedIntegerSelectorFieldClassConst = (
 class _OptionFieldClassWithSignedIntegerSelectorFieldConst(
     _OptionFieldClassWithIntegerSelectorFieldConst
 ):
+    __slots__ = ()
     _NAME = "Const option (with signed integer selector)"
     _range_set_pycls = bt2_integer_range_set._SignedIntegerRangeSetConst
     _borrow_selector_ranges_ptr = staticmethod(
@@ -678,6 +715,7 @@ _OptionWithSignedIntegerSelectorFieldClassConst = (
 
 
 class _OptionFieldClass(_OptionFieldClassConst, _FieldClass):
+    __slots__ = ()
     _NAME = "Option"
     _borrow_field_class_ptr = staticmethod(native_bt.field_class_option_borrow_field_class)
     _create_field_class_from_ptr_and_get_ref = staticmethod(
@@ -688,6 +726,7 @@ class _OptionFieldClass(_OptionFieldClassConst, _FieldClass):
 class _OptionFieldClassWithSelectorField(
     _OptionFieldClassWithSelectorFieldConst, _OptionFieldClass
 ):
+    __slots__ = ()
     _NAME = "Option (with selector)"
 
 
@@ -697,6 +736,7 @@ _OptionWithSelectorFieldClass = _OptionFieldClassWithSelectorField
 class _OptionFieldClassWithBoolSelectorField(
     _OptionFieldClassWithBoolSelectorFieldConst, _OptionFieldClassWithSelectorField
 ):
+    __slots__ = ()
     _NAME = "Option (with boolean selector)"
 
     def _set_selector_is_reversed(self, selector_is_reversed):
@@ -712,6 +752,7 @@ _OptionWithBoolSelectorFieldClass = _OptionFieldClassWithBoolSelectorField
 class _OptionFieldClassWithIntegerSelectorField(
     _OptionFieldClassWithIntegerSelectorFieldConst, _OptionFieldClassWithSelectorField
 ):
+    __slots__ = ()
     _NAME = "Option (with integer selector)"
 
 
@@ -722,6 +763,7 @@ class _OptionFieldClassWithUnsignedIntegerSelectorField(
     _OptionFieldClassWithUnsignedIntegerSelectorFieldConst,
     _OptionFieldClassWithIntegerSelectorField,
 ):
+    __slots__ = ()
     _NAME = "Option (with unsigned integer selector)"
 
 
@@ -732,6 +774,7 @@ class _OptionFieldClassWithSignedIntegerSelectorField(
     _OptionFieldClassWithSignedIntegerSelectorFieldConst,
     _OptionFieldClassWithIntegerSelectorField,
 ):
+    __slots__ = ()
     _NAME = "Option (with signed integer selector)"
 
 
@@ -739,6 +782,8 @@ _OptionWithSignedIntegerSelectorFieldClass = _OptionFieldClassWithSignedIntegerS
 
 
 class _VariantFieldClassOptionConst(bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ("_owning_var_fc", "_opt_ptr")
+
     @property
     def _ptr(self):
         return self._opt_ptr
@@ -772,6 +817,7 @@ class _VariantFieldClassOptionConst(bt2_user_attrs._WithUserAttrsConst):
 
 
 class _VariantFieldClassOption(bt2_user_attrs._WithUserAttrs, _VariantFieldClassOptionConst):
+    __slots__ = ()
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         _create_field_class_from_ptr_and_get_ref
     )
@@ -787,6 +833,8 @@ class _VariantFieldClassOption(bt2_user_attrs._WithUserAttrs, _VariantFieldClass
 
 
 class _VariantFieldClassWithIntegerSelectorFieldOptionConst(_VariantFieldClassOptionConst):
+    __slots__ = ("_spec_ptr",)
+
     def __init__(self, owning_var_fc, spec_opt_ptr):
         self._spec_ptr = spec_opt_ptr
         super().__init__(owning_var_fc, self._as_option_ptr(spec_opt_ptr))
@@ -801,12 +849,13 @@ class _VariantFieldClassWithIntegerSelectorFieldOptionConst(_VariantFieldClassOp
 class _VariantFieldClassWithIntegerSelectorFieldOption(
     _VariantFieldClassWithIntegerSelectorFieldOptionConst, _VariantFieldClassOption
 ):
-    pass
+    __slots__ = ()
 
 
 class _VariantFieldClassWithSignedIntegerSelectorFieldOptionConst(
     _VariantFieldClassWithIntegerSelectorFieldOptionConst
 ):
+    __slots__ = ()
     _as_option_ptr = staticmethod(
         native_bt.field_class_variant_with_selector_field_integer_signed_option_as_option_const
     )
@@ -820,12 +869,13 @@ class _VariantFieldClassWithSignedIntegerSelectorFieldOption(
     _VariantFieldClassWithSignedIntegerSelectorFieldOptionConst,
     _VariantFieldClassWithIntegerSelectorFieldOption,
 ):
-    pass
+    __slots__ = ()
 
 
 class _VariantFieldClassWithUnsignedIntegerSelectorFieldOptionConst(
     _VariantFieldClassWithIntegerSelectorFieldOptionConst
 ):
+    __slots__ = ()
     _as_option_ptr = staticmethod(
         native_bt.field_class_variant_with_selector_field_integer_unsigned_option_as_option_const
     )
@@ -839,10 +889,11 @@ class _VariantFieldClassWithUnsignedIntegerSelectorFieldOption(
     _VariantFieldClassWithUnsignedIntegerSelectorFieldOptionConst,
     _VariantFieldClassWithIntegerSelectorFieldOption,
 ):
-    pass
+    __slots__ = ()
 
 
 class _VariantFieldClassConst(_FieldClassConst, collections.abc.Mapping):
+    __slots__ = ()
     _NAME = "Const variant"
     _borrow_option_ptr_by_name = staticmethod(
         native_bt.field_class_variant_borrow_option_by_name_const
@@ -911,6 +962,7 @@ class _VariantFieldClassConst(_FieldClassConst, collections.abc.Mapping):
 
 
 class _VariantFieldClass(_VariantFieldClassConst, _FieldClass, collections.abc.Mapping):
+    __slots__ = ()
     _NAME = "Variant"
     _borrow_option_ptr_by_name = staticmethod(native_bt.field_class_variant_borrow_option_by_name)
     _borrow_option_ptr_by_index = staticmethod(native_bt.field_class_variant_borrow_option_by_index)
@@ -932,6 +984,7 @@ class _VariantFieldClass(_VariantFieldClassConst, _FieldClass, collections.abc.M
 
 
 class _VariantFieldClassWithoutSelectorFieldConst(_VariantFieldClassConst):
+    __slots__ = ()
     _NAME = "Const variant (without selector)"
 
 
@@ -941,6 +994,7 @@ _VariantFieldClassWithoutSelectorConst = _VariantFieldClassWithoutSelectorFieldC
 class _VariantFieldClassWithoutSelectorField(
     _VariantFieldClassWithoutSelectorFieldConst, _VariantFieldClass
 ):
+    __slots__ = ()
     _NAME = "Variant (without selector)"
 
     def append_option(
@@ -1002,6 +1056,7 @@ _VariantFieldClassWithoutSelector = _VariantFieldClassWithoutSelectorField
 
 
 class _VariantFieldClassWithIntegerSelectorFieldConst(_VariantFieldClassConst):
+    __slots__ = ()
     _NAME = "Const variant (with selector)"
 
     def __getitem__(
@@ -1054,6 +1109,7 @@ _VariantFieldClassWithIntegerSelectorConst = _VariantFieldClassWithIntegerSelect
 class _VariantFieldClassWithIntegerSelectorField(
     _VariantFieldClassWithIntegerSelectorFieldConst, _VariantFieldClass
 ):
+    __slots__ = ()
     _NAME = "Variant (with selector)"
 
     def __getitem__(
@@ -1145,6 +1201,7 @@ _VariantFieldClassWithIntegerSelector = _VariantFieldClassWithIntegerSelectorFie
 class _VariantFieldClassWithUnsignedIntegerSelectorFieldConst(
     _VariantFieldClassWithIntegerSelectorFieldConst
 ):
+    __slots__ = ()
     _NAME = "Const variant (with unsigned integer selector)"
     _variant_option_pycls = _VariantFieldClassWithUnsignedIntegerSelectorFieldOptionConst
     _borrow_option_ptr_by_name = staticmethod(
@@ -1191,6 +1248,7 @@ class _VariantFieldClassWithUnsignedIntegerSelectorField(
     _VariantFieldClassWithUnsignedIntegerSelectorFieldConst,
     _VariantFieldClassWithIntegerSelectorField,
 ):
+    __slots__ = ()
     _NAME = "Variant (with unsigned integer selector)"
     _variant_option_pycls = _VariantFieldClassWithUnsignedIntegerSelectorFieldOption
     _as_option_ptr = staticmethod(_variant_option_pycls._as_option_ptr)
@@ -1256,6 +1314,7 @@ _VariantFieldClassWithUnsignedIntegerSelector = _VariantFieldClassWithUnsignedIn
 class _VariantFieldClassWithSignedIntegerSelectorFieldConst(
     _VariantFieldClassWithIntegerSelectorFieldConst
 ):
+    __slots__ = ()
     _NAME = "Const variant (with signed integer selector)"
     _variant_option_pycls = _VariantFieldClassWithSignedIntegerSelectorFieldOptionConst
     _borrow_option_ptr_by_name = staticmethod(
@@ -1300,6 +1359,7 @@ class _VariantFieldClassWithSignedIntegerSelectorField(
     _VariantFieldClassWithSignedIntegerSelectorFieldConst,
     _VariantFieldClassWithIntegerSelectorField,
 ):
+    __slots__ = ()
     _NAME = "Variant (with signed integer selector)"
     _variant_option_pycls = _VariantFieldClassWithSignedIntegerSelectorFieldOption
     _as_option_ptr = staticmethod(_variant_option_pycls._as_option_ptr)
@@ -1361,6 +1421,7 @@ _VariantFieldClassWithSignedIntegerSelector = _VariantFieldClassWithSignedIntege
 
 
 class _ArrayFieldClassConst(_FieldClassConst):
+    __slots__ = ()
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         _create_field_class_from_const_ptr_and_get_ref
     )
@@ -1375,6 +1436,7 @@ class _ArrayFieldClassConst(_FieldClassConst):
 
 
 class _ArrayFieldClass(_ArrayFieldClassConst, _FieldClass):
+    __slots__ = ()
     _create_field_class_from_ptr_and_get_ref = staticmethod(
         _create_field_class_from_ptr_and_get_ref
     )
@@ -1384,6 +1446,7 @@ class _ArrayFieldClass(_ArrayFieldClassConst, _FieldClass):
 
 
 class _StaticArrayFieldClassConst(_ArrayFieldClassConst):
+    __slots__ = ()
     _NAME = "Const static array"
 
     @property
@@ -1392,14 +1455,17 @@ class _StaticArrayFieldClassConst(_ArrayFieldClassConst):
 
 
 class _StaticArrayFieldClass(_StaticArrayFieldClassConst, _ArrayFieldClass):
+    __slots__ = ()
     _NAME = "Static array"
 
 
 class _DynamicArrayFieldClassConst(_ArrayFieldClassConst):
+    __slots__ = ()
     _NAME = "Const dynamic array"
 
 
 class _DynamicArrayFieldClassWithLengthFieldConst(_DynamicArrayFieldClassConst):
+    __slots__ = ()
     _NAME = "Const dynamic array (with length field)"
 
     @property
@@ -1429,12 +1495,14 @@ _DynamicArrayWithLengthFieldFieldClassConst = _DynamicArrayFieldClassWithLengthF
 
 
 class _DynamicArrayFieldClass(_DynamicArrayFieldClassConst, _ArrayFieldClass):
+    __slots__ = ()
     _NAME = "Dynamic array"
 
 
 class _DynamicArrayFieldClassWithLengthField(
     _DynamicArrayFieldClassWithLengthFieldConst, _DynamicArrayFieldClass
 ):
+    __slots__ = ()
     _NAME = "Dynamic array (with length field)"
 
 
@@ -1442,12 +1510,16 @@ _DynamicArrayWithLengthFieldFieldClass = _DynamicArrayFieldClassWithLengthField
 
 
 class _BlobFieldClassConst(_FieldClassConst):
+    __slots__ = ()
+
     @property
     def media_type(self) -> str:
         return native_bt.field_class_blob_get_media_type(self._ptr)
 
 
 class _BlobFieldClass(_BlobFieldClassConst, _FieldClass):
+    __slots__ = ()
+
     def _set_media_type(self, media_type: str):
         bt2_utils._check_str(media_type)
         bt2_utils._handle_func_status(
@@ -1456,24 +1528,28 @@ class _BlobFieldClass(_BlobFieldClassConst, _FieldClass):
 
 
 class _StaticBlobFieldClassConst(_BlobFieldClassConst):
+    __slots__ = ()
+
     @property
     def length(self) -> int:
         return native_bt.field_class_blob_static_get_length(self._ptr)
 
 
 class _StaticBlobFieldClass(_StaticBlobFieldClassConst, _BlobFieldClass):
-    pass
+    __slots__ = ()
 
 
 class _DynamicBlobFieldClassConst(_BlobFieldClassConst):
-    pass
+    __slots__ = ()
 
 
 class _DynamicBlobFieldClass(_DynamicBlobFieldClassConst, _BlobFieldClass):
-    pass
+    __slots__ = ()
 
 
 class _DynamicBlobFieldClassWithLengthFieldConst(_DynamicBlobFieldClassConst):
+    __slots__ = ()
+
     @property
     def length_field_location(self) -> bt2_field_location._FieldLocationConst:
         return bt2_field_location._FieldLocationConst._create_from_ptr_and_get_ref(
@@ -1486,7 +1562,7 @@ class _DynamicBlobFieldClassWithLengthFieldConst(_DynamicBlobFieldClassConst):
 class _DynamicBlobFieldClassWithLengthField(
     _DynamicBlobFieldClassWithLengthFieldConst, _DynamicBlobFieldClass
 ):
-    pass
+    __slots__ = ()
 
 
 _FIELD_CLASS_TYPE_TO_CONST_OBJ = {
@@ -198,6 +198,25 @@ class Graph(bt2_object._SharedObject):
         bt2_utils._check_type(interrupter, bt2_interrupter.Interrupter)
         native_bt.graph_add_interrupter(self._ptr, interrupter._ptr)
 
+    @property
+    def memory_budget(self) -> int:
+        return native_bt.graph_get_memory_budget(self._ptr)
+
+    @memory_budget.setter
+    def memory_budget(self, budget: int):
+        bt2_utils._check_uint64(budget)
+        native_bt.graph_set_memory_budget(self._ptr, budget)
+
+    @property
+    def memory_usage(self) -> int:
+        usage, _ = native_bt.graph_get_memory_usage(self._ptr)
+        return usage
+
+    @property
+    def peak_memory_usage(self) -> int:
+        _, peak_usage = native_bt.graph_get_memory_usage(self._ptr)
+        return peak_usage
+
     @property
     def default_interrupter(self) -> bt2_interrupter.Interrupter:
         return bt2_interrupter.Interrupter._create_from_ptr_and_get_ref(
@@ -19,6 +19,8 @@ def _create_from_ptr(ptr):
 
 
 class _MessageConst(bt2_object._SharedObject):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.message_get_ref(ptr)
@@ -36,20 +38,20 @@ class _MessageConst(bt2_object._SharedObject):
 
 
 class _Message(_MessageConst):
-    pass
+    __slots__ = ()
 
 
 class _MessageWithDefaultClockSnapshot:
+    __slots__ = ()
+
     def _get_default_clock_snapshot(self, borrow_clock_snapshot_ptr):
-        return bt2_clock_snapshot._ClockSnapshotConst._create_from_ptr_and_get_ref(
-            borrow_clock_snapshot_ptr(self._ptr),
-            self._ptr,
-            self._get_ref,
-            self._put_ref,
+        return bt2_clock_snapshot._ClockSnapshotConst._create_borrowed(
+            borrow_clock_snapshot_ptr(self._ptr), self
         )
 
 
 class _EventMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
+    __slots__ = ()
     _borrow_default_clock_snapshot = staticmethod(
         native_bt.message_event_borrow_default_clock_snapshot_const
     )
@@ -63,9 +65,7 @@ class _EventMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
 
     @property
     def _event(self):
-        return self._event_pycls._create_from_ptr_and_get_ref(
-            self._borrow_event(self._ptr), self._ptr, self._get_ref, self._put_ref
-        )
+        return self._event_pycls._create_borrowed(self._borrow_event(self._ptr), self)
 
     @property
     def event(self) -> bt2_event._EventConst:
@@ -73,6 +73,7 @@ class _EventMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
 
 
 class _EventMessage(_EventMessageConst, _Message):
+    __slots__ = ()
     _borrow_event = staticmethod(native_bt.message_event_borrow_event)
     _stream_pycls = property(lambda _: bt2_stream._Stream)
     _event_pycls = property(lambda _: bt2_event._Event)
@@ -83,6 +84,7 @@ class _EventMessage(_EventMessageConst, _Message):
 
 
 class _PacketMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
+    __slots__ = ()
     _packet_pycls = bt2_packet._PacketConst
 
     @property
@@ -96,10 +98,12 @@ class _PacketMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
 
 
 class _PacketMessage(_PacketMessageConst, _Message):
+    __slots__ = ()
     _packet_pycls = bt2_packet._Packet
 
 
 class _PacketBeginningMessageConst(_PacketMessageConst):
+    __slots__ = ()
     _borrow_packet = staticmethod(native_bt.message_packet_beginning_borrow_packet_const)
     _borrow_default_clock_snapshot_ptr = staticmethod(
         native_bt.message_packet_beginning_borrow_default_clock_snapshot_const
@@ -107,10 +111,12 @@ class _PacketBeginningMessageConst(_PacketMessageConst):
 
 
 class _PacketBeginningMessage(_PacketMessage):
+    __slots__ = ()
     _borrow_packet = staticmethod(native_bt.message_packet_beginning_borrow_packet)
 
 
 class _PacketEndMessageConst(_PacketMessageConst):
+    __slots__ = ()
     _borrow_packet = staticmethod(native_bt.message_packet_end_borrow_packet_const)
     _borrow_default_clock_snapshot_ptr = staticmethod(
         native_bt.message_packet_end_borrow_default_clock_snapshot_const
@@ -118,10 +124,12 @@ class _PacketEndMessageConst(_PacketMessageConst):
 
 
 class _PacketEndMessage(_PacketMessage):
+    __slots__ = ()
     _borrow_packet = staticmethod(native_bt.message_packet_end_borrow_packet)
 
 
 class _StreamMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
+    __slots__ = ()
     _stream_pycls = property(lambda _: bt2_stream._StreamConst)
 
     @property
@@ -137,12 +145,12 @@ class _StreamMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
         if status == native_bt.MESSAGE_STREAM_CLOCK_SNAPSHOT_STATE_UNKNOWN:
             return bt2_clock_snapshot._UnknownClockSnapshot()
 
-        return bt2_clock_snapshot._ClockSnapshotConst._create_from_ptr_and_get_ref(
-            snapshot_ptr, self._ptr, self._get_ref, self._put_ref
-        )
+        return bt2_clock_snapshot._ClockSnapshotConst._create_borrowed(snapshot_ptr, self)
 
 
 class _StreamMessage(_StreamMessageConst, _Message):
+    __slots__ = ()
+
     def _set_default_clock_snapshot(self, raw_value):
         bt2_utils._check_uint64(raw_value)
         self._bt_set_default_clock_snapshot(self._ptr, raw_value)
@@ -151,6 +159,7 @@ class _StreamMessage(_StreamMessageConst, _Message):
 
 
 class _StreamBeginningMessageConst(_StreamMessageConst):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_stream_beginning_borrow_stream_const)
     _borrow_default_clock_snapshot_ptr = staticmethod(
         native_bt.message_stream_beginning_borrow_default_clock_snapshot_const
@@ -158,6 +167,7 @@ class _StreamBeginningMessageConst(_StreamMessageConst):
 
 
 class _StreamBeginningMessage(_StreamMessage):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_stream_beginning_borrow_stream)
     _bt_set_default_clock_snapshot = staticmethod(
         native_bt.message_stream_beginning_set_default_clock_snapshot
@@ -165,6 +175,7 @@ class _StreamBeginningMessage(_StreamMessage):
 
 
 class _StreamEndMessageConst(_StreamMessageConst):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_stream_end_borrow_stream_const)
     _borrow_default_clock_snapshot_ptr = staticmethod(
         native_bt.message_stream_end_borrow_default_clock_snapshot_const
@@ -172,6 +183,7 @@ class _StreamEndMessageConst(_StreamMessageConst):
 
 
 class _StreamEndMessage(_StreamMessage):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_stream_end_borrow_stream)
     _bt_set_default_clock_snapshot = staticmethod(
         native_bt.message_stream_end_set_default_clock_snapshot
@@ -179,6 +191,7 @@ class _StreamEndMessage(_StreamMessage):
 
 
 class _MessageIteratorInactivityMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
+    __slots__ = ()
     _borrow_clock_snapshot_ptr = staticmethod(
         native_bt.message_message_iterator_inactivity_borrow_clock_snapshot_const
     )
@@ -191,10 +204,11 @@ class _MessageIteratorInactivityMessageConst(_MessageConst, _MessageWithDefaultC
 
 
 class _MessageIteratorInactivityMessage(_MessageIteratorInactivityMessageConst, _Message):
-    pass
+    __slots__ = ()
 
 
 class _DiscardedMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
+    __slots__ = ()
     _stream_pycls = property(lambda _: bt2_stream._StreamConst)
 
     @property
@@ -228,6 +242,7 @@ class _DiscardedMessageConst(_MessageConst, _MessageWithDefaultClockSnapshot):
 
 
 class _DiscardedMessage(_DiscardedMessageConst, _Message):
+    __slots__ = ()
     _stream_pycls = property(lambda _: bt2_stream._Stream)
 
     def _set_count(self, count):
@@ -240,6 +255,7 @@ class _DiscardedMessage(_DiscardedMessageConst, _Message):
 
 
 class _DiscardedEventsMessageConst(_DiscardedMessageConst):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_discarded_events_borrow_stream_const)
     _get_count = staticmethod(native_bt.message_discarded_events_get_count)
     _borrow_beginning_clock_snapshot_ptr = staticmethod(
@@ -255,12 +271,14 @@ class _DiscardedEventsMessageConst(_DiscardedMessageConst):
 
 
 class _DiscardedEventsMessage(_DiscardedEventsMessageConst, _DiscardedMessage):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_discarded_events_borrow_stream)
     _bt_set_count = staticmethod(native_bt.message_discarded_events_set_count)
     _item_name = "event"
 
 
 class _DiscardedPacketsMessageConst(_DiscardedMessageConst):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_discarded_packets_borrow_stream_const)
     _get_count = staticmethod(native_bt.message_discarded_packets_get_count)
     _borrow_beginning_clock_snapshot_ptr = staticmethod(
@@ -276,6 +294,7 @@ class _DiscardedPacketsMessageConst(_DiscardedMessageConst):
 
 
 class _DiscardedPacketsMessage(_DiscardedPacketsMessageConst, _DiscardedMessage):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.message_discarded_packets_borrow_stream)
     _bt_set_count = staticmethod(native_bt.message_discarded_packets_set_count)
     _item_name = "packet"
@@ -7,6 +7,7 @@ import collections.abc
 from bt2 import clock_class as bt2_clock_class
 from bt2 import error as bt2_error
 from bt2 import event_class as bt2_event_class
+from bt2 import event_field_extractor as bt2_event_field_extractor
 from bt2 import message as bt2_message
 from bt2 import native_bt, typing_mod
 from bt2 import object as bt2_object
@@ -40,7 +41,7 @@ class _UserComponentInputPortMessageIterator(bt2_object._SharedObject, _MessageI
         self._at = 0
         super().__init__(ptr)
 
-    def __next__(self) -> bt2_message._MessageConst:
+    def _fetch_msgs_if_needed(self):
         if len(self._current_msgs) == self._at:
             status, msgs = native_bt.bt2_self_component_port_input_get_msg_range(self._ptr)
             bt2_utils._handle_func_status(
@@ -49,11 +50,24 @@ class _UserComponentInputPortMessageIterator(bt2_object._SharedObject, _MessageI
             self._current_msgs = msgs
             self._at = 0
 
+    def __next__(self) -> bt2_message._MessageConst:
+        self._fetch_msgs_if_needed()
         msg_ptr = self._current_msgs[self._at]
         self._at += 1
 
         return bt2_message._create_from_ptr(msg_ptr)
 
+    # Returns all the remaining messages of the current batch, getting
+    # a new batch first if needed.
+    #
+    # This is equivalent to calling __next__() as many times, but
+    # without a method call per message.
+    def _next_batch(self) -> typing.List[bt2_message._MessageConst]:
+        self._fetch_msgs_if_needed()
+        msgs = [bt2_message._create_from_ptr(ptr) for ptr in self._current_msgs[self._at :]]
+        self._at = len(self._current_msgs)
+        return msgs
+
     def can_seek_beginning(self) -> bool:
         (status, res) = native_bt.message_iterator_can_seek_beginning(self._ptr)
         bt2_utils._handle_func_status(
@@ -116,6 +130,10 @@ class _MessageIteratorConfiguration:
 class _UserMessageIterator(_MessageIterator):
     def _bt_init_from_native(self, bt_ptr, config_ptr, self_output_port_ptr):
         self._bt_ptr = bt_ptr
+
+        # Messages of the last sequence which __next__() returned which
+        # didn't fit in the message array of the native part yet.
+        self._bt_pending_msgs = []
         self_output_port = bt2_port._create_self_from_ptr_and_get_ref(
             self_output_port_ptr, native_bt.PORT_TYPE_OUTPUT
         )
@@ -149,22 +167,50 @@ class _UserMessageIterator(_MessageIterator):
     def __next__(self) -> bt2_message._MessageConst:
         raise bt2_utils.Stop
 
-    def _bt_next_from_native(self):
+    # Returns the address of a single message, or a list of at most
+    # `capacity` message addresses.
+    #
+    # __next__() may return a message or, to get a single call per
+    # batch, a non-empty list or tuple of messages: the messages which
+    # don't fit in the message array of the native part are returned
+    # by the next calls, before calling __next__() again.
+    def _bt_next_from_native(self, capacity):
         # this can raise anything: it's caught by the native part
-        try:
-            msg = next(self)
-        except StopIteration:
-            raise bt2_utils.Stop
-        except Exception:
-            raise
+        pending_msgs = self._bt_pending_msgs
+
+        if not pending_msgs:
+            try:
+                res = next(self)
+            except StopIteration:
+                raise bt2_utils.Stop
+            except Exception:
+                raise
+
+            if not isinstance(res, (list, tuple)):
+                bt2_utils._check_type(res, bt2_message._MessageConst)
+
+                # The reference we return will be given to the message array.
+                # However, the `res` Python object may stay alive, if the user has kept
+                # a reference to it.  Acquire a new reference to account for that.
+                res._get_ref(res._ptr)
+                return int(res._ptr)
+
+            if len(res) == 0:
+                raise ValueError("__next__() returned an empty sequence of messages")
+
+            for msg in res:
+                bt2_utils._check_type(msg, bt2_message._MessageConst)
 
-        bt2_utils._check_type(msg, bt2_message._MessageConst)
+            pending_msgs.extend(res)
 
-        # The reference we return will be given to the message array.
-        # However, the `msg` Python object may stay alive, if the user has kept
-        # a reference to it.  Acquire a new reference to account for that.
-        msg._get_ref(msg._ptr)
-        return int(msg._ptr)
+        msgs = pending_msgs[:capacity]
+        del pending_msgs[:capacity]
+
+        # See the comment about the reference above.
+        for msg in msgs:
+            msg._get_ref(msg._ptr)
+
+        return [int(msg._ptr) for msg in msgs]
 
     def _bt_can_seek_beginning_from_native(self):
         # Here, we mimic the behavior of the C API:
@@ -181,6 +227,8 @@ class _UserMessageIterator(_MessageIterator):
             return hasattr(self, "_user_seek_beginning")
 
     def _bt_seek_beginning_from_native(self):
+        # Forget about pending messages, they won't be valid after seeking.
+        self._bt_pending_msgs.clear()
         self._user_seek_beginning()
 
     def _bt_can_seek_ns_from_origin_from_native(self, ns_from_origin):
@@ -201,6 +249,8 @@ class _UserMessageIterator(_MessageIterator):
             return hasattr(self, "_user_seek_ns_from_origin")
 
     def _bt_seek_ns_from_origin_from_native(self, ns_from_origin):
+        # Forget about pending messages, they won't be valid after seeking.
+        self._bt_pending_msgs.clear()
         self._user_seek_ns_from_origin(ns_from_origin)
 
     def _create_message_iterator(
@@ -265,6 +315,75 @@ class _UserMessageIterator(_MessageIterator):
 
         return bt2_message._EventMessage(ptr)
 
+    # Creates, in one native call, one event message of which the event
+    # class is `event_class` for each payload of `payloads`.
+    #
+    # Each payload is a sequence of values, one for each member of the
+    # payload structure field class, in order. The members must be
+    # boolean, integer, enumeration, real, or string fields.
+    #
+    # `payloads` may also be a NumPy structured array of which the
+    # fields match the payload members, and `default_clock_snapshots` a
+    # NumPy array of unsigned integers, with one value per payload.
+    def _create_event_messages(
+        self,
+        event_class: bt2_event_class._EventClassConst,
+        parent: typing.Union[bt2_stream._StreamConst, bt2_packet._PacketConst],
+        payloads: typing.Iterable[typing.Sequence],
+        default_clock_snapshots: typing.Optional[typing.Iterable[int]] = None,
+    ) -> typing.List[bt2_message._EventMessage]:
+        bt2_utils._check_type(event_class, bt2_event_class._EventClass)
+
+        if event_class.stream_class.supports_packets:
+            bt2_utils._check_type(parent, bt2_packet._Packet)
+            stream_ptr = None
+            packet_ptr = parent._ptr
+        else:
+            bt2_utils._check_type(parent, bt2_stream._Stream)
+            stream_ptr = parent._ptr
+            packet_ptr = None
+
+        has_default_clock_class = event_class.stream_class.default_clock_class is not None
+
+        if default_clock_snapshots is not None:
+            if not has_default_clock_class:
+                raise ValueError(
+                    "event messages in this stream must not have a default clock snapshot"
+                )
+
+            # `tolist()`: a NumPy array becomes a list of Python integers
+            default_clock_snapshots = (
+                default_clock_snapshots.tolist()
+                if hasattr(default_clock_snapshots, "tolist")
+                else list(default_clock_snapshots)
+            )
+        elif has_default_clock_class:
+            raise ValueError("event messages in this stream must have a default clock snapshot")
+
+        payload_fc = event_class.payload_field_class
+
+        if payload_fc is None:
+            raise ValueError("event class '{}' has no payload field class".format(event_class.name))
+
+        kinds = "".join(
+            bt2_event_field_extractor._column_kind(payload_fc.member_at_index(i).field_class)
+            for i in range(len(payload_fc))
+        )
+
+        # `tolist()`: a NumPy structured array becomes a list of tuples
+        # of Python objects.
+        payloads = payloads.tolist() if hasattr(payloads, "tolist") else list(payloads)
+        ptrs = native_bt.bt2_create_event_messages(
+            self._bt_ptr,
+            event_class._ptr,
+            stream_ptr,
+            packet_ptr,
+            kinds,
+            payloads,
+            default_clock_snapshots,
+        )
+        return [bt2_message._EventMessage(ptr) for ptr in ptrs]
+
     def _create_message_iterator_inactivity_message(
         self, clock_class: bt2_clock_class._ClockClassConst, clock_snapshot: int
     ) -> bt2_message._MessageIteratorInactivityMessage:
@@ -32,6 +32,7 @@
 
 /* Used by some interface files */
 #include "native_bt_bt2_objects.hpp"
+#include "native_bt_gil.hpp"
 #include "native_bt_log_and_append_error.hpp"
 %}
 
@@ -158,13 +158,19 @@ static bool bt_bt2_is_python_component_class(const bt_component_class *comp_cls)
     return bt_g_hash_table_contains(bt_cc_ptr_to_py_cls, comp_cls);
 }
 
-/* Component class proxy methods (delegate to the attached Python object) */
+/*
+ * Component class proxy methods (delegate to the attached Python object).
+ *
+ * Each method which the library calls directly acquires the GIL (see
+ * `native_bt_gil.hpp`).
+ */
 
 static bt_component_class_initialize_method_status
 component_class_init(bt_self_component *self_component, void *self_component_v,
                      swig_type_info *self_comp_cls_type_swig_type, const bt_value *params,
                      void *init_method_data)
 {
+    const bt_bt2_gil_guard gil_guard;
     const bt_component *component = bt_self_component_as_component(self_component);
     const bt_component_class *component_class = bt_component_borrow_class_const(component);
     bt_component_class_initialize_method_status status;
@@ -264,6 +270,7 @@ component_class_get_supported_mip_versions(const bt_component_class *component_c
                                            bt_logging_level log_level,
                                            bt_integer_range_set_unsigned *supported_versions)
 {
+    const bt_bt2_gil_guard gil_guard;
     uint64_t i;
     PyObject *py_cls = NULL;
     PyObject *py_params_ptr = NULL;
@@ -501,6 +508,7 @@ static void delete_port_output_user_data(bt_self_component_port_output *port_out
 
 static void component_class_source_finalize(bt_self_component_source *self_component_source)
 {
+    const bt_bt2_gil_guard gil_guard;
     uint64_t i;
     bt_self_component *self_component;
     const bt_component_source *component_source;
@@ -527,6 +535,7 @@ static void component_class_source_finalize(bt_self_component_source *self_compo
 
 static void component_class_filter_finalize(bt_self_component_filter *self_component_filter)
 {
+    const bt_bt2_gil_guard gil_guard;
     uint64_t i;
     bt_self_component *self_component;
     const bt_component_filter *component_filter;
@@ -561,6 +570,7 @@ static void component_class_filter_finalize(bt_self_component_filter *self_compo
 
 static void component_class_sink_finalize(bt_self_component_sink *self_component_sink)
 {
+    const bt_bt2_gil_guard gil_guard;
     uint64_t i;
     bt_self_component *self_component;
     const bt_component_sink *component_sink;
@@ -588,6 +598,7 @@ static bt_message_iterator_class_can_seek_beginning_method_status
 component_class_can_seek_beginning(bt_self_message_iterator *self_message_iterator,
                                    bt_bool *can_seek)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_result = NULL;
     bt_message_iterator_class_can_seek_beginning_method_status status;
     const auto py_iter =
@@ -616,6 +627,7 @@ end:
 static bt_message_iterator_class_seek_beginning_method_status
 component_class_seek_beginning(bt_self_message_iterator *self_message_iterator)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_result;
     bt_message_iterator_class_seek_beginning_method_status status;
     const auto py_iter =
@@ -644,6 +656,7 @@ static bt_message_iterator_class_can_seek_ns_from_origin_method_status
 component_class_can_seek_ns_from_origin(bt_self_message_iterator *self_message_iterator,
                                         int64_t ns_from_origin, bt_bool *can_seek)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_result = NULL;
     bt_message_iterator_class_can_seek_ns_from_origin_method_status status;
     const auto py_iter =
@@ -674,6 +687,7 @@ static bt_message_iterator_class_seek_ns_from_origin_method_status
 component_class_seek_ns_from_origin(bt_self_message_iterator *self_message_iterator,
                                     int64_t ns_from_origin)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_result;
     bt_message_iterator_class_seek_ns_from_origin_method_status status;
     const auto py_iter =
@@ -705,6 +719,7 @@ component_class_port_connected(bt_self_component *self_component, void *self_com
                                bt_port_type self_component_port_type, const void *other_port,
                                swig_type_info *other_port_swig_type)
 {
+    const bt_bt2_gil_guard gil_guard;
     bt_component_class_port_connected_method_status status;
     PyObject *py_self_port_ptr = NULL;
     PyObject *py_other_port_ptr = NULL;
@@ -804,6 +819,7 @@ component_class_sink_input_port_connected(bt_self_component_sink *self_component
 static bt_component_class_sink_graph_is_configured_method_status
 component_class_sink_graph_is_configured(bt_self_component_sink *self_component_sink)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_method_result = NULL;
     bt_component_class_sink_graph_is_configured_method_status status;
     bt_self_component *self_component =
@@ -833,6 +849,7 @@ component_class_query(const bt_component_class *component_class,
                       bt_private_query_executor *priv_query_executor, const char *object,
                       const bt_value *params, void *method_data, const bt_value **result)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_cls = NULL;
     PyObject *py_params_ptr = NULL;
     PyObject *py_priv_query_exec_ptr = NULL;
@@ -983,6 +1000,7 @@ component_class_message_iterator_init(bt_self_message_iterator *self_message_ite
                                       bt_self_message_iterator_configuration *config,
                                       bt_self_component_port_output *self_component_port_output)
 {
+    const bt_bt2_gil_guard gil_guard;
     bt_message_iterator_class_initialize_method_status status =
         BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
     PyObject *py_comp_cls = NULL;
@@ -1118,6 +1136,7 @@ end:
 
 static void component_class_message_iterator_finalize(bt_self_message_iterator *message_iterator)
 {
+    const bt_bt2_gil_guard gil_guard;
     const auto py_message_iter =
         static_cast<PyObject *>(bt_self_message_iterator_get_data(message_iterator));
     PyObject *py_method_result = NULL;
@@ -1151,13 +1170,15 @@ component_class_message_iterator_next(bt_self_message_iterator *message_iterator
                                       bt_message_array_const msgs, uint64_t capacity,
                                       uint64_t *count)
 {
+    const bt_bt2_gil_guard gil_guard;
     bt_message_iterator_class_next_method_status status;
     const auto py_message_iter =
         static_cast<PyObject *>(bt_self_message_iterator_get_data(message_iterator));
     PyObject *py_method_result = NULL;
 
     BT_ASSERT_DBG(py_message_iter);
-    py_method_result = PyObject_CallMethod(py_message_iter, "_bt_next_from_native", NULL);
+    py_method_result = PyObject_CallMethod(py_message_iter, "_bt_next_from_native", "K",
+                                           static_cast<unsigned long long>(capacity));
     if (!py_method_result) {
         status = static_cast<bt_message_iterator_class_next_method_status>(
             py_exc_to_status_message_iterator_clear(message_iterator));
@@ -1165,12 +1186,27 @@ component_class_message_iterator_next(bt_self_message_iterator *message_iterator
     }
 
     /*
-     * The returned object, on success, is an integer object
-     * (PyLong) containing the address of a native message
-     * object (which is now ours).
+     * The returned object, on success, is either an integer object
+     * (PyLong) containing the address of a native message object
+     * (which is now ours), or a list of at most `capacity` such
+     * integer objects.
      */
-    msgs[0] = static_cast<const bt_message *>(PyLong_AsVoidPtr(py_method_result));
-    *count = 1;
+    if (PyList_Check(py_method_result)) {
+        const Py_ssize_t msg_count = PyList_GET_SIZE(py_method_result);
+
+        BT_ASSERT_DBG(msg_count > 0);
+        BT_ASSERT_DBG(static_cast<uint64_t>(msg_count) <= capacity);
+
+        for (Py_ssize_t i = 0; i < msg_count; i++) {
+            msgs[i] = static_cast<const bt_message *>(
+                PyLong_AsVoidPtr(PyList_GET_ITEM(py_method_result, i)));
+        }
+
+        *count = static_cast<uint64_t>(msg_count);
+    } else {
+        msgs[0] = static_cast<const bt_message *>(PyLong_AsVoidPtr(py_method_result));
+        *count = 1;
+    }
 
     /* Overflow errors should never happen. */
     BT_ASSERT_DBG(!PyErr_Occurred());
@@ -1185,6 +1221,7 @@ end:
 static bt_component_class_sink_consume_method_status
 component_class_sink_consume(bt_self_component_sink *self_component_sink)
 {
+    const bt_bt2_gil_guard gil_guard;
     bt_self_component *self_component =
         bt_self_component_sink_as_self_component(self_component_sink);
     const auto py_comp = static_cast<PyObject *>(bt_self_component_get_data(self_component));
@@ -5,3 +5,10 @@
  */
 
 %include <babeltrace2/trace-ir/event.h>
+
+%{
+#include "native_bt_event.i.hpp"
+%}
+
+PyObject *bt_bt2_extract_event_payload_fields(PyObject *py_msgs,
+		const bt_event_class *event_class, PyObject *py_columns);
@@ -0,0 +1,213 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_EVENT_I_HPP
+#define BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_EVENT_I_HPP
+
+#include <string>
+#include <vector>
+
+/* Column of event payload field values (see bt_bt2_extract_event_payload_fields()) */
+struct bt_bt2_event_field_column
+{
+    /* Member indexes from the payload field to the field */
+    std::vector<uint64_t> member_indexes;
+
+    /* `B` (boolean), `Q` (unsigned integer), `q` (signed integer), `d` (real), or `s` (string) */
+    char kind;
+
+    /* Values (for the `B`, `Q`, `q`, and `d` kinds), one per event */
+    std::string values;
+
+    /*
+     * Offsets, within `str_data`, of the strings of the events, as
+     * signed 64-bit integers, followed with the total length of
+     * `str_data` (for the `s` kind).
+     */
+    std::vector<int64_t> str_offsets;
+
+    /* Concatenated strings, without null characters (for the `s` kind) */
+    std::string str_data;
+};
+
+template <typename ValT>
+static void append_column_value(struct bt_bt2_event_field_column& column, const ValT val)
+{
+    column.values.append(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+static void append_column_field(struct bt_bt2_event_field_column& column, const bt_field *field)
+{
+    switch (column.kind) {
+    case 'B':
+        append_column_value(column, static_cast<uint8_t>(bt_field_bool_get_value(field)));
+        break;
+    case 'Q':
+        append_column_value(column, bt_field_integer_unsigned_get_value(field));
+        break;
+    case 'q':
+        append_column_value(column, bt_field_integer_signed_get_value(field));
+        break;
+    case 'd':
+        if (bt_field_get_class_type(field) == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+            append_column_value(
+                column, static_cast<double>(bt_field_real_single_precision_get_value(field)));
+        } else {
+            append_column_value(column, bt_field_real_double_precision_get_value(field));
+        }
+
+        break;
+    case 's':
+        column.str_offsets.push_back(column.str_data.size());
+        column.str_data.append(bt_field_string_get_value(field), bt_field_string_get_length(field));
+        break;
+    default:
+        bt_common_abort();
+    }
+}
+
+/*
+ * Appends the fields of the payload of each event message of
+ * `py_msgs` (iterable of `bt2._MessageConst`) of which the class is
+ * `event_class` to columns, skipping any other message.
+ *
+ * `py_columns` is a sequence of `(member_indexes, kind)` pairs, where
+ * `member_indexes` is a tuple of indexes of structure members from the
+ * payload field to a field of which the kind is `kind` (see
+ * `struct bt_bt2_event_field_column`).
+ *
+ * Returns a list containing, for each column, a bytearray of values or,
+ * for a string column, a `(offsets, data)` tuple of bytearrays.
+ */
+static PyObject *bt_bt2_extract_event_payload_fields(PyObject *py_msgs,
+                                                     const bt_event_class *event_class,
+                                                     PyObject *py_columns)
+{
+    std::vector<struct bt_bt2_event_field_column> columns;
+    PyObject *py_iter = NULL;
+    PyObject *py_item = NULL;
+    PyObject *py_result = NULL;
+
+    /* Decode the columns */
+    const Py_ssize_t column_count = PySequence_Size(py_columns);
+
+    if (column_count < 0) {
+        return NULL;
+    }
+
+    columns.resize(column_count);
+
+    for (Py_ssize_t i = 0; i < column_count; ++i) {
+        PyObject *py_indexes;
+        int kind;
+
+        py_item = PySequence_GetItem(py_columns, i);
+        if (!py_item || !PyArg_ParseTuple(py_item, "O!C", &PyTuple_Type, &py_indexes, &kind)) {
+            goto end;
+        }
+
+        for (Py_ssize_t j = 0; j < PyTuple_GET_SIZE(py_indexes); ++j) {
+            const unsigned long long index =
+                PyLong_AsUnsignedLongLong(PyTuple_GET_ITEM(py_indexes, j));
+
+            if (PyErr_Occurred()) {
+                goto end;
+            }
+
+            columns[i].member_indexes.push_back(index);
+        }
+
+        columns[i].kind = static_cast<char>(kind);
+        Py_CLEAR(py_item);
+    }
+
+    /* Extract the fields, event by event */
+    py_iter = PyObject_GetIter(py_msgs);
+    if (!py_iter) {
+        goto end;
+    }
+
+    while ((py_item = PyIter_Next(py_iter))) {
+        PyObject *py_msg_ptr = PyObject_GetAttrString(py_item, "_ptr");
+        const bt_message *msg;
+
+        if (!py_msg_ptr) {
+            goto end;
+        }
+
+        if (!SWIG_IsOK(SWIG_ConvertPtr(py_msg_ptr, (void **) &msg, SWIGTYPE_p_bt_message, 0))) {
+            Py_DECREF(py_msg_ptr);
+            PyErr_SetString(PyExc_TypeError, "expecting a message object");
+            goto end;
+        }
+
+        Py_DECREF(py_msg_ptr);
+        Py_CLEAR(py_item);
+
+        if (bt_message_get_type(msg) != BT_MESSAGE_TYPE_EVENT) {
+            continue;
+        }
+
+        const bt_event *event = bt_message_event_borrow_event_const(msg);
+
+        if (bt_event_borrow_class_const(event) != event_class) {
+            continue;
+        }
+
+        const bt_field *payload = bt_event_borrow_payload_field_const(event);
+
+        for (auto& column : columns) {
+            const bt_field *field = payload;
+
+            for (const uint64_t index : column.member_indexes) {
+                field = bt_field_structure_borrow_member_field_by_index_const(field, index);
+            }
+
+            append_column_field(column, field);
+        }
+    }
+
+    if (PyErr_Occurred()) {
+        goto end;
+    }
+
+    /* Build the result */
+    py_result = PyList_New(column_count);
+    if (!py_result) {
+        goto end;
+    }
+
+    for (Py_ssize_t i = 0; i < column_count; ++i) {
+        auto& column = columns[i];
+        PyObject *py_column;
+
+        if (column.kind == 's') {
+            column.str_offsets.push_back(column.str_data.size());
+            py_column = Py_BuildValue(
+                "(NN)",
+                PyByteArray_FromStringAndSize(
+                    reinterpret_cast<const char *>(column.str_offsets.data()),
+                    column.str_offsets.size() * sizeof(int64_t)),
+                PyByteArray_FromStringAndSize(column.str_data.data(), column.str_data.size()));
+        } else {
+            py_column = PyByteArray_FromStringAndSize(column.values.data(), column.values.size());
+        }
+
+        if (!py_column) {
+            Py_CLEAR(py_result);
+            goto end;
+        }
+
+        PyList_SET_ITEM(py_result, i, py_column);
+    }
+
+end:
+    Py_XDECREF(py_item);
+    Py_XDECREF(py_iter);
+    return py_result;
+}
+
+#endif /* BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_EVENT_I_HPP */
@@ -28,3 +28,12 @@
 }
 
 %include <babeltrace2/trace-ir/field.h>
+
+%{
+#include "native_bt_field.i.hpp"
+%}
+
+PyObject *bt_bt2_field_blob_memoryview(PyObject *py_field, const bt_field *field,
+		int writable);
+PyObject *bt_bt2_field_string_memoryview(PyObject *py_field, const bt_field *field);
+PyObject *bt_bt2_field_array_pack(const bt_field *field, char kind);
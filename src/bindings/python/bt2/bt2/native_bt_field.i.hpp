@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_FIELD_I_HPP
+#define BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_FIELD_I_HPP
+
+#include <string>
+
+/*
+ * Buffer exporter of the data of a field.
+ *
+ * An instance keeps a strong reference on the Python field object
+ * `py_field`, which itself keeps its owner (event, packet) alive: a
+ * memoryview of an instance therefore remains valid as long as it
+ * exists, without copying the data of the field.
+ */
+struct bt_bt2_field_buffer
+{
+    PyObject_HEAD
+
+    /* Python field object owning the data (strong reference) */
+    PyObject *py_field;
+
+    /* Data */
+    void *data;
+
+    /* Length of `data` (bytes) */
+    Py_ssize_t len;
+
+    /* Whether or not `data` is read-only */
+    int readonly;
+};
+
+static int field_buffer_get_buffer(PyObject *self, Py_buffer *view, const int flags)
+{
+    const auto buf = reinterpret_cast<struct bt_bt2_field_buffer *>(self);
+
+    return PyBuffer_FillInfo(view, self, buf->data, buf->len, buf->readonly, flags);
+}
+
+static void field_buffer_dealloc(PyObject *self)
+{
+    Py_XDECREF(reinterpret_cast<struct bt_bt2_field_buffer *>(self)->py_field);
+    PyObject_Del(self);
+}
+
+static PyBufferProcs field_buffer_procs;
+static PyTypeObject field_buffer_type = {PyVarObject_HEAD_INIT(NULL, 0)};
+
+/*
+ * Returns a memoryview of the `len` bytes at `data`, which the Python
+ * field object `py_field` owns, or `NULL` on error.
+ */
+static PyObject *create_field_memoryview(PyObject *py_field, const void *data, const Py_ssize_t len,
+                                         const bool readonly)
+{
+    struct bt_bt2_field_buffer *buf;
+    PyObject *py_memoryview;
+
+    if (!(field_buffer_type.tp_flags & Py_TPFLAGS_READY)) {
+        field_buffer_procs.bf_getbuffer = field_buffer_get_buffer;
+        field_buffer_type.tp_name = "bt2._FieldBuffer";
+        field_buffer_type.tp_basicsize = sizeof(struct bt_bt2_field_buffer);
+        field_buffer_type.tp_dealloc = field_buffer_dealloc;
+        field_buffer_type.tp_flags = Py_TPFLAGS_DEFAULT;
+        field_buffer_type.tp_as_buffer = &field_buffer_procs;
+
+        if (PyType_Ready(&field_buffer_type) < 0) {
+            return NULL;
+        }
+    }
+
+    buf = PyObject_New(struct bt_bt2_field_buffer, &field_buffer_type);
+    if (!buf) {
+        return NULL;
+    }
+
+    Py_INCREF(py_field);
+    buf->py_field = py_field;
+    buf->data = const_cast<void *>(data);
+    buf->len = len;
+    buf->readonly = readonly;
+
+    /* The memoryview keeps a reference on `buf` */
+    py_memoryview = PyMemoryView_FromObject(reinterpret_cast<PyObject *>(buf));
+    Py_DECREF(buf);
+    return py_memoryview;
+}
+
+/*
+ * Returns a memoryview of the data of the blob field `field` of which
+ * the Python field object is `py_field`, writable if `writable` is
+ * true.
+ */
+static PyObject *bt_bt2_field_blob_memoryview(PyObject *py_field, const bt_field *field,
+                                              const int writable)
+{
+    return create_field_memoryview(py_field, bt_field_blob_get_data_const(field),
+                                   bt_field_blob_get_length(field), !writable);
+}
+
+/*
+ * Returns a read-only memoryview of the UTF-8 value (without the
+ * terminating null character) of the string field `field` of which
+ * the Python field object is `py_field`.
+ */
+static PyObject *bt_bt2_field_string_memoryview(PyObject *py_field, const bt_field *field)
+{
+    return create_field_memoryview(py_field, bt_field_string_get_value(field),
+                                   bt_field_string_get_length(field), true);
+}
+
+/*
+ * Returns a bytearray of the packed values of the elements of the array
+ * field `field`, each one in the native byte order, depending on
+ * `kind`:
+ *
+ * `B`:
+ *     Boolean element fields, one byte each.
+ *
+ * `Q`:
+ *     Unsigned integer element fields, 64-bit each.
+ *
+ * `q`:
+ *     Signed integer element fields, 64-bit each.
+ *
+ * `d`:
+ *     Real element fields, double precision each.
+ */
+static PyObject *bt_bt2_field_array_pack(const bt_field *field, const char kind)
+{
+    const uint64_t len = bt_field_array_get_length(field);
+    std::string values;
+
+    values.reserve(len * (kind == 'B' ? 1 : 8));
+
+    for (uint64_t i = 0; i < len; ++i) {
+        const auto elem = bt_field_array_borrow_element_field_by_index_const(field, i);
+
+        switch (kind) {
+        case 'B':
+            values.push_back(static_cast<char>(bt_field_bool_get_value(elem)));
+            break;
+        case 'Q':
+        {
+            const uint64_t val = bt_field_integer_unsigned_get_value(elem);
+
+            values.append(reinterpret_cast<const char *>(&val), sizeof(val));
+            break;
+        }
+        case 'q':
+        {
+            const int64_t val = bt_field_integer_signed_get_value(elem);
+
+            values.append(reinterpret_cast<const char *>(&val), sizeof(val));
+            break;
+        }
+        case 'd':
+        {
+            const double val =
+                bt_field_get_class_type(elem) == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL ?
+                    static_cast<double>(bt_field_real_single_precision_get_value(elem)) :
+                    bt_field_real_double_precision_get_value(elem);
+
+            values.append(reinterpret_cast<const char *>(&val), sizeof(val));
+            break;
+        }
+        default:
+            PyErr_Format(PyExc_ValueError, "invalid kind '%c'", kind);
+            return NULL;
+        }
+    }
+
+    return PyByteArray_FromStringAndSize(values.data(), values.size());
+}
+
+#endif /* BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_FIELD_I_HPP */
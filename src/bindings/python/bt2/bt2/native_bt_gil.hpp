@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_GIL_HPP
+#define BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_GIL_HPP
+
+/*
+ * The wrappers of the library functions which may run for a long time
+ * without any Python code (bt_graph_run() and
+ * bt_message_iterator_next(), for example) release the GIL so that
+ * other Python threads may run meanwhile.
+ *
+ * Therefore, any function of this module which the library calls and
+ * which uses the Python C API (component class methods, listeners)
+ * must acquire the GIL first, making sure the current thread holds it
+ * during the lifetime of a `bt_bt2_gil_guard` object declared at the
+ * beginning of the function, before any `goto`.
+ *
+ * Acquiring the GIL when it's already held by the current thread
+ * (for example, when the library calls such a function from
+ * bt_graph_add_component(), or from the CLI which never releases it)
+ * is a no-op.
+ */
+class bt_bt2_gil_guard final
+{
+public:
+    bt_bt2_gil_guard() noexcept : _mState {PyGILState_Ensure()}
+    {
+    }
+
+    bt_bt2_gil_guard(const bt_bt2_gil_guard&) = delete;
+    bt_bt2_gil_guard& operator=(const bt_bt2_gil_guard&) = delete;
+
+    ~bt_bt2_gil_guard()
+    {
+        PyGILState_Release(_mState);
+    }
+
+private:
+    PyGILState_STATE _mState;
+};
+
+#endif /* BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_GIL_HPP */
@@ -83,6 +83,23 @@
 	}
 }
 
+/*
+ * Running a graph may take a long time without any Python code (only
+ * native components): release the GIL meanwhile. The methods of Python
+ * components and the listeners acquire it again.
+ */
+%exception bt_graph_run {
+	Py_BEGIN_ALLOW_THREADS
+	$action
+	Py_END_ALLOW_THREADS
+}
+
+%exception bt_graph_run_once {
+	Py_BEGIN_ALLOW_THREADS
+	$action
+	Py_END_ALLOW_THREADS
+}
+
 %include <babeltrace2/graph/graph.h>
 
 /* Helper functions for Python */
@@ -12,6 +12,7 @@ port_added_listener(const void *component, swig_type_info *component_swig_type,
                     bt_component_class_type component_class_type, const void *port,
                     swig_type_info *port_swig_type, bt_port_type port_type, void *py_callable)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_component_ptr = NULL;
     PyObject *py_port_ptr = NULL;
     PyObject *py_res = NULL;
@@ -27,3 +27,14 @@
 }
 
 %include <babeltrace2/graph/message.h>
+
+/* Helper functions for Python */
+
+%{
+#include "native_bt_message.i.hpp"
+%}
+
+PyObject *bt_bt2_create_event_messages(bt_self_message_iterator *self_msg_iter,
+		const bt_event_class *event_class, const bt_stream *stream,
+		const bt_packet *packet, PyObject *py_kinds, PyObject *py_payloads,
+		PyObject *py_clock_snapshots);
@@ -0,0 +1,268 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_MESSAGE_I_HPP
+#define BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_MESSAGE_I_HPP
+
+/*
+ * Sets the value of the field `field`, of which the kind is `kind`
+ * (see bt_bt2_create_event_messages()), to `py_val`.
+ *
+ * Returns `false` with a Python exception set on error.
+ */
+static bool set_event_message_payload_member(bt_field *field, const char kind, PyObject *py_val)
+{
+    switch (kind) {
+    case 'B':
+    {
+        const int val = PyObject_IsTrue(py_val);
+
+        if (val < 0) {
+            return false;
+        }
+
+        bt_field_bool_set_value(field, val);
+        return true;
+    }
+    case 'Q':
+    case 'q':
+    {
+        PyObject *py_int = PyNumber_Index(py_val);
+        int overflow;
+
+        if (!py_int) {
+            return false;
+        }
+
+        const long long val = PyLong_AsLongLongAndOverflow(py_int, &overflow);
+        const uint64_t size =
+            bt_field_class_integer_get_field_value_range(bt_field_borrow_class_const(field));
+        bool in_range;
+
+        if (kind == 'Q') {
+            const unsigned long long uval = overflow > 0 ? PyLong_AsUnsignedLongLong(py_int) : val;
+
+            if (PyErr_Occurred() || overflow < 0 || (overflow == 0 && val < 0)) {
+                PyErr_Clear();
+                in_range = false;
+            } else {
+                in_range = size == 64 || uval <= (UINT64_C(1) << size) - 1;
+
+                if (in_range) {
+                    bt_field_integer_unsigned_set_value(field, uval);
+                }
+            }
+        } else {
+            in_range = overflow == 0 && !PyErr_Occurred() &&
+                       (size == 64 || (val >= -(INT64_C(1) << (size - 1)) &&
+                                       val <= (INT64_C(1) << (size - 1)) - 1));
+
+            PyErr_Clear();
+
+            if (in_range) {
+                bt_field_integer_signed_set_value(field, val);
+            }
+        }
+
+        if (!in_range) {
+            PyErr_Format(PyExc_ValueError,
+                         "payload member value %R is outside the range of its %s %llu-bit "
+                         "integer field class",
+                         py_int, kind == 'Q' ? "unsigned" : "signed",
+                         static_cast<unsigned long long>(size));
+        }
+
+        Py_DECREF(py_int);
+        return in_range;
+    }
+    case 'd':
+    {
+        const double val = PyFloat_AsDouble(py_val);
+
+        if (val == -1. && PyErr_Occurred()) {
+            return false;
+        }
+
+        if (bt_field_get_class_type(field) == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+            bt_field_real_single_precision_set_value(field, static_cast<float>(val));
+        } else {
+            bt_field_real_double_precision_set_value(field, val);
+        }
+
+        return true;
+    }
+    case 's':
+    {
+        const char *val;
+        Py_ssize_t len;
+
+        if (PyBytes_Check(py_val)) {
+            val = PyBytes_AS_STRING(py_val);
+            len = PyBytes_GET_SIZE(py_val);
+        } else {
+            val = PyUnicode_AsUTF8AndSize(py_val, &len);
+
+            if (!val) {
+                return false;
+            }
+        }
+
+        bt_field_string_clear(field);
+
+        if (bt_field_string_append_with_length(field, val, len) !=
+            BT_FIELD_STRING_APPEND_STATUS_OK) {
+            PyErr_NoMemory();
+            return false;
+        }
+
+        return true;
+    }
+    default:
+        bt_common_abort();
+    }
+}
+
+/*
+ * Creates one event message of which the event class is `event_class`
+ * for each payload of `py_payloads` (list), within `packet` if not
+ * `NULL`, or within `stream` otherwise.
+ *
+ * `py_kinds` is a string of which the characters are the kinds of the
+ * members of the payload structure field class: `B` (boolean), `Q`
+ * (unsigned integer), `q` (signed integer), `d` (real), or `s`
+ * (string).
+ *
+ * Each payload is a sequence of member values, in the order of the
+ * members of the payload structure field class.
+ *
+ * `py_clock_snapshots` is either `Py_None` or a list of default
+ * clock snapshot values, one per payload.
+ *
+ * Returns a list of SWIG pointer objects to the created event messages
+ * (new references), or `NULL` with a Python exception set on error.
+ */
+static PyObject *bt_bt2_create_event_messages(bt_self_message_iterator *self_msg_iter,
+                                              const bt_event_class *event_class,
+                                              const bt_stream *stream, const bt_packet *packet,
+                                              PyObject *py_kinds, PyObject *py_payloads,
+                                              PyObject *py_clock_snapshots)
+{
+    PyObject *py_msg_list = NULL;
+    PyObject *py_payload = NULL;
+    bt_message *msg = NULL;
+    const char *kinds;
+    Py_ssize_t member_count;
+    Py_ssize_t msg_count;
+
+    kinds = PyUnicode_AsUTF8AndSize(py_kinds, &member_count);
+    if (!kinds) {
+        goto error;
+    }
+
+    msg_count = PySequence_Fast_GET_SIZE(py_payloads);
+
+    if (py_clock_snapshots != Py_None &&
+        PySequence_Fast_GET_SIZE(py_clock_snapshots) != msg_count) {
+        PyErr_SetString(PyExc_ValueError,
+                        "the numbers of payloads and of default clock snapshots differ");
+        goto error;
+    }
+
+    py_msg_list = PyList_New(msg_count);
+    if (!py_msg_list) {
+        goto error;
+    }
+
+    for (Py_ssize_t i = 0; i < msg_count; ++i) {
+        /* Create the message */
+        if (py_clock_snapshots != Py_None) {
+            const unsigned long long cs =
+                PyLong_AsUnsignedLongLong(PySequence_Fast_GET_ITEM(py_clock_snapshots, i));
+
+            if (PyErr_Occurred()) {
+                goto error;
+            }
+
+            msg = packet ? bt_message_event_create_with_packet_and_default_clock_snapshot(
+                               self_msg_iter, event_class, packet, cs) :
+                           bt_message_event_create_with_default_clock_snapshot(
+                               self_msg_iter, event_class, stream, cs);
+        } else {
+            msg = packet ? bt_message_event_create_with_packet(self_msg_iter, event_class, packet) :
+                           bt_message_event_create(self_msg_iter, event_class, stream);
+        }
+
+        if (!msg) {
+            PyErr_NoMemory();
+            goto error;
+        }
+
+        /* Set its payload field */
+        py_payload = PySequence_Fast(PySequence_Fast_GET_ITEM(py_payloads, i),
+                                     "expecting a sequence of payload member values");
+        if (!py_payload) {
+            goto error;
+        }
+
+        if (PySequence_Fast_GET_SIZE(py_payload) != member_count) {
+            PyErr_Format(PyExc_ValueError,
+                         "expecting %zd payload member values, got %zd (payload #%zd)",
+                         member_count, PySequence_Fast_GET_SIZE(py_payload), i);
+            goto error;
+        }
+
+        bt_field *payload_field =
+            bt_event_borrow_payload_field(bt_message_event_borrow_event(msg));
+
+        for (Py_ssize_t j = 0; j < member_count; ++j) {
+            if (!set_event_message_payload_member(
+                    bt_field_structure_borrow_member_field_by_index(payload_field, j), kinds[j],
+                    PySequence_Fast_GET_ITEM(py_payload, j))) {
+                goto error;
+            }
+        }
+
+        Py_CLEAR(py_payload);
+
+        /* The SWIG pointer object takes the reference of `msg` */
+        PyObject *py_msg_ptr = SWIG_NewPointerObj(SWIG_as_voidptr(msg), SWIGTYPE_p_bt_message, 0);
+
+        if (!py_msg_ptr) {
+            goto error;
+        }
+
+        msg = NULL;
+        PyList_SET_ITEM(py_msg_list, i, py_msg_ptr);
+    }
+
+    goto end;
+
+error:
+    if (py_msg_list) {
+        /* Put the references of the messages created so far */
+        for (Py_ssize_t i = 0; i < PyList_GET_SIZE(py_msg_list); ++i) {
+            PyObject *py_msg_ptr = PyList_GET_ITEM(py_msg_list, i);
+            bt_message *created_msg;
+
+            if (!py_msg_ptr) {
+                break;
+            }
+
+            SWIG_ConvertPtr(py_msg_ptr, (void **) &created_msg, SWIGTYPE_p_bt_message, 0);
+            bt_message_put_ref(created_msg);
+        }
+
+        Py_CLEAR(py_msg_list);
+    }
+
+    bt_message_put_ref(msg);
+    Py_XDECREF(py_payload);
+
+end:
+    return py_msg_list;
+}
+
+#endif /* BABELTRACE_BINDINGS_PYTHON_BT2_BT2_NATIVE_BT_MESSAGE_I_HPP */
@@ -25,6 +25,23 @@
 	}
 }
 
+/*
+ * Seeking may consume many messages from native upstream message
+ * iterators: release the GIL meanwhile (see
+ * bt_bt2_self_component_port_input_get_msg_range()).
+ */
+%exception bt_message_iterator_seek_beginning {
+	Py_BEGIN_ALLOW_THREADS
+	$action
+	Py_END_ALLOW_THREADS
+}
+
+%exception bt_message_iterator_seek_ns_from_origin {
+	Py_BEGIN_ALLOW_THREADS
+	$action
+	Py_END_ALLOW_THREADS
+}
+
 %include <babeltrace2/graph/message-iterator.h>
 %include <babeltrace2/graph/self-message-iterator.h>
 
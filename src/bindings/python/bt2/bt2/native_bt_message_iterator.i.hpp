@@ -107,7 +107,17 @@ static PyObject *bt_bt2_self_component_port_input_get_msg_range(bt_message_itera
     uint64_t message_count = 0;
     bt_message_iterator_next_status status;
 
+    /*
+     * Release the GIL while the upstream message iterators, native
+     * ones at least, create messages: another Python thread may, for
+     * example, meanwhile process the previous batch. A Python upstream
+     * message iterator acquires it again (see
+     * component_class_message_iterator_next()).
+     */
+    Py_BEGIN_ALLOW_THREADS
     status = bt_message_iterator_next(iter, &messages, &message_count);
+    Py_END_ALLOW_THREADS
+
     return get_msg_range_common(status, messages, message_count);
 }
 
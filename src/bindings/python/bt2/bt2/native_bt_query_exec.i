@@ -5,6 +5,16 @@
  */
 
 %include <babeltrace2/graph/private-query-executor.h>
+/*
+ * Querying a native component class may take a long time (reading
+ * trace metadata, for example): release the GIL meanwhile.
+ */
+%exception bt_query_executor_query {
+	Py_BEGIN_ALLOW_THREADS
+	$action
+	Py_END_ALLOW_THREADS
+}
+
 %include <babeltrace2/graph/query-executor.h>
 
 %{
@@ -9,6 +9,7 @@
 
 static void trace_destroyed_listener(const bt_trace *trace, void *py_callable)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_trace_ptr = NULL;
     PyObject *py_res = NULL;
 
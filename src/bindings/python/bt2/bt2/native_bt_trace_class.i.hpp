@@ -9,6 +9,7 @@
 
 static void trace_class_destroyed_listener(const bt_trace_class *trace_class, void *py_callable)
 {
+    const bt_bt2_gil_guard gil_guard;
     PyObject *py_trace_class_ptr = NULL;
     PyObject *py_res = NULL;
 
@@ -4,6 +4,7 @@
 
 
 import abc
+import weakref
 
 from bt2 import typing_mod
 
@@ -11,6 +12,8 @@ typing = typing_mod._typing_mod
 
 
 class _BaseObject:
+    __slots__ = ("_ptr_internal",)
+
     # Ensure that the object always has _ptr_internal set, even if it throws during
     # construction.
 
@@ -56,6 +59,8 @@ _UniqueObjectT = typing.TypeVar("_UniqueObjectT", bound="_UniqueObject")
 
 
 class _UniqueObject(_BaseObject):
+    __slots__ = ("_owner_ptr", "_owner_get_ref", "_owner_put_ref")
+
     # Create a _UniqueObject.
     #
     #   - ptr: SWIG Object, pointer to the unique object.
@@ -63,6 +68,13 @@ class _UniqueObject(_BaseObject):
     #     object.  A new reference is acquired.
     #   - owner_get_ref: Callback to get a reference on the owner
     #   - owner_put_ref: Callback to put a reference on the owner.
+    #
+    # If `owner_get_ref` and `owner_put_ref` are `None`, then `owner_ptr`
+    # is the Python wrapper of the owner instead: the unique object is
+    # a borrowed view which keeps this wrapper, and therefore the owner,
+    # alive without any native reference count operation. Children of a
+    # borrowed view (fields of an event, for example) are also borrowed
+    # views of the same wrapper.
 
     @classmethod
     def _create_from_ptr_and_get_ref(
@@ -78,12 +90,22 @@ class _UniqueObject(_BaseObject):
         obj._owner_get_ref = owner_get_ref
         obj._owner_put_ref = owner_put_ref
 
-        obj._owner_get_ref(obj._owner_ptr)
+        if owner_get_ref is not None:
+            owner_get_ref(owner_ptr)
 
         return obj
 
+    # Create a borrowed view of the unique object `ptr` of which the
+    # owner is the Python wrapper `owner` (see
+    # _create_from_ptr_and_get_ref()).
+
+    @classmethod
+    def _create_borrowed(cls: typing.Type[_UniqueObjectT], ptr, owner) -> _UniqueObjectT:
+        return cls._create_from_ptr_and_get_ref(ptr, owner, None, None)
+
     def __del__(self):
-        self._owner_put_ref(self._owner_ptr)
+        if self._owner_put_ref is not None:
+            self._owner_put_ref(self._owner_ptr)
 
 
 # Type variable representing any sub-class of _SharedObject.
@@ -92,6 +114,8 @@ _SharedObjectT = typing.TypeVar("_SharedObjectT", bound="_SharedObject")
 
 # Python object that owns a reference to a Babeltrace object.
 class _SharedObject(_BaseObject, abc.ABC):
+    __slots__ = ()
+
     # Get a new reference on ptr.
     #
     # This must be implemented by subclasses to work correctly with a pointer
@@ -136,3 +160,61 @@ class _SharedObject(_BaseObject, abc.ABC):
 
     def __del__(self):
         self._put_ref(self._ptr_internal)
+
+
+# Live wrappers of long-lived shared objects (see _CachedSharedObject),
+# keyed by (wrapper class, native address).
+_cached_shared_objects = weakref.WeakValueDictionary()
+
+
+# Shared object of which the wrapper is cached: creating a wrapper of
+# the same class for a native object which already has a live wrapper
+# returns the latter instead of allocating a new one and acquiring a
+# new reference.
+#
+# This is for long-lived objects (trace classes, stream classes, event
+# classes, field classes, and the likes) of which the wrapper is
+# typically recreated for each message.
+#
+# Because a cached wrapper owns a reference, the native object can't be
+# destroyed, and its address reused, while the cache contains it.
+class _CachedSharedObject(_SharedObject):
+    __slots__ = ("__weakref__",)
+
+    @classmethod
+    def _create_from_ptr(cls: typing.Type[_SharedObjectT], ptr_owned) -> _SharedObjectT:
+        key = (cls, int(ptr_owned))
+        obj = _cached_shared_objects.get(key)
+
+        if obj is not None:
+            # The cached wrapper already owns a reference
+            cls._put_ref(ptr_owned)
+            return obj
+
+        obj = super()._create_from_ptr(ptr_owned)
+        _cached_shared_objects[key] = obj
+        return obj
+
+    @classmethod
+    def _create_from_ptr_and_get_ref(cls: typing.Type[_SharedObjectT], ptr) -> _SharedObjectT:
+        key = (cls, int(ptr))
+        obj = _cached_shared_objects.get(key)
+
+        if obj is not None:
+            return obj
+
+        obj = super()._create_from_ptr(ptr)
+        cls._get_ref(ptr)
+        _cached_shared_objects[key] = obj
+        return obj
+
+    def __del__(self):
+        if self._ptr_internal is not None:
+            # Forget this wrapper before putting its reference, which
+            # may destroy the native object and free its address.
+            key = (type(self), int(self._ptr_internal))
+
+            if _cached_shared_objects.get(key) is self:
+                del _cached_shared_objects[key]
+
+        super().__del__()
@@ -20,6 +20,8 @@ def _bt2_stream():
 
 
 class _PacketConst(bt2_object._SharedObject):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.packet_get_ref(ptr)
@@ -44,10 +46,11 @@ class _PacketConst(bt2_object._SharedObject):
         if field_ptr is None:
             return
 
-        return self._create_field_from_ptr(field_ptr, self._ptr, self._get_ref, self._put_ref)
+        return self._create_field_from_ptr(field_ptr, self, None, None)
 
 
 class _Packet(_PacketConst):
+    __slots__ = ()
     _borrow_stream_ptr = staticmethod(native_bt.packet_borrow_stream)
     _borrow_context_field_ptr = staticmethod(native_bt.packet_borrow_context_field)
     _stream_pycls = property(lambda _: _bt2_stream()._Stream)
@@ -22,7 +22,9 @@ def _bt2_trace():
     return bt2_trace
 
 
-class _StreamConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsConst):
+class _StreamConst(bt2_object._CachedSharedObject, bt2_user_attrs._WithUserAttrsConst):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.stream_get_ref(ptr)
@@ -61,6 +63,7 @@ class _StreamConst(bt2_object._SharedObject, bt2_user_attrs._WithUserAttrsConst)
 
 
 class _Stream(bt2_user_attrs._WithUserAttrs, _StreamConst):
+    __slots__ = ()
     _borrow_class_ptr = staticmethod(native_bt.stream_borrow_class)
 
     @staticmethod
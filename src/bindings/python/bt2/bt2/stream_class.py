@@ -26,10 +26,12 @@ def _bt2_trace_class():
 
 
 class _StreamClassConst(
-    bt2_object._SharedObject,
+    bt2_object._CachedSharedObject,
     bt2_user_attrs._WithUserAttrsConst,
     collections.abc.Mapping,
 ):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.stream_class_get_ref(ptr)
@@ -181,6 +183,8 @@ class _StreamClassConst(
 
 
 class _StreamClass(bt2_user_attrs._WithUserAttrs, _StreamClassConst):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.stream_class_get_ref(ptr)
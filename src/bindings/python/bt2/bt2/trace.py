@@ -28,6 +28,7 @@ def _bt2_trace_class():
 
 
 class _TraceEnvironmentConst(collections.abc.Mapping):
+    __slots__ = ("_trace",)
     _create_value_from_ptr_and_get_ref = staticmethod(bt2_value._create_from_const_ptr_and_get_ref)
 
     def __init__(self, trace):
@@ -56,6 +57,7 @@ class _TraceEnvironmentConst(collections.abc.Mapping):
 
 
 class _TraceEnvironment(_TraceEnvironmentConst, collections.abc.MutableMapping):
+    __slots__ = ()
     _create_value_from_ptr_and_get_ref = staticmethod(bt2_value._create_from_ptr_and_get_ref)
 
     def __setitem__(self, key: str, value: typing.Union[str, int]):
@@ -76,10 +78,12 @@ class _TraceEnvironment(_TraceEnvironmentConst, collections.abc.MutableMapping):
 
 
 class _TraceConst(
-    bt2_object._SharedObject,
+    bt2_object._CachedSharedObject,
     bt2_user_attrs._WithUserAttrsConst,
     collections.abc.Mapping,
 ):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.trace_get_ref(ptr)
@@ -187,6 +191,7 @@ class _TraceConst(
 
 
 class _Trace(bt2_user_attrs._WithUserAttrs, _TraceConst):
+    __slots__ = ()
     _borrow_stream_ptr_by_id = staticmethod(native_bt.trace_borrow_stream_by_id)
     _borrow_stream_ptr_by_index = staticmethod(native_bt.trace_borrow_stream_by_index)
     _borrow_class_ptr = staticmethod(native_bt.trace_borrow_class)
@@ -31,10 +31,12 @@ def _trace_class_destruction_listener_from_native(user_listener, handle, trace_c
 
 
 class _TraceClassConst(
-    bt2_object._SharedObject,
+    bt2_object._CachedSharedObject,
     bt2_user_attrs._WithUserAttrsConst,
     collections.abc.Mapping,
 ):
+    __slots__ = ()
+
     @staticmethod
     def _get_ref(ptr):
         native_bt.trace_class_get_ref(ptr)
@@ -132,6 +134,7 @@ _IntegerFieldClassT = typing.TypeVar(
 
 
 class _TraceClass(bt2_user_attrs._WithUserAttrs, _TraceClassConst):
+    __slots__ = ()
     _borrow_stream_class_ptr_by_index = staticmethod(
         native_bt.trace_class_borrow_stream_class_by_index
     )
@@ -2,6 +2,8 @@
 #
 # Copyright (c) 2017 Philippe Proulx <pproulx@efficios.com>
 
+import asyncio
+import collections
 import datetime
 import itertools
 import numbers
@@ -266,18 +268,28 @@ def _get_ns(obj):
     return int(s * 1e9)
 
 
+# Bounds of the delay (seconds) between two attempts to get messages
+# when the graph returns `bt2.TryAgain` during an asynchronous
+# iteration.
+_ASYNC_MIN_TRY_AGAIN_DELAY = 0.001
+_ASYNC_MAX_TRY_AGAIN_DELAY = 0.1
+
+
 class _TraceCollectionMessageIteratorProxySink(bt2_component._UserSinkComponent):
-    def __init__(self, config, params, msg_list):
-        assert type(msg_list) is list
-        self._msg_list = msg_list
+    def __init__(self, config, params, msg_queue):
+        assert type(msg_queue) is collections.deque
+        self._msg_queue = msg_queue
         self._add_input_port("in")
 
     def _user_graph_is_configured(self):
         self._msg_iter = self._create_message_iterator(self._input_ports["in"])
 
     def _user_consume(self):
-        assert self._msg_list[0] is None
-        self._msg_list[0] = next(self._msg_iter)
+        # Move a whole batch of messages at once so that the trace
+        # collection message iterator only needs to run the graph once
+        # per batch instead of once per message.
+        assert len(self._msg_queue) == 0
+        self._msg_queue.extend(self._msg_iter._next_batch())
 
 
 class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
@@ -295,7 +307,7 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
         self._stream_intersection_mode = stream_intersection_mode
         self._begin_ns = _get_ns(begin)
         self._end_ns = _get_ns(end)
-        self._msg_list = [None]
+        self._msg_queue = collections.deque()
 
         # If a single item is provided, convert to a list.
         if type(source_component_specs) in (
@@ -336,6 +348,7 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
         )
 
         self._flt_comp_specs = filter_component_specs
+        self._plugin_set = plugin_set
         self._next_suffix = 1
         self._connect_ports = False
 
@@ -394,12 +407,59 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
                 raise TypeError('"{}" object is not a ComponentSpec'.format(type(comp_spec)))
 
     def __next__(self) -> bt2_message._MessageConst:
-        assert self._msg_list[0] is None
-        self._graph.run_once()
-        msg = self._msg_list[0]
-        assert msg is not None
-        self._msg_list[0] = None
-        return msg
+        if len(self._msg_queue) == 0:
+            self._graph.run_once()
+            assert len(self._msg_queue) > 0
+
+        return self._msg_queue.popleft()
+
+    def __aiter__(self):
+        return self
+
+    # Asynchronous iteration protocol.
+    #
+    # Runs the graph in a thread of the default executor of the running
+    # event loop: the native parts of the graph run without the GIL, so
+    # that the event loop keeps running while, for example, a
+    # `source.ctf.lttng-live` component waits for the LTTng relay
+    # daemon.
+    #
+    # When the graph returns `bt2.TryAgain` (no messages available
+    # yet), waits asynchronously, with an exponential backoff which
+    # resets when new messages arrive, before trying again.
+    #
+    # Don't use this message iterator concurrently, for example with
+    # synchronous iteration.
+    async def __anext__(self) -> bt2_message._MessageConst:
+        if len(self._msg_queue) == 0:
+            loop = asyncio.get_running_loop()
+            delay = _ASYNC_MIN_TRY_AGAIN_DELAY
+
+            while True:
+                try:
+                    if not await loop.run_in_executor(None, self._run_graph_once):
+                        raise StopAsyncIteration
+
+                    break
+                except bt2_utils.TryAgain:
+                    await asyncio.sleep(delay)
+                    delay = min(delay * 2, _ASYNC_MAX_TRY_AGAIN_DELAY)
+
+            assert len(self._msg_queue) > 0
+
+        return self._msg_queue.popleft()
+
+    # Runs the graph once, returning `False` if it's done.
+    #
+    # A future can't hold a `StopIteration` exception, hence the
+    # returned value instead of `bt2.Stop`.
+    def _run_graph_once(self) -> bool:
+        try:
+            self._graph.run_once()
+        except bt2_utils.Stop:
+            return False
+
+        return True
 
     def _create_stream_intersection_trimmer(self, component, port):
         key = (component.addr, port.name)
@@ -407,8 +467,18 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
         name = "trimmer-{}-{}".format(component.name, port.name)
         return self._create_trimmer(begin, end, name)
 
+    # Returns the `utils` plugin, from the plugin set passed to the
+    # constructor, if any, to avoid finding all the plugins again.
+    def _find_utils_plugin(self):
+        if self._plugin_set is None:
+            return bt2_plugin.find_plugin("utils")
+
+        for plugin in self._plugin_set:
+            if plugin.name == "utils":
+                return plugin
+
     def _create_muxer(self):
-        plugin = bt2_plugin.find_plugin("utils")
+        plugin = self._find_utils_plugin()
 
         if plugin is None:
             raise RuntimeError('cannot find "utils" plugin (needed for the muxer)')
@@ -420,7 +490,7 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
         return self._graph.add_component(comp_cls, "muxer", {"live": 1} if self.live_mode else None)
 
     def _create_trimmer(self, begin_ns, end_ns, name):
-        plugin = bt2_plugin.find_plugin("utils")
+        plugin = self._find_utils_plugin()
 
         if plugin is None:
             raise RuntimeError('cannot find "utils" plugin (needed for the trimmer)')
@@ -584,10 +654,10 @@ class TraceCollectionMessageIterator(bt2_message_iterator._MessageIterator):
 
                 self._connect_src_comp_port(comp_and_spec.comp, out_port)
 
-        # Add the proxy sink, passing our message list to share consumed
+        # Add the proxy sink, passing our message queue to share consumed
         # messages with this trace collection message iterator.
         sink = self._graph.add_component(
-            _TraceCollectionMessageIteratorProxySink, "proxy-sink", obj=self._msg_list
+            _TraceCollectionMessageIteratorProxySink, "proxy-sink", obj=self._msg_queue
         )
         sink_in_port = sink.input_ports["in"]
 
@@ -0,0 +1,199 @@
+# SPDX-License-Identifier: MIT
+#
+# Copyright (c) 2026 EfficiOS, Inc.
+
+import collections.abc
+import concurrent.futures
+import numbers
+
+from bt2 import error as bt2_error
+from bt2 import message as bt2_message
+from bt2 import plugin as bt2_plugin
+from bt2 import trace_collection_message_iterator as bt2_tcmi
+from bt2 import typing_mod
+from bt2 import value as bt2_value
+
+typing = typing_mod._typing_mod
+
+# Plugins of this process.
+#
+# process_trace_collections() finds them before creating its worker
+# processes, so that a forked worker inherits them instead of finding
+# them again. Otherwise (`spawn` and `forkserver` start methods),
+# _init_worker() finds them once per worker process, not once per trace
+# collection.
+_plugin_set = None
+
+_Inputs = typing.Union[str, typing.Sequence[str]]
+_FilterSpec = typing.Tuple[str, str, object]
+
+
+def count_event_messages(msg_it: bt2_tcmi.TraceCollectionMessageIterator) -> typing.Dict[str, int]:
+    # Returns the number of event messages of `msg_it` per event class
+    # name.
+    counts = collections.Counter()
+
+    for msg in msg_it:
+        if type(msg) is bt2_message._EventMessageConst:
+            counts[msg.event.name] += 1
+
+    return dict(counts)
+
+
+# Returns the Python equivalent of the value object `value`.
+def _value_to_python(value: typing.Optional[bt2_value._ValueConst]):
+    if value is None:
+        return
+    elif isinstance(value, bt2_value._BoolValueConst):
+        return bool(value)
+    elif isinstance(value, bt2_value._IntegerValueConst):
+        return int(value)
+    elif isinstance(value, bt2_value._RealValueConst):
+        return float(value)
+    elif isinstance(value, bt2_value._StringValueConst):
+        return str(value)
+    elif isinstance(value, bt2_value._ArrayValueConst):
+        return [_value_to_python(elem) for elem in value]
+
+    assert isinstance(value, bt2_value._MapValueConst)
+    return {key: _value_to_python(elem) for key, elem in value.items()}
+
+
+def merge_values(a, b):
+    # Merges the results `a` and `b` (Python equivalents of value
+    # objects) of two trace collections:
+    #
+    # • Maps: union of the entries, merging the values of the common
+    #   keys.
+    # • Arrays: concatenation.
+    # • Booleans: logical OR.
+    # • Numbers: sum.
+    # • Anything else: must be equal.
+    if isinstance(a, collections.abc.Mapping) and isinstance(b, collections.abc.Mapping):
+        res = dict(a)
+
+        for key, value in b.items():
+            res[key] = merge_values(res[key], value) if key in res else value
+
+        return res
+    elif isinstance(a, list) and isinstance(b, list):
+        return a + b
+    elif isinstance(a, bool) and isinstance(b, bool):
+        return a or b
+    elif (
+        isinstance(a, numbers.Number)
+        and isinstance(b, numbers.Number)
+        and not isinstance(a, bool)
+        and not isinstance(b, bool)
+    ):
+        return a + b
+    elif a == b:
+        return a
+
+    raise ValueError("cannot merge {!r} and {!r}".format(a, b))
+
+
+def _find_component_class(plugin_name, comp_cls_name):
+    for plugin in _plugin_set or []:
+        if plugin.name != plugin_name:
+            continue
+
+        if comp_cls_name in plugin.filter_component_classes:
+            return plugin.filter_component_classes[comp_cls_name]
+
+    raise KeyError(
+        "filter component class `{}` not found in plugin `{}`".format(comp_cls_name, plugin_name)
+    )
+
+
+def _init_worker():
+    global _plugin_set
+
+    if _plugin_set is None:
+        _plugin_set = bt2_plugin.find_plugins()
+
+
+# Processes a single trace collection within a worker process.
+def _process_trace_collection(inputs, process, filter_specs, tcmi_kwargs):
+    if type(inputs) is str:
+        inputs = [inputs]
+
+    try:
+        msg_it = bt2_tcmi.TraceCollectionMessageIterator(
+            [bt2_tcmi.AutoSourceComponentSpec(input) for input in inputs],
+            [
+                bt2_tcmi.ComponentSpec(_find_component_class(plugin_name, comp_cls_name), params)
+                for plugin_name, comp_cls_name, params in filter_specs
+            ],
+            plugin_set=_plugin_set,
+            **tcmi_kwargs,
+        )
+
+        # A value object isn't picklable: convert the result to Python
+        # objects.
+        return _value_to_python(bt2_value.create_value(process(msg_it)))
+    except bt2_error._Error as exc:
+        # Neither is a `bt2._Error` object
+        raise RuntimeError(
+            "cannot process trace collection {}: {}".format(list(inputs), exc)
+        ) from None
+
+
+def process_trace_collections(
+    inputs: typing.Iterable[_Inputs],
+    process: typing.Callable[
+        [bt2_tcmi.TraceCollectionMessageIterator], bt2_value._ConvertibleToValue
+    ] = count_event_messages,
+    merge: typing.Callable[[object, object], object] = merge_values,
+    filter_component_specs: typing.Optional[typing.Iterable[_FilterSpec]] = None,
+    max_workers: typing.Optional[int] = None,
+    mp_context=None,
+    **tcmi_kwargs,
+) -> typing.Optional[bt2_value._Value]:
+    # Processes independent trace collections in parallel, merging their
+    # results.
+    #
+    # Each item of `inputs` is the input (path, URL) or sequence of
+    # inputs of a trace collection. A worker process creates a
+    # `bt2.TraceCollectionMessageIterator` object for it, with
+    # automatic source component discovery, and calls
+    # `process(msg_it)`, which returns a value object or an object
+    # which bt2.create_value() accepts.
+    #
+    # Each item of `filter_component_specs` is a
+    # `(plugin_name, component_class_name, params)` tuple to create a
+    # filter component for each trace collection
+    # (for example, `('utils', 'select', {'expression': ...})`).
+    #
+    # `process`, `merge`, and the parameters must be picklable: `process`
+    # and `merge` are, for example, module-level functions.
+    #
+    # `tcmi_kwargs` are the other keyword arguments of the
+    # `bt2.TraceCollectionMessageIterator` constructor
+    # (`stream_intersection_mode`, `begin`, and `end`, for example).
+    #
+    # Returns the value object of the results merged in the order of
+    # `inputs` with `merge(a, b)`, where `a` and `b` are Python
+    # equivalents of value objects, or `None` without any input.
+    if filter_component_specs is None:
+        filter_component_specs = []
+
+    filter_specs = [tuple(spec) for spec in filter_component_specs]
+    _init_worker()
+
+    with concurrent.futures.ProcessPoolExecutor(
+        max_workers=max_workers, mp_context=mp_context, initializer=_init_worker
+    ) as executor:
+        futures = [
+            executor.submit(
+                _process_trace_collection, coll_inputs, process, filter_specs, tcmi_kwargs
+            )
+            for coll_inputs in inputs
+        ]
+        res = None
+
+        for index, future in enumerate(futures):
+            coll_res = future.result()
+            res = coll_res if index == 0 else merge(res, coll_res)
+
+    return bt2_value.create_value(res)
@@ -9,6 +9,8 @@ from bt2 import value as bt2_value
 
 
 class _WithUserAttrsBase(abc.ABC):
+    __slots__ = ()
+
     @staticmethod
     @abc.abstractmethod
     def _borrow_user_attributes_ptr(ptr):
@@ -22,6 +24,8 @@ class _WithUserAttrsBase(abc.ABC):
 
 # Mixin class for objects with user attributes (const version).
 class _WithUserAttrsConst(_WithUserAttrsBase):
+    __slots__ = ()
+
     @property
     def user_attributes(self) -> bt2_value._MapValueConst:
         return bt2_value._MapValueConst._create_from_ptr_and_get_ref(
@@ -31,6 +35,8 @@ class _WithUserAttrsConst(_WithUserAttrsBase):
 
 # Mixin class for objects with user attributes (non-const version).
 class _WithUserAttrs(_WithUserAttrsBase, abc.ABC):
+    __slots__ = ()
+
     @property
     def user_attributes(self) -> bt2_value.MapValue:
         return bt2_value.MapValue._create_from_ptr_and_get_ref(
@@ -173,6 +173,58 @@ end:
 	return;
 }
 
+/*
+ * Parses the memory size `arg`, a number of bytes with an optional
+ * `K`, `M`, or `G` (binary) suffix, setting `*size` accordingly.
+ *
+ * Returns 0 on success, or -1 if `arg` is invalid.
+ */
+static
+int parse_memory_size(const char *arg, uint64_t *size)
+{
+	gchar *end;
+	guint64 val;
+	unsigned int shift = 0;
+
+	if (!g_ascii_isdigit(arg[0])) {
+		return -1;
+	}
+
+	errno = 0;
+	val = g_ascii_strtoull(arg, &end, 10);
+
+	if (errno != 0) {
+		return -1;
+	}
+
+	switch (*end) {
+	case '\0':
+		break;
+	case 'K':
+		shift = 10;
+		break;
+	case 'M':
+		shift = 20;
+		break;
+	case 'G':
+		shift = 30;
+		break;
+	default:
+		return -1;
+	}
+
+	if (shift > 0 && end[1] != '\0') {
+		return -1;
+	}
+
+	if (val > (UINT64_MAX >> shift)) {
+		return -1;
+	}
+
+	*size = (uint64_t) val << shift;
+	return 0;
+}
+
 static
 void print_and_indent(const char *str)
 {
@@ -832,6 +884,7 @@ enum {
 	OPT_ALLOWED_MIP_VERSIONS,
 	OPT_BASE_PARAMS,
 	OPT_BEGIN,
+	OPT_BENCHMARK,
 	OPT_CLOCK_CYCLES,
 	OPT_CLOCK_DATE,
 	OPT_CLOCK_FORCE_CORRELATE,
@@ -853,6 +906,7 @@ enum {
 	OPT_INPUT_FORMAT,
 	OPT_LIST,
 	OPT_LOG_LEVEL,
+	OPT_MEMORY_BUDGET,
 	OPT_NAMES,
 	OPT_NO_DELTA,
 	OPT_OMIT_HOME_PLUGIN_PATH,
@@ -865,6 +919,7 @@ enum {
 	OPT_RETRY_DURATION,
 	OPT_RUN_ARGS,
 	OPT_RUN_ARGS_0,
+	OPT_STATS,
 	OPT_STREAM_INTERSECTION,
 	OPT_TIMERANGE,
 	OPT_VERBOSE,
@@ -1881,6 +1936,9 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "                                    for all the following components until\n");
 	fprintf(fp, "                                    --reset-base-params is encountered\n");
 	fprintf(fp, "                                    (see the expected format of PARAMS below)\n");
+	fprintf(fp, "      --benchmark=COUNT             After a warm-up run, run the graph COUNT\n");
+	fprintf(fp, "                                    times and print a JSON benchmark report\n");
+	fprintf(fp, "                                    to the standard error\n");
 	fprintf(fp, "  -c, --component=NAME:TYPE.PLUGIN.CLS\n");
 	fprintf(fp, "                                    Instantiate the component class CLS of type\n");
 	fprintf(fp, "                                    TYPE (`source`, `filter`, or `sink`) found\n");
@@ -1890,6 +1948,8 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "                                    expected format of CONNECTION below)\n");
 	fprintf(fp, "  -l, --log-level=LVL               Set the log level of the current component to LVL\n");
 	fprintf(fp, "                                    (`N`, `T`, `D`, `I`, `W`, `E`, or `F`)\n");
+	fprintf(fp, "      --memory-budget=SIZE          Set the memory budget of the graph to SIZE\n");
+	fprintf(fp, "                                    bytes (`K`, `M`, and `G` suffixes allowed)\n");
 	fprintf(fp, "  -p, --params=PARAMS               Add initialization parameters PARAMS to the\n");
 	fprintf(fp, "                                    current component (see the expected format\n");
 	fprintf(fp, "                                    of PARAMS below)\n");
@@ -1898,6 +1958,9 @@ void print_run_usage(FILE *fp)
 	fprintf(fp, "      --retry-duration=DUR          When babeltrace2(1) needs to retry to run\n");
 	fprintf(fp, "                                    the graph later, retry in DUR µs\n");
 	fprintf(fp, "                                    (default: 100000)\n");
+	fprintf(fp, "      --stats                       Print statistics of each component to the\n");
+	fprintf(fp, "                                    standard error when the graph stops\n");
+	fprintf(fp, "                                    running\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
 	fprintf(fp, "\n");
 	fprintf(fp, "See `babeltrace2 --help` for the list of general options.\n");
@@ -1965,14 +2028,17 @@ enum bt_config_cli_args_status bt_config_run_from_args(int argc, const char *arg
 
 	static const struct argpar_opt_descr run_options[] = {
 		{ OPT_BASE_PARAMS, 'b', "base-params", true },
+		{ OPT_BENCHMARK, '\0', "benchmark", true },
 		{ OPT_COMPONENT, 'c', "component", true },
 		{ OPT_CONNECT, 'x', "connect", true },
 		{ OPT_HELP, 'h', "help", false },
 		{ OPT_LOG_LEVEL, 'l', "log-level", true },
+		{ OPT_MEMORY_BUDGET, '\0', "memory-budget", true },
 		{ OPT_PARAMS, 'p', "params", true },
 		{ OPT_RESET_BASE_PARAMS, 'r', "reset-base-params", false },
 		{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
 		{ OPT_ALLOWED_MIP_VERSIONS, 'm', "allowed-mip-versions", true },
+		{ OPT_STATS, '\0', "stats", false },
 		ARGPAR_OPT_DESCR_SENTINEL
 	};
 
@@ -2186,6 +2252,39 @@ enum bt_config_cli_args_status bt_config_run_from_args(int argc, const char *arg
 				(uint64_t) retry_duration;
 			break;
 		}
+		case OPT_STATS:
+			cfg->cmd_data.run.print_stats = true;
+			break;
+		case OPT_MEMORY_BUDGET:
+			if (parse_memory_size(arg,
+					&cfg->cmd_data.run.memory_budget)) {
+				BT_CLI_LOGE_APPEND_CAUSE(
+					"Invalid --memory-budget option's argument: expecting a size in bytes, with an optional `K`, `M`, or `G` suffix: `%s`",
+					arg);
+				goto error;
+			}
+			break;
+		case OPT_BENCHMARK: {
+			gchar *end;
+			size_t arg_len = strlen(arg);
+			long long run_count = g_ascii_strtoll(arg, &end, 10);
+
+			if (arg_len == 0 || end != (arg + arg_len)) {
+				BT_CLI_LOGE_APPEND_CAUSE(
+					"Could not parse --benchmark option's argument as an unsigned integer: `%s`",
+					arg);
+				goto error;
+			}
+
+			if (run_count <= 0) {
+				BT_CLI_LOGE_APPEND_CAUSE("--benchmark option's argument must be greater than 0: %lld",
+					run_count);
+				goto error;
+			}
+
+			cfg->cmd_data.run.benchmark_run_count = (uint64_t) run_count;
+			break;
+		}
 		case OPT_ALLOWED_MIP_VERSIONS: {
 			gchar *end;
 			size_t arg_len = strlen(arg);
@@ -2311,6 +2410,9 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "\n");
 	fprintf(fp, "  -m, --allowed-mip-versions=VER    Allow only the MIP version VER (0 or 1)\n");
 	fprintf(fp, "                                    (default: all MIP versions are allowed)\n");
+	fprintf(fp, "      --benchmark=COUNT             After a warm-up run, run the conversion\n");
+	fprintf(fp, "                                    graph COUNT times and print a JSON\n");
+	fprintf(fp, "                                    benchmark report to the standard error\n");
 	fprintf(fp, "  -c, --component=[NAME:]TYPE.PLUGIN.CLS\n");
 	fprintf(fp, "                                    Instantiate the component class CLS of type\n");
 	fprintf(fp, "                                    TYPE (`source`, `filter`, or `sink`) found\n");
@@ -2319,6 +2421,9 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "                                    NAME\n");
 	fprintf(fp, "  -l, --log-level=LVL               Set the log level of the current component to LVL\n");
 	fprintf(fp, "                                    (`N`, `T`, `D`, `I`, `W`, `E`, or `F`)\n");
+	fprintf(fp, "      --memory-budget=SIZE          Set the memory budget of the conversion\n");
+	fprintf(fp, "                                    graph to SIZE bytes (`K`, `M`, and `G`\n");
+	fprintf(fp, "                                    suffixes allowed)\n");
 	fprintf(fp, "  -p, --params=PARAMS               Add initialization parameters PARAMS to the\n");
 	fprintf(fp, "                                    current component (see the expected format\n");
 	fprintf(fp, "                                    of PARAMS below)\n");
@@ -2332,6 +2437,9 @@ void print_convert_usage(FILE *fp)
 	fprintf(fp, "      --run-args-0                  Print the equivalent arguments for the\n");
 	fprintf(fp, "                                    `run` command to the standard output,\n");
 	fprintf(fp, "                                    formatted for `xargs -0`, and quit\n");
+	fprintf(fp, "      --stats                       Print statistics of each component to the\n");
+	fprintf(fp, "                                    standard error when the graph stops\n");
+	fprintf(fp, "                                    running\n");
 	fprintf(fp, "      --stream-intersection         Only process events when all streams\n");
 	fprintf(fp, "                                    are active\n");
 	fprintf(fp, "  -h, --help                        Show this help and quit\n");
@@ -2429,6 +2537,7 @@ const struct argpar_opt_descr convert_options[] = {
 	/* id, short_name, long_name, with_arg */
 	{ OPT_ALLOWED_MIP_VERSIONS, 'm', "allowed-mip-versions", true },
 	{ OPT_BEGIN, 'b', "begin", true },
+	{ OPT_BENCHMARK, '\0', "benchmark", true },
 	{ OPT_CLOCK_CYCLES, '\0', "clock-cycles", false },
 	{ OPT_CLOCK_DATE, '\0', "clock-date", false },
 	{ OPT_CLOCK_FORCE_CORRELATE, '\0', "clock-force-correlate", false },
@@ -2447,6 +2556,7 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_HELP, 'h', "help", false },
 	{ OPT_INPUT_FORMAT, 'i', "input-format", true },
 	{ OPT_LOG_LEVEL, 'l', "log-level", true },
+	{ OPT_MEMORY_BUDGET, '\0', "memory-budget", true },
 	{ OPT_NAMES, 'n', "names", true },
 	{ OPT_DEBUG_INFO, '\0', "debug-info", false },
 	{ OPT_NO_DELTA, '\0', "no-delta", false },
@@ -2458,6 +2568,7 @@ const struct argpar_opt_descr convert_options[] = {
 	{ OPT_RETRY_DURATION, '\0', "retry-duration", true },
 	{ OPT_RUN_ARGS, '\0', "run-args", false },
 	{ OPT_RUN_ARGS_0, '\0', "run-args-0", false },
+	{ OPT_STATS, '\0', "stats", false },
 	{ OPT_STREAM_INTERSECTION, '\0', "stream-intersection", false },
 	{ OPT_TIMERANGE, '\0', "timerange", true },
 	{ OPT_VERBOSE, 'v', "verbose", false },
@@ -3727,6 +3838,37 @@ enum bt_config_cli_args_status bt_config_convert_from_args(int argc,
 					goto error;
 				}
 
+				if (bt_value_array_append_string_element(run_args, arg)) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
+			case OPT_STATS:
+				if (bt_value_array_append_string_element(run_args,
+						"--stats")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
+			case OPT_MEMORY_BUDGET:
+				if (bt_value_array_append_string_element(run_args,
+						"--memory-budget")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+
+				if (bt_value_array_append_string_element(run_args, arg)) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+				break;
+			case OPT_BENCHMARK:
+				if (bt_value_array_append_string_element(run_args,
+						"--benchmark")) {
+					BT_CLI_LOGE_APPEND_CAUSE_OOM();
+					goto error;
+				}
+
 				if (bt_value_array_append_string_element(run_args, arg)) {
 					BT_CLI_LOGE_APPEND_CAUSE_OOM();
 					goto error;
@@ -4113,6 +4255,9 @@ enum bt_config_cli_args_status bt_config_convert_from_args(int argc,
 		case OPT_PARAMS:
 		case OPT_PLUGIN_PATH:
 		case OPT_RETRY_DURATION:
+		case OPT_STATS:
+		case OPT_BENCHMARK:
+		case OPT_MEMORY_BUDGET:
 			/* Ignore in this pass */
 			break;
 		default:
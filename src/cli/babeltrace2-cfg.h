@@ -82,6 +82,22 @@ struct bt_config {
 			 * intersection of its streams.
 			 */
 			bool stream_intersection_mode;
+
+			/*
+			 * Whether or not to print the statistics of the
+			 * components when the graph stops running.
+			 */
+			bool print_stats;
+
+			/* Memory budget of the graph (bytes), or 0 if none */
+			uint64_t memory_budget;
+
+			/*
+			 * Number of measured runs of the graph, after a
+			 * warm-up run, or 0 to run the graph once without
+			 * benchmarking it.
+			 */
+			uint64_t benchmark_run_count;
 		} run;
 
 		/* BT_CONFIG_COMMAND_HELP */
@@ -19,6 +19,11 @@
 #include <inttypes.h>
 #include <unistd.h>
 #include <signal.h>
+
+#ifndef __MINGW32__
+# include <sys/resource.h>
+#endif
+
 #include "babeltrace2-cfg.h"
 #include "babeltrace2-cfg-cli-args.h"
 #include "babeltrace2-cfg-cli-args-default.h"
@@ -1937,6 +1942,11 @@ int cmd_run_ctx_init(struct cmd_run_ctx *ctx, struct bt_config *cfg)
 		goto error;
 	}
 
+	if (cfg->cmd_data.run.memory_budget > 0) {
+		bt_graph_set_memory_budget(ctx->graph,
+			cfg->cmd_data.run.memory_budget);
+	}
+
 	bt_graph_add_interrupter(ctx->graph, the_interrupter);
 	add_listener_status = bt_graph_add_source_component_output_port_added_listener(
 		ctx->graph, graph_source_output_port_added_listener, ctx,
@@ -2497,10 +2507,322 @@ end:
 }
 
 static
-enum bt_cmd_status cmd_run(struct bt_config *cfg)
+void print_comp_stats(const bt_component *comp)
+{
+	uint64_t call_count, msg_count, inclusive_ns, exclusive_ns;
+	uint64_t mem_usage, peak_mem_usage;
+
+	bt_component_get_statistics(comp, &call_count, &msg_count,
+		&inclusive_ns, &exclusive_ns);
+	bt_component_get_memory_usage(comp, &mem_usage, &peak_mem_usage);
+	fprintf(stderr, "%-24s %6s %12" PRIu64 " %12" PRIu64 " %14.3f %14.3f %12" PRIu64 " %12" PRIu64 "\n",
+		bt_component_get_name(comp),
+		bt_common_component_class_type_string(
+			bt_component_get_class_type(comp)),
+		call_count, msg_count, (double) inclusive_ns / 1e6,
+		(double) exclusive_ns / 1e6, mem_usage / 1024,
+		peak_mem_usage / 1024);
+}
+
+static
+void print_comps_stats(GHashTable *comps, bt_component_class_type type)
+{
+	GHashTableIter iter;
+	gpointer key, value;
+
+	g_hash_table_iter_init(&iter, comps);
+
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		const bt_component *comp;
+
+		switch (type) {
+		case BT_COMPONENT_CLASS_TYPE_SOURCE:
+			comp = bt_component_source_as_component_const(value);
+			break;
+		case BT_COMPONENT_CLASS_TYPE_FILTER:
+			comp = bt_component_filter_as_component_const(value);
+			break;
+		case BT_COMPONENT_CLASS_TYPE_SINK:
+			comp = bt_component_sink_as_component_const(value);
+			break;
+		default:
+			bt_common_abort();
+		}
+
+		print_comp_stats(comp);
+	}
+}
+
+static
+void print_stats(struct cmd_run_ctx *ctx)
+{
+	uint64_t mem_usage, peak_mem_usage;
+	uint64_t mem_budget = bt_graph_get_memory_budget(ctx->graph);
+
+	fprintf(stderr, "%-24s %6s %12s %12s %14s %14s %12s %12s\n",
+		"Component", "Type", "Calls", "Messages", "Inclusive (ms)",
+		"Exclusive (ms)", "Mem. (KiB)", "Peak (KiB)");
+	print_comps_stats(ctx->src_components, BT_COMPONENT_CLASS_TYPE_SOURCE);
+	print_comps_stats(ctx->flt_components, BT_COMPONENT_CLASS_TYPE_FILTER);
+	print_comps_stats(ctx->sink_components, BT_COMPONENT_CLASS_TYPE_SINK);
+	bt_graph_get_memory_usage(ctx->graph, &mem_usage, &peak_mem_usage);
+	fprintf(stderr, "Reported memory (KiB): current=%" PRIu64
+		", peak=%" PRIu64, mem_usage / 1024, peak_mem_usage / 1024);
+
+	if (mem_budget > 0) {
+		fprintf(stderr, ", budget=%" PRIu64, mem_budget / 1024);
+	}
+
+	fprintf(stderr, "\n");
+}
+
+/* Accumulated statistics of a component over the benchmark runs */
+struct bench_comp_stats {
+	/* Owned by this */
+	gchar *name;
+
+	bt_component_class_type type;
+	uint64_t call_count;
+	uint64_t msg_count;
+	uint64_t inclusive_ns;
+	uint64_t exclusive_ns;
+};
+
+/* Results of `--benchmark` */
+struct bench {
+	/* Whether or not the current run is the warm-up run */
+	bool warming_up;
+
+	/* Array of `uint64_t`: duration (µs) of each measured run */
+	GArray *run_durations_us;
+
+	/*
+	 * Array of `uint64_t`: number of messages which the source
+	 * components returned during each measured run
+	 */
+	GArray *run_msg_counts;
+
+	/*
+	 * Array of `struct bench_comp_stats`, in order of first
+	 * appearance
+	 */
+	GArray *comps_stats;
+};
+
+static
+struct bench_comp_stats *bench_borrow_comp_stats(struct bench *bench,
+		const char *name, bt_component_class_type type)
+{
+	struct bench_comp_stats new_comp_stats = { 0 };
+	guint i;
+
+	for (i = 0; i < bench->comps_stats->len; i++) {
+		struct bench_comp_stats *comp_stats = &bt_g_array_index(
+			bench->comps_stats, struct bench_comp_stats, i);
+
+		if (comp_stats->type == type &&
+				strcmp(comp_stats->name, name) == 0) {
+			return comp_stats;
+		}
+	}
+
+	new_comp_stats.name = g_strdup(name);
+	new_comp_stats.type = type;
+	g_array_append_val(bench->comps_stats, new_comp_stats);
+	return &bt_g_array_index(bench->comps_stats, struct bench_comp_stats,
+		bench->comps_stats->len - 1);
+}
+
+/*
+ * Adds the statistics of the components `comps` of type `type` to
+ * `bench`, adding the number of messages which they returned to
+ * `*msg_count`.
+ */
+static
+void bench_add_comps_stats(struct bench *bench, GHashTable *comps,
+		bt_component_class_type type, uint64_t *msg_count)
+{
+	GHashTableIter iter;
+	gpointer key, value;
+
+	g_hash_table_iter_init(&iter, comps);
+
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		const bt_component *comp;
+		struct bench_comp_stats *comp_stats;
+		uint64_t call_count, comp_msg_count, inclusive_ns, exclusive_ns;
+
+		switch (type) {
+		case BT_COMPONENT_CLASS_TYPE_SOURCE:
+			comp = bt_component_source_as_component_const(value);
+			break;
+		case BT_COMPONENT_CLASS_TYPE_FILTER:
+			comp = bt_component_filter_as_component_const(value);
+			break;
+		case BT_COMPONENT_CLASS_TYPE_SINK:
+			comp = bt_component_sink_as_component_const(value);
+			break;
+		default:
+			bt_common_abort();
+		}
+
+		bt_component_get_statistics(comp, &call_count, &comp_msg_count,
+			&inclusive_ns, &exclusive_ns);
+		comp_stats = bench_borrow_comp_stats(bench,
+			bt_component_get_name(comp), type);
+		comp_stats->call_count += call_count;
+		comp_stats->msg_count += comp_msg_count;
+		comp_stats->inclusive_ns += inclusive_ns;
+		comp_stats->exclusive_ns += exclusive_ns;
+		*msg_count += comp_msg_count;
+	}
+}
+
+/*
+ * Records a successful run of the graph of `ctx`, which lasted
+ * `duration_us` µs, unless it's the warm-up run.
+ */
+static
+void bench_add_run(struct bench *bench, struct cmd_run_ctx *ctx,
+		uint64_t duration_us)
+{
+	uint64_t msg_count = 0;
+	uint64_t unused_msg_count = 0;
+
+	if (bench->warming_up) {
+		return;
+	}
+
+	g_array_append_val(bench->run_durations_us, duration_us);
+	bench_add_comps_stats(bench, ctx->src_components,
+		BT_COMPONENT_CLASS_TYPE_SOURCE, &msg_count);
+	bench_add_comps_stats(bench, ctx->flt_components,
+		BT_COMPONENT_CLASS_TYPE_FILTER, &unused_msg_count);
+	bench_add_comps_stats(bench, ctx->sink_components,
+		BT_COMPONENT_CLASS_TYPE_SINK, &unused_msg_count);
+	g_array_append_val(bench->run_msg_counts, msg_count);
+}
+
+static
+void print_json_str(FILE *fp, const char *str)
+{
+	const char *ch;
+
+	fputc('"', fp);
+
+	for (ch = str; *ch != '\0'; ch++) {
+		if (*ch == '"' || *ch == '\\') {
+			fprintf(fp, "\\%c", *ch);
+		} else if ((unsigned char) *ch < 0x20) {
+			fprintf(fp, "\\u%04x", (unsigned int) *ch);
+		} else {
+			fputc(*ch, fp);
+		}
+	}
+
+	fputc('"', fp);
+}
+
+/*
+ * Prints the JSON benchmark report of `bench` to the standard error.
+ *
+ * The component statistics are means per measured run.
+ */
+static
+void print_bench_report(struct bench *bench)
+{
+	const guint run_count = bench->run_durations_us->len;
+	uint64_t total_duration_us = 0;
+	uint64_t total_msg_count = 0;
+	uint64_t min_duration_us = UINT64_MAX;
+	uint64_t max_duration_us = 0;
+	guint i;
+
+	BT_ASSERT(run_count > 0);
+	fprintf(stderr, "{\n  \"warm-up-run-count\": 1,\n  \"runs\": [");
+
+	for (i = 0; i < run_count; i++) {
+		const uint64_t duration_us = bt_g_array_index(
+			bench->run_durations_us, uint64_t, i);
+		const uint64_t msg_count = bt_g_array_index(
+			bench->run_msg_counts, uint64_t, i);
+
+		fprintf(stderr, "%s\n    {\"duration-us\": %" PRIu64
+			", \"messages\": %" PRIu64 "}", i == 0 ? "" : ",",
+			duration_us, msg_count);
+		total_duration_us += duration_us;
+		total_msg_count += msg_count;
+		min_duration_us = MIN(min_duration_us, duration_us);
+		max_duration_us = MAX(max_duration_us, duration_us);
+	}
+
+	fprintf(stderr, "\n  ],\n  \"duration-us\": {\"min\": %" PRIu64
+		", \"mean\": %.3f, \"max\": %" PRIu64 "},\n",
+		min_duration_us, (double) total_duration_us / run_count,
+		max_duration_us);
+	fprintf(stderr, "  \"messages-per-second\": %.3f,\n",
+		total_duration_us == 0 ? 0. :
+		(double) total_msg_count * 1e6 / (double) total_duration_us);
+
+#ifdef __MINGW32__
+	fprintf(stderr, "  \"peak-rss-kib\": null,\n");
+#else
+	{
+		struct rusage usage;
+		long peak_rss_kib = -1;
+
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+# ifdef __APPLE__
+			/* Bytes on macOS */
+			peak_rss_kib = usage.ru_maxrss / 1024;
+# else
+			peak_rss_kib = usage.ru_maxrss;
+# endif
+		}
+
+		if (peak_rss_kib >= 0) {
+			fprintf(stderr, "  \"peak-rss-kib\": %ld,\n",
+				peak_rss_kib);
+		} else {
+			fprintf(stderr, "  \"peak-rss-kib\": null,\n");
+		}
+	}
+#endif
+
+	fprintf(stderr, "  \"components\": [");
+
+	for (i = 0; i < bench->comps_stats->len; i++) {
+		const struct bench_comp_stats *comp_stats = &bt_g_array_index(
+			bench->comps_stats, struct bench_comp_stats, i);
+
+		fprintf(stderr, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+		print_json_str(stderr, comp_stats->name);
+		fprintf(stderr, ", \"type\": \"%s\", \"calls\": %.3f, "
+			"\"messages\": %.3f, \"inclusive-duration-us\": %.3f, "
+			"\"exclusive-duration-us\": %.3f}",
+			bt_common_component_class_type_string(comp_stats->type),
+			(double) comp_stats->call_count / run_count,
+			(double) comp_stats->msg_count / run_count,
+			(double) comp_stats->inclusive_ns / 1e3 / run_count,
+			(double) comp_stats->exclusive_ns / 1e3 / run_count);
+	}
+
+	fprintf(stderr, "\n  ]\n}\n");
+}
+
+/*
+ * Creates, connects, and runs the graph which `cfg` describes.
+ *
+ * If `bench` isn't `NULL`, then this function records the duration and
+ * component statistics of a successful run into it.
+ */
+static
+enum bt_cmd_status run_graph(struct bt_config *cfg, struct bench *bench)
 {
 	enum bt_cmd_status cmd_status;
 	struct cmd_run_ctx ctx = { 0 };
+	bool stats_enabled = false;
+	int64_t run_begin_us = 0;
 
 	/* Initialize the command's context and the graph object */
 	if (cmd_run_ctx_init(&ctx, cfg)) {
@@ -2538,7 +2860,13 @@ enum bt_cmd_status cmd_run(struct bt_config *cfg)
 		goto error;
 	}
 
+	if (cfg->cmd_data.run.print_stats || bench) {
+		bt_graph_enable_statistics(ctx.graph);
+		stats_enabled = true;
+	}
+
 	BT_LOGI_STR("Running the graph.");
+	run_begin_us = g_get_monotonic_time();
 
 	/* Run the graph */
 	while (true) {
@@ -2568,15 +2896,26 @@ enum bt_cmd_status cmd_run(struct bt_config *cfg)
 			}
 
 			if (cfg->cmd_data.run.retry_duration_us > 0) {
-				BT_LOGT("Got BT_GRAPH_RUN_STATUS_AGAIN: sleeping: "
-					"time-us=%" PRIu64,
+				/*
+				 * Returns as soon as a component's wait
+				 * file descriptor is ready or a signal
+				 * interrupts it.
+				 */
+				BT_LOGT("Got BT_GRAPH_RUN_STATUS_AGAIN: waiting: "
+					"timeout-us=%" PRIu64,
 					cfg->cmd_data.run.retry_duration_us);
 
-				if (usleep(cfg->cmd_data.run.retry_duration_us)) {
-					if (bt_interrupter_is_set(the_interrupter)) {
-						cmd_status = BT_CMD_STATUS_INTERRUPTED;
-						goto end;
-					}
+				if (bt_graph_wait(ctx.graph,
+						cfg->cmd_data.run.retry_duration_us) !=
+						BT_GRAPH_WAIT_STATUS_OK) {
+					BT_CLI_LOGE_APPEND_CAUSE(
+						"Cannot wait for the graph's components.");
+					goto error;
+				}
+
+				if (bt_interrupter_is_set(the_interrupter)) {
+					cmd_status = BT_CMD_STATUS_INTERRUPTED;
+					goto end;
 				}
 			}
 			break;
@@ -2595,10 +2934,76 @@ error:
 	cmd_status = BT_CMD_STATUS_ERROR;
 
 end:
+	if (bench && cmd_status == BT_CMD_STATUS_OK) {
+		bench_add_run(bench, &ctx,
+			(uint64_t) (g_get_monotonic_time() - run_begin_us));
+	}
+
+	if (stats_enabled && cfg->cmd_data.run.print_stats) {
+		print_stats(&ctx);
+	}
+
 	cmd_run_ctx_destroy(&ctx);
 	return cmd_status;
 }
 
+/*
+ * Runs the graph once to warm up (caches, plugin files), and then
+ * `cfg->cmd_data.run.benchmark_run_count` times, printing the report.
+ */
+static
+enum bt_cmd_status cmd_run_benchmark(struct bt_config *cfg)
+{
+	enum bt_cmd_status cmd_status;
+	struct bench bench = { 0 };
+	uint64_t i;
+
+	bench.run_durations_us = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+	bench.run_msg_counts = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+	bench.comps_stats = g_array_new(FALSE, FALSE,
+		sizeof(struct bench_comp_stats));
+	bench.warming_up = true;
+	BT_LOGI_STR("Running the graph to warm up.");
+	cmd_status = run_graph(cfg, &bench);
+	if (cmd_status != BT_CMD_STATUS_OK) {
+		goto end;
+	}
+
+	bench.warming_up = false;
+
+	for (i = 0; i < cfg->cmd_data.run.benchmark_run_count; i++) {
+		BT_LOGI("Running the graph: run=%" PRIu64 "/%" PRIu64,
+			i + 1, cfg->cmd_data.run.benchmark_run_count);
+		cmd_status = run_graph(cfg, &bench);
+		if (cmd_status != BT_CMD_STATUS_OK) {
+			goto end;
+		}
+	}
+
+	print_bench_report(&bench);
+
+end:
+	for (i = 0; i < bench.comps_stats->len; i++) {
+		g_free(bt_g_array_index(bench.comps_stats,
+			struct bench_comp_stats, i).name);
+	}
+
+	g_array_free(bench.comps_stats, TRUE);
+	g_array_free(bench.run_msg_counts, TRUE);
+	g_array_free(bench.run_durations_us, TRUE);
+	return cmd_status;
+}
+
+static
+enum bt_cmd_status cmd_run(struct bt_config *cfg)
+{
+	if (cfg->cmd_data.run.benchmark_run_count > 0) {
+		return cmd_run_benchmark(cfg);
+	}
+
+	return run_graph(cfg, NULL);
+}
+
 static
 void warn_command_name_and_directory_clash(struct bt_config *cfg)
 {
@@ -57,6 +57,11 @@ void ClockCorrelationValidator::_validate(const bt2::ConstMessage msg,
         bt_common_abort();
     }
 
+    if (clockCls && _mValidClockClasses.count(clockCls->libObjPtr())) {
+        /* Already validated */
+        return;
+    }
+
     switch (_mExpectation) {
     case PropsExpectation::Unset:
         /*
@@ -173,6 +178,10 @@ void ClockCorrelationValidator::_validate(const bt2::ConstMessage msg,
     default:
         bt_common_abort();
     }
+
+    if (clockCls) {
+        _mValidClockClasses.emplace(clockCls->libObjPtr(), clockCls->shared());
+    }
 }
 
 } /* namespace bt2ccv */
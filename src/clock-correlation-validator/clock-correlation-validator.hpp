@@ -7,6 +7,8 @@
 #ifndef BABELTRACE_CLOCK_CORRELATION_VALIDATOR_CLOCK_CORRELATION_VALIDATOR_HPP
 #define BABELTRACE_CLOCK_CORRELATION_VALIDATOR_CLOCK_CORRELATION_VALIDATOR_HPP
 
+#include <unordered_map>
+
 #include "cpp-common/bt2/message.hpp"
 
 #include "clock-correlation-validator/clock-correlation-validator.h"
@@ -125,6 +127,22 @@ private:
      * as long as the owner of this validator.
      */
     bt2::ConstClockClass::Shared _mRefClockClass;
+
+    /*
+     * Clock classes which passed the validation, so that the following
+     * messages having one of them skip the property comparisons.
+     *
+     * Whether or not a given clock class passes the validation only
+     * depends on `_mExpectation` and `_mRefClockClass`, which never
+     * change once set, and on the graph MIP version, which is constant
+     * for a given user. Clock classes are frozen once a message refers
+     * to them. Therefore, an entry remains valid for the whole lifetime
+     * of this validator.
+     *
+     * Like for `_mRefClockClass`, keep strong references so that no
+     * other clock class may get allocated at the address of a key.
+     */
+    std::unordered_map<const bt_clock_class *, bt2::ConstClockClass::Shared> _mValidClockClasses;
 };
 
 } /* namespace bt2ccv */
@@ -755,6 +755,107 @@ end:
 	return ret;
 }
 
+/*
+ * Precomputed conversion of clock cycles at a given frequency to
+ * nanoseconds (see bt_common_cycles_to_ns_conv_init()).
+ */
+struct bt_common_cycles_to_ns_conv {
+	uint64_t frequency;
+
+	/* 10^9 / `frequency` as the irreducible fraction `num / den` */
+	uint64_t num;
+	uint64_t den;
+
+	/*
+	 * Whether or not `(den - 1) * num` fits in 64 bits, in which case
+	 * bt_common_cycles_to_ns() is exact without any floating point
+	 * arithmetic.
+	 */
+	bool exact;
+
+	/* `UINT64_MAX / num` */
+	uint64_t max_mul;
+};
+
+/*
+ * Initializes `conv` to convert clock cycles at the frequency
+ * `frequency` (greater than 0) to nanoseconds.
+ */
+static inline
+void bt_common_cycles_to_ns_conv_init(
+		struct bt_common_cycles_to_ns_conv *conv, uint64_t frequency)
+{
+	uint64_t gcd = NS_PER_S_U;
+	uint64_t b = frequency;
+
+	BT_ASSERT_DBG(conv);
+	BT_ASSERT_DBG(frequency > 0);
+
+	while (b != 0) {
+		const uint64_t rem = gcd % b;
+
+		gcd = b;
+		b = rem;
+	}
+
+	conv->frequency = frequency;
+	conv->num = NS_PER_S_U / gcd;
+	conv->den = frequency / gcd;
+	conv->exact = conv->den - 1 <= UINT64_MAX / conv->num;
+	conv->max_mul = UINT64_MAX / conv->num;
+}
+
+/*
+ * Converts `cycles` at the frequency of `conv` to nanoseconds, rounding
+ * down, returning `UINT64_C(-1)` if the result doesn't fit.
+ *
+ * This is exact, with at most two integer divisions, for any
+ * frequency which divides 10^9 (for example, 1 GHz, 1 MHz, and 1 kHz)
+ * as well as for usual CPU time stamp counter frequencies.
+ */
+static inline
+uint64_t bt_common_cycles_to_ns(const struct bt_common_cycles_to_ns_conv *conv,
+		uint64_t cycles)
+{
+	BT_ASSERT_DBG(conv);
+
+	if (conv->den == 1) {
+		/* Whole number of nanoseconds per cycle */
+		if (cycles > conv->max_mul) {
+			return UINT64_C(-1);
+		}
+
+		return cycles * conv->num;
+	}
+
+	if (conv->exact) {
+		/*
+		 * With `cycles = q * den + r`:
+		 *
+		 *     cycles * num / den = q * num + r * num / den
+		 */
+		const uint64_t q = cycles / conv->den;
+		const uint64_t r = cycles - q * conv->den;
+		const uint64_t r_ns = r * conv->num / conv->den;
+
+		if (q > conv->max_mul || q * conv->num > UINT64_MAX - r_ns) {
+			return UINT64_C(-1);
+		} else {
+			return q * conv->num + r_ns;
+		}
+	} else {
+		const double dblres = (1e9 * (double) cycles) /
+			(double) conv->frequency;
+
+		if (dblres >= (double) UINT64_MAX) {
+			/* Overflows uint64_t */
+			return UINT64_C(-1);
+		}
+
+		return (uint64_t) dblres;
+	}
+}
+
 /*
  * bt_g_string_append_printf cannot be inlined because it expects a
  * variadic argument list.
@@ -801,6 +902,97 @@ void bt_common_g_string_append_c(GString *str, char c)
 	str->str[len + 1] = '\0';
 }
 
+/*
+ * Appends the first `s_len` bytes of `s` to `str`.
+ */
+static inline
+void bt_common_g_string_append_len(GString *str, const char *s, gsize s_len)
+{
+	gsize len, allocated_len;
+
+	/* str->len excludes \0. */
+	len = str->len;
+	/* Exclude \0. */
+	allocated_len = str->allocated_len - 1;
+	if (G_UNLIKELY(allocated_len < len + s_len)) {
+		/* Resize. */
+		g_string_set_size(str, len + s_len);
+	} else {
+		str->len = len + s_len;
+	}
+	memcpy(str->str + len, s, s_len);
+	str->str[len + s_len] = '\0';
+}
+
+/*
+ * Appends the decimal representation of `v` to `str`, left-padded
+ * with zeros to at least `min_width` digits.
+ *
+ * Equivalent to the `%0*` PRIu64 format, without having to parse it.
+ */
+static inline
+void bt_common_g_string_append_uint64(GString *str, uint64_t v,
+		unsigned int min_width)
+{
+	/* 20 digits are enough for `UINT64_MAX` */
+	char buf[32];
+	char *p = buf + sizeof(buf);
+
+	BT_ASSERT_DBG(min_width <= sizeof(buf));
+
+	do {
+		*--p = (char) ('0' + (v % 10));
+		v /= 10;
+	} while (v != 0);
+
+	while ((unsigned int) (buf + sizeof(buf) - p) < min_width) {
+		*--p = '0';
+	}
+
+	bt_common_g_string_append_len(str, p, buf + sizeof(buf) - p);
+}
+
+/*
+ * Appends the decimal representation of `v` to `str`.
+ *
+ * Equivalent to the `%` PRId64 format, without having to parse it.
+ */
+static inline
+void bt_common_g_string_append_int64(GString *str, int64_t v)
+{
+	if (v < 0) {
+		bt_common_g_string_append_c(str, '-');
+
+		/* Negate as unsigned: also valid for `INT64_MIN` */
+		bt_common_g_string_append_uint64(str, -(uint64_t) v, 0);
+	} else {
+		bt_common_g_string_append_uint64(str, (uint64_t) v, 0);
+	}
+}
+
+/*
+ * Appends the uppercase hexadecimal representation of `v`, without
+ * prefix, to `str`.
+ *
+ * Equivalent to the `%` PRIX64 format, without having to parse it.
+ */
+static inline
+void bt_common_g_string_append_uint64_hex(GString *str, uint64_t v)
+{
+	static const char digits[] = "0123456789ABCDEF";
+
+	/* 16 digits are enough for `UINT64_MAX` */
+	char buf[16];
+	char *p = buf + sizeof(buf);
+
+	do {
+		*--p = digits[v & 0xf];
+		v >>= 4;
+	} while (v != 0);
+
+	bt_common_g_string_append_len(str, p, buf + sizeof(buf) - p);
+}
+
 static inline
 const char *bt_common_component_class_type_string(
 		enum bt_component_class_type type)
@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <glib.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+# include <sys/auxv.h>
+#endif
+
+#include "common/cpu.h"
+
+#if defined(__linux__) && defined(__aarch64__) && !defined(HWCAP_SVE)
+# define HWCAP_SVE	(1 << 22)
+#endif
+
+#if defined(__linux__) && defined(__arm__) && !defined(HWCAP_NEON)
+# define HWCAP_NEON	(1 << 12)
+#endif
+
+/*
+ * Features which the compiler already assumes, whatever the machine.
+ */
+static
+uint64_t build_time_features(void)
+{
+	uint64_t features = 0;
+
+#ifdef __SSE2__
+	features |= BT_CPU_FEATURE_X86_SSE2;
+#endif
+#ifdef __SSE4_2__
+	features |= BT_CPU_FEATURE_X86_SSE4_2;
+#endif
+#ifdef __AVX2__
+	features |= BT_CPU_FEATURE_X86_AVX2;
+#endif
+#ifdef __AVX512BW__
+	features |= BT_CPU_FEATURE_X86_AVX512BW;
+#endif
+#ifdef __ARM_NEON
+	features |= BT_CPU_FEATURE_ARM_NEON;
+#endif
+#ifdef __ARM_FEATURE_SVE
+	features |= BT_CPU_FEATURE_ARM_SVE;
+#endif
+
+	return features;
+}
+
+static
+uint64_t detect_features(void)
+{
+	uint64_t features = build_time_features();
+	const char *no_simd = getenv("BABELTRACE_CPU_NO_SIMD");
+
+	if (no_simd && strcmp(no_simd, "1") == 0) {
+		return features;
+	}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	/*
+	 * __builtin_cpu_supports() also checks that the operating system
+	 * saves the AVX and AVX-512 registers.
+	 */
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("sse2")) {
+		features |= BT_CPU_FEATURE_X86_SSE2;
+	}
+
+	if (__builtin_cpu_supports("sse4.2")) {
+		features |= BT_CPU_FEATURE_X86_SSE4_2;
+	}
+
+	if (__builtin_cpu_supports("avx2")) {
+		features |= BT_CPU_FEATURE_X86_AVX2;
+	}
+
+	if (__builtin_cpu_supports("avx512bw")) {
+		features |= BT_CPU_FEATURE_X86_AVX512BW;
+	}
+#elif defined(__aarch64__)
+	/* Advanced SIMD (NEON) is mandatory on AArch64 */
+	features |= BT_CPU_FEATURE_ARM_NEON;
+
+# ifdef __linux__
+	if (getauxval(AT_HWCAP) & HWCAP_SVE) {
+		features |= BT_CPU_FEATURE_ARM_SVE;
+	}
+# endif
+#elif defined(__arm__) && defined(__linux__)
+	if (getauxval(AT_HWCAP) & HWCAP_NEON) {
+		features |= BT_CPU_FEATURE_ARM_NEON;
+	}
+#endif
+
+	return features;
+}
+
+uint64_t bt_cpu_features(void)
+{
+	static uint64_t features;
+	static gsize init;
+
+	if (g_once_init_enter(&init)) {
+		features = detect_features();
+		g_once_init_leave(&init, 1);
+	}
+
+	return features;
+}
+
+#if !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+uint64_t bt_cpu_cycles_fallback(void)
+{
+	return (uint64_t) g_get_monotonic_time() * 1000;
+}
+#endif
+
+static
+uint64_t measure_cycles_freq(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	/*
+	 * There's no portable way to get the TSC frequency: count the
+	 * cycles during about 10 ms of monotonic time.
+	 */
+	const gint64 begin_us = g_get_monotonic_time();
+	const uint64_t begin_cycles = bt_cpu_cycles();
+	gint64 elapsed_us;
+
+	g_usleep(10000);
+	elapsed_us = g_get_monotonic_time() - begin_us;
+
+	if (elapsed_us <= 0) {
+		/* Unlikely: fall back to 1 GHz */
+		return UINT64_C(1000000000);
+	}
+
+	return (bt_cpu_cycles() - begin_cycles) * UINT64_C(1000000) /
+		(uint64_t) elapsed_us;
+#elif defined(__aarch64__)
+	uint64_t freq;
+
+	__asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r" (freq));
+	return freq;
+#else
+	/* bt_cpu_cycles_fallback() returns nanoseconds */
+	return UINT64_C(1000000000);
+#endif
+}
+
+uint64_t bt_cpu_cycles_freq(void)
+{
+	static uint64_t freq;
+	static gsize init;
+
+	if (g_once_init_enter(&init)) {
+		freq = measure_cycles_freq();
+		g_once_init_leave(&init, 1);
+	}
+
+	return freq;
+}
+
+uint64_t bt_cpu_cycles_to_ns(uint64_t cycles)
+{
+	const uint64_t freq = bt_cpu_cycles_freq();
+
+	/* Avoid overflowing `cycles * 1000000000` for long durations */
+	return cycles / freq * UINT64_C(1000000000) +
+		cycles % freq * UINT64_C(1000000000) / freq;
+}
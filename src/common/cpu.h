@@ -0,0 +1,162 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_COMMON_CPU_H
+#define BABELTRACE_COMMON_CPU_H
+
+/*
+ * Runtime CPU feature detection, function dispatch, and cycle counter.
+ *
+ * A SIMD kernel is compiled for a specific target with BT_CPU_TARGET()
+ * and selected at run time with BT_CPU_SELECT(), for example:
+ *
+ *     BT_CPU_TARGET("avx2")
+ *     static const char *find_nl_avx2(const char *begin, const char *end)
+ *     {
+ *         ...
+ *     }
+ *
+ *     static const char *find_nl_generic(const char *begin,
+ *             const char *end)
+ *     {
+ *         ...
+ *     }
+ *
+ *     const char *find_nl(const char *begin, const char *end)
+ *     {
+ *         static const char *(*func)(const char *, const char *);
+ *
+ *         if (G_UNLIKELY(!func)) {
+ *             func = BT_CPU_SELECT(BT_CPU_FEATURE_X86_AVX2,
+ *                 find_nl_avx2, find_nl_generic);
+ *         }
+ *
+ *         return func(begin, end);
+ *     }
+ *
+ * Guard the specific implementations with the usual architecture
+ * macros (`__x86_64__`, `__aarch64__`, and so on) and with
+ * `BT_CPU_HAVE_TARGET_ATTR` when they need BT_CPU_TARGET().
+ *
+ * With the `BABELTRACE_CPU_NO_SIMD` environment variable set to `1`,
+ * bt_cpu_features() only reports the features which the compiler
+ * already assumes (for example, SSE2 on x86-64 and NEON on AArch64)
+ * so that the fallback implementations are testable on any machine.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum bt_cpu_feature {
+	BT_CPU_FEATURE_X86_SSE2		= 1 << 0,
+	BT_CPU_FEATURE_X86_SSE4_2	= 1 << 1,
+	BT_CPU_FEATURE_X86_AVX2		= 1 << 2,
+	BT_CPU_FEATURE_X86_AVX512BW	= 1 << 3,
+	BT_CPU_FEATURE_ARM_NEON		= 1 << 4,
+	BT_CPU_FEATURE_ARM_SVE		= 1 << 5,
+};
+
+/*
+ * BT_CPU_TARGET(_target): function attribute which makes the compiler
+ * generate code for the target `_target` (for example, `"avx2"`), if
+ * it supports it (then `BT_CPU_HAVE_TARGET_ATTR` is defined).
+ *
+ * Only call such a function when bt_cpu_has_features() reports the
+ * corresponding features.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define BT_CPU_HAVE_TARGET_ATTR	1
+# define BT_CPU_TARGET(_target)	__attribute__((target(_target)))
+#else
+# define BT_CPU_TARGET(_target)
+#endif
+
+/*
+ * Returns the CPU features (bitwise OR of `enum bt_cpu_feature`) of
+ * the current machine.
+ *
+ * The first call detects them; the other ones return the same value.
+ * This function is thread-safe.
+ */
+uint64_t bt_cpu_features(void);
+
+/*
+ * Returns whether or not the current machine has all the features
+ * `features` (bitwise OR of `enum bt_cpu_feature`).
+ */
+static inline
+bool bt_cpu_has_features(uint64_t features)
+{
+	return (bt_cpu_features() & features) == features;
+}
+
+/*
+ * Evaluates to `_func` if the current machine has all the features
+ * `_features`, or to `_fallback` otherwise.
+ *
+ * Nest it to select amongst more than two implementations, the most
+ * specific first. Assign the result to a static function pointer as
+ * shown at the top of this file to only select once.
+ */
+#define BT_CPU_SELECT(_features, _func, _fallback)			\
+	(bt_cpu_has_features(_features) ? (_func) : (_fallback))
+
+#if !defined(__x86_64__) && !defined(__i386__) && !defined(__aarch64__)
+/* Fallback of bt_cpu_cycles(): monotonic time in nanoseconds */
+uint64_t bt_cpu_cycles_fallback(void);
+#endif
+
+/*
+ * Returns the current value of a monotonic counter which is cheap to
+ * read: the time stamp counter on x86 (assuming a constant-rate TSC,
+ * like on any x86 CPU since about 2008), the virtual counter on
+ * AArch64, or the monotonic time in nanoseconds otherwise.
+ *
+ * Use bt_cpu_cycles_to_ns() to convert a difference of two values to
+ * nanoseconds.
+ *
+ * The values of different CPUs may differ slightly.
+ */
+static inline
+uint64_t bt_cpu_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#elif defined(__aarch64__)
+	uint64_t val;
+
+	__asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (val));
+	return val;
+#else
+	return bt_cpu_cycles_fallback();
+#endif
+}
+
+/*
+ * Returns the frequency, in hertz, of the counter of bt_cpu_cycles().
+ *
+ * On x86, the first call measures it over about 10 ms.
+ */
+uint64_t bt_cpu_cycles_freq(void);
+
+/*
+ * Converts `cycles` counts of bt_cpu_cycles() to nanoseconds.
+ */
+uint64_t bt_cpu_cycles_to_ns(uint64_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE_COMMON_CPU_H */
@@ -116,6 +116,61 @@ void mmap_unlock(int log_level)
 	}
 }
 
+/*
+ * Range of PrefetchVirtualMemory(), with the same layout as
+ * `WIN32_MEMORY_RANGE_ENTRY`, which older headers don't declare.
+ */
+struct prefetch_range {
+	void *addr;
+	size_t length;
+};
+
+typedef BOOL (WINAPI *prefetch_virtual_memory_func)(HANDLE, ULONG_PTR,
+		struct prefetch_range *, ULONG);
+
+/*
+ * PrefetchVirtualMemory() only exists as of Windows 8: resolve it at
+ * run time, once.
+ */
+static pthread_once_t prefetch_virtual_memory_once = PTHREAD_ONCE_INIT;
+static prefetch_virtual_memory_func prefetch_virtual_memory;
+
+static
+void resolve_prefetch_virtual_memory(void)
+{
+	HMODULE kernel32 = GetModuleHandleA("kernel32.dll");
+
+	if (kernel32) {
+		prefetch_virtual_memory = (prefetch_virtual_memory_func)
+			(void *) GetProcAddress(kernel32, "PrefetchVirtualMemory");
+	}
+}
+
+/*
+ * Asks the system to bring the `length` bytes of the view at `addr`
+ * into memory with large sequential reads, instead of one page fault
+ * at a time while the caller reads the view.
+ *
+ * This is only a hint: failing to prefetch isn't an error.
+ */
+static
+void prefetch_view(void *addr, size_t length, int log_level)
+{
+	struct prefetch_range range = { addr, length };
+
+	pthread_once(&prefetch_virtual_memory_once,
+		resolve_prefetch_virtual_memory);
+	if (!prefetch_virtual_memory) {
+		return;
+	}
+
+	if (!prefetch_virtual_memory(GetCurrentProcess(), 1, &range, 0)) {
+		BT_LOG_WRITE_PRINTF_CUR_LVL(BT_LOG_DEBUG, log_level, BT_LOG_TAG,
+			"PrefetchVirtualMemory() failed: addr=%p, length=%zu, error=%lu",
+			addr, length, GetLastError());
+	}
+}
+
 /*
  * Convert mmap memory protection flags to CreateFileMapping page protection
  * flag and MapViewOfFile desired access flag.
@@ -224,6 +279,15 @@ void *bt_mmap(size_t length, int prot, int flags, int fd, off_t offset,
 		goto error;
 	}
 
+	/*
+	 * Read-only views are typically read sequentially right away
+	 * (data stream files, for example), whereas writable views are
+	 * typically written (and extended) without reading them first.
+	 */
+	if (!(prot & PROT_WRITE)) {
+		prefetch_view(mapping_addr, length, log_level);
+	}
+
 	mmap_lock(log_level);
 
 	/* If we have never done any mappings, allocate the hashtable. */
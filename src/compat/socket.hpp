@@ -73,6 +73,25 @@ static inline bool bt_socket_interrupted(void)
     return false;
 }
 
+typedef WSAPOLLFD bt_socket_pollfd;
+
+static inline int bt_socket_poll(bt_socket_pollfd *fds, unsigned long nfds, int timeout_ms)
+{
+    return WSAPoll(fds, nfds, timeout_ms);
+}
+
+static inline int bt_socket_set_nonblocking(SOCKET fd)
+{
+    u_long mode = 1;
+
+    return ioctlsocket(fd, FIONBIO, &mode);
+}
+
+static inline bool bt_socket_would_block(void)
+{
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+}
+
 static inline const char *bt_socket_errormsg(void)
 {
     const char *errstr;
@@ -253,10 +272,13 @@ static inline const char *bt_socket_errormsg(void)
 
 #    include <arpa/inet.h>
 #    include <errno.h>
+#    include <fcntl.h>
 #    include <glib.h>
 #    include <netdb.h>
 #    include <netinet/in.h>
+#    include <poll.h>
 #    include <sys/socket.h>
+#    include <sys/un.h>
 #    include <unistd.h>
 
 #    define BT_INVALID_SOCKET -1
@@ -294,6 +316,29 @@ static inline bool bt_socket_interrupted(void)
     return (errno == EINTR);
 }
 
+typedef struct pollfd bt_socket_pollfd;
+
+static inline int bt_socket_poll(bt_socket_pollfd *fds, unsigned long nfds, int timeout_ms)
+{
+    return poll(fds, nfds, timeout_ms);
+}
+
+static inline int bt_socket_set_nonblocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+
+    if (flags < 0) {
+        return -1;
+    }
+
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static inline bool bt_socket_would_block(void)
+{
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
 static inline const char *bt_socket_errormsg(void)
 {
     return g_strerror(errno);
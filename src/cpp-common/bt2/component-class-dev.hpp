@@ -66,6 +66,26 @@ protected:
         return _mSelfComp.graphMipVersion();
     }
 
+    /*
+     * Adds `delta` bytes to the memory usage of this component (see
+     * bt_self_component_add_memory_usage()).
+     */
+    void _addMemoryUsage(const std::int64_t delta) const noexcept
+    {
+        _mSelfComp.addMemoryUsage(delta);
+    }
+
+    /*
+     * Whether or not the total memory usage of the graph exceeds its
+     * memory budget, if any.
+     */
+    bool _graphMemoryBudgetIsExceeded() const noexcept
+    {
+        const auto budget = _mSelfComp.graphMemoryBudget();
+
+        return budget != 0 && _mSelfComp.graphMemoryUsage() > budget;
+    }
+
     SelfCompT _selfComp() noexcept
     {
         return _mSelfComp;
@@ -462,6 +462,11 @@ public:
         return bt_field_class_get_graph_mip_version(this->libObjPtr());
     }
 
+    bool isShareable() const noexcept
+    {
+        return static_cast<bool>(bt_field_class_is_shareable(this->libObjPtr()));
+    }
+
     Shared shared() const noexcept
     {
         return Shared::createWithRef(*this);
@@ -1324,6 +1329,21 @@ public:
                                                                               name);
     }
 
+    /*
+     * Index of the member named `name`, if any, to borrow the
+     * corresponding member field of many structure fields by index.
+     */
+    bt2s::optional<std::uint64_t> memberIndexByName(const bt2c::CStringView name) const noexcept
+    {
+        std::uint64_t index;
+
+        if (bt_field_class_structure_get_member_index_by_name(this->libObjPtr(), name, &index)) {
+            return index;
+        }
+
+        return bt2s::nullopt;
+    }
+
     Shared shared() const noexcept
     {
         return Shared::createWithRef(*this);
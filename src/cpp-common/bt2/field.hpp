@@ -223,6 +223,20 @@ public:
         return this->cls().isVariant();
     }
 
+    /*
+     * Copies the value of `other`, of which the class has the same
+     * structure as the class of this field, to this field.
+     */
+    void copyFrom(const CommonField<const bt_field> other) const
+    {
+        static_assert(!std::is_const<LibObjT>::value, "Not available with `bt2::ConstField`.");
+
+        if (bt_field_copy(other.libObjPtr(), this->libObjPtr()) ==
+            BT_FIELD_COPY_STATUS_MEMORY_ERROR) {
+            throw MemoryError {};
+        }
+    }
+
     template <typename FieldT>
     FieldT as() const noexcept
     {
@@ -131,6 +131,17 @@ public:
         return *this;
     }
 
+    Graph msgBatchSize(const std::uint64_t batchSize) const noexcept
+    {
+        bt_graph_set_message_batch_size(this->libObjPtr(), batchSize);
+        return *this;
+    }
+
+    std::uint64_t msgBatchSize() const noexcept
+    {
+        return bt_graph_get_message_batch_size(this->libObjPtr());
+    }
+
     Graph runOnce() const
     {
         const auto status = bt_graph_run_once(this->libObjPtr());
@@ -7,8 +7,6 @@
 #ifndef BABELTRACE_CPP_COMMON_BT2_MESSAGE_ARRAY_HPP
 #define BABELTRACE_CPP_COMMON_BT2_MESSAGE_ARRAY_HPP
 
-#include <algorithm>
-
 #include <babeltrace2/babeltrace.h>
 
 #include "common/assert.h"
@@ -117,6 +115,13 @@ private:
  * In both cases, the returned message array wrapper is always the sole
  * owner of the wrapped library array: it's not a simple passive view.
  * The destructor puts the references of the contained messages.
+ *
+ * operator[]() and iterating borrow the contained messages without
+ * changing their reference count. To forward a message from one array
+ * to another one without any reference count change either (typical
+ * for a filter), move its reference out with take():
+ *
+ *     outMsgs.append(inMsgs.take(i));
  */
 class ConstMessageArray final
 {
@@ -228,6 +233,25 @@ public:
         return *this;
     }
 
+    /*
+     * Moves the reference of the message at the index `index` out of
+     * this array, without changing its reference count, and returns it.
+     *
+     * The slot at the index `index` becomes empty: you may not call
+     * operator[]() or take() with `index` afterwards, and the
+     * destructor won't put any reference for it.
+     */
+    ConstMessage::Shared take(const std::uint64_t index) noexcept
+    {
+        BT_ASSERT_DBG(index < _mLen);
+        BT_ASSERT_DBG(_mLibArrayPtr[index]);
+
+        const auto libMsgPtr = _mLibArrayPtr[index];
+
+        _mLibArrayPtr[index] = nullptr;
+        return ConstMessage::Shared::createWithoutRef(libMsgPtr);
+    }
+
     /*
      * Transfers the ownership of the wrapped library array to the
      * caller, returning the number of contained messages (array
@@ -244,6 +268,7 @@ public:
     ConstMessage operator[](const std::uint64_t index) const noexcept
     {
         BT_ASSERT_DBG(index < _mLen);
+        BT_ASSERT_DBG(_mLibArrayPtr[index]);
         return ConstMessage {_mLibArrayPtr[index]};
     }
 
@@ -273,12 +298,12 @@ private:
 
     /*
      * Decrements the reference count of all the contained messages.
+     *
+     * bt_message_put_refs() skips the empty slots which take() leaves.
      */
     void _putMsgRefs() noexcept
     {
-        std::for_each(&_mLibArrayPtr[0], &_mLibArrayPtr[_mLen], [](const bt_message * const msg) {
-            bt_message_put_ref(msg);
-        });
+        bt_message_put_refs(_mLibArrayPtr, _mLen);
     }
 
     /* Underlying array which is generally owned by the library */
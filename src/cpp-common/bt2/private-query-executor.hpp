@@ -12,6 +12,8 @@
 #include "logging.hpp"
 
 #include "borrowed-object.hpp"
+#include "exc.hpp"
+#include "value.hpp"
 
 namespace bt2 {
 
@@ -34,6 +36,23 @@ public:
         return static_cast<bool>(bt_query_executor_is_interrupted(
             bt_private_query_executor_as_query_executor_const(this->libObjPtr())));
     }
+
+    /*
+     * Stashes `data`, keyed by `key`, within the component class of
+     * this query executor (see bt_private_query_executor_stash()).
+     *
+     * On error, the ownership of `data` remains with the caller.
+     */
+    void stash(const ConstValue key, void * const data,
+               const bt_private_query_executor_stash_destroy_func destroyFunc) const
+    {
+        const auto status =
+            bt_private_query_executor_stash(this->libObjPtr(), key.libObjPtr(), data, destroyFunc);
+
+        if (status == BT_PRIVATE_QUERY_EXECUTOR_STASH_STATUS_MEMORY_ERROR) {
+            throw MemoryError {};
+        }
+    }
 };
 
 } /* namespace bt2 */
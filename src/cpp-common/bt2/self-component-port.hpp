@@ -19,6 +19,7 @@
 #include "borrowed-object.hpp"
 #include "component-port.hpp"
 #include "message-iterator.hpp"
+#include "value.hpp"
 
 namespace bt2 {
 
@@ -92,6 +93,26 @@ public:
         return bt_self_component_get_graph_mip_version(this->libObjPtr());
     }
 
+    void addMemoryUsage(const std::int64_t delta) const noexcept
+    {
+        bt_self_component_add_memory_usage(this->libObjPtr(), delta);
+    }
+
+    std::uint64_t graphMemoryBudget() const noexcept
+    {
+        return bt_self_component_get_graph_memory_budget(this->libObjPtr());
+    }
+
+    std::uint64_t graphMemoryUsage() const noexcept
+    {
+        return bt_self_component_get_graph_memory_usage(this->libObjPtr());
+    }
+
+    void *takeQueryStash(const ConstValue key) const noexcept
+    {
+        return bt_self_component_take_query_stash(this->libObjPtr(), key.libObjPtr());
+    }
+
     template <typename T>
     T& data() const noexcept
     {
@@ -127,6 +148,19 @@ public:
 
         return ClockClass::Shared::createWithoutRef(libObjPtr);
     }
+
+    void addWaitFd(const int fd) const
+    {
+        if (bt_self_component_add_wait_fd(this->libObjPtr(), fd) ==
+            BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_MEMORY_ERROR) {
+            throw MemoryError {};
+        }
+    }
+
+    void removeWaitFd(const int fd) const noexcept
+    {
+        bt_self_component_remove_wait_fd(this->libObjPtr(), fd);
+    }
 };
 
 namespace internal {
@@ -182,6 +216,26 @@ public:
         return this->_selfComponent().graphMipVersion();
     }
 
+    void addMemoryUsage(const std::int64_t delta) const noexcept
+    {
+        this->_selfComponent().addMemoryUsage(delta);
+    }
+
+    std::uint64_t graphMemoryBudget() const noexcept
+    {
+        return this->_selfComponent().graphMemoryBudget();
+    }
+
+    std::uint64_t graphMemoryUsage() const noexcept
+    {
+        return this->_selfComponent().graphMemoryUsage();
+    }
+
+    void *takeQueryStash(const ConstValue key) const noexcept
+    {
+        return this->_selfComponent().takeQueryStash(key);
+    }
+
     template <typename T>
     T& data() const noexcept
     {
@@ -1576,7 +1576,7 @@ public:
 
     OptionalBorrowedObject<_StructureFieldClass> commonEventContextFieldClass() const noexcept
     {
-        return _Spec::commonEventContextFieldClass(this->libObjPtr());
+        return _Spec::eventCommonContextFieldClass(this->libObjPtr());
     }
 
     template <typename LibValT>
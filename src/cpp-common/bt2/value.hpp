@@ -1427,6 +1427,115 @@ struct TypeDescr<ConstMapValue> : public MapValueTypeDescr
 
 } /* namespace internal */
 
+namespace internal {
+
+struct MapValueBuilderRefFuncs final
+{
+    static void get(const bt_value_map_builder * const libObjPtr) noexcept
+    {
+        bt_value_map_builder_get_ref(libObjPtr);
+    }
+
+    static void put(const bt_value_map_builder * const libObjPtr) noexcept
+    {
+        bt_value_map_builder_put_ref(libObjPtr);
+    }
+};
+
+} /* namespace internal */
+
+/*
+ * Builder of compact (immutable) map values: see
+ * bt_value_map_builder_build().
+ */
+class MapValueBuilder final : public BorrowedObject<bt_value_map_builder>
+{
+public:
+    using Shared =
+        SharedObject<MapValueBuilder, bt_value_map_builder, internal::MapValueBuilderRefFuncs>;
+
+    explicit MapValueBuilder(const LibObjPtr libObjPtr) noexcept : _ThisBorrowedObject {libObjPtr}
+    {
+    }
+
+    static Shared create()
+    {
+        const auto libObjPtr = bt_value_map_builder_create();
+
+        internal::validateCreatedObjPtr(libObjPtr);
+        return Shared::createWithoutRef(libObjPtr);
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const ConstValue val) const
+    {
+        this->_handleAddLibStatus(
+            bt_value_map_builder_add_entry(this->libObjPtr(), key, val.libObjPtr()));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const bool rawVal) const
+    {
+        this->_handleAddLibStatus(bt_value_map_builder_add_bool_entry(
+            this->libObjPtr(), key, static_cast<bt_bool>(rawVal)));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const std::uint64_t rawVal) const
+    {
+        this->_handleAddLibStatus(
+            bt_value_map_builder_add_unsigned_integer_entry(this->libObjPtr(), key, rawVal));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const std::int64_t rawVal) const
+    {
+        this->_handleAddLibStatus(
+            bt_value_map_builder_add_signed_integer_entry(this->libObjPtr(), key, rawVal));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const double rawVal) const
+    {
+        this->_handleAddLibStatus(
+            bt_value_map_builder_add_real_entry(this->libObjPtr(), key, rawVal));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const char * const rawVal) const
+    {
+        this->_handleAddLibStatus(
+            bt_value_map_builder_add_string_entry(this->libObjPtr(), key, rawVal));
+        return *this;
+    }
+
+    MapValueBuilder add(const bt2c::CStringView key, const bt2c::CStringView rawVal) const
+    {
+        return this->add(key, rawVal.data());
+    }
+
+    /*
+     * Builds a compact map value from the added entries, making this
+     * builder empty.
+     *
+     * The returned map value is frozen: don't modify it.
+     */
+    MapValue::Shared build() const
+    {
+        const auto libObjPtr = bt_value_map_builder_build(this->libObjPtr());
+
+        internal::validateCreatedObjPtr(libObjPtr);
+        return MapValue::Shared::createWithoutRef(libObjPtr);
+    }
+
+private:
+    static void _handleAddLibStatus(const bt_value_map_builder_add_entry_status status)
+    {
+        if (status == BT_VALUE_MAP_BUILDER_ADD_ENTRY_STATUS_MEMORY_ERROR) {
+            throw MemoryError {};
+        }
+    }
+};
+
 template <typename LibObjT>
 ArrayValue CommonValue<LibObjT>::appendEmptyArray() const
 {
@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include "common/common.h"
+
+#include "json-from-bt2-value.hpp"
+
+namespace bt2c {
+
+void appendJsonFromBt2Value(JsonWriter& writer, const bt2::ConstValue val)
+{
+    switch (val.type()) {
+    case bt2::ValueType::Null:
+        writer.nullVal();
+        break;
+
+    case bt2::ValueType::Bool:
+        writer.boolVal(val.asBool().value());
+        break;
+
+    case bt2::ValueType::SignedInteger:
+        writer.sIntVal(val.asSignedInteger().value());
+        break;
+
+    case bt2::ValueType::UnsignedInteger:
+        writer.uIntVal(val.asUnsignedInteger().value());
+        break;
+
+    case bt2::ValueType::Real:
+        writer.realVal(val.asReal().value());
+        break;
+
+    case bt2::ValueType::String:
+        writer.strVal(val.asString().value());
+        break;
+
+    case bt2::ValueType::Array:
+        writer.beginArray();
+
+        for (const auto elemVal : val.asArray()) {
+            appendJsonFromBt2Value(writer, elemVal);
+        }
+
+        writer.endArray();
+        break;
+
+    case bt2::ValueType::Map:
+        writer.beginObj();
+        val.asMap().forEach([&writer](const bt2c::CStringView key, const bt2::ConstValue itemVal) {
+            writer.key(key);
+            appendJsonFromBt2Value(writer, itemVal);
+        });
+        writer.endObj();
+        break;
+
+    default:
+        bt_common_abort();
+    }
+}
+
+std::string jsonFromBt2Value(const bt2::ConstValue val)
+{
+    JsonWriter writer;
+
+    appendJsonFromBt2Value(writer, val);
+    return writer.release();
+}
+
+} /* namespace bt2c */
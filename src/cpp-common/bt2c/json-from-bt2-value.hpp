@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_CPP_COMMON_BT2C_JSON_FROM_BT2_VALUE_HPP
+#define BABELTRACE_CPP_COMMON_BT2C_JSON_FROM_BT2_VALUE_HPP
+
+#include <string>
+
+#include "cpp-common/bt2/value.hpp"
+
+#include "json-writer.hpp"
+
+namespace bt2c {
+
+/*
+ * Appends the JSON representation of the Babeltrace 2 value `val` to
+ * `writer`.
+ *
+ * A map value becomes a JSON object of which the members are in the
+ * order of bt2::CommonMapValue::forEach().
+ */
+void appendJsonFromBt2Value(JsonWriter& writer, bt2::ConstValue val);
+
+/*
+ * Returns the compact JSON representation of the Babeltrace 2 value
+ * `val`.
+ */
+std::string jsonFromBt2Value(bt2::ConstValue val);
+
+} /* namespace bt2c */
+
+#endif /* BABELTRACE_CPP_COMMON_BT2C_JSON_FROM_BT2_VALUE_HPP */
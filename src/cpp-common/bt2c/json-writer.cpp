@@ -0,0 +1,98 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+#include <glib.h>
+
+#include "json-writer.hpp"
+
+namespace bt2c {
+namespace {
+
+/*
+ * For each byte: 0 if it doesn't need to be escaped within a JSON
+ * string, or else the character which follows the backslash of its
+ * escape sequence, `u` meaning `\u00XX`.
+ */
+constexpr char escapeTable[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+} /* namespace */
+
+void JsonWriter::_appendStr(const bt2s::string_view str)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    const auto end = str.data() + str.size();
+    auto runBegin = str.data();
+
+    _mStr += '"';
+
+    for (auto it = str.data(); it != end; ++it) {
+        const auto escape = escapeTable[static_cast<unsigned char>(*it)];
+
+        if (G_LIKELY(escape == 0)) {
+            continue;
+        }
+
+        /* Append the run of bytes which don't need to be escaped at once */
+        _mStr.append(runBegin, it - runBegin);
+        runBegin = it + 1;
+        _mStr += '\\';
+        _mStr += escape;
+
+        if (escape == 'u') {
+            const auto byte = static_cast<unsigned char>(*it);
+
+            _mStr.append("00", 2);
+            _mStr += hexDigits[byte >> 4];
+            _mStr += hexDigits[byte & 0xf];
+        }
+    }
+
+    _mStr.append(runBegin, end - runBegin);
+    _mStr += '"';
+}
+
+JsonWriter& JsonWriter::realVal(const double val)
+{
+    if (!std::isfinite(val)) {
+        return this->nullVal();
+    }
+
+    this->_beforeVal();
+
+    const auto begin = _mStr.size();
+
+    fmt::format_to(std::back_inserter(_mStr), "{}", val);
+
+    /* `1` must read back as a real number: make it `1.0` */
+    if (_mStr.find_first_of(".e", begin) == std::string::npos) {
+        _mStr.append(".0", 2);
+    }
+
+    return *this;
+}
+
+} /* namespace bt2c */
@@ -0,0 +1,227 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_CPP_COMMON_BT2C_JSON_WRITER_HPP
+#define BABELTRACE_CPP_COMMON_BT2C_JSON_WRITER_HPP
+
+#include <cstddef>
+#include <string>
+
+#include "common/assert.h"
+#include "cpp-common/bt2s/string-view.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+namespace bt2c {
+
+/*
+ * Streaming JSON text writer.
+ *
+ * Each method appends compact JSON text to an internal string, adding
+ * the commas and colons, without building any intermediate document:
+ * the object member keys remain in the order of the key() calls.
+ *
+ * Example:
+ *
+ *     bt2c::JsonWriter writer;
+ *
+ *     writer.beginObj();
+ *     writer.key("name").strVal("meow");
+ *     writer.key("ids").beginArray().uIntVal(23).uIntVal(42).endArray();
+ *     writer.endObj();
+ *
+ *     // writer.str() is `{"name":"meow","ids":[23,42]}`
+ *
+ * The caller is responsible for the overall structure: a value within
+ * an object requires a preceding key() call.
+ */
+class JsonWriter final
+{
+public:
+    explicit JsonWriter() = default;
+
+    JsonWriter& beginObj()
+    {
+        this->_beforeVal();
+        _mStr += '{';
+        _mNeedComma = false;
+        return *this;
+    }
+
+    JsonWriter& endObj()
+    {
+        _mStr += '}';
+        _mNeedComma = true;
+        return *this;
+    }
+
+    JsonWriter& beginArray()
+    {
+        this->_beforeVal();
+        _mStr += '[';
+        _mNeedComma = false;
+        return *this;
+    }
+
+    JsonWriter& endArray()
+    {
+        _mStr += ']';
+        _mNeedComma = true;
+        return *this;
+    }
+
+    /*
+     * Appends the object member key `key`: the next call must append
+     * its value.
+     */
+    JsonWriter& key(const bt2s::string_view key)
+    {
+        BT_ASSERT_DBG(!_mAfterKey);
+
+        if (_mNeedComma) {
+            _mStr += ',';
+        }
+
+        this->_appendStr(key);
+        _mStr += ':';
+        _mNeedComma = false;
+        _mAfterKey = true;
+        return *this;
+    }
+
+    JsonWriter& nullVal()
+    {
+        this->_beforeVal();
+        _mStr.append("null", 4);
+        return *this;
+    }
+
+    JsonWriter& boolVal(const bool val)
+    {
+        this->_beforeVal();
+
+        if (val) {
+            _mStr.append("true", 4);
+        } else {
+            _mStr.append("false", 5);
+        }
+
+        return *this;
+    }
+
+    JsonWriter& uIntVal(const unsigned long long val)
+    {
+        this->_beforeVal();
+
+        const fmt::format_int str {val};
+
+        _mStr.append(str.data(), str.size());
+        return *this;
+    }
+
+    JsonWriter& sIntVal(const long long val)
+    {
+        this->_beforeVal();
+
+        const fmt::format_int str {val};
+
+        _mStr.append(str.data(), str.size());
+        return *this;
+    }
+
+    /*
+     * Appends the shortest representation of `val` which reads back as
+     * the same value, always with a fraction or an exponent so that a
+     * reader doesn't take it as an integer.
+     *
+     * Appends `null` if `val` is infinite or NaN, which JSON can't
+     * represent.
+     */
+    JsonWriter& realVal(double val);
+
+    /*
+     * Appends the string `val`, escaping it.
+     *
+     * `val` must be valid UTF-8: this method doesn't validate it.
+     */
+    JsonWriter& strVal(const bt2s::string_view val)
+    {
+        this->_beforeVal();
+        this->_appendStr(val);
+        return *this;
+    }
+
+    /*
+     * Appends the JSON text `json` as is, as a value.
+     *
+     * `json` must be a valid JSON value.
+     */
+    JsonWriter& rawVal(const bt2s::string_view json)
+    {
+        this->_beforeVal();
+        _mStr.append(json.data(), json.size());
+        return *this;
+    }
+
+    /*
+     * JSON text written so far.
+     */
+    const std::string& str() const noexcept
+    {
+        return _mStr;
+    }
+
+    /*
+     * Moves the JSON text written so far out of this writer, and makes
+     * it ready to write a new JSON value.
+     */
+    std::string release() noexcept
+    {
+        std::string str {std::move(_mStr)};
+
+        this->clear();
+        return str;
+    }
+
+    /*
+     * Clears the JSON text written so far, keeping the allocated
+     * memory, to write a new JSON value.
+     */
+    void clear() noexcept
+    {
+        _mStr.clear();
+        _mNeedComma = false;
+        _mAfterKey = false;
+    }
+
+private:
+    void _beforeVal()
+    {
+        if (_mAfterKey) {
+            _mAfterKey = false;
+        } else if (_mNeedComma) {
+            _mStr += ',';
+        }
+
+        _mNeedComma = true;
+    }
+
+    /*
+     * Appends `str` as an escaped JSON string (with double quotes).
+     */
+    void _appendStr(bt2s::string_view str);
+
+    std::string _mStr;
+
+    /* Whether or not the next value or key needs a preceding comma */
+    bool _mNeedComma = false;
+
+    /* Whether or not the last written item is a key */
+    bool _mAfterKey = false;
+};
+
+} /* namespace bt2c */
+
+#endif /* BABELTRACE_CPP_COMMON_BT2C_JSON_WRITER_HPP */
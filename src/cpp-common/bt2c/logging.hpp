@@ -9,6 +9,7 @@
 #include <cstring>
 #include <iterator>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -67,6 +68,13 @@ namespace bt2c {
  *
  * Use the BT_CPPLOG*() macros to use `__FILE__`, `__func__`, `__LINE__`
  * as the file name, function name, and line number.
+ *
+ * The conditional BT_CPPLOG*() macros (all of them except the
+ * `*_APPEND_CAUSE*` ones) only evaluate their arguments when the
+ * logger would log at their level, so that a disabled log statement
+ * costs a single comparison, whatever its arguments. A statement of
+ * which the level is more verbose than `BT_LOG_MINIMAL_LEVEL` doesn't
+ * even cost that: the build-time check is a constant expression.
  */
 class Logger final
 {
@@ -187,6 +195,15 @@ public:
         return _mLevel;
     }
 
+    /*
+     * Whether or not the level `level` is enabled at build time, that
+     * is, it's equally or less verbose than `BT_LOG_MINIMAL_LEVEL`.
+     */
+    static constexpr bool enabledAtBuildTime(const Level level) noexcept
+    {
+        return BT_LOG_ENABLED(static_cast<int>(level));
+    }
+
     /*
      * Whether or not this logger would log at the level `level`.
      */
@@ -608,12 +625,19 @@ inline const char *maybeNull(const char * const s) noexcept
 /* Internal: default logger name */
 #define _BT_CPPLOG_DEF_LOGGER _mLogger
 
+/*
+ * Internal: whether or not the level `_lvl` is enabled at build time
+ * (always a constant expression).
+ */
+#define _BT_CPPLOG_ENABLED_AT_BUILD_TIME(_lvl)                                                     \
+    (std::integral_constant<bool, bt2c::Logger::enabledAtBuildTime(_lvl)>::value)
+
 /*
  * Calls log() on `_logger` to log using the level `_lvl`.
  */
 #define BT_CPPLOG_EX(_lvl, _logger, _fmt, ...)                                                     \
     do {                                                                                           \
-        if (G_UNLIKELY((_logger).wouldLog(_lvl))) {                                                \
+        if (_BT_CPPLOG_ENABLED_AT_BUILD_TIME(_lvl) && G_UNLIKELY((_logger).wouldLog(_lvl))) {      \
             (_logger).template log<(_lvl), false>(__FILE__, __func__, __LINE__, (_fmt),            \
                                                   ##__VA_ARGS__);                                  \
         }                                                                                          \
@@ -651,7 +675,7 @@ inline const char *maybeNull(const char * const s) noexcept
  */
 #define BT_CPPLOG_MEM_EX(_lvl, _logger, _memData, _fmt, ...)                                       \
     do {                                                                                           \
-        if (G_UNLIKELY((_logger).wouldLog(_lvl))) {                                                \
+        if (_BT_CPPLOG_ENABLED_AT_BUILD_TIME(_lvl) && G_UNLIKELY((_logger).wouldLog(_lvl))) {      \
             (_logger).template logMem<(_lvl)>(__FILE__, __func__, __LINE__, (_memData), (_fmt),    \
                                               ##__VA_ARGS__);                                      \
         }                                                                                          \
@@ -696,7 +720,7 @@ inline const char *maybeNull(const char * const s) noexcept
  */
 #define BT_CPPLOG_ERRNO_EX(_lvl, _logger, _initMsg, _fmt, ...)                                     \
     do {                                                                                           \
-        if (G_UNLIKELY((_logger).wouldLog(_lvl))) {                                                \
+        if (_BT_CPPLOG_ENABLED_AT_BUILD_TIME(_lvl) && G_UNLIKELY((_logger).wouldLog(_lvl))) {      \
             (_logger).template logErrno<(_lvl), false>(__FILE__, __func__, __LINE__, (_initMsg),   \
                                                        (_fmt), ##__VA_ARGS__);                     \
         }                                                                                          \
@@ -741,7 +765,7 @@ inline const char *maybeNull(const char * const s) noexcept
  */
 #define BT_CPPLOG_TEXT_LOC_EX(_lvl, _logger, _textLoc, _fmt, ...)                                  \
     do {                                                                                           \
-        if (G_UNLIKELY((_logger).wouldLog(_lvl))) {                                                \
+        if (_BT_CPPLOG_ENABLED_AT_BUILD_TIME(_lvl) && G_UNLIKELY((_logger).wouldLog(_lvl))) {      \
             (_logger).template logTextLoc<(_lvl), false>(__FILE__, __func__, __LINE__, (_textLoc), \
                                                          (_fmt), ##__VA_ARGS__);                   \
         }                                                                                          \
@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef BABELTRACE_CPP_COMMON_BT2C_LOSER_TREE_HPP
+#define BABELTRACE_CPP_COMMON_BT2C_LOSER_TREE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glib.h>
+
+#include "common/assert.h"
+
+namespace bt2c {
+
+/*
+ * A tournament tree of losers, a drop-in alternative to `PrioHeap`
+ * (same methods, same comparator semantics) for a large number of
+ * elements.
+ *
+ * Each element occupies a leaf of a complete binary tree and each
+ * internal node holds the loser of the match between the winners of
+ * its two subtrees; the overall winner (greatest element) sits above
+ * the root.
+ *
+ * When the top element changes (replaceTop()) or leaves (removeTop()),
+ * restoring the tree means replaying its matches from its leaf up to
+ * the root: one comparison per level with the loser that the node
+ * already holds, instead of the two comparisons per level
+ * (children, then parent) of a heap sift-down. With 64 elements or
+ * more, this saves about 40 % of the comparisons, which pays off when
+ * comparing two elements is expensive; with cheap comparisons, the
+ * heap is usually as fast or faster.
+ *
+ * insert() only fills a free leaf: the next access to the top element
+ * rebuilds the whole tree (a linear number of comparisons). Therefore,
+ * this structure is best when you insert all the elements once and
+ * then mostly call replaceTop() and removeTop(), which is what a k-way
+ * merge does.
+ *
+ * `T` must be default-constructible, copy-constructible, and
+ * copy-assignable.
+ *
+ * `CompT` is the type of the callable comparator. It must be possible
+ * to call an instance `comp` of `CompT` as such:
+ *
+ *     comp(a, b)
+ *
+ * `comp` accepts two different `const T&` values and returns a value
+ * contextually convertible to `bool` which must be true if `a` appears
+ * _after_ `b`.
+ */
+template <typename T, typename CompT = std::greater<T>>
+class LoserTree final
+{
+    static_assert(std::is_default_constructible<T>::value, "`T` is default-constructible.");
+    static_assert(std::is_copy_constructible<T>::value, "`T` is copy-constructible.");
+    static_assert(std::is_copy_assignable<T>::value, "`T` is copy-assignable.");
+
+public:
+    /*
+     * Builds a loser tree using the comparator `comp` and with an
+     * initial capacity of `cap` elements.
+     */
+    explicit LoserTree(CompT comp, const std::size_t cap) : _mComp {std::move(comp)}
+    {
+        this->_grow(cap);
+    }
+
+    /*
+     * Builds a loser tree using the comparator `comp` and with an
+     * initial capacity of one element.
+     */
+    explicit LoserTree(CompT comp) : LoserTree {std::move(comp), 1}
+    {
+    }
+
+    /*
+     * Builds a loser tree using a default comparator and with an
+     * initial capacity of one element.
+     */
+    explicit LoserTree() : LoserTree {CompT {}, 1}
+    {
+    }
+
+    /*
+     * Number of contained elements.
+     */
+    std::size_t len() const noexcept
+    {
+        return _mLen;
+    }
+
+    /*
+     * Whether or not this tree is empty.
+     */
+    bool isEmpty() const noexcept
+    {
+        return _mLen == 0;
+    }
+
+    /*
+     * Removes all the elements.
+     */
+    void clear()
+    {
+        _mLen = 0;
+        _mFreeLeaves.clear();
+
+        for (std::size_t leaf = 0; leaf < _mLeaves.size(); ++leaf) {
+            _mLeaves[leaf].isOccupied = false;
+            _mFreeLeaves.push_back(_mLeaves.size() - 1 - leaf);
+        }
+
+        _mIsDirty = true;
+    }
+
+    /*
+     * Current top (greatest) element (`const` version).
+     */
+    const T& top() const
+    {
+        BT_ASSERT_DBG(!this->isEmpty());
+        this->_ensureBuilt();
+        this->_validate();
+        return _mLeaves[_mNodes[0]].elem;
+    }
+
+    /*
+     * Current top (greatest) element.
+     */
+    T& top()
+    {
+        BT_ASSERT_DBG(!this->isEmpty());
+        this->_ensureBuilt();
+        this->_validate();
+        return _mLeaves[_mNodes[0]].elem;
+    }
+
+    /*
+     * Second greatest element, or `nullptr` if this tree contains less
+     * than two elements.
+     *
+     * As long as the priority of the top element changes without it
+     * becoming less than this element, the top element remains the
+     * greatest one and you don't need to call replaceTop().
+     */
+    const T *secondTop() const
+    {
+        if (_mLen < 2) {
+            return nullptr;
+        }
+
+        this->_ensureBuilt();
+
+        /*
+         * The second greatest element necessarily lost its last match
+         * against the greatest one: it's the greatest of the losers on
+         * the path of the winner.
+         */
+        const auto winnerLeaf = _mNodes[0];
+        auto bestLeaf = _mLeaves.size();
+
+        for (auto node = this->_leafParentNode(winnerLeaf); node > 0; node >>= 1) {
+            const auto leaf = _mNodes[node];
+
+            if (_mLeaves[leaf].isOccupied &&
+                (bestLeaf == _mLeaves.size() || this->_beats(leaf, bestLeaf))) {
+                bestLeaf = leaf;
+            }
+        }
+
+        BT_ASSERT_DBG(bestLeaf < _mLeaves.size());
+        return &_mLeaves[bestLeaf].elem;
+    }
+
+    /*
+     * Comparator of this tree.
+     */
+    const CompT& comp() const noexcept
+    {
+        return _mComp;
+    }
+
+    /*
+     * Inserts a copy of the element `elem`.
+     */
+    void insert(const T& elem)
+    {
+        if (_mFreeLeaves.empty()) {
+            this->_grow(_mLeaves.size() * 2);
+        }
+
+        auto& leaf = _mLeaves[_mFreeLeaves.back()];
+
+        _mFreeLeaves.pop_back();
+        leaf.elem = elem;
+        leaf.isOccupied = true;
+        ++_mLen;
+        _mIsDirty = true;
+    }
+
+    /*
+     * Removes the top (greatest) element.
+     *
+     * This tree must not be empty.
+     */
+    void removeTop()
+    {
+        BT_ASSERT_DBG(!this->isEmpty());
+        this->_ensureBuilt();
+
+        const auto winnerLeaf = _mNodes[0];
+
+        _mLeaves[winnerLeaf].isOccupied = false;
+        _mFreeLeaves.push_back(winnerLeaf);
+        --_mLen;
+        this->_replay(winnerLeaf);
+    }
+
+    /*
+     * Removes the top (greatest) element, and inserts a copy of `elem`.
+     *
+     * Equivalent to using removeTop() and then insert(), but more
+     * efficient (single replay from the leaf of the top element).
+     *
+     * This tree must not be empty.
+     */
+    void replaceTop(const T& elem)
+    {
+        BT_ASSERT_DBG(!this->isEmpty());
+        this->_ensureBuilt();
+
+        const auto winnerLeaf = _mNodes[0];
+
+        _mLeaves[winnerLeaf].elem = elem;
+        this->_replay(winnerLeaf);
+        this->_validate();
+    }
+
+private:
+    struct _Leaf final
+    {
+        T elem;
+        bool isOccupied = false;
+    };
+
+    /*
+     * Grows the capacity of this tree to the smallest power of two
+     * which is greater than or equal to `cap` (at least one), keeping
+     * the elements where they are.
+     */
+    void _grow(const std::size_t cap)
+    {
+        auto newCap = _mLeaves.empty() ? std::size_t {1} : _mLeaves.size();
+
+        while (newCap < cap) {
+            newCap *= 2;
+        }
+
+        const auto oldCap = _mLeaves.size();
+
+        if (oldCap > 0 && newCap == oldCap) {
+            return;
+        }
+
+        _mLeaves.resize(newCap);
+
+        /* Lowest leaves are used first */
+        for (auto leaf = newCap; leaf > oldCap; --leaf) {
+            _mFreeLeaves.push_back(leaf - 1);
+        }
+
+        _mNodes.resize(newCap);
+        _mIsDirty = true;
+    }
+
+    /*
+     * Index, within `_mNodes`, of the parent node of the leaf `leaf`.
+     *
+     * Leaf `i` is conceptually the node `i + capacity`, so that the
+     * parent of any node `n` is `n / 2`, and the root is the node 1.
+     */
+    std::size_t _leafParentNode(const std::size_t leaf) const noexcept
+    {
+        return (leaf + _mLeaves.size()) >> 1;
+    }
+
+    /*
+     * Whether or not the element of the leaf `leafA` wins against the
+     * element of the leaf `leafB`.
+     *
+     * A free leaf loses against any occupied leaf.
+     */
+    bool _beats(const std::size_t leafA, const std::size_t leafB) const
+    {
+        if (!_mLeaves[leafA].isOccupied) {
+            return false;
+        }
+
+        if (!_mLeaves[leafB].isOccupied) {
+            return true;
+        }
+
+        /* Forward to user comparator */
+        return !_mComp(_mLeaves[leafB].elem, _mLeaves[leafA].elem);
+    }
+
+    /*
+     * Replays the matches from the leaf `leaf`, which must be the leaf
+     * of the current winner, up to the root.
+     */
+    void _replay(const std::size_t leaf)
+    {
+        auto winnerLeaf = leaf;
+
+        for (auto node = this->_leafParentNode(leaf); node > 0; node >>= 1) {
+            if (this->_beats(_mNodes[node], winnerLeaf)) {
+                std::swap(_mNodes[node], winnerLeaf);
+            }
+        }
+
+        _mNodes[0] = winnerLeaf;
+    }
+
+    /*
+     * Rebuilds the whole tree if needed.
+     */
+    void _ensureBuilt() const
+    {
+        if (G_LIKELY(!_mIsDirty)) {
+            return;
+        }
+
+        const auto cap = _mLeaves.size();
+
+        if (cap == 1) {
+            _mNodes[0] = 0;
+            _mIsDirty = false;
+            return;
+        }
+
+        /* Winner of each internal node, from the bottom up */
+        std::vector<std::size_t> winners(cap);
+
+        for (auto node = cap - 1; node > 0; --node) {
+            const auto leftNode = node << 1;
+            const auto rightNode = leftNode + 1;
+            const auto leftLeaf = leftNode >= cap ? leftNode - cap : winners[leftNode];
+            const auto rightLeaf = rightNode >= cap ? rightNode - cap : winners[rightNode];
+
+            if (this->_beats(rightLeaf, leftLeaf)) {
+                winners[node] = rightLeaf;
+                _mNodes[node] = leftLeaf;
+            } else {
+                winners[node] = leftLeaf;
+                _mNodes[node] = rightLeaf;
+            }
+        }
+
+        _mNodes[0] = winners[1];
+        _mIsDirty = false;
+    }
+
+    void _validate() const noexcept
+    {
+#ifdef BT_DEBUG_MODE
+        if (this->isEmpty()) {
+            return;
+        }
+
+        const auto& topElem = _mLeaves[_mNodes[0]].elem;
+
+        BT_ASSERT_DBG(_mLeaves[_mNodes[0]].isOccupied);
+
+        for (const auto& leaf : _mLeaves) {
+            BT_ASSERT_DBG(!leaf.isOccupied || !_mComp(leaf.elem, topElem));
+        }
+#endif /* BT_DEBUG_MODE */
+    }
+
+    CompT _mComp;
+
+    /* Leaves (capacity is a power of two) */
+    std::vector<_Leaf> _mLeaves;
+
+    /*
+     * Index of the winner leaf (index 0), and index of the loser leaf
+     * of each internal node (other indexes).
+     */
+    mutable std::vector<std::size_t> _mNodes;
+
+    /* Free leaves, the next one to use being the last one */
+    std::vector<std::size_t> _mFreeLeaves;
+
+    /* Number of occupied leaves */
+    std::size_t _mLen = 0;
+
+    /* Whether or not `_mNodes` needs a complete rebuild */
+    mutable bool _mIsDirty = true;
+};
+
+} /* namespace bt2c */
+
+#endif /* BABELTRACE_CPP_COMMON_BT2C_LOSER_TREE_HPP */
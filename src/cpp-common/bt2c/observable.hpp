@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -41,6 +42,11 @@ namespace bt2c {
  * Notify all the observers with the notify() method:
  *
  *    myObservable.notify(args);
+ *
+ * attach() and the destructor of a token are thread-safe, so that
+ * observers may come and go from different threads. notify() is not:
+ * make sure no other thread attaches or detaches an observer while
+ * calling it.
  */
 template <typename... Args>
 class Observable
@@ -102,9 +108,20 @@ public:
 public:
     Observable() = default;
     Observable(const Observable&) = delete;
-    Observable(Observable&&) = default;
+
+    Observable(Observable&& other) noexcept :
+        _mNextTokenId {other._mNextTokenId}, _mObservers {std::move(other._mObservers)}
+    {
+    }
+
     Observable& operator=(const Observable&) = delete;
-    Observable& operator=(Observable&&) = default;
+
+    Observable& operator=(Observable&& other) noexcept
+    {
+        _mNextTokenId = other._mNextTokenId;
+        _mObservers = std::move(other._mObservers);
+        return *this;
+    }
 
     /*
      * Attaches an observer using the user callback `func` to this
@@ -112,6 +129,7 @@ public:
      */
     Token attach(_ObserverFunc func)
     {
+        std::lock_guard<std::mutex> lock {_mObserversMutex};
         const auto tokenId = _mNextTokenId;
 
         ++_mNextTokenId;
@@ -149,6 +167,7 @@ private:
      */
     void _detach(const _TokenId tokenId)
     {
+        std::lock_guard<std::mutex> lock {_mObserversMutex};
         const auto it =
             std::remove_if(_mObservers.begin(), _mObservers.end(), [tokenId](_Observer& obs) {
                 return obs.tokenId == tokenId;
@@ -163,6 +182,9 @@ private:
 
     /* List of observers */
     mutable std::vector<_Observer> _mObservers;
+
+    /* Protects `_mNextTokenId` and `_mObservers` */
+    std::mutex _mObserversMutex;
 };
 
 } /* namespace bt2c */
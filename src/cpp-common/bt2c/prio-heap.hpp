@@ -123,6 +123,35 @@ public:
         return _mElems.front();
     }
 
+    /*
+     * Second greatest element, or `nullptr` if this heap contains less
+     * than two elements.
+     *
+     * As long as the priority of the top element changes without it
+     * becoming less than this element, the top element remains the
+     * greatest one and you don't need to call replaceTop().
+     */
+    const T *secondTop() const
+    {
+        if (_mElems.size() < 2) {
+            return nullptr;
+        }
+
+        if (_mElems.size() == 2 || this->_gt(_mElems[1], _mElems[2])) {
+            return &_mElems[1];
+        }
+
+        return &_mElems[2];
+    }
+
+    /*
+     * Comparator of this heap.
+     */
+    const CompT& comp() const noexcept
+    {
+        return _mComp;
+    }
+
     /*
      * Inserts a copy of the element `elem`.
      */
@@ -50,6 +50,54 @@ IntT readFixedLenIntBe(const std::uint8_t * const buf)
     return bigEndianToNative(readFixedLenInt<IntT>(buf));
 }
 
+/*
+ * Reads a fixed-length little-endian bit array of `len` bits, starting
+ * at the bit `bitOffset` of `buf[0]` (counting from its least
+ * significant bit), into a value of 64-bit integral type `IntT` with a
+ * single 64-bit load and returns it.
+ *
+ * The returned value is sign-extended if `IntT` is signed.
+ *
+ * `len` must be at least 1, `bitOffset + len` must be at most 64, and
+ * eight bytes must be readable at `buf`.
+ */
+template <typename IntT>
+IntT readFixedLenBitArrayLe(const std::uint8_t * const buf, const unsigned long long bitOffset,
+                            const unsigned long long len)
+{
+    static_assert(sizeof(IntT) == sizeof(std::uint64_t), "`IntT` is a 64-bit integer.");
+
+    /* Move the most significant bit of the bit array to bit 63 */
+    const auto word = readFixedLenIntLe<std::uint64_t>(buf) << (64 - bitOffset - len);
+
+    /* Sign-extends when `IntT` is signed */
+    return static_cast<IntT>(word) >> (64 - len);
+}
+
+/*
+ * Reads a fixed-length big-endian bit array of `len` bits, starting at
+ * the bit `bitOffset` of `buf[0]` (counting from its most significant
+ * bit), into a value of 64-bit integral type `IntT` with a single
+ * 64-bit load and returns it.
+ *
+ * The returned value is sign-extended if `IntT` is signed.
+ *
+ * `len` must be at least 1, `bitOffset + len` must be at most 64, and
+ * eight bytes must be readable at `buf`.
+ */
+template <typename IntT>
+IntT readFixedLenBitArrayBe(const std::uint8_t * const buf, const unsigned long long bitOffset,
+                            const unsigned long long len)
+{
+    static_assert(sizeof(IntT) == sizeof(std::uint64_t), "`IntT` is a 64-bit integer.");
+
+    /* Move the most significant bit of the bit array to bit 63 */
+    const auto word = readFixedLenIntBe<std::uint64_t>(buf) << bitOffset;
+
+    /* Sign-extends when `IntT` is signed */
+    return static_cast<IntT>(word) >> (64 - len);
+}
+
 } /* namespace bt2c */
 
 #endif /* BABELTRACE_CPP_COMMON_BT2C_READ_FIXED_LEN_INT_HPP */
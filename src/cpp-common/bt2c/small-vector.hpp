@@ -0,0 +1,231 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_CPP_COMMON_BT2C_SMALL_VECTOR_HPP
+#define BABELTRACE_CPP_COMMON_BT2C_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "common/assert.h"
+
+namespace bt2c {
+
+/*
+ * Vector of `T` instances which stores up to `InlineCapV` elements
+ * within itself, only allocating when it grows beyond that.
+ *
+ * This is a subset of the `std::vector` interface. Like
+ * `std::vector`, clear() and pop_back() keep the current storage, so
+ * that refilling the vector up to its previous size never allocates.
+ *
+ * Moving an element (when growing) uses its move constructor: the
+ * move constructor of `T` must not throw.
+ */
+template <typename T, std::size_t InlineCapV>
+class SmallVector final
+{
+    static_assert(InlineCapV > 0, "`InlineCapV` is greater than 0.");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+                  "`T` is nothrow move-constructible.");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    explicit SmallVector() noexcept = default;
+
+    /* Disable copy/move operations */
+    SmallVector(const SmallVector&) = delete;
+    SmallVector& operator=(const SmallVector&) = delete;
+
+    ~SmallVector()
+    {
+        this->clear();
+
+        if (!this->_isInline()) {
+            std::allocator<T> {}.deallocate(_mData, _mCap);
+        }
+    }
+
+    size_type size() const noexcept
+    {
+        return _mSize;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _mCap;
+    }
+
+    bool empty() const noexcept
+    {
+        return _mSize == 0;
+    }
+
+    T *data() noexcept
+    {
+        return _mData;
+    }
+
+    const T *data() const noexcept
+    {
+        return _mData;
+    }
+
+    iterator begin() noexcept
+    {
+        return _mData;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return _mData;
+    }
+
+    iterator end() noexcept
+    {
+        return _mData + _mSize;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _mData + _mSize;
+    }
+
+    T& operator[](const size_type index) noexcept
+    {
+        BT_ASSERT_DBG(index < _mSize);
+        return _mData[index];
+    }
+
+    const T& operator[](const size_type index) const noexcept
+    {
+        BT_ASSERT_DBG(index < _mSize);
+        return _mData[index];
+    }
+
+    T& back() noexcept
+    {
+        BT_ASSERT_DBG(!this->empty());
+        return _mData[_mSize - 1];
+    }
+
+    const T& back() const noexcept
+    {
+        BT_ASSERT_DBG(!this->empty());
+        return _mData[_mSize - 1];
+    }
+
+    /*
+     * Makes sure that the capacity of this vector is at least `cap`.
+     */
+    void reserve(const size_type cap)
+    {
+        if (cap > _mCap) {
+            this->_realloc(cap);
+        }
+    }
+
+    template <typename... ArgTs>
+    T& emplace_back(ArgTs&&...args)
+    {
+        if (_mSize == _mCap) {
+            this->_realloc(_mCap * 2);
+        }
+
+        T * const elem = ::new (static_cast<void *>(_mData + _mSize)) T(std::forward<ArgTs>(args)...);
+
+        ++_mSize;
+        return *elem;
+    }
+
+    void push_back(const T& elem)
+    {
+        this->emplace_back(elem);
+    }
+
+    void push_back(T&& elem)
+    {
+        this->emplace_back(std::move(elem));
+    }
+
+    void pop_back() noexcept
+    {
+        BT_ASSERT_DBG(!this->empty());
+        --_mSize;
+        _mData[_mSize].~T();
+    }
+
+    /*
+     * Resizes this vector to `size` elements, value-initializing the
+     * new ones, if any.
+     */
+    void resize(const size_type size)
+    {
+        this->reserve(size);
+
+        while (_mSize < size) {
+            this->emplace_back();
+        }
+
+        while (_mSize > size) {
+            this->pop_back();
+        }
+    }
+
+    void clear() noexcept
+    {
+        while (!this->empty()) {
+            this->pop_back();
+        }
+    }
+
+private:
+    bool _isInline() const noexcept
+    {
+        return _mData == reinterpret_cast<const T *>(&_mInlineStorage);
+    }
+
+    /*
+     * Moves the elements to a new storage having a capacity of `cap`.
+     */
+    void _realloc(const size_type cap)
+    {
+        BT_ASSERT_DBG(cap > _mSize);
+
+        T * const newData = std::allocator<T> {}.allocate(cap);
+
+        for (size_type i = 0; i < _mSize; ++i) {
+            ::new (static_cast<void *>(newData + i)) T(std::move(_mData[i]));
+            _mData[i].~T();
+        }
+
+        if (!this->_isInline()) {
+            std::allocator<T> {}.deallocate(_mData, _mCap);
+        }
+
+        _mData = newData;
+        _mCap = cap;
+    }
+
+    typename std::aligned_storage<sizeof(T) * InlineCapV, alignof(T)>::type _mInlineStorage;
+    T *_mData = reinterpret_cast<T *>(&_mInlineStorage);
+    size_type _mSize = 0;
+    size_type _mCap = InlineCapV;
+};
+
+} /* namespace bt2c */
+
+#endif /* BABELTRACE_CPP_COMMON_BT2C_SMALL_VECTOR_HPP */
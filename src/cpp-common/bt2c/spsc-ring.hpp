@@ -0,0 +1,138 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ */
+
+#ifndef BABELTRACE_CPP_COMMON_BT2C_SPSC_RING_HPP
+#define BABELTRACE_CPP_COMMON_BT2C_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/assert.h"
+
+namespace bt2c {
+
+/*
+ * Lock-free, fixed-capacity, single-producer/single-consumer ring of
+ * `T` instances.
+ *
+ * One thread (the producer) may call tryPush() while another one (the
+ * consumer) calls peek() and pop(): none of those methods block nor
+ * allocate. Both threads may call size(), empty(), and full(), which
+ * only return a snapshot.
+ *
+ * The capacity is the requested one rounded up to a power of two.
+ *
+ * `T` must be default-constructible and move-assignable: a popped slot
+ * is reset to `T {}` so that it doesn't retain resources.
+ */
+template <typename T>
+class SpscRing final
+{
+    static_assert(std::is_default_constructible<T>::value, "`T` is default-constructible.");
+    static_assert(std::is_move_assignable<T>::value, "`T` is move-assignable.");
+
+public:
+    explicit SpscRing(const std::size_t cap) : _mSlots(_roundUpPow2(cap)), _mMask {_mSlots.size() - 1}
+    {
+    }
+
+    /* Disable copy/move operations */
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const noexcept
+    {
+        return _mSlots.size();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return _mTail.load(std::memory_order_acquire) - _mHead.load(std::memory_order_acquire);
+    }
+
+    bool empty() const noexcept
+    {
+        return this->size() == 0;
+    }
+
+    bool full() const noexcept
+    {
+        return this->size() == this->capacity();
+    }
+
+    /*
+     * Producer: appends `elem`, returning false (leaving `elem` as is)
+     * if this ring is full.
+     */
+    bool tryPush(T&& elem)
+    {
+        const auto tail = _mTail.load(std::memory_order_relaxed);
+
+        if (tail - _mHead.load(std::memory_order_acquire) == this->capacity()) {
+            return false;
+        }
+
+        _mSlots[tail & _mMask] = std::move(elem);
+        _mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*
+     * Consumer: returns the element at the index `index` from the
+     * oldest one, or `nullptr` if there's no such element (yet).
+     */
+    T *peek(const std::size_t index = 0) noexcept
+    {
+        const auto head = _mHead.load(std::memory_order_relaxed);
+
+        if (_mTail.load(std::memory_order_acquire) - head <= index) {
+            return nullptr;
+        }
+
+        return &_mSlots[(head + index) & _mMask];
+    }
+
+    /*
+     * Consumer: removes the oldest element.
+     *
+     * This ring must not be empty.
+     */
+    void pop()
+    {
+        const auto head = _mHead.load(std::memory_order_relaxed);
+
+        BT_ASSERT_DBG(_mTail.load(std::memory_order_acquire) != head);
+        _mSlots[head & _mMask] = T {};
+        _mHead.store(head + 1, std::memory_order_release);
+    }
+
+private:
+    static std::size_t _roundUpPow2(const std::size_t val) noexcept
+    {
+        std::size_t pow2 = 1;
+
+        while (pow2 < val) {
+            pow2 <<= 1;
+        }
+
+        return pow2;
+    }
+
+    std::vector<T> _mSlots;
+    std::size_t _mMask;
+
+    /* Keep the indexes on separate cache lines to avoid false sharing */
+    alignas(64) std::atomic<std::size_t> _mHead {0};
+    alignas(64) std::atomic<std::size_t> _mTail {0};
+};
+
+} /* namespace bt2c */
+
+#endif /* BABELTRACE_CPP_COMMON_BT2C_SPSC_RING_HPP */
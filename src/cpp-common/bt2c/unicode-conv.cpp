@@ -4,119 +4,230 @@
  * SPDX-License-Identifier: MIT
  */
 
-#include <glib.h>
+#include <cstring>
+
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
 
 #include "common/assert.h"
 #include "cpp-common/bt2/exc.hpp"
 
+#include "read-fixed-len-int.hpp"
 #include "unicode-conv.hpp"
 
 namespace bt2c {
-namespace {
-
-const auto invalidGIConv = reinterpret_cast<GIConv>(-1);
-
-} /* namespace */
 
 UnicodeConv::UnicodeConv(const bt2c::Logger& parentLogger) :
-    _mLogger {parentLogger, "UNICODE-CONV"}, _mUtf16BeToUtf8IConv {invalidGIConv},
-    _mUtf16LeToUtf8IConv {invalidGIConv}, _mUtf32BeToUtf8IConv {invalidGIConv},
-    _mUtf32LeToUtf8IConv {invalidGIConv}
+    _mLogger {parentLogger, "UNICODE-CONV"}
 {
 }
 
 namespace {
 
-void tryCloseGIConv(const GIConv conv) noexcept
+/*
+ * Reads the code unit of `CodeUnitLenV` bytes at `buf`.
+ */
+template <std::size_t CodeUnitLenV, bool IsBeV>
+std::uint32_t readCodeUnit(const std::uint8_t * const buf) noexcept
 {
-    if (conv != invalidGIConv) {
-        g_iconv_close(conv);
+    if (CodeUnitLenV == 2) {
+        return IsBeV ? (static_cast<std::uint32_t>(buf[0]) << 8) | buf[1] :
+                       buf[0] | (static_cast<std::uint32_t>(buf[1]) << 8);
     }
-};
-
-} /* namespace */
 
-UnicodeConv::~UnicodeConv()
-{
-    tryCloseGIConv(_mUtf16BeToUtf8IConv);
-    tryCloseGIConv(_mUtf16LeToUtf8IConv);
-    tryCloseGIConv(_mUtf32BeToUtf8IConv);
-    tryCloseGIConv(_mUtf32LeToUtf8IConv);
+    return IsBeV ? readFixedLenIntBe<std::uint32_t>(buf) : readFixedLenIntLe<std::uint32_t>(buf);
 }
 
-ConstBytes UnicodeConv::_justDoIt(const char * const srcEncoding, GIConv& conv,
-                                  const ConstBytes data, const std::size_t codeUnitSize)
+/*
+ * Writes the UTF-8 encoding of the valid codepoint `cp` at `out`,
+ * returning the new end.
+ */
+std::uint8_t *writeUtf8(std::uint8_t *out, const std::uint32_t cp) noexcept
 {
-    /* Create iconv conversion descriptor if not created already */
-    if (conv == invalidGIConv) {
-        conv = g_iconv_open("UTF-8", srcEncoding);
-
-        if (conv == invalidGIConv) {
-            BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2::Error, "g_iconv_open() failed",
-                                                    ": from-encoding={}, to-encoding=UTF-8",
-                                                    srcEncoding);
-        }
+    if (cp < 0x80) {
+        *out++ = static_cast<std::uint8_t>(cp);
+    } else if (cp < 0x800) {
+        *out++ = static_cast<std::uint8_t>(0xc0 | (cp >> 6));
+        *out++ = static_cast<std::uint8_t>(0x80 | (cp & 0x3f));
+    } else if (cp < 0x10000) {
+        *out++ = static_cast<std::uint8_t>(0xe0 | (cp >> 12));
+        *out++ = static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3f));
+        *out++ = static_cast<std::uint8_t>(0x80 | (cp & 0x3f));
+    } else {
+        *out++ = static_cast<std::uint8_t>(0xf0 | (cp >> 18));
+        *out++ = static_cast<std::uint8_t>(0x80 | ((cp >> 12) & 0x3f));
+        *out++ = static_cast<std::uint8_t>(0x80 | ((cp >> 6) & 0x3f));
+        *out++ = static_cast<std::uint8_t>(0x80 | (cp & 0x3f));
     }
 
+    return out;
+}
+
+/*
+ * Copies the ASCII code units of `CodeUnitLenV` bytes from `in`
+ * (excluding `end`) to `out`, one 16-byte (SSE2) or 8-byte chunk at a
+ * time, stopping at the first chunk containing a non-ASCII code unit
+ * or when less than one chunk remains.
+ *
+ * Advances `in` and `out`.
+ */
+template <std::size_t CodeUnitLenV, bool IsBeV>
+void copyAsciiChunks(const std::uint8_t *& in, const std::uint8_t * const end,
+                     std::uint8_t *& out) noexcept
+{
     /*
-     * Compute a dumb, but safe upper bound for the UTF-8 output buffer.
+     * Within a little-endian 64-bit word of code units:
+     *
+     * `nonAsciiMask`:
+     *     Bits which must be cleared for all the code units to be
+     *     ASCII.
      *
-     * The input string can encode up to `data.size() / codeUnitSize`
-     * codepoints. Then, each code point can take up to four bytes in
-     * UTF-8.
+     * `asciiShift`:
+     *     Position of the ASCII byte within a code unit.
      */
-    _mBuf.resize(data.size() / codeUnitSize * 4);
-
-    /* Convert */
-    gsize inBytesLeft = data.size();
-    gsize outBytesLeft = _mBuf.size();
-    auto inBuf = const_cast<gchar *>(reinterpret_cast<const gchar *>(data.data()));
-    auto outBuf = reinterpret_cast<gchar *>(_mBuf.data());
-
-    if (g_iconv(conv, &inBuf, &inBytesLeft, &outBuf, &outBytesLeft) == -1) {
-        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(
-            bt2::Error, "g_iconv() failed",
-            ": input-byte-offset={}, from-encoding={}, to-encoding=UTF-8",
-            data.size() - inBytesLeft, srcEncoding);
+    constexpr std::uint64_t nonAsciiMask =
+        CodeUnitLenV == 2 ? (IsBeV ? 0x80ff80ff80ff80ffULL : 0xff80ff80ff80ff80ULL) :
+                            (IsBeV ? 0x80ffffff80ffffffULL : 0xffffff80ffffff80ULL);
+    constexpr unsigned int asciiShift = IsBeV ? (CodeUnitLenV - 1) * 8 : 0;
+
+#ifdef __SSE2__
+    const auto mask = _mm_set1_epi64x(static_cast<long long>(nonAsciiMask));
+    const auto zero = _mm_setzero_si128();
+
+    for (; end - in >= 16; in += 16) {
+        auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(chunk, mask), zero)) != 0xffff) {
+            /* At least one non-ASCII code unit */
+            return;
+        }
+
+        /* Narrow the code units to bytes */
+        if (CodeUnitLenV == 2) {
+            chunk = _mm_packus_epi16(_mm_srli_epi16(chunk, asciiShift), zero);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(out), chunk);
+            out += 8;
+        } else {
+            chunk = _mm_packs_epi32(_mm_srli_epi32(chunk, asciiShift), zero);
+
+            const auto bytes = _mm_cvtsi128_si32(_mm_packus_epi16(chunk, zero));
+
+            std::memcpy(out, &bytes, 4);
+            out += 4;
+        }
+    }
+#else
+    for (; end - in >= 8; in += 8) {
+        const auto word = readFixedLenIntLe<std::uint64_t>(in);
+
+        if (word & nonAsciiMask) {
+            /* At least one non-ASCII code unit */
+            return;
+        }
+
+        for (unsigned int i = 0; i < 8 / CodeUnitLenV; ++i) {
+            *out++ = static_cast<std::uint8_t>(word >> (i * CodeUnitLenV * 8 + asciiShift));
+        }
+    }
+#endif
+}
+
+} /* namespace */
+
+void UnicodeConv::_throwInvalidData(const char * const srcEncoding, const ConstBytes data,
+                                    const std::uint8_t * const pos, const char * const reason) const
+{
+    BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error,
+                                      "Cannot convert to UTF-8: {}: "
+                                      "input-byte-offset={}, from-encoding={}",
+                                      reason, pos - data.data(), srcEncoding);
+}
+
+template <std::size_t CodeUnitLenV, bool IsBeV>
+ConstBytes UnicodeConv::_justDoIt(const char * const srcEncoding, const ConstBytes data)
+{
+    if (data.size() % CodeUnitLenV != 0) {
+        this->_throwInvalidData(srcEncoding, data,
+                                data.data() + data.size() - data.size() % CodeUnitLenV,
+                                "incomplete code unit");
     }
 
     /*
-     * When g_iconv() is successful, assert that it consumed all input.
-     *
-     * The (underlying) iconv() documentation outlines three
-     * failure modes:
-     *
-     * 1. Insufficient output buffer space.
-     * 2. Invalid multibyte sequence in input.
-     * 3. Incomplete multibyte sequence in input.
-     *
-     * For any malformed input, iconv() will return error 2 or 3.
-     *
-     * This suggests that, barring input errors, a successful conversion
-     * will consume all input bytes.
+     * Upper bound for the UTF-8 output buffer: a UTF-16 code unit
+     * encodes a codepoint of at most three UTF-8 bytes, or half of a
+     * codepoint of four UTF-8 bytes; a UTF-32 code unit encodes a
+     * codepoint of at most four UTF-8 bytes.
      */
-    BT_ASSERT(inBytesLeft == 0);
-    return {_mBuf.data(), _mBuf.size() - outBytesLeft};
+    const auto maxOutSize = data.size() / CodeUnitLenV * (CodeUnitLenV == 2 ? 3 : 4);
+
+    if (_mBuf.size() < maxOutSize) {
+        _mBuf.resize(maxOutSize);
+    }
+
+    auto in = data.data();
+    const auto end = data.data() + data.size();
+    auto out = _mBuf.data();
+
+    while (in < end) {
+        copyAsciiChunks<CodeUnitLenV, IsBeV>(in, end, out);
+
+        if (in == end) {
+            break;
+        }
+
+        const auto cpBegin = in;
+        auto cp = readCodeUnit<CodeUnitLenV, IsBeV>(in);
+
+        in += CodeUnitLenV;
+
+        if (cp >= 0xd800 && cp <= 0xdfff) {
+            if (CodeUnitLenV == 4 || cp >= 0xdc00) {
+                this->_throwInvalidData(srcEncoding, data, cpBegin, "unexpected surrogate");
+            }
+
+            /* High surrogate: expect a low surrogate */
+            if (in == end) {
+                this->_throwInvalidData(srcEncoding, data, cpBegin, "incomplete surrogate pair");
+            }
+
+            const auto lowSurrogate = readCodeUnit<CodeUnitLenV, IsBeV>(in);
+
+            if (lowSurrogate < 0xdc00 || lowSurrogate > 0xdfff) {
+                this->_throwInvalidData(srcEncoding, data, in, "expecting a low surrogate");
+            }
+
+            in += CodeUnitLenV;
+            cp = 0x10000 + ((cp - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+        } else if (cp > 0x10ffff) {
+            this->_throwInvalidData(srcEncoding, data, cpBegin, "invalid codepoint");
+        }
+
+        out = writeUtf8(out, cp);
+    }
+
+    BT_ASSERT_DBG(static_cast<std::size_t>(out - _mBuf.data()) <= maxOutSize);
+    return {_mBuf.data(), static_cast<std::size_t>(out - _mBuf.data())};
 }
 
 ConstBytes UnicodeConv::utf8FromUtf16Be(const ConstBytes data)
 {
-    return this->_justDoIt("UTF-16BE", _mUtf16BeToUtf8IConv, data, 2);
+    return this->_justDoIt<2, true>("UTF-16BE", data);
 }
 
 ConstBytes UnicodeConv::utf8FromUtf16Le(const ConstBytes data)
 {
-    return this->_justDoIt("UTF-16LE", _mUtf16LeToUtf8IConv, data, 2);
+    return this->_justDoIt<2, false>("UTF-16LE", data);
 }
 
 ConstBytes UnicodeConv::utf8FromUtf32Be(const ConstBytes data)
 {
-    return this->_justDoIt("UTF-32BE", _mUtf32BeToUtf8IConv, data, 4);
+    return this->_justDoIt<4, true>("UTF-32BE", data);
 }
 
 ConstBytes UnicodeConv::utf8FromUtf32Le(const ConstBytes data)
 {
-    return this->_justDoIt("UTF-32LE", _mUtf32LeToUtf8IConv, data, 4);
+    return this->_justDoIt<4, false>("UTF-32LE", data);
 }
 
 } /* namespace bt2c */
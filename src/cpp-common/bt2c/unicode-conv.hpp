@@ -8,10 +8,9 @@
 #define BABELTRACE_CPP_COMMON_BT2C_UNICODE_CONV_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
-#include <glib.h>
-
 #include "logging.hpp"
 
 #include "aliases.hpp"
@@ -22,15 +21,20 @@ namespace bt2c {
  * A Unicode converter offers the utf8FromUtf*() methods to convert
  * UTF-16 and UTF-32 data to UTF-8.
  *
+ * The conversion methods copy runs of ASCII code units 16 bytes at a
+ * time (with SSE2 when available, or 8 bytes at a time within a 64-bit
+ * integer otherwise), and transcode the other codepoints one at a
+ * time, validating them.
+ *
  * IMPORTANT: The conversion methods aren't thread-safe: a `UnicodeConv`
  * instance keeps an internal buffer where it writes the resulting UTF-8
- * data.
+ * data. This buffer only grows, so that converting strings of similar
+ * lengths doesn't allocate.
  */
 class UnicodeConv final
 {
 public:
     explicit UnicodeConv(const bt2c::Logger& parentLogger);
-    ~UnicodeConv();
 
     /*
      * Converts the UTF-16BE data `data` to UTF-8 and returns it.
@@ -89,14 +93,13 @@ public:
     ConstBytes utf8FromUtf32Le(ConstBytes data);
 
 private:
-    ConstBytes _justDoIt(const char *sourceEncoding, GIConv& converter, const ConstBytes data,
-                         std::size_t codeUnitSize);
+    template <std::size_t CodeUnitLenV, bool IsBeV>
+    ConstBytes _justDoIt(const char *srcEncoding, ConstBytes data);
+
+    [[noreturn]] void _throwInvalidData(const char *srcEncoding, ConstBytes data,
+                                        const std::uint8_t *pos, const char *reason) const;
 
     bt2c::Logger _mLogger;
-    GIConv _mUtf16BeToUtf8IConv;
-    GIConv _mUtf16LeToUtf8IConv;
-    GIConv _mUtf32BeToUtf8IConv;
-    GIConv _mUtf32LeToUtf8IConv;
     std::vector<std::uint8_t> _mBuf;
 };
 
@@ -0,0 +1,1116 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ *
+ * The translation of the CTF writer objects to CTF 2 fragments follows
+ * the one of the `sink.ctf.fs` component class (see
+ * `src/plugins/ctf/fs-sink/translate-ctf-ir-to-json.cpp`).
+ */
+
+#define BT_LOG_TAG "CTF-WRITER/JSON-METADATA"
+#include "logging.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "common/uuid.h"
+#include "compat/endian.h"
+
+#include "attributes.h"
+#include "clock-class.h"
+#include "event-class.h"
+#include "field-path.h"
+#include "field-types.h"
+#include "json-metadata.h"
+#include "stream-class.h"
+#include "trace.h"
+#include "values.h"
+
+/* Namespace of the Babeltrace 2 attributes */
+#define BT_ATTRS_NS	"babeltrace.org,2020"
+
+struct json_metadata_context {
+	GString *json;
+	struct bt_ctf_trace_common *trace;
+
+	/* Stream class and event class being translated, or `NULL` */
+	struct bt_ctf_stream_class_common *stream_class;
+	struct bt_ctf_event_class_common *event_class;
+};
+
+/*
+ * Appends a comma to `json` unless the value or key to append is the
+ * first one of its object, array, or fragment, or follows a key.
+ */
+static
+void append_sep(GString *json)
+{
+	char last;
+
+	if (json->len == 0) {
+		return;
+	}
+
+	last = json->str[json->len - 1];
+
+	if (last != '{' && last != '[' && last != ':' && last != '\x1e') {
+		g_string_append_c(json, ',');
+	}
+}
+
+static
+void append_str(GString *json, const char *str)
+{
+	const char *ch;
+
+	append_sep(json);
+	g_string_append_c(json, '"');
+
+	for (ch = str; *ch != '\0'; ch++) {
+		const unsigned char c = (unsigned char) *ch;
+
+		if (c == '"' || c == '\\') {
+			g_string_append_c(json, '\\');
+			g_string_append_c(json, (char) c);
+		} else if (c < 0x20) {
+			g_string_append_printf(json, "\\u%04x", c);
+		} else {
+			g_string_append_c(json, (char) c);
+		}
+	}
+
+	g_string_append_c(json, '"');
+}
+
+static
+void append_uint(GString *json, uint64_t val)
+{
+	append_sep(json);
+	g_string_append_printf(json, "%" PRIu64, val);
+}
+
+static
+void append_int(GString *json, int64_t val)
+{
+	append_sep(json);
+	g_string_append_printf(json, "%" PRId64, val);
+}
+
+static
+void append_key(GString *json, const char *key)
+{
+	append_str(json, key);
+	g_string_append_c(json, ':');
+}
+
+static
+void begin_obj(GString *json)
+{
+	append_sep(json);
+	g_string_append_c(json, '{');
+}
+
+static
+void end_obj(GString *json)
+{
+	g_string_append_c(json, '}');
+}
+
+static
+void begin_array(GString *json)
+{
+	append_sep(json);
+	g_string_append_c(json, '[');
+}
+
+static
+void end_array(GString *json)
+{
+	g_string_append_c(json, ']');
+}
+
+static
+void append_str_prop(GString *json, const char *key, const char *val)
+{
+	append_key(json, key);
+	append_str(json, val);
+}
+
+static
+void append_uint_prop(GString *json, const char *key, uint64_t val)
+{
+	append_key(json, key);
+	append_uint(json, val);
+}
+
+static
+void append_roles_prop(GString *json, const char *role)
+{
+	append_key(json, "roles");
+	begin_array(json);
+	append_str(json, role);
+	end_array(json);
+}
+
+/* Each fragment is a JSON text of a JSON text sequence (RFC 7464) */
+static
+void begin_fragment(GString *json, const char *type)
+{
+	g_string_append_c(json, '\x1e');
+	begin_obj(json);
+	append_str_prop(json, "type", type);
+}
+
+static
+void end_fragment(GString *json)
+{
+	end_obj(json);
+	g_string_append_c(json, '\n');
+}
+
+static
+const char *byte_order_str(struct json_metadata_context *ctx,
+		enum bt_ctf_byte_order byte_order)
+{
+	if (byte_order == BT_CTF_BYTE_ORDER_NATIVE ||
+			byte_order == BT_CTF_BYTE_ORDER_UNSPECIFIED) {
+		byte_order = ctx->trace->native_byte_order;
+	}
+
+	switch (byte_order) {
+	case BT_CTF_BYTE_ORDER_LITTLE_ENDIAN:
+		return "little-endian";
+	case BT_CTF_BYTE_ORDER_BIG_ENDIAN:
+	case BT_CTF_BYTE_ORDER_NETWORK:
+		return "big-endian";
+	default:
+		return BYTE_ORDER == LITTLE_ENDIAN ?
+			"little-endian" : "big-endian";
+	}
+}
+
+/*
+ * Returns the CTF 2 role of the member named `name`, of which the type
+ * is `ft`, of the root field type of the scope `scope`, or `NULL` if
+ * it has none.
+ *
+ * Those are the members which the CTF writer sets automatically, as
+ * well as `stream_instance_id` (see
+ * bt_ctf_stream_borrow_thread_stream()).
+ */
+static
+const char *get_member_role(struct json_metadata_context *ctx,
+		enum bt_ctf_scope scope, const char *name,
+		struct bt_ctf_field_type_common *ft)
+{
+	const bool has_default_clock_class = ctx->stream_class &&
+		ctx->stream_class->clock_class;
+
+	if (ft->id == BT_CTF_FIELD_TYPE_ID_ENUM) {
+		ft = (void *) ((struct bt_ctf_field_type_common_enumeration *)
+			ft)->container_ft;
+	}
+
+	/* Roles only apply to unsigned integer field classes */
+	if (ft->id != BT_CTF_FIELD_TYPE_ID_INTEGER ||
+			((struct bt_ctf_field_type_common_integer *) ft)->is_signed) {
+		return NULL;
+	}
+
+	switch (scope) {
+	case BT_CTF_SCOPE_TRACE_PACKET_HEADER:
+		if (strcmp(name, "magic") == 0) {
+			return "packet-magic-number";
+		} else if (strcmp(name, "stream_id") == 0) {
+			return "data-stream-class-id";
+		} else if (strcmp(name, "stream_instance_id") == 0) {
+			return "data-stream-id";
+		}
+
+		break;
+	case BT_CTF_SCOPE_STREAM_PACKET_CONTEXT:
+		if (strcmp(name, "packet_size") == 0) {
+			return "packet-total-length";
+		} else if (strcmp(name, "content_size") == 0) {
+			return "packet-content-length";
+		} else if (strcmp(name, "events_discarded") == 0) {
+			return "discarded-event-record-counter-snapshot";
+		} else if (strcmp(name, "packet_seq_num") == 0) {
+			return "packet-sequence-number";
+		} else if (has_default_clock_class &&
+				strcmp(name, "timestamp_begin") == 0) {
+			return "default-clock-timestamp";
+		} else if (has_default_clock_class &&
+				strcmp(name, "timestamp_end") == 0) {
+			return "packet-end-default-clock-timestamp";
+		}
+
+		break;
+	case BT_CTF_SCOPE_STREAM_EVENT_HEADER:
+		if (strcmp(name, "id") == 0) {
+			return "event-record-class-id";
+		} else if (has_default_clock_class &&
+				strcmp(name, "timestamp") == 0) {
+			return "default-clock-timestamp";
+		}
+
+		break;
+	default:
+		break;
+	}
+
+	return NULL;
+}
+
+/*
+ * Returns whether or not `ft` is the type of encoded 8-bit characters,
+ * that is, of which a static or dynamic array is a CTF 2 string.
+ */
+static
+bool is_char_field_type(struct bt_ctf_field_type_common *ft)
+{
+	struct bt_ctf_field_type_common_integer *int_ft = (void *) ft;
+
+	return ft->id == BT_CTF_FIELD_TYPE_ID_INTEGER && int_ft->size == 8 &&
+		ft->alignment % 8 == 0 &&
+		int_ft->encoding != BT_CTF_STRING_ENCODING_NONE;
+}
+
+/*
+ * Returns whether or not `ft` is the type of the `uuid` member of the
+ * packet header, that is, an array of 16 bytes.
+ */
+static
+bool is_uuid_field_type(struct bt_ctf_field_type_common *ft)
+{
+	struct bt_ctf_field_type_common_array *array_ft = (void *) ft;
+	struct bt_ctf_field_type_common_integer *elem_ft;
+
+	if (ft->id != BT_CTF_FIELD_TYPE_ID_ARRAY || array_ft->length != 16 ||
+			array_ft->element_ft->id != BT_CTF_FIELD_TYPE_ID_INTEGER) {
+		return false;
+	}
+
+	elem_ft = (void *) array_ft->element_ft;
+	return elem_ft->size == 8 && !elem_ft->is_signed &&
+		array_ft->element_ft->alignment % 8 == 0;
+}
+
+static
+int append_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common *ft, const char *role);
+
+static
+void append_enum_mappings_prop(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_enumeration *enum_ft)
+{
+	GString *json = ctx->json;
+	const GPtrArray *entries = enum_ft->entries;
+	const bool is_signed = enum_ft->container_ft->is_signed;
+	guint i;
+
+	append_key(json, "mappings");
+	begin_obj(json);
+
+	for (i = 0; i < entries->len; i++) {
+		const struct bt_ctf_enumeration_mapping *mapping =
+			entries->pdata[i];
+		bool seen = false;
+		guint j;
+
+		/* Each label has a single entry with all its ranges */
+		for (j = 0; j < i; j++) {
+			const struct bt_ctf_enumeration_mapping *prev_mapping =
+				entries->pdata[j];
+
+			if (prev_mapping->string == mapping->string) {
+				seen = true;
+				break;
+			}
+		}
+
+		if (seen) {
+			continue;
+		}
+
+		append_key(json, g_quark_to_string(mapping->string));
+		begin_array(json);
+
+		for (j = i; j < entries->len; j++) {
+			const struct bt_ctf_enumeration_mapping *other_mapping =
+				entries->pdata[j];
+
+			if (other_mapping->string != mapping->string) {
+				continue;
+			}
+
+			begin_array(json);
+
+			if (is_signed) {
+				append_int(json,
+					other_mapping->range_start._signed);
+				append_int(json,
+					other_mapping->range_end._signed);
+			} else {
+				append_uint(json,
+					other_mapping->range_start._unsigned);
+				append_uint(json,
+					other_mapping->range_end._unsigned);
+			}
+
+			end_array(json);
+		}
+
+		end_array(json);
+	}
+
+	end_obj(json);
+}
+
+/*
+ * Appends the fixed-length integer field class of `int_ft`, with the
+ * mappings of `enum_ft` if not `NULL`.
+ */
+static
+void append_int_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_integer *int_ft,
+		struct bt_ctf_field_type_common_enumeration *enum_ft,
+		const char *role)
+{
+	GString *json = ctx->json;
+
+	begin_obj(json);
+	append_str_prop(json, "type", int_ft->is_signed ?
+		"fixed-length-signed-integer" :
+		"fixed-length-unsigned-integer");
+	append_uint_prop(json, "length", int_ft->size);
+	append_uint_prop(json, "alignment", int_ft->common.alignment);
+	append_str_prop(json, "byte-order",
+		byte_order_str(ctx, int_ft->user_byte_order));
+
+	switch (int_ft->base) {
+	case BT_CTF_INTEGER_BASE_BINARY:
+	case BT_CTF_INTEGER_BASE_OCTAL:
+	case BT_CTF_INTEGER_BASE_HEXADECIMAL:
+		append_uint_prop(json, "preferred-display-base",
+			(uint64_t) int_ft->base);
+		break;
+	default:
+		break;
+	}
+
+	if (enum_ft) {
+		append_enum_mappings_prop(ctx, enum_ft);
+	}
+
+	if (role) {
+		append_roles_prop(json, role);
+	}
+
+	end_obj(json);
+}
+
+static
+int append_float_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_floating_point *float_ft)
+{
+	GString *json = ctx->json;
+	unsigned int len;
+
+	if (float_ft->exp_dig == 8 && float_ft->mant_dig == 24) {
+		len = 32;
+	} else if (float_ft->exp_dig == 11 && float_ft->mant_dig == 53) {
+		len = 64;
+	} else {
+		BT_LOGW("CTF 2 only supports 32-bit and 64-bit floating point number field types: "
+			"ft-addr=%p, exp-dig=%u, mant-dig=%u",
+			float_ft, float_ft->exp_dig, float_ft->mant_dig);
+		return -1;
+	}
+
+	begin_obj(json);
+	append_str_prop(json, "type", "fixed-length-floating-point-number");
+	append_uint_prop(json, "length", len);
+	append_uint_prop(json, "alignment", float_ft->common.alignment);
+	append_str_prop(json, "byte-order",
+		byte_order_str(ctx, float_ft->user_byte_order));
+	end_obj(json);
+	return 0;
+}
+
+/*
+ * Appends the property named `key` of which the value is the CTF 2
+ * field location of `field_path`.
+ *
+ * A CTF 2 field location path only contains structure member names:
+ * the array, sequence, and variant field types which `field_path`
+ * also goes through are implicit.
+ */
+static
+int append_field_loc_prop(struct json_metadata_context *ctx,
+		const char *key, const struct bt_ctf_field_path *field_path)
+{
+	GString *json = ctx->json;
+	struct bt_ctf_field_type_common *ft;
+	const char *origin;
+	guint i;
+
+	if (!field_path) {
+		BT_LOGW("Field type has no resolved field path: key=\"%s\"",
+			key);
+		return -1;
+	}
+
+	switch (field_path->root) {
+	case BT_CTF_SCOPE_TRACE_PACKET_HEADER:
+		origin = "packet-header";
+		ft = ctx->trace->packet_header_field_type;
+		break;
+	case BT_CTF_SCOPE_STREAM_PACKET_CONTEXT:
+		origin = "packet-context";
+		BT_ASSERT(ctx->stream_class);
+		ft = ctx->stream_class->packet_context_field_type;
+		break;
+	case BT_CTF_SCOPE_STREAM_EVENT_HEADER:
+		origin = "event-record-header";
+		BT_ASSERT(ctx->stream_class);
+		ft = ctx->stream_class->event_header_field_type;
+		break;
+	case BT_CTF_SCOPE_STREAM_EVENT_CONTEXT:
+		origin = "event-record-common-context";
+		BT_ASSERT(ctx->stream_class);
+		ft = ctx->stream_class->event_context_field_type;
+		break;
+	case BT_CTF_SCOPE_EVENT_CONTEXT:
+		origin = "event-record-specific-context";
+		BT_ASSERT(ctx->event_class);
+		ft = ctx->event_class->context_field_type;
+		break;
+	case BT_CTF_SCOPE_EVENT_FIELDS:
+		origin = "event-record-payload";
+		BT_ASSERT(ctx->event_class);
+		ft = ctx->event_class->payload_field_type;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	append_key(json, key);
+	begin_obj(json);
+	append_str_prop(json, "origin", origin);
+	append_key(json, "path");
+	begin_array(json);
+
+	for (i = 0; i < field_path->indexes->len; i++) {
+		const int index = g_array_index(field_path->indexes, int, i);
+
+		BT_ASSERT(ft);
+
+		switch (ft->id) {
+		case BT_CTF_FIELD_TYPE_ID_STRUCT:
+		{
+			struct bt_ctf_field_type_common_structure_field *member =
+				BT_CTF_FIELD_TYPE_COMMON_STRUCTURE_FIELD_AT_INDEX(
+					ft, index);
+
+			append_str(json, g_quark_to_string(member->name));
+			ft = member->type;
+			break;
+		}
+		case BT_CTF_FIELD_TYPE_ID_VARIANT:
+			ft = BT_CTF_FIELD_TYPE_COMMON_VARIANT_CHOICE_AT_INDEX(
+				ft, index)->type;
+			break;
+		case BT_CTF_FIELD_TYPE_ID_ARRAY:
+			ft = ((struct bt_ctf_field_type_common_array *)
+				ft)->element_ft;
+			break;
+		case BT_CTF_FIELD_TYPE_ID_SEQUENCE:
+			ft = ((struct bt_ctf_field_type_common_sequence *)
+				ft)->element_ft;
+			break;
+		default:
+			bt_common_abort();
+		}
+	}
+
+	end_array(json);
+	end_obj(json);
+	return 0;
+}
+
+static
+int append_array_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_array *array_ft)
+{
+	GString *json = ctx->json;
+	int ret = 0;
+
+	begin_obj(json);
+
+	if (is_char_field_type(array_ft->element_ft)) {
+		append_str_prop(json, "type", "static-length-string");
+		append_uint_prop(json, "length", array_ft->length);
+	} else {
+		append_str_prop(json, "type", "static-length-array");
+		append_uint_prop(json, "length", array_ft->length);
+		append_key(json, "element-field-class");
+		ret = append_fc(ctx, array_ft->element_ft, NULL);
+	}
+
+	end_obj(json);
+	return ret;
+}
+
+static
+int append_sequence_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_sequence *seq_ft)
+{
+	GString *json = ctx->json;
+	const bool is_str = is_char_field_type(seq_ft->element_ft);
+	int ret;
+
+	begin_obj(json);
+	append_str_prop(json, "type", is_str ?
+		"dynamic-length-string" : "dynamic-length-array");
+	ret = append_field_loc_prop(ctx, "length-field-location",
+		seq_ft->length_field_path);
+	if (ret) {
+		goto end;
+	}
+
+	if (!is_str) {
+		append_key(json, "element-field-class");
+		ret = append_fc(ctx, seq_ft->element_ft, NULL);
+	}
+
+end:
+	end_obj(json);
+	return ret;
+}
+
+static
+int append_variant_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_variant *var_ft)
+{
+	GString *json = ctx->json;
+	bool is_signed;
+	guint i;
+	int ret;
+
+	if (!var_ft->tag_ft) {
+		BT_LOGW("Variant field type has no tag field type: ft-addr=%p",
+			var_ft);
+		return -1;
+	}
+
+	ret = bt_ctf_field_type_common_variant_update_choices(
+		(void *) var_ft);
+	if (ret) {
+		BT_LOGW("Cannot update variant field type's choices: "
+			"ft-addr=%p", var_ft);
+		return -1;
+	}
+
+	is_signed = var_ft->tag_ft->container_ft->is_signed;
+	begin_obj(json);
+	append_str_prop(json, "type", "variant");
+	ret = append_field_loc_prop(ctx, "selector-field-location",
+		var_ft->tag_field_path);
+	if (ret) {
+		goto end;
+	}
+
+	append_key(json, "options");
+	begin_array(json);
+
+	for (i = 0; i < var_ft->choices->len; i++) {
+		struct bt_ctf_field_type_common_variant_choice *choice =
+			BT_CTF_FIELD_TYPE_COMMON_VARIANT_CHOICE_AT_INDEX(
+				var_ft, i);
+		guint j;
+
+		if (choice->ranges->len == 0) {
+			/* No tag value selects this choice */
+			BT_LOGD("Skipping variant field type's choice without ranges: "
+				"ft-addr=%p, choice-name=\"%s\"", var_ft,
+				g_quark_to_string(choice->name));
+			continue;
+		}
+
+		begin_obj(json);
+		append_str_prop(json, "name", g_quark_to_string(choice->name));
+		append_key(json, "selector-field-ranges");
+		begin_array(json);
+
+		for (j = 0; j < choice->ranges->len; j++) {
+			struct bt_ctf_field_type_common_variant_choice_range *range =
+				&g_array_index(choice->ranges,
+					struct bt_ctf_field_type_common_variant_choice_range,
+					j);
+
+			begin_array(json);
+
+			if (is_signed) {
+				append_int(json, range->lower.i);
+				append_int(json, range->upper.i);
+			} else {
+				append_uint(json, range->lower.u);
+				append_uint(json, range->upper.u);
+			}
+
+			end_array(json);
+		}
+
+		end_array(json);
+		append_key(json, "field-class");
+		ret = append_fc(ctx, choice->type, NULL);
+		end_obj(json);
+
+		if (ret) {
+			goto end;
+		}
+	}
+
+	end_array(json);
+
+end:
+	end_obj(json);
+	return ret;
+}
+
+/*
+ * Appends the structure field class of `struct_ft`.
+ *
+ * `scope` is the scope of which `struct_ft` is the root field type,
+ * to give its known members their CTF 2 role, or
+ * `BT_CTF_SCOPE_UNKNOWN`.
+ */
+static
+int append_struct_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common_structure *struct_ft,
+		enum bt_ctf_scope scope)
+{
+	GString *json = ctx->json;
+	int ret = 0;
+	guint i;
+
+	begin_obj(json);
+	append_str_prop(json, "type", "structure");
+	append_uint_prop(json, "minimum-alignment",
+		struct_ft->common.alignment);
+	append_key(json, "member-classes");
+	begin_array(json);
+
+	for (i = 0; i < struct_ft->fields->len; i++) {
+		struct bt_ctf_field_type_common_structure_field *member =
+			BT_CTF_FIELD_TYPE_COMMON_STRUCTURE_FIELD_AT_INDEX(
+				struct_ft, i);
+		const char *name = g_quark_to_string(member->name);
+
+		begin_obj(json);
+		append_str_prop(json, "name", name);
+		append_key(json, "field-class");
+
+		if (scope == BT_CTF_SCOPE_TRACE_PACKET_HEADER &&
+				ctx->trace->uuid_set &&
+				strcmp(name, "uuid") == 0 &&
+				is_uuid_field_type(member->type)) {
+			begin_obj(json);
+			append_str_prop(json, "type", "static-length-blob");
+			append_uint_prop(json, "length", 16);
+			append_roles_prop(json, "metadata-stream-uuid");
+			end_obj(json);
+		} else {
+			ret = append_fc(ctx, member->type,
+				scope == BT_CTF_SCOPE_UNKNOWN ? NULL :
+				get_member_role(ctx, scope, name, member->type));
+		}
+
+		end_obj(json);
+
+		if (ret) {
+			goto end;
+		}
+	}
+
+	end_array(json);
+
+end:
+	end_obj(json);
+	return ret;
+}
+
+static
+int append_fc(struct json_metadata_context *ctx,
+		struct bt_ctf_field_type_common *ft, const char *role)
+{
+	int ret = 0;
+
+	switch (ft->id) {
+	case BT_CTF_FIELD_TYPE_ID_INTEGER:
+		append_int_fc(ctx, (void *) ft, NULL, role);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_ENUM:
+	{
+		struct bt_ctf_field_type_common_enumeration *enum_ft =
+			(void *) ft;
+
+		append_int_fc(ctx, enum_ft->container_ft, enum_ft, role);
+		break;
+	}
+	case BT_CTF_FIELD_TYPE_ID_FLOAT:
+		ret = append_float_fc(ctx, (void *) ft);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_STRING:
+		begin_obj(ctx->json);
+		append_str_prop(ctx->json, "type", "null-terminated-string");
+		end_obj(ctx->json);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_STRUCT:
+		ret = append_struct_fc(ctx, (void *) ft, BT_CTF_SCOPE_UNKNOWN);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_ARRAY:
+		ret = append_array_fc(ctx, (void *) ft);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_SEQUENCE:
+		ret = append_sequence_fc(ctx, (void *) ft);
+		break;
+	case BT_CTF_FIELD_TYPE_ID_VARIANT:
+		ret = append_variant_fc(ctx, (void *) ft);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	return ret;
+}
+
+/*
+ * Appends the property named `key` of which the value is the field
+ * class of `ft`, the root field type of the scope `scope`, if `ft` is
+ * not `NULL`.
+ */
+static
+int append_scope_fc_prop(struct json_metadata_context *ctx,
+		const char *key, struct bt_ctf_field_type_common *ft,
+		enum bt_ctf_scope scope)
+{
+	if (!ft) {
+		return 0;
+	}
+
+	BT_ASSERT(ft->id == BT_CTF_FIELD_TYPE_ID_STRUCT);
+	append_key(ctx->json, key);
+	return append_struct_fc(ctx, (void *) ft, scope);
+}
+
+static
+void append_preamble_fragment(struct json_metadata_context *ctx)
+{
+	GString *json = ctx->json;
+
+	begin_fragment(json, "preamble");
+	append_uint_prop(json, "version", 2);
+
+	if (ctx->trace->uuid_set) {
+		unsigned int i;
+
+		append_key(json, "uuid");
+		begin_array(json);
+
+		for (i = 0; i < BT_UUID_LEN; i++) {
+			append_uint(json, ctx->trace->uuid[i]);
+		}
+
+		end_array(json);
+	}
+
+	end_fragment(json);
+}
+
+static
+int append_trace_class_fragment(struct json_metadata_context *ctx)
+{
+	GString *json = ctx->json;
+	int64_t env_count;
+	int64_t i;
+	int ret;
+
+	begin_fragment(json, "trace-class");
+
+	if (ctx->trace->name) {
+		append_str_prop(json, "name", ctx->trace->name->str);
+	}
+
+	env_count = bt_ctf_attributes_get_count(ctx->trace->environment);
+	if (env_count > 0) {
+		append_key(json, "environment");
+		begin_obj(json);
+
+		for (i = 0; i < env_count; i++) {
+			const char *entry_name = bt_ctf_attributes_get_field_name(
+				ctx->trace->environment, i);
+			struct bt_ctf_value *entry_value =
+				bt_ctf_private_value_as_value(
+					bt_ctf_attributes_borrow_field_value(
+						ctx->trace->environment, i));
+
+			BT_ASSERT_DBG(entry_name);
+			BT_ASSERT_DBG(entry_value);
+			append_key(json, entry_name);
+
+			switch (bt_ctf_value_get_type(entry_value)) {
+			case BT_CTF_VALUE_TYPE_INTEGER:
+				append_int(json,
+					bt_ctf_value_integer_get(entry_value));
+				break;
+			case BT_CTF_VALUE_TYPE_STRING:
+				append_str(json,
+					bt_ctf_value_string_get(entry_value));
+				break;
+			default:
+				bt_common_abort();
+			}
+		}
+
+		end_obj(json);
+	}
+
+	ret = append_scope_fc_prop(ctx, "packet-header-field-class",
+		ctx->trace->packet_header_field_type,
+		BT_CTF_SCOPE_TRACE_PACKET_HEADER);
+	end_fragment(json);
+	return ret;
+}
+
+static
+void append_clock_class_fragment(struct json_metadata_context *ctx,
+		struct bt_ctf_clock_class *clock_class)
+{
+	GString *json = ctx->json;
+	int64_t seconds = clock_class->offset_s;
+	int64_t cycles = clock_class->offset;
+
+	begin_fragment(json, "clock-class");
+	append_str_prop(json, "id", clock_class->name->str);
+	append_str_prop(json, "name", clock_class->name->str);
+	append_uint_prop(json, "frequency", clock_class->frequency);
+
+	/* CTF 2 requires 0 <= cycles < frequency */
+	if (cycles < 0 || (uint64_t) cycles >= clock_class->frequency) {
+		int64_t extra_seconds = cycles / (int64_t) clock_class->frequency;
+
+		cycles -= extra_seconds * (int64_t) clock_class->frequency;
+
+		if (cycles < 0) {
+			extra_seconds--;
+			cycles += (int64_t) clock_class->frequency;
+		}
+
+		seconds += extra_seconds;
+	}
+
+	if (seconds != 0 || cycles != 0) {
+		append_key(json, "offset-from-origin");
+		begin_obj(json);
+		append_key(json, "seconds");
+		append_int(json, seconds);
+		append_uint_prop(json, "cycles", (uint64_t) cycles);
+		end_obj(json);
+	}
+
+	if (clock_class->absolute) {
+		append_str_prop(json, "origin", "unix-epoch");
+	}
+
+	append_uint_prop(json, "precision", clock_class->precision);
+
+	if (clock_class->description) {
+		append_str_prop(json, "description",
+			clock_class->description->str);
+	}
+
+	if (clock_class->uuid_set) {
+		char uuid_str[BT_UUID_STR_LEN + 1];
+
+		bt_uuid_to_str(clock_class->uuid, uuid_str);
+		append_str_prop(json, "uid", uuid_str);
+	}
+
+	end_fragment(json);
+}
+
+static
+int append_data_stream_class_fragment(struct json_metadata_context *ctx)
+{
+	struct bt_ctf_stream_class_common *stream_class = ctx->stream_class;
+	GString *json = ctx->json;
+	int ret;
+
+	begin_fragment(json, "data-stream-class");
+	append_uint_prop(json, "id", (uint64_t) stream_class->id);
+
+	if (stream_class->name && stream_class->name->len > 0) {
+		append_str_prop(json, "name", stream_class->name->str);
+	}
+
+	if (stream_class->clock_class) {
+		append_str_prop(json, "default-clock-class-id",
+			stream_class->clock_class->name->str);
+	}
+
+	ret = append_scope_fc_prop(ctx, "packet-context-field-class",
+		stream_class->packet_context_field_type,
+		BT_CTF_SCOPE_STREAM_PACKET_CONTEXT);
+	if (ret) {
+		goto end;
+	}
+
+	ret = append_scope_fc_prop(ctx, "event-record-header-field-class",
+		stream_class->event_header_field_type,
+		BT_CTF_SCOPE_STREAM_EVENT_HEADER);
+	if (ret) {
+		goto end;
+	}
+
+	ret = append_scope_fc_prop(ctx,
+		"event-record-common-context-field-class",
+		stream_class->event_context_field_type,
+		BT_CTF_SCOPE_STREAM_EVENT_CONTEXT);
+
+end:
+	end_fragment(json);
+	return ret;
+}
+
+static
+const char *log_level_str(int log_level)
+{
+	static const char * const strs[] = {
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_EMERGENCY] = "emergency",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_ALERT] = "alert",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_CRITICAL] = "critical",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_ERROR] = "error",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_WARNING] = "warning",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_NOTICE] = "notice",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_INFO] = "info",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_SYSTEM] = "debug:system",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_PROGRAM] = "debug:program",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_PROCESS] = "debug:process",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_MODULE] = "debug:module",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_UNIT] = "debug:unit",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_FUNCTION] = "debug:function",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG_LINE] = "debug:line",
+		[BT_CTF_EVENT_CLASS_LOG_LEVEL_DEBUG] = "debug",
+	};
+
+	if (log_level < 0 || log_level >= (int) G_N_ELEMENTS(strs)) {
+		return NULL;
+	}
+
+	return strs[log_level];
+}
+
+static
+int append_event_record_class_fragment(struct json_metadata_context *ctx)
+{
+	struct bt_ctf_event_class_common *event_class = ctx->event_class;
+	const char *log_level = log_level_str(event_class->log_level);
+	GString *json = ctx->json;
+	int ret;
+
+	begin_fragment(json, "event-record-class");
+	append_uint_prop(json, "id", (uint64_t) event_class->id);
+	append_uint_prop(json, "data-stream-class-id",
+		(uint64_t) ctx->stream_class->id);
+	append_str_prop(json, "name", event_class->name->str);
+
+	if (log_level || event_class->emf_uri) {
+		append_key(json, "attributes");
+		begin_obj(json);
+		append_key(json, BT_ATTRS_NS);
+		begin_obj(json);
+
+		if (log_level) {
+			append_str_prop(json, "log-level", log_level);
+		}
+
+		if (event_class->emf_uri) {
+			append_str_prop(json, "emf-uri",
+				event_class->emf_uri->str);
+		}
+
+		end_obj(json);
+		end_obj(json);
+	}
+
+	ret = append_scope_fc_prop(ctx, "specific-context-field-class",
+		event_class->context_field_type, BT_CTF_SCOPE_EVENT_CONTEXT);
+	if (ret) {
+		goto end;
+	}
+
+	ret = append_scope_fc_prop(ctx, "payload-field-class",
+		event_class->payload_field_type, BT_CTF_SCOPE_EVENT_FIELDS);
+
+end:
+	end_fragment(json);
+	return ret;
+}
+
+char *bt_ctf_trace_get_json_metadata_string(struct bt_ctf_trace *trace)
+{
+	struct json_metadata_context ctx = { 0 };
+	int ret;
+	guint i;
+
+	BT_ASSERT(trace);
+	ctx.json = g_string_sized_new(4096);
+	ctx.trace = BT_CTF_TO_COMMON(trace);
+	append_preamble_fragment(&ctx);
+	ret = append_trace_class_fragment(&ctx);
+	if (ret) {
+		goto error;
+	}
+
+	for (i = 0; i < ctx.trace->clock_classes->len; i++) {
+		append_clock_class_fragment(&ctx,
+			ctx.trace->clock_classes->pdata[i]);
+	}
+
+	for (i = 0; i < ctx.trace->stream_classes->len; i++) {
+		guint j;
+
+		ctx.stream_class = ctx.trace->stream_classes->pdata[i];
+		ctx.event_class = NULL;
+		ret = append_data_stream_class_fragment(&ctx);
+		if (ret) {
+			goto error;
+		}
+
+		for (j = 0; j < ctx.stream_class->event_classes->len; j++) {
+			ctx.event_class =
+				ctx.stream_class->event_classes->pdata[j];
+			ret = append_event_record_class_fragment(&ctx);
+			if (ret) {
+				goto error;
+			}
+		}
+	}
+
+	return g_string_free(ctx.json, FALSE);
+
+error:
+	BT_LOGW("Cannot translate trace to CTF 2 metadata: trace-addr=%p",
+		trace);
+	g_string_free(ctx.json, TRUE);
+	return NULL;
+}
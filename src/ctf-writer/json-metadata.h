@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_CTF_WRITER_JSON_METADATA_H
+#define BABELTRACE_CTF_WRITER_JSON_METADATA_H
+
+struct bt_ctf_trace;
+
+/*
+ * Returns the CTF 2 metadata stream of `trace`, a JSON text sequence of
+ * fragments (preamble, trace class, clock classes, data stream classes,
+ * and event record classes), as a new string which the caller must
+ * free with g_free(), or `NULL` on error.
+ *
+ * The known members of the packet header, packet context, and event
+ * header field types (`magic`, `packet_size`, `timestamp_begin`, and
+ * `id`, for example) get the corresponding CTF 2 roles.
+ */
+char *bt_ctf_trace_get_json_metadata_string(struct bt_ctf_trace *trace);
+
+#endif /* BABELTRACE_CTF_WRITER_JSON_METADATA_H */
@@ -9,8 +9,12 @@
 #include "logging.h"
 
 #include <inttypes.h>
+#include <pthread.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #include <babeltrace2-ctf-writer/field-types.h>
@@ -22,12 +26,14 @@
 #include "common/align.h"
 #include "common/assert.h"
 #include "compat/compiler.h"
+#include "compat/endian.h"
 #include "ctfser/ctfser.h"
 
 #include "assert-pre.h"
 #include "event-class.h"
 #include "event.h"
 #include "fields.h"
+#include "lttng-index.h"
 #include "stream-class.h"
 #include "stream.h"
 #include "trace.h"
@@ -135,7 +141,7 @@ static
 int set_integer_field_value(struct bt_ctf_field* field, uint64_t value)
 {
 	int ret = 0;
-	struct bt_ctf_field_type *field_type = NULL;
+	struct bt_ctf_field_type *field_type;
 
 	if (!field) {
 		BT_LOGW_STR("Invalid parameter: field is NULL.");
@@ -143,7 +149,11 @@ int set_integer_field_value(struct bt_ctf_field* field, uint64_t value)
 		goto end;
 	}
 
-	field_type = bt_ctf_field_get_type(field);
+	/*
+	 * Borrow the field type: it can be shared with the sub-streams
+	 * of other threads (see bt_ctf_stream_borrow_thread_stream()).
+	 */
+	field_type = (void *) ((struct bt_ctf_field_common *) field)->type;
 	BT_ASSERT_DBG(field_type);
 
 	if (bt_ctf_field_type_get_type_id(field_type) !=
@@ -178,16 +188,32 @@ int set_integer_field_value(struct bt_ctf_field* field, uint64_t value)
 		}
 	}
 end:
-	bt_ctf_object_put_ref(field_type);
 	return ret;
 }
 
+/*
+ * Returns a new reference to the member field of `structure` at
+ * `index`, or `NULL` if `structure` is `NULL` or `index` is -1 (see the
+ * `*_member_indexes` members of `struct bt_ctf_stream`).
+ */
+static
+struct bt_ctf_field *get_member_field(struct bt_ctf_field *structure,
+		int index)
+{
+	if (!structure || index < 0) {
+		return NULL;
+	}
+
+	return bt_ctf_field_structure_get_field_by_index(structure, index);
+}
+
 static
 int set_packet_header_magic(struct bt_ctf_stream *stream)
 {
 	int ret = 0;
-	struct bt_ctf_field *magic_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_header, "magic");
+	struct bt_ctf_field *magic_field = get_member_field(
+		stream->packet_header,
+		stream->packet_header_member_indexes.magic);
 	const uint32_t magic_value = 0xc1fc1fc1;
 
 	BT_ASSERT_DBG(stream);
@@ -225,8 +251,9 @@ int set_packet_header_uuid(struct bt_ctf_stream *stream)
 	int ret = 0;
 	int64_t i;
 	struct bt_ctf_trace *trace = NULL;
-	struct bt_ctf_field *uuid_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_header, "uuid");
+	struct bt_ctf_field *uuid_field = get_member_field(
+		stream->packet_header,
+		stream->packet_header_member_indexes.uuid);
 
 	BT_ASSERT_DBG(stream);
 
@@ -239,7 +266,7 @@ int set_packet_header_uuid(struct bt_ctf_stream *stream)
 	}
 
 	trace = (struct bt_ctf_trace *)
-		bt_ctf_object_get_parent(&stream->common.base);
+		bt_ctf_object_borrow_parent(&stream->common.base);
 
 	for (i = 0; i < 16; i++) {
 		struct bt_ctf_field *uuid_element =
@@ -264,7 +291,6 @@ int set_packet_header_uuid(struct bt_ctf_stream *stream)
 
 end:
 	bt_ctf_object_put_ref(uuid_field);
-	BT_CTF_OBJECT_PUT_REF_AND_RESET(trace);
 	return ret;
 }
 static
@@ -272,9 +298,9 @@ int set_packet_header_stream_id(struct bt_ctf_stream *stream)
 {
 	int ret = 0;
 	uint32_t stream_id;
-	struct bt_ctf_field *stream_id_field =
-		bt_ctf_field_structure_get_field_by_name(
-			stream->packet_header, "stream_id");
+	struct bt_ctf_field *stream_id_field = get_member_field(
+		stream->packet_header,
+		stream->packet_header_member_indexes.stream_id);
 
 	if (!stream_id_field) {
 		/* No stream_id field found. Not an error, skip. */
@@ -350,8 +376,9 @@ int set_packet_context_packet_size(struct bt_ctf_stream *stream,
 		uint64_t packet_size_bits)
 {
 	int ret = 0;
-	struct bt_ctf_field *field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "packet_size");
+	struct bt_ctf_field *field = get_member_field(
+		stream->packet_context,
+		stream->packet_context_member_indexes.packet_size);
 
 	ret = bt_ctf_field_integer_unsigned_set_value(field, packet_size_bits);
 	if (ret) {
@@ -375,8 +402,9 @@ int set_packet_context_content_size(struct bt_ctf_stream *stream,
 		uint64_t content_size_bits)
 {
 	int ret = 0;
-	struct bt_ctf_field *field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "content_size");
+	struct bt_ctf_field *field = get_member_field(
+		stream->packet_context,
+		stream->packet_context_member_indexes.content_size);
 
 	BT_ASSERT_DBG(stream);
 
@@ -410,8 +438,9 @@ static
 int set_packet_context_events_discarded(struct bt_ctf_stream *stream)
 {
 	int ret = 0;
-	struct bt_ctf_field *field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "events_discarded");
+	struct bt_ctf_field *field = get_member_field(
+		stream->packet_context,
+		stream->packet_context_member_indexes.events_discarded);
 
 	BT_ASSERT_DBG(stream);
 
@@ -521,8 +550,8 @@ int visit_field_update_clock_value(struct bt_ctf_field *field, uint64_t *val)
 	case BT_CTF_FIELD_TYPE_ID_INTEGER:
 	{
 		struct bt_ctf_clock_class *cc =
-			bt_ctf_field_type_integer_get_mapped_clock_class(
-				(void *) field_common->type);
+			bt_ctf_field_type_common_integer_borrow_mapped_clock_class(
+				field_common->type);
 		int val_size;
 		uint64_t uval;
 
@@ -530,7 +559,6 @@ int visit_field_update_clock_value(struct bt_ctf_field *field, uint64_t *val)
 			goto end;
 		}
 
-		bt_ctf_object_put_ref(cc);
 		val_size = bt_ctf_field_type_integer_get_size(
 			(void *) field_common->type);
 		BT_ASSERT_DBG(val_size >= 1);
@@ -651,46 +679,169 @@ end:
 	return ret;
 }
 
+/*
+ * Scopes of an event which contain an integer field of which the type
+ * is mapped to a clock class.
+ */
+enum event_clock_field_scope {
+	EVENT_CLOCK_FIELD_SCOPE_HEADER			= 1 << 0,
+	EVENT_CLOCK_FIELD_SCOPE_STREAM_EVENT_CONTEXT	= 1 << 1,
+	EVENT_CLOCK_FIELD_SCOPE_CONTEXT			= 1 << 2,
+	EVENT_CLOCK_FIELD_SCOPE_PAYLOAD			= 1 << 3,
+
+	/*
+	 * Always set so that a cached value is never 0 (which
+	 * g_hash_table_lookup() returns for a missing key).
+	 */
+	EVENT_CLOCK_FIELD_SCOPE_KNOWN			= 1 << 4,
+};
+
+/*
+ * Returns whether or not `ft` is or contains an integer field type
+ * mapped to a clock class.
+ */
 static
-int visit_event_update_clock_value(struct bt_ctf_event *event, uint64_t *val)
+bool field_type_has_mapped_clock_class(struct bt_ctf_field_type_common *ft)
+{
+	struct bt_ctf_clock_class *clock_class = NULL;
+
+	/*
+	 * This sets `clock_class` to the first mapped clock class it
+	 * finds, if any; the return value (single clock class or not)
+	 * doesn't matter here.
+	 */
+	(void) bt_ctf_field_type_common_validate_single_clock_class(ft,
+		&clock_class);
+	bt_ctf_object_put_ref(clock_class);
+	return clock_class;
+}
+
+/*
+ * Returns the lock of the writer of `stream`.
+ */
+static
+pthread_mutex_t *borrow_writer_lock(struct bt_ctf_stream *stream)
+{
+	struct bt_ctf_trace_common *trace =
+		bt_ctf_stream_class_common_borrow_trace(
+			stream->common.stream_class);
+	struct bt_ctf_writer *writer =
+		(void *) bt_ctf_object_borrow_parent(&trace->base);
+
+	BT_ASSERT_DBG(writer);
+	return &writer->lock;
+}
+
+/*
+ * Returns the scopes (`enum event_clock_field_scope` bits) of `event`
+ * which visit_event_update_clock_value() needs to visit.
+ *
+ * The field types of those scopes are frozen once an event of this
+ * class is appended to a stream, and the fields of an event must have
+ * equivalent types, therefore this is cached per event class.
+ */
+static
+unsigned int get_event_clock_field_scopes(struct bt_ctf_stream *stream,
+		struct bt_ctf_event *event)
+{
+	struct bt_ctf_event_class_common *event_class = event->common.class;
+	struct bt_ctf_stream_class_common *stream_class =
+		stream->common.stream_class;
+	unsigned int scopes = GPOINTER_TO_UINT(g_hash_table_lookup(
+		stream->event_clock_field_scopes, event_class));
+
+	if (scopes) {
+		goto end;
+	}
+
+	/*
+	 * The field types are shared with the sub-streams of other
+	 * threads (see bt_ctf_stream_borrow_thread_stream()) and
+	 * field_type_has_mapped_clock_class() modifies reference counts.
+	 */
+	pthread_mutex_lock(borrow_writer_lock(stream));
+	scopes = EVENT_CLOCK_FIELD_SCOPE_KNOWN;
+
+	if (field_type_has_mapped_clock_class(
+			stream_class->event_header_field_type)) {
+		scopes |= EVENT_CLOCK_FIELD_SCOPE_HEADER;
+	}
+
+	if (field_type_has_mapped_clock_class(
+			stream_class->event_context_field_type)) {
+		scopes |= EVENT_CLOCK_FIELD_SCOPE_STREAM_EVENT_CONTEXT;
+	}
+
+	if (field_type_has_mapped_clock_class(
+			event_class->context_field_type)) {
+		scopes |= EVENT_CLOCK_FIELD_SCOPE_CONTEXT;
+	}
+
+	if (field_type_has_mapped_clock_class(
+			event_class->payload_field_type)) {
+		scopes |= EVENT_CLOCK_FIELD_SCOPE_PAYLOAD;
+	}
+
+	BT_LOGT("Cached event class's clock field scopes: "
+		"stream-addr=%p, event-class-addr=%p, scopes=%x",
+		stream, event_class, scopes);
+	g_hash_table_insert(stream->event_clock_field_scopes, event_class,
+		GUINT_TO_POINTER(scopes));
+	pthread_mutex_unlock(borrow_writer_lock(stream));
+
+end:
+	return scopes;
+}
+
+static
+int visit_event_update_clock_value(struct bt_ctf_event *event,
+		unsigned int scopes, uint64_t *val)
 {
 	int ret = 0;
 	struct bt_ctf_field *field;
 
-	field = bt_ctf_event_get_header(event);
-	ret = visit_field_update_clock_value(field, val);
-	bt_ctf_object_put_ref(field);
-	if (ret) {
-		BT_LOGW_STR("Cannot automatically update clock value in "
-			"event's header.");
-		goto end;
+	if (scopes & EVENT_CLOCK_FIELD_SCOPE_HEADER) {
+		field = bt_ctf_event_get_header(event);
+		ret = visit_field_update_clock_value(field, val);
+		bt_ctf_object_put_ref(field);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically update clock value in "
+				"event's header.");
+			goto end;
+		}
 	}
 
-	field = bt_ctf_event_get_stream_event_context(event);
-	ret = visit_field_update_clock_value(field, val);
-	bt_ctf_object_put_ref(field);
-	if (ret) {
-		BT_LOGW_STR("Cannot automatically update clock value in "
-			"event's stream event context.");
-		goto end;
+	if (scopes & EVENT_CLOCK_FIELD_SCOPE_STREAM_EVENT_CONTEXT) {
+		field = bt_ctf_event_get_stream_event_context(event);
+		ret = visit_field_update_clock_value(field, val);
+		bt_ctf_object_put_ref(field);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically update clock value in "
+				"event's stream event context.");
+			goto end;
+		}
 	}
 
-	field = bt_ctf_event_get_context(event);
-	ret = visit_field_update_clock_value(field, val);
-	bt_ctf_object_put_ref(field);
-	if (ret) {
-		BT_LOGW_STR("Cannot automatically update clock value in "
-			"event's context.");
-		goto end;
+	if (scopes & EVENT_CLOCK_FIELD_SCOPE_CONTEXT) {
+		field = bt_ctf_event_get_context(event);
+		ret = visit_field_update_clock_value(field, val);
+		bt_ctf_object_put_ref(field);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically update clock value in "
+				"event's context.");
+			goto end;
+		}
 	}
 
-	field = bt_ctf_event_get_payload_field(event);
-	ret = visit_field_update_clock_value(field, val);
-	bt_ctf_object_put_ref(field);
-	if (ret) {
-		BT_LOGW_STR("Cannot automatically update clock value in "
-			"event's payload.");
-		goto end;
+	if (scopes & EVENT_CLOCK_FIELD_SCOPE_PAYLOAD) {
+		field = bt_ctf_event_get_payload_field(event);
+		ret = visit_field_update_clock_value(field, val);
+		bt_ctf_object_put_ref(field);
+		if (ret) {
+			BT_LOGW_STR("Cannot automatically update clock value in "
+				"event's payload.");
+			goto end;
+		}
 	}
 
 end:
@@ -704,10 +855,12 @@ int set_packet_context_timestamps(struct bt_ctf_stream *stream)
 	uint64_t val;
 	uint64_t cur_clock_value;
 	uint64_t init_clock_value = 0;
-	struct bt_ctf_field *ts_begin_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "timestamp_begin");
-	struct bt_ctf_field *ts_end_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "timestamp_end");
+	struct bt_ctf_field *ts_begin_field = get_member_field(
+		stream->packet_context,
+		stream->packet_context_member_indexes.timestamp_begin);
+	struct bt_ctf_field *ts_end_field = get_member_field(
+		stream->packet_context,
+		stream->packet_context_member_indexes.timestamp_end);
 	struct bt_ctf_field_common *packet_context =
 		(void *) stream->packet_context;
 	uint64_t i;
@@ -749,12 +902,18 @@ int set_packet_context_timestamps(struct bt_ctf_stream *stream)
 	 * `packet_size`, `content_size`, `events_discarded`, and
 	 * `packet_seq_num` if they are not set because those are
 	 * autopopulating fields.
+	 *
+	 * Skip the packet context fields and the event scopes which
+	 * cannot contain any integer field mapped to a clock class
+	 * altogether.
 	 */
-	len = bt_ctf_field_type_structure_get_field_count(
-		(void *) packet_context->type);
+	len = stream->packet_context_has_clock_fields ?
+		bt_ctf_field_type_structure_get_field_count(
+			(void *) packet_context->type) : 0;
 	BT_ASSERT_DBG(len >= 0);
 
 	for (i = 0; i < len; i++) {
+		const int member_index = (int) i;
 		const char *member_name;
 		struct bt_ctf_field *member_field;
 
@@ -762,8 +921,8 @@ int set_packet_context_timestamps(struct bt_ctf_stream *stream)
 			(void *) packet_context->type, &member_name, NULL, i);
 		BT_ASSERT_DBG(ret == 0);
 
-		if (strcmp(member_name, "timestamp_begin") == 0 ||
-				strcmp(member_name, "timestamp_end") == 0) {
+		if (member_index == stream->packet_context_member_indexes.timestamp_begin ||
+				member_index == stream->packet_context_member_indexes.timestamp_end) {
 			continue;
 		}
 
@@ -771,25 +930,10 @@ int set_packet_context_timestamps(struct bt_ctf_stream *stream)
 			stream->packet_context, i);
 		BT_ASSERT_DBG(member_field);
 
-		if (strcmp(member_name, "packet_size") == 0 &&
-				!bt_ctf_field_is_set_recursive(member_field)) {
-			bt_ctf_object_put_ref(member_field);
-			continue;
-		}
-
-		if (strcmp(member_name, "content_size") == 0 &&
-				!bt_ctf_field_is_set_recursive(member_field)) {
-			bt_ctf_object_put_ref(member_field);
-			continue;
-		}
-
-		if (strcmp(member_name, "events_discarded") == 0 &&
-				!bt_ctf_field_is_set_recursive(member_field)) {
-			bt_ctf_object_put_ref(member_field);
-			continue;
-		}
-
-		if (strcmp(member_name, "packet_seq_num") == 0 &&
+		if ((member_index == stream->packet_context_member_indexes.packet_size ||
+				member_index == stream->packet_context_member_indexes.content_size ||
+				member_index == stream->packet_context_member_indexes.events_discarded ||
+				member_index == stream->packet_context_member_indexes.packet_seq_num) &&
 				!bt_ctf_field_is_set_recursive(member_field)) {
 			bt_ctf_object_put_ref(member_field);
 			continue;
@@ -811,9 +955,17 @@ int set_packet_context_timestamps(struct bt_ctf_stream *stream)
 
 	for (i = 0; i < stream->events->len; i++) {
 		struct bt_ctf_event *event = g_ptr_array_index(stream->events, i);
+		unsigned int scopes;
 
 		BT_ASSERT_DBG(event);
-		ret = visit_event_update_clock_value(event, &cur_clock_value);
+		scopes = get_event_clock_field_scopes(stream, event);
+
+		if (scopes == EVENT_CLOCK_FIELD_SCOPE_KNOWN) {
+			continue;
+		}
+
+		ret = visit_event_update_clock_value(event, scopes,
+			&cur_clock_value);
 		if (ret) {
 			BT_LOGW("Cannot automatically update clock value "
 				"in stream's packet context: "
@@ -928,6 +1080,36 @@ end:
 	return ret;
 }
 
+/*
+ * Adds `event`, which only its parent stream owns, to the event pool of
+ * its class, if any, so that bt_ctf_stream_append_event_with_payload()
+ * can reuse it.
+ *
+ * Returns whether or not the stream took `event`.
+ */
+static
+bool recycle_event(struct bt_ctf_event *event)
+{
+	struct bt_ctf_stream *stream = (void *) bt_ctf_object_borrow_parent(
+		&event->common.base);
+	GPtrArray *events;
+
+	BT_ASSERT_DBG(stream);
+
+	if (!stream->event_pools) {
+		/* Stream is being destroyed */
+		return false;
+	}
+
+	events = g_hash_table_lookup(stream->event_pools, event->common.class);
+	if (!events) {
+		return false;
+	}
+
+	g_ptr_array_add(events, event);
+	return true;
+}
+
 static
 void release_event(struct bt_ctf_event *event)
 {
@@ -939,9 +1121,107 @@ void release_event(struct bt_ctf_event *event)
 		 */
 		bt_ctf_object_get_ref(event->common.class);
 		BT_CTF_OBJECT_PUT_REF_AND_RESET(event->common.base.parent);
-	} else {
+	} else if (!recycle_event(event)) {
+		bt_ctf_object_try_spec_release(&event->common.base);
+	}
+}
+
+static
+void destroy_event_pool(GPtrArray *events)
+{
+	guint i;
+
+	for (i = 0; i < events->len; i++) {
+		struct bt_ctf_event *event = g_ptr_array_index(events, i);
+
 		bt_ctf_object_try_spec_release(&event->common.base);
 	}
+
+	g_ptr_array_free(events, TRUE);
+}
+
+/*
+ * Returns the index of the member named `name` of the structure field
+ * type `ft`, or -1 if `ft` is `NULL` or has no such member.
+ */
+static
+int get_member_index(struct bt_ctf_field_type_common *ft, const char *name)
+{
+	if (!ft) {
+		return -1;
+	}
+
+	return bt_ctf_field_type_common_structure_get_field_name_index(ft,
+		name);
+}
+
+/*
+ * Resolves the indexes of the known members of the packet header and
+ * packet context fields of `stream` as well as whether or not its
+ * packet context field can contain clock values, once and for all,
+ * instead of looking them up by name for each packet.
+ */
+static
+void resolve_packet_members(struct bt_ctf_stream *stream,
+		struct bt_ctf_field_type_common *packet_header_ft)
+{
+	struct bt_ctf_field_type_common *packet_context_ft =
+		stream->common.stream_class->packet_context_field_type;
+	int64_t i;
+	int64_t count;
+
+	stream->packet_header_member_indexes.magic =
+		get_member_index(packet_header_ft, "magic");
+	stream->packet_header_member_indexes.uuid =
+		get_member_index(packet_header_ft, "uuid");
+	stream->packet_header_member_indexes.stream_id =
+		get_member_index(packet_header_ft, "stream_id");
+	stream->packet_context_member_indexes.packet_size =
+		get_member_index(packet_context_ft, "packet_size");
+	stream->packet_context_member_indexes.content_size =
+		get_member_index(packet_context_ft, "content_size");
+	stream->packet_context_member_indexes.events_discarded =
+		get_member_index(packet_context_ft, "events_discarded");
+	stream->packet_context_member_indexes.packet_seq_num =
+		get_member_index(packet_context_ft, "packet_seq_num");
+	stream->packet_context_member_indexes.timestamp_begin =
+		get_member_index(packet_context_ft, "timestamp_begin");
+	stream->packet_context_member_indexes.timestamp_end =
+		get_member_index(packet_context_ft, "timestamp_end");
+	stream->packet_context_has_clock_fields = false;
+
+	if (!packet_context_ft) {
+		goto end;
+	}
+
+	count = bt_ctf_field_type_common_structure_get_field_count(
+		packet_context_ft);
+	BT_ASSERT_DBG(count >= 0);
+
+	for (i = 0; i < count; i++) {
+		const char *name;
+		struct bt_ctf_field_type_common *member_ft;
+		int ret;
+
+		if (i == stream->packet_context_member_indexes.timestamp_begin ||
+				i == stream->packet_context_member_indexes.timestamp_end) {
+			continue;
+		}
+
+		ret = bt_ctf_field_type_common_structure_borrow_field_by_index(
+			packet_context_ft, &name, &member_ft, i);
+		BT_ASSERT_DBG(ret == 0);
+
+		if (field_type_has_mapped_clock_class(member_ft)) {
+			stream->packet_context_has_clock_fields = true;
+			break;
+		}
+	}
+
+end:
+	BT_LOGD("Resolved stream's packet header and packet context members: "
+		"stream-addr=%p, packet-context-has-clock-fields=%d",
+		stream, stream->packet_context_has_clock_fields);
 }
 
 static
@@ -1010,11 +1290,11 @@ append_ids:
 		goto end;
 	}
 
-	ret = bt_ctfser_init(&stream->ctfser, file_path,
-		BT_LOG_OUTPUT_LEVEL);
+	ret = bt_ctfser_init_with_writer(&stream->ctfser, file_path,
+		writer->ctfser_writer, BT_LOG_OUTPUT_LEVEL);
 	g_free(file_path);
 	if (ret) {
-		/* bt_ctfser_init() logs errors */
+		/* bt_ctfser_init_with_writer() logs errors */
 		goto end;
 	}
 
@@ -1028,6 +1308,96 @@ end:
 	return ret;
 }
 
+/*
+ * Closes and removes the index file of `stream`, if any, so that a
+ * reader doesn't use an incomplete index.
+ */
+static
+void discard_index_file(struct bt_ctf_stream *stream)
+{
+	if (!stream->index_file) {
+		return;
+	}
+
+	BT_LOGW("Discarding stream's index file: stream-addr=%p, "
+		"path=\"%s\"", stream, stream->index_path);
+	fclose(stream->index_file);
+	stream->index_file = NULL;
+
+	if (unlink(stream->index_path)) {
+		BT_LOGW_ERRNO("Cannot remove stream's index file", ": path=\"%s\"",
+			stream->index_path);
+	}
+
+	g_free(stream->index_path);
+	stream->index_path = NULL;
+}
+
+/*
+ * Creates the index file of `stream` in the `index` directory of the
+ * trace and writes its header if `writer` writes index files and the
+ * packet context of `stream` has the members which an index entry
+ * needs.
+ *
+ * Not an error if this fails: a reader can index the stream file
+ * itself.
+ */
+static
+void try_create_index_file(struct bt_ctf_writer *writer,
+		struct bt_ctf_stream *stream)
+{
+	struct ctf_packet_index_file_hdr hdr;
+	gchar *index_dir = NULL;
+	gchar *basename = NULL;
+	gchar *filename = NULL;
+
+	if (!writer->write_index ||
+			stream->packet_context_member_indexes.packet_size < 0 ||
+			stream->packet_context_member_indexes.timestamp_begin < 0 ||
+			stream->packet_context_member_indexes.timestamp_end < 0) {
+		goto end;
+	}
+
+	index_dir = g_build_filename(writer->path->str, "index", NULL);
+	if (g_mkdir_with_parents(index_dir, S_IRWXU | S_IRWXG)) {
+		BT_LOGW_ERRNO("Cannot create index directory", ": path=\"%s\"",
+			index_dir);
+		goto end;
+	}
+
+	basename = g_path_get_basename(stream->ctfser.path->str);
+	filename = g_strdup_printf("%s.idx", basename);
+	stream->index_path = g_build_filename(index_dir, filename, NULL);
+	stream->index_file = fopen(stream->index_path, "wb");
+	if (!stream->index_file) {
+		BT_LOGW_ERRNO("Cannot create stream's index file", ": path=\"%s\"",
+			stream->index_path);
+		g_free(stream->index_path);
+		stream->index_path = NULL;
+		goto end;
+	}
+
+	hdr.magic = htobe32(CTF_INDEX_MAGIC);
+	hdr.index_major = htobe32(CTF_INDEX_MAJOR);
+	hdr.index_minor = htobe32(CTF_INDEX_MINOR);
+	hdr.packet_index_len = htobe32(sizeof(struct ctf_packet_index));
+
+	if (fwrite(&hdr, sizeof(hdr), 1, stream->index_file) != 1) {
+		BT_LOGW_ERRNO("Cannot write stream's index file header",
+			": path=\"%s\"", stream->index_path);
+		discard_index_file(stream);
+		goto end;
+	}
+
+	BT_LOGD("Created stream's index file: stream-addr=%p, path=\"%s\"",
+		stream, stream->index_path);
+
+end:
+	g_free(index_dir);
+	g_free(basename);
+	g_free(filename);
+}
+
 struct bt_ctf_stream *bt_ctf_stream_create_with_id(
 		struct bt_ctf_stream_class *stream_class,
 		const char *name, uint64_t id)
@@ -1107,6 +1477,22 @@ struct bt_ctf_stream *bt_ctf_stream_create_with_id(
 		goto error;
 	}
 
+	stream->event_clock_field_scopes = g_hash_table_new(g_direct_hash,
+		g_direct_equal);
+	if (!stream->event_clock_field_scopes) {
+		BT_LOGE_STR("Failed to allocate a GHashTable.");
+		goto error;
+	}
+
+	stream->event_pools = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, NULL, (GDestroyNotify) destroy_event_pool);
+	if (!stream->event_pools) {
+		BT_LOGE_STR("Failed to allocate a GHashTable.");
+		goto error;
+	}
+
+	resolve_packet_members(stream, trace->common.packet_header_field_type);
+
 	if (trace->common.packet_header_field_type) {
 		BT_LOGD("Creating stream's packet header field: "
 			"ft-addr=%p", trace->common.packet_header_field_type);
@@ -1140,6 +1526,8 @@ struct bt_ctf_stream *bt_ctf_stream_create_with_id(
 		goto error;
 	}
 
+	try_create_index_file(writer, stream);
+
 	/* Freeze the writer */
 	BT_LOGD_STR("Freezing stream's CTF writer.");
 	bt_ctf_writer_freeze(writer);
@@ -1167,6 +1555,71 @@ struct bt_ctf_stream *bt_ctf_stream_create(
 		name, id_param);
 }
 
+BT_EXPORT
+struct bt_ctf_stream *bt_ctf_stream_borrow_thread_stream(
+		struct bt_ctf_stream *stream)
+{
+	struct bt_ctf_stream *thread_stream = NULL;
+	pthread_mutex_t *writer_lock;
+	GThread *thread = g_thread_self();
+	gchar *name = NULL;
+
+	if (!stream) {
+		BT_LOGW_STR("Invalid parameter: stream is NULL.");
+		goto end;
+	}
+
+	writer_lock = borrow_writer_lock(stream);
+	pthread_mutex_lock(writer_lock);
+
+	if (!stream->thread_streams) {
+		stream->thread_streams = g_hash_table_new(g_direct_hash,
+			g_direct_equal);
+		if (!stream->thread_streams) {
+			BT_LOGE_STR("Failed to allocate a GHashTable.");
+			goto unlock;
+		}
+	}
+
+	/*
+	 * A `GThread` object exists as long as its thread runs, therefore
+	 * a new thread only reuses the sub-stream of a finished one.
+	 */
+	thread_stream = g_hash_table_lookup(stream->thread_streams, thread);
+	if (thread_stream) {
+		goto unlock;
+	}
+
+	if (stream->common.name) {
+		name = g_strdup_printf("%s-%u", stream->common.name->str,
+			g_hash_table_size(stream->thread_streams));
+	}
+
+	BT_LOGD("Creating thread sub-stream: stream-addr=%p, "
+		"stream-name=\"%s\", thread-addr=%p, sub-stream-name=\"%s\"",
+		stream, bt_ctf_stream_get_name(stream), thread, name);
+	thread_stream = bt_ctf_stream_create_with_id(
+		BT_CTF_FROM_COMMON(stream->common.stream_class), name, -1ULL);
+	if (!thread_stream) {
+		BT_LOGW_STR("Cannot create thread sub-stream.");
+		goto unlock;
+	}
+
+	/* The trace keeps the sub-stream until it's destroyed */
+	bt_ctf_object_put_ref(thread_stream);
+	g_hash_table_insert(stream->thread_streams, thread, thread_stream);
+	BT_LOGD("Created thread sub-stream: stream-addr=%p, "
+		"sub-stream-addr=%p, sub-stream-id=%" PRId64,
+		stream, thread_stream, thread_stream->common.id);
+
+unlock:
+	pthread_mutex_unlock(writer_lock);
+
+end:
+	g_free(name);
+	return thread_stream;
+}
+
 BT_EXPORT
 int bt_ctf_stream_get_discarded_events_count(
 		struct bt_ctf_stream *stream, uint64_t *count)
@@ -1202,8 +1655,8 @@ int set_packet_context_events_discarded_field(struct bt_ctf_stream *stream,
 		goto end;
 	}
 
-	events_discarded_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "events_discarded");
+	events_discarded_field = get_member_field(stream->packet_context,
+		stream->packet_context_member_indexes.events_discarded);
 	if (!events_discarded_field) {
 		goto end;
 	}
@@ -1244,8 +1697,8 @@ void bt_ctf_stream_append_discarded_events(struct bt_ctf_stream *stream,
 		goto end;
 	}
 
-	events_discarded_field = bt_ctf_field_structure_get_field_by_name(
-		stream->packet_context, "events_discarded");
+	events_discarded_field = get_member_field(stream->packet_context,
+		stream->packet_context_member_indexes.events_discarded);
 	if (!events_discarded_field) {
 		BT_LOGW_STR("No field named `events_discarded` in stream's packet context.");
 		goto end;
@@ -1331,8 +1784,8 @@ static int auto_populate_event_header(struct bt_ctf_stream *stream,
 			bt_ctf_field_get_type_id(id_field) == BT_CTF_FIELD_TYPE_ID_INTEGER &&
 			!bt_ctf_field_is_set_recursive(timestamp_field)) {
 		mapped_clock_class =
-			bt_ctf_field_type_integer_get_mapped_clock_class(
-				(void *) ((struct bt_ctf_field_common *) timestamp_field)->type);
+			bt_ctf_field_type_common_integer_borrow_mapped_clock_class(
+				((struct bt_ctf_field_common *) timestamp_field)->type);
 		if (mapped_clock_class) {
 			uint64_t timestamp;
 
@@ -1360,7 +1813,6 @@ static int auto_populate_event_header(struct bt_ctf_stream *stream,
 end:
 	bt_ctf_object_put_ref(id_field);
 	bt_ctf_object_put_ref(timestamp_field);
-	bt_ctf_object_put_ref(mapped_clock_class);
 	return ret;
 }
 
@@ -1451,6 +1903,316 @@ error:
 	return ret;
 }
 
+/*
+ * Returns whether or not bt_ctf_stream_append_event_with_payload()
+ * supports the events of `event_class`, that is:
+ *
+ * * Neither the stream class nor `event_class` has a context field
+ *   type.
+ *
+ * * The type of each member of the payload field type is an integer,
+ *   enumeration, floating point number, or string field type.
+ */
+static
+bool event_class_supports_payload_values(
+		struct bt_ctf_stream_class_common *stream_class,
+		struct bt_ctf_event_class_common *event_class)
+{
+	struct bt_ctf_field_type_common *payload_ft =
+		event_class->payload_field_type;
+	bool supported = false;
+	int64_t i;
+	int64_t count;
+
+	if (stream_class->event_context_field_type) {
+		BT_LOGW("Invalid parameter: stream class has a stream event context field type: "
+			"sc-addr=%p, ec-addr=%p, ec-name=\"%s\"",
+			stream_class, event_class,
+			bt_ctf_event_class_common_get_name(event_class));
+		goto end;
+	}
+
+	if (event_class->context_field_type) {
+		BT_LOGW("Invalid parameter: event class has a context field type: "
+			"ec-addr=%p, ec-name=\"%s\"", event_class,
+			bt_ctf_event_class_common_get_name(event_class));
+		goto end;
+	}
+
+	count = payload_ft ?
+		bt_ctf_field_type_common_structure_get_field_count(payload_ft) :
+		0;
+	BT_ASSERT_DBG(count >= 0);
+
+	for (i = 0; i < count; i++) {
+		const char *name;
+		struct bt_ctf_field_type_common *member_ft;
+		int ret;
+
+		ret = bt_ctf_field_type_common_structure_borrow_field_by_index(
+			payload_ft, &name, &member_ft, i);
+		BT_ASSERT_DBG(ret == 0);
+
+		switch (member_ft->id) {
+		case BT_CTF_FIELD_TYPE_ID_INTEGER:
+		case BT_CTF_FIELD_TYPE_ID_ENUM:
+		case BT_CTF_FIELD_TYPE_ID_FLOAT:
+		case BT_CTF_FIELD_TYPE_ID_STRING:
+			break;
+		default:
+			BT_LOGW("Invalid parameter: unsupported event payload field type member: "
+				"ec-addr=%p, ec-name=\"%s\", member-name=\"%s\", "
+				"member-ft-id=%s",
+				event_class,
+				bt_ctf_event_class_common_get_name(event_class),
+				name, bt_ctf_field_type_id_string(member_ft->id));
+			goto end;
+		}
+	}
+
+	supported = true;
+
+end:
+	return supported;
+}
+
+/*
+ * Sets the integer field `field` (or the container of the enumeration
+ * field `field`) to the next value of `args`.
+ */
+static
+int set_integer_field_from_args(struct bt_ctf_field *field, va_list *args)
+{
+	struct bt_ctf_field_common *int_field = (void *) field;
+
+	if (int_field->type->id == BT_CTF_FIELD_TYPE_ID_ENUM) {
+		int_field = (void *) bt_ctf_field_enumeration_borrow_container(
+			field);
+	}
+
+	if (bt_ctf_field_type_integer_is_signed((void *) int_field->type)) {
+		return bt_ctf_field_integer_signed_set_value((void *) int_field,
+			va_arg(*args, int64_t));
+	} else {
+		return bt_ctf_field_integer_unsigned_set_value((void *) int_field,
+			va_arg(*args, uint64_t));
+	}
+}
+
+/*
+ * Sets the members of the payload field of `event` to the next values
+ * of `args` (see bt_ctf_stream_append_event_with_payload()).
+ */
+static
+int set_event_payload_from_args(struct bt_ctf_event *event, va_list *args)
+{
+	struct bt_ctf_field_common *payload = event->common.payload_field;
+	int ret = 0;
+	int64_t i;
+	int64_t count;
+
+	if (!payload) {
+		goto end;
+	}
+
+	count = bt_ctf_field_type_common_structure_get_field_count(
+		payload->type);
+	BT_ASSERT_DBG(count >= 0);
+
+	for (i = 0; i < count; i++) {
+		struct bt_ctf_field *member = (void *)
+			bt_ctf_field_common_structure_borrow_field_by_index(
+				payload, i);
+
+		BT_ASSERT_DBG(member);
+
+		switch (bt_ctf_field_get_type_id(member)) {
+		case BT_CTF_FIELD_TYPE_ID_INTEGER:
+		case BT_CTF_FIELD_TYPE_ID_ENUM:
+			ret = set_integer_field_from_args(member, args);
+			break;
+		case BT_CTF_FIELD_TYPE_ID_FLOAT:
+			ret = bt_ctf_field_floating_point_set_value(member,
+				va_arg(*args, double));
+			break;
+		case BT_CTF_FIELD_TYPE_ID_STRING:
+			ret = bt_ctf_field_string_set_value(member,
+				va_arg(*args, const char *));
+			break;
+		default:
+			bt_common_abort();
+		}
+
+		if (ret) {
+			BT_LOGW("Cannot set event payload field's member: "
+				"event-addr=%p, index=%" PRId64, event, i);
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Appends `event`, taken from an event pool of `stream`, to `stream`
+ * again: this is bt_ctf_stream_append_event() without the parts which
+ * only matter for a new event.
+ */
+static
+int reappend_pooled_event(struct bt_ctf_stream *stream,
+		struct bt_ctf_event *event)
+{
+	int ret;
+
+	BT_ASSERT_DBG(bt_ctf_object_borrow_parent(&event->common.base) ==
+		&stream->common.base);
+	ret = auto_populate_event_header(stream, event);
+	if (ret) {
+		/* auto_populate_event_header() reports errors */
+		goto end;
+	}
+
+	BT_CTF_ASSERT_PRE(bt_ctf_event_common_validate(BT_CTF_TO_COMMON(event)) == 0,
+		"Invalid event: event-addr=%p", event);
+	bt_ctf_event_common_set_is_frozen(BT_CTF_TO_COMMON(event), true);
+	g_ptr_array_add(stream->events, event);
+
+end:
+	return ret;
+}
+
+BT_EXPORT
+int bt_ctf_stream_append_event_with_payload(struct bt_ctf_stream *stream,
+		struct bt_ctf_event_class *event_class, ...)
+{
+	int ret = 0;
+	struct bt_ctf_event *event = NULL;
+	pthread_mutex_t *writer_lock = NULL;
+	GPtrArray *pool;
+	va_list args;
+
+	va_start(args, event_class);
+
+	if (!stream) {
+		BT_LOGW_STR("Invalid parameter: stream is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (!event_class) {
+		BT_LOGW_STR("Invalid parameter: event class is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	BT_LOGT("Appending event with payload to stream: "
+		"stream-addr=%p, stream-name=\"%s\", "
+		"event-class-name=\"%s\", event-class-id=%" PRId64,
+		stream, bt_ctf_stream_get_name(stream),
+		bt_ctf_event_class_get_name(event_class),
+		bt_ctf_event_class_get_id(event_class));
+
+	if (bt_ctf_event_class_common_borrow_stream_class(
+			BT_CTF_TO_COMMON(event_class)) !=
+			stream->common.stream_class) {
+		BT_LOGW("Invalid parameter: event class is not part of the stream's class: "
+			"stream-addr=%p, stream-name=\"%s\", ec-addr=%p",
+			stream, bt_ctf_stream_get_name(stream), event_class);
+		ret = -1;
+		goto end;
+	}
+
+	pool = g_hash_table_lookup(stream->event_pools, event_class);
+	if (!pool) {
+		/*
+		 * The event class and its field types are shared with the
+		 * sub-streams of other threads (see
+		 * bt_ctf_stream_borrow_thread_stream()): checking them,
+		 * creating an event, and appending it for the first time
+		 * modify reference counts and freeze objects.
+		 */
+		writer_lock = borrow_writer_lock(stream);
+		pthread_mutex_lock(writer_lock);
+
+		if (!event_class_supports_payload_values(
+				stream->common.stream_class,
+				BT_CTF_TO_COMMON(event_class))) {
+			/* event_class_supports_payload_values() logs errors */
+			ret = -1;
+			goto end;
+		}
+
+		pool = g_ptr_array_new();
+		if (!pool) {
+			BT_LOGE_STR("Failed to allocate a GPtrArray.");
+			ret = -1;
+			goto end;
+		}
+
+		g_hash_table_insert(stream->event_pools, event_class, pool);
+	}
+
+	if (pool->len > 0) {
+		/* Reuse a flushed event: only the stream owns it */
+		event = g_ptr_array_remove_index_fast(pool, pool->len - 1);
+		bt_ctf_event_common_set_is_frozen(BT_CTF_TO_COMMON(event),
+			false);
+
+		if (event->common.header_field) {
+			bt_ctf_field_common_reset_recursive(
+				event->common.header_field->field);
+		}
+
+		if (event->common.payload_field) {
+			bt_ctf_field_common_reset_recursive(
+				event->common.payload_field);
+		}
+
+		ret = set_event_payload_from_args(event, &args);
+		if (ret == 0) {
+			ret = reappend_pooled_event(stream, event);
+		}
+
+		if (ret) {
+			g_ptr_array_add(pool, event);
+		}
+
+		goto end;
+	}
+
+	if (!writer_lock) {
+		writer_lock = borrow_writer_lock(stream);
+		pthread_mutex_lock(writer_lock);
+	}
+
+	event = bt_ctf_event_create(event_class);
+	if (!event) {
+		BT_LOGW_STR("Cannot create event.");
+		ret = -1;
+		goto end;
+	}
+
+	ret = set_event_payload_from_args(event, &args);
+	if (ret == 0) {
+		ret = bt_ctf_stream_append_event(stream, event);
+	}
+
+	/*
+	 * On success, the stream owns the event, and recycles it once
+	 * it flushes it.
+	 */
+	bt_ctf_object_put_ref(event);
+
+end:
+	if (writer_lock) {
+		pthread_mutex_unlock(writer_lock);
+	}
+
+	va_end(args);
+	return ret;
+}
+
 BT_EXPORT
 struct bt_ctf_field *bt_ctf_stream_get_packet_context(struct bt_ctf_stream *stream)
 {
@@ -1584,12 +2346,83 @@ end:
 	return ret;
 }
 
+/*
+ * Returns the value of the unsigned integer member at `index` of the
+ * packet context field of `stream`, or `default_val` if it's missing or
+ * not an unsigned integer field.
+ */
 static
-void reset_structure_field(struct bt_ctf_field *structure, const char *name)
+uint64_t get_packet_context_uint(struct bt_ctf_stream *stream, int index,
+		uint64_t default_val)
+{
+	struct bt_ctf_field *field;
+	uint64_t val;
+
+	if (!stream->packet_context || index < 0) {
+		return default_val;
+	}
+
+	field = (void *) bt_ctf_field_common_structure_borrow_field_by_index(
+		(void *) stream->packet_context, index);
+
+	if (!field || bt_ctf_field_get_type_id(field) !=
+			BT_CTF_FIELD_TYPE_ID_INTEGER ||
+			bt_ctf_field_integer_unsigned_get_value(field, &val)) {
+		return default_val;
+	}
+
+	return val;
+}
+
+/*
+ * Appends the index entry of the packet which `stream` just closed,
+ * located at `offset_bytes` within the stream file, to the index file
+ * of `stream`, if any.
+ *
+ * Must be called before resetting the automatically-set packet context
+ * members.
+ */
+static
+void write_index_entry(struct bt_ctf_stream *stream, uint64_t offset_bytes,
+		uint64_t packet_size_bits, uint64_t content_size_bits)
+{
+	struct ctf_packet_index entry;
+	const struct bt_ctf_stream_class_common *stream_class =
+		stream->common.stream_class;
+
+	if (!stream->index_file) {
+		return;
+	}
+
+	entry.offset = htobe64(offset_bytes);
+	entry.packet_size = htobe64(packet_size_bits);
+	entry.content_size = htobe64(content_size_bits);
+	entry.timestamp_begin = htobe64(get_packet_context_uint(stream,
+		stream->packet_context_member_indexes.timestamp_begin, 0));
+	entry.timestamp_end = htobe64(get_packet_context_uint(stream,
+		stream->packet_context_member_indexes.timestamp_end, 0));
+	entry.events_discarded = htobe64(get_packet_context_uint(stream,
+		stream->packet_context_member_indexes.events_discarded,
+		stream->discarded_events));
+	entry.stream_id = htobe64((uint64_t) stream_class->id);
+	entry.stream_instance_id = htobe64((uint64_t) stream->common.id);
+	entry.packet_seq_num = htobe64(get_packet_context_uint(stream,
+		stream->packet_context_member_indexes.packet_seq_num,
+		stream->flushed_packet_count));
+
+	if (fwrite(&entry, sizeof(entry), 1, stream->index_file) != 1) {
+		BT_LOGW_ERRNO("Cannot write stream's index entry",
+			": path=\"%s\"", stream->index_path);
+		discard_index_file(stream);
+	}
+}
+
+static
+void reset_structure_field(struct bt_ctf_field *structure, int index)
 {
 	struct bt_ctf_field *member;
 
-	member = bt_ctf_field_structure_get_field_by_name(structure, name);
+	member = get_member_field(structure, index);
 	if (member) {
 		bt_ctf_field_common_reset_recursive((void *) member);
 		bt_ctf_object_put_ref(member);
@@ -1603,10 +2436,13 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 	size_t i;
 	uint64_t packet_context_offset_bits = 0;
 	struct bt_ctf_trace *trace;
+	struct bt_ctf_writer *writer;
 	enum bt_ctf_byte_order native_byte_order;
 	bool has_packet_size = false;
 	uint64_t packet_size_bits = 0;
 	uint64_t content_size_bits = 0;
+	uint64_t packet_offset_bytes;
+	bool closed;
 
 	if (!stream) {
 		BT_LOGW_STR("Invalid parameter: stream is NULL.");
@@ -1615,12 +2451,8 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 	}
 
 	if (stream->packet_context) {
-		struct bt_ctf_field *packet_size_field;
-
-		packet_size_field = bt_ctf_field_structure_get_field_by_name(
-				stream->packet_context, "packet_size");
-		has_packet_size = packet_size_field;
-		bt_ctf_object_put_ref(packet_size_field);
+		has_packet_size =
+			stream->packet_context_member_indexes.packet_size >= 0;
 	}
 
 	if (stream->flushed_packet_count == 1) {
@@ -1772,12 +2604,7 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 		 * sure that, if `packet_size` is missing, the current
 		 * content size is equal to the current packet size.
 		 */
-		struct bt_ctf_field *field =
-			bt_ctf_field_structure_get_field_by_name(
-				stream->packet_context, "content_size");
-
-		bt_ctf_object_put_ref(field);
-		if (!field) {
+		if (stream->packet_context_member_indexes.content_size < 0) {
 			if (content_size_bits != packet_size_bits) {
 				BT_LOGW("Stream's packet context's `content_size` field is missing, "
 					"but current packet's content size is not equal to its packet size: "
@@ -1815,18 +2642,54 @@ int bt_ctf_stream_flush(struct bt_ctf_stream *stream)
 		}
 	}
 
+	writer = (void *) bt_ctf_object_borrow_parent(&trace->common.base);
+	BT_ASSERT_DBG(writer);
+
+	/* Closing the packet adds its size to the stream file's size */
+	packet_offset_bytes = stream->ctfser.stream_size_bytes;
+
+	if (writer->drop_packets_when_full) {
+		closed = bt_ctfser_try_close_current_packet(&stream->ctfser,
+			packet_size_bits / 8);
+	} else {
+		bt_ctfser_close_current_packet(&stream->ctfser,
+			packet_size_bits / 8);
+		closed = true;
+	}
+
+	if (closed) {
+		write_index_entry(stream, packet_offset_bytes,
+			packet_size_bits, content_size_bits);
+		stream->flushed_packet_count++;
+	} else {
+		/*
+		 * The writer's queue is full: the events of the
+		 * dropped packet are discarded events.
+		 */
+		BT_LOGI("Dropped stream's current packet: "
+			"background flushing queue is full: "
+			"stream-addr=%p, stream-name=\"%s\", "
+			"event-count=%u",
+			stream, bt_ctf_stream_get_name(stream),
+			stream->events->len);
+		stream->discarded_events += stream->events->len;
+	}
+
 	g_ptr_array_set_size(stream->events, 0);
-	stream->flushed_packet_count++;
-	bt_ctfser_close_current_packet(&stream->ctfser, packet_size_bits / 8);
 
 end:
 	/* Reset automatically-set fields. */
 	if (stream->packet_context) {
-		reset_structure_field(stream->packet_context, "timestamp_begin");
-		reset_structure_field(stream->packet_context, "timestamp_end");
-		reset_structure_field(stream->packet_context, "packet_size");
-		reset_structure_field(stream->packet_context, "content_size");
-		reset_structure_field(stream->packet_context, "events_discarded");
+		reset_structure_field(stream->packet_context,
+			stream->packet_context_member_indexes.timestamp_begin);
+		reset_structure_field(stream->packet_context,
+			stream->packet_context_member_indexes.timestamp_end);
+		reset_structure_field(stream->packet_context,
+			stream->packet_context_member_indexes.packet_size);
+		reset_structure_field(stream->packet_context,
+			stream->packet_context_member_indexes.content_size);
+		reset_structure_field(stream->packet_context,
+			stream->packet_context_member_indexes.events_discarded);
 	}
 
 	if (ret == 0) {
@@ -1850,11 +2713,38 @@ void bt_ctf_stream_destroy(struct bt_ctf_object *obj)
 	bt_ctf_stream_common_finalize(BT_CTF_TO_COMMON(stream));
 	bt_ctfser_fini(&stream->ctfser);
 
+	if (stream->index_file) {
+		if (fclose(stream->index_file)) {
+			BT_LOGW_ERRNO("Cannot close stream's index file",
+				": path=\"%s\"", stream->index_path);
+		}
+	}
+
+	g_free(stream->index_path);
+
+	/*
+	 * Destroy the event pools first so that putting the events
+	 * below doesn't recycle them.
+	 */
+	if (stream->event_pools) {
+		BT_LOGD_STR("Destroying event pools.");
+		g_hash_table_destroy(stream->event_pools);
+		stream->event_pools = NULL;
+	}
+
 	if (stream->events) {
 		BT_LOGD_STR("Putting events.");
 		g_ptr_array_free(stream->events, TRUE);
 	}
 
+	if (stream->event_clock_field_scopes) {
+		g_hash_table_destroy(stream->event_clock_field_scopes);
+	}
+
+	if (stream->thread_streams) {
+		g_hash_table_destroy(stream->thread_streams);
+	}
+
 	BT_LOGD_STR("Putting packet header field.");
 	bt_ctf_object_put_ref(stream->packet_header);
 	BT_LOGD_STR("Putting packet context field.");
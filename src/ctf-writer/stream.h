@@ -14,7 +14,10 @@
 #include "common/macros.h"
 #include <babeltrace2-ctf-writer/stream.h>
 #include "ctfser/ctfser.h"
+#include <glib.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include "assert-pre.h"
 #include "object.h"
@@ -78,6 +81,72 @@ struct bt_ctf_stream {
 	unsigned int flushed_packet_count;
 	uint64_t discarded_events;
 	uint64_t last_ts_end;
+
+	/*
+	 * Indexes of the known members of the packet header and packet
+	 * context fields, or -1 when missing.
+	 *
+	 * bt_ctf_stream_set_packet_header() and
+	 * bt_ctf_stream_set_packet_context() only accept a field of
+	 * which the type is equivalent to the original one, therefore
+	 * those indexes never change.
+	 */
+	struct {
+		int magic;
+		int uuid;
+		int stream_id;
+	} packet_header_member_indexes;
+
+	struct {
+		int packet_size;
+		int content_size;
+		int events_discarded;
+		int packet_seq_num;
+		int timestamp_begin;
+		int timestamp_end;
+	} packet_context_member_indexes;
+
+	/*
+	 * True if any member of the packet context field, except
+	 * `timestamp_begin` and `timestamp_end`, contains an integer
+	 * field of which the type is mapped to a clock class.
+	 */
+	bool packet_context_has_clock_fields;
+
+	/*
+	 * Event class (weak) -> scopes of its events which contain an
+	 * integer field of which the type is mapped to a clock class
+	 * (`enum event_clock_field_scope` bits, see stream.c).
+	 */
+	GHashTable *event_clock_field_scopes;
+
+	/*
+	 * Event class (weak) -> `GPtrArray *` of flushed events of this
+	 * class (owned by this) which
+	 * bt_ctf_stream_append_event_with_payload() reuses instead of
+	 * creating new events.
+	 *
+	 * Only contains the event classes which
+	 * bt_ctf_stream_append_event_with_payload() supports.
+	 */
+	GHashTable *event_pools;
+
+	/*
+	 * `GThread *` (weak) -> sub-stream of this thread (weak: the
+	 * trace owns it like any other stream), or `NULL` if
+	 * bt_ctf_stream_borrow_thread_stream() was never called.
+	 *
+	 * Protected by the lock of the writer.
+	 */
+	GHashTable *thread_streams;
+
+	/*
+	 * LTTng-compatible index file of the stream file, and its path
+	 * (owned by this), or `NULL` if the stream doesn't write one
+	 * (see bt_ctf_writer_set_write_index()).
+	 */
+	FILE *index_file;
+	gchar *index_path;
 };
 
 struct bt_ctf_stream *bt_ctf_stream_create_with_id(
@@ -12,6 +12,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
@@ -23,11 +24,13 @@
 #include "compat/compiler.h"
 #include "compat/endian.h"
 #include "common/uuid.h"
+#include "ctfser/ctfser.h"
 
 #include "clock.h"
 #include "fields.h"
 #include "field-types.h"
 #include "functor.h"
+#include "json-metadata.h"
 #include "stream-class.h"
 #include "stream.h"
 #include "trace.h"
@@ -105,6 +108,9 @@ struct bt_ctf_writer *bt_ctf_writer_create(const char *path)
 	metadata_path = g_build_filename(path, "metadata", NULL);
 
 	bt_ctf_object_init_shared(&writer->base, bt_ctf_writer_destroy);
+	pthread_mutex_init(&writer->lock, NULL);
+	writer->ctf_version = 1;
+	writer->write_index = true;
 	writer->path = g_string_new(path);
 	if (!writer->path) {
 		goto error_destroy;
@@ -177,6 +183,10 @@ void bt_ctf_writer_destroy(struct bt_ctf_object *obj)
 	}
 
 	bt_ctf_object_try_spec_release(&writer->trace->common.base);
+
+	/* After the streams, which use it */
+	bt_ctfser_writer_destroy(writer->ctfser_writer);
+	pthread_mutex_destroy(&writer->lock);
 	g_free(writer);
 }
 
@@ -299,6 +309,20 @@ end:
 	return ret;
 }
 
+/*
+ * Returns the metadata stream of the trace of `writer` in the CTF
+ * version of `writer`.
+ */
+static
+char *get_metadata_string(struct bt_ctf_writer *writer)
+{
+	if (writer->ctf_version == 2) {
+		return bt_ctf_trace_get_json_metadata_string(writer->trace);
+	}
+
+	return bt_ctf_trace_get_metadata_string(writer->trace);
+}
+
 BT_EXPORT
 char *bt_ctf_writer_get_metadata_string(struct bt_ctf_writer *writer)
 {
@@ -308,8 +332,7 @@ char *bt_ctf_writer_get_metadata_string(struct bt_ctf_writer *writer)
 		goto end;
 	}
 
-	metadata_string = bt_ctf_trace_get_metadata_string(
-		writer->trace);
+	metadata_string = get_metadata_string(writer);
 end:
 	return metadata_string;
 }
@@ -324,8 +347,7 @@ void bt_ctf_writer_flush_metadata(struct bt_ctf_writer *writer)
 		goto end;
 	}
 
-	metadata_string = bt_ctf_trace_get_metadata_string(
-		writer->trace);
+	metadata_string = get_metadata_string(writer);
 	if (!metadata_string) {
 		goto end;
 	}
@@ -375,6 +397,113 @@ end:
 	return ret;
 }
 
+BT_EXPORT
+int bt_ctf_writer_set_background_flush(struct bt_ctf_writer *writer,
+		uint64_t max_queued_bytes,
+		enum bt_ctf_writer_flush_queue_full_policy full_policy)
+{
+	int ret = 0;
+	struct bt_ctfser_writer *ctfser_writer;
+
+	if (!writer) {
+		BT_LOGW_STR("Invalid parameter: writer is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (writer->frozen) {
+		BT_LOGW("Invalid parameter: writer is frozen: addr=%p", writer);
+		ret = -1;
+		goto end;
+	}
+
+	if (full_policy != BT_CTF_WRITER_FLUSH_QUEUE_FULL_POLICY_BLOCK &&
+			full_policy != BT_CTF_WRITER_FLUSH_QUEUE_FULL_POLICY_DROP) {
+		BT_LOGW("Invalid parameter: unknown queue full policy: "
+			"addr=%p, policy=%d", writer, (int) full_policy);
+		ret = -1;
+		goto end;
+	}
+
+	ctfser_writer = bt_ctfser_writer_create(max_queued_bytes, 1, 0,
+		BT_LOG_OUTPUT_LEVEL);
+	if (!ctfser_writer) {
+		/* bt_ctfser_writer_create() logs errors */
+		ret = -1;
+		goto end;
+	}
+
+	bt_ctfser_writer_destroy(writer->ctfser_writer);
+	writer->ctfser_writer = ctfser_writer;
+	writer->drop_packets_when_full =
+		full_policy == BT_CTF_WRITER_FLUSH_QUEUE_FULL_POLICY_DROP;
+	BT_LOGD("Set writer's background flushing: addr=%p, "
+		"max-queued-bytes=%" PRIu64 ", drop-packets-when-full=%d",
+		writer, max_queued_bytes, writer->drop_packets_when_full);
+
+end:
+	return ret;
+}
+
+BT_EXPORT
+int bt_ctf_writer_set_ctf_version(struct bt_ctf_writer *writer,
+		unsigned int major_version)
+{
+	int ret = 0;
+
+	if (!writer) {
+		BT_LOGW_STR("Invalid parameter: writer is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (writer->frozen) {
+		BT_LOGW("Invalid parameter: writer is frozen: addr=%p", writer);
+		ret = -1;
+		goto end;
+	}
+
+	if (major_version != 1 && major_version != 2) {
+		BT_LOGW("Invalid parameter: unknown CTF major version: "
+			"addr=%p, version=%u", writer, major_version);
+		ret = -1;
+		goto end;
+	}
+
+	writer->ctf_version = major_version;
+	BT_LOGD("Set writer's CTF version: addr=%p, version=%u",
+		writer, major_version);
+
+end:
+	return ret;
+}
+
+BT_EXPORT
+int bt_ctf_writer_set_write_index(struct bt_ctf_writer *writer,
+		bt_ctf_bool write_index)
+{
+	int ret = 0;
+
+	if (!writer) {
+		BT_LOGW_STR("Invalid parameter: writer is NULL.");
+		ret = -1;
+		goto end;
+	}
+
+	if (writer->frozen) {
+		BT_LOGW("Invalid parameter: writer is frozen: addr=%p", writer);
+		ret = -1;
+		goto end;
+	}
+
+	writer->write_index = (bool) write_index;
+	BT_LOGD("Set whether or not the writer writes index files: "
+		"addr=%p, write-index=%d", writer, writer->write_index);
+
+end:
+	return ret;
+}
+
 void bt_ctf_writer_freeze(struct bt_ctf_writer *writer)
 {
 	writer->frozen = 1;
@@ -9,6 +9,8 @@
 
 #include <dirent.h>
 #include <glib.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <sys/types.h>
 
 #include <babeltrace2-ctf-writer/trace.h>
@@ -30,6 +32,39 @@ struct bt_ctf_writer {
 	struct bt_ctf_trace *trace;
 	GString *path;
 	int metadata_fd;
+
+	/*
+	 * Background packet writer of the streams (owned by this), or
+	 * `NULL` to write the packets on the thread which calls
+	 * bt_ctf_stream_flush().
+	 */
+	struct bt_ctfser_writer *ctfser_writer;
+
+	/*
+	 * True if bt_ctf_stream_flush() drops the packet instead of
+	 * waiting when `ctfser_writer` is full.
+	 */
+	bool drop_packets_when_full;
+
+	/*
+	 * Protects the shared objects (trace, classes, reference counts)
+	 * which bt_ctf_stream_borrow_thread_stream() and the first
+	 * appending of an event of a given class to a thread sub-stream
+	 * modify, so that different threads may write to their own
+	 * sub-streams concurrently.
+	 */
+	pthread_mutex_t lock;
+
+	/* Major version of CTF of the metadata stream (1 or 2) */
+	unsigned int ctf_version;
+
+	/*
+	 * True to write an LTTng-compatible index file, in the `index`
+	 * directory of the trace, for each stream of which the packet
+	 * context has the `timestamp_begin`, `timestamp_end`, and
+	 * `packet_size` members.
+	 */
+	bool write_index;
 };
 
 enum field_type_alias {
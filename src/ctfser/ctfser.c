@@ -21,24 +21,454 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <wchar.h>
+#include <errno.h>
+#include <pthread.h>
 #include "common/macros.h"
 #include "common/common.h"
 #include "ctfser/ctfser.h"
+#include "ctfser/zstd-seek-table.h"
 #include "compat/unistd.h"
 #include "compat/fcntl.h"
 
+#ifdef BT_HAVE_ZSTD
+# include <zstd.h>
+#endif
+
+/* Maximum number of recycled packet buffers of a writer */
+#define WRITER_MAX_FREE_BUF_COUNT	8
+
+/* Packet to write (or request to stop a writer thread) */
+struct write_job {
+	/*
+	 * Serializer which closed this packet (weak), or `NULL` to
+	 * stop the writer thread which gets this job.
+	 */
+	struct bt_ctfser *ctfser;
+
+	/* Stream file's descriptor */
+	int fd;
+
+	/* Offset (bytes) of the packet in the stream file */
+	off_t offset;
+
+	/* Packet data (owned by this) */
+	uint8_t *buf;
+
+	/* Packet size (bytes) */
+	uint64_t size_bytes;
+
+	/* Capacity of `buf` (bytes) */
+	uint64_t buf_capacity_bytes;
+};
+
+struct bt_ctfser_writer {
+	/*
+	 * Writer threads.
+	 *
+	 * Each packet has its own offset within its stream file, so
+	 * that any thread can write any packet with pwrite(), in any
+	 * order, even two packets of the same stream file at the same
+	 * time.
+	 */
+	pthread_t *threads;
+	unsigned int thread_count;
+
+	/* Protects all the members below */
+	pthread_mutex_t lock;
+
+	/* Signaled when a job is added or done */
+	pthread_cond_t cond;
+
+	/* Jobs to do (`struct write_job *`, owned by this) */
+	GQueue *jobs;
+
+	/* Total size of the packets of `jobs` (bytes) */
+	uint64_t pending_bytes;
+
+	/* Maximum value of `pending_bytes` (bytes) */
+	uint64_t max_pending_bytes;
+
+	/*
+	 * Done jobs (`struct write_job *`, owned by this) of which to
+	 * reuse the buffers.
+	 *
+	 * No element free function: removing a job from this array
+	 * transfers its ownership.
+	 */
+	GPtrArray *free_jobs;
+
+	/* zstd compression level of the packets, or 0 for none */
+	int compression_level;
+
+	int log_level;
+};
+
 static inline
 uint64_t get_packet_size_increment_bytes(struct bt_ctfser *ctfser)
 {
 	return bt_common_get_page_size(ctfser->log_level) * 8;
 }
 
+/*
+ * Returns the predicted size (bytes) of the next packet of `ctfser`:
+ * the size of the largest recent packet, rounded up to a multiple of
+ * the packet size increment, or a single increment without recent
+ * packets.
+ */
+static
+uint64_t get_initial_packet_size_bytes(struct bt_ctfser *ctfser)
+{
+	uint64_t incr = get_packet_size_increment_bytes(ctfser);
+	uint64_t max_size = 0;
+	unsigned int i;
+
+	for (i = 0; i < BT_CTFSER_RECENT_PACKET_SIZE_COUNT; i++) {
+		max_size = MAX(max_size, ctfser->recent_packet_sizes_bytes[i]);
+	}
+
+	if (max_size == 0) {
+		return incr;
+	}
+
+	return BT_ALIGN(max_size, incr);
+}
+
+/*
+ * Returns the new size (bytes) of the current packet of `ctfser` when
+ * it needs more room: it grows by half its current size, but by at
+ * least one increment, to limit the number of remaps for a packet which
+ * is much larger than the predicted size.
+ */
+static
+uint64_t get_grown_packet_size_bytes(struct bt_ctfser *ctfser)
+{
+	uint64_t incr = get_packet_size_increment_bytes(ctfser);
+
+	return ctfser->cur_packet_size_bytes +
+		BT_ALIGN(MAX(ctfser->cur_packet_size_bytes / 2, incr), incr);
+}
+
 static inline
 void mmap_align_ctfser(struct bt_ctfser *ctfser)
 {
 	ctfser->base_mma = mmap_align(ctfser->cur_packet_size_bytes,
 		PROT_READ | PROT_WRITE,
 		MAP_SHARED, ctfser->fd, ctfser->mmap_offset, ctfser->log_level);
+
+	if (ctfser->base_mma != MAP_FAILED) {
+		ctfser->cur_packet_addr =
+			((uint8_t *) mmap_align_addr(ctfser->base_mma)) +
+			ctfser->mmap_base_offset;
+	}
+}
+
+static
+void destroy_write_job(struct write_job *job)
+{
+	if (!job) {
+		return;
+	}
+
+	g_free(job->buf);
+	g_free(job);
+}
+
+/*
+ * Writes the whole packet of `job` to its stream file.
+ *
+ * Returns 0 on success, or an `errno` value.
+ */
+static
+int write_job_packet(struct write_job *job)
+{
+	uint64_t written = 0;
+
+	while (written < job->size_bytes) {
+		ssize_t ret = pwrite(job->fd, job->buf + written,
+			job->size_bytes - written,
+			job->offset + (off_t) written);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			return errno;
+		}
+
+		written += (uint64_t) ret;
+	}
+
+	return 0;
+}
+
+static
+void *writer_thread_func(void *data)
+{
+	struct bt_ctfser_writer *writer = data;
+
+	pthread_mutex_lock(&writer->lock);
+
+	while (true) {
+		struct write_job *job;
+		int error;
+
+		while (g_queue_is_empty(writer->jobs)) {
+			pthread_cond_wait(&writer->cond, &writer->lock);
+		}
+
+		job = g_queue_pop_head(writer->jobs);
+		if (!job->ctfser) {
+			/* Stop request */
+			destroy_write_job(job);
+			break;
+		}
+
+		/* Don't hold the lock during the actual I/O */
+		pthread_mutex_unlock(&writer->lock);
+		error = write_job_packet(job);
+		pthread_mutex_lock(&writer->lock);
+
+		if (error && !job->ctfser->writer_error) {
+			job->ctfser->writer_error = error;
+		}
+
+		BT_ASSERT(job->ctfser->pending_packet_count > 0);
+		job->ctfser->pending_packet_count--;
+		writer->pending_bytes -= job->size_bytes;
+		job->ctfser = NULL;
+
+		if (writer->free_jobs->len < WRITER_MAX_FREE_BUF_COUNT) {
+			g_ptr_array_add(writer->free_jobs, job);
+		} else {
+			destroy_write_job(job);
+		}
+
+		pthread_cond_broadcast(&writer->cond);
+	}
+
+	pthread_mutex_unlock(&writer->lock);
+	return NULL;
+}
+
+/*
+ * Makes the first `count` threads of `writer` write the pending
+ * packets and stop, and then joins them.
+ */
+static
+void stop_writer_threads(struct bt_ctfser_writer *writer, unsigned int count)
+{
+	unsigned int i;
+
+	pthread_mutex_lock(&writer->lock);
+
+	for (i = 0; i < count; i++) {
+		g_queue_push_tail(writer->jobs, g_new0(struct write_job, 1));
+	}
+
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->lock);
+
+	for (i = 0; i < count; i++) {
+		pthread_join(writer->threads[i], NULL);
+	}
+}
+
+struct bt_ctfser_writer *bt_ctfser_writer_create(uint64_t max_pending_bytes,
+		unsigned int thread_count, int compression_level,
+		int log_level)
+{
+	struct bt_ctfser_writer *writer = g_new0(struct bt_ctfser_writer, 1);
+	bool sync_init = false;
+	unsigned int i;
+	int ret;
+
+	BT_ASSERT(thread_count > 0);
+#ifndef BT_HAVE_ZSTD
+	BT_ASSERT(compression_level == 0);
+#endif
+
+	if (!writer) {
+		BT_LOG_WRITE_PRINTF_CUR_LVL(BT_LOG_ERROR, log_level, BT_LOG_TAG,
+			"Failed to allocate one CTF serializer writer.");
+		goto error;
+	}
+
+	writer->log_level = log_level;
+	writer->max_pending_bytes = max_pending_bytes;
+	writer->compression_level = compression_level;
+	writer->jobs = g_queue_new();
+	writer->free_jobs = g_ptr_array_new();
+	writer->threads = g_new0(pthread_t, thread_count);
+	if (!writer->jobs || !writer->free_jobs || !writer->threads) {
+		BT_LOG_WRITE_PRINTF_CUR_LVL(BT_LOG_ERROR, log_level, BT_LOG_TAG,
+			"Failed to allocate the containers of a CTF serializer writer.");
+		goto error;
+	}
+
+	pthread_mutex_init(&writer->lock, NULL);
+	pthread_cond_init(&writer->cond, NULL);
+	sync_init = true;
+
+	for (i = 0; i < thread_count; i++) {
+		ret = pthread_create(&writer->threads[i], NULL,
+			writer_thread_func, writer);
+		if (ret) {
+			errno = ret;
+			BT_LOG_WRITE_ERRNO_PRINTF_CUR_LVL(BT_LOG_ERROR,
+				log_level, BT_LOG_TAG,
+				"Failed to create CTF serializer writer thread",
+				": ret=%d, index=%u", ret, i);
+			stop_writer_threads(writer, i);
+			goto error;
+		}
+	}
+
+	writer->thread_count = thread_count;
+	BT_LOG_WRITE_PRINTF_CUR_LVL(BT_LOG_DEBUG, log_level, BT_LOG_TAG,
+		"Created CTF serializer writer: addr=%p, "
+		"max-pending-bytes=%" PRIu64 ", thread-count=%u, "
+		"compression-level=%d",
+		writer, max_pending_bytes, thread_count, compression_level);
+	goto end;
+
+error:
+	if (writer) {
+		if (sync_init) {
+			pthread_cond_destroy(&writer->cond);
+			pthread_mutex_destroy(&writer->lock);
+		}
+
+		if (writer->jobs) {
+			g_queue_free(writer->jobs);
+		}
+
+		if (writer->free_jobs) {
+			g_ptr_array_free(writer->free_jobs, TRUE);
+		}
+
+		g_free(writer->threads);
+		g_free(writer);
+		writer = NULL;
+	}
+
+end:
+	return writer;
+}
+
+void bt_ctfser_writer_destroy(struct bt_ctfser_writer *writer)
+{
+	guint i;
+
+	if (!writer) {
+		return;
+	}
+
+	/* The writer threads write the pending packets first */
+	stop_writer_threads(writer, writer->thread_count);
+	BT_ASSERT(g_queue_is_empty(writer->jobs));
+	g_queue_free(writer->jobs);
+
+	for (i = 0; i < writer->free_jobs->len; i++) {
+		destroy_write_job(g_ptr_array_index(writer->free_jobs, i));
+	}
+
+	g_ptr_array_free(writer->free_jobs, TRUE);
+	pthread_cond_destroy(&writer->cond);
+	pthread_mutex_destroy(&writer->lock);
+	g_free(writer->threads);
+	g_free(writer);
+}
+
+/*
+ * Returns the first write error of the writer of `ctfser` for
+ * `ctfser`, or 0.
+ */
+static
+int get_writer_error(struct bt_ctfser *ctfser)
+{
+	int error;
+
+	BT_ASSERT(ctfser->writer);
+	pthread_mutex_lock(&ctfser->writer->lock);
+	error = ctfser->writer_error;
+	pthread_mutex_unlock(&ctfser->writer->lock);
+	return error;
+}
+
+/*
+ * Makes `ctfser->buf` a zeroed buffer of at least
+ * get_initial_packet_size_bytes() bytes, reusing a buffer of its
+ * writer if possible.
+ */
+static
+int acquire_packet_buf(struct bt_ctfser *ctfser)
+{
+	struct bt_ctfser_writer *writer = ctfser->writer;
+	struct write_job *job = NULL;
+	uint64_t min_size = get_initial_packet_size_bytes(ctfser);
+
+	BT_ASSERT(!ctfser->buf);
+	pthread_mutex_lock(&writer->lock);
+
+	if (writer->free_jobs->len > 0) {
+		job = g_ptr_array_remove_index_fast(writer->free_jobs,
+			writer->free_jobs->len - 1);
+	}
+
+	pthread_mutex_unlock(&writer->lock);
+
+	if (job && job->buf_capacity_bytes >= min_size) {
+		ctfser->buf = job->buf;
+		ctfser->cur_packet_size_bytes = job->buf_capacity_bytes;
+		job->buf = NULL;
+	} else {
+		ctfser->buf = g_try_malloc(min_size);
+		ctfser->cur_packet_size_bytes = min_size;
+	}
+
+	destroy_write_job(job);
+
+	if (!ctfser->buf) {
+		BT_LOGE("Failed to allocate packet buffer: size-bytes=%" PRIu64,
+			min_size);
+		return -1;
+	}
+
+	memset(ctfser->buf, 0, ctfser->cur_packet_size_bytes);
+	ctfser->cur_packet_addr = ctfser->buf;
+	return 0;
+}
+
+/*
+ * Increases the size of the in-memory current packet of `ctfser`.
+ */
+static
+int increase_cur_packet_buf_size(struct bt_ctfser *ctfser)
+{
+	uint64_t old_size = ctfser->cur_packet_size_bytes;
+	uint64_t new_size;
+	uint8_t *new_buf;
+
+	/*
+	 * Unlike a memory map, growing a buffer may copy it: at least
+	 * double its size so that the total copy cost remains linear.
+	 */
+	new_size = old_size + MAX(old_size,
+		get_packet_size_increment_bytes(ctfser));
+	new_buf = g_try_realloc(ctfser->buf, new_size);
+
+	if (!new_buf) {
+		BT_LOGE("Failed to reallocate packet buffer: "
+			"size-bytes=%" PRIu64, new_size);
+		return -1;
+	}
+
+	memset(new_buf + old_size, 0, new_size - old_size);
+	ctfser->buf = new_buf;
+	ctfser->cur_packet_addr = new_buf;
+	ctfser->cur_packet_size_bytes = new_size;
+	return 0;
 }
 
 int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
@@ -53,6 +483,12 @@ int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
 		ctfser->path->str, ctfser->fd,
 		ctfser->offset_in_cur_packet_bits,
 		ctfser->cur_packet_size_bytes);
+
+	if (ctfser->writer) {
+		ret = increase_cur_packet_buf_size(ctfser);
+		goto end;
+	}
+
 	ret = munmap_align(ctfser->base_mma);
 	if (ret) {
 		BT_LOGE_ERRNO("Failed to perform an aligned memory unmapping",
@@ -60,8 +496,7 @@ int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser)
 		goto end;
 	}
 
-	ctfser->cur_packet_size_bytes += get_packet_size_increment_bytes(
-		ctfser);
+	ctfser->cur_packet_size_bytes = get_grown_packet_size_bytes(ctfser);
 
 	do {
 		ret = bt_posix_fallocate(ctfser->fd, ctfser->mmap_offset,
@@ -93,7 +528,8 @@ end:
 	return ret;
 }
 
-int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path, int log_level)
+int bt_ctfser_init_with_writer(struct bt_ctfser *ctfser, const char *path,
+		struct bt_ctfser_writer *writer, int log_level)
 {
 	int ret = 0;
 
@@ -102,6 +538,7 @@ int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path, int log_level)
 	ctfser->fd = open(path, O_RDWR | O_CREAT | O_TRUNC,
 		S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP);
 	ctfser->log_level = log_level;
+	ctfser->writer = writer;
 	if (ctfser->fd < 0) {
 		BT_LOGW_ERRNO("Failed to open stream file for writing",
 			": path=\"%s\", ret=%d",
@@ -112,18 +549,136 @@ int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path, int log_level)
 
 	ctfser->path = g_string_new(path);
 
+#ifdef BT_HAVE_ZSTD
+	if (writer && writer->compression_level != 0) {
+		ctfser->zstd_cctx = ZSTD_createCCtx();
+		ctfser->zstd_seek_table = g_array_new(FALSE, FALSE,
+			sizeof(uint32_t));
+		if (!ctfser->zstd_cctx || !ctfser->zstd_seek_table) {
+			BT_LOGE("Failed to create zstd compression context: "
+				"path=\"%s\"", path);
+			ret = -1;
+			goto end;
+		}
+	}
+#endif
+
+end:
+	return ret;
+}
+
+int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path, int log_level)
+{
+	return bt_ctfser_init_with_writer(ctfser, path, NULL, log_level);
+}
+
+/*
+ * Appends the seek table of the compressed stream file of `ctfser`
+ * after its last frame, adding its size to
+ * `ctfser->compressed_size_bytes`.
+ */
+static
+int write_zstd_seek_table(struct bt_ctfser *ctfser)
+{
+	GArray *table = ctfser->zstd_seek_table;
+	uint32_t frame_count = table->len / 2;
+	uint32_t entries_size = table->len * sizeof(uint32_t);
+	uint32_t content_size = entries_size + BT_ZSTD_SEEK_TABLE_FOOTER_SIZE;
+	struct write_job job = { 0 };
+	uint8_t *p;
+	uint32_t word;
+	int ret = 0;
+
+	job.fd = ctfser->fd;
+	job.offset = (off_t) ctfser->compressed_size_bytes;
+	job.size_bytes = BT_ZSTD_SEEK_TABLE_FRAME_HEADER_SIZE + content_size;
+	job.buf = g_try_malloc(job.size_bytes);
+	if (!job.buf) {
+		BT_LOGE("Failed to allocate seek table: size-bytes=%" PRIu64,
+			job.size_bytes);
+		ret = -1;
+		goto end;
+	}
+
+	/* Skippable frame header */
+	p = job.buf;
+	word = htole32(BT_ZSTD_SEEK_TABLE_FRAME_MAGIC);
+	memcpy(p, &word, sizeof(word));
+	p += sizeof(word);
+	word = htole32(content_size);
+	memcpy(p, &word, sizeof(word));
+	p += sizeof(word);
+
+	/* Entries (already little-endian) */
+	memcpy(p, table->data, entries_size);
+	p += entries_size;
+
+	/* Footer: frame count, descriptor (no checksums), and magic */
+	word = htole32(frame_count);
+	memcpy(p, &word, sizeof(word));
+	p += sizeof(word);
+	*p = 0;
+	p++;
+	word = htole32(BT_ZSTD_SEEK_TABLE_FOOTER_MAGIC);
+	memcpy(p, &word, sizeof(word));
+	p += sizeof(word);
+	BT_ASSERT(p == job.buf + job.size_bytes);
+
+	errno = write_job_packet(&job);
+	if (errno) {
+		BT_LOGE_ERRNO("Failed to write seek table to stream file",
+			": path=\"%s\", frame-count=%" PRIu32,
+			ctfser->path->str, frame_count);
+		ret = -1;
+		goto end;
+	}
+
+	ctfser->compressed_size_bytes += job.size_bytes;
+	BT_LOGD("Wrote seek table to stream file: path=\"%s\", "
+		"frame-count=%" PRIu32 ", compressed-size-bytes=%" PRIu64
+		", size-bytes=%" PRIu64,
+		ctfser->path->str, frame_count,
+		ctfser->compressed_size_bytes, ctfser->stream_size_bytes);
+
 end:
+	g_free(job.buf);
 	return ret;
 }
 
 int bt_ctfser_fini(struct bt_ctfser *ctfser)
 {
+	uint64_t file_size_bytes;
 	int ret = 0;
 
 	if (ctfser->fd == -1) {
 		goto free_path;
 	}
 
+	if (ctfser->writer) {
+		struct bt_ctfser_writer *writer = ctfser->writer;
+		int error;
+
+		/* Wait for the writer to write all our packets */
+		pthread_mutex_lock(&writer->lock);
+
+		while (ctfser->pending_packet_count > 0) {
+			pthread_cond_wait(&writer->cond, &writer->lock);
+		}
+
+		error = ctfser->writer_error;
+		pthread_mutex_unlock(&writer->lock);
+		g_free(ctfser->buf);
+		ctfser->buf = NULL;
+
+		if (error) {
+			errno = error;
+			BT_LOGE_ERRNO("Failed to write packet to stream file",
+				": path=\"%s\"", ctfser->path->str);
+			ret = -1;
+			goto end;
+		}
+	}
+
 	if (ctfser->base_mma) {
 		/* Unmap old base */
 		ret = munmap_align(ctfser->base_mma);
@@ -137,23 +692,33 @@ int bt_ctfser_fini(struct bt_ctfser *ctfser)
 		ctfser->base_mma = NULL;
 	}
 
+	if (ctfser->zstd_cctx) {
+		ret = write_zstd_seek_table(ctfser);
+		if (ret) {
+			goto end;
+		}
+
+		file_size_bytes = ctfser->compressed_size_bytes;
+	} else {
+		file_size_bytes = ctfser->stream_size_bytes;
+	}
+
 	/*
 	 * Truncate the stream file's size to the minimum required to
 	 * fit the last packet as we might have grown it too much during
 	 * the last memory map.
 	 */
 	do {
-		ret = ftruncate(ctfser->fd, ctfser->stream_size_bytes);
+		ret = ftruncate(ctfser->fd, file_size_bytes);
 	} while (ret == -1 && errno == EINTR);
 
 	if (ret) {
 		BT_LOGE_ERRNO("Failed to truncate stream file",
 			": ret=%d, size-bytes=%" PRIu64,
-			ret, ctfser->stream_size_bytes);
+			ret, file_size_bytes);
 		goto end;
 	}
 
-
 	ret = close(ctfser->fd);
 	if (ret) {
 		BT_LOGE_ERRNO("Failed to close stream file",
@@ -169,6 +734,16 @@ free_path:
 		ctfser->path = NULL;
 	}
 
+#ifdef BT_HAVE_ZSTD
+	ZSTD_freeCCtx(ctfser->zstd_cctx);
+	ctfser->zstd_cctx = NULL;
+#endif
+
+	if (ctfser->zstd_seek_table) {
+		g_array_free(ctfser->zstd_seek_table, TRUE);
+		ctfser->zstd_seek_table = NULL;
+	}
+
 end:
 	return ret;
 }
@@ -182,6 +757,28 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
 		ctfser->path->str, ctfser->fd,
 		ctfser->prev_packet_size_bytes);
 
+	if (ctfser->writer) {
+		int error = get_writer_error(ctfser);
+
+		if (error) {
+			errno = error;
+			BT_LOGE_ERRNO("Failed to write packet to stream file",
+				": path=\"%s\"", ctfser->path->str);
+			ret = -1;
+			goto end;
+		}
+
+		ctfser->mmap_offset += ctfser->prev_packet_size_bytes;
+		ctfser->prev_packet_size_bytes = 0;
+		ctfser->offset_in_cur_packet_bits = 0;
+		ret = acquire_packet_buf(ctfser);
+		if (ret) {
+			goto end;
+		}
+
+		goto opened;
+	}
+
 	if (ctfser->base_mma) {
 		/* Unmap old base (previous packet) */
 		ret = munmap_align(ctfser->base_mma);
@@ -202,9 +799,8 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
 	ctfser->mmap_offset += ctfser->prev_packet_size_bytes;
 	ctfser->prev_packet_size_bytes = 0;
 
-	/* Make initial space for the current packet */
-	ctfser->cur_packet_size_bytes = get_packet_size_increment_bytes(
-		ctfser);
+	/* Make initial space for the current packet (predicted size) */
+	ctfser->cur_packet_size_bytes = get_initial_packet_size_bytes(ctfser);
 
 	do {
 		ret = bt_posix_fallocate(ctfser->fd, ctfser->mmap_offset,
@@ -228,6 +824,7 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser)
 		goto end;
 	}
 
+opened:
 	BT_LOGD("Opened packet: path=\"%s\", fd=%d, "
 		"cur-packet-size-bytes=%" PRIu64,
 		ctfser->path->str, ctfser->fd,
@@ -237,8 +834,138 @@ end:
 	return ret;
 }
 
-void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
+/*
+ * Returns whether or not `writer` has enough room for a packet of
+ * `size_bytes` bytes.
+ *
+ * The lock of `writer` must be held.
+ */
+static inline
+bool writer_has_room(struct bt_ctfser_writer *writer, uint64_t size_bytes)
+{
+	/* A single packet which is too large is still accepted */
+	return writer->pending_bytes == 0 ||
+		writer->pending_bytes + size_bytes <= writer->max_pending_bytes;
+}
+
+#ifdef BT_HAVE_ZSTD
+/*
+ * Replaces the packet of `job`, of which the size is
+ * `packet_size_bytes`, with a single zstd frame, recording its
+ * compressed and decompressed sizes in the seek table of `ctfser`.
+ *
+ * Returns 0 on success, or an `errno` value.
+ */
+static
+int compress_job_packet(struct bt_ctfser *ctfser, struct write_job *job,
 		uint64_t packet_size_bytes)
+{
+	size_t capacity = ZSTD_compressBound(packet_size_bytes);
+	uint8_t *frame;
+	size_t frame_size;
+	uint32_t sizes[2];
+
+	if (packet_size_bytes > UINT32_MAX || capacity > UINT32_MAX) {
+		BT_LOGE("Packet is too large to be compressed: "
+			"path=\"%s\", size-bytes=%" PRIu64,
+			ctfser->path->str, packet_size_bytes);
+		return EFBIG;
+	}
+
+	frame = g_try_malloc(capacity);
+	if (!frame) {
+		BT_LOGE("Failed to allocate compressed packet buffer: "
+			"size-bytes=%zu", capacity);
+		return ENOMEM;
+	}
+
+	frame_size = ZSTD_compressCCtx(ctfser->zstd_cctx, frame, capacity,
+		job->buf, packet_size_bytes,
+		ctfser->writer->compression_level);
+	if (ZSTD_isError(frame_size)) {
+		BT_LOGE("Failed to compress packet: path=\"%s\", "
+			"size-bytes=%" PRIu64 ", error=\"%s\"",
+			ctfser->path->str, packet_size_bytes,
+			ZSTD_getErrorName(frame_size));
+		g_free(frame);
+		return EIO;
+	}
+
+	sizes[0] = htole32((uint32_t) frame_size);
+	sizes[1] = htole32((uint32_t) packet_size_bytes);
+	g_array_append_vals(ctfser->zstd_seek_table, sizes, 2);
+
+	/* The frame buffer becomes a recyclable packet buffer */
+	g_free(job->buf);
+	job->buf = frame;
+	job->buf_capacity_bytes = capacity;
+	job->size_bytes = frame_size;
+	job->offset = (off_t) ctfser->compressed_size_bytes;
+	ctfser->compressed_size_bytes += frame_size;
+	BT_LOGD("Compressed packet: path=\"%s\", size-bytes=%" PRIu64 ", "
+		"compressed-size-bytes=%zu",
+		ctfser->path->str, packet_size_bytes, frame_size);
+	return 0;
+}
+#endif
+
+/*
+ * Hands the in-memory current packet of `ctfser` over to its writer,
+ * compressing it first if needed, and, if `wait` is true, waiting until
+ * the writer has enough room for it.
+ */
+static
+void hand_over_cur_packet(struct bt_ctfser *ctfser,
+		uint64_t packet_size_bytes, bool wait)
+{
+	struct bt_ctfser_writer *writer = ctfser->writer;
+	struct write_job *job = g_new0(struct write_job, 1);
+	int error = 0;
+
+	BT_ASSERT(ctfser->buf);
+	BT_ASSERT(packet_size_bytes <= ctfser->cur_packet_size_bytes);
+	job->ctfser = ctfser;
+	job->fd = ctfser->fd;
+	job->offset = ctfser->mmap_offset;
+	job->buf = ctfser->buf;
+	job->size_bytes = packet_size_bytes;
+	job->buf_capacity_bytes = ctfser->cur_packet_size_bytes;
+	ctfser->buf = NULL;
+	ctfser->cur_packet_addr = NULL;
+
+#ifdef BT_HAVE_ZSTD
+	if (ctfser->zstd_cctx) {
+		error = compress_job_packet(ctfser, job, packet_size_bytes);
+	}
+#endif
+
+	pthread_mutex_lock(&writer->lock);
+
+	if (error) {
+		/* Reported by the next bt_ctfser_open_packet() call */
+		if (!ctfser->writer_error) {
+			ctfser->writer_error = error;
+		}
+
+		destroy_write_job(job);
+		pthread_mutex_unlock(&writer->lock);
+		return;
+	}
+
+	while (wait && !writer_has_room(writer, job->size_bytes)) {
+		pthread_cond_wait(&writer->cond, &writer->lock);
+	}
+
+	g_queue_push_tail(writer->jobs, job);
+	writer->pending_bytes += job->size_bytes;
+	ctfser->pending_packet_count++;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->lock);
+}
+
+static
+bool close_current_packet(struct bt_ctfser *ctfser,
+		uint64_t packet_size_bytes, bool wait)
 {
 	BT_LOGD("Closing packet: path=\"%s\", fd=%d, "
 		"offset-in-cur-packet-bits=%" PRIu64
@@ -247,6 +974,34 @@ void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
 		ctfser->offset_in_cur_packet_bits,
 		ctfser->cur_packet_size_bytes);
 
+	if (ctfser->writer && !wait) {
+		bool has_room;
+
+		/*
+		 * Compare with the uncompressed size: the writer may
+		 * end up with a bit more than its maximum if other
+		 * serializers hand packets over in the meantime.
+		 */
+		pthread_mutex_lock(&ctfser->writer->lock);
+		has_room = writer_has_room(ctfser->writer, packet_size_bytes);
+		pthread_mutex_unlock(&ctfser->writer->lock);
+
+		if (!has_room) {
+			/*
+			 * Discard the packet: `prev_packet_size_bytes`
+			 * is still 0, so the next packet takes its
+			 * place in the stream file.
+			 */
+			BT_LOGD("Discarding packet: writer is full: "
+				"path=\"%s\", size-bytes=%" PRIu64,
+				ctfser->path->str, packet_size_bytes);
+			g_free(ctfser->buf);
+			ctfser->buf = NULL;
+			ctfser->cur_packet_addr = NULL;
+			return false;
+		}
+	}
+
 	/*
 	 * This will be used during the next call to
 	 * bt_ctfser_open_packet(): we add
@@ -256,8 +1011,31 @@ void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
 	 */
 	ctfser->prev_packet_size_bytes = packet_size_bytes;
 	ctfser->stream_size_bytes += packet_size_bytes;
+	ctfser->recent_packet_sizes_bytes[
+		ctfser->next_recent_packet_size_index] = packet_size_bytes;
+	ctfser->next_recent_packet_size_index =
+		(ctfser->next_recent_packet_size_index + 1) %
+		BT_CTFSER_RECENT_PACKET_SIZE_COUNT;
+
+	if (ctfser->writer) {
+		hand_over_cur_packet(ctfser, packet_size_bytes, wait);
+	}
+
 	BT_LOGD("Closed packet: path=\"%s\", fd=%d, "
 		"stream-file-size-bytes=%" PRIu64,
 		ctfser->path->str, ctfser->fd,
 		ctfser->stream_size_bytes);
+	return true;
+}
+
+void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
+		uint64_t packet_size_bytes)
+{
+	(void) close_current_packet(ctfser, packet_size_bytes, true);
+}
+
+bool bt_ctfser_try_close_current_packet(struct bt_ctfser *ctfser,
+		uint64_t packet_size_bytes)
+{
+	return close_current_packet(ctfser, packet_size_bytes, false);
 }
@@ -29,6 +29,11 @@
 #include "compat/bitfield.h"
 #include <glib.h>
 
+struct bt_ctfser_writer;
+
+/* Number of recent packet sizes to predict the next one */
+#define BT_CTFSER_RECENT_PACKET_SIZE_COUNT	8
+
 struct bt_ctfser {
 	/* Stream file's descriptor */
 	int fd;
@@ -51,9 +56,67 @@ struct bt_ctfser {
 	/* Current stream size (bytes) */
 	uint64_t stream_size_bytes;
 
+	/*
+	 * Sizes (bytes) of the last closed packets (ring buffer; 0 means
+	 * no packet) and index of the next one to replace.
+	 *
+	 * bt_ctfser_open_packet() uses them to make enough initial space
+	 * for the new packet so that it rarely needs to grow it.
+	 */
+	uint64_t recent_packet_sizes_bytes[BT_CTFSER_RECENT_PACKET_SIZE_COUNT];
+	unsigned int next_recent_packet_size_index;
+
 	/* Memory map base address */
 	struct mmap_align_data *base_mma;
 
+	/*
+	 * Address of the first byte of the current packet: within the
+	 * memory map `base_mma`, or within `buf` when there's a writer.
+	 */
+	uint8_t *cur_packet_addr;
+
+	/*
+	 * Background writer (weak), or `NULL` to write the packets
+	 * directly to the memory-mapped stream file.
+	 *
+	 * When there's a writer, the serializer writes the current
+	 * packet to `buf` and, when closing it, hands `buf` over to
+	 * the writer which writes it to the stream file on its own
+	 * thread.
+	 */
+	struct bt_ctfser_writer *writer;
+
+	/* In-memory current packet (owned by this), or `NULL` */
+	uint8_t *buf;
+
+	/*
+	 * Number of packets of this serializer which `writer` didn't
+	 * write yet and first error (`errno` value) of `writer` for
+	 * this serializer, both protected by the lock of `writer`.
+	 */
+	uint64_t pending_packet_count;
+	int writer_error;
+
+	/*
+	 * zstd compression context (`ZSTD_CCtx *`, owned by this), or
+	 * `NULL` if this serializer doesn't compress its packets.
+	 *
+	 * When this is set, the serializer compresses each closed packet
+	 * as a single zstd frame before handing it over to `writer`, and
+	 * bt_ctfser_fini() appends a seek table to the stream file (see
+	 * `ctfser/zstd-seek-table.h`).
+	 */
+	void *zstd_cctx;
+
+	/* Size of the compressed stream file (bytes) */
+	uint64_t compressed_size_bytes;
+
+	/*
+	 * Seek table entries (`uint32_t`, already little-endian) of the
+	 * written frames: compressed and decompressed sizes, in pairs.
+	 */
+	GArray *zstd_seek_table;
+
 	/* Stream file's path (for debugging) */
 	GString *path;
 
@@ -70,11 +133,53 @@ BT_EXTERN_C
 int bt_ctfser_init(struct bt_ctfser *ctfser, const char *path,
 		int log_level);
 
+/*
+ * Like bt_ctfser_init(), but makes the serializer serialize each
+ * packet to memory and then hand it over to `writer` (which must
+ * outlive the serializer) to write it to the stream file in the
+ * background.
+ *
+ * `writer` may be `NULL`, in which case this function is equivalent to
+ * bt_ctfser_init().
+ */
+BT_EXTERN_C
+int bt_ctfser_init_with_writer(struct bt_ctfser *ctfser, const char *path,
+		struct bt_ctfser_writer *writer, int log_level);
+
+/*
+ * Creates a background packet writer for CTF serializers, starting
+ * its `thread_count` (at least one) threads.
+ *
+ * The writer hands at most `max_pending_bytes` bytes of packets at a
+ * time to its threads: bt_ctfser_close_current_packet() blocks until
+ * the writer has enough room.
+ *
+ * If `compression_level` isn't 0, then the serializers which use the
+ * writer compress their packets with zstd at this level, which
+ * requires `BT_HAVE_ZSTD`.
+ *
+ * Returns `NULL` on error.
+ */
+BT_EXTERN_C
+struct bt_ctfser_writer *bt_ctfser_writer_create(uint64_t max_pending_bytes,
+		unsigned int thread_count, int compression_level,
+		int log_level);
+
+/*
+ * Writes the pending packets of `writer`, stops its thread, and
+ * destroys it.
+ *
+ * You must finalize all the serializers which use `writer` first.
+ */
+BT_EXTERN_C
+void bt_ctfser_writer_destroy(struct bt_ctfser_writer *writer);
+
 /*
  * Finalizes a CTF serializer.
  *
  * This function truncates the stream file so that there's no extra
- * padding after the last packet, and then closes the file.
+ * padding after the last packet (or, for a compressed stream file,
+ * appends its seek table), and then closes the file.
  */
 BT_EXTERN_C
 int bt_ctfser_fini(struct bt_ctfser *ctfser);
@@ -89,11 +194,27 @@ int bt_ctfser_open_packet(struct bt_ctfser *ctfser);
 
 /*
  * Closes the current packet, making its size `packet_size_bytes`.
+ *
+ * With a writer, the packet isn't necessarily in the stream file when
+ * this function returns: the next call to bt_ctfser_open_packet() or
+ * bt_ctfser_fini() reports any write error.
  */
 BT_EXTERN_C
 void bt_ctfser_close_current_packet(struct bt_ctfser *ctfser,
 		uint64_t packet_size_bytes);
 
+/*
+ * Like bt_ctfser_close_current_packet(), but, if the writer of `ctfser`
+ * doesn't have enough room for the packet, discards the packet instead
+ * of waiting, as if bt_ctfser_open_packet() never opened it.
+ *
+ * Returns whether or not the packet is closed (always true without a
+ * writer).
+ */
+BT_EXTERN_C
+bool bt_ctfser_try_close_current_packet(struct bt_ctfser *ctfser,
+		uint64_t packet_size_bytes);
+
 BT_EXTERN_C
 int _bt_ctfser_increase_cur_packet_size(struct bt_ctfser *ctfser);
 
@@ -120,8 +241,7 @@ uint8_t *_bt_ctfser_get_addr(struct bt_ctfser *ctfser)
 {
 	/* Only makes sense to get the address after aligning on byte */
 	BT_ASSERT_DBG(ctfser->offset_in_cur_packet_bits % 8 == 0);
-	return ((uint8_t *) mmap_align_addr(ctfser->base_mma)) +
-		ctfser->mmap_base_offset + _bt_ctfser_offset_bytes(ctfser);
+	return ctfser->cur_packet_addr + _bt_ctfser_offset_bytes(ctfser);
 }
 
 static inline
@@ -403,12 +523,10 @@ int bt_ctfser_write_unsigned_int(struct bt_ctfser *ctfser, uint64_t value,
 	}
 
 	if (byte_order == LITTLE_ENDIAN) {
-		bt_bitfield_write_le((uint8_t *) mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	} else {
-		bt_bitfield_write_be((uint8_t *) mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	}
 
@@ -448,12 +566,10 @@ int bt_ctfser_write_signed_int(struct bt_ctfser *ctfser, int64_t value,
 	}
 
 	if (byte_order == LITTLE_ENDIAN) {
-		bt_bitfield_write_le((uint8_t *) mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	} else {
-		bt_bitfield_write_be((uint8_t *) mmap_align_addr(ctfser->base_mma) +
-			ctfser->mmap_base_offset, uint8_t,
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
 			ctfser->offset_in_cur_packet_bits, size_bits, value);
 	}
 
@@ -566,6 +682,141 @@ end:
 	return ret;
 }
 
+/*
+ * Makes sure that the current packet has at least `size_bits` bits of
+ * space left from the current offset, growing it if needed.
+ *
+ * After this, the bt_ctfser_*_reserved() functions may write up to
+ * `size_bits` bits (including alignment padding) without checking the
+ * remaining space.
+ */
+static inline
+int bt_ctfser_reserve_space(struct bt_ctfser *ctfser, uint64_t size_bits)
+{
+	int ret = 0;
+
+	while (G_UNLIKELY(!_bt_ctfser_has_space_left(ctfser, size_bits))) {
+		ret = _bt_ctfser_increase_cur_packet_size(ctfser);
+		if (G_UNLIKELY(ret)) {
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/*
+ * Like bt_ctfser_align_offset_in_current_packet(), but within space
+ * which bt_ctfser_reserve_space() reserved.
+ */
+static inline
+void bt_ctfser_align_offset_in_current_packet_reserved(
+		struct bt_ctfser *ctfser, uint64_t alignment_bits)
+{
+	BT_ASSERT_DBG(alignment_bits > 0);
+	_bt_ctfser_incr_offset(ctfser,
+		BT_ALIGN(ctfser->offset_in_cur_packet_bits, alignment_bits) -
+		ctfser->offset_in_cur_packet_bits);
+}
+
+/*
+ * Like bt_ctfser_write_unsigned_int(), but within space which
+ * bt_ctfser_reserve_space() reserved.
+ */
+static inline
+void bt_ctfser_write_unsigned_int_reserved(struct bt_ctfser *ctfser,
+	uint64_t value, unsigned int alignment_bits,
+	unsigned int size_bits, int byte_order)
+{
+	bt_ctfser_align_offset_in_current_packet_reserved(ctfser,
+		alignment_bits);
+
+	if (alignment_bits % 8 == 0 && size_bits % 8 == 0) {
+		(void) _bt_ctfser_write_byte_aligned_unsigned_int_no_align(
+			ctfser, value, size_bits, byte_order);
+		return;
+	}
+
+	BT_ASSERT_DBG(_bt_ctfser_has_space_left(ctfser, size_bits));
+
+	if (byte_order == LITTLE_ENDIAN) {
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
+			ctfser->offset_in_cur_packet_bits, size_bits, value);
+	} else {
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
+			ctfser->offset_in_cur_packet_bits, size_bits, value);
+	}
+
+	_bt_ctfser_incr_offset(ctfser, size_bits);
+}
+
+/*
+ * Like bt_ctfser_write_signed_int(), but within space which
+ * bt_ctfser_reserve_space() reserved.
+ */
+static inline
+void bt_ctfser_write_signed_int_reserved(struct bt_ctfser *ctfser,
+	int64_t value, unsigned int alignment_bits,
+	unsigned int size_bits, int byte_order)
+{
+	bt_ctfser_align_offset_in_current_packet_reserved(ctfser,
+		alignment_bits);
+
+	if (alignment_bits % 8 == 0 && size_bits % 8 == 0) {
+		(void) _bt_ctfser_write_byte_aligned_signed_int_no_align(
+			ctfser, value, size_bits, byte_order);
+		return;
+	}
+
+	BT_ASSERT_DBG(_bt_ctfser_has_space_left(ctfser, size_bits));
+
+	if (byte_order == LITTLE_ENDIAN) {
+		bt_bitfield_write_le(ctfser->cur_packet_addr, uint8_t,
+			ctfser->offset_in_cur_packet_bits, size_bits, value);
+	} else {
+		bt_bitfield_write_be(ctfser->cur_packet_addr, uint8_t,
+			ctfser->offset_in_cur_packet_bits, size_bits, value);
+	}
+
+	_bt_ctfser_incr_offset(ctfser, size_bits);
+}
+
+/*
+ * Like bt_ctfser_write_float32(), but within space which
+ * bt_ctfser_reserve_space() reserved.
+ */
+static inline
+void bt_ctfser_write_float32_reserved(struct bt_ctfser *ctfser,
+	double value, unsigned int alignment_bits, int byte_order)
+{
+	union u32f {
+		uint32_t u;
+		float f;
+	} u32f;
+
+	u32f.f = (float) value;
+	bt_ctfser_write_unsigned_int_reserved(ctfser, (uint64_t) u32f.u,
+		alignment_bits, 32, byte_order);
+}
+
+/*
+ * Like bt_ctfser_write_float64(), but within space which
+ * bt_ctfser_reserve_space() reserved.
+ */
+static inline
+void bt_ctfser_write_float64_reserved(struct bt_ctfser *ctfser,
+	double value, unsigned int alignment_bits, int byte_order)
+{
+	union u64f {
+		uint64_t u;
+		double d;
+	} u64f;
+
+	u64f.d = value;
+	bt_ctfser_write_unsigned_int_reserved(ctfser, u64f.u, alignment_bits,
+		64, byte_order);
+}
+
 /*
  * Returns the current offset within the current packet (bits).
  */
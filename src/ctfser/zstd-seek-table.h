@@ -0,0 +1,52 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_CTFSER_ZSTD_SEEK_TABLE_H
+#define BABELTRACE_CTFSER_ZSTD_SEEK_TABLE_H
+
+/*
+ * Layout of a compressed CTF data stream file.
+ *
+ * Such a file is a sequence of zstd frames, one per packet, followed
+ * with a seek table, which follows the zstd seekable format: the seek
+ * table is a skippable frame of which the content is, all integers
+ * being little-endian:
+ *
+ * • For each preceding frame:
+ *
+ *   1. Size of the compressed frame (32-bit).
+ *   2. Size of the decompressed frame, that is, of the packet (32-bit).
+ *
+ * • Footer:
+ *
+ *   1. Number of entries (32-bit).
+ *   2. Descriptor (8-bit, always 0: no checksums).
+ *   3. `BT_ZSTD_SEEK_TABLE_FOOTER_MAGIC` (32-bit).
+ *
+ * A reader only needs to read the footer at the end of the file to
+ * know whether or not it's compressed, and then the seek table to
+ * find the frame of any decompressed offset.
+ */
+
+/* Magic number of the seek table skippable frame */
+#define BT_ZSTD_SEEK_TABLE_FRAME_MAGIC		0x184d2a5eU
+
+/* Magic number which ends the seek table footer */
+#define BT_ZSTD_SEEK_TABLE_FOOTER_MAGIC		0x8f92eab1U
+
+/* Size of the skippable frame header (magic and frame size) */
+#define BT_ZSTD_SEEK_TABLE_FRAME_HEADER_SIZE	8
+
+/* Size of a seek table entry without checksum */
+#define BT_ZSTD_SEEK_TABLE_ENTRY_SIZE		8
+
+/* Size of the seek table footer */
+#define BT_ZSTD_SEEK_TABLE_FOOTER_SIZE		9
+
+/* Checksum flag of the footer descriptor (never set by ctfser) */
+#define BT_ZSTD_SEEK_TABLE_DESC_CHECKSUM_FLAG	0x80
+
+#endif /* BABELTRACE_CTFSER_ZSTD_SEEK_TABLE_H */
@@ -8,8 +8,10 @@
 
 #define BT_LOG_OUTPUT_LEVEL (fdc->log_level)
 #define BT_LOG_TAG          "FD-CACHE"
+#include <errno.h>
 #include <fcntl.h>
 #include <glib.h>
+#include <inttypes.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -31,6 +33,12 @@ struct fd_handle_internal
     struct bt_fd_cache_handle fd_handle;
     uint64_t ref_count;
     struct file_key *key;
+
+    /*
+     * Link within `bt_fd_cache::idle_handles` if unreferenced, or
+     * `NULL`.
+     */
+    GList *idle_link;
 };
 
 static void fd_cache_handle_internal_destroy(struct fd_handle_internal *internal_fd)
@@ -80,11 +88,55 @@ static void file_key_destroy(gpointer data)
     g_free(fk);
 }
 
-int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level)
+/*
+ * Closes the least recently used unreferenced handle of `fdc`.
+ *
+ * Returns whether or not there was such a handle.
+ */
+static bool fd_cache_evict_one(struct bt_fd_cache *fdc)
+{
+    struct fd_handle_internal *fd_internal =
+        static_cast<fd_handle_internal *>(g_queue_pop_head(&fdc->idle_handles));
+    gboolean ret;
+
+    if (!fd_internal) {
+        return false;
+    }
+
+    BT_ASSERT(fd_internal->ref_count == 0);
+    BT_LOGD("Closing least recently used file descriptor: fd=%d", fd_internal->fd_handle.fd);
+    fd_internal->idle_link = NULL;
+    fdc->eviction_count++;
+
+    /* Closes the file descriptor */
+    ret = g_hash_table_remove(fdc->cache, fd_internal->key);
+    BT_ASSERT(ret);
+    return true;
+}
+
+/*
+ * Closes unreferenced handles of `fdc`, least recently used first,
+ * until it has at most `max_count` open file descriptors.
+ */
+static void fd_cache_trim(struct bt_fd_cache *fdc, guint max_count)
+{
+    while (g_hash_table_size(fdc->cache) > max_count) {
+        if (!fd_cache_evict_one(fdc)) {
+            break;
+        }
+    }
+}
+
+int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level, guint capacity)
 {
     int ret = 0;
 
     fdc->log_level = log_level;
+    fdc->capacity = capacity;
+    g_queue_init(&fdc->idle_handles);
+    fdc->hit_count = 0;
+    fdc->miss_count = 0;
+    fdc->eviction_count = 0;
     fdc->cache = g_hash_table_new_full(file_key_hash, file_key_equal, file_key_destroy,
                                        (GDestroyNotify) fd_cache_handle_internal_destroy);
     if (!fdc->cache) {
@@ -100,11 +152,19 @@ void bt_fd_cache_fini(struct bt_fd_cache *fdc)
         goto end;
     }
 
+    BT_LOGD("Finalizing file descriptor cache: hit-count=%" PRIu64 ", miss-count=%" PRIu64
+            ", eviction-count=%" PRIu64,
+            fdc->hit_count, fdc->miss_count, fdc->eviction_count);
+
     /*
-     * All handle should have been removed for the hashtable at this point.
+     * All handles should have been put at this point: only the
+     * unreferenced ones which are still open remain.
      */
+    BT_ASSERT(g_hash_table_size(fdc->cache) == fdc->idle_handles.length);
+    fd_cache_trim(fdc, 0);
     BT_ASSERT(g_hash_table_size(fdc->cache) == 0);
     g_hash_table_destroy(fdc->cache);
+    fdc->cache = NULL;
 
 end:
     return;
@@ -138,10 +198,30 @@ struct bt_fd_cache_handle *bt_fd_cache_get_handle(struct bt_fd_cache *fdc, const
     fk.ino = statbuf.st_ino;
 
     fd_internal = static_cast<fd_handle_internal *>(g_hash_table_lookup(fdc->cache, &fk));
-    if (!fd_internal) {
+    if (fd_internal) {
+        fdc->hit_count++;
+
+        if (fd_internal->idle_link) {
+            /* Referenced again */
+            g_queue_delete_link(&fdc->idle_handles, fd_internal->idle_link);
+            fd_internal->idle_link = NULL;
+        }
+    } else {
         struct file_key *file_key;
 
+        fdc->miss_count++;
+
+        /* Make room for the new file descriptor */
+        if (fdc->capacity > 0) {
+            fd_cache_trim(fdc, fdc->capacity - 1);
+        }
+
         fd = open(path, O_RDONLY);
+        while (fd < 0 && (errno == EMFILE || errno == ENFILE) && fd_cache_evict_one(fdc)) {
+            /* Try again with one less open file descriptor */
+            fd = open(path, O_RDONLY);
+        }
+
         if (fd < 0) {
             BT_LOGE_ERRNO("Failed to open file", "path=%s", path);
             goto error;
@@ -202,18 +282,17 @@ void bt_fd_cache_put_handle(struct bt_fd_cache *fdc, struct bt_fd_cache_handle *
 
     BT_ASSERT(fd_internal->ref_count > 0);
 
-    if (fd_internal->ref_count > 1) {
-        fd_internal->ref_count--;
-    } else {
-        gboolean ret;
-        int close_ret;
+    fd_internal->ref_count--;
 
-        close_ret = close(fd_internal->fd_handle.fd);
-        if (close_ret == -1) {
-            BT_LOGE_ERRNO("Failed to close file descriptor", ": fd=%d", fd_internal->fd_handle.fd);
-        }
-        ret = g_hash_table_remove(fdc->cache, fd_internal->key);
-        BT_ASSERT(ret);
+    if (fd_internal->ref_count == 0) {
+        /*
+         * Keep the file descriptor open for a future
+         * bt_fd_cache_get_handle() call, closing the least recently
+         * used ones beyond the capacity (possibly this one).
+         */
+        g_queue_push_tail(&fdc->idle_handles, fd_internal);
+        fd_internal->idle_link = fdc->idle_handles.tail;
+        fd_cache_trim(fdc, fdc->capacity);
     }
 
 end:
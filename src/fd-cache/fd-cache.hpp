@@ -10,6 +10,13 @@
 #define BABELTRACE_FD_CACHE_FD_CACHE_HPP
 
 #include <glib.h>
+#include <stdint.h>
+
+/*
+ * Default maximum number of file descriptors which a cache keeps open
+ * (see bt_fd_cache_init()).
+ */
+#define BT_FD_CACHE_DEFAULT_CAPACITY 128
 
 struct bt_fd_cache_handle
 {
@@ -20,6 +27,25 @@ struct bt_fd_cache
 {
     int log_level;
     GHashTable *cache;
+
+    /*
+     * Maximum number of open file descriptors: the cache closes the
+     * least recently used unreferenced handles to honour it.
+     *
+     * The cache exceeds it only when all its handles are referenced.
+     */
+    guint capacity;
+
+    /*
+     * Unreferenced handles, still open, from the least to the most
+     * recently used (`struct fd_handle_internal *`).
+     */
+    GQueue idle_handles;
+
+    /* Statistics */
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t eviction_count;
 };
 
 static inline int bt_fd_cache_handle_get_fd(struct bt_fd_cache_handle *handle)
@@ -27,7 +53,14 @@ static inline int bt_fd_cache_handle_get_fd(struct bt_fd_cache_handle *handle)
     return handle->fd;
 }
 
-int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level);
+/*
+ * Initializes the cache `fdc` to keep at most `capacity` file
+ * descriptors open (see `struct bt_fd_cache`).
+ *
+ * With a capacity of 0, the cache closes a file descriptor as soon as
+ * its last handle is put.
+ */
+int bt_fd_cache_init(struct bt_fd_cache *fdc, int log_level, guint capacity);
 
 void bt_fd_cache_fini(struct bt_fd_cache *fdc);
 
@@ -619,6 +619,17 @@
 	BT_ASSERT_PRE_DEV_NON_NULL(_BT_ASSERT_PRE_FP_ID, (_fp),		\
 		_BT_ASSERT_PRE_FP_NAME)
 
+#define _BT_ASSERT_PRE_FPH_NAME	"Field path handle"
+#define _BT_ASSERT_PRE_FPH_ID	"field-path-handle"
+
+#define BT_ASSERT_PRE_FPH_NON_NULL(_fph)				\
+	BT_ASSERT_PRE_NON_NULL(_BT_ASSERT_PRE_FPH_ID, (_fph),		\
+		_BT_ASSERT_PRE_FPH_NAME)
+
+#define BT_ASSERT_PRE_DEV_FPH_NON_NULL(_fph)				\
+	BT_ASSERT_PRE_DEV_NON_NULL(_BT_ASSERT_PRE_FPH_ID, (_fph),	\
+		_BT_ASSERT_PRE_FPH_NAME)
+
 #define BT_ASSERT_PRE_DEV_FIELD_HAS_CLASS_TYPE_FROM_FUNC(_func, _field_id, _field, _cls_type_id, _cls_type, _name) \
 	BT_ASSERT_PRE_DEV_FROM_FUNC(_func, "is-" _cls_type_id ":" _field_id, \
 		((const struct bt_field *) (_field))->class->type == (_cls_type), \
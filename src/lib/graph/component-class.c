@@ -17,6 +17,7 @@
 #include <glib.h>
 
 #include "component-class.h"
+#include "query-executor.h"
 #include "lib/func-status.h"
 #include "lib/graph/message-iterator-class.h"
 
@@ -36,6 +37,13 @@ void destroy_component_class(struct bt_object *obj)
 
 	BT_LIB_LOGI("Destroying component class: %!+C", class);
 
+	/*
+	 * Destroy the stashed query states first: their destroy functions
+	 * may belong to the shared library of a plugin which a destroy
+	 * listener unloads.
+	 */
+	bt_component_class_destroy_query_stash(class);
+
 	/* Call destroy listeners in reverse registration order */
 	if (class->destroy_listeners) {
 		for (i = class->destroy_listeners->len - 1; i >= 0; i--) {
@@ -37,6 +37,14 @@ struct bt_component_class {
 
 	/* Array of struct bt_component_class_destroy_listener */
 	GArray *destroy_listeners;
+
+	/*
+	 * Array of `struct bt_query_stash_entry *`, owned by this, oldest
+	 * first, or `NULL` if no query method ever stashed a state (see
+	 * `query-executor.c`).
+	 */
+	GPtrArray *query_stash;
+
 	bool frozen;
 	struct bt_list_head node;
 	struct bt_plugin_so_shared_lib_handle *so_handle;
@@ -27,6 +27,7 @@
 #include "component-sink.h"
 #include "connection.h"
 #include "graph.h"
+#include "query-executor.h"
 #include "iterator.h"
 #include "port.h"
 #include "lib/func-status.h"
@@ -361,6 +362,27 @@ const char *bt_component_get_name(const struct bt_component *component)
 	return component->name->str;
 }
 
+BT_EXPORT
+void bt_component_get_statistics(const struct bt_component *component,
+		uint64_t *call_count, uint64_t *message_count,
+		uint64_t *inclusive_duration_ns,
+		uint64_t *exclusive_duration_ns)
+{
+	BT_ASSERT_PRE_COMP_NON_NULL(component);
+	BT_ASSERT_PRE_NON_NULL("call-count-output", call_count,
+		"Call count (output)");
+	BT_ASSERT_PRE_NON_NULL("message-count-output", message_count,
+		"Message count (output)");
+	BT_ASSERT_PRE_NON_NULL("inclusive-duration-output",
+		inclusive_duration_ns, "Inclusive duration (output)");
+	BT_ASSERT_PRE_NON_NULL("exclusive-duration-output",
+		exclusive_duration_ns, "Exclusive duration (output)");
+	*call_count = component->stats.call_count;
+	*message_count = component->stats.msg_count;
+	*inclusive_duration_ns = component->stats.inclusive_ns;
+	*exclusive_duration_ns = component->stats.exclusive_ns;
+}
+
 BT_EXPORT
 const struct bt_component_class *bt_component_borrow_class_const(
 		const struct bt_component *component)
@@ -625,6 +647,93 @@ uint64_t bt_self_component_get_graph_mip_version(
 	return bt_component_borrow_graph(comp)->mip_version;
 }
 
+BT_EXPORT
+enum bt_self_component_add_wait_fd_status bt_self_component_add_wait_fd(
+		bt_self_component *self_component, int fd)
+{
+	struct bt_component *comp = (void *) self_component;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_COMP_NON_NULL(self_component);
+	BT_ASSERT_PRE("valid-fd", fd >= 0,
+		"File descriptor is negative: %![comp-]+c, fd=%d", comp, fd);
+	return bt_graph_add_wait_fd(bt_component_borrow_graph(comp), fd);
+}
+
+BT_EXPORT
+void bt_self_component_remove_wait_fd(bt_self_component *self_component,
+		int fd)
+{
+	struct bt_component *comp = (void *) self_component;
+
+	BT_ASSERT_PRE_COMP_NON_NULL(self_component);
+	bt_graph_remove_wait_fd(bt_component_borrow_graph(comp), fd);
+}
+
+BT_EXPORT
+void bt_self_component_add_memory_usage(bt_self_component *self_component,
+		int64_t delta)
+{
+	struct bt_component *comp = (void *) self_component;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(self_component);
+	bt_graph_add_memory_usage(bt_component_borrow_graph(comp), comp,
+		delta);
+}
+
+BT_EXPORT
+uint64_t bt_self_component_get_graph_memory_budget(
+		const bt_self_component *self_component)
+{
+	const struct bt_component *comp = (const void *) self_component;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(self_component);
+	return bt_graph_get_memory_budget(
+		bt_component_borrow_graph((void *) comp));
+}
+
+BT_EXPORT
+uint64_t bt_self_component_get_graph_memory_usage(
+		const bt_self_component *self_component)
+{
+	const struct bt_component *comp = (const void *) self_component;
+	uint64_t usage, peak_usage;
+
+	BT_ASSERT_PRE_DEV_COMP_NON_NULL(self_component);
+	bt_graph_get_memory_usage(bt_component_borrow_graph((void *) comp),
+		&usage, &peak_usage);
+	return usage;
+}
+
+BT_EXPORT
+void *bt_self_component_take_query_stash(bt_self_component *self_component,
+		const struct bt_value *key)
+{
+	struct bt_component *comp = (void *) self_component;
+
+	BT_ASSERT_PRE_COMP_NON_NULL(self_component);
+	BT_ASSERT_PRE_NON_NULL("key", key, "Key");
+	return bt_component_class_take_query_stash(comp->class, key);
+}
+
+BT_EXPORT
+void bt_component_get_memory_usage(const struct bt_component *component,
+		uint64_t *usage, uint64_t *peak_usage)
+{
+	struct bt_graph *graph;
+
+	BT_ASSERT_PRE_COMP_NON_NULL(component);
+	BT_ASSERT_PRE_NON_NULL("usage-output", usage,
+		"Memory usage (output)");
+	BT_ASSERT_PRE_NON_NULL("peak-usage-output", peak_usage,
+		"Peak memory usage (output)");
+	graph = bt_component_borrow_graph((void *) component);
+	g_mutex_lock(&graph->mem.lock);
+	*usage = component->mem_usage;
+	*peak_usage = component->peak_mem_usage;
+	g_mutex_unlock(&graph->mem.lock);
+}
+
 BT_EXPORT
 void bt_component_get_ref(const struct bt_component *component)
 {
@@ -30,6 +30,24 @@ struct bt_component_destroy_listener {
 
 struct bt_graph;
 
+/*
+ * Statistics of a component or of a message iterator, which its graph
+ * accumulates when bt_graph_enable_statistics() was called.
+ */
+struct bt_component_stats {
+	/* Number of "next" or "consume" method calls */
+	uint64_t call_count;
+
+	/* Number of messages which "next" methods returned */
+	uint64_t msg_count;
+
+	/* Time spent in those method calls, including upstream calls */
+	uint64_t inclusive_ns;
+
+	/* Time spent in those method calls, excluding upstream calls */
+	uint64_t exclusive_ns;
+};
+
 struct bt_component {
 	struct bt_object base;
 	struct bt_component_class *class;
@@ -47,8 +65,28 @@ struct bt_component {
 	GArray *destroy_listeners;
 
 	bool initialized;
+
+	/* Sum of the statistics of all its message iterators, if any */
+	struct bt_component_stats stats;
+
+	/*
+	 * Current and peak memory usage which the component reported,
+	 * protected by the memory accounting lock of its graph.
+	 */
+	uint64_t mem_usage;
+	uint64_t peak_mem_usage;
 };
 
+static inline
+void bt_component_stats_add(struct bt_component_stats *stats,
+		const struct bt_component_stats *other)
+{
+	stats->call_count += other->call_count;
+	stats->msg_count += other->msg_count;
+	stats->inclusive_ns += other->inclusive_ns;
+	stats->exclusive_ns += other->exclusive_ns;
+}
+
 static inline
 struct bt_graph *bt_component_borrow_graph(struct bt_component *comp)
 {
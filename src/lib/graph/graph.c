@@ -19,10 +19,18 @@
 #include <babeltrace2/types.h>
 #include <babeltrace2/value.h>
 #include "lib/value.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <stdbool.h>
 #include <glib.h>
 
+#ifndef __MINGW32__
+# include <poll.h>
+#endif
+
 #include "component-class-sink-simple.h"
 #include "component.h"
 #include "component-sink.h"
@@ -137,30 +145,61 @@ void destroy_graph(struct bt_object *obj)
 		graph->listeners.sink_input_port_added = NULL;
 	}
 
+	if (graph->wait_fds) {
+		g_array_free(graph->wait_fds, TRUE);
+		graph->wait_fds = NULL;
+	}
+
 	bt_object_pool_finalize(&graph->event_msg_pool);
 	bt_object_pool_finalize(&graph->packet_begin_msg_pool);
 	bt_object_pool_finalize(&graph->packet_end_msg_pool);
+	g_mutex_clear(&graph->mem.lock);
 	g_free(graph);
 }
 
+/*
+ * Removes the message `msg`, which one of the message pools of `graph`
+ * is about to destroy, from `graph->messages`.
+ *
+ * A message pool destroys a message before the graph is destroyed
+ * when it's full (see set_msg_pools_max_size()): without this,
+ * destroy_graph() would unlink a freed message, and
+ * `graph->messages` would grow with each message replacing a
+ * destroyed one.
+ */
+static
+void remove_message(struct bt_graph *graph, struct bt_message *msg)
+{
+	if (!graph->messages) {
+		/* Graph is being destroyed: already unlinked */
+		return;
+	}
+
+	/* This also calls notify_message_graph_is_destroyed() */
+	g_ptr_array_remove_fast(graph->messages, msg);
+}
+
 static
 void destroy_message_event(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	remove_message(graph, msg);
 	bt_message_event_destroy(msg);
 }
 
 static
 void destroy_message_packet_begin(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	remove_message(graph, msg);
 	bt_message_packet_destroy(msg);
 }
 
 static
 void destroy_message_packet_end(struct bt_message *msg,
-		struct bt_graph *graph __attribute__((unused)))
+		struct bt_graph *graph)
 {
+	remove_message(graph, msg);
 	bt_message_packet_destroy(msg);
 }
 
@@ -190,7 +229,9 @@ struct bt_graph *bt_graph_create(uint64_t mip_version)
 	}
 
 	bt_object_init_shared(&graph->base, destroy_graph);
+	g_mutex_init(&graph->mem.lock);
 	graph->mip_version = mip_version;
+	graph->msg_batch_size = BT_GRAPH_DEFAULT_MSG_BATCH_SIZE;
 	graph->connections = g_ptr_array_new_with_free_func(
 		(GDestroyNotify) bt_object_try_spec_release);
 	if (!graph->connections) {
@@ -288,6 +329,12 @@ struct bt_graph *bt_graph_create(uint64_t mip_version)
 
 	graph->messages = g_ptr_array_new_with_free_func(
 		(GDestroyNotify) notify_message_graph_is_destroyed);
+	graph->wait_fds = g_array_new(FALSE, FALSE, sizeof(int));
+	if (!graph->wait_fds) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate one GArray.");
+		goto error;
+	}
+
 	BT_LIB_LOGI("Created graph object: %!+g", graph);
 
 end:
@@ -446,7 +493,20 @@ int consume_graph_sink(struct bt_component_sink *comp)
 	sink_class = (void *) comp->parent.class;
 	BT_ASSERT_DBG(sink_class->methods.consume);
 	BT_LIB_LOGD("Calling user's consume method: %!+c", comp);
-	consume_status = sink_class->methods.consume((void *) comp);
+
+	if (G_UNLIKELY(bt_component_borrow_graph(&comp->parent)->collect_stats)) {
+		struct bt_graph *graph = bt_component_borrow_graph(&comp->parent);
+		struct bt_graph_stats_call call;
+		struct bt_component_stats call_stats;
+
+		bt_graph_stats_begin_call(graph, &call);
+		consume_status = sink_class->methods.consume((void *) comp);
+		bt_graph_stats_end_call(graph, &call, 0, &call_stats);
+		bt_component_stats_add(&comp->parent.stats, &call_stats);
+	} else {
+		consume_status = sink_class->methods.consume((void *) comp);
+	}
+
 	BT_LOGD("User method returned: status=%s",
 		bt_common_func_status_string(consume_status));
 	BT_ASSERT_POST_DEV(CONSUME_METHOD_NAME, "valid-status",
@@ -570,6 +630,45 @@ end:
 	return status;
 }
 
+/*
+ * Bounds the message pools of `graph` to the value of the
+ * `LIBBABELTRACE2_MSG_POOL_MAX_SIZE` environment variable, if set.
+ *
+ * Messages which are recycled while their pool is full are destroyed
+ * instead of kept, which caps the memory a graph retains after a burst.
+ */
+static
+void set_msg_pools_max_size(struct bt_graph *graph)
+{
+	const char *envvar = getenv("LIBBABELTRACE2_MSG_POOL_MAX_SIZE");
+	char *endptr;
+	guint64 max_size;
+
+	if (!envvar) {
+		goto end;
+	}
+
+	errno = 0;
+	max_size = g_ascii_strtoull(envvar, &endptr, 10);
+	if (errno != 0 || endptr == envvar || *endptr != '\0' ||
+			max_size > SIZE_MAX) {
+		BT_LOGW("Ignoring invalid `LIBBABELTRACE2_MSG_POOL_MAX_SIZE` "
+			"environment variable: value=\"%s\"", envvar);
+		goto end;
+	}
+
+	BT_LOGI("Setting maximum size of message pools: "
+		"addr=%p, max-size=%" PRIu64, graph, (uint64_t) max_size);
+	bt_object_pool_set_max_size(&graph->event_msg_pool, (size_t) max_size);
+	bt_object_pool_set_max_size(&graph->packet_begin_msg_pool,
+		(size_t) max_size);
+	bt_object_pool_set_max_size(&graph->packet_end_msg_pool,
+		(size_t) max_size);
+
+end:
+	return;
+}
+
 #define GRAPH_IS_CONFIGURED_METHOD_NAME					\
 	"bt_component_class_sink_graph_is_configured_method"
 
@@ -590,6 +689,25 @@ int configure_graph(struct bt_graph *graph, const char *api_func)
 	BT_ASSERT_PRE_FROM_FUNC(api_func,
 		"graph-has-at-least-one-sink-component",
 		graph->has_sink, "Graph has no sink component: %!+g", graph);
+
+	if (graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING) {
+		set_msg_pools_max_size(graph);
+
+		/*
+		 * The message batch size is now frozen: preallocate
+		 * enough event messages for one full batch so that the
+		 * first one doesn't allocate them one by one.
+		 */
+		if (bt_object_pool_preallocate(&graph->event_msg_pool,
+				graph->msg_batch_size)) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to preallocate event messages: %!+g",
+				graph);
+			status = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+	}
+
 	graph->config_state = BT_GRAPH_CONFIGURATION_STATE_PARTIALLY_CONFIGURED;
 
 	for (i = 0; i < graph->components->len; i++) {
@@ -1326,6 +1444,134 @@ enum bt_graph_add_interrupter_status bt_graph_add_interrupter(
 	return BT_FUNC_STATUS_OK;
 }
 
+int bt_graph_add_wait_fd(struct bt_graph *graph, int fd)
+{
+	BT_ASSERT(graph);
+	g_array_append_val(graph->wait_fds, fd);
+	BT_LIB_LOGD("Added wait file descriptor to graph: %![graph-]+g, fd=%d",
+		graph, fd);
+	return BT_FUNC_STATUS_OK;
+}
+
+void bt_graph_remove_wait_fd(struct bt_graph *graph, int fd)
+{
+	guint i;
+
+	BT_ASSERT(graph);
+
+	for (i = 0; i < graph->wait_fds->len; i++) {
+		if (bt_g_array_index(graph->wait_fds, int, i) == fd) {
+			g_array_remove_index_fast(graph->wait_fds, i);
+			BT_LIB_LOGD("Removed wait file descriptor from graph: "
+				"%![graph-]+g, fd=%d", graph, fd);
+			return;
+		}
+	}
+
+	BT_ASSERT_PRE("wait-fd-exists", false,
+		"Graph has no such wait file descriptor: %![graph-]+g, fd=%d",
+		graph, fd);
+}
+
+void bt_graph_add_memory_usage(struct bt_graph *graph,
+		struct bt_component *comp, int64_t delta)
+{
+	BT_ASSERT_DBG(graph);
+	BT_ASSERT_DBG(comp);
+	g_mutex_lock(&graph->mem.lock);
+	BT_ASSERT_PRE_FROM_FUNC("bt_self_component_add_memory_usage",
+		"memory-usage-is-not-negative",
+		delta >= 0 || (uint64_t) -delta <= comp->mem_usage,
+		"Removing more memory than the component reported: "
+		"%![comp-]+c, usage=%" PRIu64 ", delta=%" PRId64,
+		comp, comp->mem_usage, delta);
+	comp->mem_usage += (uint64_t) delta;
+	graph->mem.usage += (uint64_t) delta;
+
+	if (comp->mem_usage > comp->peak_mem_usage) {
+		comp->peak_mem_usage = comp->mem_usage;
+	}
+
+	if (graph->mem.usage > graph->mem.peak_usage) {
+		graph->mem.peak_usage = graph->mem.usage;
+	}
+
+	g_mutex_unlock(&graph->mem.lock);
+}
+
+BT_EXPORT
+enum bt_graph_wait_status bt_graph_wait(struct bt_graph *graph,
+		uint64_t timeout_us)
+{
+	enum bt_graph_wait_status status = BT_FUNC_STATUS_OK;
+#ifndef __MINGW32__
+	struct pollfd *pfds = NULL;
+	uint64_t timeout_ms;
+	guint i;
+	int ret;
+#endif
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-faulty",
+		graph->config_state != BT_GRAPH_CONFIGURATION_STATE_FAULTY,
+		"Graph is in a faulty state: %!+g", graph);
+
+	if (bt_graph_is_interrupted(graph)) {
+		goto end;
+	}
+
+	BT_LIB_LOGT("Waiting for graph's wait file descriptors: "
+		"%![graph-]+g, fd-count=%u, timeout-us=%" PRIu64,
+		graph, graph->wait_fds->len, timeout_us);
+
+#ifdef __MINGW32__
+	/* No poll() */
+	g_usleep(timeout_us);
+#else
+	/* Round up: don't busy-wait with a sub-millisecond timeout */
+	timeout_ms = (timeout_us + 999) / 1000;
+
+	if (timeout_ms > INT_MAX) {
+		timeout_ms = INT_MAX;
+	}
+
+	if (graph->wait_fds->len > 0) {
+		pfds = g_new(struct pollfd, graph->wait_fds->len);
+		if (!pfds) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate poll file descriptors.");
+			status = BT_FUNC_STATUS_ERROR;
+			goto end;
+		}
+
+		for (i = 0; i < graph->wait_fds->len; i++) {
+			pfds[i].fd = bt_g_array_index(graph->wait_fds, int, i);
+			pfds[i].events = POLLIN;
+			pfds[i].revents = 0;
+		}
+	}
+
+	ret = poll(pfds, graph->wait_fds->len, (int) timeout_ms);
+	if (ret < 0 && errno != EINTR) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to wait for graph's wait file descriptors: "
+			"%![graph-]+g, %s", graph, g_strerror(errno));
+		status = BT_FUNC_STATUS_ERROR;
+		goto end;
+	}
+
+	BT_LIB_LOGT("Waited for graph's wait file descriptors: "
+		"%![graph-]+g, ready-fd-count=%d", graph, ret);
+#endif
+
+end:
+#ifndef __MINGW32__
+	g_free(pfds);
+#endif
+	return status;
+}
+
 BT_EXPORT
 struct bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 {
@@ -1333,6 +1579,80 @@ struct bt_interrupter *bt_graph_borrow_default_interrupter(bt_graph *graph)
 	return graph->default_interrupter;
 }
 
+BT_EXPORT
+void bt_graph_set_message_batch_size(struct bt_graph *graph,
+		uint64_t batch_size)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	BT_ASSERT_PRE("valid-batch-size", batch_size > 0,
+		"Message batch size is 0: %!+g", graph);
+	graph->msg_batch_size = batch_size;
+	BT_LIB_LOGD("Set graph's message batch size: %![graph-]+g, "
+		"batch-size=%" PRIu64, graph, batch_size);
+}
+
+BT_EXPORT
+uint64_t bt_graph_get_message_batch_size(const struct bt_graph *graph)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	return graph->msg_batch_size;
+}
+
+BT_EXPORT
+void bt_graph_enable_statistics(struct bt_graph *graph)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE("graph-is-not-configured",
+		graph->config_state == BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
+		"Graph is not in the \"configuring\" state: %!+g", graph);
+	graph->collect_stats = true;
+	BT_LIB_LOGD("Enabled graph's statistics: %!+g", graph);
+}
+
+BT_EXPORT
+void bt_graph_set_memory_budget(struct bt_graph *graph, uint64_t budget)
+{
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	g_mutex_lock(&graph->mem.lock);
+	graph->mem.budget = budget;
+	g_mutex_unlock(&graph->mem.lock);
+	BT_LIB_LOGD("Set graph's memory budget: %![graph-]+g, "
+		"budget=%" PRIu64, graph, budget);
+}
+
+BT_EXPORT
+uint64_t bt_graph_get_memory_budget(const struct bt_graph *graph)
+{
+	struct bt_graph *mut_graph = (void *) graph;
+	uint64_t budget;
+
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	g_mutex_lock(&mut_graph->mem.lock);
+	budget = graph->mem.budget;
+	g_mutex_unlock(&mut_graph->mem.lock);
+	return budget;
+}
+
+BT_EXPORT
+void bt_graph_get_memory_usage(const struct bt_graph *graph,
+		uint64_t *usage, uint64_t *peak_usage)
+{
+	struct bt_graph *mut_graph = (void *) graph;
+
+	BT_ASSERT_PRE_GRAPH_NON_NULL(graph);
+	BT_ASSERT_PRE_NON_NULL("usage-output", usage,
+		"Memory usage (output)");
+	BT_ASSERT_PRE_NON_NULL("peak-usage-output", peak_usage,
+		"Peak memory usage (output)");
+	g_mutex_lock(&mut_graph->mem.lock);
+	*usage = graph->mem.usage;
+	*peak_usage = graph->mem.peak_usage;
+	g_mutex_unlock(&mut_graph->mem.lock);
+}
+
 BT_EXPORT
 void bt_graph_get_ref(const struct bt_graph *graph)
 {
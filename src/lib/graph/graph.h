@@ -19,6 +19,8 @@
 #include "lib/object-pool.h"
 #include "common/assert.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 #include <glib.h>
 
 #include "component.h"
@@ -33,6 +35,14 @@
 struct bt_component;
 struct bt_port;
 
+/*
+ * Default message batch size of a graph.
+ *
+ * TODO: Use graph's state (number of active iterators, etc.) and
+ * possibly system specifications to make a better guess than this.
+ */
+#define BT_GRAPH_DEFAULT_MSG_BATCH_SIZE	15
+
 enum bt_graph_configuration_state {
 	BT_GRAPH_CONFIGURATION_STATE_CONFIGURING,
 	BT_GRAPH_CONFIGURATION_STATE_PARTIALLY_CONFIGURED,
@@ -63,6 +73,16 @@ struct bt_graph {
 
 	uint64_t mip_version;
 
+	/*
+	 * Capacity of the message array which a message iterator of
+	 * this graph passes to the "next" method of its class.
+	 *
+	 * Frozen once the graph isn't in the "configuring" state
+	 * anymore, as message iterators size their array from it on
+	 * creation.
+	 */
+	uint64_t msg_batch_size;
+
 	/*
 	 * Array of `struct bt_interrupter *`, each one owned by this.
 	 * If any interrupter is set, then this graph is deemed
@@ -91,6 +111,19 @@ struct bt_graph {
 
 	enum bt_graph_configuration_state config_state;
 
+	/*
+	 * Whether or not to accumulate the statistics of the components
+	 * and message iterators of this graph.
+	 */
+	bool collect_stats;
+
+	/*
+	 * Total time spent in the callee methods of the current method
+	 * call, to compute its exclusive time (see
+	 * bt_graph_stats_begin_call() and bt_graph_stats_end_call()).
+	 */
+	uint64_t stats_callee_ns;
+
 	struct {
 		GArray *source_output_port_added;
 		GArray *filter_output_port_added;
@@ -122,6 +155,31 @@ struct bt_graph {
 	 * array (on destruction).
 	 */
 	GPtrArray *messages;
+
+	/*
+	 * Array of `int`: file descriptors which components of
+	 * this graph added with bt_self_component_add_wait_fd() (see
+	 * bt_graph_wait()).
+	 */
+	GArray *wait_fds;
+
+	/*
+	 * Memory accounting (see bt_self_component_add_memory_usage()).
+	 *
+	 * `lock` protects the members of `mem` as well as the memory
+	 * usage of each component of this graph: components may report
+	 * from their own threads.
+	 */
+	struct {
+		GMutex lock;
+
+		/* Memory budget, or 0 if none */
+		uint64_t budget;
+
+		/* Current and peak total memory usage of the components */
+		uint64_t usage;
+		uint64_t peak_usage;
+	} mem;
 };
 
 static inline
@@ -145,6 +203,13 @@ void bt_graph_add_message(struct bt_graph *graph,
 
 bool bt_graph_is_interrupted(const struct bt_graph *graph);
 
+int bt_graph_add_wait_fd(struct bt_graph *graph, int fd);
+
+void bt_graph_remove_wait_fd(struct bt_graph *graph, int fd);
+
+void bt_graph_add_memory_usage(struct bt_graph *graph,
+		struct bt_component *comp, int64_t delta);
+
 static inline
 const char *bt_graph_configuration_state_string(
 		enum bt_graph_configuration_state state)
@@ -172,4 +237,62 @@ void bt_graph_make_faulty(struct bt_graph *graph)
 	BT_LIB_LOGI("Set graph's state to faulty: %![graph-]+g", graph);
 }
 
+/*
+ * State of a method call for which a graph is accumulating statistics.
+ */
+struct bt_graph_stats_call {
+	uint64_t begin_ns;
+	uint64_t caller_callee_ns;
+};
+
+static inline
+uint64_t bt_graph_stats_now_ns(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * UINT64_C(1000000000) +
+		(uint64_t) ts.tv_nsec;
+#else
+	return (uint64_t) g_get_monotonic_time() * UINT64_C(1000);
+#endif
+}
+
+/*
+ * Call before calling a user method of which to accumulate the
+ * statistics with bt_graph_stats_end_call().
+ */
+static inline
+void bt_graph_stats_begin_call(struct bt_graph *graph,
+		struct bt_graph_stats_call *call)
+{
+	BT_ASSERT_DBG(graph->collect_stats);
+	call->caller_callee_ns = graph->stats_callee_ns;
+	graph->stats_callee_ns = 0;
+	call->begin_ns = bt_graph_stats_now_ns();
+}
+
+/*
+ * Call after the user method call which bt_graph_stats_begin_call()
+ * started, which returned `msg_count` messages: sets `*call_stats` to
+ * the statistics of this single call.
+ */
+static inline
+void bt_graph_stats_end_call(struct bt_graph *graph,
+		const struct bt_graph_stats_call *call, uint64_t msg_count,
+		struct bt_component_stats *call_stats)
+{
+	const uint64_t inclusive_ns = bt_graph_stats_now_ns() - call->begin_ns;
+
+	call_stats->call_count = 1;
+	call_stats->msg_count = msg_count;
+	call_stats->inclusive_ns = inclusive_ns;
+	call_stats->exclusive_ns = inclusive_ns > graph->stats_callee_ns ?
+		inclusive_ns - graph->stats_callee_ns : 0;
+
+	/* This whole call is a callee of the caller */
+	graph->stats_callee_ns = call->caller_callee_ns + inclusive_ns;
+}
+
 #endif /* BABELTRACE_LIB_GRAPH_GRAPH_H */
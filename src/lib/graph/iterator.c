@@ -52,12 +52,6 @@
 #include "lib/func-status.h"
 #include "clock-correlation-validator/clock-correlation-validator.h"
 
-/*
- * TODO: Use graph's state (number of active iterators, etc.) and
- * possibly system specifications to make a better guess than this.
- */
-#define MSG_BATCH_SIZE	15
-
 #define BT_ASSERT_PRE_ITER_HAS_STATE_TO_SEEK(_iter)			\
 	BT_ASSERT_PRE("has-state-to-seek",				\
 		(_iter)->state == BT_MESSAGE_ITERATOR_STATE_ACTIVE ||	\
@@ -199,6 +193,17 @@ void bt_message_iterator_try_finalize(
 	}
 
 	BT_LIB_LOGD("Finalizing message iterator: %!+i", iterator);
+
+	if (iterator->stats.call_count > 0) {
+		BT_LIB_LOGI("Message iterator statistics: %![iter-]+i, "
+			"call-count=%" PRIu64 ", msg-count=%" PRIu64 ", "
+			"inclusive-ns=%" PRIu64 ", exclusive-ns=%" PRIu64,
+			iterator, iterator->stats.call_count,
+			iterator->stats.msg_count,
+			iterator->stats.inclusive_ns,
+			iterator->stats.exclusive_ns);
+	}
+
 	set_msg_iterator_state(iterator,
 		BT_MESSAGE_ITERATOR_STATE_FINALIZING);
 	BT_ASSERT(iterator->upstream_component);
@@ -374,7 +379,10 @@ int create_self_component_input_port_message_iterator(
 		}
 	);
 
-	g_ptr_array_set_size(iterator->msgs, MSG_BATCH_SIZE);
+	iterator->batch_size =
+		bt_component_borrow_graph(upstream_comp)->msg_batch_size;
+	BT_ASSERT(iterator->batch_size > 0);
+	g_ptr_array_set_size(iterator->msgs, iterator->batch_size);
 	iterator->last_ns_from_origin = INT64_MIN;
 
 	/* The per-stream state is only used for dev assertions right now. */
@@ -1274,7 +1282,25 @@ call_iterator_next_method(
 
 	BT_ASSERT_DBG(iterator->methods.next);
 	BT_LOGD_STR("Calling user's \"next\" method.");
-	status = iterator->methods.next(iterator, msgs, capacity, user_count);
+
+	if (G_UNLIKELY(iterator->graph->collect_stats)) {
+		struct bt_graph_stats_call call;
+		struct bt_component_stats call_stats;
+
+		bt_graph_stats_begin_call(iterator->graph, &call);
+		status = iterator->methods.next(iterator, msgs, capacity,
+			user_count);
+		bt_graph_stats_end_call(iterator->graph, &call,
+			status == BT_FUNC_STATUS_OK ? *user_count : 0,
+			&call_stats);
+		bt_component_stats_add(&iterator->stats, &call_stats);
+		bt_component_stats_add(&iterator->upstream_component->stats,
+			&call_stats);
+	} else {
+		status = iterator->methods.next(iterator, msgs, capacity,
+			user_count);
+	}
+
 	BT_LOGD("User method returned: status=%s, msg-count=%" PRIu64,
 		bt_common_func_status_string(status), *user_count);
 
@@ -1324,8 +1350,8 @@ bt_message_iterator_next(
 		"Graph is not configured: %!+g",
 		bt_component_borrow_graph(iterator->upstream_component));
 	BT_LIB_LOGD("Getting next self component input port "
-		"message iterator's messages: %!+i, batch-size=%u",
-		iterator, MSG_BATCH_SIZE);
+		"message iterator's messages: %!+i, batch-size=%" PRIu64,
+		iterator, iterator->batch_size);
 
 	/*
 	 * Call the user's "next" method to get the next messages
@@ -1333,7 +1359,7 @@ bt_message_iterator_next(
 	 */
 	*user_count = 0;
 	status = (int) call_iterator_next_method(iterator,
-		(void *) iterator->msgs->pdata, MSG_BATCH_SIZE,
+		(void *) iterator->msgs->pdata, iterator->batch_size,
 		user_count);
 	BT_LOGD("User method returned: status=%s, msg-count=%" PRIu64,
 		bt_common_func_status_string(status), *user_count);
@@ -1360,10 +1386,10 @@ bt_message_iterator_next(
 	switch (status) {
 	case BT_FUNC_STATUS_OK:
 		BT_ASSERT_POST_DEV(NEXT_METHOD_NAME, "count-lteq-capacity",
-			*user_count <= MSG_BATCH_SIZE,
+			*user_count <= iterator->batch_size,
 			"Invalid returned message count: greater than "
-			"batch size: count=%" PRIu64 ", batch-size=%u",
-			*user_count, MSG_BATCH_SIZE);
+			"batch size: count=%" PRIu64 ", batch-size=%" PRIu64,
+			*user_count, iterator->batch_size);
 		*msgs = (void *) iterator->msgs->pdata;
 		break;
 	case BT_FUNC_STATUS_AGAIN:
@@ -2031,13 +2057,20 @@ int find_message_ge_ns_from_origin(
 	int status = BT_FUNC_STATUS_OK;
 	enum bt_message_iterator_state init_state =
 		iterator->state;
-	const struct bt_message *messages[MSG_BATCH_SIZE];
+	const struct bt_message **messages;
 	uint64_t user_count = 0;
 	uint64_t i;
 	bool got_first = false;
 
 	BT_ASSERT_DBG(iterator);
-	memset(&messages[0], 0, sizeof(messages[0]) * MSG_BATCH_SIZE);
+	messages = g_new0(const struct bt_message *, iterator->batch_size);
+	if (!messages) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate a message array: "
+			"%![iter-]+i, batch-size=%" PRIu64,
+			iterator, iterator->batch_size);
+		return BT_FUNC_STATUS_MEMORY_ERROR;
+	}
 
 	/*
 	 * Make this iterator temporarily active (not seeking) to call
@@ -2054,7 +2087,7 @@ int find_message_ge_ns_from_origin(
 		 * messages and status.
 		 */
 		status = call_iterator_next_method(iterator,
-			&messages[0], MSG_BATCH_SIZE, &user_count);
+			&messages[0], iterator->batch_size, &user_count);
 		BT_LOGD("User method returned: status=%s",
 			bt_common_func_status_string(status));
 		if (status < 0) {
@@ -2075,10 +2108,10 @@ int find_message_ge_ns_from_origin(
 		case BT_FUNC_STATUS_OK:
 			BT_ASSERT_POST_DEV(NEXT_METHOD_NAME,
 				"count-lteq-capacity",
-				user_count <= MSG_BATCH_SIZE,
+				user_count <= iterator->batch_size,
 				"Invalid returned message count: greater than "
-				"batch size: count=%" PRIu64 ", batch-size=%u",
-				user_count, MSG_BATCH_SIZE);
+				"batch size: count=%" PRIu64 ", batch-size=%" PRIu64,
+				user_count, iterator->batch_size);
 			break;
 		case BT_FUNC_STATUS_AGAIN:
 		case BT_FUNC_STATUS_ERROR:
@@ -2116,6 +2149,7 @@ end:
 		}
 	}
 
+	g_free(messages);
 	set_msg_iterator_state(iterator, init_state);
 	return status;
 }
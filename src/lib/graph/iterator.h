@@ -82,6 +82,15 @@ struct bt_message_iterator {
 	struct bt_graph *graph; /* Weak */
 	struct bt_self_message_iterator_configuration config;
 
+	/*
+	 * Capacity of `msgs`, copied from the message batch size of
+	 * `graph` on creation.
+	 */
+	uint64_t batch_size;
+
+	/* Statistics, if `graph` collects them */
+	struct bt_component_stats stats;
+
 	/*
 	 * Array of
 	 * `struct bt_message_iterator *`
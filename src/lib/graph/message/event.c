@@ -43,6 +43,7 @@ struct bt_message *bt_message_event_new(
 
 	bt_message_init(&message->parent, BT_MESSAGE_TYPE_EVENT,
 		(bt_object_release_func) bt_message_event_recycle, graph);
+	bt_object_init_unique(&message->default_cs_storage.base);
 	goto end;
 
 error:
@@ -170,13 +171,9 @@ struct bt_message *create_event_message(
 
 	if (with_cs) {
 		BT_ASSERT_DBG(stream_class->default_clock_class);
-		message->default_cs = bt_clock_snapshot_create(
-			stream_class->default_clock_class);
-		if (!message->default_cs) {
-			goto error;
-		}
-
-		bt_clock_snapshot_set_raw_value(message->default_cs, raw_value);
+		bt_clock_snapshot_set_embedded(&message->default_cs_storage,
+			stream_class->default_clock_class, raw_value);
+		message->default_cs = &message->default_cs_storage;
 	}
 
 	BT_ASSERT_DBG(!message->event);
@@ -264,7 +261,7 @@ void bt_message_event_destroy(struct bt_message *msg)
 	}
 
 	if (event_msg->default_cs) {
-		bt_clock_snapshot_recycle(event_msg->default_cs);
+		bt_clock_snapshot_reset_embedded(event_msg->default_cs);
 		event_msg->default_cs = NULL;
 	}
 
@@ -291,7 +288,7 @@ void bt_message_event_recycle(struct bt_message *msg)
 	event_msg->event = NULL;
 
 	if (event_msg->default_cs) {
-		bt_clock_snapshot_recycle(event_msg->default_cs);
+		bt_clock_snapshot_reset_embedded(event_msg->default_cs);
 		event_msg->default_cs = NULL;
 	}
 
@@ -11,6 +11,7 @@
 #include "compat/compiler.h"
 #include <babeltrace2/trace-ir/event-class.h>
 #include <babeltrace2/trace-ir/event.h>
+#include "lib/trace-ir/clock-snapshot.h"
 
 #include "message.h"
 
@@ -21,7 +22,15 @@ extern "C" {
 struct bt_message_event {
 	struct bt_message parent;
 	struct bt_event *event;
+
+	/* `&default_cs_storage`, or `NULL` without default clock snapshot */
 	struct bt_clock_snapshot *default_cs;
+
+	/*
+	 * Embedded default clock snapshot, to avoid getting one from
+	 * the pool of the default clock class for each message.
+	 */
+	struct bt_clock_snapshot default_cs_storage;
 };
 
 struct bt_message *bt_message_event_new(struct bt_graph *graph);
@@ -53,3 +53,17 @@ void bt_message_put_ref(const struct bt_message *message)
 {
 	bt_object_put_ref(message);
 }
+
+BT_EXPORT
+void bt_message_put_refs(const struct bt_message * const *messages,
+		uint64_t count)
+{
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV("messages-is-not-null", messages || count == 0,
+		"Message array is NULL: count=%" PRIu64, count);
+
+	for (i = 0; i < count; i++) {
+		bt_object_put_ref(messages[i]);
+	}
+}
@@ -64,6 +64,7 @@ struct bt_message *new_packet_message(struct bt_graph *graph,
 	}
 
 	bt_message_init(&message->parent, type, recycle_func, graph);
+	bt_object_init_unique(&message->default_cs_storage.base);
 	goto end;
 
 error:
@@ -138,15 +139,9 @@ struct bt_message *create_packet_message(
 
 	if (with_cs) {
 		BT_ASSERT(stream_class->default_clock_class);
-		message->default_cs = bt_clock_snapshot_create(
-			stream_class->default_clock_class);
-		if (!message->default_cs) {
-			bt_object_put_ref_no_null_check(message);
-			message = NULL;
-			goto end;
-		}
-
-		bt_clock_snapshot_set_raw_value(message->default_cs, raw_value);
+		bt_clock_snapshot_set_embedded(&message->default_cs_storage,
+			stream_class->default_clock_class, raw_value);
+		message->default_cs = &message->default_cs_storage;
 	}
 
 	BT_ASSERT(!message->packet);
@@ -230,7 +225,7 @@ void bt_message_packet_destroy(struct bt_message *msg)
 	BT_OBJECT_PUT_REF_AND_RESET(packet_msg->packet);
 
 	if (packet_msg->default_cs) {
-		bt_clock_snapshot_recycle(packet_msg->default_cs);
+		bt_clock_snapshot_reset_embedded(packet_msg->default_cs);
 		packet_msg->default_cs = NULL;
 	}
 
@@ -247,7 +242,7 @@ void recycle_packet_message(struct bt_message *msg, struct bt_object_pool *pool)
 	bt_object_put_ref_no_null_check(&packet_msg->packet->base);
 
 	if (packet_msg->default_cs) {
-		bt_clock_snapshot_recycle(packet_msg->default_cs);
+		bt_clock_snapshot_reset_embedded(packet_msg->default_cs);
 		packet_msg->default_cs = NULL;
 	}
 
@@ -17,7 +17,15 @@
 struct bt_message_packet {
 	struct bt_message parent;
 	struct bt_packet *packet;
+
+	/* `&default_cs_storage`, or `NULL` without default clock snapshot */
 	struct bt_clock_snapshot *default_cs;
+
+	/*
+	 * Embedded default clock snapshot, to avoid getting one from
+	 * the pool of the default clock class for each message.
+	 */
+	struct bt_clock_snapshot default_cs_storage;
 };
 
 void bt_message_packet_destroy(struct bt_message *msg);
@@ -11,7 +11,7 @@
 #include "lib/assert-cond.h"
 #include <babeltrace2/graph/query-executor.h>
 #include <babeltrace2/graph/component-class.h>
-#include <babeltrace2/graph/query-executor.h>
+#include <babeltrace2/graph/private-query-executor.h>
 #include <babeltrace2/value.h>
 #include "lib/object.h"
 #include "compat/compiler.h"
@@ -21,6 +21,170 @@
 #include "interrupter.h"
 #include "lib/func-status.h"
 
+/* Maximum number of stashed states of a component class */
+#define QUERY_STASH_MAX_ENTRY_COUNT	4
+
+struct bt_query_stash_entry {
+	/* Owned by this */
+	struct bt_value *key;
+
+	/* `NULL` once a component takes it */
+	void *data;
+
+	bt_private_query_executor_stash_destroy_func destroy_func;
+};
+
+static
+void destroy_query_stash_entry(struct bt_query_stash_entry *entry)
+{
+	if (entry->data) {
+		BT_LOGD("Destroying stashed query state: data-addr=%p",
+			entry->data);
+		entry->destroy_func(entry->data);
+	}
+
+	BT_OBJECT_PUT_REF_AND_RESET(entry->key);
+	g_free(entry);
+}
+
+/*
+ * Returns the index of the stashed state of `comp_cls` having a key
+ * equal to `key`, or -1 if there's none.
+ */
+static
+gint find_query_stash_entry(const struct bt_component_class *comp_cls,
+		const struct bt_value *key)
+{
+	guint i;
+
+	if (!comp_cls->query_stash) {
+		goto not_found;
+	}
+
+	for (i = 0; i < comp_cls->query_stash->len; i++) {
+		const struct bt_query_stash_entry *entry =
+			g_ptr_array_index(comp_cls->query_stash, i);
+
+		if (bt_value_is_equal(entry->key, key)) {
+			return (gint) i;
+		}
+	}
+
+not_found:
+	return -1;
+}
+
+BT_EXPORT
+enum bt_private_query_executor_stash_status bt_private_query_executor_stash(
+		struct bt_private_query_executor *priv_query_exec,
+		const struct bt_value *key, void *data,
+		bt_private_query_executor_stash_destroy_func destroy_func)
+{
+	struct bt_query_executor *query_exec = (void *) priv_query_exec;
+	struct bt_component_class *comp_cls;
+	struct bt_query_stash_entry *entry = NULL;
+	enum bt_private_query_executor_stash_status status;
+	gint index;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_QUERY_EXEC_NON_NULL(query_exec);
+	BT_ASSERT_PRE_NON_NULL("key", key, "Key");
+	BT_ASSERT_PRE_NON_NULL("data", data, "Data");
+	BT_ASSERT_PRE_NON_NULL("destroy-function", destroy_func,
+		"Destroy function");
+	comp_cls = (void *) query_exec->comp_cls;
+
+	if (!comp_cls->query_stash) {
+		comp_cls->query_stash = g_ptr_array_new_with_free_func(
+			(GDestroyNotify) destroy_query_stash_entry);
+		if (!comp_cls->query_stash) {
+			BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate one GPtrArray.");
+			goto memory_error;
+		}
+	}
+
+	entry = g_new0(struct bt_query_stash_entry, 1);
+	if (!entry) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate one query stash entry.");
+		goto memory_error;
+	}
+
+	if (bt_value_copy(key, &entry->key) != BT_VALUE_COPY_STATUS_OK) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to copy value: %!+v", key);
+		goto memory_error;
+	}
+
+	/* Replace any state having the same key */
+	index = find_query_stash_entry(comp_cls, key);
+	if (index >= 0) {
+		g_ptr_array_remove_index(comp_cls->query_stash, (guint) index);
+	}
+
+	/* Make room, evicting the oldest state */
+	if (comp_cls->query_stash->len == QUERY_STASH_MAX_ENTRY_COUNT) {
+		BT_LIB_LOGD("Evicting oldest stashed query state: %!+C",
+			comp_cls);
+		g_ptr_array_remove_index(comp_cls->query_stash, 0);
+	}
+
+	entry->data = data;
+	entry->destroy_func = destroy_func;
+	g_ptr_array_add(comp_cls->query_stash, entry);
+	BT_LIB_LOGD("Stashed query state: %![comp-cls-]+C, %![key-]+v, "
+		"data-addr=%p", comp_cls, key, data);
+	status = BT_FUNC_STATUS_OK;
+	goto end;
+
+memory_error:
+	if (entry) {
+		BT_OBJECT_PUT_REF_AND_RESET(entry->key);
+		g_free(entry);
+	}
+
+	status = BT_FUNC_STATUS_MEMORY_ERROR;
+
+end:
+	return status;
+}
+
+void *bt_component_class_take_query_stash(struct bt_component_class *comp_cls,
+		const struct bt_value *key)
+{
+	struct bt_query_stash_entry *entry;
+	void *data = NULL;
+	gint index;
+
+	BT_ASSERT(comp_cls);
+	BT_ASSERT(key);
+	index = find_query_stash_entry(comp_cls, key);
+	if (index < 0) {
+		goto end;
+	}
+
+	/* Transfer the ownership of the state to the caller */
+	entry = g_ptr_array_index(comp_cls->query_stash, (guint) index);
+	data = entry->data;
+	entry->data = NULL;
+	g_ptr_array_remove_index(comp_cls->query_stash, (guint) index);
+	BT_LIB_LOGD("Took stashed query state: %![comp-cls-]+C, "
+		"%![key-]+v, data-addr=%p", comp_cls, key, data);
+
+end:
+	return data;
+}
+
+void bt_component_class_destroy_query_stash(
+		struct bt_component_class *comp_cls)
+{
+	BT_ASSERT(comp_cls);
+
+	if (comp_cls->query_stash) {
+		g_ptr_array_free(comp_cls->query_stash, TRUE);
+		comp_cls->query_stash = NULL;
+	}
+}
+
 static
 void bt_query_executor_destroy(struct bt_object *obj)
 {
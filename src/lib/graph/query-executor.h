@@ -44,4 +44,15 @@ struct bt_query_executor {
 	enum bt_logging_level log_level;
 };
 
+/*
+ * Removes the state stashed with a key equal to `key` from `comp_cls`
+ * and returns it, or returns `NULL` if there's none.
+ */
+void *bt_component_class_take_query_stash(struct bt_component_class *comp_cls,
+		const struct bt_value *key);
+
+/* Destroys all the stashed states of `comp_cls` */
+void bt_component_class_destroy_query_stash(
+		struct bt_component_class *comp_cls);
+
 #endif /* BABELTRACE_LIB_GRAPH_QUERY_EXECUTOR_H */
@@ -131,6 +131,10 @@ static inline void format_object_pool(char **buf_ch, const char *prefix,
 	if (pool->objects) {
 		BUF_APPEND(", %scap=%u", PRFIELD(pool->objects->len));
 	}
+
+	if (pool->max_size != SIZE_MAX) {
+		BUF_APPEND(", %smax-size=%zu", PRFIELD(pool->max_size));
+	}
 }
 
 static inline void format_integer_field_class(char **buf_ch, const char *prefix,
@@ -175,6 +179,8 @@ static inline void format_field_class(char **buf_ch, bool extended,
 		BUF_APPEND(", %sis-frozen=%d", PRFIELD(field_class->frozen));
 		BUF_APPEND(", %sis-part-of-trace-class=%d",
 			PRFIELD(field_class->part_of_trace_class));
+		BUF_APPEND(", %sis-scope-root=%d",
+			PRFIELD(field_class->is_scope_root));
 	} else {
 		return;
 	}
@@ -469,9 +475,8 @@ static inline void format_field(char **buf_ch, bool extended,
 		const struct bt_field_string *str = (const void *) field;
 
 		if (str->buf) {
-			BT_ASSERT(str->buf->data);
 			BUF_APPEND(", %spartial-value=\"%.32s\"",
-				PRFIELD(str->buf->data));
+				PRFIELD(str->buf));
 		}
 
 		break;
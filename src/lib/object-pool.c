@@ -33,6 +33,7 @@ int bt_object_pool_initialize(struct bt_object_pool *pool,
 	pool->funcs.destroy_object = destroy_object_func;
 	pool->data = data;
 	pool->size = 0;
+	pool->max_size = SIZE_MAX;
 	BT_LIB_LOGD("Initialized object pool: %!+o", pool);
 	goto end;
 
@@ -44,6 +45,57 @@ end:
 	return ret;
 }
 
+void bt_object_pool_set_max_size(struct bt_object_pool *pool,
+		size_t max_size)
+{
+	BT_ASSERT(pool);
+	BT_LIB_LOGD("Setting object pool's maximum size: %!+o, "
+		"max-size=%zu", pool, max_size);
+
+	while (pool->size > max_size) {
+		pool->size--;
+		pool->funcs.destroy_object(pool->objects->pdata[pool->size],
+			pool->data);
+		pool->objects->pdata[pool->size] = NULL;
+	}
+
+	pool->max_size = max_size;
+}
+
+int bt_object_pool_preallocate(struct bt_object_pool *pool, size_t count)
+{
+	int ret = 0;
+
+	BT_ASSERT(pool);
+	BT_LIB_LOGD("Preallocating objects of object pool: %!+o, count=%zu",
+		pool, count);
+
+	if (count > pool->max_size) {
+		count = pool->max_size;
+	}
+
+	if (count > pool->objects->len) {
+		g_ptr_array_set_size(pool->objects, count);
+	}
+
+	while (pool->size < count) {
+		struct bt_object *obj = pool->funcs.new_object(pool->data);
+
+		if (!obj) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate one object: %!+o", pool);
+			ret = -1;
+			goto end;
+		}
+
+		pool->objects->pdata[pool->size] = obj;
+		pool->size++;
+	}
+
+end:
+	return ret;
+}
+
 void bt_object_pool_finalize(struct bt_object_pool *pool)
 {
 	uint64_t i;
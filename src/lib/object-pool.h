@@ -56,6 +56,15 @@ struct bt_object_pool {
 	 */
 	size_t size;
 
+	/*
+	 * Maximum size of the pool: bt_object_pool_recycle_object()
+	 * destroys an object instead of recycling it when the pool
+	 * already contains that many objects.
+	 *
+	 * `SIZE_MAX` by default (no limit).
+	 */
+	size_t max_size;
+
 	/* User functions */
 	struct {
 		/* Allocate a new object in memory */
@@ -77,6 +86,27 @@ int bt_object_pool_initialize(struct bt_object_pool *pool,
 		bt_object_pool_destroy_object_func destroy_object_func,
 		void *data);
 
+/*
+ * Sets the maximum size of an object pool to `max_size`, destroying
+ * recycled objects in excess.
+ *
+ * With a maximum size, the pool calls the "destroy" user function
+ * while its owner is still alive: this function must then also remove
+ * any weak reference which the owner keeps to the object.
+ */
+void bt_object_pool_set_max_size(struct bt_object_pool *pool,
+		size_t max_size);
+
+/*
+ * Makes sure an object pool contains at least `count` recycled objects
+ * (limited to its maximum size), calling the "new" user function as
+ * needed, so that the next `count` calls to
+ * bt_object_pool_create_object() don't allocate.
+ *
+ * Returns 0 on success, or -1 on memory error.
+ */
+int bt_object_pool_preallocate(struct bt_object_pool *pool, size_t count);
+
 /*
  * Finalizes an object pool without deallocating it.
  */
@@ -133,6 +163,15 @@ void bt_object_pool_recycle_object(struct bt_object_pool *pool, void *obj)
 	BT_LOGT("Recycling object: pool-addr=%p, pool-size=%zu, pool-cap=%u, obj-addr=%p",
 		pool, pool->size, pool->objects->len, obj);
 
+	if (G_UNLIKELY(pool->size == pool->max_size)) {
+		/* Pool is at its maximum size: destroy object */
+		BT_LOGT("Object pool is at its maximum size: destroying object: "
+			"pool-addr=%p, pool-max-size=%zu, obj-addr=%p",
+			pool, pool->max_size, obj);
+		pool->funcs.destroy_object(obj, pool->data);
+		return;
+	}
+
 	if (pool->size == pool->objects->len) {
 		/* Backing array is full: make place for recycled object */
 		BT_LOGD("Object pool is full: increasing object pool capacity: "
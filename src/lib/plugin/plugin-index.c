@@ -0,0 +1,304 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#define BT_LOG_TAG "LIB/PLUGIN-INDEX"
+#include "lib/logging.h"
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "compat/compiler.h"
+#include <glib.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "plugin.h"
+#include "plugin-index.h"
+
+/* Increment when the format of the entries changes */
+#define PLUGIN_INDEX_FILENAME		"plugin-index-1"
+
+#define PLUGIN_INDEX_KEY_MTIME		"mtime"
+#define PLUGIN_INDEX_KEY_SIZE		"size"
+#define PLUGIN_INDEX_KEY_PLUGIN_COUNT	"plugin-count"
+#define PLUGIN_INDEX_KEY_PLUGINS	"plugins"
+
+static struct {
+	pthread_mutex_t lock;
+
+	/* True if the plugin index file was loaded (or tried to) */
+	bool loaded;
+
+	/* True if `key_file` changed since it was loaded or written */
+	bool dirty;
+
+	/* Path of the plugin index file (owned by this), or `NULL` if disabled */
+	gchar *path;
+
+	/*
+	 * One group per plugin file (the group name is the file path),
+	 * or `NULL` if disabled (owned by this)
+	 */
+	GKeyFile *key_file;
+} plugin_index = {
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/*
+ * Loads the plugin index file if not already done.
+ *
+ * `plugin_index.lock` must be held.
+ */
+static
+void load_plugin_index(void)
+{
+	const char *envvar;
+	GError *error = NULL;
+
+	if (plugin_index.loaded) {
+		goto end;
+	}
+
+	plugin_index.loaded = true;
+	envvar = getenv("LIBBABELTRACE2_DISABLE_PLUGIN_INDEX");
+
+	if (envvar && strcmp(envvar, "1") == 0) {
+		BT_LOGI_STR("Plugin index is disabled by the "
+			"`LIBBABELTRACE2_DISABLE_PLUGIN_INDEX` environment variable.");
+		goto end;
+	}
+
+	if (bt_common_is_setuid_setgid()) {
+		BT_LOGI_STR("Plugin index is disabled for a setuid/setgid process.");
+		goto end;
+	}
+
+	plugin_index.path = g_build_filename(g_get_user_cache_dir(),
+		"babeltrace2", PLUGIN_INDEX_FILENAME, NULL);
+	plugin_index.key_file = g_key_file_new();
+
+	if (!g_key_file_load_from_file(plugin_index.key_file,
+			plugin_index.path, G_KEY_FILE_NONE, &error)) {
+		/* Not an error: the index is only a cache */
+		BT_LOGI("Cannot load plugin index file: starting with an empty index: "
+			"path=\"%s\", %s", plugin_index.path, error->message);
+		g_clear_error(&error);
+		g_key_file_free(plugin_index.key_file);
+		plugin_index.key_file = g_key_file_new();
+		goto end;
+	}
+
+	BT_LOGI("Loaded plugin index file: path=\"%s\"", plugin_index.path);
+
+end:
+	return;
+}
+
+/*
+ * A key file group name cannot contain `[`, `]`, or control
+ * characters: such plugin file paths are never indexed.
+ */
+static
+bool path_is_indexable(const char *path)
+{
+	const char *ch;
+
+	for (ch = path; *ch; ch++) {
+		if (*ch == '[' || *ch == ']' || g_ascii_iscntrl(*ch)) {
+			return false;
+		}
+	}
+
+	return *path != '\0';
+}
+
+__attribute__((destructor)) static
+void fini_plugin_index(void)
+{
+	if (plugin_index.key_file) {
+		g_key_file_free(plugin_index.key_file);
+		plugin_index.key_file = NULL;
+	}
+
+	g_free(plugin_index.path);
+	plugin_index.path = NULL;
+}
+
+bool bt_plugin_index_lookup(const char *path, const struct stat *sb,
+		const char *plugin_name, bool *provides_plugin)
+{
+	bool found = false;
+	GError *error = NULL;
+	gchar **names = NULL;
+	gint64 mtime;
+	guint64 size;
+	gint plugin_count;
+
+	BT_ASSERT(path);
+	BT_ASSERT(sb);
+	BT_ASSERT(provides_plugin);
+	pthread_mutex_lock(&plugin_index.lock);
+	load_plugin_index();
+
+	if (!plugin_index.key_file || !path_is_indexable(path) ||
+			!g_key_file_has_group(plugin_index.key_file, path)) {
+		goto end;
+	}
+
+	mtime = g_key_file_get_int64(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_MTIME, &error);
+	if (error) {
+		goto end;
+	}
+
+	size = g_key_file_get_uint64(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_SIZE, &error);
+	if (error) {
+		goto end;
+	}
+
+	if (mtime != (gint64) sb->st_mtime || size != (guint64) sb->st_size) {
+		BT_LOGD("Plugin index entry is outdated: path=\"%s\"", path);
+		goto end;
+	}
+
+	plugin_count = g_key_file_get_integer(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_PLUGIN_COUNT, &error);
+	if (error) {
+		goto end;
+	}
+
+	if (plugin_count == 0) {
+		*provides_plugin = false;
+		found = true;
+		goto end;
+	}
+
+	if (!plugin_name) {
+		*provides_plugin = true;
+		found = true;
+		goto end;
+	}
+
+	names = g_key_file_get_string_list(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_PLUGINS, NULL, &error);
+	if (error) {
+		goto end;
+	}
+
+	*provides_plugin = false;
+	found = true;
+
+	for (gchar **name = names; *name; name++) {
+		if (strcmp(*name, plugin_name) == 0) {
+			*provides_plugin = true;
+			break;
+		}
+	}
+
+end:
+	pthread_mutex_unlock(&plugin_index.lock);
+	g_clear_error(&error);
+	g_strfreev(names);
+
+	if (found) {
+		BT_LOGD("Found up-to-date plugin index entry: path=\"%s\", "
+			"plugin-name=\"%s\", provides-plugin=%d", path,
+			plugin_name ? plugin_name : "(any)", *provides_plugin);
+	}
+
+	return found;
+}
+
+void bt_plugin_index_update(const char *path, const struct stat *sb,
+		const struct bt_plugin_set *plugin_set)
+{
+	const gchar **names = NULL;
+	guint plugin_count = plugin_set ? plugin_set->plugins->len : 0;
+	guint i;
+
+	BT_ASSERT(path);
+	BT_ASSERT(sb);
+	pthread_mutex_lock(&plugin_index.lock);
+	load_plugin_index();
+
+	if (!plugin_index.key_file || !path_is_indexable(path)) {
+		goto end;
+	}
+
+	BT_LOGD("Updating plugin index entry: path=\"%s\", plugin-count=%u",
+		path, plugin_count);
+	g_key_file_remove_group(plugin_index.key_file, path, NULL);
+	g_key_file_set_int64(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_MTIME, (gint64) sb->st_mtime);
+	g_key_file_set_uint64(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_SIZE, (guint64) sb->st_size);
+	g_key_file_set_integer(plugin_index.key_file, path,
+		PLUGIN_INDEX_KEY_PLUGIN_COUNT, (gint) plugin_count);
+
+	if (plugin_count > 0) {
+		names = g_new(const gchar *, plugin_count);
+
+		for (i = 0; i < plugin_count; i++) {
+			const struct bt_plugin *plugin =
+				plugin_set->plugins->pdata[i];
+
+			names[i] = plugin->info.name->str;
+		}
+
+		g_key_file_set_string_list(plugin_index.key_file, path,
+			PLUGIN_INDEX_KEY_PLUGINS, names, plugin_count);
+	}
+
+	plugin_index.dirty = true;
+
+end:
+	pthread_mutex_unlock(&plugin_index.lock);
+	g_free(names);
+}
+
+void bt_plugin_index_save(void)
+{
+	gchar *data = NULL;
+	gchar *dir = NULL;
+	gsize data_len;
+	GError *error = NULL;
+
+	pthread_mutex_lock(&plugin_index.lock);
+
+	if (!plugin_index.key_file || !plugin_index.dirty) {
+		goto end;
+	}
+
+	/* Not an error if this fails: the index is only a cache */
+	plugin_index.dirty = false;
+	data = g_key_file_to_data(plugin_index.key_file, &data_len, NULL);
+	dir = g_path_get_dirname(plugin_index.path);
+
+	if (g_mkdir_with_parents(dir, 0755) != 0) {
+		BT_LOGW_ERRNO("Cannot create plugin index directory", ": path=\"%s\"",
+			dir);
+		goto end;
+	}
+
+	/* g_file_set_contents() replaces the file atomically */
+	if (!g_file_set_contents(plugin_index.path, data, data_len, &error)) {
+		BT_LOGW("Cannot write plugin index file: path=\"%s\", %s",
+			plugin_index.path, error->message);
+		g_clear_error(&error);
+		goto end;
+	}
+
+	BT_LOGI("Wrote plugin index file: path=\"%s\"", plugin_index.path);
+
+end:
+	pthread_mutex_unlock(&plugin_index.lock);
+	g_free(data);
+	g_free(dir);
+}
@@ -0,0 +1,58 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_LIB_PLUGIN_PLUGIN_INDEX_H
+#define BABELTRACE_LIB_PLUGIN_PLUGIN_INDEX_H
+
+#include <stdbool.h>
+#include <sys/stat.h>
+
+struct bt_plugin_set;
+
+/*
+ * The plugin index is a persistent cache, in the user cache directory,
+ * which records, for each plugin file path, the modification time and
+ * size of the file as well as the names of the plugins it provides.
+ *
+ * This makes it possible to skip loading the files which, according to
+ * an up-to-date entry, don't provide any plugin, or don't provide the
+ * plugin to find by name (see bt_plugin_find()).
+ *
+ * The `LIBBABELTRACE2_DISABLE_PLUGIN_INDEX` environment variable
+ * disables the plugin index when set to `1`.
+ *
+ * All the functions below are thread-safe.
+ */
+
+/*
+ * Looks up the up-to-date entry of the file at `path`, of which the
+ * status is `sb`.
+ *
+ * If such an entry exists, sets `*provides_plugin` to whether or not
+ * the file provides a plugin named `plugin_name` or, if `plugin_name`
+ * is `NULL`, any plugin, and returns true.
+ *
+ * Returns false if the plugin index has no up-to-date entry for this
+ * file or if it's disabled.
+ */
+bool bt_plugin_index_lookup(const char *path, const struct stat *sb,
+		const char *plugin_name, bool *provides_plugin);
+
+/*
+ * Records that the file at `path`, of which the status is `sb`,
+ * provides the plugins of `plugin_set`, or no plugin if `plugin_set` is
+ * `NULL`.
+ */
+void bt_plugin_index_update(const char *path, const struct stat *sb,
+		const struct bt_plugin_set *plugin_set);
+
+/*
+ * Writes the plugin index to its file if it changed since it was
+ * loaded or last written.
+ */
+void bt_plugin_index_save(void);
+
+#endif /* BABELTRACE_LIB_PLUGIN_PLUGIN_INDEX_H */
@@ -1416,7 +1416,8 @@ end:
 }
 
 int bt_plugin_so_create_all_from_file(const char *path,
-		bool fail_on_load_error, struct bt_plugin_set **plugin_set_out)
+		bool fail_on_load_error, struct bt_plugin_set **plugin_set_out,
+		bool *not_plugin)
 {
 	size_t path_len;
 	int status;
@@ -1441,7 +1442,9 @@ int bt_plugin_so_create_all_from_file(const char *path,
 
 	BT_ASSERT(path);
 	BT_ASSERT(plugin_set_out);
+	BT_ASSERT(not_plugin);
 	*plugin_set_out = NULL;
+	*not_plugin = false;
 	path_len = strlen(path);
 
 	/*
@@ -1497,6 +1500,7 @@ int bt_plugin_so_create_all_from_file(const char *path,
 		BT_LOGI("Cannot resolve plugin symbol: path=\"%s\", "
 			"symbol=\"%s\"", path,
 			"__bt_get_begin_section_plugin_descriptors");
+		*not_plugin = true;
 		status = BT_FUNC_STATUS_NOT_FOUND;
 		goto end;
 	}
@@ -36,8 +36,15 @@ struct bt_plugin_so_spec_data {
 	const struct __bt_plugin_descriptor_version *version;
 };
 
+/*
+ * Sets `*not_plugin` to true if this function returns
+ * `BT_FUNC_STATUS_NOT_FOUND` because `path` is a shared object which
+ * isn't a Babeltrace plugin, as opposed to a file which isn't a shared
+ * object or a plugin which fails to load.
+ */
 int bt_plugin_so_create_all_from_file(const char *path,
-		bool fail_on_load_error, struct bt_plugin_set **plugin_set_out);
+		bool fail_on_load_error, struct bt_plugin_set **plugin_set_out,
+		bool *not_plugin);
 
 int bt_plugin_so_create_all_from_static(bool fail_on_load_error,
 		struct bt_plugin_set **plugin_set_out);
@@ -29,6 +29,7 @@
 #include <pthread.h>
 
 #include "plugin.h"
+#include "plugin-index.h"
 #include "plugin-so.h"
 #include "lib/func-status.h"
 
@@ -180,21 +181,22 @@ enum bt_plugin_find_all_from_static_status bt_plugin_find_all_from_static(
 		(void *) plugin_set_out);
 }
 
-BT_EXPORT
-enum bt_plugin_find_all_from_file_status bt_plugin_find_all_from_file(
-		const char *path, bt_bool fail_on_load_error,
-		const struct bt_plugin_set **plugin_set_out)
+/*
+ * Sets `*not_plugin` to true if this function returns
+ * `BT_FUNC_STATUS_NOT_FOUND` because `path` is a shared object which
+ * isn't a Babeltrace plugin (see bt_plugin_so_create_all_from_file()).
+ */
+static
+int create_all_from_file(const char *path, bool fail_on_load_error,
+		const struct bt_plugin_set **plugin_set_out, bool *not_plugin)
 {
-	enum bt_plugin_find_all_from_file_status status;
+	int status;
 
-	BT_ASSERT_PRE_NO_ERROR();
-	BT_ASSERT_PRE_NON_NULL("path", path, "Path");
-	BT_ASSERT_PRE_PLUGIN_SET_OUT_NON_NULL(plugin_set_out);
 	BT_LOGI("Creating plugins from file: path=\"%s\"", path);
 
 	/* Try shared object plugins */
 	status = bt_plugin_so_create_all_from_file(path, fail_on_load_error,
-		(void *) plugin_set_out);
+		(void *) plugin_set_out, not_plugin);
 	if (status == BT_FUNC_STATUS_OK) {
 		BT_ASSERT(*plugin_set_out);
 		BT_ASSERT((*plugin_set_out)->plugins->len > 0);
@@ -253,44 +255,87 @@ end:
 	return status;
 }
 
+BT_EXPORT
+enum bt_plugin_find_all_from_file_status bt_plugin_find_all_from_file(
+		const char *path, bt_bool fail_on_load_error,
+		const struct bt_plugin_set **plugin_set_out)
+{
+	bool not_plugin;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_NON_NULL("path", path, "Path");
+	BT_ASSERT_PRE_PLUGIN_SET_OUT_NON_NULL(plugin_set_out);
+	return create_all_from_file(path, fail_on_load_error, plugin_set_out,
+		&not_plugin);
+}
+
+/*
+ * Creates the plugins of the file at `path`, of which the status is
+ * `sb`, and updates its plugin index entry accordingly.
+ *
+ * If the up-to-date plugin index entry of this file indicates that it
+ * doesn't provide any plugin named `plugin_name` (or any plugin at all
+ * if `plugin_name` is `NULL`), returns `BT_FUNC_STATUS_NOT_FOUND`
+ * without loading the file.
+ */
+static
+int create_all_from_indexed_file(const char *path, const struct stat *sb,
+		const char *plugin_name, bool fail_on_load_error,
+		const struct bt_plugin_set **plugin_set_out)
+{
+	int status;
+	bool provides_plugin;
+	bool not_plugin;
+
+	if (bt_plugin_index_lookup(path, sb, plugin_name, &provides_plugin) &&
+			!provides_plugin) {
+		BT_LOGI("Skipping file which, according to the plugin index, "
+			"doesn't provide the plugin: path=\"%s\", name=\"%s\"",
+			path, plugin_name ? plugin_name : "(any)");
+		status = BT_FUNC_STATUS_NOT_FOUND;
+		goto end;
+	}
+
+	status = create_all_from_file(path, fail_on_load_error,
+		plugin_set_out, &not_plugin);
+	if (status == BT_FUNC_STATUS_OK) {
+		bt_plugin_index_update(path, sb, *plugin_set_out);
+	} else if (status == BT_FUNC_STATUS_NOT_FOUND && not_plugin) {
+		/*
+		 * Only index a shared object which isn't a plugin: any
+		 * other file could fail to provide plugins for a
+		 * transient reason (a Python plugin file with the
+		 * Python plugin provider unavailable, for example).
+		 */
+		bt_plugin_index_update(path, sb, NULL);
+	}
+
+end:
+	return status;
+}
+
 static
 void destroy_gstring(void *data)
 {
 	g_string_free(data, TRUE);
 }
 
-BT_EXPORT
-enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
-		bt_bool find_in_user_dir, bt_bool find_in_sys_dir,
-		bt_bool find_in_static, bt_bool fail_on_load_error,
-		const struct bt_plugin_set **plugin_set_out)
+/*
+ * Returns a new array of the standard plugin directories (`GString *`
+ * elements), in search order, or `NULL` on memory error.
+ */
+static
+GPtrArray *create_std_plugin_dirs(bool find_in_std_env_var,
+		bool find_in_user_dir, bool find_in_sys_dir)
 {
 	char *home_plugin_dir = NULL;
-	const struct bt_plugin_set *plugin_set = NULL;
-	GPtrArray *dirs = NULL;
+	GPtrArray *dirs;
 	int ret;
-	int status = BT_FUNC_STATUS_OK;
-	uint64_t dir_i, plugin_i;
 
-	BT_ASSERT_PRE_NO_ERROR();
-	BT_ASSERT_PRE_PLUGIN_SET_OUT_NON_NULL(plugin_set_out);
-	BT_LOGI("Finding all plugins in standard directories and built-in plugins: "
-		"find-in-std-env-var=%d, find-in-user-dir=%d, "
-		"find-in-sys-dir=%d, find-in-static=%d",
-		find_in_std_env_var, find_in_user_dir, find_in_sys_dir,
-		find_in_static);
 	dirs = g_ptr_array_new_with_free_func((GDestroyNotify) destroy_gstring);
 	if (!dirs) {
 		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GPtrArray.");
-		status = BT_FUNC_STATUS_MEMORY_ERROR;
-		goto end;
-	}
-
-	*plugin_set_out = bt_plugin_set_create();
-	if (!*plugin_set_out) {
-		BT_LIB_LOGE_APPEND_CAUSE("Cannot create empty plugin set.");
-		status = BT_FUNC_STATUS_MEMORY_ERROR;
-		goto end;
+		goto error;
 	}
 
 	/*
@@ -314,8 +359,7 @@ enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
 			if (ret) {
 				BT_LIB_LOGE_APPEND_CAUSE(
 					"Failed to append plugin path to array of directories.");
-				status = BT_FUNC_STATUS_MEMORY_ERROR;
-				goto end;
+				goto error;
 			}
 		}
 	}
@@ -329,8 +373,7 @@ enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
 
 			if (!home_plugin_dir_str) {
 				BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GString.");
-				status = BT_FUNC_STATUS_MEMORY_ERROR;
-				goto end;
+				goto error;
 			}
 
 			g_ptr_array_add(dirs, home_plugin_dir_str);
@@ -347,14 +390,59 @@ enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
 
 			if (!system_plugin_dir_str) {
 				BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GString.");
-				status = BT_FUNC_STATUS_MEMORY_ERROR;
-				goto end;
+				goto error;
 			}
 
 			g_ptr_array_add(dirs, system_plugin_dir_str);
 		}
 	}
 
+	goto end;
+
+error:
+	if (dirs) {
+		g_ptr_array_free(dirs, TRUE);
+		dirs = NULL;
+	}
+
+end:
+	free(home_plugin_dir);
+	return dirs;
+}
+
+BT_EXPORT
+enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
+		bt_bool find_in_user_dir, bt_bool find_in_sys_dir,
+		bt_bool find_in_static, bt_bool fail_on_load_error,
+		const struct bt_plugin_set **plugin_set_out)
+{
+	const struct bt_plugin_set *plugin_set = NULL;
+	GPtrArray *dirs = NULL;
+	int status = BT_FUNC_STATUS_OK;
+	uint64_t dir_i, plugin_i;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_PLUGIN_SET_OUT_NON_NULL(plugin_set_out);
+	BT_LOGI("Finding all plugins in standard directories and built-in plugins: "
+		"find-in-std-env-var=%d, find-in-user-dir=%d, "
+		"find-in-sys-dir=%d, find-in-static=%d",
+		find_in_std_env_var, find_in_user_dir, find_in_sys_dir,
+		find_in_static);
+	*plugin_set_out = bt_plugin_set_create();
+	if (!*plugin_set_out) {
+		BT_LIB_LOGE_APPEND_CAUSE("Cannot create empty plugin set.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
+	dirs = create_std_plugin_dirs(find_in_std_env_var, find_in_user_dir,
+		find_in_sys_dir);
+	if (!dirs) {
+		/* create_std_plugin_dirs() logs errors */
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
+
 	for (dir_i = 0; dir_i < dirs->len; dir_i++) {
 		GString *dir = dirs->pdata[dir_i];
 
@@ -421,7 +509,6 @@ enum bt_plugin_find_all_status bt_plugin_find_all(bt_bool find_in_std_env_var,
 	}
 
 end:
-	free(home_plugin_dir);
 	bt_object_put_ref(plugin_set);
 
 	if (dirs) {
@@ -453,9 +540,11 @@ enum bt_plugin_find_status bt_plugin_find(const char *plugin_name,
 		bt_bool find_in_sys_dir, bt_bool find_in_static,
 		bt_bool fail_on_load_error, const struct bt_plugin **plugin_out)
 {
-	enum bt_plugin_find_status status;
+	int status = BT_FUNC_STATUS_NOT_FOUND;
 	const struct bt_plugin_set *plugin_set = NULL;
-	uint64_t i;
+	GPtrArray *dirs = NULL;
+	GString *path = NULL;
+	uint64_t dir_i;
 
 	BT_ASSERT_PRE_NO_ERROR();
 	BT_ASSERT_PRE_NAME_NON_NULL(plugin_name);
@@ -465,29 +554,127 @@ enum bt_plugin_find_status bt_plugin_find(const char *plugin_name,
 		"find-in-sys-dir=%d, find-in-static=%d",
 		plugin_name, find_in_std_env_var, find_in_user_dir,
 		find_in_sys_dir, find_in_static);
-	status = (enum bt_plugin_find_status) bt_plugin_find_all(find_in_std_env_var, find_in_user_dir,
-		find_in_sys_dir, find_in_static, fail_on_load_error,
-		&plugin_set);
-	if (status != BT_FUNC_STATUS_OK) {
-		BT_ASSERT(!plugin_set);
+	dirs = create_std_plugin_dirs(find_in_std_env_var, find_in_user_dir,
+		find_in_sys_dir);
+	if (!dirs) {
+		/* create_std_plugin_dirs() logs errors */
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
 		goto end;
 	}
 
-	BT_ASSERT(plugin_set);
+	path = g_string_new(NULL);
+	if (!path) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GString.");
+		status = BT_FUNC_STATUS_MEMORY_ERROR;
+		goto end;
+	}
 
-	for (i = 0; i < plugin_set->plugins->len; i++) {
-		const struct bt_plugin *plugin = plugin_set->plugins->pdata[i];
+	/*
+	 * Same search order as bt_plugin_find_all(), but only load the
+	 * files which, according to the plugin index, may provide the
+	 * plugin, stopping at the first match.
+	 */
+	for (dir_i = 0; dir_i < dirs->len; dir_i++) {
+		GString *dir_path = dirs->pdata[dir_i];
+		GDir *dir;
+		const char *name;
+
+		dir = g_dir_open(dir_path->str, 0, NULL);
+		if (!dir) {
+			BT_LOGI("Skipping nonexistent or unreadable directory: "
+				"path=\"%s\"", dir_path->str);
+			continue;
+		}
 
-		if (strcmp(plugin->info.name->str, plugin_name) == 0) {
-			*plugin_out = plugin;
-			bt_object_get_ref_no_null_check(*plugin_out);
+		while ((name = g_dir_read_name(dir))) {
+			struct stat sb;
+			uint64_t i;
+
+			if (name[0] == '.') {
+				/* Skip hidden files */
+				continue;
+			}
+
+			g_string_printf(path, "%s" G_DIR_SEPARATOR_S "%s",
+				dir_path->str, name);
+
+			/*
+			 * Like bt_plugin_find_all_from_dir(), don't
+			 * follow symbolic links.
+			 */
+			if (lstat(path->str, &sb) || !S_ISREG(sb.st_mode)) {
+				continue;
+			}
+
+			BT_OBJECT_PUT_REF_AND_RESET(plugin_set);
+			status = create_all_from_indexed_file(path->str, &sb,
+				plugin_name, fail_on_load_error, &plugin_set);
+			if (status < 0) {
+				/* create_all_from_file() logs errors */
+				BT_ASSERT(!plugin_set);
+				g_dir_close(dir);
+				goto end;
+			} else if (status == BT_FUNC_STATUS_NOT_FOUND) {
+				BT_ASSERT(!plugin_set);
+				continue;
+			}
+
+			BT_ASSERT(status == BT_FUNC_STATUS_OK);
+			BT_ASSERT(plugin_set);
+
+			for (i = 0; i < plugin_set->plugins->len; i++) {
+				const struct bt_plugin *plugin =
+					plugin_set->plugins->pdata[i];
+
+				if (strcmp(plugin->info.name->str,
+						plugin_name) == 0) {
+					*plugin_out = plugin;
+					bt_object_get_ref_no_null_check(
+						*plugin_out);
+					g_dir_close(dir);
+					goto end;
+				}
+			}
+
+			status = BT_FUNC_STATUS_NOT_FOUND;
+		}
+
+		g_dir_close(dir);
+	}
+
+	if (find_in_static) {
+		uint64_t i;
+
+		BT_OBJECT_PUT_REF_AND_RESET(plugin_set);
+		status = bt_plugin_find_all_from_static(fail_on_load_error,
+			&plugin_set);
+		if (status < 0) {
+			BT_ASSERT(!plugin_set);
+			goto end;
+		} else if (status == BT_FUNC_STATUS_NOT_FOUND) {
+			BT_ASSERT(!plugin_set);
 			goto end;
 		}
+
+		BT_ASSERT(plugin_set);
+
+		for (i = 0; i < plugin_set->plugins->len; i++) {
+			const struct bt_plugin *plugin =
+				plugin_set->plugins->pdata[i];
+
+			if (strcmp(plugin->info.name->str, plugin_name) == 0) {
+				*plugin_out = plugin;
+				bt_object_get_ref_no_null_check(*plugin_out);
+				goto end;
+			}
+		}
 	}
 
 	status = BT_FUNC_STATUS_NOT_FOUND;
 
 end:
+	bt_plugin_index_save();
+
 	if (status == BT_FUNC_STATUS_OK) {
 		BT_ASSERT(*plugin_out);
 		BT_LIB_LOGI("Found plugin in standard directories and built-in plugins: "
@@ -499,6 +686,14 @@ end:
 
 	bt_plugin_set_put_ref(plugin_set);
 
+	if (dirs) {
+		g_ptr_array_free(dirs, TRUE);
+	}
+
+	if (path) {
+		g_string_free(path, TRUE);
+	}
+
 	return status;
 }
 
@@ -514,8 +709,7 @@ static struct {
 
 static
 int nftw_append_all_from_dir(const char *file,
-		const struct stat *sb __attribute__((unused)),
-		int flag, struct FTW *s)
+		const struct stat *sb, int flag, struct FTW *s)
 {
 	int ret = 0;
 	const char *name = file + s->base;
@@ -537,7 +731,7 @@ int nftw_append_all_from_dir(const char *file,
 		}
 
 		append_all_from_dir_info.status =
-			bt_plugin_find_all_from_file(file,
+			create_all_from_indexed_file(file, sb, NULL,
 				append_all_from_dir_info.fail_on_load_error,
 				&plugins_from_file);
 		if (append_all_from_dir_info.status == BT_FUNC_STATUS_OK) {
@@ -560,7 +754,7 @@ int nftw_append_all_from_dir(const char *file,
 			bt_object_put_ref(plugins_from_file);
 			goto end;
 		} else if (append_all_from_dir_info.status < 0) {
-			/* bt_plugin_find_all_from_file() logs errors */
+			/* create_all_from_file() logs errors */
 			BT_ASSERT(!plugins_from_file);
 			ret = -1;
 			goto end;
@@ -632,6 +826,7 @@ int bt_plugin_create_append_all_from_dir(struct bt_plugin_set *plugin_set,
 	append_all_from_dir_info.plugin_set = NULL;
 	status = append_all_from_dir_info.status;
 	pthread_mutex_unlock(&append_all_from_dir_info.lock);
+	bt_plugin_index_save();
 	if (ret) {
 		BT_LIB_LOGW_APPEND_CAUSE("Failed to walk directory",
 			": path=\"%s\", recurse=%d",
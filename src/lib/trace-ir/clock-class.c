@@ -70,6 +70,8 @@ void set_base_offset(struct bt_clock_class *clock_class)
 	clock_class->base_offset.overflows = bt_util_get_base_offset_ns(
 		clock_class->offset_seconds, clock_class->offset_cycles,
 		clock_class->frequency, &clock_class->base_offset.value_ns);
+	bt_common_cycles_to_ns_conv_init(&clock_class->cycles_to_ns,
+		clock_class->frequency);
 }
 
 static void
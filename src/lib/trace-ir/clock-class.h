@@ -79,6 +79,12 @@ struct bt_clock_class {
 		bool overflows;
 	} base_offset;
 
+	/*
+	 * Conversion of cycles to nanoseconds for `frequency` above,
+	 * computed at the same time as `base_offset`.
+	 */
+	struct bt_common_cycles_to_ns_conv cycles_to_ns;
+
 	/* Pool of `struct bt_clock_snapshot *` */
 	struct bt_object_pool cs_pool;
 
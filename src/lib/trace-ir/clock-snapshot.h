@@ -42,11 +42,10 @@ void bt_clock_snapshot_reset(struct bt_clock_snapshot *clock_snapshot)
 static inline
 void set_ns_from_origin(struct bt_clock_snapshot *clock_snapshot)
 {
-	if (bt_util_ns_from_origin_clock_class(clock_snapshot->clock_class,
+	clock_snapshot->ns_from_origin_overflows =
+		bt_util_ns_from_origin_clock_class(clock_snapshot->clock_class,
 			clock_snapshot->value_cycles,
-			&clock_snapshot->ns_from_origin)) {
-		clock_snapshot->ns_from_origin_overflows = true;
-	}
+			&clock_snapshot->ns_from_origin) != 0;
 }
 
 static inline
@@ -59,6 +58,38 @@ void bt_clock_snapshot_set_raw_value(struct bt_clock_snapshot *clock_snapshot,
 	bt_clock_snapshot_set(clock_snapshot);
 }
 
+/*
+ * Sets the clock class of the clock snapshot `clock_snapshot`, which
+ * another object embeds instead of getting it from the pool of
+ * `clock_class`, and sets its raw value to `cycles`.
+ *
+ * The embedding object must guarantee the existence of `clock_class`
+ * (for example, through its stream class): this function doesn't get
+ * a reference. Call bt_clock_snapshot_reset_embedded() once the
+ * embedding object doesn't need `clock_snapshot` anymore.
+ *
+ * Never destroy or recycle an embedded clock snapshot.
+ */
+static inline
+void bt_clock_snapshot_set_embedded(struct bt_clock_snapshot *clock_snapshot,
+		struct bt_clock_class *clock_class, uint64_t cycles)
+{
+	BT_ASSERT_DBG(clock_snapshot);
+	BT_ASSERT_DBG(clock_class);
+	BT_ASSERT_DBG(!clock_snapshot->clock_class);
+	clock_snapshot->clock_class = clock_class;
+	bt_clock_class_freeze(clock_class);
+	bt_clock_snapshot_set_raw_value(clock_snapshot, cycles);
+}
+
+static inline
+void bt_clock_snapshot_reset_embedded(struct bt_clock_snapshot *clock_snapshot)
+{
+	BT_ASSERT_DBG(clock_snapshot);
+	bt_clock_snapshot_reset(clock_snapshot);
+	clock_snapshot->clock_class = NULL;
+}
+
 void bt_clock_snapshot_destroy(struct bt_clock_snapshot *clock_snapshot);
 
 struct bt_clock_snapshot *bt_clock_snapshot_new(struct bt_clock_class *clock_class);
@@ -64,21 +64,7 @@ static
 bool event_class_id_is_unique(const struct bt_stream_class *stream_class,
 		uint64_t id)
 {
-	uint64_t i;
-	bool is_unique = true;
-
-	for (i = 0; i < stream_class->event_classes->len; i++) {
-		const struct bt_event_class *ec =
-			stream_class->event_classes->pdata[i];
-
-		if (ec->id == id) {
-			is_unique = false;
-			goto end;
-		}
-	}
-
-end:
-	return is_unique;
+	return !bt_id_index_lookup(&stream_class->event_class_index, id);
 }
 
 static
@@ -125,6 +111,13 @@ struct bt_event_class *create_event_class_with_id(
 		goto error;
 	}
 
+	ret = bt_id_index_add(&stream_class->event_class_index, id,
+		event_class);
+	if (ret) {
+		/* bt_id_index_add() logs errors */
+		goto error;
+	}
+
 	bt_object_set_parent(&event_class->base, &stream_class->base);
 	g_ptr_array_add(stream_class->event_classes, event_class);
 	bt_stream_class_freeze(stream_class);
@@ -345,6 +338,17 @@ bt_event_class_set_specific_context_field_class(
 		"Specific context field class");
 	stream_class = bt_event_class_borrow_stream_class_inline(
 		event_class);
+	if (field_class->part_of_trace_class) {
+		/* Shared field class: its field paths are already resolved */
+		BT_ASSERT_PRE("field-class-is-shareable",
+			bt_field_class_is_shareable_as_scope_root(field_class,
+				BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT),
+			"Field class is part of a trace class, but isn't an "
+			"event specific context field class which you can share: "
+			"%!+F", field_class);
+		goto set;
+	}
+
 	resolve_ctx.packet_context = stream_class->packet_context_fc;
 	resolve_ctx.event_common_context =
 		stream_class->event_common_context_fc;
@@ -356,6 +360,10 @@ bt_event_class_set_specific_context_field_class(
 	}
 
 	bt_field_class_make_part_of_trace_class(field_class);
+	bt_field_class_set_scope_root(field_class,
+		BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT);
+
+set:
 	bt_object_put_ref(event_class->specific_context_fc);
 	event_class->specific_context_fc = field_class;
 	bt_object_get_ref_no_null_check(event_class->specific_context_fc);
@@ -408,6 +416,17 @@ bt_event_class_set_payload_field_class(
 	BT_ASSERT_PRE_FC_IS_STRUCT("payload", field_class, "Payload field class");
 	stream_class = bt_event_class_borrow_stream_class_inline(
 		event_class);
+	if (field_class->part_of_trace_class) {
+		/* Shared field class: its field paths are already resolved */
+		BT_ASSERT_PRE("field-class-is-shareable",
+			bt_field_class_is_shareable_as_scope_root(field_class,
+				BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD),
+			"Field class is part of a trace class, but isn't an "
+			"event payload field class which you can share: %!+F",
+			field_class);
+		goto set;
+	}
+
 	resolve_ctx.packet_context = stream_class->packet_context_fc;
 	resolve_ctx.event_common_context =
 		stream_class->event_common_context_fc;
@@ -420,6 +439,10 @@ bt_event_class_set_payload_field_class(
 	}
 
 	bt_field_class_make_part_of_trace_class(field_class);
+	bt_field_class_set_scope_root(field_class,
+		BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD);
+
+set:
 	bt_object_put_ref(event_class->payload_fc);
 	event_class->payload_fc = field_class;
 	bt_object_get_ref_no_null_check(event_class->payload_fc);
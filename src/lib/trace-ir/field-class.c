@@ -1412,17 +1412,16 @@ borrow_named_field_class_from_container_field_class_by_name(
 		const char *name, const char *api_func)
 {
 	struct bt_named_field_class *named_fc = NULL;
-	gpointer orig_key;
-	gpointer value;
+	uint64_t index;
 
 	BT_ASSERT_DBG(fc);
 	BT_ASSERT_PRE_DEV_NAME_NON_NULL_FROM_FUNC(api_func, name);
-	if (!g_hash_table_lookup_extended(fc->name_to_index, name, &orig_key,
-			&value)) {
+	if (!bt_field_class_named_field_class_container_get_index_by_name(fc,
+			name, &index)) {
 		goto end;
 	}
 
-	named_fc = fc->named_fcs->pdata[GPOINTER_TO_UINT(value)];
+	named_fc = fc->named_fcs->pdata[index];
 
 end:
 	return named_fc;
@@ -1440,6 +1439,20 @@ bt_field_class_structure_borrow_member_by_name_const(
 			(void *) fc, name, __func__);
 }
 
+BT_EXPORT
+bt_bool bt_field_class_structure_get_member_index_by_name(
+		const struct bt_field_class *fc, const char *name,
+		uint64_t *index)
+{
+	BT_ASSERT_PRE_DEV_FC_NON_NULL(fc);
+	BT_ASSERT_PRE_DEV_FC_IS_STRUCT("field-class", fc, "Field class");
+	BT_ASSERT_PRE_DEV_NAME_NON_NULL(name);
+	BT_ASSERT_PRE_DEV_NON_NULL("index-output", index,
+		"Index (output)");
+	return (bt_bool) bt_field_class_named_field_class_container_get_index_by_name(
+		(const void *) fc, name, index);
+}
+
 BT_EXPORT
 struct bt_field_class_structure_member *
 bt_field_class_structure_borrow_member_by_name(
@@ -3035,6 +3048,113 @@ void bt_field_class_make_part_of_trace_class(const struct bt_field_class *c_fc)
 	}
 }
 
+static
+bool field_xref_is_in_scope(enum field_xref_kind xref_kind,
+		const struct bt_field_path *field_path,
+		enum bt_field_path_scope scope)
+{
+	/*
+	 * A field location targets a field by name at run time: it
+	 * doesn't depend on the field classes of the other scopes.
+	 */
+	return xref_kind != FIELD_XREF_KIND_PATH || field_path->root == scope;
+}
+
+static
+bool field_class_xrefs_are_in_scope(const struct bt_field_class *fc,
+		enum bt_field_path_scope scope)
+{
+	bool in_scope = true;
+
+	if (fc->type == BT_FIELD_CLASS_TYPE_STRUCTURE ||
+			bt_field_class_type_is(fc->type,
+				BT_FIELD_CLASS_TYPE_VARIANT)) {
+		const struct bt_field_class_named_field_class_container *container_fc =
+			(const void *) fc;
+		uint64_t i;
+
+		if (bt_field_class_type_is(fc->type,
+				BT_FIELD_CLASS_TYPE_VARIANT_WITH_SELECTOR_FIELD)) {
+			const struct bt_field_class_variant_with_selector_field *var_fc =
+				(const void *) fc;
+
+			if (!field_xref_is_in_scope(var_fc->selector_field_xref_kind,
+					var_fc->selector_field.path.path, scope)) {
+				in_scope = false;
+				goto end;
+			}
+		}
+
+		for (i = 0; i < container_fc->named_fcs->len; i++) {
+			const struct bt_named_field_class *named_fc =
+				container_fc->named_fcs->pdata[i];
+
+			if (!field_class_xrefs_are_in_scope(named_fc->fc, scope)) {
+				in_scope = false;
+				goto end;
+			}
+		}
+	} else if (bt_field_class_type_is(fc->type,
+			BT_FIELD_CLASS_TYPE_ARRAY)) {
+		const struct bt_field_class_array *array_fc = (const void *) fc;
+
+		if (fc->type == BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY_WITH_LENGTH_FIELD) {
+			const struct bt_field_class_array_dynamic *dyn_array_fc =
+				(const void *) fc;
+
+			if (!field_xref_is_in_scope(
+					dyn_array_fc->length_field.xref_kind,
+					dyn_array_fc->length_field.path.path,
+					scope)) {
+				in_scope = false;
+				goto end;
+			}
+		}
+
+		in_scope = field_class_xrefs_are_in_scope(array_fc->element_fc,
+			scope);
+	} else if (bt_field_class_type_is(fc->type,
+			BT_FIELD_CLASS_TYPE_OPTION)) {
+		const struct bt_field_class_option *opt_fc = (const void *) fc;
+
+		if (bt_field_class_type_is(fc->type,
+				BT_FIELD_CLASS_TYPE_OPTION_WITH_SELECTOR_FIELD)) {
+			const struct bt_field_class_option_with_selector_field *opt_sel_fc =
+				(const void *) fc;
+
+			if (!field_xref_is_in_scope(
+					opt_sel_fc->selector_field_xref_kind,
+					opt_sel_fc->selector_field.path.path,
+					scope)) {
+				in_scope = false;
+				goto end;
+			}
+		}
+
+		in_scope = field_class_xrefs_are_in_scope(opt_fc->content_fc,
+			scope);
+	}
+
+end:
+	return in_scope;
+}
+
+bool bt_field_class_is_shareable_as_scope_root(
+		const struct bt_field_class *fc, enum bt_field_path_scope scope)
+{
+	BT_ASSERT(fc);
+	return fc->part_of_trace_class && fc->is_scope_root &&
+		fc->scope == scope && field_class_xrefs_are_in_scope(fc, scope);
+}
+
+BT_EXPORT
+bt_bool bt_field_class_is_shareable(const struct bt_field_class *fc)
+{
+	BT_ASSERT_PRE_DEV_FC_NON_NULL(fc);
+	return fc->is_scope_root &&
+		bt_field_class_is_shareable_as_scope_root(fc, fc->scope);
+}
+
 BT_EXPORT
 const struct bt_value *bt_field_class_borrow_user_attributes_const(
 		const struct bt_field_class *fc)
@@ -10,11 +10,14 @@
 
 #include <babeltrace2/trace-ir/clock-class.h>
 #include <babeltrace2/trace-ir/field-class.h>
+#include <babeltrace2/trace-ir/field-path.h>
+#include "common/assert.h"
 #include "common/macros.h"
 #include "lib/object.h"
 #include <babeltrace2/types.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 #include <glib.h>
 
 #define BT_FIELD_CLASS_ENUM_MAPPING_AT_INDEX(_fc, _index)		\
@@ -48,6 +51,14 @@ struct bt_field_class {
 	 */
 	bool part_of_trace_class;
 
+	/*
+	 * Whether or not this field class is the root field class of a
+	 * scope of an event class or of a stream class, in which case
+	 * `scope` is this scope.
+	 */
+	bool is_scope_root;
+	enum bt_field_path_scope scope;
+
 	/* Effective MIP version for this field class */
 	uint64_t mip_version;
 };
@@ -140,6 +151,16 @@ struct bt_field_class_real {
 
 struct bt_field_class_string {
 	struct bt_field_class common;
+
+	/*
+	 * Initial buffer size of the string fields of this class
+	 * (bytes): the largest buffer size which a field of this class
+	 * needed so far (up to a limit), or 0.
+	 *
+	 * A frozen field class may be shared by fields which live in
+	 * different threads: only access this with g_atomic_int_*().
+	 */
+	gint field_capacity_hint;
 };
 
 /* A named field class is a (name, field class) pair */
@@ -315,8 +336,63 @@ struct bt_field_class_blob_static {
 struct bt_field_class_blob_dynamic {
 	struct bt_field_class_blob common;
 	const struct bt_field_location *length_fl;
+
+	/* Like `struct bt_field_class_string::field_capacity_hint` */
+	gint field_capacity_hint;
 };
 
+/*
+ * Containers having at most this number of named field classes look up
+ * a name with a linear search instead of with their `name_to_index`
+ * hash table: comparing a few names is cheaper than hashing the
+ * requested name, and most structure field classes are small.
+ */
+#define BT_FIELD_CLASS_NAMED_FC_CONTAINER_LINEAR_SEARCH_MAX_LEN	16
+
+/*
+ * Sets `*index` to the index of the named field class named `name`
+ * within `fc` and returns true, or returns false if there's none.
+ */
+static inline
+bool bt_field_class_named_field_class_container_get_index_by_name(
+		const struct bt_field_class_named_field_class_container *fc,
+		const char *name, uint64_t *index)
+{
+	BT_ASSERT_DBG(fc);
+	BT_ASSERT_DBG(name);
+	BT_ASSERT_DBG(index);
+
+	if (fc->named_fcs->len <=
+			BT_FIELD_CLASS_NAMED_FC_CONTAINER_LINEAR_SEARCH_MAX_LEN) {
+		guint i;
+
+		for (i = 0; i < fc->named_fcs->len; i++) {
+			const struct bt_named_field_class *named_fc =
+				fc->named_fcs->pdata[i];
+
+			/* MIP > 0: a variant field class option may have no name */
+			if (named_fc->name && named_fc->name->str[0] == name[0] &&
+					strcmp(named_fc->name->str, name) == 0) {
+				*index = i;
+				return true;
+			}
+		}
+
+		return false;
+	} else {
+		gpointer orig_key;
+		gpointer value;
+
+		if (!g_hash_table_lookup_extended(fc->name_to_index, name,
+				&orig_key, &value)) {
+			return false;
+		}
+
+		*index = GPOINTER_TO_UINT(value);
+		return true;
+	}
+}
+
 void _bt_field_class_freeze(const struct bt_field_class *field_class);
 
 #ifdef BT_DEV_MODE
@@ -342,4 +418,31 @@ void _bt_named_field_class_freeze(const struct bt_named_field_class *named_fc);
 void bt_field_class_make_part_of_trace_class(
 		const struct bt_field_class *field_class);
 
+/*
+ * Marks `field_class` as being the root field class of the scope
+ * `scope`.
+ */
+static inline
+void bt_field_class_set_scope_root(struct bt_field_class *field_class,
+		enum bt_field_path_scope scope)
+{
+	BT_ASSERT_DBG(field_class);
+	field_class->is_scope_root = true;
+	field_class->scope = scope;
+}
+
+/*
+ * Returns whether or not `field_class`, which must already be part of
+ * a trace class, may become the root field class of the scope `scope`
+ * of another event class or stream class without being copied.
+ *
+ * This is the case when `field_class` already is the root field class
+ * of the same scope elsewhere and when all the field paths of its
+ * children (length and selector fields) target a field class within
+ * `field_class` itself, so that they remain valid as is.
+ */
+bool bt_field_class_is_shareable_as_scope_root(
+		const struct bt_field_class *field_class,
+		enum bt_field_path_scope scope);
+
 #endif /* BABELTRACE_LIB_TRACE_IR_FIELD_CLASS_H */
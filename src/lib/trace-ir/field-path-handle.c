@@ -0,0 +1,375 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#define BT_LOG_TAG "LIB/FIELD-PATH-HANDLE"
+#include "lib/logging.h"
+
+#include "lib/assert-cond.h"
+#include <babeltrace2/trace-ir/field-path-handle.h>
+#include <stdint.h>
+#include "common/assert.h"
+#include "common/common.h"
+#include <glib.h>
+
+#include "event.h"
+#include "event-class.h"
+#include "field.h"
+#include "field-class.h"
+#include "field-path-handle.h"
+#include "field-wrapper.h"
+#include "packet.h"
+#include "stream-class.h"
+
+#define BT_ASSERT_PRE_DEV_FPH_IS_VALID_FOR_EVENT(_handle, _event)	\
+	BT_ASSERT_PRE_DEV("event-class-is-field-path-handle-event-class", \
+		(_event)->class == (_handle)->event_class,		\
+		"Class of event is not the event class of the field path " \
+		"handle: %![event-]+e, %![handle-ec-]+E", (_event),	\
+		(_handle)->event_class)
+
+static
+void destroy_field_path_handle(struct bt_object *obj)
+{
+	struct bt_field_path_handle *handle =
+		(struct bt_field_path_handle *) obj;
+
+	BT_ASSERT(handle);
+	BT_LOGD("Destroying field path handle: addr=%p", handle);
+
+	if (handle->items) {
+		g_array_free(handle->items, TRUE);
+		handle->items = NULL;
+	}
+
+	BT_OBJECT_PUT_REF_AND_RESET(handle->event_class);
+	g_free(handle);
+}
+
+static
+struct bt_field_class *borrow_root_field_class(
+		const struct bt_event_class *event_class,
+		enum bt_field_path_scope root_scope)
+{
+	struct bt_stream_class *stream_class =
+		bt_event_class_borrow_stream_class_inline(event_class);
+
+	switch (root_scope) {
+	case BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+		return stream_class->packet_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		return stream_class->event_common_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		return event_class->specific_context_fc;
+	case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+		return event_class->payload_fc;
+	default:
+		bt_common_abort();
+	}
+}
+
+BT_EXPORT
+struct bt_field_path_handle *bt_field_path_handle_create(
+		const struct bt_event_class *event_class,
+		enum bt_field_path_scope root_scope)
+{
+	struct bt_field_path_handle *handle = NULL;
+	struct bt_field_class *root_fc;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_EC_NON_NULL(event_class);
+	BT_ASSERT_PRE("event-class-has-stream-class",
+		bt_event_class_borrow_stream_class_inline(event_class),
+		"Event class has no stream class: %!+E", event_class);
+	root_fc = borrow_root_field_class(event_class, root_scope);
+	BT_ASSERT_PRE("root-scope-has-field-class", root_fc,
+		"Event class has no field class for the root scope: "
+		"%!+E, root-scope=%s", event_class,
+		bt_common_field_path_scope_string(root_scope));
+	BT_LIB_LOGD("Creating field path handle object: %!+E, root-scope=%s",
+		event_class, bt_common_field_path_scope_string(root_scope));
+
+	handle = g_new0(struct bt_field_path_handle, 1);
+	if (!handle) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate one field path handle.");
+		goto error;
+	}
+
+	bt_object_init_shared(&handle->base, destroy_field_path_handle);
+	handle->items = g_array_new(FALSE, FALSE,
+		sizeof(struct bt_field_path_handle_item));
+	if (!handle->items) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GArray.");
+		goto error;
+	}
+
+	handle->event_class = (void *) event_class;
+	bt_object_get_ref_no_null_check(handle->event_class);
+	handle->root = root_scope;
+	handle->target_fc = root_fc;
+	BT_LOGD("Created field path handle object: addr=%p", handle);
+	goto end;
+
+error:
+	BT_OBJECT_PUT_REF_AND_RESET(handle);
+
+end:
+	return handle;
+}
+
+static inline
+void append_item(struct bt_field_path_handle *handle,
+		enum bt_field_path_handle_item_type type, uint64_t index,
+		struct bt_field_class *target_fc)
+{
+	struct bt_field_path_handle_item item = {
+		.type = type,
+		.index = index,
+	};
+
+	g_array_append_val(handle->items, item);
+	handle->target_fc = target_fc;
+	BT_LIB_LOGD("Appended field path handle item: addr=%p, "
+		"item-index=%" PRIu64 ", %![target-fc-]+F", handle, index,
+		target_fc);
+}
+
+BT_EXPORT
+enum bt_field_path_handle_append_item_status
+bt_field_path_handle_append_structure_member_by_name(
+		struct bt_field_path_handle *handle, const char *name)
+{
+	const struct bt_field_class_named_field_class_container *struct_fc;
+	const struct bt_named_field_class *named_fc;
+	uint64_t index;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_NAME_NON_NULL(name);
+	BT_ASSERT_PRE_FC_IS_STRUCT("target-field-class", handle->target_fc,
+		"Target field class");
+	struct_fc = (const void *) handle->target_fc;
+
+	if (!bt_field_class_named_field_class_container_get_index_by_name(
+			struct_fc, name, &index)) {
+		BT_LIB_LOGD("No such structure member: name=\"%s\", %![fc-]+F",
+			name, handle->target_fc);
+		return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_NOT_FOUND;
+	}
+
+	named_fc = struct_fc->named_fcs->pdata[index];
+	append_item(handle, BT_FIELD_PATH_HANDLE_ITEM_TYPE_STRUCTURE_MEMBER,
+		index, named_fc->fc);
+	return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_field_path_handle_append_item_status
+bt_field_path_handle_append_array_element(
+		struct bt_field_path_handle *handle, uint64_t index)
+{
+	const struct bt_field_class_array *array_fc;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_FC_IS_ARRAY("target-field-class", handle->target_fc,
+		"Target field class");
+	array_fc = (const void *) handle->target_fc;
+	BT_ASSERT_PRE("valid-static-array-element-index",
+		array_fc->common.type != BT_FIELD_CLASS_TYPE_STATIC_ARRAY ||
+		index < ((const struct bt_field_class_array_static *)
+			array_fc)->length,
+		"Index is out of bounds: index=%" PRIu64 ", %![fc-]+F",
+		index, array_fc);
+	append_item(handle, BT_FIELD_PATH_HANDLE_ITEM_TYPE_ARRAY_ELEMENT,
+		index, array_fc->element_fc);
+	return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_field_path_handle_append_item_status
+bt_field_path_handle_append_option_content(
+		struct bt_field_path_handle *handle)
+{
+	const struct bt_field_class_option *opt_fc;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_FC_IS_OPTION("target-field-class", handle->target_fc,
+		"Target field class");
+	opt_fc = (const void *) handle->target_fc;
+	append_item(handle, BT_FIELD_PATH_HANDLE_ITEM_TYPE_OPTION_CONTENT,
+		0, opt_fc->content_fc);
+	return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_field_path_handle_append_item_status
+bt_field_path_handle_append_variant_option_by_name(
+		struct bt_field_path_handle *handle, const char *name)
+{
+	const struct bt_field_class_named_field_class_container *var_fc;
+	const struct bt_named_field_class *named_fc;
+	uint64_t index;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_NAME_NON_NULL(name);
+	BT_ASSERT_PRE_FC_IS_VARIANT("target-field-class", handle->target_fc,
+		"Target field class");
+	var_fc = (const void *) handle->target_fc;
+
+	if (!bt_field_class_named_field_class_container_get_index_by_name(
+			var_fc, name, &index)) {
+		BT_LIB_LOGD("No such variant option: name=\"%s\", %![fc-]+F",
+			name, handle->target_fc);
+		return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_NOT_FOUND;
+	}
+
+	named_fc = var_fc->named_fcs->pdata[index];
+	append_item(handle, BT_FIELD_PATH_HANDLE_ITEM_TYPE_VARIANT_OPTION,
+		index, named_fc->fc);
+	return BT_FIELD_PATH_HANDLE_APPEND_ITEM_STATUS_OK;
+}
+
+BT_EXPORT
+const struct bt_event_class *bt_field_path_handle_borrow_event_class_const(
+		const struct bt_field_path_handle *handle)
+{
+	BT_ASSERT_PRE_DEV_FPH_NON_NULL(handle);
+	return handle->event_class;
+}
+
+BT_EXPORT
+enum bt_field_path_scope bt_field_path_handle_get_root_scope(
+		const struct bt_field_path_handle *handle)
+{
+	BT_ASSERT_PRE_DEV_FPH_NON_NULL(handle);
+	return handle->root;
+}
+
+BT_EXPORT
+const struct bt_field_class *bt_field_path_handle_borrow_field_class_const(
+		const struct bt_field_path_handle *handle)
+{
+	BT_ASSERT_PRE_DEV_FPH_NON_NULL(handle);
+	return handle->target_fc;
+}
+
+static inline
+struct bt_field *borrow_root_field(const struct bt_field_path_handle *handle,
+		const struct bt_event *event)
+{
+	switch (handle->root) {
+	case BT_FIELD_PATH_SCOPE_PACKET_CONTEXT:
+		if (!event->packet || !event->packet->context_field) {
+			return NULL;
+		}
+
+		return event->packet->context_field->field;
+	case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+		return event->common_context_field;
+	case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+		return event->specific_context_field;
+	case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+		return event->payload_field;
+	default:
+		bt_common_abort();
+	}
+}
+
+/*
+ * Follows the items of `handle` from the root field of `event`.
+ *
+ * The field classes of the items were checked when they were appended,
+ * so this doesn't check the type of any intermediate field.
+ */
+static
+struct bt_field *borrow_field_from_event(
+		const struct bt_field_path_handle *handle,
+		const struct bt_event *event)
+{
+	struct bt_field *field = borrow_root_field(handle, event);
+	guint i;
+
+	for (i = 0; field && i < handle->items->len; i++) {
+		const struct bt_field_path_handle_item *item =
+			&bt_g_array_index(handle->items,
+				struct bt_field_path_handle_item, i);
+
+		switch (item->type) {
+		case BT_FIELD_PATH_HANDLE_ITEM_TYPE_STRUCTURE_MEMBER:
+		{
+			struct bt_field_structure *struct_field = (void *) field;
+
+			BT_ASSERT_DBG(item->index < struct_field->fields->len);
+			field = struct_field->fields->pdata[item->index];
+			break;
+		}
+		case BT_FIELD_PATH_HANDLE_ITEM_TYPE_ARRAY_ELEMENT:
+		{
+			struct bt_field_array *array_field = (void *) field;
+
+			field = item->index < array_field->length ?
+				array_field->fields->pdata[item->index] : NULL;
+			break;
+		}
+		case BT_FIELD_PATH_HANDLE_ITEM_TYPE_OPTION_CONTENT:
+		{
+			struct bt_field_option *opt_field = (void *) field;
+
+			field = opt_field->selected_field;
+			break;
+		}
+		case BT_FIELD_PATH_HANDLE_ITEM_TYPE_VARIANT_OPTION:
+		{
+			struct bt_field_variant *var_field = (void *) field;
+
+			field = var_field->selected_index == item->index ?
+				var_field->selected_field : NULL;
+			break;
+		}
+		default:
+			bt_common_abort();
+		}
+	}
+
+	return field;
+}
+
+BT_EXPORT
+struct bt_field *bt_field_path_handle_borrow_field_from_event(
+		const struct bt_field_path_handle *handle,
+		struct bt_event *event)
+{
+	BT_ASSERT_PRE_DEV_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_DEV_EVENT_NON_NULL(event);
+	BT_ASSERT_PRE_DEV_FPH_IS_VALID_FOR_EVENT(handle, event);
+	return borrow_field_from_event(handle, event);
+}
+
+BT_EXPORT
+const struct bt_field *bt_field_path_handle_borrow_field_from_event_const(
+		const struct bt_field_path_handle *handle,
+		const struct bt_event *event)
+{
+	BT_ASSERT_PRE_DEV_FPH_NON_NULL(handle);
+	BT_ASSERT_PRE_DEV_EVENT_NON_NULL(event);
+	BT_ASSERT_PRE_DEV_FPH_IS_VALID_FOR_EVENT(handle, event);
+	return borrow_field_from_event(handle, event);
+}
+
+BT_EXPORT
+void bt_field_path_handle_get_ref(const struct bt_field_path_handle *handle)
+{
+	bt_object_get_ref(handle);
+}
+
+BT_EXPORT
+void bt_field_path_handle_put_ref(const struct bt_field_path_handle *handle)
+{
+	bt_object_put_ref(handle);
+}
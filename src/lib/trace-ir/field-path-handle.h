@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_LIB_TRACE_IR_FIELD_PATH_HANDLE_H
+#define BABELTRACE_LIB_TRACE_IR_FIELD_PATH_HANDLE_H
+
+#include "lib/object.h"
+#include <babeltrace2/trace-ir/field-path-handle.h>
+#include <babeltrace2/trace-ir/field-path.h>
+#include <glib.h>
+#include <stdint.h>
+
+enum bt_field_path_handle_item_type {
+	/* Structure member at `index` */
+	BT_FIELD_PATH_HANDLE_ITEM_TYPE_STRUCTURE_MEMBER,
+
+	/* Array element at `index` (possibly out of bounds) */
+	BT_FIELD_PATH_HANDLE_ITEM_TYPE_ARRAY_ELEMENT,
+
+	/* Option content (possibly not selected) */
+	BT_FIELD_PATH_HANDLE_ITEM_TYPE_OPTION_CONTENT,
+
+	/* Variant option at `index` (possibly not selected) */
+	BT_FIELD_PATH_HANDLE_ITEM_TYPE_VARIANT_OPTION,
+};
+
+struct bt_field_path_handle_item {
+	enum bt_field_path_handle_item_type type;
+	uint64_t index;
+};
+
+struct bt_field_path_handle {
+	struct bt_object base;
+
+	/* Owned by this */
+	struct bt_event_class *event_class;
+
+	enum bt_field_path_scope root;
+
+	/* Array of `struct bt_field_path_handle_item` (items) */
+	GArray *items;
+
+	/* Weak: class of the target field */
+	struct bt_field_class *target_fc;
+};
+
+#endif /* BABELTRACE_LIB_TRACE_IR_FIELD_PATH_HANDLE_H */
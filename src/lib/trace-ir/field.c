@@ -383,6 +383,100 @@ end:
 	return (void *) real_field;
 }
 
+/*
+ * Maximum initial buffer size (bytes) of a string or dynamic BLOB field
+ * from the length history of its class: a single long value mustn't
+ * make all the next fields of the same class allocate that much.
+ */
+#define FIELD_CAPACITY_HINT_MAX	4096
+
+/*
+ * Returns the initial buffer of a string or BLOB field, setting
+ * `*capacity` to its size: `inline_buf` (of which the size is
+ * `inline_size`) if `min_capacity` bytes fit, or a new heap buffer of
+ * `min_capacity` bytes otherwise.
+ *
+ * Returns `NULL` on memory error.
+ */
+static
+void *init_field_buf(void *inline_buf, uint64_t inline_size,
+		uint64_t min_capacity, uint64_t *capacity)
+{
+	void *buf;
+
+	if (min_capacity <= inline_size) {
+		*capacity = inline_size;
+		return inline_buf;
+	}
+
+	buf = g_malloc(min_capacity);
+	if (buf) {
+		*capacity = min_capacity;
+	}
+
+	return buf;
+}
+
+/*
+ * Raises the field class hint `*capacity_hint` to `capacity` (up to
+ * `FIELD_CAPACITY_HINT_MAX`), atomically: other threads may create or
+ * grow fields of the same class concurrently.
+ */
+static
+void update_capacity_hint(gint *capacity_hint, uint64_t capacity)
+{
+	const gint new_hint = (gint) MIN(capacity, FIELD_CAPACITY_HINT_MAX);
+	gint cur_hint;
+
+	do {
+		cur_hint = g_atomic_int_get(capacity_hint);
+		if (cur_hint >= new_hint) {
+			break;
+		}
+	} while (!g_atomic_int_compare_and_exchange(capacity_hint,
+		cur_hint, new_hint));
+}
+
+/*
+ * Grows the buffer `buf` of a string or BLOB field, of which the size
+ * is `*capacity`, to at least `min_capacity` bytes, keeping its first
+ * `keep_size` bytes, and updates `*capacity` and the field class hint
+ * `*capacity_hint`.
+ *
+ * `inline_buf` is the inline buffer of the field: this function never
+ * frees it.
+ *
+ * Returns the new buffer, or `NULL` on memory error (`buf` remains
+ * valid).
+ */
+static
+void *grow_field_buf(void *buf, const void *inline_buf, uint64_t keep_size,
+		uint64_t *capacity, uint64_t min_capacity,
+		gint *capacity_hint)
+{
+	uint64_t new_capacity = MAX(*capacity * 2, min_capacity);
+	void *new_buf;
+
+	if (buf == inline_buf) {
+		new_buf = g_malloc(new_capacity);
+		if (new_buf) {
+			memcpy(new_buf, inline_buf, keep_size);
+		}
+	} else {
+		new_buf = g_realloc(buf, new_capacity);
+	}
+
+	if (!new_buf) {
+		goto end;
+	}
+
+	*capacity = new_capacity;
+	update_capacity_hint(capacity_hint, new_capacity);
+
+end:
+	return new_buf;
+}
+
 static
 struct bt_field *create_string_field(struct bt_field_class *fc)
 {
@@ -397,30 +491,106 @@ struct bt_field *create_string_field(struct bt_field_class *fc)
 	}
 
 	init_field((void *) string_field, fc, &string_field_methods);
-	string_field->buf = g_array_sized_new(FALSE, FALSE,
-		sizeof(char), 1);
+	string_field->buf = init_field_buf(string_field->inline_buf,
+		BT_FIELD_STRING_INLINE_BUF_SIZE,
+		(uint64_t) g_atomic_int_get(
+			&((struct bt_field_class_string *) fc)->field_capacity_hint),
+		&string_field->capacity);
 	if (!string_field->buf) {
-		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GArray.");
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate string field buffer: %![fc-]+F",
+			fc);
 		bt_field_destroy((void *) string_field);
 		string_field = NULL;
 		goto end;
 	}
 
-	g_array_set_size(string_field->buf, 1);
-	bt_g_array_index(string_field->buf, char, 0) = '\0';
+	string_field->buf[0] = '\0';
 	BT_LIB_LOGD("Created string field object: %!+f", string_field);
 
 end:
 	return (void *) string_field;
 }
 
+/*
+ * Returns the size of a field of class `fc` if it can live within the
+ * member block of a structure field, or 0 otherwise.
+ */
+static inline
+size_t member_block_field_size(struct bt_field_class *fc)
+{
+	switch (fc->type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+		return sizeof(struct bt_field_bool);
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		return sizeof(struct bt_field_bit_array);
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+		return sizeof(struct bt_field_integer);
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		return sizeof(struct bt_field_real);
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Initializes the field of class `fc` at `addr` within a member block.
+ */
+static
+struct bt_field *init_member_block_field(void *addr,
+		struct bt_field_class *fc)
+{
+	struct bt_field *field = addr;
+	struct bt_field_methods *methods;
+
+	switch (fc->type) {
+	case BT_FIELD_CLASS_TYPE_BOOL:
+		methods = &bool_field_methods;
+		break;
+	case BT_FIELD_CLASS_TYPE_BIT_ARRAY:
+		methods = &bit_array_field_methods;
+		break;
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_SIGNED_INTEGER:
+	case BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION:
+	case BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION:
+		methods = &integer_field_methods;
+		break;
+	case BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL:
+	case BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL:
+		methods = &real_field_methods;
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	init_field(field, fc, methods);
+	field->in_parent_block = true;
+	BT_LIB_LOGD("Created field object within member block: %!+f", field);
+	return field;
+}
+
+/*
+ * Creates the fields of the named field classes of `fc` into `*fields`.
+ *
+ * If `member_block` isn't `NULL`, then this function creates the
+ * fields for which member_block_field_size() isn't 0 within a single
+ * memory block, setting `*member_block` to it (or to `NULL` if there's
+ * no such field).
+ */
 static inline
 int create_fields_from_named_field_classes(
 		struct bt_field_class_named_field_class_container *fc,
-		GPtrArray **fields)
+		GPtrArray **fields, void **member_block)
 {
 	int ret = 0;
 	uint64_t i;
+	size_t block_size = 0;
+	uint8_t *block_addr = NULL;
 
 	*fields = g_ptr_array_new_with_free_func(
 		(GDestroyNotify) bt_field_destroy);
@@ -432,18 +602,55 @@ int create_fields_from_named_field_classes(
 
 	g_ptr_array_set_size(*fields, fc->named_fcs->len);
 
+	if (member_block) {
+		for (i = 0; i < fc->named_fcs->len; i++) {
+			struct bt_named_field_class *named_fc =
+				fc->named_fcs->pdata[i];
+
+			block_size += member_block_field_size(named_fc->fc);
+		}
+
+		*member_block = NULL;
+
+		if (block_size > 0) {
+			/*
+			 * All the scalar field structures have the same
+			 * alignment (the one of `struct bt_field`), so
+			 * they may follow each other.
+			 */
+			*member_block = g_malloc0(block_size);
+			if (!*member_block) {
+				BT_LIB_LOGE_APPEND_CAUSE(
+					"Failed to allocate a member block: "
+					"size=%zu", block_size);
+				ret = -1;
+				goto end;
+			}
+
+			block_addr = *member_block;
+		}
+	}
+
 	for (i = 0; i < fc->named_fcs->len; i++) {
 		struct bt_field *field;
 		struct bt_named_field_class *named_fc = fc->named_fcs->pdata[i];
-
-		field = bt_field_create(named_fc->fc);
-		if (!field) {
-			BT_LIB_LOGE_APPEND_CAUSE(
-				"Failed to create structure member or variant option field: "
-				"name=\"%s\", %![fc-]+F",
-				named_fc->name->str, named_fc->fc);
-			ret = -1;
-			goto end;
+		const size_t size = block_addr ?
+			member_block_field_size(named_fc->fc) : 0;
+
+		if (size > 0) {
+			field = init_member_block_field(block_addr,
+				named_fc->fc);
+			block_addr += size;
+		} else {
+			field = bt_field_create(named_fc->fc);
+			if (!field) {
+				BT_LIB_LOGE_APPEND_CAUSE(
+					"Failed to create structure member or variant option field: "
+					"name=\"%s\", %![fc-]+F",
+					named_fc->name->str, named_fc->fc);
+				ret = -1;
+				goto end;
+			}
 		}
 
 		g_ptr_array_index(*fields, i) = field;
@@ -469,7 +676,7 @@ struct bt_field *create_structure_field(struct bt_field_class *fc)
 	init_field((void *) struct_field, fc, &structure_field_methods);
 
 	if (create_fields_from_named_field_classes((void *) fc,
-			&struct_field->fields)) {
+			&struct_field->fields, &struct_field->member_block)) {
 		BT_LIB_LOGE_APPEND_CAUSE(
 			"Cannot create structure member fields: %![fc-]+F", fc);
 		bt_field_destroy((void *) struct_field);
@@ -531,7 +738,7 @@ struct bt_field *create_variant_field(struct bt_field_class *fc)
 	init_field((void *) var_field, fc, &variant_field_methods);
 
 	if (create_fields_from_named_field_classes((void *) fc,
-			&var_field->fields)) {
+			&var_field->fields, NULL)) {
 		BT_LIB_LOGE_APPEND_CAUSE("Cannot create variant member fields: "
 			"%![fc-]+F", fc);
 		bt_field_destroy((void *) var_field);
@@ -564,13 +771,24 @@ struct bt_field *create_blob_field(struct bt_field_class *fc)
 		struct bt_field_class_blob_static *blob_static_fc =
 			(void *) fc;
 		blob_field->length = blob_static_fc->length;
-		blob_field->data = g_malloc(blob_field->length);
-		if (!blob_field->data) {
-			BT_LIB_LOGE_APPEND_CAUSE(
-				"Failed to allocate BLOB field data: %![fc-]+F",
-				fc);
-			goto error;
-		}
+		blob_field->data = init_field_buf(blob_field->inline_data,
+			BT_FIELD_BLOB_INLINE_DATA_SIZE, blob_field->length,
+			&blob_field->capacity);
+	} else {
+		struct bt_field_class_blob_dynamic *blob_dyn_fc =
+			(void *) fc;
+
+		blob_field->data = init_field_buf(blob_field->inline_data,
+			BT_FIELD_BLOB_INLINE_DATA_SIZE,
+			(uint64_t) g_atomic_int_get(
+				&blob_dyn_fc->field_capacity_hint),
+			&blob_field->capacity);
+	}
+
+	if (!blob_field->data) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate BLOB field data: %![fc-]+F", fc);
+		goto error;
 	}
 
 	goto end;
@@ -582,27 +800,66 @@ end:
 	return (void *) blob_field;
 }
 
-static inline
-int init_array_field_fields(struct bt_field_array *array_field)
+/*
+ * Creates the element fields of `array_field` at the indexes
+ * `begin_index` (included) to `end_index` (excluded) of
+ * `array_field->fields`, which must already have at least `end_index`
+ * entries.
+ *
+ * If member_block_field_size() isn't 0 for the element field class,
+ * then this function creates all those element fields within a single
+ * memory block, adding it to `array_field->element_blocks`.
+ */
+static
+int create_array_field_element_fields(struct bt_field_array *array_field,
+		uint64_t begin_index, uint64_t end_index)
 {
 	int ret = 0;
 	uint64_t i;
 	struct bt_field_class_array *array_fc;
+	size_t elem_size;
 
-	BT_ASSERT(array_field);
+	BT_ASSERT_DBG(array_field);
+	BT_ASSERT_DBG(end_index <= array_field->fields->len);
 	array_fc = (void *) array_field->common.class;
-	array_field->fields = g_ptr_array_sized_new(array_field->length);
-	if (!array_field->fields) {
-		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GPtrArray.");
-		ret = -1;
+	elem_size = member_block_field_size(array_fc->element_fc);
+
+	if (elem_size > 0 && end_index > begin_index) {
+		uint8_t *block = g_malloc0(elem_size * (end_index - begin_index));
+
+		if (!block) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to allocate array field's element block: "
+				"count=%" PRIu64 ", %![fc-]+F",
+				end_index - begin_index, array_fc);
+			ret = -1;
+			goto end;
+		}
+
+		if (!array_field->element_blocks) {
+			array_field->element_blocks =
+				g_ptr_array_new_with_free_func(g_free);
+			if (!array_field->element_blocks) {
+				BT_LIB_LOGE_APPEND_CAUSE(
+					"Failed to allocate a GPtrArray.");
+				g_free(block);
+				ret = -1;
+				goto end;
+			}
+		}
+
+		g_ptr_array_add(array_field->element_blocks, block);
+
+		for (i = begin_index; i < end_index; i++) {
+			array_field->fields->pdata[i] = init_member_block_field(
+				block + (i - begin_index) * elem_size,
+				array_fc->element_fc);
+		}
+
 		goto end;
 	}
 
-	g_ptr_array_set_free_func(array_field->fields,
-		(GDestroyNotify) bt_field_destroy);
-	g_ptr_array_set_size(array_field->fields, array_field->length);
-
-	for (i = 0; i < array_field->length; i++) {
+	for (i = begin_index; i < end_index; i++) {
 		array_field->fields->pdata[i] = bt_field_create(
 			array_fc->element_fc);
 		if (!array_field->fields->pdata[i]) {
@@ -618,6 +875,29 @@ end:
 	return ret;
 }
 
+static inline
+int init_array_field_fields(struct bt_field_array *array_field)
+{
+	int ret = 0;
+
+	BT_ASSERT(array_field);
+	array_field->fields = g_ptr_array_sized_new(array_field->length);
+	if (!array_field->fields) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GPtrArray.");
+		ret = -1;
+		goto end;
+	}
+
+	g_ptr_array_set_free_func(array_field->fields,
+		(GDestroyNotify) bt_field_destroy);
+	g_ptr_array_set_size(array_field->fields, array_field->length);
+	ret = create_array_field_element_fields(array_field, 0,
+		array_field->length);
+
+end:
+	return ret;
+}
+
 static
 struct bt_field *create_static_array_field(struct bt_field_class *fc)
 {
@@ -929,7 +1209,7 @@ const char *bt_field_string_get_value(const struct bt_field *field)
 	BT_ASSERT_PRE_DEV_FIELD_IS_SET("field", field);
 	BT_ASSERT_PRE_DEV_FIELD_HAS_CLASS_TYPE("field", field, "string-field",
 		BT_FIELD_CLASS_TYPE_STRING, "Field");
-	return (const char *) string_field->buf->data;
+	return string_field->buf;
 }
 
 BT_EXPORT
@@ -951,7 +1231,7 @@ void clear_string_field(struct bt_field *field)
 
 	BT_ASSERT_DBG(field);
 	string_field->length = 0;
-	bt_g_array_index(string_field->buf, char, 0) = '\0';
+	string_field->buf[0] = '\0';
 	bt_field_set_single(field, true);
 }
 
@@ -991,20 +1271,31 @@ enum bt_field_string_append_status append_to_string_field_with_length(
 		struct bt_field *field, const char *value, uint64_t length)
 {
 	struct bt_field_string *string_field = (void *) field;
-	char *data;
 	uint64_t new_length;
 
 	BT_ASSERT_DBG(field);
 	BT_ASSERT_DBG(value);
 	new_length = length + string_field->length;
 
-	if (G_UNLIKELY(new_length + 1 > string_field->buf->len)) {
-		g_array_set_size(string_field->buf, new_length + 1);
+	if (G_UNLIKELY(new_length + 1 > string_field->capacity)) {
+		char *buf = grow_field_buf(string_field->buf,
+			string_field->inline_buf, string_field->length,
+			&string_field->capacity, new_length + 1,
+			&((struct bt_field_class_string *)
+				field->class)->field_capacity_hint);
+
+		if (!buf) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Failed to grow string field buffer: %!+f",
+				field);
+			return BT_FUNC_STATUS_MEMORY_ERROR;
+		}
+
+		string_field->buf = buf;
 	}
 
-	data = string_field->buf->data;
-	memcpy(data + string_field->length, value, length);
-	((char *) string_field->buf->data)[new_length] = '\0';
+	memcpy(string_field->buf + string_field->length, value, length);
+	string_field->buf[new_length] = '\0';
 	string_field->length = new_length;
 	bt_field_set_single(field, true);
 	return BT_FUNC_STATUS_OK;
@@ -1050,43 +1341,57 @@ uint64_t bt_field_array_get_length(const struct bt_field *field)
 	return array_field->length;
 }
 
-BT_EXPORT
-enum bt_field_array_dynamic_set_length_status bt_field_array_dynamic_set_length(
-		struct bt_field *field, uint64_t length)
+static
+int set_dynamic_array_field_length(struct bt_field *field, uint64_t length)
 {
 	int ret = BT_FUNC_STATUS_OK;
 	struct bt_field_array *array_field = (void *) field;
 
-	BT_ASSERT_PRE_DEV_NO_ERROR();
-	BT_ASSERT_PRE_DEV_FIELD_NON_NULL(field);
-	BT_ASSERT_PRE_DEV_FIELD_IS_DYNAMIC_ARRAY("field", field, "Field");
-	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+	BT_ASSERT_DBG(field);
 
 	if (G_UNLIKELY(length > array_field->fields->len)) {
 		/* Make more room */
-		struct bt_field_class_array *array_fc;
+		struct bt_field_class_array *array_fc = (void *) field->class;
 		uint64_t cur_len = array_field->fields->len;
+		uint64_t new_len = length;
 		uint64_t i;
 
-		g_ptr_array_set_size(array_field->fields, length);
-		array_fc = (void *) field->class;
+		/*
+		 * Creating scalar element fields within a block is cheap:
+		 * create more of them than needed so that the next length
+		 * increases don't need another block.
+		 */
+		if (member_block_field_size(array_fc->element_fc) > 0) {
+			new_len = MAX(length, cur_len * 2);
+		}
 
-		for (i = cur_len; i < array_field->fields->len; i++) {
-			struct bt_field *elem_field = bt_field_create(
-				array_fc->element_fc);
+		g_ptr_array_set_size(array_field->fields, new_len);
 
-			if (!elem_field) {
-				BT_LIB_LOGE_APPEND_CAUSE(
-					"Cannot create element field for "
-					"dynamic array field: "
-					"index=%" PRIu64 ", "
-					"%![array-field-]+f", i, field);
-				ret = BT_FUNC_STATUS_MEMORY_ERROR;
-				goto end;
+		if (create_array_field_element_fields(array_field, cur_len,
+				new_len)) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"Cannot create element fields for "
+				"dynamic array field: "
+				"length=%" PRIu64 ", "
+				"%![array-field-]+f", length, field);
+
+			/*
+			 * Remove the (`NULL`) entries of the element
+			 * fields which this function couldn't create.
+			 */
+			i = cur_len;
+
+			while (i < new_len && array_field->fields->pdata[i]) {
+				i++;
 			}
 
-			BT_ASSERT_DBG(!array_field->fields->pdata[i]);
-			array_field->fields->pdata[i] = elem_field;
+			g_ptr_array_set_free_func(array_field->fields, NULL);
+			g_ptr_array_set_size(array_field->fields, i);
+			g_ptr_array_set_free_func(array_field->fields,
+				(GDestroyNotify) bt_field_destroy);
+
+			ret = BT_FUNC_STATUS_MEMORY_ERROR;
+			goto end;
 		}
 	}
 
@@ -1096,6 +1401,197 @@ end:
 	return ret;
 }
 
+BT_EXPORT
+enum bt_field_array_dynamic_set_length_status bt_field_array_dynamic_set_length(
+		struct bt_field *field, uint64_t length)
+{
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_FIELD_NON_NULL(field);
+	BT_ASSERT_PRE_DEV_FIELD_IS_DYNAMIC_ARRAY("field", field, "Field");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+	return set_dynamic_array_field_length(field, length);
+}
+
+#define BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(_field, _index, _values, _count, _elem_cond, _elem_cond_id, _elem_desc) \
+	do {								\
+		BT_ASSERT_PRE_DEV_FIELD_NON_NULL(_field);		\
+		BT_ASSERT_PRE_DEV_FIELD_IS_ARRAY("field", (_field),	\
+			"Field");					\
+		BT_ASSERT_PRE_DEV_NON_NULL("values", (_values),		\
+			"Values");					\
+		BT_ASSERT_PRE_DEV("valid-element-range",		\
+			(_index) <= ((const struct bt_field_array *)	\
+				(_field))->length &&			\
+			(_count) <= ((const struct bt_field_array *)	\
+				(_field))->length - (_index),		\
+			"Element range is out of the bounds of the array " \
+			"field: index=%" PRIu64 ", count=%" PRIu64 ", "	\
+			"%![field-]+f", (_index), (_count), (_field));	\
+		BT_ASSERT_PRE_DEV("element-field-class-is-" _elem_cond_id, \
+			_elem_cond(((const struct bt_field_class_array *) \
+				(_field)->class)->element_fc),		\
+			"Element field class of array field is not " _elem_desc \
+			": %![field-]+f", (_field));			\
+	} while (0)
+
+#define ARRAY_ELEM_FC_IS_UNSIGNED_INT(_fc)				\
+	((_fc)->type == BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER ||		\
+	(_fc)->type == BT_FIELD_CLASS_TYPE_UNSIGNED_ENUMERATION)
+
+#define ARRAY_ELEM_FC_IS_SIGNED_INT(_fc)				\
+	((_fc)->type == BT_FIELD_CLASS_TYPE_SIGNED_INTEGER ||		\
+	(_fc)->type == BT_FIELD_CLASS_TYPE_SIGNED_ENUMERATION)
+
+#define ARRAY_ELEM_FC_IS_REAL(_fc)					\
+	((_fc)->type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL ||	\
+	(_fc)->type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL)
+
+BT_EXPORT
+void bt_field_array_integer_unsigned_set_values(struct bt_field *field,
+		uint64_t index, const uint64_t *values, uint64_t count)
+{
+	struct bt_field_array *array_field = (void *) field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_UNSIGNED_INT, "unsigned-integer",
+		"an unsigned integer field class");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+
+	for (i = 0; i < count; i++) {
+		struct bt_field_integer *int_field =
+			array_field->fields->pdata[index + i];
+
+		BT_ASSERT_PRE_DEV("valid-value-for-field-class-field-value-range",
+			bt_util_value_is_in_range_unsigned(
+				((struct bt_field_class_integer *)
+					int_field->common.class)->range,
+				values[i]),
+			"Value is out of bounds: index=%" PRIu64 ", "
+			"value=%" PRIu64 ", %![field-]+f", index + i, values[i],
+			field);
+		int_field->value.u = values[i];
+		bt_field_set_single((void *) int_field, true);
+	}
+}
+
+BT_EXPORT
+void bt_field_array_integer_unsigned_get_values(const struct bt_field *field,
+		uint64_t index, uint64_t *values, uint64_t count)
+{
+	const struct bt_field_array *array_field = (const void *) field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_UNSIGNED_INT, "unsigned-integer",
+		"an unsigned integer field class");
+
+	for (i = 0; i < count; i++) {
+		const struct bt_field_integer *int_field =
+			array_field->fields->pdata[index + i];
+
+		BT_ASSERT_PRE_DEV_FIELD_IS_SET("element-field",
+			&int_field->common);
+		values[i] = int_field->value.u;
+	}
+}
+
+BT_EXPORT
+void bt_field_array_integer_signed_set_values(struct bt_field *field,
+		uint64_t index, const int64_t *values, uint64_t count)
+{
+	struct bt_field_array *array_field = (void *) field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_SIGNED_INT, "signed-integer",
+		"a signed integer field class");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+
+	for (i = 0; i < count; i++) {
+		struct bt_field_integer *int_field =
+			array_field->fields->pdata[index + i];
+
+		BT_ASSERT_PRE_DEV("valid-value-for-field-class-field-value-range",
+			bt_util_value_is_in_range_signed(
+				((struct bt_field_class_integer *)
+					int_field->common.class)->range,
+				values[i]),
+			"Value is out of bounds: index=%" PRIu64 ", "
+			"value=%" PRId64 ", %![field-]+f", index + i, values[i],
+			field);
+		int_field->value.i = values[i];
+		bt_field_set_single((void *) int_field, true);
+	}
+}
+
+BT_EXPORT
+void bt_field_array_integer_signed_get_values(const struct bt_field *field,
+		uint64_t index, int64_t *values, uint64_t count)
+{
+	const struct bt_field_array *array_field = (const void *) field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_SIGNED_INT, "signed-integer",
+		"a signed integer field class");
+
+	for (i = 0; i < count; i++) {
+		const struct bt_field_integer *int_field =
+			array_field->fields->pdata[index + i];
+
+		BT_ASSERT_PRE_DEV_FIELD_IS_SET("element-field",
+			&int_field->common);
+		values[i] = int_field->value.i;
+	}
+}
+
+BT_EXPORT
+void bt_field_array_real_set_values(struct bt_field *field,
+		uint64_t index, const double *values, uint64_t count)
+{
+	struct bt_field_array *array_field = (void *) field;
+	bool is_single_precision;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_REAL, "real", "a real field class");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+	is_single_precision = ((struct bt_field_class_array *)
+		field->class)->element_fc->type ==
+			BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL;
+
+	for (i = 0; i < count; i++) {
+		struct bt_field_real *real_field =
+			array_field->fields->pdata[index + i];
+
+		/* Like bt_field_real_single_precision_set_value() */
+		real_field->value = is_single_precision ?
+			(double) (float) values[i] : values[i];
+		bt_field_set_single((void *) real_field, true);
+	}
+}
+
+BT_EXPORT
+void bt_field_array_real_get_values(const struct bt_field *field,
+		uint64_t index, double *values, uint64_t count)
+{
+	const struct bt_field_array *array_field = (const void *) field;
+	uint64_t i;
+
+	BT_ASSERT_PRE_DEV_FOR_ARRAY_FIELD_VALUES(field, index, values, count,
+		ARRAY_ELEM_FC_IS_REAL, "real", "a real field class");
+
+	for (i = 0; i < count; i++) {
+		const struct bt_field_real *real_field =
+			array_field->fields->pdata[index + i];
+
+		BT_ASSERT_PRE_DEV_FIELD_IS_SET("element-field",
+			&real_field->common);
+		values[i] = real_field->value;
+	}
+}
+
 static inline
 struct bt_field *borrow_array_field_element_field_by_index(
 		struct bt_field *field, uint64_t index, const char *api_func)
@@ -1166,8 +1662,7 @@ struct bt_field *borrow_structure_field_member_field_by_name(
 	struct bt_field *ret_field = NULL;
 	struct bt_field_class_structure *struct_fc;
 	struct bt_field_structure *struct_field = (void *) field;
-	gpointer orig_key;
-	gpointer index;
+	uint64_t index;
 
 	BT_ASSERT_PRE_DEV_FIELD_NON_NULL_FROM_FUNC(api_func, field);
 	BT_ASSERT_PRE_DEV_NON_NULL_FROM_FUNC(api_func, "member-name", name,
@@ -1177,12 +1672,12 @@ struct bt_field *borrow_structure_field_member_field_by_name(
 		"Field");
 	struct_fc = (void *) field->class;
 
-	if (!g_hash_table_lookup_extended(struct_fc->common.name_to_index, name,
-			&orig_key, &index)) {
+	if (!bt_field_class_named_field_class_container_get_index_by_name(
+			&struct_fc->common, name, &index)) {
 		goto end;
 	}
 
-	ret_field = struct_field->fields->pdata[GPOINTER_TO_UINT(index)];
+	ret_field = struct_field->fields->pdata[index];
 	BT_ASSERT_DBG(ret_field);
 
 end:
@@ -1395,21 +1890,21 @@ const uint8_t *bt_field_blob_get_data_const(const struct bt_field *field)
 	return blob_field->data;
 }
 
-BT_EXPORT
-enum bt_field_blob_dynamic_set_length_status bt_field_blob_dynamic_set_length(
-		struct bt_field *field, uint64_t length)
+static
+int set_dynamic_blob_field_length(struct bt_field *field, uint64_t length)
 {
 	int ret;
 	struct bt_field_blob *blob_field = (void *) field;
 
-	BT_ASSERT_PRE_DEV_NO_ERROR();
-	BT_ASSERT_PRE_DEV_FIELD_NON_NULL(field);
-	BT_ASSERT_PRE_DEV_FIELD_IS_DYNAMIC_BLOB("field", field, "Field");
-	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+	BT_ASSERT_DBG(field);
 
-	if (G_UNLIKELY(length > blob_field->length)) {
+	if (G_UNLIKELY(length > blob_field->capacity)) {
 		/* Make more room */
-		uint8_t *data = g_realloc(blob_field->data, length);
+		uint8_t *data = grow_field_buf(blob_field->data,
+			blob_field->inline_data, blob_field->length,
+			&blob_field->capacity, length,
+			&((struct bt_field_class_blob_dynamic *)
+				field->class)->field_capacity_hint);
 
 		if (!data) {
 			BT_LIB_LOGE_APPEND_CAUSE(
@@ -1429,6 +1924,17 @@ end:
 	return ret;
 }
 
+BT_EXPORT
+enum bt_field_blob_dynamic_set_length_status bt_field_blob_dynamic_set_length(
+		struct bt_field *field, uint64_t length)
+{
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_FIELD_NON_NULL(field);
+	BT_ASSERT_PRE_DEV_FIELD_IS_DYNAMIC_BLOB("field", field, "Field");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(field);
+	return set_dynamic_blob_field_length(field, length);
+}
+
 BT_EXPORT
 uint64_t bt_field_blob_get_length(const struct bt_field *field)
 {
@@ -1440,6 +1946,256 @@ uint64_t bt_field_blob_get_length(const struct bt_field *field)
 	return blob_field->length;
 }
 
+BT_ASSERT_COND_DEV_FUNC
+static
+bool field_classes_have_same_structure(const struct bt_field_class *fc_a,
+		const struct bt_field_class *fc_b)
+{
+	bool same = false;
+
+	if (fc_a == fc_b) {
+		same = true;
+		goto end;
+	}
+
+	if (fc_a->type != fc_b->type) {
+		goto end;
+	}
+
+	if (fc_a->type == BT_FIELD_CLASS_TYPE_STRUCTURE ||
+			bt_field_class_type_is(fc_a->type,
+				BT_FIELD_CLASS_TYPE_VARIANT)) {
+		const struct bt_field_class_named_field_class_container *container_fc_a =
+			(const void *) fc_a;
+		const struct bt_field_class_named_field_class_container *container_fc_b =
+			(const void *) fc_b;
+		uint64_t i;
+
+		if (container_fc_a->named_fcs->len !=
+				container_fc_b->named_fcs->len) {
+			goto end;
+		}
+
+		for (i = 0; i < container_fc_a->named_fcs->len; i++) {
+			const struct bt_named_field_class *named_fc_a =
+				container_fc_a->named_fcs->pdata[i];
+			const struct bt_named_field_class *named_fc_b =
+				container_fc_b->named_fcs->pdata[i];
+
+			if (!field_classes_have_same_structure(named_fc_a->fc,
+					named_fc_b->fc)) {
+				goto end;
+			}
+		}
+	} else if (bt_field_class_type_is(fc_a->type,
+			BT_FIELD_CLASS_TYPE_ARRAY)) {
+		const struct bt_field_class_array *array_fc_a = (const void *) fc_a;
+		const struct bt_field_class_array *array_fc_b = (const void *) fc_b;
+
+		if (fc_a->type == BT_FIELD_CLASS_TYPE_STATIC_ARRAY &&
+				((const struct bt_field_class_array_static *) fc_a)->length !=
+				((const struct bt_field_class_array_static *) fc_b)->length) {
+			goto end;
+		}
+
+		if (!field_classes_have_same_structure(array_fc_a->element_fc,
+				array_fc_b->element_fc)) {
+			goto end;
+		}
+	} else if (bt_field_class_type_is(fc_a->type,
+			BT_FIELD_CLASS_TYPE_OPTION)) {
+		const struct bt_field_class_option *opt_fc_a = (const void *) fc_a;
+		const struct bt_field_class_option *opt_fc_b = (const void *) fc_b;
+
+		if (!field_classes_have_same_structure(opt_fc_a->content_fc,
+				opt_fc_b->content_fc)) {
+			goto end;
+		}
+	} else if (fc_a->type == BT_FIELD_CLASS_TYPE_STATIC_BLOB) {
+		if (((const struct bt_field_class_blob_static *) fc_a)->length !=
+				((const struct bt_field_class_blob_static *) fc_b)->length) {
+			goto end;
+		}
+	}
+
+	same = true;
+
+end:
+	return same;
+}
+
+/*
+ * Copies the value of the scalar field `src_field` to `dst_field`,
+ * returning `false` if `type` isn't a scalar field class type.
+ */
+static inline
+bool copy_scalar_field(const struct bt_field *src_field,
+		struct bt_field *dst_field, enum bt_field_class_type type)
+{
+	if (type == BT_FIELD_CLASS_TYPE_BOOL) {
+		((struct bt_field_bool *) dst_field)->value =
+			((const struct bt_field_bool *) src_field)->value;
+	} else if (type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		((struct bt_field_bit_array *) dst_field)->value_as_int =
+			((const struct bt_field_bit_array *) src_field)->value_as_int;
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_INTEGER)) {
+		((struct bt_field_integer *) dst_field)->value =
+			((const struct bt_field_integer *) src_field)->value;
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_REAL)) {
+		((struct bt_field_real *) dst_field)->value =
+			((const struct bt_field_real *) src_field)->value;
+	} else {
+		return false;
+	}
+
+	bt_field_set_single(dst_field, true);
+	return true;
+}
+
+static
+int copy_field(const struct bt_field *src_field, struct bt_field *dst_field)
+{
+	int ret = BT_FUNC_STATUS_OK;
+	enum bt_field_class_type type = src_field->class->type;
+
+	if (copy_scalar_field(src_field, dst_field, type)) {
+		goto end;
+	}
+
+	if (type == BT_FIELD_CLASS_TYPE_STRING) {
+		const struct bt_field_string *src_string_field =
+			(const void *) src_field;
+
+		clear_string_field(dst_field);
+		ret = append_to_string_field_with_length(dst_field,
+			src_string_field->buf, src_string_field->length);
+	} else if (type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		const struct bt_field_structure *src_struct_field =
+			(const void *) src_field;
+		struct bt_field_structure *dst_struct_field = (void *) dst_field;
+		uint64_t i;
+
+		for (i = 0; i < src_struct_field->fields->len; i++) {
+			ret = copy_field(src_struct_field->fields->pdata[i],
+				dst_struct_field->fields->pdata[i]);
+			if (ret) {
+				goto end;
+			}
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_ARRAY)) {
+		const struct bt_field_array *src_array_field =
+			(const void *) src_field;
+		struct bt_field_array *dst_array_field = (void *) dst_field;
+		enum bt_field_class_type elem_type =
+			((struct bt_field_class_array *) src_field->class)->element_fc->type;
+		uint64_t i;
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_DYNAMIC_ARRAY)) {
+			ret = set_dynamic_array_field_length(dst_field,
+				src_array_field->length);
+			if (ret) {
+				goto end;
+			}
+		}
+
+		for (i = 0; i < src_array_field->length; i++) {
+			const struct bt_field *src_elem_field =
+				src_array_field->fields->pdata[i];
+			struct bt_field *dst_elem_field =
+				dst_array_field->fields->pdata[i];
+
+			/* Fast path for the common arrays of scalar fields */
+			if (copy_scalar_field(src_elem_field, dst_elem_field,
+					elem_type)) {
+				continue;
+			}
+
+			ret = copy_field(src_elem_field, dst_elem_field);
+			if (ret) {
+				goto end;
+			}
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_OPTION)) {
+		const struct bt_field_option *src_opt_field =
+			(const void *) src_field;
+		struct bt_field_option *dst_opt_field = (void *) dst_field;
+
+		if (src_opt_field->selected_field) {
+			dst_opt_field->selected_field =
+				dst_opt_field->content_field;
+			ret = copy_field(src_opt_field->selected_field,
+				dst_opt_field->selected_field);
+		} else {
+			dst_opt_field->selected_field = NULL;
+		}
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_VARIANT)) {
+		const struct bt_field_variant *src_var_field =
+			(const void *) src_field;
+		struct bt_field_variant *dst_var_field = (void *) dst_field;
+
+		BT_ASSERT_DBG(src_var_field->selected_field);
+		dst_var_field->selected_index = src_var_field->selected_index;
+		dst_var_field->selected_field =
+			dst_var_field->fields->pdata[dst_var_field->selected_index];
+		ret = copy_field(src_var_field->selected_field,
+			dst_var_field->selected_field);
+	} else if (bt_field_class_type_is(type, BT_FIELD_CLASS_TYPE_BLOB)) {
+		const struct bt_field_blob *src_blob_field =
+			(const void *) src_field;
+		struct bt_field_blob *dst_blob_field = (void *) dst_field;
+
+		if (bt_field_class_type_is(type,
+				BT_FIELD_CLASS_TYPE_DYNAMIC_BLOB)) {
+			ret = set_dynamic_blob_field_length(dst_field,
+				src_blob_field->length);
+			if (ret) {
+				goto end;
+			}
+		}
+
+		BT_ASSERT_DBG(dst_blob_field->length == src_blob_field->length);
+
+		if (src_blob_field->length > 0) {
+			memcpy(dst_blob_field->data, src_blob_field->data,
+				src_blob_field->length);
+		}
+
+		bt_field_set_single(dst_field, true);
+	} else {
+		bt_common_abort();
+	}
+
+end:
+	return ret;
+}
+
+BT_EXPORT
+enum bt_field_copy_status bt_field_copy(const struct bt_field *src_field,
+		struct bt_field *dst_field)
+{
+	int ret;
+
+	BT_ASSERT_PRE_DEV_NO_ERROR();
+	BT_ASSERT_PRE_DEV_NON_NULL("source-field", src_field, "Source field");
+	BT_ASSERT_PRE_DEV_NON_NULL("destination-field", dst_field,
+		"Destination field");
+	BT_ASSERT_PRE_DEV_FIELD_HOT(dst_field);
+	BT_ASSERT_PRE_DEV("field-classes-have-same-structure",
+		field_classes_have_same_structure(src_field->class,
+			dst_field->class),
+		"Source and destination fields have classes with different "
+		"structures: %![src-field-]+f, %![dst-field-]+f",
+		src_field, dst_field);
+	ret = copy_field(src_field, dst_field);
+	if (ret) {
+		BT_LIB_LOGE_APPEND_CAUSE("Cannot copy field: "
+			"%![src-field-]+f, %![dst-field-]+f",
+			src_field, dst_field);
+	}
+
+	return ret;
+}
 
 static inline
 void bt_field_finalize(struct bt_field *field)
@@ -1455,7 +2211,10 @@ void destroy_bool_field(struct bt_field *field)
 	BT_ASSERT(field);
 	BT_LIB_LOGD("Destroying boolean field object: %!+f", field);
 	bt_field_finalize(field);
-	g_free(field);
+
+	if (!field->in_parent_block) {
+		g_free(field);
+	}
 }
 
 static
@@ -1464,7 +2223,10 @@ void destroy_bit_array_field(struct bt_field *field)
 	BT_ASSERT(field);
 	BT_LIB_LOGD("Destroying bit array field object: %!+f", field);
 	bt_field_finalize(field);
-	g_free(field);
+
+	if (!field->in_parent_block) {
+		g_free(field);
+	}
 }
 
 static
@@ -1473,7 +2235,10 @@ void destroy_integer_field(struct bt_field *field)
 	BT_ASSERT(field);
 	BT_LIB_LOGD("Destroying integer field object: %!+f", field);
 	bt_field_finalize(field);
-	g_free(field);
+
+	if (!field->in_parent_block) {
+		g_free(field);
+	}
 }
 
 static
@@ -1482,7 +2247,10 @@ void destroy_real_field(struct bt_field *field)
 	BT_ASSERT(field);
 	BT_LIB_LOGD("Destroying real field object: %!+f", field);
 	bt_field_finalize(field);
-	g_free(field);
+
+	if (!field->in_parent_block) {
+		g_free(field);
+	}
 }
 
 static
@@ -1499,6 +2267,8 @@ void destroy_structure_field(struct bt_field *field)
 		struct_field->fields = NULL;
 	}
 
+	/* After the member fields: some of them live within it */
+	g_free(struct_field->member_block);
 	g_free(field);
 }
 
@@ -1544,7 +2314,9 @@ void destroy_blob_field(struct bt_field *field)
 	BT_LIB_LOGD("Destroying BLOB field object: %!+f", field);
 	bt_field_finalize(field);
 
-	g_free(blob_field->data);
+	if (blob_field->data != blob_field->inline_data) {
+		g_free(blob_field->data);
+	}
 
 	g_free(field);
 }
@@ -1563,6 +2335,12 @@ void destroy_array_field(struct bt_field *field)
 		array_field->fields = NULL;
 	}
 
+	/* After destroying the element fields which they contain */
+	if (array_field->element_blocks) {
+		g_ptr_array_free(array_field->element_blocks, TRUE);
+		array_field->element_blocks = NULL;
+	}
+
 	g_free(field);
 }
 
@@ -1575,11 +2353,12 @@ void destroy_string_field(struct bt_field *field)
 	BT_LIB_LOGD("Destroying string field object: %!+f", field);
 	bt_field_finalize(field);
 
-	if (string_field->buf) {
-		g_array_free(string_field->buf, TRUE);
-		string_field->buf = NULL;
+	if (string_field->buf != string_field->inline_buf) {
+		g_free(string_field->buf);
 	}
 
+	string_field->buf = NULL;
+
 	g_free(field);
 }
 
@@ -40,6 +40,13 @@ struct bt_field {
 
 	bool is_set;
 	bool frozen;
+
+	/*
+	 * Whether or not this field lives within the member block of
+	 * its parent structure field (see `struct bt_field_structure`),
+	 * in which case destroying it doesn't free its memory.
+	 */
+	bool in_parent_block;
 };
 
 struct bt_field_bool {
@@ -71,6 +78,17 @@ struct bt_field_structure {
 
 	/* Array of `struct bt_field *`, owned by this */
 	GPtrArray *fields;
+
+	/*
+	 * Single memory block, owned by this, which contains all the
+	 * boolean, bit array, integer, and real member fields of this
+	 * structure field contiguously, in member order; `NULL` if
+	 * there's no such member.
+	 *
+	 * This avoids one allocation per scalar member and keeps them
+	 * close to each other for sinks which read them all.
+	 */
+	void *member_block;
 };
 
 struct bt_field_option {
@@ -96,27 +114,73 @@ struct bt_field_variant {
 	GPtrArray *fields;
 };
 
+/*
+ * Sizes of the inline buffers of string and BLOB fields: most values
+ * fit, saving one allocation per field and one pointer chase per
+ * access.
+ */
+#define BT_FIELD_STRING_INLINE_BUF_SIZE		32
+#define BT_FIELD_BLOB_INLINE_DATA_SIZE		32
+
 struct bt_field_blob {
 	struct bt_field common;
 
 	uint64_t length;
+
+	/*
+	 * Points to `inline_data` below, or to a heap buffer (owned by
+	 * this) if the data doesn't fit.
+	 */
 	uint8_t *data;
+
+	/* Size of `data` (bytes) */
+	uint64_t capacity;
+
+	uint8_t inline_data[BT_FIELD_BLOB_INLINE_DATA_SIZE];
 };
 
 struct bt_field_array {
 	struct bt_field common;
 
-	/* Array of `struct bt_field *`, owned by this */
+	/*
+	 * Array of `struct bt_field *`, owned by this.
+	 *
+	 * May contain more fields than the current effective length
+	 * below.
+	 */
 	GPtrArray *fields;
 
+	/*
+	 * Array of memory blocks (owned by this) which contain the
+	 * element fields contiguously when their class is a boolean,
+	 * bit array, integer, or real field class, or `NULL` if there's
+	 * no such block.
+	 *
+	 * A static array field has at most one block. A dynamic array
+	 * field gets a new block each time it needs more element fields.
+	 */
+	GPtrArray *element_blocks;
+
 	/* Current effective length */
 	uint64_t length;
 };
 
 struct bt_field_string {
 	struct bt_field common;
-	GArray *buf;
+
+	/*
+	 * Null-terminated value: points to `inline_buf` below, or to a
+	 * heap buffer (owned by this) if the value doesn't fit.
+	 */
+	char *buf;
+
+	/* Size of `buf` (bytes) */
+	uint64_t capacity;
+
+	/* Length of the value, excluding the terminating null character */
 	uint64_t length;
+
+	char inline_buf[BT_FIELD_STRING_INLINE_BUF_SIZE];
 };
 
 #ifdef BT_DEV_MODE
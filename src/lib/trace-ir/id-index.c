@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#define BT_LOG_TAG "LIB/ID-INDEX"
+#include "lib/logging.h"
+
+#include "common/assert.h"
+#include <glib.h>
+#include <inttypes.h>
+#include <stdint.h>
+
+#include "id-index.h"
+
+/*
+ * Maximum length of the dense array of an index of which the number of
+ * objects is `_count`.
+ */
+#define DENSE_MAX_LEN(_count)	(2 * (_count) + 64)
+
+static
+guint hash_id(gconstpointer id)
+{
+	return g_int64_hash(id);
+}
+
+static
+gboolean id_equal(gconstpointer a, gconstpointer b)
+{
+	return *(const uint64_t *) a == *(const uint64_t *) b;
+}
+
+int bt_id_index_init(struct bt_id_index *index)
+{
+	int ret = 0;
+
+	BT_ASSERT(index);
+	index->sparse = NULL;
+	index->count = 0;
+	index->dense = g_ptr_array_new();
+	if (!index->dense) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GPtrArray.");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+void bt_id_index_fini(struct bt_id_index *index)
+{
+	BT_ASSERT(index);
+
+	if (index->dense) {
+		g_ptr_array_free(index->dense, TRUE);
+		index->dense = NULL;
+	}
+
+	if (index->sparse) {
+		g_hash_table_destroy(index->sparse);
+		index->sparse = NULL;
+	}
+}
+
+static
+int insert_sparse(GHashTable *sparse, uint64_t id, void *obj)
+{
+	int ret = 0;
+	uint64_t *key = g_new(uint64_t, 1);
+
+	if (!key) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate one ID.");
+		ret = -1;
+		goto end;
+	}
+
+	*key = id;
+	g_hash_table_insert(sparse, key, obj);
+
+end:
+	return ret;
+}
+
+/*
+ * Moves the objects of the dense array of `index` to a new hash table.
+ */
+static
+int make_sparse(struct bt_id_index *index)
+{
+	int ret = 0;
+	GHashTable *sparse;
+	guint i;
+
+	BT_ASSERT(index->dense);
+	BT_LOGD("Switching ID index to a hash table: index-addr=%p, "
+		"count=%" PRIu64, index, index->count);
+	sparse = g_hash_table_new_full(hash_id, id_equal, g_free, NULL);
+	if (!sparse) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GHashTable.");
+		ret = -1;
+		goto end;
+	}
+
+	for (i = 0; i < index->dense->len; i++) {
+		void *obj = g_ptr_array_index(index->dense, i);
+
+		if (!obj) {
+			continue;
+		}
+
+		ret = insert_sparse(sparse, i, obj);
+		if (ret) {
+			g_hash_table_destroy(sparse);
+			goto end;
+		}
+	}
+
+	g_ptr_array_free(index->dense, TRUE);
+	index->dense = NULL;
+	index->sparse = sparse;
+
+end:
+	return ret;
+}
+
+int bt_id_index_add(struct bt_id_index *index, uint64_t id, void *obj)
+{
+	int ret = 0;
+
+	BT_ASSERT(index);
+	BT_ASSERT(obj);
+	BT_ASSERT_DBG(!bt_id_index_lookup(index, id));
+
+	if (index->dense && id >= DENSE_MAX_LEN(index->count + 1)) {
+		ret = make_sparse(index);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	if (index->dense) {
+		if (id >= index->dense->len) {
+			g_ptr_array_set_size(index->dense, (guint) id + 1);
+		}
+
+		g_ptr_array_index(index->dense, id) = obj;
+	} else {
+		ret = insert_sparse(index->sparse, id, obj);
+		if (ret) {
+			goto end;
+		}
+	}
+
+	index->count++;
+
+end:
+	return ret;
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_LIB_TRACE_IR_ID_INDEX_H
+#define BABELTRACE_LIB_TRACE_IR_ID_INDEX_H
+
+#include <glib.h>
+#include <stdint.h>
+
+/*
+ * Index of objects (event classes of a stream class, stream classes of
+ * a trace class) by numeric ID, for constant-time lookups.
+ *
+ * While the IDs are compact (automatically assigned IDs, for example),
+ * the index is a dense array of which the element at index `id` is the
+ * object having this ID, or `NULL`. As soon as adding an ID would make
+ * this array too sparse, it switches to a hash table for good.
+ *
+ * The index doesn't own the objects.
+ */
+struct bt_id_index {
+	/* Array of objects (weak) indexed by ID, or `NULL` if sparse */
+	GPtrArray *dense;
+
+	/* `uint64_t *` (owned) to object (weak), or `NULL` if dense */
+	GHashTable *sparse;
+
+	/* Number of objects */
+	uint64_t count;
+};
+
+int bt_id_index_init(struct bt_id_index *index);
+
+void bt_id_index_fini(struct bt_id_index *index);
+
+/*
+ * Adds the object `obj` having the ID `id`, which `index` must not
+ * contain yet, to `index`.
+ *
+ * Returns 0 on success or -1 on memory error, in which case `index`
+ * still contains the same objects.
+ */
+int bt_id_index_add(struct bt_id_index *index, uint64_t id, void *obj);
+
+/*
+ * Returns the object having the ID `id` within `index`, or `NULL` if
+ * none.
+ */
+static inline
+void *bt_id_index_lookup(const struct bt_id_index *index, uint64_t id)
+{
+	if (index->dense) {
+		return id < index->dense->len ?
+			g_ptr_array_index(index->dense, id) : NULL;
+	}
+
+	return g_hash_table_lookup(index->sparse, &id);
+}
+
+#endif /* BABELTRACE_LIB_TRACE_IR_ID_INDEX_H */
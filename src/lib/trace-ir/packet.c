@@ -73,10 +73,11 @@ void reset_packet(struct bt_packet *packet)
 {
 	BT_ASSERT(packet);
 	BT_LIB_LOGD("Resetting packet: %!+a", packet);
+
+	/* This also unfreezes the context field, if any */
 	bt_packet_set_is_frozen(packet, false);
 
 	if (packet->context_field) {
-		bt_field_set_is_frozen(packet->context_field->field, false);
 		bt_field_reset(packet->context_field->field);
 	}
 }
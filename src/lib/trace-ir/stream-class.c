@@ -41,6 +41,8 @@ void destroy_stream_class(struct bt_object *obj)
 	BT_OBJECT_PUT_REF_AND_RESET(stream_class->user_attributes);
 	BT_OBJECT_PUT_REF_AND_RESET(stream_class->default_clock_class);
 
+	bt_id_index_fini(&stream_class->event_class_index);
+
 	if (stream_class->event_classes) {
 		BT_LOGD_STR("Destroying event classes.");
 		g_ptr_array_free(stream_class->event_classes, TRUE);
@@ -68,21 +70,7 @@ void free_field_wrapper(struct bt_field_wrapper *field_wrapper,
 static
 bool stream_class_id_is_unique(const struct bt_trace_class *tc, uint64_t id)
 {
-	uint64_t i;
-	bool is_unique = true;
-
-	for (i = 0; i < tc->stream_classes->len; i++) {
-		const struct bt_stream_class *sc =
-			tc->stream_classes->pdata[i];
-
-		if (sc->id == id) {
-			is_unique = false;
-			goto end;
-		}
-	}
-
-end:
-	return is_unique;
+	return !bt_id_index_lookup(&tc->stream_class_index, id);
 }
 
 static
@@ -124,6 +112,12 @@ struct bt_stream_class *create_stream_class_with_id(
 		goto error;
 	}
 
+	ret = bt_id_index_init(&stream_class->event_class_index);
+	if (ret) {
+		/* bt_id_index_init() logs errors */
+		goto error;
+	}
+
 	ret = bt_object_pool_initialize(&stream_class->packet_context_field_pool,
 		(bt_object_pool_new_object_func) bt_field_wrapper_new,
 		(bt_object_pool_destroy_object_func) free_field_wrapper,
@@ -135,6 +129,12 @@ struct bt_stream_class *create_stream_class_with_id(
 		goto error;
 	}
 
+	ret = bt_id_index_add(&tc->stream_class_index, id, stream_class);
+	if (ret) {
+		/* bt_id_index_add() logs errors */
+		goto error;
+	}
+
 	bt_object_set_parent(&stream_class->base, &tc->base);
 	g_ptr_array_add(tc->stream_classes, stream_class);
 	bt_trace_class_freeze(tc);
@@ -298,23 +298,8 @@ BT_EXPORT
 struct bt_event_class *bt_stream_class_borrow_event_class_by_id(
 		struct bt_stream_class *stream_class, uint64_t id)
 {
-	struct bt_event_class *event_class = NULL;
-	uint64_t i;
-
 	BT_ASSERT_PRE_DEV_SC_NON_NULL(stream_class);
-
-	for (i = 0; i < stream_class->event_classes->len; i++) {
-		struct bt_event_class *event_class_candidate =
-			g_ptr_array_index(stream_class->event_classes, i);
-
-		if (event_class_candidate->id == id) {
-			event_class = event_class_candidate;
-			goto end;
-		}
-	}
-
-end:
-	return event_class;
+	return bt_id_index_lookup(&stream_class->event_class_index, id);
 }
 
 BT_EXPORT
@@ -369,6 +354,18 @@ bt_stream_class_set_packet_context_field_class(
 	BT_ASSERT_PRE_DEV_STREAM_CLASS_HOT(stream_class);
 	BT_ASSERT_PRE_FC_IS_STRUCT("field-class", field_class,
 		"Packet context field class");
+
+	if (field_class->part_of_trace_class) {
+		/* Shared field class: its field paths are already resolved */
+		BT_ASSERT_PRE("field-class-is-shareable",
+			bt_field_class_is_shareable_as_scope_root(field_class,
+				BT_FIELD_PATH_SCOPE_PACKET_CONTEXT),
+			"Field class is part of a trace class, but isn't a "
+			"packet context field class which you can share: %!+F",
+			field_class);
+		goto set;
+	}
+
 	resolve_status = bt_resolve_field_paths(field_class, &resolve_ctx, __func__);
 	if (resolve_status != BT_RESOLVE_FIELD_XREF_STATUS_OK) {
 		status = (int) resolve_status;
@@ -376,6 +373,10 @@ bt_stream_class_set_packet_context_field_class(
 	}
 
 	bt_field_class_make_part_of_trace_class(field_class);
+	bt_field_class_set_scope_root(field_class,
+		BT_FIELD_PATH_SCOPE_PACKET_CONTEXT);
+
+set:
 	bt_object_put_ref(stream_class->packet_context_fc);
 	stream_class->packet_context_fc = field_class;
 	bt_object_get_ref_no_null_check(stream_class->packet_context_fc);
@@ -428,6 +429,18 @@ bt_stream_class_set_event_common_context_field_class(
 	BT_ASSERT_PRE_DEV_STREAM_CLASS_HOT(stream_class);
 	BT_ASSERT_PRE_FC_IS_STRUCT("field-class", field_class,
 		"Event common context field class");
+
+	if (field_class->part_of_trace_class) {
+		/* Shared field class: its field paths are already resolved */
+		BT_ASSERT_PRE("field-class-is-shareable",
+			bt_field_class_is_shareable_as_scope_root(field_class,
+				BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT),
+			"Field class is part of a trace class, but isn't an "
+			"event common context field class which you can share: "
+			"%!+F", field_class);
+		goto set;
+	}
+
 	resolve_ctx.packet_context = stream_class->packet_context_fc;
 	resolve_status = bt_resolve_field_paths(field_class, &resolve_ctx, __func__);
 	if (resolve_status != BT_RESOLVE_FIELD_XREF_STATUS_OK) {
@@ -436,6 +449,10 @@ bt_stream_class_set_event_common_context_field_class(
 	}
 
 	bt_field_class_make_part_of_trace_class(field_class);
+	bt_field_class_set_scope_root(field_class,
+		BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT);
+
+set:
 	bt_object_put_ref(stream_class->event_common_context_fc);
 	stream_class->event_common_context_fc = field_class;
 	bt_object_get_ref_no_null_check(stream_class->event_common_context_fc);
@@ -16,6 +16,7 @@
 #include <stdbool.h>
 
 #include "field-class.h"
+#include "id-index.h"
 
 struct bt_stream_class {
 	struct bt_object base;
@@ -44,6 +45,9 @@ struct bt_stream_class {
 	/* Array of `struct bt_event_class *` */
 	GPtrArray *event_classes;
 
+	/* Event classes of `event_classes` by ID */
+	struct bt_id_index event_class_index;
+
 	/* Pool of `struct bt_field_wrapper *` */
 	struct bt_object_pool packet_context_field_pool;
 
@@ -103,6 +103,8 @@ void destroy_trace_class(struct bt_object *obj)
 		}
 	}
 
+	bt_id_index_fini(&tc->stream_class_index);
+
 	if (tc->stream_classes) {
 		BT_LOGD_STR("Destroying stream classes.");
 		g_ptr_array_free(tc->stream_classes, TRUE);
@@ -145,6 +147,11 @@ struct bt_trace_class *bt_trace_class_create(bt_self_component *self_comp)
 		goto error;
 	}
 
+	if (bt_id_index_init(&tc->stream_class_index)) {
+		/* bt_id_index_init() logs errors */
+		goto error;
+	}
+
 	tc->destruction_listeners = g_array_new(FALSE, TRUE,
 		sizeof(struct bt_trace_class_destruction_listener_elem));
 	if (!tc->destruction_listeners) {
@@ -270,23 +277,8 @@ BT_EXPORT
 struct bt_stream_class *bt_trace_class_borrow_stream_class_by_id(
 		struct bt_trace_class *tc, uint64_t id)
 {
-	struct bt_stream_class *stream_class = NULL;
-	uint64_t i;
-
 	BT_ASSERT_PRE_DEV_TC_NON_NULL(tc);
-
-	for (i = 0; i < tc->stream_classes->len; i++) {
-		struct bt_stream_class *stream_class_candidate =
-			g_ptr_array_index(tc->stream_classes, i);
-
-		if (stream_class_candidate->id == id) {
-			stream_class = stream_class_candidate;
-			goto end;
-		}
-	}
-
-end:
-	return stream_class;
+	return bt_id_index_lookup(&tc->stream_class_index, id);
 }
 
 BT_EXPORT
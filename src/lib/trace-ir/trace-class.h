@@ -18,6 +18,8 @@
 #include <sys/types.h>
 #include <stdbool.h>
 
+#include "id-index.h"
+
 struct bt_trace_class {
 	struct bt_object base;
 
@@ -30,6 +32,9 @@ struct bt_trace_class {
 	/* Array of `struct bt_stream_class *` */
 	GPtrArray *stream_classes;
 
+	/* Stream classes of `stream_classes` by ID */
+	struct bt_id_index stream_class_index;
+
 	bool assigns_automatic_stream_class_id;
 	GArray *destruction_listeners;
 	bool frozen;
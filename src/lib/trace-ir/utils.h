@@ -76,19 +76,21 @@ end:
 	return overflows;
 }
 
+/*
+ * Sets `*ns_from_origin` to `base_offset_ns` plus `value_ns_unsigned`,
+ * returning -1 on overflow.
+ */
 static inline
-int bt_util_ns_from_origin_inline(int64_t base_offset_ns,
-		uint64_t frequency, uint64_t value, int64_t *ns_from_origin)
+int bt_util_ns_from_origin_add_value_ns(int64_t base_offset_ns,
+		uint64_t value_ns_unsigned, int64_t *ns_from_origin)
 {
 	int ret = 0;
-	uint64_t value_ns_unsigned;
 	int64_t value_ns_signed;
 
 	/* Initialize to clock class's base offset */
 	*ns_from_origin = base_offset_ns;
 
-	/* Add given value in cycles */
-	value_ns_unsigned = bt_util_ns_from_value(frequency, value);
+	/* Add given value */
 	if (value_ns_unsigned >= (uint64_t) INT64_MAX) {
 		/*
 		 * FIXME: `value_ns_unsigned` could be greater than
@@ -121,6 +123,14 @@ end:
 	return ret;
 }
 
+static inline
+int bt_util_ns_from_origin_inline(int64_t base_offset_ns,
+		uint64_t frequency, uint64_t value, int64_t *ns_from_origin)
+{
+	return bt_util_ns_from_origin_add_value_ns(base_offset_ns,
+		bt_util_ns_from_value(frequency, value), ns_from_origin);
+}
+
 static inline
 int bt_util_ns_from_origin_clock_class(const struct bt_clock_class *clock_class,
 		uint64_t value, int64_t *ns_from_origin)
@@ -132,8 +142,10 @@ int bt_util_ns_from_origin_clock_class(const struct bt_clock_class *clock_class,
 		goto end;
 	}
 
-	ret = bt_util_ns_from_origin_inline(clock_class->base_offset.value_ns,
-		clock_class->frequency, value, ns_from_origin);
+	ret = bt_util_ns_from_origin_add_value_ns(
+		clock_class->base_offset.value_ns,
+		bt_common_cycles_to_ns(&clock_class->cycles_to_ns, value),
+		ns_from_origin);
 
 end:
 	return ret;
@@ -36,6 +36,10 @@
 #define BT_VALUE_TO_ARRAY(_base) ((struct bt_value_array *) (_base))
 #define BT_VALUE_TO_MAP(_base) ((struct bt_value_map *) (_base))
 
+#define BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(_builder)		\
+	BT_ASSERT_PRE_NON_NULL("map-value-builder", (_builder),		\
+		"Map value builder")
+
 static
 void bt_value_null_instance_release_func(struct bt_object *obj)
 {
@@ -80,16 +84,57 @@ void bt_value_array_destroy(struct bt_value *object)
 	BT_VALUE_TO_ARRAY(object)->garray = NULL;
 }
 
+static inline
+bool map_value_is_compact(const struct bt_value *map_obj)
+{
+	return !BT_VALUE_TO_MAP(map_obj)->ght;
+}
+
+/*
+ * Returns whether or not `element_obj` lives within the memory block
+ * of the compact map `map_obj`.
+ */
+static inline
+bool value_is_compact_map_child(const struct bt_value *map_obj,
+		const struct bt_value *element_obj)
+{
+	return element_obj->base.parent == &map_obj->base;
+}
+
 static
 void bt_value_map_destroy(struct bt_value *object)
 {
+	struct bt_value_map *typed_map_obj = BT_VALUE_TO_MAP(object);
+
+	if (map_value_is_compact(object)) {
+		uint64_t i;
+
+		/*
+		 * The children live within the memory block of the
+		 * map, which bt_value_destroy() frees: only put the
+		 * other values.
+		 */
+		for (i = 0; i < typed_map_obj->compact_entry_count; i++) {
+			struct bt_value *element_obj =
+				typed_map_obj->compact_entries[i].value;
+
+			if (!value_is_compact_map_child(object, element_obj)) {
+				bt_object_put_ref_no_null_check(element_obj);
+			}
+		}
+
+		typed_map_obj->compact_entries = NULL;
+		typed_map_obj->compact_entry_count = 0;
+		return;
+	}
+
 	/*
 	 * Hash table's registered value destructor will take care of
 	 * putting each contained object. Keys are GQuarks and cannot
 	 * be destroyed anyway.
 	 */
-	g_hash_table_destroy(BT_VALUE_TO_MAP(object)->ght);
-	BT_VALUE_TO_MAP(object)->ght = NULL;
+	g_hash_table_destroy(typed_map_obj->ght);
+	typed_map_obj->ght = NULL;
 }
 
 static
@@ -200,54 +245,91 @@ end:
 	return copy_obj;
 }
 
+/*
+ * Copies the entry having the key `key_str` and the value
+ * `element_obj` of the map value `map_obj` into the map value
+ * `copy_obj`.
+ */
 static
-struct bt_value *bt_value_map_copy(const struct bt_value *map_obj)
+int copy_map_entry(const struct bt_value *map_obj, struct bt_value *copy_obj,
+		const char *key_str, const struct bt_value *element_obj)
 {
 	int ret;
+	struct bt_value *element_obj_copy = NULL;
+
+	BT_ASSERT(key_str);
+	BT_LOGD("Copying map value's element: element-addr=%p, "
+		"key=\"%s\"", element_obj, key_str);
+	ret = bt_value_copy(element_obj, &element_obj_copy);
+	if (ret) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Cannot copy map value's element: "
+			"map-addr=%p, key=\"%s\"",
+			map_obj, key_str);
+		goto end;
+	}
+
+	BT_ASSERT(element_obj_copy);
+	ret = bt_value_map_insert_entry(copy_obj, key_str,
+		(void *) element_obj_copy);
+	BT_OBJECT_PUT_REF_AND_RESET(element_obj_copy);
+	if (ret) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Cannot insert into map value: addr=%p, key=\"%s\"",
+			map_obj, key_str);
+		goto end;
+	}
+
+end:
+	return ret;
+}
+
+static
+struct bt_value *bt_value_map_copy(const struct bt_value *map_obj)
+{
 	GHashTableIter iter;
 	gpointer key, element_obj;
 	struct bt_value *copy_obj;
-	struct bt_value *element_obj_copy = NULL;
 	struct bt_value_map *typed_map_obj;
 
 	BT_LOGD("Copying map value: addr=%p", map_obj);
 	typed_map_obj = BT_VALUE_TO_MAP(map_obj);
+
+	/* The copy of a compact map value is a regular map value */
 	copy_obj = bt_value_map_create();
 	if (!copy_obj) {
 		goto end;
 	}
 
-	g_hash_table_iter_init(&iter, typed_map_obj->ght);
+	if (map_value_is_compact(map_obj)) {
+		uint64_t i;
 
-	while (g_hash_table_iter_next(&iter, &key, &element_obj)) {
-		const char *key_str = g_quark_to_string(GPOINTER_TO_UINT(key));
+		for (i = 0; i < typed_map_obj->compact_entry_count; i++) {
+			const struct bt_value_map_compact_entry *entry =
+				&typed_map_obj->compact_entries[i];
 
-		BT_ASSERT(key_str);
-		BT_LOGD("Copying map value's element: element-addr=%p, "
-			"key=\"%s\"", element_obj, key_str);
-		ret = bt_value_copy(element_obj, &element_obj_copy);
-		if (ret) {
-			BT_LIB_LOGE_APPEND_CAUSE(
-				"Cannot copy map value's element: "
-				"map-addr=%p, key=\"%s\"",
-				map_obj, key_str);
-			BT_OBJECT_PUT_REF_AND_RESET(copy_obj);
-			goto end;
+			if (copy_map_entry(map_obj, copy_obj, entry->key,
+					entry->value)) {
+				BT_OBJECT_PUT_REF_AND_RESET(copy_obj);
+				goto end;
+			}
 		}
 
-		BT_ASSERT(element_obj_copy);
-		ret = bt_value_map_insert_entry(copy_obj, key_str,
-			(void *) element_obj_copy);
-		BT_OBJECT_PUT_REF_AND_RESET(element_obj_copy);
-		if (ret) {
-			BT_LIB_LOGE_APPEND_CAUSE(
-				"Cannot insert into map value: addr=%p, key=\"%s\"",
-				map_obj, key_str);
+		goto copied;
+	}
+
+	g_hash_table_iter_init(&iter, typed_map_obj->ght);
+
+	while (g_hash_table_iter_next(&iter, &key, &element_obj)) {
+		if (copy_map_entry(map_obj, copy_obj,
+				g_quark_to_string(GPOINTER_TO_UINT(key)),
+				element_obj)) {
 			BT_OBJECT_PUT_REF_AND_RESET(copy_obj);
 			goto end;
 		}
 	}
 
+copied:
 	BT_LOGD("Copied map value: addr=%p", map_obj);
 
 end:
@@ -394,6 +476,29 @@ end:
 	return ret;
 }
 
+/*
+ * Returns whether or not the map value `object_b` has an entry with the
+ * key `key_str` and a value equal to `element_obj_a`.
+ */
+static
+bt_bool map_entry_is_equal(const struct bt_value *object_a,
+		const struct bt_value *object_b, const char *key_str,
+		const struct bt_value *element_obj_a)
+{
+	const struct bt_value *element_obj_b =
+		bt_value_map_borrow_entry_value_const(object_b, key_str);
+
+	if (!element_obj_b ||
+			!bt_value_is_equal(element_obj_a, element_obj_b)) {
+		BT_LOGT("Map values's elements are different: "
+			"value-a-addr=%p, value-b-addr=%p, key=\"%s\"",
+			object_a, object_b, key_str);
+		return BT_FALSE;
+	}
+
+	return BT_TRUE;
+}
+
 static
 bt_bool bt_value_map_is_equal(const struct bt_value *object_a,
 		const struct bt_value *object_b)
@@ -415,19 +520,29 @@ bt_bool bt_value_map_is_equal(const struct bt_value *object_a,
 		goto end;
 	}
 
-	g_hash_table_iter_init(&iter, map_obj_a->ght);
+	if (map_value_is_compact(object_a)) {
+		uint64_t i;
 
-	while (g_hash_table_iter_next(&iter, &key, &element_obj_a)) {
-		const struct bt_value *element_obj_b;
-		const char *key_str = g_quark_to_string(GPOINTER_TO_UINT(key));
+		for (i = 0; i < map_obj_a->compact_entry_count; i++) {
+			const struct bt_value_map_compact_entry *entry =
+				&map_obj_a->compact_entries[i];
 
-		element_obj_b = bt_value_map_borrow_entry_value_const(object_b,
-			key_str);
+			if (!map_entry_is_equal(object_a, object_b, entry->key,
+					entry->value)) {
+				ret = BT_FALSE;
+				goto end;
+			}
+		}
 
-		if (!bt_value_is_equal(element_obj_a, element_obj_b)) {
-			BT_LOGT("Map values's elements are different: "
-				"value-a-addr=%p, value-b-addr=%p, key=\"%s\"",
-				element_obj_a, element_obj_b, key_str);
+		goto end;
+	}
+
+	g_hash_table_iter_init(&iter, map_obj_a->ght);
+
+	while (g_hash_table_iter_next(&iter, &key, &element_obj_a)) {
+		if (!map_entry_is_equal(object_a, object_b,
+				g_quark_to_string(GPOINTER_TO_UINT(key)),
+				element_obj_a)) {
 			ret = BT_FALSE;
 			goto end;
 		}
@@ -893,6 +1008,15 @@ enum bt_value_string_set_status bt_value_string_set(
 	BT_ASSERT_PRE_VALUE_NON_NULL(string_obj);
 	BT_ASSERT_PRE_VALUE_IS_STRING(string_obj);
 	BT_ASSERT_PRE_DEV_VALUE_HOT(string_obj);
+
+	/*
+	 * Always check this one: the raw value of a string value of a
+	 * compact map value isn't a regular `GString`.
+	 */
+	BT_ASSERT_PRE("value-object-is-not-in-compact-map",
+		!string_obj->base.parent,
+		"String value object is an entry value of a compact map value: "
+		"%!+v", string_obj);
 	g_string_assign(BT_VALUE_TO_STRING(string_obj)->gstr, val);
 	BT_LOGT("Set string value's raw value: value-addr=%p, raw-value-addr=%p",
 		string_obj, val);
@@ -1118,9 +1242,44 @@ uint64_t bt_value_map_get_size(const struct bt_value *map_obj)
 {
 	BT_ASSERT_PRE_DEV_VALUE_NON_NULL(map_obj);
 	BT_ASSERT_PRE_DEV_VALUE_IS_MAP(map_obj);
+
+	if (map_value_is_compact(map_obj)) {
+		return BT_VALUE_TO_MAP(map_obj)->compact_entry_count;
+	}
+
 	return (uint64_t) g_hash_table_size(BT_VALUE_TO_MAP(map_obj)->ght);
 }
 
+/*
+ * Binary searches the entries of the compact map value `map_obj` for
+ * the key `key`, returning `NULL` if not found.
+ */
+static
+struct bt_value *borrow_compact_map_entry_value(
+		const struct bt_value *map_obj, const char *key)
+{
+	const struct bt_value_map *typed_map_obj = BT_VALUE_TO_MAP(map_obj);
+	uint64_t begin = 0;
+	uint64_t end = typed_map_obj->compact_entry_count;
+
+	while (begin < end) {
+		const uint64_t mid = begin + (end - begin) / 2;
+		const struct bt_value_map_compact_entry *entry =
+			&typed_map_obj->compact_entries[mid];
+		const int cmp = strcmp(key, entry->key);
+
+		if (cmp == 0) {
+			return entry->value;
+		} else if (cmp < 0) {
+			end = mid;
+		} else {
+			begin = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
 BT_EXPORT
 struct bt_value *bt_value_map_borrow_entry_value(struct bt_value *map_obj,
 		const char *key)
@@ -1128,6 +1287,11 @@ struct bt_value *bt_value_map_borrow_entry_value(struct bt_value *map_obj,
 	BT_ASSERT_PRE_DEV_VALUE_NON_NULL(map_obj);
 	BT_ASSERT_PRE_DEV_KEY_NON_NULL(key);
 	BT_ASSERT_PRE_DEV_VALUE_IS_MAP(map_obj);
+
+	if (map_value_is_compact(map_obj)) {
+		return borrow_compact_map_entry_value(map_obj, key);
+	}
+
 	return g_hash_table_lookup(BT_VALUE_TO_MAP(map_obj)->ght,
 		GUINT_TO_POINTER(g_quark_from_string(key)));
 }
@@ -1145,6 +1309,11 @@ bt_bool bt_value_map_has_entry(const struct bt_value *map_obj, const char *key)
 	BT_ASSERT_PRE_DEV_VALUE_NON_NULL(map_obj);
 	BT_ASSERT_PRE_DEV_KEY_NON_NULL(key);
 	BT_ASSERT_PRE_DEV_VALUE_IS_MAP(map_obj);
+
+	if (map_value_is_compact(map_obj)) {
+		return borrow_compact_map_entry_value(map_obj, key) != NULL;
+	}
+
 	return bt_g_hash_table_contains(BT_VALUE_TO_MAP(map_obj)->ght,
 		GUINT_TO_POINTER(g_quark_from_string(key)));
 }
@@ -1163,6 +1332,9 @@ enum bt_value_map_insert_entry_status insert_map_value_entry(
 	BT_ASSERT_PRE_VALUE_HAS_TYPE_FROM_FUNC(api_func, "value-object",
 		map_obj, "map", BT_VALUE_TYPE_MAP);
 	BT_ASSERT_PRE_DEV_VALUE_HOT_FROM_FUNC(api_func, map_obj);
+	BT_ASSERT_PRE_FROM_FUNC(api_func, "map-value-object-is-not-compact",
+		!map_value_is_compact(map_obj),
+		"Map value object is compact: %!+v", map_obj);
 	g_hash_table_insert(BT_VALUE_TO_MAP(map_obj)->ght,
 		GUINT_TO_POINTER(g_quark_from_string(key)), element_obj);
 	bt_object_get_ref(element_obj);
@@ -1308,6 +1480,48 @@ bt_value_map_insert_empty_map_entry(struct bt_value *map_obj, const char *key,
 	return ret;
 }
 
+/*
+ * Calls the user function `func` for one map value entry, returning
+ * the (possibly converted) status.
+ */
+static
+int call_foreach_map_entry_func(bt_value_map_foreach_entry_func func,
+		const char *key_str, struct bt_value *element_obj, void *data,
+		const char *user_func_name)
+{
+	int status = func(key_str, element_obj, data);
+
+	BT_ASSERT_POST_NO_ERROR_IF_NO_ERROR_STATUS(user_func_name, status);
+	if (status != BT_FUNC_STATUS_OK) {
+		if (status < 0) {
+			BT_LIB_LOGE_APPEND_CAUSE(
+				"User function failed while iterating "
+				"map value entries: "
+				"status=%s, key=\"%s\", "
+				"value-addr=%p, data=%p",
+				bt_common_func_status_string(status),
+				key_str, element_obj, data);
+
+			if (status == BT_FUNC_STATUS_ERROR) {
+				/*
+				 * User function error becomes a user
+				 * error from this function's caller's
+				 * perspective.
+				 */
+				status = BT_FUNC_STATUS_USER_ERROR;
+			}
+		} else {
+			BT_ASSERT(status == BT_FUNC_STATUS_INTERRUPTED);
+			BT_LOGT("User interrupted the loop: status=%s, "
+				"key=\"%s\", value-addr=%p, data=%p",
+				bt_common_func_status_string(status),
+				key_str, element_obj, data);
+		}
+	}
+
+	return status;
+}
+
 static
 enum bt_value_map_foreach_entry_status foreach_map_entry(
 		struct bt_value *map_obj, bt_value_map_foreach_entry_func func,
@@ -1325,45 +1539,37 @@ enum bt_value_map_foreach_entry_status foreach_map_entry(
 		func, "User function");
 	BT_ASSERT_PRE_VALUE_HAS_TYPE_FROM_FUNC(api_func, "value-object",
 		map_obj, "map", BT_VALUE_TYPE_MAP);
-	g_hash_table_iter_init(&iter, typed_map_obj->ght);
 
-	while (g_hash_table_iter_next(&iter, &key, &element_obj)) {
-		const char *key_str = g_quark_to_string(GPOINTER_TO_UINT(key));
+	if (map_value_is_compact(map_obj)) {
+		uint64_t i;
 
-		status = func(key_str, element_obj, data);
-		BT_ASSERT_POST_NO_ERROR_IF_NO_ERROR_STATUS(user_func_name,
-			status);
-		if (status != BT_FUNC_STATUS_OK) {
-			if (status < 0) {
-				BT_LIB_LOGE_APPEND_CAUSE(
-					"User function failed while iterating "
-					"map value entries: "
-					"status=%s, key=\"%s\", "
-					"value-addr=%p, data=%p",
-					bt_common_func_status_string(status),
-					key_str, element_obj, data);
-
-				if (status == BT_FUNC_STATUS_ERROR) {
-					/*
-					 * User function error becomes a
-					 * user error from this
-					 * function's caller's
-					 * perspective.
-					 */
-					status = BT_FUNC_STATUS_USER_ERROR;
-				}
-			} else {
-				BT_ASSERT(status == BT_FUNC_STATUS_INTERRUPTED);
-				BT_LOGT("User interrupted the loop: status=%s, "
-					"key=\"%s\", value-addr=%p, data=%p",
-					bt_common_func_status_string(status),
-					key_str, element_obj, data);
+		/* Compact map value: key order */
+		for (i = 0; i < typed_map_obj->compact_entry_count; i++) {
+			const struct bt_value_map_compact_entry *entry =
+				&typed_map_obj->compact_entries[i];
+
+			status = call_foreach_map_entry_func(func, entry->key,
+				entry->value, data, user_func_name);
+			if (status != BT_FUNC_STATUS_OK) {
+				break;
 			}
+		}
+
+		goto end;
+	}
 
+	g_hash_table_iter_init(&iter, typed_map_obj->ght);
+
+	while (g_hash_table_iter_next(&iter, &key, &element_obj)) {
+		status = call_foreach_map_entry_func(func,
+			g_quark_to_string(GPOINTER_TO_UINT(key)), element_obj,
+			data, user_func_name);
+		if (status != BT_FUNC_STATUS_OK) {
 			break;
 		}
 	}
 
+end:
 	return status;
 }
 
@@ -1472,6 +1678,507 @@ enum bt_value_map_extend_status bt_value_map_extend(
 	return status;
 }
 
+/*
+ * Scalar value within the memory block of a compact map value.
+ */
+union compact_map_scalar {
+	struct bt_value_bool bool_obj;
+	struct bt_value_integer integer_obj;
+	struct bt_value_real real_obj;
+
+	struct {
+		struct bt_value_string obj;
+
+		/* `obj.gstr` points to this; `str` points within the block */
+		GString gstr;
+	} string;
+};
+
+struct compact_map_sort_entry {
+	const char *key;
+
+	/* Index of the builder entry */
+	guint index;
+};
+
+static
+int compare_compact_map_sort_entries(const void *a, const void *b)
+{
+	const struct compact_map_sort_entry *entry_a = a;
+	const struct compact_map_sort_entry *entry_b = b;
+	const int cmp = strcmp(entry_a->key, entry_b->key);
+
+	if (cmp != 0) {
+		return cmp;
+	}
+
+	/* Same key: keep the insertion order */
+	return entry_a->index < entry_b->index ? -1 :
+		entry_a->index > entry_b->index;
+}
+
+static
+void compact_map_child_release(struct bt_object *obj __attribute__((unused)))
+{
+	/*
+	 * Never called: a compact map value child always has its
+	 * parent, which frees it with its own memory block.
+	 */
+}
+
+static
+void init_compact_map_child(struct bt_value *child, enum bt_value_type type,
+		struct bt_value_map *map_obj)
+{
+	child->type = type;
+	child->frozen = BT_TRUE;
+	bt_object_init_shared_with_parent(&child->base,
+		compact_map_child_release);
+
+	/*
+	 * The map value owns its child: the child only gets a reference
+	 * on its parent when someone gets a reference on the child.
+	 */
+	child->base.ref_count = 0;
+	child->base.parent = &map_obj->base.base;
+}
+
+static inline
+size_t align_size(size_t size, size_t align)
+{
+	return (size + align - 1) / align * align;
+}
+
+/*
+ * Copies the null-terminated string `str` to `*chars`, advancing
+ * `*chars`, and returns the copy.
+ */
+static inline
+char *copy_compact_map_chars(char **chars, const char *str, size_t len)
+{
+	char *copy = *chars;
+
+	memcpy(copy, str, len + 1);
+	*chars += len + 1;
+	return copy;
+}
+
+static
+void reset_map_builder(struct bt_value_map_builder *builder)
+{
+	guint i;
+
+	for (i = 0; i < builder->entries->len; i++) {
+		struct bt_value_map_builder_entry *entry =
+			&g_array_index(builder->entries,
+				struct bt_value_map_builder_entry, i);
+
+		if (entry->type == BT_VALUE_TYPE_ARRAY ||
+				entry->type == BT_VALUE_TYPE_MAP) {
+			bt_object_put_ref_no_null_check(entry->value.obj);
+		}
+	}
+
+	g_array_set_size(builder->entries, 0);
+	g_string_truncate(builder->chars, 0);
+}
+
+static
+void destroy_map_builder(struct bt_object *obj)
+{
+	struct bt_value_map_builder *builder = (void *) obj;
+
+	BT_LOGD("Destroying map value builder: addr=%p", builder);
+
+	if (builder->entries) {
+		reset_map_builder(builder);
+		g_array_free(builder->entries, TRUE);
+		builder->entries = NULL;
+	}
+
+	if (builder->chars) {
+		g_string_free(builder->chars, TRUE);
+		builder->chars = NULL;
+	}
+
+	g_free(builder);
+}
+
+BT_EXPORT
+struct bt_value_map_builder *bt_value_map_builder_create(void)
+{
+	struct bt_value_map_builder *builder;
+
+	BT_ASSERT_PRE_NO_ERROR();
+
+	BT_LOGD_STR("Creating map value builder.");
+	builder = g_new0(struct bt_value_map_builder, 1);
+	if (!builder) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate one map value builder.");
+		goto error;
+	}
+
+	bt_object_init_shared(&builder->base, destroy_map_builder);
+	builder->entries = g_array_new(FALSE, FALSE,
+		sizeof(struct bt_value_map_builder_entry));
+	if (!builder->entries) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GArray.");
+		goto error;
+	}
+
+	builder->chars = g_string_new(NULL);
+	if (!builder->chars) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate a GString.");
+		goto error;
+	}
+
+	BT_LOGD("Created map value builder: addr=%p", builder);
+	goto end;
+
+error:
+	BT_OBJECT_PUT_REF_AND_RESET(builder);
+
+end:
+	return builder;
+}
+
+/*
+ * Appends the null-terminated string `str` to the characters of
+ * `builder`, returning its offset.
+ */
+static
+size_t append_map_builder_chars(struct bt_value_map_builder *builder,
+		const char *str)
+{
+	const size_t offset = builder->chars->len;
+
+	g_string_append_len(builder->chars, str, strlen(str) + 1);
+	return offset;
+}
+
+static
+struct bt_value_map_builder_entry *add_map_builder_entry(
+		struct bt_value_map_builder *builder, const char *key,
+		enum bt_value_type type)
+{
+	struct bt_value_map_builder_entry entry;
+
+	entry.key_offset = append_map_builder_chars(builder, key);
+	entry.type = type;
+	g_array_append_val(builder->entries, entry);
+	return &g_array_index(builder->entries,
+		struct bt_value_map_builder_entry, builder->entries->len - 1);
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status bt_value_map_builder_add_entry(
+		struct bt_value_map_builder *builder, const char *key,
+		const struct bt_value *entry_value)
+{
+	struct bt_value_map_builder_entry *entry;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	BT_ASSERT_PRE_NON_NULL("element-value-object", entry_value,
+		"Element value object");
+	entry = add_map_builder_entry(builder, key, entry_value->type);
+
+	switch (entry_value->type) {
+	case BT_VALUE_TYPE_NULL:
+		break;
+	case BT_VALUE_TYPE_BOOL:
+		entry->value.b = BT_VALUE_TO_BOOL(entry_value)->value;
+		break;
+	case BT_VALUE_TYPE_UNSIGNED_INTEGER:
+	case BT_VALUE_TYPE_SIGNED_INTEGER:
+		entry->value.u = BT_VALUE_TO_INTEGER(entry_value)->value.u;
+		break;
+	case BT_VALUE_TYPE_REAL:
+		entry->value.r = BT_VALUE_TO_REAL(entry_value)->value;
+		break;
+	case BT_VALUE_TYPE_STRING:
+		entry->value.str_offset = append_map_builder_chars(builder,
+			BT_VALUE_TO_STRING(entry_value)->gstr->str);
+		break;
+	case BT_VALUE_TYPE_ARRAY:
+	case BT_VALUE_TYPE_MAP:
+		entry->value.obj = (void *) entry_value;
+		bt_object_get_ref_no_null_check(entry_value);
+		bt_value_freeze(entry_value);
+		break;
+	default:
+		bt_common_abort();
+	}
+
+	BT_LOGT("Added entry to map value builder: builder-addr=%p, "
+		"key=\"%s\", element-value-addr=%p",
+		builder, key, entry_value);
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_bool_entry(struct bt_value_map_builder *builder,
+		const char *key, bt_bool val)
+{
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	add_map_builder_entry(builder, key, BT_VALUE_TYPE_BOOL)->value.b = val;
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_unsigned_integer_entry(
+		struct bt_value_map_builder *builder, const char *key,
+		uint64_t val)
+{
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	add_map_builder_entry(builder, key,
+		BT_VALUE_TYPE_UNSIGNED_INTEGER)->value.u = val;
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_signed_integer_entry(
+		struct bt_value_map_builder *builder, const char *key,
+		int64_t val)
+{
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	add_map_builder_entry(builder, key,
+		BT_VALUE_TYPE_SIGNED_INTEGER)->value.u = (uint64_t) val;
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_real_entry(struct bt_value_map_builder *builder,
+		const char *key, double val)
+{
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	add_map_builder_entry(builder, key, BT_VALUE_TYPE_REAL)->value.r = val;
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+enum bt_value_map_builder_add_entry_status
+bt_value_map_builder_add_string_entry(struct bt_value_map_builder *builder,
+		const char *key, const char *val)
+{
+	size_t str_offset;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	BT_ASSERT_PRE_KEY_NON_NULL(key);
+	BT_ASSERT_PRE_NON_NULL("raw-value", val, "Raw value");
+	str_offset = append_map_builder_chars(builder, val);
+	add_map_builder_entry(builder, key,
+		BT_VALUE_TYPE_STRING)->value.str_offset = str_offset;
+	return BT_FUNC_STATUS_OK;
+}
+
+BT_EXPORT
+struct bt_value *bt_value_map_builder_build(
+		struct bt_value_map_builder *builder)
+{
+	struct bt_value_map *map_obj = NULL;
+	struct compact_map_sort_entry *sort_entries = NULL;
+	guint entry_count;
+	guint i;
+	uint64_t unique_count = 0;
+	uint64_t scalar_count = 0;
+	size_t chars_size = 0;
+	size_t entries_offset, scalars_offset, chars_offset;
+	union compact_map_scalar *scalar;
+	char *chars;
+
+	BT_ASSERT_PRE_NO_ERROR();
+	BT_ASSERT_PRE_VALUE_MAP_BUILDER_NON_NULL(builder);
+	entry_count = builder->entries->len;
+	BT_LOGD("Building compact map value: builder-addr=%p, entry-count=%u",
+		builder, entry_count);
+
+	/* Sort the entries by key, then by insertion order */
+	sort_entries = g_new(struct compact_map_sort_entry, entry_count + 1);
+	if (!sort_entries) {
+		BT_LIB_LOGE_APPEND_CAUSE("Failed to allocate sorting entries.");
+		goto end;
+	}
+
+	for (i = 0; i < entry_count; i++) {
+		sort_entries[i].key = builder->chars->str +
+			g_array_index(builder->entries,
+				struct bt_value_map_builder_entry, i).key_offset;
+		sort_entries[i].index = i;
+	}
+
+	qsort(sort_entries, entry_count, sizeof(*sort_entries),
+		compare_compact_map_sort_entries);
+
+	/* Only keep the last entry of each key, and compute the size */
+	for (i = 0; i < entry_count; i++) {
+		const struct bt_value_map_builder_entry *entry;
+
+		if (i + 1 < entry_count && strcmp(sort_entries[i].key,
+				sort_entries[i + 1].key) == 0) {
+			sort_entries[i].key = NULL;
+			continue;
+		}
+
+		entry = &g_array_index(builder->entries,
+			struct bt_value_map_builder_entry,
+			sort_entries[i].index);
+		unique_count++;
+		chars_size += strlen(sort_entries[i].key) + 1;
+
+		switch (entry->type) {
+		case BT_VALUE_TYPE_NULL:
+		case BT_VALUE_TYPE_ARRAY:
+		case BT_VALUE_TYPE_MAP:
+			break;
+		case BT_VALUE_TYPE_STRING:
+			chars_size += strlen(builder->chars->str +
+				entry->value.str_offset) + 1;
+			scalar_count++;
+			break;
+		default:
+			scalar_count++;
+			break;
+		}
+	}
+
+	/*
+	 * Single memory block: map value, entries, scalar values, and
+	 * characters (keys and string raw values).
+	 */
+	entries_offset = align_size(sizeof(*map_obj),
+		__alignof__(struct bt_value_map_compact_entry));
+	scalars_offset = align_size(entries_offset +
+		unique_count * sizeof(struct bt_value_map_compact_entry),
+		__alignof__(union compact_map_scalar));
+	chars_offset = scalars_offset +
+		scalar_count * sizeof(union compact_map_scalar);
+	map_obj = g_malloc0(chars_offset + chars_size);
+	if (!map_obj) {
+		BT_LIB_LOGE_APPEND_CAUSE(
+			"Failed to allocate one compact map object: size=%zu",
+			chars_offset + chars_size);
+		goto end;
+	}
+
+	map_obj->base = bt_value_create_base(BT_VALUE_TYPE_MAP);
+	map_obj->base.frozen = BT_TRUE;
+	map_obj->compact_entries = (void *) ((char *) map_obj + entries_offset);
+	map_obj->compact_entry_count = unique_count;
+	scalar = (void *) ((char *) map_obj + scalars_offset);
+	chars = (char *) map_obj + chars_offset;
+	unique_count = 0;
+
+	for (i = 0; i < entry_count; i++) {
+		const struct bt_value_map_builder_entry *entry;
+		struct bt_value_map_compact_entry *compact_entry;
+
+		if (!sort_entries[i].key) {
+			/* Replaced by a later entry */
+			continue;
+		}
+
+		entry = &g_array_index(builder->entries,
+			struct bt_value_map_builder_entry,
+			sort_entries[i].index);
+		compact_entry = &map_obj->compact_entries[unique_count];
+		unique_count++;
+		compact_entry->key = copy_compact_map_chars(&chars,
+			sort_entries[i].key, strlen(sort_entries[i].key));
+
+		switch (entry->type) {
+		case BT_VALUE_TYPE_NULL:
+			compact_entry->value = bt_value_null;
+			bt_object_get_ref_no_null_check(bt_value_null);
+			break;
+		case BT_VALUE_TYPE_BOOL:
+			init_compact_map_child(&scalar->bool_obj.base,
+				entry->type, map_obj);
+			scalar->bool_obj.value = entry->value.b;
+			compact_entry->value = &scalar->bool_obj.base;
+			scalar++;
+			break;
+		case BT_VALUE_TYPE_UNSIGNED_INTEGER:
+		case BT_VALUE_TYPE_SIGNED_INTEGER:
+			init_compact_map_child(&scalar->integer_obj.base,
+				entry->type, map_obj);
+			scalar->integer_obj.value.u = entry->value.u;
+			compact_entry->value = &scalar->integer_obj.base;
+			scalar++;
+			break;
+		case BT_VALUE_TYPE_REAL:
+			init_compact_map_child(&scalar->real_obj.base,
+				entry->type, map_obj);
+			scalar->real_obj.value = entry->value.r;
+			compact_entry->value = &scalar->real_obj.base;
+			scalar++;
+			break;
+		case BT_VALUE_TYPE_STRING:
+		{
+			const char *str = builder->chars->str +
+				entry->value.str_offset;
+			const size_t len = strlen(str);
+
+			init_compact_map_child(&scalar->string.obj.base,
+				entry->type, map_obj);
+			scalar->string.gstr.str = copy_compact_map_chars(
+				&chars, str, len);
+			scalar->string.gstr.len = len;
+			scalar->string.gstr.allocated_len = len + 1;
+			scalar->string.obj.gstr = &scalar->string.gstr;
+			compact_entry->value = &scalar->string.obj.base;
+			scalar++;
+			break;
+		}
+		case BT_VALUE_TYPE_ARRAY:
+		case BT_VALUE_TYPE_MAP:
+			compact_entry->value = entry->value.obj;
+			bt_object_get_ref_no_null_check(entry->value.obj);
+			break;
+		default:
+			bt_common_abort();
+		}
+	}
+
+	BT_ASSERT(unique_count == map_obj->compact_entry_count);
+	reset_map_builder(builder);
+	BT_LOGD("Built compact map value: builder-addr=%p, addr=%p, "
+		"entry-count=%" PRIu64, builder, map_obj, unique_count);
+
+end:
+	g_free(sort_entries);
+	return (void *) map_obj;
+}
+
+BT_EXPORT
+void bt_value_map_builder_get_ref(
+		const struct bt_value_map_builder *builder)
+{
+	bt_object_get_ref(builder);
+}
+
+BT_EXPORT
+void bt_value_map_builder_put_ref(
+		const struct bt_value_map_builder *builder)
+{
+	bt_object_put_ref(builder);
+}
+
 BT_EXPORT
 enum bt_value_copy_status bt_value_copy(const struct bt_value *object,
 		struct bt_value **copy_obj)
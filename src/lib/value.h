@@ -46,9 +46,58 @@ struct bt_value_array {
 	GPtrArray *garray;
 };
 
+struct bt_value_map_compact_entry {
+	const char *key;
+	struct bt_value *value;
+};
+
 struct bt_value_map {
 	struct bt_value base;
+
+	/* `NULL` for a compact map */
 	GHashTable *ght;
+
+	/*
+	 * Entries of a compact map (see bt_value_map_builder_build()),
+	 * sorted by key (strcmp()).
+	 *
+	 * Both the entries and their scalar values live in the same
+	 * memory block as this map: such a value has this map as its
+	 * parent and a reference count of zero until someone gets a
+	 * reference on it. Other values (null, array, and map values)
+	 * are regular references.
+	 */
+	struct bt_value_map_compact_entry *compact_entries;
+	uint64_t compact_entry_count;
+};
+
+struct bt_value_map_builder_entry {
+	/* Offset of the key within `chars` of the builder */
+	size_t key_offset;
+
+	enum bt_value_type type;
+
+	union {
+		bt_bool b;
+		uint64_t u;
+		double r;
+
+		/* Offset of the raw value within `chars` of the builder */
+		size_t str_offset;
+
+		/* Array or map value (owned reference) */
+		struct bt_value *obj;
+	} value;
+};
+
+struct bt_value_map_builder {
+	struct bt_object base;
+
+	/* Array of `struct bt_value_map_builder_entry` */
+	GArray *entries;
+
+	/* Null-terminated keys and string raw values, one after the other */
+	GString *chars;
 };
 
 void _bt_value_freeze(const struct bt_value *object);
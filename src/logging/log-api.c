@@ -12,8 +12,11 @@
 #include <ctype.h>
 #include <errno.h>
 #include <glib.h>
+#include <inttypes.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
 #include <time.h>
@@ -277,17 +280,282 @@ void common_write_init(char ** const at, const char * const file_name,
 	append_sp_to_msg_buf(at);
 }
 
+/*
+ * Asynchronous writing, enabled with `BABELTRACE_LOG_ASYNC=1`.
+ *
+ * The logging functions copy each complete log message to a ring
+ * buffer, and a writer thread writes its contents to the standard
+ * error, so that a slow standard error doesn't slow down the logging
+ * thread.
+ *
+ * When the ring buffer is full, a logging function drops its message
+ * instead of waiting, and the writer thread then reports how many
+ * messages it dropped.
+ *
+ * A logging function writes a fatal message synchronously, after the
+ * contents of the ring buffer, as the process is about to abort.
+ */
+#define ASYNC_RING_BUF_SIZE	(1 << 20)
+
+static struct {
+	/*
+	 * Protects the members below, except `write_lock`.
+	 *
+	 * Lock order: `write_lock`, and then `lock`.
+	 */
+	GMutex lock;
+
+	/* Signaled when the ring buffer becomes non-empty or on exit */
+	GCond cond;
+
+	/* Held while writing the ring buffer to the standard error */
+	GMutex write_lock;
+
+	/* Writer thread, or `NULL` if disabled */
+	GThread *thread;
+
+	/* Ring buffer */
+	char *ring_buf;
+
+	/* Offset of the oldest byte within `ring_buf` */
+	size_t head;
+
+	/* Number of bytes to write within `ring_buf` */
+	size_t len;
+
+	/* Number of dropped messages since the last report */
+	uint64_t dropped_count;
+
+	/* True when the thread must finish writing and exit */
+	bool quit;
+} async_writer;
+
+static GOnce async_writer_once = G_ONCE_INIT;
+
+/*
+ * Writes `len` bytes of `buf` to the standard error, retrying on
+ * partial writes.
+ */
+static
+void write_all_to_stderr(const char *buf, size_t len)
+{
+	while (len > 0) {
+		const ssize_t ret = write(STDERR_FILENO, buf, len);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+
+			/* Nothing more we can do */
+			break;
+		}
+
+		buf += ret;
+		len -= (size_t) ret;
+	}
+}
+
+/*
+ * Writes the whole contents of the ring buffer to the standard error
+ * and empties it.
+ *
+ * `async_writer.write_lock` and `async_writer.lock` must be held.
+ */
+static
+void async_writer_write_ring_buf(void)
+{
+	const size_t first_len = MIN(async_writer.len,
+		ASYNC_RING_BUF_SIZE - async_writer.head);
+
+	write_all_to_stderr(&async_writer.ring_buf[async_writer.head],
+		first_len);
+	write_all_to_stderr(async_writer.ring_buf,
+		async_writer.len - first_len);
+	async_writer.head = 0;
+	async_writer.len = 0;
+}
+
+static
+gpointer async_writer_thread_func(gpointer data)
+{
+	while (true) {
+		size_t len;
+		uint64_t dropped_count;
+
+		g_mutex_lock(&async_writer.lock);
+
+		while (async_writer.len == 0 && async_writer.dropped_count == 0 &&
+				!async_writer.quit) {
+			g_cond_wait(&async_writer.cond, &async_writer.lock);
+		}
+
+		len = async_writer.len;
+		dropped_count = async_writer.dropped_count;
+		async_writer.dropped_count = 0;
+		g_mutex_unlock(&async_writer.lock);
+
+		if (len == 0 && dropped_count == 0) {
+			/* Quitting with nothing left to write */
+			break;
+		}
+
+		/*
+		 * Producers only append after `head + len`, therefore the
+		 * bytes to write don't change without `lock`.
+		 */
+		g_mutex_lock(&async_writer.write_lock);
+
+		if (dropped_count > 0) {
+			char note[64];
+			const int note_len = snprintf(note, sizeof(note),
+				"[%" PRIu64 " log messages dropped]\n",
+				dropped_count);
+
+			write_all_to_stderr(note, (size_t) note_len);
+		}
+
+		g_mutex_lock(&async_writer.lock);
+
+		if (len > 0) {
+			/*
+			 * Write the contiguous part starting at `head`:
+			 * the next iteration writes the rest.
+			 */
+			const size_t head = async_writer.head;
+			const size_t write_len = MIN(len,
+				ASYNC_RING_BUF_SIZE - head);
+
+			g_mutex_unlock(&async_writer.lock);
+			write_all_to_stderr(&async_writer.ring_buf[head],
+				write_len);
+			g_mutex_lock(&async_writer.lock);
+			async_writer.head = (head + write_len) %
+				ASYNC_RING_BUF_SIZE;
+			async_writer.len -= write_len;
+		}
+
+		g_mutex_unlock(&async_writer.lock);
+		g_mutex_unlock(&async_writer.write_lock);
+	}
+
+	return NULL;
+}
+
+static
+gpointer async_writer_init(gpointer data)
+{
+	const char * const env_var = getenv("BABELTRACE_LOG_ASYNC");
+
+	if (!env_var || strcmp(env_var, "1") != 0) {
+		goto end;
+	}
+
+	async_writer.ring_buf = g_try_malloc(ASYNC_RING_BUF_SIZE);
+	if (!async_writer.ring_buf) {
+		goto end;
+	}
+
+	async_writer.thread = g_thread_try_new("bt-log-writer",
+		async_writer_thread_func, NULL, NULL);
+	if (!async_writer.thread) {
+		g_free(async_writer.ring_buf);
+		async_writer.ring_buf = NULL;
+	}
+
+end:
+	return async_writer.thread;
+}
+
+/*
+ * Makes the writer thread write what's left and joins it.
+ *
+ * Log messages which come after this are written synchronously.
+ */
+__attribute__((destructor)) static
+void async_writer_fini(void)
+{
+	if (!async_writer.thread) {
+		return;
+	}
+
+	g_mutex_lock(&async_writer.lock);
+	async_writer.quit = true;
+	g_cond_signal(&async_writer.cond);
+	g_mutex_unlock(&async_writer.lock);
+	g_thread_join(async_writer.thread);
+	async_writer.thread = NULL;
+}
+
+/*
+ * Tries to append the `len` bytes of `buf` to the ring buffer.
+ *
+ * Returns false if the writer thread is disabled or gone, or if `lvl`
+ * is `BT_LOG_FATAL`: the caller must write `buf` directly in this case.
+ */
+static
+bool async_writer_append(const char * const buf, const size_t len,
+		const enum bt_log_level lvl)
+{
+	bool appended = false;
+
+	if (!g_once(&async_writer_once, async_writer_init, NULL)) {
+		goto end;
+	}
+
+	if (lvl == BT_LOG_FATAL) {
+		/* Write everything before the fatal message */
+		g_mutex_lock(&async_writer.write_lock);
+		g_mutex_lock(&async_writer.lock);
+		async_writer_write_ring_buf();
+		g_mutex_unlock(&async_writer.lock);
+		g_mutex_unlock(&async_writer.write_lock);
+		goto end;
+	}
+
+	g_mutex_lock(&async_writer.lock);
+
+	if (async_writer.quit) {
+		g_mutex_unlock(&async_writer.lock);
+		goto end;
+	}
+
+	if (len > ASYNC_RING_BUF_SIZE - async_writer.len) {
+		async_writer.dropped_count++;
+	} else {
+		const size_t tail = (async_writer.head + async_writer.len) %
+			ASYNC_RING_BUF_SIZE;
+		const size_t first_len = MIN(len, ASYNC_RING_BUF_SIZE - tail);
+
+		memcpy(&async_writer.ring_buf[tail], buf, first_len);
+		memcpy(async_writer.ring_buf, &buf[first_len],
+			len - first_len);
+		async_writer.len += len;
+	}
+
+	g_cond_signal(&async_writer.cond);
+	g_mutex_unlock(&async_writer.lock);
+	appended = true;
+
+end:
+	return appended;
+}
+
 /*
  * Writes the final part of the log message to `msg_buf` (resets the
  * terminal color and appends a newline), and then writes the whole log
- * message to the standard error.
+ * message to the standard error, possibly asynchronously (see
+ * `async_writer`).
  */
 static
-void common_write_fini(char ** const at)
+void common_write_fini(char ** const at, const enum bt_log_level lvl)
 {
 	append_str_to_msg_buf(at, bt_common_color_reset());
 	append_char_to_msg_buf(at, '\n');
-	(void) write(STDERR_FILENO, msg_buf, *at - msg_buf);
+
+	if (!async_writer_append(msg_buf, *at - msg_buf, lvl)) {
+		write_all_to_stderr(msg_buf, *at - msg_buf);
+	}
 }
 
 void bt_log_write(const char * const file_name, const char * const func_name,
@@ -298,7 +566,7 @@ void bt_log_write(const char * const file_name, const char * const func_name,
 
 	common_write_init(&at, file_name, func_name, line_no, lvl, tag);
 	append_str_to_msg_buf(&at, msg);
-	common_write_fini(&at);
+	common_write_fini(&at, lvl);
 }
 
 _BT_LOG_PRINTFLIKE(6, 0)
@@ -317,7 +585,7 @@ void write_vprintf(const char * const file_name, const char * const func_name,
 		at += (size_t) written_len;
 	}
 
-	common_write_fini(&at);
+	common_write_fini(&at, lvl);
 }
 
 void bt_log_write_printf(const char * const file_name,
@@ -364,7 +632,7 @@ void bt_log_write_errno(const char * const file_name,
 	common_write_errno_init(&at, file_name, func_name, line_no, lvl,
 		tag, init_msg);
 	append_str_to_msg_buf(&at, msg);
-	common_write_fini(&at);
+	common_write_fini(&at, lvl);
 }
 
 void bt_log_write_errno_printf(const char * const file_name,
@@ -385,7 +653,7 @@ void bt_log_write_errno_printf(const char * const file_name,
 		at += (size_t) written_len;
 	}
 
-	common_write_fini(&at);
+	common_write_fini(&at, lvl);
 }
 
 /*
@@ -437,7 +705,7 @@ void write_mem_line(const char * const file_name, const char * const func_name,
 		}
 	}
 
-	common_write_fini(&at);
+	common_write_fini(&at, lvl);
 }
 
 /*
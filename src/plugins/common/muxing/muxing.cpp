@@ -316,8 +316,6 @@ int MessageComparator::_compareClockSnapshots(const bt2::ConstClockSnapshot left
     return _compareLt(left.value(), right.value());
 }
 
-namespace {
-
 bt2::OptionalBorrowedObject<bt2::ConstStream> borrowStream(const bt2::ConstMessage msg) noexcept
 {
     switch (msg.type()) {
@@ -349,8 +347,6 @@ bt2::OptionalBorrowedObject<bt2::ConstStream> borrowStream(const bt2::ConstMessa
     bt_common_abort();
 }
 
-} /* namespace */
-
 int MessageComparator::_compareMessagesSameType(const bt2::ConstMessage left,
                                                 const bt2::ConstMessage right) const noexcept
 {
@@ -467,6 +463,35 @@ int MessageComparator::_compareMessagesSameType(const bt2::ConstMessage left,
     bt_common_abort();
 }
 
+int MessageComparator::compareStreams(const bt2::ConstStream left,
+                                      const bt2::ConstStream right) const noexcept
+{
+    const auto leftTrace = left.trace();
+    const auto rightTrace = right.trace();
+
+    /* Compare trace UUIDs or identities. */
+    if (_mGraphMipVersion == 0) {
+        if (const auto ret = _compareOptUuids(leftTrace.uuid(), rightTrace.uuid())) {
+            return ret;
+        }
+    } else if (const auto ret = _compareIdentities(leftTrace.identity(), rightTrace.identity())) {
+        return ret;
+    }
+
+    /* Compare trace names. */
+    if (const auto ret = _compareStrings(leftTrace.name(), rightTrace.name())) {
+        return ret;
+    }
+
+    /* Compare stream class IDs. */
+    if (const auto ret = _compareLt(left.cls().id(), right.cls().id())) {
+        return ret;
+    }
+
+    /* Compare stream IDs. */
+    return _compareLt(left.id(), right.id());
+}
+
 int MessageComparator::compare(const bt2::ConstMessage left,
                                const bt2::ConstMessage right) const noexcept
 {
@@ -474,32 +499,8 @@ int MessageComparator::compare(const bt2::ConstMessage left,
 
     if (const auto ret = _compareOptionalBorrowedObjects(
             borrowStream(left), borrowStream(right),
-            [&](const bt2::ConstStream leftStream, const bt2::ConstStream rightStream) {
-                const auto leftTrace = leftStream.trace();
-                const auto rightTrace = rightStream.trace();
-
-                /* Compare trace UUIDs or identities. */
-                if (_mGraphMipVersion == 0) {
-                    if (const auto ret = _compareOptUuids(leftTrace.uuid(), rightTrace.uuid())) {
-                        return ret;
-                    }
-                } else if (const auto ret =
-                               _compareIdentities(leftTrace.identity(), rightTrace.identity())) {
-                    return ret;
-                }
-
-                /* Compare trace names. */
-                if (const auto ret = _compareStrings(leftTrace.name(), rightTrace.name())) {
-                    return ret;
-                }
-
-                /* Compare stream class IDs. */
-                if (const auto ret = _compareLt(leftStream.cls().id(), rightStream.cls().id())) {
-                    return ret;
-                }
-
-                /* Compare stream IDs. */
-                return _compareLt(leftStream.id(), rightStream.id());
+            [this](const bt2::ConstStream leftStream, const bt2::ConstStream rightStream) {
+                return this->compareStreams(leftStream, rightStream);
             })) {
         return ret;
     }
@@ -11,6 +11,11 @@
 
 namespace muxing {
 
+/*
+ * Returns the stream of `msg`, if any.
+ */
+bt2::OptionalBorrowedObject<bt2::ConstStream> borrowStream(bt2::ConstMessage msg) noexcept;
+
 class MessageComparator final
 {
 public:
@@ -21,6 +26,12 @@ public:
 
     int compare(bt2::ConstMessage left, bt2::ConstMessage right) const noexcept;
 
+    /*
+     * Compares the streams `left` and `right` the same way compare()
+     * does as its first step for two messages having a stream.
+     */
+    int compareStreams(bt2::ConstStream left, bt2::ConstStream right) const noexcept;
+
 private:
     static int _messageTypeWeight(const bt2::MessageType msgType) noexcept;
 
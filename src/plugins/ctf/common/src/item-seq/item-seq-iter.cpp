@@ -5,6 +5,9 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <initializer_list>
+#include <vector>
 
 #include "common/assert.h"
 
@@ -24,8 +27,19 @@ ItemSeqIter::ItemSeqIter(std::unique_ptr<Medium> medium, const TraceCls& traceCl
             std::bind(&ItemSeqIter::_savedKeyValCountUpdated, this, std::placeholders::_1))),
     _mLogger {parentLogger, "PLUGIN/CTF/ITEM-SEQ-ITER"}
 {
+    /* Select the state machine runner once for this trace class */
+    if (traceCls.isCtf1()) {
+        _mRunStateMachine = &ItemSeqIter::_runStateMachine<_Ctf1Traits>;
+    } else {
+        _mRunStateMachine = &ItemSeqIter::_runStateMachine<_Ctf2Traits>;
+    }
+
     /* Allocate enough elements to save values for dependent fields */
     _mSavedKeyVals.resize(traceCls.savedKeyValCount());
+
+#ifdef BT_CTF_SRC_STATS
+    _mStats.states.resize(wise_enum::enumerators<_State>::size);
+#endif
 }
 
 ItemSeqIter::ItemSeqIter(std::unique_ptr<Medium> medium, const TraceCls& traceCls,
@@ -35,6 +49,54 @@ ItemSeqIter::ItemSeqIter(std::unique_ptr<Medium> medium, const TraceCls& traceCl
     this->seekPkt(pktOffset);
 }
 
+ItemSeqIter::~ItemSeqIter()
+{
+#ifdef BT_CTF_SRC_STATS
+    this->_logStats();
+#endif
+}
+
+#ifdef BT_CTF_SRC_STATS
+void ItemSeqIter::_logStats() const
+{
+    using namespace std::chrono;
+
+    /* States, the most expensive first */
+    std::vector<_State> states;
+
+    for (const auto& state : wise_enum::enumerators<_State>::range) {
+        if (_mStats.states[static_cast<std::size_t>(state.value)].count > 0) {
+            states.push_back(state.value);
+        }
+    }
+
+    std::sort(states.begin(), states.end(), [this](const _State a, const _State b) {
+        return _mStats.states[static_cast<std::size_t>(a)].elapsed >
+               _mStats.states[static_cast<std::size_t>(b)].elapsed;
+    });
+
+    BT_CPPLOGI("Decoding statistics per state: addr={}, state-count={}", fmt::ptr(this),
+               states.size());
+
+    for (const auto state : states) {
+        const auto& stateStats = _mStats.states[static_cast<std::size_t>(state)];
+        const auto elapsedNs = duration_cast<nanoseconds>(stateStats.elapsed).count();
+
+        BT_CPPLOGI("  {}: count={}, elapsed-ns={}, avg-elapsed-ns={:.1f}",
+                   wise_enum::to_string(state), stateStats.count, elapsedNs,
+                   static_cast<double>(elapsedNs) / static_cast<double>(stateStats.count));
+    }
+
+    BT_CPPLOGI("Decoding statistics per field class deep type: addr={}", fmt::ptr(this));
+
+    for (const auto& deepType : wise_enum::enumerators<FcDeepType>::range) {
+        if (const auto count = _mStats.fieldCounts[static_cast<std::size_t>(deepType.value)]) {
+            BT_CPPLOGI("  {}: field-count={}", wise_enum::to_string(deepType.value), count);
+        }
+    }
+}
+#endif
+
 ItemSeqIter::_StackFrame::_StackFrame(const _State restoringStateParam) noexcept :
     restoringState {restoringStateParam}
 {
@@ -145,11 +207,35 @@ void ItemSeqIter::_resetForNewPkt()
     _mCurVarLenInt.len = 0_bits;
 }
 
-void ItemSeqIter::_newBuf(const bt2c::DataLen offsetInItemSeq, const bt2c::DataLen minSize)
+BufResult::Status ItemSeqIter::_tryNewBuf(const bt2c::DataLen offsetInItemSeq,
+                                          const bt2c::DataLen minSize)
 {
     BT_ASSERT_DBG(minSize <= 9_bytes);
-    _mBuf = _mMedium->buf(offsetInItemSeq, minSize);
+
+    /*
+     * If the expected total length of the current packet is known,
+     * then hint the medium that we'll read the rest of the packet.
+     */
+    auto prefSize = minSize;
+
+    if (_mCurPktExpectedLens.total != this->_infDataLen()) {
+        const auto pktEndOffsetInItemSeq = _mCurPktOffsetInItemSeq + _mCurPktExpectedLens.total;
+
+        if (pktEndOffsetInItemSeq > offsetInItemSeq) {
+            prefSize = std::max(prefSize, bt2c::DataLen::fromBytes(
+                                              (pktEndOffsetInItemSeq - offsetInItemSeq).bytes()));
+        }
+    }
+
+    const auto res = _mMedium->tryBuf(offsetInItemSeq, minSize, prefSize);
+
+    if (!res.isOk()) {
+        return res.status();
+    }
+
+    _mBuf = res.buf();
     _mBufOffsetInCurPkt = offsetInItemSeq - _mCurPktOffsetInItemSeq;
+    return BufResult::Status::Ok;
 }
 
 ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleInitState()
@@ -168,12 +254,21 @@ ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleTryBeginReadPktState()
         /*
          * Try getting a single bit to see if we're at the end of the
          * item sequence.
+         *
+         * This is where a live medium typically has no data yet: report
+         * it without throwing as this state handler may be reentered
+         * as is.
          */
-        if (!this->_tryHaveData(1_bits)) {
+        switch (this->_tryHaveDataStatus(1_bits)) {
+        case BufResult::Status::Ok:
+            break;
+        case BufResult::Status::NoData:
             /* No more data: no more packets */
             _mCurItem = nullptr;
             _mState = _State::Done;
             return _StateHandlingReaction::Stop;
+        case BufResult::Status::TryAgain:
+            return _StateHandlingReaction::TryAgain;
         }
     }
 
@@ -635,10 +730,15 @@ ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleTryBeginReadEventRecordS
              * Try having 1 bit to see if we're at the end of the
              * packet.
              */
-            if (!this->_tryHaveData(1_bits)) {
+            switch (this->_tryHaveDataStatus(1_bits)) {
+            case BufResult::Status::Ok:
+                break;
+            case BufResult::Status::NoData:
                 /* No more data: no more event records */
                 this->_state(_State::EndReadPktContent);
                 return _StateHandlingReaction::Continue;
+            case BufResult::Status::TryAgain:
+                return _StateHandlingReaction::TryAgain;
             }
         }
     } else if (this->_remainingPktContentLen() == 0_bits) {
@@ -659,6 +759,66 @@ ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleTryBeginReadEventRecordS
     return _StateHandlingReaction::Stop;
 }
 
+void ItemSeqIter::skipCurEventRecordCtxsAndPayload()
+{
+    BT_ASSERT_DBG(_mCurItem == &_mItems.eventRecordInfo);
+    BT_ASSERT_DBG(_mState == _State::TryBeginReadCommonEventRecordCtxScope);
+    BT_ASSERT_DBG(_mItems.dataStreamInfo._mCls);
+
+    const auto eventRecordCls = _mItems.eventRecordInfo._mCls;
+
+    if (!eventRecordCls) {
+        /* No specific context and payload fields anyway */
+        return;
+    }
+
+    /* Compute the offset of the end of the event record */
+    auto endOffset = _mHeadOffsetInCurPkt;
+
+    for (const auto fc : {_mItems.dataStreamInfo._mCls->commonEventRecordCtxFc(),
+                          eventRecordCls->specCtxFc(), eventRecordCls->payloadFc()}) {
+        if (!fc) {
+            continue;
+        }
+
+        if (!fc->staticLen()) {
+            /* Dynamic length: decode normally */
+            return;
+        }
+
+        endOffset = bt2c::DataLen::fromBits(bt2c::align(*endOffset, fc->align())) + *fc->staticLen();
+    }
+
+    const auto lenToSkip = endOffset - _mHeadOffsetInCurPkt;
+
+    if (lenToSkip > this->_remainingPktContentLen()) {
+        /* Let the normal decoding process report the error */
+        return;
+    }
+
+    CTF_SRC_ITEM_SEQ_ITER_CPPLOGT("Skipping event record contexts and payload: len-bits={}",
+                                  *lenToSkip);
+
+    /*
+     * _prepareToTryReadScope() pushed a frame for the common event
+     * record context scope, if any.
+     */
+    if (_mCurScope.fc) {
+        this->_stackPop();
+    }
+
+    /*
+     * The skipped fields may have changed the byte order of the last
+     * fixed-length bit array field.
+     */
+    _mLastFixedLenBitArrayFieldByteOrder.reset();
+
+    /* Next: skip the fields, then end reading the event record */
+    _mRemainingLenToSkip = lenToSkip;
+    _mPostSkipPaddingState = _State::EndReadEventRecord;
+    this->_state(_State::SkipContentPadding);
+}
+
 ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleEndReadEventRecordState()
 {
     /* Validate that current event record has data */
@@ -695,8 +855,172 @@ ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleBeginReadStructFieldStat
         /* Set length (member count) */
         this->_stackTop().len = structFc.size();
 
-        /* Next: read the first struct field */
-        this->_prepareToReadField(structFc.begin()->fc());
+        /*
+         * If the structure field has a fixed layout and the current
+         * buffer contains all of it, then read its members directly
+         * at their known offsets.
+         *
+         * Otherwise, fall back to reading the members one by one,
+         * aligning the head and requiring data for each of them.
+         */
+        const auto& fixedLayout = structFc.fixedLayout();
+
+        if (fixedLayout && fixedLayout->len <= this->_remainingPktContentLen() &&
+            fixedLayout->len <= this->_remainingBufLen()) {
+            CTF_SRC_ITEM_SEQ_ITER_CPPLOGT(
+                "Reading structure field having a fixed layout: len-bits={}, member-count={}",
+                *fixedLayout->len, structFc.size());
+            _mFixedLayoutStructFieldOffsetInCurPkt = _mHeadOffsetInCurPkt;
+
+            /* Next: read the first member */
+            this->_state(_State::ReadFixedLayoutStructFieldMember);
+        } else {
+            /* Next: read the first struct field */
+            this->_prepareToReadField(structFc.begin()->fc());
+        }
+    }
+
+    return _StateHandlingReaction::Stop;
+}
+
+ItemSeqIter::_StateHandlingReaction ItemSeqIter::_handleReadFixedLayoutStructFieldMemberState()
+{
+    auto& top = this->_stackTop();
+    auto& structFc = top.fc->asStruct();
+    auto& fc = structFc[top.elemIndex].fc();
+
+    BT_ASSERT_DBG(structFc.fixedLayout());
+
+    /*
+     * Move the decoding head to the member: the fixed layout takes
+     * care of any padding between members.
+     */
+    _mHeadOffsetInCurPkt = _mFixedLayoutStructFieldOffsetInCurPkt +
+                           structFc.fixedLayout()->memberOffsets[top.elemIndex];
+
+    switch (fc.deepType()) {
+    case FcDeepType::FixedLenUIntBa8:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 8, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa8SaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 8, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa16Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 16, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa16LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 16, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa16Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 16, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa16BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 16, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa32Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 32, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa32LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 32, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa32Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 32, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa32BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 32, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa64Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 64, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa64LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 64, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa64Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 64, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenUIntBa64BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Unsigned, 64, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenUIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa8:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 8, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa8SaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 8, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa16Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 16, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa16LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 16, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa16Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 16, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa16BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 16, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa32Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 32, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa32LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 32, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa32Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 32, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa32BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 32, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa64Le:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 64, ByteOrder::Little,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa64LeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 64, ByteOrder::Little,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa64Be:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 64, ByteOrder::Big,
+                                                _SaveVal::No>(fc, _mItems.fixedLenSIntField);
+        break;
+    case FcDeepType::FixedLenSIntBa64BeSaveVal:
+        this->_readFixedLayoutStructFieldMember<bt2c::Signedness::Signed, 64, ByteOrder::Big,
+                                                _SaveVal::Yes>(fc, _mItems.fixedLenSIntField);
+        break;
+    default:
+        bt_common_abort();
+    }
+
+    /* Next member */
+    ++top.elemIndex;
+
+    if (top.elemIndex == top.len) {
+        /* Next: end reading the structure field */
+        this->_restoreState();
     }
 
     return _StateHandlingReaction::Stop;
@@ -9,19 +9,27 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#ifdef __BMI2__
+#    include <immintrin.h>
+#endif
+
 #include "common/assert.h"
 #include "common/common.h"
 #include "compat/bitfield.h"
 #include "cpp-common/bt2c/align.hpp"
+#include "cpp-common/bt2c/exc.hpp"
 #include "cpp-common/bt2c/logging.hpp"
 #include "cpp-common/bt2c/read-fixed-len-int.hpp"
 #include "cpp-common/bt2c/reverse-fixed-len-int-bits.hpp"
+#include "cpp-common/bt2c/small-vector.hpp"
 #include "cpp-common/bt2c/std-int.hpp"
 #include "cpp-common/vendor/wise-enum/wise_enum.h"
 
@@ -87,7 +95,10 @@ enum class BitOrder
  * `LenBitsV` must be one of:
  *
  * 0:
- *     Uses bt_bitfield_read_be() and bt_bitfield_read_le().
+ *     Uses bt2c::readFixedLenBitArrayBe() or
+ *     bt2c::readFixedLenBitArrayLe() when the bit array fits within
+ *     the next 64 bits of the current buffer (single load), or
+ *     bt_bitfield_read_be() or bt_bitfield_read_le() otherwise.
  *
  * 8, 16, 32, or 64:
  *     Uses bt2c::readFixedLenIntBe() or bt2c::readFixedLenIntLe().
@@ -527,6 +538,29 @@ struct VarLenIntFieldVal<bt2c::Signedness::Signed> final
  * All the state handlers have the name _handle*State(), although there
  * are common state handling helpers which start with `_handleCommon`.
  *
+ * Fixed layouts
+ * ─────────────
+ * When the class of a structure field has a fixed layout (see the
+ * comment of `StructFcFixedLayout`) and the current buffer contains the
+ * whole structure field, _handleBeginReadStructFieldState() skips
+ * _prepareToReadField() for its members: the
+ * `_State::ReadFixedLayoutStructFieldMember` state handler reads each
+ * member at its precomputed offset, without aligning the decoding head
+ * or requiring data. Otherwise, the iterator reads the members through
+ * the generic states.
+ *
+ * Statistics
+ * ──────────
+ * When building with the `BT_CTF_SRC_STATS` definition (configure with
+ * `BABELTRACE_CTF_SRC_STATS=1`), the iterator counts, for each state,
+ * how many times _handleState() handled it and the total time it
+ * spent in its handler, as well as the number of fields which
+ * _prepareToReadField() prepared to read for each field class deep
+ * type. Since most states and deep types are specific to a field class
+ * type, this shows which metadata layouts are expensive to decode.
+ *
+ * The destructor logs those statistics at the INFO level.
+ *
  * State transitions
  * ─────────────────
  * Here's a Graphviz DOT source which shows the state transitions:
@@ -756,6 +790,8 @@ public:
     ItemSeqIter(const ItemSeqIter&) = delete;
     ItemSeqIter& operator=(const ItemSeqIter&) = delete;
 
+    ~ItemSeqIter();
+
     /*
      * Makes the underlying medium seek to `pktOffset` and resets the
      * state to decode a packet.
@@ -784,13 +820,112 @@ public:
     {
         BT_ASSERT_DBG(_mState != _State::Done);
 
-        while (this->_handleState() == _StateHandlingReaction::Continue) {
-            continue;
+        if ((this->*_mRunStateMachine)() == _StateHandlingReaction::TryAgain) {
+            throw bt2c::TryAgain {};
         }
 
         return _mCurItem;
     }
 
+    /* Status of tryAdvanceWhile() */
+    enum class AdvanceStatus
+    {
+        /* `func` returned false */
+        Stopped,
+
+        /* End of iterator (no more items) */
+        End,
+
+        /*
+         * The medium has no data right now, between two packets or two
+         * event records: try again later.
+         */
+        TryAgain,
+    };
+
+    /*
+     * Advances the iterator, calling `func` with each next item
+     * (`const Item&`), while `func` returns true, returning:
+     *
+     * True:
+     *     `func` returned false.
+     *
+     * False:
+     *     End of iterator (no more items).
+     *
+     * This is equivalent to calling next() in a loop, but runs the
+     * state machine and `func`, which the compiler may inline, in a
+     * single loop: use it to handle many items (for example, all the
+     * items of an event record) at once.
+     *
+     * `func` may call skipCurEventRecordCtxsAndPayload().
+     *
+     * This iterator must not be ended.
+     *
+     * May throw whatever Medium::buf() and `func` may throw as well as
+     * `bt2c::Error`.
+     */
+    template <typename FuncT>
+    bool advanceWhile(FuncT&& func)
+    {
+        switch (this->tryAdvanceWhile(std::forward<FuncT>(func))) {
+        case AdvanceStatus::Stopped:
+            return true;
+        case AdvanceStatus::End:
+            return false;
+        case AdvanceStatus::TryAgain:
+            throw bt2c::TryAgain {};
+        }
+
+        bt_common_abort();
+    }
+
+    /*
+     * Like advanceWhile(), but returns `AdvanceStatus::TryAgain`
+     * instead of throwing `bt2c::TryAgain` when the medium reports
+     * "try again" (see Medium::tryBuf()) between two packets or two
+     * event records, which is where a live medium typically waits for
+     * data.
+     *
+     * This method may still throw `bt2c::TryAgain` when the medium
+     * reports "try again" in the middle of a field. In both cases,
+     * calling this method again later resumes the decoding where it
+     * stopped.
+     */
+    template <typename FuncT>
+    AdvanceStatus tryAdvanceWhile(FuncT&& func)
+    {
+        BT_ASSERT_DBG(_mState != _State::Done);
+
+        while (true) {
+            if ((this->*_mRunStateMachine)() == _StateHandlingReaction::TryAgain) {
+                return AdvanceStatus::TryAgain;
+            }
+
+            if (!_mCurItem) {
+                /* No more items */
+                return AdvanceStatus::End;
+            }
+
+            if (!func(*_mCurItem)) {
+                return AdvanceStatus::Stopped;
+            }
+        }
+    }
+
+    /*
+     * Makes this iterator skip the common context, specific context,
+     * and payload fields of the current event record, without providing
+     * their items, if they all have a static length.
+     *
+     * The current item must be an event record info item
+     * (`EventRecordInfoItem`). If any of those fields doesn't have a
+     * static length, then this method doesn't change anything.
+     *
+     * The next item is the event record end item on success.
+     */
+    void skipCurEventRecordCtxsAndPayload();
+
     /*
      * Current offset of this iterator relative to the beginning of the
      * item sequence (_not_ to the beginning of some current packet).
@@ -879,6 +1014,7 @@ private:
         EndReadVariantFieldWithSIntSel,
         EndReadVariantFieldWithUIntSel,
         Init,
+        ReadFixedLayoutStructFieldMember,
         ReadFixedLenBitArrayFieldBa16Be,
         ReadFixedLenBitArrayFieldBa16BeRev,
         ReadFixedLenBitArrayFieldBa16Le,
@@ -1126,6 +1262,37 @@ private:
          * • The iterator is ended (next() will return `nullptr`).
          */
         Stop,
+
+        /*
+         * Stop the state machine: the medium has no data right now.
+         *
+         * Only state handlers which may be reentered as is, before
+         * having changed anything, return this reaction.
+         */
+        TryAgain,
+    };
+
+    /*
+     * State machine traits of a trace class coming from a CTF 1
+     * metadata stream.
+     *
+     * Such a trace class only contains field classes having a CTF 1.8
+     * equivalent, therefore the states to read variable-length integer,
+     * BLOB, optional, and UTF-16/UTF-32 string fields are unreachable:
+     * _handleCurState<_Ctf1Traits>() doesn't dispatch to their handlers,
+     * making its switch statement smaller.
+     */
+    struct _Ctf1Traits final
+    {
+        static constexpr bool hasCtf2OnlyFcs = false;
+    };
+
+    /*
+     * State machine traits of any other trace class.
+     */
+    struct _Ctf2Traits final
+    {
+        static constexpr bool hasCtf2OnlyFcs = true;
     };
 
     /*
@@ -1226,9 +1393,10 @@ private:
 
     /*
      * Requests a new buffer from the medium, setting the corresponding
-     * members accordingly on success.
+     * members accordingly on success, and returning the status of
+     * Medium::tryBuf().
      */
-    void _newBuf(bt2c::DataLen offsetInItemSeq, bt2c::DataLen minSize);
+    BufResult::Status _tryNewBuf(bt2c::DataLen offsetInItemSeq, bt2c::DataLen minSize);
 
     /*
      * Length of remaining content in the current packet.
@@ -1478,18 +1646,16 @@ private:
 
     /*
      * Tries to have `len` bits (maximum: 64 bits) of data, returning
-     * false if not possible.
-     *
-     * This method may still throw `bt2c::TryAgain`, but it won't
-     * throw `NoData`.
+     * the status of Medium::tryBuf() (`BufResult::Status::Ok` if we
+     * already have enough).
      */
-    bool _tryHaveData(const bt2c::DataLen len)
+    BufResult::Status _tryHaveDataStatus(const bt2c::DataLen len)
     {
         BT_ASSERT_DBG(len <= bt2c::DataLen::fromBits(64));
 
         if (len <= this->_remainingBufLen()) {
             /* We already have enough */
-            return true;
+            return BufResult::Status::Ok;
         }
 
         /*
@@ -1512,13 +1678,25 @@ private:
         const auto reqSize = bt2c::DataLen::fromBytes(
             bt2c::DataLen::fromBits(*len + 7 + _mHeadOffsetInCurPkt.extraBitCount()).bytes());
 
-        try {
-            this->_newBuf(reqOffsetInElemSeq, reqSize);
-        } catch (const NoData&) {
-            return false;
+        return this->_tryNewBuf(reqOffsetInElemSeq, reqSize);
+    }
+
+    /*
+     * Tries to have `len` bits (maximum: 64 bits) of data, returning
+     * false if not possible.
+     *
+     * This method may still throw `bt2c::TryAgain`, but it won't
+     * throw `NoData`.
+     */
+    bool _tryHaveData(const bt2c::DataLen len)
+    {
+        const auto status = this->_tryHaveDataStatus(len);
+
+        if (status == BufResult::Status::TryAgain) {
+            throw bt2c::TryAgain {};
         }
 
-        return true;
+        return status == BufResult::Status::Ok;
     }
 
     /*
@@ -1705,6 +1883,10 @@ private:
      */
     void _prepareToReadField(const Fc& fc)
     {
+#ifdef BT_CTF_SRC_STATS
+        ++_mStats.fieldCounts[static_cast<std::size_t>(fc.deepType())];
+#endif
+
         switch (fc.deepType()) {
         case FcDeepType::FixedLenBitArrayBe:
             this->_prepareToReadScalarField(_State::ReadFixedLenBitArrayFieldBe, fc);
@@ -2441,10 +2623,49 @@ private:
         _mState = state;
     }
 
+    /*
+     * Handles states until a state handler returns anything else than
+     * `_StateHandlingReaction::Continue`, returning said reaction.
+     */
+    template <typename TraitsT>
+    _StateHandlingReaction _runStateMachine()
+    {
+        while (true) {
+            const auto reaction = this->_handleState<TraitsT>();
+
+            if (reaction != _StateHandlingReaction::Continue) {
+                return reaction;
+            }
+        }
+    }
+
     /*
      * Handles the current state.
      */
+    template <typename TraitsT>
     _StateHandlingReaction _handleState()
+    {
+#ifdef BT_CTF_SRC_STATS
+        const auto state = _mState;
+        const auto begin = std::chrono::steady_clock::now();
+        const auto reaction = this->_handleCurState<TraitsT>();
+        auto& stateStats = _mStats.states[static_cast<std::size_t>(state)];
+
+        ++stateStats.count;
+        stateStats.elapsed += std::chrono::steady_clock::now() - begin;
+        return reaction;
+#else
+        return this->_handleCurState<TraitsT>();
+#endif
+    }
+
+    /*
+     * Handles the current state.
+     *
+     * `TraitsT` is `_Ctf1Traits` or `_Ctf2Traits`.
+     */
+    template <typename TraitsT>
+    _StateHandlingReaction _handleCurState()
     {
         CTF_SRC_ITEM_SEQ_ITER_CPPLOGT("Handling state `{}`: state={}, stack-len={}",
                                       wise_enum::to_string(_mState), wise_enum::to_string(_mState),
@@ -2504,17 +2725,23 @@ private:
         case _State::BeginReadNullTerminatedStrFieldUtf8:
             return this->_handleBeginReadNullTerminatedStrFieldUtf8State();
         case _State::BeginReadNullTerminatedStrFieldUtf16:
-            return this->_handleBeginReadNullTerminatedStrFieldUtf16State();
+            return TraitsT::hasCtf2OnlyFcs ?
+                       this->_handleBeginReadNullTerminatedStrFieldUtf16State() :
+                       this->_handleCtf2OnlyState();
         case _State::BeginReadNullTerminatedStrFieldUtf32:
-            return this->_handleBeginReadNullTerminatedStrFieldUtf32State();
+            return TraitsT::hasCtf2OnlyFcs ?
+                       this->_handleBeginReadNullTerminatedStrFieldUtf32State() :
+                       this->_handleCtf2OnlyState();
         case _State::EndReadNullTerminatedStrField:
             return this->_handleEndReadNullTerminatedStrFieldState();
         case _State::ReadSubstrUntilNullCodepointUtf8:
             return this->_handleReadSubstrUntilNullCodepointUtf8State();
         case _State::ReadSubstrUntilNullCodepointUtf16:
-            return this->_handleReadSubstrUntilNullCodepointUtf16State();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadSubstrUntilNullCodepointUtf16State() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadSubstrUntilNullCodepointUtf32:
-            return this->_handleReadSubstrUntilNullCodepointUtf32State();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadSubstrUntilNullCodepointUtf32State() :
+                                             this->_handleCtf2OnlyState();
         case _State::BeginReadStaticLenStrField:
             return this->_handleBeginReadStaticLenStrFieldState();
         case _State::EndReadStaticLenStrField:
@@ -2526,17 +2753,25 @@ private:
         case _State::ReadRawData:
             return this->_handleReadRawDataState();
         case _State::BeginReadStaticLenBlobField:
-            return this->_handleBeginReadStaticLenBlobFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleBeginReadStaticLenBlobFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::BeginReadStaticLenBlobFieldMetadataStreamUuid:
-            return this->_handleBeginReadStaticLenBlobFieldMetadataStreamUuidState();
+            return TraitsT::hasCtf2OnlyFcs ?
+                       this->_handleBeginReadStaticLenBlobFieldMetadataStreamUuidState() :
+                       this->_handleCtf2OnlyState();
         case _State::EndReadStaticLenBlobField:
-            return this->_handleEndReadStaticLenBlobFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleEndReadStaticLenBlobFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::BeginReadDynLenBlobField:
-            return this->_handleBeginReadDynLenBlobFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleBeginReadDynLenBlobFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::EndReadDynLenBlobField:
-            return this->_handleEndReadDynLenBlobFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleEndReadDynLenBlobFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadMetadataStreamUuidBlobFieldSection:
-            return this->_handleReadMetadataStreamUuidBlobFieldSectionState();
+            return TraitsT::hasCtf2OnlyFcs ?
+                       this->_handleReadMetadataStreamUuidBlobFieldSectionState() :
+                       this->_handleCtf2OnlyState();
         case _State::BeginReadVariantFieldWithUIntSel:
             return this->_handleBeginReadVariantFieldWithUIntSelState();
         case _State::EndReadVariantFieldWithUIntSel:
@@ -2546,17 +2781,23 @@ private:
         case _State::EndReadVariantFieldWithSIntSel:
             return this->_handleEndReadVariantFieldWithSIntSelState();
         case _State::BeginReadOptionalFieldWithBoolSel:
-            return this->_handleBeginReadOptionalFieldWithBoolSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleBeginReadOptionalFieldWithBoolSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::EndReadOptionalFieldWithBoolSel:
-            return this->_handleEndReadOptionalFieldWithBoolSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleEndReadOptionalFieldWithBoolSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::BeginReadOptionalFieldWithUIntSel:
-            return this->_handleBeginReadOptionalFieldWithUIntSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleBeginReadOptionalFieldWithUIntSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::EndReadOptionalFieldWithUIntSel:
-            return this->_handleEndReadOptionalFieldWithUIntSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleEndReadOptionalFieldWithUIntSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::BeginReadOptionalFieldWithSIntSel:
-            return this->_handleBeginReadOptionalFieldWithSIntSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleBeginReadOptionalFieldWithSIntSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::EndReadOptionalFieldWithSIntSel:
-            return this->_handleEndReadOptionalFieldWithSIntSelState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleEndReadOptionalFieldWithSIntSelState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadFixedLenBitArrayFieldBe:
             return this->_handleReadFixedLenBitArrayFieldBeState();
         case _State::ReadFixedLenBitArrayFieldLe:
@@ -2950,19 +3191,28 @@ private:
         case _State::ReadFixedLenSIntFieldBa64BeRevSaveVal:
             return this->_handleReadFixedLenSIntFieldBa64BeRevSaveValState();
         case _State::ReadVarLenUIntField:
-            return this->_handleReadVarLenUIntFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadVarLenUIntFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadVarLenUIntFieldWithRole:
-            return this->_handleReadVarLenUIntFieldWithRoleState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadVarLenUIntFieldWithRoleState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadVarLenUIntFieldSaveVal:
-            return this->_handleReadVarLenUIntFieldSaveValState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadVarLenUIntFieldSaveValState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadVarLenUIntFieldWithRoleSaveVal:
-            return this->_handleReadVarLenUIntFieldWithRoleSaveValState();
+            return TraitsT::hasCtf2OnlyFcs ?
+                       this->_handleReadVarLenUIntFieldWithRoleSaveValState() :
+                       this->_handleCtf2OnlyState();
         case _State::ReadVarLenSIntField:
-            return this->_handleReadVarLenSIntFieldState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadVarLenSIntFieldState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadVarLenSIntFieldSaveVal:
-            return this->_handleReadVarLenSIntFieldSaveValState();
+            return TraitsT::hasCtf2OnlyFcs ? this->_handleReadVarLenSIntFieldSaveValState() :
+                                             this->_handleCtf2OnlyState();
         case _State::ReadFixedLenMetadataStreamUuidByteUIntFieldBa8:
             return this->_handleReadFixedLenMetadataStreamUuidByteUIntFieldBa8State();
+        case _State::ReadFixedLayoutStructFieldMember:
+            return this->_handleReadFixedLayoutStructFieldMemberState();
         case _State::SetDataStreamInfoItem:
             return this->_handleSetDataStreamInfoItemState();
         case _State::SetPktInfoItem:
@@ -2986,6 +3236,15 @@ private:
         };
     };
 
+    /*
+     * Handles a state which only exists for a field class without
+     * any CTF 1.8 equivalent, which a CTF 1 trace class can't contain.
+     */
+    [[noreturn]] _StateHandlingReaction _handleCtf2OnlyState() const
+    {
+        bt_common_abort();
+    }
+
     /* State handlers */
     _StateHandlingReaction _handleInitState();
     _StateHandlingReaction _handleSkipPaddingState();
@@ -3252,6 +3511,7 @@ private:
     _StateHandlingReaction _handleReadVarLenSIntFieldState();
     _StateHandlingReaction _handleReadVarLenSIntFieldSaveValState();
     _StateHandlingReaction _handleReadFixedLenMetadataStreamUuidByteUIntFieldBa8State();
+    _StateHandlingReaction _handleReadFixedLayoutStructFieldMemberState();
 
     /* Helpers for state handlers */
     _StateHandlingReaction _handleCommonBeginReadScopeState(Scope scope);
@@ -3881,6 +4141,52 @@ private:
         return _StateHandlingReaction::Stop;
     }
 
+    /*
+     * Reads the member field of a structure field having a fixed
+     * layout, of which the class is `fc`, at the decoding head,
+     * updating `item`.
+     *
+     * Unlike _readFixedLenIntField(), this method doesn't align the
+     * decoding head nor check the available data: the caller
+     * guarantees that the whole structure field is available.
+     *
+     * The `SignednessV`, `LenBitsV`, and `ByteOrderV` template
+     * parameters are the same as for the _readFixedLenIntField() method
+     * template.
+     *
+     * `SaveValV` indicates whether or not to save the integer
+     * field value.
+     */
+    template <bt2c::Signedness SignednessV, std::size_t LenBitsV, ByteOrder ByteOrderV,
+              _SaveVal SaveValV, typename ItemT>
+    void _readFixedLayoutStructFieldMember(const Fc& fc, ItemT& item)
+    {
+        auto& intFc = fc.asFixedLenInt();
+
+        BT_ASSERT_DBG(*intFc.len() == LenBitsV);
+        BT_ASSERT_DBG(*intFc.len() <= *this->_remainingBufLen());
+
+        /* Read the field */
+        const auto val =
+            internal::ReadFixedLenIntFunc<SignednessV, LenBitsV, ByteOrderV,
+                                          internal::BitOrder::Natural>::read(*this, intFc);
+
+        /* May be a length/selector of some upcoming dependent field */
+        if (SaveValV == _SaveVal::Yes) {
+            this->_saveKeyVal(intFc.keyValSavingIndexes(), val);
+        }
+
+        /* Update for user */
+        item._val(val);
+        this->_setFieldItemFcAndUpdateForUser(item, fc);
+
+        /* Set last fixed-length bit array field byte order */
+        _mLastFixedLenBitArrayFieldByteOrder = intFc.byteOrder();
+
+        /* Mark the fixed-length integer field as consumed */
+        this->_consumeAvailData(intFc.len());
+    }
+
     /*
      * Appends the single LEB128 byte `byte` to `_mCurVarLenInt.val` and
      * updates `_mCurVarLenInt.len` accordingly.
@@ -3934,6 +4240,69 @@ private:
         _mCurVarLenInt.len = newVarLenIntLen;
     }
 
+    /*
+     * Tries to decode, at once, a whole variable-length integer field
+     * of at most eight bytes from a single 64-bit load at the head,
+     * setting `_mCurVarLenInt` and consuming its bytes on success.
+     *
+     * Returns false, without consuming anything, if:
+     *
+     * • The decoding of the current variable-length integer field is
+     *   already in progress (reentered state handler).
+     *
+     * • There are less than eight bytes of buffer or of packet content
+     *   at the head.
+     *
+     * • The variable-length integer field is longer than eight bytes:
+     *   that's at least 57 bits of data, which needs the validation of
+     *   _appendVarLenIntByte() anyway.
+     *
+     * In those cases, the caller must use the byte-wise path.
+     */
+    bool _tryDecodeVarLenIntWord() noexcept
+    {
+        using namespace bt2c::literals::datalen;
+
+        if (*_mCurVarLenInt.len != 0 || this->_remainingBufLen() < 64_bits ||
+            this->_remainingPktContentLen() < 64_bits) {
+            return false;
+        }
+
+        constexpr std::uint64_t contBits = 0x8080808080808080ULL;
+        const auto word = bt2c::readFixedLenIntLe<std::uint64_t>(this->_bufAtHead());
+
+        /* Continuation bit of each byte cleared: last byte */
+        const auto lastBytes = ~word & contBits;
+
+        if (lastBytes == 0) {
+            /* More than eight bytes */
+            return false;
+        }
+
+        /* Number of bytes of the variable-length integer (1 to 8) */
+        const auto byteCount = (static_cast<unsigned int>(__builtin_ctzll(lastBytes)) + 1) / 8;
+
+        /* Keep the 7-bit groups of those bytes only */
+        const auto groups = word & (byteCount == 8 ? ~contBits :
+                                                     (~contBits & ((1ULL << (byteCount * 8)) - 1)));
+
+#ifdef __BMI2__
+        const auto val = static_cast<unsigned long long>(_pext_u64(groups, ~contBits));
+#else
+        /* Pack the 7-bit groups: pairs, then quadruples, then octets */
+        auto val = static_cast<unsigned long long>(groups);
+
+        val = ((val & 0x7f007f007f007f00ULL) >> 1) | (val & 0x007f007f007f007fULL);
+        val = ((val & 0x3fff00003fff0000ULL) >> 2) | (val & 0x00003fff00003fffULL);
+        val = ((val & 0x0fffffff00000000ULL) >> 4) | (val & 0x000000000fffffffULL);
+#endif
+
+        _mCurVarLenInt.val = val;
+        _mCurVarLenInt.len = bt2c::DataLen::fromBits(byteCount * 7);
+        this->_consumeAvailData(bt2c::DataLen::fromBytes(byteCount));
+        return true;
+    }
+
     /*
      * Common variable-length unsigned integer field state handler
      * updating `item`.
@@ -3946,6 +4315,54 @@ private:
         BT_ASSERT_DBG(_mCurScalarFc);
         this->_alignHead(*_mCurScalarFc);
 
+        /* Fast path: whole variable-length integer in the buffer */
+        if (!this->_tryDecodeVarLenIntWord()) {
+            this->_decodeVarLenIntBytes<SignednessV>();
+        }
+
+        /*
+         * Update for user.
+         *
+         * `_headOffsetInItemSeq()` now returns the offset at the _end_
+         * of the variable-length integer; the iterator user expects its
+         * beginning offset.
+         */
+        item._val(
+            internal::VarLenIntFieldVal<SignednessV>::val(_mCurVarLenInt.len, _mCurVarLenInt.val));
+        item._mLen = _mCurVarLenInt.len;
+        this->_setFieldItemFc(item, *_mCurScalarFc);
+        this->_updateForUser(item, this->_headOffsetInItemSeq() - item.fieldLen());
+
+        /*
+         * Any state handler which calls this method template may be
+         * reentered as is. This may happen if the _requireContentData()
+         * call of _decodeVarLenIntBytes() throws `bt2c::TryAgain`, for
+         * example.
+         *
+         * This means there's no initial setup to read a variable-length
+         * integer field: the state handlers just call this method
+         * template to start _and_ to continue.
+         *
+         * Because of this, and because both `_mCurVarLenInt.len` and
+         * `_mCurVarLenInt.val` must be zero before starting to read a
+         * variable-length integer field, we reset them here for the
+         * next variable-length integer field reading operation.
+         *
+         * _resetForNewPkt() also resets both variables before starting
+         * to read a packet.
+         */
+        _mCurVarLenInt.val = 0;
+        _mCurVarLenInt.len = bt2c::DataLen::fromBits(0);
+    }
+
+    /*
+     * Decodes the remaining bytes of the current variable-length
+     * integer field one at a time, updating `_mCurVarLenInt`, until
+     * its last byte.
+     */
+    template <bt2c::Signedness SignednessV>
+    void _decodeVarLenIntBytes()
+    {
         while (true) {
             /*
              * Read a single byte, and then:
@@ -3954,10 +4371,7 @@ private:
              *     Continue.
              *
              * Otherwise:
-             *     Set the variable-length integer element.
-             *
-             *     The caller is responsible for preparing or not to
-             *     read the next field.
+             *     Return.
              *
              * See <https://en.wikipedia.org/wiki/LEB128>.
              */
@@ -3969,52 +4383,12 @@ private:
             /* Read current byte */
             const auto byte = *this->_bufAtHead();
 
-            if ((byte & 0x80) == 0) {
-                /* This is the last byte */
-                this->_appendVarLenIntByte<SignednessV>(byte);
-
-                /*
-                 * Update for user.
-                 *
-                 * `_headOffsetInItemSeq()` now returns the offset at
-                 * the _end_ of the variable-length integer; the
-                 * iterator user expects its beginning offset.
-                 */
-                item._val(internal::VarLenIntFieldVal<SignednessV>::val(_mCurVarLenInt.len,
-                                                                        _mCurVarLenInt.val));
-                item._mLen = _mCurVarLenInt.len;
-                this->_setFieldItemFc(item, *_mCurScalarFc);
-                this->_updateForUser(item, this->_headOffsetInItemSeq() - item.fieldLen());
-
-                /*
-                 * Any state handler which calls this method template
-                 * may be reentered as is. This may happen if the
-                 * _requireContentData() call above throws
-                 * `bt2c::TryAgain`, for example.
-                 *
-                 * This means there's no initial setup to read a
-                 * variable-length integer field: the state handlers
-                 * just call this method template to start _and_ to
-                 * continue.
-                 *
-                 * Because of this, and because both
-                 * `_mCurVarLenInt.len` and `_mCurVarLenInt.val` must be
-                 * zero before starting to read a variable-length
-                 * integer field, we reset them here for the next
-                 * variable-length integer field reading operation.
-                 *
-                 * _resetForNewPkt() also resets both variables before
-                 * starting to read a packet.
-                 */
-                _mCurVarLenInt.val = 0;
-                _mCurVarLenInt.len = bt2c::DataLen::fromBits(0);
+            this->_appendVarLenIntByte<SignednessV>(byte);
 
-                /* Done */
+            if ((byte & 0x80) == 0) {
+                /* This was the last byte */
                 return;
             }
-
-            /* Not the last byte */
-            this->_appendVarLenIntByte<SignednessV>(byte);
         }
     }
 
@@ -4108,6 +4482,13 @@ private:
     TraceCls::SavedKeyValCountUpdatedObservable::Token
         _mTraceClsSavedKeyValCountUpdatedObservableToken;
 
+    /*
+     * State machine runner, specialized once for the trace class:
+     * `&ItemSeqIter::_runStateMachine<_Ctf1Traits>` or
+     * `&ItemSeqIter::_runStateMachine<_Ctf2Traits>`.
+     */
+    _StateHandlingReaction (ItemSeqIter::*_mRunStateMachine)();
+
     /* Current state */
     _State _mState = _State::Init;
 
@@ -4227,6 +4608,12 @@ private:
     /* Current scalar field class */
     const Fc *_mCurScalarFc = nullptr;
 
+    /*
+     * Offset, within the current packet, of the beginning of the
+     * current structure field having a fixed layout.
+     */
+    bt2c::DataLen _mFixedLayoutStructFieldOffsetInCurPkt = bt2c::DataLen::fromBits(0);
+
     /* Current scope */
     struct
     {
@@ -4243,19 +4630,52 @@ private:
         bt2c::DataLen content = bt2c::DataLen::fromBits(0);
     } _mCurPktExpectedLens;
 
-    /* Stack */
-    std::vector<_StackFrame> _mStack;
+    /*
+     * Stack.
+     *
+     * Most metadata streams don't nest deeper than this inline
+     * capacity, so that decoding never allocates.
+     */
+    bt2c::SmallVector<_StackFrame, 16> _mStack;
 
     /*
      * Saved key values (dynamic-length field lengths and
      * variant/optional field selectors).
      */
-    std::vector<unsigned long long> _mSavedKeyVals;
+    bt2c::SmallVector<unsigned long long, 16> _mSavedKeyVals;
 
     unsigned long long _mDefClkValPerStream[16] = {0};
 
     unsigned long long _mStreamClassID = 0;
 
+#ifdef BT_CTF_SRC_STATS
+    /* Logs the statistics of `_mStats` */
+    void _logStats() const;
+
+    /* Decoding statistics (see "Statistics" above) */
+    struct
+    {
+        /* Statistics of a single state */
+        struct StateStats
+        {
+            /* Number of times _handleState() handled this state */
+            unsigned long long count = 0;
+
+            /* Total time spent in the state handler */
+            std::chrono::steady_clock::duration elapsed {0};
+        };
+
+        /*
+         * Indexed with `_State` (a vector because `_State` is
+         * incomplete here).
+         */
+        std::vector<StateStats> states;
+
+        /* Number of prepared fields, indexed with `FcDeepType` */
+        std::array<unsigned long long, wise_enum::enumerators<FcDeepType>::size> fieldCounts {};
+    } _mStats;
+#endif
+
     /* Logging configuration */
     bt2c::Logger _mLogger;
 };
@@ -4321,10 +4741,19 @@ struct ReadFixedLenIntFunc<SignednessV, 0, ByteOrder::Big, BitOrderV> final
     {
         iter._checkLastFixedLenBitArrayFieldByteOrder(fc);
 
+        using namespace bt2c::literals::datalen;
+
+        const auto bitOffset = iter._mHeadOffsetInCurPkt.extraBitCount();
         ReadFixedLenIntFuncRet<SignednessV> val;
 
-        bt_bitfield_read_be(iter._bufAtHead(), std::uint8_t,
-                            iter._mHeadOffsetInCurPkt.extraBitCount(), *fc.len(), &val);
+        if (iter._remainingBufLen() >= 64_bits && bitOffset + *fc.len() <= 64) {
+            /* Fast path: single 64-bit load */
+            val = bt2c::readFixedLenBitArrayBe<ReadFixedLenIntFuncRet<SignednessV>>(
+                iter._bufAtHead(), bitOffset, *fc.len());
+        } else {
+            bt_bitfield_read_be(iter._bufAtHead(), std::uint8_t, bitOffset, *fc.len(), &val);
+        }
+
         return reverseFixedLenIntBitsIfNeeded<SignednessV, BitOrderV>(val, fc.len());
     }
 };
@@ -4340,10 +4769,19 @@ struct ReadFixedLenIntFunc<SignednessV, 0, ByteOrder::Little, BitOrderV> final
     {
         iter._checkLastFixedLenBitArrayFieldByteOrder(fc);
 
+        using namespace bt2c::literals::datalen;
+
+        const auto bitOffset = iter._mHeadOffsetInCurPkt.extraBitCount();
         ReadFixedLenIntFuncRet<SignednessV> val;
 
-        bt_bitfield_read_le(iter._bufAtHead(), std::uint8_t,
-                            iter._mHeadOffsetInCurPkt.extraBitCount(), *fc.len(), &val);
+        if (iter._remainingBufLen() >= 64_bits && bitOffset + *fc.len() <= 64) {
+            /* Fast path: single 64-bit load */
+            val = bt2c::readFixedLenBitArrayLe<ReadFixedLenIntFuncRet<SignednessV>>(
+                iter._bufAtHead(), bitOffset, *fc.len());
+        } else {
+            bt_bitfield_read_le(iter._bufAtHead(), std::uint8_t, bitOffset, *fc.len(), &val);
+        }
+
         return reverseFixedLenIntBitsIfNeeded<SignednessV, BitOrderV>(val, fc.len());
     }
 };
@@ -5,6 +5,8 @@
  */
 
 #include "common/assert.h"
+#include "common/common.h"
+#include "cpp-common/bt2c/exc.hpp"
 
 #include "medium.hpp"
 
@@ -24,5 +26,31 @@ Buf Buf::slice(const bt2c::DataLen offset) const noexcept
     return Buf {_mAddr + offset.bytes(), _mSize - offset};
 }
 
+Buf BufResult::bufOrThrow() const
+{
+    switch (_mStatus) {
+    case Status::Ok:
+        return _mBuf;
+    case Status::NoData:
+        throw NoData {};
+    case Status::TryAgain:
+        throw bt2c::TryAgain {};
+    }
+
+    bt_common_abort();
+}
+
+BufResult Medium::tryBuf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                         const bt2c::DataLen prefSize)
+{
+    try {
+        return BufResult {this->buf(offset, minSize, prefSize)};
+    } catch (const NoData&) {
+        return BufResult::noData();
+    } catch (const bt2c::TryAgain&) {
+        return BufResult::tryAgain();
+    }
+}
+
 } /* namespace src */
 } /* namespace ctf */
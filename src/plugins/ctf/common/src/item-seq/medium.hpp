@@ -79,15 +79,91 @@ public:
     explicit NoData() noexcept = default;
 };
 
+/*
+ * Result of Medium::tryBuf(): a status and, if the status is
+ * `BufResult::Status::Ok`, a buffer.
+ */
+class BufResult final
+{
+public:
+    enum class Status
+    {
+        /* The buffer is available */
+        Ok,
+
+        /* No data at the requested offset (equivalent of `NoData`) */
+        NoData,
+
+        /*
+         * No data is available right now: try again later
+         * (equivalent of `bt2c::TryAgain`).
+         */
+        TryAgain,
+    };
+
+    /*
+     * Builds an `Ok` result containing `buf`.
+     */
+    explicit BufResult(const Buf buf) noexcept : _mBuf {buf}
+    {
+    }
+
+    static BufResult noData() noexcept
+    {
+        return BufResult {Status::NoData};
+    }
+
+    static BufResult tryAgain() noexcept
+    {
+        return BufResult {Status::TryAgain};
+    }
+
+    Status status() const noexcept
+    {
+        return _mStatus;
+    }
+
+    bool isOk() const noexcept
+    {
+        return _mStatus == Status::Ok;
+    }
+
+    /*
+     * Buffer of this result.
+     *
+     * isOk() must return true.
+     */
+    Buf buf() const noexcept
+    {
+        return _mBuf;
+    }
+
+    /*
+     * Returns buf() if isOk() returns true, or throws `NoData` or
+     * `bt2c::TryAgain`, depending on the status, otherwise.
+     */
+    Buf bufOrThrow() const;
+
+private:
+    explicit BufResult(const Status status) noexcept : _mStatus {status}
+    {
+    }
+
+    Status _mStatus = Status::Ok;
+    Buf _mBuf;
+};
+
 /*
  * A medium is the data provider of an item sequence iterator.
  *
- * A concrete medium class needs to implement:
- *
- * • nextBuf() to return the next buffer of data.
- * • seek() to change its position.
+ * A concrete medium class needs to implement buf() to return the buffer
+ * of data at some offset.
  *
- * On construction, the current offset of the medium is 0.
+ * A medium for which "no data" and "try again" are frequent, expected
+ * outcomes (for example, a live medium which regularly waits for data)
+ * should also override tryBuf() so as to report them without throwing.
+ * In that case, its buf() implementation may simply call
+ * `this->tryBuf(...).bufOrThrow()`.
  */
 class Medium
 {
@@ -104,6 +180,14 @@ public:
      * Returns the buffer at the offset `offset` having a size of at
      * least `minSize`.
      *
+     * `prefSize`, greater than or equal to `minSize`, is a hint: it's
+     * the size of the data which the caller expects to read from
+     * `offset` (for example, the rest of the current packet). A medium
+     * which needs to copy or receive the data for each call should try
+     * to return a buffer of this size, if possible, instead of just
+     * `minSize` so as to reduce the number of calls. The returned
+     * buffer may be smaller or larger than `prefSize`.
+     *
      * The returned buffer is to be read only and borrowed: it remains
      * owned by this medium. Calling this method invalidates the
      * previously returned buffer by the same medium.
@@ -114,7 +198,8 @@ public:
      *
      * `minSize.bytes()` must be less than ten.
      *
-     * `minSize.hasExtraBits()` must be false.
+     * `minSize.hasExtraBits()` and `prefSize.hasExtraBits()` must
+     * be false.
      *
      * This method may throw:
      *
@@ -127,7 +212,19 @@ public:
      * Other:
      *     User error.
      */
-    virtual Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize) = 0;
+    virtual Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) = 0;
+
+    /*
+     * Like buf(), but returns a `BufResult::Status::NoData` or
+     * `BufResult::Status::TryAgain` result instead of throwing `NoData`
+     * or `bt2c::TryAgain`.
+     *
+     * The item sequence iterator always calls this method.
+     *
+     * The default implementation calls buf() and catches those
+     * exceptions. This method may still throw a user error.
+     */
+    virtual BufResult tryBuf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize);
 };
 
 } /* namespace src */
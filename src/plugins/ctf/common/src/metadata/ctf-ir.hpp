@@ -8,10 +8,13 @@
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_CTF_IR_HPP
 
 #include <cstdlib>
+#include <map>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2c/data-len.hpp"
 #include "cpp-common/bt2c/observable.hpp"
 #include "cpp-common/bt2c/text-loc.hpp"
 #include "cpp-common/vendor/wise-enum/wise_enum.h"
@@ -363,7 +366,9 @@ WISE_ENUM_CLASS(FcDeepType,
  * A field class FC of which the deep type contains `SaveVal` contains
  * key value saving indexes IX (keyValSavingIndexes() method).
  * keyValSavingIndexes() possibly returns more than one index because
- * many dependent fields may depend on the same key field.
+ * many dependent fields may depend on the same key field. Dependent
+ * fields having the exact same key fields share a single index (see
+ * TraceClsMixin::keyValSavingIndex()).
  *
  * When decoding an instance of FC (a key field), the decoder saves its
  * value to some vector V at the indexes IX. When decoding a dependent
@@ -383,6 +388,24 @@ struct CtfIrMixins;
  */
 using FcSet = std::set<ir::Fc<internal::CtfIrMixins> *>;
 
+/*
+ * Decode plan of a structure field class of which all the members are
+ * byte-aligned fixed-length integer field classes without roles.
+ *
+ * The layout of an instance of such a structure field class is fixed:
+ * an item sequence iterator may read all its members directly at
+ * known offsets, without aligning or checking the available data for
+ * each one of them, as long as the whole instance is available.
+ */
+struct StructFcFixedLayout final
+{
+    /* Offset of each member relative to the beginning of the structure */
+    std::vector<bt2c::DataLen> memberOffsets;
+
+    /* Total length of an instance */
+    bt2c::DataLen len = bt2c::DataLen::fromBits(0);
+};
+
 namespace internal {
 
 /*
@@ -716,6 +739,63 @@ private:
     FcSet _mKeyFcs;
 };
 
+/*
+ * Structure field class user mixin.
+ */
+class StructFcMixin
+{
+public:
+    explicit StructFcMixin() noexcept
+    {
+    }
+
+    /*
+     * Fixed layout of this field class, if any.
+     */
+    const bt2s::optional<StructFcFixedLayout>& fixedLayout() const noexcept
+    {
+        return _mFixedLayout;
+    }
+
+    /*
+     * Sets the fixed layout of this field class to `fixedLayout`.
+     */
+    void fixedLayout(bt2s::optional<StructFcFixedLayout> fixedLayout) noexcept
+    {
+        _mFixedLayout = std::move(fixedLayout);
+    }
+
+    /*
+     * Length of any instance of this field class, if it's static.
+     *
+     * An instance of this field class has a static length when all its
+     * inner fields have a static length: fixed-length fields as well as
+     * static-length array, BLOB, and string fields. Alignment padding
+     * within such an instance is part of its length, as the alignment
+     * of this field class is at least the one of any inner field class.
+     */
+    const bt2s::optional<bt2c::DataLen>& staticLen() const noexcept
+    {
+        return _mStaticLen;
+    }
+
+    /*
+     * Sets the static length of any instance of this field class
+     * to `staticLen`.
+     */
+    void staticLen(const bt2s::optional<bt2c::DataLen>& staticLen) noexcept
+    {
+        _mStaticLen = staticLen;
+    }
+
+private:
+    /* Fixed layout of this field class, if any */
+    bt2s::optional<StructFcFixedLayout> _mFixedLayout;
+
+    /* Static length of instances of this field class, if any */
+    bt2s::optional<bt2c::DataLen> _mStaticLen;
+};
+
 /*
  * Trace class user mixin.
  */
@@ -764,6 +844,50 @@ public:
         return _mSavedKeyValCountUpdatedObservable;
     }
 
+    /*
+     * Key value saving index of the dependent field classes of which
+     * the key field classes are exactly `keyFcs`, if any.
+     */
+    bt2s::optional<std::size_t> keyValSavingIndex(const FcSet& keyFcs) const
+    {
+        const auto it = _mKeyValSavingIndexes.find(keyFcs);
+
+        if (it == _mKeyValSavingIndexes.end()) {
+            return bt2s::nullopt;
+        }
+
+        return it->second;
+    }
+
+    /*
+     * Sets the key value saving index of the dependent field classes
+     * of which the key field classes are exactly `keyFcs` to `index`.
+     */
+    void keyValSavingIndex(FcSet keyFcs, const std::size_t index)
+    {
+        _mKeyValSavingIndexes.emplace(std::move(keyFcs), index);
+    }
+
+    /*
+     * Whether or not this trace class comes from a CTF 1 metadata
+     * stream, in which case it only contains field classes having a
+     * CTF 1.8 equivalent (no variable-length integer, BLOB, optional,
+     * or UTF-16/UTF-32 string field classes).
+     */
+    bool isCtf1() const noexcept
+    {
+        return _mIsCtf1;
+    }
+
+    /*
+     * Sets whether or not this trace class comes from a CTF 1 metadata
+     * stream to `isCtf1`.
+     */
+    void isCtf1(const bool isCtf1) noexcept
+    {
+        _mIsCtf1 = isCtf1;
+    }
+
 private:
     /* Equivalent libbabeltrace2 class (shared) */
     bt2::TraceClass::Shared _mSharedLibCls;
@@ -781,6 +905,15 @@ private:
      * by this trace class changes.
      */
     mutable SavedKeyValCountUpdatedObservable _mSavedKeyValCountUpdatedObservable;
+
+    /*
+     * Key value saving index of each distinct set of key field classes
+     * of dependent field classes.
+     */
+    std::map<FcSet, std::size_t> _mKeyValSavingIndexes;
+
+    /* Whether or not this trace class comes from a CTF 1 metadata stream */
+    bool _mIsCtf1 = false;
 };
 
 /*
@@ -794,6 +927,7 @@ struct CtfIrMixins final : public ir::DefUserMixins
     using FixedLenBoolFc = KeyFcMixin<ir::FixedLenBoolFc<internal::CtfIrMixins>>;
     using FixedLenIntFc = KeyFcMixin<ir::FixedLenIntFc<internal::CtfIrMixins>>;
     using VarLenIntFc = KeyFcMixin<ir::VarLenIntFc<internal::CtfIrMixins>>;
+    using StructFc = StructFcMixin;
     using DynLenStrFc = DependentFcMixin;
     using DynLenBlobFc = DependentFcMixin;
     using DynLenArrayFc = DependentFcMixin;
@@ -4,9 +4,13 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <thread>
 
 #include "common/assert.h"
+#include "cpp-common/bt2/error.hpp"
 #include "cpp-common/bt2c/contains.hpp"
 #include "cpp-common/bt2c/exc.hpp"
 #include "cpp-common/bt2c/join.hpp"
@@ -46,6 +50,13 @@ Ctf2MetadataStreamParser::Ctf2MetadataStreamParser(
 {
 }
 
+#ifdef BT_CTF_SRC_STATS
+Ctf2MetadataStreamParser::~Ctf2MetadataStreamParser()
+{
+    this->_logStats(_mLogger);
+}
+#endif
+
 MetadataStreamParser::ParseRet
 Ctf2MetadataStreamParser::parse(const bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
                                 const ClkClsCfg& clkClsCfg, const bt2c::ConstBytes buffer,
@@ -53,6 +64,8 @@ Ctf2MetadataStreamParser::parse(const bt2::OptionalBorrowedObject<bt2::SelfCompo
 {
     Ctf2MetadataStreamParser parser {selfComp, clkClsCfg, parentLogger};
 
+    /* `buffer` is the whole metadata stream: nothing comes after */
+    parser._mKeepIncompleteFragment = false;
     parser.parseSection(buffer);
 
     if (!parser.traceCls() || parser.traceCls()->dataStreamClasses().empty()) {
@@ -71,15 +84,107 @@ Ctf2MetadataStreamParser::parse(const bt2::OptionalBorrowedObject<bt2::SelfCompo
 
 void Ctf2MetadataStreamParser::_parseSection(const bt2c::ConstBytes buffer)
 {
-    this->_parseFragments(buffer);
+    if (_mPendingFragmentBuf.empty()) {
+        this->_parseFragments(buffer);
+        return;
+    }
+
+    /*
+     * Complete the pending fragment of the previous sections with
+     * `buffer`.
+     *
+     * `_mCurOffsetInStream` is still the offset of the beginning of
+     * the pending fragment.
+     */
+    std::vector<std::uint8_t> fullBuf;
+
+    std::swap(fullBuf, _mPendingFragmentBuf);
+    fullBuf.insert(fullBuf.end(), buffer.begin(), buffer.end());
+    this->_parseFragments(bt2c::ConstBytes {fullBuf.data(), fullBuf.size()});
 }
 
+namespace {
+
+/*
+ * Returns whether or not the bytes from `begin` to `end` contain a
+ * complete JSON object or array, considering that nothing follows.
+ *
+ * This only tracks the nesting level outside of strings, leaving the
+ * actual validation to the JSON parser: anything else than an object
+ * or an array is considered complete.
+ */
+bool isCompleteJsonCompoundVal(const bt2c::ConstBytes::const_iterator begin,
+                               const bt2c::ConstBytes::const_iterator end) noexcept
+{
+    auto it = begin;
+
+    /* Skip leading whitespaces */
+    while (it != end && (*it == ' ' || *it == '\t' || *it == '\n' || *it == '\r')) {
+        ++it;
+    }
+
+    if (it == end) {
+        /* Nothing yet */
+        return false;
+    }
+
+    if (*it != '{' && *it != '[') {
+        return true;
+    }
+
+    std::size_t level = 0;
+    bool inStr = false;
+
+    for (; it != end; ++it) {
+        if (inStr) {
+            if (*it == '\\') {
+                /* Skip escaped character */
+                ++it;
+
+                if (it == end) {
+                    return false;
+                }
+            } else if (*it == '"') {
+                inStr = false;
+            }
+
+            continue;
+        }
+
+        switch (*it) {
+        case '"':
+            inStr = true;
+            break;
+        case '{':
+        case '[':
+            ++level;
+            break;
+        case '}':
+        case ']':
+            --level;
+
+            if (level == 0) {
+                return true;
+            }
+
+            break;
+        default:
+            break;
+        }
+    }
+
+    return false;
+}
+
+} /* namespace */
+
 void Ctf2MetadataStreamParser::_parseFragments(const bt2c::ConstBytes buffer)
 {
     BT_ASSERT(buffer.data());
 
     auto fragmentBegin = buffer.begin();
     const auto curSectionOffsetInStream = _mCurOffsetInStream;
+    std::vector<_Fragment> fragments;
 
     while (true) {
         /* Find the beginning pointer of the current JSON fragment */
@@ -93,7 +198,7 @@ void Ctf2MetadataStreamParser::_parseFragments(const bt2c::ConstBytes buffer)
 
         if (fragmentBegin == buffer.end()) {
             /* We're done */
-            return;
+            break;
         }
 
         /* Find the end pointer of the current JSON fragment */
@@ -109,26 +214,147 @@ void Ctf2MetadataStreamParser::_parseFragments(const bt2c::ConstBytes buffer)
                 bt2c::Error, this->_loc(buffer, fragmentBegin), "Expecting a fragment.");
         }
 
-        /* Parse one fragment */
-        _mCurOffsetInStream =
-            curSectionOffsetInStream + bt2c::DataLen::fromBytes(fragmentBegin - buffer.begin());
-        this->_parseFragment(bt2c::makeSpan(fragmentBegin, fragmentEnd));
+        if (fragmentEnd == buffer.end() && _mKeepIncompleteFragment &&
+            !isCompleteJsonCompoundVal(fragmentBegin, fragmentEnd)) {
+            /*
+             * The next section will complete this fragment: keep it
+             * for later, `_mCurOffsetInStream` being its offset.
+             */
+            BT_CPPLOGD_SPEC(_mLogger,
+                            "Keeping incomplete fragment for the next section: "
+                            "fragment-index={}, offset-in-stream={}, len={}",
+                            _mCurFragmentIndex + fragments.size(), _mCurOffsetInStream.bytes(),
+                            fragmentEnd - fragmentBegin);
+            _mPendingFragmentBuf.assign(fragmentBegin, fragmentEnd);
+            break;
+        }
+
+        /* Add one fragment to parse */
+        fragments.emplace_back();
+        fragments.back().buf = bt2c::makeSpan(fragmentBegin, fragmentEnd);
+        fragments.back().offsetInStream = _mCurOffsetInStream;
 
         /* Go to next fragment */
         fragmentBegin = fragmentEnd;
-        ++_mCurFragmentIndex;
     }
+
+    /* Parse and handle the fragments */
+    const auto endOffsetInStream = _mCurOffsetInStream;
+
+    for (std::size_t batchBegin = 0; batchBegin < fragments.size();
+         batchBegin += _maxFragmentBatchLen) {
+        const auto batchEnd = std::min(batchBegin + _maxFragmentBatchLen, fragments.size());
+
+        {
+            /* JSON parsing and validation, possibly concurrent */
+            const _StageTimer timer {*this, "json-parse"};
+
+            this->_parseFragmentBatch(fragments, batchBegin, batchEnd);
+        }
+
+        for (auto i = batchBegin; i < batchEnd; ++i) {
+            {
+                /* CTF IR object creation */
+                const _StageTimer timer {*this, "fragment-handling"};
+
+                this->_handleParsedFragment(fragments[i]);
+            }
+
+            /* Not needed anymore */
+            fragments[i].jsonVal.reset();
+            ++_mCurFragmentIndex;
+        }
+    }
+
+    _mCurOffsetInStream = endOffsetInStream;
 }
 
-void Ctf2MetadataStreamParser::_parseFragment(const bt2c::ConstBytes buffer)
+void Ctf2MetadataStreamParser::_parseFragment(_Fragment& fragment,
+                                              const Ctf2JsonAnyFragmentValReq& valReq,
+                                              const bt2c::Logger& logger)
 {
     try {
-        this->_handleFragment(*bt2c::parseJson(
-            bt2s::string_view {reinterpret_cast<const char *>(buffer.data()), buffer.size()},
-            _mCurOffsetInStream.bytes(), _mLogger));
+        fragment.jsonVal = bt2c::parseJson(
+            bt2s::string_view {reinterpret_cast<const char *>(fragment.buf.data()),
+                               fragment.buf.size()},
+            fragment.offsetInStream.bytes(), logger);
+
+        /* Validate the fragment */
+        valReq.validate(*fragment.jsonVal);
+    } catch (...) {
+        /* Let _handleParsedFragment() handle it */
+        fragment.exc = std::current_exception();
+        fragment.error = bt2::takeCurrentThreadError();
+    }
+}
+
+void Ctf2MetadataStreamParser::_parseFragmentBatch(std::vector<_Fragment>& fragments,
+                                                   const std::size_t begin, const std::size_t end)
+{
+    std::atomic<std::size_t> nextFragmentIndex {begin};
+    const auto work = [&fragments, &nextFragmentIndex,
+                       end](const Ctf2JsonAnyFragmentValReq& valReq, const bt2c::Logger& logger) {
+        while (true) {
+            const auto i = nextFragmentIndex++;
+
+            if (i >= end) {
+                break;
+            }
+
+            _parseFragment(fragments[i], valReq, logger);
+        }
+    };
+
+    const auto threadCount =
+        std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U),
+                              (end - begin) / _minFragmentsPerThread);
+
+    if (threadCount <= 1) {
+        work(_mFragmentValReq, _mLogger);
+        return;
+    }
+
+    BT_CPPLOGD_SPEC(_mLogger, "Parsing fragments concurrently: fragment-count={}, thread-count={}",
+                    end - begin, threadCount);
+
+    /*
+     * Each thread needs its own logger, as a logger isn't thread-safe,
+     * and therefore its own fragment requirement.
+     */
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this, &work] {
+            const bt2c::Logger logger {_mLogger, _mLogger.tag()};
+
+            work(Ctf2JsonAnyFragmentValReq {logger}, logger);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void Ctf2MetadataStreamParser::_handleParsedFragment(_Fragment& fragment)
+{
+    _mCurOffsetInStream = fragment.offsetInStream;
+
+    try {
+        if (fragment.exc) {
+            /* Parsing or validation failed */
+            if (fragment.error) {
+                bt2::moveErrorToCurrentThread(std::move(fragment.error));
+            }
+
+            std::rethrow_exception(fragment.exc);
+        }
+
+        this->_handleFragment(*fragment.jsonVal);
     } catch (const bt2c::Error&) {
         BT_CPPLOGE_TEXT_LOC_APPEND_CAUSE_AND_RETHROW(
-            this->_loc(buffer, buffer.begin()), "Invalid fragment #{}.", _mCurFragmentIndex + 1);
+            this->_loc(fragment.buf, fragment.buf.begin()), "Invalid fragment #{}.",
+            _mCurFragmentIndex + 1);
     }
 }
 
@@ -158,9 +384,6 @@ bt2s::optional<bt2c::Uuid> uuidOfObj(const bt2c::JsonObjVal& jsonObjVal)
 
 void Ctf2MetadataStreamParser::_handleFragment(const bt2c::JsonVal& jsonFragment)
 {
-    /* Validate the fragment */
-    _mFragmentValReq.validate(jsonFragment);
-
     /* Get type */
     auto& jsonFragmentObj = jsonFragment.asObj();
     auto& type = jsonFragmentObj.rawStrVal(jsonstr::type);
@@ -8,9 +8,14 @@
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_JSON_CTF_2_METADATA_STREAM_PARSER_HPP
 
 #include <cstdint>
+#include <exception>
+#include <vector>
 
 #include <babeltrace2/babeltrace.h>
 
+#include "cpp-common/bt2/error.hpp"
+#include "cpp-common/bt2c/json-val.hpp"
+
 #include "../ctf-ir.hpp"
 #include "../metadata-stream-parser.hpp"
 #include "ctf-2-fc-builder.hpp"
@@ -23,8 +28,14 @@ namespace src {
  * CTF 2 metadata stream (JSON text sequence) parser.
  *
  * Build an instance of `Ctf2MetadataStreamParser`, and then call
- * parseSection() as often as needed with one or more _complete_
- * CTF 2 fragments.
+ * parseSection() as often as needed with the next bytes of a CTF 2
+ * metadata stream.
+ *
+ * A section doesn't need to end with a complete fragment: the parser
+ * keeps the bytes of an incomplete last fragment and parses it once
+ * the next sections complete it. The parser validates and handles
+ * each complete fragment as soon as it gets it, and doesn't keep its
+ * JSON value afterwards.
  *
  * You may also call the static Ctf2MetadataStreamParser::parse() method
  * to parse a whole CTF 2 metadata stream.
@@ -41,6 +52,10 @@ public:
     explicit Ctf2MetadataStreamParser(bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
                                       const ClkClsCfg& clkClsCfg, const bt2c::Logger& parentLogger);
 
+#ifdef BT_CTF_SRC_STATS
+    ~Ctf2MetadataStreamParser() override;
+#endif
+
     /*
      * Parses the whole CTF 2 metadata stream in `buffer` and returns
      * the resulting trace class and optional metadata stream UUID on
@@ -55,22 +70,74 @@ private:
     void _parseSection(bt2c::ConstBytes buffer) override;
 
     /*
-     * Parses one or more complete fragments in `buffer`, updating the
-     * internal state on success, or appending a cause to the error of
-     * the current thread and throwing `bt2c::Error` otherwise.
+     * Parses the fragments in `buffer`, updating the internal state on
+     * success, or appending a cause to the error of the current thread
+     * and throwing `bt2c::Error` otherwise.
+     *
+     * If `_mKeepIncompleteFragment` is true and the last fragment of
+     * `buffer` is incomplete, then this method copies it to
+     * `_mPendingFragmentBuf` instead of parsing it.
      */
     void _parseFragments(bt2c::ConstBytes buffer);
 
     /*
-     * Parses the JSON fragment in `buffer`, updating the internal state
-     * on success, or appending a cause to the error of the current
-     * thread and throwing `bt2c::Error` on failure.
+     * Fragment to parse and handle.
+     */
+    struct _Fragment final
+    {
+        /* Text of the fragment, without RS */
+        bt2c::ConstBytes buf;
+
+        /* Offset of `buf` within the whole metadata stream */
+        bt2c::DataLen offsetInStream = bt2c::DataLen::fromBytes(0);
+
+        /* Parsed and validated JSON value, if successful */
+        bt2c::JsonVal::UP jsonVal;
+
+        /*
+         * Exception which parsing or validating the fragment threw,
+         * and corresponding thread error, if any.
+         */
+        std::exception_ptr exc;
+        bt2::UniqueConstError error {nullptr};
+    };
+
+    /*
+     * Parses and validates the JSON fragment `fragment` with the
+     * fragment requirement `valReq`, setting `fragment.jsonVal` on
+     * success, or `fragment.exc` and `fragment.error` on failure.
+     *
+     * This only depends on its parameters, so that different threads
+     * may call it at the same time with different requirements
+     * and loggers.
+     */
+    static void _parseFragment(_Fragment& fragment, const Ctf2JsonAnyFragmentValReq& valReq,
+                               const bt2c::Logger& logger);
+
+    /*
+     * Parses the fragments from `fragments[begin]` to
+     * `fragments[end - 1]`, concurrently if there are enough of them.
+     *
+     * Parsing and validating the fragments of a large metadata stream
+     * are most of its parsing time, and don't depend on the previous
+     * fragments. Handling them (building field classes and adding
+     * classes to the trace class) still happens afterwards, in order,
+     * within the calling thread.
      */
-    void _parseFragment(bt2c::ConstBytes buffer);
+    void _parseFragmentBatch(std::vector<_Fragment>& fragments, std::size_t begin,
+                             std::size_t end);
 
     /*
-     * Handles the JSON fragment `jsonFragment`, updating the internal
+     * Handles the parsed fragment `fragment`, updating the internal
      * state on success, or appending a cause to the error of the
+     * current thread and throwing `bt2c::Error` on failure (including
+     * if parsing or validating it failed).
+     */
+    void _handleParsedFragment(_Fragment& fragment);
+
+    /*
+     * Handles the validated JSON fragment `jsonFragment`, updating the
+     * internal state on success, or appending a cause to the error of the
      * current thread and throwing `bt2c::Error` on failure.
      */
     void _handleFragment(const bt2c::JsonVal& jsonFragment);
@@ -246,6 +313,12 @@ private:
     }
 
 private:
+    /* Maximum number of fragments to parse before handling them */
+    static constexpr std::size_t _maxFragmentBatchLen = 4096;
+
+    /* Minimum number of fragments per parsing thread */
+    static constexpr std::size_t _minFragmentsPerThread = 64;
+
     /* Logging configuration */
     bt2c::Logger _mLogger;
 
@@ -255,6 +328,21 @@ private:
     /* Current fragment index */
     std::size_t _mCurFragmentIndex = 0;
 
+    /*
+     * Whether or not to keep an incomplete last fragment of a section
+     * for the next section instead of parsing it.
+     *
+     * False when parsing a whole metadata stream: an incomplete last
+     * fragment is then an error.
+     */
+    bool _mKeepIncompleteFragment = true;
+
+    /*
+     * Bytes of the incomplete last fragment of the previous sections
+     * (starting at `_mCurOffsetInStream`), if any.
+     */
+    std::vector<std::uint8_t> _mPendingFragmentBuf;
+
     /* Fragment requirement */
     Ctf2JsonAnyFragmentValReq _mFragmentValReq;
 
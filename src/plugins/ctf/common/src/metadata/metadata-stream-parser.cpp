@@ -4,10 +4,19 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <algorithm>
 #include <cstring>
 
+#ifdef BT_CTF_SRC_STATS
+#    if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#        include <malloc.h>
+#        define BT_CTF_SRC_STATS_HAVE_MALLINFO2
+#    endif
+#endif
+
 #include "common/assert.h"
 #include "cpp-common/bt2/field-class.hpp"
+#include "cpp-common/bt2c/align.hpp"
 #include "cpp-common/bt2c/call.hpp"
 
 #include "../../metadata/json-strings.hpp"
@@ -317,9 +326,29 @@ private:
         scopeFc(*_mTraceCls, _mCurDataStreamCls, _mCurEventRecordCls, *fieldLoc.origin())
             .accept(finder);
 
+        /*
+         * Dependent field classes having the exact same key field
+         * classes always read the same saved value: make them share a
+         * single key value saving index so that the data stream decoder
+         * saves the value of a key field once per distinct set of key
+         * field classes instead of once per dependent field class.
+         *
+         * For example, without this, the decoder would save the value
+         * of a common event record context member which the dynamic
+         * arrays of N event record classes use as their length N times
+         * for each event record.
+         */
+        if (const auto existingIndex = _mTraceCls->keyValSavingIndex(finder.fcs())) {
+            fc.savedKeyValIndex(*existingIndex);
+            fc.keyFcs(finder.fcs());
+            return;
+        }
+
         /* Key value saving index to use */
         const auto keyValSavingIndex = _mTraceCls->savedKeyValCount();
 
+        _mTraceCls->keyValSavingIndex(finder.fcs(), keyValSavingIndex);
+
         /* Update maximum number of saved key values of `*_mTraceCls` */
         _mTraceCls->savedKeyValCount(keyValSavingIndex + 1);
 
@@ -494,6 +523,231 @@ void setSavedKeyValIndexes(TraceCls& traceCls)
     SavedKeyValIndexesSetter {traceCls};
 }
 
+/*
+ * Returns whether or not an instance of `fc` may be part of a
+ * structure field having a fixed layout, that is, whether or not it's
+ * a byte-aligned, natural bit order fixed-length integer field class
+ * without roles.
+ */
+bool isFixedLayoutMemberFc(const Fc& fc) noexcept
+{
+    switch (fc.deepType()) {
+    case FcDeepType::FixedLenUIntBa8:
+    case FcDeepType::FixedLenUIntBa8SaveVal:
+    case FcDeepType::FixedLenUIntBa16Le:
+    case FcDeepType::FixedLenUIntBa16LeSaveVal:
+    case FcDeepType::FixedLenUIntBa16Be:
+    case FcDeepType::FixedLenUIntBa16BeSaveVal:
+    case FcDeepType::FixedLenUIntBa32Le:
+    case FcDeepType::FixedLenUIntBa32LeSaveVal:
+    case FcDeepType::FixedLenUIntBa32Be:
+    case FcDeepType::FixedLenUIntBa32BeSaveVal:
+    case FcDeepType::FixedLenUIntBa64Le:
+    case FcDeepType::FixedLenUIntBa64LeSaveVal:
+    case FcDeepType::FixedLenUIntBa64Be:
+    case FcDeepType::FixedLenUIntBa64BeSaveVal:
+    case FcDeepType::FixedLenSIntBa8:
+    case FcDeepType::FixedLenSIntBa8SaveVal:
+    case FcDeepType::FixedLenSIntBa16Le:
+    case FcDeepType::FixedLenSIntBa16LeSaveVal:
+    case FcDeepType::FixedLenSIntBa16Be:
+    case FcDeepType::FixedLenSIntBa16BeSaveVal:
+    case FcDeepType::FixedLenSIntBa32Le:
+    case FcDeepType::FixedLenSIntBa32LeSaveVal:
+    case FcDeepType::FixedLenSIntBa32Be:
+    case FcDeepType::FixedLenSIntBa32BeSaveVal:
+    case FcDeepType::FixedLenSIntBa64Le:
+    case FcDeepType::FixedLenSIntBa64LeSaveVal:
+    case FcDeepType::FixedLenSIntBa64Be:
+    case FcDeepType::FixedLenSIntBa64BeSaveVal:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Returns the length of any instance of `fc`, if it's static, assuming
+ * that the static lengths of structure field classes within `fc` are
+ * already set.
+ */
+bt2s::optional<bt2c::DataLen> fcStaticLen(const Fc& fc) noexcept
+{
+    if (fc.isFixedLenBitArray()) {
+        return fc.asFixedLenBitArray().len();
+    } else if (fc.isStaticLenStr()) {
+        return bt2c::DataLen::fromBytes(fc.asStaticLenStr().len());
+    } else if (fc.isStaticLenBlob()) {
+        return bt2c::DataLen::fromBytes(fc.asStaticLenBlob().len());
+    } else if (fc.isStaticLenArray()) {
+        auto& arrayFc = fc.asStaticLenArray();
+        const auto elemLen = fcStaticLen(arrayFc.elemFc());
+
+        if (!elemLen) {
+            return bt2s::nullopt;
+        }
+
+        if (arrayFc.len() == 0) {
+            return 0_bits;
+        }
+
+        /*
+         * Each element after the first one begins at the first offset
+         * which satisfies the element alignment.
+         */
+        return bt2c::DataLen::fromBits(
+            bt2c::align(**elemLen, arrayFc.elemFc().align()) * (arrayFc.len() - 1) + **elemLen);
+    } else if (fc.isStruct()) {
+        return fc.asStruct().staticLen();
+    }
+
+    return bt2s::nullopt;
+}
+
+/*
+ * Sets the fixed layout (see the comment of `StructFcFixedLayout`) and
+ * the static length of all the structure field classes which have one.
+ */
+class StructFcLayoutSetter final : public FcVisitor
+{
+public:
+    explicit StructFcLayoutSetter(TraceCls& traceCls)
+    {
+        /*
+         * Process the whole trace class, skipping the scopes of the
+         * already translated objects: their layouts are already set and
+         * can't change anymore.
+         */
+        if (!traceCls.libCls()) {
+            this->_visitScopeFc(traceCls.pktHeaderFc());
+        }
+
+        for (auto& dataStreamCls : traceCls) {
+            if (!dataStreamCls->libCls()) {
+                this->_visitScopeFc(dataStreamCls->pktCtxFc());
+                this->_visitScopeFc(dataStreamCls->eventRecordHeaderFc());
+                this->_visitScopeFc(dataStreamCls->commonEventRecordCtxFc());
+            }
+
+            for (auto& eventRecordCls : *dataStreamCls) {
+                if (eventRecordCls->libCls()) {
+                    /* Already done */
+                    continue;
+                }
+
+                this->_visitScopeFc(eventRecordCls->specCtxFc());
+                this->_visitScopeFc(eventRecordCls->payloadFc());
+            }
+        }
+    }
+
+    void visit(StaticLenArrayFc& fc) override
+    {
+        fc.elemFc().accept(*this);
+    }
+
+    void visit(DynLenArrayFc& fc) override
+    {
+        fc.elemFc().accept(*this);
+    }
+
+    void visit(StructFc& structFc) override
+    {
+        StructFcFixedLayout layout;
+        auto isFixed = !structFc.isEmpty();
+        bt2s::optional<bt2c::DataLen> staticLen {0_bits};
+
+        for (auto& memberCls : structFc) {
+            auto& memberFc = memberCls.fc();
+
+            memberFc.accept(*this);
+
+            if (staticLen) {
+                if (const auto memberLen = fcStaticLen(memberFc)) {
+                    staticLen = bt2c::DataLen::fromBits(bt2c::align(**staticLen, memberFc.align())) +
+                                *memberLen;
+                } else {
+                    staticLen.reset();
+                }
+            }
+
+            if (!isFixed) {
+                continue;
+            }
+
+            if (!isFixedLayoutMemberFc(memberFc)) {
+                isFixed = false;
+                continue;
+            }
+
+            /*
+             * The alignment of `structFc` is at least the one of
+             * `memberFc`, therefore the offset of this member relative
+             * to the beginning of the structure is always the same.
+             */
+            const auto offset =
+                bt2c::DataLen::fromBits(bt2c::align(*layout.len, memberFc.align()));
+
+            layout.memberOffsets.push_back(offset);
+            layout.len = offset + memberFc.asFixedLenBitArray().len();
+        }
+
+        if (isFixed) {
+            structFc.fixedLayout(std::move(layout));
+        } else {
+            structFc.fixedLayout(bt2s::nullopt);
+        }
+
+        structFc.staticLen(staticLen);
+    }
+
+    void visit(OptionalWithBoolSelFc& fc) override
+    {
+        fc.fc().accept(*this);
+    }
+
+    void visit(OptionalWithUIntSelFc& fc) override
+    {
+        fc.fc().accept(*this);
+    }
+
+    void visit(OptionalWithSIntSelFc& fc) override
+    {
+        fc.fc().accept(*this);
+    }
+
+    void visit(VariantWithUIntSelFc& fc) override
+    {
+        this->_visitVariantFc(fc);
+    }
+
+    void visit(VariantWithSIntSelFc& fc) override
+    {
+        this->_visitVariantFc(fc);
+    }
+
+private:
+    void _visitScopeFc(StructFc * const structFc)
+    {
+        if (structFc) {
+            structFc->accept(*this);
+        }
+    }
+
+    template <typename VariantFcT>
+    void _visitVariantFc(VariantFcT& variantFc)
+    {
+        for (auto& opt : variantFc) {
+            opt.fc().accept(*this);
+        }
+    }
+};
+
+void setStructFcLayouts(TraceCls& traceCls)
+{
+    StructFcLayoutSetter {traceCls};
+}
+
 /*
  * Visits a field class recursively to check whether or not it contains
  * an unsigned integer field class having a given role.
@@ -2004,9 +2258,78 @@ MetadataStreamParser::MetadataStreamParser(
 void MetadataStreamParser::parseSection(const bt2c::ConstBytes buffer)
 {
     this->_parseSection(buffer);
-    this->_finalizeTraceCls();
+
+    {
+        const _StageTimer timer {*this, "finalize-trace-cls"};
+
+        this->_finalizeTraceCls();
+    }
+}
+
+#ifdef BT_CTF_SRC_STATS
+namespace {
+
+/*
+ * Returns the number of bytes currently allocated on the heap, or 0 if
+ * it's unknown.
+ */
+long long heapInUse() noexcept
+{
+#    ifdef BT_CTF_SRC_STATS_HAVE_MALLINFO2
+    return static_cast<long long>(mallinfo2().uordblks);
+#    else
+    return 0;
+#    endif
+}
+
+} /* namespace */
+
+MetadataStreamParser::_StageTimer::_StageTimer(MetadataStreamParser& parser,
+                                               const char * const stageName) noexcept :
+    _mParser {&parser},
+    _mStageName {stageName}, _mBegin {std::chrono::steady_clock::now()}, _mHeapBegin {heapInUse()}
+{
+}
+
+MetadataStreamParser::_StageTimer::~_StageTimer()
+{
+    _mParser->_addStageStats(_mStageName, std::chrono::steady_clock::now() - _mBegin,
+                             heapInUse() - _mHeapBegin);
 }
 
+void MetadataStreamParser::_addStageStats(const char * const stageName,
+                                          const std::chrono::steady_clock::duration elapsed,
+                                          const long long heapGrowth)
+{
+    auto it = std::find_if(_mStats.begin(), _mStats.end(), [stageName](const _StageStats& stats) {
+        return std::strcmp(stats.name, stageName) == 0;
+    });
+
+    if (it == _mStats.end()) {
+        _mStats.push_back({stageName, 0, std::chrono::steady_clock::duration {0}, 0});
+        it = _mStats.end() - 1;
+    }
+
+    ++it->count;
+    it->elapsed += elapsed;
+    it->heapGrowth += heapGrowth;
+}
+
+void MetadataStreamParser::_logStats(const bt2c::Logger& logger) const
+{
+    using namespace std::chrono;
+
+    BT_CPPLOGI_SPEC(logger, "Metadata stream parsing statistics per stage: addr={}, stage-count={}",
+                    fmt::ptr(this), _mStats.size());
+
+    for (const auto& stats : _mStats) {
+        BT_CPPLOGI_SPEC(logger, "  {}: count={}, elapsed-ns={}, heap-growth-bytes={}", stats.name,
+                        stats.count, duration_cast<nanoseconds>(stats.elapsed).count(),
+                        stats.heapGrowth);
+    }
+}
+#endif
+
 void MetadataStreamParser::_adjustClkClsOffsetFromOrigin(ClkCls& clkCls) noexcept
 {
     auto offsetSeconds = static_cast<long long>(_mClkClsCfg.offsetSec);
@@ -2066,6 +2389,13 @@ void MetadataStreamParser::_finalizeTraceCls()
      */
     setSavedKeyValIndexes(*_mTraceCls);
 
+    /*
+     * Set the fixed layout and static length of structure field
+     * classes so that item sequence iterators may decode or skip their
+     * instances at once.
+     */
+    setStructFcLayouts(*_mTraceCls);
+
     /* Adjust clock classes, if needed */
     for (const auto& dataStreamCls : *_mTraceCls) {
         const auto clkCls = dataStreamCls->defClkCls();
@@ -2090,9 +2420,14 @@ void MetadataStreamParser::_finalizeTraceCls()
 
     /* Translates CTF IR objects to their trace IR equivalents */
     if (_mSelfComp) {
-        LibTraceClsFromTraceClsTranslator {*_mTraceCls, *_mSelfComp};
+        translateTraceClsToLib(*_mTraceCls, *_mSelfComp);
     }
 }
 
+void translateTraceClsToLib(TraceCls& traceCls, const bt2::SelfComponent selfComp)
+{
+    LibTraceClsFromTraceClsTranslator {traceCls, selfComp};
+}
+
 } /* namespace src */
 } /* namespace ctf */
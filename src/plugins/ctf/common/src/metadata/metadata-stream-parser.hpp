@@ -7,12 +7,15 @@
 #ifndef BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_METADATA_STREAM_PARSER_HPP
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_METADATA_STREAM_PARSER_HPP
 
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "cpp-common/bt2/self-component-port.hpp"
 #include "cpp-common/bt2c/aliases.hpp"
+#include "cpp-common/bt2c/logging.hpp"
 #include "cpp-common/bt2c/uuid.hpp"
 
 #include "../clk-cls-cfg.hpp"
@@ -31,6 +34,14 @@ extern const char * const lttngUserAttrsNs;
 
 /*
  * Abstract base CTF metadata stream parser class.
+ *
+ * When building with the `BT_CTF_SRC_STATS` definition (configure with
+ * `BABELTRACE_CTF_SRC_STATS=1`), the parser counts, for each parsing
+ * stage which a derived class times with a `_StageTimer` instance, how
+ * many times it ran, the total time it spent in it, and, with glibc
+ * 2.33 or later, the net heap growth during it. The destructor of a
+ * derived class logs those statistics at the INFO level with
+ * _logStats().
  */
 class MetadataStreamParser
 {
@@ -95,6 +106,50 @@ protected:
         return _mSelfComp;
     }
 
+    /*
+     * Scoped timer of the parsing stage named `stageName` (static
+     * storage) of `parser`: adds what happened between its construction
+     * and its destruction to the statistics of this stage.
+     *
+     * No-op without the `BT_CTF_SRC_STATS` definition.
+     */
+    class _StageTimer final
+    {
+    public:
+#ifdef BT_CTF_SRC_STATS
+        explicit _StageTimer(MetadataStreamParser& parser, const char *stageName) noexcept;
+        ~_StageTimer();
+#else
+        explicit _StageTimer(MetadataStreamParser&, const char *) noexcept
+        {
+        }
+#endif
+
+        _StageTimer(const _StageTimer&) = delete;
+        _StageTimer& operator=(const _StageTimer&) = delete;
+
+#ifdef BT_CTF_SRC_STATS
+    private:
+        MetadataStreamParser *_mParser;
+        const char *_mStageName;
+        std::chrono::steady_clock::time_point _mBegin;
+        long long _mHeapBegin;
+#endif
+    };
+
+#ifdef BT_CTF_SRC_STATS
+    /*
+     * Adds one run of `elapsed` and of a net heap growth of
+     * `heapGrowth` bytes to the statistics of the parsing stage named
+     * `stageName` (static storage).
+     */
+    void _addStageStats(const char *stageName, std::chrono::steady_clock::duration elapsed,
+                        long long heapGrowth = 0);
+
+    /* Logs the parsing statistics with `logger` */
+    void _logStats(const bt2c::Logger& logger) const;
+#endif
+
 private:
     virtual void _parseSection(bt2c::ConstBytes buffer) = 0;
 
@@ -148,8 +203,36 @@ private:
 
     /* Self component, used to finalize `*_mTraceCls` */
     bt2::OptionalBorrowedObject<bt2::SelfComponent> _mSelfComp;
+
+#ifdef BT_CTF_SRC_STATS
+    /* Statistics of a single parsing stage */
+    struct _StageStats final
+    {
+        const char *name;
+
+        /* Number of runs */
+        unsigned long long count;
+
+        /* Total time spent in the stage */
+        std::chrono::steady_clock::duration elapsed;
+
+        /* Total net heap growth (bytes) */
+        long long heapGrowth;
+    };
+
+    /* Parsing statistics, in order of first run */
+    std::vector<_StageStats> _mStats;
+#endif
 };
 
+/*
+ * Translates the objects of `traceCls` which don't have their trace IR
+ * equivalent yet (all of them when a metadata stream parser without a
+ * self component created `traceCls`) to trace IR objects created from
+ * `selfComp`.
+ */
+void translateTraceClsToLib(TraceCls& traceCls, bt2::SelfComponent selfComp);
+
 } /* namespace src */
 } /* namespace ctf */
 
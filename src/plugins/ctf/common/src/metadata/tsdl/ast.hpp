@@ -7,6 +7,7 @@
 #ifndef BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_TSDL_AST_HPP
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_TSDL_AST_HPP
 
+#include <chrono>
 #include <memory>
 
 #include <glib.h>
@@ -501,6 +502,15 @@ struct ctf_visitor_generate_ir
 
     /* True if this is an LTTng trace */
     bool is_lttng = false;
+
+#ifdef BT_CTF_SRC_STATS
+    /*
+     * Total time spent in the `ctf-meta-*` passes of
+     * ctf_visitor_generate_ir_visit_node() (statistics of
+     * `Ctf1MetadataStreamParser`).
+     */
+    std::chrono::steady_clock::duration metaPassesElapsed {0};
+#endif
 };
 
 ctf_visitor_generate_ir::UP ctf_visitor_generate_ir_create(const bt2c::Logger& parentLogger);
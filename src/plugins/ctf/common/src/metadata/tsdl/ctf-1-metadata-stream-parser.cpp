@@ -10,6 +10,7 @@
 #include "common/common.h"
 #include "compat/memstream.h"
 #include "cpp-common/bt2c/aliases.hpp"
+#include "cpp-common/bt2c/call.hpp"
 
 #include "../../../metadata/json-strings.hpp"
 #include "../ctf-ir.hpp"
@@ -450,9 +451,21 @@ bt2c::FileUP Ctf1MetadataStreamParser::_fileUpFromStr(const std::string& str)
 void Ctf1MetadataStreamParser::_parseSection(const bt2c::ConstBytes buffer)
 {
     {
-        const auto metadataStr = _mStreamDecoder.decode(buffer);
+        const auto metadataStr = bt2c::call([this, buffer] {
+            const _StageTimer timer {*this, "decode"};
+
+            return _mStreamDecoder.decode(buffer);
+        });
         const auto plaintextFile = this->_fileUpFromStr(metadataStr);
 
+        /* Lexing and AST building happen together (Bison parser) */
+        const _StageTimer timer {*this, "lex-parse"};
+
+        if (ctf_scanner_reserve(_mScanner.get(), metadataStr.size())) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "Failed to allocate the metadata stream AST memory.");
+        }
+
         /* Append the metadata text content to the TSDL scanner */
         if (const auto ret = ctf_scanner_append_ast(_mScanner.get(), plaintextFile.get())) {
             BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
@@ -461,13 +474,22 @@ void Ctf1MetadataStreamParser::_parseSection(const bt2c::ConstBytes buffer)
     }
 
     /* Make some basic AST node validation */
-    if (const auto ret = ctf_visitor_semantic_check(0, &_mScanner.get()->ast->root, _mLogger)) {
-        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
-            bt2c::Error, "Failed to validate metadata stream AST nodes: ret={}", ret);
+    {
+        const _StageTimer timer {*this, "semantic-check"};
+
+        if (const auto ret =
+                ctf_visitor_semantic_check(0, &_mScanner.get()->ast->root, _mLogger)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "Failed to validate metadata stream AST nodes: ret={}", ret);
+        }
     }
 
-    /* Convert AST nodes to original CTF IR objects */
+    /*
+     * Convert AST nodes to original CTF IR objects (the statistics of
+     * this stage include the `ctf-meta-passes` ones).
+     */
     {
+        const _StageTimer timer {*this, "ir-generation"};
         const auto ret = ctf_visitor_generate_ir_visit_node(_mOrigCtfIrGenerator.get(),
                                                             &_mScanner.get()->ast->root);
 
@@ -485,8 +507,17 @@ void Ctf1MetadataStreamParser::_parseSection(const bt2c::ConstBytes buffer)
         }
     }
 
+#ifdef BT_CTF_SRC_STATS
+    this->_addStageStats("ctf-meta-passes", _mOrigCtfIrGenerator->metaPassesElapsed);
+    _mOrigCtfIrGenerator->metaPassesElapsed = std::chrono::steady_clock::duration {0};
+#endif
+
     /* Translate original CTF IR objects to current CTF IR ones */
-    this->_tryTranslate(*_mOrigCtfIrGenerator->ctf_tc);
+    {
+        const _StageTimer timer {*this, "translation"};
+
+        this->_tryTranslate(*_mOrigCtfIrGenerator->ctf_tc);
+    }
 }
 
 void Ctf1MetadataStreamParser::_tryTranslate(ctf_trace_class& origTraceCls)
@@ -565,6 +596,12 @@ Ctf1MetadataStreamParser::_translateTraceCls(ctf_trace_class& origTraceCls)
     auto traceCls = createTraceCls(std::move(ns), std::move(name), std::move(uid),
                                    envMapValFromOrigTraceCls(origTraceCls), std::move(pktHeaderFc));
 
+    /*
+     * Let the item sequence iterators select their CTF 1-only state
+     * machine.
+     */
+    traceCls->isCtf1(true);
+
     /* Mark original CTF IR trace class as translated */
     origTraceCls.is_translated = true;
 
@@ -717,6 +754,13 @@ Ctf1MetadataStreamParser::Ctf1MetadataStreamParser(
 {
 }
 
+#ifdef BT_CTF_SRC_STATS
+Ctf1MetadataStreamParser::~Ctf1MetadataStreamParser()
+{
+    this->_logStats(_mLogger);
+}
+#endif
+
 MetadataStreamParser::ParseRet
 Ctf1MetadataStreamParser::parse(const bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
                                 const ClkClsCfg& clkClsCfg, const bt2c::ConstBytes buffer,
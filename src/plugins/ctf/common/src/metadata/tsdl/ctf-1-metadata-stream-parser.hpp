@@ -106,6 +106,10 @@ public:
     explicit Ctf1MetadataStreamParser(bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
                                       const ClkClsCfg& clkClsCfg, const bt2c::Logger& parentLogger);
 
+#ifdef BT_CTF_SRC_STATS
+    ~Ctf1MetadataStreamParser() override;
+#endif
+
     /*
      * Parses the whole packetized or plain text CTF 1 metadata stream
      * in `buffer` and returns the resulting trace class and optional
@@ -103,25 +103,37 @@ static inline int update_stream_class_default_clock_class(struct ctf_stream_clas
     struct ctf_clock_class *clock_class = stream_class->default_clock_class;
     uint64_t i;
 
-    ret = find_mapped_clock_class(stream_class->packet_context_fc, &clock_class, logger);
-    if (ret) {
-        goto end;
-    }
+    /*
+     * The clock classes which the scopes of already translated classes
+     * map are already part of `stream_class->default_clock_class`, and
+     * those scopes can't change anymore: only visit the new ones.
+     */
+    if (!stream_class->is_translated) {
+        ret = find_mapped_clock_class(stream_class->packet_context_fc, &clock_class, logger);
+        if (ret) {
+            goto end;
+        }
 
-    ret = find_mapped_clock_class(stream_class->event_header_fc, &clock_class, logger);
-    if (ret) {
-        goto end;
-    }
+        ret = find_mapped_clock_class(stream_class->event_header_fc, &clock_class, logger);
+        if (ret) {
+            goto end;
+        }
 
-    ret = find_mapped_clock_class(stream_class->event_common_context_fc, &clock_class, logger);
-    if (ret) {
-        goto end;
+        ret = find_mapped_clock_class(stream_class->event_common_context_fc, &clock_class,
+                                      logger);
+        if (ret) {
+            goto end;
+        }
     }
 
     for (i = 0; i < stream_class->event_classes->len; i++) {
         struct ctf_event_class *event_class =
             (ctf_event_class *) stream_class->event_classes->pdata[i];
 
+        if (event_class->is_translated) {
+            continue;
+        }
+
         ret = find_mapped_clock_class(event_class->spec_context_fc, &clock_class, logger);
         if (ret) {
             goto end;
@@ -149,14 +161,16 @@ int ctf_trace_class_update_default_clock_classes(struct ctf_trace_class *ctf_tc,
     struct ctf_clock_class *clock_class = NULL;
     bt2c::Logger logger {parentLogger, "PLUGIN/CTF/META/UPDATE-DEF-CC"};
 
-    ret = find_mapped_clock_class(ctf_tc->packet_header_fc, &clock_class, logger);
-    if (ret) {
-        goto end;
-    }
+    if (!ctf_tc->is_translated) {
+        ret = find_mapped_clock_class(ctf_tc->packet_header_fc, &clock_class, logger);
+        if (ret) {
+            goto end;
+        }
 
-    if (clock_class) {
-        ret = -1;
-        goto end;
+        if (clock_class) {
+            ret = -1;
+            goto end;
+        }
     }
 
     for (i = 0; i < ctf_tc->stream_classes->len; i++) {
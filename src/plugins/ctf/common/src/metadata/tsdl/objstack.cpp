@@ -83,25 +83,48 @@ void objstack_destroy(struct objstack *objstack)
     delete objstack;
 }
 
-static struct objstack_node *objstack_append_node(struct objstack *objstack)
+/*
+ * Appends a new node of which the length is at least `min_len` bytes,
+ * but at least the double of the length of the last node.
+ */
+static struct objstack_node *objstack_append_node(struct objstack *objstack, size_t min_len)
 {
     struct objstack_node *last_node, *new_node;
+    size_t new_len;
 
     /* Get last node */
     last_node = bt_list_entry(objstack->head.prev, struct objstack_node, node);
 
     /* Allocate new node with double of size of last node */
-    new_node = (objstack_node *) calloc(sizeof(struct objstack_node) + (last_node->len << 1),
-                                        sizeof(char));
+    new_len = last_node->len << 1;
+    if (new_len < min_len) {
+        new_len = BT_ALIGN(min_len, OBJSTACK_ALIGN);
+    }
+
+    new_node = (objstack_node *) calloc(sizeof(struct objstack_node) + new_len, sizeof(char));
     if (!new_node) {
-        BT_CPPLOGE_SPEC(objstack->logger, "Failed to allocate one object stack node.");
+        BT_CPPLOGE_SPEC(objstack->logger,
+                        "Failed to allocate one object stack node: len={}", new_len);
         return NULL;
     }
     bt_list_add_tail(&new_node->node, &objstack->head);
-    new_node->len = last_node->len << 1;
+    new_node->len = new_len;
     return new_node;
 }
 
+int objstack_reserve(struct objstack *objstack, size_t len)
+{
+    struct objstack_node *last_node;
+
+    /* Get last node */
+    last_node = bt_list_entry(objstack->head.prev, struct objstack_node, node);
+    if (last_node->len - last_node->used_len >= len) {
+        return 0;
+    }
+
+    return objstack_append_node(objstack, len) ? 0 : -1;
+}
+
 void *objstack_alloc(struct objstack *objstack, size_t len)
 {
     struct objstack_node *last_node;
@@ -111,8 +134,8 @@ void *objstack_alloc(struct objstack *objstack, size_t len)
 
     /* Get last node */
     last_node = bt_list_entry(objstack->head.prev, struct objstack_node, node);
-    while (last_node->len - last_node->used_len < len) {
-        last_node = objstack_append_node(objstack);
+    if (last_node->len - last_node->used_len < len) {
+        last_node = objstack_append_node(objstack, len);
         if (!last_node) {
             return NULL;
         }
@@ -26,4 +26,12 @@ void objstack_destroy(struct objstack *objstack);
  */
 void *objstack_alloc(struct objstack *objstack, size_t len);
 
+/*
+ * Make sure that the next allocations of a total of len bytes don't
+ * need to allocate more memory, for example when knowing the size of
+ * the input in advance.
+ * Return -1 on error.
+ */
+int objstack_reserve(struct objstack *objstack, size_t len);
+
 #endif /* BABELTRACE_PLUGINS_CTF_COMMON_SRC_METADATA_TSDL_OBJSTACK_HPP */
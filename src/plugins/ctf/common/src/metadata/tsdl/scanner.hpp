@@ -36,6 +36,12 @@ struct ctf_scanner
     ctf_scanner_scope root_scope {};
     ctf_scanner_scope *cs = nullptr;
     struct objstack *objstack = nullptr;
+
+    /*
+     * Interned keywords and identifiers: `char *` (within `objstack`)
+     * to the same `char *`.
+     */
+    GHashTable *strings = nullptr;
 };
 
 struct ctf_scanner *ctf_scanner_alloc(const bt2c::Logger& parentLogger);
@@ -44,6 +50,14 @@ void ctf_scanner_free(struct ctf_scanner *scanner);
 
 int ctf_scanner_append_ast(struct ctf_scanner *scanner, FILE *input);
 
+/*
+ * Prepares `scanner` to parse `input_len` more bytes of TSDL text,
+ * preallocating its AST memory from this estimate.
+ *
+ * Returns -1 on error.
+ */
+int ctf_scanner_reserve(struct ctf_scanner *scanner, size_t input_len);
+
 static inline struct ctf_ast *ctf_scanner_get_ast(struct ctf_scanner *scanner)
 {
     return scanner->ast;
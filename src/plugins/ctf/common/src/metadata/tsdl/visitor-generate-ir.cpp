@@ -221,15 +221,20 @@ end:
 /**
  * Returns the GQuark of a prefixed alias.
  *
+ * If \p create is false, this function returns 0 when the prefixed
+ * alias doesn't have any GQuark yet, which means it's not registered
+ * in any scope, instead of adding it to the global quark table.
+ *
  * @param prefix	Prefix character
  * @param name		Name
+ * @param create	True to create the GQuark if needed
  * @returns		Associated GQuark, or 0 on error
  */
-static GQuark get_prefixed_named_quark(char prefix, const char *name)
+static GQuark get_prefixed_named_quark(char prefix, const char *name, bool create)
 {
     BT_ASSERT(name);
     std::string prname = std::string {prefix} + name;
-    return g_quark_from_string(prname.c_str());
+    return create ? g_quark_from_string(prname.c_str()) : g_quark_try_string(prname.c_str());
 }
 
 /**
@@ -254,7 +259,7 @@ static struct ctf_field_class *ctx_decl_scope_lookup_prefix_alias(struct ctx_dec
 
     BT_ASSERT(scope);
     BT_ASSERT(name);
-    qname = get_prefixed_named_quark(prefix, name);
+    qname = get_prefixed_named_quark(prefix, name, false);
     if (!qname) {
         goto end;
     }
@@ -369,7 +374,7 @@ static int ctx_decl_scope_register_prefix_alias(struct ctx_decl_scope *scope, ch
     BT_ASSERT(scope);
     BT_ASSERT(name);
     BT_ASSERT(decl);
-    qname = get_prefixed_named_quark(prefix, name);
+    qname = get_prefixed_named_quark(prefix, name, true);
     if (!qname) {
         ret = -ENOMEM;
         goto end;
@@ -4427,46 +4432,56 @@ int ctf_visitor_generate_ir_visit_node(struct ctf_visitor_generate_ir *ctx, stru
         goto end;
     }
 
-    /* Update default clock classes */
-    ret = ctf_trace_class_update_default_clock_classes(ctx->ctf_tc, ctx->logger);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
-    }
+    {
+#ifdef BT_CTF_SRC_STATS
+        const auto metaPassesBegin = std::chrono::steady_clock::now();
+#endif
 
-    /* Update trace class meanings */
-    ret = ctf_trace_class_update_meanings(ctx->ctf_tc);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
-    }
+        /* Update default clock classes */
+        ret = ctf_trace_class_update_default_clock_classes(ctx->ctf_tc, ctx->logger);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
 
-    /* Update text arrays and sequences */
-    ret = ctf_trace_class_update_text_array_sequence(ctx->ctf_tc);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
-    }
+        /* Update trace class meanings */
+        ret = ctf_trace_class_update_meanings(ctx->ctf_tc);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
 
-    /* Update structure/array/sequence alignments */
-    ret = ctf_trace_class_update_alignments(ctx->ctf_tc);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
-    }
+        /* Update text arrays and sequences */
+        ret = ctf_trace_class_update_text_array_sequence(ctx->ctf_tc);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
 
-    /* Resolve sequence lengths and variant tags */
-    ret = ctf_trace_class_resolve_field_classes(ctx->ctf_tc, ctx->logger);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
-    }
+        /* Update structure/array/sequence alignments */
+        ret = ctf_trace_class_update_alignments(ctx->ctf_tc);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
 
-    /* Validate what we have so far */
-    ret = ctf_trace_class_validate(ctx->ctf_tc, ctx->logger);
-    if (ret) {
-        ret = -EINVAL;
-        goto end;
+        /* Resolve sequence lengths and variant tags */
+        ret = ctf_trace_class_resolve_field_classes(ctx->ctf_tc, ctx->logger);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
+
+        /* Validate what we have so far */
+        ret = ctf_trace_class_validate(ctx->ctf_tc, ctx->logger);
+        if (ret) {
+            ret = -EINVAL;
+            goto end;
+        }
+
+#ifdef BT_CTF_SRC_STATS
+        ctx->metaPassesElapsed += std::chrono::steady_clock::now() - metaPassesBegin;
+#endif
     }
 
     /*
@@ -39,11 +39,23 @@ MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter, const ctf::src::Tra
 }
 
 bt2::ConstMessage::Shared MsgIter::next()
+{
+    bt2::ConstMessage::Shared msg;
+
+    if (this->tryNext(msg) == NextStatus::TryAgain) {
+        throw bt2c::TryAgain {};
+    }
+
+    return msg;
+}
+
+MsgIter::NextStatus MsgIter::tryNext(bt2::ConstMessage::Shared& msg)
 {
     BT_CPPLOGD("Getting next message: addr={}", fmt::ptr(this));
 
     if (_mIsDone) {
-        return bt2::ConstMessage::Shared {};
+        msg.reset();
+        return NextStatus::Ok;
     }
 
     /*
@@ -51,44 +63,52 @@ bt2::ConstMessage::Shared MsgIter::next()
      * the underlying item sequence iterator may yield more than one
      * message, but we return one at a time).
      */
-    if (auto msg = this->_releaseNextMsg()) {
-        return msg;
+    msg = this->_releaseNextMsg();
+
+    if (msg) {
+        return NextStatus::Ok;
     }
 
     try {
-        while (true) {
-            /*
-             * Get the next item from the underlying item
-             * sequence iterator.
-             */
-            if (const auto item = _mItemSeqIter.next()) {
-                if (item->type() == Item::Type::PktBegin) {
-                    _mShouldWork = true;
-                }
-
-                /* Handle item if needed */
-                if (_mShouldWork && (!_mSkipItemsUntilScopeEndItem || item->isScopeEnd())) {
-                    this->_handleItem(*item);
+        /*
+         * Handle the items of the underlying item sequence iterator
+         * until there's a message to return.
+         */
+        const auto status = _mItemSeqIter.tryAdvanceWhile([this, &msg](const Item& item) {
+            if (item.type() == Item::Type::PktBegin) {
+                _mShouldWork = true;
+            }
 
-                    if (item->type() == Item::Type::DataStreamInfo) {
-                        if (_mStream.cls().id() != _mCurStreamClassId) {
-                            _mShouldWork = false;
-                        }
-                    }
+            /* Handle item if needed */
+            if (_mShouldWork && (!_mSkipItemsUntilScopeEndItem || item.isScopeEnd())) {
+                this->_handleItem(item);
 
-                    if (auto msg = this->_releaseNextMsg()) {
-                        return msg;
+                if (item.type() == Item::Type::DataStreamInfo) {
+                    if (_mStream.cls().id() != _mCurStreamClassId) {
+                        _mShouldWork = false;
                     }
                 }
-            } else {
-                /* No more items: this is the end! */
-                break;
+
+                msg = this->_releaseNextMsg();
             }
+
+            return !msg;
+        });
+
+        switch (status) {
+        case ItemSeqIter::AdvanceStatus::Stopped:
+            BT_ASSERT_DBG(msg);
+            return NextStatus::Ok;
+        case ItemSeqIter::AdvanceStatus::End:
+            /* No more items: we're done! */
+            _mIsDone = true;
+            msg = _mSelfMsgIter.createStreamEndMessage(_mStream);
+            return NextStatus::Ok;
+        case ItemSeqIter::AdvanceStatus::TryAgain:
+            return NextStatus::TryAgain;
         }
 
-        /* We're done! */
-        _mIsDone = true;
-        return _mSelfMsgIter.createStreamEndMessage(_mStream);
+        bt_common_abort();
     } catch (const bt2c::Error&) {
         BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to create the next message: addr={}",
                                             fmt::ptr(this));
@@ -229,6 +249,12 @@ void MsgIter::_handleItem(const Item& item)
 void MsgIter::_handleItem(const PktBeginItem&)
 {
     BT_ASSERT_DBG(!_mCurPkt);
+
+    /*
+     * The library gets this packet from the packet pool of `_mStream`,
+     * reusing the context field of a recycled packet: handling the
+     * packet context items only updates its existing field values.
+     */
     this->_curPkt(_mStream.createPacket());
 }
 
@@ -279,6 +305,13 @@ void MsgIter::_handleItem(const ScopeBeginItem& item)
     BT_ASSERT(_mStack.empty());
     BT_ASSERT(!_mCurScopeField);
 
+    if (_mDroppingCurEventRecord) {
+        /* No event message to fill: fast-forward */
+        BT_ASSERT_DBG(!_mCurMsg);
+        _mSkipItemsUntilScopeEndItem = true;
+        return;
+    }
+
     /* Handle specific scope */
     switch (item.scope()) {
     case Scope::PktHeader:
@@ -369,6 +402,14 @@ void MsgIter::_handleItem(const PktContentEndItem&)
 void MsgIter::_handleItem(const EventRecordEndItem&)
 {
     BT_ASSERT_DBG(_mStack.empty());
+
+    if (_mDroppingCurEventRecord) {
+        /* Nothing to emit */
+        BT_ASSERT_DBG(!_mCurMsg);
+        _mDroppingCurEventRecord = false;
+        return;
+    }
+
     BT_ASSERT_DBG(_mCurMsg);
 
     /* Emit current message (move to message queue) */
@@ -608,6 +649,27 @@ bt2::Message::Shared MsgIter::_createEventMsg(const bt2::EventClass cls, const _
     }
 }
 
+bool MsgIter::_mustDropEventRecord(const EventRecordInfoItem& item) const noexcept
+{
+    if (!_mDropEventRecordsBeforeNsFromOrigin || !item.defClkVal()) {
+        return false;
+    }
+
+    const auto clkCls = _mStream.cls().defaultClockClass();
+
+    if (!clkCls) {
+        return false;
+    }
+
+    try {
+        return clkCls->cyclesToNsFromOrigin(*item.defClkVal()) <
+               *_mDropEventRecordsBeforeNsFromOrigin;
+    } catch (const bt2::OverflowError&) {
+        /* Can't tell: keep it */
+        return false;
+    }
+}
+
 void MsgIter::_handleItem(const EventRecordInfoItem& item)
 {
     // TODO: Test having a trace with only event record headers
@@ -625,6 +687,17 @@ void MsgIter::_handleItem(const EventRecordInfoItem& item)
         _mCurDefClkVal = *item.defClkVal();
     }
 
+    if (this->_mustDropEventRecord(item)) {
+        /*
+         * Don't create any event message: skip the contexts and
+         * payload of this event record if possible, and ignore their
+         * items otherwise.
+         */
+        _mDroppingCurEventRecord = true;
+        _mItemSeqIter.skipCurEventRecordCtxsAndPayload();
+        return;
+    }
+
     /*
      * Set as current message.
      *
@@ -893,7 +966,8 @@ void MsgIter::_handleItem(const OptionalFieldEndItem&)
 void MsgIter::_addMsgToQueue(bt2::ConstMessage::Shared msg)
 {
     BT_ASSERT_DBG(_mMsgQueue.len < _mMsgQueue.array.size());
-    _mMsgQueue.array[_mMsgQueue.len] = std::move(msg);
+    _mMsgQueue.array[(_mMsgQueue.head + _mMsgQueue.len) % _mMsgQueue.array.size()] =
+        std::move(msg);
     ++_mMsgQueue.len;
 }
 
@@ -903,10 +977,9 @@ bt2::ConstMessage::Shared MsgIter::_releaseNextMsg()
         return bt2::ConstMessage::Shared {};
     }
 
-    auto msg = std::move(_mMsgQueue.array.front());
+    auto msg = std::move(_mMsgQueue.array[_mMsgQueue.head]);
 
-    _mMsgQueue.array[0] = std::move(_mMsgQueue.array[1]);
-    _mMsgQueue.array[1] = std::move(_mMsgQueue.array[2]);
+    _mMsgQueue.head = (_mMsgQueue.head + 1) % _mMsgQueue.array.size();
     --_mMsgQueue.len;
     return msg;
 }
@@ -7,7 +7,8 @@
 #ifndef BABELTRACE_PLUGINS_CTF_COMMON_SRC_MSG_ITER_HPP
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_MSG_ITER_HPP
 
-#include <stack>
+#include <cstdint>
+#include <vector>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -15,6 +16,7 @@
 #include "cpp-common/bt2/message.hpp"
 #include "cpp-common/bt2/self-message-iterator.hpp"
 #include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2c/small-vector.hpp"
 #include "cpp-common/bt2c/unicode-conv.hpp"
 
 #include "item-seq/item-seq-iter.hpp"
@@ -100,6 +102,44 @@ public:
      * as `bt2c::Error`.
      */
     bt2::ConstMessage::Shared next();
+
+    /* Status of tryNext() */
+    enum class NextStatus
+    {
+        /* `msg` is the next message (empty: the iterator is ended) */
+        Ok,
+
+        /* The medium has no data right now: try again later */
+        TryAgain,
+    };
+
+    /*
+     * Like next(), but sets `msg` to the next message on success, and
+     * returns `NextStatus::TryAgain` instead of throwing
+     * `bt2c::TryAgain` when the medium reports "try again" between two
+     * packets or two event records (see
+     * ItemSeqIter::tryAdvanceWhile()).
+     *
+     * This method may still throw `bt2c::TryAgain` when the medium
+     * reports "try again" in the middle of a packet or event record.
+     */
+    NextStatus tryNext(bt2::ConstMessage::Shared& msg);
+
+    /*
+     * Makes this iterator drop the event records of which the default
+     * clock value, converted to nanoseconds from origin, is less than
+     * `nsFromOrigin`, or not drop any event record if `nsFromOrigin`
+     * is `bt2s::nullopt`.
+     *
+     * The iterator doesn't create any event message for a dropped event
+     * record and, when their lengths are static, skips its contexts and
+     * payload without decoding them.
+     */
+    void dropEventRecordsBefore(const bt2s::optional<std::int64_t> nsFromOrigin) noexcept
+    {
+        _mDropEventRecordsBeforeNsFromOrigin = nsFromOrigin;
+    }
+
     const bt2::Stream& stream() const noexcept
     {
         return _mStream;
@@ -367,7 +407,7 @@ private:
     void _stackTopGoToNextSubField()
     {
         BT_ASSERT_DBG(!_mStack.empty());
-        _mStack.top().goToNextSubField();
+        _mStack.back().goToNextSubField();
     }
 
     /*
@@ -376,7 +416,7 @@ private:
     bt2::Field _stackTopCurSubField()
     {
         BT_ASSERT_DBG(!_mStack.empty());
-        return _mStack.top().curSubField();
+        return _mStack.back().curSubField();
     }
 
     /*
@@ -385,7 +425,7 @@ private:
     bt2::Field _stackTopCurSubFieldAndGoToNextSubField()
     {
         BT_ASSERT_DBG(!_mStack.empty());
-        return _mStack.top().curSubFieldAndGoToNextSubField();
+        return _mStack.back().curSubFieldAndGoToNextSubField();
     }
 
     /*
@@ -394,7 +434,7 @@ private:
     template <typename FieldT>
     void _stackPush(FieldT&& field)
     {
-        _mStack.emplace(std::forward<FieldT>(field));
+        _mStack.emplace_back(std::forward<FieldT>(field));
     }
 
     /*
@@ -403,7 +443,7 @@ private:
     void _stackPop()
     {
         BT_ASSERT_DBG(!_mStack.empty());
-        _mStack.pop();
+        _mStack.pop_back();
     }
 
     /*
@@ -460,6 +500,12 @@ private:
      */
     void _emitDelayedPktBeginMsg(const _OptUll& otherDefClkVal);
 
+    /*
+     * Returns whether or not to drop the event record of which the
+     * info item is `item`.
+     */
+    bool _mustDropEventRecord(const EventRecordInfoItem& item) const noexcept;
+
     /*
      * Adds the message `msg` to the message queue.
      */
@@ -507,18 +553,27 @@ private:
      * three messages (see `_handleItem(const PktInfoItem&)`), therefore
      * it's a queue of up to three messages.
      *
-     * The head of the queue (the next message to return) is always at
-     * index 0 within `array`. `len` is the number of messages in
-     * the queue.
+     * This is a ring buffer: the head of the queue (the next message
+     * to return) is at index `head` within `array`, and `len` is the
+     * number of messages in the queue. This way, releasing a message
+     * doesn't move the other ones.
      */
     struct
     {
         std::array<bt2::ConstMessage::Shared, 3> array;
+        std::size_t head {0};
         std::size_t len {0};
     } _mMsgQueue;
 
-    /* Stack */
-    std::stack<_StackFrame> _mStack;
+    /*
+     * Stack.
+     *
+     * Pushing and popping a frame happens for each compound field:
+     * with an inline capacity, this never allocates for most metadata
+     * streams, and, beyond it, only until the stack reaches the
+     * maximum nesting depth.
+     */
+    bt2c::SmallVector<_StackFrame, 16> _mStack;
 
     /* Root field of current scope */
     bt2::OptionalBorrowedObject<bt2::StructureField> _mCurScopeField;
@@ -535,6 +590,15 @@ private:
      */
     bt2::Message::Shared _mCurMsg;
 
+    /*
+     * If set: drop the event records of which the timestamp is less
+     * than this value (nanoseconds from origin).
+     */
+    bt2s::optional<std::int64_t> _mDropEventRecordsBeforeNsFromOrigin;
+
+    /* Whether or not the current event record is dropped */
+    bool _mDroppingCurEventRecord = false;
+
     /*
      * If set: the current packet.
      *
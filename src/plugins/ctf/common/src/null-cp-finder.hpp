@@ -7,8 +7,15 @@
 #ifndef BABELTRACE_PLUGINS_CTF_COMMON_SRC_NULL_CP_FINDER_HPP
 #define BABELTRACE_PLUGINS_CTF_COMMON_SRC_NULL_CP_FINDER_HPP
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+
+#ifdef __SSE2__
+#    include <emmintrin.h>
+#endif
 
 #include "cpp-common/bt2c/aliases.hpp"
 #include "cpp-common/bt2s/optional.hpp"
@@ -66,6 +73,11 @@ namespace src {
  * unit size, the method can check the current code unit value: two
  * zeros, which means U+0000, which means the end of that
  * null-terminated string.
+ *
+ * Between two code units, findNullCp() skips the non-null code units
+ * many at a time (see _skipNonNullCodeUnits()), only feeding the code
+ * unit buffer with the bytes of a candidate and of the tail of the
+ * buffer.
  */
 template <std::size_t CodeUnitLenV>
 class NullCpFinder final
@@ -88,7 +100,19 @@ public:
     bt2s::optional<bt2c::ConstBytes::const_iterator>
     findNullCp(const bt2c::ConstBytes buffer) noexcept
     {
-        for (auto it = buffer.begin(); it != buffer.end(); ++it) {
+        const auto data = buffer.data();
+        const auto dataEnd = data + buffer.size();
+
+        for (auto it = data; it != dataEnd; ++it) {
+            if (_mCodeUnitBufLen == 0) {
+                /* Beginning of a code unit: skip non-null ones quickly */
+                it = _skipNonNullCodeUnits(it, dataEnd);
+
+                if (it == dataEnd) {
+                    break;
+                }
+            }
+
             _mCodeUnitBuf[_mCodeUnitBufLen] = *it;
             ++_mCodeUnitBufLen;
 
@@ -96,7 +120,7 @@ public:
                 /* New complete code unit: is it U+0000? */
                 if (_mCodeUnitBuf == _CodeUnitBuf {0}) {
                     /* Found U+0000 */
-                    return it + 1;
+                    return buffer.begin() + (it + 1 - data);
                 }
 
                 /* New empty code unit */
@@ -109,6 +133,70 @@ public:
     }
 
 private:
+    /*
+     * Returns the address of the first null code unit within
+     * [`begin`, `end`), `begin` being the beginning of a code unit, or,
+     * if there's none, the address of the remaining bytes (fewer than
+     * a stride) which this method didn't check.
+     *
+     * With UTF-8, this is std::memchr(), which the C library usually
+     * optimizes for the current CPU.
+     *
+     * With UTF-16 and UTF-32, this method checks 16 bytes at a time
+     * with SSE2 when available, or 8 bytes at a time within a 64-bit
+     * integer otherwise.
+     */
+    static const std::uint8_t *_skipNonNullCodeUnits(const std::uint8_t *begin,
+                                                     const std::uint8_t * const end) noexcept
+    {
+        if (CodeUnitLenV == 1) {
+            const auto nullByte = std::memchr(begin, 0, end - begin);
+
+            return nullByte ? static_cast<const std::uint8_t *>(nullByte) : end;
+        }
+
+#ifdef __SSE2__
+        const auto zero = _mm_setzero_si128();
+
+        for (; end - begin >= 16; begin += 16) {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+            const auto mask = _mm_movemask_epi8(CodeUnitLenV == 2 ? _mm_cmpeq_epi16(chunk, zero) :
+                                                                    _mm_cmpeq_epi32(chunk, zero));
+
+            if (mask != 0) {
+                /* First byte of the first null code unit */
+                return begin + __builtin_ctz(static_cast<unsigned int>(mask));
+            }
+        }
+#else
+        /* Lowest and highest bit of each code unit within a 64-bit word */
+        constexpr std::uint64_t loBits =
+            CodeUnitLenV == 2 ? 0x0001000100010001ULL : 0x0000000100000001ULL;
+        constexpr std::uint64_t hiBits = loBits << (CodeUnitLenV * 8 - 1);
+
+        for (; end - begin >= 8; begin += 8) {
+            std::uint64_t word;
+
+            std::memcpy(&word, begin, sizeof(word));
+
+            if (((word - loBits) & ~word & hiBits) != 0) {
+                /* At least one null code unit: find the first one */
+                auto it = begin;
+
+                while (!std::all_of(it, it + CodeUnitLenV, [](const std::uint8_t byte) {
+                    return byte == 0;
+                })) {
+                    it += CodeUnitLenV;
+                }
+
+                return it;
+            }
+        }
+#endif
+
+        return begin;
+    }
+
     /* Code unit buffer type */
     using _CodeUnitBuf = std::array<char, CodeUnitLenV>;
 
@@ -4,7 +4,6 @@
  * Copyright (c) 2022 EfficiOS Inc. and Linux Foundation
  */
 
-#include "../../common/src/item-seq/item-seq-iter.hpp"
 #include "../../common/src/item-seq/logging-item-visitor.hpp"
 #include "pkt-props.hpp"
 
@@ -42,21 +41,27 @@ private:
 };
 } /* namespace */
 
-PktProps readPktProps(const TraceCls& traceCls, Medium::UP medium, const bt2c::DataLen pktOffset,
-                      const bt2c::Logger& parentLogger)
+PktPropsReader::PktPropsReader(const TraceCls& traceCls, Medium::UP medium,
+                               const bt2c::Logger& parentLogger) :
+    _mLogger {parentLogger, "PLUGIN/CTF/PKT-PROPS"},
+    _mItemSeqIter {std::move(medium), traceCls, _mLogger}
+{
+}
+
+PktProps PktPropsReader::read(const bt2c::DataLen pktOffset)
 {
-    bt2c::Logger logger {parentLogger, "PLUGIN/CTF/PKT-PROPS"};
-    BT_CPPLOGD_SPEC(logger, "Reading packet properties: pkt-offset-bytes={}", pktOffset.bytes());
+    BT_CPPLOGD("Reading packet properties: pkt-offset-bytes={}", pktOffset.bytes());
 
-    ItemSeqIter itemSeqIter {std::move(medium), traceCls, pktOffset, logger};
     ReadPacketPropertiesItemVisitor visitor;
-    LoggingItemVisitor loggingVisitor {logger};
+    LoggingItemVisitor loggingVisitor {_mLogger};
+
+    _mItemSeqIter.seekPkt(pktOffset);
 
     while (!visitor.done()) {
-        const Item *item = itemSeqIter.next();
+        const Item *item = _mItemSeqIter.next();
         BT_ASSERT(item);
 
-        if (parentLogger.wouldLogT()) {
+        if (_mLogger.wouldLogT()) {
             item->accept(loggingVisitor);
         }
 
@@ -66,5 +71,11 @@ PktProps readPktProps(const TraceCls& traceCls, Medium::UP medium, const bt2c::D
     return visitor.props;
 }
 
+PktProps readPktProps(const TraceCls& traceCls, Medium::UP medium, const bt2c::DataLen pktOffset,
+                      const bt2c::Logger& parentLogger)
+{
+    return PktPropsReader {traceCls, std::move(medium), parentLogger}.read(pktOffset);
+}
+
 } /* namespace src */
 } /* namespace ctf */
@@ -11,6 +11,7 @@
 #include "cpp-common/bt2c/logging.hpp"
 #include "cpp-common/bt2s/optional.hpp"
 
+#include "item-seq/item-seq-iter.hpp"
 #include "item-seq/medium.hpp"
 #include "metadata/ctf-ir.hpp"
 
@@ -32,6 +33,31 @@ struct PktProps final
     } snapshots;
 };
 
+/*
+ * Reader of the properties of many packets of the same medium.
+ *
+ * Unlike calling readPktProps() for each packet, a packet properties
+ * reader reuses a single item sequence iterator, and therefore a
+ * single medium, for all the packets, only decoding each packet until
+ * the end of its context.
+ */
+class PktPropsReader final
+{
+public:
+    explicit PktPropsReader(const TraceCls& traceCls, Medium::UP medium,
+                            const bt2c::Logger& parentLogger);
+
+    /*
+     * Returns the properties of the packet at the offset `pktOffset`
+     * within the medium.
+     */
+    PktProps read(bt2c::DataLen pktOffset);
+
+private:
+    bt2c::Logger _mLogger;
+    ItemSeqIter _mItemSeqIter;
+};
+
 /*
  * Extract packet properties at offset.
  */
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.h"
+#include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "region-medium.hpp"
+
+namespace ctf {
+namespace src {
+
+constexpr std::size_t RegionMedium::maxStagedSize;
+
+RegionMedium::RegionMedium(Provider::UP provider, const bt2c::Logger& parentLogger) :
+    _mProvider {std::move(provider)}, _mLogger {parentLogger, "PLUGIN/CTF/REGION-MEDIUM"}
+{
+    BT_ASSERT(_mProvider);
+}
+
+RegionMedium::~RegionMedium()
+{
+    /* Give the remaining regions back to the provider */
+    while (!_mRegions.empty()) {
+        this->_retireFrontRegion();
+    }
+}
+
+void RegionMedium::_retireFrontRegion() noexcept
+{
+    BT_ASSERT_DBG(!_mRegions.empty());
+    _mProvider->retireRegion(_mRegions.front().region);
+    _mBeginOffset = _mRegions.front().endOffset();
+    _mRegions.pop_front();
+}
+
+Buf RegionMedium::buf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                      const bt2c::DataLen prefSize)
+{
+    return this->tryBuf(offset, minSize, prefSize).bufOrThrow();
+}
+
+BufResult RegionMedium::tryBuf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                               const bt2c::DataLen prefSize)
+{
+    BT_ASSERT_DBG(offset.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.bytes() > 0);
+
+    const auto reqOffset = offset.bytes();
+    const auto reqSize = minSize.bytes();
+
+    BT_CPPLOGT_SPEC(_mLogger, "tryBuf(): offset={}, min-size={}", reqOffset, reqSize);
+    BT_ASSERT(reqOffset >= _mBeginOffset);
+
+    while (true) {
+        /* Retire the regions which precede the requested offset */
+        while (!_mRegions.empty() && _mRegions.front().endOffset() <= reqOffset) {
+            this->_retireFrontRegion();
+        }
+
+        if (_mEndOffset >= reqOffset && _mEndOffset - reqOffset >= reqSize) {
+            break;
+        }
+
+        if (_mEnded) {
+            if (reqOffset >= _mEndOffset) {
+                return BufResult::noData();
+            }
+
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                _mLogger, bt2::Error,
+                "Data stream is truncated: offset={}, available-size={}, expected-size={}",
+                reqOffset, _mEndOffset - reqOffset, reqSize);
+        }
+
+        Region region;
+
+        switch (_mProvider->nextRegion(region)) {
+        case NextRegionStatus::Ok:
+            BT_CPPLOGD_SPEC(_mLogger, "Got region: addr={}, size={}, offset-in-stream={}",
+                            fmt::ptr(region.addr), region.size, _mEndOffset);
+            _mRegions.push_back(_StreamRegion {region, _mEndOffset});
+            _mEndOffset += region.size;
+            break;
+        case NextRegionStatus::End:
+            BT_CPPLOGD_SPEC(_mLogger, "Data stream is ended: size={}", _mEndOffset);
+            _mEnded = true;
+            break;
+        case NextRegionStatus::TryAgain:
+            return BufResult::tryAgain();
+        }
+    }
+
+    /* The first region contains the requested offset */
+    const auto& front = _mRegions.front();
+    const auto frontOffset = reqOffset - front.offset;
+    const auto frontLeft = front.region.size - frontOffset;
+
+    BT_ASSERT_DBG(reqOffset >= front.offset && reqOffset < front.endOffset());
+
+    if (frontLeft >= reqSize) {
+        /* Fast path: hand out the rest of the region, without copying */
+        return BufResult {Buf {front.region.addr + frontOffset, bt2c::DataLen::fromBytes(frontLeft)}};
+    }
+
+    /* Copy as much of the preferred size as the provided regions have */
+    const auto count = std::max<unsigned long long>(
+        reqSize, std::min<unsigned long long>(
+                     {prefSize.bytes(), maxStagedSize, _mEndOffset - reqOffset}));
+
+    _mStagingBuf.resize(count);
+
+    {
+        auto regionOffset = frontOffset;
+        std::size_t copied = 0;
+
+        for (auto it = _mRegions.begin(); copied < count; ++it) {
+            BT_ASSERT_DBG(it != _mRegions.end());
+
+            const auto len =
+                std::min<unsigned long long>(it->region.size - regionOffset, count - copied);
+
+            std::memcpy(&_mStagingBuf[copied], it->region.addr + regionOffset, len);
+            copied += len;
+            regionOffset = 0;
+        }
+    }
+
+    return BufResult {Buf {_mStagingBuf.data(), bt2c::DataLen::fromBytes(count)}};
+}
+
+} /* namespace src */
+} /* namespace ctf */
@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_CTF_COMMON_SRC_REGION_MEDIUM_HPP
+#define BABELTRACE_PLUGINS_CTF_COMMON_SRC_REGION_MEDIUM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "cpp-common/bt2c/logging.hpp"
+
+#include "item-seq/medium.hpp"
+
+namespace ctf {
+namespace src {
+
+/*
+ * Medium over the contiguous memory regions of a data stream, which a
+ * region provider (see `RegionMedium::Provider`) owns.
+ *
+ * The returned buffers point directly into the regions, except when
+ * the requested minimum size straddles two regions or more: then the
+ * medium copies the requested bytes to a staging buffer.
+ *
+ * The requested offsets must never decrease: the medium retires a
+ * region as soon as a request begins after its end, and retires the
+ * remaining ones when it's destroyed.
+ */
+class RegionMedium final : public Medium
+{
+public:
+    /* Memory region of a data stream */
+    struct Region final
+    {
+        /* Address of the first byte */
+        const std::uint8_t *addr;
+
+        /* Size (bytes), possibly zero */
+        std::size_t size;
+
+        /* Provider data */
+        void *data;
+    };
+
+    /* Status of Provider::nextRegion() */
+    enum class NextRegionStatus
+    {
+        /* The region is set */
+        Ok,
+
+        /* The data stream is ended */
+        End,
+
+        /* No region is available right now: try again later */
+        TryAgain,
+    };
+
+    /*
+     * Provider of the regions of a data stream.
+     */
+    class Provider
+    {
+    public:
+        using UP = std::unique_ptr<Provider>;
+
+    protected:
+        explicit Provider() noexcept = default;
+
+    public:
+        virtual ~Provider() = default;
+
+        /*
+         * Sets `region` to the next region of the data stream, the one
+         * following the previously provided region.
+         *
+         * May throw `bt2::Error`.
+         */
+        virtual NextRegionStatus nextRegion(Region& region) = 0;
+
+        /*
+         * Gives back the region `region`, which the medium doesn't need
+         * anymore.
+         *
+         * The medium retires the regions in the order of nextRegion().
+         */
+        virtual void retireRegion(const Region& region) noexcept = 0;
+    };
+
+    /* Maximum number of bytes which tryBuf() copies to satisfy `prefSize` */
+    static constexpr std::size_t maxStagedSize = 64 * 1024;
+
+    explicit RegionMedium(Provider::UP provider, const bt2c::Logger& parentLogger);
+    ~RegionMedium() override;
+
+    Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+    BufResult tryBuf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+
+private:
+    struct _StreamRegion final
+    {
+        unsigned long long endOffset() const noexcept
+        {
+            return offset + region.size;
+        }
+
+        Region region;
+
+        /* Offset of the first byte of `region` within the data stream */
+        unsigned long long offset;
+    };
+
+    void _retireFrontRegion() noexcept;
+
+    Provider::UP _mProvider;
+    bt2c::Logger _mLogger;
+
+    /* Regions not retired yet, in data stream order */
+    std::deque<_StreamRegion> _mRegions;
+
+    /* Offset of the first byte of the first region of `_mRegions` */
+    unsigned long long _mBeginOffset = 0;
+
+    /* Offset of the byte following the last provided region */
+    unsigned long long _mEndOffset = 0;
+
+    /* Whether or not the provider reported the end of the data stream */
+    bool _mEnded = false;
+
+    /* Staging buffer for requests which straddle two regions or more */
+    std::vector<std::uint8_t> _mStagingBuf;
+};
+
+} /* namespace src */
+} /* namespace ctf */
+
+#endif /* BABELTRACE_PLUGINS_CTF_COMMON_SRC_REGION_MEDIUM_HPP */
@@ -11,6 +11,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <vector>
+
 #include <babeltrace2/babeltrace.h>
 
 #include "common/assert.h"
@@ -238,6 +240,69 @@ fs_sink_ctf_field_class_as_variant(fs_sink_ctf_field_class *fc)
     return (fs_sink_ctf_field_class_variant *) fc;
 }
 
+enum fs_sink_ctf_write_insn_type
+{
+    /*
+     * Reserve `size` bits (the maximum size of the fixed-size
+     * instructions which follow, up to the next `FIELD`
+     * instruction).
+     */
+    FS_SINK_CTF_WRITE_INSN_TYPE_RESERVE,
+
+    /* Write the event class ID (header) */
+    FS_SINK_CTF_WRITE_INSN_TYPE_EVENT_CLASS_ID,
+
+    /* Write the default clock snapshot value (header) */
+    FS_SINK_CTF_WRITE_INSN_TYPE_TIME,
+
+    /*
+     * Align to `alignment` and borrow the root structure field of
+     * the scope `index` (`bt_field_path_scope`) into the register
+     * `dst_reg`.
+     */
+    FS_SINK_CTF_WRITE_INSN_TYPE_SCOPE,
+
+    /*
+     * Align to `alignment` and borrow the member `index` of the
+     * structure field of the register `src_reg` into the register
+     * `dst_reg`.
+     */
+    FS_SINK_CTF_WRITE_INSN_TYPE_STRUCT,
+
+    /*
+     * Write the member `index` of the structure field of the
+     * register `src_reg`, of which the alignment is `alignment` and
+     * the size is `size`.
+     */
+    FS_SINK_CTF_WRITE_INSN_TYPE_BOOL,
+    FS_SINK_CTF_WRITE_INSN_TYPE_BIT_ARRAY,
+    FS_SINK_CTF_WRITE_INSN_TYPE_UINT,
+    FS_SINK_CTF_WRITE_INSN_TYPE_SINT,
+    FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT32,
+    FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT64,
+
+    /*
+     * Write the member `index` of the structure field of the
+     * register `src_reg`, of which the class is `fc`, with the
+     * generic (space-checking) field writer.
+     */
+    FS_SINK_CTF_WRITE_INSN_TYPE_FIELD,
+};
+
+/* Instruction of the write program of an event class */
+struct fs_sink_ctf_write_insn
+{
+    enum fs_sink_ctf_write_insn_type type;
+    unsigned int src_reg;
+    unsigned int dst_reg;
+    unsigned int alignment;
+    uint64_t index;
+    uint64_t size;
+
+    /* Weak */
+    struct fs_sink_ctf_field_class *fc;
+};
+
 struct fs_sink_ctf_stream_class;
 
 struct fs_sink_ctf_event_class
@@ -253,6 +318,25 @@ struct fs_sink_ctf_event_class
 
     /* Owned by this */
     struct fs_sink_ctf_field_class *payload_fc;
+
+    /*
+     * Array of `struct fs_sink_ctf_write_insn`: flat program which
+     * writes a complete event of this class (header, common context,
+     * specific context, and payload).
+     *
+     * Nested structures and fixed-size scalar fields are unrolled,
+     * their alignments known, and one `RESERVE` instruction ensures
+     * the space of each run of them, so that writing them doesn't
+     * check the remaining space.
+     */
+    GArray *write_prog;
+
+    /*
+     * Structure field registers of the write program (scratch
+     * storage while writing an event).
+     */
+    const bt_field **write_prog_regs;
+    unsigned int write_prog_reg_count;
 };
 
 struct fs_sink_ctf_trace;
@@ -306,6 +390,25 @@ struct fs_sink_ctf_trace
     GPtrArray *stream_classes;
 };
 
+/*
+ * Position of an incremental metadata translation of a trace, that is,
+ * what a metadata stream already describes.
+ *
+ * As stream classes and event classes are only appended to their
+ * arrays, the counts of translated ones are enough.
+ */
+struct fs_sink_ctf_metadata_pos
+{
+    /* True if the preamble and trace class are translated */
+    bool has_trace_class = false;
+
+    /*
+     * Number of translated event classes, by stream class index: its
+     * length is the number of translated stream classes.
+     */
+    std::vector<guint> event_class_counts;
+};
+
 static inline void fs_sink_ctf_field_class_destroy(struct fs_sink_ctf_field_class *fc);
 
 static inline void _fs_sink_ctf_field_class_init(struct fs_sink_ctf_field_class *fc,
@@ -878,6 +981,14 @@ static inline void fs_sink_ctf_event_class_destroy(struct fs_sink_ctf_event_clas
     ec->spec_context_fc = NULL;
     fs_sink_ctf_field_class_destroy(ec->payload_fc);
     ec->payload_fc = NULL;
+
+    if (ec->write_prog) {
+        g_array_free(ec->write_prog, TRUE);
+        ec->write_prog = NULL;
+    }
+
+    g_free(ec->write_prog_regs);
+    ec->write_prog_regs = NULL;
     g_free(ec);
 }
 
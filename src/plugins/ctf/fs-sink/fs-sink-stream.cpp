@@ -15,11 +15,51 @@
 #include "compat/endian.h" /* IWYU pragma: keep  */
 #include "ctfser/ctfser.h"
 
+#include "plugins/ctf/fs-src/lttng-index.hpp"
+
 #include "fs-sink-ctf-meta.hpp"
 #include "fs-sink-stream.hpp"
 #include "fs-sink-trace.hpp"
+#include "fs-sink.hpp"
 #include "translate-trace-ir-to-ctf-ir.hpp"
 
+/*
+ * Closes and removes the index file of `stream`, if any: a partial
+ * index file would only make a reader reject it.
+ */
+static void discard_index_file(struct fs_sink_stream *stream)
+{
+    if (stream->index_file) {
+        fclose(stream->index_file);
+        stream->index_file = NULL;
+    }
+
+    if (stream->index_path) {
+        remove(stream->index_path->str);
+        g_string_free(stream->index_path, TRUE);
+        stream->index_path = NULL;
+    }
+}
+
+static void close_index_file(struct fs_sink_stream *stream)
+{
+    if (!stream->index_file) {
+        return;
+    }
+
+    if (fclose(stream->index_file) != 0) {
+        stream->index_file = NULL;
+        BT_CPPLOGW_ERRNO_SPEC(stream->logger, "Cannot close index file", ": path=\"{}\"",
+                              stream->index_path->str);
+        discard_index_file(stream);
+        return;
+    }
+
+    stream->index_file = NULL;
+    g_string_free(stream->index_path, TRUE);
+    stream->index_path = NULL;
+}
+
 void fs_sink_stream_destroy(struct fs_sink_stream *stream)
 {
     if (!stream) {
@@ -27,6 +67,7 @@ void fs_sink_stream_destroy(struct fs_sink_stream *stream)
     }
 
     bt_ctfser_fini(&stream->ctfser);
+    close_index_file(stream);
 
     if (stream->file_name) {
         g_string_free(stream->file_name, TRUE);
@@ -96,7 +137,8 @@ static GString *make_unique_stream_file_name(struct fs_sink_trace *trace, const
 
     BT_ASSERT(name);
 
-    while (stream_file_name_exists(trace, name->str) || strcmp(name->str, "metadata") == 0) {
+    while (stream_file_name_exists(trace, name->str) || strcmp(name->str, "metadata") == 0 ||
+           (trace->fs_sink->write_index && strcmp(name->str, "index") == 0)) {
         g_string_printf(name, "%s-%u", san_base->str, suffix);
         suffix++;
     }
@@ -117,12 +159,170 @@ static void set_stream_file_name(struct fs_sink_stream *stream)
     stream->file_name = make_unique_stream_file_name(stream->trace, base_name);
 }
 
+/*
+ * Opens the LTTng-compatible packet index file of `stream`, that is,
+ * `index/NAME.idx` within the directory of its trace, and writes its
+ * header.
+ *
+ * An index entry needs the beginning and end default clock snapshots
+ * of its packet: this function does nothing if the stream class of
+ * `stream` has no default clock class or if its packets don't have
+ * beginning/end times.
+ *
+ * Failing to create the index file isn't an error: a reader can
+ * always index the stream file itself.
+ */
+static void try_open_index_file(struct fs_sink_stream *stream)
+{
+    GString *dir_path = NULL;
+    struct ctf_packet_index_file_hdr hdr;
+
+    /*
+     * The offsets of an LTTng index file are offsets within the data
+     * stream file as is: don't write any for a compressed file.
+     */
+    if (!stream->trace->fs_sink->write_index || stream->trace->fs_sink->compression_level != 0 ||
+        !stream->sc->default_clock_class || !stream->sc->packets_have_ts_begin ||
+        !stream->sc->packets_have_ts_end) {
+        goto end;
+    }
+
+    dir_path = g_string_new(stream->trace->chunk_path->str);
+    BT_ASSERT(dir_path);
+    g_string_append(dir_path, "/index");
+
+    if (g_mkdir_with_parents(dir_path->str, 0755)) {
+        BT_CPPLOGW_ERRNO_SPEC(stream->logger, "Cannot create index directory",
+                              ": path=\"{}\"", dir_path->str);
+        goto end;
+    }
+
+    stream->index_path = g_string_new(dir_path->str);
+    BT_ASSERT(stream->index_path);
+    g_string_append_printf(stream->index_path, "/%s.idx", stream->file_name->str);
+    stream->index_file = fopen(stream->index_path->str, "wb");
+    if (!stream->index_file) {
+        BT_CPPLOGW_ERRNO_SPEC(stream->logger, "Cannot open index file", ": path=\"{}\"",
+                              stream->index_path->str);
+        g_string_free(stream->index_path, TRUE);
+        stream->index_path = NULL;
+        goto end;
+    }
+
+    hdr.magic = htobe32(CTF_INDEX_MAGIC);
+    hdr.index_major = htobe32(CTF_INDEX_MAJOR);
+    hdr.index_minor = htobe32(CTF_INDEX_MINOR);
+    hdr.packet_index_len = htobe32(sizeof(struct ctf_packet_index));
+
+    if (fwrite(&hdr, sizeof(hdr), 1, stream->index_file) != 1) {
+        BT_CPPLOGW_ERRNO_SPEC(stream->logger, "Cannot write index file header",
+                              ": path=\"{}\"", stream->index_path->str);
+        discard_index_file(stream);
+        goto end;
+    }
+
+    BT_CPPLOGD_SPEC(stream->logger, "Opened index file: path=\"{}\"",
+                    stream->index_path->str);
+
+end:
+    if (dir_path) {
+        g_string_free(dir_path, TRUE);
+    }
+}
+
+/*
+ * Appends the index entry of the current packet of `stream`, which
+ * starts at the offset `offset_bytes` within the stream file, to its
+ * index file, if any.
+ */
+static void write_index_entry(struct fs_sink_stream *stream, const uint64_t offset_bytes)
+{
+    struct ctf_packet_index entry;
+
+    if (!stream->index_file) {
+        return;
+    }
+
+    BT_ASSERT_DBG(stream->packet_state.beginning_cs != UINT64_C(-1));
+    BT_ASSERT_DBG(stream->packet_state.end_cs != UINT64_C(-1));
+    entry.offset = htobe64(offset_bytes);
+    entry.packet_size = htobe64(stream->packet_state.total_size);
+    entry.content_size = htobe64(stream->packet_state.content_size);
+    entry.timestamp_begin = htobe64(stream->packet_state.beginning_cs);
+    entry.timestamp_end = htobe64(stream->packet_state.end_cs);
+    entry.events_discarded = htobe64(stream->packet_state.discarded_events_counter);
+    entry.stream_id = htobe64(bt_stream_class_get_id(stream->sc->ir_sc));
+    entry.stream_instance_id = htobe64(bt_stream_get_id(stream->ir_stream));
+    entry.packet_seq_num = htobe64(stream->packet_state.seq_num);
+
+    if (fwrite(&entry, sizeof(entry), 1, stream->index_file) != 1) {
+        BT_CPPLOGW_ERRNO_SPEC(stream->logger, "Cannot write index file entry",
+                              ": path=\"{}\"", stream->index_path->str);
+        discard_index_file(stream);
+    }
+}
+
+/*
+ * Opens the stream file of `stream` (and its index file) in the
+ * current chunk directory of its trace.
+ */
+static int open_stream_file(struct fs_sink_stream *stream)
+{
+    int ret;
+    GString *path = g_string_new(stream->trace->chunk_path->str);
+
+    BT_ASSERT(path);
+    g_string_append_printf(path, "/%s", stream->file_name->str);
+    stream->chunk_index = stream->trace->chunk_index;
+    ret = bt_ctfser_init_with_writer(&stream->ctfser, path->str, stream->trace->fs_sink->writer,
+                                     static_cast<int>(stream->logger.level()));
+    if (ret) {
+        goto end;
+    }
+
+    try_open_index_file(stream);
+
+end:
+    g_string_free(path, TRUE);
+    return ret;
+}
+
+/*
+ * Moves the stream file of `stream` to the current chunk of its
+ * trace: finalizes the current stream file and opens a new one.
+ *
+ * The current packet of `stream` must be closed.
+ */
+static int move_to_cur_chunk(struct fs_sink_stream *stream)
+{
+    int ret;
+    const uint64_t prev_chunk_index = stream->chunk_index;
+
+    BT_ASSERT(!stream->packet_state.is_open);
+    close_index_file(stream);
+    ret = bt_ctfser_fini(&stream->ctfser);
+    if (ret) {
+        BT_CPPLOGE_SPEC(stream->logger, "Cannot finalize stream file: stream-file-name={}",
+                        stream->file_name->str);
+        goto end;
+    }
+
+    ret = open_stream_file(stream);
+    if (ret) {
+        goto end;
+    }
+
+    ret = fs_sink_trace_leave_chunk(stream->trace, prev_chunk_index);
+
+end:
+    return ret;
+}
+
 struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
                                              const bt_stream *ir_stream)
 {
     fs_sink_stream *stream = new fs_sink_stream {trace->logger};
     int ret;
-    GString *path = g_string_new(trace->path->str);
 
     stream->trace = trace;
     stream->ir_stream = ir_stream;
@@ -138,8 +338,7 @@ struct fs_sink_stream *fs_sink_stream_create(struct fs_sink_trace *trace,
     }
 
     set_stream_file_name(stream);
-    g_string_append_printf(path, "/%s", stream->file_name->str);
-    ret = bt_ctfser_init(&stream->ctfser, path->str, static_cast<int>(stream->logger.level()));
+    ret = open_stream_file(stream);
     if (ret) {
         goto error;
     }
@@ -152,10 +351,6 @@ error:
     stream = NULL;
 
 end:
-    if (path) {
-        g_string_free(path, TRUE);
-    }
-
     return stream;
 }
 
@@ -226,6 +421,115 @@ static inline int write_string_field(struct fs_sink_stream *stream, const bt_fie
     return bt_ctfser_write_string(&stream->ctfser, bt_field_string_get_value(field));
 }
 
+/*
+ * Maximum number of array field elements of which
+ * write_int_array_field_elements() and
+ * write_float_array_field_elements() get the values at once.
+ */
+#define ARRAY_FIELD_ELEMENT_CHUNK_LEN 64
+
+/*
+ * Returns the number of array field elements to handle next when
+ * `index` elements out of `len` are already written.
+ */
+static inline uint64_t array_field_element_chunk_len(uint64_t index, uint64_t len)
+{
+    return len - index < ARRAY_FIELD_ELEMENT_CHUNK_LEN ? len - index :
+                                                         ARRAY_FIELD_ELEMENT_CHUNK_LEN;
+}
+
+/*
+ * Reserves the space to write `count` elements of `size` bits, each one
+ * aligned to `alignment` bits (worst case: padding before each one).
+ */
+static inline int reserve_array_field_element_space(struct fs_sink_stream *stream,
+                                                    uint64_t count, unsigned int size,
+                                                    unsigned int alignment)
+{
+    return bt_ctfser_reserve_space(&stream->ctfser, count * (size + alignment - 1));
+}
+
+static int write_int_array_field_elements(struct fs_sink_stream *stream,
+                                          struct fs_sink_ctf_field_class_int *elem_fc,
+                                          const bt_field *field, uint64_t len)
+{
+    const unsigned int alignment = elem_fc->base.base.alignment;
+    const unsigned int size = elem_fc->base.size;
+    uint64_t index = 0;
+    int ret = 0;
+
+    while (index < len) {
+        const uint64_t count = array_field_element_chunk_len(index, len);
+
+        ret = reserve_array_field_element_space(stream, count, size, alignment);
+        if (G_UNLIKELY(ret)) {
+            goto end;
+        }
+
+        if (elem_fc->is_signed) {
+            int64_t values[ARRAY_FIELD_ELEMENT_CHUNK_LEN];
+
+            bt_field_array_integer_signed_get_values(field, index, values, count);
+
+            for (uint64_t i = 0; i < count; i++) {
+                bt_ctfser_write_signed_int_reserved(&stream->ctfser, values[i], alignment, size,
+                                                    BYTE_ORDER);
+            }
+        } else {
+            uint64_t values[ARRAY_FIELD_ELEMENT_CHUNK_LEN];
+
+            bt_field_array_integer_unsigned_get_values(field, index, values, count);
+
+            for (uint64_t i = 0; i < count; i++) {
+                bt_ctfser_write_unsigned_int_reserved(&stream->ctfser, values[i], alignment, size,
+                                                      BYTE_ORDER);
+            }
+        }
+
+        index += count;
+    }
+
+end:
+    return ret;
+}
+
+static int write_float_array_field_elements(struct fs_sink_stream *stream,
+                                            struct fs_sink_ctf_field_class_float *elem_fc,
+                                            const bt_field *field, uint64_t len)
+{
+    const unsigned int alignment = elem_fc->base.base.alignment;
+    const unsigned int size = elem_fc->base.size;
+    uint64_t index = 0;
+    int ret = 0;
+
+    while (index < len) {
+        const uint64_t count = array_field_element_chunk_len(index, len);
+        double values[ARRAY_FIELD_ELEMENT_CHUNK_LEN];
+
+        ret = reserve_array_field_element_space(stream, count, size, alignment);
+        if (G_UNLIKELY(ret)) {
+            goto end;
+        }
+
+        bt_field_array_real_get_values(field, index, values, count);
+
+        for (uint64_t i = 0; i < count; i++) {
+            if (size == 32) {
+                bt_ctfser_write_float32_reserved(&stream->ctfser, values[i], alignment,
+                                                 BYTE_ORDER);
+            } else {
+                bt_ctfser_write_float64_reserved(&stream->ctfser, values[i], alignment,
+                                                 BYTE_ORDER);
+            }
+        }
+
+        index += count;
+    }
+
+end:
+    return ret;
+}
+
 static inline int write_array_base_field_elements(struct fs_sink_stream *stream,
                                                   struct fs_sink_ctf_field_class_array_base *fc,
                                                   const bt_field *field)
@@ -234,6 +538,17 @@ static inline int write_array_base_field_elements(struct fs_sink_stream *stream,
     uint64_t len = bt_field_array_get_length(field);
     int ret = 0;
 
+    /* Get the values of integer and real elements in bulk */
+    if (fc->elem_fc->type == FS_SINK_CTF_FIELD_CLASS_TYPE_INT) {
+        ret = write_int_array_field_elements(stream, fs_sink_ctf_field_class_as_int(fc->elem_fc),
+                                             field, len);
+        goto end;
+    } else if (fc->elem_fc->type == FS_SINK_CTF_FIELD_CLASS_TYPE_FLOAT) {
+        ret = write_float_array_field_elements(
+            stream, fs_sink_ctf_field_class_as_float(fc->elem_fc), field, len);
+        goto end;
+    }
+
     for (i = 0; i < len; i++) {
         const bt_field *elem_field = bt_field_array_borrow_element_field_by_index_const(field, i);
         ret = write_field(stream, fc->elem_fc, elem_field);
@@ -428,75 +743,113 @@ static int write_field(struct fs_sink_stream *stream, struct fs_sink_ctf_field_c
     return ret;
 }
 
-static inline int write_event_header(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
-                                     struct fs_sink_ctf_event_class *ec)
+static inline const bt_field *borrow_scope_field(const bt_event *event,
+                                                 const bt_field_path_scope scope)
 {
-    int ret;
-
-    /* Event class ID */
-    ret = bt_ctfser_write_byte_aligned_unsigned_int(
-        &stream->ctfser, bt_event_class_get_id(ec->ir_ec), 8, 64, BYTE_ORDER);
-    if (G_UNLIKELY(ret)) {
-        goto end;
-    }
-
-    /* Time */
-    if (stream->sc->default_clock_class) {
-        BT_ASSERT_DBG(cs);
-        ret = bt_ctfser_write_byte_aligned_unsigned_int(
-            &stream->ctfser, bt_clock_snapshot_get_value(cs), 8, 64, BYTE_ORDER);
-        if (G_UNLIKELY(ret)) {
-            goto end;
-        }
+    switch (scope) {
+    case BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT:
+        return bt_event_borrow_common_context_field_const(event);
+    case BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT:
+        return bt_event_borrow_specific_context_field_const(event);
+    case BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD:
+        return bt_event_borrow_payload_field_const(event);
+    default:
+        bt_common_abort();
     }
+}
 
-end:
-    return ret;
+static inline const bt_field *borrow_insn_member_field(const bt_field **regs,
+                                                       const struct fs_sink_ctf_write_insn *insn)
+{
+    return bt_field_structure_borrow_member_field_by_index_const(regs[insn->src_reg], insn->index);
 }
 
 int fs_sink_stream_write_event(struct fs_sink_stream *stream, const bt_clock_snapshot *cs,
                                const bt_event *event, struct fs_sink_ctf_event_class *ec)
 {
-    int ret;
-    const bt_field *field;
-
-    /* Header */
-    ret = write_event_header(stream, cs, ec);
-    if (G_UNLIKELY(ret)) {
-        goto end;
-    }
-
-    /* Common context */
-    if (stream->sc->event_common_context_fc) {
-        field = bt_event_borrow_common_context_field_const(event);
-        BT_ASSERT_DBG(field);
-        ret = write_struct_field(
-            stream, fs_sink_ctf_field_class_as_struct(stream->sc->event_common_context_fc), field,
-            true);
-        if (G_UNLIKELY(ret)) {
-            goto end;
-        }
-    }
-
-    /* Specific context */
-    if (ec->spec_context_fc) {
-        field = bt_event_borrow_specific_context_field_const(event);
-        BT_ASSERT_DBG(field);
-        ret = write_struct_field(stream, fs_sink_ctf_field_class_as_struct(ec->spec_context_fc),
-                                 field, true);
-        if (G_UNLIKELY(ret)) {
-            goto end;
-        }
-    }
-
-    /* Specific context */
-    if (ec->payload_fc) {
-        field = bt_event_borrow_payload_field_const(event);
-        BT_ASSERT_DBG(field);
-        ret = write_struct_field(stream, fs_sink_ctf_field_class_as_struct(ec->payload_fc), field,
-                                 true);
-        if (G_UNLIKELY(ret)) {
-            goto end;
+    int ret = 0;
+    bt_ctfser *ctfser = &stream->ctfser;
+    const bt_field **regs = ec->write_prog_regs;
+
+    BT_ASSERT_DBG(ec->write_prog);
+
+    for (guint i = 0; i < ec->write_prog->len; i++) {
+        const struct fs_sink_ctf_write_insn *insn =
+            &g_array_index(ec->write_prog, struct fs_sink_ctf_write_insn, i);
+
+        switch (insn->type) {
+        case FS_SINK_CTF_WRITE_INSN_TYPE_RESERVE:
+            ret = bt_ctfser_reserve_space(ctfser, insn->size);
+            if (G_UNLIKELY(ret)) {
+                goto end;
+            }
+
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_EVENT_CLASS_ID:
+            bt_ctfser_write_unsigned_int_reserved(ctfser, bt_event_class_get_id(ec->ir_ec), 8, 64,
+                                                  BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_TIME:
+            BT_ASSERT_DBG(cs);
+            bt_ctfser_write_unsigned_int_reserved(ctfser, bt_clock_snapshot_get_value(cs), 8, 64,
+                                                  BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_SCOPE:
+            regs[insn->dst_reg] = borrow_scope_field(event, (bt_field_path_scope) insn->index);
+            BT_ASSERT_DBG(regs[insn->dst_reg]);
+            bt_ctfser_align_offset_in_current_packet_reserved(ctfser, insn->alignment);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_STRUCT:
+            regs[insn->dst_reg] = borrow_insn_member_field(regs, insn);
+            bt_ctfser_align_offset_in_current_packet_reserved(ctfser, insn->alignment);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_BOOL:
+            /*
+             * CTF 1.8 has no boolean field class type: see
+             * write_bool_field().
+             */
+            bt_ctfser_write_unsigned_int_reserved(
+                ctfser, bt_field_bool_get_value(borrow_insn_member_field(regs, insn)) ? 1 : 0,
+                insn->alignment, insn->size, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_BIT_ARRAY:
+            bt_ctfser_write_unsigned_int_reserved(
+                ctfser,
+                bt_field_bit_array_get_value_as_integer(borrow_insn_member_field(regs, insn)),
+                insn->alignment, insn->size, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_UINT:
+            bt_ctfser_write_unsigned_int_reserved(
+                ctfser, bt_field_integer_unsigned_get_value(borrow_insn_member_field(regs, insn)),
+                insn->alignment, insn->size, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_SINT:
+            bt_ctfser_write_signed_int_reserved(
+                ctfser, bt_field_integer_signed_get_value(borrow_insn_member_field(regs, insn)),
+                insn->alignment, insn->size, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT32:
+            bt_ctfser_write_float32_reserved(
+                ctfser,
+                (double) bt_field_real_single_precision_get_value(
+                    borrow_insn_member_field(regs, insn)),
+                insn->alignment, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT64:
+            bt_ctfser_write_float64_reserved(
+                ctfser,
+                bt_field_real_double_precision_get_value(borrow_insn_member_field(regs, insn)),
+                insn->alignment, BYTE_ORDER);
+            break;
+        case FS_SINK_CTF_WRITE_INSN_TYPE_FIELD:
+            ret = write_field(stream, insn->fc, borrow_insn_member_field(regs, insn));
+            if (G_UNLIKELY(ret)) {
+                goto end;
+            }
+
+            break;
+        default:
+            bt_common_abort();
         }
     }
 
@@ -582,6 +935,20 @@ int fs_sink_stream_open_packet(struct fs_sink_stream *stream, const bt_clock_sna
     uint64_t i;
 
     BT_ASSERT(!stream->packet_state.is_open);
+
+    /* Packet boundary: possibly begin a new trace chunk */
+    ret = fs_sink_trace_rotate_if_needed(stream->trace, cs);
+    if (ret) {
+        goto end;
+    }
+
+    if (G_UNLIKELY(stream->chunk_index != stream->trace->chunk_index)) {
+        ret = move_to_cur_chunk(stream);
+        if (ret) {
+            goto end;
+        }
+    }
+
     bt_packet_put_ref(stream->packet_state.packet);
     stream->packet_state.packet = packet;
     bt_packet_get_ref(stream->packet_state.packet);
@@ -676,6 +1043,16 @@ int fs_sink_stream_close_packet(struct fs_sink_stream *stream, const bt_clock_sn
         goto end;
     }
 
+    /* Make the metadata file describe this packet before it's complete */
+    ret = fs_sink_trace_flush_metadata(stream->trace);
+    if (ret) {
+        goto end;
+    }
+
+    /* Current stream file size is the offset of this packet */
+    write_index_entry(stream, stream->ctfser.stream_size_bytes);
+    stream->trace->chunk_size_bytes += stream->packet_state.total_size / 8;
+
     /* Close packet */
     bt_ctfser_close_current_packet(&stream->ctfser, stream->packet_state.total_size / 8);
 
@@ -692,6 +1069,7 @@ int fs_sink_stream_close_packet(struct fs_sink_stream *stream, const bt_clock_sn
     stream->packet_state.total_size = 0;
     stream->packet_state.seq_num += 1;
     stream->packet_state.context_offset_bits = 0;
+    stream->packet_state.has_first_event_ns = false;
     stream->packet_state.is_open = false;
     BT_PACKET_PUT_REF_AND_RESET(stream->packet_state.packet);
 
@@ -9,6 +9,7 @@
 
 #include <glib.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -32,6 +33,17 @@ struct fs_sink_stream
     /* Stream's file name */
     GString *file_name = nullptr;
 
+    /* Index of the trace chunk containing the stream file */
+    uint64_t chunk_index = 0;
+
+    /*
+     * Path of the packet index file of this stream, and the index
+     * file itself (owned by this), or both `nullptr` if this stream
+     * has no index file.
+     */
+    GString *index_path = nullptr;
+    FILE *index_file = nullptr;
+
     /* Weak */
     const bt_stream *ir_stream = nullptr;
 
@@ -80,6 +92,14 @@ struct fs_sink_stream
         /* Sequence number (free running) of the current packet */
         uint64_t seq_num = 0;
 
+        /*
+         * Time (ns from origin) of the first event of the
+         * current artificial packet, if `has_first_event_ns` is
+         * true.
+         */
+        int64_t first_event_ns = 0;
+        bool has_first_event_ns = false;
+
         /*
          * Offset of the packet context structure within the
          * current packet (bits).
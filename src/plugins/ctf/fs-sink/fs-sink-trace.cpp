@@ -5,6 +5,8 @@
  */
 
 #include <glib.h>
+#include <glib/gstdio.h>
+#include <inttypes.h>
 #include <stdio.h>
 
 #include <babeltrace2/babeltrace.h>
@@ -457,12 +459,433 @@ end:
     return unique_full_path;
 }
 
-void fs_sink_trace_destroy(struct fs_sink_trace *trace)
+static bool rotates(const struct fs_sink_trace *trace)
 {
-    GString *metadata = NULL;
+    return trace->fs_sink->rotation_size > 0 || trace->fs_sink->rotation_duration_ns > 0;
+}
+
+/*
+ * Writes the metadata file of `trace` in the directory `dir_path` and
+ * prints that the CTF trace `dir_path` exists.
+ */
+static int write_metadata_file(struct fs_sink_trace *trace, const char *dir_path)
+{
+    int ret = 0;
+    GString *metadata = g_string_new(NULL);
+    GString *metadata_path = g_string_new(dir_path);
     FILE *fh = NULL;
     size_t len;
 
+    BT_ASSERT(metadata);
+    BT_ASSERT(metadata_path);
+    g_string_append(metadata_path, "/metadata");
+
+    if (trace->fs_sink->ctf_version == 1) {
+        translate_trace_ctf_ir_to_tsdl(trace->trace, metadata);
+    } else {
+        BT_ASSERT(trace->fs_sink->ctf_version == 2);
+        translate_trace_ctf_ir_to_json(trace->trace, metadata);
+    }
+
+    fh = fopen(metadata_path->str, "wb");
+    if (!fh) {
+        BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot open metadata file for writing",
+                              ": path=\"{}\"", metadata_path->str);
+        ret = -1;
+        goto end;
+    }
+
+    len = fwrite(metadata->str, sizeof(*metadata->str), metadata->len, fh);
+    if (len != metadata->len) {
+        BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot write metadata file", ": path=\"{}\"",
+                              metadata_path->str);
+        ret = -1;
+        goto end;
+    }
+
+    if (!trace->fs_sink->quiet) {
+        printf("Created CTF trace `%s`.\n", dir_path);
+    }
+
+end:
+    if (fh) {
+        if (fclose(fh) != 0) {
+            BT_CPPLOGW_ERRNO_SPEC(trace->logger, "Cannot close metadata file", ": path=\"{}\"",
+                                  metadata_path->str);
+        }
+    }
+
+    g_string_free(metadata_path, TRUE);
+    g_string_free(metadata, TRUE);
+    return ret;
+}
+
+/*
+ * Creates the metadata file of `trace` in its current chunk directory,
+ * initially describing the classes which `trace` contains so far.
+ */
+static int open_metadata_file(struct fs_sink_trace *trace)
+{
+    int ret = 0;
+    GString *metadata_path = g_string_new(trace->chunk_path->str);
+
+    BT_ASSERT(metadata_path);
+    BT_ASSERT(!trace->metadata_fh);
+    g_string_append(metadata_path, "/metadata");
+    trace->metadata_fh = fopen(metadata_path->str, "wb");
+    if (!trace->metadata_fh) {
+        BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot open metadata file for writing",
+                              ": path=\"{}\"", metadata_path->str);
+        ret = -1;
+        goto end;
+    }
+
+    trace->metadata_pos = fs_sink_ctf_metadata_pos {};
+    ret = fs_sink_trace_flush_metadata(trace);
+
+end:
+    g_string_free(metadata_path, TRUE);
+    return ret;
+}
+
+int fs_sink_trace_flush_metadata(struct fs_sink_trace *trace)
+{
+    int ret = 0;
+    GString *metadata;
+
+    if (!trace->metadata_fh) {
+        goto end;
+    }
+
+    metadata = g_string_new(NULL);
+    BT_ASSERT(metadata);
+
+    if (trace->fs_sink->ctf_version == 1) {
+        translate_new_trace_ctf_ir_to_tsdl(trace->trace, &trace->metadata_pos, metadata);
+    } else {
+        BT_ASSERT(trace->fs_sink->ctf_version == 2);
+        translate_new_trace_ctf_ir_to_json(trace->trace, &trace->metadata_pos, metadata);
+    }
+
+    if (metadata->len > 0) {
+        BT_CPPLOGD_SPEC(trace->logger, "Appending to metadata file: dir-path=\"{}\", size={}",
+                        trace->chunk_path->str, metadata->len);
+
+        if (fwrite(metadata->str, sizeof(*metadata->str), metadata->len, trace->metadata_fh) !=
+                metadata->len ||
+            fflush(trace->metadata_fh) != 0) {
+            BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot write metadata file",
+                                  ": dir-path=\"{}\"", trace->chunk_path->str);
+            ret = -1;
+        }
+    }
+
+    g_string_free(metadata, TRUE);
+
+end:
+    return ret;
+}
+
+/*
+ * Appends the last classes to the metadata file of `trace`, closes it,
+ * and prints that the CTF trace `trace->chunk_path` exists.
+ */
+static int close_metadata_file(struct fs_sink_trace *trace)
+{
+    int ret;
+
+    BT_ASSERT(trace->metadata_fh);
+    ret = fs_sink_trace_flush_metadata(trace);
+
+    if (fclose(trace->metadata_fh) != 0) {
+        BT_CPPLOGW_ERRNO_SPEC(trace->logger, "Cannot close metadata file", ": dir-path=\"{}\"",
+                              trace->chunk_path->str);
+    }
+
+    trace->metadata_fh = NULL;
+
+    if (ret == 0 && !trace->fs_sink->quiet) {
+        printf("Created CTF trace `%s`.\n", trace->chunk_path->str);
+    }
+
+    return ret;
+}
+
+static GString *make_chunk_path(const struct fs_sink_trace *trace, const uint64_t chunk_index)
+{
+    GString *chunk_path = g_string_new(trace->path->str);
+
+    BT_ASSERT(chunk_path);
+    g_string_append_printf(chunk_path, "/chunk-%" PRIu64, chunk_index);
+    return chunk_path;
+}
+
+/*
+ * Removes the directory `path` and its contents.
+ */
+static int remove_dir(const struct fs_sink_trace *trace, const char *path)
+{
+    int ret = 0;
+    GError *error = NULL;
+    GDir *dir = g_dir_open(path, 0, &error);
+    const char *name;
+
+    if (!dir) {
+        BT_CPPLOGE_SPEC(trace->logger, "Cannot open directory: path=\"{}\", error=\"{}\"", path,
+                        error->message);
+        g_error_free(error);
+        ret = -1;
+        goto end;
+    }
+
+    while ((name = g_dir_read_name(dir))) {
+        gchar *entry_path = g_build_filename(path, name, NULL);
+
+        if (g_file_test(entry_path, G_FILE_TEST_IS_DIR)) {
+            ret = remove_dir(trace, entry_path);
+        } else if (g_remove(entry_path) != 0) {
+            BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot remove file", ": path=\"{}\"",
+                                  entry_path);
+            ret = -1;
+        }
+
+        g_free(entry_path);
+
+        if (ret) {
+            goto end;
+        }
+    }
+
+    if (g_rmdir(path) != 0) {
+        BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot remove directory", ": path=\"{}\"", path);
+        ret = -1;
+        goto end;
+    }
+
+end:
+    if (dir) {
+        g_dir_close(dir);
+    }
+
+    return ret;
+}
+
+/*
+ * Removes the oldest complete chunks of `trace` while it has more than
+ * the maximum chunk count.
+ *
+ * An incomplete chunk (with a stream file which is still open) stops
+ * the removal: it becomes removable once complete.
+ */
+static int remove_old_chunks(struct fs_sink_trace *trace)
+{
+    int ret = 0;
+    const uint64_t max_count = trace->fs_sink->rotation_chunk_count;
+
+    if (max_count == 0) {
+        goto end;
+    }
+
+    while (trace->chunks->len > max_count) {
+        const fs_sink_trace_chunk& chunk = g_array_index(trace->chunks, fs_sink_trace_chunk, 0);
+        GString *chunk_path;
+
+        if (!chunk.is_complete) {
+            break;
+        }
+
+        chunk_path = make_chunk_path(trace, chunk.index);
+        BT_CPPLOGI_SPEC(trace->logger, "Removing oldest chunk: path=\"{}\"", chunk_path->str);
+        ret = remove_dir(trace, chunk_path->str);
+        g_string_free(chunk_path, TRUE);
+        if (ret) {
+            goto end;
+        }
+
+        g_array_remove_index(trace->chunks, 0);
+    }
+
+end:
+    return ret;
+}
+
+static fs_sink_trace_chunk *borrow_chunk(struct fs_sink_trace *trace, const uint64_t chunk_index)
+{
+    for (guint i = 0; i < trace->chunks->len; i++) {
+        fs_sink_trace_chunk *chunk = &g_array_index(trace->chunks, fs_sink_trace_chunk, i);
+
+        if (chunk->index == chunk_index) {
+            return chunk;
+        }
+    }
+
+    return NULL;
+}
+
+static int complete_chunk(struct fs_sink_trace *trace, fs_sink_trace_chunk *chunk)
+{
+    int ret;
+
+    BT_ASSERT(!chunk->is_complete);
+
+    if (chunk->index == trace->chunk_index && trace->metadata_fh) {
+        /* Current chunk: its metadata file is up to date */
+        ret = close_metadata_file(trace);
+    } else {
+        /*
+         * Previous chunk: rewrite its metadata file, as its last stream
+         * files could contain classes which appeared after the trace
+         * began the current chunk.
+         */
+        GString *chunk_path = make_chunk_path(trace, chunk->index);
+
+        ret = write_metadata_file(trace, chunk_path->str);
+        g_string_free(chunk_path, TRUE);
+    }
+
+    if (ret) {
+        goto end;
+    }
+
+    chunk->is_complete = true;
+
+end:
+    return ret;
+}
+
+/*
+ * Creates the directory of a new current chunk for `trace`.
+ */
+static int begin_chunk(struct fs_sink_trace *trace, const uint64_t chunk_index)
+{
+    int ret;
+    fs_sink_trace_chunk chunk = {chunk_index, false};
+
+    if (trace->metadata_fh) {
+        /* Previous chunk: complete_chunk() rewrites its metadata file */
+        if (fclose(trace->metadata_fh) != 0) {
+            BT_CPPLOGW_ERRNO_SPEC(trace->logger, "Cannot close metadata file",
+                                  ": dir-path=\"{}\"", trace->chunk_path->str);
+        }
+
+        trace->metadata_fh = NULL;
+    }
+
+    if (trace->chunk_path) {
+        g_string_free(trace->chunk_path, TRUE);
+    }
+
+    trace->chunk_path = make_chunk_path(trace, chunk_index);
+    ret = g_mkdir_with_parents(trace->chunk_path->str, 0755);
+    if (ret) {
+        BT_CPPLOGE_ERRNO_SPEC(trace->logger, "Cannot create chunk directory", ": path=\"{}\"",
+                              trace->chunk_path->str);
+        goto end;
+    }
+
+    trace->chunk_index = chunk_index;
+    trace->chunk_size_bytes = 0;
+    trace->has_chunk_begin_ns = false;
+    g_array_append_val(trace->chunks, chunk);
+    ret = open_metadata_file(trace);
+    if (ret) {
+        goto end;
+    }
+
+    BT_CPPLOGI_SPEC(trace->logger, "Began trace chunk: path=\"{}\"", trace->chunk_path->str);
+
+end:
+    return ret;
+}
+
+int fs_sink_trace_rotate_if_needed(struct fs_sink_trace *trace, const bt_clock_snapshot *cs)
+{
+    int ret = 0;
+    const fs_sink_comp *fs_sink = trace->fs_sink;
+    int64_t ns;
+    bool has_ns = false;
+    bool rotate = false;
+
+    if (!rotates(trace)) {
+        goto end;
+    }
+
+    if (cs && fs_sink->rotation_duration_ns > 0) {
+        has_ns = bt_clock_snapshot_get_ns_from_origin(cs, &ns) ==
+                 BT_CLOCK_SNAPSHOT_GET_NS_FROM_ORIGIN_STATUS_OK;
+    }
+
+    if (fs_sink->rotation_size > 0 && trace->chunk_size_bytes >= fs_sink->rotation_size) {
+        rotate = true;
+    } else if (has_ns && trace->has_chunk_begin_ns && ns >= trace->chunk_begin_ns &&
+               static_cast<uint64_t>(ns - trace->chunk_begin_ns) >=
+                   fs_sink->rotation_duration_ns) {
+        rotate = true;
+    }
+
+    if (rotate) {
+        uint64_t prev_chunk_index = trace->chunk_index;
+
+        ret = begin_chunk(trace, prev_chunk_index + 1);
+        if (ret) {
+            goto end;
+        }
+
+        /* Previous chunk could be empty (no stream file) */
+        ret = fs_sink_trace_leave_chunk(trace, prev_chunk_index);
+        if (ret) {
+            goto end;
+        }
+    }
+
+    if (has_ns && !trace->has_chunk_begin_ns) {
+        trace->chunk_begin_ns = ns;
+        trace->has_chunk_begin_ns = true;
+    }
+
+end:
+    return ret;
+}
+
+int fs_sink_trace_leave_chunk(struct fs_sink_trace *trace, const uint64_t chunk_index)
+{
+    int ret = 0;
+    fs_sink_trace_chunk *chunk;
+    GHashTableIter iter;
+    gpointer value;
+
+    if (!rotates(trace) || chunk_index == trace->chunk_index) {
+        /* No chunks or still the current chunk */
+        goto end;
+    }
+
+    g_hash_table_iter_init(&iter, trace->streams);
+
+    while (g_hash_table_iter_next(&iter, NULL, &value)) {
+        if (((fs_sink_stream *) value)->chunk_index == chunk_index) {
+            /* Another stream file is still in this chunk */
+            goto end;
+        }
+    }
+
+    chunk = borrow_chunk(trace, chunk_index);
+    if (!chunk || chunk->is_complete) {
+        goto end;
+    }
+
+    ret = complete_chunk(trace, chunk);
+    if (ret) {
+        goto end;
+    }
+
+    ret = remove_old_chunks(trace);
+
+end:
+    return ret;
+}
+
+void fs_sink_trace_destroy(struct fs_sink_trace *trace)
+{
     if (!trace) {
         goto end;
     }
@@ -483,37 +906,36 @@ void fs_sink_trace_destroy(struct fs_sink_trace *trace)
         trace->streams = NULL;
     }
 
-    metadata = g_string_new(NULL);
-    BT_ASSERT(metadata);
+    if (trace->chunks) {
+        /* All the stream files are closed now: complete all the chunks */
+        for (guint i = 0; i < trace->chunks->len; i++) {
+            fs_sink_trace_chunk *chunk = &g_array_index(trace->chunks, fs_sink_trace_chunk, i);
 
-    if (trace->fs_sink->ctf_version == 1) {
-        translate_trace_ctf_ir_to_tsdl(trace->trace, metadata);
-    } else {
-        BT_ASSERT(trace->fs_sink->ctf_version == 2);
-        translate_trace_ctf_ir_to_json(trace->trace, metadata);
-    }
+            if (!chunk->is_complete && complete_chunk(trace, chunk)) {
+                BT_CPPLOGF_SPEC(trace->logger, "In trace destruction listener: "
+                                               "cannot complete trace chunk");
+                bt_common_abort();
+            }
+        }
 
-    BT_ASSERT(trace->metadata_path);
-    fh = fopen(trace->metadata_path->str, "wb");
-    if (!fh) {
-        BT_CPPLOGF_ERRNO_SPEC(trace->logger,
-                              "In trace destruction listener: "
-                              "cannot open metadata file for writing",
-                              ": path=\"{}\"", trace->metadata_path->str);
-        bt_common_abort();
-    }
+        if (remove_old_chunks(trace)) {
+            BT_CPPLOGW_SPEC(trace->logger, "In trace destruction listener: "
+                                           "cannot remove old trace chunks");
+        }
 
-    len = fwrite(metadata->str, sizeof(*metadata->str), metadata->len, fh);
-    if (len != metadata->len) {
-        BT_CPPLOGF_ERRNO_SPEC(trace->logger,
-                              "In trace destruction listener: "
-                              "cannot write metadata file",
-                              ": path=\"{}\"", trace->metadata_path->str);
-        bt_common_abort();
+        g_array_free(trace->chunks, TRUE);
+        trace->chunks = NULL;
+    } else if (trace->metadata_fh) {
+        if (close_metadata_file(trace)) {
+            BT_CPPLOGF_SPEC(trace->logger, "In trace destruction listener: "
+                                           "cannot write metadata file");
+            bt_common_abort();
+        }
     }
 
-    if (!trace->fs_sink->quiet) {
-        printf("Created CTF trace `%s`.\n", trace->path->str);
+    if (trace->chunk_path) {
+        g_string_free(trace->chunk_path, TRUE);
+        trace->chunk_path = NULL;
     }
 
     if (trace->path) {
@@ -521,26 +943,10 @@ void fs_sink_trace_destroy(struct fs_sink_trace *trace)
         trace->path = NULL;
     }
 
-    if (fh) {
-        int ret = fclose(fh);
-
-        if (ret != 0) {
-            BT_CPPLOGW_ERRNO_SPEC(trace->logger,
-                                  "In trace destruction listener: "
-                                  "cannot close metadata file",
-                                  ": path=\"{}\"", trace->metadata_path->str);
-        }
-    }
-
-    g_string_free(trace->metadata_path, TRUE);
-    trace->metadata_path = NULL;
-
     fs_sink_ctf_trace_destroy(trace->trace);
     trace->trace = NULL;
     delete trace;
 
-    g_string_free(metadata, TRUE);
-
 end:
     return;
 }
@@ -581,12 +987,26 @@ struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink, const b
         goto error;
     }
 
-    trace->metadata_path = g_string_new(trace->path->str);
-    BT_ASSERT(trace->metadata_path);
-    g_string_append(trace->metadata_path, "/metadata");
     trace->streams = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL,
                                            (GDestroyNotify) fs_sink_stream_destroy);
     BT_ASSERT(trace->streams);
+
+    if (rotates(trace)) {
+        trace->chunks = g_array_new(FALSE, FALSE, sizeof(fs_sink_trace_chunk));
+        BT_ASSERT(trace->chunks);
+        ret = begin_chunk(trace, 0);
+        if (ret) {
+            goto error;
+        }
+    } else {
+        trace->chunk_path = g_string_new(trace->path->str);
+        BT_ASSERT(trace->chunk_path);
+        ret = open_metadata_file(trace);
+        if (ret) {
+            goto error;
+        }
+    }
+
     trace_status = bt_trace_add_destruction_listener(ir_trace, ir_trace_destruction_listener, trace,
                                                      &trace->ir_trace_destruction_listener_id);
     if (trace_status) {
@@ -8,13 +8,27 @@
 #define BABELTRACE_PLUGINS_CTF_FS_SINK_FS_SINK_TRACE_HPP
 
 #include <glib.h>
+#include <stdint.h>
 
 #include <babeltrace2/babeltrace.h>
 
 #include "cpp-common/bt2c/logging.hpp"
 
+#include "fs-sink-ctf-meta.hpp"
+
 struct fs_sink_comp;
-struct fs_sink_ctf_trace;
+
+/* Chunk directory of a rotating trace */
+struct fs_sink_trace_chunk
+{
+    uint64_t index;
+
+    /*
+     * True if no stream file of this chunk is open anymore and its
+     * metadata file exists.
+     */
+    bool is_complete;
+};
 
 struct fs_sink_trace
 {
@@ -48,8 +62,41 @@ struct fs_sink_trace
     /* Trace's directory */
     GString *path = nullptr;
 
-    /* `metadata` file path */
-    GString *metadata_path = nullptr;
+    /*
+     * Directory of the current chunk (see fs_sink_trace_rotate()),
+     * in which to create the stream files: `path` itself when the
+     * component doesn't rotate its output.
+     */
+    GString *chunk_path = nullptr;
+
+    /*
+     * Metadata file in `chunk_path`, which new classes get appended to
+     * (see fs_sink_trace_flush_metadata()), or `nullptr`.
+     */
+    FILE *metadata_fh = nullptr;
+
+    /* What `metadata_fh` describes */
+    fs_sink_ctf_metadata_pos metadata_pos;
+
+    /* Index of the current chunk */
+    uint64_t chunk_index = 0;
+
+    /* Size of the packets closed since the current chunk began (bytes) */
+    uint64_t chunk_size_bytes = 0;
+
+    /*
+     * Time (ns from origin) of the first packet of the current
+     * chunk, if `has_chunk_begin_ns` is true.
+     */
+    int64_t chunk_begin_ns = 0;
+    bool has_chunk_begin_ns = false;
+
+    /*
+     * Array of `struct fs_sink_trace_chunk`: existing chunk
+     * directories, oldest first, or `nullptr` when the component
+     * doesn't rotate its output.
+     */
+    GArray *chunks = nullptr;
 
     /*
      * Hash table of `const bt_stream *` (weak) to
@@ -62,4 +109,31 @@ struct fs_sink_trace *fs_sink_trace_create(struct fs_sink_comp *fs_sink, const b
 
 void fs_sink_trace_destroy(struct fs_sink_trace *trace);
 
+/*
+ * Makes `trace` begin a new chunk if the component rotates its output
+ * and the current chunk reached its size or duration limit, `cs`
+ * being the time of the packet to open, if any.
+ *
+ * A stream file moves to the new chunk when its stream opens its next
+ * packet (see fs_sink_stream_open_packet()).
+ */
+int fs_sink_trace_rotate_if_needed(struct fs_sink_trace *trace, const bt_clock_snapshot *cs);
+
+/*
+ * Appends the classes of `trace` which its metadata file doesn't
+ * describe yet to it, in a single write, and flushes it.
+ *
+ * Call this before closing a packet so that the metadata file always
+ * describes the complete packets of the stream files, making the trace
+ * readable while it's still being written.
+ */
+int fs_sink_trace_flush_metadata(struct fs_sink_trace *trace);
+
+/*
+ * Marks the chunk `chunk_index` of `trace` as complete (writing its
+ * metadata file and removing the oldest complete chunks beyond the
+ * maximum chunk count) if no stream file of `trace` is in it anymore.
+ */
+int fs_sink_trace_leave_chunk(struct fs_sink_trace *trace, uint64_t chunk_index);
+
 #endif /* BABELTRACE_PLUGINS_CTF_FS_SINK_FS_SINK_TRACE_HPP */
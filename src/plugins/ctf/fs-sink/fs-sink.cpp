@@ -25,6 +25,18 @@
 
 static const char * const in_port_name = "in";
 
+/*
+ * Maximum total size of the packets which the background writer of a
+ * component didn't write yet.
+ */
+static constexpr uint64_t writer_max_pending_bytes = 64 * 1024 * 1024;
+
+/* Maximum number of threads of the background writer of a component */
+static constexpr int64_t max_writer_thread_count = 256;
+
+/* Maximum zstd compression level of the stream files */
+static constexpr int64_t max_compression_level = 19;
+
 static bt_component_class_initialize_method_status
 ensure_output_dir_exists(struct fs_sink_comp *fs_sink)
 {
@@ -58,6 +70,24 @@ static bt_param_validation_map_value_entry_descr fs_sink_params_descr[] = {
      bt_param_validation_value_descr::makeBool()},
     {"quiet", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeBool()},
+    {"write-index", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"write-in-background", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"background-thread-count", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"compression-level", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"artificial-packet-size", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"artificial-packet-max-duration", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"rotation-size", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"rotation-duration", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"rotation-chunk-count", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
     {ctfVersionParamName, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeString()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
@@ -92,6 +122,7 @@ configure_component(bt_self_component_sink *self_comp_sink, struct fs_sink_comp
     const bt_value *value;
     enum bt_param_validation_status validation_status;
     gchar *validation_error;
+    unsigned int writer_thread_count = 1;
 
     validation_status =
         bt_param_validation_validate(params, fs_sink_params_descr, &validation_error);
@@ -127,6 +158,153 @@ configure_component(bt_self_component_sink *self_comp_sink, struct fs_sink_comp
         fs_sink->quiet = (bool) bt_value_bool_get(value);
     }
 
+    value = bt_value_map_borrow_entry_value_const(params, "write-index");
+    if (value) {
+        fs_sink->write_index = (bool) bt_value_bool_get(value);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "artificial-packet-size");
+    if (value) {
+        const int64_t size = bt_value_integer_signed_get(value);
+
+        if (size <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(
+                fs_sink->logger,
+                "Invalid `artificial-packet-size` parameter: expecting a positive size: size={}",
+                size);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->artificial_packet_size = static_cast<uint64_t>(size);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "artificial-packet-max-duration");
+    if (value) {
+        const int64_t duration = bt_value_integer_signed_get(value);
+
+        if (duration <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Invalid `artificial-packet-max-duration` parameter: "
+                                         "expecting a positive duration: duration={}",
+                                         duration);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->artificial_packet_max_duration_ns = static_cast<uint64_t>(duration);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "rotation-size");
+    if (value) {
+        const int64_t size = bt_value_integer_signed_get(value);
+
+        if (size <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(
+                fs_sink->logger,
+                "Invalid `rotation-size` parameter: expecting a positive size: size={}", size);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->rotation_size = static_cast<uint64_t>(size);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "rotation-duration");
+    if (value) {
+        const int64_t duration = bt_value_integer_signed_get(value);
+
+        if (duration <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Invalid `rotation-duration` parameter: "
+                                         "expecting a positive duration: duration={}",
+                                         duration);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->rotation_duration_ns = static_cast<uint64_t>(duration);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "rotation-chunk-count");
+    if (value) {
+        const int64_t count = bt_value_integer_signed_get(value);
+
+        if (count <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Invalid `rotation-chunk-count` parameter: "
+                                         "expecting a positive count: count={}",
+                                         count);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        if (fs_sink->rotation_size == 0 && fs_sink->rotation_duration_ns == 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "`rotation-chunk-count` parameter needs the "
+                                         "`rotation-size` or `rotation-duration` parameter.");
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->rotation_chunk_count = static_cast<uint64_t>(count);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "background-thread-count");
+    if (value) {
+        const int64_t count = bt_value_integer_signed_get(value);
+
+        if (count <= 0 || count > max_writer_thread_count) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Invalid `background-thread-count` parameter: "
+                                         "expecting a count between 1 and {}: count={}",
+                                         max_writer_thread_count, count);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        writer_thread_count = static_cast<unsigned int>(count);
+    }
+
+    value = bt_value_map_borrow_entry_value_const(params, "compression-level");
+    if (value) {
+        const int64_t level = bt_value_integer_signed_get(value);
+
+#ifdef BT_HAVE_ZSTD
+        if (level <= 0 || level > max_compression_level) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Invalid `compression-level` parameter: "
+                                         "expecting a level between 1 and {}: level={}",
+                                         max_compression_level, level);
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+
+        fs_sink->compression_level = static_cast<int>(level);
+#else
+        BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                     "`compression-level` parameter is not supported: "
+                                     "Babeltrace was built without zstd support: level={}",
+                                     level);
+        status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+        goto end;
+#endif
+    }
+
+    /* Compression happens when handing packets over to the writer */
+    value = bt_value_map_borrow_entry_value_const(params, "write-in-background");
+    if ((value && bt_value_bool_get(value)) || fs_sink->compression_level != 0) {
+        fs_sink->writer = bt_ctfser_writer_create(
+            writer_max_pending_bytes, writer_thread_count, fs_sink->compression_level,
+            static_cast<int>(fs_sink->logger.level()));
+        if (!fs_sink->writer) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger,
+                                         "Failed to create background packet writer.");
+            status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+            goto end;
+        }
+    }
+
     value = bt_value_map_borrow_entry_value_const(params, "ctf-version");
     if (value) {
         const auto ctfVersion = ctfVersionFromParams(params, fs_sink->logger);
@@ -175,6 +353,10 @@ static void destroy_fs_sink_comp(struct fs_sink_comp *fs_sink)
         fs_sink->traces = NULL;
     }
 
+    /* After the traces: their stream files use the writer */
+    bt_ctfser_writer_destroy(fs_sink->writer);
+    fs_sink->writer = NULL;
+
     BT_MESSAGE_ITERATOR_PUT_REF_AND_RESET(fs_sink->upstream_iter);
     delete fs_sink;
 
@@ -320,17 +502,34 @@ handle_event_msg(struct fs_sink_comp *fs_sink, const bt_message *msg)
      * If this event's stream does not support packets, then we
      * lazily create artificial packets.
      *
-     * The size of an artificial packet is arbitrarily at least
-     * 4 MiB (it usually is greater because we close it when
-     * comes the time to write a new event and the packet's content
-     * size is >= 4 MiB), except the last one which can be smaller.
+     * The size of an artificial packet is at least
+     * `fs_sink->artificial_packet_size` (4 MiB by default; it usually
+     * is greater because we close it when comes the time to write a
+     * new event and the packet's content size is greater than or
+     * equal to this size), except the last one which can be smaller.
+     *
+     * With `fs_sink->artificial_packet_max_duration_ns`, we also
+     * close it when the time of the new event is too far from the
+     * time of its first event.
      */
         if (G_UNLIKELY(!stream->sc->has_packets)) {
+            int64_t event_ns = 0;
+            bool has_event_ns = false;
+
+            if (cs && fs_sink->artificial_packet_max_duration_ns > 0) {
+                has_event_ns = bt_clock_snapshot_get_ns_from_origin(cs, &event_ns) ==
+                               BT_CLOCK_SNAPSHOT_GET_NS_FROM_ORIGIN_STATUS_OK;
+            }
+
             if (stream->packet_state.is_open &&
-                bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser) / 8 >=
-                    4 * 1024 * 1024) {
+                (bt_ctfser_get_offset_in_current_packet_bits(&stream->ctfser) / 8 >=
+                     fs_sink->artificial_packet_size ||
+                 (has_event_ns && stream->packet_state.has_first_event_ns &&
+                  event_ns >= stream->packet_state.first_event_ns &&
+                  static_cast<uint64_t>(event_ns - stream->packet_state.first_event_ns) >=
+                      fs_sink->artificial_packet_max_duration_ns))) {
                 /*
-             * Stream's current packet is larger than 4 MiB:
+             * Stream's current packet is large or long enough:
              * close it. A new packet will be opened just
              * below.
              */
@@ -343,6 +542,18 @@ handle_event_msg(struct fs_sink_comp *fs_sink, const bt_message *msg)
             }
 
             if (!stream->packet_state.is_open) {
+                /*
+                 * An artificial packet has no beginning time:
+                 * rotate the output based on the time of its
+                 * first event.
+                 */
+                ret = fs_sink_trace_rotate_if_needed(stream->trace, cs);
+                if (ret) {
+                    BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger, "Failed to rotate output.");
+                    status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+                    goto end;
+                }
+
                 /* Stream's packet is not currently opened: open it */
                 ret = fs_sink_stream_open_packet(stream, NULL, NULL);
                 if (ret) {
@@ -350,6 +561,9 @@ handle_event_msg(struct fs_sink_comp *fs_sink, const bt_message *msg)
                     status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
                     goto end;
                 }
+
+                stream->packet_state.first_event_ns = event_ns;
+                stream->packet_state.has_first_event_ns = has_event_ns;
             }
         }
 
@@ -766,13 +980,25 @@ handle_stream_end_msg(struct fs_sink_comp *fs_sink, const bt_message *msg)
                     "trace-name=\"{}\", path=\"{}/{}\"",
                     bt_stream_get_id(ir_stream), bt2c::maybeNull(bt_stream_get_name(ir_stream)),
                     bt2c::maybeNull(bt_trace_get_name(bt_stream_borrow_trace_const(ir_stream))),
-                    stream->trace->path->str, stream->file_name->str);
+                    stream->trace->chunk_path->str, stream->file_name->str);
 
-    /*
-     * This destroys the stream object and frees all its resources,
-     * closing the stream file.
-     */
-    g_hash_table_remove(stream->trace->streams, ir_stream);
+    {
+        fs_sink_trace *trace = stream->trace;
+        const uint64_t chunk_index = stream->chunk_index;
+
+        /*
+         * This destroys the stream object and frees all its
+         * resources, closing the stream file.
+         */
+        g_hash_table_remove(trace->streams, ir_stream);
+
+        /* Chunk of the stream file could be complete now */
+        if (fs_sink_trace_leave_chunk(trace, chunk_index)) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(fs_sink->logger, "Failed to complete trace chunk.");
+            status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+            goto end;
+        }
+    }
 
 end:
     return status;
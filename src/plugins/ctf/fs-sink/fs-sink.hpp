@@ -12,6 +12,7 @@
 #include <babeltrace2/babeltrace.h>
 
 #include "cpp-common/bt2c/logging.hpp"
+#include "ctfser/ctfser.h"
 
 struct fs_sink_comp
 {
@@ -48,6 +49,55 @@ struct fs_sink_comp
      */
     bool quiet = false;
 
+    /*
+     * True to write, for each stream file having a default clock
+     * class and packet beginning/end times, an LTTng-compatible
+     * packet index file in the `index` directory of its trace.
+     */
+    bool write_index = true;
+
+    /*
+     * Minimum content size (bytes) from which to close the current
+     * artificial packet of a stream which doesn't support packets
+     * before writing the next event.
+     */
+    uint64_t artificial_packet_size = 4 * 1024 * 1024;
+
+    /*
+     * Maximum duration (ns) of an artificial packet, from its first
+     * event to its last one, or 0 for no maximum duration.
+     */
+    uint64_t artificial_packet_max_duration_ns = 0;
+
+    /*
+     * Size (bytes) and duration (ns) from which a trace begins a new
+     * chunk, or 0 for no limit: the component rotates its output
+     * when either one isn't 0.
+     */
+    uint64_t rotation_size = 0;
+    uint64_t rotation_duration_ns = 0;
+
+    /*
+     * Maximum number of chunks to keep per trace, or 0 to keep all
+     * of them.
+     */
+    uint64_t rotation_chunk_count = 0;
+
+    /*
+     * zstd compression level of the packets of the stream files, or
+     * 0 to write uncompressed stream files.
+     *
+     * Compression requires `writer` below.
+     */
+    int compression_level = 0;
+
+    /*
+     * Background packet writer shared by all the stream files of
+     * this component (owned by this), or `nullptr` to write the
+     * packets directly to the memory-mapped stream files.
+     */
+    bt_ctfser_writer *writer = nullptr;
+
     /*
      * CTF version to generate (1 or 2).
      *
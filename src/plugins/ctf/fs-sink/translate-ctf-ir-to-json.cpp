@@ -869,53 +869,69 @@ void appendFragment(const nljson& jsonFrag, GString& metadata)
 
 } /* namespace */
 
-void translate_trace_ctf_ir_to_json(fs_sink_ctf_trace * const trace, GString * const metadataStream)
+void translate_new_trace_ctf_ir_to_json(fs_sink_ctf_trace * const trace,
+                                        fs_sink_ctf_metadata_pos * const pos,
+                                        GString * const metadataStream)
 {
-    /* Preamble fragment */
-    /* clang-format off */
-    appendFragment({
-        {jsonstr::type, jsonstr::preamble},
-        {jsonstr::version, 2},
-        {jsonstr::uuid, bt2c::call([trace] {
-            auto json = nljson::array();
-
-            for (const auto byte : bt2c::UuidView {trace->uuid}) {
-                json.push_back(byte);
-            }
+    if (!pos->has_trace_class) {
+        /* Preamble fragment */
+        /* clang-format off */
+        appendFragment({
+            {jsonstr::type, jsonstr::preamble},
+            {jsonstr::version, 2},
+            {jsonstr::uuid, bt2c::call([trace] {
+                auto json = nljson::array();
+
+                for (const auto byte : bt2c::UuidView {trace->uuid}) {
+                    json.push_back(byte);
+                }
 
-            return json;
-        })},
-        {jsonstr::attrs, {
-            {jsonstr::btNs, {
-                {"sink.ctf.fs", true},
+                return json;
+            })},
+            {jsonstr::attrs, {
+                {jsonstr::btNs, {
+                    {"sink.ctf.fs", true},
+                }},
             }},
-        }},
-    }, *metadataStream);
-    /* clang-format on */
+        }, *metadataStream);
+        /* clang-format on */
 
-    /* Trace class */
-    appendFragment(jsonTraceClsFromFs(*trace), *metadataStream);
+        /* Trace class */
+        appendFragment(jsonTraceClsFromFs(*trace), *metadataStream);
+        pos->has_trace_class = true;
+    }
 
-    /* Clock classes, data stream classes, event record classes */
+    /* New clock classes, data stream classes, and event record classes */
     for (auto streamClsIdx = 0U; streamClsIdx < trace->stream_classes->len; ++streamClsIdx) {
         auto& fsStreamCls = *static_cast<const fs_sink_ctf_stream_class *>(
             trace->stream_classes->pdata[streamClsIdx]);
 
-        /* Default clock class, if any */
-        if (fsStreamCls.default_clock_class) {
-            appendFragment(jsonClkClsFromIr(bt2::wrap(fsStreamCls.default_clock_class),
-                                            fsStreamCls.default_clock_class_name->str),
-                           *metadataStream);
-        }
+        if (streamClsIdx == pos->event_class_counts.size()) {
+            /* Default clock class, if any */
+            if (fsStreamCls.default_clock_class) {
+                appendFragment(jsonClkClsFromIr(bt2::wrap(fsStreamCls.default_clock_class),
+                                                fsStreamCls.default_clock_class_name->str),
+                               *metadataStream);
+            }
 
-        /* Data stream class */
-        appendFragment(jsonDataStreamClsFromFs(fsStreamCls), *metadataStream);
+            /* Data stream class */
+            appendFragment(jsonDataStreamClsFromFs(fsStreamCls), *metadataStream);
+            pos->event_class_counts.push_back(0);
+        }
 
         /* Event record classes */
-        for (auto eventClsIdx = 0U; eventClsIdx < fsStreamCls.event_classes->len; ++eventClsIdx) {
+        for (auto& eventClsIdx = pos->event_class_counts[streamClsIdx];
+             eventClsIdx < fsStreamCls.event_classes->len; ++eventClsIdx) {
             appendFragment(jsonEventRecordClsFromFs(*static_cast<fs_sink_ctf_event_class *>(
                                fsStreamCls.event_classes->pdata[eventClsIdx])),
                            *metadataStream);
         }
     }
 }
+
+void translate_trace_ctf_ir_to_json(fs_sink_ctf_trace * const trace, GString * const metadataStream)
+{
+    fs_sink_ctf_metadata_pos pos;
+
+    translate_new_trace_ctf_ir_to_json(trace, &pos, metadataStream);
+}
@@ -627,8 +627,6 @@ static void append_event_class(ctf::sink::CtfIrToTsdlCtx *ctx, struct fs_sink_ct
 
 static void append_stream_class(ctf::sink::CtfIrToTsdlCtx *ctx, struct fs_sink_ctf_stream_class *sc)
 {
-    uint64_t i;
-
     /* Default clock class */
     if (sc->default_clock_class) {
         const char *descr;
@@ -777,40 +775,32 @@ static void append_stream_class(ctf::sink::CtfIrToTsdlCtx *ctx, struct fs_sink_c
 
     /* End stream class */
     append_end_block_semi_nl_nl(ctx);
-
-    /* Event classes */
-    for (i = 0; i < sc->event_classes->len; i++) {
-        append_event_class(ctx, (fs_sink_ctf_event_class *) sc->event_classes->pdata[i]);
-    }
 }
 
-void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *tsdl)
+static void append_trace_class(ctf::sink::CtfIrToTsdlCtx *ctx, struct fs_sink_ctf_trace *trace)
 {
-    ctf::sink::CtfIrToTsdlCtx ctx = {
-        .indent_level = 0,
-        .tsdl = tsdl,
-    };
+    GString *tsdl = ctx->tsdl;
     uint64_t i;
     uint64_t count;
 
-    g_string_assign(tsdl, "/* CTF 1.8 */\n\n");
+    g_string_append(tsdl, "/* CTF 1.8 */\n\n");
     g_string_append(tsdl, "/* This was generated by a Babeltrace `sink.ctf.fs` component. */\n\n");
 
     /* Trace class */
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "trace {\n");
-    ctx.indent_level++;
+    ctx->indent_level++;
 
     /* Trace class properties */
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "major = 1;\n");
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "minor = 8;\n");
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "uuid = ");
-    append_uuid(&ctx, trace->uuid);
+    append_uuid(ctx, trace->uuid);
     g_string_append(tsdl, ";\n");
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "byte_order = ");
 
     if (BYTE_ORDER == LITTLE_ENDIAN) {
@@ -822,46 +812,46 @@ void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *ts
     g_string_append(tsdl, ";\n");
 
     /* Packet header field class */
-    append_indent(&ctx);
+    append_indent(ctx);
     g_string_append(tsdl, "packet.header := struct {\n");
-    ctx.indent_level++;
-    append_indent(&ctx);
-    append_integer_field_class_from_props(&ctx, 32, 8, false,
+    ctx->indent_level++;
+    append_indent(ctx);
+    append_integer_field_class_from_props(ctx, 32, 8, false,
                                           BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_HEXADECIMAL,
                                           NULL, "magic", true);
-    append_indent(&ctx);
-    append_integer_field_class_from_props(&ctx, 8, 8, false,
+    append_indent(ctx);
+    append_integer_field_class_from_props(ctx, 8, 8, false,
                                           BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_DECIMAL,
                                           NULL, "uuid[16]", true);
-    append_indent(&ctx);
-    append_integer_field_class_from_props(&ctx, 64, 8, false,
+    append_indent(ctx);
+    append_integer_field_class_from_props(ctx, 64, 8, false,
                                           BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_DECIMAL,
                                           NULL, "stream_id", true);
-    append_indent(&ctx);
-    append_integer_field_class_from_props(&ctx, 64, 8, false,
+    append_indent(ctx);
+    append_integer_field_class_from_props(ctx, 64, 8, false,
                                           BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_DECIMAL,
                                           NULL, "stream_instance_id", true);
 
     /* End packet header field class */
-    append_end_block(&ctx);
-    g_string_append(ctx.tsdl, " align(8);\n");
+    append_end_block(ctx);
+    g_string_append(ctx->tsdl, " align(8);\n");
 
     /* End trace class */
-    append_end_block_semi_nl_nl(&ctx);
+    append_end_block_semi_nl_nl(ctx);
 
     /* Trace environment */
     count = bt_trace_get_environment_entry_count(trace->ir_trace);
     if (count > 0) {
-        append_indent(&ctx);
+        append_indent(ctx);
         g_string_append(tsdl, "env {\n");
-        ctx.indent_level++;
+        ctx->indent_level++;
 
         for (i = 0; i < count; i++) {
             const char *name;
             const bt_value *val;
 
             bt_trace_borrow_environment_entry_by_index_const(trace->ir_trace, i, &name, &val);
-            append_indent(&ctx);
+            append_indent(ctx);
             g_string_append_printf(tsdl, "%s = ", name);
 
             switch (bt_value_get_type(val)) {
@@ -869,7 +859,7 @@ void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *ts
                 g_string_append_printf(tsdl, "%" PRId64, bt_value_integer_signed_get(val));
                 break;
             case BT_VALUE_TYPE_STRING:
-                append_quoted_string(&ctx, bt_value_string_get(val));
+                append_quoted_string(ctx, bt_value_string_get(val));
                 break;
             default:
                 /*
@@ -883,11 +873,45 @@ void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *ts
         }
 
         /* End trace class environment */
-        append_end_block_semi_nl_nl(&ctx);
+        append_end_block_semi_nl_nl(ctx);
     }
+}
 
-    /* Stream classes and their event classes */
-    for (i = 0; i < trace->stream_classes->len; i++) {
-        append_stream_class(&ctx, (fs_sink_ctf_stream_class *) trace->stream_classes->pdata[i]);
+void translate_new_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace,
+                                        struct fs_sink_ctf_metadata_pos *pos, GString *tsdl)
+{
+    ctf::sink::CtfIrToTsdlCtx ctx = {
+        .indent_level = 0,
+        .tsdl = tsdl,
+    };
+
+    if (!pos->has_trace_class) {
+        append_trace_class(&ctx, trace);
+        pos->has_trace_class = true;
     }
+
+    /*
+     * New stream classes and new event classes: TSDL allows a `stream`
+     * block and its `event` blocks to follow any other block.
+     */
+    for (guint i = 0; i < trace->stream_classes->len; i++) {
+        fs_sink_ctf_stream_class *sc = (fs_sink_ctf_stream_class *) trace->stream_classes->pdata[i];
+
+        if (i == pos->event_class_counts.size()) {
+            append_stream_class(&ctx, sc);
+            pos->event_class_counts.push_back(0);
+        }
+
+        for (guint& ec_i = pos->event_class_counts[i]; ec_i < sc->event_classes->len; ec_i++) {
+            append_event_class(&ctx, (fs_sink_ctf_event_class *) sc->event_classes->pdata[ec_i]);
+        }
+    }
+}
+
+void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *tsdl)
+{
+    fs_sink_ctf_metadata_pos pos;
+
+    g_string_truncate(tsdl, 0);
+    translate_new_trace_ctf_ir_to_tsdl(trace, &pos, tsdl);
 }
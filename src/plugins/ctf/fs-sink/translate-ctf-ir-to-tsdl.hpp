@@ -9,6 +9,15 @@
 
 #include <glib.h>
 
+struct fs_sink_ctf_metadata_pos;
+
 void translate_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace, GString *tsdl);
 
+/*
+ * Appends to `tsdl` the TSDL of what `pos` doesn't describe yet within
+ * `trace`, updating `pos`.
+ */
+void translate_new_trace_ctf_ir_to_tsdl(struct fs_sink_ctf_trace *trace,
+                                        struct fs_sink_ctf_metadata_pos *pos, GString *tsdl);
+
 #endif /* BABELTRACE_PLUGINS_CTF_FS_SINK_TRANSLATE_CTF_IR_TO_TSDL_HPP */
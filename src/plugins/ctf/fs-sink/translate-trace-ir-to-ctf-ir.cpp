@@ -1589,6 +1589,150 @@ static inline void ctx_fini(ctf::sink::TraceIrToCtfIrCtx *ctx)
     }
 }
 
+/* State while building the write program of an event class */
+struct write_prog_builder
+{
+    /* Weak */
+    struct fs_sink_ctf_event_class *ec;
+
+    /*
+     * Index of the `RESERVE` instruction of the current run of
+     * fixed-size instructions within `ec->write_prog`, or
+     * `G_MAXUINT` if there's no current run.
+     */
+    guint reserve_insn_index;
+};
+
+static void append_write_insn(struct write_prog_builder *builder,
+                              const struct fs_sink_ctf_write_insn *insn)
+{
+    GArray *prog = builder->ec->write_prog;
+
+    if (insn->type == FS_SINK_CTF_WRITE_INSN_TYPE_FIELD) {
+        /* Variable size: ends the current run */
+        builder->reserve_insn_index = G_MAXUINT;
+    } else {
+        if (builder->reserve_insn_index == G_MAXUINT) {
+            struct fs_sink_ctf_write_insn reserve_insn = {};
+
+            reserve_insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_RESERVE;
+            builder->reserve_insn_index = prog->len;
+            g_array_append_val(prog, reserve_insn);
+        }
+
+        /* Worst case: maximum padding, then the field itself */
+        g_array_index(prog, struct fs_sink_ctf_write_insn, builder->reserve_insn_index).size +=
+            insn->alignment - 1 + insn->size;
+    }
+
+    g_array_append_val(prog, *insn);
+}
+
+static void append_struct_write_insns(struct write_prog_builder *builder,
+                                      struct fs_sink_ctf_field_class_struct *fc,
+                                      const unsigned int reg)
+{
+    for (guint i = 0; i < fc->members->len; i++) {
+        struct fs_sink_ctf_field_class *member_fc =
+            fs_sink_ctf_field_class_struct_borrow_member_by_index(fc, i)->fc;
+        struct fs_sink_ctf_write_insn insn = {};
+
+        insn.src_reg = reg;
+        insn.index = i;
+        insn.alignment = member_fc->alignment;
+        insn.fc = member_fc;
+
+        switch (member_fc->type) {
+        case FS_SINK_CTF_FIELD_CLASS_TYPE_BOOL:
+            insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_BOOL;
+            insn.size = fs_sink_ctf_field_class_as_bit_array(member_fc)->size;
+            break;
+        case FS_SINK_CTF_FIELD_CLASS_TYPE_BIT_ARRAY:
+            insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_BIT_ARRAY;
+            insn.size = fs_sink_ctf_field_class_as_bit_array(member_fc)->size;
+            break;
+        case FS_SINK_CTF_FIELD_CLASS_TYPE_INT:
+            insn.type = fs_sink_ctf_field_class_as_int(member_fc)->is_signed ?
+                            FS_SINK_CTF_WRITE_INSN_TYPE_SINT :
+                            FS_SINK_CTF_WRITE_INSN_TYPE_UINT;
+            insn.size = fs_sink_ctf_field_class_as_bit_array(member_fc)->size;
+            break;
+        case FS_SINK_CTF_FIELD_CLASS_TYPE_FLOAT:
+            insn.size = fs_sink_ctf_field_class_as_bit_array(member_fc)->size;
+            insn.type = insn.size == 32 ? FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT32 :
+                                          FS_SINK_CTF_WRITE_INSN_TYPE_FLOAT64;
+            break;
+        case FS_SINK_CTF_FIELD_CLASS_TYPE_STRUCT:
+            insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_STRUCT;
+            insn.dst_reg = builder->ec->write_prog_reg_count++;
+            append_write_insn(builder, &insn);
+            append_struct_write_insns(builder, fs_sink_ctf_field_class_as_struct(member_fc),
+                                      insn.dst_reg);
+            continue;
+        default:
+            insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_FIELD;
+            break;
+        }
+
+        append_write_insn(builder, &insn);
+    }
+}
+
+static void append_scope_write_insns(struct write_prog_builder *builder,
+                                     const bt_field_path_scope scope,
+                                     struct fs_sink_ctf_field_class *fc)
+{
+    struct fs_sink_ctf_write_insn insn = {};
+
+    if (!fc) {
+        return;
+    }
+
+    insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_SCOPE;
+    insn.index = scope;
+    insn.alignment = fc->alignment;
+    insn.dst_reg = builder->ec->write_prog_reg_count++;
+    append_write_insn(builder, &insn);
+    append_struct_write_insns(builder, fs_sink_ctf_field_class_as_struct(fc), insn.dst_reg);
+}
+
+/*
+ * Builds the write program of `ec` (see the `write_prog` member of
+ * `struct fs_sink_ctf_event_class`).
+ */
+static void build_event_class_write_prog(struct fs_sink_ctf_event_class *ec)
+{
+    struct write_prog_builder builder = {ec, G_MAXUINT};
+    struct fs_sink_ctf_write_insn insn = {};
+
+    BT_ASSERT(!ec->write_prog);
+    ec->write_prog = g_array_new(FALSE, FALSE, sizeof(struct fs_sink_ctf_write_insn));
+    BT_ASSERT(ec->write_prog);
+
+    /* Header */
+    insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_EVENT_CLASS_ID;
+    insn.alignment = 8;
+    insn.size = 64;
+    append_write_insn(&builder, &insn);
+
+    if (ec->sc->default_clock_class) {
+        insn.type = FS_SINK_CTF_WRITE_INSN_TYPE_TIME;
+        append_write_insn(&builder, &insn);
+    }
+
+    /* Scopes */
+    append_scope_write_insns(&builder, BT_FIELD_PATH_SCOPE_EVENT_COMMON_CONTEXT,
+                             ec->sc->event_common_context_fc);
+    append_scope_write_insns(&builder, BT_FIELD_PATH_SCOPE_EVENT_SPECIFIC_CONTEXT,
+                             ec->spec_context_fc);
+    append_scope_write_insns(&builder, BT_FIELD_PATH_SCOPE_EVENT_PAYLOAD, ec->payload_fc);
+
+    if (ec->write_prog_reg_count > 0) {
+        ec->write_prog_regs = g_new0(const bt_field *, ec->write_prog_reg_count);
+        BT_ASSERT(ec->write_prog_regs);
+    }
+}
+
 static int translate_event_class(struct fs_sink_comp *fs_sink, struct fs_sink_ctf_stream_class *sc,
                                  const bt_event_class *ir_ec,
                                  struct fs_sink_ctf_event_class **out_ec)
@@ -1618,6 +1762,8 @@ static int translate_event_class(struct fs_sink_comp *fs_sink, struct fs_sink_ct
         goto end;
     }
 
+    build_event_class_write_prog(ec);
+
 end:
     ctx_fini(&ctx);
     *out_ec = ec;
@@ -6,20 +6,35 @@
  * Copyright 2010-2011 EfficiOS Inc. and Linux Foundation
  */
 
+#include <algorithm>
+
+#include <fcntl.h>
 #include <glib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __MINGW32__
+#    include <io.h>
+#endif
+
+#ifdef BT_HAVE_ZSTD
+#    include <zstd.h>
+#endif
 
 #include "compat/endian.h" /* IWYU pragma: keep  */
 #include "compat/mman.h"   /* IWYU: pragma keep  */
 #include "cpp-common/bt2c/glib-up.hpp"
 #include "cpp-common/bt2s/make-unique.hpp"
 #include "cpp-common/vendor/fmt/format.h"
+#include "ctfser/zstd-seek-table.h"
 
 #include "../common/src/pkt-props.hpp"
 #include "data-stream-file.hpp"
 #include "file.hpp"
+#include "index-cache.hpp"
 #include "lttng-index.hpp"
 
 using namespace bt2c::literals::datalen;
@@ -35,10 +50,248 @@ static bt2c::DataLen getFileSize(const char * const path, const bt2c::Logger& lo
     return bt2c::DataLen::fromBytes(st.st_size);
 }
 
+/*
+ * Reads `len` bytes at `offset` of the opened file `file` into `dst`.
+ */
+static void readFileRange(ctf_fs_file& file, const off_t offset, std::uint8_t * const dst,
+                          const size_t len)
+{
+    if (fseeko(file.fp.get(), offset, SEEK_SET) != 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW_SPEC(file.logger, bt2::Error,
+                                                     "Failed to seek data stream file",
+                                                     ": path=\"{}\", offset={}", file.path,
+                                                     (intmax_t) offset);
+    }
+
+    if (fread(dst, 1, len, file.fp.get()) != len) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            file.logger, bt2::Error,
+            "Failed to read data stream file: path=\"{}\", offset={}, len={}", file.path,
+            (intmax_t) offset, len);
+    }
+}
+
+static std::uint32_t readLe32(const std::uint8_t * const data) noexcept
+{
+    std::uint32_t val;
+
+    memcpy(&val, data, sizeof(val));
+    return le32toh(val);
+}
+
+/* Magic number which begins a zstd frame */
+static constexpr std::uint32_t zstdFrameMagic = 0xfd2fb528;
+
+/*
+ * Returns the frames of the seek table of `file`, or `bt2s::nullopt`
+ * if it has no seek table.
+ */
+static bt2s::optional<std::vector<ctf_fs_ds_zstd_frame>> readZstdSeekTable(ctf_fs_file& file)
+{
+    const auto minTableSize = static_cast<off_t>(BT_ZSTD_SEEK_TABLE_FRAME_HEADER_SIZE +
+                                                 BT_ZSTD_SEEK_TABLE_FOOTER_SIZE);
+
+    if (file.size < minTableSize) {
+        return bt2s::nullopt;
+    }
+
+    /* Footer: frame count, descriptor, and magic */
+    std::uint8_t footer[BT_ZSTD_SEEK_TABLE_FOOTER_SIZE];
+
+    readFileRange(file, file.size - BT_ZSTD_SEEK_TABLE_FOOTER_SIZE, footer, sizeof(footer));
+
+    if (readLe32(&footer[5]) != BT_ZSTD_SEEK_TABLE_FOOTER_MAGIC) {
+        return bt2s::nullopt;
+    }
+
+    const auto frameCount = readLe32(&footer[0]);
+    const auto entrySize = BT_ZSTD_SEEK_TABLE_ENTRY_SIZE +
+                           ((footer[4] & BT_ZSTD_SEEK_TABLE_DESC_CHECKSUM_FLAG) ? 4 : 0);
+    const auto tableSize = minTableSize + static_cast<off_t>(frameCount) * entrySize;
+
+    if (tableSize > file.size) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            file.logger, bt2::Error,
+            "Invalid seek table: larger than compressed data stream file: path=\"{}\", "
+            "frame-count={}, file-size-bytes={}",
+            file.path, frameCount, (intmax_t) file.size);
+    }
+
+    std::vector<std::uint8_t> table(tableSize - BT_ZSTD_SEEK_TABLE_FOOTER_SIZE);
+
+    readFileRange(file, file.size - tableSize, table.data(), table.size());
+
+    if (readLe32(&table[0]) != BT_ZSTD_SEEK_TABLE_FRAME_MAGIC ||
+        readLe32(&table[4]) != tableSize - BT_ZSTD_SEEK_TABLE_FRAME_HEADER_SIZE) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            file.logger, bt2::Error,
+            "Invalid seek table: unexpected skippable frame header: path=\"{}\"", file.path);
+    }
+
+    std::vector<ctf_fs_ds_zstd_frame> frames;
+    uint64_t offsetInFile = 0;
+    uint64_t offset = 0;
+
+    frames.reserve(frameCount);
+
+    for (std::uint32_t i = 0; i < frameCount; ++i) {
+        const auto entry = &table[BT_ZSTD_SEEK_TABLE_FRAME_HEADER_SIZE + i * entrySize];
+        const ctf_fs_ds_zstd_frame frame {offsetInFile, readLe32(&entry[0]), offset,
+                                          readLe32(&entry[4])};
+
+        frames.push_back(frame);
+        offsetInFile += frame.compressedSize;
+        offset += frame.size;
+    }
+
+    if (offsetInFile != static_cast<uint64_t>(file.size - tableSize)) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            file.logger, bt2::Error,
+            "Invalid seek table: frames don't end where the seek table begins: path=\"{}\", "
+            "frames-size-bytes={}, seek-table-offset={}",
+            file.path, offsetInFile, (intmax_t) (file.size - tableSize));
+    }
+
+    BT_CPPLOGI_SPEC(file.logger,
+                    "Read seek table of compressed data stream file: path=\"{}\", "
+                    "frame-count={}, size-bytes={}",
+                    file.path, frameCount, offset);
+    return frames;
+}
+
+#ifdef BT_HAVE_ZSTD
+/*
+ * Decompresses the whole zstd-compressed file `file`, discarding the
+ * data, to find its frames.
+ */
+static std::vector<ctf_fs_ds_zstd_frame> scanZstdFrames(ctf_fs_file& file)
+{
+    BT_CPPLOGI_SPEC(file.logger, "Scanning frames of compressed data stream file: path=\"{}\"",
+                    file.path);
+
+    const std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx *)> dctx {ZSTD_createDCtx(),
+                                                                   ZSTD_freeDCtx};
+
+    if (!dctx) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(file.logger, bt2::Error,
+                                               "Failed to create zstd decompression context.");
+    }
+
+    std::vector<std::uint8_t> inBuf(ZSTD_DStreamInSize());
+    std::vector<std::uint8_t> outBuf(ZSTD_DStreamOutSize());
+    std::vector<ctf_fs_ds_zstd_frame> frames;
+    uint64_t inOffset = 0;
+    uint64_t frameOffsetInFile = 0;
+    uint64_t frameOffset = 0;
+    uint64_t offset = 0;
+    size_t ret = 0;
+
+    while (inOffset < static_cast<uint64_t>(file.size)) {
+        const auto len = std::min<uint64_t>(inBuf.size(), file.size - inOffset);
+        ZSTD_inBuffer in {inBuf.data(), len, 0};
+        ZSTD_outBuffer out;
+
+        readFileRange(file, static_cast<off_t>(inOffset), inBuf.data(), len);
+
+        /* Consume all the input and flush all the output */
+        do {
+            out = {outBuf.data(), outBuf.size(), 0};
+            ret = ZSTD_decompressStream(dctx.get(), &out, &in);
+
+            if (ZSTD_isError(ret)) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    file.logger, bt2::Error,
+                    "Failed to decompress data stream file: path=\"{}\", offset-in-file={}, "
+                    "error=\"{}\"",
+                    file.path, inOffset + in.pos, ZSTD_getErrorName(ret));
+            }
+
+            offset += out.pos;
+
+            if (ret == 0) {
+                /* End of frame (skip empty and skippable frames) */
+                const auto frameEndInFile = inOffset + in.pos;
+
+                if (offset > frameOffset) {
+                    frames.push_back({frameOffsetInFile, frameEndInFile - frameOffsetInFile,
+                                      frameOffset, offset - frameOffset});
+                }
+
+                frameOffsetInFile = frameEndInFile;
+                frameOffset = offset;
+            }
+        } while (in.pos < in.size || out.pos == out.size);
+
+        inOffset += len;
+    }
+
+    if (ret != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            file.logger, bt2::Error,
+            "Truncated compressed data stream file: path=\"{}\", size-bytes={}", file.path,
+            (intmax_t) file.size);
+    }
+
+    BT_CPPLOGI_SPEC(file.logger,
+                    "Scanned frames of compressed data stream file: path=\"{}\", "
+                    "frame-count={}, size-bytes={}",
+                    file.path, frames.size(), offset);
+    return frames;
+}
+#endif /* BT_HAVE_ZSTD */
+
+bt2s::optional<std::vector<ctf_fs_ds_zstd_frame>> ctf_fs_ds_file_read_zstd_frames(ctf_fs_file& file)
+{
+    auto frames = readZstdSeekTable(file);
+
+    if (frames) {
+        return frames;
+    }
+
+    std::uint8_t magic[4];
+
+    if (file.size < static_cast<off_t>(sizeof(magic))) {
+        return bt2s::nullopt;
+    }
+
+    readFileRange(file, 0, magic, sizeof(magic));
+
+    if (readLe32(magic) != zstdFrameMagic) {
+        return bt2s::nullopt;
+    }
+
+#ifdef BT_HAVE_ZSTD
+    return scanZstdFrames(file);
+#else
+    BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+        file.logger, bt2::Error,
+        "Cannot read compressed data stream file: Babeltrace was built without zstd support: "
+        "path=\"{}\"",
+        file.path);
+#endif
+}
+
 ctf_fs_ds_file_info::ctf_fs_ds_file_info(std::string path, const bt2c::Logger& parentLogger) :
     _mLogger {parentLogger, "PLUGIN/SRC.CTF.FS/DS-FILE-INFO"}, _mPath(std::move(path)),
     _mSize(getFileSize(_mPath.c_str(), _mLogger))
 {
+    ctf_fs_file file {_mLogger};
+
+    file.path = _mPath;
+    if (ctf_fs_file_open(&file, "rb")) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to open data stream file: path=\"{}\"",
+                                          _mPath);
+    }
+
+    auto frames = ctf_fs_ds_file_read_zstd_frames(file);
+
+    if (frames) {
+        _mIsCompressed = true;
+        _mZstdFrames = std::move(*frames);
+        _mSize = _mZstdFrames.empty() ?
+                     0_bytes :
+                     bt2c::DataLen::fromBytes(_mZstdFrames.back().offset + _mZstdFrames.back().size);
+    }
 }
 
 /*
@@ -88,10 +341,16 @@ static ds_file_status ds_file_munmap(struct ctf_fs_ds_file *ds_file)
  * mapping.  If the currently mmap-ed region already contains
  * `requested_offset_in_file`, the mapping is kept.
  *
+ * If `populate` is true, then populate the page tables of the new
+ * mapping, where supported.
+ *
  * `requested_offset_in_file` must be a valid offset in the file.
  */
-static ds_file_status ds_file_mmap(struct ctf_fs_ds_file *ds_file, off_t requested_offset_in_file)
+static ds_file_status ds_file_mmap(struct ctf_fs_ds_file *ds_file, off_t requested_offset_in_file,
+                                   const bool populate = false)
 {
+    int flags = MAP_PRIVATE;
+
     /* Ensure the requested offset is in the file range. */
     BT_ASSERT(requested_offset_in_file >= 0);
     BT_ASSERT(requested_offset_in_file < ds_file->file->size);
@@ -124,8 +383,16 @@ static ds_file_status ds_file_mmap(struct ctf_fs_ds_file *ds_file, off_t request
     BT_ASSERT(requested_offset_in_file >= ds_file->mmap_offset_in_file);
     BT_ASSERT(requested_offset_in_file < (ds_file->mmap_offset_in_file + ds_file->mmap_len));
 
+#ifdef MAP_POPULATE
+    if (populate) {
+        flags |= MAP_POPULATE;
+    }
+#else
+    (void) populate;
+#endif
+
     ds_file->mmap_addr =
-        bt_mmap(ds_file->mmap_len, PROT_READ, MAP_PRIVATE, fileno(ds_file->file->fp.get()),
+        bt_mmap(ds_file->mmap_len, PROT_READ, flags, fileno(ds_file->file->fp.get()),
                 ds_file->mmap_offset_in_file, static_cast<int>(ds_file->logger.level()));
     if (ds_file->mmap_addr == MAP_FAILED) {
         BT_CPPLOGE_SPEC(ds_file->logger,
@@ -138,6 +405,46 @@ static ds_file_status ds_file_mmap(struct ctf_fs_ds_file *ds_file, off_t request
     return DS_FILE_STATUS_OK;
 }
 
+ctf_fs_ds_index::EntriesT::const_iterator
+ctf_fs_ds_index::findEntry(const bt2c::DataLen offsetInStream) const noexcept
+{
+    return std::lower_bound(
+        this->entries.begin(), this->entries.end(), offsetInStream,
+        [](const ctf_fs_ds_index_entry& entry, bt2c::DataLen offsetInStreamLambda) {
+            return (entry.offsetInStream + entry.packetSize - 1_bytes) < offsetInStreamLambda;
+        });
+}
+
+bt2c::DataLen ctf_fs_ds_index::dataEndInFile(const EntriesT::const_iterator entryIt,
+                                             const bt2c::DataLen exclEndInFile) const noexcept
+{
+    /*
+     * Find the end entry.  We can include the following entries as long as
+     *
+     *  1) there are following entries
+     *  2) they are located in the same file as our starting entry
+     *  3) they are (at least partially) within the range
+     *
+     * The entries of a given file are consecutive and sorted by offset
+     * in the index, so that this condition partitions the entries
+     * following the starting one.
+     */
+    const EntriesT::const_iterator endEntryIt =
+        std::partition_point(entryIt + 1, this->entries.end(),
+                             [&](const ctf_fs_ds_index_entry& entry) {
+                                 return entry.path == entryIt->path &&
+                                        entry.offsetInFile < exclEndInFile;
+                             }) -
+        1;
+
+    /*
+     * It's possible the range ends in the middle of our end entry.  Choose
+     * the end of the range or the end of the end entry, whichever comes
+     * first.
+     */
+    return std::min(exclEndInFile, endEntryIt->offsetInFile + endEntryIt->packetSize);
+}
+
 void ctf_fs_ds_index::updateOffsetsInStream()
 {
     auto offsetInStream = 0_bytes;
@@ -235,12 +542,12 @@ build_index_from_idx_file(const ctf_fs_ds_file_info& fileInfo, const ctf::src::T
      * We don't know the size of that packet yet, so pretend that it spans the
      * whole file (the reader will only read the header anyway).
      */
-    ctf_fs_ds_index_entry tempIndexEntry {path, 0_bits, fileInfo.size()};
+    ctf_fs_ds_index_entry tempIndexEntry {fileInfo, 0_bits, fileInfo.size()};
     ctf_fs_ds_index tempIndex;
     tempIndex.entries.emplace_back(tempIndexEntry);
 
-    ctf::src::fs::Medium::UP medium =
-        bt2s::make_unique<ctf::src::fs::Medium>(tempIndex, fileInfo.logger());
+    ctf::src::Medium::UP medium = ctf::src::fs::createMedium(ctf::src::fs::ReadMode::Mmap,
+                                                             tempIndex, 0, fileInfo.logger());
     ctf::src::PktProps props =
         ctf::src::readPktProps(traceCls, std::move(medium), 0_bytes, fileInfo.logger());
 
@@ -255,6 +562,8 @@ build_index_from_idx_file(const ctf_fs_ds_file_info& fileInfo, const ctf::src::T
     ctf_fs_ds_index_entry *prev_index_entry = nullptr;
     auto totalPacketsSize = 0_bytes;
 
+    index.entries.reserve(file_entry_count);
+
     for (size_t i = 0; i < file_entry_count; i++) {
         struct ctf_packet_index *file_index = (struct ctf_packet_index *) file_pos;
         const auto packetSize = bt2c::DataLen::fromBits(be64toh(file_index->packet_size));
@@ -276,7 +585,7 @@ build_index_from_idx_file(const ctf_fs_ds_file_info& fileInfo, const ctf::src::T
             return bt2s::nullopt;
         }
 
-        ctf_fs_ds_index_entry index_entry {path, offset, packetSize};
+        ctf_fs_ds_index_entry index_entry {fileInfo, offset, packetSize};
         index_entry.timestamp_begin = be64toh(file_index->timestamp_begin);
         index_entry.timestamp_end = be64toh(file_index->timestamp_end);
         if (index_entry.timestamp_end < index_entry.timestamp_begin) {
@@ -340,6 +649,21 @@ build_index_from_stream_file(const ctf_fs_ds_file_info& fileInfo,
     ctf_fs_ds_index index;
     auto currentPacketOffset = 0_bytes;
 
+    /*
+     * Create a single medium and packet properties reader for the whole
+     * file: the medium keeps its mappings from one packet to the next.
+     *
+     * We don't know yet the packet sizes (that's one of the things we
+     * want to find out), so pretend there's a single packet spanning
+     * the whole file.
+     */
+    ctf_fs_ds_index tempIndex;
+    tempIndex.entries.emplace_back(fileInfo, 0_bytes, fileInfo.size());
+    ctf::src::PktPropsReader pktPropsReader {
+        traceCls,
+        ctf::src::fs::createMedium(ctf::src::fs::ReadMode::Mmap, tempIndex, 0, fileInfo.logger()),
+        fileInfo.logger()};
+
     while (true) {
         if (currentPacketOffset > fileInfo.size()) {
             BT_CPPLOGE_SPEC(fileInfo.logger(),
@@ -350,20 +674,7 @@ build_index_from_stream_file(const ctf_fs_ds_file_info& fileInfo,
             break;
         }
 
-        /*
-         * Create a temporary index and medium to read the properties of the
-         * current packet.  We don't know yet the size of the packet (that's
-         * one of the things we want to find out), so pretend it spans the rest
-         * of the file.
-         */
-        ctf_fs_ds_index_entry tempIndexEntry {path, currentPacketOffset,
-                                              fileInfo.size() - currentPacketOffset};
-        ctf_fs_ds_index tempIndex;
-        tempIndex.entries.emplace_back(tempIndexEntry);
-        ctf::src::fs::Medium::UP medium =
-            bt2s::make_unique<ctf::src::fs::Medium>(tempIndex, fileInfo.logger());
-        ctf::src::PktProps props = ctf::src::readPktProps(traceCls, std::move(medium),
-                                                          currentPacketOffset, fileInfo.logger());
+        ctf::src::PktProps props = pktPropsReader.read(currentPacketOffset);
 
         /*
          * Get the current packet size from the packet header, if set.  Else,
@@ -389,7 +700,7 @@ build_index_from_stream_file(const ctf_fs_ds_file_info& fileInfo,
             return bt2s::nullopt;
         }
 
-        ctf_fs_ds_index_entry index_entry {path, currentPacketOffset, currentPacketSize};
+        ctf_fs_ds_index_entry index_entry {fileInfo, currentPacketOffset, currentPacketSize};
 
         if (init_index_entry(index_entry, &props)) {
             return bt2s::nullopt;
@@ -408,12 +719,12 @@ build_index_from_stream_file(const ctf_fs_ds_file_info& fileInfo,
     return index;
 }
 
-ctf_fs_ds_file::UP ctf_fs_ds_file_create(const char *path, const bt2c::Logger& parentLogger)
+ctf_fs_ds_file::UP ctf_fs_ds_file_create(const char *path, const size_t mmapMaxLen,
+                                         const bt2c::Logger& parentLogger)
 {
-    const auto offset_align = bt_mmap_get_offset_align_size(static_cast<int>(parentLogger.level()));
-    auto ds_file = bt2s::make_unique<ctf_fs_ds_file>(parentLogger, offset_align * 2048);
+    auto ds_file = bt2s::make_unique<ctf_fs_ds_file>(parentLogger, mmapMaxLen);
 
-    ds_file->file = bt2s::make_unique<ctf_fs_file>(ds_file->logger);
+    ds_file->file = std::make_shared<ctf_fs_file>(ds_file->logger);
     ds_file->file->path = path;
     int ret = ctf_fs_file_open(ds_file->file.get(), "rb");
     if (ret) {
@@ -427,23 +738,201 @@ namespace ctf {
 namespace src {
 namespace fs {
 
-Medium::Medium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger) :
-    _mIndex(index), _mLogger {parentLogger, "PLUGIN/SRC.CTF.FS/DS-MEDIUM"}
+/*
+ * Number of maximum length mappings which the mapping cache of a
+ * medium may hold.
+ */
+static constexpr size_t maxCachedMappingCount = 4;
+
+/*
+ * Default maximum length of a mapping, in mapping offset alignment
+ * units (8 MiB with 4 KiB pages).
+ */
+static constexpr size_t defaultMmapMaxLenAlignUnits = 2048;
+
+static size_t mmapMaxLen(const size_t requestedLen, const bt2c::Logger& logger)
+{
+    const auto align = bt_mmap_get_offset_align_size(static_cast<int>(logger.level()));
+
+    if (requestedLen == 0) {
+        return align * defaultMmapMaxLenAlignUnits;
+    }
+
+    return (requestedLen + align - 1) / align * align;
+}
+
+Medium::Medium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+               const size_t mmapMaxLenParam, const bool prefault) :
+    _mIndex(index), _mLogger {parentLogger, "PLUGIN/SRC.CTF.FS/DS-MEDIUM"},
+    _mMmapMaxLen {mmapMaxLen(mmapMaxLenParam, _mLogger)},
+    _mMaxMappedLen {_mMmapMaxLen * maxCachedMappingCount}, _mPrefault {prefault}
 {
     BT_ASSERT(!_mIndex.entries.empty());
 }
 
-ctf_fs_ds_index::EntriesT::const_iterator
-Medium::_mFindIndexEntryForOffset(bt2c::DataLen offsetInStream) const noexcept
+void Medium::_mAdviseReadahead(const ctf_fs_ds_file& dsFile) const noexcept
 {
-    return std::lower_bound(
-        _mIndex.entries.begin(), _mIndex.entries.end(), offsetInStream,
-        [](const ctf_fs_ds_index_entry& entry, bt2c::DataLen offsetInStreamLambda) {
-            return (entry.offsetInStream + entry.packetSize - 1_bytes) < offsetInStreamLambda;
-        });
+#ifdef MADV_SEQUENTIAL
+    /*
+     * Make the kernel read ahead aggressively within the mapping, and
+     * free its pages early once read.
+     */
+    if (madvise(dsFile.mmap_addr, dsFile.mmap_len, MADV_SEQUENTIAL) != 0) {
+        BT_CPPLOGD_ERRNO("madvise(MADV_SEQUENTIAL) failed", ": path=\"{}\"", dsFile.file->path);
+    }
+#endif
+
+#ifdef POSIX_FADV_WILLNEED
+    /*
+     * Start reading the next window into the page cache now, so that
+     * the page faults of its future mapping don't wait for the disk.
+     */
+    const auto nextWindowOffset = dsFile.mmap_offset_in_file + static_cast<off_t>(dsFile.mmap_len);
+
+    if (nextWindowOffset < dsFile.file->size) {
+        const auto ret = posix_fadvise(
+            fileno(dsFile.file->fp.get()), nextWindowOffset,
+            std::min(static_cast<off_t>(_mMmapMaxLen), dsFile.file->size - nextWindowOffset),
+            POSIX_FADV_WILLNEED);
+
+        if (ret != 0) {
+            BT_CPPLOGD("posix_fadvise(POSIX_FADV_WILLNEED) failed: path=\"{}\", ret={}",
+                       dsFile.file->path, ret);
+        }
+    }
+#else
+    (void) dsFile;
+#endif
+}
+
+void Medium::_mStartNextMapping(const ctf_fs_ds_file& dsFile)
+{
+#ifndef __MINGW32__
+    BT_ASSERT_DBG(!_mNextMapping.valid());
+
+    const auto offset = dsFile.mmap_offset_in_file + static_cast<off_t>(dsFile.mmap_len);
+
+    if (offset >= dsFile.file->size) {
+        /* Nothing to map ahead within this file */
+        return;
+    }
+
+    /* Share the already open file */
+    auto nextDsFile = bt2s::make_unique<ctf_fs_ds_file>(_mLogger, _mMmapMaxLen);
+
+    nextDsFile->file = dsFile.file;
+    _mNextMapping = std::async(
+        std::launch::async,
+        [offset](ctf_fs_ds_file::UP nextDsFileLambda) {
+            if (ds_file_mmap(nextDsFileLambda.get(), offset, true) != DS_FILE_STATUS_OK) {
+                /* Let a synchronous mapping report the error, if any. */
+                return ctf_fs_ds_file::UP {};
+            }
+
+            return nextDsFileLambda;
+        },
+        std::move(nextDsFile));
+#else
+    (void) dsFile;
+#endif
+}
+
+ctf_fs_ds_file::UP Medium::_mTakeNextMapping(const char * const path, const off_t offset,
+                                             const off_t endOffset)
+{
+    if (!_mNextMapping.valid()) {
+        return nullptr;
+    }
+
+    auto dsFile = _mNextMapping.get();
+
+    if (!dsFile || dsFile->file->path != path || !offset_ist_mapped(dsFile.get(), offset)) {
+        /* Failed or not the requested window: discard it */
+        return nullptr;
+    }
+
+    const auto exclEndOfMapping = dsFile->mmap_offset_in_file + static_cast<off_t>(dsFile->mmap_len);
+
+    if (endOffset > exclEndOfMapping && exclEndOfMapping != dsFile->file->size) {
+        return nullptr;
+    }
+
+    BT_CPPLOGD("Using prefaulted mapping: path=\"{}\", mapping-offset-bytes={}, "
+               "mapping-len-bytes={}",
+               path, (intmax_t) dsFile->mmap_offset_in_file, dsFile->mmap_len);
+    return dsFile;
+}
+
+ctf_fs_ds_file& Medium::_mMapping(const char * const path, const bt2c::DataLen offsetInFile,
+                                  const bt2c::DataLen minSize)
+{
+    const auto offset = static_cast<off_t>(offsetInFile.bytes());
+    const auto endOffset = static_cast<off_t>((offsetInFile + minSize).bytes());
+    std::shared_ptr<ctf_fs_file> file;
+
+    for (auto it = _mMappings.begin(); it != _mMappings.end(); ++it) {
+        ctf_fs_ds_file& dsFile = **it;
+
+        if (dsFile.file->path != path) {
+            continue;
+        }
+
+        const auto exclEndOfMapping =
+            dsFile.mmap_offset_in_file + static_cast<off_t>(dsFile.mmap_len);
+
+        if (offset_ist_mapped(&dsFile, offset) &&
+            (endOffset <= exclEndOfMapping || exclEndOfMapping == dsFile.file->size)) {
+            BT_CPPLOGD("Reusing cached mapping: path=\"{}\", mapping-offset-bytes={}, "
+                       "mapping-len-bytes={}",
+                       path, (intmax_t) dsFile.mmap_offset_in_file, dsFile.mmap_len);
+            _mMappings.splice(_mMappings.begin(), _mMappings, it);
+            return dsFile;
+        }
+
+        file = dsFile.file;
+    }
+
+    ctf_fs_ds_file::UP dsFile = this->_mTakeNextMapping(path, offset, endOffset);
+
+    if (!dsFile) {
+        if (file) {
+            /* Share the already open file. */
+            dsFile = bt2s::make_unique<ctf_fs_ds_file>(_mLogger, _mMmapMaxLen);
+            dsFile->file = std::move(file);
+        } else {
+            dsFile = ctf_fs_ds_file_create(path, _mMmapMaxLen, _mLogger);
+            if (!dsFile) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to create ctf_fs_ds_file");
+            }
+        }
+
+        if (ds_file_mmap(dsFile.get(), offset, _mPrefault) != DS_FILE_STATUS_OK) {
+            throw bt2::Error("Failed to mmap file");
+        }
+    }
+
+    this->_mAdviseReadahead(*dsFile);
+    _mMappedLen += dsFile->mmap_len;
+    _mMappings.emplace_front(std::move(dsFile));
+    this->_mEvictMappings();
+
+    if (_mPrefault) {
+        this->_mStartNextMapping(*_mMappings.front());
+    }
+
+    return *_mMappings.front();
 }
 
-ctf::src::Buf Medium::buf(const bt2c::DataLen requestedOffsetInStream, const bt2c::DataLen minSize)
+void Medium::_mEvictMappings() noexcept
+{
+    while (_mMappedLen > _mMaxMappedLen && _mMappings.size() > 1) {
+        _mMappedLen -= _mMappings.back()->mmap_len;
+        _mMappings.pop_back();
+    }
+}
+
+ctf::src::Buf Medium::buf(const bt2c::DataLen requestedOffsetInStream, const bt2c::DataLen minSize,
+                          const bt2c::DataLen)
 {
     BT_CPPLOGD("buf called: offset-bytes={}, min-size-bytes={}", requestedOffsetInStream.bytes(),
                minSize.bytes());
@@ -472,71 +961,468 @@ ctf::src::Buf Medium::buf(const bt2c::DataLen requestedOffsetInStream, const bt2
      *                  ^--------------------------------^  endOfMappingInFile
      */
     const ctf_fs_ds_index::EntriesT::const_iterator indexEntryIt =
-        this->_mFindIndexEntryForOffset(requestedOffsetInStream);
+        _mIndex.findEntry(requestedOffsetInStream);
     if (indexEntryIt == _mIndex.entries.end()) {
         BT_CPPLOGD("no index entry containing this offset");
         throw NoData();
     }
 
     const ctf_fs_ds_index_entry& indexEntry = *indexEntryIt;
+    const auto fileStartInStream = indexEntry.offsetInStream - indexEntry.offsetInFile;
+    const auto requestedOffsetInFile = requestedOffsetInStream - fileStartInStream;
+    const ctf_fs_ds_file& dsFile = this->_mMapping(indexEntry.path, requestedOffsetInFile, minSize);
+    const auto startOfMappingInFile = bt2c::DataLen::fromBytes(dsFile.mmap_offset_in_file);
+    const auto requestedOffsetInMapping = requestedOffsetInFile - startOfMappingInFile;
+    const auto exclEndOfMappingInFile =
+        startOfMappingInFile + bt2c::DataLen::fromBytes(dsFile.mmap_len);
 
-    _mCurrentDsFile = ctf_fs_ds_file_create(indexEntry.path, _mLogger);
-    if (!_mCurrentDsFile) {
-        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to create ctf_fs_ds_file");
+    const auto bufEndInFile = _mIndex.dataEndInFile(indexEntryIt, exclEndOfMappingInFile);
+    const auto bufLen = bufEndInFile - requestedOffsetInFile;
+    const uint8_t *bufStart =
+        (const uint8_t *) dsFile.mmap_addr + requestedOffsetInMapping.bytes();
+
+    if (bufLen < minSize) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2::Error,
+            "Insufficient data in file to fulfill request: path=\"{}\", requested-offset-in-file-bytes={}, "
+            "remaining-data-len-in-file-bytes={}, min-size-bytes={}",
+            indexEntry.path, requestedOffsetInFile.bytes(), bufLen.bytes(), minSize.bytes());
     }
 
+    ctf::src::Buf buf {bufStart, bufLen};
+
+    BT_CPPLOGD("CtfFsMedium::buf returns: buf-addr={}, buf-size-bytes={}", fmt::ptr(buf.addr()),
+               buf.size().bytes());
+
+    return buf;
+}
+
+ReadMedium::ReadMedium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+                       const size_t chunkLen) :
+    _mIndex(index), _mLogger {parentLogger, "PLUGIN/SRC.CTF.FS/DS-READ-MEDIUM"},
+    _mAlign {bt_mmap_get_offset_align_size(static_cast<int>(_mLogger.level()))},
+    _mChunkLen {mmapMaxLen(chunkLen, _mLogger)},
+
+    /*
+     * A chunk starts at the aligned offset preceding the requested
+     * one: make room for the requested minimum size after it.
+     */
+    _mChunks {_Chunk {_mChunkLen + _mAlign}, _Chunk {_mChunkLen + _mAlign}}
+{
+    BT_ASSERT(!_mIndex.entries.empty());
+}
+
+ReadMedium::~ReadMedium()
+{
+    (void) this->_mWaitPrefetch();
+}
+
+bool ReadMedium::_mChunkContains(const _Chunk& chunk, const char * const path, const off_t offset,
+                                 const off_t endOffset) const noexcept
+{
+    if (chunk.path != path) {
+        return false;
+    }
+
+    const auto exclEnd = chunk.offsetInFile + static_cast<off_t>(chunk.len);
+
+    return offset >= chunk.offsetInFile && offset < exclEnd &&
+           (endOffset <= exclEnd || exclEnd == _mFile->size);
+}
+
+void ReadMedium::_mOpenFile(const char * const path)
+{
+    if (_mFile && _mFile->path == path) {
+        return;
+    }
+
+    /* The prefetch task may be reading the current file. */
+    (void) this->_mWaitPrefetch();
+    _mNextChunk->path = nullptr;
+    _mCurChunk->path = nullptr;
+
+    auto file = bt2s::make_unique<ctf_fs_file>(_mLogger);
+
+    file->path = path;
+    if (ctf_fs_file_open(file.get(), "rb")) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to open data stream file: path=\"{}\"",
+                                          path);
+    }
+
+    _mFile = std::move(file);
+}
+
+ReadMedium::_ReadRes ReadMedium::_mReadAt(std::uint8_t * const dst, const size_t len,
+                                          const off_t offset) const noexcept
+{
+    const auto fd = fileno(_mFile->fp.get());
+    size_t readLen = 0;
+
+    while (readLen < len) {
+#ifdef __MINGW32__
+        /*
+         * No pread() on Windows: this is safe because there's no
+         * prefetch task on this platform (see _mStartPrefetch()).
+         */
+        if (_lseeki64(fd, offset + static_cast<off_t>(readLen), SEEK_SET) < 0) {
+            return {readLen, errno};
+        }
+
+        const auto ret = read(fd, dst + readLen, static_cast<unsigned int>(len - readLen));
+#else
+        const auto ret = pread(fd, dst + readLen, len - readLen, offset + static_cast<off_t>(readLen));
+#endif
+
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return {readLen, errno};
+        } else if (ret == 0) {
+            /* End of file */
+            break;
+        }
+
+        readLen += static_cast<size_t>(ret);
+    }
+
+    return {readLen, 0};
+}
+
+void ReadMedium::_mFill(const char * const path, const off_t offset, const size_t minLen)
+{
+    auto& chunk = *_mCurChunk;
+    const auto alignedOffset = offset - offset % static_cast<off_t>(_mAlign);
+    const auto len = std::min(std::max(_mChunkLen, static_cast<size_t>(offset - alignedOffset) + minLen),
+                              static_cast<size_t>(_mFile->size - alignedOffset));
+
+    chunk.path = nullptr;
+
+    if (len > chunk.data.size()) {
+        /*
+         * The requested minimum size doesn't fit the regular chunk
+         * size (large fixed-length field, for example): grow this
+         * chunk. No prefetch task writes to the current chunk.
+         */
+        BT_CPPLOGD("Growing data stream file chunk: path=\"{}\", old-capacity={}, new-capacity={}",
+                   _mFile->path, chunk.data.size(), len);
+        chunk.data.resize(len);
+    }
+
+    const auto res = this->_mReadAt(chunk.data.data(), len, alignedOffset);
+
+    if (res.err != 0) {
+        errno = res.err;
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to read data stream file",
+                                                ": path=\"{}\", offset={}, len={}", _mFile->path,
+                                                (intmax_t) alignedOffset, len);
+    }
+
+    BT_CPPLOGD("Read data stream file chunk: path=\"{}\", offset={}, len={}", _mFile->path,
+               (intmax_t) alignedOffset, res.len);
+    chunk.path = path;
+    chunk.offsetInFile = alignedOffset;
+    chunk.len = res.len;
+}
+
+void ReadMedium::_mStartPrefetch()
+{
+#ifndef __MINGW32__
+    BT_ASSERT_DBG(!_mPrefetch.valid());
+
+    const auto& curChunk = *_mCurChunk;
+    const auto offset = curChunk.offsetInFile + static_cast<off_t>(curChunk.len);
+
+    if (offset >= _mFile->size) {
+        /* Nothing to read ahead within this file */
+        return;
+    }
+
+    auto& nextChunk = *_mNextChunk;
+    const auto len = std::min(_mChunkLen, static_cast<size_t>(_mFile->size - offset));
+
+    nextChunk.path = curChunk.path;
+    nextChunk.offsetInFile = offset;
+    nextChunk.len = 0;
+    _mPrefetch = std::async(std::launch::async, [this, &nextChunk, len, offset] {
+        return this->_mReadAt(nextChunk.data.data(), len, offset);
+    });
+#endif
+}
+
+bool ReadMedium::_mWaitPrefetch() noexcept
+{
+    if (!_mPrefetch.valid()) {
+        return false;
+    }
+
+    const auto res = _mPrefetch.get();
+
+    if (res.err != 0) {
+        /* Let a synchronous read report the error, if any. */
+        BT_CPPLOGD("Failed to prefetch data stream file chunk: path=\"{}\", offset={}, err={}",
+                   _mFile->path, (intmax_t) _mNextChunk->offsetInFile, res.err);
+        _mNextChunk->path = nullptr;
+        return false;
+    }
+
+    _mNextChunk->len = res.len;
+    return true;
+}
+
+ctf::src::Buf ReadMedium::buf(const bt2c::DataLen requestedOffsetInStream,
+                              const bt2c::DataLen minSize, const bt2c::DataLen)
+{
+    BT_CPPLOGD("buf called: offset-bytes={}, min-size-bytes={}", requestedOffsetInStream.bytes(),
+               minSize.bytes());
+
+    /* The medium only gets asked about whole byte offsets and min sizes. */
+    BT_ASSERT_DBG(requestedOffsetInStream.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
+
+    const ctf_fs_ds_index::EntriesT::const_iterator indexEntryIt =
+        _mIndex.findEntry(requestedOffsetInStream);
+    if (indexEntryIt == _mIndex.entries.end()) {
+        BT_CPPLOGD("no index entry containing this offset");
+        throw NoData();
+    }
+
+    const ctf_fs_ds_index_entry& indexEntry = *indexEntryIt;
     const auto fileStartInStream = indexEntry.offsetInStream - indexEntry.offsetInFile;
     const auto requestedOffsetInFile = requestedOffsetInStream - fileStartInStream;
+    const auto offset = static_cast<off_t>(requestedOffsetInFile.bytes());
+    const auto endOffset = static_cast<off_t>((requestedOffsetInFile + minSize).bytes());
+
+    this->_mOpenFile(indexEntry.path);
+
+    if (!this->_mChunkContains(*_mCurChunk, indexEntry.path, offset, endOffset)) {
+        if (this->_mWaitPrefetch() &&
+            this->_mChunkContains(*_mNextChunk, indexEntry.path, offset, endOffset)) {
+            /* Prefetch hit */
+            std::swap(_mCurChunk, _mNextChunk);
+        } else {
+            this->_mFill(indexEntry.path, offset, minSize.bytes());
+        }
 
-    ds_file_status status = ds_file_mmap(_mCurrentDsFile.get(), requestedOffsetInFile.bytes());
-    if (status != DS_FILE_STATUS_OK) {
-        throw bt2::Error("Failed to mmap file");
+        this->_mStartPrefetch();
     }
 
-    const auto startOfMappingInFile =
-        bt2c::DataLen::fromBytes(_mCurrentDsFile->mmap_offset_in_file);
-    const auto requestedOffsetInMapping = requestedOffsetInFile - startOfMappingInFile;
-    const auto exclEndOfMappingInFile =
-        startOfMappingInFile + bt2c::DataLen::fromBytes(_mCurrentDsFile->mmap_len);
+    const auto& chunk = *_mCurChunk;
+    const auto startOfChunkInFile = bt2c::DataLen::fromBytes(chunk.offsetInFile);
+    const auto bufEndInFile = _mIndex.dataEndInFile(
+        indexEntryIt, startOfChunkInFile + bt2c::DataLen::fromBytes(chunk.len));
+    const auto bufLen = bufEndInFile - requestedOffsetInFile;
+
+    if (bufLen < minSize) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2::Error,
+            "Insufficient data in file to fulfill request: path=\"{}\", requested-offset-in-file-bytes={}, "
+            "remaining-data-len-in-file-bytes={}, min-size-bytes={}",
+            indexEntry.path, requestedOffsetInFile.bytes(), bufLen.bytes(), minSize.bytes());
+    }
+
+    ctf::src::Buf buf {chunk.data.data() + (requestedOffsetInFile - startOfChunkInFile).bytes(),
+                       bufLen};
+
+    BT_CPPLOGD("ReadMedium::buf returns: buf-addr={}, buf-size-bytes={}", fmt::ptr(buf.addr()),
+               buf.size().bytes());
+    return buf;
+}
+
+#ifdef BT_HAVE_ZSTD
+ZstdMedium::ZstdMedium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+                       const size_t windowLen) :
+    _mIndex(index),
+    _mLogger {parentLogger, "PLUGIN/SRC.CTF.FS/DS-ZSTD-MEDIUM"}, _mDctx {ZSTD_createDCtx()},
+    _mInBuf(ZSTD_DStreamInSize()), _mWindow(mmapMaxLen(windowLen, _mLogger))
+{
+    BT_ASSERT(!_mIndex.entries.empty());
+
+    if (!_mDctx) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to create zstd decompression context.");
+    }
+}
+
+ZstdMedium::~ZstdMedium()
+{
+    ZSTD_freeDCtx(_mDctx);
+}
+
+void ZstdMedium::_mOpenFile(const ctf_fs_ds_file_info& fileInfo)
+{
+    if (_mFileInfo == &fileInfo) {
+        return;
+    }
+
+    auto file = bt2s::make_unique<ctf_fs_file>(_mLogger);
+
+    file->path = fileInfo.path();
+    if (ctf_fs_file_open(file.get(), "rb")) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2::Error, "Failed to open data stream file: path=\"{}\"",
+                                          fileInfo.path());
+    }
+
+    const auto& frames = fileInfo.zstdFrames();
+
+    _mFile = std::move(file);
+    _mFileInfo = &fileInfo;
+    _mCompressedEnd =
+        frames.empty() ? 0 : frames.back().offsetInFile + frames.back().compressedSize;
+    _mIsStarted = false;
+    _mWindowDataLen = 0;
+}
+
+void ZstdMedium::_mRestart(const ctf_fs_ds_zstd_frame& frame)
+{
+    const auto ret = ZSTD_initDStream(_mDctx);
+
+    if (ZSTD_isError(ret)) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2::Error, "Failed to reset zstd decompression context: error=\"{}\"",
+            ZSTD_getErrorName(ret));
+    }
+
+    BT_CPPLOGD("Restarting decompression: path=\"{}\", offset-in-file={}, offset={}",
+               _mFile->path, frame.offsetInFile, frame.offset);
+    _mInLen = 0;
+    _mInPos = 0;
+    _mInOffset = frame.offsetInFile;
+    _mWindowOffset = frame.offset;
+    _mWindowDataLen = 0;
+    _mIsStarted = true;
+}
+
+void ZstdMedium::_mDecompressMore()
+{
+    BT_ASSERT_DBG(_mWindowDataLen < _mWindow.size());
+
+    if (_mInPos == _mInLen) {
+        if (_mInOffset == _mCompressedEnd) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2::Error,
+                "Unexpected end of compressed data: path=\"{}\", decompressed-offset={}",
+                _mFile->path, _mWindowOffset + _mWindowDataLen);
+        }
+
+        _mInLen = std::min<uint64_t>(_mInBuf.size(), _mCompressedEnd - _mInOffset);
+        readFileRange(*_mFile, static_cast<off_t>(_mInOffset), _mInBuf.data(), _mInLen);
+        _mInPos = 0;
+        _mInOffset += _mInLen;
+    }
+
+    ZSTD_inBuffer in {_mInBuf.data(), _mInLen, _mInPos};
+    ZSTD_outBuffer out {_mWindow.data() + _mWindowDataLen, _mWindow.size() - _mWindowDataLen, 0};
+    const auto ret = ZSTD_decompressStream(_mDctx, &out, &in);
+
+    if (ZSTD_isError(ret)) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2::Error,
+            "Failed to decompress data stream file: path=\"{}\", offset-in-file={}, "
+            "error=\"{}\"",
+            _mFile->path, _mInOffset - _mInLen + in.pos, ZSTD_getErrorName(ret));
+    }
+
+    _mInPos = in.pos;
+    _mWindowDataLen += out.pos;
+}
+
+void ZstdMedium::_mFill(const uint64_t offset, uint64_t endOffset)
+{
+    const auto& frames = _mFileInfo->zstdFrames();
+
+    endOffset = std::min<uint64_t>(endOffset, _mFileInfo->size().bytes());
+
+    /* Last frame beginning at or before `offset` */
+    const auto frameIt = std::partition_point(frames.begin(), frames.end(),
+                                              [offset](const ctf_fs_ds_zstd_frame& frame) {
+                                                  return frame.offset <= offset;
+                                              });
+
+    BT_ASSERT(frameIt != frames.begin());
 
     /*
-     * Find where to end the mapping.  We can map the following entries as long as
-     *
-     *  1) there are following entries
-     *  2) they are located in the same file as our starting entry
-     *  3) they are (at least partially) within the mapping
+     * Continue the current decompression, unless `offset` is behind
+     * it or a frame beginning is closer.
      */
+    const auto& frame = *(frameIt - 1);
+
+    if (!_mIsStarted || offset < _mWindowOffset ||
+        frame.offset > _mWindowOffset + _mWindowDataLen) {
+        this->_mRestart(frame);
+    }
 
-    ctf_fs_ds_index::EntriesT::const_iterator endIndexEntryIt = indexEntryIt;
     while (true) {
-        ctf_fs_ds_index::EntriesT::const_iterator nextIndexEntryIt = endIndexEntryIt + 1;
+        /* Drop the data preceding `offset` */
+        if (_mWindowOffset < offset) {
+            const auto dropLen = std::min<uint64_t>(offset - _mWindowOffset, _mWindowDataLen);
 
-        if (nextIndexEntryIt == _mIndex.entries.end()) {
-            break;
+            memmove(_mWindow.data(), _mWindow.data() + dropLen, _mWindowDataLen - dropLen);
+            _mWindowOffset += dropLen;
+            _mWindowDataLen -= dropLen;
         }
 
-        if (nextIndexEntryIt->path != indexEntryIt->path) {
+        if (_mWindowOffset == offset && _mWindowDataLen > 0 &&
+            _mWindowOffset + _mWindowDataLen >= endOffset) {
             break;
         }
 
-        if (nextIndexEntryIt->offsetInFile >= exclEndOfMappingInFile) {
-            break;
+        if (_mWindowDataLen == _mWindow.size()) {
+            /* Make room for the whole requested range */
+            _mWindow.resize(std::max<uint64_t>(_mWindow.size() * 2, endOffset - offset));
         }
 
-        endIndexEntryIt = nextIndexEntryIt;
+        this->_mDecompressMore();
     }
+}
 
-    /*
-     * It's possible the mapping ends in the middle of our end entry.  Choose
-     * the end of the mapping or the end of the end entry, whichever comes
-     * first, as the end of the returned buffer.
-     */
-    const auto exclEndOfEndEntryInFile =
-        endIndexEntryIt->offsetInFile + endIndexEntryIt->packetSize;
-    const auto bufEndInFile = std::min(exclEndOfMappingInFile, exclEndOfEndEntryInFile);
+ctf::src::Buf ZstdMedium::buf(const bt2c::DataLen requestedOffsetInStream,
+                              const bt2c::DataLen minSize, const bt2c::DataLen)
+{
+    BT_CPPLOGD("buf called: offset-bytes={}, min-size-bytes={}", requestedOffsetInStream.bytes(),
+               minSize.bytes());
+
+    /* The medium only gets asked about whole byte offsets and min sizes. */
+    BT_ASSERT_DBG(requestedOffsetInStream.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
+
+    const ctf_fs_ds_index::EntriesT::const_iterator indexEntryIt =
+        _mIndex.findEntry(requestedOffsetInStream);
+    if (indexEntryIt == _mIndex.entries.end()) {
+        BT_CPPLOGD("no index entry containing this offset");
+        throw NoData();
+    }
+
+    const ctf_fs_ds_index_entry& indexEntry = *indexEntryIt;
+
+    if (!indexEntry.fileInfo->isCompressed()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2::Error,
+            "Cannot read both compressed and regular data stream files as a single stream: "
+            "path=\"{}\"",
+            indexEntry.path);
+    }
+
+    const auto fileStartInStream = indexEntry.offsetInStream - indexEntry.offsetInFile;
+    const auto requestedOffsetInFile = requestedOffsetInStream - fileStartInStream;
+    const auto offset = requestedOffsetInFile.bytes();
+    const auto endOffset = (requestedOffsetInFile + minSize).bytes();
+
+    this->_mOpenFile(*indexEntry.fileInfo);
+
+    {
+        const auto windowEnd = _mWindowOffset + _mWindowDataLen;
+
+        if (!_mIsStarted || offset < _mWindowOffset || offset >= windowEnd ||
+            (endOffset > windowEnd && windowEnd != _mFileInfo->size().bytes())) {
+            this->_mFill(offset, endOffset);
+        }
+    }
+
+    const auto startOfWindowInFile = bt2c::DataLen::fromBytes(_mWindowOffset);
+    const auto bufEndInFile = _mIndex.dataEndInFile(
+        indexEntryIt, startOfWindowInFile + bt2c::DataLen::fromBytes(_mWindowDataLen));
     const auto bufLen = bufEndInFile - requestedOffsetInFile;
-    const uint8_t *bufStart =
-        (const uint8_t *) _mCurrentDsFile->mmap_addr + requestedOffsetInMapping.bytes();
 
     if (bufLen < minSize) {
         BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
@@ -546,29 +1432,104 @@ ctf::src::Buf Medium::buf(const bt2c::DataLen requestedOffsetInStream, const bt2
             indexEntry.path, requestedOffsetInFile.bytes(), bufLen.bytes(), minSize.bytes());
     }
 
-    ctf::src::Buf buf {bufStart, bufLen};
+    ctf::src::Buf buf {_mWindow.data() + (requestedOffsetInFile - startOfWindowInFile).bytes(),
+                       bufLen};
 
-    BT_CPPLOGD("CtfFsMedium::buf returns: buf-addr={}, buf-size-bytes={}\n", fmt::ptr(buf.addr()),
+    BT_CPPLOGD("ZstdMedium::buf returns: buf-addr={}, buf-size-bytes={}", fmt::ptr(buf.addr()),
                buf.size().bytes());
+    return buf;
+}
+#endif /* BT_HAVE_ZSTD */
+
+SliceMedium::SliceMedium(ctf::src::Medium::UP medium, const bt2c::DataLen begin,
+                         const bt2s::optional<bt2c::DataLen> end) noexcept :
+    _mMedium {std::move(medium)},
+    _mBegin {begin}, _mEnd {end}
+{
+}
+
+ctf::src::Buf SliceMedium::buf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                               const bt2c::DataLen prefSize)
+{
+    const auto offsetInMedium = _mBegin + offset;
+
+    if (!_mEnd) {
+        return _mMedium->buf(offsetInMedium, minSize, prefSize);
+    }
+
+    if (offsetInMedium >= *_mEnd) {
+        throw ctf::src::NoData {};
+    }
+
+    const auto buf = _mMedium->buf(offsetInMedium, minSize,
+                                   std::max(minSize, std::min(prefSize, *_mEnd - offsetInMedium)));
+
+    if (offsetInMedium + buf.size() > *_mEnd) {
+        return ctf::src::Buf {buf.addr(), *_mEnd - offsetInMedium};
+    }
 
     return buf;
 }
 
+ctf::src::Medium::UP createMedium(const ReadMode readMode, const ctf_fs_ds_index& index,
+                                  const size_t windowLen, const bt2c::Logger& parentLogger)
+{
+    BT_ASSERT(!index.entries.empty());
+
+    if (index.entries.front().fileInfo->isCompressed()) {
+#ifdef BT_HAVE_ZSTD
+        return bt2s::make_unique<ZstdMedium>(index, parentLogger, windowLen);
+#else
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            parentLogger, bt2::Error,
+            "Cannot read compressed data stream file: Babeltrace was built without zstd support: "
+            "path=\"{}\"",
+            index.entries.front().path);
+#endif
+    }
+
+    if (readMode == ReadMode::Pread) {
+        return bt2s::make_unique<ReadMedium>(index, parentLogger, windowLen);
+    }
+
+    return bt2s::make_unique<Medium>(index, parentLogger, windowLen,
+                                     readMode == ReadMode::MmapPrefault);
+}
+
 } /* namespace fs */
 } /* namespace src */
 } /* namespace ctf */
 
 bt2s::optional<ctf_fs_ds_index> ctf_fs_ds_file_build_index(const ctf_fs_ds_file_info& fileInfo,
-                                                           const ctf::src::TraceCls& traceCls)
+                                                           const ctf::src::TraceCls& traceCls,
+                                                           const bool useIndexCache)
 {
-    auto index = build_index_from_idx_file(fileInfo, traceCls);
+    auto index = ctf_fs_ds_index_mem_cache_get(fileInfo);
     if (index) {
         return index;
     }
 
-    BT_CPPLOGI_SPEC(fileInfo.logger(), "Failed to build index from .index file; "
-                                       "falling back to stream indexing.");
-    return build_index_from_stream_file(fileInfo, traceCls);
+    index = build_index_from_idx_file(fileInfo, traceCls);
+
+    if (!index && useIndexCache) {
+        index = ctf_fs_ds_index_cache_read(fileInfo);
+    }
+
+    if (!index) {
+        BT_CPPLOGI_SPEC(fileInfo.logger(), "Failed to build index from .index file; "
+                                           "falling back to stream indexing.");
+        index = build_index_from_stream_file(fileInfo, traceCls);
+
+        if (index && useIndexCache) {
+            ctf_fs_ds_index_cache_write(fileInfo, *index);
+        }
+    }
+
+    if (index) {
+        ctf_fs_ds_index_mem_cache_put(fileInfo, *index);
+    }
+
+    return index;
 }
 
 ctf_fs_ds_file::~ctf_fs_ds_file()
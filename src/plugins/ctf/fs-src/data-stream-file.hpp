@@ -7,6 +7,9 @@
 #ifndef BABELTRACE_PLUGINS_CTF_FS_SRC_DATA_STREAM_FILE_HPP
 #define BABELTRACE_PLUGINS_CTF_FS_SRC_DATA_STREAM_FILE_HPP
 
+#include <cstdint>
+#include <future>
+#include <list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -19,11 +22,46 @@
 #include "cpp-common/bt2/trace-ir.hpp"
 #include "cpp-common/bt2c/data-len.hpp"
 #include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/optional.hpp"
 
 #include "../common/src/item-seq/medium.hpp"
 #include "../common/src/metadata/ctf-ir.hpp"
 #include "file.hpp"
 
+/*
+ * Frame of a compressed data stream file.
+ *
+ * Decompression may start at the beginning of any frame, so that the
+ * frames of a file are the checkpoints from which to seek within its
+ * decompressed data.
+ */
+struct ctf_fs_ds_zstd_frame
+{
+    /* Offset and size (bytes) of the compressed frame in the file. */
+    uint64_t offsetInFile;
+    uint64_t compressedSize;
+
+    /* Offset and size (bytes) of the decompressed frame. */
+    uint64_t offset;
+    uint64_t size;
+};
+
+/*
+ * Returns the frames of the opened data stream file `file`, or
+ * `bt2s::nullopt` if it's not a compressed data stream file.
+ *
+ * A compressed data stream file is either:
+ *
+ * • A file written by a `sink.ctf.fs` component with its
+ *   `compression-level` parameter, of which the seek table contains
+ *   the frames (see `ctfser/zstd-seek-table.h`).
+ *
+ * • Any zstd-compressed file (for example, the output of the `zstd`
+ *   command), of which this function finds the frames with a first
+ *   decompression pass.
+ */
+bt2s::optional<std::vector<ctf_fs_ds_zstd_frame>> ctf_fs_ds_file_read_zstd_frames(ctf_fs_file& file);
+
 struct ctf_fs_ds_file_info
 {
     using UP = std::unique_ptr<ctf_fs_ds_file_info>;
@@ -40,15 +78,36 @@ struct ctf_fs_ds_file_info
         return _mPath;
     }
 
+    /*
+     * Size of the data of the file: for a compressed data stream file,
+     * this is the total size of its decompressed frames.
+     */
     bt2c::DataLen size() const noexcept
     {
         return _mSize;
     }
 
+    /* Whether or not this is a compressed data stream file. */
+    bool isCompressed() const noexcept
+    {
+        return _mIsCompressed;
+    }
+
+    /*
+     * Frames of this compressed data stream file, sorted by offset
+     * (empty if not compressed).
+     */
+    const std::vector<ctf_fs_ds_zstd_frame>& zstdFrames() const noexcept
+    {
+        return _mZstdFrames;
+    }
+
 private:
     bt2c::Logger _mLogger;
     std::string _mPath;
     bt2c::DataLen _mSize;
+    bool _mIsCompressed = false;
+    std::vector<ctf_fs_ds_zstd_frame> _mZstdFrames;
 };
 
 struct ctf_fs_ds_file
@@ -66,7 +125,8 @@ struct ctf_fs_ds_file
 
     bt2c::Logger logger;
 
-    ctf_fs_file::UP file;
+    /* Shared between the mappings of the same file of a medium. */
+    std::shared_ptr<ctf_fs_file> file;
 
     void *mmap_addr = nullptr;
 
@@ -85,9 +145,11 @@ struct ctf_fs_ds_file
 
 struct ctf_fs_ds_index_entry
 {
-    ctf_fs_ds_index_entry(const bt2c::CStringView pathParam, const bt2c::DataLen offsetInFileParam,
+    ctf_fs_ds_index_entry(const ctf_fs_ds_file_info& fileInfoParam,
+                          const bt2c::DataLen offsetInFileParam,
                           const bt2c::DataLen packetSizeParam) :
-        path {pathParam}, offsetInFile {offsetInFileParam}, offsetInStream {offsetInFileParam},
+        path {fileInfoParam.path().c_str()}, fileInfo {&fileInfoParam},
+        offsetInFile {offsetInFileParam}, offsetInStream {offsetInFileParam},
         packetSize {packetSizeParam}
     {
         BT_ASSERT(path);
@@ -96,6 +158,14 @@ struct ctf_fs_ds_index_entry
     /* Weak, belongs to ctf_fs_ds_file_info. */
     const char *path;
 
+    /*
+     * Info of the file `path` (weak).
+     *
+     * If it's a compressed data stream file, then `offsetInFile` is an
+     * offset within its decompressed data.
+     */
+    const ctf_fs_ds_file_info *fileInfo;
+
     /* Position of the packet from the beginning of the file. */
     bt2c::DataLen offsetInFile;
 
@@ -115,6 +185,24 @@ struct ctf_fs_ds_index_entry
      */
     uint64_t timestamp_begin = 0, timestamp_end = 0;
 
+    /*
+     * Pending tracer bug fixups of `timestamp_begin` and
+     * `timestamp_end` (see fix_ds_file_group_index_tracer_bugs()).
+     *
+     * Applying the first and the last ones requires decoding the
+     * packet, so they only happen the first time some code needs the
+     * timestamps: call ctf_fs_ds_file_group_fix_index_entry_timestamps()
+     * before reading them.
+     */
+    bool beginIsFirstEventTs = false;
+    bool endIsNextBeginTs = false;
+    bool endIsLastEventTs = false;
+
+    bool timestampsArePending() const noexcept
+    {
+        return beginIsFirstEventTs || endIsNextBeginTs || endIsLastEventTs;
+    }
+
     /*
      * Packet sequence number, or UINT64_MAX if not present in the index.
      */
@@ -127,6 +215,19 @@ struct ctf_fs_ds_index
 
     EntriesT entries;
 
+    /*
+     * Returns the entry of the packet containing `offsetInStream`, or
+     * `entries.end()` if there's none.
+     */
+    EntriesT::const_iterator findEntry(bt2c::DataLen offsetInStream) const noexcept;
+
+    /*
+     * Returns the end offset, in the file of `*entryIt`, of the packet
+     * data of this file from `*entryIt` until at most `exclEndInFile`.
+     */
+    bt2c::DataLen dataEndInFile(EntriesT::const_iterator entryIt,
+                                bt2c::DataLen exclEndInFile) const noexcept;
+
     void updateOffsetsInStream();
 };
 
@@ -170,12 +271,36 @@ struct ctf_fs_ds_file_group
     struct ctf_fs_trace *ctf_fs_trace = nullptr;
 
     ctf_fs_ds_index index;
+
+    /*
+     * Whether or not `index` is built.
+     *
+     * In lazy index mode, the first message iterator of this group
+     * builds `index` and the last one releases it.
+     */
+    bool indexBuilt = true;
+
+    /* Number of message iterators using `index` */
+    unsigned int indexUserCount = 0;
 };
 
-ctf_fs_ds_file::UP ctf_fs_ds_file_create(const char *path, const bt2c::Logger& parentLogger);
+ctf_fs_ds_file::UP ctf_fs_ds_file_create(const char *path, size_t mmapMaxLen,
+                                         const bt2c::Logger& parentLogger);
 
+/*
+ * Builds the index of the data stream file `file_info`.
+ *
+ * If `useIndexCache` is true, then this function reads the index cache
+ * file of `file_info` when there's no LTTng index file, and writes it
+ * after indexing the data stream file packet by packet (see
+ * `index-cache.hpp`).
+ *
+ * In any case, this function first looks for the index of `file_info`
+ * in the in-memory index cache, and adds the index it builds to it.
+ */
 bt2s::optional<ctf_fs_ds_index> ctf_fs_ds_file_build_index(const ctf_fs_ds_file_info& file_info,
-                                                           const ctf::src::TraceCls& traceCls);
+                                                           const ctf::src::TraceCls& traceCls,
+                                                           bool useIndexCache);
 
 namespace ctf {
 namespace src {
@@ -183,23 +308,310 @@ namespace fs {
 
 struct Medium : public ctf::src::Medium
 {
-    explicit Medium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger);
+    /*
+     * `mmapMaxLen` is the maximum length of a single mapping (window)
+     * of a data stream file, rounded up to the mapping offset
+     * alignment, or 0 to use the default length.
+     *
+     * If `prefault` is true, then the medium populates the page tables
+     * of each mapping when creating it (`MAP_POPULATE`), and maps the
+     * window which follows the most recent one in a background task, so
+     * that the decoder doesn't stall on page faults.
+     */
+    explicit Medium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+                    size_t mmapMaxLen = 0, bool prefault = false);
 
     ~Medium() = default;
     Medium(const Medium&) = delete;
     Medium& operator=(const Medium&) = delete;
 
-    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize) override;
+    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
 
 private:
-    ctf_fs_ds_index::EntriesT::const_iterator
-    _mFindIndexEntryForOffset(bt2c::DataLen offsetInStream) const noexcept;
+    /*
+     * Returns a mapping of the file `path` which contains the range
+     * [`offsetInFile`, `offsetInFile` + `minSize`[, or which contains
+     * `offsetInFile` and reaches the end of the file, making it the most
+     * recently used one.
+     */
+    ctf_fs_ds_file& _mMapping(const char *path, bt2c::DataLen offsetInFile, bt2c::DataLen minSize);
+
+    /*
+     * Removes the least recently used mappings, but the most recently
+     * used one, until the total length of the mappings is at most
+     * `_mMaxMappedLen`.
+     */
+    void _mEvictMappings() noexcept;
+
+    /*
+     * Hints the kernel that the decoder is about to read the mapping
+     * `dsFile` sequentially, and then the window following it.
+     */
+    void _mAdviseReadahead(const ctf_fs_ds_file& dsFile) const noexcept;
+
+    /*
+     * Starts mapping, in the background, the window of the file of
+     * `dsFile` which follows the mapping `dsFile`.
+     */
+    void _mStartNextMapping(const ctf_fs_ds_file& dsFile);
+
+    /*
+     * Waits for the background mapping, if any, and returns it if it
+     * satisfies the _mMapping() request (`path`, `offset`,
+     * `endOffset`), or `nullptr` otherwise.
+     */
+    ctf_fs_ds_file::UP _mTakeNextMapping(const char *path, off_t offset, off_t endOffset);
 
     const ctf_fs_ds_index& _mIndex;
     bt2c::Logger _mLogger;
-    ctf_fs_ds_file::UP _mCurrentDsFile;
+
+    /*
+     * Cached mappings, most recently used first.
+     *
+     * The mappings of the same file share its `ctf_fs_file` object,
+     * so that a file remains open as long as one of its mappings is
+     * cached.
+     */
+    std::list<ctf_fs_ds_file::UP> _mMappings;
+
+    /* Maximum length of a single mapping. */
+    size_t _mMmapMaxLen;
+
+    /* Total length of the mappings of `_mMappings`. */
+    size_t _mMappedLen = 0;
+
+    /* Budget of `_mMappedLen`. */
+    size_t _mMaxMappedLen;
+
+    /* True to prefault the mappings (see the constructor) */
+    bool _mPrefault;
+
+    /*
+     * Background mapping of the window following the most recent
+     * mapping (`nullptr` result on failure), if valid.
+     */
+    std::future<ctf_fs_ds_file::UP> _mNextMapping;
 };
 
+/*
+ * Medium which reads the data stream files with large, aligned pread()
+ * calls into two buffers instead of memory-mapping them.
+ *
+ * While the decoder reads one buffer, a background task reads the
+ * following chunk of the same file into the other one, so that the
+ * latency of slow storage (network file systems, FUSE) overlaps with
+ * decoding instead of stalling it on page faults.
+ */
+struct ReadMedium : public ctf::src::Medium
+{
+    /*
+     * `chunkLen` is the length of a single read, rounded up to the
+     * mapping offset alignment, or 0 to use the default length.
+     */
+    explicit ReadMedium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+                        size_t chunkLen = 0);
+
+    ~ReadMedium();
+    ReadMedium(const ReadMedium&) = delete;
+    ReadMedium& operator=(const ReadMedium&) = delete;
+
+    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+
+private:
+    struct _Chunk
+    {
+        explicit _Chunk(const size_t capacity) : data(capacity)
+        {
+        }
+
+        std::vector<std::uint8_t> data;
+
+        /* File path (weak, belongs to ctf_fs_ds_file_info), or `nullptr` if empty. */
+        const char *path = nullptr;
+
+        /* Offset of `data` in the file. */
+        off_t offsetInFile = 0;
+
+        /* Number of valid bytes of `data`. */
+        size_t len = 0;
+    };
+
+    /* Result of _mReadAt(): read length, or `errno` value on error. */
+    struct _ReadRes
+    {
+        size_t len;
+        int err;
+    };
+
+    /*
+     * Returns whether or not `chunk` contains the range [`offset`,
+     * `endOffset`[ of the file `path`, or contains `offset` and reaches
+     * the end of the file.
+     */
+    bool _mChunkContains(const _Chunk& chunk, const char *path, off_t offset,
+                         off_t endOffset) const noexcept;
+
+    /* Makes `path` the current file, opening it if needed. */
+    void _mOpenFile(const char *path);
+
+    /* Reads at most `len` bytes from `offset` of the current file into `dst`. */
+    _ReadRes _mReadAt(std::uint8_t *dst, size_t len, off_t offset) const noexcept;
+
+    /*
+     * Fills `*_mCurChunk` with the chunk of the current file, of which
+     * the path is `path`, containing `offset`.
+     */
+    void _mFill(const char *path, off_t offset, size_t minLen);
+
+    /* Starts reading the chunk following `*_mCurChunk` into `*_mNextChunk`. */
+    void _mStartPrefetch();
+
+    /*
+     * Waits for the prefetch task to complete, returning whether or not
+     * it succeeded.
+     */
+    bool _mWaitPrefetch() noexcept;
+
+    const ctf_fs_ds_index& _mIndex;
+    bt2c::Logger _mLogger;
+    size_t _mAlign;
+    size_t _mChunkLen;
+    ctf_fs_file::UP _mFile;
+    _Chunk _mChunks[2];
+    _Chunk *_mCurChunk = &_mChunks[0];
+    _Chunk *_mNextChunk = &_mChunks[1];
+
+    /* Prefetch task filling `*_mNextChunk`, if valid. */
+    std::future<_ReadRes> _mPrefetch;
+};
+
+#ifdef BT_HAVE_ZSTD
+/*
+ * Medium which streams the decompression of compressed data stream
+ * files (see ctf_fs_ds_file_read_zstd_frames()) into a reusable window
+ * buffer.
+ *
+ * The offsets of the index entries are offsets within the decompressed
+ * data. Reading forward continues the current decompression; reading
+ * backward, or far enough forward, restarts the decompression at the
+ * beginning of the last frame preceding the requested offset, so that
+ * this medium only decompresses the data from a single frame
+ * beginning, instead of from the beginning of the file.
+ */
+struct ZstdMedium : public ctf::src::Medium
+{
+    /*
+     * `windowLen` is the initial length of the window buffer, rounded
+     * up to the mapping offset alignment, or 0 to use the default
+     * length.
+     */
+    explicit ZstdMedium(const ctf_fs_ds_index& index, const bt2c::Logger& parentLogger,
+                        size_t windowLen = 0);
+
+    ~ZstdMedium();
+    ZstdMedium(const ZstdMedium&) = delete;
+    ZstdMedium& operator=(const ZstdMedium&) = delete;
+
+    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+
+private:
+    /* Makes the file of `fileInfo` the current file, opening it if needed. */
+    void _mOpenFile(const ctf_fs_ds_file_info& fileInfo);
+
+    /* Restarts the decompression at the beginning of `frame`. */
+    void _mRestart(const ctf_fs_ds_zstd_frame& frame);
+
+    /* Decompresses more data of the current file after the window data. */
+    void _mDecompressMore();
+
+    /*
+     * Makes the window contain the range [`offset`, `endOffset`[ of
+     * the decompressed data of the current file, or `offset` and the
+     * remaining data of the file, starting at the beginning of the
+     * window.
+     */
+    void _mFill(uint64_t offset, uint64_t endOffset);
+
+    const ctf_fs_ds_index& _mIndex;
+    bt2c::Logger _mLogger;
+    ctf_fs_file::UP _mFile;
+
+    /* Info of the current file (weak), or `nullptr` if none. */
+    const ctf_fs_ds_file_info *_mFileInfo = nullptr;
+
+    /* Offset, in the current file, of the end of its compressed data. */
+    uint64_t _mCompressedEnd = 0;
+
+    /* Decompression context (owned by this). */
+    struct ZSTD_DCtx_s *_mDctx;
+
+    /*
+     * Compressed data of the current file: `_mInBuf` contains
+     * `_mInLen` bytes, of which the decompressor consumed the first
+     * `_mInPos` ones, and `_mInOffset` is the offset, in the file, of
+     * the byte following them.
+     */
+    std::vector<std::uint8_t> _mInBuf;
+    size_t _mInLen = 0;
+    size_t _mInPos = 0;
+    uint64_t _mInOffset = 0;
+
+    /*
+     * Window buffer: `_mWindowDataLen` bytes of decompressed data at
+     * the decompressed offset `_mWindowOffset`, the next byte from the
+     * decompressor being the one at
+     * `_mWindowOffset + _mWindowDataLen`.
+     */
+    std::vector<std::uint8_t> _mWindow;
+    size_t _mWindowDataLen = 0;
+    uint64_t _mWindowOffset = 0;
+
+    /* Whether or not there's an ongoing decompression. */
+    bool _mIsStarted = false;
+};
+#endif /* BT_HAVE_ZSTD */
+
+/*
+ * Medium which makes the offset `begin` of another medium its own
+ * offset 0, so that a message iterator may start decoding a data stream
+ * at some packet instead of at its beginning.
+ *
+ * If `end` is set, then the data of this medium ends at the offset
+ * `end` of the other medium.
+ */
+struct SliceMedium : public ctf::src::Medium
+{
+    explicit SliceMedium(ctf::src::Medium::UP medium, bt2c::DataLen begin,
+                         bt2s::optional<bt2c::DataLen> end = bt2s::nullopt) noexcept;
+
+    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+
+private:
+    ctf::src::Medium::UP _mMedium;
+    bt2c::DataLen _mBegin;
+    bt2s::optional<bt2c::DataLen> _mEnd;
+};
+
+/* How to read the data stream files */
+enum class ReadMode
+{
+    Mmap,
+    MmapPrefault,
+    Pread,
+};
+
+/*
+ * Creates a medium reading the data stream files of `index` with the
+ * read mode `readMode`, `windowLen` being the maximum length of a
+ * mapping or of a single read (0 means default).
+ *
+ * If the data stream files of `index` are compressed, then this
+ * function creates a decompressing medium instead, ignoring
+ * `readMode` and `windowLen`.
+ */
+ctf::src::Medium::UP createMedium(ReadMode readMode, const ctf_fs_ds_index& index,
+                                  size_t windowLen, const bt2c::Logger& parentLogger);
+
 } /* namespace fs */
 } /* namespace src */
 } /* namespace ctf */
@@ -7,14 +7,28 @@
  * Babeltrace CTF file system Reader Component
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <queue>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <glib.h>
+#include <sys/stat.h>
 
 #include <babeltrace2/babeltrace.h>
 
 #include "common/assert.h"
 #include "common/common.h"
+#include "cpp-common/bt2/error.hpp"
 #include "cpp-common/bt2/message.hpp"
 #include "cpp-common/bt2/private-query-executor.hpp"
 #include "cpp-common/bt2/wrap.hpp"
@@ -46,6 +60,205 @@ struct tracer_info
     int64_t patch;
 };
 
+static std::int64_t msgNsFromOrigin(const bt2::ConstClockSnapshot clkSnapshot,
+                                     const bt2c::Logger& logger)
+{
+    try {
+        return clkSnapshot.nsFromOrigin();
+    } catch (const bt2::OverflowError&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error,
+            "Cannot convert clock snapshot to nanoseconds from origin: value={}",
+            clkSnapshot.value());
+    }
+}
+
+/*
+ * Returns the value of the default clock of `stream` at the time of the
+ * last seek operation of `msg_iter_data`.
+ */
+static std::uint64_t seekDefClkVal(const ctf_fs_msg_iter_data *msg_iter_data,
+                                   const bt2::ConstStream stream)
+{
+    const auto clkCls = *stream.cls().defaultClockClass();
+    std::uint64_t val;
+
+    if (bt_common_clock_value_from_ns_from_origin(
+            clkCls.offsetFromOrigin().seconds(), clkCls.offsetFromOrigin().cycles(),
+            clkCls.frequency(), *msg_iter_data->seekNsFromOrigin, &val)) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            msg_iter_data->logger, bt2::Error,
+            "Cannot convert nanoseconds from origin to clock value: ns-from-origin={}",
+            *msg_iter_data->seekNsFromOrigin);
+    }
+
+    return val;
+}
+
+/*
+ * Ends the current seek operation of `msg_iter_data`, `msg` being the
+ * first message at or after its time, returning the first message to
+ * deliver.
+ *
+ * Like the seeking emulation of the library, this function puts back
+ * the current stream and packet in the right state, giving the packet
+ * beginning message the seek time when it has a default clock snapshot.
+ */
+static bt2::ConstMessage::Shared endSeek(ctf_fs_msg_iter_data *msg_iter_data,
+                                         bt2::ConstMessage::Shared msg)
+{
+    if (msg_iter_data->seekStreamBeginMsg) {
+        msg_iter_data->queuedMsgs.push_back(std::move(msg_iter_data->seekStreamBeginMsg));
+    }
+
+    if (msg_iter_data->seekPktBeginMsg) {
+        const auto pkt = msg_iter_data->seekPktBeginMsg->asPacketBeginning().packet();
+
+        if (pkt.stream().cls().packetsHaveBeginningClockSnapshot()) {
+            msg_iter_data->queuedMsgs.push_back(
+                msg_iter_data->selfMsgIter.createPacketBeginningMessage(
+                    pkt, seekDefClkVal(msg_iter_data, pkt.stream())));
+            msg_iter_data->seekPktBeginMsg.reset();
+        } else {
+            msg_iter_data->queuedMsgs.push_back(std::move(msg_iter_data->seekPktBeginMsg));
+        }
+    }
+
+    msg_iter_data->queuedMsgs.push_back(std::move(msg));
+    msg_iter_data->seekNsFromOrigin.reset();
+    msg_iter_data->msgIter->dropEventRecordsBefore(bt2s::nullopt);
+
+    auto firstMsg = std::move(msg_iter_data->queuedMsgs.front());
+
+    msg_iter_data->queuedMsgs.pop_front();
+    return firstMsg;
+}
+
+/*
+ * Returns the next message of `msg_iter_data`, dropping the messages
+ * preceding the time of the current seek operation, if any.
+ *
+ * Returns a null message at the end.
+ */
+static bt2::ConstMessage::Shared nextMsg(ctf_fs_msg_iter_data *msg_iter_data)
+{
+    if (!msg_iter_data->queuedMsgs.empty()) {
+        auto msg = std::move(msg_iter_data->queuedMsgs.front());
+
+        msg_iter_data->queuedMsgs.pop_front();
+        return msg;
+    }
+
+    while (true) {
+        auto msg = msg_iter_data->msgIter->next();
+
+        if (!msg || !msg_iter_data->seekNsFromOrigin) {
+            return msg;
+        }
+
+        const auto seekNs = *msg_iter_data->seekNsFromOrigin;
+        const auto& logger = msg_iter_data->logger;
+
+        switch (msg->type()) {
+        case bt2::MessageType::StreamBeginning:
+            msg_iter_data->seekStreamBeginMsg = std::move(msg);
+            break;
+
+        case bt2::MessageType::StreamEnd:
+            /* The whole stream precedes the seek time: drop it */
+            msg_iter_data->seekStreamBeginMsg.reset();
+            break;
+
+        case bt2::MessageType::PacketBeginning:
+        {
+            const auto pktBeginMsg = msg->asPacketBeginning();
+
+            if (pktBeginMsg.packet().stream().cls().packetsHaveBeginningClockSnapshot() &&
+                msgNsFromOrigin(pktBeginMsg.defaultClockSnapshot(), logger) >= seekNs) {
+                return endSeek(msg_iter_data, std::move(msg));
+            }
+
+            msg_iter_data->seekPktBeginMsg = std::move(msg);
+            break;
+        }
+
+        case bt2::MessageType::PacketEnd:
+        {
+            const auto pktEndMsg = msg->asPacketEnd();
+
+            if (pktEndMsg.packet().stream().cls().packetsHaveEndClockSnapshot() &&
+                msgNsFromOrigin(pktEndMsg.defaultClockSnapshot(), logger) >= seekNs) {
+                return endSeek(msg_iter_data, std::move(msg));
+            }
+
+            /* The whole packet precedes the seek time: drop it */
+            msg_iter_data->seekPktBeginMsg.reset();
+            break;
+        }
+
+        case bt2::MessageType::Event:
+            if (msgNsFromOrigin(msg->asEvent().defaultClockSnapshot(), logger) >= seekNs) {
+                return endSeek(msg_iter_data, std::move(msg));
+            }
+
+            break;
+
+        case bt2::MessageType::DiscardedEvents:
+        {
+            const auto discMsg = msg->asDiscardedEvents();
+
+            if (!discMsg.stream().cls().discardedEventsHaveDefaultClockSnapshots()) {
+                break;
+            }
+
+            if (msgNsFromOrigin(discMsg.beginningDefaultClockSnapshot(), logger) >= seekNs) {
+                return endSeek(msg_iter_data, std::move(msg));
+            }
+
+            if (msgNsFromOrigin(discMsg.endDefaultClockSnapshot(), logger) >= seekNs) {
+                /*
+                 * Make the message begin at the seek time, with an
+                 * unknown count, as we don't know if event records
+                 * were discarded within the new time range.
+                 */
+                return endSeek(msg_iter_data,
+                               msg_iter_data->selfMsgIter.createDiscardedEventsMessage(
+                                   discMsg.stream(), seekDefClkVal(msg_iter_data, discMsg.stream()),
+                                   discMsg.endDefaultClockSnapshot().value()));
+            }
+
+            break;
+        }
+
+        case bt2::MessageType::DiscardedPackets:
+        {
+            const auto discMsg = msg->asDiscardedPackets();
+
+            if (!discMsg.stream().cls().discardedPacketsHaveDefaultClockSnapshots()) {
+                break;
+            }
+
+            if (msgNsFromOrigin(discMsg.beginningDefaultClockSnapshot(), logger) >= seekNs) {
+                return endSeek(msg_iter_data, std::move(msg));
+            }
+
+            if (msgNsFromOrigin(discMsg.endDefaultClockSnapshot(), logger) >= seekNs) {
+                /* Same as for a discarded events message above */
+                return endSeek(msg_iter_data,
+                               msg_iter_data->selfMsgIter.createDiscardedPacketsMessage(
+                                   discMsg.stream(), seekDefClkVal(msg_iter_data, discMsg.stream()),
+                                   discMsg.endDefaultClockSnapshot().value()));
+            }
+
+            break;
+        }
+
+        default:
+            bt_common_abort();
+        }
+    }
+}
+
 bt_message_iterator_class_next_method_status
 ctf_fs_iterator_next(bt_self_message_iterator *iterator, bt_message_array_const msgs,
                      uint64_t capacity, uint64_t *count)
@@ -69,7 +282,7 @@ ctf_fs_iterator_next(bt_self_message_iterator *iterator, bt_message_array_const
 
     do {
         try {
-            bt2::ConstMessage::Shared msg = msg_iter_data->msgIter->next();
+            bt2::ConstMessage::Shared msg = nextMsg(msg_iter_data);
             if (G_LIKELY(msg)) {
                 msgs[i] = msg.release().libObjPtr();
                 ++i;
@@ -116,14 +329,109 @@ ctf_fs_iterator_next(bt_self_message_iterator *iterator, bt_message_array_const
     return status;
 }
 
-static void instantiateMsgIter(ctf_fs_msg_iter_data *msg_iter_data)
+static ctf_fs_ds_index merge_ctf_fs_ds_indexes(std::vector<ctf_fs_ds_index> indexes);
+static void fix_ds_file_group_index_tracer_bugs(ctf_fs_ds_file_group& ds_file_group,
+                                                const ctf::src::MsgIterQuirks& quirks);
+
+/*
+ * Builds the index of `ds_file_group` if it's not built yet (lazy index
+ * mode), and adds a user to it.
+ *
+ * Like when building all the indexes at initialization time, this
+ * function merges the indexes of the data stream files of the group and
+ * fixes up the result for the known tracer bugs.
+ */
+static void ensure_ds_file_group_index(const ctf_fs_component& ctfFs,
+                                       ctf_fs_ds_file_group& ds_file_group,
+                                       const bt2c::Logger& logger)
 {
-    ctf_fs_ds_file_group *ds_file_group = msg_iter_data->port_data->ds_file_group;
+    ++ds_file_group.indexUserCount;
+
+    if (ds_file_group.indexBuilt) {
+        return;
+    }
+
+    const ctf_fs_trace& trace = *ds_file_group.ctf_fs_trace;
+    std::vector<ctf_fs_ds_index> fileIndexes;
+
+    BT_CPPLOGI_SPEC(logger, "Building data stream file group index: first-path=\"{}\", file-count={}",
+                    ds_file_group.ds_file_infos[0]->path(), ds_file_group.ds_file_infos.size());
+
+    for (const auto& ds_file_info : ds_file_group.ds_file_infos) {
+        auto fileIndex =
+            ctf_fs_ds_file_build_index(*ds_file_info, *trace.cls(), trace.useIndexCache);
 
-    Medium::UP medium = bt2s::make_unique<fs::Medium>(ds_file_group->index, msg_iter_data->logger);
+        if (!fileIndex) {
+            --ds_file_group.indexUserCount;
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Failed to index CTF stream file `{}`",
+                                                   ds_file_info->path());
+        }
+
+        fileIndexes.emplace_back(std::move(*fileIndex));
+    }
+
+    ds_file_group.index = merge_ctf_fs_ds_indexes(std::move(fileIndexes));
+
+    fix_ds_file_group_index_tracer_bugs(ds_file_group, ctfFs.quirks);
+    ds_file_group.index.updateOffsetsInStream();
+    ds_file_group.indexBuilt = true;
+}
+
+/*
+ * Removes a user from the index of `ds_file_group`, releasing its memory
+ * when it's the last one in lazy index mode.
+ */
+static void release_ds_file_group_index(ctf_fs_ds_file_group& ds_file_group)
+{
+    BT_ASSERT(ds_file_group.indexUserCount > 0);
+    --ds_file_group.indexUserCount;
+
+    if (ds_file_group.indexUserCount == 0 && ds_file_group.ctf_fs_trace->lazyIndex) {
+        ds_file_group.index = ctf_fs_ds_index {};
+        ds_file_group.indexBuilt = false;
+    }
+}
+
+/*
+ * (Re)creates the message iterator of `msg_iter_data`, starting at the
+ * packet of which the index entry is at `beginEntryIdx`, or at the
+ * first packet of its port if not set.
+ */
+static void instantiateMsgIter(ctf_fs_msg_iter_data *msg_iter_data,
+                               bt2s::optional<std::size_t> beginEntryIdx = bt2s::nullopt)
+{
+    const ctf_fs_port_data& port_data = *msg_iter_data->port_data;
+    ctf_fs_ds_file_group *ds_file_group = port_data.ds_file_group;
+    const auto& entries = ds_file_group->index.entries;
+
+    const ctf_fs_component& ctfFs = *port_data.ctf_fs;
+    Medium::UP medium = fs::createMedium(ctfFs.readMode, ds_file_group->index,
+                                         ctfFs.mmapWindowSize, msg_iter_data->logger);
+
+    if (!beginEntryIdx) {
+        beginEntryIdx = port_data.shardBeginEntryIdx;
+    }
+
+    if (*beginEntryIdx < entries.size() && (*beginEntryIdx > 0 || port_data.shardEndEntryIdx)) {
+        /* Decode a subrange of the data stream */
+        bt2s::optional<bt2c::DataLen> endOffsetInStream;
+
+        if (port_data.shardEndEntryIdx && *port_data.shardEndEntryIdx < entries.size()) {
+            endOffsetInStream = entries[*port_data.shardEndEntryIdx].offsetInStream;
+        }
+
+        medium = bt2s::make_unique<fs::SliceMedium>(
+            std::move(medium), entries[*beginEntryIdx].offsetInStream, endOffsetInStream);
+    }
+
+    msg_iter_data->seekNsFromOrigin.reset();
+    msg_iter_data->seekStreamBeginMsg.reset();
+    msg_iter_data->seekPktBeginMsg.reset();
+    msg_iter_data->queuedMsgs.clear();
     msg_iter_data->msgIter.emplace(msg_iter_data->selfMsgIter, *ds_file_group->ctf_fs_trace->cls(),
                                    ds_file_group->ctf_fs_trace->metadataStreamUuid(),
-                                   *ds_file_group->stream, std::move(medium),
+                                   port_data.stream(), std::move(medium),
                                    msg_iter_data->port_data->ctf_fs->quirks, msg_iter_data->logger);
 }
 
@@ -146,10 +454,109 @@ ctf_fs_iterator_seek_beginning(bt_self_message_iterator *it)
     }
 }
 
+bt_message_iterator_class_seek_ns_from_origin_method_status
+ctf_fs_iterator_seek_ns_from_origin(bt_self_message_iterator *it, const int64_t ns_from_origin)
+{
+    try {
+        struct ctf_fs_msg_iter_data *msg_iter_data =
+            (struct ctf_fs_msg_iter_data *) bt_self_message_iterator_get_data(it);
+
+        BT_ASSERT(msg_iter_data);
+
+        const ctf_fs_port_data& port_data = *msg_iter_data->port_data;
+        ctf_fs_ds_file_group& ds_file_group = *port_data.ds_file_group;
+        const auto& defClkCls = *ds_file_group.dataStreamCls->defClkCls();
+        const auto& entries = ds_file_group.index.entries;
+        const auto rangeBegin = entries.begin() + port_data.shardBeginEntryIdx;
+        const auto rangeEnd = port_data.shardEndEntryIdx ?
+                                  entries.begin() + *port_data.shardEndEntryIdx :
+                                  entries.end();
+
+        /*
+         * Find the first packet of the port which doesn't end before
+         * `ns_from_origin`.
+         *
+         * An entry without a valid end timestamp doesn't end before
+         * `ns_from_origin`, so that at worst we start decoding too early.
+         *
+         * This only applies the pending tracer bug fixups of the
+         * visited entries.
+         */
+        auto entryIt = std::partition_point(
+            rangeBegin, rangeEnd, [&](const ctf_fs_ds_index_entry& entry) {
+                int64_t endNs;
+
+                ctf_fs_ds_file_group_fix_index_entry_timestamps(
+                    ds_file_group, &entry - entries.data(), msg_iter_data->logger);
+
+                return bt_util_clock_cycles_to_ns_from_origin(
+                           entry.timestamp_end, defClkCls.freq(),
+                           defClkCls.offsetFromOrigin().seconds(),
+                           defClkCls.offsetFromOrigin().cycles(), &endNs) == 0 &&
+                       endNs < ns_from_origin;
+            });
+
+        /*
+         * Start decoding at the previous packet, which is entirely
+         * dropped, so that the message iterator still emits the
+         * discarded events/packets messages preceding the packet found
+         * above.
+         *
+         * If all the packets end before `ns_from_origin`, then decode
+         * the last one for nothing: the stream ends before the seek
+         * time and the iterator drops it.
+         */
+        if (entryIt != rangeBegin) {
+            --entryIt;
+        }
+
+        BT_CPPLOGD_SPEC(msg_iter_data->logger,
+                        "Seeking message iterator: ns-from-origin={}, pkt-offset-in-stream-bytes={}",
+                        ns_from_origin,
+                        entryIt == entries.end() ? 0 : entryIt->offsetInStream.bytes());
+        instantiateMsgIter(msg_iter_data, entryIt - entries.begin());
+        msg_iter_data->seekNsFromOrigin = ns_from_origin;
+        msg_iter_data->msgIter->dropEventRecordsBefore(ns_from_origin);
+
+        return BT_MESSAGE_ITERATOR_CLASS_SEEK_NS_FROM_ORIGIN_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_MESSAGE_ITERATOR_CLASS_SEEK_NS_FROM_ORIGIN_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_MESSAGE_ITERATOR_CLASS_SEEK_NS_FROM_ORIGIN_METHOD_STATUS_ERROR;
+    }
+}
+
+bt_message_iterator_class_can_seek_ns_from_origin_method_status
+ctf_fs_iterator_can_seek_ns_from_origin(bt_self_message_iterator *it, int64_t, bt_bool *can_seek)
+{
+    struct ctf_fs_msg_iter_data *msg_iter_data =
+        (struct ctf_fs_msg_iter_data *) bt_self_message_iterator_get_data(it);
+
+    BT_ASSERT(msg_iter_data);
+
+    /*
+     * Finding a packet needs the timestamps of the index entries, which
+     * are default clock values.
+     */
+    const ctf_fs_port_data& port_data = *msg_iter_data->port_data;
+    const ctf_fs_ds_file_group& ds_file_group = *port_data.ds_file_group;
+    const auto rangeEndIdx = port_data.shardEndEntryIdx ? *port_data.shardEndEntryIdx :
+                                                          ds_file_group.index.entries.size();
+
+    *can_seek = ds_file_group.dataStreamCls->defClkCls() &&
+                rangeEndIdx > port_data.shardBeginEntryIdx;
+    return BT_MESSAGE_ITERATOR_CLASS_CAN_SEEK_NS_FROM_ORIGIN_METHOD_STATUS_OK;
+}
+
 void ctf_fs_iterator_finalize(bt_self_message_iterator *it)
 {
-    ctf_fs_msg_iter_data::UP {
+    ctf_fs_msg_iter_data::UP msg_iter_data {
         static_cast<ctf_fs_msg_iter_data *>(bt_self_message_iterator_get_data(it))};
+    ctf_fs_ds_file_group& ds_file_group = *msg_iter_data->port_data->ds_file_group;
+
+    /* Destroy the message iterator and its medium before releasing the index */
+    msg_iter_data.reset();
+    release_ds_file_group_index(ds_file_group);
 }
 
 bt_message_iterator_class_initialize_method_status
@@ -165,7 +572,16 @@ ctf_fs_iterator_init(bt_self_message_iterator *self_msg_iter,
         auto msg_iter_data = bt2s::make_unique<ctf_fs_msg_iter_data>(bt2::wrap(self_msg_iter));
         msg_iter_data->port_data = port_data;
 
-        instantiateMsgIter(msg_iter_data.get());
+        ensure_ds_file_group_index(*port_data->ctf_fs, *port_data->ds_file_group,
+                                   msg_iter_data->logger);
+
+        try {
+            instantiateMsgIter(msg_iter_data.get());
+        } catch (...) {
+            msg_iter_data->msgIter.reset();
+            release_ds_file_group_index(*port_data->ds_file_group);
+            throw;
+        }
 
         /*
          * This iterator can seek forward if its stream class has a default
@@ -238,6 +654,20 @@ std::string ctf_fs_make_port_name(ctf_fs_ds_file_group *ds_file_group)
     return name.str();
 }
 
+static int add_port_for_trace(struct ctf_fs_component *ctf_fs, const std::string& port_name,
+                              ctf_fs_port_data::UP port_data,
+                              const bt2::SelfSourceComponent selfSrcComp)
+{
+    int ret = bt_self_component_source_add_output_port(selfSrcComp.libObjPtr(), port_name.c_str(),
+                                                       port_data.get(), NULL);
+    if (ret) {
+        return ret;
+    }
+
+    ctf_fs->port_data.emplace_back(std::move(port_data));
+    return 0;
+}
+
 static int create_one_port_for_trace(struct ctf_fs_component *ctf_fs,
                                      struct ctf_fs_ds_file_group *ds_file_group,
                                      const bt2::SelfSourceComponent selfSrcComp)
@@ -250,13 +680,61 @@ static int create_one_port_for_trace(struct ctf_fs_component *ctf_fs,
     port_data->ctf_fs = ctf_fs;
     port_data->ds_file_group = ds_file_group;
 
-    int ret = bt_self_component_source_add_output_port(selfSrcComp.libObjPtr(), port_name.c_str(),
-                                                       port_data.get(), NULL);
-    if (ret) {
-        return ret;
+    return add_port_for_trace(ctf_fs, port_name, std::move(port_data), selfSrcComp);
+}
+
+/*
+ * Creates one port for each of the at most `ctf_fs->streamShardCount`
+ * shards of `ds_file_group`.
+ *
+ * Each shard is a contiguous range of packets of the data stream. The
+ * first shard keeps the stream of `ds_file_group`, while each other one
+ * gets its own stream, having the ID `*nextStreamId` (incremented), as
+ * distinct message iterators can't share a stream.
+ */
+static int create_shard_ports_for_trace(struct ctf_fs_component *ctf_fs,
+                                        struct ctf_fs_ds_file_group *ds_file_group,
+                                        std::uint64_t *nextStreamId,
+                                        const bt2::SelfSourceComponent selfSrcComp)
+{
+    const auto entryCount = ds_file_group->index.entries.size();
+    const auto shardCount = std::min<std::size_t>(ctf_fs->streamShardCount, entryCount);
+    const auto basePortName = ctf_fs_make_port_name(ds_file_group);
+
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        const auto port_name = fmt::format("{} | shard {}", basePortName, i);
+        auto port_data = bt2s::make_unique<ctf_fs_port_data>();
+
+        port_data->ctf_fs = ctf_fs;
+        port_data->ds_file_group = ds_file_group;
+        port_data->shardBeginEntryIdx = i * entryCount / shardCount;
+
+        if (i + 1 < shardCount) {
+            port_data->shardEndEntryIdx = (i + 1) * entryCount / shardCount;
+        }
+
+        if (i > 0) {
+            const auto streamCls = *ds_file_group->dataStreamCls->libCls();
+
+            port_data->shardStream =
+                streamCls.instantiate(*ds_file_group->ctf_fs_trace->trace, *nextStreamId);
+            ++*nextStreamId;
+            port_data->shardStream->name(
+                fmt::format("{} (shard {})", ds_file_group->stream->name(), i));
+        }
+
+        BT_CPPLOGI_SPEC(ctf_fs->logger,
+                        "Creating one shard port: name=`{}`, begin-entry-index={}, entry-count={}",
+                        port_name, port_data->shardBeginEntryIdx,
+                        (port_data->shardEndEntryIdx ? *port_data->shardEndEntryIdx : entryCount) -
+                            port_data->shardBeginEntryIdx);
+
+        int ret = add_port_for_trace(ctf_fs, port_name, std::move(port_data), selfSrcComp);
+        if (ret) {
+            return ret;
+        }
     }
 
-    ctf_fs->port_data.emplace_back(std::move(port_data));
     return 0;
 }
 
@@ -264,9 +742,30 @@ static int create_ports_for_trace(struct ctf_fs_component *ctf_fs,
                                   struct ctf_fs_trace *ctf_fs_trace,
                                   const bt2::SelfSourceComponent selfSrcComp)
 {
-    /* Create one output port for each stream file group */
+    /*
+     * Next stream ID of a shard stream, per data stream class ID, so
+     * that shard streams don't clash with the existing streams.
+     */
+    std::unordered_map<std::uint64_t, std::uint64_t> nextShardStreamIds;
+
+    for (const auto& ds_file_group : ctf_fs_trace->ds_file_groups) {
+        auto& nextId = nextShardStreamIds[ds_file_group->dataStreamCls->id()];
+
+        nextId = std::max(nextId, ds_file_group->stream->id() + 1);
+    }
+
+    /* Create one output port for each stream file group, or for each of its shards */
     for (const auto& ds_file_group : ctf_fs_trace->ds_file_groups) {
-        int ret = create_one_port_for_trace(ctf_fs, ds_file_group.get(), selfSrcComp);
+        int ret;
+
+        if (ctf_fs->streamShardCount > 1 && ds_file_group->index.entries.size() > 1) {
+            ret = create_shard_ports_for_trace(
+                ctf_fs, ds_file_group.get(),
+                &nextShardStreamIds[ds_file_group->dataStreamCls->id()], selfSrcComp);
+        } else {
+            ret = create_one_port_for_trace(ctf_fs, ds_file_group.get(), selfSrcComp);
+        }
+
         if (ret) {
             BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger, "Cannot create output port.");
             return ret;
@@ -299,53 +798,245 @@ static bool ds_index_entries_equal(const ctf_fs_ds_index_entry& left,
 }
 
 /*
- * Insert `entry` into `index`, without duplication.
+ * Merges the indexes `indexes`, each one sorted by packet beginning
+ * timestamp, into a single index sorted the same way.
  *
- * The entry is inserted only if there isn't an identical entry already.
+ * There can be duplicate packets if reading multiple overlapping
+ * snapshots of the same trace.  We then want the index to contain
+ * a reference to only one copy of that packet: an entry is only added
+ * if there isn't an identical entry having the same beginning timestamp
+ * already.
+ *
+ * This is a k-way merge, taking O(n log k) time for `n` entries in `k`
+ * indexes. Amongst entries having the same beginning timestamp, the
+ * ones of the last indexes come first.
  */
-
-static void ds_index_insert_ds_index_entry_sorted(ctf_fs_ds_index& index,
-                                                  const ctf_fs_ds_index_entry& entry)
+static ctf_fs_ds_index merge_ctf_fs_ds_indexes(std::vector<ctf_fs_ds_index> indexes)
 {
-    /* Find the spot where to insert this index entry. */
-    auto otherEntry = index.entries.begin();
-    for (; otherEntry != index.entries.end(); ++otherEntry) {
-        if (entry.timestamp_begin <= otherEntry->timestamp_begin) {
-            break;
+    if (indexes.size() == 1) {
+        return std::move(indexes.front());
+    }
+
+    /* Next entry to merge of an index */
+    struct Cursor
+    {
+        ctf_fs_ds_index::EntriesT::const_iterator it;
+        ctf_fs_ds_index::EntriesT::const_iterator end;
+        std::size_t indexIdx;
+    };
+
+    /* Puts the cursor having the entry to merge next on top */
+    const auto cursorGreater = [](const Cursor& left, const Cursor& right) {
+        if (left.it->timestamp_begin != right.it->timestamp_begin) {
+            return left.it->timestamp_begin > right.it->timestamp_begin;
+        }
+
+        return left.indexIdx < right.indexIdx;
+    };
+
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(cursorGreater)> cursors {
+        cursorGreater};
+    std::size_t entryCount = 0;
+
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        const auto& entries = indexes[i].entries;
+
+        if (!entries.empty()) {
+            cursors.push(Cursor {entries.begin(), entries.end(), i});
+            entryCount += entries.size();
         }
     }
 
-    /*
-     * Insert the entry only if a duplicate doesn't already exist.
-     *
-     * There can be duplicate packets if reading multiple overlapping
-     * snapshots of the same trace.  We then want the index to contain
-     * a reference to only one copy of that packet.
-     */
-    if (otherEntry == index.entries.end() || !ds_index_entries_equal(entry, *otherEntry)) {
-        index.entries.emplace(otherEntry, entry);
+    ctf_fs_ds_index merged;
+
+    merged.entries.reserve(entryCount);
+
+    /* Index, within `merged.entries`, of the first entry having the current beginning timestamp */
+    std::size_t runBeginIdx = 0;
+
+    while (!cursors.empty()) {
+        auto cursor = cursors.top();
+        const auto& entry = *cursor.it;
+
+        cursors.pop();
+
+        if (merged.entries.empty() ||
+            merged.entries.back().timestamp_begin != entry.timestamp_begin) {
+            runBeginIdx = merged.entries.size();
+        }
+
+        if (std::none_of(merged.entries.begin() + runBeginIdx, merged.entries.end(),
+                         [&entry](const ctf_fs_ds_index_entry& otherEntry) {
+                             return ds_index_entries_equal(entry, otherEntry);
+                         })) {
+            merged.entries.push_back(entry);
+        }
+
+        ++cursor.it;
+
+        if (cursor.it != cursor.end) {
+            cursors.push(cursor);
+        }
     }
+
+    return merged;
 }
 
-static void merge_ctf_fs_ds_indexes(ctf_fs_ds_index& dest, const ctf_fs_ds_index& src)
+/*
+ * Exception which a worker thread threw, and corresponding thread
+ * error, if any, for the calling thread to rethrow.
+ */
+struct worker_exc
 {
-    for (const auto& entry : src.entries) {
-        ds_index_insert_ds_index_entry_sorted(dest, entry);
+    void capture()
+    {
+        exc = std::current_exception();
+        error = bt2::takeCurrentThreadError();
+    }
+
+    void rethrowIfAny()
+    {
+        if (!exc) {
+            return;
+        }
+
+        if (error) {
+            bt2::moveErrorToCurrentThread(std::move(error));
+        }
+
+        std::rethrow_exception(exc);
+    }
+
+    std::exception_ptr exc;
+    bt2::UniqueConstError error {nullptr};
+};
+
+/*
+ * Calls `func(i)` for each `i` in [0, `count`[ concurrently, with at
+ * most one thread per hardware thread.
+ *
+ * `func` must not throw: make it capture its exception for the calling
+ * thread instead (see `worker_exc`).
+ */
+template <typename FuncT>
+static void run_concurrently(const std::size_t count, FuncT func, const char * const what,
+                             const bt2c::Logger& logger)
+{
+    std::atomic<std::size_t> nextI {0};
+    const auto work = [&] {
+        while (true) {
+            const auto i = nextI++;
+
+            if (i >= count) {
+                break;
+            }
+
+            func(i);
+        }
+    };
+
+    const auto threadCount =
+        std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+
+    if (threadCount <= 1) {
+        work();
+        return;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "{} concurrently: count={}, thread-count={}", what, count,
+                    threadCount);
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(work);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
     }
 }
 
-static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const char *path,
-                                        const bt2c::Logger& logger)
+struct indexed_ds_file
 {
-    auto ds_file_info = bt2s::make_unique<ctf_fs_ds_file_info>(path, logger);
-    const auto& traceCls = *ctf_fs_trace->cls();
+    /* Trace of this data stream file (weak) */
+    struct ctf_fs_trace *trace = nullptr;
+
+    std::string path;
+    ctf_fs_ds_file_info::UP ds_file_info;
+
+    /* Properties of the first packet */
+    ctf::src::PktProps props;
+
+    bt2s::optional<ctf_fs_ds_index> index;
+
+    /* Exception which indexing the file threw, if any */
+    worker_exc exc;
+};
+
+static void index_ds_file(indexed_ds_file& file, const bt2c::Logger& logger)
+{
+    const auto& traceCls = *file.trace->cls();
+
+    file.ds_file_info = bt2s::make_unique<ctf_fs_ds_file_info>(file.path, logger);
+
     ctf_fs_ds_index tempIndex;
-    ctf_fs_ds_index_entry tempIndexEntry {path, 0_bytes, ds_file_info->size()};
+    ctf_fs_ds_index_entry tempIndexEntry {*file.ds_file_info, 0_bytes, file.ds_file_info->size()};
 
     tempIndex.entries.emplace_back(tempIndexEntry);
+    file.props = readPktProps(traceCls, fs::createMedium(fs::ReadMode::Mmap, tempIndex, 0, logger),
+                              0_bytes, logger);
+
+    if (!file.trace->lazyIndex) {
+        file.index =
+            ctf_fs_ds_file_build_index(*file.ds_file_info, traceCls, file.trace->useIndexCache);
+    }
+}
+
+/*
+ * Indexes the data stream files `files`, possibly of different traces,
+ * concurrently.
+ *
+ * Each file gets indexed independently: grouping them, which merges
+ * their indexes, happens afterwards, in order.
+ *
+ * If the trace of a file is in lazy index mode, then this function only
+ * reads the properties of its first packet.
+ */
+static void index_ds_files(std::vector<indexed_ds_file>& files, const bt2c::Logger& logger)
+{
+    run_concurrently(
+        files.size(),
+        [&](const std::size_t i) {
+            try {
+                index_ds_file(files[i], logger);
+            } catch (...) {
+                /* Let the calling thread handle it. */
+                files[i].exc.capture();
+            }
+        },
+        "Indexing data stream files", logger);
+}
 
-    const auto props =
-        readPktProps(traceCls, bt2s::make_unique<fs::Medium>(tempIndex, logger), 0_bytes, logger);
+/*
+ * Adds the data stream file `file` to a data stream file group of
+ * `ctf_fs_trace`.
+ *
+ * Instead of merging the index of `file` into the index of its group
+ * immediately, this function adds it to the file indexes of the group
+ * within `fileIndexes`, so that the caller merges them all at once.
+ */
+static int add_ds_file_to_ds_file_group(
+    struct ctf_fs_trace *ctf_fs_trace, indexed_ds_file& file,
+    std::unordered_map<ctf_fs_ds_file_group *, std::vector<ctf_fs_ds_index>>& fileIndexes,
+    const bt2c::Logger& logger)
+{
+    file.exc.rethrowIfAny();
+
+    const char *path = file.path.c_str();
+    auto ds_file_info = std::move(file.ds_file_info);
+    const auto& traceCls = *ctf_fs_trace->cls();
+    const auto& props = file.props;
     const auto sc = props.dataStreamCls;
 
     BT_ASSERT(sc);
@@ -366,8 +1057,11 @@ static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const
         }
     }
 
-    auto index = ctf_fs_ds_file_build_index(*ds_file_info, traceCls);
-    if (!index) {
+    auto& index = file.index;
+    if (ctf_fs_trace->lazyIndex) {
+        /* The iterators of the group build its index (see ensure_ds_file_group_index()) */
+        index.emplace();
+    } else if (!index) {
         BT_CPPLOGE_APPEND_CAUSE_SPEC(logger, "Failed to index CTF stream file \'{}\'", path);
         return -1;
     }
@@ -383,6 +1077,7 @@ static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const
         ctf_fs_trace->ds_file_groups.emplace_back(bt2s::make_unique<ctf_fs_ds_file_group>(
             ctf_fs_trace, *sc, stream_instance_id ? *stream_instance_id : UINT64_C(-1),
             std::move(*index)));
+        ctf_fs_trace->ds_file_groups.back()->indexBuilt = !ctf_fs_trace->lazyIndex;
         ctf_fs_trace->ds_file_groups.back()->add_ds_file_info(std::move(ds_file_info));
 
         for (const auto& streamCls : ctf_fs_trace->cls()->dataStreamClasses()) {
@@ -391,7 +1086,11 @@ static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const
             }
             auto extra_ds_file_info = bt2s::make_unique<ctf_fs_ds_file_info>(path, logger);
 
-            auto extra_index = ctf_fs_ds_file_build_index(*extra_ds_file_info, traceCls);
+            auto extra_index =
+                ctf_fs_trace->lazyIndex ?
+                    bt2s::optional<ctf_fs_ds_index> {ctf_fs_ds_index {}} :
+                    ctf_fs_ds_file_build_index(*extra_ds_file_info, traceCls,
+                                               ctf_fs_trace->useIndexCache);
             if (!index) {
                 BT_CPPLOGE_APPEND_CAUSE_SPEC(logger, "Failed to index CTF stream file \'{}\'",
                                              path);
@@ -400,6 +1099,7 @@ static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const
 
             ctf_fs_trace->ds_file_groups.emplace_back(bt2s::make_unique<ctf_fs_ds_file_group>(
                 ctf_fs_trace, *streamCls.get(), UINT64_C(-1), std::move(*extra_index)));
+            ctf_fs_trace->ds_file_groups.back()->indexBuilt = !ctf_fs_trace->lazyIndex;
             ctf_fs_trace->ds_file_groups.back()->add_ds_file_info(std::move(extra_ds_file_info));
         }
 
@@ -417,40 +1117,50 @@ static int add_ds_file_to_ds_file_group(struct ctf_fs_trace *ctf_fs_trace, const
 
     if (!ds_file_group) {
         ctf_fs_trace->ds_file_groups.emplace_back(bt2s::make_unique<ctf_fs_ds_file_group>(
-            ctf_fs_trace, *sc, static_cast<std::uint64_t>(*stream_instance_id), std::move(*index)));
+            ctf_fs_trace, *sc, static_cast<std::uint64_t>(*stream_instance_id),
+            ctf_fs_ds_index {}));
         ds_file_group = ctf_fs_trace->ds_file_groups.back().get();
-    } else {
-        merge_ctf_fs_ds_indexes(ds_file_group->index, *index);
+        ds_file_group->indexBuilt = !ctf_fs_trace->lazyIndex;
     }
 
+    fileIndexes[ds_file_group].emplace_back(std::move(*index));
+
     ds_file_group->add_ds_file_info(std::move(ds_file_info));
 
     return 0;
 }
 
-static int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace, const bt2c::Logger& logger)
+/*
+ * Appends the paths of the data stream files of the trace directory
+ * `tracePath` to `paths`.
+ */
+static void list_ds_files(const std::string& tracePath, std::vector<std::string>& paths,
+                          const bt2c::Logger& logger)
 {
     /* Check each file in the path directory, except specific ones */
     GError *error = NULL;
-    const bt2c::GDirUP dir {g_dir_open(ctf_fs_trace->path.c_str(), 0, &error)};
+    const bt2c::GDirUP dir {g_dir_open(tracePath.c_str(), 0, &error)};
     if (!dir) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(logger, "Cannot open directory `{}`: {} (code {})",
-                                     ctf_fs_trace->path, error->message, error->code);
+        const std::string msg = error->message;
+        const auto code = error->code;
+
         g_error_free(error);
-        return -1;
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Cannot open directory `{}`: {} (code {})",
+                                               tracePath, msg, code);
     }
 
     while (const char *basename = g_dir_read_name(dir.get())) {
         if (strcmp(basename, CTF_FS_METADATA_FILENAME) == 0) {
             /* Ignore the metadata stream. */
             BT_CPPLOGI_SPEC(logger, "Ignoring metadata file `{}" G_DIR_SEPARATOR_S "{}`",
-                            ctf_fs_trace->path, basename);
+                            tracePath, basename);
             continue;
         }
 
         if (basename[0] == '.') {
-            BT_CPPLOGI_SPEC(logger, "Ignoring hidden file `{}" G_DIR_SEPARATOR_S "{}`",
-                            ctf_fs_trace->path, basename);
+            BT_CPPLOGI_SPEC(logger, "Ignoring hidden file `{}" G_DIR_SEPARATOR_S "{}`", tracePath,
+                            basename);
             continue;
         }
 
@@ -458,17 +1168,16 @@ static int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace, const bt2c::
         ctf_fs_file file {logger};
 
         /* Create full path string. */
-        file.path = fmt::format("{}" G_DIR_SEPARATOR_S "{}", ctf_fs_trace->path, basename);
+        file.path = fmt::format("{}" G_DIR_SEPARATOR_S "{}", tracePath, basename);
 
         if (!g_file_test(file.path.c_str(), G_FILE_TEST_IS_REGULAR)) {
             BT_CPPLOGI_SPEC(logger, "Ignoring non-regular file `{}`", file.path);
             continue;
         }
 
-        int ret = ctf_fs_file_open(&file, "rb");
-        if (ret) {
-            BT_CPPLOGE_APPEND_CAUSE_SPEC(logger, "Cannot open stream file `{}`", file.path);
-            return ret;
+        if (ctf_fs_file_open(&file, "rb")) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Cannot open stream file `{}`", file.path);
         }
 
         if (file.size == 0) {
@@ -477,7 +1186,22 @@ static int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace, const bt2c::
             continue;
         }
 
-        ret = add_ds_file_to_ds_file_group(ctf_fs_trace, file.path.c_str(), logger);
+        paths.emplace_back(std::move(file.path));
+    }
+}
+
+/*
+ * Indexes the data stream files `files` concurrently, and then adds
+ * each of them to a data stream file group of its trace.
+ */
+static int create_ds_file_groups(std::vector<indexed_ds_file>& files, const bt2c::Logger& logger)
+{
+    index_ds_files(files, logger);
+
+    std::unordered_map<ctf_fs_ds_file_group *, std::vector<ctf_fs_ds_index>> fileIndexes;
+
+    for (auto& file : files) {
+        const int ret = add_ds_file_to_ds_file_group(file.trace, file, fileIndexes, logger);
         if (ret) {
             BT_CPPLOGE_APPEND_CAUSE_SPEC(logger, "Cannot add stream file `{}` to stream file group",
                                          file.path);
@@ -485,6 +1209,10 @@ static int create_ds_file_groups(struct ctf_fs_trace *ctf_fs_trace, const bt2c::
         }
     }
 
+    for (auto& groupFileIndexes : fileIndexes) {
+        groupFileIndexes.first->index = merge_ctf_fs_ds_indexes(std::move(groupFileIndexes.second));
+    }
+
     return 0;
 }
 
@@ -512,31 +1240,43 @@ static void set_trace_name(const bt2::Trace trace, const char *name_suffix)
     trace.name(name);
 }
 
+/*
+ * Creates the trace IR trace of `ctf_fs_trace`, of which the trace
+ * class has its trace IR equivalent, naming it from `name`.
+ */
+static void create_ir_trace(ctf_fs_trace& ctf_fs_trace, const char *name,
+                            const bt2::SelfComponent selfComp, const bt2c::Logger& logger)
+{
+    bt2::TraceClass traceCls = *ctf_fs_trace.cls()->libCls();
+
+    ctf_fs_trace.trace = traceCls.instantiate();
+    ctf_trace_class_configure_ir_trace(*ctf_fs_trace.cls(), *ctf_fs_trace.trace,
+                                       selfComp.graphMipVersion(), logger);
+    set_trace_name(*ctf_fs_trace.trace, name);
+}
+
+/*
+ * Creates a trace from the trace directory `path` having the metadata
+ * stream `metadata`, without any data stream file group.
+ */
 static ctf_fs_trace::UP
 ctf_fs_trace_create(const char *path, const char *name, const ctf::src::ClkClsCfg& clkClsCfg,
+                    const bool useIndexCache, const bool lazyIndex,
                     const bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
+                    const bt2c::ConstBytes metadata, ctf_fs_metadata_cache& metadataCache,
                     const bt2c::Logger& logger)
 {
     auto ctf_fs_trace = bt2s::make_unique<struct ctf_fs_trace>(clkClsCfg, selfComp, logger);
-    const auto metadataPath = fmt::format("{}" G_DIR_SEPARATOR_S CTF_FS_METADATA_FILENAME, path);
 
     ctf_fs_trace->path = path;
-    ctf_fs_trace->parseMetadata(bt2c::dataFromFile(metadataPath, logger, true));
+    ctf_fs_trace->useIndexCache = useIndexCache;
+    ctf_fs_trace->lazyIndex = lazyIndex;
+    ctf_fs_trace->parseMetadata(metadata, metadataCache);
 
     BT_ASSERT(ctf_fs_trace->cls());
 
     if (ctf_fs_trace->cls()->libCls()) {
-        bt2::TraceClass traceCls = *ctf_fs_trace->cls()->libCls();
-        ctf_fs_trace->trace = traceCls.instantiate();
-        ctf_trace_class_configure_ir_trace(
-            *ctf_fs_trace->cls(), *ctf_fs_trace->trace,
-            bt_self_component_get_graph_mip_version(selfComp->libObjPtr()), logger);
-        set_trace_name(*ctf_fs_trace->trace, name);
-    }
-
-    int ret = create_ds_file_groups(ctf_fs_trace.get(), logger);
-    if (ret) {
-        return nullptr;
+        create_ir_trace(*ctf_fs_trace, name, *selfComp, logger);
     }
 
     return ctf_fs_trace;
@@ -548,48 +1288,95 @@ static int path_is_ctf_trace(const char *path)
                        G_FILE_TEST_IS_REGULAR);
 }
 
-/* Helper for ctf_fs_component_create_ctf_fs_trace, to handle a single path. */
+namespace {
 
-static int ctf_fs_component_create_ctf_fs_trace_one_path(
-    struct ctf_fs_component *ctf_fs, const char *path_param, const char *trace_name,
-    std::vector<ctf_fs_trace::UP>& traces,
-    const bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp)
+/*
+ * Set of distinct metadata streams which the concurrent readers of
+ * trace directories share, so that the traces having the exact same
+ * metadata stream (for example, the per-process traces of an LTTng
+ * tracing session) only keep a single copy of it.
+ */
+class MetadataStreamSet final
+{
+public:
+    /*
+     * Adds `metadata` to this set if it's not already part of it, and
+     * returns the stable address of the element of this set equal to
+     * `metadata`.
+     */
+    const std::string *add(std::string metadata)
+    {
+        const std::lock_guard<std::mutex> lock {_mMutex};
+
+        /* Addresses of `std::unordered_set` elements never change */
+        return &*_mStreams.insert(std::move(metadata)).first;
+    }
+
+private:
+    std::mutex _mMutex;
+    std::unordered_set<std::string> _mStreams;
+};
+
+} /* namespace */
+
+/* Contents of a trace directory, read before creating its trace */
+struct ctf_fs_trace_dir
+{
+    /* Normalized path */
+    std::string path;
+
+    /* Metadata stream (weak, belongs to a `MetadataStreamSet`) */
+    const std::string *metadata = nullptr;
+
+    /* Paths of the data stream files */
+    std::vector<std::string> dsFilePaths;
+
+    /* Exception which reading the directory threw, if any */
+    worker_exc exc;
+};
+
+/*
+ * Reads the metadata stream and lists the data stream files of the
+ * trace directory `pathParam` into `dir`.
+ *
+ * This function is thread-safe.
+ */
+static void read_trace_dir(const std::string& pathParam, ctf_fs_trace_dir& dir,
+                           MetadataStreamSet& metadataStreams, const bt2c::Logger& logger)
 {
-    bt2c::GStringUP norm_path {bt_common_normalize_path(path_param, NULL)};
+    bt2c::GStringUP norm_path {bt_common_normalize_path(pathParam.c_str(), NULL)};
     if (!norm_path) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger, "Failed to normalize path: `{}`.", path_param);
-        return -1;
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Failed to normalize path: `{}`.", pathParam);
     }
 
     int ret = path_is_ctf_trace(norm_path->str);
     if (ret < 0) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(
-            ctf_fs->logger, "Failed to check if path is a CTF trace: path={}", norm_path->str);
-        return ret;
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error, "Failed to check if path is a CTF trace: path={}", norm_path->str);
     } else if (ret == 0) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(
-            ctf_fs->logger, "Path is not a CTF trace (does not contain a metadata file): `{}`.",
-            norm_path->str);
-        return -1;
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error,
+            "Path is not a CTF trace (does not contain a metadata file): `{}`.", norm_path->str);
     }
 
     // FIXME: Remove or ifdef for __MINGW32__
     if (strcmp(norm_path->str, "/") == 0) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger, "Opening a trace in `/` is not supported.");
-        return -1;
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Opening a trace in `/` is not supported.");
     }
 
-    ctf_fs_trace::UP ctf_fs_trace = ctf_fs_trace_create(
-        norm_path->str, trace_name, ctf_fs->clkClsCfg, selfComp, ctf_fs->logger);
-    if (!ctf_fs_trace) {
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger, "Cannot create trace for `{}`.",
-                                     norm_path->str);
-        return -1;
-    }
+    dir.path = norm_path->str;
 
-    traces.emplace_back(std::move(ctf_fs_trace));
+    {
+        const auto data = bt2c::dataFromFile(
+            fmt::format("{}" G_DIR_SEPARATOR_S CTF_FS_METADATA_FILENAME, dir.path), logger, true);
 
-    return 0;
+        dir.metadata = metadataStreams.add(
+            std::string {reinterpret_cast<const char *>(data.data()), data.size()});
+    }
+
+    list_ds_files(dir.path, dir.dsFilePaths, logger);
 }
 
 /*
@@ -618,83 +1405,6 @@ static unsigned int metadata_count_stream_and_event_classes(struct ctf_fs_trace
  * ds_file_infos and indexes.
  */
 
-static void merge_ctf_fs_ds_file_groups(struct ctf_fs_ds_file_group *dest,
-                                        ctf_fs_ds_file_group::UP src)
-{
-    for (auto& ds_file_info : src->ds_file_infos) {
-        dest->add_ds_file_info(std::move(ds_file_info));
-    }
-
-    /* Merge both indexes. */
-    merge_ctf_fs_ds_indexes(dest->index, src->index);
-}
-
-/* Merge src_trace's data stream file groups into dest_trace's. */
-
-static int merge_matching_ctf_fs_ds_file_groups(struct ctf_fs_trace *dest_trace,
-                                                ctf_fs_trace::UP src_trace)
-{
-    std::vector<ctf_fs_ds_file_group::UP>& dest = dest_trace->ds_file_groups;
-    std::vector<ctf_fs_ds_file_group::UP>& src = src_trace->ds_file_groups;
-
-    /*
-     * Save the initial length of dest: we only want to check against the
-     * original elements in the inner loop.
-     */
-    size_t dest_len = dest.size();
-
-    for (auto& src_group : src) {
-        struct ctf_fs_ds_file_group *dest_group = NULL;
-
-        /* A stream instance without ID can't match a stream in the other trace.  */
-        if (src_group->stream_id != -1) {
-            /* Let's search for a matching ds_file_group in the destination.  */
-            for (size_t d_i = 0; d_i < dest_len; ++d_i) {
-                ctf_fs_ds_file_group *candidate_dest = dest[d_i].get();
-
-                /* Can't match a stream instance without ID.  */
-                if (candidate_dest->stream_id == -1) {
-                    continue;
-                }
-
-                /*
-                 * If the two groups have the same stream instance id
-                 * and belong to the same stream class (stream instance
-                 * ids are per-stream class), they represent the same
-                 * stream instance.
-                 */
-                if (candidate_dest->stream_id != src_group->stream_id ||
-                    candidate_dest->dataStreamCls->id() != src_group->dataStreamCls->id()) {
-                    continue;
-                }
-
-                dest_group = candidate_dest;
-                break;
-            }
-        }
-
-        /*
-         * Didn't find a friend in dest to merge our src_group into?
-         * Create a new empty one. This can happen if a stream was
-         * active in the source trace chunk but not in the destination
-         * trace chunk.
-         */
-        if (!dest_group) {
-            const DataStreamCls *sc = (*dest_trace->cls())[src_group->dataStreamCls->id()];
-            BT_ASSERT(sc);
-
-            dest_trace->ds_file_groups.emplace_back(bt2s::make_unique<ctf_fs_ds_file_group>(
-                dest_trace, *sc, src_group->stream_id, ctf_fs_ds_index {}));
-            dest_group = dest_trace->ds_file_groups.back().get();
-        }
-
-        BT_ASSERT(dest_group);
-        merge_ctf_fs_ds_file_groups(dest_group, std::move(src_group));
-    }
-
-    return 0;
-}
-
 /*
  * Collapse the given traces, which must all share the same UUID, in a single
  * one.
@@ -717,27 +1427,100 @@ static int merge_ctf_fs_traces(std::vector<ctf_fs_trace::UP> traces, ctf_fs_trac
         ctf_fs_trace *candidate = traces[i].get();
         unsigned int candidate_count;
 
-        candidate_count = metadata_count_stream_and_event_classes(candidate);
+        candidate_count = metadata_count_stream_and_event_classes(candidate);
+
+        if (candidate_count > winner_count) {
+            winner_count = candidate_count;
+            winner = candidate;
+            winner_i = i;
+        }
+    }
+
+    /*
+     * Data stream file groups of the winner having a stream instance
+     * ID, by data stream class ID and stream instance ID (stream
+     * instance IDs are per data stream class): two such groups
+     * represent the same stream instance.
+     */
+    using GroupKey = std::pair<std::uint64_t, std::uint64_t>;
+    std::map<GroupKey, ctf_fs_ds_file_group *> destGroups;
+
+    for (const auto& group : winner->ds_file_groups) {
+        if (group->stream_id != UINT64_C(-1)) {
+            destGroups.emplace(GroupKey {group->dataStreamCls->id(), group->stream_id},
+                               group.get());
+        }
+    }
+
+    /*
+     * Indexes to merge into the index of each group of the winner, all
+     * at once afterwards.
+     */
+    std::unordered_map<ctf_fs_ds_file_group *, std::vector<ctf_fs_ds_index>> groupIndexes;
+
+    /* Merge all the other traces in the winning trace. */
+    for (ctf_fs_trace::UP& trace : traces) {
+        /* Don't merge the winner into itself. */
+        if (trace.get() == winner) {
+            continue;
+        }
+
+        /*
+         * A group which this trace adds to the winner only matches the
+         * groups of the next traces.
+         */
+        std::vector<ctf_fs_ds_file_group *> newGroups;
+
+        for (auto& src_group : trace->ds_file_groups) {
+            struct ctf_fs_ds_file_group *dest_group = NULL;
+
+            /* A stream instance without ID can't match a stream in the other trace.  */
+            if (src_group->stream_id != UINT64_C(-1)) {
+                const auto it =
+                    destGroups.find(GroupKey {src_group->dataStreamCls->id(), src_group->stream_id});
+
+                if (it != destGroups.end()) {
+                    dest_group = it->second;
+                }
+            }
+
+            /*
+             * Didn't find a friend in the winner to merge our
+             * src_group into? Create a new empty one. This can happen
+             * if a stream was active in the source trace chunk but not
+             * in the destination trace chunk.
+             */
+            if (!dest_group) {
+                const DataStreamCls *sc = (*winner->cls())[src_group->dataStreamCls->id()];
+                BT_ASSERT(sc);
+
+                winner->ds_file_groups.emplace_back(bt2s::make_unique<ctf_fs_ds_file_group>(
+                    winner, *sc, src_group->stream_id, ctf_fs_ds_index {}));
+                dest_group = winner->ds_file_groups.back().get();
+                dest_group->indexBuilt = src_group->indexBuilt;
+                newGroups.push_back(dest_group);
+            }
+
+            for (auto& ds_file_info : src_group->ds_file_infos) {
+                dest_group->add_ds_file_info(std::move(ds_file_info));
+            }
 
-        if (candidate_count > winner_count) {
-            winner_count = candidate_count;
-            winner = candidate;
-            winner_i = i;
+            groupIndexes[dest_group].emplace_back(std::move(src_group->index));
         }
-    }
 
-    /* Merge all the other traces in the winning trace. */
-    for (ctf_fs_trace::UP& trace : traces) {
-        /* Don't merge the winner into itself. */
-        if (trace.get() == winner) {
-            continue;
+        for (const auto group : newGroups) {
+            if (group->stream_id != UINT64_C(-1)) {
+                destGroups.emplace(GroupKey {group->dataStreamCls->id(), group->stream_id}, group);
+            }
         }
+    }
 
-        /* Merge trace's data stream file groups into winner's. */
-        int ret = merge_matching_ctf_fs_ds_file_groups(winner, std::move(trace));
-        if (ret) {
-            return ret;
-        }
+    /* Merge the indexes of each group with a single k-way merge. */
+    for (auto& groupIndexesPair : groupIndexes) {
+        auto& indexes = groupIndexesPair.second;
+
+        indexes.insert(indexes.begin(), std::move(groupIndexesPair.first->index));
+        groupIndexesPair.first->index = merge_ctf_fs_ds_indexes(std::move(indexes));
     }
 
     /*
@@ -814,8 +1597,8 @@ static int decode_clock_snapshot_after_event(struct ctf_fs_trace *ctf_fs_trace,
 
     tempIndex.entries.emplace_back(index_entry);
 
-    ItemSeqIter itemSeqIter {bt2s::make_unique<fs::Medium>(tempIndex, logger), *ctf_fs_trace->cls(),
-                             index_entry.offsetInFile, logger};
+    ItemSeqIter itemSeqIter {fs::createMedium(fs::ReadMode::Mmap, tempIndex, 0, logger),
+                             *ctf_fs_trace->cls(), index_entry.offsetInFile, logger};
     LoggingItemVisitor loggingVisitor {logger};
 
     while (!visitor.done()) {
@@ -858,6 +1641,85 @@ static int decode_packet_last_event_timestamp(struct ctf_fs_trace *ctf_fs_trace,
                                              cs);
 }
 
+/*
+ * Sets the `end` timestamp of the entry `entryIdx` of `index` to the
+ * `begin` timestamp of the next entry, deferring it if the latter is
+ * itself pending.
+ */
+static void set_index_entry_end_to_next_begin(ctf_fs_ds_index& index, const size_t entryIdx)
+{
+    auto& entry = index.entries[entryIdx];
+    const auto& nextEntry = index.entries[entryIdx + 1];
+
+    if (nextEntry.beginIsFirstEventTs) {
+        entry.endIsNextBeginTs = true;
+    } else {
+        entry.timestamp_end = nextEntry.timestamp_begin;
+    }
+}
+
+void ctf_fs_ds_file_group_fix_index_entry_timestamps(ctf_fs_ds_file_group& ds_file_group,
+                                                     const size_t entryIdx,
+                                                     const bt2c::Logger& logger)
+{
+    auto& entries = ds_file_group.index.entries;
+
+    BT_ASSERT(entryIdx < entries.size());
+
+    auto& entry = entries[entryIdx];
+
+    if (!entry.timestampsArePending()) {
+        return;
+    }
+
+    BT_CPPLOGD_SPEC(logger,
+                    "Fixing packet index entry timestamps: path=\"{}\", "
+                    "pkt-offset-in-file-bytes={}, begin-is-first-event-ts={}, "
+                    "end-is-next-begin-ts={}, end-is-last-event-ts={}",
+                    entry.path, entry.offsetInFile.bytes(), entry.beginIsFirstEventTs,
+                    entry.endIsNextBeginTs, entry.endIsLastEventTs);
+
+    if (entry.beginIsFirstEventTs) {
+        if (decode_packet_first_event_timestamp(ds_file_group.ctf_fs_trace, entry, logger,
+                                                &entry.timestamp_begin)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Failed to decode first event's clock snapshot");
+        }
+
+        entry.beginIsFirstEventTs = false;
+    }
+
+    if (entry.endIsNextBeginTs) {
+        BT_ASSERT(entryIdx + 1 < entries.size());
+
+        /* Only the `begin` timestamp of the next entry matters */
+        auto& nextEntry = entries[entryIdx + 1];
+
+        if (nextEntry.beginIsFirstEventTs) {
+            if (decode_packet_first_event_timestamp(ds_file_group.ctf_fs_trace, nextEntry, logger,
+                                                    &nextEntry.timestamp_begin)) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    logger, bt2::Error, "Failed to decode first event's clock snapshot");
+            }
+
+            nextEntry.beginIsFirstEventTs = false;
+        }
+
+        entry.timestamp_end = nextEntry.timestamp_begin;
+        entry.endIsNextBeginTs = false;
+    }
+
+    if (entry.endIsLastEventTs) {
+        if (decode_packet_last_event_timestamp(ds_file_group.ctf_fs_trace, entry, logger,
+                                               &entry.timestamp_end)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Failed to decode last event's clock snapshot");
+        }
+
+        entry.endIsLastEventTs = false;
+    }
+}
+
 /*
  * Fix up packet index entries for lttng's "event-after-packet" bug.
  * Some buggy lttng tracer versions may emit events with a timestamp that is
@@ -876,51 +1738,29 @@ static int decode_packet_last_event_timestamp(struct ctf_fs_trace *ctf_fs_trace,
  *  - before lttng-module 2.10.10
  *  - before lttng-module 2.9.13
  */
-static int fix_index_lttng_event_after_packet_bug(struct ctf_fs_trace *trace,
-                                                  const bt2c::Logger& logger)
+static void fix_index_lttng_event_after_packet_bug(ctf_fs_ds_file_group& ds_file_group)
 {
-    for (const auto& ds_file_group : trace->ds_file_groups) {
-        BT_ASSERT(ds_file_group);
-        auto& index = ds_file_group->index;
-
-        BT_ASSERT(!index.entries.empty());
-
-        /*
-         * Iterate over all entries but the last one. The last one is
-         * fixed differently after.
-         */
-        for (size_t entry_i = 0; entry_i < index.entries.size() - 1; ++entry_i) {
-            auto& curr_entry = index.entries[entry_i];
-            const auto& next_entry = index.entries[entry_i + 1];
-
-            /*
-             * 1. Set the current index entry `end` timestamp to
-             * the next index entry `begin` timestamp.
-             */
-            curr_entry.timestamp_end = next_entry.timestamp_begin;
-        }
+    auto& index = ds_file_group.index;
 
-        /*
-         * 2. Fix the last entry by decoding the last event of the last
-         * packet.
-         */
-        auto& last_entry = index.entries.back();
+    BT_ASSERT(!index.entries.empty());
 
+    /*
+     * Iterate over all entries but the last one. The last one is
+     * fixed differently after.
+     */
+    for (size_t entry_i = 0; entry_i < index.entries.size() - 1; ++entry_i) {
         /*
-         * Decode packet to read the timestamp of the last event of the
-         * entry.
+         * 1. Set the current index entry `end` timestamp to
+         * the next index entry `begin` timestamp.
          */
-        int ret = decode_packet_last_event_timestamp(trace, last_entry, logger,
-                                                     &last_entry.timestamp_end);
-        if (ret) {
-            BT_CPPLOGE_APPEND_CAUSE_SPEC(
-                logger,
-                "Failed to decode stream's last packet to get its last event's clock snapshot.");
-            return ret;
-        }
+        set_index_entry_end_to_next_begin(index, entry_i);
     }
 
-    return 0;
+    /*
+     * 2. Fix the last entry by decoding the last event of the last
+     * packet, once needed.
+     */
+    index.entries.back().endIsLastEventTs = true;
 }
 
 /*
@@ -937,42 +1777,28 @@ static int fix_index_lttng_event_after_packet_bug(struct ctf_fs_trace *trace,
  * Known buggy tracer versions:
  *  - before barectf 2.3.1
  */
-static int fix_index_barectf_event_before_packet_bug(struct ctf_fs_trace *trace,
-                                                     const bt2c::Logger& logger)
+static void fix_index_barectf_event_before_packet_bug(ctf_fs_ds_file_group& ds_file_group)
 {
-    for (const auto& ds_file_group : trace->ds_file_groups) {
-        auto& index = ds_file_group->index;
+    auto& index = ds_file_group.index;
 
-        BT_ASSERT(!index.entries.empty());
+    BT_ASSERT(!index.entries.empty());
 
+    /*
+     * 1. Iterate over the index, starting from the second entry
+     * (index = 1).
+     */
+    for (size_t entry_i = 1; entry_i < index.entries.size(); ++entry_i) {
         /*
-         * 1. Iterate over the index, starting from the second entry
-         * (index = 1).
+         * 2. Set the current entry `begin` timestamp to the
+         * timestamp of the first event of the current packet, once
+         * needed.
+         *
+         * 3. Set the previous entry `end` timestamp to the
+         * timestamp of the first event of the current packet.
          */
-        for (size_t entry_i = 1; entry_i < index.entries.size(); ++entry_i) {
-            auto& prev_entry = index.entries[entry_i - 1];
-            auto& curr_entry = index.entries[entry_i];
-            /*
-             * 2. Set the current entry `begin` timestamp to the
-             * timestamp of the first event of the current packet.
-             */
-            int ret = decode_packet_first_event_timestamp(trace, curr_entry, logger,
-                                                          &curr_entry.timestamp_begin);
-            if (ret) {
-                BT_CPPLOGE_APPEND_CAUSE_SPEC(logger,
-                                             "Failed to decode first event's clock snapshot");
-                return ret;
-            }
-
-            /*
-             * 3. Set the previous entry `end` timestamp to the
-             * timestamp of the first event of the current packet.
-             */
-            prev_entry.timestamp_end = curr_entry.timestamp_begin;
-        }
+        index.entries[entry_i].beginIsFirstEventTs = true;
+        index.entries[entry_i - 1].endIsNextBeginTs = true;
     }
-
-    return 0;
 }
 
 /*
@@ -992,47 +1818,37 @@ static int fix_index_barectf_event_before_packet_bug(struct ctf_fs_trace *trace,
  * Affected versions:
  * - All current and future lttng-ust and lttng-modules versions.
  */
-static int fix_index_lttng_crash_quirk(struct ctf_fs_trace *trace, const bt2c::Logger& logger)
+static void fix_index_lttng_crash_quirk(ctf_fs_ds_file_group& ds_file_group)
 {
-    for (const auto& ds_file_group : trace->ds_file_groups) {
-        BT_ASSERT(ds_file_group);
-        auto& index = ds_file_group->index;
+    auto& index = ds_file_group.index;
 
-        BT_ASSERT(!index.entries.empty());
+    BT_ASSERT(!index.entries.empty());
 
-        auto& last_entry = index.entries.back();
+    auto& last_entry = index.entries.back();
 
-        /* 1. Fix the last entry first. */
-        if (last_entry.timestamp_end == 0 && last_entry.timestamp_begin != 0) {
-            /*
-             * Decode packet to read the timestamp of the
-             * last event of the stream file.
-             */
-            int ret = decode_packet_last_event_timestamp(trace, last_entry, logger,
-                                                         &last_entry.timestamp_end);
-            if (ret) {
-                BT_CPPLOGE_APPEND_CAUSE_SPEC(logger,
-                                             "Failed to decode last event's clock snapshot");
-                return ret;
-            }
-        }
+    /*
+     * 1. Fix the last entry first, decoding the last event of the
+     * stream file once needed.
+     *
+     * If the LTTng event-after-packet bug fixup already applies, then
+     * the fixed timestamp is the same.
+     */
+    if (last_entry.timestamp_end == 0 && last_entry.timestamp_begin != 0) {
+        last_entry.endIsLastEventTs = true;
+    }
 
-        /* Iterate over all entries but the last one. */
-        for (size_t entry_idx = 0; entry_idx < index.entries.size() - 1; ++entry_idx) {
-            auto& curr_entry = index.entries[entry_idx];
-            const auto& next_entry = index.entries[entry_idx + 1];
+    /* Iterate over all entries but the last one. */
+    for (size_t entry_idx = 0; entry_idx < index.entries.size() - 1; ++entry_idx) {
+        const auto& curr_entry = index.entries[entry_idx];
 
-            if (curr_entry.timestamp_end == 0 && curr_entry.timestamp_begin != 0) {
-                /*
-                 * 2. Set the current index entry `end` timestamp to
-                 * the next index entry `begin` timestamp.
-                 */
-                curr_entry.timestamp_end = next_entry.timestamp_begin;
-            }
+        if (curr_entry.timestamp_end == 0 && curr_entry.timestamp_begin != 0) {
+            /*
+             * 2. Set the current index entry `end` timestamp to
+             * the next index entry `begin` timestamp.
+             */
+            set_index_entry_end_to_next_begin(index, entry_idx);
         }
     }
-
-    return 0;
 }
 
 /*
@@ -1182,9 +1998,36 @@ static bool is_tracer_affected_by_lttng_crash_quirk(struct tracer_info *curr_tra
     return is_affected;
 }
 
+/*
+ * Fixes up the index of `ds_file_group` for the known tracer bugs which
+ * `quirks` indicates (see fix_packet_index_tracer_bugs()).
+ *
+ * The fixups which require decoding packets only mark the index entries
+ * (see ctf_fs_ds_file_group_fix_index_entry_timestamps()), so that this
+ * function doesn't read any data stream file.
+ */
+static void fix_ds_file_group_index_tracer_bugs(ctf_fs_ds_file_group& ds_file_group,
+                                                const ctf::src::MsgIterQuirks& quirks)
+{
+    if (quirks.eventRecordDefClkValGtNextPktBeginDefClkVal) {
+        fix_index_lttng_event_after_packet_bug(ds_file_group);
+    }
+
+    if (quirks.eventRecordDefClkValLtPktBeginDefClkVal) {
+        fix_index_barectf_event_before_packet_bug(ds_file_group);
+    }
+
+    if (quirks.pktEndDefClkValZero) {
+        fix_index_lttng_crash_quirk(ds_file_group);
+    }
+}
+
 /*
  * Looks for trace produced by known buggy tracers and fix up the index
  * produced earlier.
+ *
+ * In lazy index mode, this function only sets the quirks of `ctf_fs`:
+ * ensure_ds_file_group_index() fixes up each index once it's built.
  */
 static int fix_packet_index_tracer_bugs(ctf_fs_component *ctf_fs)
 {
@@ -1209,37 +2052,29 @@ static int fix_packet_index_tracer_bugs(ctf_fs_component *ctf_fs)
     if (is_tracer_affected_by_lttng_event_after_packet_bug(&current_tracer_info)) {
         BT_CPPLOGI_SPEC(ctf_fs->logger,
                         "Trace may be affected by LTTng tracer packet timestamp bug. Fixing up.");
-        ret = fix_index_lttng_event_after_packet_bug(ctf_fs->trace.get(), ctf_fs->logger);
-        if (ret) {
-            BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger,
-                                         "Failed to fix LTTng event-after-packet bug.");
-            return ret;
-        }
         ctf_fs->quirks.eventRecordDefClkValGtNextPktBeginDefClkVal = true;
     }
 
     if (is_tracer_affected_by_barectf_event_before_packet_bug(&current_tracer_info)) {
         BT_CPPLOGI_SPEC(ctf_fs->logger,
                         "Trace may be affected by barectf tracer packet timestamp bug. Fixing up.");
-        ret = fix_index_barectf_event_before_packet_bug(ctf_fs->trace.get(), ctf_fs->logger);
-        if (ret) {
-            BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger,
-                                         "Failed to fix barectf event-before-packet bug.");
-            return ret;
-        }
         ctf_fs->quirks.eventRecordDefClkValLtPktBeginDefClkVal = true;
     }
 
     if (is_tracer_affected_by_lttng_crash_quirk(&current_tracer_info)) {
-        ret = fix_index_lttng_crash_quirk(ctf_fs->trace.get(), ctf_fs->logger);
-        if (ret) {
-            BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger,
-                                         "Failed to fix lttng-crash timestamp quirks.");
-            return ret;
-        }
         ctf_fs->quirks.pktEndDefClkValZero = true;
     }
 
+    for (const auto& ds_file_group : ctf_fs->trace->ds_file_groups) {
+        BT_ASSERT(ds_file_group);
+
+        if (!ds_file_group->indexBuilt) {
+            continue;
+        }
+
+        fix_ds_file_group_index_tracer_bugs(*ds_file_group, ctf_fs->quirks);
+    }
+
     return 0;
 }
 
@@ -1274,14 +2109,66 @@ int ctf_fs_component_create_ctf_fs_trace(
 
     std::sort(paths.begin(), paths.end());
 
-    /* Create a separate ctf_fs_trace object for each path. */
+    /*
+     * Read the metadata streams and list the data stream files of all
+     * the trace directories concurrently.
+     */
+    std::vector<ctf_fs_trace_dir> dirs(paths.size());
+    MetadataStreamSet metadataStreams;
+
+    run_concurrently(
+        paths.size(),
+        [&](const std::size_t i) {
+            try {
+                read_trace_dir(paths[i], dirs[i], metadataStreams, ctf_fs->logger);
+            } catch (...) {
+                /* Let the calling thread handle it. */
+                dirs[i].exc.capture();
+            }
+        },
+        "Reading trace directories", ctf_fs->logger);
+
+    /*
+     * Create a separate ctf_fs_trace object for each path, in order.
+     *
+     * Creating trace IR objects isn't thread-safe: the parsing of the
+     * metadata streams remains serial, but traces having the exact same
+     * metadata stream share their parsed trace class.
+     */
     std::vector<ctf_fs_trace::UP> traces;
-    for (const auto& path : paths) {
-        int ret = ctf_fs_component_create_ctf_fs_trace_one_path(ctf_fs, path.c_str(), traceName,
-                                                                traces, selfComp);
-        if (ret) {
-            return ret;
+    ctf_fs_metadata_cache metadataCache;
+    std::vector<indexed_ds_file> files;
+
+    for (std::size_t i = 0; i < dirs.size(); ++i) {
+        auto& dir = dirs[i];
+
+        try {
+            dir.exc.rethrowIfAny();
+        } catch (const bt2::Error&) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW_SPEC(ctf_fs->logger, "Cannot create trace for `{}`.",
+                                                     paths[i]);
+        }
+
+        auto trace = ctf_fs_trace_create(
+            dir.path.c_str(), traceName, ctf_fs->clkClsCfg, ctf_fs->indexCache, ctf_fs->lazyIndex,
+            selfComp,
+            bt2c::ConstBytes {reinterpret_cast<const std::uint8_t *>(dir.metadata->data()),
+                              dir.metadata->size()},
+            metadataCache, ctf_fs->logger);
+
+        for (auto& dsFilePath : dir.dsFilePaths) {
+            files.emplace_back();
+            files.back().trace = trace.get();
+            files.back().path = std::move(dsFilePath);
         }
+
+        traces.emplace_back(std::move(trace));
+    }
+
+    /* Index the data stream files of all the traces at once */
+    if (create_ds_file_groups(files, ctf_fs->logger)) {
+        BT_CPPLOGE_APPEND_CAUSE_SPEC(ctf_fs->logger, "Cannot create data stream file groups.");
+        return -1;
     }
 
     if (traces.size() > 1) {
@@ -1350,7 +2237,9 @@ int ctf_fs_component_create_ctf_fs_trace(
      * offset in the logical data stream.
      */
     for (ctf_fs_ds_file_group::UP& group : ctf_fs->trace->ds_file_groups) {
-        group->index.updateOffsetsInStream();
+        if (group->indexBuilt) {
+            group->index.updateOffsetsInStream();
+        }
     }
 
     return 0;
@@ -1409,6 +2298,16 @@ static bt_param_validation_map_value_entry_descr fs_params_entries_descr[] = {
      bt_param_validation_value_descr::makeSignedInteger()},
     {"force-clock-class-origin-unix-epoch", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeBool()},
+    {"mmap-window-size", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    {"read-mode", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeString()},
+    {"index-cache", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"lazy-index", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeBool()},
+    {"stream-shard-count", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
 
 ctf::src::fs::Parameters read_src_fs_parameters(const bt2::ConstValue params,
@@ -1446,9 +2345,245 @@ ctf::src::fs::Parameters read_src_fs_parameters(const bt2::ConstValue params,
         parameters.traceName = traceName->asString().value().str();
     }
 
+    /* mmap-window-size parameter */
+    if (const auto mmapWindowSize = params["mmap-window-size"]) {
+        const auto val = mmapWindowSize->asSignedInteger().value();
+
+        if (val <= 0) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2c::Error, "Invalid `mmap-window-size` parameter: value={}", val);
+        }
+
+        parameters.mmapWindowSize = static_cast<size_t>(val);
+    }
+
+    /* index-cache parameter */
+    if (const auto indexCache = params["index-cache"]) {
+        parameters.indexCache = indexCache->asBool().value();
+    }
+
+    /* lazy-index parameter */
+    if (const auto lazyIndex = params["lazy-index"]) {
+        parameters.lazyIndex = lazyIndex->asBool().value();
+    }
+
+    /* stream-shard-count parameter */
+    if (const auto streamShardCount = params["stream-shard-count"]) {
+        const auto val = streamShardCount->asSignedInteger().value();
+
+        if (val <= 0 || val > UINT_MAX) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2c::Error, "Invalid `stream-shard-count` parameter: value={}", val);
+        }
+
+        if (val > 1 && parameters.lazyIndex) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2c::Error,
+                "Cannot split data streams into shards with the `lazy-index` parameter: "
+                "splitting needs the indexes when the component initializes");
+        }
+
+        parameters.streamShardCount = static_cast<unsigned int>(val);
+    }
+
+    /* read-mode parameter */
+    if (const auto readMode = params["read-mode"]) {
+        const auto val = readMode->asString().value();
+
+        if (val == "mmap") {
+            parameters.readMode = ctf::src::fs::ReadMode::Mmap;
+        } else if (val == "mmap-prefault") {
+            parameters.readMode = ctf::src::fs::ReadMode::MmapPrefault;
+        } else if (val == "pread") {
+            parameters.readMode = ctf::src::fs::ReadMode::Pread;
+        } else {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2c::Error,
+                                                   "Invalid `read-mode` parameter: expecting "
+                                                   "`mmap`, `mmap-prefault`, or `pread`: "
+                                                   "value=\"{}\"",
+                                                   val);
+        }
+    }
+
     return parameters;
 }
 
+namespace {
+
+/* Size and modification time of a file or directory */
+struct ctf_fs_file_stamp
+{
+    std::string path;
+    off_t size;
+    time_t mtime;
+
+    bool operator==(const ctf_fs_file_stamp& other) const noexcept
+    {
+        return path == other.path && size == other.size && mtime == other.mtime;
+    }
+};
+
+/* State which ctf_fs_stash_trace() stashes */
+struct ctf_fs_query_stash
+{
+    ctf_fs_trace::UP trace;
+
+    /*
+     * Stamps of the input directories, of their metadata files, and of
+     * the data stream files of `trace` when stashing it.
+     */
+    std::vector<ctf_fs_file_stamp> stamps;
+};
+
+} /* namespace */
+
+/*
+ * Returns the key of the stashed trace of which the inputs and the
+ * trace-level settings are those of `parameters`, `indexCache`, and
+ * `lazyIndex`, and of which the objects log with the level of `logger`.
+ */
+static bt2::Value::Shared make_query_stash_key(const ctf::src::fs::Parameters& parameters,
+                                               const bool indexCache, const bool lazyIndex,
+                                               const bt2c::Logger& logger)
+{
+    std::vector<std::string> inputs;
+
+    for (const auto input : parameters.inputs) {
+        inputs.emplace_back(input.asString().value().str());
+    }
+
+    /* The order of the inputs doesn't matter */
+    std::sort(inputs.begin(), inputs.end());
+
+    const auto key = bt2::MapValue::create();
+    const auto inputsVal = key->insertEmptyArray("inputs");
+
+    for (const auto& input : inputs) {
+        inputsVal.append(input.c_str());
+    }
+
+    key->insert("clock-class-offset-s", static_cast<std::int64_t>(parameters.clkClsCfg.offsetSec));
+    key->insert("clock-class-offset-ns",
+                static_cast<std::int64_t>(parameters.clkClsCfg.offsetNanoSec));
+    key->insert("force-clock-class-origin-unix-epoch",
+                parameters.clkClsCfg.forceOriginIsUnixEpoch);
+    key->insert("index-cache", indexCache);
+    key->insert("lazy-index", lazyIndex);
+
+    /* The objects of a trace keep the logger of their creator */
+    key->insert("log-level", static_cast<std::int64_t>(logger.level()));
+    return key;
+}
+
+/*
+ * Returns the stamps of the inputs of `parameters`, of their metadata
+ * files, and of the data stream files of `trace`, or `bt2s::nullopt`
+ * if any of them is missing.
+ */
+static bt2s::optional<std::vector<ctf_fs_file_stamp>>
+get_query_stash_stamps(const ctf::src::fs::Parameters& parameters, const ctf_fs_trace& trace)
+{
+    std::vector<std::string> paths;
+
+    for (const auto input : parameters.inputs) {
+        paths.emplace_back(input.asString().value().str());
+        paths.emplace_back(paths.back() + G_DIR_SEPARATOR_S CTF_FS_METADATA_FILENAME);
+    }
+
+    for (const auto& group : trace.ds_file_groups) {
+        for (const auto& ds_file_info : group->ds_file_infos) {
+            paths.emplace_back(ds_file_info->path());
+        }
+    }
+
+    std::vector<ctf_fs_file_stamp> stamps;
+
+    for (auto& path : paths) {
+        struct stat st;
+
+        if (stat(path.c_str(), &st) != 0) {
+            return bt2s::nullopt;
+        }
+
+        stamps.push_back({std::move(path), st.st_size, st.st_mtime});
+    }
+
+    return stamps;
+}
+
+static void destroy_query_stash(void * const data)
+{
+    delete static_cast<ctf_fs_query_stash *>(data);
+}
+
+void ctf_fs_stash_trace(const bt2::PrivateQueryExecutor privQueryExec,
+                        const ctf::src::fs::Parameters& parameters, ctf_fs_trace::UP trace,
+                        const bt2c::Logger& logger)
+{
+    BT_ASSERT(trace);
+
+    auto stamps = get_query_stash_stamps(parameters, *trace);
+
+    if (!stamps) {
+        BT_CPPLOGD_SPEC(logger, "Not stashing trace: missing file: trace-path=\"{}\"",
+                        trace->path);
+        return;
+    }
+
+    try {
+        const auto key =
+            make_query_stash_key(parameters, trace->useIndexCache, trace->lazyIndex, logger);
+        std::unique_ptr<ctf_fs_query_stash> stash {new ctf_fs_query_stash};
+
+        stash->trace = std::move(trace);
+        stash->stamps = std::move(*stamps);
+        privQueryExec.stash(*key, stash.get(), destroy_query_stash);
+        BT_CPPLOGD_SPEC(logger, "Stashed trace: trace-path=\"{}\"", stash->trace->path);
+        stash.release();
+    } catch (const bt2::MemoryError&) {
+        bt_current_thread_clear_error();
+        BT_CPPLOGW_SPEC(logger, "Cannot stash trace: out of memory.");
+    }
+}
+
+/*
+ * Takes the trace which a `babeltrace.trace-infos` query stashed for
+ * the parameters `parameters` (see ctf_fs_stash_trace()), creating its
+ * trace IR objects from `selfComp`, or returns `nullptr` if there's
+ * none or if any of its files changed since.
+ */
+static ctf_fs_trace::UP take_stashed_trace(const ctf::src::fs::Parameters& parameters,
+                                           const bt2::SelfComponent selfComp,
+                                           const bt2c::Logger& logger)
+{
+    const auto key =
+        make_query_stash_key(parameters, parameters.indexCache, parameters.lazyIndex, logger);
+    std::unique_ptr<ctf_fs_query_stash> stash {
+        static_cast<ctf_fs_query_stash *>(selfComp.takeQueryStash(*key))};
+
+    if (!stash) {
+        return nullptr;
+    }
+
+    const auto stamps = get_query_stash_stamps(parameters, *stash->trace);
+
+    if (!stamps || *stamps != stash->stamps) {
+        BT_CPPLOGI_SPEC(logger, "Ignoring stale stashed trace: trace-path=\"{}\"",
+                        stash->trace->path);
+        return nullptr;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "Reusing the trace which a query built: trace-path=\"{}\"",
+                    stash->trace->path);
+
+    auto& trace = *stash->trace;
+
+    trace.translateCls(selfComp);
+    create_ir_trace(trace, parameters.traceName ? parameters.traceName->c_str() : nullptr,
+                    selfComp, logger);
+    return std::move(stash->trace);
+}
+
 static ctf_fs_component::UP ctf_fs_create(const bt2::ConstMapValue params,
                                           const bt2::SelfSourceComponent selfSrcComp)
 {
@@ -1456,7 +2591,17 @@ static ctf_fs_component::UP ctf_fs_create(const bt2::ConstMapValue params,
     const auto parameters = read_src_fs_parameters(params, logger);
     auto ctf_fs = bt2s::make_unique<ctf_fs_component>(parameters.clkClsCfg, logger);
 
-    if (ctf_fs_component_create_ctf_fs_trace(ctf_fs.get(), parameters.inputs,
+    ctf_fs->mmapWindowSize = parameters.mmapWindowSize;
+    ctf_fs->readMode = parameters.readMode;
+    ctf_fs->indexCache = parameters.indexCache;
+    ctf_fs->lazyIndex = parameters.lazyIndex;
+    ctf_fs->streamShardCount = parameters.streamShardCount;
+
+    ctf_fs->trace =
+        take_stashed_trace(parameters, static_cast<bt2::SelfComponent>(selfSrcComp), logger);
+
+    if (!ctf_fs->trace &&
+        ctf_fs_component_create_ctf_fs_trace(ctf_fs.get(), parameters.inputs,
                                              parameters.traceName ? parameters.traceName->c_str() :
                                                                     nullptr,
                                              static_cast<bt2::SelfComponent>(selfSrcComp))) {
@@ -1484,6 +2629,11 @@ ctf_fs_get_supported_mip_versions(bt_self_component_class_source *selfCompClsSrc
         const auto parameters = read_src_fs_parameters(bt2::ConstMapValue {params}, logger);
         auto ctf_fs = bt2s::make_unique<ctf_fs_component>(parameters.clkClsCfg, logger);
 
+        ctf_fs->indexCache = parameters.indexCache;
+
+        /* Only the metadata matters here */
+        ctf_fs->lazyIndex = true;
+
         if (ctf_fs_component_create_ctf_fs_trace(
                 ctf_fs.get(), parameters.inputs,
                 parameters.traceName ? parameters.traceName->c_str() : nullptr, {})) {
@@ -1543,7 +2693,12 @@ bt_component_class_query_method_status ctf_fs_query(bt_self_component_class_sour
         if (strcmp(object, "metadata-info") == 0) {
             resultObj = metadata_info_query(paramsObj, logger);
         } else if (strcmp(object, "babeltrace.trace-infos") == 0) {
-            resultObj = trace_infos_query(paramsObj, logger);
+            resultObj =
+                trace_infos_query(paramsObj, bt2::PrivateQueryExecutor {priv_query_exec}, logger);
+        } else if (strcmp(object, "event-record-stats") == 0) {
+            resultObj = event_record_stats_query(paramsObj, logger);
+        } else if (strcmp(object, "event-record-histogram") == 0) {
+            resultObj = event_record_histogram_query(paramsObj, logger);
         } else if (!strcmp(object, "babeltrace.support-info")) {
             resultObj = support_info_query(paramsObj, logger);
         } else {
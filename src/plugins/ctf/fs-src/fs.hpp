@@ -10,10 +10,18 @@
 #ifndef BABELTRACE_PLUGINS_CTF_FS_SRC_FS_HPP
 #define BABELTRACE_PLUGINS_CTF_FS_SRC_FS_HPP
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 #include <glib.h>
 
 #include <babeltrace2/babeltrace.h>
 
+#include "cpp-common/bt2/message.hpp"
+#include "cpp-common/bt2/private-query-executor.hpp"
 #include "cpp-common/bt2c/aliases.hpp"
 #include "cpp-common/bt2c/logging.hpp"
 
@@ -25,6 +33,19 @@
 
 extern bool ctf_fs_debug;
 
+/*
+ * Metadata stream parsing results of a given component, by complete
+ * metadata stream content.
+ *
+ * When a `src.ctf.fs` component opens many trace directories having
+ * the exact same metadata stream (for example, the trace chunks of an
+ * LTTng tracing session rotation), the traces share a single parsed
+ * trace class, as well as its trace IR trace class, instead of parsing
+ * the same metadata stream again for each directory.
+ */
+using ctf_fs_metadata_cache =
+    std::unordered_map<std::string, std::shared_ptr<const ctf::src::MetadataStreamParser::ParseRet>>;
+
 struct ctf_fs_trace
 {
     using UP = std::unique_ptr<ctf_fs_trace>;
@@ -56,9 +77,37 @@ struct ctf_fs_trace
         return _mParseRet->metadataVersion;
     }
 
-    void parseMetadata(const bt2c::ConstBytes buffer)
+    /*
+     * Parses the metadata stream `buffer`, reusing the result of an
+     * identical metadata stream from `cache`, if any, and adding the
+     * new result to `cache` otherwise.
+     */
+    void parseMetadata(const bt2c::ConstBytes buffer, ctf_fs_metadata_cache& cache)
+    {
+        std::string key {reinterpret_cast<const char *>(buffer.data()), buffer.size()};
+        auto& parseRet = cache[std::move(key)];
+
+        if (parseRet) {
+            BT_CPPLOGD_SPEC(_mLogger, "Reusing the parsed metadata stream of another trace.");
+        } else {
+            parseRet = std::make_shared<const ctf::src::MetadataStreamParser::ParseRet>(
+                ctf::src::parseMetadataStream(_mSelfComp, _mClkClsCfg, buffer, _mLogger));
+        }
+
+        _mParseRet = parseRet;
+    }
+
+    /*
+     * Translates the parsed trace class, which a metadata stream parser
+     * without a self component created (query method), to trace IR
+     * objects created from `selfComp`.
+     */
+    void translateCls(const bt2::SelfComponent selfComp)
     {
-        _mParseRet = ctf::src::parseMetadataStream(_mSelfComp, _mClkClsCfg, buffer, _mLogger);
+        BT_ASSERT(_mParseRet);
+        BT_ASSERT(_mParseRet->traceCls);
+        ctf::src::translateTraceClsToLib(*_mParseRet->traceCls, selfComp);
+        _mSelfComp = selfComp;
     }
 
     bt2::Trace::Shared trace;
@@ -67,6 +116,15 @@ struct ctf_fs_trace
 
     std::string path;
 
+    /* Whether or not to use index cache files (see `index-cache.hpp`) */
+    bool useIndexCache = false;
+
+    /*
+     * Whether or not the message iterators build the indexes of the
+     * data stream file groups on demand.
+     */
+    bool lazyIndex = false;
+
     /* Next automatic stream ID when not provided by packet header */
     uint64_t next_stream_id = 0;
 
@@ -74,7 +132,9 @@ private:
     bt2c::Logger _mLogger;
     ctf::src::ClkClsCfg _mClkClsCfg;
     bt2::OptionalBorrowedObject<bt2::SelfComponent> _mSelfComp;
-    bt2s::optional<ctf::src::MetadataStreamParser::ParseRet> _mParseRet;
+
+    /* Possibly shared with other traces of the same component */
+    std::shared_ptr<const ctf::src::MetadataStreamParser::ParseRet> _mParseRet;
 };
 
 struct ctf_fs_port_data
@@ -86,6 +146,28 @@ struct ctf_fs_port_data
 
     /* Weak */
     struct ctf_fs_component *ctf_fs = nullptr;
+
+    /*
+     * Range of packets of `ds_file_group`, as entries of its index,
+     * which this port covers: the whole data stream unless the
+     * component splits it into shards.
+     *
+     * `shardEndEntryIdx` isn't set when the range reaches the end of
+     * the data stream.
+     */
+    std::size_t shardBeginEntryIdx = 0;
+    bt2s::optional<std::size_t> shardEndEntryIdx;
+
+    /*
+     * Stream of the shard of this port, or null to use the stream of
+     * `ds_file_group`.
+     */
+    bt2::Stream::Shared shardStream;
+
+    bt2::Stream stream() const noexcept
+    {
+        return shardStream ? *shardStream : *ds_file_group->stream;
+    }
 };
 
 struct ctf_fs_component
@@ -106,6 +188,18 @@ struct ctf_fs_component
 
     ctf::src::ClkClsCfg clkClsCfg;
     ctf::src::MsgIterQuirks quirks;
+
+    /* Maximum length of a data stream file mapping or read (0 means default) */
+    size_t mmapWindowSize = 0;
+
+    ctf::src::fs::ReadMode readMode = ctf::src::fs::ReadMode::Mmap;
+
+    bool indexCache = false;
+
+    bool lazyIndex = false;
+
+    /* Maximum number of shards of a data stream (1 means no splitting) */
+    unsigned int streamShardCount = 1;
 };
 
 struct ctf_fs_msg_iter_data
@@ -126,6 +220,21 @@ struct ctf_fs_msg_iter_data
 
     bt2s::optional<ctf::src::MsgIter> msgIter;
 
+    /*
+     * Time, in nanoseconds from origin, of the last seek operation
+     * while `msgIter` didn't return a message at or after it yet.
+     *
+     * While it's set, ctf_fs_iterator_next() drops the messages
+     * preceding this time, holding back the beginning messages of the
+     * current stream and packet below.
+     */
+    bt2s::optional<std::int64_t> seekNsFromOrigin;
+    bt2::ConstMessage::Shared seekStreamBeginMsg;
+    bt2::ConstMessage::Shared seekPktBeginMsg;
+
+    /* Messages to return before getting the next one from `msgIter` */
+    std::deque<bt2::ConstMessage::Shared> queuedMsgs;
+
     /*
      * Saved error.  If we hit an error in the _next method, but have some
      * messages ready to return, we save the error here and return it on
@@ -166,6 +275,14 @@ ctf_fs_iterator_next(bt_self_message_iterator *iterator, bt_message_array_const
 bt_message_iterator_class_seek_beginning_method_status
 ctf_fs_iterator_seek_beginning(bt_self_message_iterator *message_iterator);
 
+bt_message_iterator_class_seek_ns_from_origin_method_status
+ctf_fs_iterator_seek_ns_from_origin(bt_self_message_iterator *message_iterator,
+                                    int64_t ns_from_origin);
+
+bt_message_iterator_class_can_seek_ns_from_origin_method_status
+ctf_fs_iterator_can_seek_ns_from_origin(bt_self_message_iterator *message_iterator,
+                                        int64_t ns_from_origin, bt_bool *can_seek);
+
 /*
  * Create one `struct ctf_fs_trace` from one trace, or multiple traces sharing
  * the same UUID.
@@ -194,6 +311,14 @@ struct Parameters
     bt2::ConstArrayValue inputs;
     bt2s::optional<std::string> traceName;
     ClkClsCfg clkClsCfg;
+
+    /* 0 means default */
+    size_t mmapWindowSize = 0;
+
+    ReadMode readMode = ReadMode::Mmap;
+    bool indexCache = false;
+    bool lazyIndex = false;
+    unsigned int streamShardCount = 1;
 };
 
 } /* namespace fs */
@@ -208,6 +333,31 @@ struct Parameters
 
 ctf::src::fs::Parameters read_src_fs_parameters(bt2::ConstValue params, const bt2c::Logger& logger);
 
+/*
+ * Stashes `trace`, which a query built without a self component from
+ * the parameters `parameters`, within the component class so that the
+ * initialization method of a future component having equivalent
+ * parameters reuses it instead of parsing the metadata streams and
+ * indexing the data stream files again.
+ *
+ * Only logs on error.
+ */
+void ctf_fs_stash_trace(bt2::PrivateQueryExecutor privQueryExec,
+                        const ctf::src::fs::Parameters& parameters, ctf_fs_trace::UP trace,
+                        const bt2c::Logger& logger);
+
+/*
+ * Applies the pending tracer bug fixups of the timestamps of the index
+ * entry `entryIdx` of `ds_file_group`, if any, decoding packets as
+ * needed.
+ *
+ * Throws `bt2::Error` on error.
+ */
+
+void ctf_fs_ds_file_group_fix_index_entry_timestamps(ctf_fs_ds_file_group& ds_file_group,
+                                                     std::size_t entryIdx,
+                                                     const bt2c::Logger& logger);
+
 /*
  * Generate the port name to be used for a given data stream file group.
  */
@@ -0,0 +1,783 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <sys/stat.h>
+
+#include "common/assert.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/file-utils.hpp"
+#include "cpp-common/bt2c/glib-up.hpp"
+#include "cpp-common/bt2c/libc-up.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "index-cache.hpp"
+
+using namespace bt2c::literals::datalen;
+
+#define CTF_FS_INDEX_CACHE_MAGIC   0xB7FD1CAC
+#define CTF_FS_INDEX_CACHE_VERSION 1
+
+#define CTF_FS_SUMMARY_CACHE_MAGIC   0xB7F5C0DE
+#define CTF_FS_SUMMARY_CACHE_VERSION 1
+
+/* Maximum total number of packets of the in-memory index cache */
+#define CTF_FS_INDEX_MEM_CACHE_MAX_PACKET_COUNT (UINT64_C(1) << 18)
+
+namespace {
+
+/*
+ * Header at the beginning of each index cache file.
+ * All integer fields are stored in big endian.
+ */
+struct ctf_fs_index_cache_hdr
+{
+    uint32_t magic;
+    uint32_t version;
+
+    /* size of struct ctf_fs_index_cache_entry, in bytes. */
+    uint32_t entry_len;
+    uint32_t reserved;
+
+    /* size and modification time of the data stream file */
+    uint64_t file_size;
+    uint64_t file_mtime_sec;
+    uint64_t file_mtime_nsec;
+} __attribute__((__packed__));
+
+/*
+ * Index cache entry of one packet.
+ * All integer fields are stored in big endian.
+ */
+struct ctf_fs_index_cache_entry
+{
+    uint64_t offset;      /* offset of the packet in the file, in bytes */
+    uint64_t packet_size; /* packet size, in bytes */
+    uint64_t timestamp_begin;
+    uint64_t timestamp_end;
+    uint64_t packet_seq_num;
+} __attribute__((__packed__));
+
+/*
+ * Header at the beginning of each summary cache file.
+ * All integer fields are stored in big endian.
+ *
+ * The header is followed by `level_count` levels, each one being a
+ * `ctf_fs_summary_cache_level` followed by its buckets.
+ */
+struct ctf_fs_summary_cache_hdr
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t level_count;
+
+    /* size of struct ctf_fs_summary_cache_bucket, in bytes. */
+    uint32_t bucket_len;
+
+    /* size and modification time of the data stream file */
+    uint64_t file_size;
+    uint64_t file_mtime_sec;
+    uint64_t file_mtime_nsec;
+} __attribute__((__packed__));
+
+/*
+ * Summary cache level.
+ * All integer fields are stored in big endian.
+ */
+struct ctf_fs_summary_cache_level
+{
+    uint64_t bucket_dur_ns;
+    uint64_t bucket_count;
+} __attribute__((__packed__));
+
+/*
+ * Summary cache bucket.
+ * All integer fields are stored in big endian.
+ */
+struct ctf_fs_summary_cache_bucket
+{
+    uint64_t index; /* two's complement */
+    uint64_t event_record_class_id;
+    uint64_t event_record_count;
+    uint64_t event_record_total_len_bits;
+} __attribute__((__packed__));
+
+struct file_stamp
+{
+    uint64_t size;
+    uint64_t mtimeSec;
+    uint64_t mtimeNsec;
+};
+
+bt2s::optional<file_stamp> get_file_stamp(const ctf_fs_ds_file_info& fileInfo)
+{
+    struct stat st;
+
+    if (stat(fileInfo.path().c_str(), &st) != 0) {
+        return bt2s::nullopt;
+    }
+
+    file_stamp stamp;
+
+    stamp.size = static_cast<uint64_t>(st.st_size);
+    stamp.mtimeSec = static_cast<uint64_t>(st.st_mtime);
+#if defined(__APPLE__)
+    stamp.mtimeNsec = static_cast<uint64_t>(st.st_mtimespec.tv_nsec);
+#elif defined(__MINGW32__)
+    stamp.mtimeNsec = 0;
+#else
+    stamp.mtimeNsec = static_cast<uint64_t>(st.st_mtim.tv_nsec);
+#endif
+    return stamp;
+}
+
+bool operator==(const file_stamp& left, const file_stamp& right) noexcept
+{
+    return left.size == right.size && left.mtimeSec == right.mtimeSec &&
+           left.mtimeNsec == right.mtimeNsec;
+}
+
+/*
+ * Packet of the index of a data stream file within the in-memory index
+ * cache, without any reference to a `ctf_fs_ds_file_info` instance.
+ */
+struct mem_cache_pkt
+{
+    bt2c::DataLen offsetInFile;
+    bt2c::DataLen packetSize;
+    uint64_t timestampBegin;
+    uint64_t timestampEnd;
+    uint64_t packetSeqNum;
+};
+
+/* In-memory index cache entry: index of a single data stream file */
+struct mem_cache_entry
+{
+    std::string path;
+    file_stamp stamp;
+    bt2c::DataLen size = 0_bytes;
+    std::vector<mem_cache_pkt> pkts;
+};
+
+struct mem_cache
+{
+    /* Protects the members below */
+    std::mutex mutex;
+
+    /* Most recently used first */
+    std::list<mem_cache_entry> entries;
+
+    /* Total number of packets of `entries` */
+    uint64_t pktCount = 0;
+};
+
+mem_cache& get_mem_cache()
+{
+    static mem_cache cache;
+
+    return cache;
+}
+
+/*
+ * Returns the path of the cache file of `fileInfo` having the
+ * extension `ext`.
+ */
+std::string cache_path(const ctf_fs_ds_file_info& fileInfo, const char * const ext)
+{
+    const bt2c::GCharUP basename {g_path_get_basename(fileInfo.path().c_str())};
+    const bt2c::GCharUP directory {g_path_get_dirname(fileInfo.path().c_str())};
+
+    return fmt::format("{}" G_DIR_SEPARATOR_S "index" G_DIR_SEPARATOR_S "{}.{}", directory.get(),
+                       basename.get(), ext);
+}
+
+std::string index_cache_path(const ctf_fs_ds_file_info& fileInfo)
+{
+    return cache_path(fileInfo, "bt-idx");
+}
+
+std::string summary_cache_path(const ctf_fs_ds_file_info& fileInfo)
+{
+    return cache_path(fileInfo, "bt-summary");
+}
+
+/* Floored division of `dividend` by `divisor` */
+int64_t floor_div(const int64_t dividend, const int64_t divisor) noexcept
+{
+    const auto quotient = dividend / divisor;
+
+    return (dividend % divisor != 0 && dividend < 0) ? quotient - 1 : quotient;
+}
+
+} /* namespace */
+
+bt2s::optional<ctf_fs_ds_index> ctf_fs_ds_index_cache_read(const ctf_fs_ds_file_info& fileInfo)
+{
+    const auto& logger = fileInfo.logger();
+    const auto path = index_cache_path(fileInfo);
+    std::vector<std::uint8_t> data;
+
+    try {
+        data = bt2c::dataFromFile(path, logger, false);
+    } catch (const bt2c::NoSuchFileOrDirectoryError&) {
+        return bt2s::nullopt;
+    }
+
+    ctf_fs_index_cache_hdr hdr;
+
+    if (data.size() < sizeof(hdr)) {
+        BT_CPPLOGW_SPEC(logger, "Invalid index cache file: file size < header size: path=\"{}\"",
+                        path);
+        return bt2s::nullopt;
+    }
+
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+
+    if (be32toh(hdr.magic) != CTF_FS_INDEX_CACHE_MAGIC ||
+        be32toh(hdr.version) != CTF_FS_INDEX_CACHE_VERSION ||
+        be32toh(hdr.entry_len) != sizeof(ctf_fs_index_cache_entry) ||
+        (data.size() - sizeof(hdr)) % sizeof(ctf_fs_index_cache_entry) != 0) {
+        BT_CPPLOGW_SPEC(logger, "Invalid or unsupported index cache file: path=\"{}\"", path);
+        return bt2s::nullopt;
+    }
+
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp || be64toh(hdr.file_size) != stamp->size ||
+        be64toh(hdr.file_mtime_sec) != stamp->mtimeSec ||
+        be64toh(hdr.file_mtime_nsec) != stamp->mtimeNsec) {
+        BT_CPPLOGI_SPEC(logger, "Ignoring stale index cache file: path=\"{}\"", path);
+        return bt2s::nullopt;
+    }
+
+    const auto entryCount = (data.size() - sizeof(hdr)) / sizeof(ctf_fs_index_cache_entry);
+    ctf_fs_ds_index index;
+    auto totalPacketsSize = 0_bytes;
+
+    index.entries.reserve(entryCount);
+
+    for (std::size_t i = 0; i < entryCount; ++i) {
+        ctf_fs_index_cache_entry entry;
+
+        std::memcpy(&entry, data.data() + sizeof(hdr) + i * sizeof(entry), sizeof(entry));
+
+        const auto offset = bt2c::DataLen::fromBytes(be64toh(entry.offset));
+        const auto packetSize = bt2c::DataLen::fromBytes(be64toh(entry.packet_size));
+
+        if (offset != totalPacketsSize) {
+            BT_CPPLOGW_SPEC(logger,
+                            "Invalid index cache file: non-contiguous packets: path=\"{}\", "
+                            "expected-offset-bytes={}, offset-bytes={}",
+                            path, totalPacketsSize.bytes(), offset.bytes());
+            return bt2s::nullopt;
+        }
+
+        ctf_fs_ds_index_entry indexEntry {fileInfo, offset, packetSize};
+
+        indexEntry.timestamp_begin = be64toh(entry.timestamp_begin);
+        indexEntry.timestamp_end = be64toh(entry.timestamp_end);
+        indexEntry.packet_seq_num = be64toh(entry.packet_seq_num);
+        index.entries.emplace_back(indexEntry);
+        totalPacketsSize += packetSize;
+    }
+
+    if (totalPacketsSize != fileInfo.size()) {
+        BT_CPPLOGW_SPEC(logger,
+                        "Invalid index cache file: indexed size != stream file size: "
+                        "path=\"{}\", stream-file-size-bytes={}, total-packets-size-bytes={}",
+                        path, fileInfo.size().bytes(), totalPacketsSize.bytes());
+        return bt2s::nullopt;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "Read index from index cache file: path=\"{}\", packet-count={}", path,
+                    entryCount);
+    return index;
+}
+
+void ctf_fs_ds_index_cache_write(const ctf_fs_ds_file_info& fileInfo,
+                                 const ctf_fs_ds_index& index)
+{
+    const auto& logger = fileInfo.logger();
+    const auto path = index_cache_path(fileInfo);
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp || stamp->size != fileInfo.size().bytes()) {
+        /* Changed while indexing it */
+        BT_CPPLOGW_SPEC(logger, "Not writing index cache file: data stream file changed: path=\"{}\"",
+                        path);
+        return;
+    }
+
+    const bt2c::GCharUP dirPath {g_path_get_dirname(path.c_str())};
+
+    if (g_mkdir_with_parents(dirPath.get(), 0755) != 0) {
+        BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot create index cache directory", ": path=\"{}\"",
+                              dirPath.get());
+        return;
+    }
+
+    /*
+     * Write to a temporary file, and then rename it, so that a
+     * concurrent reader never sees a partial index cache file.
+     */
+    const auto tmpPath = fmt::format("{}.tmp", path);
+
+    {
+        bt2c::FileUP file {std::fopen(tmpPath.c_str(), "wb")};
+
+        if (!file) {
+            BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot create index cache file", ": path=\"{}\"",
+                                  tmpPath);
+            return;
+        }
+
+        ctf_fs_index_cache_hdr hdr {};
+
+        hdr.magic = htobe32(CTF_FS_INDEX_CACHE_MAGIC);
+        hdr.version = htobe32(CTF_FS_INDEX_CACHE_VERSION);
+        hdr.entry_len = htobe32(sizeof(ctf_fs_index_cache_entry));
+        hdr.file_size = htobe64(stamp->size);
+        hdr.file_mtime_sec = htobe64(stamp->mtimeSec);
+        hdr.file_mtime_nsec = htobe64(stamp->mtimeNsec);
+
+        bool ok = std::fwrite(&hdr, sizeof(hdr), 1, file.get()) == 1;
+
+        for (const auto& indexEntry : index.entries) {
+            if (!ok) {
+                break;
+            }
+
+            ctf_fs_index_cache_entry entry;
+
+            entry.offset = htobe64(indexEntry.offsetInFile.bytes());
+            entry.packet_size = htobe64(indexEntry.packetSize.bytes());
+            entry.timestamp_begin = htobe64(indexEntry.timestamp_begin);
+            entry.timestamp_end = htobe64(indexEntry.timestamp_end);
+            entry.packet_seq_num = htobe64(indexEntry.packet_seq_num);
+            ok = std::fwrite(&entry, sizeof(entry), 1, file.get()) == 1;
+        }
+
+        if (!ok || std::fflush(file.get()) != 0) {
+            BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot write index cache file", ": path=\"{}\"",
+                                  tmpPath);
+            file.reset();
+            (void) g_unlink(tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (g_rename(tmpPath.c_str(), path.c_str()) != 0) {
+        BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot rename index cache file",
+                              ": old-path=\"{}\", new-path=\"{}\"", tmpPath, path);
+        (void) g_unlink(tmpPath.c_str());
+        return;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "Wrote index cache file: path=\"{}\", packet-count={}", path,
+                    index.entries.size());
+}
+
+bt2s::optional<ctf_fs_ds_index>
+ctf_fs_ds_index_mem_cache_get(const ctf_fs_ds_file_info& fileInfo)
+{
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp) {
+        return bt2s::nullopt;
+    }
+
+    auto& cache = get_mem_cache();
+    const std::lock_guard<std::mutex> lock {cache.mutex};
+
+    for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+        if (it->path != fileInfo.path()) {
+            continue;
+        }
+
+        if (!(it->stamp == *stamp) || it->size != fileInfo.size()) {
+            BT_CPPLOGD_SPEC(fileInfo.logger(),
+                            "Dropping stale in-memory index cache entry: path=\"{}\"",
+                            fileInfo.path());
+            cache.pktCount -= it->pkts.size();
+            cache.entries.erase(it);
+            return bt2s::nullopt;
+        }
+
+        ctf_fs_ds_index index;
+
+        index.entries.reserve(it->pkts.size());
+
+        for (const auto& pkt : it->pkts) {
+            ctf_fs_ds_index_entry indexEntry {fileInfo, pkt.offsetInFile, pkt.packetSize};
+
+            indexEntry.timestamp_begin = pkt.timestampBegin;
+            indexEntry.timestamp_end = pkt.timestampEnd;
+            indexEntry.packet_seq_num = pkt.packetSeqNum;
+            index.entries.emplace_back(indexEntry);
+        }
+
+        /* Most recently used first */
+        cache.entries.splice(cache.entries.begin(), cache.entries, it);
+        BT_CPPLOGI_SPEC(fileInfo.logger(),
+                        "Reusing index from in-memory index cache: path=\"{}\", packet-count={}",
+                        fileInfo.path(), index.entries.size());
+        return index;
+    }
+
+    return bt2s::nullopt;
+}
+
+void ctf_fs_ds_index_mem_cache_put(const ctf_fs_ds_file_info& fileInfo,
+                                   const ctf_fs_ds_index& index)
+{
+    if (index.entries.size() > CTF_FS_INDEX_MEM_CACHE_MAX_PACKET_COUNT) {
+        return;
+    }
+
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp || (!fileInfo.isCompressed() && stamp->size != fileInfo.size().bytes())) {
+        /* Changed while indexing it */
+        return;
+    }
+
+    mem_cache_entry entry;
+
+    entry.path = fileInfo.path();
+    entry.stamp = *stamp;
+    entry.size = fileInfo.size();
+    entry.pkts.reserve(index.entries.size());
+
+    for (const auto& indexEntry : index.entries) {
+        entry.pkts.push_back({indexEntry.offsetInFile, indexEntry.packetSize,
+                              indexEntry.timestamp_begin, indexEntry.timestamp_end,
+                              indexEntry.packet_seq_num});
+    }
+
+    auto& cache = get_mem_cache();
+    const std::lock_guard<std::mutex> lock {cache.mutex};
+
+    for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+        if (it->path == entry.path) {
+            cache.pktCount -= it->pkts.size();
+            cache.entries.erase(it);
+            break;
+        }
+    }
+
+    /* Evict the least recently used entries to make room */
+    while (!cache.entries.empty() &&
+           cache.pktCount + entry.pkts.size() > CTF_FS_INDEX_MEM_CACHE_MAX_PACKET_COUNT) {
+        cache.pktCount -= cache.entries.back().pkts.size();
+        cache.entries.pop_back();
+    }
+
+    cache.pktCount += entry.pkts.size();
+    cache.entries.emplace_front(std::move(entry));
+}
+
+int64_t ctf_fs_ds_summary_bucket_index(const int64_t ns, const uint64_t bucketDurNs) noexcept
+{
+    return floor_div(ns, static_cast<int64_t>(bucketDurNs));
+}
+
+void ctf_fs_ds_summary_level_normalize(ctf_fs_ds_summary_level& level)
+{
+    auto& buckets = level.buckets;
+
+    std::sort(buckets.begin(), buckets.end(),
+              [](const ctf_fs_ds_summary_bucket& a, const ctf_fs_ds_summary_bucket& b) {
+                  return a.index < b.index ||
+                         (a.index == b.index && a.eventRecordClsId < b.eventRecordClsId);
+              });
+
+    auto out = buckets.begin();
+
+    for (auto it = buckets.begin(); it != buckets.end(); ++it) {
+        if (out != buckets.begin() && (out - 1)->index == it->index &&
+            (out - 1)->eventRecordClsId == it->eventRecordClsId) {
+            (out - 1)->eventRecordCount += it->eventRecordCount;
+            (out - 1)->eventRecordTotalLenBits += it->eventRecordTotalLenBits;
+        } else {
+            *out = *it;
+            ++out;
+        }
+    }
+
+    buckets.erase(out, buckets.end());
+}
+
+ctf_fs_ds_summary_level ctf_fs_ds_summary_level_coarsen(const ctf_fs_ds_summary_level& level,
+                                                        const uint64_t bucketDurNs)
+{
+    BT_ASSERT(level.bucketDurNs > 0);
+    BT_ASSERT(bucketDurNs % level.bucketDurNs == 0);
+
+    const auto ratio = static_cast<int64_t>(bucketDurNs / level.bucketDurNs);
+    ctf_fs_ds_summary_level coarseLevel;
+
+    coarseLevel.bucketDurNs = bucketDurNs;
+
+    /*
+     * The coarse indexes of the sorted buckets of `level` don't
+     * decrease: accumulate the buckets of the current coarse index per
+     * event record class, and append them once the coarse index
+     * changes.
+     */
+    std::map<uint64_t, ctf_fs_ds_summary_bucket> curBuckets;
+    const auto flush = [&curBuckets, &coarseLevel] {
+        for (const auto& entry : curBuckets) {
+            coarseLevel.buckets.push_back(entry.second);
+        }
+
+        curBuckets.clear();
+    };
+
+    for (const auto& bucket : level.buckets) {
+        const auto index = floor_div(bucket.index, ratio);
+
+        if (!curBuckets.empty() && curBuckets.begin()->second.index != index) {
+            flush();
+        }
+
+        const auto it = curBuckets.find(bucket.eventRecordClsId);
+
+        if (it == curBuckets.end()) {
+            curBuckets.emplace(bucket.eventRecordClsId,
+                               ctf_fs_ds_summary_bucket {index, bucket.eventRecordClsId,
+                                                         bucket.eventRecordCount,
+                                                         bucket.eventRecordTotalLenBits});
+        } else {
+            it->second.eventRecordCount += bucket.eventRecordCount;
+            it->second.eventRecordTotalLenBits += bucket.eventRecordTotalLenBits;
+        }
+    }
+
+    flush();
+    return coarseLevel;
+}
+
+ctf_fs_ds_summary ctf_fs_ds_summary_from_base_level(ctf_fs_ds_summary_level baseLevel)
+{
+    BT_ASSERT(baseLevel.bucketDurNs == CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS);
+
+    ctf_fs_ds_summary summary;
+
+    summary.levels.reserve(CTF_FS_DS_SUMMARY_LEVEL_COUNT);
+    summary.levels.emplace_back(std::move(baseLevel));
+
+    while (summary.levels.size() < CTF_FS_DS_SUMMARY_LEVEL_COUNT) {
+        const auto& prevLevel = summary.levels.back();
+
+        summary.levels.emplace_back(
+            ctf_fs_ds_summary_level_coarsen(prevLevel, prevLevel.bucketDurNs * 10));
+    }
+
+    return summary;
+}
+
+bt2s::optional<ctf_fs_ds_summary>
+ctf_fs_ds_summary_cache_read(const ctf_fs_ds_file_info& fileInfo)
+{
+    const auto& logger = fileInfo.logger();
+    const auto path = summary_cache_path(fileInfo);
+    std::vector<std::uint8_t> data;
+
+    try {
+        data = bt2c::dataFromFile(path, logger, false);
+    } catch (const bt2c::NoSuchFileOrDirectoryError&) {
+        return bt2s::nullopt;
+    }
+
+    ctf_fs_summary_cache_hdr hdr;
+
+    if (data.size() < sizeof(hdr)) {
+        BT_CPPLOGW_SPEC(logger, "Invalid summary cache file: file size < header size: path=\"{}\"",
+                        path);
+        return bt2s::nullopt;
+    }
+
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+
+    if (be32toh(hdr.magic) != CTF_FS_SUMMARY_CACHE_MAGIC ||
+        be32toh(hdr.version) != CTF_FS_SUMMARY_CACHE_VERSION ||
+        be32toh(hdr.level_count) != CTF_FS_DS_SUMMARY_LEVEL_COUNT ||
+        be32toh(hdr.bucket_len) != sizeof(ctf_fs_summary_cache_bucket)) {
+        BT_CPPLOGW_SPEC(logger, "Invalid or unsupported summary cache file: path=\"{}\"", path);
+        return bt2s::nullopt;
+    }
+
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp || be64toh(hdr.file_size) != stamp->size ||
+        be64toh(hdr.file_mtime_sec) != stamp->mtimeSec ||
+        be64toh(hdr.file_mtime_nsec) != stamp->mtimeNsec) {
+        BT_CPPLOGI_SPEC(logger, "Ignoring stale summary cache file: path=\"{}\"", path);
+        return bt2s::nullopt;
+    }
+
+    ctf_fs_ds_summary summary;
+    auto offset = sizeof(hdr);
+    auto expectedBucketDurNs = CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS;
+
+    for (unsigned int levelIdx = 0; levelIdx < CTF_FS_DS_SUMMARY_LEVEL_COUNT; ++levelIdx) {
+        ctf_fs_summary_cache_level cacheLevel;
+
+        if (data.size() - offset < sizeof(cacheLevel)) {
+            BT_CPPLOGW_SPEC(logger, "Invalid summary cache file: truncated level: path=\"{}\"",
+                            path);
+            return bt2s::nullopt;
+        }
+
+        std::memcpy(&cacheLevel, data.data() + offset, sizeof(cacheLevel));
+        offset += sizeof(cacheLevel);
+
+        const auto bucketCount = be64toh(cacheLevel.bucket_count);
+
+        if (be64toh(cacheLevel.bucket_dur_ns) != expectedBucketDurNs ||
+            (data.size() - offset) / sizeof(ctf_fs_summary_cache_bucket) < bucketCount) {
+            BT_CPPLOGW_SPEC(logger, "Invalid summary cache file: invalid level: path=\"{}\"",
+                            path);
+            return bt2s::nullopt;
+        }
+
+        ctf_fs_ds_summary_level level;
+
+        level.bucketDurNs = expectedBucketDurNs;
+        level.buckets.reserve(bucketCount);
+
+        for (uint64_t i = 0; i < bucketCount; ++i) {
+            ctf_fs_summary_cache_bucket cacheBucket;
+
+            std::memcpy(&cacheBucket, data.data() + offset, sizeof(cacheBucket));
+            offset += sizeof(cacheBucket);
+            level.buckets.push_back({static_cast<int64_t>(be64toh(cacheBucket.index)),
+                                     be64toh(cacheBucket.event_record_class_id),
+                                     be64toh(cacheBucket.event_record_count),
+                                     be64toh(cacheBucket.event_record_total_len_bits)});
+        }
+
+        summary.levels.emplace_back(std::move(level));
+        expectedBucketDurNs *= 10;
+    }
+
+    if (offset != data.size()) {
+        BT_CPPLOGW_SPEC(logger, "Invalid summary cache file: trailing data: path=\"{}\"", path);
+        return bt2s::nullopt;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "Read summary from summary cache file: path=\"{}\", bucket-count={}",
+                    path, summary.levels.front().buckets.size());
+    return summary;
+}
+
+void ctf_fs_ds_summary_cache_write(const ctf_fs_ds_file_info& fileInfo,
+                                   const ctf_fs_ds_summary& summary)
+{
+    BT_ASSERT(summary.levels.size() == CTF_FS_DS_SUMMARY_LEVEL_COUNT);
+
+    const auto& logger = fileInfo.logger();
+    const auto path = summary_cache_path(fileInfo);
+    const auto stamp = get_file_stamp(fileInfo);
+
+    if (!stamp || (!fileInfo.isCompressed() && stamp->size != fileInfo.size().bytes())) {
+        /* Changed while summarizing it */
+        BT_CPPLOGW_SPEC(logger,
+                        "Not writing summary cache file: data stream file changed: path=\"{}\"",
+                        path);
+        return;
+    }
+
+    const bt2c::GCharUP dirPath {g_path_get_dirname(path.c_str())};
+
+    if (g_mkdir_with_parents(dirPath.get(), 0755) != 0) {
+        BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot create summary cache directory", ": path=\"{}\"",
+                              dirPath.get());
+        return;
+    }
+
+    /* Same temporary file strategy as ctf_fs_ds_index_cache_write() */
+    const auto tmpPath = fmt::format("{}.tmp", path);
+
+    {
+        bt2c::FileUP file {std::fopen(tmpPath.c_str(), "wb")};
+
+        if (!file) {
+            BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot create summary cache file", ": path=\"{}\"",
+                                  tmpPath);
+            return;
+        }
+
+        ctf_fs_summary_cache_hdr hdr {};
+
+        hdr.magic = htobe32(CTF_FS_SUMMARY_CACHE_MAGIC);
+        hdr.version = htobe32(CTF_FS_SUMMARY_CACHE_VERSION);
+        hdr.level_count = htobe32(CTF_FS_DS_SUMMARY_LEVEL_COUNT);
+        hdr.bucket_len = htobe32(sizeof(ctf_fs_summary_cache_bucket));
+        hdr.file_size = htobe64(stamp->size);
+        hdr.file_mtime_sec = htobe64(stamp->mtimeSec);
+        hdr.file_mtime_nsec = htobe64(stamp->mtimeNsec);
+
+        bool ok = std::fwrite(&hdr, sizeof(hdr), 1, file.get()) == 1;
+
+        for (const auto& level : summary.levels) {
+            if (!ok) {
+                break;
+            }
+
+            ctf_fs_summary_cache_level cacheLevel;
+
+            cacheLevel.bucket_dur_ns = htobe64(level.bucketDurNs);
+            cacheLevel.bucket_count = htobe64(level.buckets.size());
+            ok = std::fwrite(&cacheLevel, sizeof(cacheLevel), 1, file.get()) == 1;
+
+            for (const auto& bucket : level.buckets) {
+                if (!ok) {
+                    break;
+                }
+
+                ctf_fs_summary_cache_bucket cacheBucket;
+
+                cacheBucket.index = htobe64(static_cast<uint64_t>(bucket.index));
+                cacheBucket.event_record_class_id = htobe64(bucket.eventRecordClsId);
+                cacheBucket.event_record_count = htobe64(bucket.eventRecordCount);
+                cacheBucket.event_record_total_len_bits = htobe64(bucket.eventRecordTotalLenBits);
+                ok = std::fwrite(&cacheBucket, sizeof(cacheBucket), 1, file.get()) == 1;
+            }
+        }
+
+        if (!ok || std::fflush(file.get()) != 0) {
+            BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot write summary cache file", ": path=\"{}\"",
+                                  tmpPath);
+            file.reset();
+            (void) g_unlink(tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (g_rename(tmpPath.c_str(), path.c_str()) != 0) {
+        BT_CPPLOGW_ERRNO_SPEC(logger, "Cannot rename summary cache file",
+                              ": old-path=\"{}\", new-path=\"{}\"", tmpPath, path);
+        (void) g_unlink(tmpPath.c_str());
+        return;
+    }
+
+    BT_CPPLOGI_SPEC(logger, "Wrote summary cache file: path=\"{}\", bucket-count={}", path,
+                    summary.levels.front().buckets.size());
+}
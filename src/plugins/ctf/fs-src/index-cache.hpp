@@ -0,0 +1,173 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ */
+
+#ifndef BABELTRACE_PLUGINS_CTF_FS_SRC_INDEX_CACHE_HPP
+#define BABELTRACE_PLUGINS_CTF_FS_SRC_INDEX_CACHE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "data-stream-file.hpp"
+
+/*
+ * Index cache files.
+ *
+ * An index cache file is a compact index of a data stream file which
+ * this plugin writes after indexing the data stream file packet by
+ * packet, when the trace doesn't have LTTng index files.
+ *
+ * The index cache file of the data stream file `DIR/NAME` is
+ * `DIR/index/NAME.bt-idx`. It records the size and modification time
+ * of the data stream file so that a stale index cache file is never
+ * used.
+ */
+
+/*
+ * Reads the index cache file of `fileInfo`, returning `bt2s::nullopt`
+ * if it doesn't exist, is invalid or is stale.
+ */
+bt2s::optional<ctf_fs_ds_index> ctf_fs_ds_index_cache_read(const ctf_fs_ds_file_info& fileInfo);
+
+/*
+ * Writes `index`, the index of `fileInfo`, to the index cache file of
+ * `fileInfo`.
+ *
+ * Only logs a warning on failure.
+ */
+void ctf_fs_ds_index_cache_write(const ctf_fs_ds_file_info& fileInfo,
+                                 const ctf_fs_ds_index& index);
+
+/*
+ * In-memory index cache.
+ *
+ * Within a process, the `babeltrace.trace-infos` query indexes the
+ * data stream files of a trace, and then the component which the
+ * caller creates for the same trace indexes them again. To only index
+ * them once, ctf_fs_ds_file_build_index() keeps the indexes it builds
+ * in a bounded, process-wide cache, keyed by path and validated with
+ * the size and modification time of the data stream file like index
+ * cache files.
+ *
+ * Those functions are thread-safe.
+ */
+
+/*
+ * Returns the cached index of `fileInfo`, or `bt2s::nullopt` if
+ * there's none or if it's stale.
+ */
+bt2s::optional<ctf_fs_ds_index>
+ctf_fs_ds_index_mem_cache_get(const ctf_fs_ds_file_info& fileInfo);
+
+/*
+ * Caches `index`, the index of `fileInfo`, possibly evicting the least
+ * recently used indexes.
+ */
+void ctf_fs_ds_index_mem_cache_put(const ctf_fs_ds_file_info& fileInfo,
+                                   const ctf_fs_ds_index& index);
+
+/*
+ * Summary cache files.
+ *
+ * A summary is the time-bucketed overview of a data stream file: for
+ * several bucket durations, the number of event records and their
+ * total length per time bucket and per event record class. The
+ * `event-record-histogram` query builds it by decoding the event record
+ * headers once, writes it to the summary cache file, and then answers
+ * from the latter without decoding anything.
+ *
+ * The summary cache file of the data stream file `DIR/NAME` is
+ * `DIR/index/NAME.bt-summary`, validated like an index cache file.
+ */
+
+/* Bucket duration of the finest level of a summary (ns) */
+#define CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS UINT64_C(10000000)
+
+/*
+ * Number of levels of a summary, the bucket duration of each level
+ * being ten times the one of the previous level.
+ */
+#define CTF_FS_DS_SUMMARY_LEVEL_COUNT 5
+
+/* Event records of a given class within a given time bucket */
+struct ctf_fs_ds_summary_bucket
+{
+    /*
+     * Index of the time bucket: the bucket contains the timestamps, in
+     * nanoseconds from the origin of the clock class, within
+     * [index × D, (index + 1) × D[, where D is the bucket duration.
+     */
+    int64_t index;
+
+    /* Event record class ID, or `UINT64_C(-1)` if none */
+    uint64_t eventRecordClsId;
+
+    uint64_t eventRecordCount;
+    uint64_t eventRecordTotalLenBits;
+};
+
+/* Buckets of a summary for a given bucket duration */
+struct ctf_fs_ds_summary_level
+{
+    uint64_t bucketDurNs = 0;
+
+    /* Sorted by index, and then by event record class ID */
+    std::vector<ctf_fs_ds_summary_bucket> buckets;
+};
+
+struct ctf_fs_ds_summary
+{
+    /* `CTF_FS_DS_SUMMARY_LEVEL_COUNT` levels, finest first */
+    std::vector<ctf_fs_ds_summary_level> levels;
+};
+
+/*
+ * Returns the index of the time bucket, for the bucket duration
+ * `bucketDurNs`, which contains the timestamp `ns` (nanoseconds from
+ * the origin of the clock class).
+ */
+int64_t ctf_fs_ds_summary_bucket_index(int64_t ns, uint64_t bucketDurNs) noexcept;
+
+/*
+ * Sorts the buckets of `level` and merges the ones having the same
+ * index and event record class ID.
+ */
+void ctf_fs_ds_summary_level_normalize(ctf_fs_ds_summary_level& level);
+
+/*
+ * Returns the buckets of `level`, which must be normalized, for the
+ * bucket duration `bucketDurNs`, a multiple of the bucket duration of
+ * `level`.
+ */
+ctf_fs_ds_summary_level ctf_fs_ds_summary_level_coarsen(const ctf_fs_ds_summary_level& level,
+                                                        uint64_t bucketDurNs);
+
+/*
+ * Returns a summary of which the finest level is `baseLevel`, which
+ * must be normalized and have the bucket duration
+ * `CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS`.
+ */
+ctf_fs_ds_summary ctf_fs_ds_summary_from_base_level(ctf_fs_ds_summary_level baseLevel);
+
+/*
+ * Reads the summary cache file of `fileInfo`, returning `bt2s::nullopt`
+ * if it doesn't exist, is invalid or is stale.
+ */
+bt2s::optional<ctf_fs_ds_summary>
+ctf_fs_ds_summary_cache_read(const ctf_fs_ds_file_info& fileInfo);
+
+/*
+ * Writes `summary`, the summary of `fileInfo`, to the summary cache
+ * file of `fileInfo`.
+ *
+ * Only logs a warning on failure.
+ */
+void ctf_fs_ds_summary_cache_write(const ctf_fs_ds_file_info& fileInfo,
+                                   const ctf_fs_ds_summary& summary);
+
+#endif /* BABELTRACE_PLUGINS_CTF_FS_SRC_INDEX_CACHE_HPP */
@@ -6,6 +6,11 @@
  * Babeltrace CTF file system Reader Component queries
  */
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <sys/types.h>
@@ -18,11 +23,13 @@
 
 #include "plugins/common/param-validation/param-validation.h"
 
+#include "../common/src/item-seq/item-seq-iter.hpp"
 #include "../common/src/metadata/metadata-stream-parser-utils.hpp"
 #include "../common/src/metadata/metadata-stream-parser.hpp"
 #include "../common/src/metadata/tsdl/metadata-stream-decoder.hpp"
 #include "data-stream-file.hpp"
 #include "fs.hpp"
+#include "index-cache.hpp"
 #include "metadata.hpp"
 #include "query.hpp"
 
@@ -107,6 +114,9 @@ static void populate_stream_info(struct ctf_fs_ds_file_group *group, const bt2::
      * of the last index entry.
      */
     BT_ASSERT(!group->index.entries.empty());
+    ctf_fs_ds_file_group_fix_index_entry_timestamps(*group, 0, logger);
+    ctf_fs_ds_file_group_fix_index_entry_timestamps(*group, group->index.entries.size() - 1,
+                                                    logger);
 
     /* First and last entries. */
     const auto& first_ds_index_entry = group->index.entries.front();
@@ -148,11 +158,15 @@ static void populate_trace_info(const struct ctf_fs_trace *trace, const bt2::Map
     }
 }
 
-bt2::Value::Shared trace_infos_query(const bt2::ConstValue params, const bt2c::Logger& logger)
+bt2::Value::Shared trace_infos_query(const bt2::ConstValue params,
+                                     const bt2::PrivateQueryExecutor privQueryExec,
+                                     const bt2c::Logger& logger)
 {
     const auto parameters = read_src_fs_parameters(params, logger);
     ctf_fs_component ctf_fs {parameters.clkClsCfg, logger};
 
+    ctf_fs.indexCache = parameters.indexCache;
+
     if (ctf_fs_component_create_ctf_fs_trace(
             &ctf_fs, parameters.inputs,
             parameters.traceName ? parameters.traceName->c_str() : nullptr, {})) {
@@ -163,6 +177,12 @@ bt2::Value::Shared trace_infos_query(const bt2::ConstValue params, const bt2c::L
     const auto traceInfo = result->appendEmptyMap();
     populate_trace_info(ctf_fs.trace.get(), traceInfo, logger);
 
+    /*
+     * The user of this query usually creates a component for the same
+     * inputs next: save it the work.
+     */
+    ctf_fs_stash_trace(privQueryExec, parameters, std::move(ctf_fs.trace), logger);
+
     return result;
 }
 
@@ -236,3 +256,650 @@ bt2::Value::Shared support_info_query(const bt2::ConstValue params, const bt2c::
 
     return result;
 }
+
+namespace {
+
+/* Number of event records and total length of a set of event records */
+struct EventRecordCounts final
+{
+    void add(const bt2c::DataLen len) noexcept
+    {
+        ++count;
+        totalLen += len;
+    }
+
+    unsigned long long count = 0;
+    bt2c::DataLen totalLen = bt2c::DataLen::fromBits(0);
+};
+
+/* Optional time range of the `event-record-stats` query */
+struct TimeRange final
+{
+    bool contains(const std::int64_t ns) const noexcept
+    {
+        return (!begin || ns >= *begin) && (!end || ns <= *end);
+    }
+
+    bool isSet() const noexcept
+    {
+        return begin || end;
+    }
+
+    bt2s::optional<std::int64_t> begin;
+    bt2s::optional<std::int64_t> end;
+};
+
+} /* namespace */
+
+static void addEventRecordCounts(const bt2::MapValueBuilder builder,
+                                 const EventRecordCounts& counts)
+{
+    builder.add("event-record-count", static_cast<std::uint64_t>(counts.count));
+    builder.add("event-record-total-length-bits", static_cast<std::uint64_t>(*counts.totalLen));
+}
+
+/*
+ * Returns whether or not the packet of `entry` may contain an event
+ * record within `range`, considering its beginning and end timestamps
+ * from the index.
+ */
+static bool pktMayBeInRange(const ctf_fs_ds_index_entry& entry, const TimeRange& range,
+                            const ctf::src::ClkCls *const clkCls, const bt2c::Logger& logger)
+{
+    if (!range.isSet() || !clkCls || entry.timestamp_begin == UINT64_C(-1) ||
+        entry.timestamp_end == UINT64_C(-1)) {
+        /* Can't tell */
+        return true;
+    }
+
+    if (range.begin && convertCyclesToNs(*clkCls, entry.timestamp_end, logger) < *range.begin) {
+        return false;
+    }
+
+    if (range.end && convertCyclesToNs(*clkCls, entry.timestamp_begin, logger) > *range.end) {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Counts the event records of the data stream of `group` within
+ * `range`, adding a map to `streamInfos`.
+ *
+ * This function doesn't create any message or trace IR object: it
+ * only reads the event record headers with an item sequence iterator
+ * and skips the other fields of each event record when possible.
+ *
+ * The maps are compact ones, built with `builder`: a trace may have
+ * many streams and event record classes.
+ */
+static void populateEventRecordStats(const ctf_fs_trace& trace, ctf_fs_ds_file_group& group,
+                                     const ctf::src::fs::Parameters& parameters,
+                                     const TimeRange& range, const bt2::ArrayValue streamInfos,
+                                     const bt2::MapValueBuilder builder,
+                                     const bt2c::Logger& logger)
+{
+    const auto clkCls = group.dataStreamCls->defClkCls();
+    EventRecordCounts streamCounts;
+    std::unordered_map<const ctf::src::EventRecordCls *, EventRecordCounts> clsCounts;
+    unsigned long long pktCount = 0;
+
+    if (!group.index.entries.empty()) {
+        ctf::src::ItemSeqIter itemSeqIter {
+            ctf::src::fs::createMedium(parameters.readMode, group.index, parameters.mmapWindowSize,
+                                       logger),
+            *trace.cls(), logger};
+        bt2c::DataLen eventRecordBeginOffset = bt2c::DataLen::fromBits(0);
+        const ctf::src::EventRecordCls *eventRecordCls = nullptr;
+        bool eventRecordIsInRange = true;
+
+        for (std::size_t entryIdx = 0; entryIdx < group.index.entries.size(); ++entryIdx) {
+            if (range.isSet()) {
+                ctf_fs_ds_file_group_fix_index_entry_timestamps(group, entryIdx, logger);
+            }
+
+            const auto& entry = group.index.entries[entryIdx];
+
+            if (!pktMayBeInRange(entry, range, clkCls, logger)) {
+                continue;
+            }
+
+            itemSeqIter.seekPkt(entry.offsetInStream);
+            ++pktCount;
+
+            /* Handle the items of this packet */
+            itemSeqIter.advanceWhile([&](const ctf::src::Item& item) {
+                switch (item.type()) {
+                case ctf::src::Item::Type::EventRecordBegin:
+                    eventRecordBeginOffset = itemSeqIter.offset();
+                    break;
+                case ctf::src::Item::Type::EventRecordInfo:
+                {
+                    const auto& infoItem = item.asEventRecordInfo();
+
+                    eventRecordCls = infoItem.cls();
+                    eventRecordIsInRange =
+                        !range.isSet() || !clkCls || !infoItem.defClkVal() ||
+                        range.contains(convertCyclesToNs(*clkCls, *infoItem.defClkVal(), logger));
+
+                    /* Only the length matters from here */
+                    itemSeqIter.skipCurEventRecordCtxsAndPayload();
+                    break;
+                }
+                case ctf::src::Item::Type::EventRecordEnd:
+                    if (eventRecordIsInRange) {
+                        const auto len = itemSeqIter.offset() - eventRecordBeginOffset;
+
+                        streamCounts.add(len);
+                        clsCounts[eventRecordCls].add(len);
+                    }
+
+                    break;
+                case ctf::src::Item::Type::PktEnd:
+                    return false;
+                default:
+                    break;
+                }
+
+                return true;
+            });
+        }
+    }
+
+    /* Sort by event record class ID for a stable result */
+    std::vector<std::pair<const ctf::src::EventRecordCls *, EventRecordCounts>> sortedClsCounts {
+        clsCounts.begin(), clsCounts.end()};
+
+    std::sort(sortedClsCounts.begin(), sortedClsCounts.end(),
+              [](const std::pair<const ctf::src::EventRecordCls *, EventRecordCounts>& a,
+                 const std::pair<const ctf::src::EventRecordCls *, EventRecordCounts>& b) {
+                  return a.first && (!b.first || a.first->id() < b.first->id());
+              });
+
+    const auto clsInfos = bt2::ArrayValue::create();
+
+    for (const auto& clsCount : sortedClsCounts) {
+        if (clsCount.first) {
+            builder.add("id", static_cast<std::uint64_t>(clsCount.first->id()));
+
+            if (clsCount.first->name()) {
+                builder.add("name", *clsCount.first->name());
+            }
+        }
+
+        addEventRecordCounts(builder, clsCount.second);
+        clsInfos->append(*builder.build());
+    }
+
+    builder.add("port-name", ctf_fs_make_port_name(&group));
+    builder.add("stream-class-id", static_cast<std::uint64_t>(group.dataStreamCls->id()));
+
+    if (group.stream_id != UINT64_C(-1)) {
+        builder.add("stream-id", group.stream_id);
+    }
+
+    builder.add("packet-count", static_cast<std::uint64_t>(pktCount));
+    addEventRecordCounts(builder, streamCounts);
+    builder.add("event-record-class-infos", *clsInfos);
+    streamInfos.append(*builder.build());
+}
+
+bt2::Value::Shared event_record_stats_query(const bt2::ConstValue params,
+                                            const bt2c::Logger& logger)
+{
+    /*
+     * Extract the `begin` and `end` parameters, passing the other ones
+     * to read_src_fs_parameters().
+     */
+    TimeRange range;
+    const auto fsParams = bt2::MapValue::create();
+
+    if (!params.isMap()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Expecting a map value for the parameters.");
+    }
+
+    params.asMap().forEach([&](const bt2c::CStringView key, const bt2::ConstValue val) {
+        if (key == "begin" || key == "end") {
+            if (!val.isSignedInteger()) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    logger, bt2::Error, "Expecting a signed integer value for the `{}` parameter.",
+                    key);
+            }
+
+            (key == "begin" ? range.begin : range.end) = val.asSignedInteger().value();
+        } else {
+            fsParams->insert(key, *val.copy());
+        }
+    });
+
+    if (range.begin && range.end && *range.begin > *range.end) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error,
+            "Invalid time range: `begin` is greater than `end`: begin={}, end={}", *range.begin,
+            *range.end);
+    }
+
+    const auto parameters = read_src_fs_parameters(*fsParams, logger);
+    ctf_fs_component ctf_fs {parameters.clkClsCfg, logger};
+
+    ctf_fs.indexCache = parameters.indexCache;
+
+    if (ctf_fs_component_create_ctf_fs_trace(
+            &ctf_fs, parameters.inputs,
+            parameters.traceName ? parameters.traceName->c_str() : nullptr, {})) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error, "Failed to create trace");
+    }
+
+    const auto result = bt2::MapValue::create();
+    const auto streamInfos = result->insertEmptyArray("stream-infos");
+    const auto builder = bt2::MapValueBuilder::create();
+
+    try {
+        for (auto& group : ctf_fs.trace->ds_file_groups) {
+            populateEventRecordStats(*ctf_fs.trace, *group, parameters, range, streamInfos,
+                                     *builder, logger);
+        }
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW_SPEC(logger, "Failed to count event records");
+    }
+
+    return result;
+}
+
+namespace {
+
+/*
+ * Accumulator of the finest summary levels of the data stream files of
+ * a data stream.
+ *
+ * The timestamps of the event records of a data stream don't decrease:
+ * the accumulator counts the event records of the current time bucket
+ * per event record class, and appends them to the level of the current
+ * data stream file once the bucket or the file changes.
+ */
+class SummaryBuilder final
+{
+public:
+    void add(const ctf_fs_ds_file_info& fileInfo, const std::int64_t bucketIndex,
+             const std::uint64_t eventRecordClsId, const bt2c::DataLen len)
+    {
+        if (&fileInfo != _mCurFileInfo || bucketIndex != _mCurBucketIndex) {
+            this->_flush();
+            _mCurFileInfo = &fileInfo;
+            _mCurBucketIndex = bucketIndex;
+        }
+
+        auto& bucket = _mCurBuckets[eventRecordClsId];
+
+        ++bucket.eventRecordCount;
+        bucket.eventRecordTotalLenBits += *len;
+    }
+
+    /*
+     * Returns the normalized finest level of `fileInfo`, empty if the
+     * accumulator counted no event record of it.
+     */
+    ctf_fs_ds_summary_level takeBaseLevel(const ctf_fs_ds_file_info& fileInfo)
+    {
+        this->_flush();
+
+        auto& level = _mBaseLevels[&fileInfo];
+
+        level.bucketDurNs = CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS;
+        ctf_fs_ds_summary_level_normalize(level);
+        return std::move(level);
+    }
+
+private:
+    struct _Counts final
+    {
+        std::uint64_t eventRecordCount = 0;
+        std::uint64_t eventRecordTotalLenBits = 0;
+    };
+
+    void _flush()
+    {
+        if (_mCurBuckets.empty()) {
+            return;
+        }
+
+        auto& level = _mBaseLevels[_mCurFileInfo];
+
+        for (const auto& entry : _mCurBuckets) {
+            level.buckets.push_back({_mCurBucketIndex, entry.first, entry.second.eventRecordCount,
+                                     entry.second.eventRecordTotalLenBits});
+        }
+
+        _mCurBuckets.clear();
+    }
+
+    std::unordered_map<const ctf_fs_ds_file_info *, ctf_fs_ds_summary_level> _mBaseLevels;
+    const ctf_fs_ds_file_info *_mCurFileInfo = nullptr;
+    std::int64_t _mCurBucketIndex = 0;
+    std::unordered_map<std::uint64_t, _Counts> _mCurBuckets;
+};
+
+} /* namespace */
+
+/*
+ * Builds the summary of each data stream file of `group` by decoding
+ * its event record headers, writing the summary cache files, and
+ * returns the summary of the whole data stream.
+ *
+ * The data stream class of `group` must have a default clock class.
+ * This function ignores the event records without a default clock
+ * value.
+ */
+static ctf_fs_ds_summary buildGroupSummary(const ctf_fs_trace& trace, ctf_fs_ds_file_group& group,
+                                           const ctf::src::fs::Parameters& parameters,
+                                           const bt2c::Logger& logger)
+{
+    const auto clkCls = group.dataStreamCls->defClkCls();
+    SummaryBuilder builder;
+
+    BT_ASSERT(clkCls);
+
+    if (!group.index.entries.empty()) {
+        ctf::src::ItemSeqIter itemSeqIter {
+            ctf::src::fs::createMedium(parameters.readMode, group.index, parameters.mmapWindowSize,
+                                       logger),
+            *trace.cls(), logger};
+        bt2c::DataLen eventRecordBeginOffset = bt2c::DataLen::fromBits(0);
+        std::uint64_t eventRecordClsId = UINT64_C(-1);
+        bt2s::optional<std::int64_t> bucketIndex;
+
+        for (const auto& entry : group.index.entries) {
+            itemSeqIter.seekPkt(entry.offsetInStream);
+
+            /* Handle the items of this packet */
+            itemSeqIter.advanceWhile([&](const ctf::src::Item& item) {
+                switch (item.type()) {
+                case ctf::src::Item::Type::EventRecordBegin:
+                    eventRecordBeginOffset = itemSeqIter.offset();
+                    break;
+                case ctf::src::Item::Type::EventRecordInfo:
+                {
+                    const auto& infoItem = item.asEventRecordInfo();
+
+                    eventRecordClsId = infoItem.cls() ? infoItem.cls()->id() : UINT64_C(-1);
+
+                    if (infoItem.defClkVal()) {
+                        bucketIndex = ctf_fs_ds_summary_bucket_index(
+                            convertCyclesToNs(*clkCls, *infoItem.defClkVal(), logger),
+                            CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS);
+                    } else {
+                        bucketIndex.reset();
+                    }
+
+                    /* Only the length matters from here */
+                    itemSeqIter.skipCurEventRecordCtxsAndPayload();
+                    break;
+                }
+                case ctf::src::Item::Type::EventRecordEnd:
+                    if (bucketIndex) {
+                        builder.add(*entry.fileInfo, *bucketIndex, eventRecordClsId,
+                                    itemSeqIter.offset() - eventRecordBeginOffset);
+                    }
+
+                    break;
+                case ctf::src::Item::Type::PktEnd:
+                    return false;
+                default:
+                    break;
+                }
+
+                return true;
+            });
+        }
+    }
+
+    /* Write the summary of each data stream file, merging them */
+    ctf_fs_ds_summary groupSummary;
+
+    for (const auto& fileInfo : group.ds_file_infos) {
+        auto summary = ctf_fs_ds_summary_from_base_level(builder.takeBaseLevel(*fileInfo));
+
+        ctf_fs_ds_summary_cache_write(*fileInfo, summary);
+
+        if (groupSummary.levels.empty()) {
+            groupSummary = std::move(summary);
+            continue;
+        }
+
+        for (std::size_t i = 0; i < summary.levels.size(); ++i) {
+            auto& buckets = groupSummary.levels[i].buckets;
+
+            buckets.insert(buckets.end(), summary.levels[i].buckets.begin(),
+                           summary.levels[i].buckets.end());
+        }
+    }
+
+    for (auto& level : groupSummary.levels) {
+        ctf_fs_ds_summary_level_normalize(level);
+    }
+
+    return groupSummary;
+}
+
+/*
+ * Returns the summary of the data stream of `group`, of which the data
+ * stream class must have a default clock class, from the summary cache
+ * files of its data stream files if they're all valid, or by building
+ * it otherwise.
+ */
+static ctf_fs_ds_summary groupSummary(const ctf_fs_trace& trace, ctf_fs_ds_file_group& group,
+                                      const ctf::src::fs::Parameters& parameters,
+                                      const bt2c::Logger& logger)
+{
+    ctf_fs_ds_summary groupSummary;
+
+    for (const auto& fileInfo : group.ds_file_infos) {
+        auto summary = ctf_fs_ds_summary_cache_read(*fileInfo);
+
+        if (!summary) {
+            BT_CPPLOGI_SPEC(logger,
+                            "Building data stream summary: port-name=\"{}\", "
+                            "missing-summary-file-path=\"{}\"",
+                            ctf_fs_make_port_name(&group), fileInfo->path());
+
+            return buildGroupSummary(trace, group, parameters, logger);
+        }
+
+        if (groupSummary.levels.empty()) {
+            groupSummary = std::move(*summary);
+            continue;
+        }
+
+        for (std::size_t i = 0; i < summary->levels.size(); ++i) {
+            auto& buckets = groupSummary.levels[i].buckets;
+
+            buckets.insert(buckets.end(), summary->levels[i].buckets.begin(),
+                           summary->levels[i].buckets.end());
+        }
+    }
+
+    for (auto& level : groupSummary.levels) {
+        ctf_fs_ds_summary_level_normalize(level);
+    }
+
+    return groupSummary;
+}
+
+/*
+ * Returns the buckets of `summary` for the bucket duration
+ * `bucketDurNs`, coarsening its coarsest level of which the bucket
+ * duration divides `bucketDurNs`.
+ */
+static ctf_fs_ds_summary_level summaryLevel(const ctf_fs_ds_summary& summary,
+                                            const std::uint64_t bucketDurNs)
+{
+    const ctf_fs_ds_summary_level *bestLevel = nullptr;
+
+    for (const auto& level : summary.levels) {
+        if (bucketDurNs % level.bucketDurNs == 0) {
+            bestLevel = &level;
+        }
+    }
+
+    BT_ASSERT(bestLevel);
+
+    if (bestLevel->bucketDurNs == bucketDurNs) {
+        return *bestLevel;
+    }
+
+    return ctf_fs_ds_summary_level_coarsen(*bestLevel, bucketDurNs);
+}
+
+/*
+ * Adds the map of the data stream of `group`, having the buckets of
+ * its summary for the bucket duration `bucketDurNs` which overlap
+ * `range`, to `streamInfos`.
+ */
+static void populateEventRecordHistogram(const ctf_fs_trace& trace, ctf_fs_ds_file_group& group,
+                                         const ctf::src::fs::Parameters& parameters,
+                                         const std::uint64_t bucketDurNs, const TimeRange& range,
+                                         const bt2::ArrayValue streamInfos,
+                                         const bt2::MapValueBuilder builder,
+                                         const bt2c::Logger& logger)
+{
+    const auto bucketInfos = bt2::ArrayValue::create();
+
+    if (group.dataStreamCls->defClkCls()) {
+        const auto level =
+            summaryLevel(groupSummary(trace, group, parameters, logger), bucketDurNs);
+        auto clsInfos = bt2::ArrayValue::create();
+        EventRecordCounts bucketCounts;
+
+        for (auto it = level.buckets.begin(); it != level.buckets.end(); ++it) {
+            /* Beginning and end (inclusive) of the bucket */
+            const auto beginNs = it->index * static_cast<std::int64_t>(bucketDurNs);
+            const auto endNs = beginNs + static_cast<std::int64_t>(bucketDurNs - 1);
+
+            if ((range.begin && endNs < *range.begin) || (range.end && beginNs > *range.end)) {
+                continue;
+            }
+
+            /* One map per event record class, already sorted by ID */
+            EventRecordCounts clsCounts;
+
+            clsCounts.count = it->eventRecordCount;
+            clsCounts.totalLen = bt2c::DataLen::fromBits(it->eventRecordTotalLenBits);
+
+            if (it->eventRecordClsId != UINT64_C(-1)) {
+                builder.add("id", it->eventRecordClsId);
+
+                if (const auto eventRecordCls = (*group.dataStreamCls)[it->eventRecordClsId]) {
+                    if (eventRecordCls->name()) {
+                        builder.add("name", *eventRecordCls->name());
+                    }
+                }
+            }
+
+            addEventRecordCounts(builder, clsCounts);
+            clsInfos->append(*builder.build());
+            bucketCounts.count += clsCounts.count;
+            bucketCounts.totalLen += clsCounts.totalLen;
+
+            if (std::next(it) != level.buckets.end() && std::next(it)->index == it->index) {
+                continue;
+            }
+
+            /* Last bucket of this index */
+            builder.add("begin-ns", beginNs);
+            addEventRecordCounts(builder, bucketCounts);
+            builder.add("event-record-class-infos", *clsInfos);
+            bucketInfos->append(*builder.build());
+            clsInfos = bt2::ArrayValue::create();
+            bucketCounts = EventRecordCounts {};
+        }
+    }
+
+    builder.add("port-name", ctf_fs_make_port_name(&group));
+    builder.add("stream-class-id", static_cast<std::uint64_t>(group.dataStreamCls->id()));
+
+    if (group.stream_id != UINT64_C(-1)) {
+        builder.add("stream-id", group.stream_id);
+    }
+
+    builder.add("bucket-infos", *bucketInfos);
+    streamInfos.append(*builder.build());
+}
+
+bt2::Value::Shared event_record_histogram_query(const bt2::ConstValue params,
+                                                const bt2c::Logger& logger)
+{
+    /*
+     * Extract the `bucket-duration`, `begin`, and `end` parameters,
+     * passing the other ones to read_src_fs_parameters().
+     */
+    std::uint64_t bucketDurNs = CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS;
+    TimeRange range;
+    const auto fsParams = bt2::MapValue::create();
+
+    if (!params.isMap()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Expecting a map value for the parameters.");
+    }
+
+    params.asMap().forEach([&](const bt2c::CStringView key, const bt2::ConstValue val) {
+        if (key == "bucket-duration") {
+            if (!val.isUnsignedInteger() || val.asUnsignedInteger().value() == 0 ||
+                val.asUnsignedInteger().value() % CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS != 0) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    logger, bt2::Error,
+                    "Expecting a positive multiple of {} for the `bucket-duration` parameter.",
+                    CTF_FS_DS_SUMMARY_BASE_BUCKET_DUR_NS);
+            }
+
+            bucketDurNs = val.asUnsignedInteger().value();
+        } else if (key == "begin" || key == "end") {
+            if (!val.isSignedInteger()) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    logger, bt2::Error, "Expecting a signed integer value for the `{}` parameter.",
+                    key);
+            }
+
+            (key == "begin" ? range.begin : range.end) = val.asSignedInteger().value();
+        } else {
+            fsParams->insert(key, *val.copy());
+        }
+    });
+
+    if (range.begin && range.end && *range.begin > *range.end) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error,
+            "Invalid time range: `begin` is greater than `end`: begin={}, end={}", *range.begin,
+            *range.end);
+    }
+
+    const auto parameters = read_src_fs_parameters(*fsParams, logger);
+    ctf_fs_component ctf_fs {parameters.clkClsCfg, logger};
+
+    ctf_fs.indexCache = parameters.indexCache;
+
+    if (ctf_fs_component_create_ctf_fs_trace(
+            &ctf_fs, parameters.inputs,
+            parameters.traceName ? parameters.traceName->c_str() : nullptr, {})) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error, "Failed to create trace");
+    }
+
+    const auto result = bt2::MapValue::create();
+
+    result->insert("bucket-duration-ns", bucketDurNs);
+
+    const auto streamInfos = result->insertEmptyArray("stream-infos");
+    const auto builder = bt2::MapValueBuilder::create();
+
+    try {
+        for (auto& group : ctf_fs.trace->ds_file_groups) {
+            populateEventRecordHistogram(*ctf_fs.trace, *group, parameters, bucketDurNs, range,
+                                         streamInfos, *builder, logger);
+        }
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW_SPEC(logger, "Failed to build event record histogram");
+    }
+
+    return result;
+}
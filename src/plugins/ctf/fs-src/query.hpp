@@ -9,6 +9,7 @@
 #ifndef BABELTRACE_PLUGINS_CTF_FS_SRC_QUERY_HPP
 #define BABELTRACE_PLUGINS_CTF_FS_SRC_QUERY_HPP
 
+#include "cpp-common/bt2/private-query-executor.hpp"
 #include "cpp-common/bt2/value.hpp"
 
 namespace bt2c {
@@ -19,7 +20,28 @@ class Logger;
 
 bt2::Value::Shared metadata_info_query(bt2::ConstValue params, const bt2c::Logger& logger);
 
-bt2::Value::Shared trace_infos_query(bt2::ConstValue params, const bt2c::Logger& logger);
+/*
+ * Also stashes the trace which it builds for a future component having
+ * equivalent parameters (see ctf_fs_stash_trace()).
+ */
+bt2::Value::Shared trace_infos_query(bt2::ConstValue params,
+                                     bt2::PrivateQueryExecutor privQueryExec,
+                                     const bt2c::Logger& logger);
+
+/*
+ * Counts the event records, and their total length, per data stream
+ * and per event record class, without creating any message.
+ */
+bt2::Value::Shared event_record_stats_query(bt2::ConstValue params, const bt2c::Logger& logger);
+
+/*
+ * Returns, per data stream, the number of event records, and their
+ * total length, per time bucket and per event record class, from the
+ * summary cache files (see `index-cache.hpp`), building them first if
+ * needed.
+ */
+bt2::Value::Shared event_record_histogram_query(bt2::ConstValue params,
+                                                const bt2c::Logger& logger);
 
 bt2::Value::Shared support_info_query(bt2::ConstValue params, const bt2c::Logger& logger);
 
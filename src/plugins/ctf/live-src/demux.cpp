@@ -0,0 +1,589 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "common/assert.h"
+#include "cpp-common/bt2c/data-len.hpp"
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/make-unique.hpp"
+
+#include "plugins/ctf/common/src/item-seq/item-seq-iter.hpp"
+#include "plugins/ctf/common/src/item-seq/item.hpp"
+#include "plugins/ctf/common/src/item-seq/medium.hpp"
+#include "demux.hpp"
+
+/*
+ * Medium of the packet property reader: serves the pending bytes of the
+ * demultiplexer.
+ */
+class CtfLiveSocketDemux::_Medium final : public ctf::src::Medium
+{
+public:
+    explicit _Medium(CtfLiveSocketDemux& demux) noexcept : _mDemux {&demux}
+    {
+    }
+
+    ctf::src::Buf buf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                      const bt2c::DataLen prefSize) override
+    {
+        return this->tryBuf(offset, minSize, prefSize).bufOrThrow();
+    }
+
+    ctf::src::BufResult tryBuf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                               const bt2c::DataLen) override
+    {
+        return _mDemux->_tryBuf(offset.bytes(), minSize.bytes());
+    }
+
+private:
+    CtfLiveSocketDemux *_mDemux;
+};
+
+CtfLiveSocketDemux::CtfLiveSocketDemux(const ctf::src::TraceCls& traceCls, FifoMap& fifos,
+                                       const CtfLiveOverflowPolicy overflowPolicy,
+                                       CtfLiveRecorder * const recorder,
+                                       std::mutex * const traceClsMutex, OnMetadata onMetadata,
+                                       const bt2c::Logger& parentLogger) :
+    _mTraceCls {&traceCls},
+    _mFifos {&fifos}, _mOverflowPolicy {overflowPolicy}, _mRecorder {recorder},
+    _mTraceClsMutex {traceClsMutex}, _mOnMetadata {std::move(onMetadata)},
+    _mLogger {parentLogger, "PLUGIN/CTF/LIVE/DEMUX"}
+{
+    this->reset();
+}
+
+void CtfLiveSocketDemux::reset()
+{
+    _mPending.clear();
+    _mPendingSize = 0;
+    _mPendingOffset = 0;
+    _mCurDataStreamCls = nullptr;
+    _mCurPktTotalLen = bt2s::nullopt;
+    _mCurPktLeft = 0;
+    _mCurFifo = nullptr;
+    _mInMetadataPkt = false;
+    _mMetadataPkt.clear();
+
+    _mCurPktBegins = false;
+
+    /*
+     * Recording, finding metadata stream packets, and a history which
+     * only keeps whole packets need the packet boundaries, even with a
+     * single port.
+     */
+    std::size_t fifoCount = 0;
+    bool hasHistory = false;
+
+    for (const auto& clsFifos : *_mFifos) {
+        fifoCount += clsFifos.second.size();
+
+        for (const auto& fifo : clsFifos.second) {
+            hasHistory = hasHistory || fifo->hasHistory();
+        }
+    }
+
+    _mBroadcast = fifoCount <= 1 && !_mRecorder && !_mOnMetadata && !hasHistory;
+
+    if (_mRecorder) {
+        _mRecorder->abortPkt();
+    }
+
+    const auto lock = this->_lockTraceCls();
+
+    /*
+     * Create the item sequence iterator once: creating one attaches
+     * an observer to the trace class, which the port iterators also do
+     * from another thread.
+     */
+    if (_mItemSeqIter) {
+        _mItemSeqIter->seekPkt(bt2c::DataLen::fromBytes(0));
+    } else {
+        _mItemSeqIter = bt2s::make_unique<ctf::src::ItemSeqIter>(
+            bt2s::make_unique<_Medium>(*this), *_mTraceCls, _mLogger);
+    }
+}
+
+std::unique_lock<std::mutex> CtfLiveSocketDemux::_lockTraceCls()
+{
+    if (!_mTraceClsMutex) {
+        return std::unique_lock<std::mutex> {};
+    }
+
+    return std::unique_lock<std::mutex> {*_mTraceClsMutex};
+}
+
+void CtfLiveSocketDemux::_broadcast(const CtfLiveSocketView& view)
+{
+    for (auto& clsFifos : *_mFifos) {
+        for (auto& fifo : clsFifos.second) {
+            this->_pushView(*fifo, view);
+        }
+    }
+}
+
+void CtfLiveSocketDemux::_pushView(CtfLiveSocketFifo& fifo, const CtfLiveSocketView& view)
+{
+    // Once stalled, keep the order: don't let a view overtake the stalled ones.
+    if (!_mStalled.empty() || !fifo.tryPush(view)) {
+        if (_mStalled.empty()) {
+            BT_CPPLOGD("Port buffer is full: stalling: fifo={}, buffered-bytes={}, "
+                       "pinned-bytes={}, max-buffered-bytes={}",
+                       fmt::ptr(&fifo), fifo.size(), fifo.pinnedSize(), fifo.maxSize());
+        }
+
+        _mStalled.push_back({&fifo, view});
+    }
+}
+
+bool CtfLiveSocketDemux::flush()
+{
+    while (!_mStalled.empty()) {
+        auto& stalled = _mStalled.front();
+
+        if (!stalled.fifo->tryPush(stalled.view)) {
+            return false;
+        }
+
+        _mStalled.pop_front();
+    }
+
+    return true;
+}
+
+CtfLiveSocketFifo *CtfLiveSocketDemux::_curPktFifo()
+{
+    const auto clsId = _mCurDataStreamCls->id();
+    const auto& id = _mCurPktProps.dataStreamId;
+    const auto it = _mFifos->find(clsId);
+
+    if (it == _mFifos->end()) {
+        BT_CPPLOGW("No port for data stream class: discarding packet: "
+                   "data-stream-cls-id={}, pkt-len-bytes={}",
+                   clsId, _mCurPktTotalLen->bytes());
+        return nullptr;
+    }
+
+    for (auto& fifo : it->second) {
+        if (!fifo->isBound()) {
+            BT_CPPLOGI("Binding data stream to port: data-stream-cls-id={}, data-stream-id={}",
+                       clsId, id ? fmt::to_string(*id) : "none");
+            fifo->bindDataStream(id);
+            return fifo.get();
+        }
+
+        if (fifo->boundDataStreamId() == id) {
+            return fifo.get();
+        }
+    }
+
+    if (_mUnboundDataStreams.emplace(clsId, id).second) {
+        BT_CPPLOGW("No port left for data stream: discarding its packets: "
+                   "data-stream-cls-id={}, data-stream-id={}, port-count={}",
+                   clsId, id ? fmt::to_string(*id) : "none", it->second.size());
+    }
+
+    return nullptr;
+}
+
+void CtfLiveSocketDemux::push(CtfLiveSocketChunk::ConstSP chunk)
+{
+    if (_mBroadcast) {
+        // A single port, or no known packet boundaries: no need to look inside.
+        this->_broadcast(CtfLiveSocketView {std::move(chunk)});
+        return;
+    }
+
+    _mPendingSize += chunk->len;
+    _mPending.emplace_back(std::move(chunk));
+
+    while (_mPendingSize > 0) {
+        if (_mCurPktLeft > 0) {
+            const auto len = std::min<unsigned long long>(_mCurPktLeft, _mPendingSize);
+
+            this->_route(len, _mCurFifo);
+            _mCurPktLeft -= len;
+
+            if (_mCurPktLeft > 0) {
+                // Wait for the rest of the packet.
+                return;
+            }
+
+            if (_mInMetadataPkt) {
+                this->_endMetadataPkt();
+            } else {
+                this->_endPkt();
+            }
+
+            continue;
+        }
+
+        if (_mOnMetadata) {
+            bool needMore = false;
+
+            if (this->_tryBeginMetadataPkt(needMore)) {
+                continue;
+            } else if (needMore) {
+                return;
+            }
+        }
+
+        if (!this->_tryReadPktProps()) {
+            if (_mBroadcast) {
+                this->_route(_mPendingSize, nullptr);
+            }
+
+            return;
+        }
+    }
+}
+
+void CtfLiveSocketDemux::pushPkt(CtfLiveSocketChunk::ConstSP chunk)
+{
+    const auto len = chunk->len;
+
+    // A datagram never continues a previous one: start a new packet.
+    _mPending.clear();
+    _mPending.emplace_back(std::move(chunk));
+    _mPendingSize = len;
+    _mCurDataStreamCls = nullptr;
+    _mCurPktTotalLen = bt2s::nullopt;
+    _mCurPktLeft = 0;
+    _mBroadcast = false;
+    _mInMetadataPkt = false;
+    _mMetadataPkt.clear();
+
+    {
+        const auto lock = this->_lockTraceCls();
+
+        _mItemSeqIter->seekPkt(bt2c::DataLen::fromBytes(_mPendingOffset));
+    }
+
+    if (_mRecorder) {
+        _mRecorder->abortPkt();
+    }
+
+    if (_mOnMetadata) {
+        bool needMore = false;
+
+        if (this->_tryBeginMetadataPkt(needMore) && _mCurPktLeft <= len) {
+            this->_route(_mCurPktLeft, nullptr);
+            this->_endMetadataPkt();
+            this->_route(_mPendingSize, nullptr);
+            _mCurPktLeft = 0;
+            return;
+        } else if (_mInMetadataPkt || needMore) {
+            BT_CPPLOGW("Discarding truncated metadata stream packet: dgram-len-bytes={}", len);
+            _mInMetadataPkt = false;
+            _mMetadataPkt.clear();
+            _mCurPktLeft = 0;
+            this->_route(_mPendingSize, nullptr);
+            return;
+        }
+    }
+
+    if (!this->_tryReadPktProps()) {
+        BT_CPPLOGW("Discarding datagram which doesn't hold a whole delimited packet: "
+                   "dgram-len-bytes={}",
+                   len);
+        _mBroadcast = false;
+        this->_route(_mPendingSize, nullptr);
+        return;
+    }
+
+    if (_mCurPktLeft > len) {
+        BT_CPPLOGW("Discarding truncated packet: data-stream-cls-id={}, pkt-len-bytes={}, "
+                   "dgram-len-bytes={}",
+                   _mCurDataStreamCls->id(), _mCurPktLeft, len);
+        _mCurFifo = nullptr;
+        _mCurPktLeft = len;
+    }
+
+    // Anything after the packet is padding.
+    this->_route(_mCurPktLeft, _mCurFifo);
+
+    if (_mRecorder && _mRecorder->inPkt()) {
+        if (_mCurPktLeft == _mCurPktTotalLen->bytes()) {
+            _mRecorder->endPkt();
+        } else {
+            _mRecorder->abortPkt();
+        }
+    }
+
+    this->_route(_mPendingSize, nullptr);
+    _mCurPktLeft = 0;
+}
+
+void CtfLiveSocketDemux::_endPkt()
+{
+    if (_mRecorder && _mRecorder->inPkt()) {
+        _mRecorder->endPkt();
+    }
+
+    // Next: read the properties of the next packet.
+    _mCurDataStreamCls = nullptr;
+    _mCurPktTotalLen = bt2s::nullopt;
+
+    const auto lock = this->_lockTraceCls();
+
+    _mItemSeqIter->seekPkt(bt2c::DataLen::fromBytes(_mPendingOffset));
+}
+
+bool CtfLiveSocketDemux::_tryBeginMetadataPkt(bool& needMore)
+{
+    /*
+     * Metadata stream packet header: magic (32 bits), UUID (128 bits),
+     * checksum (32 bits), content size (32 bits), packet size
+     * (32 bits), and then five 8-bit fields.
+     */
+    static constexpr std::size_t pktSizeOffset = 28;
+    static constexpr std::size_t headerLen = 37;
+
+    needMore = false;
+
+    if (_mPendingSize < 4) {
+        needMore = true;
+        return false;
+    }
+
+    const auto *magic = this->_tryBuf(_mPendingOffset, 4).buf().addr();
+
+    if (!isMetadataPktMagic(magic)) {
+        return false;
+    }
+
+    const bool isLe = magic[0] == 0x57;
+
+    if (_mPendingSize < pktSizeOffset + 4) {
+        needMore = true;
+        return false;
+    }
+
+    const auto *field = this->_tryBuf(_mPendingOffset + pktSizeOffset, 4).buf().addr();
+    const auto pktSizeBits =
+        isLe ? (static_cast<std::uint32_t>(field[0]) | static_cast<std::uint32_t>(field[1]) << 8 |
+                static_cast<std::uint32_t>(field[2]) << 16 |
+                static_cast<std::uint32_t>(field[3]) << 24) :
+               (static_cast<std::uint32_t>(field[3]) | static_cast<std::uint32_t>(field[2]) << 8 |
+                static_cast<std::uint32_t>(field[1]) << 16 |
+                static_cast<std::uint32_t>(field[0]) << 24);
+
+    if (pktSizeBits % 8 != 0 || pktSizeBits / 8 < headerLen) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "Invalid metadata stream packet size: offset={}, pkt-size-bits={}",
+            _mPendingOffset, pktSizeBits);
+    }
+
+    BT_CPPLOGD("Found metadata stream packet: offset={}, pkt-len-bytes={}", _mPendingOffset,
+               pktSizeBits / 8);
+    _mInMetadataPkt = true;
+    _mCurFifo = nullptr;
+    _mCurPktLeft = pktSizeBits / 8;
+    _mMetadataPkt.reserve(_mCurPktLeft);
+    return true;
+}
+
+void CtfLiveSocketDemux::_endMetadataPkt()
+{
+    BT_ASSERT(_mInMetadataPkt);
+    _mInMetadataPkt = false;
+
+    if (_mRecorder) {
+        _mRecorder->appendMetadata(_mMetadataPkt);
+    }
+
+    _mOnMetadata(_mMetadataPkt);
+    _mMetadataPkt.clear();
+
+    // Next: read the properties of the packet after it.
+    const auto lock = this->_lockTraceCls();
+
+    _mItemSeqIter->seekPkt(bt2c::DataLen::fromBytes(_mPendingOffset));
+}
+
+bool CtfLiveSocketDemux::_tryReadPktProps()
+{
+    const auto lock = this->_lockTraceCls();
+
+    try {
+        // Only a partial packet header or context throws `bt2c::TryAgain`.
+        const auto status = _mItemSeqIter->tryAdvanceWhile([this](const ctf::src::Item& item) {
+            if (item.isDataStreamInfo()) {
+                BT_ASSERT_DBG(item.asDataStreamInfo().cls());
+                _mCurDataStreamCls = item.asDataStreamInfo().cls();
+                _mCurPktProps.dataStreamId = item.asDataStreamInfo().id();
+            } else if (item.isPktInfo()) {
+                const auto& pktInfo = item.asPktInfo();
+
+                _mCurPktTotalLen = pktInfo.expectedTotalLen();
+
+                if (_mRecorder) {
+                    auto& props = _mCurPktProps;
+
+                    props.contentLenBits = bt2s::nullopt;
+                    if (pktInfo.expectedContentLen()) {
+                        props.contentLenBits = pktInfo.expectedContentLen()->bits();
+                    }
+                    props.beginDefClkVal = pktInfo.beginDefClkVal();
+                    props.endDefClkVal = pktInfo.endDefClkVal();
+                    props.discEventRecordCounterSnap = pktInfo.discEventRecordCounterSnap();
+                    props.seqNum = pktInfo.seqNum();
+                }
+
+                return false;
+            }
+
+            return true;
+        });
+
+        if (status == ctf::src::ItemSeqIter::AdvanceStatus::TryAgain) {
+            // No pending bytes for the next packet yet.
+            return false;
+        }
+
+        BT_ASSERT(status == ctf::src::ItemSeqIter::AdvanceStatus::Stopped);
+    } catch (const bt2c::TryAgain&) {
+        // Packet header or context isn't complete yet.
+        return false;
+    }
+
+    if (!_mCurPktTotalLen) {
+        BT_CPPLOGW("Packet has no expected total length: "
+                   "sending the rest of the stream to all ports: offset={}",
+                   _mPendingOffset);
+
+        if (_mOverflowPolicy == CtfLiveOverflowPolicy::Drop) {
+            BT_CPPLOGW("Packets can't be dropped without packet boundaries: "
+                       "blocking when a port buffer is full.");
+        }
+
+        _mBroadcast = true;
+        return false;
+    }
+
+    BT_ASSERT(_mCurDataStreamCls);
+
+    if (_mRecorder) {
+        // Record every received packet, even the ones which no port gets.
+        _mCurPktProps.dataStreamClsId = _mCurDataStreamCls->id();
+        _mCurPktProps.totalLenBits = _mCurPktTotalLen->bits();
+        _mRecorder->beginPkt(_mCurPktProps);
+    }
+
+    _mCurFifo = this->_curPktFifo();
+
+    if (_mCurFifo && this->_mustDropPkt(*_mCurFifo)) {
+        _mCurFifo = nullptr;
+    }
+
+    BT_CPPLOGD("Routing packet: offset={}, data-stream-cls-id={}, pkt-len-bytes={}",
+               _mPendingOffset, _mCurDataStreamCls->id(), _mCurPktTotalLen->bytes());
+    _mCurPktLeft = _mCurPktTotalLen->bytes();
+    _mCurPktBegins = true;
+    return true;
+}
+
+bool CtfLiveSocketDemux::_mustDropPkt(CtfLiveSocketFifo& fifo)
+{
+    if (_mOverflowPolicy != CtfLiveOverflowPolicy::Drop ||
+        fifo.pinnedSize() + _mCurPktTotalLen->bytes() <= fifo.maxSize()) {
+        return false;
+    }
+
+    fifo.countDroppedPkt();
+
+    if (fifo.droppedPktCount() == 1 && _mCurDataStreamCls->libCls() &&
+        !_mCurDataStreamCls->libCls()->supportsDiscardedPackets()) {
+        BT_CPPLOGW("Dropping packets of a data stream class without packet sequence numbers: "
+                   "the loss won't be reported downstream: data-stream-cls-id={}",
+                   _mCurDataStreamCls->id());
+    }
+
+    BT_CPPLOGI("Port buffer is full: dropping packet: data-stream-cls-id={}, pkt-len-bytes={}, "
+               "buffered-bytes={}, pinned-bytes={}, max-buffered-bytes={}, dropped-pkt-count={}",
+               _mCurDataStreamCls->id(), _mCurPktTotalLen->bytes(), fifo.size(),
+               fifo.pinnedSize(), fifo.maxSize(),
+               fifo.droppedPktCount());
+    return true;
+}
+
+void CtfLiveSocketDemux::_route(std::size_t len, CtfLiveSocketFifo * const fifo)
+{
+    BT_ASSERT(len <= _mPendingSize);
+    _mPendingSize -= len;
+    _mPendingOffset += len;
+
+    while (len > 0) {
+        auto& front = _mPending.front();
+        const auto viewLen = std::min(len, front.len);
+        CtfLiveSocketView view {front.chunk, front.addr, viewLen};
+
+        view.beginsPkt = _mCurPktBegins;
+        _mCurPktBegins = false;
+
+        if (_mRecorder && _mRecorder->inPkt()) {
+            _mRecorder->write(view.addr, view.len);
+        }
+
+        if (_mInMetadataPkt) {
+            _mMetadataPkt.insert(_mMetadataPkt.end(), view.addr, view.addr + view.len);
+        } else if (fifo) {
+            this->_pushView(*fifo, view);
+        } else if (_mBroadcast) {
+            this->_broadcast(view);
+        }
+
+        len -= viewLen;
+
+        if (viewLen == front.len) {
+            _mPending.pop_front();
+        } else {
+            front.addr += viewLen;
+            front.len -= viewLen;
+        }
+    }
+}
+
+ctf::src::BufResult CtfLiveSocketDemux::_tryBuf(const unsigned long long offset,
+                                                const std::size_t minSize)
+{
+    BT_ASSERT(offset >= _mPendingOffset);
+
+    auto rel = offset - _mPendingOffset;
+
+    if (rel + minSize > _mPendingSize) {
+        return ctf::src::BufResult::tryAgain();
+    }
+
+    auto it = _mPending.begin();
+
+    while (rel >= it->len) {
+        rel -= it->len;
+        ++it;
+    }
+
+    if (it->len - rel >= minSize) {
+        return ctf::src::BufResult {
+            ctf::src::Buf {it->addr + rel, bt2c::DataLen::fromBytes(it->len - rel)}};
+    }
+
+    // Straddles two chunks: copy.
+    _mStagingBuf.resize(minSize);
+
+    for (std::size_t copied = 0; copied < minSize; ++it) {
+        const auto len = std::min<std::size_t>(it->len - rel, minSize - copied);
+
+        std::memcpy(&_mStagingBuf[copied], it->addr + rel, len);
+        copied += len;
+        rel = 0;
+    }
+
+    return ctf::src::BufResult {
+        ctf::src::Buf {_mStagingBuf.data(), bt2c::DataLen::fromBytes(minSize)}};
+}
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_DEMUX_HPP
+#define BABELTRACE_PLUGINS_CTF_LIVE_SRC_DEMUX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cpp-common/bt2c/aliases.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "plugins/ctf/common/src/item-seq/item-seq-iter.hpp"
+#include "plugins/ctf/common/src/metadata/ctf-ir.hpp"
+#include "plugins/ctf/live-src/fifo.hpp"
+#include "plugins/ctf/live-src/recorder.hpp"
+
+/*
+ * Splits the incoming byte stream into packets, reading only the packet
+ * header and context of each one, and routes each packet to the FIFO of
+ * its data stream, so that every port only receives and decodes its own
+ * packets.
+ *
+ * Each data stream class has a fixed number of FIFOs. The first packet
+ * of a new data stream instance (by the data stream ID of its header)
+ * binds it to the next unbound FIFO of its class; packets of a data
+ * stream instance for which there's no FIFO left are discarded.
+ *
+ * Packet bytes are routed as views of the received chunks: nothing is
+ * copied.
+ *
+ * With the `CtfLiveOverflowPolicy::Drop` policy, a packet which doesn't
+ * fit in the room left in its FIFO is discarded as a whole. If the
+ * packet context has a sequence number, the port message iterator then
+ * reports the gap as a discarded packets message.
+ *
+ * If a packet has no expected total length, packet boundaries can't be
+ * found anymore: from this point, the demultiplexer sends the whole
+ * remaining stream to all the FIFOs, like a broadcaster, and can only
+ * stall when a FIFO is full.
+ *
+ * The demultiplexer never waits for room in a FIFO: when a FIFO is
+ * full, it keeps the view to route to it, and all the views which
+ * follow it whatever their FIFO, so that each FIFO still gets its data
+ * in order. The caller then stops reading the connection while
+ * isStalled() is true, and calls flush() to try routing those views
+ * again (see CtfLiveSocketFifo::onRoom()).
+ *
+ * Packetized metadata stream packets may be interleaved with the data
+ * packets: the demultiplexer recognizes them by their magic number and
+ * passes each one whole to an `OnMetadata` function instead of routing
+ * it to a port. The trace class may then grow while the demultiplexer
+ * reads packet properties from another thread, hence `traceClsMutex`.
+ *
+ * If there's a recorder, the demultiplexer also writes each packet, as
+ * received, to it.
+ *
+ * With datagram transports, each datagram is expected to hold a whole
+ * packet: pushPkt() routes it without having to find any boundary in
+ * the byte stream, and a lost datagram is a lost packet.
+ *
+ * All the methods must be called from the socket thread.
+ */
+class CtfLiveSocketDemux final
+{
+public:
+    // FIFOs of each data stream class, by data stream class ID.
+    using FifoMap =
+        std::unordered_map<unsigned long long, std::vector<std::unique_ptr<CtfLiveSocketFifo>>>;
+    using OnMetadata = std::function<void(bt2c::ConstBytes)>;
+
+    /*
+     * `traceClsMutex`, if not `nullptr`, is locked while reading
+     * `traceCls`. `onMetadata`, if set, receives the metadata stream
+     * packets found in the byte stream.
+     */
+    explicit CtfLiveSocketDemux(const ctf::src::TraceCls& traceCls, FifoMap& fifos,
+                                CtfLiveOverflowPolicy overflowPolicy, CtfLiveRecorder *recorder,
+                                std::mutex *traceClsMutex, OnMetadata onMetadata,
+                                const bt2c::Logger& parentLogger);
+
+    void push(CtfLiveSocketChunk::ConstSP chunk);
+
+    // Routes `chunk`, a received datagram holding exactly one packet.
+    void pushPkt(CtfLiveSocketChunk::ConstSP chunk);
+
+    /*
+     * Restarts at the beginning of a new byte stream.
+     *
+     * Keeps the stalled views: they're whole views of the previous
+     * byte stream.
+     */
+    void reset();
+
+    // Whether or not some routed views didn't fit in their FIFO yet.
+    bool isStalled() const noexcept
+    {
+        return !_mStalled.empty();
+    }
+
+    /*
+     * Tries to route the stalled views again, in order, returning
+     * whether or not none is left.
+     */
+    bool flush();
+
+private:
+    class _Medium;
+
+    // View which didn't fit in its FIFO yet.
+    struct _StalledView
+    {
+        CtfLiveSocketFifo *fifo;
+        CtfLiveSocketView view;
+    };
+
+    /*
+     * Routes the next `len` pending bytes to `fifo`. If `fifo` is
+     * `nullptr`, routes them to all FIFOs in broadcast mode, or
+     * discards them otherwise.
+     */
+    void _route(std::size_t len, CtfLiveSocketFifo *fifo);
+
+    void _broadcast(const CtfLiveSocketView& view);
+
+    // Pushes `view` to `fifo`, or keeps it as a stalled view.
+    void _pushView(CtfLiveSocketFifo& fifo, const CtfLiveSocketView& view);
+
+    /*
+     * Returns the FIFO of the data stream of the current packet,
+     * binding one if needed, or `nullptr` if there's none.
+     */
+    CtfLiveSocketFifo *_curPktFifo();
+
+    // Returns whether or not the properties of the current packet are known.
+    bool _tryReadPktProps();
+
+    // Ends the current packet, once it's completely routed.
+    void _endPkt();
+
+    std::unique_lock<std::mutex> _lockTraceCls();
+
+    /*
+     * If the pending bytes start with a metadata stream packet, sets
+     * `_mCurPktLeft` to its length and returns true.
+     *
+     * Sets `needMore` if there aren't enough pending bytes to tell.
+     */
+    bool _tryBeginMetadataPkt(bool& needMore);
+
+    // Passes the complete current metadata stream packet to `_mOnMetadata`.
+    void _endMetadataPkt();
+
+    // Returns a "try again" result if the pending bytes don't include the requested range yet.
+    ctf::src::BufResult _tryBuf(unsigned long long offset, std::size_t minSize);
+
+    // Returns whether or not to discard the current packet instead of routing it to `fifo`.
+    bool _mustDropPkt(CtfLiveSocketFifo& fifo);
+
+    const ctf::src::TraceCls *_mTraceCls;
+    FifoMap *_mFifos;
+    CtfLiveOverflowPolicy _mOverflowPolicy;
+    CtfLiveRecorder *_mRecorder;
+    std::mutex *_mTraceClsMutex;
+    OnMetadata _mOnMetadata;
+
+    // Received bytes which aren't routed yet.
+    std::deque<CtfLiveSocketView> _mPending;
+    std::size_t _mPendingSize = 0;
+
+    // Offset of the first pending byte within the byte stream.
+    unsigned long long _mPendingOffset = 0;
+
+    std::unique_ptr<ctf::src::ItemSeqIter> _mItemSeqIter;
+
+    // Properties of the current packet, read so far.
+    const ctf::src::DataStreamCls *_mCurDataStreamCls = nullptr;
+    bt2s::optional<bt2c::DataLen> _mCurPktTotalLen;
+    CtfLiveRecordedPktProps _mCurPktProps;
+
+    // Bytes of the current packet left to route, once its properties are known.
+    unsigned long long _mCurPktLeft = 0;
+    CtfLiveSocketFifo *_mCurFifo = nullptr;
+
+    // Whether or not the next routed view starts the current packet.
+    bool _mCurPktBegins = false;
+
+    // Whether or not the current packet is a metadata stream packet, and its bytes.
+    bool _mInMetadataPkt = false;
+    std::vector<uint8_t> _mMetadataPkt;
+
+    bool _mBroadcast = false;
+
+    // Routed views which didn't fit in their FIFO yet, in routing order.
+    std::deque<_StalledView> _mStalled;
+
+    // Data stream instances without a FIFO, already reported.
+    std::set<std::pair<unsigned long long, bt2s::optional<unsigned long long>>>
+        _mUnboundDataStreams;
+
+    // Staging buffer for header reads which straddle two chunks.
+    std::vector<uint8_t> _mStagingBuf;
+    bt2c::Logger _mLogger;
+};
+
+#endif
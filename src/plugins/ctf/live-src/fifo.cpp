@@ -0,0 +1,336 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#include "common/assert.h"
+#include "cpp-common/bt2c/data-len.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+#include "plugins/ctf/common/src/item-seq/medium.hpp"
+#include "fifo.hpp"
+
+constexpr std::size_t CtfLiveSocketFifo::MAX_STAGED_SIZE;
+
+CtfLiveSocketFifo::CtfLiveSocketFifo(const std::size_t maxSize, const std::size_t historyMaxSize,
+                                     const std::chrono::milliseconds historyMaxAge,
+                                     const std::size_t capacity) :
+    _mMutex(), _mCv(), _mProducerStalled(false),
+    _mConsumerWaiting(false), _mClosed(false), _mChunks(capacity),
+    _mFrontChunkOffset(0), _mSize(0), _mMaxSize(maxSize), _mDroppedPktCount(0),
+    _mHistoryMaxSize(historyMaxSize), _mHistoryMaxAge(historyMaxAge), _mCurrentOffset(0),
+    _mCurrentBuf(),
+    _mLogger("FIFO", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info)
+{
+}
+
+const CtfLiveSocketView *CtfLiveSocketFifo::_view(const std::size_t index) noexcept
+{
+    if (index < _mReplay.size()) {
+        return &_mReplay[index];
+    }
+
+    return _mChunks.peek(index - _mReplay.size());
+}
+
+void CtfLiveSocketFifo::_drop(unsigned long count)
+{
+    BT_ASSERT(count <= this->_availSize());
+
+    while (count > 0) {
+        const auto fromReplay = !_mReplay.empty();
+        const auto *front = this->_view(0);
+        BT_ASSERT_DBG(front);
+        const auto frontLeft = front->len - _mFrontChunkOffset;
+        const auto len = std::min<std::size_t>(count, frontLeft);
+
+        if (fromReplay) {
+            _mReplaySize -= len;
+        } else {
+            _mSize.fetch_sub(len, std::memory_order_relaxed);
+        }
+
+        count -= len;
+
+        if (len < frontLeft) {
+            _mFrontChunkOffset += len;
+            break;
+        }
+
+        _mFrontChunkOffset = 0;
+
+        // Releases this reader's reference to the chunk, unless the history keeps it.
+        if (fromReplay) {
+            const auto view = std::move(_mReplay.front());
+
+            _mReplay.pop_front();
+            this->_record(view);
+        } else {
+            const auto view = std::move(*_mChunks.peek());
+
+            _mChunks.pop();
+            _mPinnedSize.fetch_sub(view.pinnedSize(), std::memory_order_relaxed);
+            this->_record(view);
+        }
+    }
+
+    _notifyProducer();
+}
+
+void CtfLiveSocketFifo::_record(const CtfLiveSocketView& view)
+{
+    if (_mHistoryMaxSize == 0) {
+        return;
+    }
+
+    if (_mHistory.empty() && !_mHistoryAligned) {
+        if (!view.beginsPkt) {
+            // Not a whole packet: useless to replay.
+            return;
+        }
+
+        _mHistoryAligned = true;
+    }
+
+    _mHistory.push_back(view);
+    _mHistorySize += view.len;
+    _mHistoryPinnedSize += view.pinnedSize();
+    this->_trimHistory();
+}
+
+void CtfLiveSocketFifo::_trimHistory()
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    while (!_mHistory.empty() && (_mHistoryPinnedSize > _mHistoryMaxSize ||
+                                  (_mHistoryMaxAge.count() > 0 &&
+                                   now - _mHistory.front().chunk->recvTime > _mHistoryMaxAge))) {
+        // Drop the oldest packet as a whole so that the history still starts with one.
+        do {
+            _mHistorySize -= _mHistory.front().len;
+            _mHistoryPinnedSize -= _mHistory.front().pinnedSize();
+            _mHistory.pop_front();
+        } while (!_mHistory.empty() && !_mHistory.front().beginsPkt);
+
+        if (_mHistory.empty()) {
+            /*
+             * Aligned only if the unconsumed views start with a packet,
+             * that is, if we didn't just drop a part of it.
+             */
+            const auto *next = this->_view(0);
+
+            _mHistoryAligned = next && next->beginsPkt;
+        }
+    }
+}
+
+bool CtfLiveSocketFifo::canRewind()
+{
+    if (_mCurrentOffset == 0) {
+        // Nothing consumed: already at a packet boundary.
+        return true;
+    }
+
+    this->_trimHistory();
+    return _mHistoryMaxSize > 0 && _mHistoryAligned;
+}
+
+void CtfLiveSocketFifo::rewind()
+{
+    BT_ASSERT(this->canRewind());
+
+    // The consumed bytes of the front view are unconsumed again.
+    if (!_mReplay.empty()) {
+        _mReplaySize += _mFrontChunkOffset;
+    } else {
+        _mSize.fetch_add(_mFrontChunkOffset, std::memory_order_relaxed);
+    }
+
+    _mFrontChunkOffset = 0;
+
+    // The history precedes the unconsumed views: replay it first.
+    _mReplay.insert(_mReplay.begin(), _mHistory.begin(), _mHistory.end());
+    _mReplaySize += _mHistorySize;
+    _mHistory.clear();
+    _mHistorySize = 0;
+    _mHistoryPinnedSize = 0;
+    _mCurrentOffset = 0;
+    BT_CPPLOGD("FIFO={} rewound: replay-size={}", fmt::ptr(this), _mReplaySize);
+}
+
+void CtfLiveSocketFifo::_notifyConsumer()
+{
+    // Pairs with the fence in _waitForData(), like _notifyProducer().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_mConsumerWaiting.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lg {_mMutex};
+        _mCv.notify_one();
+    }
+}
+
+void CtfLiveSocketFifo::_notifyProducer()
+{
+    // Pairs with the fence in tryPush() so that either the producer
+    // sees the room we just made, or we see that it's stalled.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_mProducerStalled.load(std::memory_order_relaxed) &&
+        _mProducerStalled.exchange(false, std::memory_order_relaxed) && _mOnRoom) {
+        _mOnRoom();
+    }
+}
+
+ctf::src::BufResult CtfLiveSocketFifo::next(unsigned long offset, unsigned long count,
+                                            const unsigned long prefCount,
+                                            const std::chrono::milliseconds timeout)
+{
+    if (offset != _mCurrentOffset) {
+        BT_ASSERT(offset >= _mCurrentOffset);
+        _drop(offset - _mCurrentOffset);
+        _mCurrentOffset = offset;
+        BT_CPPLOGD("Advance to offset={}", offset);
+    }
+
+    // If there's not enough data, wait for it, and then let the caller try again.
+    if (this->_availSize() < count && !this->_waitForData(count, timeout)) {
+        BT_CPPLOGD("Not enough data: have={}, need={}", this->size(), count);
+        return ctf::src::BufResult::tryAgain();
+    }
+
+    BT_ASSERT_DBG(count > 0);
+
+    const auto& front = *this->_view(0);
+    const auto frontLeft = front.len - _mFrontChunkOffset;
+
+    _mLastRecvTime = front.chunk->recvTime;
+
+    if (frontLeft >= count) {
+        /*
+         * Fast path: hand out everything left in the front chunk. It
+         * remains valid until a later call drops it.
+         */
+        const auto *addr = front.addr + _mFrontChunkOffset;
+        BT_CPPLOGD("FIFO={} returning chunk data len={}", fmt::ptr(this), frontLeft);
+        BT_CPPLOGT_MEM(bt2c::ConstBytes(addr, count), "FIFO={} chunk data:", fmt::ptr(this));
+        return ctf::src::BufResult {ctf::src::Buf(addr, bt2c::DataLen::fromBytes(frontLeft))};
+    }
+
+    // Copy as much of the preferred size as is already buffered.
+    count = std::max<std::size_t>(
+        count, std::min({static_cast<std::size_t>(prefCount), MAX_STAGED_SIZE,
+                         this->_availSize()}));
+
+    // Resize the temp buffer if we need more space for the request.
+    if (_mCurrentBuf.size() < count) {
+        _mCurrentBuf.resize(count);
+    }
+    // The request straddles chunks: copy it to a temporary buffer. The
+    // data will persist until the next call to next().
+    {
+        auto chunkOffset = _mFrontChunkOffset;
+        std::size_t copied = 0;
+
+        for (std::size_t i = 0; copied < count; ++i) {
+            const auto *view = this->_view(i);
+            BT_ASSERT_DBG(view);
+            const auto len = std::min<std::size_t>(view->len - chunkOffset, count - copied);
+            std::memcpy(&_mCurrentBuf[copied], view->addr + chunkOffset, len);
+            copied += len;
+            chunkOffset = 0;
+        }
+    }
+    BT_CPPLOGD("FIFO={} returning data len={}", fmt::ptr(this), count);
+    BT_CPPLOGT_MEM(bt2c::ConstBytes(_mCurrentBuf.data(), count), "FIFO={} data:", fmt::ptr(this));
+    return ctf::src::BufResult {
+        ctf::src::Buf(_mCurrentBuf.data(), bt2c::DataLen::fromBytes(count))};
+}
+
+bool CtfLiveSocketFifo::tryPush(const CtfLiveSocketView& view)
+{
+    const auto len = view.len;
+
+    BT_ASSERT_DBG(len > 0);
+
+    if (_mClosed) {
+        // No reader anymore.
+        return true;
+    }
+
+    auto viewCopy = view;
+
+    if (!_hasRoom() || !_mChunks.tryPush(std::move(viewCopy))) {
+        if (!_mStallBegin) {
+            _mStallBegin = std::chrono::steady_clock::now();
+        }
+
+        // Pairs with the fence in _notifyProducer().
+        _mProducerStalled.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // The reader may have made room meanwhile: retry once.
+        if (!_hasRoom() || !_mChunks.tryPush(std::move(viewCopy))) {
+            return false;
+        }
+
+        _mProducerStalled.store(false, std::memory_order_relaxed);
+    }
+
+    if (_mStallBegin) {
+        _mProducerBlockedNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now() - *_mStallBegin)
+                                          .count(),
+                                      std::memory_order_relaxed);
+        _mStallBegin.reset();
+    }
+
+    // Before `_mSize`: the reader can't pop this view before that.
+    _mPinnedSize.fetch_add(view.pinnedSize(), std::memory_order_relaxed);
+
+    const auto newSize = _mSize.fetch_add(len, std::memory_order_release) + len;
+
+    // Only the producer updates the high-water mark: no need to compare and swap.
+    if (newSize > _mHighWaterSize.load(std::memory_order_relaxed)) {
+        _mHighWaterSize.store(newSize, std::memory_order_relaxed);
+    }
+
+    this->_notifyConsumer();
+    return true;
+}
+
+void CtfLiveSocketFifo::close()
+{
+    std::lock_guard<std::mutex> lg {_mMutex};
+    _mClosed = true;
+    _mCv.notify_all();
+}
+
+bool CtfLiveSocketFifo::_waitForData(const unsigned long count,
+                                     const std::chrono::milliseconds timeout)
+{
+    if (timeout.count() <= 0 || _mClosed) {
+        return false;
+    }
+
+    const auto waitBegin = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lk(_mMutex);
+    _mConsumerWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const auto ready = _mCv.wait_for(lk, timeout, [this, count] {
+        return this->_availSize() >= count || _mClosed;
+    });
+
+    _mConsumerWaiting.store(false, std::memory_order_relaxed);
+    _mConsumerWaitNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - waitBegin)
+                                   .count(),
+                               std::memory_order_relaxed);
+    return ready && this->_availSize() >= count;
+}
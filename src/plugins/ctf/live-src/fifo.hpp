@@ -0,0 +1,418 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_FIFO_HPP
+#define BABELTRACE_PLUGINS_CTF_LIVE_SRC_FIFO_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/assert.h"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2c/spsc-ring.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+#include "cpp-common/bt2s/span.hpp"
+
+#include "plugins/ctf/common/src/item-seq/medium.hpp"
+#include "plugins/ctf/live-src/latency-histo.hpp"
+
+/*
+ * Block of bytes filled by a single recv() call.
+ *
+ * Once pushed, a chunk is immutable and shared, without copying, by
+ * all the FIFOs which need its data.
+ */
+struct CtfLiveSocketChunk
+{
+    using SP = std::shared_ptr<CtfLiveSocketChunk>;
+    using ConstSP = std::shared_ptr<const CtfLiveSocketChunk>;
+
+    explicit CtfLiveSocketChunk(const std::size_t capacity) : buf(capacity)
+    {
+    }
+
+    bt2s::span<const uint8_t> data() const noexcept
+    {
+        return {buf.data(), len};
+    }
+
+    std::vector<uint8_t> buf;
+
+    // Number of valid bytes in `buf`.
+    std::size_t len = 0;
+
+    // Time at which the socket thread started filling this chunk.
+    std::chrono::steady_clock::time_point recvTime;
+};
+
+/*
+ * Slice of the valid bytes of a chunk, keeping the chunk alive.
+ */
+struct CtfLiveSocketView
+{
+    CtfLiveSocketView() = default;
+
+    explicit CtfLiveSocketView(CtfLiveSocketChunk::ConstSP chunkParam) :
+        chunk(std::move(chunkParam)), addr(chunk->buf.data()), len(chunk->len)
+    {
+    }
+
+    explicit CtfLiveSocketView(CtfLiveSocketChunk::ConstSP chunkParam, const uint8_t *addrParam,
+                               const std::size_t lenParam) :
+        chunk(std::move(chunkParam)),
+        addr(addrParam), len(lenParam)
+    {
+    }
+
+    /*
+     * Number of bytes of memory which this view pins: its share of the
+     * capacity of `chunk`, in proportion to `len`.
+     *
+     * The views of a chunk pin its whole capacity together, however
+     * few bytes it holds (short read, small datagram).
+     */
+    std::size_t pinnedSize() const noexcept
+    {
+        BT_ASSERT_DBG(chunk && chunk->len > 0);
+        return len * chunk->buf.size() / chunk->len;
+    }
+
+    CtfLiveSocketChunk::ConstSP chunk;
+    const uint8_t *addr = nullptr;
+    std::size_t len = 0;
+
+    // Whether or not this view starts a packet.
+    bool beginsPkt = false;
+};
+
+/*
+ * What to do with incoming data when a FIFO is full.
+ */
+enum class CtfLiveOverflowPolicy
+{
+    // Stop reading the socket until the reader catches up, letting TCP flow control slow the sender.
+    Block,
+
+    // Discard whole incoming packets.
+    Drop,
+};
+
+/*
+ * Single-producer/single-consumer chunk queue which buffers incoming
+ * socket data and serves it to a reader on demand, waiting for a
+ * bounded time, and then returning a "try again" result, when
+ * insufficient data is available.
+ *
+ * The socket thread pushes chunks and the reader thread calls next():
+ * neither takes a lock, except for the reader to sleep when the queue
+ * is empty. The socket thread never waits: tryPush() fails when the
+ * queue is full, and the reader calls the `onRoom` function once it
+ * makes room again.
+ *
+ * With a history, the reader keeps the views which it consumed, up to
+ * a given size and age, dropping the oldest packets as a whole. Those
+ * views share the chunks instead of copying them. rewind() then
+ * makes next() serve the history again, from offset 0, before the
+ * rest of the queue, so that a new CTF message iterator can decode
+ * the recent data again.
+ */
+class CtfLiveSocketFifo
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+    // Maximum number of bytes which next() copies to satisfy `prefCount`.
+    static constexpr std::size_t MAX_STAGED_SIZE = 64 * 1024;
+
+    /*
+     * `maxSize` is a soft limit of the memory which the buffered views
+     * pin (see CtfLiveSocketView::pinnedSize()): tryPush() fails while
+     * it's reached, but may then exceed it by one view.
+     *
+     * `historyMaxSize` is the maximum memory which the views of the
+     * history pin (no history if zero) and `historyMaxAge`, if not
+     * zero, the maximum age of their chunks.
+     */
+    explicit CtfLiveSocketFifo(std::size_t maxSize, std::size_t historyMaxSize = 0,
+                               std::chrono::milliseconds historyMaxAge = {},
+                               std::size_t capacity = DEFAULT_CAPACITY);
+
+    /*
+     * Returns the data at `offset`, at least `count` bytes, waiting at
+     * most `timeout` for it to arrive.
+     *
+     * When the requested data straddles two chunks, this method copies
+     * it to a staging buffer: then it copies up to `prefCount` bytes
+     * (at most `MAX_STAGED_SIZE`) of the buffered data instead of just
+     * `count` so that the next calls aren't as frequent.
+     *
+     * Returns a "try again" result if there's still not enough data
+     * after `timeout`, or as soon as close() is called.
+     */
+    ctf::src::BufResult next(unsigned long offset, unsigned long count, unsigned long prefCount,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds {0});
+
+    /*
+     * Socket thread: appends a copy of `view`, returning false, without
+     * waiting, if the queue is full.
+     *
+     * After a failed call, the reader calls the function which
+     * onRoom() sets once it makes room.
+     *
+     * Always succeeds, discarding `view`, once close() is called.
+     */
+    bool tryPush(const CtfLiveSocketView& view);
+
+    /*
+     * Socket thread, before the first tryPush() call: sets the function
+     * which the reader thread calls when it makes room after a failed
+     * tryPush() call.
+     */
+    void onRoom(std::function<void()> func)
+    {
+        _mOnRoom = std::move(func);
+    }
+
+    // Number of buffered bytes not consumed by the reader yet.
+    std::size_t size() const noexcept
+    {
+        return _mSize.load(std::memory_order_relaxed);
+    }
+
+    // Memory which the buffered views not consumed by the reader yet pin.
+    std::size_t pinnedSize() const noexcept
+    {
+        return _mPinnedSize.load(std::memory_order_relaxed);
+    }
+
+    std::size_t maxSize() const noexcept
+    {
+        return _mMaxSize;
+    }
+
+    // Records that the producer discarded a whole packet instead of pushing it.
+    void countDroppedPkt() noexcept
+    {
+        _mDroppedPktCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    unsigned long long droppedPktCount() const noexcept
+    {
+        return _mDroppedPktCount.load(std::memory_order_relaxed);
+    }
+
+    // Highest number of buffered bytes so far.
+    std::size_t highWaterSize() const noexcept
+    {
+        return _mHighWaterSize.load(std::memory_order_relaxed);
+    }
+
+    // Total time during which tryPush() failed, until it succeeded again.
+    std::chrono::nanoseconds producerBlockedTime() const noexcept
+    {
+        return std::chrono::nanoseconds {_mProducerBlockedNs.load(std::memory_order_relaxed)};
+    }
+
+    // Total time which next() spent waiting for data.
+    std::chrono::nanoseconds consumerWaitTime() const noexcept
+    {
+        return std::chrono::nanoseconds {_mConsumerWaitNs.load(std::memory_order_relaxed)};
+    }
+
+    // Records that the reader emitted `count` messages out of this FIFO's data.
+    void countMsgs(const unsigned long long count) noexcept
+    {
+        _mMsgCount.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    unsigned long long msgCount() const noexcept
+    {
+        return _mMsgCount.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * Reader thread: time at which the socket thread received the
+     * first chunk of the data which the last next() call returned.
+     */
+    std::chrono::steady_clock::time_point lastRecvTime() const noexcept
+    {
+        return _mLastRecvTime;
+    }
+
+    /*
+     * Latencies from the default clock snapshots of the emitted events
+     * to the reception of their data (reader thread records).
+     */
+    CtfLiveLatencyHisto& latencyHisto() noexcept
+    {
+        return _mLatencyHisto;
+    }
+
+    const CtfLiveLatencyHisto& latencyHisto() const noexcept
+    {
+        return _mLatencyHisto;
+    }
+
+    /*
+     * Delays from the reception of the data of the emitted events to
+     * their emission (reader thread records).
+     */
+    CtfLiveLatencyHisto& queueingDelayHisto() noexcept
+    {
+        return _mQueueingDelayHisto;
+    }
+
+    const CtfLiveLatencyHisto& queueingDelayHisto() const noexcept
+    {
+        return _mQueueingDelayHisto;
+    }
+
+    /*
+     * Socket thread: binds this FIFO to the data stream instance of ID
+     * `id` (`bt2s::nullopt` if packets have no data stream ID), before
+     * pushing its first packet.
+     */
+    void bindDataStream(const bt2s::optional<unsigned long long>& id) noexcept
+    {
+        BT_ASSERT_DBG(!this->isBound());
+        _mBoundDataStreamId = id;
+        _mBound.store(true, std::memory_order_release);
+    }
+
+    // Whether or not bindDataStream() was called; may be called from any thread.
+    bool isBound() const noexcept
+    {
+        return _mBound.load(std::memory_order_acquire);
+    }
+
+    // Data stream instance ID of the binding, only valid if isBound() is true.
+    const bt2s::optional<unsigned long long>& boundDataStreamId() const noexcept
+    {
+        BT_ASSERT_DBG(this->isBound());
+        return _mBoundDataStreamId;
+    }
+
+    /*
+     * Reader thread: returns whether or not rewind() may restart at a
+     * packet boundary, that is, whether nothing was consumed since the
+     * beginning or the last rewind, or the history starts with a whole
+     * packet.
+     */
+    bool canRewind();
+
+    /*
+     * Reader thread: makes offset 0 of next() the beginning of the
+     * history.
+     *
+     * canRewind() must be true.
+     */
+    void rewind();
+
+    bool hasHistory() const noexcept
+    {
+        return _mHistoryMaxSize > 0;
+    }
+
+    // Wakes up a waiting reader and disables future tryPush() calls.
+    void close();
+
+private:
+    // Returns whether or not at least `count` bytes are buffered.
+    bool _waitForData(unsigned long count, std::chrono::milliseconds timeout);
+    void _drop(unsigned long count);
+
+    // View `index` of the unconsumed data: replayed views come first.
+    const CtfLiveSocketView *_view(std::size_t index) noexcept;
+
+    // Number of unconsumed bytes, including the replayed ones.
+    std::size_t _availSize() const noexcept
+    {
+        return _mReplaySize + _mSize.load(std::memory_order_acquire);
+    }
+
+    // Appends the consumed view `view` to the history, and trims it.
+    void _record(const CtfLiveSocketView& view);
+    void _trimHistory();
+    void _notifyProducer();
+    void _notifyConsumer();
+
+    bool _hasRoom() const noexcept
+    {
+        return !_mChunks.full() && this->pinnedSize() < _mMaxSize;
+    }
+
+    std::mutex _mMutex;
+    // Used for notification from socket thread to readers.
+    std::condition_variable _mCv;
+    // Whether or not the last tryPush() call failed.
+    std::atomic<bool> _mProducerStalled;
+
+    // See onRoom().
+    std::function<void()> _mOnRoom;
+
+    // Time of the first failed tryPush() call since the last successful one (socket thread only).
+    bt2s::optional<std::chrono::steady_clock::time_point> _mStallBegin;
+    std::atomic<bool> _mConsumerWaiting;
+    std::atomic<bool> _mClosed;
+    bt2c::SpscRing<CtfLiveSocketView> _mChunks;
+    // Number of already consumed bytes of the front view (reader only).
+    std::size_t _mFrontChunkOffset;
+    // Number of unconsumed bytes in `_mChunks`.
+    std::atomic<std::size_t> _mSize;
+    // Memory which the views of `_mChunks` pin.
+    std::atomic<std::size_t> _mPinnedSize {0};
+    std::size_t _mMaxSize;
+    std::atomic<unsigned long long> _mDroppedPktCount;
+
+    // Views consumed again before `_mChunks`, after rewind() (reader only).
+    std::deque<CtfLiveSocketView> _mReplay;
+    std::size_t _mReplaySize = 0;
+
+    // History (reader only).
+    std::size_t _mHistoryMaxSize;
+    std::chrono::milliseconds _mHistoryMaxAge;
+    std::deque<CtfLiveSocketView> _mHistory;
+    std::size_t _mHistorySize = 0;
+    // Memory which the views of `_mHistory` pin.
+    std::size_t _mHistoryPinnedSize = 0;
+
+    /*
+     * Whether or not the history, followed by the unconsumed views,
+     * starts with a whole packet.
+     */
+    bool _mHistoryAligned = true;
+
+    // See bindDataStream().
+    std::atomic<bool> _mBound {false};
+    bt2s::optional<unsigned long long> _mBoundDataStreamId;
+
+    // Statistics, only written by a single thread each.
+    std::atomic<std::size_t> _mHighWaterSize {0};
+    std::atomic<std::int64_t> _mProducerBlockedNs {0};
+    std::atomic<std::int64_t> _mConsumerWaitNs {0};
+    std::atomic<unsigned long long> _mMsgCount {0};
+    CtfLiveLatencyHisto _mLatencyHisto;
+    CtfLiveLatencyHisto _mQueueingDelayHisto;
+
+    // See lastRecvTime() (reader only).
+    std::chrono::steady_clock::time_point _mLastRecvTime;
+
+    unsigned long _mCurrentOffset;
+    // Staging buffer for requests which straddle two chunks.
+    std::vector<uint8_t> _mCurrentBuf;
+    bt2c::Logger _mLogger;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#include <algorithm>
+
+#include "latency-histo.hpp"
+
+constexpr unsigned int CtfLiveLatencyHisto::SUB_BUCKET_BITS;
+constexpr std::size_t CtfLiveLatencyHisto::SUB_BUCKET_COUNT;
+constexpr std::size_t CtfLiveLatencyHisto::BUCKET_COUNT;
+
+unsigned long long CtfLiveLatencyHisto::bucketHighestVal(const std::size_t index) noexcept
+{
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    const auto shift = static_cast<unsigned int>(index / SUB_BUCKET_COUNT - 1);
+    const auto lowest = static_cast<unsigned long long>(index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT)
+                        << shift;
+
+    return lowest + ((1ULL << shift) - 1);
+}
+
+CtfLiveLatencyHistoSnapshot CtfLiveLatencyHisto::snapshot() const noexcept
+{
+    CtfLiveLatencyHistoSnapshot snapshot;
+    std::array<unsigned long long, BUCKET_COUNT> counts;
+
+    /* Count from the buckets themselves so that the percentiles are consistent */
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        counts[i] = _mBuckets[i].load(std::memory_order_relaxed);
+        snapshot.count += counts[i];
+    }
+
+    snapshot.negativeCount = _mNegativeCount.load(std::memory_order_relaxed);
+
+    if (snapshot.count == 0) {
+        return snapshot;
+    }
+
+    snapshot.min = _mMin.load(std::memory_order_relaxed);
+    snapshot.max = _mMax.load(std::memory_order_relaxed);
+    snapshot.mean = _mSum.load(std::memory_order_relaxed) / snapshot.count;
+
+    struct
+    {
+        unsigned long long perMille;
+        unsigned long long *val;
+    } percentiles[] = {
+        {500, &snapshot.p50},
+        {900, &snapshot.p90},
+        {990, &snapshot.p99},
+        {999, &snapshot.p999},
+    };
+
+    unsigned long long cumulCount = 0;
+    std::size_t percentileIndex = 0;
+
+    for (std::size_t i = 0; i < BUCKET_COUNT && percentileIndex < 4; ++i) {
+        cumulCount += counts[i];
+
+        while (percentileIndex < 4 &&
+               cumulCount * 1000 >= percentiles[percentileIndex].perMille * snapshot.count) {
+            /* Never report more than the maximum value */
+            *percentiles[percentileIndex].val = std::min(bucketHighestVal(i), snapshot.max);
+            ++percentileIndex;
+        }
+    }
+
+    return snapshot;
+}
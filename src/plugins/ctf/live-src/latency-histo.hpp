@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_LATENCY_HISTO_HPP
+#define BABELTRACE_PLUGINS_CTF_LIVE_SRC_LATENCY_HISTO_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "common/common.h"
+
+/*
+ * Snapshot of a latency histogram, all durations in nanoseconds.
+ *
+ * The percentiles are the highest values of their bucket, so they're
+ * at most 1/8 (12.5 %) greater than the exact ones.
+ */
+struct CtfLiveLatencyHistoSnapshot
+{
+    unsigned long long count = 0;
+
+    // Number of negative durations (clock skew), not part of `count`.
+    unsigned long long negativeCount = 0;
+
+    unsigned long long min = 0;
+    unsigned long long max = 0;
+    unsigned long long mean = 0;
+    unsigned long long p50 = 0;
+    unsigned long long p90 = 0;
+    unsigned long long p99 = 0;
+    unsigned long long p999 = 0;
+};
+
+/*
+ * HDR-style (log-linear) histogram of durations in nanoseconds.
+ *
+ * Each power of two range has 8 buckets of equal width, so that the
+ * relative error of a bucket is at most 12.5 % over the whole 64-bit
+ * range, with 496 fixed buckets and no allocation.
+ *
+ * A single thread records, and any other thread may take a snapshot
+ * concurrently: a snapshot may then miss the latest values, but it's
+ * never torn.
+ */
+class CtfLiveLatencyHisto final
+{
+public:
+    // log2 of the number of buckets per power of two range.
+    static constexpr unsigned int SUB_BUCKET_BITS = 3;
+    static constexpr std::size_t SUB_BUCKET_COUNT = 1U << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    // Records the duration `ns`.
+    void record(const long long ns) noexcept
+    {
+        if (G_UNLIKELY(ns < 0)) {
+            this->_inc(_mNegativeCount);
+            return;
+        }
+
+        const auto val = static_cast<unsigned long long>(ns);
+
+        this->_inc(_mBuckets[bucketIndex(val)]);
+        this->_inc(_mCount);
+        _mSum.store(_mSum.load(std::memory_order_relaxed) + val, std::memory_order_relaxed);
+
+        if (val < _mMin.load(std::memory_order_relaxed)) {
+            _mMin.store(val, std::memory_order_relaxed);
+        }
+
+        if (val > _mMax.load(std::memory_order_relaxed)) {
+            _mMax.store(val, std::memory_order_relaxed);
+        }
+    }
+
+    CtfLiveLatencyHistoSnapshot snapshot() const noexcept;
+
+    // Index of the bucket of `val`.
+    static std::size_t bucketIndex(const unsigned long long val) noexcept
+    {
+        if (val < 2 * SUB_BUCKET_COUNT) {
+            return static_cast<std::size_t>(val);
+        }
+
+        const auto shift = static_cast<unsigned int>(63 - __builtin_clzll(val)) - SUB_BUCKET_BITS;
+
+        return static_cast<std::size_t>(shift * SUB_BUCKET_COUNT + (val >> shift));
+    }
+
+    // Highest value of the bucket at the index `index`.
+    static unsigned long long bucketHighestVal(std::size_t index) noexcept;
+
+private:
+    /*
+     * Single writer: a load and a store are enough, and cheaper than
+     * an atomic read-modify-write operation.
+     */
+    static void _inc(std::atomic<unsigned long long>& counter) noexcept
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<unsigned long long>, BUCKET_COUNT> _mBuckets {};
+    std::atomic<unsigned long long> _mCount {0};
+    std::atomic<unsigned long long> _mNegativeCount {0};
+    std::atomic<unsigned long long> _mSum {0};
+    std::atomic<unsigned long long> _mMin {~0ULL};
+    std::atomic<unsigned long long> _mMax {0};
+};
+
+#endif
@@ -5,13 +5,18 @@
  * Copyright (C) 2026 Analog Devices
  *
  */
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <babeltrace2/babeltrace.h>
 
 #include "common/assert.h"
 #include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/bt2/value.hpp"
 #include "cpp-common/bt2/wrap.hpp"
 #include "cpp-common/bt2c/data-len.hpp"
 #include "cpp-common/bt2c/exc.hpp"
@@ -35,6 +40,13 @@ using namespace bt2c::literals::datalen;
 
 static bt2c::Logger s_logger {"SOURCE.CTF.LIVE", "SOURCE.CTF.LIVE", bt2c::Logger::Level::Info};
 
+/*
+ * Live components of this plugin, for the `statistics` query, which
+ * only has access to the component class.
+ */
+static std::mutex s_comps_mutex;
+static std::vector<ctf_live_component *> s_comps;
+
 static ctf_live_component *priv(bt_self_component_source *component)
 {
     return static_cast<ctf_live_component *>(
@@ -64,6 +76,19 @@ ctf_live_trace_create(const char *path, const char *name, const ctf::src::ClkCls
     return live_trace;
 }
 
+/*
+ * Returns the parameter named `name` of `params`, or `nullptr` if
+ * there's none.
+ */
+static const bt_value *borrow_param(const bt_value *params, const char *name)
+{
+    if (!bt_value_is_map(params) || !bt_value_map_has_entry(params, name)) {
+        return nullptr;
+    }
+
+    return bt_value_map_borrow_entry_value_const(params, name);
+}
+
 bt_component_class_get_supported_mip_versions_method_status ctf_live_get_supported_mip_versions(
     bt_self_component_class_source *selfCompClsSrc, const bt_value *params, void *method_data,
     bt_logging_level logLevel, bt_integer_range_set_unsigned *supportedVersions)
@@ -93,44 +118,233 @@ ctf_live_init(bt_self_component_source *self_comp_src,
     }
     bt_self_component_set_data(bt_self_component_source_as_self_component(self_comp_src), comp);
 
-    std::string metadataPath = ".";
-    if (bt_value_is_map(params) && bt_value_map_has_entry(params, "metadata-path")) {
-        metadataPath =
-            bt_value_string_get(bt_value_map_borrow_entry_value_const(params, "metadata-path"));
-    }
+    try {
+        CtfLiveSocketServerCfg cfg;
+        std::string metadataPath = ".";
+        std::vector<std::string> clientMetadataPaths;
+        std::size_t maxClients = 1;
 
-    //  Parse the metadata file
-    comp->trace = ctf_live_trace_create(metadataPath.c_str(), "trace", ctf::src::ClkClsCfg {},
-                                        static_cast<bt2::SelfComponent>(bt2::wrap(self_comp_src)));
-    size_t idx = 0;
-    //  Create an output port for each of the streams found in the metadata
-    //  file.
-    for (const auto& streamCls : comp->trace->cls()->dataStreamClasses()) {
-        auto *port = new ctf_live_port_output;
-        if (!port) {
-            for (auto *p : comp->ports) {
-                delete p;
+        if (const auto *val = borrow_param(params, "metadata-path")) {
+            metadataPath = bt_value_string_get(val);
+        }
+        if (const auto *val = borrow_param(params, "max-clients")) {
+            maxClients = bt_value_integer_unsigned_get(val);
+            if (maxClients == 0) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(s_logger, bt2c::Error,
+                                                       "`max-clients` must be greater than 0");
             }
-            delete comp;
-            return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
-        }
-        port->comp = comp;
-        port->stream_id = idx++;
-        port->name = std::string {"out"} + std::to_string(port->stream_id);
-        port->data_stream_cls = streamCls.get();
-        comp->ports.push_back(port);
-        bt_self_component_source_add_output_port(self_comp_src, port->name.data(), port, nullptr);
-    }
-    try {
-        unsigned port = 42674;
-        if (bt_value_is_map(params)) {
-            if (bt_value_map_has_entry(params, "port")) {
-                port = bt_value_integer_unsigned_get(
-                    bt_value_map_borrow_entry_value_const(params, "port"));
+        }
+        if (const auto *val = borrow_param(params, "client-metadata-paths")) {
+            /*
+             * The client of the slot `i` sends a trace of which the
+             * metadata is in the `i`th directory: this is how a single
+             * component receives different traces.
+             */
+            for (std::uint64_t i = 0; i < bt_value_array_get_length(val); ++i) {
+                clientMetadataPaths.emplace_back(
+                    bt_value_string_get(bt_value_array_borrow_element_by_index_const(val, i)));
+            }
+            if (!borrow_param(params, "max-clients")) {
+                maxClients = clientMetadataPaths.size();
+            } else if (clientMetadataPaths.size() != maxClients) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error,
+                    "`client-metadata-paths` must have `max-clients` elements: "
+                    "client-metadata-paths-len={}, max-clients={}",
+                    clientMetadataPaths.size(), maxClients);
+            }
+        }
+        if (clientMetadataPaths.empty()) {
+            clientMetadataPaths.assign(maxClients, metadataPath);
+        }
+        if (const auto *val = borrow_param(params, "transport")) {
+            const std::string transport = bt_value_string_get(val);
+            if (transport == "tcp") {
+                cfg.transport = CtfLiveTransport::Tcp;
+            } else if (transport == "udp") {
+                cfg.transport = CtfLiveTransport::Udp;
+            } else if (transport == "unix") {
+                cfg.transport = CtfLiveTransport::UnixStream;
+            } else if (transport == "unix-dgram") {
+                cfg.transport = CtfLiveTransport::UnixDgram;
+            } else {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error,
+                    "Invalid `transport` parameter: expecting `tcp`, `udp`, `unix`, or "
+                    "`unix-dgram`: value={}",
+                    transport);
+            }
+        }
+        if ((cfg.transport == CtfLiveTransport::Udp ||
+             cfg.transport == CtfLiveTransport::UnixDgram) &&
+            maxClients != 1) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                s_logger, bt2c::Error,
+                "Datagram transports receive a single trace: `max-clients` must be 1: "
+                "max-clients={}",
+                maxClients);
+        }
+        if (const auto *val = borrow_param(params, "path")) {
+            cfg.path = bt_value_string_get(val);
+        }
+        bool inbandMetadata = false;
+        if (const auto *val = borrow_param(params, "inband-metadata")) {
+            inbandMetadata = bt_value_bool_get(val);
+        }
+        std::string recordPath;
+        if (const auto *val = borrow_param(params, "record-path")) {
+            recordPath = bt_value_string_get(val);
+        }
+        if (const auto *val = borrow_param(params, "stats-log-period-ms")) {
+            cfg.statsLogPeriod = std::chrono::milliseconds {
+                static_cast<std::chrono::milliseconds::rep>(bt_value_integer_unsigned_get(val))};
+        }
+        if (const auto *val = borrow_param(params, "latency-stats")) {
+            cfg.latencyStats = bt_value_bool_get(val);
+        }
+        if (const auto *val = borrow_param(params, "address")) {
+            cfg.address = bt_value_string_get(val);
+        }
+        if (const auto *val = borrow_param(params, "inactivity-timeout-ms")) {
+            comp->inactivity_timeout = std::chrono::milliseconds {
+                static_cast<std::chrono::milliseconds::rep>(bt_value_integer_unsigned_get(val))};
+        }
+        if (const auto *val = borrow_param(params, "port")) {
+            cfg.port = static_cast<int>(bt_value_integer_unsigned_get(val));
+        }
+        if (const auto *val = borrow_param(params, "buffer-size")) {
+            cfg.recvBufSize = bt_value_integer_unsigned_get(val);
+            if (cfg.recvBufSize == 0) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(s_logger, bt2c::Error,
+                                                       "`buffer-size` must be greater than 0");
+            }
+        }
+        if (const auto *val = borrow_param(params, "max-port-buffer-size")) {
+            cfg.fifoMaxSize = bt_value_integer_unsigned_get(val);
+            if (cfg.fifoMaxSize < cfg.recvBufSize) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error,
+                    "`max-port-buffer-size` must be greater than or equal to `buffer-size`: "
+                    "max-port-buffer-size={}, buffer-size={}",
+                    cfg.fifoMaxSize, cfg.recvBufSize);
+            }
+        }
+        if (const auto *val = borrow_param(params, "streams-per-class")) {
+            cfg.fifosPerDataStreamCls = bt_value_integer_unsigned_get(val);
+            if (cfg.fifosPerDataStreamCls == 0) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error, "`streams-per-class` must be greater than 0");
+            }
+        }
+        if (const auto *val = borrow_param(params, "history-size")) {
+            cfg.historyMaxSize = bt_value_integer_unsigned_get(val);
+        }
+        if (const auto *val = borrow_param(params, "history-duration-ms")) {
+            cfg.historyMaxAge = std::chrono::milliseconds {
+                static_cast<std::chrono::milliseconds::rep>(bt_value_integer_unsigned_get(val))};
+        }
+        if (const auto *val = borrow_param(params, "compression")) {
+            const std::string compression = bt_value_string_get(val);
+            if (compression == "none") {
+                cfg.compression = CtfLiveCompression::None;
+            } else if (compression == "zstd") {
+                cfg.compression = CtfLiveCompression::Zstd;
+            } else {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error,
+                    "Invalid `compression` parameter: expecting `none` or `zstd`: value={}",
+                    compression);
+            }
+        }
+        if (const auto *val = borrow_param(params, "overflow-policy")) {
+            const std::string policy = bt_value_string_get(val);
+            if (policy == "block") {
+                cfg.overflowPolicy = CtfLiveOverflowPolicy::Block;
+            } else if (policy == "drop") {
+                cfg.overflowPolicy = CtfLiveOverflowPolicy::Drop;
+            } else {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    s_logger, bt2c::Error,
+                    "Invalid `overflow-policy` parameter: expecting `block` or `drop`: value={}",
+                    policy);
+            }
+        }
+
+        //  Parse the metadata file of each client slot, and create an output
+        //  port for each of the streams found in it.
+        std::vector<CtfLiveSocketSlotCfg> slotCfgs;
+
+        for (std::size_t slot = 0; slot < maxClients; ++slot) {
+            const auto traceName = maxClients == 1 ? std::string {"trace"} :
+                                                     fmt::format("trace-{}", slot);
+
+            comp->traces.emplace_back(ctf_live_trace_create(
+                clientMetadataPaths[slot].c_str(), traceName.c_str(), ctf::src::ClkClsCfg {},
+                static_cast<bt2::SelfComponent>(bt2::wrap(self_comp_src))));
+
+            auto& trace = *comp->traces.back();
+            std::uint64_t idx = 0;
+            std::size_t clsIdx = 0;
+
+            CtfLiveSocketSlotCfg slotCfg;
+
+            slotCfg.traceCls = trace.cls();
+
+            if (inbandMetadata) {
+                //  Parsed by the message iterators, which own the trace class.
+                slotCfg.traceClsMutex = &trace.clsMutex;
+                slotCfg.onMetadata = [&trace](const bt2c::ConstBytes pkt) {
+                    trace.appendMetadata(pkt);
+                };
+            }
+
+            if (!recordPath.empty()) {
+                //  Keep a copy of the received data, as is, next to the metadata.
+                const auto metadataFilePath = fmt::format(
+                    "{}" G_DIR_SEPARATOR_S "metadata", clientMetadataPaths[slot]);
+
+                slotCfg.recorder = bt2s::make_unique<CtfLiveRecorder>(
+                    maxClients == 1 ? recordPath :
+                                      fmt::format("{}" G_DIR_SEPARATOR_S "client{}", recordPath,
+                                                  slot),
+                    bt2c::dataFromFile(metadataFilePath, s_logger, true), s_logger);
+            }
+
+            slotCfgs.emplace_back(std::move(slotCfg));
+
+            /*
+             * One port per possible data stream instance: the graph
+             * can't get new ports once it's configured.
+             */
+            for (const auto& streamCls : trace.cls()->dataStreamClasses()) {
+                for (std::size_t i = 0; i < cfg.fifosPerDataStreamCls; ++i) {
+                    auto *port = new ctf_live_port_output;
+                    port->comp = comp;
+                    port->slot = slot;
+                    port->trace = &trace;
+                    port->fifo_index = i;
+                    port->default_stream_id = idx++;
+
+                    const auto baseName = cfg.fifosPerDataStreamCls == 1 ?
+                                              fmt::format("out{}", port->default_stream_id) :
+                                              fmt::format("out{}-{}", clsIdx, i);
+
+                    port->name = maxClients == 1 ? baseName :
+                                                   fmt::format("client{}-{}", slot, baseName);
+                    port->data_stream_cls = streamCls.get();
+                    comp->ports.push_back(port);
+                    bt_self_component_source_add_output_port(self_comp_src, port->name.data(),
+                                                             port, nullptr);
+                }
+
+                ++clsIdx;
             }
         }
 
-        comp->server = bt2s::make_unique<CtfLiveSocketServer>(static_cast<int>(port));
+        comp->server = bt2s::make_unique<CtfLiveSocketServer>(std::move(slotCfgs), cfg);
+
+        std::lock_guard<std::mutex> lock {s_comps_mutex};
+        s_comps.push_back(comp);
     } catch (const bt2c::Error& e) {
         BT_CPPLOGE_APPEND_CAUSE_SPEC(s_logger, "Error initializing live socket server");
         for (auto *p : comp->ports) {
@@ -143,6 +357,97 @@ ctf_live_init(bt_self_component_source *self_comp_src,
     return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 }
 
+/*
+ * Inserts a map entry named `name` into `mapObj` for the latency
+ * histogram snapshot `snapshot`.
+ */
+static void insert_latency_stats(const bt2::MapValue mapObj, const char * const name,
+                                 const CtfLiveLatencyHistoSnapshot& snapshot)
+{
+    const auto obj = mapObj.insertEmptyMap(name);
+
+    obj.insert("count", static_cast<std::uint64_t>(snapshot.count));
+    obj.insert("negative-count", static_cast<std::uint64_t>(snapshot.negativeCount));
+    obj.insert("min-ns", static_cast<std::uint64_t>(snapshot.min));
+    obj.insert("mean-ns", static_cast<std::uint64_t>(snapshot.mean));
+    obj.insert("p50-ns", static_cast<std::uint64_t>(snapshot.p50));
+    obj.insert("p90-ns", static_cast<std::uint64_t>(snapshot.p90));
+    obj.insert("p99-ns", static_cast<std::uint64_t>(snapshot.p99));
+    obj.insert("p99.9-ns", static_cast<std::uint64_t>(snapshot.p999));
+    obj.insert("max-ns", static_cast<std::uint64_t>(snapshot.max));
+}
+
+static bt2::Value::Shared statistics_query()
+{
+    auto result = bt2::ArrayValue::create();
+    std::lock_guard<std::mutex> lock {s_comps_mutex};
+
+    for (const auto *comp : s_comps) {
+        const auto& cfg = comp->server->cfg();
+        const auto compObj = result->appendEmptyMap();
+        const auto slotsObj = compObj.insertEmptyArray("slots");
+        const auto slotsStats = comp->server->stats();
+
+        compObj.insert("address", cfg.address.c_str());
+        compObj.insert("port", static_cast<std::uint64_t>(cfg.port));
+
+        for (std::size_t slot = 0; slot < slotsStats.size(); ++slot) {
+            const auto& slotStats = slotsStats[slot];
+            const auto slotObj = slotsObj.appendEmptyMap();
+            const auto portsObj = slotObj.insertEmptyArray("ports");
+
+            slotObj.insert("connected", slotStats.connected);
+            slotObj.insert("connection-count", static_cast<std::uint64_t>(slotStats.connCount));
+            slotObj.insert("received-bytes", static_cast<std::uint64_t>(slotStats.rxBytes));
+            slotObj.insert("decompressed-bytes",
+                           static_cast<std::uint64_t>(slotStats.decompressedBytes));
+            slotObj.insert("recv-calls", static_cast<std::uint64_t>(slotStats.recvCalls));
+
+            for (const auto& fifoStats : slotStats.fifos) {
+                const auto portIt = std::find_if(
+                    comp->ports.begin(), comp->ports.end(), [&](const ctf_live_port_output *port) {
+                        return port->slot == slot &&
+                               port->data_stream_cls->id() == fifoStats.dataStreamClsId &&
+                               port->fifo_index == fifoStats.index;
+                    });
+                const auto portObj = portsObj.appendEmptyMap();
+
+                if (portIt != comp->ports.end()) {
+                    portObj.insert("name", (*portIt)->name.c_str());
+                }
+
+                portObj.insert("data-stream-class-id",
+                               static_cast<std::uint64_t>(fifoStats.dataStreamClsId));
+
+                if (fifoStats.dataStreamId) {
+                    portObj.insert("data-stream-id",
+                                   static_cast<std::uint64_t>(*fifoStats.dataStreamId));
+                }
+
+                portObj.insert("buffered-bytes", static_cast<std::uint64_t>(fifoStats.size));
+                portObj.insert("pinned-bytes", static_cast<std::uint64_t>(fifoStats.pinnedSize));
+                portObj.insert("max-buffered-bytes", static_cast<std::uint64_t>(fifoStats.maxSize));
+                portObj.insert("high-water-buffered-bytes",
+                               static_cast<std::uint64_t>(fifoStats.highWaterSize));
+                portObj.insert("dropped-packets",
+                               static_cast<std::uint64_t>(fifoStats.droppedPktCount));
+                portObj.insert("producer-blocked-ns",
+                               static_cast<std::uint64_t>(fifoStats.producerBlockedTime.count()));
+                portObj.insert("consumer-wait-ns",
+                               static_cast<std::uint64_t>(fifoStats.consumerWaitTime.count()));
+                portObj.insert("messages", static_cast<std::uint64_t>(fifoStats.msgCount));
+
+                if (cfg.latencyStats) {
+                    insert_latency_stats(portObj, "latency", fifoStats.latency);
+                    insert_latency_stats(portObj, "queueing-delay", fifoStats.queueingDelay);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
 bt_component_class_query_method_status
 ctf_live_query(bt_self_component_class_source *comp_class_src,
                bt_private_query_executor *priv_query_exec, const char *object,
@@ -150,17 +455,33 @@ ctf_live_query(bt_self_component_class_source *comp_class_src,
 {
     (void) comp_class_src;
     (void) priv_query_exec;
-    (void) object;
     (void) params;
     (void) method_data;
 
-    *result = bt_value_null;
-    return BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_OK;
+    try {
+        if (std::strcmp(object, "statistics") == 0) {
+            *result = statistics_query().release().libObjPtr();
+            return BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_OK;
+        }
+
+        BT_CPPLOGE_SPEC(s_logger, "Unknown query object `{}`", object);
+        return BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_UNKNOWN_OBJECT;
+    } catch (const std::bad_alloc&) {
+        return BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_COMPONENT_CLASS_QUERY_METHOD_STATUS_ERROR;
+    }
 }
 
 void ctf_live_finalize(bt_self_component_source *component)
 {
     auto *comp = priv(component);
+
+    {
+        std::lock_guard<std::mutex> lock {s_comps_mutex};
+        s_comps.erase(std::remove(s_comps.begin(), s_comps.end(), comp), s_comps.end());
+    }
+
     for (auto *port : comp->ports) {
         delete port;
     }
@@ -186,16 +507,179 @@ ctf_live_iterator_init(bt_self_message_iterator *self_msg_iter,
     bt_self_message_iterator_configuration_set_can_seek_forward(config, true);
     bt_self_message_iterator_set_data(self_msg_iter, it);
 
-    const auto streamCls = *port->data_stream_cls->libCls();
-
     it->comp = static_cast<ctf_live_component *>(bt_self_component_get_data(self_component));
-    it->stream = streamCls.instantiate(*it->comp->trace->trace, port->stream_id);
-    auto medium = it->comp->server->create_medium();
+    it->port = port;
+    it->trace = port->trace;
+    it->fifo = &it->comp->server->fifo(port->slot, port->data_stream_cls->id(), port->fifo_index);
+    if (const auto clockCls = port->data_stream_cls->libCls()->defaultClockClass()) {
+        it->clock_cls = clockCls->libObjPtr();
+        it->clock_origin_is_unix_epoch = bt_clock_class_origin_is_unix_epoch(it->clock_cls);
+    }
+
+    return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+}
+
+/*
+ * Creates the stream and the CTF message iterator of `it` once there's
+ * data for its port, waiting a bit for it, and returns whether or not
+ * they exist.
+ */
+static bool ctf_live_iterator_try_start(ctf_live_iterator *it,
+                                        bt_self_message_iterator *self_msg_iter)
+{
+    static constexpr std::chrono::milliseconds maxWait {50};
+
+    if (it->msg_iter) {
+        return true;
+    }
+
+    const auto port = it->port;
+
+    /*
+     * A previous message iterator of this port may have consumed some
+     * data: restart at the beginning of the history.
+     */
+    if (!it->fifo->canRewind()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            s_logger, bt2::Error,
+            "Port data was already consumed and isn't in its history: port-name={}", port->name);
+    }
+
+    it->fifo->rewind();
+
+    /*
+     * The demultiplexer binds a data stream instance to the FIFO
+     * before pushing its first packet. In broadcast mode, it pushes
+     * without binding: then any data is for this port.
+     */
+    if (!it->fifo->isBound() &&
+        !it->fifo->next(0, 1, 1, std::min(it->comp->inactivity_timeout, maxWait)).isOk() &&
+        !it->fifo->isBound()) {
+        return false;
+    }
+
+    // All the message iterators of a port share its stream.
+    if (!port->stream) {
+        const auto streamId = it->fifo->isBound() && it->fifo->boundDataStreamId() ?
+                                  *it->fifo->boundDataStreamId() :
+                                  port->default_stream_id;
+
+        BT_CPPLOGI_SPEC(s_logger,
+                        "Starting port: port-name={}, data-stream-cls-id={}, stream-id={}",
+                        port->name, port->data_stream_cls->id(), streamId);
+        port->stream =
+            port->data_stream_cls->libCls()->instantiate(*port->trace->trace, streamId);
+    }
+
+    it->stream = port->stream;
+
+    auto medium = it->comp->server->create_medium(
+        port->slot, port->data_stream_cls->id(), port->fifo_index, it->comp->inactivity_timeout,
+        [self_msg_iter] {
+            return static_cast<bool>(bt_self_message_iterator_is_interrupted(self_msg_iter));
+        });
     it->msg_iter = bt2s::make_unique<ctf::src::MsgIter>(
-        bt2::wrap(self_msg_iter), *it->comp->trace->cls(), it->comp->trace->parseRet->uuid,
+        bt2::wrap(self_msg_iter), *port->trace->cls(), port->trace->parser->metadataStreamUuid(),
         *it->stream, std::move(medium), ctf::src::MsgIterQuirks {}, s_logger);
+    return true;
+}
 
-    return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+/*
+ * Returns the value of the latest clock snapshot of `msg`, if any.
+ */
+static bt2s::optional<uint64_t> msg_last_ts(const bt2::ConstMessage msg)
+{
+    switch (msg.type()) {
+    case bt2::MessageType::Event:
+        if (msg.asEvent().streamClassDefaultClockClass()) {
+            return msg.asEvent().defaultClockSnapshot().value();
+        }
+
+        break;
+    case bt2::MessageType::PacketBeginning:
+        if (msg.asPacketBeginning().packet().stream().cls().packetsHaveBeginningClockSnapshot()) {
+            return msg.asPacketBeginning().defaultClockSnapshot().value();
+        }
+
+        break;
+    case bt2::MessageType::PacketEnd:
+        if (msg.asPacketEnd().packet().stream().cls().packetsHaveEndClockSnapshot()) {
+            return msg.asPacketEnd().defaultClockSnapshot().value();
+        }
+
+        break;
+    case bt2::MessageType::DiscardedEvents:
+        if (msg.asDiscardedEvents().stream().cls().discardedEventsHaveDefaultClockSnapshots()) {
+            return msg.asDiscardedEvents().endDefaultClockSnapshot().value();
+        }
+
+        break;
+    case bt2::MessageType::DiscardedPackets:
+        if (msg.asDiscardedPackets().stream().cls().discardedPacketsHaveDefaultClockSnapshots()) {
+            return msg.asDiscardedPackets().endDefaultClockSnapshot().value();
+        }
+
+        break;
+    case bt2::MessageType::MessageIteratorInactivity:
+        return msg.asMessageIteratorInactivity().clockSnapshot().value();
+    case bt2::MessageType::StreamBeginning:
+        if (msg.asStreamBeginning().streamClassDefaultClockClass()) {
+            if (const auto cs = msg.asStreamBeginning().defaultClockSnapshot()) {
+                return cs->value();
+            }
+        }
+
+        break;
+    case bt2::MessageType::StreamEnd:
+        if (msg.asStreamEnd().streamClassDefaultClockClass()) {
+            if (const auto cs = msg.asStreamEnd().defaultClockSnapshot()) {
+                return cs->value();
+            }
+        }
+
+        break;
+    default:
+        break;
+    }
+
+    return bt2s::nullopt;
+}
+
+/*
+ * Records the latency and the queueing delay of an event of which the
+ * default clock snapshot value is `ts`, and which `it` is about to
+ * emit.
+ *
+ * The reception time of an event is the one of the first chunk of the
+ * data which the CTF message iterator was decoding, which is usually
+ * the chunk containing the event record. After a rewind, the delays of
+ * the events of the history include the time they spent in it.
+ */
+static void ctf_live_iterator_record_latency(ctf_live_iterator *it, const uint64_t ts)
+{
+    const auto queueingDelay = std::chrono::steady_clock::now() - it->fifo->lastRecvTime();
+
+    it->fifo->queueingDelayHisto().record(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(queueingDelay).count());
+
+    /* The event time is only comparable to the wall time from the Unix epoch */
+    if (!it->clock_origin_is_unix_epoch) {
+        return;
+    }
+
+    int64_t eventNs;
+
+    if (bt_clock_class_cycles_to_ns_from_origin(it->clock_cls, ts, &eventNs) !=
+        BT_CLOCK_CLASS_CYCLES_TO_NS_FROM_ORIGIN_STATUS_OK) {
+        return;
+    }
+
+    const auto recvWallTime = std::chrono::system_clock::now() - queueingDelay;
+    const auto recvWallNs =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(recvWallTime.time_since_epoch())
+            .count();
+
+    it->fifo->latencyHisto().record(recvWallNs - eventNs);
 }
 
 bt_message_iterator_class_next_method_status
@@ -206,12 +690,68 @@ ctf_live_iterator_next(bt_self_message_iterator *self_msg_iter, bt_message_array
 
     bt_message_iterator_class_next_method_status status =
         BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    const bool latencyStats = it->comp->server->cfg().latencyStats;
     uint64_t i = 0;
 
+    try {
+        /*
+         * Apply the metadata received in-band before decoding more
+         * packets: they may need the new event record classes.
+         */
+        const auto dataStreamClsCount = it->trace->cls()->dataStreamClasses().size();
+
+        if (it->trace->parsePendingMetadata()) {
+            BT_CPPLOGI_SPEC(s_logger, "Updated trace class with in-band metadata");
+
+            if (it->trace->cls()->dataStreamClasses().size() != dataStreamClsCount) {
+                BT_CPPLOGW_SPEC(s_logger,
+                                "In-band metadata adds data stream classes: "
+                                "their packets have no port and are discarded");
+            }
+        }
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_SPEC(s_logger, "Failed to parse in-band metadata");
+        return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+    }
+
+    try {
+        if (!ctf_live_iterator_try_start(it, self_msg_iter)) {
+            // No data stream for this port yet.
+            return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+        }
+    } catch (const bt2::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_SPEC(s_logger, "Failed to start port: port-name={}",
+                                     it->port->name);
+        return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+    } catch (const std::bad_alloc&) {
+        return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+    }
+
     do {
+        /*
+         * The CTF message iterator reports "try again" without throwing
+         * when there's no data between two packets or event records,
+         * which is the common case here, and throws `bt2::TryAgain`
+         * otherwise.
+         */
+        bool tryAgain = false;
+
         try {
-            bt2::ConstMessage::Shared msg = it->msg_iter->next();
-            if (G_LIKELY(msg)) {
+            bt2::ConstMessage::Shared msg;
+
+            if (it->msg_iter->tryNext(msg) == ctf::src::MsgIter::NextStatus::TryAgain) {
+                tryAgain = true;
+            } else if (G_LIKELY(msg)) {
+                if (it->clock_cls) {
+                    if (const auto ts = msg_last_ts(*msg)) {
+                        it->last_ts = ts;
+
+                        if (latencyStats && msg->type() == bt2::MessageType::Event) {
+                            ctf_live_iterator_record_latency(it, *ts);
+                        }
+                    }
+                }
+
                 msgs[i] = msg.release().libObjPtr();
                 ++i;
             } else {
@@ -224,6 +764,32 @@ ctf_live_iterator_next(bt_self_message_iterator *self_msg_iter, bt_message_array
             status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
             break;
         } catch (const bt2::TryAgain&) {
+            tryAgain = true;
+        }
+
+        if (tryAgain) {
+            /*
+             * No data within the inactivity timeout: tell downstream
+             * that nothing happened until the latest timestamp instead
+             * of letting the graph poll us again right away.
+             */
+            if (i == 0 && it->clock_cls && it->last_ts &&
+                !bt_self_message_iterator_is_interrupted(self_msg_iter)) {
+                const auto msg = bt_message_message_iterator_inactivity_create(
+                    self_msg_iter, it->clock_cls, *it->last_ts);
+
+                if (!msg) {
+                    BT_CPPLOGE_APPEND_CAUSE_SPEC(
+                        s_logger, "Error emitting message iterator inactivity message");
+                    status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+                    break;
+                }
+
+                BT_CPPLOGD_SPEC(s_logger, "Emitting inactivity message: ts={}", *it->last_ts);
+                msgs[i] = msg;
+                ++i;
+            }
+
             status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
             break;
         }
@@ -254,16 +820,42 @@ ctf_live_iterator_next(bt_self_message_iterator *self_msg_iter, bt_message_array
         }
 
         *count = i;
+        it->fifo->countMsgs(i);
         status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
     }
 
     return status;
 }
 
+bt_message_iterator_class_can_seek_beginning_method_status
+ctf_live_iterator_can_seek_beginning(bt_self_message_iterator *self_msg_iter,
+                                     bt_bool *can_seek_beginning)
+{
+    auto *it = static_cast<ctf_live_iterator *>(bt_self_message_iterator_get_data(self_msg_iter));
+
+    *can_seek_beginning = it->fifo->canRewind();
+    return BT_MESSAGE_ITERATOR_CLASS_CAN_SEEK_BEGINNING_METHOD_STATUS_OK;
+}
+
 bt_message_iterator_class_seek_beginning_method_status
-ctf_live_iterator_seek_beginning(bt_self_message_iterator *it)
+ctf_live_iterator_seek_beginning(bt_self_message_iterator *self_msg_iter)
 {
-    (void) it;
+    auto *it = static_cast<ctf_live_iterator *>(bt_self_message_iterator_get_data(self_msg_iter));
+
+    /*
+     * Decode the history again with a new CTF message iterator: the
+     * next call to ctf_live_iterator_next() creates it.
+     */
+    it->msg_iter.reset();
+    it->fifo->rewind();
+    it->last_ts = bt2s::nullopt;
+
+    if (it->next_saved_error) {
+        bt_error_release(it->next_saved_error);
+        it->next_saved_error = nullptr;
+        it->next_saved_status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    }
+
     return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
 }
 
@@ -8,11 +8,14 @@
 #ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_LIVE_SRC_HPP
 #define BABELTRACE_PLUGINS_CTF_LIVE_SRC_LIVE_SRC_HPP
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <sys/types.h>
@@ -59,9 +62,23 @@ struct ctf_live_trace
     bt2c::Logger logger;
     ctf::src::ClkClsCfg clkClsCfg;
     bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp;
-    bt2s::optional<ctf::src::MetadataStreamParser::ParseRet> parseRet;
+    ctf::src::MetadataStreamParser::UP parser;
     bt2::Trace::Shared trace;
 
+    /*
+     * Serializes the updates of the trace class (graph thread) with the
+     * packet property reads of the demultiplexer (socket thread).
+     */
+    std::mutex clsMutex;
+
+    /*
+     * Metadata stream sections received in-band, not parsed yet:
+     * the socket thread appends, and the graph thread parses them.
+     */
+    std::mutex pendingMetadataMutex;
+    std::vector<std::uint8_t> pendingMetadata;
+    std::atomic<bool> hasPendingMetadata {false};
+
     explicit ctf_live_trace(const ctf::src::ClkClsCfg& clkClsCfg,
                             const bt2::OptionalBorrowedObject<bt2::SelfComponent> selfComp,
                             const bt2c::Logger& parentLogger) :
@@ -71,37 +88,122 @@ struct ctf_live_trace
 
     const ctf::src::TraceCls *cls() const
     {
-        BT_ASSERT(parseRet);
-        BT_ASSERT(parseRet->traceCls);
-        return parseRet->traceCls.get();
+        BT_ASSERT(parser);
+        BT_ASSERT(parser->traceCls());
+        return parser->traceCls();
     }
 
     void parseMetadata(const bt2c::ConstBytes buffer)
     {
-        parseRet = ctf::src::parseMetadataStream(selfComp, clkClsCfg, buffer, logger);
+        if (!parser) {
+            parser = ctf::src::createMetadataStreamParser(buffer, selfComp, clkClsCfg, logger);
+        }
+
+        std::lock_guard<std::mutex> lock {clsMutex};
+
+        parser->parseSection(buffer);
+    }
+
+    // Socket thread: queues a metadata stream section received in-band.
+    void appendMetadata(const bt2c::ConstBytes buffer)
+    {
+        std::lock_guard<std::mutex> lock {pendingMetadataMutex};
+
+        pendingMetadata.insert(pendingMetadata.end(), buffer.begin(), buffer.end());
+        hasPendingMetadata.store(true, std::memory_order_release);
+    }
+
+    /*
+     * Graph thread: parses the queued metadata stream sections, if any,
+     * returning whether or not there were some.
+     */
+    bool parsePendingMetadata()
+    {
+        if (!hasPendingMetadata.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        std::vector<std::uint8_t> buffer;
+
+        {
+            std::lock_guard<std::mutex> lock {pendingMetadataMutex};
+
+            buffer.swap(pendingMetadata);
+            hasPendingMetadata.store(false, std::memory_order_relaxed);
+        }
+
+        this->parseMetadata(buffer);
+        return true;
     }
 };
 
 struct ctf_live_component
 {
-    std::unique_ptr<ctf_live_trace> trace;
+    // One trace per client slot of the server.
+    std::vector<std::unique_ptr<ctf_live_trace>> traces;
     std::unique_ptr<CtfLiveSocketServer> server;
     std::vector<ctf_live_port_output *> ports;
+
+    // How long a message iterator waits for data before emitting an inactivity message.
+    std::chrono::milliseconds inactivity_timeout {100};
 };
 
 struct ctf_live_port_output
 {
     ctf_live_component *comp;
     std::string name;
-    uint8_t stream_id;
+
+    // Client slot of the server, and its trace.
+    std::size_t slot;
+    ctf_live_trace *trace;
     const ctf::src::DataStreamCls *data_stream_cls;
+
+    // Index of the FIFO of this port within the ones of its data stream class.
+    std::size_t fifo_index;
+
+    // Data stream instance ID when the packets don't have any.
+    uint64_t default_stream_id;
+
+    // Stream of the message iterators of this port, once one starts.
+    bt2::Stream::Shared stream;
 };
 
+/*
+ * Message iterator of a port.
+ *
+ * The socket thread receives, decompresses, and demultiplexes the
+ * data, but the CTF message iterator decodes on the graph thread: it
+ * creates libbabeltrace2 objects, of which the reference counts and
+ * pools aren't thread-safe.
+ */
 struct ctf_live_iterator
 {
     ctf_live_component *comp;
+    ctf_live_port_output *port;
+    ctf_live_trace *trace;
+
+    // Port FIFO, for statistics.
+    CtfLiveSocketFifo *fifo;
+
+    /*
+     * Created once a data stream instance is bound to `fifo`, as the
+     * ID of the stream is the one of the data stream instance.
+     */
     std::unique_ptr<ctf::src::MsgIter> msg_iter;
     bt2::Stream::Shared stream;
+
+    /*
+     * Default clock class of the stream class and value of the latest
+     * clock snapshot sent downstream, if any: inactivity messages
+     * repeat it, so that a downstream muxer may send the messages of
+     * other ports until then while this port is idle.
+     */
+    const bt_clock_class *clock_cls = nullptr;
+    bt2s::optional<uint64_t> last_ts;
+
+    // Whether or not the origin of `clock_cls` is the Unix epoch (latency statistics).
+    bool clock_origin_is_unix_epoch = false;
+
     /*
      * Saved error.  If we hit an error in the _next method, but have some
      * messages ready to return, we save the error here and return it on
@@ -140,6 +242,9 @@ ctf_live_iterator_init(bt_self_message_iterator *self_msg_iter,
 
 void ctf_live_iterator_finalize(bt_self_message_iterator *it);
 
+bt_message_iterator_class_can_seek_beginning_method_status
+ctf_live_iterator_can_seek_beginning(bt_self_message_iterator *it, bt_bool *can_seek_beginning);
+
 bt_message_iterator_class_seek_beginning_method_status
 ctf_live_iterator_seek_beginning(bt_self_message_iterator *it);
 
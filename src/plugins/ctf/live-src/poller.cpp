@@ -0,0 +1,496 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#include "common/assert.h"
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+#include "poller.hpp"
+
+#if defined(CTF_LIVE_SOCKET_POLLER_EPOLL)
+#    include <sys/epoll.h>
+#    include <sys/eventfd.h>
+#    include <unistd.h>
+#elif defined(CTF_LIVE_SOCKET_POLLER_IOCP)
+#    include <cstring>
+
+#    include "cpp-common/bt2s/make-unique.hpp"
+#else
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
+CtfLiveSocketPoller::CtfLiveSocketPoller(const bt2c::Logger& parentLogger) :
+    _mLogger {parentLogger, "PLUGIN/CTF/LIVE/POLLER"}
+{
+#if defined(CTF_LIVE_SOCKET_POLLER_EPOLL)
+    _mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_mEpollFd < 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "epoll_create1() failed: {}",
+                                          bt_socket_errormsg());
+    }
+
+    _mWakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_mWakeFd < 0) {
+        close(_mEpollFd);
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "eventfd() failed: {}",
+                                          bt_socket_errormsg());
+    }
+
+    epoll_event ev {};
+
+    ev.events = EPOLLIN;
+    ev.data.fd = _mWakeFd;
+    if (epoll_ctl(_mEpollFd, EPOLL_CTL_ADD, _mWakeFd, &ev) != 0) {
+        close(_mWakeFd);
+        close(_mEpollFd);
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "epoll_ctl(EPOLL_CTL_ADD) failed: {}",
+                                          bt_socket_errormsg());
+    }
+#elif defined(CTF_LIVE_SOCKET_POLLER_IOCP)
+    _mIocp = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+    if (!_mIocp) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "CreateIoCompletionPort() failed: error={}",
+                                          GetLastError());
+    }
+#else
+    if (pipe(_mWakePipe) != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "pipe() failed: {}", bt_socket_errormsg());
+    }
+
+    for (const auto fd : _mWakePipe) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+
+    this->add(_mWakePipe[0]);
+#endif
+}
+
+CtfLiveSocketPoller::~CtfLiveSocketPoller()
+{
+#if defined(CTF_LIVE_SOCKET_POLLER_EPOLL)
+    close(_mWakeFd);
+    close(_mEpollFd);
+#elif defined(CTF_LIVE_SOCKET_POLLER_IOCP)
+    std::vector<BT_SOCKET> fds;
+
+    for (const auto& fdEntry : _mEntries) {
+        fds.push_back(fdEntry.first);
+    }
+
+    for (const auto fd : fds) {
+        this->remove(fd);
+    }
+
+    /*
+     * Dequeue the completion packets of the cancelled receive
+     * operations before freeing their entries.
+     */
+    while (!_mRemovedEntries.empty()) {
+        OVERLAPPED_ENTRY completions[64];
+        ULONG n;
+
+        if (!GetQueuedCompletionStatusEx(_mIocp, completions, 64, &n, 1000, FALSE)) {
+            BT_CPPLOGW("Cancelled receive operations didn't complete: count={}",
+                       _mRemovedEntries.size());
+
+            /* Leak them rather than letting the system write to freed memory */
+            for (auto& entry : _mRemovedEntries) {
+                entry.release();
+            }
+
+            break;
+        }
+
+        for (ULONG i = 0; i < n; ++i) {
+            this->_handleCompletion(completions[i]);
+        }
+    }
+
+    CloseHandle(_mIocp);
+#else
+    close(_mWakePipe[0]);
+    close(_mWakePipe[1]);
+#endif
+}
+
+#if defined(CTF_LIVE_SOCKET_POLLER_EPOLL)
+
+void CtfLiveSocketPoller::add(const BT_SOCKET fd)
+{
+    epoll_event ev {};
+
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    if (epoll_ctl(_mEpollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "epoll_ctl(EPOLL_CTL_ADD) failed: {}",
+                                          bt_socket_errormsg());
+    }
+}
+
+void CtfLiveSocketPoller::remove(const BT_SOCKET fd)
+{
+    epoll_ctl(_mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+    std::replace(_mReady.begin(), _mReady.end(), fd, BT_INVALID_SOCKET);
+}
+
+void CtfLiveSocketPoller::watchRead(const BT_SOCKET fd, const bool watch)
+{
+    /*
+     * epoll always reports `EPOLLERR` and `EPOLLHUP`, even with an
+     * empty event mask: unregister an unwatched socket instead.
+     */
+    if (watch) {
+        this->add(fd);
+    } else {
+        this->remove(fd);
+    }
+}
+
+void CtfLiveSocketPoller::wait(const int timeoutMs, const OnReady& onReady)
+{
+    epoll_event events[64];
+    const auto n = epoll_wait(_mEpollFd, events, 64, timeoutMs);
+
+    if (n < 0) {
+        if (bt_socket_interrupted()) {
+            return;
+        }
+
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "epoll_wait() failed: {}",
+                                          bt_socket_errormsg());
+    }
+
+    _mReady.clear();
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == _mWakeFd) {
+            std::uint64_t val;
+
+            /* Reset the counter */
+            if (read(_mWakeFd, &val, sizeof(val)) < 0) {
+                BT_CPPLOGD("read() from wake eventfd failed: {}", bt_socket_errormsg());
+            }
+
+            continue;
+        }
+
+        _mReady.push_back(events[i].data.fd);
+    }
+
+    for (std::size_t i = 0; i < _mReady.size(); ++i) {
+        if (_mReady[i] != BT_INVALID_SOCKET) {
+            onReady(_mReady[i]);
+        }
+    }
+}
+
+void CtfLiveSocketPoller::wake()
+{
+    const std::uint64_t val = 1;
+
+    if (write(_mWakeFd, &val, sizeof(val)) < 0 && errno != EAGAIN) {
+        BT_CPPLOGW("write() to wake eventfd failed: {}", bt_socket_errormsg());
+    }
+}
+
+#elif defined(CTF_LIVE_SOCKET_POLLER_IOCP)
+
+void CALLBACK CtfLiveSocketPoller::_acceptEventSignaled(void * const data, BOOLEAN)
+{
+    const auto& entry = *static_cast<const _Entry *>(data);
+
+    PostQueuedCompletionStatus(entry.iocp, 0, static_cast<ULONG_PTR>(entry.fd), nullptr);
+}
+
+void CtfLiveSocketPoller::add(const BT_SOCKET fd)
+{
+    auto entry = bt2s::make_unique<_Entry>();
+    BOOL listening = FALSE;
+    int listeningLen = sizeof(listening);
+
+    entry->fd = fd;
+    entry->iocp = _mIocp;
+    entry->watched = true;
+
+    if (getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, reinterpret_cast<char *>(&listening),
+                   &listeningLen) != 0) {
+        listening = FALSE;
+    }
+
+    if (listening) {
+        entry->acceptEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (!entry->acceptEvent) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "CreateEvent() failed: error={}",
+                                              GetLastError());
+        }
+
+        if (WSAEventSelect(fd, entry->acceptEvent, FD_ACCEPT) != 0) {
+            CloseHandle(entry->acceptEvent);
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "WSAEventSelect() failed: {}",
+                                              bt_socket_errormsg());
+        }
+
+        if (!RegisterWaitForSingleObject(&entry->acceptWait, entry->acceptEvent,
+                                         _acceptEventSignaled, entry.get(), INFINITE,
+                                         WT_EXECUTEDEFAULT)) {
+            WSAEventSelect(fd, nullptr, 0);
+            CloseHandle(entry->acceptEvent);
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "RegisterWaitForSingleObject() failed: error={}", GetLastError());
+        }
+    } else {
+        /* An accepted socket inherits the network events of the listening socket */
+        WSAEventSelect(fd, nullptr, 0);
+
+        if (!CreateIoCompletionPort(reinterpret_cast<HANDLE>(fd), _mIocp,
+                                    static_cast<ULONG_PTR>(fd), 0)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "CreateIoCompletionPort() failed: fd={}, error={}",
+                static_cast<unsigned long long>(fd), GetLastError());
+        }
+
+        this->_arm(*entry);
+    }
+
+    _mEntries[fd] = std::move(entry);
+}
+
+void CtfLiveSocketPoller::remove(const BT_SOCKET fd)
+{
+    const auto it = _mEntries.find(fd);
+
+    if (it == _mEntries.end()) {
+        return;
+    }
+
+    auto& entry = *it->second;
+
+    if (entry.acceptWait) {
+        /* Also waits for any running _acceptEventSignaled() call */
+        UnregisterWaitEx(entry.acceptWait, INVALID_HANDLE_VALUE);
+        WSAEventSelect(fd, nullptr, 0);
+        CloseHandle(entry.acceptEvent);
+    }
+
+    if (entry.pending) {
+        CancelIoEx(reinterpret_cast<HANDLE>(fd), &entry.ov);
+        _mRemovedEntries.push_back(std::move(it->second));
+    }
+
+    _mEntries.erase(it);
+    std::replace(_mReady.begin(), _mReady.end(), fd, BT_INVALID_SOCKET);
+}
+
+void CtfLiveSocketPoller::watchRead(const BT_SOCKET fd, const bool watch)
+{
+    const auto it = _mEntries.find(fd);
+
+    BT_ASSERT(it != _mEntries.end());
+    it->second->watched = watch;
+
+    if (watch) {
+        this->_arm(*it->second);
+    }
+}
+
+void CtfLiveSocketPoller::_arm(_Entry& entry)
+{
+    if (entry.acceptEvent || entry.pending || !entry.watched) {
+        return;
+    }
+
+    WSABUF buf {0, nullptr};
+    DWORD flags = MSG_PEEK;
+
+    std::memset(&entry.ov, 0, sizeof(entry.ov));
+    entry.pending = true;
+
+    if (WSARecv(entry.fd, &buf, 1, nullptr, &flags, &entry.ov, nullptr) != 0 &&
+        WSAGetLastError() != WSA_IO_PENDING) {
+        /*
+         * No completion packet for an immediate failure: post one so
+         * that the next receive call reports the error.
+         */
+        PostQueuedCompletionStatus(_mIocp, 0, static_cast<ULONG_PTR>(entry.fd), &entry.ov);
+    }
+}
+
+void CtfLiveSocketPoller::_handleCompletion(const OVERLAPPED_ENTRY& completion)
+{
+    if (!completion.lpOverlapped) {
+        /* Posted by _acceptEventSignaled(): ignore it if the socket is removed */
+        const auto fd = static_cast<BT_SOCKET>(completion.lpCompletionKey);
+        const auto it = _mEntries.find(fd);
+
+        if (it != _mEntries.end() && it->second->watched) {
+            _mReady.push_back(fd);
+        }
+
+        return;
+    }
+
+    /* `ov` is the first member of `_Entry` */
+    auto& entry = *reinterpret_cast<_Entry *>(completion.lpOverlapped);
+
+    entry.pending = false;
+
+    const auto removedIt = std::find_if(
+        _mRemovedEntries.begin(), _mRemovedEntries.end(),
+        [&entry](const std::unique_ptr<_Entry>& removedEntry) {
+            return removedEntry.get() == &entry;
+        });
+
+    if (removedIt != _mRemovedEntries.end()) {
+        _mRemovedEntries.erase(removedIt);
+        return;
+    }
+
+    if (entry.watched) {
+        _mReady.push_back(entry.fd);
+    }
+}
+
+void CtfLiveSocketPoller::wait(const int timeoutMs, const OnReady& onReady)
+{
+    OVERLAPPED_ENTRY completions[64];
+    ULONG n;
+
+    if (!GetQueuedCompletionStatusEx(_mIocp, completions, 64, &n,
+                                     timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs),
+                                     FALSE)) {
+        if (GetLastError() == WAIT_TIMEOUT) {
+            return;
+        }
+
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "GetQueuedCompletionStatusEx() failed: error={}", GetLastError());
+    }
+
+    _mReady.clear();
+    for (ULONG i = 0; i < n; ++i) {
+        this->_handleCompletion(completions[i]);
+    }
+
+    for (std::size_t i = 0; i < _mReady.size(); ++i) {
+        if (_mReady[i] == BT_INVALID_SOCKET) {
+            continue;
+        }
+
+        onReady(_mReady[i]);
+
+        /* Watch again, unless `onReady` removed the socket or stopped watching it */
+        const auto it = _mEntries.find(_mReady[i]);
+
+        if (_mReady[i] != BT_INVALID_SOCKET && it != _mEntries.end()) {
+            this->_arm(*it->second);
+        }
+    }
+}
+
+void CtfLiveSocketPoller::wake()
+{
+    /* Not a socket: _handleCompletion() ignores it */
+    PostQueuedCompletionStatus(_mIocp, 0, static_cast<ULONG_PTR>(BT_INVALID_SOCKET), nullptr);
+}
+
+#else /* CTF_LIVE_SOCKET_POLLER_EPOLL */
+
+std::vector<bt_socket_pollfd>::iterator CtfLiveSocketPoller::_find(const BT_SOCKET fd)
+{
+    return std::find_if(_mFds.begin(), _mFds.end(), [fd](const bt_socket_pollfd& pfd) {
+        return pfd.fd == fd;
+    });
+}
+
+void CtfLiveSocketPoller::add(const BT_SOCKET fd)
+{
+    bt_socket_pollfd pfd {};
+
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    _mFds.push_back(pfd);
+}
+
+void CtfLiveSocketPoller::remove(const BT_SOCKET fd)
+{
+    const auto it = this->_find(fd);
+
+    if (it != _mFds.end()) {
+        _mFds.erase(it);
+    }
+
+    std::replace(_mReady.begin(), _mReady.end(), fd, BT_INVALID_SOCKET);
+}
+
+void CtfLiveSocketPoller::watchRead(const BT_SOCKET fd, const bool watch)
+{
+    /*
+     * poll() always reports `POLLERR` and `POLLHUP`, even without
+     * requested events: don't poll an unwatched socket at all.
+     */
+    if (watch) {
+        this->add(fd);
+    } else {
+        this->remove(fd);
+    }
+}
+
+void CtfLiveSocketPoller::wait(const int timeoutMs, const OnReady& onReady)
+{
+    const auto n = bt_socket_poll(_mFds.data(), _mFds.size(), timeoutMs);
+
+    if (n == BT_SOCKET_ERROR) {
+        if (bt_socket_interrupted()) {
+            return;
+        }
+
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "poll() failed: {}", bt_socket_errormsg());
+    }
+
+    _mReady.clear();
+    for (const auto& pfd : _mFds) {
+        if (!(pfd.revents & (POLLIN | POLLERR | POLLHUP))) {
+            continue;
+        }
+
+        if (pfd.fd == _mWakePipe[0]) {
+            char buf[64];
+
+            /* Empty the pipe */
+            while (read(_mWakePipe[0], buf, sizeof(buf)) > 0) {
+            }
+
+            continue;
+        }
+
+        _mReady.push_back(pfd.fd);
+    }
+
+    for (std::size_t i = 0; i < _mReady.size(); ++i) {
+        if (_mReady[i] != BT_INVALID_SOCKET) {
+            onReady(_mReady[i]);
+        }
+    }
+}
+
+void CtfLiveSocketPoller::wake()
+{
+    const char byte = 0;
+
+    /* A full pipe already wakes wait() up */
+    if (write(_mWakePipe[1], &byte, 1) < 0 && errno != EAGAIN) {
+        BT_CPPLOGW("write() to wake pipe failed: {}", bt_socket_errormsg());
+    }
+}
+
+#endif /* CTF_LIVE_SOCKET_POLLER_EPOLL */
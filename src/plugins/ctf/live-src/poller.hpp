@@ -0,0 +1,139 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_POLLER_HPP
+#define BABELTRACE_PLUGINS_CTF_LIVE_SRC_POLLER_HPP
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "compat/socket.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+#if defined(__linux__)
+#    define CTF_LIVE_SOCKET_POLLER_EPOLL 1
+#elif defined(__MINGW32__)
+#    define CTF_LIVE_SOCKET_POLLER_IOCP 1
+#endif
+
+/*
+ * Readiness notifier for a set of sockets: epoll on Linux, an I/O
+ * completion port on Windows, and bt_socket_poll() elsewhere.
+ *
+ * Only read readiness is watched. Errors and hang-ups are reported as
+ * read readiness: the next receive call reports them.
+ *
+ * Not thread-safe, except wake(): meant to be used by the socket thread
+ * only.
+ */
+class CtfLiveSocketPoller final
+{
+public:
+    using OnReady = std::function<void(BT_SOCKET)>;
+
+    explicit CtfLiveSocketPoller(const bt2c::Logger& parentLogger);
+    ~CtfLiveSocketPoller();
+
+    CtfLiveSocketPoller(const CtfLiveSocketPoller&) = delete;
+    CtfLiveSocketPoller& operator=(const CtfLiveSocketPoller&) = delete;
+
+    void add(BT_SOCKET fd);
+    void remove(BT_SOCKET fd);
+
+    /*
+     * Enables or disables read readiness reporting for `fd`, already
+     * added.
+     *
+     * The poller doesn't report an unwatched socket at all, not even
+     * on errors or hang-ups.
+     */
+    void watchRead(BT_SOCKET fd, bool watch);
+
+    /*
+     * Waits at most `timeoutMs` milliseconds for sockets to become
+     * ready, calling `onReady` for each ready one.
+     *
+     * `onReady` may call remove().
+     */
+    void wait(int timeoutMs, const OnReady& onReady);
+
+    /*
+     * Makes a current or the next wait() call return early; may be
+     * called from any thread.
+     */
+    void wake();
+
+private:
+#if defined(CTF_LIVE_SOCKET_POLLER_EPOLL)
+    int _mEpollFd = -1;
+
+    /* eventfd which wake() signals */
+    int _mWakeFd = -1;
+#elif defined(CTF_LIVE_SOCKET_POLLER_IOCP)
+    /*
+     * Watched socket.
+     *
+     * A connected or datagram socket has at most one pending zero-byte
+     * receive operation (`MSG_PEEK`, so that it doesn't consume any
+     * datagram) of which the completion means read readiness.
+     *
+     * A listening socket can't receive: its `FD_ACCEPT` network event
+     * signals `acceptEvent`, and a thread pool wait on the latter posts
+     * a completion packet without overlapped structure to the port.
+     */
+    struct _Entry final
+    {
+        /* Overlapped structure of the zero-byte receive operation (first member) */
+        OVERLAPPED ov;
+
+        BT_SOCKET fd;
+        HANDLE iocp;
+
+        /* Whether or not to report read readiness */
+        bool watched;
+
+        /* Whether or not a zero-byte receive operation is pending */
+        bool pending;
+
+        /* Listening socket: `FD_ACCEPT` event and its registered wait */
+        HANDLE acceptEvent;
+        HANDLE acceptWait;
+    };
+
+    /* Posts a zero-byte receive operation for `entry`, if needed */
+    void _arm(_Entry& entry);
+
+    /* Handles a dequeued completion packet, appending any ready socket to `_mReady` */
+    void _handleCompletion(const OVERLAPPED_ENTRY& completion);
+
+    static void CALLBACK _acceptEventSignaled(void *data, BOOLEAN timedOut);
+
+    HANDLE _mIocp = nullptr;
+    std::unordered_map<BT_SOCKET, std::unique_ptr<_Entry>> _mEntries;
+
+    /*
+     * Removed entries of which the cancelled receive operation isn't
+     * dequeued yet: the system still refers to their overlapped
+     * structure.
+     */
+    std::vector<std::unique_ptr<_Entry>> _mRemovedEntries;
+#else
+    std::vector<bt_socket_pollfd>::iterator _find(BT_SOCKET fd);
+
+    std::vector<bt_socket_pollfd> _mFds;
+
+    /* Pipe of which wake() writes to the write end (index 1) */
+    int _mWakePipe[2] = {-1, -1};
+#endif
+
+    std::vector<BT_SOCKET> _mReady;
+    bt2c::Logger _mLogger;
+};
+
+#endif
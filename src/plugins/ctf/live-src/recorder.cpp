@@ -0,0 +1,179 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#include <cerrno>
+#include <cstring>
+
+#include <glib.h>
+
+#include "common/assert.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "recorder.hpp"
+
+bool isMetadataPktMagic(const std::uint8_t * const magic) noexcept
+{
+    // 0x75d11d57, in either byte order.
+    return (magic[0] == 0x57 && magic[1] == 0x1d && magic[2] == 0xd1 && magic[3] == 0x75) ||
+           (magic[0] == 0x75 && magic[1] == 0xd1 && magic[2] == 0x1d && magic[3] == 0x57);
+}
+
+CtfLiveRecorder::CtfLiveRecorder(const std::string& dirPath, const bt2c::ConstBytes metadata,
+                                 const bt2c::Logger& parentLogger) :
+    _mDirPath {dirPath},
+    _mLogger {parentLogger, "PLUGIN/CTF/LIVE/RECORDER"}
+{
+    const auto indexDirPath = fmt::format("{}" G_DIR_SEPARATOR_S "index", _mDirPath);
+
+    if (g_mkdir_with_parents(indexDirPath.c_str(), 0755) != 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                                "Failed to create recording directory", ": path=\"{}\"",
+                                                indexDirPath);
+    }
+
+    _mMetadataFile = this->_open(fmt::format("{}" G_DIR_SEPARATOR_S "metadata", _mDirPath), true);
+
+    if (std::fwrite(metadata.data(), 1, metadata.size(), _mMetadataFile.get()) !=
+        metadata.size()) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write metadata file",
+                                                ": dir-path=\"{}\"", _mDirPath);
+    }
+
+    std::fflush(_mMetadataFile.get());
+
+    _mMetadataIsPacketized = metadata.size() >= 4 && isMetadataPktMagic(metadata.data());
+
+    BT_CPPLOGI("Recording received data: path=\"{}\"", _mDirPath);
+}
+
+bt2c::FileUP CtfLiveRecorder::_open(const std::string& path, const bool buffered)
+{
+    bt2c::FileUP file {std::fopen(path.c_str(), "wb")};
+
+    if (!file) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to open file",
+                                                ": path=\"{}\"", path);
+    }
+
+    if (!buffered) {
+        // Each write() call of ours becomes one write() system call.
+        std::setvbuf(file.get(), nullptr, _IONBF, 0);
+    }
+
+    return file;
+}
+
+CtfLiveRecorder::_StreamFile& CtfLiveRecorder::_streamFile(const CtfLiveRecordedPktProps& props)
+{
+    const auto name = props.dataStreamId ?
+                          fmt::format("stream-{}-{}", props.dataStreamClsId, *props.dataStreamId) :
+                          fmt::format("stream-{}", props.dataStreamClsId);
+    const auto it = _mFiles.find(name);
+
+    if (it != _mFiles.end()) {
+        return it->second;
+    }
+
+    _StreamFile streamFile;
+
+    streamFile.file = this->_open(fmt::format("{}" G_DIR_SEPARATOR_S "{}", _mDirPath, name), false);
+    streamFile.indexFile = this->_open(
+        fmt::format("{0}" G_DIR_SEPARATOR_S "index" G_DIR_SEPARATOR_S "{1}.idx", _mDirPath, name),
+        true);
+
+    ctf_packet_index_file_hdr hdr;
+
+    hdr.magic = htobe32(CTF_INDEX_MAGIC);
+    hdr.index_major = htobe32(CTF_INDEX_MAJOR);
+    hdr.index_minor = htobe32(CTF_INDEX_MINOR);
+    hdr.packet_index_len = htobe32(sizeof(ctf_packet_index));
+
+    if (std::fwrite(&hdr, sizeof(hdr), 1, streamFile.indexFile.get()) != 1) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write index file header",
+                                                ": name=\"{}\"", name);
+    }
+
+    BT_CPPLOGD("Created data stream file: name=\"{}\"", name);
+    return _mFiles.emplace(name, std::move(streamFile)).first->second;
+}
+
+void CtfLiveRecorder::beginPkt(const CtfLiveRecordedPktProps& props)
+{
+    BT_ASSERT(!_mCurFile);
+
+    auto& streamFile = this->_streamFile(props);
+
+    _mCurEntry.offset = htobe64(streamFile.size);
+    _mCurEntry.packet_size = htobe64(props.totalLenBits);
+    _mCurEntry.content_size = htobe64(props.contentLenBits.value_or(props.totalLenBits));
+    _mCurEntry.timestamp_begin = htobe64(props.beginDefClkVal.value_or(0));
+    _mCurEntry.timestamp_end = htobe64(props.endDefClkVal.value_or(0));
+    _mCurEntry.events_discarded = htobe64(props.discEventRecordCounterSnap.value_or(0));
+    _mCurEntry.stream_id = htobe64(props.dataStreamClsId);
+    _mCurEntry.stream_instance_id = htobe64(props.dataStreamId.value_or(0));
+    _mCurEntry.packet_seq_num = htobe64(props.seqNum.value_or(0));
+    _mCurFile = &streamFile;
+}
+
+void CtfLiveRecorder::write(const std::uint8_t * const addr, const std::size_t len)
+{
+    BT_ASSERT_DBG(_mCurFile);
+
+    if (std::fwrite(addr, 1, len, _mCurFile->file.get()) != len) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write data stream file",
+                                                ": dir-path=\"{}\", len={}", _mDirPath, len);
+    }
+
+    _mCurFile->size += len;
+}
+
+void CtfLiveRecorder::endPkt()
+{
+    BT_ASSERT(_mCurFile);
+
+    /*
+     * The index file is buffered: the index entries of the last packets
+     * reach the disk at the latest when the recorder is destroyed.
+     */
+    if (std::fwrite(&_mCurEntry, sizeof(_mCurEntry), 1, _mCurFile->indexFile.get()) != 1) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write index entry",
+                                                ": dir-path=\"{}\"", _mDirPath);
+    }
+
+    _mCurFile = nullptr;
+}
+
+void CtfLiveRecorder::appendMetadata(const bt2c::ConstBytes pkt)
+{
+    if (!_mMetadataIsPacketized) {
+        if (!_mWarnedMetadataKind) {
+            BT_CPPLOGW("Not recording in-band metadata stream packets: "
+                       "the initial metadata stream is plain text: dir-path=\"{}\"",
+                       _mDirPath);
+            _mWarnedMetadataKind = true;
+        }
+
+        return;
+    }
+
+    if (std::fwrite(pkt.data(), 1, pkt.size(), _mMetadataFile.get()) != pkt.size() ||
+        std::fflush(_mMetadataFile.get()) != 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write metadata file",
+                                                ": dir-path=\"{}\"", _mDirPath);
+    }
+}
+
+void CtfLiveRecorder::abortPkt() noexcept
+{
+    if (_mCurFile) {
+        BT_CPPLOGW("Packet is incomplete: not indexing it: offset={}", be64toh(_mCurEntry.offset));
+        _mCurFile = nullptr;
+    }
+}
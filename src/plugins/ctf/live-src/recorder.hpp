@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (C) 2026 Antmicro
+ * Copyright (C) 2026 Analog Devices
+ *
+ */
+#ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_RECORDER_HPP
+#define BABELTRACE_PLUGINS_CTF_LIVE_SRC_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "cpp-common/bt2c/aliases.hpp"
+#include "cpp-common/bt2c/libc-up.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "plugins/ctf/fs-src/lttng-index.hpp"
+
+/*
+ * Properties of a packet to record, as read from its header and
+ * context.
+ */
+struct CtfLiveRecordedPktProps
+{
+    unsigned long long dataStreamClsId = 0;
+    bt2s::optional<unsigned long long> dataStreamId;
+    unsigned long long totalLenBits = 0;
+    bt2s::optional<unsigned long long> contentLenBits;
+    bt2s::optional<unsigned long long> beginDefClkVal;
+    bt2s::optional<unsigned long long> endDefClkVal;
+    bt2s::optional<unsigned long long> discEventRecordCounterSnap;
+    bt2s::optional<unsigned long long> seqNum;
+};
+
+/*
+ * Returns whether or not the four bytes at `magic` are the magic number
+ * of a metadata stream packet.
+ */
+bool isMetadataPktMagic(const std::uint8_t *magic) noexcept;
+
+/*
+ * Writes the received packets, unmodified, to a CTF trace directory:
+ *
+ * * `metadata`: copy of the metadata stream, followed with the
+ *   metadata stream packets received in-band when the initial metadata
+ *   stream is packetized too.
+ *
+ * * One data stream file per data stream, named after its data stream
+ *   class and data stream IDs.
+ *
+ * * `index/NAME.idx`: LTTng packet index of the data stream file
+ *   `NAME`, so that `source.ctf.fs` doesn't need to index the
+ *   recording when opening it.
+ *
+ * The bytes of a packet are written as they arrive, but its index entry
+ * is only added once the whole packet is written.
+ *
+ * All the methods must be called from the socket thread.
+ */
+class CtfLiveRecorder final
+{
+public:
+    explicit CtfLiveRecorder(const std::string& dirPath, bt2c::ConstBytes metadata,
+                             const bt2c::Logger& parentLogger);
+
+    // Starts recording a packet having the properties `props`.
+    void beginPkt(const CtfLiveRecordedPktProps& props);
+
+    // Appends bytes of the current packet.
+    void write(const std::uint8_t *addr, std::size_t len);
+
+    // Ends the current packet, adding its index entry.
+    void endPkt();
+
+    // Forgets the current packet, leaving its written bytes unindexed.
+    void abortPkt() noexcept;
+
+    // Appends a metadata stream packet received in-band.
+    void appendMetadata(bt2c::ConstBytes pkt);
+
+    bool inPkt() const noexcept
+    {
+        return _mCurFile != nullptr;
+    }
+
+private:
+    struct _StreamFile
+    {
+        bt2c::FileUP file;
+        bt2c::FileUP indexFile;
+
+        // Current size of `file`, in bytes.
+        unsigned long long size = 0;
+    };
+
+    _StreamFile& _streamFile(const CtfLiveRecordedPktProps& props);
+    bt2c::FileUP _open(const std::string& path, bool buffered);
+
+    std::string _mDirPath;
+    bt2c::FileUP _mMetadataFile;
+
+    // Whether or not the initial metadata stream is packetized.
+    bool _mMetadataIsPacketized = false;
+    bool _mWarnedMetadataKind = false;
+    std::unordered_map<std::string, _StreamFile> _mFiles;
+
+    // Data stream file of the current packet, and its index entry.
+    _StreamFile *_mCurFile = nullptr;
+    ctf_packet_index _mCurEntry;
+    bt2c::Logger _mLogger;
+};
+
+#endif
@@ -1,7 +1,18 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
+#ifdef BT_HAVE_ZSTD
+#    include <zstd.h>
+#endif
+
+#include "common/common.h"
 #include "compat/socket.hpp"
 #include "cpp-common/bt2/exc.hpp"
 #include "cpp-common/bt2c/data-len.hpp"
@@ -19,17 +30,123 @@ static std::string sockaddr_to_string(const sockaddr_in& addr)
     if (!p) {
         return std::string {"<invalid>"};
     }
-    return std::string {p} + ":" + std::to_string(addr.sin_port);
+    return std::string {p} + ":" + std::to_string(ntohs(addr.sin_port));
 }
 
-CtfLiveSocketServer::CtfLiveSocketServer(int port) :
-    _mKeepRunning(true), _mLogger("SOCKET", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info)
+static CtfLiveSocketDemux::FifoMap createFifos(const ctf::src::TraceCls& traceCls,
+                                               const CtfLiveSocketServerCfg& cfg)
 {
+    CtfLiveSocketDemux::FifoMap fifos;
+
+    for (const auto& dataStreamCls : traceCls.dataStreamClasses()) {
+        auto& clsFifos = fifos[dataStreamCls->id()];
+
+        for (std::size_t i = 0; i < cfg.fifosPerDataStreamCls; ++i) {
+            clsFifos.emplace_back(bt2s::make_unique<CtfLiveSocketFifo>(
+                cfg.fifoMaxSize, cfg.historyMaxSize, cfg.historyMaxAge));
+        }
+    }
+
+    return fifos;
+}
+
+CtfLiveSocketServer::_Slot::_Slot(CtfLiveSocketSlotCfg slotCfg, const CtfLiveSocketServerCfg& cfg,
+                                  const bt2c::Logger& logger) :
+    fifos(createFifos(*slotCfg.traceCls, cfg)),
+    recorder(std::move(slotCfg.recorder)),
+    demux(*slotCfg.traceCls, fifos, cfg.overflowPolicy, recorder.get(), slotCfg.traceClsMutex,
+          std::move(slotCfg.onMetadata), logger)
+{
+}
+
+CtfLiveSocketServer::CtfLiveSocketServer(std::vector<CtfLiveSocketSlotCfg> slotCfgs,
+                                         const CtfLiveSocketServerCfg& cfg) :
+    _mKeepRunning(true),
+    _mCfg(cfg), _mChunkPool(std::make_shared<_ChunkPool>()),
+    _mLogger("SOCKET", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info),
+    _mPoller(_mLogger)
+{
+    BT_ASSERT(_mCfg.recvBufSize > 0);
+    BT_ASSERT(!slotCfgs.empty());
+
+    for (auto& slotCfg : slotCfgs) {
+        _mSlots.emplace_back(bt2s::make_unique<_Slot>(std::move(slotCfg), _mCfg, _mLogger));
+
+        // Wake the socket thread up when a reader makes room in a full FIFO.
+        for (auto& clsFifos : _mSlots.back()->fifos) {
+            for (auto& fifo : clsFifos.second) {
+                fifo->onRoom([this] {
+                    _mPoller.wake();
+                });
+            }
+        }
+    }
+
     if (bt_socket_init(_mLogger) != 0) {
         BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to init socket");
     }
 
-    _mSocketFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (_mCfg.compression == CtfLiveCompression::Zstd) {
+#ifdef BT_HAVE_ZSTD
+        if (this->_isDgram()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "zstd compression is only available with stream transports");
+        }
+
+        _mCompressedBuf.resize(_mCfg.recvBufSize);
+#else
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "zstd compression isn't available: Babeltrace was built without zstd");
+#endif
+    }
+
+    const auto sockType = this->_isDgram() ? SOCK_DGRAM : SOCK_STREAM;
+    std::string boundTo;
+
+    if (_mCfg.transport == CtfLiveTransport::Tcp || _mCfg.transport == CtfLiveTransport::Udp) {
+        boundTo = this->_bindInet(sockType);
+    } else {
+        boundTo = this->_bindUnix(sockType);
+    }
+
+    if (!this->_isDgram() && listen(_mSocketFd, static_cast<int>(_mSlots.size())) != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "listen() failed: {}", bt_socket_errormsg());
+    }
+    if (bt_socket_set_nonblocking(_mSocketFd) != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to make socket non-blocking: {}",
+                                          bt_socket_errormsg());
+    }
+    _mPoller.add(_mSocketFd);
+
+    if (this->_isDgram()) {
+        /*
+         * There's no connection with datagrams: all of them feed the
+         * first slot, and the socket itself is read like a connection.
+         */
+        _Conn conn;
+        conn.peer = boundTo;
+        conn.slot = 0;
+        _mSlots[0]->busy = true;
+        _mConns.emplace(_mSocketFd, std::move(conn));
+        BT_CPPLOGI("Server receiving datagrams at {}", boundTo);
+    } else {
+        BT_CPPLOGI("Server listening at {}: max-clients={}", boundTo, _mSlots.size());
+    }
+
+    _mSocketThread = std::thread([this] {
+        this->_socketServerLoop();
+    });
+}
+
+bool CtfLiveSocketServer::_isDgram() const noexcept
+{
+    return _mCfg.transport == CtfLiveTransport::Udp ||
+           _mCfg.transport == CtfLiveTransport::UnixDgram;
+}
+
+std::string CtfLiveSocketServer::_bindInet(const int sockType)
+{
+    _mSocketFd = socket(AF_INET, sockType, 0);
     if (_mSocketFd == BT_INVALID_SOCKET) {
         BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "socket() call failed: {}",
                                           bt_socket_errormsg());
@@ -43,202 +160,663 @@ CtfLiveSocketServer::CtfLiveSocketServer(int port) :
         BT_CPPLOGW("setsockopt(SO_REUSEADDR) failed");
     }
 
+    if (sockType == SOCK_DGRAM) {
+        // Absorb bursts: a datagram which doesn't fit is lost.
+        optval = static_cast<int>(_mCfg.fifoMaxSize);
+        if (setsockopt(_mSocketFd, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&optval),
+                       sizeof(int)) == BT_SOCKET_ERROR) {
+            BT_CPPLOGW("setsockopt(SO_RCVBUF) failed");
+        }
+    }
+
     sockaddr_in server;
     memset(&server, 0, sizeof(server));
-    server.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (inet_pton(AF_INET, _mCfg.address.c_str(), &server.sin_addr) != 1) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "Invalid IPv4 bind address: address={}",
+                                          _mCfg.address);
+    }
     server.sin_family = AF_INET;
-    server.sin_port = htons(port);
+    server.sin_port = htons(_mCfg.port);
     memset(server.sin_zero, '\0', sizeof(server.sin_zero));
-    auto err = bind(_mSocketFd, reinterpret_cast<sockaddr *>(&server), sizeof(server));
-    if (err != 0) {
+    if (bind(_mSocketFd, reinterpret_cast<sockaddr *>(&server), sizeof(server)) != 0) {
         BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "bind() failed: {}", bt_socket_errormsg());
     }
-    err = listen(_mSocketFd, MAX_CONNECTIONS);
-    if (err != 0) {
-        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "listen() failed: {}", bt_socket_errormsg());
+
+    return fmt::format("{}://{}", sockType == SOCK_DGRAM ? "udp" : "tcp",
+                       sockaddr_to_string(server));
+}
+
+std::string CtfLiveSocketServer::_bindUnix(const int sockType)
+{
+#ifdef __MINGW32__
+    (void) sockType;
+    BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                      "Unix domain sockets aren't supported on this platform");
+#else
+    sockaddr_un server;
+
+    memset(&server, 0, sizeof(server));
+    if (_mCfg.path.empty() || _mCfg.path.size() >= sizeof(server.sun_path)) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Invalid Unix domain socket path: path=\"{}\"",
+                                          _mCfg.path);
     }
-    BT_CPPLOGI("Server listening at {}", sockaddr_to_string(server));
 
-    _mSocketThread = std::thread([this] {
-        this->_socketServerLoop();
-    });
+    _mSocketFd = socket(AF_UNIX, sockType, 0);
+    if (_mSocketFd == BT_INVALID_SOCKET) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "socket() call failed: {}",
+                                          bt_socket_errormsg());
+    }
+
+    // Remove a stale socket file from a previous run.
+    unlink(_mCfg.path.c_str());
+    server.sun_family = AF_UNIX;
+    std::strcpy(server.sun_path, _mCfg.path.c_str());
+    if (bind(_mSocketFd, reinterpret_cast<sockaddr *>(&server), sizeof(server)) != 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "bind() failed: path=\"{}\", error={}",
+                                          _mCfg.path, bt_socket_errormsg());
+    }
+
+    return fmt::format("unix://{}", _mCfg.path);
+#endif
 }
 
 CtfLiveSocketServer::~CtfLiveSocketServer()
 {
     BT_CPPLOGD("Cleaning up socket server={}", fmt::ptr(this));
     _mKeepRunning = false;
-    if (_mClientFd != BT_INVALID_SOCKET) {
-        shutdown(_mClientFd, BT_SHUT_RDWR);
-        bt_socket_close(_mClientFd);
+    for (auto& slot : _mSlots) {
+        for (auto& clsFifos : slot->fifos) {
+            for (auto& fifo : clsFifos.second) {
+                fifo->close();
+            }
+        }
+    }
+
+    _mPoller.wake();
+
+    if (_mSocketThread.joinable()) {
+        _mSocketThread.join();
+    }
+
+    for (auto& conn : _mConns) {
+        if (conn.first != _mSocketFd) {
+            shutdown(conn.first, BT_SHUT_RDWR);
+            bt_socket_close(conn.first);
+        }
     }
     if (_mSocketFd != BT_INVALID_SOCKET) {
-        shutdown(_mSocketFd, BT_SHUT_RDWR);
         bt_socket_close(_mSocketFd);
     }
-    if (_mSocketThread.joinable()) {
-        _mSocketThread.join();
+#ifndef __MINGW32__
+    if (!_mCfg.path.empty() && (_mCfg.transport == CtfLiveTransport::UnixStream ||
+                                _mCfg.transport == CtfLiveTransport::UnixDgram)) {
+        unlink(_mCfg.path.c_str());
     }
+#endif
     bt_socket_fini();
 }
 
 void CtfLiveSocketServer::_socketServerLoop()
 {
+    const auto onReady = [this](const sock_type_t fd) {
+        this->_onReady(fd);
+    };
+
+    _mLastStatsLogTime = std::chrono::steady_clock::now();
+
     while (_mKeepRunning) {
-        sockaddr_in client_addr;
-        socklen_t client_addr_size = sizeof(client_addr);
+        try {
+            _mPoller.wait(POLL_TIMEOUT_MS, onReady);
+            _resumePausedConns();
 
-        BT_CPPLOGI("Awaiting client connection");
-        _mClientFd =
-            accept(_mSocketFd, reinterpret_cast<sockaddr *>(&client_addr), &client_addr_size);
-        if (_mClientFd == BT_INVALID_SOCKET && _mKeepRunning) {
-            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "accept() failed: {}",
-                                              bt_socket_errormsg());
-        } else if (_mClientFd == BT_INVALID_SOCKET) {
-            // In this case, the shutdown from the destructor force-closed the socket
-            // and accept returned -1. In this case, return to the destructor that joined here
+            if (_mCfg.statsLogPeriod.count() > 0 &&
+                std::chrono::steady_clock::now() - _mLastStatsLogTime >= _mCfg.statsLogPeriod) {
+                this->_logStats();
+                _mLastStatsLogTime = std::chrono::steady_clock::now();
+            }
+        } catch (const bt2c::Error&) {
+            BT_CPPLOGE("Error in socket server loop: stopping");
             break;
         }
+    }
+}
 
-        const auto cleanup = [this] {
-            shutdown(_mClientFd, BT_SHUT_RDWR);
-            bt_socket_close(_mClientFd);
-        };
+void CtfLiveSocketServer::_onReady(const sock_type_t fd)
+{
+    if (fd == _mSocketFd && !this->_isDgram()) {
+        _accept();
+        return;
+    }
 
-        BT_CPPLOGI("Client connected ({}:{})", sockaddr_to_string(client_addr),
-                   client_addr.sin_port);
-        try {
-            _clientLoop();
-        } catch (const bt2c::Error&) {
-            cleanup();
-            BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Error while reading data from client");
+    const auto it = _mConns.find(fd);
+    BT_ASSERT(it != _mConns.end());
+
+    bool open;
+
+    try {
+        open = _readConn(fd, it->second);
+    } catch (const bt2c::Error&) {
+        if (this->_isDgram()) {
+            // The next datagram starts afresh: keep receiving.
+            BT_CPPLOGE("Error while reading datagrams from {}", it->second.peer);
+            return;
         }
-        BT_CPPLOGI("Client disconnected");
-        cleanup();
+
+        BT_CPPLOGE("Error while reading data from client {}: closing connection",
+                   it->second.peer);
+        open = false;
+    }
+
+    if (!open) {
+        _closeConn(fd);
     }
 }
 
-void CtfLiveSocketServer::_clientLoop()
+void CtfLiveSocketServer::_accept()
 {
     while (_mKeepRunning) {
-        const auto n = bt_socket_recv(_mClientFd, _mReadBuf.data(), 1, 0);
+        sockaddr_storage client_addr;
+        socklen_t client_addr_size = sizeof(client_addr);
+        const auto fd =
+            accept(_mSocketFd, reinterpret_cast<sockaddr *>(&client_addr), &client_addr_size);
+
+        if (fd == BT_INVALID_SOCKET) {
+            if (!bt_socket_would_block() && !bt_socket_interrupted()) {
+                BT_CPPLOGW("accept() failed: {}", bt_socket_errormsg());
+            }
+
+            return;
+        }
+
+        const auto peer = client_addr.ss_family == AF_INET ?
+                              sockaddr_to_string(reinterpret_cast<sockaddr_in&>(client_addr)) :
+                              fmt::format("unix://{}#{}", _mCfg.path, fd);
+        const auto slotIt = std::find_if(_mSlots.begin(), _mSlots.end(),
+                                         [](const std::unique_ptr<_Slot>& slot) {
+                                             return !slot->busy;
+                                         });
+
+        if (slotIt == _mSlots.end()) {
+            BT_CPPLOGW("Rejecting client: all client slots are busy: peer={}, max-clients={}",
+                       peer, _mSlots.size());
+            bt_socket_close(fd);
+            continue;
+        }
+
+        if (bt_socket_set_nonblocking(fd) != 0) {
+            BT_CPPLOGW("Rejecting client: failed to make socket non-blocking: peer={}, error={}",
+                       peer, bt_socket_errormsg());
+            bt_socket_close(fd);
+            continue;
+        }
+
+        _Conn conn;
+        conn.peer = peer;
+        conn.slot = static_cast<std::size_t>(slotIt - _mSlots.begin());
+
+#ifdef BT_HAVE_ZSTD
+        if (_mCfg.compression == CtfLiveCompression::Zstd) {
+            conn.zstdDctx.reset(ZSTD_createDCtx());
+
+            if (!conn.zstdDctx) {
+                BT_CPPLOGW("Rejecting client: failed to create zstd decompression context: "
+                           "peer={}",
+                           peer);
+                bt_socket_close(fd);
+                continue;
+            }
+        }
+#endif
+
+        (*slotIt)->busy = true;
+        (*slotIt)->connCount.fetch_add(1, std::memory_order_relaxed);
+        (*slotIt)->demux.reset();
+        _mConns.emplace(fd, std::move(conn));
+        _mPoller.add(fd);
+        BT_CPPLOGI("Client connected: peer={}, slot={}", peer, _mConns[fd].slot);
+    }
+}
+
+bool CtfLiveSocketServer::_readConn(const sock_type_t fd, _Conn& conn)
+{
+    auto& slot = *_mSlots[conn.slot];
+
+    if (this->_isDgram()) {
+        this->_readDgrams(fd, conn);
+        return true;
+    }
+
+    for (int i = 0; i < MAX_READS_PER_WAKEUP; ++i) {
+        if (conn.zstdDctx) {
+            const auto n = bt_socket_recv(fd, _mCompressedBuf.data(), _mCompressedBuf.size(), 0);
+
+            if (n == BT_SOCKET_ERROR) {
+                if (bt_socket_interrupted()) {
+                    continue;
+                }
+                if (bt_socket_would_block()) {
+                    return true;
+                }
+                BT_CPPLOGW("recv() failed: peer={}, error={}", conn.peer, bt_socket_errormsg());
+                return false;
+            }
+            if (n == 0) {
+                return false;
+            }
+            this->_countRecv(slot, static_cast<std::size_t>(n));
+            this->_decompress(conn, static_cast<std::size_t>(n));
+
+            if (this->_pauseIfStalled(fd, conn)) {
+                return true;
+            }
+
+            continue;
+        }
+
+        auto chunk = _acquireChunk();
+
+        // Read as much as is available, up to the capacity of the chunk.
+        const auto n = bt_socket_recv(fd, chunk->buf.data(), chunk->buf.size(), 0);
         if (n == BT_SOCKET_ERROR) {
-            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "recv() failed: {}",
-                                              bt_socket_errormsg());
+            if (bt_socket_interrupted()) {
+                continue;
+            }
+            if (bt_socket_would_block()) {
+                return true;
+            }
+            BT_CPPLOGW("recv() failed: peer={}, error={}", conn.peer, bt_socket_errormsg());
+            return false;
         }
         if (n == 0) {
-            break;
+            return false;
+        }
+        chunk->len = static_cast<std::size_t>(n);
+        this->_countRecv(slot, chunk->len);
+        slot.decompressedBytes.fetch_add(chunk->len, std::memory_order_relaxed);
+        slot.demux.push(std::move(chunk));
+
+        if (this->_pauseIfStalled(fd, conn)) {
+            return true;
         }
-        _pushData(bt2s::span<uint8_t> {_mReadBuf.data(), (size_t) n});
     }
+
+    return true;
 }
 
-void CtfLiveSocketServer::_pushData(bt2s::span<uint8_t> buf)
+void CtfLiveSocketServer::_ZstdDctxDeleter::operator()(ZSTD_DCtx_s * const dctx) const noexcept
 {
-    // BT_CPPLOGD("Pushing data to attached FIFOs: len={}", buf.size());
-    for (auto& fifo : _mFifos) {
-        fifo->push(buf);
-    }
+#ifdef BT_HAVE_ZSTD
+    ZSTD_freeDCtx(dctx);
+#else
+    BT_ASSERT(!dctx);
+#endif
 }
 
-std::unique_ptr<CtfLiveSocketMedium> CtfLiveSocketServer::create_medium()
+void CtfLiveSocketServer::_decompress(_Conn& conn, const std::size_t len)
 {
-    auto fifo = bt2s::make_unique<CtfLiveSocketFifo>();
-    auto *ptr = fifo.get();
-    _mFifos.emplace_back(std::move(fifo));
+#ifdef BT_HAVE_ZSTD
+    auto& slot = *_mSlots[conn.slot];
+    ZSTD_inBuffer in {_mCompressedBuf.data(), len, 0};
+    bool outFull;
 
-    // The medium receives an unowned pointer, ownership of the fifo belongs to
-    // the server.
-    auto medium = bt2s::make_unique<CtfLiveSocketMedium>(this, ptr);
-    BT_CPPLOGD("Created new medium for socket server: medium={}", fmt::ptr(medium.get()));
-    return medium;
+    /*
+     * Decompress straight into receive chunks. Keep going while the
+     * output fills a whole chunk, even when all the input is consumed:
+     * the context may still hold decompressed bytes.
+     */
+    do {
+        auto chunk = this->_acquireChunk();
+        ZSTD_outBuffer out {chunk->buf.data(), chunk->buf.size(), 0};
+        const auto ret = ZSTD_decompressStream(conn.zstdDctx.get(), &out, &in);
+
+        if (ZSTD_isError(ret)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "Failed to decompress data: peer={}, error={}",
+                                              conn.peer, ZSTD_getErrorName(ret));
+        }
+
+        outFull = out.pos == out.size;
+
+        if (out.pos > 0) {
+            chunk->len = out.pos;
+            slot.decompressedBytes.fetch_add(chunk->len, std::memory_order_relaxed);
+            slot.demux.push(std::move(chunk));
+        }
+    } while (in.pos < in.size || outFull);
+#else
+    (void) conn;
+    (void) len;
+    bt_common_abort();
+#endif
 }
 
-CtfLiveSocketMedium::CtfLiveSocketMedium(CtfLiveSocketServer *server, CtfLiveSocketFifo *fifo) :
-    _mServer(server), _mFifo(fifo), _mLogger("MEDIUM", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info)
+bool CtfLiveSocketServer::_pauseIfStalled(const sock_type_t fd, _Conn& conn)
 {
+    if (!_mSlots[conn.slot]->demux.isStalled()) {
+        return false;
+    }
+
+    /*
+     * Stop reading this connection until its ports catch up: TCP flow
+     * control then slows down the sender without stalling the other
+     * connections. With datagrams, the kernel drops what doesn't fit
+     * in the receive buffer meanwhile.
+     *
+     * The poller doesn't report an unwatched socket at all, not even a
+     * hang-up: the first read after resuming reports it.
+     */
+    BT_CPPLOGD("Pausing client: port buffers are full: peer={}", conn.peer);
+    conn.paused = true;
+    _mPoller.watchRead(fd, false);
+    return true;
 }
 
-CtfLiveSocketMedium::~CtfLiveSocketMedium()
+void CtfLiveSocketServer::_readDgrams(const sock_type_t fd, _Conn& conn)
 {
-    BT_CPPLOGD("Cleaning up socket medium={}", fmt::ptr(this));
+    auto& slot = *_mSlots[conn.slot];
+
+    for (int i = 0; i < MAX_READS_PER_WAKEUP; ++i) {
+#ifdef __linux__
+        // Receive a batch of datagrams with a single system call.
+        std::array<CtfLiveSocketChunk::SP, MAX_DGRAMS_PER_READ> chunks;
+        std::array<iovec, MAX_DGRAMS_PER_READ> iovecs;
+        std::array<mmsghdr, MAX_DGRAMS_PER_READ> msgs;
+
+        for (std::size_t j = 0; j < MAX_DGRAMS_PER_READ; ++j) {
+            chunks[j] = this->_acquireChunk();
+            iovecs[j].iov_base = chunks[j]->buf.data();
+            iovecs[j].iov_len = chunks[j]->buf.size();
+            memset(&msgs[j], 0, sizeof(msgs[j]));
+            msgs[j].msg_hdr.msg_iov = &iovecs[j];
+            msgs[j].msg_hdr.msg_iovlen = 1;
+        }
+
+        const auto n = recvmmsg(fd, msgs.data(), MAX_DGRAMS_PER_READ, MSG_DONTWAIT, nullptr);
+#else
+        std::array<CtfLiveSocketChunk::SP, 1> chunks {this->_acquireChunk()};
+        const auto n = bt_socket_recv(fd, chunks[0]->buf.data(), chunks[0]->buf.size(), 0);
+#endif
+
+        if (n < 0) {
+            if (bt_socket_interrupted()) {
+                continue;
+            }
+            if (!bt_socket_would_block()) {
+                BT_CPPLOGW("Failed to receive datagrams: peer={}, error={}", conn.peer,
+                           bt_socket_errormsg());
+            }
+            return;
+        }
+
+#ifdef __linux__
+        slot.recvCalls.fetch_add(1, std::memory_order_relaxed);
+
+        for (int j = 0; j < n; ++j) {
+            slot.rxBytes.fetch_add(msgs[j].msg_len, std::memory_order_relaxed);
+            slot.decompressedBytes.fetch_add(msgs[j].msg_len, std::memory_order_relaxed);
+
+            if (msgs[j].msg_hdr.msg_flags & MSG_TRUNC) {
+                BT_CPPLOGW("Discarding datagram larger than the receive buffer: "
+                           "buffer-size={}",
+                           _mCfg.recvBufSize);
+                continue;
+            }
+
+            chunks[j]->len = msgs[j].msg_len;
+            slot.demux.pushPkt(std::move(chunks[j]));
+        }
+
+        if (this->_pauseIfStalled(fd, conn) || n < static_cast<int>(MAX_DGRAMS_PER_READ)) {
+            return;
+        }
+#else
+        chunks[0]->len = static_cast<std::size_t>(n);
+        this->_countRecv(slot, chunks[0]->len);
+        slot.decompressedBytes.fetch_add(chunks[0]->len, std::memory_order_relaxed);
+        slot.demux.pushPkt(std::move(chunks[0]));
+
+        if (this->_pauseIfStalled(fd, conn)) {
+            return;
+        }
+#endif
+    }
 }
 
-ctf::src::Buf CtfLiveSocketMedium::buf(bt2c::DataLen offset, bt2c::DataLen minSize)
+void CtfLiveSocketServer::_resumePausedConns()
 {
-    // The medium only gets asked about whole byte offsets and min sizes.
-    BT_ASSERT_DBG(offset.extraBitCount() == 0);
-    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
-    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
-    BT_ASSERT_DBG(_mFifo);
-    BT_CPPLOGD("buf(): offset={} minSize={}", offset.bytes(), minSize.bytes());
-    return _mFifo->next(offset.bytes(), minSize.bytes());
+    // Route the stalled views first, even without connection.
+    for (auto& slot : _mSlots) {
+        slot->demux.flush();
+    }
+
+    for (auto& conn : _mConns) {
+        if (conn.second.paused && !_mSlots[conn.second.slot]->demux.isStalled()) {
+            BT_CPPLOGD("Resuming client: peer={}", conn.second.peer);
+            conn.second.paused = false;
+            _mPoller.watchRead(conn.first, true);
+        }
+    }
 }
 
-CtfLiveSocketFifo::CtfLiveSocketFifo() :
-    _mMutex(), _mCv(), _mByteQueue(), _mCurrentOffset(0), _mCurrentBuf(),
-    _mLogger("FIFO", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info)
+void CtfLiveSocketServer::_closeConn(const sock_type_t fd)
 {
+    const auto it = _mConns.find(fd);
+    BT_ASSERT(it != _mConns.end());
+
+    BT_CPPLOGI("Client disconnected: peer={}, slot={}", it->second.peer, it->second.slot);
+    _mPoller.remove(fd);
+    shutdown(fd, BT_SHUT_RDWR);
+    bt_socket_close(fd);
+    _mSlots[it->second.slot]->busy = false;
+    _mConns.erase(it);
 }
 
-static std::string span_to_hexdump(bt2s::span<uint8_t> buf)
+CtfLiveSocketChunk::SP CtfLiveSocketServer::_acquireChunk()
 {
-    std::string str;
-    str.reserve(buf.size() * 2);
-    for (auto i = 0; i < buf.size(); ++i) {
-        str += fmt::format("{:02x}", buf[i]);
+    std::unique_ptr<CtfLiveSocketChunk> chunk;
+
+    {
+        /*
+         * The mutex also orders the last reads of the previous owner of
+         * a free chunk before overwriting its bytes.
+         */
+        std::lock_guard<std::mutex> lock {_mChunkPool->mutex};
+
+        if (!_mChunkPool->freeChunks.empty()) {
+            chunk = std::move(_mChunkPool->freeChunks.back());
+            _mChunkPool->freeChunks.pop_back();
+        }
+    }
+
+    if (chunk) {
+        chunk->len = 0;
+    } else {
+        chunk = bt2s::make_unique<CtfLiveSocketChunk>(_mCfg.recvBufSize);
+        BT_CPPLOGD("Allocated new receive chunk: size={}", _mCfg.recvBufSize);
     }
-    return str;
+
+    chunk->recvTime = std::chrono::steady_clock::now();
+
+    const auto pool = _mChunkPool;
+
+    // Put the chunk back to the free list instead of freeing it.
+    return CtfLiveSocketChunk::SP {
+        chunk.release(), [pool](CtfLiveSocketChunk * const freeChunk) {
+            std::unique_ptr<CtfLiveSocketChunk> owned {freeChunk};
+            std::lock_guard<std::mutex> lock {pool->mutex};
+
+            if (pool->freeChunks.size() < MAX_FREE_CHUNKS) {
+                pool->freeChunks.push_back(std::move(owned));
+            }
+        }};
+}
+
+void CtfLiveSocketServer::_countRecv(_Slot& slot, const std::size_t len) noexcept
+{
+    // Only the socket thread writes: relaxed increments are enough for readers.
+    slot.recvCalls.fetch_add(1, std::memory_order_relaxed);
+    slot.rxBytes.fetch_add(len, std::memory_order_relaxed);
 }
 
-ctf::src::Buf CtfLiveSocketFifo::next(unsigned long offset, unsigned long count)
+std::vector<CtfLiveSocketSlotStats> CtfLiveSocketServer::stats() const
 {
-    if (offset != _mCurrentOffset) {
-        BT_ASSERT(offset >= _mCurrentOffset);
-        {
-            std::unique_lock<std::mutex> lk(_mMutex);
-            const auto bytes_to_drop = offset - _mCurrentOffset;
-            for (auto i = 0; i < bytes_to_drop; ++i) {
-                _mByteQueue.pop_front();
+    std::vector<CtfLiveSocketSlotStats> stats;
+
+    for (const auto& slot : _mSlots) {
+        CtfLiveSocketSlotStats slotStats;
+
+        slotStats.connected = slot->busy;
+        slotStats.connCount = slot->connCount.load(std::memory_order_relaxed);
+        slotStats.rxBytes = slot->rxBytes.load(std::memory_order_relaxed);
+        slotStats.decompressedBytes = slot->decompressedBytes.load(std::memory_order_relaxed);
+        slotStats.recvCalls = slot->recvCalls.load(std::memory_order_relaxed);
+
+        for (const auto& clsFifos : slot->fifos) {
+            for (std::size_t i = 0; i < clsFifos.second.size(); ++i) {
+                const auto& fifo = *clsFifos.second[i];
+                bt2s::optional<unsigned long long> dataStreamId;
+
+                if (fifo.isBound()) {
+                    dataStreamId = fifo.boundDataStreamId();
+                }
+
+                slotStats.fifos.push_back(
+                    {clsFifos.first, i, dataStreamId, fifo.size(), fifo.pinnedSize(),
+                     fifo.maxSize(), fifo.highWaterSize(), fifo.droppedPktCount(),
+                     fifo.producerBlockedTime(), fifo.consumerWaitTime(), fifo.msgCount(),
+                     fifo.latencyHisto().snapshot(), fifo.queueingDelayHisto().snapshot()});
             }
-            _mCurrentOffset = offset;
         }
-        BT_CPPLOGD("Advance to offset={}", offset);
-    }
 
-    std::unique_lock<std::mutex> lk(_mMutex);
-    // If there's not enough data, return an empty buffer.
-    if (_mByteQueue.size() < count) {
-        BT_CPPLOGD("Not enough data: have={}, need={}", _mByteQueue.size(), count);
-        throw bt2c::TryAgain();
-    }
-    // Resize the temp buffer if we need more space for the request.
-    if (_mCurrentBuf.size() < count) {
-        _mCurrentBuf.resize(count);
+        stats.emplace_back(std::move(slotStats));
     }
-    // Copy data to a temporary buffer. The data will persist until the next
-    // call to next().
-    for (auto i = 0; i < count; ++i) {
-        _mCurrentBuf[i] = _mByteQueue[i];
-    }
-    BT_CPPLOGD("FIFO={} returning data len={}", fmt::ptr(this), count);
-    BT_CPPLOGD("Data={}", span_to_hexdump(bt2s::span<uint8_t>(_mCurrentBuf.data(), count)));
-    return ctf::src::Buf(_mCurrentBuf.data(), bt2c::DataLen::fromBytes(count));
+
+    return stats;
 }
 
-void CtfLiveSocketFifo::push(bt2s::span<uint8_t> data)
+void CtfLiveSocketServer::_logStats() const
 {
-    {
-        std::lock_guard<std::mutex> lg {_mMutex};
-        for (auto b : data) {
-            _mByteQueue.push_back(b);
+    const auto stats = this->stats();
+
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        const auto& slotStats = stats[i];
+
+        BT_CPPLOGI("Statistics: slot={}, connected={}, conn-count={}, rx-bytes={}, "
+                   "decompressed-bytes={}, recv-calls={}",
+                   i, slotStats.connected, slotStats.connCount, slotStats.rxBytes,
+                   slotStats.decompressedBytes, slotStats.recvCalls);
+
+        for (const auto& fifoStats : slotStats.fifos) {
+            BT_CPPLOGI("Statistics: slot={}, data-stream-cls-id={}, index={}, "
+                       "data-stream-id={}, buffered-bytes={}, pinned-bytes={}, "
+                       "max-buffered-bytes={}, high-water-bytes={}, dropped-pkt-count={}, "
+                       "producer-blocked-ms={}, consumer-wait-ms={}, msg-count={}",
+                       i, fifoStats.dataStreamClsId, fifoStats.index,
+                       fifoStats.dataStreamId ? fmt::to_string(*fifoStats.dataStreamId) : "none",
+                       fifoStats.size, fifoStats.pinnedSize, fifoStats.maxSize,
+                       fifoStats.highWaterSize, fifoStats.droppedPktCount,
+                       std::chrono::duration_cast<std::chrono::milliseconds>(
+                           fifoStats.producerBlockedTime)
+                           .count(),
+                       std::chrono::duration_cast<std::chrono::milliseconds>(
+                           fifoStats.consumerWaitTime)
+                           .count(),
+                       fifoStats.msgCount);
+
+            if (_mCfg.latencyStats) {
+                this->_logLatencyStats(i, fifoStats, "latency", fifoStats.latency);
+                this->_logLatencyStats(i, fifoStats, "queueing-delay", fifoStats.queueingDelay);
+            }
         }
     }
-    _mCv.notify_one();
 }
 
-void CtfLiveSocketFifo::_waitForData()
+void CtfLiveSocketServer::_logLatencyStats(const std::size_t slot,
+                                           const CtfLiveSocketFifoStats& fifoStats,
+                                           const char * const what,
+                                           const CtfLiveLatencyHistoSnapshot& snapshot) const
+{
+    BT_CPPLOGI("Statistics: slot={}, data-stream-cls-id={}, index={}, {}: count={}, "
+               "negative-count={}, min-us={}, mean-us={}, p50-us={}, p90-us={}, p99-us={}, "
+               "p99.9-us={}, max-us={}",
+               slot, fifoStats.dataStreamClsId, fifoStats.index, what, snapshot.count,
+               snapshot.negativeCount, snapshot.min / 1000, snapshot.mean / 1000,
+               snapshot.p50 / 1000, snapshot.p90 / 1000, snapshot.p99 / 1000,
+               snapshot.p999 / 1000, snapshot.max / 1000);
+}
+
+CtfLiveSocketFifo& CtfLiveSocketServer::fifo(const std::size_t slot,
+                                             const unsigned long long dataStreamClsId,
+                                             const std::size_t index)
+{
+    BT_ASSERT(slot < _mSlots.size());
+
+    const auto it = _mSlots[slot]->fifos.find(dataStreamClsId);
+    BT_ASSERT(it != _mSlots[slot]->fifos.end());
+    BT_ASSERT(index < it->second.size());
+    return *it->second[index];
+}
+
+std::unique_ptr<CtfLiveSocketMedium>
+CtfLiveSocketServer::create_medium(const std::size_t slot, const unsigned long long dataStreamClsId,
+                                   const std::size_t index,
+                                   const std::chrono::milliseconds waitTimeout,
+                                   std::function<bool()> isInterrupted)
 {
-    std::unique_lock<std::mutex> lk(_mMutex);
-    _mCv.wait(lk);
+    // The medium receives an unowned pointer, ownership of the fifo belongs to
+    // the server.
+    auto medium = bt2s::make_unique<CtfLiveSocketMedium>(
+        this, &this->fifo(slot, dataStreamClsId, index), waitTimeout, std::move(isInterrupted));
+    BT_CPPLOGD("Created new medium for socket server: medium={}", fmt::ptr(medium.get()));
+    return medium;
+}
+
+constexpr std::chrono::milliseconds CtfLiveSocketMedium::INTERRUPT_CHECK_PERIOD;
+
+CtfLiveSocketMedium::CtfLiveSocketMedium(CtfLiveSocketServer *server, CtfLiveSocketFifo *fifo,
+                                         const std::chrono::milliseconds waitTimeout,
+                                         std::function<bool()> isInterrupted) :
+    _mServer(server),
+    _mFifo(fifo), _mWaitTimeout(waitTimeout), _mIsInterrupted(std::move(isInterrupted)),
+    _mLogger("MEDIUM", "PLUGIN/CTF/LIVE", bt2c::Logger::Level::Info)
+{
+}
+
+CtfLiveSocketMedium::~CtfLiveSocketMedium()
+{
+    BT_CPPLOGD("Cleaning up socket medium={}", fmt::ptr(this));
+}
+
+ctf::src::Buf CtfLiveSocketMedium::buf(const bt2c::DataLen offset, const bt2c::DataLen minSize,
+                                       const bt2c::DataLen prefSize)
+{
+    return this->tryBuf(offset, minSize, prefSize).bufOrThrow();
+}
+
+ctf::src::BufResult CtfLiveSocketMedium::tryBuf(bt2c::DataLen offset, bt2c::DataLen minSize,
+                                                bt2c::DataLen prefSize)
+{
+    // The medium only gets asked about whole byte offsets and min sizes.
+    BT_ASSERT_DBG(offset.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
+    BT_ASSERT_DBG(minSize.extraBitCount() == 0);
+    BT_ASSERT_DBG(_mFifo);
+    BT_CPPLOGD("tryBuf(): offset={} minSize={} prefSize={}", offset.bytes(), minSize.bytes(),
+               prefSize.bytes());
+
+    const auto deadline = std::chrono::steady_clock::now() + _mWaitTimeout;
+
+    while (true) {
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+
+        const auto res = _mFifo->next(offset.bytes(), minSize.bytes(), prefSize.bytes(),
+                                      std::min(left, INTERRUPT_CHECK_PERIOD));
+
+        if (res.isOk() || left <= INTERRUPT_CHECK_PERIOD ||
+            (_mIsInterrupted && _mIsInterrupted())) {
+            return res;
+        }
+    }
 }
@@ -8,90 +8,356 @@
 #ifndef BABELTRACE_PLUGINS_CTF_LIVE_SRC_SOCKET_HPP
 #define BABELTRACE_PLUGINS_CTF_LIVE_SRC_SOCKET_HPP
 
-#include <array>
 #include <atomic>
-#include <condition_variable>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "compat/socket.hpp"
 #include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/optional.hpp"
 
 #include "plugins/ctf/common/src/item-seq/medium.hpp"
+#include "plugins/ctf/common/src/metadata/ctf-ir.hpp"
+#include "plugins/ctf/live-src/demux.hpp"
+#include "plugins/ctf/live-src/fifo.hpp"
+#include "plugins/ctf/live-src/poller.hpp"
+#include "plugins/ctf/live-src/recorder.hpp"
+
+class CtfLiveSocketMedium;
 
 /*
- * Thread-safe byte queue that buffers incoming socket data and serves
- * it to readers on demand, throwing TryAgain when insufficient data is available.
+ * Transport over which a socket server receives CTF data.
  */
-class CtfLiveSocketFifo
+enum class CtfLiveTransport
 {
-public:
-    CtfLiveSocketFifo();
+    Tcp,
+    Udp,
+    UnixStream,
+    UnixDgram,
+};
 
-    ctf::src::Buf next(unsigned long offset, unsigned long count);
-    void push(bt2s::span<uint8_t>);
+/*
+ * Compression of the byte stream of a client connection.
+ */
+enum class CtfLiveCompression
+{
+    None,
 
-private:
-    void _waitForData();
-
-    std::mutex _mMutex;
-    // Used for notification from socket thread to readers.
-    std::condition_variable _mCv;
-    std::deque<uint8_t> _mByteQueue;
-    unsigned long _mCurrentOffset;
-    std::vector<uint8_t> _mCurrentBuf;
-    bt2c::Logger _mLogger;
+    // A sequence of zstd frames (stream transports only).
+    Zstd,
 };
 
-class CtfLiveSocketMedium;
+/*
+ * Configuration of a socket server.
+ */
+struct CtfLiveSocketServerCfg
+{
+    CtfLiveTransport transport = CtfLiveTransport::Tcp;
+
+    // IPv4 address and port to bind to (TCP and UDP).
+    std::string address = "127.0.0.1";
+    int port = 42674;
+
+    // Socket file path to bind to (Unix domain sockets).
+    std::string path;
+
+    // Capacity of each receive chunk, that is, the maximum size of a single recv() call.
+    std::size_t recvBufSize = 64 * 1024;
+
+    // Soft limit of the number of bytes buffered for a single port.
+    std::size_t fifoMaxSize = 64 * 1024 * 1024;
+
+    CtfLiveOverflowPolicy overflowPolicy = CtfLiveOverflowPolicy::Block;
+
+    CtfLiveCompression compression = CtfLiveCompression::None;
+
+    // Number of FIFOs, that is, of data stream instances, per data stream class.
+    std::size_t fifosPerDataStreamCls = 1;
+
+    /*
+     * Maximum size (no history if zero) and age (no limit if zero) of
+     * the history of each FIFO (see CtfLiveSocketFifo).
+     */
+    std::size_t historyMaxSize = 0;
+    std::chrono::milliseconds historyMaxAge {0};
+
+    // Period of the statistics logging, disabled if zero.
+    std::chrono::milliseconds statsLogPeriod {0};
+
+    /*
+     * Whether or not the message iterators record the latency and
+     * queueing delay of each emitted event (see CtfLiveSocketFifo).
+     */
+    bool latencyStats = false;
+};
+
+/*
+ * Snapshot of the statistics of a port FIFO of a socket server.
+ */
+struct CtfLiveSocketFifoStats
+{
+    unsigned long long dataStreamClsId;
+
+    // Index of the FIFO within the FIFOs of its data stream class.
+    std::size_t index;
+
+    // Data stream instance ID of the FIFO, if bound and known.
+    bt2s::optional<unsigned long long> dataStreamId;
+
+    std::size_t size;
+
+    // See CtfLiveSocketFifo::pinnedSize().
+    std::size_t pinnedSize;
+    std::size_t maxSize;
+    std::size_t highWaterSize;
+    unsigned long long droppedPktCount;
+    std::chrono::nanoseconds producerBlockedTime;
+    std::chrono::nanoseconds consumerWaitTime;
+    unsigned long long msgCount;
+
+    // See CtfLiveSocketFifo::latencyHisto() and CtfLiveSocketFifo::queueingDelayHisto().
+    CtfLiveLatencyHistoSnapshot latency;
+    CtfLiveLatencyHistoSnapshot queueingDelay;
+};
 
 /*
- * TCP server that accepts a single client connection on a local port and
- * streams incoming data to registered medium instances.
+ * Snapshot of the statistics of a client slot of a socket server.
+ */
+struct CtfLiveSocketSlotStats
+{
+    bool connected;
+    unsigned long long connCount;
+    unsigned long long rxBytes;
+
+    // Equal to `rxBytes` without compression.
+    unsigned long long decompressedBytes;
+
+    unsigned long long recvCalls;
+    std::vector<CtfLiveSocketFifoStats> fifos;
+};
+
+/*
+ * Configuration of a client slot of a socket server.
+ */
+struct CtfLiveSocketSlotCfg
+{
+    // Class of the trace which the client of this slot sends.
+    const ctf::src::TraceCls *traceCls = nullptr;
+
+    // Recorder of the data which the client of this slot sends, if any.
+    std::unique_ptr<CtfLiveRecorder> recorder;
+
+    // See CtfLiveSocketDemux.
+    std::mutex *traceClsMutex = nullptr;
+    CtfLiveSocketDemux::OnMetadata onMetadata;
+};
+
+/*
+ * Server that accepts concurrent client connections and streams the
+ * incoming data of each one, split by data stream class, to the FIFOs
+ * of its client slot.
+ *
+ * There's one client slot per slot configuration given on
+ * construction, each having `fifosPerDataStreamCls` FIFOs per data
+ * stream class. A new client takes the first free slot; the server
+ * rejects clients when all the slots are busy.
+ *
+ * With datagram transports (UDP and Unix datagram sockets), each
+ * datagram must hold exactly one packet, and all the datagrams feed
+ * the first slot.
+ *
+ * With compression, the socket thread decompresses the received bytes
+ * of each connection straight into the chunks which it feeds to the
+ * demultiplexer.
+ *
+ * A single thread serves all the connections with non-blocking sockets
+ * and a CtfLiveSocketPoller.
  */
 class CtfLiveSocketServer
 {
 public:
-    CtfLiveSocketServer(int port);
+    CtfLiveSocketServer(std::vector<CtfLiveSocketSlotCfg> slotCfgs,
+                        const CtfLiveSocketServerCfg& cfg);
     ~CtfLiveSocketServer();
 
-    std::unique_ptr<CtfLiveSocketMedium> create_medium();
+    /*
+     * Creates a medium reading the packets of the data stream bound to
+     * the FIFO `index` of the data stream class `dataStreamClsId`, sent
+     * by the client of the slot `slot`.
+     *
+     * See CtfLiveSocketMedium for `waitTimeout` and `isInterrupted`.
+     */
+    std::unique_ptr<CtfLiveSocketMedium>
+    create_medium(std::size_t slot, unsigned long long dataStreamClsId, std::size_t index,
+                  std::chrono::milliseconds waitTimeout,
+                  std::function<bool()> isInterrupted);
+
+    // FIFO `index` of the data stream class `dataStreamClsId` of the slot `slot`.
+    CtfLiveSocketFifo& fifo(std::size_t slot, unsigned long long dataStreamClsId,
+                            std::size_t index);
+
+    // Returns a snapshot of the statistics of each slot; may be called from any thread.
+    std::vector<CtfLiveSocketSlotStats> stats() const;
+
+    const CtfLiveSocketServerCfg& cfg() const noexcept
+    {
+        return _mCfg;
+    }
 
 private:
-    static constexpr int MAX_CONNECTIONS = 1;
-    static constexpr int INCOMING_BUF_SIZE = 4096;
     using sock_type_t = BT_SOCKET;
 
-    void _clientLoop();
+    /*
+     * Maximum time to wait for readiness before checking for shutdown
+     * or paused connections (a reader making room wakes the socket
+     * thread up earlier).
+     */
+    static constexpr int POLL_TIMEOUT_MS = 100;
+
+    // Maximum number of consecutive reads from a single connection, for fairness.
+    static constexpr int MAX_READS_PER_WAKEUP = 16;
+
+    // Maximum number of datagrams received with a single system call.
+    static constexpr std::size_t MAX_DGRAMS_PER_READ = 32;
+
+    // Maximum number of free receive chunks to keep for reuse.
+    static constexpr std::size_t MAX_FREE_CHUNKS = 256;
+
+    /*
+     * Free list of receive chunks.
+     *
+     * The last owner of a chunk which _acquireChunk() returns, on any
+     * thread, puts it back here instead of freeing it, unless there are
+     * already `MAX_FREE_CHUNKS` free chunks. Shared with those chunks
+     * so that it outlives the server if needed.
+     */
+    struct _ChunkPool
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<CtfLiveSocketChunk>> freeChunks;
+    };
+
+    struct _Slot
+    {
+        explicit _Slot(CtfLiveSocketSlotCfg slotCfg, const CtfLiveSocketServerCfg& cfg,
+                       const bt2c::Logger& logger);
+
+        // FIFOs of each data stream class, created before the socket thread starts.
+        CtfLiveSocketDemux::FifoMap fifos;
+        std::unique_ptr<CtfLiveRecorder> recorder;
+        CtfLiveSocketDemux demux;
+        std::atomic<bool> busy {false};
+
+        // Statistics, only written by the socket thread.
+        std::atomic<unsigned long long> connCount {0};
+        std::atomic<unsigned long long> rxBytes {0};
+        std::atomic<unsigned long long> decompressedBytes {0};
+        std::atomic<unsigned long long> recvCalls {0};
+    };
+
+    struct _ZstdDctxDeleter
+    {
+        void operator()(struct ZSTD_DCtx_s *dctx) const noexcept;
+    };
+
+    struct _Conn
+    {
+        std::string peer;
+        std::size_t slot;
+
+        // Not watched for reading while the demultiplexer of its slot is stalled.
+        bool paused = false;
+
+        // Decompression context, with zstd compression.
+        std::unique_ptr<struct ZSTD_DCtx_s, _ZstdDctxDeleter> zstdDctx;
+    };
+
+    bool _isDgram() const noexcept;
+
+    // Create and bind `_mSocketFd`, returning a description of the address.
+    std::string _bindInet(int sockType);
+    std::string _bindUnix(int sockType);
+
     void _socketServerLoop();
-    void _pushData(bt2s::span<uint8_t>);
+    void _onReady(sock_type_t fd);
+    void _accept();
+    void _resumePausedConns();
+
+    // Returns false if the connection is closed.
+    bool _readConn(sock_type_t fd, _Conn& conn);
+
+    // Decompresses the first `len` bytes of `_mCompressedBuf`, received from `conn`.
+    void _decompress(_Conn& conn, std::size_t len);
+    void _readDgrams(sock_type_t fd, _Conn& conn);
+
+    /*
+     * Pauses `conn` if the demultiplexer of its slot is stalled after
+     * routing its data, returning whether or not it did.
+     */
+    bool _pauseIfStalled(sock_type_t fd, _Conn& conn);
+    void _closeConn(sock_type_t fd);
+
+    CtfLiveSocketChunk::SP _acquireChunk();
+    void _countRecv(_Slot& slot, std::size_t len) noexcept;
+    void _logStats() const;
+
+    // Logs the snapshot `snapshot`, named `what`, of a latency histogram of `fifoStats`.
+    void _logLatencyStats(std::size_t slot, const CtfLiveSocketFifoStats& fifoStats,
+                          const char *what, const CtfLiveLatencyHistoSnapshot& snapshot) const;
+
     std::atomic<bool> _mKeepRunning;
     std::thread _mSocketThread;
     sock_type_t _mSocketFd = BT_INVALID_SOCKET;
-    sock_type_t _mClientFd = BT_INVALID_SOCKET;
-    std::array<uint8_t, INCOMING_BUF_SIZE> _mReadBuf;
+    CtfLiveSocketServerCfg _mCfg;
+
+    std::shared_ptr<_ChunkPool> _mChunkPool;
+
+    // Receive buffer of the compressed bytes, with compression.
+    std::vector<std::uint8_t> _mCompressedBuf;
     bt2c::Logger _mLogger;
-    std::vector<std::unique_ptr<CtfLiveSocketFifo>> _mFifos;
+    std::vector<std::unique_ptr<_Slot>> _mSlots;
+    std::unordered_map<sock_type_t, _Conn> _mConns;
+    CtfLiveSocketPoller _mPoller;
+    std::chrono::steady_clock::time_point _mLastStatsLogTime;
 };
 
 /*
  * Adapter that bridges a socket server's FIFO to the CTF source Medium interface,
  * providing byte-offset-based reads to the live CTF plugin.
+ *
+ * When data is short, tryBuf() sleeps until it arrives, for at most
+ * `waitTimeout`, before returning a "try again" result. It checks
+ * `isInterrupted` every `INTERRUPT_CHECK_PERIOD` while waiting, so that
+ * an interrupted graph doesn't wait for the whole timeout.
  */
 class CtfLiveSocketMedium : public ctf::src::Medium
 {
 public:
-    CtfLiveSocketMedium(CtfLiveSocketServer *, CtfLiveSocketFifo *);
+    CtfLiveSocketMedium(CtfLiveSocketServer *, CtfLiveSocketFifo *,
+                        std::chrono::milliseconds waitTimeout,
+                        std::function<bool()> isInterrupted);
     ~CtfLiveSocketMedium() override;
 
-    // Buf may only be ever called from a single thread.
-    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize) override;
+    // Buf and tryBuf may only be ever called from a single thread.
+    ctf::src::Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
+    ctf::src::BufResult tryBuf(bt2c::DataLen offset, bt2c::DataLen minSize,
+                               bt2c::DataLen prefSize) override;
 
 private:
+    static constexpr std::chrono::milliseconds INTERRUPT_CHECK_PERIOD {50};
+
     CtfLiveSocketServer *_mServer;
     CtfLiveSocketFifo *_mFifo;
+    std::chrono::milliseconds _mWaitTimeout;
+    std::function<bool()> _mIsInterrupted;
     bt2c::Logger _mLogger;
 };
 
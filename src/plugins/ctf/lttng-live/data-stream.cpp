@@ -27,7 +27,7 @@ namespace ctf {
 namespace src {
 namespace live {
 
-Buf CtfLiveMedium::buf(bt2c::DataLen requestedOffsetInStream, bt2c::DataLen minSize)
+Buf CtfLiveMedium::buf(bt2c::DataLen requestedOffsetInStream, bt2c::DataLen minSize, bt2c::DataLen)
 {
     BT_CPPLOGD("CtfLiveMedium::buf called: stream-id={}, offset-bytes={}, min-size-bytes={}",
                _mLiveStreamIter.stream ? _mLiveStreamIter.stream->id() : -1,
@@ -54,17 +54,22 @@ Buf CtfLiveMedium::buf(bt2c::DataLen requestedOffsetInStream, bt2c::DataLen minS
 
     auto maxReqLen = bt2c::DataLen::fromBytes(
         _mLiveStreamIter.trace->session->lttng_live_msg_iter->lttng_live_comp->max_query_size);
-    auto reqLen = std::min(lenUntilEndOfPacket, maxReqLen);
-    uint64_t recvLen;
 
-    _mBuf.resize(reqLen.bytes());
+    /* Pipeline several maximum length requests (see lttng_live_get_stream_bytes()) */
+    auto reqLen =
+        std::min(lenUntilEndOfPacket, maxReqLen * LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT);
+
+    /* Have the I/O thread read ahead the rest of the packet */
+    auto nextLen = std::min(lenUntilEndOfPacket - reqLen,
+                            maxReqLen * LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT);
+    const uint8_t *data;
+    uint64_t recvLen;
 
     lttng_live_get_stream_bytes_status status = lttng_live_get_stream_bytes(
-        _mLiveStreamIter.trace->session->lttng_live_msg_iter, &_mLiveStreamIter, _mBuf.data(),
-        requestedOffsetInRelay.bytes(), reqLen.bytes(), &recvLen);
+        _mLiveStreamIter.trace->session->lttng_live_msg_iter, &_mLiveStreamIter,
+        requestedOffsetInRelay.bytes(), reqLen.bytes(), nextLen.bytes(), &data, &recvLen);
     switch (status) {
     case LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK:
-        _mBuf.resize(recvLen);
         break;
 
     case LTTNG_LIVE_GET_STREAM_BYTES_STATUS_AGAIN:
@@ -80,7 +85,7 @@ Buf CtfLiveMedium::buf(bt2c::DataLen requestedOffsetInStream, bt2c::DataLen minS
         throw bt2c::Error();
     }
 
-    const Buf buf {_mBuf.data(), bt2c::DataLen::fromBytes(_mBuf.size())};
+    const Buf buf {data, bt2c::DataLen::fromBytes(recvLen)};
 
     BT_CPPLOGD("CtfLiveMedium::buf returns: stream-id={}, buf-addr={}, buf-size-bytes={}",
                _mLiveStreamIter.stream ? _mLiveStreamIter.stream->id() : -1, fmt::ptr(buf.addr()),
@@ -199,6 +204,12 @@ void lttng_live_stream_iterator_set_stream_class(lttng_live_stream_iterator *str
 
 lttng_live_stream_iterator::~lttng_live_stream_iterator()
 {
+    const auto& viewerConnection = this->trace->session->lttng_live_msg_iter->viewer_connection;
+
+    if (viewerConnection && viewerConnection->io_thread) {
+        viewerConnection->io_thread->forgetStream(this->viewer_stream_id);
+    }
+
     /* Track the number of active stream iterator. */
     this->trace->session->lttng_live_msg_iter->active_stream_iter--;
 }
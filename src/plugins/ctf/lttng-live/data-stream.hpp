@@ -7,6 +7,7 @@
 #ifndef BABELTRACE_PLUGINS_CTF_LTTNG_LIVE_DATA_STREAM_HPP
 #define BABELTRACE_PLUGINS_CTF_LTTNG_LIVE_DATA_STREAM_HPP
 
+#include <memory>
 #include <stdint.h>
 
 #include "lttng-live.hpp"
@@ -27,14 +28,17 @@ struct CtfLiveMedium : Medium
     {
     }
 
-    Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize) override;
+    Buf buf(bt2c::DataLen offset, bt2c::DataLen minSize, bt2c::DataLen prefSize) override;
 
 private:
     bt2c::Logger _mLogger;
     lttng_live_stream_iterator& _mLiveStreamIter;
 
+    /*
+     * The last returned `Buf` views the buffer of the stream within the
+     * I/O thread of the viewer connection (see lttng_live_get_stream_bytes()).
+     */
     bt2c::DataLen _mCurPktBegOffsetInStream = bt2c::DataLen::fromBits(0);
-    std::vector<uint8_t> _mBuf;
 };
 
 } /* namespace live */
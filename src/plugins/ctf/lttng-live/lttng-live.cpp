@@ -8,6 +8,7 @@
  * Babeltrace CTF LTTng-live Client Component
  */
 
+#include <algorithm>
 #include <glib.h>
 #include <unistd.h>
 
@@ -33,6 +34,13 @@
 #define SESS_NOT_FOUND_ACTION_CONTINUE_STR "continue"
 #define SESS_NOT_FOUND_ACTION_FAIL_STR     "fail"
 #define SESS_NOT_FOUND_ACTION_END_STR      "end"
+#define MAX_RETRY_DURATION_PARAM           "max-retry-duration"
+
+/* Minimum duration of a wait before returning "try again" (µs) */
+#define MIN_RETRY_DURATION_US 1000
+
+/* Longest sleep between two graph cancellation checks (µs) */
+#define RETRY_SLEEP_SLICE_US (50 * 1000)
 
 void lttng_live_stream_iterator_set_state(struct lttng_live_stream_iterator *stream_iter,
                                           enum lttng_live_stream_state new_state)
@@ -193,6 +201,34 @@ lttng_live_iterator_next_check_stream_state(struct lttng_live_stream_iterator *l
     return LTTNG_LIVE_ITERATOR_STATUS_OK;
 }
 
+/*
+ * Updates the estimated period of the inactivity beacons of the relay
+ * daemon of `lttng_live_msg_iter` when a stream iterator receives a
+ * new one.
+ */
+static void
+lttng_live_msg_iter_note_inactivity_beacon(struct lttng_live_msg_iter *lttng_live_msg_iter)
+{
+    auto& retry = lttng_live_msg_iter->retry;
+    const int64_t now_us = g_get_monotonic_time();
+
+    if (retry.last_beacon_time_us >= 0) {
+        const uint64_t elapsed_us = now_us - retry.last_beacon_time_us;
+
+        if (elapsed_us < MIN_RETRY_DURATION_US) {
+            /* Another stream of the same live timer tick */
+            return;
+        }
+
+        /* Exponentially weighted moving average */
+        retry.beacon_period_us = retry.beacon_period_us == 0 ?
+                                     elapsed_us :
+                                     (3 * retry.beacon_period_us + elapsed_us) / 4;
+    }
+
+    retry.last_beacon_time_us = now_us;
+}
+
 /*
  * For active no data stream, fetch next index. As a result of that it can
  * become either:
@@ -254,6 +290,7 @@ static enum lttng_live_iterator_status lttng_live_iterator_next_handle_one_no_da
             ret = LTTNG_LIVE_ITERATOR_STATUS_AGAIN;
             LTTNG_LIVE_LOGD_STREAM_ITER(lttng_live_stream);
         } else {
+            lttng_live_msg_iter_note_inactivity_beacon(lttng_live_msg_iter);
             ret = LTTNG_LIVE_ITERATOR_STATUS_CONTINUE;
         }
         goto end;
@@ -606,11 +643,19 @@ static enum lttng_live_iterator_status lttng_live_iterator_next_handle_one_activ
     }
 
     if (!lttng_live_stream->msg_iter) {
-        /* The first time we're called for this stream, the MsgIter is not instantiated.  */
-        enum lttng_live_iterator_status ret =
-            lttng_live_stream_iterator_create_msg_iter(lttng_live_stream);
-        if (ret != LTTNG_LIVE_ITERATOR_STATUS_OK) {
-            return ret;
+        /*
+         * The first time we're called for this stream, the MsgIter is
+         * not instantiated. Creating it reads the properties of the
+         * first packet, which the I/O thread may not have received yet.
+         */
+        try {
+            enum lttng_live_iterator_status ret =
+                lttng_live_stream_iterator_create_msg_iter(lttng_live_stream);
+            if (ret != LTTNG_LIVE_ITERATOR_STATUS_OK) {
+                return ret;
+            }
+        } catch (const bt2c::TryAgain&) {
+            return LTTNG_LIVE_ITERATOR_STATUS_AGAIN;
         }
     }
 
@@ -1215,6 +1260,78 @@ next_stream_iterator_for_session(struct lttng_live_msg_iter *lttng_live_msg_iter
     }
 }
 
+/*
+ * Returns whether or not all the stream iterators of
+ * `lttng_live_msg_iter` are quiescent or ended.
+ */
+static bool lttng_live_msg_iter_is_quiescent(struct lttng_live_msg_iter *lttng_live_msg_iter)
+{
+    for (const auto& session : lttng_live_msg_iter->sessions) {
+        for (const auto& trace : session->traces) {
+            for (const auto& stream_iter : trace->stream_iterators) {
+                if (stream_iter->state != LTTNG_LIVE_STREAM_QUIESCENT &&
+                    stream_iter->state != LTTNG_LIVE_STREAM_QUIESCENT_NO_DATA &&
+                    stream_iter->state != LTTNG_LIVE_STREAM_EOF) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Waits, before returning "try again" without messages, for a duration
+ * which adapts to the activity of the traced system.
+ *
+ * The duration doubles, from `MIN_RETRY_DURATION_US`, on each
+ * consecutive call without new messages, so that a busy session
+ * (messages only missing for a short time) keeps a low latency while
+ * an idle one seldom polls the relay daemon.
+ *
+ * When all the streams are quiescent, the relay daemon won't have new
+ * data before its next live timer tick, making it pointless to poll it
+ * much more often than the estimated period of the inactivity beacons.
+ *
+ * The duration never exceeds the `max-retry-duration` parameter.
+ */
+static void lttng_live_msg_iter_wait_before_retry(struct lttng_live_msg_iter *lttng_live_msg_iter)
+{
+    auto& retry = lttng_live_msg_iter->retry;
+    const uint64_t max_duration_us =
+        lttng_live_msg_iter->lttng_live_comp->params.max_retry_duration_us;
+
+    if (max_duration_us == 0) {
+        return;
+    }
+
+    retry.duration_us = retry.duration_us == 0 ? MIN_RETRY_DURATION_US : retry.duration_us * 2;
+
+    if (retry.beacon_period_us > 0 && lttng_live_msg_iter_is_quiescent(lttng_live_msg_iter)) {
+        retry.duration_us = std::max(retry.duration_us, retry.beacon_period_us / 4);
+    }
+
+    retry.duration_us = std::min(retry.duration_us, max_duration_us);
+
+    BT_CPPLOGD_SPEC(lttng_live_msg_iter->logger,
+                    "Waiting before returning \"try again\": duration-us={}, "
+                    "beacon-period-us={}",
+                    retry.duration_us, retry.beacon_period_us);
+
+    const int64_t end_us = g_get_monotonic_time() + retry.duration_us;
+
+    while (!lttng_live_graph_is_canceled(lttng_live_msg_iter)) {
+        const int64_t now_us = g_get_monotonic_time();
+
+        if (now_us >= end_us) {
+            break;
+        }
+
+        g_usleep(std::min<int64_t>(end_us - now_us, RETRY_SLEEP_SLICE_US));
+    }
+}
+
 static inline void put_messages(bt_message_array_const msgs, uint64_t count)
 {
     uint64_t i;
@@ -1432,8 +1549,10 @@ return_status:
              */
             if (*count > 0) {
                 status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+                lttng_live_msg_iter->retry.duration_us = 0;
             } else {
                 status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+                lttng_live_msg_iter_wait_before_retry(lttng_live_msg_iter);
             }
             break;
         case LTTNG_LIVE_ITERATOR_STATUS_END:
@@ -1739,6 +1858,8 @@ static struct bt_param_validation_map_value_entry_descr params_descr[] = {
      bt_param_validation_value_descr::makeArray(1, 1, inputs_elem_descr)},
     {SESS_NOT_FOUND_ACTION_PARAM, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeString(sess_not_found_action_choices)},
+    {MAX_RETRY_DURATION_PARAM, BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
 
 static bt_component_class_initialize_method_status
@@ -1781,6 +1902,21 @@ lttng_live_component_create(const bt_value *params, bt_self_component_source *se
         lttng_live->params.sess_not_found_act = SESSION_NOT_FOUND_ACTION_CONTINUE;
     }
 
+    value = bt_value_map_borrow_entry_value_const(params, MAX_RETRY_DURATION_PARAM);
+    if (value) {
+        const int64_t duration = bt_value_integer_signed_get(value);
+
+        if (duration < 0) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(lttng_live->logger,
+                                         "Invalid `{}` parameter: "
+                                         "expecting a positive duration or 0: duration={}",
+                                         MAX_RETRY_DURATION_PARAM, duration);
+            return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+        }
+
+        lttng_live->params.max_retry_duration_us = static_cast<uint64_t>(duration);
+    }
+
     component = std::move(lttng_live);
     return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 }
@@ -327,6 +327,13 @@ struct lttng_live_component
     {
         std::string url;
         enum session_not_found_action sess_not_found_act = SESSION_NOT_FOUND_ACTION_CONTINUE;
+
+        /*
+         * Maximum duration (µs) to wait before returning "try again"
+         * (see lttng_live_msg_iter_wait_before_retry()), or 0 to
+         * return it immediately.
+         */
+        uint64_t max_retry_duration_us = 0;
     } params;
 
     size_t max_query_size = 0;
@@ -375,6 +382,22 @@ struct lttng_live_msg_iter
     bool was_interrupted = false;
 
     muxing::MessageComparator msgComparator;
+
+    /* Adaptive retry state (see lttng_live_msg_iter_wait_before_retry()) */
+    struct
+    {
+        /* Duration of the last wait (µs), 0 if the last batch had messages */
+        uint64_t duration_us = 0;
+
+        /*
+         * Monotonic time (µs) of the last received new inactivity
+         * beacon, or -1 if none yet.
+         */
+        int64_t last_beacon_time_us = -1;
+
+        /* Estimated period of the inactivity beacons (µs), or 0 */
+        uint64_t beacon_period_us = 0;
+    } retry;
 };
 
 enum lttng_live_iterator_status
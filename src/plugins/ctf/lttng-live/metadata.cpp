@@ -155,7 +155,19 @@ enum lttng_live_iterator_status lttng_live_metadata_update(struct lttng_live_tra
                            trace->session->lttng_live_msg_iter->viewer_connection->minor);
     if (!trace->trace) {
         const ctf::src::TraceCls *ctfTraceCls = metadata->traceCls();
-        BT_ASSERT(ctfTraceCls);
+
+        if (!ctfTraceCls) {
+            /*
+             * The metadata received so far doesn't define the trace
+             * class yet, for example because it ends with an
+             * incomplete CTF 2 fragment: try again later.
+             */
+            BT_CPPLOGD_SPEC(metadata->logger,
+                            "No trace class yet: session-id={}, trace-id={}", session->id,
+                            trace->id);
+            return LTTNG_LIVE_ITERATOR_STATUS_AGAIN;
+        }
+
         bt2::OptionalBorrowedObject<bt2::TraceClass> irTraceCls = ctfTraceCls->libCls();
 
         if (irTraceCls) {
@@ -5,9 +5,11 @@
  * Copyright 2016 Mathieu Desnoyers <mathieu.desnoyers@efficios.com>
  */
 
+#include <algorithm>
 #include <glib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <vector>
 
 #include <babeltrace2/babeltrace.h>
 
@@ -932,6 +934,9 @@ lttng_live_create_viewer_session(struct lttng_live_msg_iter *lttng_live_msg_iter
     cmd.data_size = htobe64((uint64_t) 0);
     cmd.cmd_version = htobe32(0);
 
+    /* Don't interleave with a command of the I/O thread */
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
     status = lttng_live_send(viewer_connection, &cmd, sizeof(cmd));
     if (status != LTTNG_LIVE_VIEWER_STATUS_OK) {
         viewer_handle_send_status(status, "create session command");
@@ -1042,6 +1047,10 @@ enum lttng_live_viewer_status lttng_live_session_attach(struct lttng_live_sessio
      */
     memcpy(cmd_buf, &cmd, sizeof(cmd));
     memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
+
+    /* Don't interleave with a command of the I/O thread */
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
     status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
     if (status != LTTNG_LIVE_VIEWER_STATUS_OK) {
         viewer_handle_send_status(status, "attach session command");
@@ -1136,6 +1145,10 @@ enum lttng_live_viewer_status lttng_live_session_detach(struct lttng_live_sessio
      */
     memcpy(cmd_buf, &cmd, sizeof(cmd));
     memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
+
+    /* Don't interleave with a command of the I/O thread */
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
     status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
     if (status != LTTNG_LIVE_VIEWER_STATUS_OK) {
         viewer_handle_send_status(status, "detach session command");
@@ -1200,6 +1213,10 @@ lttng_live_get_one_metadata_packet(struct lttng_live_trace *trace, std::vector<u
      */
     memcpy(cmd_buf, &cmd, sizeof(cmd));
     memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
+
+    /* Don't interleave with a command of the I/O thread */
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
     viewer_status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
     if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
         viewer_handle_send_status(viewer_status, "get metadata command");
@@ -1293,49 +1310,56 @@ static void lttng_live_need_new_streams(struct lttng_live_msg_iter *lttng_live_m
     }
 }
 
+/*
+ * Returns the I/O thread of the viewer connection of
+ * `lttng_live_msg_iter`, starting it if needed.
+ */
+static LiveViewerIoThread& viewer_io_thread(struct lttng_live_msg_iter *lttng_live_msg_iter)
+{
+    live_viewer_connection& viewer_connection = *lttng_live_msg_iter->viewer_connection;
+
+    if (!viewer_connection.io_thread) {
+        viewer_connection.io_thread = bt2s::make_unique<LiveViewerIoThread>(
+            viewer_connection, lttng_live_msg_iter->lttng_live_comp->max_query_size);
+    }
+
+    return *viewer_connection.io_thread;
+}
+
+/*
+ * Appends an error cause for the failure of the I/O thread of
+ * `viewer_connection` and closes its socket.
+ */
+static void viewer_handle_io_thread_error(struct live_viewer_connection *viewer_connection)
+{
+    BT_CPPLOGE_APPEND_CAUSE_SPEC(viewer_connection->logger, "Viewer connection I/O thread failed: {}",
+                                 viewer_connection->io_thread->error());
+
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
+    viewer_connection_close_socket(viewer_connection);
+}
+
 enum lttng_live_iterator_status
 lttng_live_get_next_index(struct lttng_live_msg_iter *lttng_live_msg_iter,
                           struct lttng_live_stream_iterator *stream, struct packet_index *index)
 {
-    struct lttng_viewer_cmd cmd;
-    struct lttng_viewer_get_next_index rq;
-    enum lttng_live_viewer_status viewer_status;
     struct lttng_viewer_index rp;
     live_viewer_connection *viewer_connection = lttng_live_msg_iter->viewer_connection.get();
     struct lttng_live_trace *trace = stream->trace;
-    const size_t cmd_buf_len = sizeof(cmd) + sizeof(rq);
-    char cmd_buf[cmd_buf_len];
     uint32_t flags, rp_status;
 
-    BT_CPPLOGD_SPEC(viewer_connection->logger,
-                    "Requesting next index for stream: cmd={}, "
-                    "viewer-stream-id={}",
-                    LTTNG_VIEWER_GET_NEXT_INDEX, stream->viewer_stream_id);
-    cmd.cmd = htobe32(LTTNG_VIEWER_GET_NEXT_INDEX);
-    cmd.data_size = htobe64((uint64_t) sizeof(rq));
-    cmd.cmd_version = htobe32(0);
-
-    memset(&rq, 0, sizeof(rq));
-    rq.stream_id = htobe64(stream->viewer_stream_id);
-
-    /*
-     * Merge the cmd and connection request to prevent a write-write
-     * sequence on the TCP socket. Otherwise, a delayed ACK will prevent the
-     * second write to be performed quickly in presence of Nagle's algorithm.
-     */
-    memcpy(cmd_buf, &cmd, sizeof(cmd));
-    memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
-
-    viewer_status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
-    if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
-        viewer_handle_send_status(viewer_status, "get next index command");
-        return viewer_status_to_live_iterator_status(viewer_status);
-    }
-
-    viewer_status = lttng_live_recv(viewer_connection, &rp, sizeof(rp));
-    if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
-        viewer_handle_recv_status(viewer_status, "get next index reply");
-        return viewer_status_to_live_iterator_status(viewer_status);
+    switch (viewer_io_thread(lttng_live_msg_iter).takeNextIndex(stream->viewer_stream_id, rp)) {
+    case LiveViewerIoThread::Status::READY:
+        break;
+    case LiveViewerIoThread::Status::NOT_READY:
+        BT_CPPLOGD_SPEC(viewer_connection->logger,
+                        "Next index for stream not received yet: viewer-stream-id={}",
+                        stream->viewer_stream_id);
+        return LTTNG_LIVE_ITERATOR_STATUS_AGAIN;
+    case LiveViewerIoThread::Status::ERROR:
+        viewer_handle_io_thread_error(viewer_connection);
+        return LTTNG_LIVE_ITERATOR_STATUS_ERROR;
     }
 
     flags = be32toh(rp.flags);
@@ -1418,115 +1442,128 @@ lttng_live_get_next_index(struct lttng_live_msg_iter *lttng_live_msg_iter,
     }
 }
 
-lttng_live_get_stream_bytes_status
-lttng_live_get_stream_bytes(struct lttng_live_msg_iter *lttng_live_msg_iter,
-                            struct lttng_live_stream_iterator *stream, uint8_t *buf,
-                            uint64_t offset, uint64_t req_len, uint64_t *recv_len)
+/*
+ * Handles the reply `rp` of one `LTTNG_VIEWER_GET_PACKET` command,
+ * returning the result of the command.
+ *
+ * Only appends an error cause for an error reply if `report_errors`
+ * is true.
+ */
+static lttng_live_get_stream_bytes_status
+lttng_live_handle_get_packet_reply(struct lttng_live_msg_iter *lttng_live_msg_iter,
+                                   struct lttng_live_stream_iterator *stream,
+                                   const LiveViewerIoThread::GetPacketReply& rp, bool report_errors)
 {
-    enum lttng_live_viewer_status viewer_status;
-    struct lttng_viewer_trace_packet rp;
-    struct lttng_viewer_cmd cmd;
-    struct lttng_viewer_get_packet rq;
     live_viewer_connection *viewer_connection = lttng_live_msg_iter->viewer_connection.get();
     struct lttng_live_trace *trace = stream->trace;
-    const size_t cmd_buf_len = sizeof(cmd) + sizeof(rq);
-    char cmd_buf[cmd_buf_len];
-    uint32_t flags, rp_status;
-
-    BT_CPPLOGD_SPEC(viewer_connection->logger,
-                    "Requesting data from stream: cmd={}, "
-                    "offset={}, request-len={}",
-                    LTTNG_VIEWER_GET_PACKET, offset, req_len);
-
-    cmd.cmd = htobe32(LTTNG_VIEWER_GET_PACKET);
-    cmd.data_size = htobe64((uint64_t) sizeof(rq));
-    cmd.cmd_version = htobe32(0);
-
-    memset(&rq, 0, sizeof(rq));
-    rq.stream_id = htobe64(stream->viewer_stream_id);
-    rq.offset = htobe64(offset);
-    rq.len = htobe32(req_len);
-
-    /*
-     * Merge the cmd and connection request to prevent a write-write
-     * sequence on the TCP socket. Otherwise, a delayed ACK will prevent the
-     * second write to be performed quickly in presence of Nagle's algorithm.
-     */
-    memcpy(cmd_buf, &cmd, sizeof(cmd));
-    memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
-
-    viewer_status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
-    if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
-        viewer_handle_send_status(viewer_status, "get data packet command");
-        return viewer_status_to_lttng_live_get_stream_bytes_status(viewer_status);
-    }
-
-    viewer_status = lttng_live_recv(viewer_connection, &rp, sizeof(rp));
-    if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
-        viewer_handle_recv_status(viewer_status, "get data packet reply");
-        return viewer_status_to_lttng_live_get_stream_bytes_status(viewer_status);
-    }
-
-    flags = be32toh(rp.flags);
-    rp_status = be32toh(rp.status);
 
     BT_CPPLOGD_SPEC(
         viewer_connection->logger, "Received response from relay daemon: cmd={}, response={}",
-        LTTNG_VIEWER_GET_PACKET, static_cast<lttng_viewer_get_packet_return_code>(rp_status));
-    switch (rp_status) {
+        LTTNG_VIEWER_GET_PACKET, static_cast<lttng_viewer_get_packet_return_code>(rp.status));
+    switch (rp.status) {
     case LTTNG_VIEWER_GET_PACKET_OK:
-        req_len = be32toh(rp.len);
         BT_CPPLOGD_SPEC(viewer_connection->logger,
                         "Got packet from relay daemon: response={}, packet-len={}",
-                        static_cast<lttng_viewer_get_packet_return_code>(rp_status), req_len);
-        break;
+                        static_cast<lttng_viewer_get_packet_return_code>(rp.status), rp.len);
+
+        if (rp.len == 0) {
+            return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_ERROR;
+        }
+
+        return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK;
     case LTTNG_VIEWER_GET_PACKET_RETRY:
         /* Unimplemented by relay daemon */
         return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_AGAIN;
     case LTTNG_VIEWER_GET_PACKET_ERR:
-        if (flags & LTTNG_VIEWER_FLAG_NEW_METADATA) {
+        if (rp.flags & LTTNG_VIEWER_FLAG_NEW_METADATA) {
             BT_CPPLOGD_SPEC(viewer_connection->logger,
                             "Marking trace as needing new metadata: "
                             "response={}, response-flag=NEW_METADATA, trace-id={}",
-                            static_cast<lttng_viewer_get_packet_return_code>(rp_status), trace->id);
+                            static_cast<lttng_viewer_get_packet_return_code>(rp.status), trace->id);
             trace->metadata_stream_state = LTTNG_LIVE_METADATA_STREAM_STATE_NEEDED;
         }
-        if (flags & LTTNG_VIEWER_FLAG_NEW_STREAM) {
+        if (rp.flags & LTTNG_VIEWER_FLAG_NEW_STREAM) {
             BT_CPPLOGD_SPEC(viewer_connection->logger,
                             "Marking all sessions as possibly needing new streams: "
                             "response={}, response-flag=NEW_STREAM",
-                            static_cast<lttng_viewer_get_packet_return_code>(rp_status));
+                            static_cast<lttng_viewer_get_packet_return_code>(rp.status));
             lttng_live_need_new_streams(lttng_live_msg_iter);
         }
-        if (flags & (LTTNG_VIEWER_FLAG_NEW_METADATA | LTTNG_VIEWER_FLAG_NEW_STREAM)) {
+        if (rp.flags & (LTTNG_VIEWER_FLAG_NEW_METADATA | LTTNG_VIEWER_FLAG_NEW_STREAM)) {
             BT_CPPLOGD_SPEC(viewer_connection->logger,
                             "Reply with any one flags set means we should retry: response={}",
-                            static_cast<lttng_viewer_get_packet_return_code>(rp_status));
+                            static_cast<lttng_viewer_get_packet_return_code>(rp.status));
             return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_AGAIN;
         }
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(viewer_connection->logger,
-                                     "Received get_data_packet response: error");
+        if (report_errors) {
+            BT_CPPLOGE_APPEND_CAUSE_SPEC(viewer_connection->logger,
+                                         "Received get_data_packet response: error");
+        } else {
+            BT_CPPLOGD_SPEC(viewer_connection->logger, "Received get_data_packet response: error");
+        }
         return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_ERROR;
     case LTTNG_VIEWER_GET_PACKET_EOF:
         return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_EOF;
     default:
-        BT_CPPLOGE_APPEND_CAUSE_SPEC(viewer_connection->logger,
-                                     "Received get_data_packet response: unknown ({})", rp_status);
-        return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_ERROR;
+        /* The I/O thread fails on an unknown reply */
+        bt_common_abort();
     }
+}
 
-    if (req_len == 0) {
+lttng_live_get_stream_bytes_status
+lttng_live_get_stream_bytes(struct lttng_live_msg_iter *lttng_live_msg_iter,
+                            struct lttng_live_stream_iterator *stream, uint64_t offset,
+                            uint64_t req_len, uint64_t next_len, const uint8_t **buf,
+                            uint64_t *recv_len)
+{
+    lttng_live_get_stream_bytes_status status = LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK;
+    live_viewer_connection *viewer_connection = lttng_live_msg_iter->viewer_connection.get();
+    const uint64_t chunk_len = lttng_live_msg_iter->lttng_live_comp->max_query_size;
+    const LiveViewerIoThread::StreamBytes *bytes;
+    uint64_t total_recv_len = 0;
+
+    BT_ASSERT(req_len > 0);
+
+    switch (viewer_io_thread(lttng_live_msg_iter)
+                .takeStreamBytes(stream->viewer_stream_id, offset, req_len, next_len, bytes)) {
+    case LiveViewerIoThread::Status::READY:
+        break;
+    case LiveViewerIoThread::Status::NOT_READY:
+        BT_CPPLOGD_SPEC(viewer_connection->logger,
+                        "Data from stream not received yet: viewer-stream-id={}, "
+                        "offset={}, request-len={}",
+                        stream->viewer_stream_id, offset, req_len);
+        return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_AGAIN;
+    case LiveViewerIoThread::Status::ERROR:
+        viewer_handle_io_thread_error(viewer_connection);
         return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_ERROR;
     }
 
-    viewer_status = lttng_live_recv(viewer_connection, buf, req_len);
-    if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
-        viewer_handle_recv_status(viewer_status, "get data packet");
-        return viewer_status_to_lttng_live_get_stream_bytes_status(viewer_status);
+    for (uint64_t i = 0; i < bytes->replies.size(); ++i) {
+        const LiveViewerIoThread::GetPacketReply& rp = bytes->replies[i];
+        const uint64_t this_offset = i * chunk_len;
+        const lttng_live_get_stream_bytes_status this_status =
+            lttng_live_handle_get_packet_reply(lttng_live_msg_iter, stream, rp, i == 0);
+
+        if (i == 0) {
+            status = this_status;
+        }
+
+        /*
+         * Only keep the data which directly follows the previous one.
+         */
+        if (this_status == LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK &&
+            total_recv_len == this_offset) {
+            total_recv_len += rp.len;
+        }
+    }
+
+    if (status == LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK) {
+        *buf = bytes->data.data();
+        *recv_len = total_recv_len;
     }
-    *recv_len = req_len;
 
-    return LTTNG_LIVE_GET_STREAM_BYTES_STATUS_OK;
+    return status;
 }
 
 /*
@@ -1568,6 +1605,9 @@ lttng_live_session_get_new_streams(struct lttng_live_session *session)
     memcpy(cmd_buf, &cmd, sizeof(cmd));
     memcpy(cmd_buf + sizeof(cmd), &rq, sizeof(rq));
 
+    /* Don't interleave with a command of the I/O thread */
+    std::lock_guard<std::mutex> sockLock {viewer_connection->sock_mutex};
+
     viewer_status = lttng_live_send(viewer_connection, &cmd_buf, cmd_buf_len);
     if (viewer_status != LTTNG_LIVE_VIEWER_STATUS_OK) {
         viewer_handle_send_status(viewer_status, "get new streams command");
@@ -1656,7 +1696,385 @@ live_viewer_connection::~live_viewer_connection()
 {
     BT_CPPLOGD_SPEC(this->logger, "Closing connection to relay: relay-url=\"{}\"", this->url);
 
+    /* Stop the I/O thread before it loses its socket */
+    this->io_thread.reset();
     viewer_connection_close_socket(this);
 
     bt_socket_fini();
 }
+
+LiveViewerIoThread::LiveViewerIoThread(live_viewer_connection& viewerConnection,
+                                       const uint64_t chunkLen) :
+    _mViewerConnection {&viewerConnection},
+    _mChunkLen {chunkLen}, _mLogger {viewerConnection.logger, "PLUGIN/SRC.CTF.LTTNG-LIVE/VIEWER-IO"}
+{
+    BT_ASSERT(chunkLen > 0);
+    BT_CPPLOGI_SPEC(_mLogger, "Starting viewer connection I/O thread: relay-url=\"{}\"",
+                    viewerConnection.url);
+    _mThread = std::thread {&LiveViewerIoThread::_loop, this};
+}
+
+LiveViewerIoThread::~LiveViewerIoThread()
+{
+    {
+        std::lock_guard<std::mutex> lock {_mMutex};
+
+        _mStop = true;
+    }
+
+    _mCond.notify_one();
+
+    /* Unblock a pending send or receive */
+    if (_mViewerConnection->control_sock != BT_INVALID_SOCKET) {
+        shutdown(_mViewerConnection->control_sock, BT_SHUT_RDWR);
+    }
+
+    _mThread.join();
+}
+
+LiveViewerIoThread::Status LiveViewerIoThread::takeNextIndex(const uint64_t viewerStreamId,
+                                                             lttng_viewer_index& index)
+{
+    std::lock_guard<std::mutex> lock {_mMutex};
+
+    if (_mFailed) {
+        return Status::ERROR;
+    }
+
+    auto& stream = _mStreams[viewerStreamId];
+
+    switch (stream.indexState) {
+    case _ReqState::READY:
+        index = stream.index;
+        stream.indexState = _ReqState::NONE;
+        return Status::READY;
+    case _ReqState::NONE:
+        this->_queueIndex(viewerStreamId, stream);
+        break;
+    case _ReqState::QUEUED:
+        break;
+    }
+
+    return Status::NOT_READY;
+}
+
+LiveViewerIoThread::Status
+LiveViewerIoThread::takeStreamBytes(const uint64_t viewerStreamId, const uint64_t offset,
+                                    const uint64_t len, const uint64_t nextLen,
+                                    const StreamBytes *& bytes)
+{
+    std::lock_guard<std::mutex> lock {_mMutex};
+
+    if (_mFailed) {
+        return Status::ERROR;
+    }
+
+    auto& stream = _mStreams[viewerStreamId];
+
+    if (stream.bytesState == _ReqState::READY) {
+        if (stream.bytesOffset == offset && stream.bytesLen == len) {
+            stream.takenBytes.replies.swap(stream.bytes.replies);
+            stream.takenBytes.data.swap(stream.bytes.data);
+            stream.bytesState = _ReqState::NONE;
+            bytes = &stream.takenBytes;
+
+            /* Read ahead */
+            if (nextLen > 0) {
+                this->_queueBytes(viewerStreamId, stream, offset + len, nextLen);
+            } else if (stream.indexState == _ReqState::NONE) {
+                this->_queueIndex(viewerStreamId, stream);
+            }
+
+            return Status::READY;
+        }
+
+        /* Read ahead for nothing */
+        BT_CPPLOGD_SPEC(_mLogger,
+                        "Discarding unexpected prefetched stream bytes: viewer-stream-id={}, "
+                        "offset={}, len={}, expected-offset={}, expected-len={}",
+                        viewerStreamId, stream.bytesOffset, stream.bytesLen, offset, len);
+        stream.bytesState = _ReqState::NONE;
+    }
+
+    if (stream.bytesState == _ReqState::NONE) {
+        this->_queueBytes(viewerStreamId, stream, offset, len);
+    }
+
+    return Status::NOT_READY;
+}
+
+void LiveViewerIoThread::forgetStream(const uint64_t viewerStreamId)
+{
+    std::lock_guard<std::mutex> lock {_mMutex};
+
+    _mStreams.erase(viewerStreamId);
+    _mReqs.erase(std::remove_if(_mReqs.begin(), _mReqs.end(),
+                                [viewerStreamId](const _Req& req) {
+                                    return req.viewerStreamId == viewerStreamId;
+                                }),
+                 _mReqs.end());
+}
+
+std::string LiveViewerIoThread::error()
+{
+    std::lock_guard<std::mutex> lock {_mMutex};
+
+    return _mError;
+}
+
+void LiveViewerIoThread::_queueBytes(const uint64_t viewerStreamId, _Stream& stream,
+                                     const uint64_t offset, const uint64_t len)
+{
+    BT_ASSERT(stream.bytesState != _ReqState::QUEUED);
+    stream.bytesState = _ReqState::QUEUED;
+    stream.bytesOffset = offset;
+    stream.bytesLen = len;
+    _mReqs.push_back(_Req {viewerStreamId, false, offset, len});
+    _mCond.notify_one();
+}
+
+void LiveViewerIoThread::_queueIndex(const uint64_t viewerStreamId, _Stream& stream)
+{
+    BT_ASSERT(stream.indexState == _ReqState::NONE);
+    stream.indexState = _ReqState::QUEUED;
+    _mReqs.push_back(_Req {viewerStreamId, true, 0, 0});
+    _mCond.notify_one();
+}
+
+void LiveViewerIoThread::_loop()
+{
+    while (true) {
+        _Req req;
+
+        {
+            std::unique_lock<std::mutex> lock {_mMutex};
+
+            _mCond.wait(lock, [this] {
+                return _mStop || !_mReqs.empty();
+            });
+
+            if (_mStop) {
+                return;
+            }
+
+            req = _mReqs.front();
+            _mReqs.pop_front();
+        }
+
+        lttng_viewer_index index;
+        bool ok;
+
+        {
+            std::lock_guard<std::mutex> sockLock {_mViewerConnection->sock_mutex};
+
+            ok = req.isIndex ? this->_execGetNextIndex(req, index) :
+                               this->_execGetPackets(req, _mRecvBytes);
+        }
+
+        std::lock_guard<std::mutex> lock {_mMutex};
+
+        if (!ok) {
+            if (!_mStop) {
+                BT_CPPLOGE_SPEC(_mLogger, "Viewer connection I/O thread failed: {}", _mError);
+            }
+
+            _mFailed = true;
+            return;
+        }
+
+        const auto it = _mStreams.find(req.viewerStreamId);
+
+        if (it == _mStreams.end()) {
+            /* Forgotten meanwhile */
+            continue;
+        }
+
+        auto& stream = it->second;
+
+        if (req.isIndex) {
+            stream.index = index;
+            stream.indexState = _ReqState::READY;
+
+            if (be32toh(index.status) == LTTNG_VIEWER_INDEX_OK &&
+                stream.bytesState != _ReqState::QUEUED) {
+                /* Read ahead the beginning of the packet */
+                const uint64_t len =
+                    std::min(be64toh(index.packet_size) / 8,
+                             _mChunkLen * LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT);
+
+                if (len > 0) {
+                    this->_queueBytes(req.viewerStreamId, stream, be64toh(index.offset), len);
+                }
+            }
+        } else {
+            stream.bytes.replies.swap(_mRecvBytes.replies);
+            stream.bytes.data.swap(_mRecvBytes.data);
+            stream.bytesState = _ReqState::READY;
+        }
+    }
+}
+
+bool LiveViewerIoThread::_execGetNextIndex(const _Req& req, lttng_viewer_index& index)
+{
+    struct lttng_viewer_cmd cmd;
+    struct lttng_viewer_get_next_index rq;
+    char cmdBuf[sizeof(cmd) + sizeof(rq)];
+
+    BT_CPPLOGD_SPEC(_mLogger,
+                    "Requesting next index for stream: cmd={}, "
+                    "viewer-stream-id={}",
+                    LTTNG_VIEWER_GET_NEXT_INDEX, req.viewerStreamId);
+    cmd.cmd = htobe32(LTTNG_VIEWER_GET_NEXT_INDEX);
+    cmd.data_size = htobe64((uint64_t) sizeof(rq));
+    cmd.cmd_version = htobe32(0);
+
+    memset(&rq, 0, sizeof(rq));
+    rq.stream_id = htobe64(req.viewerStreamId);
+
+    /*
+     * Merge the cmd and connection request to prevent a write-write
+     * sequence on the TCP socket. Otherwise, a delayed ACK will prevent the
+     * second write to be performed quickly in presence of Nagle's algorithm.
+     */
+    memcpy(cmdBuf, &cmd, sizeof(cmd));
+    memcpy(cmdBuf + sizeof(cmd), &rq, sizeof(rq));
+    return this->_send(cmdBuf, sizeof(cmdBuf)) && this->_recv(&index, sizeof(index));
+}
+
+bool LiveViewerIoThread::_execGetPackets(const _Req& req, StreamBytes& bytes)
+{
+    const uint64_t chunkCount = (req.len + _mChunkLen - 1) / _mChunkLen;
+    const size_t cmdLen = sizeof(struct lttng_viewer_cmd) + sizeof(struct lttng_viewer_get_packet);
+    std::vector<char> cmdBuf(chunkCount * cmdLen);
+
+    BT_ASSERT(req.len > 0);
+    BT_ASSERT(chunkCount <= LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT);
+
+    BT_CPPLOGD_SPEC(_mLogger,
+                    "Requesting data from stream: cmd={}, viewer-stream-id={}, "
+                    "offset={}, request-len={}, request-count={}",
+                    LTTNG_VIEWER_GET_PACKET, req.viewerStreamId, req.offset, req.len, chunkCount);
+
+    /*
+     * Send one command per chunk of at most `_mChunkLen` bytes at once,
+     * then receive the replies in order, so as to pay the round-trip
+     * time to the relay daemon only once.
+     */
+    for (uint64_t i = 0; i < chunkCount; ++i) {
+        struct lttng_viewer_cmd cmd;
+        struct lttng_viewer_get_packet rq;
+        const uint64_t thisOffset = i * _mChunkLen;
+
+        cmd.cmd = htobe32(LTTNG_VIEWER_GET_PACKET);
+        cmd.data_size = htobe64((uint64_t) sizeof(rq));
+        cmd.cmd_version = htobe32(0);
+
+        memset(&rq, 0, sizeof(rq));
+        rq.stream_id = htobe64(req.viewerStreamId);
+        rq.offset = htobe64(req.offset + thisOffset);
+        rq.len = htobe32(std::min(_mChunkLen, req.len - thisOffset));
+
+        memcpy(&cmdBuf[i * cmdLen], &cmd, sizeof(cmd));
+        memcpy(&cmdBuf[i * cmdLen + sizeof(cmd)], &rq, sizeof(rq));
+    }
+
+    if (!this->_send(cmdBuf.data(), cmdBuf.size())) {
+        return false;
+    }
+
+    bytes.replies.clear();
+    bytes.data.resize(req.len);
+
+    /* Always receive all the replies to keep the connection in sync */
+    for (uint64_t i = 0; i < chunkCount; ++i) {
+        const uint64_t thisOffset = i * _mChunkLen;
+        const uint64_t thisReqLen = std::min(_mChunkLen, req.len - thisOffset);
+        struct lttng_viewer_trace_packet rp;
+
+        if (!this->_recv(&rp, sizeof(rp))) {
+            return false;
+        }
+
+        const GetPacketReply reply {be32toh(rp.status), be32toh(rp.len), be32toh(rp.flags)};
+
+        switch (reply.status) {
+        case LTTNG_VIEWER_GET_PACKET_OK:
+            if (reply.len > thisReqLen) {
+                _mError = fmt::format("Received get_data_packet response: too much data: "
+                                      "packet-len={}, request-len={}",
+                                      reply.len, thisReqLen);
+                return false;
+            }
+
+            if (reply.len > 0 && !this->_recv(&bytes.data[thisOffset], reply.len)) {
+                return false;
+            }
+
+            break;
+        case LTTNG_VIEWER_GET_PACKET_RETRY:
+        case LTTNG_VIEWER_GET_PACKET_ERR:
+        case LTTNG_VIEWER_GET_PACKET_EOF:
+            break;
+        default:
+            /* Can't know what follows: give up on this connection */
+            _mError =
+                fmt::format("Received get_data_packet response: unknown ({})", reply.status);
+            return false;
+        }
+
+        bytes.replies.push_back(reply);
+    }
+
+    return true;
+}
+
+bool LiveViewerIoThread::_send(const void * const buf, const size_t len)
+{
+    const BT_SOCKET sock = _mViewerConnection->control_sock;
+    size_t totalSent = 0;
+
+    while (totalSent < len) {
+        const ssize_t sent =
+            bt_socket_send_nosigpipe(sock, (const char *) buf + totalSent, len - totalSent);
+
+        if (sent == BT_SOCKET_ERROR) {
+            if (bt_socket_interrupted()) {
+                continue;
+            }
+
+            _mError = fmt::format("Error sending to Relay: {}", bt_socket_errormsg());
+            return false;
+        }
+
+        totalSent += sent;
+    }
+
+    return true;
+}
+
+bool LiveViewerIoThread::_recv(void * const buf, const size_t len)
+{
+    const BT_SOCKET sock = _mViewerConnection->control_sock;
+    size_t totalReceived = 0;
+
+    while (totalReceived < len) {
+        const ssize_t received =
+            bt_socket_recv(sock, (char *) buf + totalReceived, len - totalReceived, 0);
+
+        if (received == BT_SOCKET_ERROR) {
+            if (bt_socket_interrupted()) {
+                continue;
+            }
+
+            _mError = fmt::format("Error receiving from Relay: {}", bt_socket_errormsg());
+            return false;
+        } else if (received == 0) {
+            _mError = "Remote side has closed connection";
+            return false;
+        }
+
+        totalReceived += received;
+    }
+
+    return true;
+}
@@ -7,8 +7,14 @@
 #ifndef BABELTRACE_PLUGINS_CTF_LTTNG_LIVE_VIEWER_CONNECTION_HPP
 #define BABELTRACE_PLUGINS_CTF_LTTNG_LIVE_VIEWER_CONNECTION_HPP
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include <glib.h>
 #include <stdint.h>
@@ -20,11 +26,20 @@
 #include "cpp-common/bt2c/glib-up.hpp"
 #include "cpp-common/bt2c/logging.hpp"
 
+#include "lttng-viewer-abi.hpp"
+
 #define LTTNG_DEFAULT_NETWORK_VIEWER_PORT 5344
 
 #define LTTNG_LIVE_MAJOR    2
 #define LTTNG_LIVE_MINOR_15 15
 
+/*
+ * Maximum number of `LTTNG_VIEWER_GET_PACKET` commands which the I/O
+ * thread sends for a single lttng_live_get_stream_bytes() request
+ * before receiving the reply of the first one.
+ */
+#define LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT 4
+
 enum lttng_live_viewer_status
 {
     LTTNG_LIVE_VIEWER_STATUS_OK = 0,
@@ -50,6 +65,160 @@ enum lttng_live_get_one_metadata_status
     LTTNG_LIVE_GET_ONE_METADATA_STATUS_CLOSED = -3,
 };
 
+struct live_viewer_connection;
+
+/*
+ * I/O thread of a viewer connection which prefetches the indexes and
+ * the packet data of the data streams into per-stream buffers.
+ *
+ * The graph thread asks for the next index or for a range of bytes of
+ * a data stream: the I/O thread sends the corresponding command and
+ * receives its reply as is, and the graph thread takes it on a later
+ * call. This way, the graph thread never waits for the relay daemon
+ * to get indexes and packet data: it only interprets and decodes the
+ * buffered replies, and a slow relay daemon doesn't stall the other
+ * components of the graph.
+ *
+ * The I/O thread also reads ahead: it requests the first bytes of a
+ * packet as soon as it receives its index, and the graph thread may
+ * request the next bytes or the next index when it takes some bytes.
+ *
+ * The graph thread keeps sending the other commands itself while
+ * holding `live_viewer_connection::sock_mutex`, which the I/O thread
+ * also holds while it sends a command and receives its reply.
+ */
+class LiveViewerIoThread final
+{
+public:
+    enum class Status
+    {
+        /* Reply not received yet: try again later */
+        NOT_READY,
+
+        /* Reply received */
+        READY,
+
+        /* The I/O thread failed (see error()): the connection is lost */
+        ERROR,
+    };
+
+    /* Reply to one `LTTNG_VIEWER_GET_PACKET` command, in host byte order */
+    struct GetPacketReply
+    {
+        uint32_t status;
+        uint32_t len;
+        uint32_t flags;
+    };
+
+    /*
+     * Replies to the `LTTNG_VIEWER_GET_PACKET` commands of a range of
+     * bytes, one per chunk of at most `chunkLen` bytes, the data of the
+     * chunk `i`, if any, being at `data.data() + i * chunkLen`.
+     */
+    struct StreamBytes
+    {
+        std::vector<GetPacketReply> replies;
+        std::vector<uint8_t> data;
+    };
+
+    /*
+     * Starts an I/O thread sending commands to the relay daemon of
+     * `viewerConnection`, requesting at most `chunkLen` bytes per
+     * `LTTNG_VIEWER_GET_PACKET` command.
+     */
+    explicit LiveViewerIoThread(live_viewer_connection& viewerConnection, uint64_t chunkLen);
+
+    ~LiveViewerIoThread();
+
+    /*
+     * If the reply to the `LTTNG_VIEWER_GET_NEXT_INDEX` command for the
+     * data stream `viewerStreamId` is received, sets `index` to it and
+     * returns `Status::READY`. Otherwise, requests it, if not already
+     * done, and returns `Status::NOT_READY`.
+     */
+    Status takeNextIndex(uint64_t viewerStreamId, lttng_viewer_index& index);
+
+    /*
+     * Like takeNextIndex(), but for the `len` bytes at `offset` of the
+     * data stream `viewerStreamId`: sets `bytes` to the replies until
+     * the next call for the same data stream.
+     *
+     * When it takes the bytes, also requests the `nextLen` following
+     * bytes if `nextLen` isn't zero, or the next index otherwise.
+     */
+    Status takeStreamBytes(uint64_t viewerStreamId, uint64_t offset, uint64_t len,
+                           uint64_t nextLen, const StreamBytes *& bytes);
+
+    /* Drops the state and pending replies of the data stream `viewerStreamId` */
+    void forgetStream(uint64_t viewerStreamId);
+
+    /* Reason of the failure, once a method returned `Status::ERROR` */
+    std::string error();
+
+private:
+    enum class _ReqState
+    {
+        NONE,
+        QUEUED,
+        READY,
+    };
+
+    struct _Stream
+    {
+        _ReqState indexState = _ReqState::NONE;
+        lttng_viewer_index index;
+
+        _ReqState bytesState = _ReqState::NONE;
+        uint64_t bytesOffset = 0;
+        uint64_t bytesLen = 0;
+        StreamBytes bytes;
+
+        /* Last taken bytes: only the graph thread accesses them */
+        StreamBytes takenBytes;
+    };
+
+    struct _Req
+    {
+        uint64_t viewerStreamId;
+
+        /* `LTTNG_VIEWER_GET_NEXT_INDEX` if true, `LTTNG_VIEWER_GET_PACKET` otherwise */
+        bool isIndex;
+        uint64_t offset;
+        uint64_t len;
+    };
+
+    /* Requests the `len` bytes at `offset` for `stream`; `_mMutex` must be locked */
+    void _queueBytes(uint64_t viewerStreamId, _Stream& stream, uint64_t offset, uint64_t len);
+
+    /* Requests the next index for `stream`; `_mMutex` must be locked */
+    void _queueIndex(uint64_t viewerStreamId, _Stream& stream);
+
+    void _loop();
+
+    /* Each one returns false on failure, having set `_mError` */
+    bool _execGetNextIndex(const _Req& req, lttng_viewer_index& index);
+    bool _execGetPackets(const _Req& req, StreamBytes& bytes);
+    bool _send(const void *buf, size_t len);
+    bool _recv(void *buf, size_t len);
+
+    live_viewer_connection *_mViewerConnection;
+    uint64_t _mChunkLen;
+    bt2c::Logger _mLogger;
+
+    std::mutex _mMutex;
+    std::condition_variable _mCond;
+    std::deque<_Req> _mReqs;
+    std::unordered_map<uint64_t, _Stream> _mStreams;
+    bool _mStop = false;
+    bool _mFailed = false;
+    std::string _mError;
+
+    /* Receive buffer of the I/O thread, swapped with `_Stream::bytes` */
+    StreamBytes _mRecvBytes;
+
+    std::thread _mThread;
+};
+
 struct live_viewer_connection
 {
     using UP = std::unique_ptr<live_viewer_connection>;
@@ -73,6 +242,15 @@ struct live_viewer_connection
     BT_SOCKET control_sock {};
     int port = 0;
 
+    /*
+     * Held while sending a command and receiving its reply, as the
+     * graph thread and `io_thread` share `control_sock`.
+     */
+    std::mutex sock_mutex;
+
+    /* Created on the first index request, only for a message iterator */
+    std::unique_ptr<LiveViewerIoThread> io_thread;
+
     int32_t major = 0;
     int32_t minor = 0;
 
@@ -120,9 +298,24 @@ enum lttng_live_get_stream_bytes_status
     LTTNG_LIVE_GET_STREAM_BYTES_STATUS_EOF = __BT_FUNC_STATUS_END,
 };
 
+/*
+ * Takes at most `req_len` bytes at `offset` within the stream `stream`
+ * from the I/O thread of the viewer connection, returning
+ * `LTTNG_LIVE_GET_STREAM_BYTES_STATUS_AGAIN` if they're not received
+ * yet (see LiveViewerIoThread::takeStreamBytes() for `next_len`).
+ *
+ * `req_len` must not exceed `LTTNG_LIVE_MAX_PIPELINED_GET_PACKET_COUNT`
+ * times the maximum query size of the component: the I/O thread sends
+ * as many `LTTNG_VIEWER_GET_PACKET` commands as needed back to back.
+ *
+ * On success, sets `*buf` to the received bytes, valid until the next
+ * call for `stream`, and `*recv_len` to their number, which may be less
+ * than `req_len`.
+ */
 lttng_live_get_stream_bytes_status
 lttng_live_get_stream_bytes(struct lttng_live_msg_iter *lttng_live_msg_iter,
-                            struct lttng_live_stream_iterator *stream, uint8_t *buf,
-                            uint64_t offset, uint64_t req_len, uint64_t *recv_len);
+                            struct lttng_live_stream_iterator *stream, uint64_t offset,
+                            uint64_t req_len, uint64_t next_len, const uint8_t **buf,
+                            uint64_t *recv_len);
 
 #endif /* BABELTRACE_PLUGINS_CTF_LTTNG_LIVE_VIEWER_CONNECTION_HPP */
@@ -0,0 +1,449 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glib.h>
+
+#include <babeltrace2/babeltrace.h>
+
+#include "common/assert.h"
+#include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/bt2/integer-range-set.hpp"
+#include "cpp-common/bt2/self-message-iterator.hpp"
+#include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2/wrap.hpp"
+#include "cpp-common/bt2c/aliases.hpp"
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/make-unique.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "../common/src/metadata/metadata-stream-parser-utils.hpp"
+#include "../common/src/metadata/tsdl/ctf-meta-configure-ir-trace.hpp"
+#include "../common/src/msg-iter.hpp"
+#include "../common/src/region-medium.hpp"
+#include "mem-src.h"
+#include "mem-src.hpp"
+
+namespace {
+
+/*
+ * Region provider which calls the `next_region` and `retire_region`
+ * callbacks of the application.
+ */
+class CallbackRegionProvider final : public ctf::src::RegionMedium::Provider
+{
+public:
+    explicit CallbackRegionProvider(const bt_ctf_mem_src_cfg& cfg,
+                                    const std::uint64_t dataStreamIdx,
+                                    const bt2c::Logger& parentLogger) :
+        _mCfg {&cfg},
+        _mDataStreamIdx {dataStreamIdx}, _mLogger {parentLogger, "PLUGIN/SRC.CTF.MEM/PROVIDER"}
+    {
+    }
+
+    ctf::src::RegionMedium::NextRegionStatus
+    nextRegion(ctf::src::RegionMedium::Region& region) override;
+
+    void retireRegion(const ctf::src::RegionMedium::Region& region) noexcept override
+    {
+        const bt_ctf_mem_src_region appRegion {region.addr, region.size, region.data};
+
+        _mCfg->retire_region(_mCfg->user_data, _mDataStreamIdx, &appRegion);
+    }
+
+private:
+    const bt_ctf_mem_src_cfg *_mCfg;
+    std::uint64_t _mDataStreamIdx;
+    bt2c::Logger _mLogger;
+};
+
+ctf::src::RegionMedium::NextRegionStatus
+CallbackRegionProvider::nextRegion(ctf::src::RegionMedium::Region& region)
+{
+    bt_ctf_mem_src_region appRegion {};
+    const auto status = _mCfg->next_region(_mCfg->user_data, _mDataStreamIdx, &appRegion);
+
+    switch (status) {
+    case BT_CTF_MEM_SRC_NEXT_REGION_STATUS_OK:
+        if (!appRegion.addr || appRegion.size == 0 || appRegion.size > SIZE_MAX) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                _mLogger, bt2::Error, "Invalid region: data-stream-index={}, addr={}, size={}",
+                _mDataStreamIdx, fmt::ptr(appRegion.addr), appRegion.size);
+        }
+
+        region.addr = appRegion.addr;
+        region.size = static_cast<std::size_t>(appRegion.size);
+        region.data = appRegion.data;
+        return ctf::src::RegionMedium::NextRegionStatus::Ok;
+    case BT_CTF_MEM_SRC_NEXT_REGION_STATUS_END:
+        return ctf::src::RegionMedium::NextRegionStatus::End;
+    case BT_CTF_MEM_SRC_NEXT_REGION_STATUS_AGAIN:
+        return ctf::src::RegionMedium::NextRegionStatus::TryAgain;
+    default:
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error,
+            "Application failed to provide the next region: data-stream-index={}, status={}",
+            _mDataStreamIdx, static_cast<int>(status));
+    }
+}
+
+struct ctf_mem_component;
+
+struct ctf_mem_port_data final
+{
+    /* Weak */
+    ctf_mem_component *comp = nullptr;
+
+    /* Index of the data stream within the configuration */
+    std::uint64_t dataStreamIdx = 0;
+
+    bt2::Stream::Shared stream;
+
+    /* Whether or not a message iterator currently reads this port */
+    bool hasMsgIter = false;
+};
+
+struct ctf_mem_component final
+{
+    using UP = std::unique_ptr<ctf_mem_component>;
+
+    explicit ctf_mem_component(const bt2::SelfSourceComponent selfComp,
+                               const bt_ctf_mem_src_cfg& cfgParam) :
+        logger {selfComp, "PLUGIN/SRC.CTF.MEM/COMP"},
+        cfg(cfgParam)
+    {
+        /* Only the callbacks remain valid after the initialization */
+        cfg.metadata = nullptr;
+        cfg.metadata_size = 0;
+        cfg.data_streams = nullptr;
+    }
+
+    bt2c::Logger logger;
+
+    /* Copy of the configuration of the application */
+    bt_ctf_mem_src_cfg cfg;
+
+    ctf::src::MetadataStreamParser::ParseRet metadata;
+    bt2::Trace::Shared trace;
+    std::vector<std::unique_ptr<ctf_mem_port_data>> ports;
+};
+
+struct ctf_mem_msg_iter_data final
+{
+    using UP = std::unique_ptr<ctf_mem_msg_iter_data>;
+
+    explicit ctf_mem_msg_iter_data(const bt2::SelfMessageIterator selfMsgIterParam) :
+        selfMsgIter {selfMsgIterParam}, logger {selfMsgIter, "PLUGIN/SRC.CTF.MEM/MSG-ITER"}
+    {
+    }
+
+    ~ctf_mem_msg_iter_data()
+    {
+        /* Destroy the message iterator, which retires the regions, first */
+        msgIter.reset();
+
+        if (port_data) {
+            port_data->hasMsgIter = false;
+        }
+    }
+
+    bt2::SelfMessageIterator selfMsgIter;
+    bt2c::Logger logger;
+
+    /* Weak, belongs to ctf_mem_component */
+    ctf_mem_port_data *port_data = nullptr;
+
+    bt2s::optional<ctf::src::MsgIter> msgIter;
+
+    /*
+     * Saved error. If we hit an error in the next method, but have
+     * some messages ready to return, we save the error here and
+     * return it on the next call of the next method.
+     */
+    bt_message_iterator_class_next_method_status next_saved_status =
+        BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    const bt_error *next_saved_error = nullptr;
+};
+
+/*
+ * Validates the configuration `cfg` of the application, throwing
+ * `bt2::Error` if it's invalid.
+ */
+void validate_cfg(const bt_ctf_mem_src_cfg * const cfg, const bt2c::Logger& logger)
+{
+    if (!cfg) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            logger, bt2::Error,
+            "Missing configuration: expecting a `struct bt_ctf_mem_src_cfg` as the "
+            "initialize method data");
+    }
+
+    if (!cfg->metadata || cfg->metadata_size == 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Missing metadata stream in configuration.");
+    }
+
+    if (!cfg->data_streams || cfg->data_stream_count == 0) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Missing data streams in configuration.");
+    }
+
+    if (!cfg->next_region || !cfg->retire_region) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Missing region callbacks in configuration.");
+    }
+}
+
+bt2c::ConstBytes metadata_bytes(const bt_ctf_mem_src_cfg& cfg) noexcept
+{
+    return bt2c::ConstBytes {cfg.metadata, static_cast<std::size_t>(cfg.metadata_size)};
+}
+
+ctf_mem_component::UP ctf_mem_create(const bt2::SelfSourceComponent selfComp,
+                                     const bt_ctf_mem_src_cfg * const cfg)
+{
+    const bt2c::Logger logger {selfComp, "PLUGIN/SRC.CTF.MEM/COMP"};
+
+    validate_cfg(cfg, logger);
+
+    auto comp = bt2s::make_unique<ctf_mem_component>(selfComp, *cfg);
+
+    /* Parse the metadata stream and create the trace */
+    comp->metadata = ctf::src::parseMetadataStream(static_cast<bt2::SelfComponent>(selfComp),
+                                                   ctf::src::ClkClsCfg {},
+                                                   metadata_bytes(*cfg), logger);
+    BT_ASSERT(comp->metadata.traceCls);
+
+    if (!comp->metadata.traceCls->libCls()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Metadata stream has no trace class.");
+    }
+
+    comp->trace = comp->metadata.traceCls->libCls()->instantiate();
+    ctf_trace_class_configure_ir_trace(*comp->metadata.traceCls, *comp->trace,
+                                       selfComp.graphMipVersion(), logger);
+
+    /* Create one stream and one output port per data stream */
+    std::set<std::pair<std::uint64_t, std::uint64_t>> ids;
+
+    for (std::uint64_t i = 0; i < cfg->data_stream_count; ++i) {
+        const auto& dataStream = cfg->data_streams[i];
+        const auto dataStreamCls = (*comp->metadata.traceCls)[dataStream.class_id];
+
+        if (!dataStreamCls) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2::Error,
+                "No data stream class with this ID: data-stream-index={}, "
+                "data-stream-class-id={}",
+                i, dataStream.class_id);
+        }
+
+        if (!ids.emplace(dataStream.class_id, dataStream.id).second) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2::Error,
+                "Duplicate data stream: data-stream-index={}, data-stream-class-id={}, "
+                "data-stream-id={}",
+                i, dataStream.class_id, dataStream.id);
+        }
+
+        BT_ASSERT(dataStreamCls->libCls());
+
+        auto portData = bt2s::make_unique<ctf_mem_port_data>();
+
+        portData->comp = comp.get();
+        portData->dataStreamIdx = i;
+        portData->stream = dataStreamCls->libCls()->instantiate(*comp->trace, dataStream.id);
+
+        const auto portName = fmt::format("out{}", i);
+
+        if (bt_self_component_source_add_output_port(selfComp.libObjPtr(), portName.c_str(),
+                                                     portData.get(), nullptr) !=
+            BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Failed to add output port: name=\"{}\"",
+                                                   portName);
+        }
+
+        comp->ports.emplace_back(std::move(portData));
+    }
+
+    return comp;
+}
+
+} /* namespace */
+
+bt_component_class_get_supported_mip_versions_method_status
+ctf_mem_get_supported_mip_versions(bt_self_component_class_source *selfCompClsSrc,
+                                   const bt_value *, void * const initMethodData,
+                                   const bt_logging_level logLevel,
+                                   bt_integer_range_set_unsigned * const supportedVersionsRaw)
+{
+    try {
+        const bt2c::Logger logger {bt2::wrap(selfCompClsSrc),
+                                   static_cast<bt2::LoggingLevel>(logLevel),
+                                   "PLUGIN/SRC.CTF.MEM/COMP"};
+        const auto cfg = static_cast<const bt_ctf_mem_src_cfg *>(initMethodData);
+
+        validate_cfg(cfg, logger);
+
+        auto supportedVersions = bt2::wrap(supportedVersionsRaw);
+
+        supportedVersions.addRange(1, 1);
+
+        if (ctf::src::getMetadataStreamMajorVersion(metadata_bytes(*cfg)) ==
+            ctf::src::MetadataStreamMajorVersion::V1) {
+            supportedVersions.addRange(0, 0);
+        }
+
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_ERROR;
+    }
+}
+
+bt_component_class_initialize_method_status
+ctf_mem_init(bt_self_component_source * const selfCompSrc,
+             bt_self_component_source_configuration *, const bt_value *,
+             void * const initMethodData)
+{
+    try {
+        auto comp = ctf_mem_create(bt2::wrap(selfCompSrc),
+                                   static_cast<const bt_ctf_mem_src_cfg *>(initMethodData));
+
+        bt_self_component_set_data(bt_self_component_source_as_self_component(selfCompSrc),
+                                   comp.release());
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+    }
+}
+
+void ctf_mem_finalize(bt_self_component_source * const selfCompSrc)
+{
+    ctf_mem_component::UP {static_cast<ctf_mem_component *>(
+        bt_self_component_get_data(bt_self_component_source_as_self_component(selfCompSrc)))};
+}
+
+bt_message_iterator_class_initialize_method_status
+ctf_mem_iterator_init(bt_self_message_iterator * const selfMsgIter,
+                      bt_self_message_iterator_configuration *,
+                      bt_self_component_port_output * const selfPort)
+{
+    try {
+        const auto portData = static_cast<ctf_mem_port_data *>(bt_self_component_port_get_data(
+            bt_self_component_port_output_as_self_component_port(selfPort)));
+
+        BT_ASSERT(portData);
+
+        auto msgIterData = bt2s::make_unique<ctf_mem_msg_iter_data>(bt2::wrap(selfMsgIter));
+
+        /* The regions of a data stream are only readable once */
+        if (portData->hasMsgIter) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                msgIterData->logger, bt2::Error,
+                "Port already has a message iterator: data-stream-index={}",
+                portData->dataStreamIdx);
+        }
+
+        const auto& comp = *portData->comp;
+
+        msgIterData->msgIter.emplace(
+            msgIterData->selfMsgIter, *comp.metadata.traceCls, comp.metadata.uuid,
+            *portData->stream,
+            bt2s::make_unique<ctf::src::RegionMedium>(
+                bt2s::make_unique<CallbackRegionProvider>(comp.cfg, portData->dataStreamIdx,
+                                                          msgIterData->logger),
+                msgIterData->logger),
+            ctf::src::MsgIterQuirks {}, msgIterData->logger);
+        msgIterData->port_data = portData;
+        portData->hasMsgIter = true;
+        bt_self_message_iterator_set_data(selfMsgIter, msgIterData.release());
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+    }
+}
+
+void ctf_mem_iterator_finalize(bt_self_message_iterator * const selfMsgIter)
+{
+    ctf_mem_msg_iter_data::UP {
+        static_cast<ctf_mem_msg_iter_data *>(bt_self_message_iterator_get_data(selfMsgIter))};
+}
+
+bt_message_iterator_class_next_method_status
+ctf_mem_iterator_next(bt_self_message_iterator * const selfMsgIter,
+                      const bt_message_array_const msgs, const uint64_t capacity,
+                      uint64_t * const count)
+{
+    auto& msgIterData =
+        *static_cast<ctf_mem_msg_iter_data *>(bt_self_message_iterator_get_data(selfMsgIter));
+
+    if (G_UNLIKELY(msgIterData.next_saved_error)) {
+        /*
+         * Last time we were called, we hit an error but had some
+         * messages to deliver, so we stashed the error here. Return
+         * it now.
+         */
+        BT_CURRENT_THREAD_MOVE_ERROR_AND_RESET(msgIterData.next_saved_error);
+        return msgIterData.next_saved_status;
+    }
+
+    auto status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    uint64_t i = 0;
+
+    do {
+        try {
+            bt2::ConstMessage::Shared msg;
+
+            if (msgIterData.msgIter->tryNext(msg) == ctf::src::MsgIter::NextStatus::TryAgain) {
+                status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+            } else if (G_LIKELY(msg)) {
+                msgs[i] = msg.release().libObjPtr();
+                ++i;
+            } else {
+                status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+            }
+        } catch (const bt2::TryAgain&) {
+            /* No region within a packet or an event record yet */
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+        } catch (const bt2::Error&) {
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+        } catch (const std::bad_alloc&) {
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+        }
+    } while (i < capacity && status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK);
+
+    if (i > 0) {
+        /*
+         * Return the accumulated messages now, and the other status,
+         * if it's an error, during the next call.
+         */
+        if (status < 0) {
+            msgIterData.next_saved_error = bt_current_thread_take_error();
+            BT_ASSERT(msgIterData.next_saved_error);
+            msgIterData.next_saved_status = status;
+        }
+
+        *count = i;
+        status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    }
+
+    return status;
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_CTF_MEM_SRC_MEM_SRC_H
+#define BABELTRACE_PLUGINS_CTF_MEM_SRC_MEM_SRC_H
+
+/*
+ * Interface between a `source.ctf.mem` component and the application
+ * which owns the memory to decode.
+ *
+ * A `source.ctf.mem` component decodes CTF data streams of which the
+ * data is in memory regions which the application provides, without
+ * copying them (except the few bytes of a field which straddles two
+ * regions).
+ *
+ * To add such a component to a graph, call
+ * bt_graph_add_source_component_with_initialize_method_data() with a
+ * pointer to a `struct bt_ctf_mem_src_cfg` as the initialize method
+ * data (no parameters). Also pass this pointer as the initialize method
+ * data of the component descriptor to get the operative MIP version
+ * (CTF 2 metadata streams require MIP 1).
+ *
+ * The component has one output port per data stream, named `out0`,
+ * `out1`, and so on, in the order of `data_streams`.
+ *
+ * The component copies the callbacks and their user data: they must
+ * remain valid until the component is destroyed. It calls them from the
+ * thread which runs the graph, only while a graph method runs.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Memory region of a data stream.
+ *
+ * The regions of a data stream are contiguous: a region begins where
+ * the previous one ends. A packet may straddle two regions or more.
+ */
+struct bt_ctf_mem_src_region {
+	/* Address of the first byte */
+	const uint8_t *addr;
+
+	/* Size (bytes), greater than 0 */
+	uint64_t size;
+
+	/* Application data, not used by the component */
+	void *data;
+};
+
+/* Status of the `next_region` callback */
+enum bt_ctf_mem_src_next_region_status {
+	/* The region is set */
+	BT_CTF_MEM_SRC_NEXT_REGION_STATUS_OK = 0,
+
+	/* The data stream is ended */
+	BT_CTF_MEM_SRC_NEXT_REGION_STATUS_END = 1,
+
+	/* No region is available right now: ask again later */
+	BT_CTF_MEM_SRC_NEXT_REGION_STATUS_AGAIN = 11,
+
+	/* Application error */
+	BT_CTF_MEM_SRC_NEXT_REGION_STATUS_ERROR = -1,
+};
+
+/* Identifiers of a data stream */
+struct bt_ctf_mem_src_data_stream {
+	/* ID of the data stream class (`0` if the trace has only one) */
+	uint64_t class_id;
+
+	/* ID of the data stream */
+	uint64_t id;
+};
+
+/* Configuration of a `source.ctf.mem` component */
+struct bt_ctf_mem_src_cfg {
+	/*
+	 * Whole metadata stream (TSDL or CTF 2 JSON text sequence, not
+	 * packetized), only read during the initialization.
+	 */
+	const uint8_t *metadata;
+	uint64_t metadata_size;
+
+	/* Data streams (at least one), only read during the initialization */
+	const struct bt_ctf_mem_src_data_stream *data_streams;
+	uint64_t data_stream_count;
+
+	/*
+	 * Sets `*region` to the next region of the data stream at the
+	 * index `data_stream_index` within `data_streams`.
+	 *
+	 * The region must remain valid and unchanged until the component
+	 * passes it to `retire_region`.
+	 */
+	enum bt_ctf_mem_src_next_region_status (*next_region)(
+		void *user_data, uint64_t data_stream_index,
+		struct bt_ctf_mem_src_region *region);
+
+	/*
+	 * Called when the component doesn't need `region`, which
+	 * `next_region` returned for the data stream at the index
+	 * `data_stream_index`, anymore: the application may reuse its
+	 * memory.
+	 *
+	 * The component retires the regions of a data stream in order. It
+	 * retires all the regions which it still holds when it finalizes
+	 * the message iterator of the data stream.
+	 */
+	void (*retire_region)(void *user_data, uint64_t data_stream_index,
+		const struct bt_ctf_mem_src_region *region);
+
+	/* User data of the callbacks */
+	void *user_data;
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BABELTRACE_PLUGINS_CTF_MEM_SRC_MEM_SRC_H */
@@ -12,6 +12,8 @@
 #include "fs-src/fs.hpp"
 #include "live-src/live-src.hpp"
 #include "lttng-live/lttng-live.hpp"
+#include "mem-src/mem-src.hpp"
+#include "shm-src/shm-src.hpp"
 
 #ifndef BT_BUILT_IN_PLUGINS
 BT_PLUGIN_MODULE();
@@ -38,6 +40,8 @@ BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(fs,
                                                                         ctf_fs_iterator_finalize);
 BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHODS(
     fs, ctf_fs_iterator_seek_beginning, NULL);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_NS_FROM_ORIGIN_METHODS(
+    fs, ctf_fs_iterator_seek_ns_from_origin, ctf_fs_iterator_can_seek_ns_from_origin);
 
 /* ctf.fs sink */
 BT_PLUGIN_SINK_COMPONENT_CLASS(fs, ctf_fs_sink_consume);
@@ -82,4 +86,32 @@ BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(live,
 BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(live,
                                                                         ctf_live_iterator_finalize);
 BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHODS(
-    live, ctf_live_iterator_seek_beginning, NULL);
+    live, ctf_live_iterator_seek_beginning, ctf_live_iterator_can_seek_beginning);
+
+/* ctf.mem source */
+BT_PLUGIN_SOURCE_COMPONENT_CLASS(mem, ctf_mem_iterator_next);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_DESCRIPTION(mem, "Read CTF data streams from application memory.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_HELP(
+    mem, "See the `src/plugins/ctf/mem-src/mem-src.h` header of the Babeltrace sources.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD(
+    mem, ctf_mem_get_supported_mip_versions);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_INITIALIZE_METHOD(mem, ctf_mem_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_FINALIZE_METHOD(mem, ctf_mem_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(mem,
+                                                                          ctf_mem_iterator_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(mem,
+                                                                        ctf_mem_iterator_finalize);
+
+/* ctf.shm source */
+BT_PLUGIN_SOURCE_COMPONENT_CLASS(shm, ctf_shm_iterator_next);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_DESCRIPTION(shm, "Read CTF data streams from shared memory rings.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_HELP(
+    shm, "See the `src/plugins/ctf/shm-src/shm-ring.h` header of the Babeltrace sources.");
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD(
+    shm, ctf_shm_get_supported_mip_versions);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_INITIALIZE_METHOD(shm, ctf_shm_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_FINALIZE_METHOD(shm, ctf_shm_finalize);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD(shm,
+                                                                          ctf_shm_iterator_init);
+BT_PLUGIN_SOURCE_COMPONENT_CLASS_MESSAGE_ITERATOR_CLASS_FINALIZE_METHOD(shm,
+                                                                        ctf_shm_iterator_finalize);
@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_RING_H
+#define BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_RING_H
+
+/*
+ * Layout of a shared memory ring which a `source.ctf.shm` component
+ * consumes.
+ *
+ * A ring is a file (typically under `/dev/shm`) which contains, in
+ * order:
+ *
+ * 1. A ring header (`struct bt_ctf_shm_ring_header`).
+ *
+ * 2. At the offset `subbufs_offset`, `subbuf_count` subbuffers of
+ *    `subbuf_size` bytes each. A subbuffer begins with a subbuffer
+ *    header (`struct bt_ctf_shm_subbuf_header`) followed with
+ *    `data_size` bytes of the data stream.
+ *
+ * A ring contains the data of a single CTF data stream: its subbuffers,
+ * in production order, form a contiguous byte sequence in which a
+ * packet may straddle two subbuffers or more.
+ *
+ * All the integers are in the byte order of the host. The producer
+ * creates and initializes the file before the consumer opens it, and
+ * never changes the first cache line afterwards.
+ *
+ * The `produced` and `consumed` counters are subbuffer counts modulo
+ * 2^32: the next subbuffer which the producer fills is at the index
+ * `produced % subbuf_count`, and the next one which the consumer reads
+ * is at the index `consumed % subbuf_count`. The ring is full when
+ * `produced - consumed == subbuf_count`.
+ *
+ * Producer protocol:
+ *
+ * 1. Wait until the ring isn't full. To wait, set `producer_waiting`
+ *    to 1, issue a full memory barrier, check `consumed` again, wait
+ *    on the `consumed` futex word (not private), and then set
+ *    `producer_waiting` to 0.
+ *
+ * 2. Write the data and `data_size` of the subbuffer.
+ *
+ * 3. Increment `produced` with release semantics, issue a full memory
+ *    barrier, and then, if `consumer_waiting` is 1, wake the waiters of
+ *    the `produced` futex word.
+ *
+ * 4. To end the data stream, set `closed` to 1 with release semantics
+ *    and wake the waiters of the `produced` futex word.
+ *
+ * The consumer follows the symmetric protocol: it sets
+ * `consumer_waiting` and waits on the `produced` futex word, and it
+ * increments `consumed` once it doesn't need a subbuffer anymore, then
+ * wakes the waiters of the `consumed` futex word if `producer_waiting`
+ * is 1.
+ *
+ * Each side only writes the members of its own cache line, and never
+ * writes the data of a subbuffer which the other side owns.
+ */
+
+#include <stdint.h>
+
+/* Value of `magic` */
+#define BT_CTF_SHM_RING_MAGIC		UINT32_C(0x62747368)
+
+/* Value of `version` */
+#define BT_CTF_SHM_RING_VERSION		UINT32_C(1)
+
+/* Alignment of `subbufs_offset` and of `subbuf_size` */
+#define BT_CTF_SHM_RING_ALIGN		8
+
+struct bt_ctf_shm_ring_header {
+	/* Constant part, written once by the producer (offset 0) */
+	uint32_t magic;
+	uint32_t version;
+	uint32_t subbuf_count;
+	uint32_t subbuf_size;
+	uint64_t subbufs_offset;
+	uint64_t data_stream_class_id;
+	uint64_t data_stream_id;
+	uint8_t reserved0[24];
+
+	/* Producer side (offset 64) */
+	uint32_t produced;
+	uint32_t closed;
+	uint32_t producer_waiting;
+	uint8_t reserved1[52];
+
+	/* Consumer side (offset 128) */
+	uint32_t consumed;
+	uint32_t consumer_waiting;
+	uint8_t reserved2[56];
+};
+
+struct bt_ctf_shm_subbuf_header {
+	/*
+	 * Number of data stream bytes following this header, at most
+	 * `subbuf_size - sizeof(struct bt_ctf_shm_subbuf_header)`
+	 */
+	uint64_t data_size;
+};
+
+#endif /* BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_RING_H */
@@ -0,0 +1,710 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <fcntl.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <time.h>
+#endif
+
+#include <glib.h>
+
+#include <babeltrace2/babeltrace.h>
+
+#include "common/assert.h"
+#include "compat/mman.h"
+#include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/bt2/integer-range-set.hpp"
+#include "cpp-common/bt2/self-message-iterator.hpp"
+#include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2/value.hpp"
+#include "cpp-common/bt2/wrap.hpp"
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2c/file-utils.hpp"
+#include "cpp-common/bt2c/glib-up.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+#include "cpp-common/bt2s/make-unique.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "../common/src/metadata/metadata-stream-parser-utils.hpp"
+#include "../common/src/metadata/tsdl/ctf-meta-configure-ir-trace.hpp"
+#include "../common/src/msg-iter.hpp"
+#include "../common/src/region-medium.hpp"
+#include "shm-ring.h"
+#include "shm-src.hpp"
+
+namespace {
+
+/*
+ * Mapping of a shared memory ring (see `shm-ring.h`).
+ */
+class ShmRing final
+{
+public:
+    using UP = std::unique_ptr<ShmRing>;
+
+    explicit ShmRing(std::string path, const bt2c::Logger& parentLogger);
+    ~ShmRing();
+
+    const std::string& path() const noexcept
+    {
+        return _mPath;
+    }
+
+    bt_ctf_shm_ring_header& header() const noexcept
+    {
+        return *static_cast<bt_ctf_shm_ring_header *>(_mAddr);
+    }
+
+    /*
+     * Returns the subbuffer header of the subbuffer at the index
+     * `index % subbuf_count`.
+     */
+    bt_ctf_shm_subbuf_header& subbuf(const std::uint32_t index) const noexcept
+    {
+        const auto& hdr = this->header();
+
+        return *reinterpret_cast<bt_ctf_shm_subbuf_header *>(
+            static_cast<std::uint8_t *>(_mAddr) + hdr.subbufs_offset +
+            static_cast<unsigned long long>(index % hdr.subbuf_count) * hdr.subbuf_size);
+    }
+
+    /* Maximum number of data stream bytes of a subbuffer */
+    std::uint64_t maxDataSize() const noexcept
+    {
+        return this->header().subbuf_size - sizeof(bt_ctf_shm_subbuf_header);
+    }
+
+private:
+    void _validate(unsigned long long fileSize) const;
+
+    std::string _mPath;
+    bt2c::Logger _mLogger;
+    void *_mAddr = nullptr;
+    std::size_t _mLen = 0;
+};
+
+ShmRing::ShmRing(std::string path, const bt2c::Logger& parentLogger) :
+    _mPath {std::move(path)}, _mLogger {parentLogger, "PLUGIN/SRC.CTF.SHM/RING"}
+{
+    /*
+     * The consumer writes the members of its side of the ring header:
+     * map the file as readable and writable.
+     */
+    const auto fd = open(_mPath.c_str(), O_RDWR);
+
+    if (fd < 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW_SPEC(_mLogger, bt2::Error, "Failed to open ring",
+                                                     ": path=\"{}\"", _mPath);
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        const auto errnoSave = errno;
+
+        close(fd);
+        errno = errnoSave;
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error, "Failed to get the size of the ring", ": path=\"{}\"", _mPath);
+    }
+
+    if (static_cast<unsigned long long>(st.st_size) < sizeof(bt_ctf_shm_ring_header)) {
+        close(fd);
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error, "Ring file is too small: path=\"{}\", size={}, min-size={}",
+            _mPath, st.st_size, sizeof(bt_ctf_shm_ring_header));
+    }
+
+    _mLen = static_cast<std::size_t>(st.st_size);
+    _mAddr = bt_mmap(_mLen, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0,
+                     static_cast<int>(_mLogger.level()));
+
+    /* The mapping remains valid without the file descriptor */
+    close(fd);
+
+    if (_mAddr == MAP_FAILED) {
+        _mAddr = nullptr;
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW_SPEC(_mLogger, bt2::Error, "Failed to map ring",
+                                                     ": path=\"{}\", size={}", _mPath, _mLen);
+    }
+
+    try {
+        this->_validate(_mLen);
+    } catch (...) {
+        bt_munmap(_mAddr, _mLen);
+        throw;
+    }
+
+    BT_CPPLOGI_SPEC(_mLogger,
+                    "Mapped ring: path=\"{}\", addr={}, size={}, subbuf-count={}, "
+                    "subbuf-size={}, data-stream-class-id={}, data-stream-id={}",
+                    _mPath, fmt::ptr(_mAddr), _mLen, this->header().subbuf_count,
+                    this->header().subbuf_size, this->header().data_stream_class_id,
+                    this->header().data_stream_id);
+}
+
+ShmRing::~ShmRing()
+{
+    if (bt_munmap(_mAddr, _mLen) != 0) {
+        BT_CPPLOGE_ERRNO_SPEC(_mLogger, "Failed to unmap ring", ": path=\"{}\"", _mPath);
+    }
+}
+
+void ShmRing::_validate(const unsigned long long fileSize) const
+{
+    const auto& hdr = this->header();
+
+    if (hdr.magic != BT_CTF_SHM_RING_MAGIC) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error, "Invalid ring magic number: path=\"{}\", magic={:#x}", _mPath,
+            hdr.magic);
+    }
+
+    if (hdr.version != BT_CTF_SHM_RING_VERSION) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error,
+            "Unsupported ring layout version: path=\"{}\", version={}, expected-version={}",
+            _mPath, hdr.version, BT_CTF_SHM_RING_VERSION);
+    }
+
+    if (hdr.subbuf_count == 0 || hdr.subbuf_size <= sizeof(bt_ctf_shm_subbuf_header) ||
+        hdr.subbuf_size % BT_CTF_SHM_RING_ALIGN != 0 ||
+        hdr.subbufs_offset < sizeof(bt_ctf_shm_ring_header) ||
+        hdr.subbufs_offset % BT_CTF_SHM_RING_ALIGN != 0 || hdr.subbufs_offset > fileSize ||
+        static_cast<unsigned long long>(hdr.subbuf_count) * hdr.subbuf_size >
+            fileSize - hdr.subbufs_offset) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+            _mLogger, bt2::Error,
+            "Invalid ring geometry: path=\"{}\", file-size={}, subbufs-offset={}, "
+            "subbuf-count={}, subbuf-size={}",
+            _mPath, fileSize, hdr.subbufs_offset, hdr.subbuf_count, hdr.subbuf_size);
+    }
+}
+
+/*
+ * Waits until the futex word `*addr` isn't `val` anymore, for at most
+ * `timeout`, or until a spurious wakeup.
+ */
+void wait_futex_word(std::uint32_t * const addr, const std::uint32_t val,
+                     const std::chrono::nanoseconds timeout) noexcept
+{
+#ifdef __linux__
+    timespec ts;
+
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+
+    /* Not private: the producer is another process */
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, &ts, nullptr, 0);
+#else
+    /* No futex: poll */
+    if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) == val) {
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(timeout).count();
+
+        g_usleep(static_cast<gulong>(std::min<decltype(us)>(us, 1000)));
+    }
+#endif
+}
+
+/*
+ * Wakes all the waiters of the futex word `*addr`.
+ */
+void wake_futex_word(std::uint32_t * const addr) noexcept
+{
+#ifdef __linux__
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+#else
+    (void) addr;
+#endif
+}
+
+/*
+ * Region provider of which the regions are the data of the subbuffers
+ * of a shared memory ring.
+ *
+ * Retiring a region releases its subbuffer to the producer.
+ */
+class ShmRegionProvider final : public ctf::src::RegionMedium::Provider
+{
+public:
+    /* Maximum duration of a single wait, between interruption checks */
+    static constexpr std::chrono::milliseconds maxWaitPeriod {50};
+
+    explicit ShmRegionProvider(ShmRing& ring, const bt2::SelfMessageIterator selfMsgIter,
+                               const std::chrono::milliseconds inactivityTimeout,
+                               const bt2c::Logger& parentLogger) :
+        _mRing {&ring},
+        _mSelfMsgIter {selfMsgIter}, _mInactivityTimeout {inactivityTimeout},
+        _mLogger {parentLogger, "PLUGIN/SRC.CTF.SHM/PROVIDER"},
+        _mFetched {__atomic_load_n(&ring.header().consumed, __ATOMIC_RELAXED)},
+        _mConsumed {_mFetched}
+    {
+    }
+
+    ctf::src::RegionMedium::NextRegionStatus
+    nextRegion(ctf::src::RegionMedium::Region& region) override;
+
+    void retireRegion(const ctf::src::RegionMedium::Region&) noexcept override
+    {
+        auto& hdr = _mRing->header();
+
+        BT_ASSERT_DBG(_mConsumed != _mFetched);
+        ++_mConsumed;
+        __atomic_store_n(&hdr.consumed, _mConsumed, __ATOMIC_RELEASE);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&hdr.producer_waiting, __ATOMIC_RELAXED)) {
+            wake_futex_word(&hdr.consumed);
+        }
+    }
+
+private:
+    ShmRing *_mRing;
+    bt2::SelfMessageIterator _mSelfMsgIter;
+    std::chrono::milliseconds _mInactivityTimeout;
+    bt2c::Logger _mLogger;
+
+    /* Number of provided subbuffers, modulo 2^32 */
+    std::uint32_t _mFetched;
+
+    /* Number of retired subbuffers, modulo 2^32 */
+    std::uint32_t _mConsumed;
+};
+
+constexpr std::chrono::milliseconds ShmRegionProvider::maxWaitPeriod;
+
+ctf::src::RegionMedium::NextRegionStatus
+ShmRegionProvider::nextRegion(ctf::src::RegionMedium::Region& region)
+{
+    auto& hdr = _mRing->header();
+    const auto deadline = std::chrono::steady_clock::now() + _mInactivityTimeout;
+
+    while (true) {
+        if (__atomic_load_n(&hdr.produced, __ATOMIC_ACQUIRE) != _mFetched) {
+            /* A new subbuffer is ready */
+            auto& subbuf = _mRing->subbuf(_mFetched);
+            const auto dataSize = subbuf.data_size;
+
+            if (dataSize > _mRing->maxDataSize()) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                    _mLogger, bt2::Error,
+                    "Invalid subbuffer data size: path=\"{}\", subbuf-index={}, data-size={}, "
+                    "max-data-size={}",
+                    _mRing->path(), _mFetched % hdr.subbuf_count, dataSize,
+                    _mRing->maxDataSize());
+            }
+
+            region.addr = reinterpret_cast<const std::uint8_t *>(&subbuf + 1);
+            region.size = static_cast<std::size_t>(dataSize);
+            region.data = nullptr;
+            ++_mFetched;
+            return ctf::src::RegionMedium::NextRegionStatus::Ok;
+        }
+
+        if (__atomic_load_n(&hdr.closed, __ATOMIC_ACQUIRE)) {
+            /*
+             * The producer increments `produced` before setting
+             * `closed`: check `produced` again.
+             */
+            if (__atomic_load_n(&hdr.produced, __ATOMIC_ACQUIRE) == _mFetched) {
+                BT_CPPLOGD_SPEC(_mLogger, "Ring is closed: path=\"{}\"", _mRing->path());
+                return ctf::src::RegionMedium::NextRegionStatus::End;
+            }
+
+            continue;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+
+        if (now >= deadline || _mSelfMsgIter.isInterrupted()) {
+            return ctf::src::RegionMedium::NextRegionStatus::TryAgain;
+        }
+
+        /* Wait for the producer */
+        __atomic_store_n(&hdr.consumer_waiting, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&hdr.produced, __ATOMIC_RELAXED) == _mFetched &&
+            !__atomic_load_n(&hdr.closed, __ATOMIC_RELAXED)) {
+            wait_futex_word(&hdr.produced, _mFetched,
+                            std::min<std::chrono::nanoseconds>(maxWaitPeriod, deadline - now));
+        }
+
+        __atomic_store_n(&hdr.consumer_waiting, 0, __ATOMIC_RELAXED);
+    }
+}
+
+struct ctf_shm_component;
+
+struct ctf_shm_port_data final
+{
+    /* Weak */
+    ctf_shm_component *comp = nullptr;
+
+    ShmRing::UP ring;
+    bt2::Stream::Shared stream;
+
+    /* Whether or not a message iterator currently reads this port */
+    bool hasMsgIter = false;
+};
+
+struct ctf_shm_component final
+{
+    using UP = std::unique_ptr<ctf_shm_component>;
+
+    explicit ctf_shm_component(const bt2::SelfSourceComponent selfComp) :
+        logger {selfComp, "PLUGIN/SRC.CTF.SHM/COMP"}
+    {
+    }
+
+    bt2c::Logger logger;
+
+    /* Maximum duration of a call to the next method without new data */
+    std::chrono::milliseconds inactivityTimeout {100};
+
+    ctf::src::MetadataStreamParser::ParseRet metadata;
+    bt2::Trace::Shared trace;
+    std::vector<std::unique_ptr<ctf_shm_port_data>> ports;
+};
+
+struct ctf_shm_msg_iter_data final
+{
+    using UP = std::unique_ptr<ctf_shm_msg_iter_data>;
+
+    explicit ctf_shm_msg_iter_data(const bt2::SelfMessageIterator selfMsgIterParam) :
+        selfMsgIter {selfMsgIterParam}, logger {selfMsgIter, "PLUGIN/SRC.CTF.SHM/MSG-ITER"}
+    {
+    }
+
+    ~ctf_shm_msg_iter_data()
+    {
+        /* Destroy the message iterator, which releases the subbuffers, first */
+        msgIter.reset();
+
+        if (port_data) {
+            port_data->hasMsgIter = false;
+        }
+    }
+
+    bt2::SelfMessageIterator selfMsgIter;
+    bt2c::Logger logger;
+
+    /* Weak, belongs to ctf_shm_component */
+    ctf_shm_port_data *port_data = nullptr;
+
+    bt2s::optional<ctf::src::MsgIter> msgIter;
+
+    /*
+     * Saved error. If we hit an error in the next method, but have
+     * some messages ready to return, we save the error here and
+     * return it on the next call of the next method.
+     */
+    bt_message_iterator_class_next_method_status next_saved_status =
+        BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    const bt_error *next_saved_error = nullptr;
+};
+
+const bt_param_validation_value_descr rings_elem_descr =
+    bt_param_validation_value_descr::makeString();
+
+bt_param_validation_map_value_entry_descr shm_params_entries_descr[] = {
+    {"metadata-path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY,
+     bt_param_validation_value_descr::makeString()},
+    {"rings", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_MANDATORY,
+     bt_param_validation_value_descr::makeArray(1, BT_PARAM_VALIDATION_INFINITE,
+                                                rings_elem_descr)},
+    {"inactivity-timeout-ms", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeSignedInteger()},
+    BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
+
+/*
+ * Validates the parameters `params`, throwing `bt2::Error` if they're
+ * invalid.
+ */
+void validate_params(const bt2::ConstValue params, const bt2c::Logger& logger)
+{
+    gchar *error = NULL;
+    const auto status =
+        bt_param_validation_validate(params.libObjPtr(), shm_params_entries_descr, &error);
+
+    if (status != BT_PARAM_VALIDATION_STATUS_OK) {
+        bt2c::GCharUP errorFreer {error};
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2c::Error, "{}", error);
+    }
+}
+
+std::vector<std::uint8_t> metadata_from_params(const bt2::ConstValue params,
+                                               const bt2c::Logger& logger)
+{
+    return bt2c::dataFromFile(params["metadata-path"]->asString().value(), logger, true);
+}
+
+ctf_shm_component::UP ctf_shm_create(const bt2::SelfSourceComponent selfComp,
+                                     const bt2::ConstValue params)
+{
+    auto comp = bt2s::make_unique<ctf_shm_component>(selfComp);
+    const auto& logger = comp->logger;
+
+    validate_params(params, logger);
+
+    /* inactivity-timeout-ms parameter */
+    if (const auto inactivityTimeout = params["inactivity-timeout-ms"]) {
+        const auto val = inactivityTimeout->asSignedInteger().value();
+
+        if (val < 0) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2c::Error, "Invalid `inactivity-timeout-ms` parameter: value={}", val);
+        }
+
+        comp->inactivityTimeout = std::chrono::milliseconds {val};
+    }
+
+    /* Parse the metadata stream and create the trace */
+    comp->metadata = ctf::src::parseMetadataStream(static_cast<bt2::SelfComponent>(selfComp),
+                                                   ctf::src::ClkClsCfg {},
+                                                   metadata_from_params(params, logger), logger);
+    BT_ASSERT(comp->metadata.traceCls);
+
+    if (!comp->metadata.traceCls->libCls()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                               "Metadata stream has no trace class.");
+    }
+
+    comp->trace = comp->metadata.traceCls->libCls()->instantiate();
+    ctf_trace_class_configure_ir_trace(*comp->metadata.traceCls, *comp->trace,
+                                       selfComp.graphMipVersion(), logger);
+
+    /* Map each ring and create its stream and output port */
+    const auto rings = params["rings"]->asArray();
+    std::set<std::pair<std::uint64_t, std::uint64_t>> ids;
+
+    for (std::uint64_t i = 0; i < rings.length(); ++i) {
+        auto portData = bt2s::make_unique<ctf_shm_port_data>();
+
+        portData->comp = comp.get();
+        portData->ring =
+            bt2s::make_unique<ShmRing>(rings[i].asString().value().str(), logger);
+
+        const auto& hdr = portData->ring->header();
+        const auto dataStreamCls = (*comp->metadata.traceCls)[hdr.data_stream_class_id];
+
+        if (!dataStreamCls) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2::Error,
+                "No data stream class with the ID of the ring: path=\"{}\", "
+                "data-stream-class-id={}",
+                portData->ring->path(), hdr.data_stream_class_id);
+        }
+
+        if (!ids.emplace(hdr.data_stream_class_id, hdr.data_stream_id).second) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                logger, bt2::Error,
+                "Duplicate data stream: path=\"{}\", data-stream-class-id={}, "
+                "data-stream-id={}",
+                portData->ring->path(), hdr.data_stream_class_id, hdr.data_stream_id);
+        }
+
+        BT_ASSERT(dataStreamCls->libCls());
+        portData->stream = dataStreamCls->libCls()->instantiate(*comp->trace, hdr.data_stream_id);
+        portData->stream->name(portData->ring->path());
+
+        const auto portName = fmt::format("out{}", i);
+
+        if (bt_self_component_source_add_output_port(selfComp.libObjPtr(), portName.c_str(),
+                                                     portData.get(), nullptr) !=
+            BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(logger, bt2::Error,
+                                                   "Failed to add output port: name=\"{}\"",
+                                                   portName);
+        }
+
+        comp->ports.emplace_back(std::move(portData));
+    }
+
+    return comp;
+}
+
+} /* namespace */
+
+bt_component_class_get_supported_mip_versions_method_status
+ctf_shm_get_supported_mip_versions(bt_self_component_class_source *selfCompClsSrc,
+                                   const bt_value * const paramsRaw, void *,
+                                   const bt_logging_level logLevel,
+                                   bt_integer_range_set_unsigned * const supportedVersionsRaw)
+{
+    try {
+        const bt2c::Logger logger {bt2::wrap(selfCompClsSrc),
+                                   static_cast<bt2::LoggingLevel>(logLevel),
+                                   "PLUGIN/SRC.CTF.SHM/COMP"};
+        const auto params = bt2::wrap(paramsRaw);
+
+        validate_params(params, logger);
+
+        auto supportedVersions = bt2::wrap(supportedVersionsRaw);
+
+        supportedVersions.addRange(1, 1);
+
+        if (ctf::src::getMetadataStreamMajorVersion(metadata_from_params(params, logger)) ==
+            ctf::src::MetadataStreamMajorVersion::V1) {
+            supportedVersions.addRange(0, 0);
+        }
+
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD_STATUS_ERROR;
+    }
+}
+
+bt_component_class_initialize_method_status
+ctf_shm_init(bt_self_component_source * const selfCompSrc,
+             bt_self_component_source_configuration *, const bt_value * const params, void *)
+{
+    try {
+        auto comp = ctf_shm_create(bt2::wrap(selfCompSrc), bt2::wrap(params));
+
+        bt_self_component_set_data(bt_self_component_source_as_self_component(selfCompSrc),
+                                   comp.release());
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+    }
+}
+
+void ctf_shm_finalize(bt_self_component_source * const selfCompSrc)
+{
+    ctf_shm_component::UP {static_cast<ctf_shm_component *>(
+        bt_self_component_get_data(bt_self_component_source_as_self_component(selfCompSrc)))};
+}
+
+bt_message_iterator_class_initialize_method_status
+ctf_shm_iterator_init(bt_self_message_iterator * const selfMsgIter,
+                      bt_self_message_iterator_configuration *,
+                      bt_self_component_port_output * const selfPort)
+{
+    try {
+        const auto portData = static_cast<ctf_shm_port_data *>(bt_self_component_port_get_data(
+            bt_self_component_port_output_as_self_component_port(selfPort)));
+
+        BT_ASSERT(portData);
+
+        auto msgIterData = bt2s::make_unique<ctf_shm_msg_iter_data>(bt2::wrap(selfMsgIter));
+
+        /* A ring has a single consumer */
+        if (portData->hasMsgIter) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW_SPEC(
+                msgIterData->logger, bt2::Error,
+                "Port already has a message iterator: path=\"{}\"", portData->ring->path());
+        }
+
+        const auto& comp = *portData->comp;
+
+        msgIterData->msgIter.emplace(
+            msgIterData->selfMsgIter, *comp.metadata.traceCls, comp.metadata.uuid,
+            *portData->stream,
+            bt2s::make_unique<ctf::src::RegionMedium>(
+                bt2s::make_unique<ShmRegionProvider>(*portData->ring, msgIterData->selfMsgIter,
+                                                     comp.inactivityTimeout,
+                                                     msgIterData->logger),
+                msgIterData->logger),
+            ctf::src::MsgIterQuirks {}, msgIterData->logger);
+        msgIterData->port_data = portData;
+        portData->hasMsgIter = true;
+        bt_self_message_iterator_set_data(selfMsgIter, msgIterData.release());
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_OK;
+    } catch (const std::bad_alloc&) {
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+    } catch (const bt2::Error&) {
+        return BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+    }
+}
+
+void ctf_shm_iterator_finalize(bt_self_message_iterator * const selfMsgIter)
+{
+    ctf_shm_msg_iter_data::UP {
+        static_cast<ctf_shm_msg_iter_data *>(bt_self_message_iterator_get_data(selfMsgIter))};
+}
+
+bt_message_iterator_class_next_method_status
+ctf_shm_iterator_next(bt_self_message_iterator * const selfMsgIter,
+                      const bt_message_array_const msgs, const uint64_t capacity,
+                      uint64_t * const count)
+{
+    auto& msgIterData =
+        *static_cast<ctf_shm_msg_iter_data *>(bt_self_message_iterator_get_data(selfMsgIter));
+
+    if (G_UNLIKELY(msgIterData.next_saved_error)) {
+        /*
+         * Last time we were called, we hit an error but had some
+         * messages to deliver, so we stashed the error here. Return
+         * it now.
+         */
+        BT_CURRENT_THREAD_MOVE_ERROR_AND_RESET(msgIterData.next_saved_error);
+        return msgIterData.next_saved_status;
+    }
+
+    auto status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    uint64_t i = 0;
+
+    do {
+        try {
+            bt2::ConstMessage::Shared msg;
+
+            if (msgIterData.msgIter->tryNext(msg) == ctf::src::MsgIter::NextStatus::TryAgain) {
+                status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+            } else if (G_LIKELY(msg)) {
+                msgs[i] = msg.release().libObjPtr();
+                ++i;
+            } else {
+                status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_END;
+            }
+        } catch (const bt2::TryAgain&) {
+            /* No subbuffer within a packet or an event record yet */
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+        } catch (const bt2::Error&) {
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+        } catch (const std::bad_alloc&) {
+            status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+        }
+    } while (i < capacity && status == BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK);
+
+    if (i > 0) {
+        /*
+         * Return the accumulated messages now, and the other status,
+         * if it's an error, during the next call.
+         */
+        if (status < 0) {
+            msgIterData.next_saved_error = bt_current_thread_take_error();
+            BT_ASSERT(msgIterData.next_saved_error);
+            msgIterData.next_saved_status = status;
+        }
+
+        *count = i;
+        status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+    }
+
+    return status;
+}
@@ -0,0 +1,35 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_SRC_HPP
+#define BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_SRC_HPP
+
+#include <babeltrace2/babeltrace.h>
+
+bt_component_class_get_supported_mip_versions_method_status
+ctf_shm_get_supported_mip_versions(bt_self_component_class_source *selfCompClsSrc,
+                                   const bt_value *params, void *initMethodData,
+                                   bt_logging_level logLevel,
+                                   bt_integer_range_set_unsigned *supportedVersions);
+
+bt_component_class_initialize_method_status
+ctf_shm_init(bt_self_component_source *selfCompSrc, bt_self_component_source_configuration *config,
+             const bt_value *params, void *initMethodData);
+
+void ctf_shm_finalize(bt_self_component_source *selfCompSrc);
+
+bt_message_iterator_class_initialize_method_status
+ctf_shm_iterator_init(bt_self_message_iterator *selfMsgIter,
+                      bt_self_message_iterator_configuration *config,
+                      bt_self_component_port_output *selfPort);
+
+void ctf_shm_iterator_finalize(bt_self_message_iterator *selfMsgIter);
+
+bt_message_iterator_class_next_method_status
+ctf_shm_iterator_next(bt_self_message_iterator *selfMsgIter, bt_message_array_const msgs,
+                      uint64_t capacity, uint64_t *count);
+
+#endif /* BABELTRACE_PLUGINS_CTF_SHM_SRC_SHM_SRC_HPP */
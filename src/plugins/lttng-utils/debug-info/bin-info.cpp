@@ -10,21 +10,30 @@
 #define BT_LOG_OUTPUT_LEVEL   (bin->log_level)
 #define BT_LOG_TAG            "PLUGIN/FLT.LTTNG-UTILS.DEBUG-INFO/BIN-INFO"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <fcntl.h>
 #include <glib.h>
 #include <inttypes.h>
 #include <libgen.h>
+#include <mutex>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <thread>
 #include <unistd.h>
+#include <vector>
 
 #include "logging/comp-logging.h"
 
 #include "bin-info.hpp"
 #include "crc32.h"
 #include "dwarf.hpp"
+#include "sym-cache.hpp"
 
 /*
  * An address printed in hex is at most 20 bytes (16 for 64-bits +
@@ -34,6 +43,34 @@
 #define ADDR_STR_LEN       20
 #define BUILD_ID_NOTE_NAME "GNU"
 
+/* Maximum number of worker threads of a bin_info loader */
+#define BIN_INFO_LOADER_MAX_THREAD_COUNT 4
+
+/*
+ * Protects the fd caches of all the bin_info instances, as loader
+ * threads also use them.
+ */
+static std::mutex fd_cache_mutex;
+
+static struct bt_fd_cache_handle *bin_info_get_fd_cache_handle(struct bin_info_file *bin,
+                                                               const char *path)
+{
+    std::lock_guard<std::mutex> lock {fd_cache_mutex};
+
+    return bt_fd_cache_get_handle(bin->fd_cache, path);
+}
+
+static void bin_info_put_fd_cache_handle(struct bin_info_file *bin,
+                                         struct bt_fd_cache_handle *handle)
+{
+    std::lock_guard<std::mutex> lock {fd_cache_mutex};
+
+    bt_fd_cache_put_handle(bin->fd_cache, handle);
+}
+
+static void bin_info_wait_loaded(struct bin_info_file *bin);
+static void bin_info_file_destroy(struct bin_info_file *bin);
+
 int bin_info_init(bt_logging_level log_level, bt_self_component *self_comp)
 {
     int ret = 0;
@@ -47,12 +84,165 @@ int bin_info_init(bt_logging_level log_level, bt_self_component *self_comp)
     return ret;
 }
 
-struct bin_info *bin_info_create(struct bt_fd_cache *fdc, const char *path, uint64_t low_addr,
-                                 uint64_t memsz, bool is_pic, const char *debug_info_dir,
-                                 const char *target_prefix, bt_logging_level log_level,
+struct bin_info_file_cache
+{
+    /* Cache key (owned by the file) to weak `struct bin_info_file *` */
+    GHashTable *files;
+};
+
+struct bin_info_file_cache *bin_info_file_cache_create(void)
+{
+    struct bin_info_file_cache *cache = g_new0(struct bin_info_file_cache, 1);
+
+    cache->files = g_hash_table_new(g_str_hash, g_str_equal);
+    return cache;
+}
+
+void bin_info_file_cache_destroy(struct bin_info_file_cache *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    BT_ASSERT(g_hash_table_size(cache->files) == 0);
+    g_hash_table_destroy(cache->files);
+    g_free(cache);
+}
+
+/**
+ * Creates an unshared bin_info_file instance with a single reference.
+ *
+ * @param fdc		fd cache
+ * @param elf_path	Path of the ELF file, with the target prefix
+ * @param debug_info_dir Directory containing debug info or NULL.
+ * @param sym_cache_dir  Symbolization cache directory or NULL.
+ * @returns		New instance, or `nullptr` on failure
+ */
+static struct bin_info_file *bin_info_file_create(struct bt_fd_cache *fdc, const char *elf_path,
+                                                  const char *debug_info_dir,
+                                                  const char *sym_cache_dir,
+                                                  bt_logging_level log_level,
+                                                  bt_self_component *self_comp)
+{
+    struct bin_info_file *bin = g_new0(struct bin_info_file, 1);
+
+    if (!bin) {
+        goto error;
+    }
+
+    bin->log_level = log_level;
+    bin->self_comp = self_comp;
+    bin->ref_count = 1;
+    bin->elf_path = g_strdup(elf_path);
+    if (!bin->elf_path) {
+        goto error;
+    }
+
+    if (debug_info_dir) {
+        bin->debug_info_dir = g_strdup(debug_info_dir);
+        if (!bin->debug_info_dir) {
+            goto error;
+        }
+    }
+
+    if (sym_cache_dir) {
+        bin->sym_cache_dir = g_strdup(sym_cache_dir);
+        if (!bin->sym_cache_dir) {
+            goto error;
+        }
+    }
+
+    bin->build_id = nullptr;
+    bin->build_id_len = 0;
+    bin->file_build_id_matches = false;
+    bin->fd_cache = fdc;
+    return bin;
+
+error:
+    bin_info_file_destroy(bin);
+    return nullptr;
+}
+
+/**
+ * Returns a new reference to the bin_info_file instance of `cache`
+ * for `elf_path`, creating it if needed.
+ *
+ * The key of a file is its path and identity (device, inode,
+ * modification time, and size) so that a file replaced on disk isn't
+ * shared with the previous one. If it's impossible to get the
+ * identity of the file, the returned instance isn't shared.
+ */
+static struct bin_info_file *bin_info_file_get(struct bin_info_file_cache *cache,
+                                               struct bt_fd_cache *fdc, const char *elf_path,
+                                               const char *debug_info_dir,
+                                               const char *sym_cache_dir,
+                                               bt_logging_level log_level,
+                                               bt_self_component *self_comp)
+{
+    struct bin_info_file *bin;
+    struct stat stat_buf;
+    gchar *key;
+
+    if (!cache || stat(elf_path, &stat_buf) != 0) {
+        return bin_info_file_create(fdc, elf_path, debug_info_dir, sym_cache_dir, log_level,
+                                    self_comp);
+    }
+
+    key = g_strdup_printf("%" PRIu64 ":%" PRIu64 ":%" PRId64 ":%" PRId64 ":%s",
+                          (uint64_t) stat_buf.st_dev, (uint64_t) stat_buf.st_ino,
+                          (int64_t) stat_buf.st_mtime, (int64_t) stat_buf.st_size, elf_path);
+    bin = static_cast<bin_info_file *>(g_hash_table_lookup(cache->files, key));
+    if (bin) {
+        g_free(key);
+        ++bin->ref_count;
+        return bin;
+    }
+
+    bin = bin_info_file_create(fdc, elf_path, debug_info_dir, sym_cache_dir, log_level,
+                               self_comp);
+    if (!bin) {
+        g_free(key);
+        return nullptr;
+    }
+
+    bin->cache = cache;
+    bin->cache_key = key;
+    g_hash_table_insert(cache->files, key, bin);
+    BT_COMP_LOGD("Created shared binary file: path=\"%s\", shared-file-count=%u", elf_path,
+                 g_hash_table_size(cache->files));
+    return bin;
+}
+
+/**
+ * Releases a reference to `bin`, destroying it if it's the last one.
+ */
+static void bin_info_file_put(struct bin_info_file *bin)
+{
+    if (!bin) {
+        return;
+    }
+
+    BT_ASSERT(bin->ref_count > 0);
+
+    if (--bin->ref_count > 0) {
+        return;
+    }
+
+    if (bin->cache) {
+        g_hash_table_remove(bin->cache->files, bin->cache_key);
+    }
+
+    bin_info_file_destroy(bin);
+}
+
+struct bin_info *bin_info_create(struct bin_info_file_cache *cache, struct bt_fd_cache *fdc,
+                                 const char *path, uint64_t low_addr, uint64_t memsz, bool is_pic,
+                                 const char *debug_info_dir, const char *target_prefix,
+                                 const char *sym_cache_dir, bt_logging_level log_level,
                                  bt_self_component *self_comp)
 {
     struct bin_info *bin = nullptr;
+    gchar *elf_path = nullptr;
 
     BT_ASSERT(fdc);
 
@@ -68,34 +258,30 @@ struct bin_info *bin_info_create(struct bt_fd_cache *fdc, const char *path, uint
     bin->log_level = log_level;
     bin->self_comp = self_comp;
     if (target_prefix) {
-        bin->elf_path = g_build_filename(target_prefix, path, nullptr);
+        elf_path = g_build_filename(target_prefix, path, nullptr);
     } else {
-        bin->elf_path = g_strdup(path);
+        elf_path = g_strdup(path);
     }
 
-    if (!bin->elf_path) {
+    if (!elf_path) {
         goto error;
     }
 
-    if (debug_info_dir) {
-        bin->debug_info_dir = g_strdup(debug_info_dir);
-        if (!bin->debug_info_dir) {
-            goto error;
-        }
+    bin->file = bin_info_file_get(cache, fdc, elf_path, debug_info_dir, sym_cache_dir, log_level,
+                                  self_comp);
+    if (!bin->file) {
+        goto error;
     }
 
     bin->is_pic = is_pic;
     bin->memsz = memsz;
     bin->low_addr = low_addr;
     bin->high_addr = bin->low_addr + bin->memsz;
-    bin->build_id = nullptr;
-    bin->build_id_len = 0;
-    bin->file_build_id_matches = false;
-    bin->fd_cache = fdc;
-
+    g_free(elf_path);
     return bin;
 
 error:
+    g_free(elf_path);
     bin_info_destroy(bin);
     return nullptr;
 }
@@ -106,9 +292,75 @@ void bin_info_destroy(struct bin_info *bin)
         return;
     }
 
+    bin_info_file_put(bin->file);
+    g_free(bin);
+}
+
+/**
+ * Makes sure that `bin` is the only user of its file, replacing it
+ * with a new unshared one if needed, before changing its build ID or
+ * debug link information.
+ *
+ * @param bin	bin_info instance
+ * @returns	0 on success, -1 on failure
+ */
+static int bin_info_own_file(struct bin_info *bin)
+{
+    struct bin_info_file *file;
+
+    if (bin->file->ref_count == 1) {
+        return 0;
+    }
+
+    file = bin_info_file_create(bin->file->fd_cache, bin->file->elf_path,
+                                bin->file->debug_info_dir, bin->file->sym_cache_dir,
+                                bin->log_level, bin->self_comp);
+    if (!file) {
+        return -1;
+    }
+
+    bin_info_file_put(bin->file);
+    bin->file = file;
+    return 0;
+}
+
+static void bin_info_file_destroy(struct bin_info_file *bin)
+{
+    if (!bin) {
+        return;
+    }
+
+    /* Make sure no loader thread still uses it */
+    bin_info_wait_loaded(bin);
+
+    if (bin->elf_func_syms) {
+        g_array_free(bin->elf_func_syms, TRUE);
+    }
+
+    if (bin->dwarf_func_ranges) {
+        g_array_free(bin->dwarf_func_ranges, TRUE);
+    }
+
+    if (bin->dwarf_cus) {
+        g_ptr_array_free(bin->dwarf_cus, TRUE);
+    }
+
+    if (bin->dwarf_cu_ranges) {
+        g_array_free(bin->dwarf_cu_ranges, TRUE);
+    }
+
+    if (bin->dwarf_rangeless_cus) {
+        g_array_free(bin->dwarf_rangeless_cus, TRUE);
+    }
+
     dwarf_end(bin->dwarf_info);
 
+    if (bin->sym_cache) {
+        sym_cache_close(bin->sym_cache);
+    }
+
     g_free(bin->debug_info_dir);
+    g_free(bin->sym_cache_dir);
     g_free(bin->elf_path);
     g_free(bin->dwarf_path);
     g_free(bin->build_id);
@@ -116,9 +368,10 @@ void bin_info_destroy(struct bin_info *bin)
 
     elf_end(bin->elf_file);
 
-    bt_fd_cache_put_handle(bin->fd_cache, bin->elf_handle);
-    bt_fd_cache_put_handle(bin->fd_cache, bin->dwarf_handle);
+    bin_info_put_fd_cache_handle(bin, bin->elf_handle);
+    bin_info_put_fd_cache_handle(bin, bin->dwarf_handle);
 
+    g_free(bin->cache_key);
     g_free(bin);
 }
 
@@ -128,7 +381,7 @@ void bin_info_destroy(struct bin_info *bin)
  * @param bin	bin_info instance
  * @returns	0 on success, negative value on error.
  */
-static int bin_info_set_elf_file(struct bin_info *bin)
+static int bin_info_set_elf_file(struct bin_info_file *bin)
 {
     struct bt_fd_cache_handle *elf_handle = nullptr;
     Elf *elf_file = nullptr;
@@ -136,7 +389,7 @@ static int bin_info_set_elf_file(struct bin_info *bin)
 
     BT_ASSERT(bin);
 
-    elf_handle = bt_fd_cache_get_handle(bin->fd_cache, bin->elf_path);
+    elf_handle = bin_info_get_fd_cache_handle(bin, bin->elf_path);
     if (!elf_handle) {
         BT_COMP_LOGI("Failed to open %s", bin->elf_path);
         goto error;
@@ -160,8 +413,10 @@ static int bin_info_set_elf_file(struct bin_info *bin)
     goto end;
 
 error:
-    bt_fd_cache_put_handle(bin->fd_cache, elf_handle);
+    bin_info_put_fd_cache_handle(bin, elf_handle);
     elf_end(elf_file);
+    bin->elf_handle = nullptr;
+    bin->elf_file = nullptr;
     ret = -1;
 
 end:
@@ -261,7 +516,7 @@ end:
  *				the build id of the ondisk file.
  *				0 on if they are different or an error occurred.
  */
-static int is_build_id_matching(struct bin_info *bin)
+static int is_build_id_matching(struct bin_info_file *bin)
 {
     int ret, is_build_id, is_matching = 0;
     Elf_Scn *curr_section = nullptr, *next_section = nullptr;
@@ -327,12 +582,38 @@ error:
     return is_matching;
 }
 
-int bin_info_set_build_id(struct bin_info *bin, uint8_t *build_id, size_t build_id_len)
+/**
+ * Checks that the build ID of `bin` matches the one of the file found
+ * on the file system.
+ *
+ * @param bin	bin_info instance with a build ID
+ * @returns	0 if it matches, -1 otherwise
+ */
+static int bin_info_match_build_id(struct bin_info_file *bin)
 {
-    if (!bin || !build_id) {
-        goto error;
+    /*
+     * Check if the file found on the file system has the same build id
+     * that what was recorded in the trace.
+     */
+    bin->file_build_id_matches = is_build_id_matching(bin);
+    if (!bin->file_build_id_matches) {
+        BT_COMP_LOGI_STR("Supplied Build ID does not match Build ID of the "
+                         "binary or library found on the file system.");
+        return -1;
     }
 
+    /*
+     * Reset the is_elf_only flag in case it had been set
+     * previously, because we might find separate debug info using
+     * the new build id information.
+     */
+    bin->is_elf_only = false;
+    return 0;
+}
+
+static int bin_info_file_set_build_id(struct bin_info_file *bin, uint8_t *build_id,
+                                      size_t build_id_len)
+{
     /* Free any previously set build id. */
     g_free(bin->build_id);
 
@@ -345,36 +626,54 @@ int bin_info_set_build_id(struct bin_info *bin, uint8_t *build_id, size_t build_
     memcpy(bin->build_id, build_id, build_id_len);
     bin->build_id_len = build_id_len;
 
-    /*
-     * Check if the file found on the file system has the same build id
-     * that what was recorded in the trace.
-     */
-    bin->file_build_id_matches = is_build_id_matching(bin);
-    if (!bin->file_build_id_matches) {
-        BT_COMP_LOGI_STR("Supplied Build ID does not match Build ID of the "
-                         "binary or library found on the file system.");
-        goto error;
+    if (bin->sym_cache_dir) {
+        if (bin->sym_cache) {
+            sym_cache_close(bin->sym_cache);
+        }
+
+        bin->sym_cache = sym_cache_open(bin->sym_cache_dir, build_id, build_id_len,
+                                        bin->log_level, bin->self_comp);
     }
 
     /*
-     * Reset the is_elf_only flag in case it had been set
-     * previously, because we might find separate debug info using
-     * the new build id information.
+     * Check the build ID on first lookup which the symbolization cache
+     * doesn't satisfy (see bin_info_wait_loaded()): a loader thread
+     * may be reading the ELF file, and there's no need to read it at
+     * all if the cache knows all the addresses.
      */
+    bin->build_id_match_pending = true;
     bin->is_elf_only = false;
-
     return 0;
 
 error:
     return -1;
 }
 
-int bin_info_set_debug_link(struct bin_info *bin, const char *filename, uint32_t crc)
+int bin_info_set_build_id(struct bin_info *bin, uint8_t *build_id, size_t build_id_len)
 {
-    if (!bin || !filename) {
-        goto error;
+    if (!bin || !build_id) {
+        return -1;
+    }
+
+    if (bin->file->build_id) {
+        if (bin->file->build_id_len == build_id_len &&
+            memcmp(bin->file->build_id, build_id, build_id_len) == 0) {
+            /* Already set through another mapping of the same file */
+            return bin->file->build_id_match_pending || bin->file->file_build_id_matches ? 0 : -1;
+        }
+
+        if (bin_info_own_file(bin)) {
+            return -1;
+        }
     }
 
+    return bin_info_file_set_build_id(bin->file, build_id, build_id_len);
+}
+
+static int bin_info_file_set_debug_link(struct bin_info_file *bin, const char *filename,
+                                        uint32_t crc)
+{
+    g_free(bin->dbg_link_filename);
     bin->dbg_link_filename = g_strdup(filename);
     if (!bin->dbg_link_filename) {
         goto error;
@@ -396,6 +695,27 @@ error:
     return -1;
 }
 
+int bin_info_set_debug_link(struct bin_info *bin, const char *filename, uint32_t crc)
+{
+    if (!bin || !filename) {
+        return -1;
+    }
+
+    if (bin->file->dbg_link_filename) {
+        if (strcmp(bin->file->dbg_link_filename, filename) == 0 &&
+            bin->file->dbg_link_crc == crc) {
+            /* Already set through another mapping of the same file */
+            return 0;
+        }
+
+        if (bin_info_own_file(bin)) {
+            return -1;
+        }
+    }
+
+    return bin_info_file_set_debug_link(bin->file, filename, crc);
+}
+
 /**
  * Tries to read DWARF info from the location given by path, and
  * attach it to the given bin_info instance if it exists.
@@ -404,7 +724,7 @@ error:
  * @param path	Presumed location of the DWARF info
  * @returns	0 on success, negative value on failure
  */
-static int bin_info_set_dwarf_info_from_path(struct bin_info *bin, char *path)
+static int bin_info_set_dwarf_info_from_path(struct bin_info_file *bin, char *path)
 {
     int ret = 0;
     struct bt_fd_cache_handle *dwarf_handle = nullptr;
@@ -415,7 +735,7 @@ static int bin_info_set_dwarf_info_from_path(struct bin_info *bin, char *path)
         goto error;
     }
 
-    dwarf_handle = bt_fd_cache_get_handle(bin->fd_cache, path);
+    dwarf_handle = bin_info_get_fd_cache_handle(bin, path);
     if (!dwarf_handle) {
         goto error;
     }
@@ -451,10 +771,9 @@ static int bin_info_set_dwarf_info_from_path(struct bin_info *bin, char *path)
 
 error:
     if (bin) {
-        bt_fd_cache_put_handle(bin->fd_cache, dwarf_handle);
+        bin_info_put_fd_cache_handle(bin, dwarf_handle);
     }
     dwarf_end(dwarf_info);
-    g_free(dwarf_info);
     free(cu);
 
     return -1;
@@ -468,7 +787,7 @@ error:
  *			DWARF info via build ID
  * @returns		0 on success (i.e. dwarf_info set), -1 on failure
  */
-static int bin_info_set_dwarf_info_build_id(struct bin_info *bin)
+static int bin_info_set_dwarf_info_build_id(struct bin_info_file *bin)
 {
     int i = 0, ret = 0;
     char *path = nullptr, *build_id_prefix_dir = nullptr, *build_id_file = nullptr;
@@ -558,7 +877,7 @@ end:
  * @returns	1 if the file exists and has the correct checksum,
  *		0 otherwise
  */
-static int is_valid_debug_file(struct bin_info *bin, char *path, uint32_t crc)
+static int is_valid_debug_file(struct bin_info_file *bin, char *path, uint32_t crc)
 {
     int ret = 0;
     struct bt_fd_cache_handle *debug_handle = nullptr;
@@ -568,7 +887,7 @@ static int is_valid_debug_file(struct bin_info *bin, char *path, uint32_t crc)
         goto end;
     }
 
-    debug_handle = bt_fd_cache_get_handle(bin->fd_cache, path);
+    debug_handle = bin_info_get_fd_cache_handle(bin, path);
     if (!debug_handle) {
         goto end;
     }
@@ -582,7 +901,7 @@ static int is_valid_debug_file(struct bin_info *bin, char *path, uint32_t crc)
     ret = (crc == _crc);
 
 end:
-    bt_fd_cache_put_handle(bin->fd_cache, debug_handle);
+    bin_info_put_fd_cache_handle(bin, debug_handle);
     return ret;
 }
 
@@ -594,7 +913,7 @@ end:
  *			DWARF info via debug link
  * @returns		0 on success (i.e. dwarf_info set), -1 on failure
  */
-static int bin_info_set_dwarf_info_debug_link(struct bin_info *bin)
+static int bin_info_set_dwarf_info_debug_link(struct bin_info_file *bin)
 {
     int ret = 0;
     const gchar *dbg_dir = nullptr;
@@ -653,7 +972,7 @@ found:
  * @param bin	bin_info instance
  * @returns	0 on success, negative value on failure
  */
-static int bin_info_set_dwarf_info(struct bin_info *bin)
+static int bin_info_set_dwarf_info(struct bin_info_file *bin)
 {
     int ret = 0;
 
@@ -737,111 +1056,136 @@ error:
     return -1;
 }
 
+/*
+ * ELF function symbol of `bin_info::elf_func_syms`.
+ */
+struct bin_info_elf_func_sym
+{
+    /* Value (address) of the symbol */
+    uint64_t addr;
+
+    /* Name of the symbol (owned by the ELF file), or `nullptr` on error */
+    const char *name;
+
+    /* Order of the symbol within the ELF file */
+    guint index;
+};
+
+static gint bin_info_elf_func_sym_compare(gconstpointer a, gconstpointer b)
+{
+    const auto sym_a = static_cast<const bin_info_elf_func_sym *>(a);
+    const auto sym_b = static_cast<const bin_info_elf_func_sym *>(b);
+
+    if (sym_a->addr != sym_b->addr) {
+        return sym_a->addr < sym_b->addr ? -1 : 1;
+    }
+
+    return sym_a->index < sym_b->index ? -1 : (sym_a->index > sym_b->index);
+}
+
 /**
- * Try to find the symbol closest to an address within a given ELF
- * section.
- *
- * Only function symbols are taken into account. The symbol's address
- * must precede `addr`. A symbol with a closer address might exist
- * after `addr` but is irrelevant because it cannot encompass `addr`.
+ * Add the function symbols of a given ELF section to
+ * `bin->elf_func_syms`.
  *
- * On success, if found, the out parameters `sym` and `shdr` are
- * set. On failure or if none are found, they remain unchanged.
+ * Only symbol table (symtab) sections contain such symbols.
  *
- * @param scn		ELF section in which to look for the address
- * @param addr		Virtual memory address for which to find the
- *			nearest function symbol
- * @param sym		Out parameter, the nearest function symbol
- * @param shdr		Out parameter, the section header for scn
+ * @param bin		bin_info instance
+ * @param scn		ELF section from which to add the symbols
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_get_nearest_symbol_from_section(Elf_Scn *scn, uint64_t addr, GElf_Sym **sym,
-                                                    GElf_Shdr **shdr)
+static int bin_info_add_elf_func_syms_from_section(struct bin_info_file *bin, Elf_Scn *scn)
 {
-    int i;
     size_t symbol_count;
-    Elf_Data *data = nullptr;
-    GElf_Shdr *_shdr = nullptr;
-    GElf_Sym *nearest_sym = nullptr;
-
-    if (!scn || !sym || !shdr) {
-        goto error;
-    }
+    Elf_Data *data;
+    GElf_Shdr shdr;
 
-    _shdr = g_new0(GElf_Shdr, 1);
-    if (!_shdr) {
-        goto error;
-    }
-
-    _shdr = gelf_getshdr(scn, _shdr);
-    if (!_shdr) {
-        goto error;
+    if (!gelf_getshdr(scn, &shdr)) {
+        return -1;
     }
 
-    if (_shdr->sh_type != SHT_SYMTAB) {
+    if (shdr.sh_type != SHT_SYMTAB) {
         /*
          * We are only interested in symbol table (symtab)
          * sections, skip this one.
          */
-        goto end;
+        return 0;
     }
 
     data = elf_getdata(scn, nullptr);
     if (!data) {
-        goto error;
+        return -1;
     }
 
-    symbol_count = _shdr->sh_size / _shdr->sh_entsize;
+    symbol_count = shdr.sh_size / shdr.sh_entsize;
 
-    for (i = 0; i < symbol_count; ++i) {
-        GElf_Sym *cur_sym = nullptr;
+    for (size_t i = 0; i < symbol_count; ++i) {
+        GElf_Sym cur_sym;
+        struct bin_info_elf_func_sym func_sym;
 
-        cur_sym = g_new0(GElf_Sym, 1);
-        if (!cur_sym) {
-            goto error;
-        }
-        cur_sym = gelf_getsym(data, i, cur_sym);
-        if (!cur_sym) {
-            goto error;
+        if (!gelf_getsym(data, i, &cur_sym)) {
+            return -1;
         }
-        if (GELF_ST_TYPE(cur_sym->st_info) != STT_FUNC) {
+
+        if (GELF_ST_TYPE(cur_sym.st_info) != STT_FUNC) {
             /* We're only interested in the functions. */
-            g_free(cur_sym);
             continue;
         }
 
-        if (cur_sym->st_value <= addr &&
-            (!nearest_sym || cur_sym->st_value > nearest_sym->st_value)) {
-            g_free(nearest_sym);
-            nearest_sym = cur_sym;
-        } else {
-            g_free(cur_sym);
-        }
+        func_sym.addr = cur_sym.st_value;
+        func_sym.name = elf_strptr(bin->elf_file, shdr.sh_link, cur_sym.st_name);
+        func_sym.index = bin->elf_func_syms->len;
+        g_array_append_val(bin->elf_func_syms, func_sym);
     }
 
-end:
-    if (nearest_sym) {
-        *sym = nearest_sym;
-        *shdr = _shdr;
-    } else {
-        g_free(_shdr);
+    return 0;
+}
+
+/**
+ * Build `bin->elf_func_syms`, the function symbols of the ELF file,
+ * sorted by address, if not already done.
+ *
+ * @param bin		bin_info instance
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_build_elf_func_syms(struct bin_info_file *bin)
+{
+    Elf_Scn *scn = nullptr;
+
+    if (bin->elf_func_syms) {
+        /* Already built */
+        return 0;
     }
 
-    return 0;
+    bin->elf_func_syms = g_array_new(FALSE, FALSE, sizeof(struct bin_info_elf_func_sym));
 
-error:
-    g_free(nearest_sym);
-    g_free(_shdr);
-    return -1;
+    while ((scn = elf_nextscn(bin->elf_file, scn))) {
+        if (bin_info_add_elf_func_syms_from_section(bin, scn)) {
+            g_array_free(bin->elf_func_syms, TRUE);
+            bin->elf_func_syms = nullptr;
+            return -1;
+        }
+    }
+
+    g_array_sort(bin->elf_func_syms, bin_info_elf_func_sym_compare);
+    BT_COMP_LOGD("Built sorted ELF function symbol index: "
+                 "path=\"%s\", symbol-count=%u",
+                 bin->elf_path, bin->elf_func_syms->len);
+    return 0;
 }
 
 /**
  * Get the name of the function containing a given address within an
  * executable using ELF symbols.
  *
- * The function name is in fact the name of the nearest ELF symbol,
- * followed by the offset in bytes between the address and the symbol
- * (in hex), separated by a '+' character.
+ * The function name is in fact the name of the nearest ELF function
+ * symbol of which the address precedes `addr` (the first one in the
+ * symbol table if many have the same address), followed by the offset
+ * in bytes between the address and the symbol (in hex), separated by a
+ * '+' character. A symbol with a closer address might exist after
+ * `addr` but is irrelevant because it cannot encompass `addr`.
+ *
+ * The first lookup builds a sorted index of the function symbols so
+ * that each lookup is a binary search.
  *
  * If found, the out parameter `func_name` is set on success. On failure,
  * it remains unchanged.
@@ -853,147 +1197,224 @@ error:
  * @param func_name	Out parameter, the function name
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_elf_function_name(struct bin_info *bin, uint64_t addr, char **func_name)
+static int bin_info_lookup_elf_function_name(struct bin_info_file *bin, uint64_t addr,
+                                             char **func_name)
 {
-    /*
-     * TODO (possible optimisation): if an ELF has no symtab
-     * section, it has been stripped. Therefore, it would be wise
-     * to store a flag indicating the stripped status after the
-     * first iteration to prevent subsequent ones.
-     */
     int ret = 0;
-    Elf_Scn *scn = nullptr;
-    GElf_Sym *sym = nullptr;
-    GElf_Shdr *shdr = nullptr;
-    char *sym_name = nullptr;
+    const struct bin_info_elf_func_sym *syms;
+    guint low = 0, high;
 
     /* Set ELF file if it hasn't been accessed yet. */
     if (!bin->elf_file) {
         ret = bin_info_set_elf_file(bin);
         if (ret) {
             /* Failed to set ELF file. */
-            goto error;
+            return ret;
         }
     }
 
-    scn = elf_nextscn(bin->elf_file, scn);
-    if (!scn) {
-        goto error;
+    if (bin_info_build_elf_func_syms(bin)) {
+        return -1;
     }
 
-    while (scn && !sym) {
-        ret = bin_info_get_nearest_symbol_from_section(scn, addr, &sym, &shdr);
-        if (ret) {
-            goto error;
+    syms = (const struct bin_info_elf_func_sym *) bin->elf_func_syms->data;
+
+    /* Find the number of symbols of which the address is <= `addr` */
+    high = bin->elf_func_syms->len;
+
+    while (low < high) {
+        const guint mid = low + (high - low) / 2;
+
+        if (syms[mid].addr <= addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
+    }
 
-        scn = elf_nextscn(bin->elf_file, scn);
+    if (low == 0) {
+        /* No function symbol precedes `addr` */
+        return 0;
     }
 
-    if (sym) {
-        sym_name = elf_strptr(bin->elf_file, shdr->sh_link, sym->st_name);
-        if (!sym_name) {
-            goto error;
-        }
+    /* First (lowest index) symbol with the nearest address */
+    high = low - 1;
 
-        ret = bin_info_append_offset_str(sym_name, sym->st_value, addr, func_name);
-        if (ret) {
-            goto error;
-        }
+    while (high > 0 && syms[high - 1].addr == syms[low - 1].addr) {
+        --high;
     }
 
-    g_free(shdr);
-    g_free(sym);
-    return 0;
+    if (!syms[high].name) {
+        return -1;
+    }
 
-error:
-    g_free(shdr);
-    g_free(sym);
-    return ret;
+    return bin_info_append_offset_str(syms[high].name, syms[high].addr, addr, func_name);
+}
+
+/*
+ * Address range of a DWARF subprogram of `bin_info::dwarf_func_ranges`.
+ */
+struct bin_info_dwarf_func_range
+{
+    /* Address range: [`start`, `end`) */
+    uint64_t start;
+    uint64_t end;
+
+    /*
+     * Greatest `end` of this range and all the ranges which precede it
+     * within the sorted array.
+     */
+    uint64_t max_end;
+
+    /* Low PC of the subprogram, or 0 on error */
+    uint64_t low_pc;
+
+    /*
+     * Name of the subprogram (owned by the DWARF info), or `nullptr`
+     * on error.
+     */
+    const char *name;
+
+    /* Order of the subprogram within the DWARF info */
+    guint index;
+};
+
+static gint bin_info_dwarf_func_range_compare(gconstpointer a, gconstpointer b)
+{
+    const auto range_a = static_cast<const bin_info_dwarf_func_range *>(a);
+    const auto range_b = static_cast<const bin_info_dwarf_func_range *>(b);
+
+    if (range_a->start != range_b->start) {
+        return range_a->start < range_b->start ? -1 : 1;
+    }
+
+    return range_a->index < range_b->index ? -1 : (range_a->index > range_b->index);
 }
 
 /**
- * Get the name of the function containing a given address within a
- * given compile unit (CU).
+ * Add the address ranges of the subprograms of a given compile unit
+ * (CU) to `bin->dwarf_func_ranges`.
  *
- * If found, the out parameter `func_name` is set on success. On
- * failure, it remains unchanged.
- *
- * @param cu		bt_dwarf_cu instance which may contain the address
- * @param addr		Virtual memory address for which to find the
- *			function name
- * @param func_name	Out parameter, the function name
+ * @param bin		bin_info instance
+ * @param cu		bt_dwarf_cu instance
+ * @param index		In/out parameter, order of the next
+ *			subprogram within the DWARF info
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_cu_function_name(struct bt_dwarf_cu *cu, uint64_t addr, char **func_name)
+static int bin_info_add_dwarf_func_ranges_from_cu(struct bin_info_file *bin, struct bt_dwarf_cu *cu,
+                                                  guint *index)
 {
     int ret = 0;
-    bool found = false;
-    struct bt_dwarf_die *die = nullptr;
-
-    if (!cu || !func_name) {
-        goto error;
-    }
+    struct bt_dwarf_die *die;
 
     die = bt_dwarf_die_create(cu);
     if (!die) {
-        goto error;
+        return -1;
     }
 
     while (bt_dwarf_die_next(die) == 0) {
         int tag;
+        struct bin_info_dwarf_func_range range = {};
+        Dwarf_Addr base, start, end;
+        ptrdiff_t offset = 0;
 
         ret = bt_dwarf_die_get_tag(die, &tag);
         if (ret) {
-            goto error;
+            goto end;
         }
 
-        if (tag == DW_TAG_subprogram) {
-            ret = bt_dwarf_die_contains_addr(die, addr, &found);
-            if (ret) {
-                goto error;
-            }
-
-            if (found) {
-                break;
-            }
+        if (tag != DW_TAG_subprogram) {
+            continue;
         }
-    }
 
-    if (found) {
-        uint64_t low_addr = 0;
-        char *die_name = nullptr;
+        range.name = dwarf_diename(die->dwarf_die);
+        range.index = (*index)++;
 
-        ret = bt_dwarf_die_get_name(die, &die_name);
-        if (ret) {
-            goto error;
+        if (dwarf_lowpc(die->dwarf_die, &range.low_pc)) {
+            /* A lookup within this subprogram fails */
+            range.name = nullptr;
         }
 
-        ret = dwarf_lowpc(die->dwarf_die, &low_addr);
-        if (ret) {
-            free(die_name);
-            goto error;
+        while ((offset = dwarf_ranges(die->dwarf_die, offset, &base, &start, &end)) > 0) {
+            range.start = start;
+            range.end = end;
+            g_array_append_val(bin->dwarf_func_ranges, range);
         }
 
-        ret = bin_info_append_offset_str(die_name, low_addr, addr, func_name);
-        free(die_name);
-        if (ret) {
-            goto error;
+        if (offset < 0) {
+            ret = -1;
+            goto end;
         }
     }
 
+end:
     bt_dwarf_die_destroy(die);
-    return 0;
+    return ret;
+}
 
-error:
-    bt_dwarf_die_destroy(die);
-    return -1;
+/**
+ * Build `bin->dwarf_func_ranges`, the address ranges of the DWARF
+ * subprograms sorted by start address, if not already done.
+ *
+ * @param bin		bin_info instance
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_build_dwarf_func_ranges(struct bin_info_file *bin)
+{
+    int ret = 0;
+    guint index = 0;
+    uint64_t max_end = 0;
+    struct bt_dwarf_cu *cu;
+
+    if (bin->dwarf_func_ranges) {
+        /* Already built */
+        return 0;
+    }
+
+    cu = bt_dwarf_cu_create(bin->dwarf_info);
+    if (!cu) {
+        return -1;
+    }
+
+    bin->dwarf_func_ranges = g_array_new(FALSE, FALSE, sizeof(struct bin_info_dwarf_func_range));
+
+    while (bt_dwarf_cu_next(cu) == 0) {
+        ret = bin_info_add_dwarf_func_ranges_from_cu(bin, cu, &index);
+        if (ret) {
+            g_array_free(bin->dwarf_func_ranges, TRUE);
+            bin->dwarf_func_ranges = nullptr;
+            goto end;
+        }
+    }
+
+    g_array_sort(bin->dwarf_func_ranges, bin_info_dwarf_func_range_compare);
+
+    for (guint i = 0; i < bin->dwarf_func_ranges->len; ++i) {
+        auto& range = ((struct bin_info_dwarf_func_range *) bin->dwarf_func_ranges->data)[i];
+
+        max_end = MAX(max_end, range.end);
+        range.max_end = max_end;
+    }
+
+    BT_COMP_LOGD("Built sorted DWARF subprogram address range index: "
+                 "path=\"%s\", subprogram-count=%u, range-count=%u",
+                 bin->elf_path, index, bin->dwarf_func_ranges->len);
+
+end:
+    bt_dwarf_cu_destroy(cu);
+    return ret;
 }
 
 /**
  * Get the name of the function containing a given address within an
  * executable using DWARF debug info.
  *
+ * The function is the first subprogram (in DWARF info order) of which
+ * an address range contains `addr`.
+ *
+ * The first lookup builds a sorted index of the address ranges of the
+ * subprograms so that each lookup is a binary search.
+ *
  * If found, the out parameter `func_name` is set on success. On
  * failure, it remains unchanged.
  *
@@ -1004,56 +1425,84 @@ error:
  * @param func_name	Out parameter, the function name
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_dwarf_function_name(struct bin_info *bin, uint64_t addr,
+static int bin_info_lookup_dwarf_function_name(struct bin_info_file *bin, uint64_t addr,
                                                char **func_name)
 {
-    int ret = 0;
-    char *_func_name = nullptr;
-    struct bt_dwarf_cu *cu = nullptr;
+    const struct bin_info_dwarf_func_range *ranges;
+    const struct bin_info_dwarf_func_range *best = nullptr;
+    guint low = 0, high;
 
     if (!bin || !func_name) {
-        goto error;
+        return -1;
     }
 
-    cu = bt_dwarf_cu_create(bin->dwarf_info);
-    if (!cu) {
-        goto error;
+    if (bin_info_build_dwarf_func_ranges(bin)) {
+        return -1;
     }
 
-    while (bt_dwarf_cu_next(cu) == 0) {
-        ret = bin_info_lookup_cu_function_name(cu, addr, &_func_name);
-        if (ret) {
-            goto error;
-        }
+    ranges = (const struct bin_info_dwarf_func_range *) bin->dwarf_func_ranges->data;
 
-        if (_func_name) {
-            break;
+    /* Find the number of ranges of which the start is <= `addr` */
+    high = bin->dwarf_func_ranges->len;
+
+    while (low < high) {
+        const guint mid = low + (high - low) / 2;
+
+        if (ranges[mid].start <= addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
 
-    if (_func_name) {
-        *func_name = _func_name;
-    } else {
-        goto error;
+    /*
+     * Walk back while a preceding range may still contain `addr`:
+     * with non-overlapping subprograms, this is a single step.
+     */
+    for (guint i = low; i > 0 && ranges[i - 1].max_end > addr; --i) {
+        const auto range = &ranges[i - 1];
+
+        if (addr < range->end && (!best || range->index < best->index)) {
+            best = range;
+        }
     }
 
-    bt_dwarf_cu_destroy(cu);
-    return 0;
+    if (!best || !best->name) {
+        return -1;
+    }
 
-error:
-    bt_dwarf_cu_destroy(cu);
-    return -1;
+    return bin_info_append_offset_str(best->name, best->low_pc, addr, func_name);
 }
 
-int bin_info_lookup_function_name(struct bin_info *bin, uint64_t addr, char **func_name)
+/**
+ * Get the name of the function containing a given address within a
+ * file (see bin_info_lookup_function_name()).
+ *
+ * @param bin		bin_info_file instance
+ * @param addr		Address relative to the file (see
+ *			bin_info_file_addr())
+ * @param func_name	Out parameter, the function name.
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_file_lookup_function_name(struct bin_info_file *bin, uint64_t addr,
+                                              char **func_name)
 {
     int ret = 0;
     char *_func_name = nullptr;
+    struct sym_cache_result cache_result;
 
     if (!bin || !func_name) {
         goto error;
     }
 
+    if (bin->sym_cache && sym_cache_lookup(bin->sym_cache, addr, &cache_result) &&
+        cache_result.has_func) {
+        *func_name = g_strdup(cache_result.func);
+        return 0;
+    }
+
+    bin_info_wait_loaded(bin);
+
     /*
      * If the bin_info has a build id but it does not match the build id
      * that was found on the file system, return an error.
@@ -1073,18 +1522,6 @@ int bin_info_lookup_function_name(struct bin_info *bin, uint64_t addr, char **fu
         }
     }
 
-    if (!bin_info_has_address(bin, addr)) {
-        goto error;
-    }
-
-    /*
-     * Addresses in ELF and DWARF are relative to base address for
-     * PIC, so make the address argument relative too if needed.
-     */
-    if (bin->is_pic) {
-        addr -= bin->low_addr;
-    }
-
     if (bin->is_elf_only) {
         ret = bin_info_lookup_elf_function_name(bin, addr, &_func_name);
         if (ret) {
@@ -1101,6 +1538,15 @@ int bin_info_lookup_function_name(struct bin_info *bin, uint64_t addr, char **fu
         }
     }
 
+    if (bin->sym_cache && ret == 0) {
+        sym_cache_add_func(bin->sym_cache, addr, _func_name);
+
+        if (bin->is_elf_only) {
+            /* No source location without DWARF info */
+            sym_cache_add_src_loc(bin->sym_cache, addr, nullptr, 0);
+        }
+    }
+
     *func_name = _func_name;
     return 0;
 
@@ -1108,6 +1554,31 @@ error:
     return -1;
 }
 
+/**
+ * Returns the address, relative to the file of `bin`, of the address
+ * `addr` of the address space of the process.
+ *
+ * @param bin	bin_info instance containing `addr`
+ * @param addr	Virtual memory address
+ */
+static uint64_t bin_info_file_addr(struct bin_info *bin, uint64_t addr)
+{
+    /*
+     * Addresses in ELF and DWARF are relative to base address for
+     * PIC, so make the address argument relative too if needed.
+     */
+    return bin->is_pic ? addr - bin->low_addr : addr;
+}
+
+int bin_info_lookup_function_name(struct bin_info *bin, uint64_t addr, char **func_name)
+{
+    if (!bin || !func_name || !bin_info_has_address(bin, addr)) {
+        return -1;
+    }
+
+    return bin_info_file_lookup_function_name(bin->file, bin_info_file_addr(bin, addr), func_name);
+}
+
 int bin_info_get_bin_loc(struct bin_info *bin, uint64_t addr, char **bin_loc)
 {
     gchar *_bin_loc = nullptr;
@@ -1119,8 +1590,13 @@ int bin_info_get_bin_loc(struct bin_info *bin, uint64_t addr, char **bin_loc)
     /*
      * If the bin_info has a build id but it does not match the build id
      * that was found on the file system, return an error.
+     *
+     * The build ID may still be pending if the symbolization cache
+     * satisfied all the lookups: the location is valid, as the cache
+     * is specific to this build ID.
      */
-    if (bin->build_id && !bin->file_build_id_matches) {
+    if (bin->file->build_id && !bin->file->build_id_match_pending &&
+        !bin->file->file_build_id_matches) {
         goto error;
     }
 
@@ -1143,105 +1619,31 @@ error:
 }
 
 /**
- * Predicate used to determine whether the children of a given DIE
- * contain a specific address.
- *
- * More specifically, the parameter `die` is expected to be a
- * subprogram (function) DIE, and this predicate tells whether any
- * subroutines are inlined within this function and would contain
- * `addr`.
- *
- * On success, the out parameter `contains` is set with the boolean
- * value indicating whether the DIE's range covers `addr`. On failure,
- * it remains unchanged.
- *
- * Do note that this function advances the position of `die`. If the
- * address is found within one of its children, `die` will be pointing
- * to that child upon returning from the function, allowing to extract
- * the information deemed necessary.
+ * Lookup the source location for a given address within a CU,
+ * assuming that it is contained within an inlined function.
  *
- * @param die		The parent DIE in whose children the address will be
- *			looked for
- * @param addr		The address for which to look for in the DIEs
- * @param contains	Out parameter, true if addr is contained,
- *			false if not
- * @returns		Returns 0 on success, -1 on failure
- */
-static int bin_info_child_die_has_address(struct bt_dwarf_die *die, uint64_t addr, bool *contains)
-{
-    int ret = 0;
-    bool _contains = false;
-
-    if (!die) {
-        goto error;
-    }
-
-    ret = bt_dwarf_die_child(die);
-    if (ret) {
-        goto error;
-    }
-
-    do {
-        ret = bt_dwarf_die_contains_addr(die, addr, &_contains);
-        if (ret) {
-            goto error;
-        }
-
-        if (_contains) {
-            /*
-             * The address is within the range of the current DIE
-             * or its children.
-             */
-            int tag;
-
-            ret = bt_dwarf_die_get_tag(die, &tag);
-            if (ret) {
-                goto error;
-            }
-
-            if (tag == DW_TAG_inlined_subroutine) {
-                /* Found the tracepoint. */
-                goto end;
-            }
-
-            if (bt_dwarf_die_has_children(die)) {
-                /*
-                 * Look for the address in the children DIEs.
-                 */
-                ret = bt_dwarf_die_child(die);
-                if (ret) {
-                    goto error;
-                }
-            }
-        }
-    } while (bt_dwarf_die_next(die) == 0);
-
-end:
-    *contains = _contains;
-    return 0;
-
-error:
-    return -1;
-}
-
-/**
- * Lookup the source location for a given address within a CU, making
- * the assumption that it is contained within an inline routine in a
- * function.
+ * A source location can be found regardless of inlining status for
+ * this method, but in the case of an inlined function, the returned
+ * source location will point not to the callsite but rather to the
+ * definition site of the inline function.
  *
  * @param cu		bt_dwarf_cu instance in which to look for the address
  * @param addr		The address for which to look for
  * @param src_loc	Out parameter, the source location (filename and
- *			line number) for the address
+ *			line number) for the address. Set only if the address
+ *			is found and resolved successfully
+ *
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_cu_src_loc_inl(struct bt_dwarf_cu *cu, uint64_t addr,
-                                          struct source_location **src_loc)
+static int bin_info_lookup_cu_src_loc_no_inl(struct bt_dwarf_cu *cu, uint64_t addr,
+                                             struct source_location **src_loc)
 {
-    int ret = 0;
-    bool found = false;
-    struct bt_dwarf_die *die = nullptr;
     struct source_location *_src_loc = nullptr;
+    struct bt_dwarf_die *die = nullptr;
+    const char *filename = nullptr;
+    Dwarf_Line *line = nullptr;
+    Dwarf_Addr line_addr;
+    int ret = 0, line_no;
 
     if (!cu || !src_loc) {
         goto error;
@@ -1252,152 +1654,499 @@ static int bin_info_lookup_cu_src_loc_inl(struct bt_dwarf_cu *cu, uint64_t addr,
         goto error;
     }
 
-    while (bt_dwarf_die_next(die) == 0) {
-        int tag;
-
-        ret = bt_dwarf_die_get_tag(die, &tag);
-        if (ret) {
-            goto error;
-        }
-
-        if (tag == DW_TAG_subprogram) {
-            bool contains = false;
-
-            ret = bt_dwarf_die_contains_addr(die, addr, &contains);
-            if (ret) {
-                goto error;
-            }
-
-            if (contains) {
-                /*
-                 * Try to find an inlined subroutine
-                 * child of this DIE containing addr.
-                 */
-                ret = bin_info_child_die_has_address(die, addr, &found);
-                if (ret) {
-                    goto error;
-                }
+    line = dwarf_getsrc_die(die->dwarf_die, addr);
+    if (!line) {
+        /* This is not an error. The caller needs to keep looking. */
+        goto end;
+    }
 
-                goto end;
-            }
-        }
+    ret = dwarf_lineaddr(line, &line_addr);
+    if (ret) {
+        goto error;
     }
 
-end:
-    if (found) {
-        char *filename = nullptr;
-        uint64_t line_no;
+    filename = dwarf_linesrc(line, nullptr, nullptr);
+    if (!filename) {
+        goto error;
+    }
 
+    if (addr == line_addr) {
         _src_loc = g_new0(struct source_location, 1);
         if (!_src_loc) {
             goto error;
         }
 
-        ret = bt_dwarf_die_get_call_file(die, &filename);
-        if (ret) {
-            goto error;
-        }
-        ret = bt_dwarf_die_get_call_line(die, &line_no);
+        ret = dwarf_lineno(line, &line_no);
         if (ret) {
-            free(filename);
             goto error;
         }
 
-        _src_loc->filename = filename;
         _src_loc->line_no = line_no;
+        _src_loc->filename = g_strdup(filename);
+    }
+
+    if (_src_loc) {
         *src_loc = _src_loc;
     }
 
-    bt_dwarf_die_destroy(die);
-    return 0;
+    goto end;
 
 error:
     source_location_destroy(_src_loc);
+    ret = -1;
+end:
     bt_dwarf_die_destroy(die);
-    return -1;
+    return ret;
+}
+
+/*
+ * Address range of a DWARF DIE within a sorted range array of
+ * `struct bin_info`.
+ */
+struct bin_info_dwarf_range
+{
+    /* Address range: [`start`, `end`) */
+    uint64_t start;
+    uint64_t end;
+
+    /*
+     * Greatest `end` of this range and all the ranges which precede it
+     * within the sorted array.
+     */
+    uint64_t max_end;
+
+    /* Offset of the DIE within the DWARF info */
+    Dwarf_Off die_offset;
+
+    /* Order of the DIE amongst the DIEs of the array */
+    guint index;
+
+    /*
+     * Index of the owner of the DIE (subprogram for an inlined
+     * subroutine, otherwise same as `index`).
+     */
+    guint owner;
+};
+
+/*
+ * Compile unit (CU) of `bin_info::dwarf_cus`.
+ */
+struct bin_info_dwarf_cu
+{
+    struct bt_dwarf_cu cu;
+
+    /* Whether or not the members below are set */
+    bool is_decoded;
+
+    /*
+     * Sorted address ranges of the subprograms of this CU (array of
+     * `struct bin_info_dwarf_range`).
+     */
+    GArray *subprogram_ranges;
+
+    /*
+     * Sorted address ranges of the outermost inlined subroutines of
+     * the subprograms of this CU (array of
+     * `struct bin_info_dwarf_range`, the owner being the index of the
+     * subprogram).
+     */
+    GArray *inline_ranges;
+};
+
+static void bin_info_dwarf_cu_destroy(gpointer data)
+{
+    const auto dwarf_cu = static_cast<bin_info_dwarf_cu *>(data);
+
+    if (dwarf_cu->subprogram_ranges) {
+        g_array_free(dwarf_cu->subprogram_ranges, TRUE);
+    }
+
+    if (dwarf_cu->inline_ranges) {
+        g_array_free(dwarf_cu->inline_ranges, TRUE);
+    }
+
+    g_free(dwarf_cu);
+}
+
+static gint bin_info_dwarf_range_compare(gconstpointer a, gconstpointer b)
+{
+    const auto range_a = static_cast<const bin_info_dwarf_range *>(a);
+    const auto range_b = static_cast<const bin_info_dwarf_range *>(b);
+
+    if (range_a->start != range_b->start) {
+        return range_a->start < range_b->start ? -1 : 1;
+    }
+
+    return range_a->index < range_b->index ? -1 : (range_a->index > range_b->index);
+}
+
+static GArray *bin_info_dwarf_ranges_create(void)
+{
+    return g_array_new(FALSE, FALSE, sizeof(struct bin_info_dwarf_range));
 }
 
 /**
- * Lookup the source location for a given address within a CU,
- * assuming that it is contained within an inlined function.
+ * Append the address ranges of a given DIE to `ranges`.
  *
- * A source location can be found regardless of inlining status for
- * this method, but in the case of an inlined function, the returned
- * source location will point not to the callsite but rather to the
- * definition site of the inline function.
+ * @param ranges	Range array
+ * @param die		DIE of which to append the address ranges
+ * @param index		Order of the DIE within `ranges`
+ * @param owner		Owner of the DIE
+ * @returns		Number of appended ranges, or -1 on failure
+ */
+static int bin_info_dwarf_ranges_append(GArray *ranges, Dwarf_Die *die, guint index, guint owner)
+{
+    struct bin_info_dwarf_range range = {};
+    Dwarf_Addr base, start, end;
+    ptrdiff_t offset = 0;
+    int count = 0;
+
+    range.die_offset = dwarf_dieoffset(die);
+    range.index = index;
+    range.owner = owner;
+
+    while ((offset = dwarf_ranges(die, offset, &base, &start, &end)) > 0) {
+        range.start = start;
+        range.end = end;
+        g_array_append_val(ranges, range);
+        ++count;
+    }
+
+    return offset < 0 ? -1 : count;
+}
+
+/**
+ * Sort `ranges` and set the `max_end` member of its ranges.
  *
- * @param cu		bt_dwarf_cu instance in which to look for the address
- * @param addr		The address for which to look for
- * @param src_loc	Out parameter, the source location (filename and
- *			line number) for the address. Set only if the address
- *			is found and resolved successfully
+ * @param ranges	Range array
+ */
+static void bin_info_dwarf_ranges_sort(GArray *ranges)
+{
+    uint64_t max_end = 0;
+
+    g_array_sort(ranges, bin_info_dwarf_range_compare);
+
+    for (guint i = 0; i < ranges->len; ++i) {
+        auto& range = ((struct bin_info_dwarf_range *) ranges->data)[i];
+
+        max_end = MAX(max_end, range.end);
+        range.max_end = max_end;
+    }
+}
+
+/*
+ * Any owner for bin_info_dwarf_ranges_find_first().
+ */
+#define BIN_INFO_DWARF_RANGE_ANY_OWNER G_MAXUINT
+
+/**
+ * Find the range of the first DIE (lowest index) of the sorted range
+ * array `ranges` which contains `addr` and of which the owner is
+ * `owner` (unless it's `BIN_INFO_DWARF_RANGE_ANY_OWNER`).
+ *
+ * This is a binary search followed with a backward walk over the
+ * ranges which may still contain `addr`, a single step if the ranges
+ * don't overlap.
  *
+ * @param ranges	Sorted range array
+ * @param addr		Address to look for
+ * @param owner		Owner of the DIE to find
+ * @returns		Range, or `nullptr` if not found
+ */
+static const struct bin_info_dwarf_range *bin_info_dwarf_ranges_find_first(GArray *ranges,
+                                                                            uint64_t addr,
+                                                                            guint owner)
+{
+    const auto data = (const struct bin_info_dwarf_range *) ranges->data;
+    const struct bin_info_dwarf_range *best = nullptr;
+    guint low = 0, high = ranges->len;
+
+    /* Find the number of ranges of which the start is <= `addr` */
+    while (low < high) {
+        const guint mid = low + (high - low) / 2;
+
+        if (data[mid].start <= addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for (guint i = low; i > 0 && data[i - 1].max_end > addr; --i) {
+        const auto range = &data[i - 1];
+
+        if (addr < range->end &&
+            (owner == BIN_INFO_DWARF_RANGE_ANY_OWNER || range->owner == owner) &&
+            (!best || range->index < best->index)) {
+            best = range;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * Append the address ranges of the outermost inlined subroutine
+ * descendants of `parent`, a DIE of the subprogram `owner`, to
+ * `dwarf_cu->inline_ranges`.
+ *
+ * @param dwarf_cu	CU containing `parent`
+ * @param parent	Parent DIE
+ * @param owner		Index of the subprogram containing `parent`
+ * @param index		In/out parameter, order of the next inlined
+ *			subroutine within the CU
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_cu_src_loc_no_inl(struct bt_dwarf_cu *cu, uint64_t addr,
-                                             struct source_location **src_loc)
+static int bin_info_dwarf_cu_add_inline_ranges(struct bin_info_dwarf_cu *dwarf_cu,
+                                               Dwarf_Die *parent, guint owner, guint *index)
 {
-    struct source_location *_src_loc = nullptr;
-    struct bt_dwarf_die *die = nullptr;
-    const char *filename = nullptr;
-    Dwarf_Line *line = nullptr;
-    Dwarf_Addr line_addr;
-    int ret = 0, line_no;
+    Dwarf_Die child, next;
+    int ret;
 
-    if (!cu || !src_loc) {
-        goto error;
+    ret = dwarf_child(parent, &child);
+    if (ret) {
+        /* ret is -1 on error, 1 if no child DIE. */
+        return ret < 0 ? -1 : 0;
     }
 
-    die = bt_dwarf_die_create(cu);
+    while (true) {
+        if (dwarf_tag(&child) == DW_TAG_inlined_subroutine) {
+            /* What's inlined within it doesn't matter */
+            if (bin_info_dwarf_ranges_append(dwarf_cu->inline_ranges, &child, (*index)++, owner) <
+                0) {
+                return -1;
+            }
+        } else if (dwarf_haschildren(&child)) {
+            if (bin_info_dwarf_cu_add_inline_ranges(dwarf_cu, &child, owner, index)) {
+                return -1;
+            }
+        }
+
+        ret = dwarf_siblingof(&child, &next);
+        if (ret) {
+            /* ret is -1 on error, 1 if no more sibling DIE. */
+            return ret < 0 ? -1 : 0;
+        }
+
+        child = next;
+    }
+}
+
+/**
+ * Decode the address ranges of the subprograms of a CU and of their
+ * inlined subroutines, if not already done.
+ *
+ * @param dwarf_cu	CU to decode
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_dwarf_cu_decode(struct bin_info_dwarf_cu *dwarf_cu)
+{
+    int ret = 0;
+    guint subprogram_index = 0, inline_index = 0;
+    struct bt_dwarf_die *die;
+
+    if (dwarf_cu->is_decoded) {
+        return 0;
+    }
+
+    die = bt_dwarf_die_create(&dwarf_cu->cu);
     if (!die) {
-        goto error;
+        return -1;
     }
 
-    line = dwarf_getsrc_die(die->dwarf_die, addr);
-    if (!line) {
-        /* This is not an error. The caller needs to keep looking. */
-        goto end;
+    dwarf_cu->subprogram_ranges = bin_info_dwarf_ranges_create();
+    dwarf_cu->inline_ranges = bin_info_dwarf_ranges_create();
+
+    while (bt_dwarf_die_next(die) == 0) {
+        int tag;
+
+        ret = bt_dwarf_die_get_tag(die, &tag);
+        if (ret) {
+            goto end;
+        }
+
+        if (tag != DW_TAG_subprogram) {
+            continue;
+        }
+
+        if (bin_info_dwarf_ranges_append(dwarf_cu->subprogram_ranges, die->dwarf_die,
+                                         subprogram_index, subprogram_index) < 0) {
+            ret = -1;
+            goto end;
+        }
+
+        if (dwarf_haschildren(die->dwarf_die)) {
+            ret = bin_info_dwarf_cu_add_inline_ranges(dwarf_cu, die->dwarf_die, subprogram_index,
+                                                      &inline_index);
+            if (ret) {
+                goto end;
+            }
+        }
+
+        ++subprogram_index;
     }
 
-    ret = dwarf_lineaddr(line, &line_addr);
+    bin_info_dwarf_ranges_sort(dwarf_cu->subprogram_ranges);
+    bin_info_dwarf_ranges_sort(dwarf_cu->inline_ranges);
+    dwarf_cu->is_decoded = true;
+
+end:
     if (ret) {
-        goto error;
+        g_array_free(dwarf_cu->subprogram_ranges, TRUE);
+        dwarf_cu->subprogram_ranges = nullptr;
+        g_array_free(dwarf_cu->inline_ranges, TRUE);
+        dwarf_cu->inline_ranges = nullptr;
     }
 
-    filename = dwarf_linesrc(line, nullptr, nullptr);
-    if (!filename) {
-        goto error;
+    bt_dwarf_die_destroy(die);
+    return ret;
+}
+
+/**
+ * Build the CU index of `bin` (`bin->dwarf_cus`,
+ * `bin->dwarf_cu_ranges`, and `bin->dwarf_rangeless_cus`), if not
+ * already done.
+ *
+ * This only reads the root DIE of each CU: bin_info_dwarf_cu_decode()
+ * decodes the contents of a CU the first time a lookup needs it.
+ *
+ * @param bin		bin_info instance
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_build_dwarf_cus(struct bin_info_file *bin)
+{
+    int ret = 0;
+    struct bt_dwarf_cu *cu;
+
+    if (bin->dwarf_cus) {
+        /* Already built */
+        return 0;
     }
 
-    if (addr == line_addr) {
-        _src_loc = g_new0(struct source_location, 1);
-        if (!_src_loc) {
-            goto error;
-        }
+    cu = bt_dwarf_cu_create(bin->dwarf_info);
+    if (!cu) {
+        return -1;
+    }
 
-        ret = dwarf_lineno(line, &line_no);
-        if (ret) {
-            goto error;
+    bin->dwarf_cus = g_ptr_array_new_with_free_func(bin_info_dwarf_cu_destroy);
+    bin->dwarf_cu_ranges = bin_info_dwarf_ranges_create();
+    bin->dwarf_rangeless_cus = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    while (bt_dwarf_cu_next(cu) == 0) {
+        const guint index = bin->dwarf_cus->len;
+        struct bin_info_dwarf_cu *dwarf_cu = g_new0(struct bin_info_dwarf_cu, 1);
+        struct bt_dwarf_die *die;
+        int range_count;
+
+        dwarf_cu->cu = *cu;
+        g_ptr_array_add(bin->dwarf_cus, dwarf_cu);
+
+        die = bt_dwarf_die_create(&dwarf_cu->cu);
+        if (!die) {
+            ret = -1;
+            goto end;
         }
 
-        _src_loc->line_no = line_no;
-        _src_loc->filename = g_strdup(filename);
-    }
+        range_count = bin_info_dwarf_ranges_append(bin->dwarf_cu_ranges, die->dwarf_die, index,
+                                                   index);
+        bt_dwarf_die_destroy(die);
 
-    if (_src_loc) {
-        *src_loc = _src_loc;
+        if (range_count < 0) {
+            ret = -1;
+            goto end;
+        } else if (range_count == 0) {
+            /* Without address ranges: always a candidate */
+            g_array_append_val(bin->dwarf_rangeless_cus, index);
+        }
     }
 
-    goto end;
+    bin_info_dwarf_ranges_sort(bin->dwarf_cu_ranges);
+    BT_COMP_LOGD("Built DWARF compile unit index: "
+                 "path=\"%s\", cu-count=%u, rangeless-cu-count=%u",
+                 bin->elf_path, bin->dwarf_cus->len, bin->dwarf_rangeless_cus->len);
 
-error:
-    source_location_destroy(_src_loc);
-    ret = -1;
 end:
-    bt_dwarf_die_destroy(die);
+    if (ret) {
+        g_ptr_array_free(bin->dwarf_cus, TRUE);
+        bin->dwarf_cus = nullptr;
+        g_array_free(bin->dwarf_cu_ranges, TRUE);
+        bin->dwarf_cu_ranges = nullptr;
+        g_array_free(bin->dwarf_rangeless_cus, TRUE);
+        bin->dwarf_rangeless_cus = nullptr;
+    }
+
+    bt_dwarf_cu_destroy(cu);
     return ret;
 }
 
+static gint bin_info_guint_compare(gconstpointer a, gconstpointer b)
+{
+    const auto val_a = *static_cast<const guint *>(a);
+    const auto val_b = *static_cast<const guint *>(b);
+
+    return val_a < val_b ? -1 : (val_a > val_b);
+}
+
+/**
+ * Get the source location of the call site of the outermost inlined
+ * subroutine containing a given address within a compile unit (CU).
+ *
+ * The inlined subroutine is a descendant of the first subprogram of
+ * the CU containing the address.
+ *
+ * On success, the out parameter `src_loc` is set if found. On
+ * failure, it remains unchanged.
+ *
+ * @param dwarf_cu	Decoded CU which may contain the address
+ * @param addr		The address for which to look for
+ * @param src_loc	Out parameter, the source location
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_lookup_cu_src_loc_inl(struct bin_info_dwarf_cu *dwarf_cu, uint64_t addr,
+                                          struct source_location **src_loc)
+{
+    const struct bin_info_dwarf_range *subprogram_range, *inline_range;
+    Dwarf_Die inline_dwarf_die;
+    struct bt_dwarf_die inline_die;
+    char *filename = nullptr;
+    uint64_t line_no;
+
+    subprogram_range = bin_info_dwarf_ranges_find_first(dwarf_cu->subprogram_ranges, addr,
+                                                        BIN_INFO_DWARF_RANGE_ANY_OWNER);
+    if (!subprogram_range) {
+        return 0;
+    }
+
+    inline_range =
+        bin_info_dwarf_ranges_find_first(dwarf_cu->inline_ranges, addr, subprogram_range->index);
+    if (!inline_range) {
+        return 0;
+    }
+
+    if (!dwarf_offdie(dwarf_cu->cu.dwarf_info, inline_range->die_offset, &inline_dwarf_die)) {
+        return -1;
+    }
+
+    /* Weak DIE: only for the bt_dwarf_die_get_call_*() functions */
+    inline_die.cu = &dwarf_cu->cu;
+    inline_die.dwarf_die = &inline_dwarf_die;
+    inline_die.depth = 0;
+
+    if (bt_dwarf_die_get_call_file(&inline_die, &filename)) {
+        return -1;
+    }
+
+    if (bt_dwarf_die_get_call_line(&inline_die, &line_no)) {
+        free(filename);
+        return -1;
+    }
+
+    *src_loc = g_new0(struct source_location, 1);
+    (*src_loc)->filename = filename;
+    (*src_loc)->line_no = line_no;
+    return 0;
+}
+
 /**
  * Get the source location (file name and line number) for a given
  * address within a compile unit (CU).
@@ -1405,63 +2154,79 @@ end:
  * On success, the out parameter `src_loc` is set if found. On
  * failure, it remains unchanged.
  *
- * @param cu		bt_dwarf_cu instance for the compile unit which
- *			may contain the address
+ * @param dwarf_cu	CU which may contain the address
  * @param addr		Virtual memory address for which to find the
  *			source location
  * @param src_loc	Out parameter, the source location
  * @returns		0 on success, -1 on failure
  */
-static int bin_info_lookup_cu_src_loc(struct bt_dwarf_cu *cu, uint64_t addr,
+static int bin_info_lookup_cu_src_loc(struct bin_info_dwarf_cu *dwarf_cu, uint64_t addr,
                                       struct source_location **src_loc)
 {
-    int ret = 0;
+    int ret;
     struct source_location *_src_loc = nullptr;
 
-    if (!cu || !src_loc) {
-        goto error;
-    }
-
-    ret = bin_info_lookup_cu_src_loc_inl(cu, addr, &_src_loc);
+    ret = bin_info_dwarf_cu_decode(dwarf_cu);
     if (ret) {
-        goto error;
-    }
-
-    if (_src_loc) {
-        goto end;
+        return -1;
     }
 
-    ret = bin_info_lookup_cu_src_loc_no_inl(cu, addr, &_src_loc);
+    ret = bin_info_lookup_cu_src_loc_inl(dwarf_cu, addr, &_src_loc);
     if (ret) {
-        goto error;
+        return -1;
     }
 
-    if (_src_loc) {
-        goto end;
+    if (!_src_loc) {
+        ret = bin_info_lookup_cu_src_loc_no_inl(&dwarf_cu->cu, addr, &_src_loc);
+        if (ret) {
+            return -1;
+        }
     }
 
-end:
     if (_src_loc) {
         *src_loc = _src_loc;
     }
 
     return 0;
-
-error:
-    source_location_destroy(_src_loc);
-    return -1;
 }
 
-int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
-                                    struct source_location **src_loc)
+/**
+ * Get the source location for a given address within a file (see
+ * bin_info_lookup_source_location()).
+ *
+ * @param bin		bin_info_file instance
+ * @param addr		Address relative to the file (see
+ *			bin_info_file_addr())
+ * @param src_loc	Out parameter, the source location
+ * @returns		0 on success, -1 on failure
+ */
+static int bin_info_file_lookup_source_location(struct bin_info_file *bin, uint64_t addr,
+                                                struct source_location **src_loc)
 {
-    struct bt_dwarf_cu *cu = nullptr;
+    GArray *candidate_cus = nullptr;
     struct source_location *_src_loc = nullptr;
+    struct sym_cache_result cache_result;
 
     if (!bin || !src_loc) {
         goto error;
     }
 
+    if (bin->sym_cache && sym_cache_lookup(bin->sym_cache, addr, &cache_result) &&
+        cache_result.has_src_loc) {
+        if (!cache_result.src_path) {
+            /* Known to have no source location */
+            return 0;
+        }
+
+        _src_loc = g_new0(struct source_location, 1);
+        _src_loc->filename = g_strdup(cache_result.src_path);
+        _src_loc->line_no = cache_result.line_no;
+        *src_loc = _src_loc;
+        return 0;
+    }
+
+    bin_info_wait_loaded(bin);
+
     /*
      * If the bin_info has a build id but it does not match the build id
      * that was found on the file system, return an error.
@@ -1480,31 +2245,60 @@ int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
 
     if (bin->is_elf_only) {
         /* We cannot lookup source location without DWARF info. */
+        if (bin->sym_cache) {
+            sym_cache_add_src_loc(bin->sym_cache, addr, nullptr, 0);
+        }
+
         goto error;
     }
 
-    if (!bin_info_has_address(bin, addr)) {
+    if (bin_info_build_dwarf_cus(bin)) {
         goto error;
     }
 
     /*
-     * Addresses in ELF and DWARF are relative to base address for
-     * PIC, so make the address argument relative too if needed.
+     * Candidate CUs, in DWARF info order: the ones having an address
+     * range containing `addr`, and the ones without address ranges.
      */
-    if (bin->is_pic) {
-        addr -= bin->low_addr;
-    }
+    candidate_cus = g_array_new(FALSE, FALSE, sizeof(guint));
+    g_array_append_vals(candidate_cus, bin->dwarf_rangeless_cus->data,
+                        bin->dwarf_rangeless_cus->len);
+
+    {
+        const auto ranges = (const struct bin_info_dwarf_range *) bin->dwarf_cu_ranges->data;
+        guint low = 0, high = bin->dwarf_cu_ranges->len;
+
+        /* Find the number of ranges of which the start is <= `addr` */
+        while (low < high) {
+            const guint mid = low + (high - low) / 2;
+
+            if (ranges[mid].start <= addr) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
 
-    cu = bt_dwarf_cu_create(bin->dwarf_info);
-    if (!cu) {
-        goto error;
+        for (guint i = low; i > 0 && ranges[i - 1].max_end > addr; --i) {
+            if (addr < ranges[i - 1].end) {
+                g_array_append_val(candidate_cus, ranges[i - 1].index);
+            }
+        }
     }
 
-    while (bt_dwarf_cu_next(cu) == 0) {
-        int ret;
+    g_array_sort(candidate_cus, bin_info_guint_compare);
 
-        ret = bin_info_lookup_cu_src_loc(cu, addr, &_src_loc);
-        if (ret) {
+    for (guint i = 0; i < candidate_cus->len; ++i) {
+        const auto cu_index = ((const guint *) candidate_cus->data)[i];
+
+        if (i > 0 && cu_index == ((const guint *) candidate_cus->data)[i - 1]) {
+            /* Already tried */
+            continue;
+        }
+
+        if (bin_info_lookup_cu_src_loc(
+                static_cast<bin_info_dwarf_cu *>(g_ptr_array_index(bin->dwarf_cus, cu_index)), addr,
+                &_src_loc)) {
             goto error;
         }
 
@@ -1513,7 +2307,12 @@ int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
         }
     }
 
-    bt_dwarf_cu_destroy(cu);
+    g_array_free(candidate_cus, TRUE);
+    if (bin->sym_cache) {
+        sym_cache_add_src_loc(bin->sym_cache, addr, _src_loc ? _src_loc->filename : nullptr,
+                              _src_loc ? _src_loc->line_no : 0);
+    }
+
     if (_src_loc) {
         *src_loc = _src_loc;
     }
@@ -1522,6 +2321,195 @@ int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
 
 error:
     source_location_destroy(_src_loc);
-    bt_dwarf_cu_destroy(cu);
+
+    if (candidate_cus) {
+        g_array_free(candidate_cus, TRUE);
+    }
+
     return -1;
 }
+
+int bin_info_lookup_source_location(struct bin_info *bin, uint64_t addr,
+                                    struct source_location **src_loc)
+{
+    if (!bin || !src_loc || !bin_info_has_address(bin, addr)) {
+        return -1;
+    }
+
+    return bin_info_file_lookup_source_location(bin->file, bin_info_file_addr(bin, addr),
+                                                src_loc);
+}
+
+
+struct bin_info_loader
+{
+    std::mutex mutex;
+
+    /* Signals a queued binary or `quit` */
+    std::condition_variable work_cv;
+
+    /* Signals a loaded binary */
+    std::condition_variable done_cv;
+
+    /* Binaries to load, in order */
+    std::deque<struct bin_info_file *> queue;
+
+    /* Started on first use */
+    std::vector<std::thread> threads;
+
+    bool quit = false;
+};
+
+/**
+ * Opens and indexes, from a loader thread, the ELF file of `bin` and
+ * the DWARF info it contains, if any.
+ *
+ * This is only a head start: on failure, the graph thread tries again
+ * lazily and reports any error then. Separate DWARF info (build ID and
+ * debug link), which depends on later events, is always found lazily.
+ *
+ * @param bin	bin_info instance to load
+ */
+static void bin_info_load(struct bin_info_file *bin)
+{
+    if (bin_info_set_elf_file(bin) == 0) {
+        (void) bin_info_build_elf_func_syms(bin);
+    }
+
+    if (bin_info_set_dwarf_info_from_path(bin, bin->elf_path) == 0) {
+        (void) bin_info_build_dwarf_func_ranges(bin);
+        (void) bin_info_build_dwarf_cus(bin);
+    }
+
+    /* Not reported: see above */
+    bt_current_thread_clear_error();
+}
+
+static void bin_info_loader_thread(struct bin_info_loader *loader)
+{
+    std::unique_lock<std::mutex> lock {loader->mutex};
+
+    while (true) {
+        loader->work_cv.wait(lock, [loader] {
+            return loader->quit || !loader->queue.empty();
+        });
+
+        if (loader->quit) {
+            return;
+        }
+
+        const auto bin = loader->queue.front();
+
+        loader->queue.pop_front();
+        bin->load_state = BIN_INFO_LOAD_STATE_LOADING;
+        lock.unlock();
+        bin_info_load(bin);
+        lock.lock();
+        bin->load_state = BIN_INFO_LOAD_STATE_DONE;
+        loader->done_cv.notify_all();
+    }
+}
+
+/**
+ * Waits until no loader thread uses `bin`, then checks its pending
+ * build ID, if any.
+ *
+ * If a loader thread didn't start loading `bin` yet, this function
+ * cancels it: the caller loads it lazily.
+ *
+ * Only the graph thread reads and writes `bin->loader`.
+ *
+ * @param bin	bin_info instance
+ */
+static void bin_info_wait_loaded(struct bin_info_file *bin)
+{
+    const auto loader = bin->loader;
+
+    if (loader) {
+        std::unique_lock<std::mutex> lock {loader->mutex};
+
+        if (bin->load_state == BIN_INFO_LOAD_STATE_QUEUED) {
+            loader->queue.erase(std::find(loader->queue.begin(), loader->queue.end(), bin));
+        } else {
+            loader->done_cv.wait(lock, [bin] {
+                return bin->load_state == BIN_INFO_LOAD_STATE_DONE;
+            });
+        }
+
+        bin->load_state = BIN_INFO_LOAD_STATE_NONE;
+        bin->loader = nullptr;
+    }
+
+    if (bin->build_id_match_pending) {
+        bin->build_id_match_pending = false;
+        (void) bin_info_match_build_id(bin);
+    }
+}
+
+struct bin_info_loader *bin_info_loader_create(void)
+{
+    return new bin_info_loader;
+}
+
+void bin_info_loader_destroy(struct bin_info_loader *loader)
+{
+    if (!loader) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock {loader->mutex};
+
+        BT_ASSERT(loader->queue.empty());
+        loader->quit = true;
+    }
+
+    loader->work_cv.notify_all();
+
+    for (auto& thread : loader->threads) {
+        thread.join();
+    }
+
+    delete loader;
+}
+
+void bin_info_start_loading(struct bin_info *mapping, struct bin_info_loader *loader)
+{
+    BT_ASSERT(mapping);
+    BT_ASSERT(loader);
+
+    struct bin_info_file *bin = mapping->file;
+
+    if (bin->loader || bin->elf_file || bin->dwarf_info) {
+        /* Already queued or (partly) loaded */
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock {loader->mutex};
+
+        if (loader->threads.empty()) {
+            const auto thread_count = std::min(std::max(std::thread::hardware_concurrency(), 1U),
+                                               (unsigned int) BIN_INFO_LOADER_MAX_THREAD_COUNT);
+
+            try {
+                for (unsigned int i = 0; i < thread_count; ++i) {
+                    loader->threads.emplace_back(bin_info_loader_thread, loader);
+                }
+            } catch (const std::system_error& exc) {
+                BT_COMP_LOGI("Cannot start bin_info loader thread: %s", exc.what());
+
+                if (loader->threads.empty()) {
+                    /* Lazy loading only */
+                    return;
+                }
+            }
+        }
+
+        bin->loader = loader;
+        bin->load_state = BIN_INFO_LOAD_STATE_QUEUED;
+        loader->queue.push_back(bin);
+    }
+
+    loader->work_cv.notify_one();
+}
@@ -24,19 +24,48 @@
 #define BUILD_ID_SUFFIX         ".debug"
 #define BUILD_ID_PREFIX_DIR_LEN 2
 
-struct bin_info
+/*
+ * Loading state of a bin_info instance (see bin_info_start_loading()).
+ */
+enum bin_info_load_state
+{
+    /* Not handled by a loader */
+    BIN_INFO_LOAD_STATE_NONE,
+
+    /* Waiting for a loader thread */
+    BIN_INFO_LOAD_STATE_QUEUED,
+
+    /* A loader thread is loading it */
+    BIN_INFO_LOAD_STATE_LOADING,
+
+    /* A loader thread loaded it */
+    BIN_INFO_LOAD_STATE_DONE,
+};
+
+struct bin_info_loader;
+struct bin_info_file_cache;
+struct sym_cache;
+
+/*
+ * ELF file and DWARF info of a binary, shared by all the bin_info
+ * instances (mappings) of the same file.
+ */
+struct bin_info_file
 {
     bt_logging_level log_level;
 
     /* Used for logging; can be `nullptr` */
     bt_self_component *self_comp;
 
-    /* Base virtual memory address. */
-    uint64_t low_addr;
-    /* Upper bound of exec address space. */
-    uint64_t high_addr;
-    /* Size of exec address space. */
-    uint64_t memsz;
+    /* Number of bin_info instances using this */
+    guint ref_count;
+    /*
+     * Cache which contains this, or `nullptr` if not shared. Weak ref.
+     * Owned by the iterator.
+     */
+    struct bin_info_file_cache *cache;
+    /* Key of this within `cache` */
+    gchar *cache_key;
     /* Paths to ELF and DWARF files. */
     gchar *elf_path;
     gchar *dwarf_path;
@@ -55,8 +84,12 @@ struct bin_info
     struct bt_fd_cache_handle *dwarf_handle;
     /* Configuration. */
     gchar *debug_info_dir;
-    /* Denotes whether the executable is position independent code. */
-    bool is_pic : 1;
+    gchar *sym_cache_dir;
+    /*
+     * Symbolization cache of `build_id`, or `nullptr` if none. Owned
+     * by this.
+     */
+    struct sym_cache *sym_cache;
     /* Denotes whether the build id in the trace matches to one on disk. */
     bool file_build_id_matches : 1;
     /*
@@ -64,8 +97,66 @@ struct bin_info
      * DWARF info.
      */
     bool is_elf_only : 1;
+    /*
+     * Denotes whether the build ID needs to be matched against the one
+     * on disk once loaded.
+     */
+    bool build_id_match_pending : 1;
+    /*
+     * Function symbols of `elf_file` sorted by address (array of
+     * `struct bin_info_elf_func_sym`), or `nullptr` if not built yet.
+     */
+    GArray *elf_func_syms;
+    /*
+     * Address ranges of the subprograms of `dwarf_info` sorted by
+     * start address (array of `struct bin_info_dwarf_func_range`), or
+     * `nullptr` if not built yet.
+     */
+    GArray *dwarf_func_ranges;
+    /*
+     * Compile units of `dwarf_info`, in order (array of owned
+     * `struct bin_info_dwarf_cu *`, each one decoded on first use), or
+     * `nullptr` if not built yet.
+     */
+    GPtrArray *dwarf_cus;
+    /*
+     * Address ranges of the compile units of `dwarf_cus` sorted by
+     * start address (array of `struct bin_info_dwarf_range`).
+     */
+    GArray *dwarf_cu_ranges;
+    /* Indexes of the compile units without address ranges (`guint`) */
+    GArray *dwarf_rangeless_cus;
     /* Weak ref. Owned by the iterator. */
     struct bt_fd_cache *fd_cache;
+    /*
+     * Loader which may load this, or `nullptr`. Weak ref. Owned by the
+     * iterator.
+     */
+    struct bin_info_loader *loader;
+    /* Protected by the mutex of `loader` */
+    enum bin_info_load_state load_state;
+};
+
+/*
+ * Mapping of a binary within the address space of a process.
+ */
+struct bin_info
+{
+    bt_logging_level log_level;
+
+    /* Used for logging; can be `nullptr` */
+    bt_self_component *self_comp;
+
+    /* Base virtual memory address. */
+    uint64_t low_addr;
+    /* Upper bound of exec address space. */
+    uint64_t high_addr;
+    /* Size of exec address space. */
+    uint64_t memsz;
+    /* Denotes whether the executable is position independent code. */
+    bool is_pic;
+    /* Mapped file; owned reference */
+    struct bin_info_file *file;
 };
 
 struct source_location
@@ -82,10 +173,34 @@ struct source_location
  */
 int bin_info_init(bt_logging_level log_level, bt_self_component *self_comp);
 
+/**
+ * Creates an empty cache of the bin_info_file instances of bin_info
+ * instances.
+ *
+ * @returns		New cache
+ */
+struct bin_info_file_cache *bin_info_file_cache_create(void);
+
+/**
+ * Destroys the cache `cache`.
+ *
+ * All the bin_info instances created with `cache` must be destroyed
+ * first.
+ *
+ * @param cache		Cache to destroy
+ */
+void bin_info_file_cache_destroy(struct bin_info_file_cache *cache);
+
 /**
  * Instantiate a structure representing an ELF executable, possibly
  * with DWARF info, located at the given path.
  *
+ * The new bin_info instance shares its ELF file and DWARF info with
+ * the other ones of `cache` having the same file (same path and
+ * modification time), as long as their build ID and debug link
+ * information match.
+ *
+ * @param cache		Cache of shared ELF files and DWARF info
  * @param path		Path to the ELF file
  * @param low_addr	Base address of the executable
  * @param memsz	In-memory size of the executable
@@ -94,14 +209,45 @@ int bin_info_init(bt_logging_level log_level, bt_self_component *self_comp);
  * @param debug_info_dir Directory containing debug info or NULL.
  * @param target_prefix  Path to the root file system of the target
  *                       or NULL.
+ * @param sym_cache_dir  Symbolization cache directory or NULL.
  * @returns		Pointer to the new bin_info on success,
  *			`nullptr` on failure.
  */
-struct bin_info *bin_info_create(struct bt_fd_cache *fdc, const char *path, uint64_t low_addr,
-                                 uint64_t memsz, bool is_pic, const char *debug_info_dir,
-                                 const char *target_prefix, bt_logging_level log_level,
+struct bin_info *bin_info_create(struct bin_info_file_cache *cache, struct bt_fd_cache *fdc,
+                                 const char *path, uint64_t low_addr, uint64_t memsz, bool is_pic,
+                                 const char *debug_info_dir, const char *target_prefix,
+                                 const char *sym_cache_dir, bt_logging_level log_level,
                                  bt_self_component *self_comp);
 
+/**
+ * Creates a loader of bin_info instances, which opens and indexes
+ * their ELF files and DWARF info with worker threads.
+ *
+ * @returns		New loader
+ */
+struct bin_info_loader *bin_info_loader_create(void);
+
+/**
+ * Destroys the loader `loader`.
+ *
+ * All the bin_info instances which `loader` may load must be
+ * destroyed first.
+ *
+ * @param loader	Loader to destroy
+ */
+void bin_info_loader_destroy(struct bin_info_loader *loader);
+
+/**
+ * Starts loading the ELF file and DWARF info of `bin` with `loader`.
+ *
+ * The lookup functions wait for the loader to finish, if needed, and
+ * load what's missing lazily as usual.
+ *
+ * @param bin		bin_info instance to load
+ * @param loader	Loader
+ */
+void bin_info_start_loading(struct bin_info *bin, struct bin_info_loader *loader);
+
 /**
  * Destroy the given bin_info instance
  *
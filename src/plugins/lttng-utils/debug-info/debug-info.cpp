@@ -33,6 +33,16 @@
 #define DEFAULT_DEBUG_INFO_FIELD_NAME "debug_info"
 #define LTTNG_UST_STATEDUMP_PREFIX    "lttng_ust"
 
+/*
+ * Initial and maximum numbers of entries of the IP to debug info
+ * source cache of a process.
+ */
+#define DEBUG_INFO_SRC_CACHE_INIT_CAPACITY 64
+#define DEBUG_INFO_SRC_CACHE_MAX_CAPACITY  4096
+
+/* No entry index within a `struct debug_info_src_cache` */
+#define DEBUG_INFO_SRC_CACHE_NIL G_MAXUINT
+
 struct debug_info_component
 {
     bt_logging_level log_level;
@@ -41,6 +51,7 @@ struct debug_info_component
     gchar *arg_debug_dir;
     gchar *arg_debug_info_field_name;
     gchar *arg_target_prefix;
+    gchar *arg_cache_dir;
     bt_bool arg_full_path;
 };
 
@@ -57,30 +68,78 @@ struct debug_info_msg_iter
     GHashTable *debug_info_map;
 
     struct bt_fd_cache fd_cache;
+
+    /* Loads the ELF files and DWARF info of new binaries; owned */
+    struct bin_info_loader *bin_loader;
+
+    /* ELF files and DWARF info shared by the binaries; owned */
+    struct bin_info_file_cache *bin_file_cache;
 };
 
 struct debug_info_source
 {
-    /* Strings are owned by debug_info_source. */
-    gchar *func;
+    /*
+     * Strings are references to the string pool of the owning
+     * `struct debug_info` (see string_pool_get()).
+     */
+    const gchar *func;
     /*
      * Store the line number as a string so that the allocation and
      * conversion to string is only done once.
      */
-    gchar *line_no;
-    gchar *src_path;
+    const gchar *line_no;
+    const gchar *src_path;
     /* short_src_path points inside src_path, no need to free. */
     const gchar *short_src_path;
-    gchar *bin_path;
+    const gchar *bin_path;
     /* short_bin_path points inside bin_path, no need to free. */
     const gchar *short_bin_path;
     /*
      * Location within the binary. Either absolute (@0x1234) or
      * relative (+0x4321).
+     *
+     * Specific to an IP, therefore owned by debug_info_source.
      */
     gchar *bin_loc;
 };
 
+struct debug_info_src_cache_entry
+{
+    uint64_t ip;
+
+    /* Owned by the cache */
+    struct debug_info_source *src;
+
+    /* Previous and next entries in recency order */
+    guint prev;
+    guint next;
+};
+
+/*
+ * Bounded IP to debug info source cache, evicting the least recently
+ * used entry when full.
+ *
+ * `entries` is an array of `capacity` entries of which the first `len`
+ * ones are used, and `slots` is an open addressing (linear probing)
+ * hash table of twice as many entry indexes.
+ */
+struct debug_info_src_cache
+{
+    struct debug_info_src_cache_entry *entries;
+    guint capacity;
+    guint len;
+
+    /* Entry indexes, `DEBUG_INFO_SRC_CACHE_NIL` if free */
+    guint *slots;
+
+    /* Most and least recently used entries */
+    guint head;
+    guint tail;
+
+    /* String pool of the sources; weak */
+    GHashTable *string_pool;
+};
+
 struct proc_debug_info_sources
 {
     /*
@@ -89,11 +148,8 @@ struct proc_debug_info_sources
      */
     GHashTable *baddr_to_bin_info;
 
-    /*
-     * Hash table: IP (pointer to uint64_t) to (struct debug_info_source *);
-     * owned by proc_debug_info_sources.
-     */
-    GHashTable *ip_to_debug_info_src;
+    /* IP to debug info source cache */
+    struct debug_info_src_cache debug_info_src_cache;
 };
 
 struct debug_info
@@ -109,6 +165,13 @@ struct debug_info
      * (struct proc_debug_info_sources*); owned by debug_info.
      */
     GHashTable *vpid_to_proc_dbg_info_src;
+
+    /*
+     * String pool of the debug info sources of all the processes:
+     * owned string to reference count (`guint`); owned by debug_info.
+     */
+    GHashTable *src_string_pool;
+
     GQuark q_statedump_bin_info;
     GQuark q_statedump_debug_link;
     GQuark q_statedump_build_id;
@@ -117,6 +180,8 @@ struct debug_info
     GQuark q_lib_load;
     GQuark q_lib_unload;
     struct bt_fd_cache *fd_cache; /* Weak ref. Owned by the iterator. */
+    struct bin_info_loader *bin_loader; /* Weak ref. Owned by the iterator. */
+    struct bin_info_file_cache *bin_file_cache; /* Weak ref. Owned by the iterator. */
 };
 
 static int debug_info_init(struct debug_info *info)
@@ -132,26 +197,74 @@ static int debug_info_init(struct debug_info *info)
     return bin_info_init(info->log_level, info->self_comp);
 }
 
-static void debug_info_source_destroy(struct debug_info_source *debug_info_src)
+/*
+ * Returns an interned copy of `str` from the string pool `pool`,
+ * incrementing its reference count.
+ *
+ * Release the returned string with string_pool_put().
+ */
+static const gchar *string_pool_get(GHashTable *pool, const gchar *str)
+{
+    gpointer key, value;
+
+    if (g_hash_table_lookup_extended(pool, str, &key, &value)) {
+        g_hash_table_insert(pool, key, GUINT_TO_POINTER(GPOINTER_TO_UINT(value) + 1));
+        return static_cast<const gchar *>(key);
+    }
+
+    key = g_strdup(str);
+    g_hash_table_insert(pool, key, GUINT_TO_POINTER(1));
+    return static_cast<const gchar *>(key);
+}
+
+/*
+ * Releases the string `str` of the string pool `pool` (returned by
+ * string_pool_get()).
+ */
+static void string_pool_put(GHashTable *pool, const gchar *str)
+{
+    gpointer key, value;
+    gboolean found;
+
+    if (!str) {
+        return;
+    }
+
+    found = g_hash_table_lookup_extended(pool, str, &key, &value);
+    BT_ASSERT(found);
+    BT_ASSERT(GPOINTER_TO_UINT(value) > 0);
+
+    if (GPOINTER_TO_UINT(value) == 1) {
+        g_hash_table_remove(pool, key);
+    } else {
+        g_hash_table_insert(pool, key, GUINT_TO_POINTER(GPOINTER_TO_UINT(value) - 1));
+    }
+}
+
+static void debug_info_source_destroy(struct debug_info_source *debug_info_src,
+                                      GHashTable *string_pool)
 {
     if (!debug_info_src) {
         return;
     }
 
-    g_free(debug_info_src->func);
-    g_free(debug_info_src->line_no);
-    g_free(debug_info_src->src_path);
-    g_free(debug_info_src->bin_path);
+    string_pool_put(string_pool, debug_info_src->func);
+    string_pool_put(string_pool, debug_info_src->line_no);
+    string_pool_put(string_pool, debug_info_src->src_path);
+    string_pool_put(string_pool, debug_info_src->bin_path);
     g_free(debug_info_src->bin_loc);
     g_free(debug_info_src);
 }
 
-static struct debug_info_source *
-debug_info_source_create_from_bin(struct bin_info *bin, uint64_t ip, bt_self_component *self_comp)
+static struct debug_info_source *debug_info_source_create_from_bin(struct bin_info *bin,
+                                                                   uint64_t ip,
+                                                                   GHashTable *string_pool,
+                                                                   bt_self_component *self_comp)
 {
     int ret;
     struct debug_info_source *debug_info_src = nullptr;
     struct source_location *src_loc = nullptr;
+    char *func = nullptr;
     bt_logging_level log_level;
 
     BT_ASSERT(bin);
@@ -165,13 +278,18 @@ debug_info_source_create_from_bin(struct bin_info *bin, uint64_t ip, bt_self_com
     }
 
     /* Lookup function name */
-    ret = bin_info_lookup_function_name(bin, ip, &debug_info_src->func);
+    ret = bin_info_lookup_function_name(bin, ip, &func);
     if (ret) {
         goto error;
     }
 
+    if (func) {
+        debug_info_src->func = string_pool_get(string_pool, func);
+        free(func);
+    }
+
     /* Can't retrieve src_loc from ELF, or could not find binary, skip. */
-    if (!bin->is_elf_only || !debug_info_src->func) {
+    if (!bin->file->is_elf_only || !debug_info_src->func) {
         /* Lookup source location */
         ret = bin_info_lookup_source_location(bin, ip, &src_loc);
         if (ret) {
@@ -180,29 +298,21 @@ debug_info_source_create_from_bin(struct bin_info *bin, uint64_t ip, bt_self_com
     }
 
     if (src_loc) {
-        debug_info_src->line_no = g_strdup_printf("%" PRId64, src_loc->line_no);
-        if (!debug_info_src->line_no) {
-            BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Error occurred when setting `line_no` field.");
-            goto error;
-        }
+        /* Maximum length of a signed 64-bit integer, with `\0` */
+        gchar line_no[21];
 
-        if (src_loc->filename) {
-            debug_info_src->src_path = g_strdup(src_loc->filename);
-            if (!debug_info_src->src_path) {
-                goto error;
-            }
+        g_snprintf(line_no, sizeof(line_no), "%" PRId64, src_loc->line_no);
+        debug_info_src->line_no = string_pool_get(string_pool, line_no);
 
+        if (src_loc->filename) {
+            debug_info_src->src_path = string_pool_get(string_pool, src_loc->filename);
             debug_info_src->short_src_path = get_filename_from_path(debug_info_src->src_path);
         }
         source_location_destroy(src_loc);
     }
 
-    if (bin->elf_path) {
-        debug_info_src->bin_path = g_strdup(bin->elf_path);
-        if (!debug_info_src->bin_path) {
-            goto error;
-        }
-
+    if (bin->file->elf_path) {
+        debug_info_src->bin_path = string_pool_get(string_pool, bin->file->elf_path);
         debug_info_src->short_bin_path = get_filename_from_path(debug_info_src->bin_path);
 
         ret = bin_info_get_bin_loc(bin, ip, &(debug_info_src->bin_loc));
@@ -215,10 +325,216 @@ end:
     return debug_info_src;
 
 error:
-    debug_info_source_destroy(debug_info_src);
+    debug_info_source_destroy(debug_info_src, string_pool);
     return nullptr;
 }
 
+static inline guint debug_info_src_cache_slot_mask(struct debug_info_src_cache *cache)
+{
+    return cache->capacity * 2 - 1;
+}
+
+static inline guint debug_info_src_cache_home_slot(struct debug_info_src_cache *cache,
+                                                   uint64_t ip)
+{
+    /* Fibonacci hashing: IPs are often close to each other */
+    return (guint) ((ip * UINT64_C(0x9e3779b97f4a7c15)) >> 32) &
+           debug_info_src_cache_slot_mask(cache);
+}
+
+/*
+ * Returns the slot of the entry of `ip` within `cache`, or the free
+ * slot where to put it if there's none.
+ */
+static guint debug_info_src_cache_find_slot(struct debug_info_src_cache *cache, uint64_t ip)
+{
+    const guint mask = debug_info_src_cache_slot_mask(cache);
+    guint slot = debug_info_src_cache_home_slot(cache, ip);
+
+    /* At most half of the slots are used: this always ends */
+    while (cache->slots[slot] != DEBUG_INFO_SRC_CACHE_NIL &&
+           cache->entries[cache->slots[slot]].ip != ip) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/*
+ * Frees the slot `slot` of `cache`, moving back the following entries
+ * of the same probe sequence so that no tombstone is needed.
+ */
+static void debug_info_src_cache_free_slot(struct debug_info_src_cache *cache, guint slot)
+{
+    const guint mask = debug_info_src_cache_slot_mask(cache);
+    guint hole = slot;
+
+    for (guint i = (slot + 1) & mask; cache->slots[i] != DEBUG_INFO_SRC_CACHE_NIL;
+         i = (i + 1) & mask) {
+        const guint home =
+            debug_info_src_cache_home_slot(cache, cache->entries[cache->slots[i]].ip);
+
+        /* Can the entry of `i` move back to `hole`? */
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            cache->slots[hole] = cache->slots[i];
+            hole = i;
+        }
+    }
+
+    cache->slots[hole] = DEBUG_INFO_SRC_CACHE_NIL;
+}
+
+static void debug_info_src_cache_unlink(struct debug_info_src_cache *cache, guint index)
+{
+    struct debug_info_src_cache_entry *entry = &cache->entries[index];
+
+    if (entry->prev == DEBUG_INFO_SRC_CACHE_NIL) {
+        cache->head = entry->next;
+    } else {
+        cache->entries[entry->prev].next = entry->next;
+    }
+
+    if (entry->next == DEBUG_INFO_SRC_CACHE_NIL) {
+        cache->tail = entry->prev;
+    } else {
+        cache->entries[entry->next].prev = entry->prev;
+    }
+}
+
+static void debug_info_src_cache_push_front(struct debug_info_src_cache *cache, guint index)
+{
+    struct debug_info_src_cache_entry *entry = &cache->entries[index];
+
+    entry->prev = DEBUG_INFO_SRC_CACHE_NIL;
+    entry->next = cache->head;
+
+    if (cache->head == DEBUG_INFO_SRC_CACHE_NIL) {
+        cache->tail = index;
+    } else {
+        cache->entries[cache->head].prev = index;
+    }
+
+    cache->head = index;
+}
+
+/*
+ * Sets the capacity of `cache` to `capacity` entries, rehashing its
+ * current entries.
+ */
+static void debug_info_src_cache_set_capacity(struct debug_info_src_cache *cache, guint capacity)
+{
+    cache->capacity = capacity;
+    cache->entries = g_renew(struct debug_info_src_cache_entry, cache->entries, capacity);
+    g_free(cache->slots);
+    cache->slots = g_new(guint, capacity * 2);
+
+    for (guint i = 0; i < capacity * 2; ++i) {
+        cache->slots[i] = DEBUG_INFO_SRC_CACHE_NIL;
+    }
+
+    for (guint i = 0; i < cache->len; ++i) {
+        cache->slots[debug_info_src_cache_find_slot(cache, cache->entries[i].ip)] = i;
+    }
+}
+
+static void debug_info_src_cache_init(struct debug_info_src_cache *cache, GHashTable *string_pool)
+{
+    cache->entries = nullptr;
+    cache->slots = nullptr;
+    cache->len = 0;
+    cache->head = DEBUG_INFO_SRC_CACHE_NIL;
+    cache->tail = DEBUG_INFO_SRC_CACHE_NIL;
+    cache->string_pool = string_pool;
+    debug_info_src_cache_set_capacity(cache, DEBUG_INFO_SRC_CACHE_INIT_CAPACITY);
+}
+
+/*
+ * Removes all the entries of `cache`.
+ */
+static void debug_info_src_cache_clear(struct debug_info_src_cache *cache)
+{
+    for (guint i = 0; i < cache->len; ++i) {
+        debug_info_source_destroy(cache->entries[i].src, cache->string_pool);
+    }
+
+    for (guint i = 0; i < cache->capacity * 2; ++i) {
+        cache->slots[i] = DEBUG_INFO_SRC_CACHE_NIL;
+    }
+
+    cache->len = 0;
+    cache->head = DEBUG_INFO_SRC_CACHE_NIL;
+    cache->tail = DEBUG_INFO_SRC_CACHE_NIL;
+}
+
+static void debug_info_src_cache_fini(struct debug_info_src_cache *cache)
+{
+    if (!cache->entries) {
+        return;
+    }
+
+    debug_info_src_cache_clear(cache);
+    g_free(cache->entries);
+    cache->entries = nullptr;
+    g_free(cache->slots);
+    cache->slots = nullptr;
+}
+
+/*
+ * Returns the cached debug info source of `ip`, or `nullptr` if none,
+ * making it the most recently used entry.
+ */
+static struct debug_info_source *debug_info_src_cache_lookup(struct debug_info_src_cache *cache,
+                                                             uint64_t ip)
+{
+    const guint index = cache->slots[debug_info_src_cache_find_slot(cache, ip)];
+
+    if (index == DEBUG_INFO_SRC_CACHE_NIL) {
+        return nullptr;
+    }
+
+    if (index != cache->head) {
+        debug_info_src_cache_unlink(cache, index);
+        debug_info_src_cache_push_front(cache, index);
+    }
+
+    return cache->entries[index].src;
+}
+
+/*
+ * Adds the debug info source `src` of `ip`, which `cache` must not
+ * contain, to `cache`, evicting the least recently used entry if it's
+ * full.
+ *
+ * `cache` takes the ownership of `src`, which remains valid until the
+ * next call to this function or to debug_info_src_cache_clear().
+ */
+static void debug_info_src_cache_add(struct debug_info_src_cache *cache, uint64_t ip,
+                                     struct debug_info_source *src)
+{
+    guint index;
+
+    if (cache->len == cache->capacity && cache->capacity < DEBUG_INFO_SRC_CACHE_MAX_CAPACITY) {
+        debug_info_src_cache_set_capacity(cache, cache->capacity * 2);
+    }
+
+    if (cache->len < cache->capacity) {
+        index = cache->len;
+        ++cache->len;
+    } else {
+        /* Evict least recently used entry */
+        index = cache->tail;
+        debug_info_src_cache_free_slot(
+            cache, debug_info_src_cache_find_slot(cache, cache->entries[index].ip));
+        debug_info_src_cache_unlink(cache, index);
+        debug_info_source_destroy(cache->entries[index].src, cache->string_pool);
+    }
+
+    cache->entries[index].ip = ip;
+    cache->entries[index].src = src;
+    cache->slots[debug_info_src_cache_find_slot(cache, ip)] = index;
+    debug_info_src_cache_push_front(cache, index);
+}
+
 static void proc_debug_info_sources_destroy(struct proc_debug_info_sources *proc_dbg_info_src)
 {
     if (!proc_dbg_info_src) {
@@ -229,14 +545,12 @@ static void proc_debug_info_sources_destroy(struct proc_debug_info_sources *proc
         g_hash_table_destroy(proc_dbg_info_src->baddr_to_bin_info);
     }
 
-    if (proc_dbg_info_src->ip_to_debug_info_src) {
-        g_hash_table_destroy(proc_dbg_info_src->ip_to_debug_info_src);
-    }
+    debug_info_src_cache_fini(&proc_dbg_info_src->debug_info_src_cache);
 
     g_free(proc_dbg_info_src);
 }
 
-static struct proc_debug_info_sources *proc_debug_info_sources_create(void)
+static struct proc_debug_info_sources *proc_debug_info_sources_create(GHashTable *string_pool)
 {
     struct proc_debug_info_sources *proc_dbg_info_src = nullptr;
 
@@ -251,12 +565,7 @@ static struct proc_debug_info_sources *proc_debug_info_sources_create(void)
         goto error;
     }
 
-    proc_dbg_info_src->ip_to_debug_info_src =
-        g_hash_table_new_full(g_int64_hash, g_int64_equal, (GDestroyNotify) g_free,
-                              (GDestroyNotify) debug_info_source_destroy);
-    if (!proc_dbg_info_src->ip_to_debug_info_src) {
-        goto error;
-    }
+    debug_info_src_cache_init(&proc_dbg_info_src->debug_info_src_cache, string_pool);
 
 end:
     return proc_dbg_info_src;
@@ -266,9 +575,10 @@ error:
     return nullptr;
 }
 
-static struct proc_debug_info_sources *proc_debug_info_sources_ht_get_entry(GHashTable *ht,
-                                                                            int64_t vpid)
+static struct proc_debug_info_sources *
+proc_debug_info_sources_ht_get_entry(struct debug_info *debug_info, int64_t vpid)
 {
+    GHashTable *ht = debug_info->vpid_to_proc_dbg_info_src;
     gpointer key = g_new0(int64_t, 1);
     struct proc_debug_info_sources *proc_dbg_info_src = nullptr;
 
@@ -285,7 +595,7 @@ static struct proc_debug_info_sources *proc_debug_info_sources_ht_get_entry(GHas
     }
 
     /* Otherwise, create and return it */
-    proc_dbg_info_src = proc_debug_info_sources_create();
+    proc_dbg_info_src = proc_debug_info_sources_create(debug_info->src_string_pool);
     if (!proc_dbg_info_src) {
         goto end;
     }
@@ -401,19 +711,11 @@ proc_debug_info_sources_get_entry(struct debug_info *debug_info,
                                   struct proc_debug_info_sources *proc_dbg_info_src, uint64_t ip)
 {
     struct debug_info_source *debug_info_src = nullptr;
-    gpointer key = g_new0(uint64_t, 1);
     GHashTableIter iter;
     gpointer baddr, value;
 
-    if (!key) {
-        goto end;
-    }
-
-    *((uint64_t *) key) = ip;
-
-    /* Look in IP to debug infos hash table first. */
-    debug_info_src = static_cast<debug_info_source *>(
-        g_hash_table_lookup(proc_dbg_info_src->ip_to_debug_info_src, key));
+    /* Look in IP to debug infos cache first. */
+    debug_info_src = debug_info_src_cache_lookup(&proc_dbg_info_src->debug_info_src_cache, ip);
     if (debug_info_src) {
         goto end;
     }
@@ -431,21 +733,20 @@ proc_debug_info_sources_get_entry(struct debug_info *debug_info,
         /*
          * Found; add it to cache.
          *
-         * FIXME: this should be bounded in size (and implement
-         * a caching policy), and entries should be prunned when
-         * libraries are unmapped.
+         * FIXME: entries should be pruned when libraries are
+         * unmapped.
          */
-        debug_info_src = debug_info_source_create_from_bin(bin, ip, debug_info->self_comp);
+        debug_info_src = debug_info_source_create_from_bin(bin, ip, debug_info->src_string_pool,
+                                                           debug_info->self_comp);
         if (debug_info_src) {
-            g_hash_table_insert(proc_dbg_info_src->ip_to_debug_info_src, key, debug_info_src);
-            /* Ownership passed to ht. */
-            key = nullptr;
+            /* Ownership passed to cache. */
+            debug_info_src_cache_add(&proc_dbg_info_src->debug_info_src_cache, ip,
+                                     debug_info_src);
         }
         break;
     }
 
 end:
-    free(key);
     return debug_info_src;
 }
 
@@ -455,8 +756,7 @@ static struct debug_info_source *debug_info_query(struct debug_info *debug_info,
     struct debug_info_source *dbg_info_src = nullptr;
     struct proc_debug_info_sources *proc_dbg_info_src;
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         goto end;
     }
@@ -468,7 +768,9 @@ end:
 }
 
 static struct debug_info *debug_info_create(struct debug_info_component *comp,
-                                            const bt_trace *trace, struct bt_fd_cache *fdc)
+                                            const bt_trace *trace, struct bt_fd_cache *fdc,
+                                            struct bin_info_loader *bin_loader,
+                                            struct bin_info_file_cache *bin_file_cache)
 {
     int ret;
     struct debug_info *debug_info;
@@ -484,6 +786,11 @@ static struct debug_info *debug_info_create(struct debug_info_component *comp,
 
     debug_info->log_level = comp->log_level;
     debug_info->self_comp = comp->self_comp;
+    debug_info->src_string_pool = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, nullptr);
+    if (!debug_info->src_string_pool) {
+        goto error;
+    }
+
     debug_info->vpid_to_proc_dbg_info_src =
         g_hash_table_new_full(g_int64_hash, g_int64_equal, (GDestroyNotify) g_free,
                               (GDestroyNotify) proc_debug_info_sources_destroy);
@@ -499,10 +806,20 @@ static struct debug_info *debug_info_create(struct debug_info_component *comp,
 
     debug_info->input_trace = trace;
     debug_info->fd_cache = fdc;
+    debug_info->bin_loader = bin_loader;
+    debug_info->bin_file_cache = bin_file_cache;
 
 end:
     return debug_info;
 error:
+    if (debug_info->vpid_to_proc_dbg_info_src) {
+        g_hash_table_destroy(debug_info->vpid_to_proc_dbg_info_src);
+    }
+
+    if (debug_info->src_string_pool) {
+        g_hash_table_destroy(debug_info->src_string_pool);
+    }
+
     g_free(debug_info);
     return nullptr;
 }
@@ -523,6 +840,11 @@ static void debug_info_destroy(struct debug_info *debug_info)
         g_hash_table_destroy(debug_info->vpid_to_proc_dbg_info_src);
     }
 
+    /* After the sources which reference its strings */
+    if (debug_info->src_string_pool) {
+        g_hash_table_destroy(debug_info->src_string_pool);
+    }
+
     remove_listener_status = bt_trace_remove_destruction_listener(
         debug_info->input_trace, debug_info->destruction_listener_id);
     if (remove_listener_status != BT_TRACE_REMOVE_LISTENER_STATUS_OK) {
@@ -547,8 +869,7 @@ static void handle_event_statedump_build_id(struct debug_info *debug_info, const
     event_get_common_context_signed_integer_field_value(event, VPID_FIELD_NAME, &vpid);
     event_get_payload_unsigned_integer_field_value(event, BADDR_FIELD_NAME, &baddr);
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         goto end;
     }
@@ -572,18 +893,16 @@ static void handle_event_statedump_build_id(struct debug_info *debug_info, const
 
     event_get_payload_build_id_value(event, BUILD_ID_FIELD_NAME, build_id);
 
+    /*
+     * On success, this resets the ELF only flag of the binary in case
+     * it had been set previously, because we might find separate debug
+     * info using the new build ID information.
+     */
     ret = bin_info_set_build_id(bin, build_id, build_id_len);
     if (ret) {
         goto end;
     }
 
-    /*
-     * Reset the is_elf_only flag in case it had been set
-     * previously, because we might find separate debug info using
-     * the new build id information.
-     */
-    bin->is_elf_only = false;
-
 end:
     g_free(build_id);
     return;
@@ -609,8 +928,7 @@ static void handle_event_statedump_debug_link(struct debug_info *debug_info, con
 
     event_get_payload_string_field_value(event, FILENAME_FIELD_NAME, &filename);
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         goto end;
     }
@@ -675,8 +993,7 @@ static void handle_bin_info_event(struct debug_info *debug_info, const bt_event
 
     event_get_common_context_signed_integer_field_value(event, VPID_FIELD_NAME, &vpid);
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         goto end;
     }
@@ -693,8 +1010,9 @@ static void handle_bin_info_event(struct debug_info *debug_info, const bt_event
         goto end;
     }
 
-    bin = bin_info_create(debug_info->fd_cache, path, baddr, memsz, is_pic,
-                          debug_info->comp->arg_debug_dir, debug_info->comp->arg_target_prefix,
+    bin = bin_info_create(debug_info->bin_file_cache, debug_info->fd_cache, path, baddr, memsz,
+                          is_pic, debug_info->comp->arg_debug_dir,
+                          debug_info->comp->arg_target_prefix, debug_info->comp->arg_cache_dir,
                           debug_info->log_level, debug_info->self_comp);
     if (!bin) {
         goto end;
@@ -704,6 +1022,9 @@ static void handle_bin_info_event(struct debug_info *debug_info, const bt_event
     /* Ownership passed to ht. */
     key = nullptr;
 
+    /* Get a head start on the first lookup into this binary */
+    bin_info_start_loading(bin, debug_info->bin_loader);
+
 end:
     g_free(key);
     return;
@@ -731,8 +1052,7 @@ static void handle_event_lib_unload(struct debug_info *debug_info, const bt_even
 
     event_get_common_context_signed_integer_field_value(event, VPID_FIELD_NAME, &vpid);
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         /*
          * It's an unload event for a library for which no load event
@@ -754,14 +1074,13 @@ static void handle_event_statedump_start(struct debug_info *debug_info, const bt
 
     event_get_common_context_signed_integer_field_value(event, VPID_FIELD_NAME, &vpid);
 
-    proc_dbg_info_src =
-        proc_debug_info_sources_ht_get_entry(debug_info->vpid_to_proc_dbg_info_src, vpid);
+    proc_dbg_info_src = proc_debug_info_sources_ht_get_entry(debug_info, vpid);
     if (!proc_dbg_info_src) {
         goto end;
     }
 
     g_hash_table_remove_all(proc_dbg_info_src->baddr_to_bin_info);
-    g_hash_table_remove_all(proc_dbg_info_src->ip_to_debug_info_src);
+    debug_info_src_cache_clear(&proc_dbg_info_src->debug_info_src_cache);
 
 end:
     return;
@@ -799,7 +1118,8 @@ static void handle_event_statedump(struct debug_info_msg_iter *debug_it, const b
     if (!debug_info) {
         bt_trace_add_listener_status add_listener_status;
 
-        debug_info = debug_info_create(debug_it->debug_info_component, trace, &debug_it->fd_cache);
+        debug_info = debug_info_create(debug_it->debug_info_component, trace, &debug_it->fd_cache,
+                                       debug_it->bin_loader, debug_it->bin_file_cache);
         g_hash_table_insert(debug_it->debug_info_map, (gpointer) trace, debug_info);
         add_listener_status = bt_trace_add_destruction_listener(
             trace, trace_debug_info_remove_func, debug_it, &debug_info->destruction_listener_id);
@@ -847,6 +1167,7 @@ static void destroy_debug_info_comp(struct debug_info_component *debug_info)
     g_free(debug_info->arg_debug_dir);
     g_free(debug_info->arg_debug_info_field_name);
     g_free(debug_info->arg_target_prefix);
+    g_free(debug_info->arg_cache_dir);
     g_free(debug_info);
 }
 
@@ -1024,12 +1345,15 @@ static void fill_debug_info_field(struct debug_info *debug_info, int64_t vpid, u
         debug_info->log_level, debug_info->self_comp);
 }
 
-static void fill_debug_info_event_if_needed(struct debug_info_msg_iter *debug_it,
-                                            const bt_event *in_event, bt_event *out_event)
+/*
+ * `out_event` must have a debug info field (see
+ * stream_class_has_debug_info_field()).
+ */
+static void fill_debug_info_event(struct debug_info_msg_iter *debug_it, const bt_event *in_event,
+                                  bt_event *out_event)
 {
     bt_field *out_common_ctx_field, *out_debug_info_field;
-    const bt_field *vpid_field, *ip_field, *in_common_ctx_field;
-    const bt_field_class *in_common_ctx_fc;
+    const bt_field *vpid_field, *ip_field;
     struct debug_info *debug_info;
     uint64_t vpid;
     int64_t ip;
@@ -1037,25 +1361,6 @@ static void fill_debug_info_event_if_needed(struct debug_info_msg_iter *debug_it
     bt_logging_level log_level = debug_it->log_level;
     bt_self_component *self_comp = debug_it->self_comp;
 
-    in_common_ctx_field = bt_event_borrow_common_context_field_const(in_event);
-    if (!in_common_ctx_field) {
-        /*
-         * There is no event common context so no need to add debug
-         * info field.
-         */
-        goto end;
-    }
-
-    in_common_ctx_fc = bt_field_borrow_class_const(in_common_ctx_field);
-    if (!is_event_common_ctx_dbg_info_compatible(in_common_ctx_fc,
-                                                 debug_it->ir_maps->debug_info_field_class_name)) {
-        /*
-         * The input event common context does not have the necessary
-         * fields to resolve debug information.
-         */
-        goto end;
-    }
-
     /* Borrow the debug-info field. */
     out_common_ctx_field = bt_event_borrow_common_context_field(out_event);
     if (!out_common_ctx_field) {
@@ -1099,32 +1404,48 @@ end:
 static void update_event_statedump_if_needed(struct debug_info_msg_iter *debug_it,
                                              const bt_event *in_event)
 {
-    const bt_field *event_common_ctx;
-    const bt_field_class *event_common_ctx_fc;
     const bt_event_class *in_event_class = bt_event_borrow_class_const(in_event);
 
     /*
-     * If the event is an lttng_ust_statedump event AND has the right event
-     * common context fields update the debug-info view for this process.
+     * The caller checked that the event has the right event common
+     * context fields: if it's an lttng_ust_statedump event, update the
+     * debug-info view for this process.
      */
-    event_common_ctx = bt_event_borrow_common_context_field_const(in_event);
-    if (!event_common_ctx) {
-        goto end;
+    const char *in_event_name = bt_event_class_get_name(in_event_class);
+    if (strncmp(in_event_name, LTTNG_UST_STATEDUMP_PREFIX, strlen(LTTNG_UST_STATEDUMP_PREFIX)) ==
+        0) {
+        /* Handle statedump events. */
+        handle_event_statedump(debug_it, in_event);
     }
+}
 
-    event_common_ctx_fc = bt_field_borrow_class_const(event_common_ctx);
-    if (is_event_common_ctx_dbg_info_compatible(event_common_ctx_fc,
-                                                debug_it->ir_maps->debug_info_field_class_name)) {
-        /* Checkout if it might be a one of lttng ust statedump events. */
-        const char *in_event_name = bt_event_class_get_name(in_event_class);
-        if (strncmp(in_event_name, LTTNG_UST_STATEDUMP_PREFIX,
-                    strlen(LTTNG_UST_STATEDUMP_PREFIX)) == 0) {
-            /* Handle statedump events. */
-            handle_event_statedump(debug_it, in_event);
-        }
+/*
+ * Returns whether or not the event common context field class of
+ * `out_stream_class`, the mapping of `in_stream_class`, has a debug
+ * info field.
+ *
+ * When copying the stream class, the metadata copy only appends a
+ * debug info member to a common context field class which
+ * is_event_common_ctx_dbg_info_compatible() accepts: comparing the
+ * member counts tells the result of this check, once for all, without
+ * looking up members by name for each event.
+ */
+static bool stream_class_has_debug_info_field(const bt_stream_class *in_stream_class,
+                                              const bt_stream_class *out_stream_class)
+{
+    const bt_field_class *in_common_ctx_fc =
+        bt_stream_class_borrow_event_common_context_field_class_const(in_stream_class);
+
+    if (!in_common_ctx_fc) {
+        return false;
     }
-end:
-    return;
+
+    const bt_field_class *out_common_ctx_fc =
+        bt_stream_class_borrow_event_common_context_field_class_const(out_stream_class);
+
+    BT_ASSERT_DBG(out_common_ctx_fc);
+    return bt_field_class_structure_get_member_count(out_common_ctx_fc) !=
+           bt_field_class_structure_get_member_count(in_common_ctx_fc);
 }
 
 static bt_message *handle_event_message(struct debug_info_msg_iter *debug_it,
@@ -1147,8 +1468,6 @@ static bt_message *handle_event_message(struct debug_info_msg_iter *debug_it,
     const bt_event *in_event = bt_message_event_borrow_event_const(in_message);
     const bt_event_class *in_event_class = bt_event_borrow_class_const(in_event);
 
-    update_event_statedump_if_needed(debug_it, in_event);
-
     out_event_class = trace_ir_mapping_borrow_mapped_event_class(debug_it->ir_maps, in_event_class);
     if (!out_event_class) {
         out_event_class =
@@ -1156,6 +1475,18 @@ static bt_message *handle_event_message(struct debug_info_msg_iter *debug_it,
     }
     BT_ASSERT_DBG(out_event_class);
 
+    /*
+     * Most events, for example all the kernel ones, have no debug
+     * info field: they only need a bulk copy of their fields.
+     */
+    const bool has_debug_info_field =
+        stream_class_has_debug_info_field(bt_event_class_borrow_stream_class_const(in_event_class),
+                                          bt_event_class_borrow_stream_class(out_event_class));
+
+    if (has_debug_info_field) {
+        update_event_statedump_if_needed(debug_it, in_event);
+    }
+
     /* Borrow the input stream. */
     in_stream = bt_event_borrow_stream_const(in_event);
     BT_ASSERT_DBG(in_stream);
@@ -1202,7 +1533,7 @@ static bt_message *handle_event_message(struct debug_info_msg_iter *debug_it,
     out_event = bt_message_event_borrow_event(out_message);
 
     /* Copy the original fields to the output event. */
-    if (copy_event_content(in_event, out_event, log_level, self_comp) !=
+    if (copy_event_content(in_event, out_event, has_debug_info_field, log_level, self_comp) !=
         DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
         BT_COMP_LOGE_APPEND_CAUSE(self_comp,
                                   "Error copying event message content output event message: "
@@ -1215,7 +1546,9 @@ static bt_message *handle_event_message(struct debug_info_msg_iter *debug_it,
      * Try to set the debug-info fields based on debug information that is
      * gathered so far.
      */
-    fill_debug_info_event_if_needed(debug_it, in_event, out_event);
+    if (has_debug_info_field) {
+        fill_debug_info_event(debug_it, in_event, out_event);
+    }
 
     goto end;
 
@@ -1534,6 +1867,8 @@ static struct bt_param_validation_map_value_entry_descr debug_info_params[] = {
      bt_param_validation_value_descr::makeString()},
     {"target-prefix", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeString()},
+    {"cache-dir", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
+     bt_param_validation_value_descr::makeString()},
     {"full-path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL,
      bt_param_validation_value_descr::makeBool()},
     BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END};
@@ -1580,6 +1915,13 @@ init_from_params(struct debug_info_component *debug_info_component, const bt_val
         debug_info_component->arg_target_prefix = nullptr;
     }
 
+    value = bt_value_map_borrow_entry_value_const(params, "cache-dir");
+    if (value) {
+        debug_info_component->arg_cache_dir = g_strdup(bt_value_string_get(value));
+    } else {
+        debug_info_component->arg_cache_dir = nullptr;
+    }
+
     value = bt_value_map_borrow_entry_value_const(params, "full-path");
     if (value) {
         debug_info_component->arg_full_path = bt_value_bool_get(value);
@@ -1786,6 +2128,9 @@ static void debug_info_msg_iter_destroy(struct debug_info_msg_iter *debug_info_m
         g_hash_table_destroy(debug_info_msg_iter->debug_info_map);
     }
 
+    /* After the bin_info instances it may load */
+    bin_info_loader_destroy(debug_info_msg_iter->bin_loader);
+    bin_info_file_cache_destroy(debug_info_msg_iter->bin_file_cache);
     bt_fd_cache_fini(&debug_info_msg_iter->fd_cache);
     g_free(debug_info_msg_iter);
 
@@ -1857,12 +2202,16 @@ debug_info_msg_iter_init(bt_self_message_iterator *self_msg_iter,
         goto error;
     }
 
-    ret = bt_fd_cache_init(&debug_info_msg_iter->fd_cache, log_level);
+    ret = bt_fd_cache_init(&debug_info_msg_iter->fd_cache, log_level,
+                           BT_FD_CACHE_DEFAULT_CAPACITY);
     if (ret) {
         status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
         goto error;
     }
 
+    debug_info_msg_iter->bin_loader = bin_info_loader_create();
+    debug_info_msg_iter->bin_file_cache = bin_info_file_cache_create();
+
     bt_self_message_iterator_configuration_set_can_seek_forward(
         config, bt_message_iterator_can_seek_forward(debug_info_msg_iter->msg_iter));
 
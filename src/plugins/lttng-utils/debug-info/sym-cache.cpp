@@ -0,0 +1,450 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * Babeltrace - Persistent Symbolization Cache
+ */
+
+#define BT_COMP_LOG_SELF_COMP (cache->self_comp)
+#define BT_LOG_OUTPUT_LEVEL   (cache->log_level)
+#define BT_LOG_TAG            "PLUGIN/FLT.LTTNG-UTILS.DEBUG-INFO/SYM-CACHE"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging/comp-logging.h"
+
+#include "common/assert.h"
+#include "compat/mman.h"
+
+#include "sym-cache.hpp"
+
+/* Result added during this run */
+struct sym_cache_new_entry
+{
+    /* Key within `sym_cache::new_entries` */
+    uint64_t addr;
+
+    guint flags;
+
+    /* Owned, or `nullptr` */
+    gchar *func;
+    gchar *src_path;
+    uint64_t line_no;
+};
+
+struct sym_cache
+{
+    bt_logging_level log_level;
+    bt_self_component *self_comp;
+
+    /* Path of the cache file */
+    gchar *path;
+
+    /* Mapped cache file, or `nullptr` if none */
+    void *map;
+    size_t map_len;
+
+    /* Within `map` */
+    const struct sym_cache_file_entry *entries;
+    uint64_t entry_count;
+    const char *strtab;
+    uint64_t strtab_size;
+
+    /*
+     * Address (pointer to `uint64_t`) to owned
+     * `struct sym_cache_new_entry *`.
+     */
+    GHashTable *new_entries;
+};
+
+static void sym_cache_new_entry_destroy(gpointer data)
+{
+    const auto entry = static_cast<sym_cache_new_entry *>(data);
+
+    g_free(entry->func);
+    g_free(entry->src_path);
+    g_free(entry);
+}
+
+/*
+ * Returns the string at offset `offset` within the string table of
+ * `cache`, or `nullptr` if none or invalid.
+ */
+static const char *sym_cache_file_str(struct sym_cache *cache, uint32_t offset)
+{
+    if (offset == SYM_CACHE_FILE_NO_STR || offset >= cache->strtab_size) {
+        return nullptr;
+    }
+
+    return &cache->strtab[offset];
+}
+
+/*
+ * Maps and validates the cache file of `cache`, if it exists.
+ */
+static void sym_cache_map_file(struct sym_cache *cache)
+{
+    const struct sym_cache_file_header *header;
+    struct stat stat_buf;
+    uint64_t file_size;
+    void *map;
+    int fd;
+
+    fd = open(cache->path, O_RDONLY);
+    if (fd < 0) {
+        BT_COMP_LOGD("No symbolization cache file: path=\"%s\"", cache->path);
+        return;
+    }
+
+    if (fstat(fd, &stat_buf) != 0 || stat_buf.st_size < (off_t) sizeof(*header)) {
+        BT_COMP_LOGI("Ignoring invalid symbolization cache file: path=\"%s\"", cache->path);
+        goto end;
+    }
+
+    file_size = stat_buf.st_size;
+    map = bt_mmap(file_size, PROT_READ, MAP_PRIVATE, fd, 0, cache->log_level);
+    if (map == MAP_FAILED) {
+        BT_COMP_LOGI("Cannot map symbolization cache file: path=\"%s\", errno=%d", cache->path,
+                     errno);
+        goto end;
+    }
+
+    header = static_cast<const sym_cache_file_header *>(map);
+
+    if (memcmp(header->magic, SYM_CACHE_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->bom != SYM_CACHE_FILE_BOM || header->version != SYM_CACHE_FILE_VERSION ||
+        header->entry_count > (file_size - sizeof(*header)) / sizeof(struct sym_cache_file_entry) ||
+        header->strtab_offset <
+            sizeof(*header) + header->entry_count * sizeof(struct sym_cache_file_entry) ||
+        header->strtab_offset > file_size ||
+        header->strtab_size > file_size - header->strtab_offset ||
+        header->strtab_size >= SYM_CACHE_FILE_NO_STR ||
+        (header->strtab_size > 0 &&
+         static_cast<const char *>(map)[header->strtab_offset + header->strtab_size - 1] != '\0')) {
+        BT_COMP_LOGI("Ignoring symbolization cache file with an unknown version or an "
+                     "invalid content: path=\"%s\"",
+                     cache->path);
+        bt_munmap(map, file_size);
+        goto end;
+    }
+
+    cache->map = map;
+    cache->map_len = file_size;
+    cache->entries = reinterpret_cast<const sym_cache_file_entry *>(header + 1);
+    cache->entry_count = header->entry_count;
+    cache->strtab = static_cast<const char *>(map) + header->strtab_offset;
+    cache->strtab_size = header->strtab_size;
+    BT_COMP_LOGD("Mapped symbolization cache file: path=\"%s\", entry-count=%" PRIu64,
+                 cache->path, cache->entry_count);
+
+end:
+    close(fd);
+}
+
+struct sym_cache *sym_cache_open(const char *dir, const uint8_t *build_id, size_t build_id_len,
+                                 bt_logging_level log_level, bt_self_component *self_comp)
+{
+    struct sym_cache *cache;
+    GString *filename;
+
+    BT_ASSERT(dir);
+    BT_ASSERT(build_id);
+
+    cache = g_new0(struct sym_cache, 1);
+    cache->log_level = log_level;
+    cache->self_comp = self_comp;
+    cache->new_entries =
+        g_hash_table_new_full(g_int64_hash, g_int64_equal, nullptr, sym_cache_new_entry_destroy);
+
+    filename = g_string_new(nullptr);
+
+    for (size_t i = 0; i < build_id_len; ++i) {
+        g_string_append_printf(filename, "%02x", build_id[i]);
+    }
+
+    g_string_append(filename, SYM_CACHE_FILE_EXT);
+    cache->path = g_build_filename(dir, filename->str, nullptr);
+    g_string_free(filename, TRUE);
+    sym_cache_map_file(cache);
+    return cache;
+}
+
+/*
+ * Returns the index of the mapped entry of `addr` within `cache`, or
+ * `entry_count` if none.
+ */
+static uint64_t sym_cache_find_file_entry(struct sym_cache *cache, uint64_t addr)
+{
+    uint64_t low = 0, high = cache->entry_count;
+
+    while (low < high) {
+        const uint64_t mid = low + (high - low) / 2;
+
+        if (cache->entries[mid].addr < addr) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < cache->entry_count && cache->entries[low].addr == addr) {
+        return low;
+    }
+
+    return cache->entry_count;
+}
+
+bool sym_cache_lookup(struct sym_cache *cache, uint64_t addr, struct sym_cache_result *result)
+{
+    const auto new_entry =
+        static_cast<sym_cache_new_entry *>(g_hash_table_lookup(cache->new_entries, &addr));
+    const uint64_t index = sym_cache_find_file_entry(cache, addr);
+
+    *result = {};
+
+    if (index < cache->entry_count) {
+        const auto entry = &cache->entries[index];
+
+        if (entry->flags & SYM_CACHE_FILE_ENTRY_FLAG_HAS_FUNC) {
+            result->has_func = true;
+            result->func = sym_cache_file_str(cache, entry->func);
+        }
+
+        if (entry->flags & SYM_CACHE_FILE_ENTRY_FLAG_HAS_SRC_LOC) {
+            result->has_src_loc = true;
+            result->src_path = sym_cache_file_str(cache, entry->src_path);
+            result->line_no = entry->line_no;
+        }
+    }
+
+    if (new_entry) {
+        if (new_entry->flags & SYM_CACHE_FILE_ENTRY_FLAG_HAS_FUNC) {
+            result->has_func = true;
+            result->func = new_entry->func;
+        }
+
+        if (new_entry->flags & SYM_CACHE_FILE_ENTRY_FLAG_HAS_SRC_LOC) {
+            result->has_src_loc = true;
+            result->src_path = new_entry->src_path;
+            result->line_no = new_entry->line_no;
+        }
+    }
+
+    return result->has_func || result->has_src_loc;
+}
+
+static struct sym_cache_new_entry *sym_cache_borrow_new_entry(struct sym_cache *cache,
+                                                              uint64_t addr)
+{
+    auto entry =
+        static_cast<sym_cache_new_entry *>(g_hash_table_lookup(cache->new_entries, &addr));
+
+    if (!entry) {
+        entry = g_new0(struct sym_cache_new_entry, 1);
+        entry->addr = addr;
+        g_hash_table_insert(cache->new_entries, &entry->addr, entry);
+    }
+
+    return entry;
+}
+
+void sym_cache_add_func(struct sym_cache *cache, uint64_t addr, const char *func)
+{
+    const auto entry = sym_cache_borrow_new_entry(cache, addr);
+
+    g_free(entry->func);
+    entry->func = g_strdup(func);
+    entry->flags |= SYM_CACHE_FILE_ENTRY_FLAG_HAS_FUNC;
+}
+
+void sym_cache_add_src_loc(struct sym_cache *cache, uint64_t addr, const char *src_path,
+                           uint64_t line_no)
+{
+    const auto entry = sym_cache_borrow_new_entry(cache, addr);
+
+    g_free(entry->src_path);
+    entry->src_path = g_strdup(src_path);
+    entry->line_no = line_no;
+    entry->flags |= SYM_CACHE_FILE_ENTRY_FLAG_HAS_SRC_LOC;
+}
+
+/*
+ * Appends the string `str` to the string table `strtab`, reusing an
+ * existing copy thanks to `offsets` (string to offset), and returns
+ * its offset.
+ */
+static uint32_t sym_cache_strtab_add(GString *strtab, GHashTable *offsets, const char *str)
+{
+    gpointer offset;
+
+    if (!str) {
+        return SYM_CACHE_FILE_NO_STR;
+    }
+
+    if (g_hash_table_lookup_extended(offsets, str, nullptr, &offset)) {
+        return GPOINTER_TO_UINT(offset);
+    }
+
+    const auto new_offset = (uint32_t) strtab->len;
+
+    g_string_append_len(strtab, str, strlen(str) + 1);
+    g_hash_table_insert(offsets, (gpointer) str, GUINT_TO_POINTER(new_offset));
+    return new_offset;
+}
+
+static gint sym_cache_file_entry_compare(gconstpointer a, gconstpointer b)
+{
+    const auto entry_a = static_cast<const sym_cache_file_entry *>(a);
+    const auto entry_b = static_cast<const sym_cache_file_entry *>(b);
+
+    return entry_a->addr < entry_b->addr ? -1 : (entry_a->addr > entry_b->addr);
+}
+
+/*
+ * Writes the mapped and new entries of `cache` to a temporary file,
+ * and then renames it to the cache file so that a concurrent reader
+ * never sees a partial file.
+ */
+static void sym_cache_write_file(struct sym_cache *cache)
+{
+    GArray *entries = g_array_new(FALSE, FALSE, sizeof(struct sym_cache_file_entry));
+    GString *strtab = g_string_new(nullptr);
+    GHashTable *offsets = g_hash_table_new(g_str_hash, g_str_equal);
+    struct sym_cache_file_header header = {};
+    gchar *tmp_path = g_strdup_printf("%s.%d.tmp", cache->path, (int) getpid());
+    gchar *dir = nullptr;
+    GHashTableIter iter;
+    gpointer value;
+    bool is_written;
+    FILE *fp;
+
+    /* Mapped entries which this run didn't replace */
+    for (uint64_t i = 0; i < cache->entry_count; ++i) {
+        struct sym_cache_result result;
+        struct sym_cache_file_entry entry = {};
+
+        entry.addr = cache->entries[i].addr;
+        sym_cache_lookup(cache, entry.addr, &result);
+
+        if (result.has_func) {
+            entry.flags |= SYM_CACHE_FILE_ENTRY_FLAG_HAS_FUNC;
+        }
+
+        if (result.has_src_loc) {
+            entry.flags |= SYM_CACHE_FILE_ENTRY_FLAG_HAS_SRC_LOC;
+        }
+
+        entry.func = sym_cache_strtab_add(strtab, offsets, result.func);
+        entry.src_path = sym_cache_strtab_add(strtab, offsets, result.src_path);
+        entry.line_no = result.line_no;
+        g_array_append_val(entries, entry);
+    }
+
+    /* New entries */
+    g_hash_table_iter_init(&iter, cache->new_entries);
+
+    while (g_hash_table_iter_next(&iter, nullptr, &value)) {
+        const auto new_entry = static_cast<const sym_cache_new_entry *>(value);
+        struct sym_cache_file_entry entry = {};
+
+        if (sym_cache_find_file_entry(cache, new_entry->addr) < cache->entry_count) {
+            /* Merged above */
+            continue;
+        }
+
+        entry.addr = new_entry->addr;
+        entry.flags = new_entry->flags;
+        entry.func = sym_cache_strtab_add(strtab, offsets, new_entry->func);
+        entry.src_path = sym_cache_strtab_add(strtab, offsets, new_entry->src_path);
+        entry.line_no = new_entry->line_no;
+        g_array_append_val(entries, entry);
+    }
+
+    if (strtab->len >= SYM_CACHE_FILE_NO_STR) {
+        BT_COMP_LOGI("Not writing symbolization cache file: string table is too large: "
+                     "path=\"%s\"",
+                     cache->path);
+        goto end;
+    }
+
+    g_array_sort(entries, sym_cache_file_entry_compare);
+    memcpy(header.magic, SYM_CACHE_FILE_MAGIC, sizeof(header.magic));
+    header.bom = SYM_CACHE_FILE_BOM;
+    header.version = SYM_CACHE_FILE_VERSION;
+    header.entry_count = entries->len;
+    header.strtab_offset = sizeof(header) + entries->len * sizeof(struct sym_cache_file_entry);
+    header.strtab_size = strtab->len;
+
+    dir = g_path_get_dirname(cache->path);
+    if (g_mkdir_with_parents(dir, 0755) != 0) {
+        BT_COMP_LOGI("Cannot create symbolization cache directory: path=\"%s\", errno=%d", dir,
+                     errno);
+        goto end;
+    }
+
+    fp = fopen(tmp_path, "wb");
+    if (!fp) {
+        BT_COMP_LOGI("Cannot create symbolization cache file: path=\"%s\", errno=%d", tmp_path,
+                     errno);
+        goto end;
+    }
+
+    is_written = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+                 (entries->len == 0 || fwrite(entries->data, sizeof(struct sym_cache_file_entry),
+                                              entries->len, fp) == entries->len) &&
+                 (strtab->len == 0 || fwrite(strtab->str, strtab->len, 1, fp) == 1);
+
+    if (fclose(fp) != 0 || !is_written) {
+        BT_COMP_LOGI("Cannot write symbolization cache file: path=\"%s\", errno=%d", tmp_path,
+                     errno);
+        (void) unlink(tmp_path);
+        goto end;
+    }
+
+    if (rename(tmp_path, cache->path) != 0) {
+        BT_COMP_LOGI("Cannot rename symbolization cache file: "
+                     "tmp-path=\"%s\", path=\"%s\", errno=%d",
+                     tmp_path, cache->path, errno);
+        (void) unlink(tmp_path);
+        goto end;
+    }
+
+    BT_COMP_LOGD("Wrote symbolization cache file: path=\"%s\", entry-count=%u", cache->path,
+                 entries->len);
+
+end:
+    g_free(dir);
+    g_free(tmp_path);
+    g_hash_table_destroy(offsets);
+    g_string_free(strtab, TRUE);
+    g_array_free(entries, TRUE);
+}
+
+void sym_cache_close(struct sym_cache *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    if (g_hash_table_size(cache->new_entries) > 0) {
+        sym_cache_write_file(cache);
+    }
+
+    g_hash_table_destroy(cache->new_entries);
+
+    if (cache->map) {
+        bt_munmap(cache->map, cache->map_len);
+    }
+
+    g_free(cache->path);
+    g_free(cache);
+}
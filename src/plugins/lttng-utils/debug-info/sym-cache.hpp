@@ -0,0 +1,147 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * Babeltrace - Persistent Symbolization Cache
+ */
+
+#ifndef BABELTRACE_PLUGINS_LTTNG_UTILS_DEBUG_INFO_SYM_CACHE_HPP
+#define BABELTRACE_PLUGINS_LTTNG_UTILS_DEBUG_INFO_SYM_CACHE_HPP
+
+#include <glib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <babeltrace2/babeltrace.h>
+
+/*
+ * A symbolization cache file, named after the build ID of a binary
+ * (`<build-id>.btsymc`) within a cache directory, contains the
+ * function names and source locations of addresses (relative to the
+ * binary) which previous runs resolved.
+ *
+ * Layout of a file, all the integers having the byte order of the
+ * host which wrote it:
+ *
+ * 1. Header (`struct sym_cache_file_header`).
+ *
+ * 2. Entries, sorted by address (`struct sym_cache_file_entry`).
+ *
+ * 3. String table: null-terminated strings which the entries refer to
+ *    by offset.
+ *
+ * A reader memory-maps the file and binary searches its entries
+ * directly. It ignores a file with an unknown version or byte order.
+ */
+#define SYM_CACHE_FILE_MAGIC   "BTSYMC\0"
+#define SYM_CACHE_FILE_BOM     0x01020304U
+#define SYM_CACHE_FILE_VERSION 1
+#define SYM_CACHE_FILE_EXT     ".btsymc"
+
+/* No string within a `struct sym_cache_file_entry` */
+#define SYM_CACHE_FILE_NO_STR UINT32_MAX
+
+/* Flags of a `struct sym_cache_file_entry` */
+#define SYM_CACHE_FILE_ENTRY_FLAG_HAS_FUNC    (1U << 0)
+#define SYM_CACHE_FILE_ENTRY_FLAG_HAS_SRC_LOC (1U << 1)
+
+struct sym_cache_file_header
+{
+    char magic[8];
+    uint32_t bom;
+    uint32_t version;
+    uint64_t entry_count;
+
+    /* Offset and size of the string table within the file */
+    uint64_t strtab_offset;
+    uint64_t strtab_size;
+};
+
+struct sym_cache_file_entry
+{
+    /* Address, relative to the binary */
+    uint64_t addr;
+    uint64_t line_no;
+
+    /* Offsets within the string table, or `SYM_CACHE_FILE_NO_STR` */
+    uint32_t func;
+    uint32_t src_path;
+
+    /* `SYM_CACHE_FILE_ENTRY_FLAG_*` */
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct sym_cache;
+
+/*
+ * Result of a symbolization cache lookup: the strings belong to the
+ * cache.
+ */
+struct sym_cache_result
+{
+    /* Whether or not `func` is known */
+    bool has_func;
+
+    /* Function name, or `nullptr` if none */
+    const char *func;
+
+    /* Whether or not `src_path` and `line_no` are known */
+    bool has_src_loc;
+
+    /* Source file path, or `nullptr` if no source location */
+    const char *src_path;
+    uint64_t line_no;
+};
+
+/**
+ * Opens the symbolization cache of the binary having the build ID
+ * `build_id` within the directory `dir`.
+ *
+ * If the cache file doesn't exist or isn't valid, the cache is
+ * initially empty.
+ *
+ * @param dir		Cache directory
+ * @param build_id	Build ID of the binary
+ * @param build_id_len	Length of `build_id` (bytes)
+ * @returns		New cache, or `nullptr` on failure
+ */
+struct sym_cache *sym_cache_open(const char *dir, const uint8_t *build_id, size_t build_id_len,
+                                 bt_logging_level log_level, bt_self_component *self_comp);
+
+/**
+ * Closes the symbolization cache `cache`, first writing its file if
+ * there are new results.
+ *
+ * @param cache		Cache to close
+ */
+void sym_cache_close(struct sym_cache *cache);
+
+/**
+ * Looks up the known results for the address `addr`, relative to the
+ * binary.
+ *
+ * @param cache		Cache
+ * @param addr		Address to look for
+ * @param result	Out parameter, the known results
+ * @returns		Whether or not any result is known
+ */
+bool sym_cache_lookup(struct sym_cache *cache, uint64_t addr, struct sym_cache_result *result);
+
+/**
+ * Adds the function name `func` (`nullptr` if none) of the address
+ * `addr`, relative to the binary, to `cache`.
+ */
+void sym_cache_add_func(struct sym_cache *cache, uint64_t addr, const char *func);
+
+/**
+ * Adds the source location `src_path` and `line_no` (`src_path` is
+ * `nullptr` if none) of the address `addr`, relative to the binary,
+ * to `cache`.
+ */
+void sym_cache_add_src_loc(struct sym_cache *cache, uint64_t addr, const char *src_path,
+                           uint64_t line_no);
+
+#endif /* BABELTRACE_PLUGINS_LTTNG_UTILS_DEBUG_INFO_SYM_CACHE_HPP */
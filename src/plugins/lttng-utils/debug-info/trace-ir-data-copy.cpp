@@ -176,7 +176,10 @@ enum debug_info_trace_ir_mapping_status copy_packet_content(const bt_packet *in_
     if (in_context_field) {
         out_context_field = bt_packet_borrow_context_field(out_packet);
         BT_ASSERT(out_context_field);
-        status = copy_field_content(in_context_field, out_context_field, log_level, self_comp);
+
+        /* This filter doesn't modify the packet context field class */
+        status = static_cast<debug_info_trace_ir_mapping_status>(
+            bt_field_copy(in_context_field, out_context_field));
         if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
             BT_COMP_LOGE_APPEND_CAUSE(self_comp,
                                       "Cannot copy context field: "
@@ -194,6 +197,7 @@ end:
 
 enum debug_info_trace_ir_mapping_status copy_event_content(const bt_event *in_event,
                                                            bt_event *out_event,
+                                                           bool has_debug_info_field,
                                                            bt_logging_level log_level,
                                                            bt_self_component *self_comp)
 {
@@ -207,8 +211,18 @@ enum debug_info_trace_ir_mapping_status copy_event_content(const bt_event *in_ev
         out_common_ctx_field = bt_event_borrow_common_context_field(out_event);
         BT_ASSERT_DBG(out_common_ctx_field);
 
-        status =
-            copy_field_content(in_common_ctx_field, out_common_ctx_field, log_level, self_comp);
+        /*
+         * Without a debug info member, the output common context field
+         * class has the structure of the input one: copy in bulk too.
+         */
+        if (has_debug_info_field) {
+            status =
+                copy_field_content(in_common_ctx_field, out_common_ctx_field, log_level, self_comp);
+        } else {
+            status = static_cast<debug_info_trace_ir_mapping_status>(
+                bt_field_copy(in_common_ctx_field, out_common_ctx_field));
+        }
+
         if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
             BT_COMP_LOGE_APPEND_CAUSE(self_comp,
                                       "Cannot copy common context field: "
@@ -223,8 +237,13 @@ enum debug_info_trace_ir_mapping_status copy_event_content(const bt_event *in_ev
         out_specific_ctx_field = bt_event_borrow_specific_context_field(out_event);
         BT_ASSERT_DBG(out_specific_ctx_field);
 
-        status =
-            copy_field_content(in_specific_ctx_field, out_specific_ctx_field, log_level, self_comp);
+        /*
+         * Unlike the common context field class, this filter doesn't
+         * modify the specific context and payload field classes: copy
+         * those fields in bulk.
+         */
+        status = static_cast<debug_info_trace_ir_mapping_status>(
+            bt_field_copy(in_specific_ctx_field, out_specific_ctx_field));
         if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
             BT_COMP_LOGE_APPEND_CAUSE(self_comp,
                                       "Cannot copy specific context field: "
@@ -239,7 +258,8 @@ enum debug_info_trace_ir_mapping_status copy_event_content(const bt_event *in_ev
         out_payload_field = bt_event_borrow_payload_field(out_event);
         BT_ASSERT_DBG(out_payload_field);
 
-        status = copy_field_content(in_payload_field, out_payload_field, log_level, self_comp);
+        status = static_cast<debug_info_trace_ir_mapping_status>(
+            bt_field_copy(in_payload_field, out_payload_field));
         if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
             BT_COMP_LOGE_APPEND_CAUSE(self_comp,
                                       "Cannot copy payloat field: "
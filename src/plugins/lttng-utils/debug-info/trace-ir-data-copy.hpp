@@ -28,6 +28,7 @@ enum debug_info_trace_ir_mapping_status copy_packet_content(const bt_packet *in_
                                                             bt_self_component *self_comp);
 enum debug_info_trace_ir_mapping_status copy_event_content(const bt_event *in_event,
                                                            bt_event *out_event,
+                                                           bool has_debug_info_field,
                                                            bt_logging_level log_level,
                                                            bt_self_component *self_comp);
 enum debug_info_trace_ir_mapping_status copy_field_content(const bt_field *in_field,
@@ -560,23 +560,43 @@ copy_event_class_content(struct trace_ir_maps *ir_maps, const bt_event_class *in
      */
     in_event_specific_context =
         bt_event_class_borrow_specific_context_field_class_const(in_event_class);
+    in_event_payload = bt_event_class_borrow_payload_field_class_const(in_event_class);
 
     md_maps->fc_resolving_ctx->event_specific_context = in_event_specific_context;
 
     if (in_event_specific_context) {
         enum bt_event_class_set_field_class_status set_fc_status;
-        /* Copy the specific context of this event class. */
-        out_specific_context_fc = create_field_class_copy(md_maps, in_event_specific_context);
 
-        status =
-            copy_field_class_content(md_maps, in_event_specific_context, out_specific_context_fc);
-        if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
-            BT_COMP_LOGE_APPEND_CAUSE(self_comp,
-                                      "Error copying event class' specific context field class:"
-                                      "in-spec-ctx-fc-addr=%p, out-spec-ctx-fc-addr=%p",
-                                      in_event_specific_context, out_specific_context_fc);
-            goto end;
+        /*
+         * This filter doesn't modify the specific context field class,
+         * so share it instead of copying it when the library allows it.
+         *
+         * Only do so when the payload field class is also shareable:
+         * otherwise, the payload field class copy could need the copy
+         * of a specific context field class as a length or selector
+         * field class.
+         */
+        if (bt_field_class_is_shareable(in_event_specific_context) &&
+            (!in_event_payload || bt_field_class_is_shareable(in_event_payload))) {
+            BT_COMP_LOGD("Sharing event class' specific context field class: "
+                         "in-spec-ctx-fc-addr=%p",
+                         in_event_specific_context);
+            out_specific_context_fc = const_cast<bt_field_class *>(in_event_specific_context);
+        } else {
+            /* Copy the specific context of this event class. */
+            out_specific_context_fc = create_field_class_copy(md_maps, in_event_specific_context);
+
+            status = copy_field_class_content(md_maps, in_event_specific_context,
+                                              out_specific_context_fc);
+            if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
+                BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+                                          "Error copying event class' specific context field class:"
+                                          "in-spec-ctx-fc-addr=%p, out-spec-ctx-fc-addr=%p",
+                                          in_event_specific_context, out_specific_context_fc);
+                goto end;
+            }
         }
+
         /*
          * Add the output specific context to the output event
          * class.
@@ -597,21 +617,27 @@ copy_event_class_content(struct trace_ir_maps *ir_maps, const bt_event_class *in
      * Add the input event class' payload field class to
      * the context.
      */
-    in_event_payload = bt_event_class_borrow_payload_field_class_const(in_event_class);
-
     md_maps->fc_resolving_ctx->event_payload = in_event_payload;
 
     if (in_event_payload) {
         enum bt_event_class_set_field_class_status set_fc_status;
-        /* Copy the payload of this event class. */
-        out_payload_fc = create_field_class_copy(md_maps, in_event_payload);
-        status = copy_field_class_content(md_maps, in_event_payload, out_payload_fc);
-        if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
-            BT_COMP_LOGE_APPEND_CAUSE(self_comp,
-                                      "Error copying event class' specific context field class:"
-                                      "in-payload-fc-addr=%p, out-payload-fc-addr=%p",
-                                      in_event_payload, out_payload_fc);
-            goto end;
+
+        if (bt_field_class_is_shareable(in_event_payload)) {
+            /* This filter doesn't modify the payload field class: share it */
+            BT_COMP_LOGD("Sharing event class' payload field class: in-payload-fc-addr=%p",
+                         in_event_payload);
+            out_payload_fc = const_cast<bt_field_class *>(in_event_payload);
+        } else {
+            /* Copy the payload of this event class. */
+            out_payload_fc = create_field_class_copy(md_maps, in_event_payload);
+            status = copy_field_class_content(md_maps, in_event_payload, out_payload_fc);
+            if (status != DEBUG_INFO_TRACE_IR_MAPPING_STATUS_OK) {
+                BT_COMP_LOGE_APPEND_CAUSE(self_comp,
+                                          "Error copying event class' specific context field class:"
+                                          "in-payload-fc-addr=%p, out-payload-fc-addr=%p",
+                                          in_event_payload, out_payload_fc);
+                goto end;
+            }
         }
 
         /* Add the output payload to the output event class. */
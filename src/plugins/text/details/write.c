@@ -159,34 +159,66 @@ static inline
 void write_nl(struct details_write_ctx *ctx)
 {
 	BT_ASSERT_DBG(ctx);
-	g_string_append_c(ctx->str, '\n');
+	bt_common_g_string_append_c(ctx->str, '\n');
 }
 
 static inline
 void write_sp(struct details_write_ctx *ctx)
 {
 	BT_ASSERT_DBG(ctx);
-	g_string_append_c(ctx->str, ' ');
+	bt_common_g_string_append_c(ctx->str, ' ');
 }
 
 static inline
 void write_indent(struct details_write_ctx *ctx)
 {
-	uint64_t i;
+	/*
+	 * Precomputed indentation: an indentation level which is
+	 * greater than the length of this string needs more than one
+	 * append operation, but that's very rare.
+	 */
+	static const char spaces[] =
+		"                                                                ";
+	unsigned int rem;
 
 	BT_ASSERT_DBG(ctx);
+	rem = ctx->indent_level;
 
-	for (i = 0; i < ctx->indent_level; i++) {
-		write_sp(ctx);
+	while (rem > 0) {
+		const unsigned int len = MIN(rem,
+			(unsigned int) sizeof(spaces) - 1);
+
+		bt_common_g_string_append_len(ctx->str, spaces, len);
+		rem -= len;
+	}
+}
+
+/*
+ * Writes `str`, preceded with the color codes `color1` and `color2`
+ * (possibly empty) and followed with the reset color code if needed.
+ *
+ * This is the hot path of the whole component: avoid the format string
+ * parsing of g_string_append_printf().
+ */
+static inline
+void write_colored_str(struct details_write_ctx *ctx, const char *color1,
+		const char *color2, const char *str)
+{
+	if (ctx->details_comp->cfg.with_color) {
+		bt_common_g_string_append(ctx->str, color1);
+		bt_common_g_string_append(ctx->str, color2);
+		bt_common_g_string_append(ctx->str, str);
+		bt_common_g_string_append(ctx->str, color_reset(ctx));
+	} else {
+		bt_common_g_string_append(ctx->str, str);
 	}
 }
 
 static inline
 void write_none_str(struct details_write_ctx *ctx, const char *str)
 {
-	g_string_append_printf(ctx->str, "%s%s%s%s",
-		color_bold(ctx), color_fg_bright_magenta(ctx),
-		str, color_reset(ctx));
+	write_colored_str(ctx, color_bold(ctx), color_fg_bright_magenta(ctx),
+		str);
 }
 
 static inline
@@ -195,13 +227,12 @@ void write_compound_member_name(struct details_write_ctx *ctx, const char *name)
 	write_indent(ctx);
 
 	if (name) {
-		g_string_append_printf(ctx->str, "%s%s%s",
-			color_fg_cyan(ctx), name, color_reset(ctx));
+		write_colored_str(ctx, color_fg_cyan(ctx), "", name);
 	} else {
 		write_none_str(ctx, "Unnamed");
 	}
 
-	g_string_append(ctx->str, ":");
+	bt_common_g_string_append_c(ctx->str, ':');
 }
 
 static inline
@@ -212,38 +243,39 @@ void write_array_index(struct details_write_ctx *ctx, uint64_t index,
 
 	write_indent(ctx);
 	format_uint(buf, index, 10);
-	g_string_append_printf(ctx->str, "%s[%s]%s:",
-		color, buf, color_reset(ctx));
+	bt_common_g_string_append(ctx->str, color);
+	bt_common_g_string_append_c(ctx->str, '[');
+	bt_common_g_string_append(ctx->str, buf);
+	bt_common_g_string_append_c(ctx->str, ']');
+	bt_common_g_string_append(ctx->str, color_reset(ctx));
+	bt_common_g_string_append_c(ctx->str, ':');
 }
 
 static inline
 void write_obj_type_name(struct details_write_ctx *ctx, const char *name)
 {
-	g_string_append_printf(ctx->str, "%s%s%s%s",
-		color_bold(ctx), color_fg_bright_yellow(ctx), name,
-		color_reset(ctx));
+	write_colored_str(ctx, color_bold(ctx), color_fg_bright_yellow(ctx),
+		name);
 }
 
 static inline
 void write_prop_name(struct details_write_ctx *ctx, const char *prop_name)
 {
-	g_string_append_printf(ctx->str, "%s%s%s",
-		color_fg_magenta(ctx), prop_name, color_reset(ctx));
+	write_colored_str(ctx, color_fg_magenta(ctx), "", prop_name);
 }
 
 static inline
 void write_prop_name_line(struct details_write_ctx *ctx, const char *prop_name)
 {
 	write_indent(ctx);
-	g_string_append_printf(ctx->str, "%s%s%s:",
-		color_fg_magenta(ctx), prop_name, color_reset(ctx));
+	write_prop_name(ctx, prop_name);
+	bt_common_g_string_append_c(ctx->str, ':');
 }
 
 static inline
 void write_str_prop_value(struct details_write_ctx *ctx, const char *value)
 {
-	g_string_append_printf(ctx->str, "%s%s%s",
-		color_bold(ctx), value, color_reset(ctx));
+	write_colored_str(ctx, color_bold(ctx), "", value);
 }
 
 static inline
@@ -332,7 +364,8 @@ void write_bool_prop_value(struct details_write_ctx *ctx, bt_bool prop_value)
 		str = "No";
 	}
 
-	g_string_append_printf(ctx->str, "%s%s", str, color_reset(ctx));
+	bt_common_g_string_append(ctx->str, str);
+	bt_common_g_string_append(ctx->str, color_reset(ctx));
 }
 
 static inline
@@ -1097,8 +1130,7 @@ void write_field_class(struct details_write_ctx *ctx, const bt_field_class *fc)
 		bt_common_abort();
 	}
 
-	g_string_append_printf(ctx->str, "%s%s%s",
-		color_fg_blue(ctx), type, color_reset(ctx));
+	write_colored_str(ctx, color_fg_blue(ctx), "", type);
 
 	/* Write field class's single-line properties */
 	if (fc_type == BT_FIELD_CLASS_TYPE_BIT_ARRAY &&
@@ -2333,8 +2365,9 @@ int write_event_message(struct details_write_ctx *ctx,
 	write_obj_type_name(ctx, "Event");
 	ec_name = bt_event_class_get_name(ec);
 	if (ec_name) {
-		g_string_append_printf(ctx->str, " `%s%s%s`",
-			color_fg_green(ctx), ec_name, color_reset(ctx));
+		g_string_append(ctx->str, " `");
+		write_colored_str(ctx, color_fg_green(ctx), "", ec_name);
+		bt_common_g_string_append_c(ctx->str, '`');
 	}
 
 	g_string_append(ctx->str, " (");
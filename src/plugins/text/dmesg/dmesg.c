@@ -16,12 +16,20 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include "common/common.h"
 #include "common/assert.h"
 #include <babeltrace2/babeltrace.h>
 #include "compat/utc.h"
 #include "compat/stdio.h"
+#include "compat/mman.h"
 #include <glib.h>
+#include <unistd.h>
+#include <sys/types.h>
+
+#ifdef __linux__
+# include <sys/inotify.h>
+#endif
 #include "plugins/common/param-validation/param-validation.h"
 
 #define NSEC_PER_USEC 1000UL
@@ -40,6 +48,36 @@ struct dmesg_msg_iter {
 	char *linebuf;
 	size_t linebuf_len;
 	FILE *fp;
+
+	/*
+	 * Whole memory-mapped input file, or `NULL` to read lines from
+	 * `fp` with bt_getline() instead.
+	 */
+	const char *map;
+	size_t map_len;
+
+	/* Offset, within `map`, of the next line to read */
+	size_t map_offset;
+
+	/*
+	 * Follow mode only: inotify watch file descriptor of the input
+	 * file, or -1 to poll the input file instead.
+	 */
+	int inotify_fd;
+
+	/*
+	 * Follow mode only: true if the last read operation reached the
+	 * end of the input file.
+	 */
+	bool at_eof;
+
+	/*
+	 * Follow mode only: true if the message iterator emitted a
+	 * message iterator inactivity message since its last event
+	 * message.
+	 */
+	bool emitted_inactivity;
+
 	bt_message *tmp_event_msg;
 	uint64_t last_clock_value;
 
@@ -58,6 +96,7 @@ struct dmesg_component {
 		GString *path;
 		bt_bool read_from_stdin;
 		bt_bool no_timestamp;
+		bt_bool follow;
 	} params;
 
 	bt_self_component_source *self_comp_src;
@@ -209,6 +248,7 @@ end:
 
 static
 struct bt_param_validation_map_value_entry_descr dmesg_params[] = {
+	{ "follow", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "no-extract-timestamp", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_STRING } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
@@ -220,6 +260,7 @@ bt_component_class_initialize_method_status handle_params(
 		const bt_value *params)
 {
 	const bt_value *no_timestamp = NULL;
+	const bt_value *follow = NULL;
 	const bt_value *path = NULL;
 	bt_component_class_initialize_method_status status;
 	enum bt_param_validation_status validation_status;
@@ -253,6 +294,18 @@ bt_component_class_initialize_method_status handle_params(
 		dmesg_comp->params.read_from_stdin = true;
 	}
 
+	follow = bt_value_map_borrow_entry_value_const(params, "follow");
+	if (follow) {
+		dmesg_comp->params.follow = bt_value_bool_get(follow);
+	}
+
+	if (dmesg_comp->params.follow && dmesg_comp->params.read_from_stdin) {
+		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
+			"`follow` parameter requires the `path` parameter.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
 	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 end:
 	g_free(validate_error);
@@ -454,17 +507,123 @@ void dmesg_finalize(bt_self_component_source *self_comp)
 		bt_self_component_source_as_self_component(self_comp)));
 }
 
+/*
+ * Skips the whitespaces at `*pos` (not beyond `end`), and then parses
+ * the decimal unsigned integer at `*pos`, setting `*pos` to the
+ * position after its last digit.
+ *
+ * Returns false if there's no digit.
+ */
+static inline
+bool parse_uint(const char **pos, const char *end, uint64_t *value)
+{
+	const char *p = *pos;
+	uint64_t v = 0;
+
+	while (p < end && isspace((unsigned char) *p)) {
+		p++;
+	}
+
+	if (p == end || *p < '0' || *p > '9') {
+		return false;
+	}
+
+	while (p < end && *p >= '0' && *p <= '9') {
+		v = v * 10 + (uint64_t) (*p - '0');
+		p++;
+	}
+
+	*pos = p;
+	*value = v;
+	return true;
+}
+
+/*
+ * Parses the expected character `ch` at `*pos` (not beyond `end`),
+ * setting `*pos` to the position after it.
+ */
+static inline
+bool parse_char(const char **pos, const char *end, char ch)
+{
+	if (*pos == end || **pos != ch) {
+		return false;
+	}
+
+	(*pos)++;
+	return true;
+}
+
+/*
+ * Parses a `[SEC.USEC]` timestamp (kernel timestamp) at the beginning
+ * of `line`, where `end` is the end of the line.
+ *
+ * Sets `*ts_end` to the position after the last digit of the
+ * timestamp on success.
+ */
+static
+bool parse_kernel_ts(const char *line, const char *end,
+		uint64_t *sec, uint64_t *usec, const char **ts_end)
+{
+	const char *p = line;
+
+	if (!parse_char(&p, end, '[') || !parse_uint(&p, end, sec) ||
+			!parse_char(&p, end, '.') ||
+			!parse_uint(&p, end, usec)) {
+		return false;
+	}
+
+	*ts_end = p;
+	return true;
+}
+
+/*
+ * Parses a `[YYYY-MM-DD HH:MM:SS.MSEC]` timestamp (wall clock
+ * timestamp) at the beginning of `line`, where `end` is the end of the
+ * line.
+ *
+ * Sets `*ts_end` to the position after the last digit of the
+ * timestamp on success.
+ */
+static
+bool parse_wall_clock_ts(const char *line, const char *end,
+		uint64_t *year, uint64_t *mon, uint64_t *mday, uint64_t *hour,
+		uint64_t *min, uint64_t *sec, uint64_t *msec,
+		const char **ts_end)
+{
+	const char *p = line;
+
+	if (!parse_char(&p, end, '[') || !parse_uint(&p, end, year) ||
+			!parse_char(&p, end, '-') ||
+			!parse_uint(&p, end, mon) ||
+			!parse_char(&p, end, '-') ||
+			!parse_uint(&p, end, mday) ||
+			!parse_uint(&p, end, hour) ||
+			!parse_char(&p, end, ':') ||
+			!parse_uint(&p, end, min) ||
+			!parse_char(&p, end, ':') ||
+			!parse_uint(&p, end, sec) ||
+			!parse_char(&p, end, '.') ||
+			!parse_uint(&p, end, msec)) {
+		return false;
+	}
+
+	*ts_end = p;
+	return true;
+}
+
 static
 bt_message *create_init_event_msg_from_line(
 		struct dmesg_msg_iter *msg_iter,
-		const char *line, const char **new_start)
+		const char *line, size_t line_len, const char **new_start)
 {
 	bt_event *event;
 	bt_message *msg = NULL;
 	bool has_timestamp = false;
-	unsigned long sec, usec, msec;
-	unsigned int year, mon, mday, hour, min;
+	uint64_t sec, usec, msec;
+	uint64_t year, mon, mday, hour, min;
 	uint64_t ts = 0;
+	const char *line_end = line + line_len;
+	const char *ts_end = NULL;
 	int ret = 0;
 	struct dmesg_component *dmesg_comp = msg_iter->dmesg_comp;
 
@@ -475,8 +634,8 @@ bt_message *create_init_event_msg_from_line(
 	}
 
 	/* Extract time from input line */
-	if (sscanf(line, "[%lu.%lu] ", &sec, &usec) == 2) {
-		ts = (uint64_t) sec * USEC_PER_SEC + (uint64_t) usec;
+	if (parse_kernel_ts(line, line_end, &sec, &usec, &ts_end)) {
+		ts = sec * USEC_PER_SEC + usec;
 
 		/*
 		 * The clock class we use has a 1 GHz frequency: convert
@@ -484,24 +643,23 @@ bt_message *create_init_event_msg_from_line(
 		 */
 		ts *= NSEC_PER_USEC;
 		has_timestamp = true;
-	} else if (sscanf(line, "[%u-%u-%u %u:%u:%lu.%lu] ",
-			&year, &mon, &mday, &hour, &min,
-			&sec, &msec) == 7) {
+	} else if (parse_wall_clock_ts(line, line_end, &year, &mon, &mday,
+			&hour, &min, &sec, &msec, &ts_end)) {
 		time_t ep_sec;
 		struct tm ti;
 
 		memset(&ti, 0, sizeof(ti));
-		ti.tm_year = year - 1900;	/* From 1900 */
-		ti.tm_mon = mon - 1;		/* 0 to 11 */
-		ti.tm_mday = mday;
-		ti.tm_hour = hour;
-		ti.tm_min = min;
-		ti.tm_sec = sec;
+		ti.tm_year = (int) year - 1900;	/* From 1900 */
+		ti.tm_mon = (int) mon - 1;	/* 0 to 11 */
+		ti.tm_mday = (int) mday;
+		ti.tm_hour = (int) hour;
+		ti.tm_min = (int) min;
+		ti.tm_sec = (int) sec;
 
 		ep_sec = bt_timegm(&ti);
 		if (ep_sec != (time_t) -1) {
 			ts = (uint64_t) ep_sec * NSEC_PER_SEC
-				+ (uint64_t) msec * NSEC_PER_MSEC;
+				+ msec * NSEC_PER_MSEC;
 		}
 
 		has_timestamp = true;
@@ -509,12 +667,19 @@ bt_message *create_init_event_msg_from_line(
 
 	if (has_timestamp) {
 		/* Set new start for the message portion of the line */
-		*new_start = strchr(line, ']');
-		BT_ASSERT_DBG(*new_start);
-		(*new_start)++;
-
-		if ((*new_start)[0] == ' ') {
+		BT_ASSERT_DBG(ts_end);
+		*new_start = memchr(ts_end, ']', line_end - ts_end);
+		if (*new_start) {
 			(*new_start)++;
+
+			if (*new_start < line_end && (*new_start)[0] == ' ') {
+				(*new_start)++;
+			}
+		} else {
+			/* No closing bracket: not a timestamp after all */
+			has_timestamp = false;
+			ts = 0;
+			*new_start = line;
 		}
 	}
 
@@ -559,11 +724,10 @@ end:
 
 static
 int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
-		const char *line, bt_event *event)
+		const char *line, size_t len, bt_event *event)
 {
 	bt_field *ep_field = NULL;
 	bt_field *str_field = NULL;
-	size_t len;
 	int ret;
 
 	ep_field = bt_event_borrow_payload_field(event);
@@ -576,8 +740,7 @@ int fill_event_payload_from_line(struct dmesg_component *dmesg_comp,
 		goto error;
 	}
 
-	len = strlen(line);
-	if (line[len - 1] == '\n') {
+	if (len > 0 && line[len - 1] == '\n') {
 		/* Do not include the newline character in the payload */
 		len--;
 	}
@@ -601,7 +764,8 @@ end:
 
 static
 bt_message *create_msg_from_line(
-		struct dmesg_msg_iter *dmesg_msg_iter, const char *line)
+		struct dmesg_msg_iter *dmesg_msg_iter, const char *line,
+		size_t len)
 {
 	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
 	bt_event *event = NULL;
@@ -610,7 +774,7 @@ bt_message *create_msg_from_line(
 	int ret;
 
 	msg = create_init_event_msg_from_line(dmesg_msg_iter,
-		line, &new_start);
+		line, len, &new_start);
 	if (!msg) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot create and initialize event message from line.");
@@ -619,7 +783,8 @@ bt_message *create_msg_from_line(
 
 	event = bt_message_event_borrow_event(msg);
 	BT_ASSERT_DBG(event);
-	ret = fill_event_payload_from_line(dmesg_comp, new_start, event);
+	ret = fill_event_payload_from_line(dmesg_comp, new_start,
+		len - (new_start - line), event);
 	if (ret) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot fill event payload field from line: ret=%d", ret);
@@ -646,6 +811,27 @@ void destroy_dmesg_msg_iter(struct dmesg_msg_iter *dmesg_msg_iter)
 
 	dmesg_comp = dmesg_msg_iter->dmesg_comp;
 
+	if (dmesg_msg_iter->map) {
+		if (bt_munmap((void *) dmesg_msg_iter->map,
+				dmesg_msg_iter->map_len)) {
+			BT_COMP_LOGE_ERRNO("Cannot unmap input file", ": "
+				"addr=%p, len=%zu", dmesg_msg_iter->map,
+				dmesg_msg_iter->map_len);
+		}
+	}
+
+#ifdef __linux__
+	if (dmesg_msg_iter->inotify_fd >= 0) {
+		bt_self_component_remove_wait_fd(dmesg_comp->self_comp,
+			dmesg_msg_iter->inotify_fd);
+
+		if (close(dmesg_msg_iter->inotify_fd)) {
+			BT_COMP_LOGE_ERRNO("Cannot close inotify file descriptor",
+				": fd=%d", dmesg_msg_iter->inotify_fd);
+		}
+	}
+#endif
+
 	if (dmesg_msg_iter->fp && dmesg_msg_iter->fp != stdin) {
 		if (fclose(dmesg_msg_iter->fp)) {
 			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(dmesg_comp->self_comp,
@@ -658,7 +844,163 @@ void destroy_dmesg_msg_iter(struct dmesg_msg_iter *dmesg_msg_iter)
 	g_free(dmesg_msg_iter);
 }
 
+/*
+ * Tries to memory-map the whole input file of `dmesg_msg_iter`.
+ *
+ * On failure, or if the input file isn't a regular, non-empty file,
+ * this function leaves `dmesg_msg_iter->map` as `NULL` so that the
+ * message iterator reads its lines with bt_getline() instead.
+ */
+static
+void try_map_input_file(struct dmesg_msg_iter *dmesg_msg_iter)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	int fd = fileno(dmesg_msg_iter->fp);
+	struct stat st;
+	void *map;
+
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		BT_COMP_LOGD_ERRNO("Cannot get input file's status",
+			": path=\"%s\"", dmesg_comp->params.path->str);
+		return;
+	}
 
+	if (!S_ISREG(st.st_mode) || st.st_size <= 0 ||
+			(uint64_t) st.st_size > SIZE_MAX) {
+		BT_COMP_LOGD("Not memory-mapping input file: "
+			"path=\"%s\", size=%jd", dmesg_comp->params.path->str,
+			(intmax_t) st.st_size);
+		return;
+	}
+
+	map = bt_mmap((size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0,
+		dmesg_comp->log_level);
+	if (map == MAP_FAILED) {
+		BT_COMP_LOGD_ERRNO("Cannot memory-map input file",
+			": path=\"%s\", size=%jd",
+			dmesg_comp->params.path->str, (intmax_t) st.st_size);
+		return;
+	}
+
+	dmesg_msg_iter->map = map;
+	dmesg_msg_iter->map_len = (size_t) st.st_size;
+	dmesg_msg_iter->map_offset = 0;
+	BT_COMP_LOGD("Memory-mapped input file: path=\"%s\", addr=%p, "
+		"size=%zu", dmesg_comp->params.path->str, map,
+		dmesg_msg_iter->map_len);
+}
+
+/*
+ * Tries to watch the input file of `dmesg_msg_iter` (follow mode) with
+ * inotify.
+ *
+ * On failure, or if inotify isn't available, this function leaves
+ * `dmesg_msg_iter->inotify_fd` as -1 so that the message iterator
+ * polls the input file instead.
+ */
+static
+void try_watch_input_file(struct dmesg_msg_iter *dmesg_msg_iter)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+
+#ifdef __linux__
+	int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (fd < 0) {
+		BT_COMP_LOGD_ERRNO("Cannot initialize inotify: "
+			"polling the input file", ": path=\"%s\"",
+			dmesg_comp->params.path->str);
+		return;
+	}
+
+	if (inotify_add_watch(fd, dmesg_comp->params.path->str,
+			IN_MODIFY | IN_ATTRIB) < 0) {
+		BT_COMP_LOGD_ERRNO("Cannot watch input file: "
+			"polling the input file", ": path=\"%s\"",
+			dmesg_comp->params.path->str);
+		(void) close(fd);
+		return;
+	}
+
+	/*
+	 * Make bt_graph_wait() return as soon as the input file
+	 * changes instead of when the "try again" duration expires.
+	 */
+	if (bt_self_component_add_wait_fd(dmesg_comp->self_comp, fd) !=
+			BT_SELF_COMPONENT_ADD_WAIT_FD_STATUS_OK) {
+		BT_COMP_LOGD("Cannot add inotify file descriptor to the graph's "
+			"wait file descriptors: polling the input file: "
+			"path=\"%s\"", dmesg_comp->params.path->str);
+		bt_current_thread_clear_error();
+		(void) close(fd);
+		return;
+	}
+
+	dmesg_msg_iter->inotify_fd = fd;
+	BT_COMP_LOGD("Watching input file with inotify: path=\"%s\", fd=%d",
+		dmesg_comp->params.path->str, fd);
+#else
+	BT_COMP_LOGD("inotify isn't available: polling the input file: "
+		"path=\"%s\"", dmesg_comp->params.path->str);
+#endif
+}
+
+/*
+ * Follow mode only: returns whether or not the input file of
+ * `dmesg_msg_iter` possibly changed since the last time its message
+ * iterator reached its end.
+ */
+static
+bool input_file_may_have_changed(struct dmesg_msg_iter *dmesg_msg_iter)
+{
+#ifdef __linux__
+	if (dmesg_msg_iter->inotify_fd >= 0) {
+		char buf[4096]
+			__attribute__((aligned(__alignof__(struct inotify_event))));
+		bool changed = false;
+
+		/*
+		 * Drain all the pending events: we only need to know if
+		 * there's at least one.
+		 */
+		while (read(dmesg_msg_iter->inotify_fd, buf, sizeof(buf)) > 0) {
+			changed = true;
+		}
+
+		return changed;
+	}
+#endif
+
+	/* Polling: always try to read */
+	return true;
+}
+
+/*
+ * Follow mode only: if the input file of `dmesg_msg_iter` is now
+ * shorter than the current reading position (truncated, for example
+ * by a log rotation tool), then restarts reading it from its
+ * beginning.
+ */
+static
+void handle_truncated_input_file(struct dmesg_msg_iter *dmesg_msg_iter)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+	struct stat st;
+	off_t pos;
+
+	if (fstat(fileno(dmesg_msg_iter->fp), &st) != 0) {
+		return;
+	}
+
+	pos = ftello(dmesg_msg_iter->fp);
+	if (pos >= 0 && st.st_size < pos) {
+		BT_COMP_LOGI("Input file was truncated: reading it from "
+			"its beginning: path=\"%s\", size=%jd, pos=%jd",
+			dmesg_comp->params.path->str, (intmax_t) st.st_size,
+			(intmax_t) pos);
+		rewind(dmesg_msg_iter->fp);
+	}
+}
 
 bt_message_iterator_class_initialize_method_status dmesg_msg_iter_init(
 		bt_self_message_iterator *self_msg_iter,
@@ -682,6 +1024,7 @@ bt_message_iterator_class_initialize_method_status dmesg_msg_iter_init(
 	BT_ASSERT(dmesg_comp);
 	dmesg_msg_iter->dmesg_comp = dmesg_comp;
 	dmesg_msg_iter->self_msg_iter = self_msg_iter;
+	dmesg_msg_iter->inotify_fd = -1;
 
 	if (dmesg_comp->params.read_from_stdin) {
 		dmesg_msg_iter->fp = stdin;
@@ -694,6 +1037,13 @@ bt_message_iterator_class_initialize_method_status dmesg_msg_iter_init(
 			status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
 			goto error;
 		}
+
+		if (dmesg_comp->params.follow) {
+			/* The input file grows: don't memory-map it */
+			try_watch_input_file(dmesg_msg_iter);
+		} else {
+			try_map_input_file(dmesg_msg_iter);
+		}
 	}
 
 	bt_self_message_iterator_set_data(self_msg_iter,
@@ -717,12 +1067,132 @@ void dmesg_msg_iter_finalize(
 		priv_msg_iter));
 }
 
+/*
+ * Sets `*line` and `*len` to the next line of the input of
+ * `dmesg_msg_iter`, including its newline character, if any.
+ *
+ * `*line` isn't necessarily null-terminated.
+ *
+ * Returns 0 on success, 1 at the end of the input, or a negative value
+ * on error (`errno` is set).
+ */
+static inline
+int read_line(struct dmesg_msg_iter *dmesg_msg_iter, const char **line,
+		size_t *len)
+{
+	ssize_t getline_len;
+	off_t line_offset = -1;
+
+	if (dmesg_msg_iter->map) {
+		const char *begin = dmesg_msg_iter->map +
+			dmesg_msg_iter->map_offset;
+		size_t rem = dmesg_msg_iter->map_len -
+			dmesg_msg_iter->map_offset;
+		const char *nl;
+
+		if (rem == 0) {
+			return 1;
+		}
+
+		/* memchr() is vectorized by any decent C library */
+		nl = memchr(begin, '\n', rem);
+		*line = begin;
+		*len = nl ? (size_t) (nl - begin) + 1 : rem;
+		dmesg_msg_iter->map_offset += *len;
+		return 0;
+	}
+
+	if (dmesg_msg_iter->dmesg_comp->params.follow) {
+		if (dmesg_msg_iter->at_eof) {
+			if (!input_file_may_have_changed(dmesg_msg_iter)) {
+				return 1;
+			}
+
+			handle_truncated_input_file(dmesg_msg_iter);
+
+			/* Forget the previous end of file */
+			clearerr(dmesg_msg_iter->fp);
+			dmesg_msg_iter->at_eof = false;
+		}
+
+		line_offset = ftello(dmesg_msg_iter->fp);
+	}
+
+	getline_len = bt_getline(&dmesg_msg_iter->linebuf,
+		&dmesg_msg_iter->linebuf_len, dmesg_msg_iter->fp);
+	if (getline_len < 0) {
+		if (errno == EINVAL || errno == ENOMEM) {
+			return -1;
+		}
+
+		dmesg_msg_iter->at_eof = true;
+		return 1;
+	}
+
+	BT_ASSERT_DBG(dmesg_msg_iter->linebuf);
+
+	if (dmesg_msg_iter->dmesg_comp->params.follow && line_offset >= 0 &&
+			dmesg_msg_iter->linebuf[getline_len - 1] != '\n') {
+		/*
+		 * Incomplete line: the writer isn't done with it yet.
+		 * Go back to its beginning to read it again, as a whole,
+		 * the next time.
+		 */
+		if (fseeko(dmesg_msg_iter->fp, line_offset, SEEK_SET) == 0) {
+			dmesg_msg_iter->at_eof = true;
+			return 1;
+		}
+	}
+
+	*line = dmesg_msg_iter->linebuf;
+	*len = (size_t) getline_len;
+	return 0;
+}
+
+/*
+ * Follow mode only: handles the end of the input file of
+ * `dmesg_msg_iter` for the time being.
+ *
+ * Once the stream began, the first time since the last event message,
+ * this function sets `*msg` to a message iterator inactivity message
+ * at the time of the last event (if there's a clock class) so that
+ * downstream components such as a `filter.utils.muxer` can make
+ * progress with their other inputs. Otherwise, it returns the "try
+ * again" status.
+ */
+static
+bt_message_iterator_class_next_method_status follow_eof(
+		struct dmesg_msg_iter *dmesg_msg_iter, bt_message **msg)
+{
+	struct dmesg_component *dmesg_comp = dmesg_msg_iter->dmesg_comp;
+
+	if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING ||
+			!dmesg_comp->clock_class ||
+			dmesg_msg_iter->emitted_inactivity) {
+		return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_AGAIN;
+	}
+
+	*msg = bt_message_message_iterator_inactivity_create(
+		dmesg_msg_iter->self_msg_iter, dmesg_comp->clock_class,
+		dmesg_msg_iter->last_clock_value);
+	if (!*msg) {
+		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
+			"Cannot create message iterator inactivity message: "
+			"dmesg-comp-addr=%p", dmesg_comp);
+		return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+	}
+
+	dmesg_msg_iter->emitted_inactivity = true;
+	return BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+}
+
 static
 bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 		struct dmesg_msg_iter *dmesg_msg_iter,
 		bt_message **msg)
 {
-	ssize_t len;
+	const char *line = NULL;
+	size_t len = 0;
 	struct dmesg_component *dmesg_comp;
 	bt_message_iterator_class_next_method_status status;
 
@@ -741,18 +1211,21 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 	}
 
 	while (true) {
-		const char *ch;
+		size_t i;
 		bool only_spaces = true;
+		int ret = read_line(dmesg_msg_iter, &line, &len);
 
-		len = bt_getline(&dmesg_msg_iter->linebuf,
-			&dmesg_msg_iter->linebuf_len, dmesg_msg_iter->fp);
-		if (len < 0) {
-			if (errno == EINVAL) {
+		if (ret) {
+			if (ret < 0 && errno == EINVAL) {
 				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
 				goto end;
-			} else if (errno == ENOMEM) {
+			} else if (ret < 0) {
 				status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
 				goto end;
+			} else if (dmesg_comp->params.follow) {
+				/* Wait for new lines */
+				status = follow_eof(dmesg_msg_iter, msg);
+				goto end;
 			} else {
 				if (dmesg_msg_iter->state == STATE_EMIT_STREAM_BEGINNING) {
 					/* Stream did not even begin */
@@ -767,11 +1240,9 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 			}
 		}
 
-		BT_ASSERT_DBG(dmesg_msg_iter->linebuf);
-
 		/* Ignore empty lines, once trimmed */
-		for (ch = dmesg_msg_iter->linebuf; *ch != '\0'; ch++) {
-			if (!isspace((unsigned char) *ch)) {
+		for (i = 0; i < len; i++) {
+			if (!isspace((unsigned char) line[i])) {
 				only_spaces = false;
 				break;
 			}
@@ -783,12 +1254,12 @@ bt_message_iterator_class_next_method_status dmesg_msg_iter_next_one(
 	}
 
 	dmesg_msg_iter->tmp_event_msg = create_msg_from_line(
-		dmesg_msg_iter, dmesg_msg_iter->linebuf);
+		dmesg_msg_iter, line, len);
 	if (!dmesg_msg_iter->tmp_event_msg) {
 		BT_COMP_LOGE_APPEND_CAUSE(dmesg_comp->self_comp,
 			"Cannot create event message from line: "
-			"dmesg-comp-addr=%p, line=\"%s\"", dmesg_comp,
-			dmesg_msg_iter->linebuf);
+			"dmesg-comp-addr=%p, line=\"%.*s\"", dmesg_comp,
+			(int) len, line);
 		status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
 		goto end;
 	}
@@ -807,6 +1278,7 @@ handle_state:
 		BT_ASSERT_DBG(dmesg_msg_iter->tmp_event_msg);
 		*msg = dmesg_msg_iter->tmp_event_msg;
 		dmesg_msg_iter->tmp_event_msg = NULL;
+		dmesg_msg_iter->emitted_inactivity = false;
 		break;
 	case STATE_EMIT_STREAM_END:
 		*msg = bt_message_stream_end_create(
@@ -882,8 +1354,12 @@ dmesg_msg_iter_can_seek_beginning(
 	struct dmesg_msg_iter *dmesg_msg_iter =
 		bt_self_message_iterator_get_data(self_msg_iter);
 
-	/* Can't seek the beginning of the standard input stream */
-	*can_seek = !dmesg_msg_iter->dmesg_comp->params.read_from_stdin;
+	/*
+	 * Can't seek the beginning of the standard input stream, and
+	 * don't seek the beginning of a followed input file.
+	 */
+	*can_seek = !dmesg_msg_iter->dmesg_comp->params.read_from_stdin &&
+		!dmesg_msg_iter->dmesg_comp->params.follow;
 
 	return BT_MESSAGE_ITERATOR_CLASS_CAN_SEEK_BEGINNING_METHOD_STATUS_OK;
 }
@@ -898,6 +1374,7 @@ dmesg_msg_iter_seek_beginning(
 	BT_ASSERT(!dmesg_msg_iter->dmesg_comp->params.read_from_stdin);
 
 	BT_MESSAGE_PUT_REF_AND_RESET(dmesg_msg_iter->tmp_event_msg);
+	dmesg_msg_iter->map_offset = 0;
 	dmesg_msg_iter->last_clock_value = 0;
 	dmesg_msg_iter->state = STATE_EMIT_STREAM_BEGINNING;
 	return BT_MESSAGE_ITERATOR_CLASS_SEEK_BEGINNING_METHOD_STATUS_OK;
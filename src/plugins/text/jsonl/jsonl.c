@@ -0,0 +1,763 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#define BT_COMP_LOG_SELF_COMP (jsonl->self_comp)
+#define BT_LOG_OUTPUT_LEVEL (jsonl->log_level)
+#define BT_LOG_TAG "PLUGIN/SINK.TEXT.JSONL"
+#include "logging/comp-logging.h"
+
+#include <babeltrace2/babeltrace.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <glib.h>
+#include <string.h>
+#include "common/assert.h"
+#include "common/common.h"
+#include "plugins/common/param-validation/param-validation.h"
+
+#include "jsonl.h"
+
+static
+const char * const in_port_name = "in";
+
+bt_component_class_get_supported_mip_versions_method_status
+jsonl_supported_mip_versions(
+		bt_self_component_class_sink *self_component_class __attribute__((unused)),
+		const bt_value *params __attribute__((unused)),
+		void *initialize_method_data __attribute__((unused)),
+		bt_logging_level logging_level __attribute__((unused)),
+		bt_integer_range_set_unsigned *supported_versions)
+{
+	return (int) bt_integer_range_set_unsigned_add_range(supported_versions, 0, 1);
+}
+
+/*
+ * Appends the JSON string literal of the `len` bytes of `str` to `buf`.
+ */
+static
+void append_json_string(GString *buf, const char *str, size_t len)
+{
+	static const char hex_digits[] = "0123456789abcdef";
+	size_t run_begin = 0;
+	size_t i;
+
+	bt_common_g_string_append_c(buf, '"');
+
+	for (i = 0; i < len; i++) {
+		const unsigned char c = (unsigned char) str[i];
+		const char *esc;
+		char u_esc[7];
+
+		if (G_LIKELY(c >= 0x20 && c != '"' && c != '\\')) {
+			/* Part of the current run of verbatim bytes */
+			continue;
+		}
+
+		switch (c) {
+		case '"':
+			esc = "\\\"";
+			break;
+		case '\\':
+			esc = "\\\\";
+			break;
+		case '\b':
+			esc = "\\b";
+			break;
+		case '\f':
+			esc = "\\f";
+			break;
+		case '\n':
+			esc = "\\n";
+			break;
+		case '\r':
+			esc = "\\r";
+			break;
+		case '\t':
+			esc = "\\t";
+			break;
+		default:
+			u_esc[0] = '\\';
+			u_esc[1] = 'u';
+			u_esc[2] = '0';
+			u_esc[3] = '0';
+			u_esc[4] = hex_digits[c >> 4];
+			u_esc[5] = hex_digits[c & 0xf];
+			u_esc[6] = '\0';
+			esc = u_esc;
+			break;
+		}
+
+		bt_common_g_string_append_len(buf, str + run_begin,
+			i - run_begin);
+		bt_common_g_string_append(buf, esc);
+		run_begin = i + 1;
+	}
+
+	bt_common_g_string_append_len(buf, str + run_begin, len - run_begin);
+	bt_common_g_string_append_c(buf, '"');
+}
+
+/*
+ * Appends the JSON string literal of the null-terminated string `str`,
+ * followed with `:`, to `buf`.
+ */
+static
+void append_json_key(GString *buf, const char *str)
+{
+	append_json_string(buf, str, strlen(str));
+	bt_common_g_string_append_c(buf, ':');
+}
+
+static
+void destroy_event_class_template(gpointer data)
+{
+	struct jsonl_event_class_template *template = data;
+
+	bt_event_class_put_ref(template->event_class);
+
+	if (template->prefix) {
+		g_string_free(template->prefix, TRUE);
+	}
+
+	g_free(template);
+}
+
+static
+void destroy_struct_keys(gpointer data)
+{
+	struct jsonl_struct_keys *struct_keys = data;
+
+	bt_field_class_put_ref(struct_keys->fc);
+
+	if (struct_keys->keys) {
+		g_ptr_array_free(struct_keys->keys, TRUE);
+	}
+
+	g_free(struct_keys);
+}
+
+static
+void free_gstring(gpointer data)
+{
+	g_string_free(data, TRUE);
+}
+
+/*
+ * Returns the template of `event_class`, building it if needed, or
+ * `NULL` on memory error.
+ */
+static inline
+struct jsonl_event_class_template *borrow_event_class_template(
+		struct jsonl_component *jsonl, const bt_event_class *event_class)
+{
+	struct jsonl_event_class_template *template;
+	const char *name;
+
+	/* Consecutive events often share their class */
+	if (G_LIKELY(event_class == jsonl->last_event_class)) {
+		return jsonl->last_template;
+	}
+
+	template = g_hash_table_lookup(jsonl->event_class_templates,
+		event_class);
+	if (template) {
+		goto end;
+	}
+
+	template = g_new0(struct jsonl_event_class_template, 1);
+	if (!template) {
+		goto end;
+	}
+
+	/*
+	 * Keep a strong reference so that no other event class may get
+	 * allocated at the same address.
+	 */
+	template->event_class = event_class;
+	bt_event_class_get_ref(event_class);
+	template->prefix = g_string_new("{");
+	if (!template->prefix) {
+		destroy_event_class_template(template);
+		template = NULL;
+		goto end;
+	}
+
+	name = bt_event_class_get_name(event_class);
+	if (name) {
+		append_json_key(template->prefix, "name");
+		append_json_string(template->prefix, name, strlen(name));
+		bt_common_g_string_append_c(template->prefix, ',');
+	}
+
+	append_json_key(template->prefix, "class-id");
+	bt_common_g_string_append_uint64(template->prefix,
+		bt_event_class_get_id(event_class), 0);
+	bt_common_g_string_append_c(template->prefix, ',');
+	append_json_key(template->prefix, "stream-class-id");
+	bt_common_g_string_append_uint64(template->prefix,
+		bt_stream_class_get_id(
+			bt_event_class_borrow_stream_class_const(event_class)), 0);
+	bt_common_g_string_append_c(template->prefix, ',');
+	g_hash_table_insert(jsonl->event_class_templates,
+		(gpointer) event_class, template);
+
+end:
+	if (template) {
+		jsonl->last_event_class = event_class;
+		jsonl->last_template = template;
+	}
+
+	return template;
+}
+
+/*
+ * Returns the member keys of the structure field class `fc`, building
+ * them if needed, or `NULL` on memory error.
+ */
+static
+struct jsonl_struct_keys *borrow_struct_keys(struct jsonl_component *jsonl,
+		const bt_field_class *fc)
+{
+	struct jsonl_struct_keys *struct_keys;
+	uint64_t member_count;
+	uint64_t i;
+
+	struct_keys = g_hash_table_lookup(jsonl->struct_keys, fc);
+	if (G_LIKELY(struct_keys)) {
+		goto end;
+	}
+
+	struct_keys = g_new0(struct jsonl_struct_keys, 1);
+	if (!struct_keys) {
+		goto end;
+	}
+
+	/* Same as for the event class templates */
+	struct_keys->fc = fc;
+	bt_field_class_get_ref(fc);
+	member_count = bt_field_class_structure_get_member_count(fc);
+	struct_keys->keys = g_ptr_array_new_full(member_count, free_gstring);
+	if (!struct_keys->keys) {
+		goto error;
+	}
+
+	for (i = 0; i < member_count; i++) {
+		const bt_field_class_structure_member *member =
+			bt_field_class_structure_borrow_member_by_index_const(
+				fc, i);
+		GString *key = g_string_new(NULL);
+
+		if (!key) {
+			goto error;
+		}
+
+		append_json_key(key,
+			bt_field_class_structure_member_get_name(member));
+		g_ptr_array_add(struct_keys->keys, key);
+	}
+
+	g_hash_table_insert(jsonl->struct_keys, (gpointer) fc, struct_keys);
+	goto end;
+
+error:
+	destroy_struct_keys(struct_keys);
+	struct_keys = NULL;
+
+end:
+	return struct_keys;
+}
+
+static
+void append_real(GString *buf, double val, bool single_precision)
+{
+	char str[G_ASCII_DTOSTR_BUF_SIZE];
+
+	if (!isfinite(val)) {
+		/* No JSON representation */
+		bt_common_g_string_append(buf, "null");
+		return;
+	}
+
+	if (single_precision) {
+		/* Enough significant digits to round-trip a `float` */
+		g_ascii_formatd(str, sizeof(str), "%.9g", val);
+	} else {
+		/* Shortest representation which round-trips */
+		g_ascii_dtostr(str, sizeof(str), val);
+	}
+
+	bt_common_g_string_append(buf, str);
+}
+
+/*
+ * Appends the JSON value of `field` to `jsonl->buf`.
+ *
+ * Returns a negative value on memory error.
+ */
+static
+int append_field(struct jsonl_component *jsonl, const bt_field *field)
+{
+	GString *buf = jsonl->buf;
+	const bt_field_class_type fc_type = bt_field_get_class_type(field);
+	int ret = 0;
+
+	if (fc_type == BT_FIELD_CLASS_TYPE_BOOL) {
+		bt_common_g_string_append(buf,
+			bt_field_bool_get_value(field) ? "true" : "false");
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_BIT_ARRAY) {
+		bt_common_g_string_append_uint64(buf,
+			bt_field_bit_array_get_value_as_integer(field), 0);
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
+		bt_common_g_string_append_uint64(buf,
+			bt_field_integer_unsigned_get_value(field), 0);
+	} else if (bt_field_class_type_is(fc_type,
+			BT_FIELD_CLASS_TYPE_SIGNED_INTEGER)) {
+		bt_common_g_string_append_int64(buf,
+			bt_field_integer_signed_get_value(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_SINGLE_PRECISION_REAL) {
+		append_real(buf, bt_field_real_single_precision_get_value(field),
+			true);
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_DOUBLE_PRECISION_REAL) {
+		append_real(buf, bt_field_real_double_precision_get_value(field),
+			false);
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRING) {
+		append_json_string(buf, bt_field_string_get_value(field),
+			bt_field_string_get_length(field));
+	} else if (fc_type == BT_FIELD_CLASS_TYPE_STRUCTURE) {
+		const struct jsonl_struct_keys *struct_keys =
+			borrow_struct_keys(jsonl, bt_field_borrow_class_const(field));
+		uint64_t i;
+
+		if (G_UNLIKELY(!struct_keys)) {
+			ret = -1;
+			goto end;
+		}
+
+		bt_common_g_string_append_c(buf, '{');
+
+		for (i = 0; i < struct_keys->keys->len; i++) {
+			const GString *key = g_ptr_array_index(struct_keys->keys, i);
+
+			if (i > 0) {
+				bt_common_g_string_append_c(buf, ',');
+			}
+
+			bt_common_g_string_append_len(buf, key->str, key->len);
+			ret = append_field(jsonl,
+				bt_field_structure_borrow_member_field_by_index_const(
+					field, i));
+			if (ret) {
+				goto end;
+			}
+		}
+
+		bt_common_g_string_append_c(buf, '}');
+	} else if (bt_field_class_type_is(fc_type, BT_FIELD_CLASS_TYPE_ARRAY)) {
+		const uint64_t len = bt_field_array_get_length(field);
+		uint64_t i;
+
+		bt_common_g_string_append_c(buf, '[');
+
+		for (i = 0; i < len; i++) {
+			if (i > 0) {
+				bt_common_g_string_append_c(buf, ',');
+			}
+
+			ret = append_field(jsonl,
+				bt_field_array_borrow_element_field_by_index_const(
+					field, i));
+			if (ret) {
+				goto end;
+			}
+		}
+
+		bt_common_g_string_append_c(buf, ']');
+	} else if (bt_field_class_type_is(fc_type, BT_FIELD_CLASS_TYPE_OPTION)) {
+		const bt_field *content = bt_field_option_borrow_field_const(field);
+
+		if (content) {
+			ret = append_field(jsonl, content);
+		} else {
+			bt_common_g_string_append(buf, "null");
+		}
+	} else if (bt_field_class_type_is(fc_type, BT_FIELD_CLASS_TYPE_VARIANT)) {
+		ret = append_field(jsonl,
+			bt_field_variant_borrow_selected_option_field_const(field));
+	} else if (bt_field_class_type_is(fc_type, BT_FIELD_CLASS_TYPE_BLOB)) {
+		static const char hex_digits[] = "0123456789abcdef";
+		const uint64_t len = bt_field_blob_get_length(field);
+		const uint8_t *data = bt_field_blob_get_data_const(field);
+		uint64_t i;
+
+		/* Hexadecimal string */
+		bt_common_g_string_append_c(buf, '"');
+
+		for (i = 0; i < len; i++) {
+			bt_common_g_string_append_c(buf, hex_digits[data[i] >> 4]);
+			bt_common_g_string_append_c(buf, hex_digits[data[i] & 0xf]);
+		}
+
+		bt_common_g_string_append_c(buf, '"');
+	} else {
+		bt_common_abort();
+	}
+
+end:
+	return ret;
+}
+
+/*
+ * Appends `,"KEY":` and the JSON value of `field`, if it's not `NULL`,
+ * to `jsonl->buf`.
+ */
+static
+int append_scope_field(struct jsonl_component *jsonl, const char *key,
+		const bt_field *field)
+{
+	int ret = 0;
+
+	if (!field) {
+		goto end;
+	}
+
+	bt_common_g_string_append(jsonl->buf, key);
+	ret = append_field(jsonl, field);
+
+end:
+	return ret;
+}
+
+static
+int write_pending_lines(struct jsonl_component *jsonl)
+{
+	int ret = 0;
+
+	if (jsonl->buf->len > 0 &&
+			fwrite(jsonl->buf->str, jsonl->buf->len, 1, jsonl->out) != 1) {
+		ret = -1;
+	}
+
+	g_string_truncate(jsonl->buf, 0);
+	return ret;
+}
+
+/*
+ * Appends the JSON line of the event message `msg` to `jsonl->buf`.
+ *
+ * Returns a negative value on error.
+ */
+static
+int append_event_line(struct jsonl_component *jsonl, const bt_message *msg)
+{
+	const bt_event *event = bt_message_event_borrow_event_const(msg);
+	const bt_stream *stream = bt_event_borrow_stream_const(event);
+	const gsize line_offset = jsonl->buf->len;
+	const struct jsonl_event_class_template *template;
+	int ret = 0;
+
+	template = borrow_event_class_template(jsonl,
+		bt_event_borrow_class_const(event));
+	if (G_UNLIKELY(!template)) {
+		ret = -1;
+		goto end;
+	}
+
+	/* Precomputed name and IDs */
+	bt_common_g_string_append_len(jsonl->buf, template->prefix->str,
+		template->prefix->len);
+
+	bt_common_g_string_append(jsonl->buf, "\"stream-id\":");
+	bt_common_g_string_append_uint64(jsonl->buf, bt_stream_get_id(stream), 0);
+
+	if (bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(stream))) {
+		const bt_clock_snapshot *cs =
+			bt_message_event_borrow_default_clock_snapshot_const(msg);
+		int64_t ns;
+
+		bt_common_g_string_append(jsonl->buf, ",\"cycles\":");
+		bt_common_g_string_append_uint64(jsonl->buf,
+			bt_clock_snapshot_get_value(cs), 0);
+
+		if (!bt_clock_snapshot_get_ns_from_origin(cs, &ns)) {
+			bt_common_g_string_append(jsonl->buf,
+				",\"ns-from-origin\":");
+			bt_common_g_string_append_int64(jsonl->buf, ns);
+		}
+	}
+
+	ret = append_scope_field(jsonl, ",\"common-context\":",
+		bt_event_borrow_common_context_field_const(event));
+	if (ret) {
+		goto end;
+	}
+
+	ret = append_scope_field(jsonl, ",\"specific-context\":",
+		bt_event_borrow_specific_context_field_const(event));
+	if (ret) {
+		goto end;
+	}
+
+	ret = append_scope_field(jsonl, ",\"payload\":",
+		bt_event_borrow_payload_field_const(event));
+	if (ret) {
+		goto end;
+	}
+
+	bt_common_g_string_append(jsonl->buf, "}\n");
+
+	/*
+	 * Write many lines at once instead of calling fwrite() for each
+	 * one of them.
+	 */
+	if (jsonl->buf->len >= JSONL_OUTPUT_FLUSH_THRESHOLD) {
+		ret = write_pending_lines(jsonl);
+	}
+
+end:
+	if (ret) {
+		/* Discard the partial line */
+		g_string_truncate(jsonl->buf, line_offset);
+	}
+
+	return ret;
+}
+
+static
+void destroy_jsonl_data(struct jsonl_component *jsonl)
+{
+	if (!jsonl) {
+		goto end;
+	}
+
+	bt_message_iterator_put_ref(jsonl->iterator);
+
+	if (jsonl->buf) {
+		g_string_free(jsonl->buf, TRUE);
+	}
+
+	if (jsonl->event_class_templates) {
+		g_hash_table_destroy(jsonl->event_class_templates);
+	}
+
+	if (jsonl->struct_keys) {
+		g_hash_table_destroy(jsonl->struct_keys);
+	}
+
+	if (jsonl->out && jsonl->out != stdout) {
+		if (fclose(jsonl->out)) {
+			perror("close output file");
+		}
+	}
+
+	g_free(jsonl->output_path);
+	g_free(jsonl);
+
+end:
+	return;
+}
+
+void jsonl_finalize(bt_self_component_sink *comp)
+{
+	struct jsonl_component *jsonl = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(comp));
+
+	/* Write what's left, for example if the graph got interrupted */
+	if (write_pending_lines(jsonl)) {
+		BT_COMP_LOGE("Failed to write the pending JSON lines.");
+	}
+
+	destroy_jsonl_data(jsonl);
+}
+
+bt_component_class_sink_graph_is_configured_method_status
+jsonl_graph_is_configured(bt_self_component_sink *self_comp_sink)
+{
+	bt_component_class_sink_graph_is_configured_method_status status;
+	bt_message_iterator_create_from_sink_component_status
+		msg_iter_status;
+	struct jsonl_component *jsonl;
+	bt_self_component *self_comp =
+		bt_self_component_sink_as_self_component(self_comp_sink);
+	bt_self_component_port_input *in_port;
+
+	jsonl = bt_self_component_get_data(self_comp);
+	BT_ASSERT(jsonl);
+	BT_ASSERT(!jsonl->iterator);
+
+	in_port = bt_self_component_sink_borrow_input_port_by_name(self_comp_sink,
+		in_port_name);
+	if (!bt_port_is_connected(bt_port_input_as_port_const(
+			bt_self_component_port_input_as_port_input(in_port)))) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Single input port is not connected: "
+			"port-name=\"%s\"", in_port_name);
+		status = BT_COMPONENT_CLASS_SINK_GRAPH_IS_CONFIGURED_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
+	msg_iter_status = bt_message_iterator_create_from_sink_component(
+		self_comp_sink, in_port, &jsonl->iterator);
+	if (msg_iter_status != BT_MESSAGE_ITERATOR_CREATE_FROM_SINK_COMPONENT_STATUS_OK) {
+		status = (int) msg_iter_status;
+		goto end;
+	}
+
+	status = BT_COMPONENT_CLASS_SINK_GRAPH_IS_CONFIGURED_METHOD_STATUS_OK;
+
+end:
+	return status;
+}
+
+bt_component_class_sink_consume_method_status jsonl_consume(
+		bt_self_component_sink *comp)
+{
+	bt_component_class_sink_consume_method_status status;
+	bt_message_array_const msgs;
+	struct jsonl_component *jsonl = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(comp));
+	bt_message_iterator_next_status next_status;
+	uint64_t count = 0;
+	uint64_t i = 0;
+
+	next_status = bt_message_iterator_next(jsonl->iterator, &msgs, &count);
+	if (next_status != BT_MESSAGE_ITERATOR_NEXT_STATUS_OK) {
+		status = (int) next_status;
+
+		/*
+		 * No messages for now (or ever): write the pending lines
+		 * instead of waiting for the flush threshold.
+		 */
+		if ((next_status == BT_MESSAGE_ITERATOR_NEXT_STATUS_END ||
+				next_status == BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN) &&
+				write_pending_lines(jsonl)) {
+			BT_COMP_LOGE_APPEND_CAUSE(jsonl->self_comp,
+				"Failed to write the pending JSON lines.");
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+		}
+
+		goto end;
+	}
+
+	for (i = 0; i < count; i++) {
+		const bt_message *msg = msgs[i];
+
+		/* Only event messages have a JSON line */
+		if (bt_message_get_type(msg) == BT_MESSAGE_TYPE_EVENT &&
+				append_event_line(jsonl, msg)) {
+			BT_COMP_LOGE_APPEND_CAUSE(jsonl->self_comp,
+				"Failed to write one event.");
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		bt_message_put_ref(msg);
+	}
+
+	status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_OK;
+
+end:
+	for (; i < count; i++) {
+		bt_message_put_ref(msgs[i]);
+	}
+
+	return status;
+}
+
+static
+struct bt_param_validation_map_value_entry_descr jsonl_params[] = {
+	{ "path", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_STRING } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+bt_component_class_initialize_method_status jsonl_init(
+		bt_self_component_sink *self_comp_sink,
+		bt_self_component_sink_configuration *config __attribute__((unused)),
+		const bt_value *params,
+		void *init_method_data __attribute__((unused)))
+{
+	bt_component_class_initialize_method_status status;
+	bt_self_component_add_port_status add_port_status;
+	bt_self_component *self_comp =
+		bt_self_component_sink_as_self_component(self_comp_sink);
+	const bt_component *comp = bt_self_component_as_component(self_comp);
+	bt_logging_level log_level = bt_component_get_logging_level(comp);
+	struct jsonl_component *jsonl = g_new0(struct jsonl_component, 1);
+	enum bt_param_validation_status validation_status;
+	gchar *validate_error = NULL;
+	const bt_value *path;
+
+	if (!jsonl) {
+		/*
+		 * Don't use BT_COMP_LOGE_APPEND_CAUSE, as `jsonl` is not
+		 * initialized yet.
+		 */
+		BT_COMP_LOG_CUR_LVL(BT_LOG_ERROR, log_level, self_comp,
+			"Failed to allocate component.");
+		BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(
+			self_comp, "Failed to allocate component.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	jsonl->self_comp = self_comp;
+	jsonl->log_level = log_level;
+	jsonl->out = stdout;
+	jsonl->buf = g_string_sized_new(JSONL_OUTPUT_FLUSH_THRESHOLD + 4096);
+	jsonl->event_class_templates = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, NULL, destroy_event_class_template);
+	jsonl->struct_keys = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, NULL, destroy_struct_keys);
+	if (!jsonl->buf || !jsonl->event_class_templates ||
+			!jsonl->struct_keys) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "Failed to allocate buffers.");
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	add_port_status = bt_self_component_sink_add_input_port(self_comp_sink,
+		in_port_name, NULL, NULL);
+	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
+		status = (int) add_port_status;
+		goto error;
+	}
+
+	validation_status = bt_param_validation_validate(params,
+		jsonl_params, &validate_error);
+	if (validation_status == BT_PARAM_VALIDATION_STATUS_MEMORY_ERROR) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	} else if (validation_status == BT_PARAM_VALIDATION_STATUS_VALIDATION_ERROR) {
+		BT_COMP_LOGE_APPEND_CAUSE(self_comp, "%s", validate_error);
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto error;
+	}
+
+	path = bt_value_map_borrow_entry_value_const(params, "path");
+	if (path) {
+		jsonl->output_path = g_strdup(bt_value_string_get(path));
+		jsonl->out = fopen(jsonl->output_path, "w");
+		if (!jsonl->out) {
+			BT_COMP_LOGE_APPEND_CAUSE_ERRNO(self_comp,
+				"Failed to open output file", ": path=\"%s\"",
+				jsonl->output_path);
+			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+			goto error;
+		}
+	}
+
+	bt_self_component_set_data(self_comp, jsonl);
+	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
+	goto end;
+
+error:
+	destroy_jsonl_data(jsonl);
+
+end:
+	g_free(validate_error);
+	return status;
+}
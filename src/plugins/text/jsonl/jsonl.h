@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright (c) 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_TEXT_JSONL_JSONL_H
+#define BABELTRACE_PLUGINS_TEXT_JSONL_JSONL_H
+
+#include <glib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <babeltrace2/babeltrace.h>
+
+/*
+ * Length of pending JSON lines from which to write them to the output
+ * stream.
+ */
+#define JSONL_OUTPUT_FLUSH_THRESHOLD (256 * 1024)
+
+/* Precomputed output of a given event class */
+struct jsonl_event_class_template {
+	/* Owned by this */
+	const bt_event_class *event_class;
+
+	/*
+	 * Beginning of the JSON object of an event of `event_class`,
+	 * with its escaped name and its ID, for example:
+	 *
+	 *     {"name":"sched_switch","class-id":23,
+	 */
+	GString *prefix;
+};
+
+/* Precomputed member keys of a given structure field class */
+struct jsonl_struct_keys {
+	/* Owned by this */
+	const bt_field_class *fc;
+
+	/*
+	 * Array of owned `GString *`: escaped member names followed
+	 * with `:`, for example `"prev_comm":`, by member index.
+	 */
+	GPtrArray *keys;
+};
+
+struct jsonl_component {
+	bt_message_iterator *iterator;
+
+	/* Output stream (`stdout` or owned file) */
+	FILE *out;
+
+	/* Path of the output file (owned), or `NULL` for `stdout` */
+	char *output_path;
+
+	/* JSON lines which aren't written to `out` yet */
+	GString *buf;
+
+	/*
+	 * Weak `const bt_event_class *` to owned
+	 * `struct jsonl_event_class_template *`.
+	 */
+	GHashTable *event_class_templates;
+
+	/*
+	 * Weak `const bt_field_class *` to owned
+	 * `struct jsonl_struct_keys *`.
+	 */
+	GHashTable *struct_keys;
+
+	/* Last event class and its template */
+	const bt_event_class *last_event_class;
+	struct jsonl_event_class_template *last_template;
+
+	bt_logging_level log_level;
+	bt_self_component *self_comp;
+};
+
+bt_component_class_get_supported_mip_versions_method_status
+jsonl_supported_mip_versions(bt_self_component_class_sink *self_component_class,
+		const bt_value *params, void *initialize_method_data,
+		bt_logging_level logging_level,
+		bt_integer_range_set_unsigned *supported_versions);
+
+bt_component_class_initialize_method_status jsonl_init(
+		bt_self_component_sink *component,
+		bt_self_component_sink_configuration *config,
+		const bt_value *params,
+		void *init_method_data);
+
+bt_component_class_sink_consume_method_status jsonl_consume(
+		bt_self_component_sink *component);
+
+bt_component_class_sink_graph_is_configured_method_status jsonl_graph_is_configured(
+		bt_self_component_sink *component);
+
+void jsonl_finalize(bt_self_component_sink *component);
+
+#endif /* BABELTRACE_PLUGINS_TEXT_JSONL_JSONL_H */
@@ -8,6 +8,7 @@
 #include "pretty/pretty.h"
 #include "dmesg/dmesg.h"
 #include "details/details.h"
+#include "jsonl/jsonl.h"
 
 #ifndef BT_BUILT_IN_PLUGINS
 BT_PLUGIN_MODULE();
@@ -61,3 +62,16 @@ BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(details,
 	"Print messages with details.");
 BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(details,
 	"See the babeltrace2-sink.text.details(7) manual page.");
+
+/* jsonl sink */
+BT_PLUGIN_SINK_COMPONENT_CLASS(jsonl, jsonl_consume);
+BT_PLUGIN_SINK_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD(jsonl,
+	jsonl_supported_mip_versions);
+BT_PLUGIN_SINK_COMPONENT_CLASS_INITIALIZE_METHOD(jsonl, jsonl_init);
+BT_PLUGIN_SINK_COMPONENT_CLASS_FINALIZE_METHOD(jsonl, jsonl_finalize);
+BT_PLUGIN_SINK_COMPONENT_CLASS_GRAPH_IS_CONFIGURED_METHOD(jsonl,
+	jsonl_graph_is_configured);
+BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(jsonl,
+	"Write one JSON object per event message (JSON Lines).");
+BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(jsonl,
+	"See the babeltrace2-sink.text.jsonl(7) manual page.");
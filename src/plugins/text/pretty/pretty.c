@@ -54,6 +54,10 @@ void destroy_pretty_data(struct pretty_component *pretty)
 		(void) g_string_free(pretty->tmp_string, TRUE);
 	}
 
+	if (pretty->wall_prefix) {
+		(void) g_string_free(pretty->wall_prefix, TRUE);
+	}
+
 	if (pretty->out != stdout) {
 		int ret;
 
@@ -69,6 +73,14 @@ void destroy_pretty_data(struct pretty_component *pretty)
 		}
 	}
 
+	if (pretty->projections) {
+		g_hash_table_destroy(pretty->projections);
+	}
+
+	if (pretty->options.field_specs) {
+		g_ptr_array_free(pretty->options.field_specs, TRUE);
+	}
+
 	g_free(pretty->options.output_path);
 	g_free(pretty);
 
@@ -93,6 +105,10 @@ struct pretty_component *create_pretty(void)
 	if (!pretty->tmp_string) {
 		goto error;
 	}
+	pretty->wall_prefix = g_string_new("");
+	if (!pretty->wall_prefix) {
+		goto error;
+	}
 end:
 	return pretty;
 
@@ -103,9 +119,15 @@ error:
 
 void pretty_finalize(bt_self_component_sink *comp)
 {
-	destroy_pretty_data(
-		bt_self_component_get_data(
-			bt_self_component_sink_as_self_component(comp)));
+	struct pretty_component *pretty = bt_self_component_get_data(
+		bt_self_component_sink_as_self_component(comp));
+
+	/* Write what's left, for example if the graph got interrupted */
+	if (pretty->string && pretty_flush_output(pretty)) {
+		BT_COMP_LOGE("Failed to write the pending events.");
+	}
+
+	destroy_pretty_data(pretty);
 }
 
 static
@@ -196,6 +218,19 @@ bt_component_class_sink_consume_method_status pretty_consume(
 		&msgs, &count);
 	if (next_status != BT_MESSAGE_ITERATOR_NEXT_STATUS_OK) {
 		status = (int) next_status;
+
+		/*
+		 * No messages for now (or ever): write the pending events
+		 * instead of waiting for the flush threshold.
+		 */
+		if ((next_status == BT_MESSAGE_ITERATOR_NEXT_STATUS_END ||
+				next_status == BT_MESSAGE_ITERATOR_NEXT_STATUS_AGAIN) &&
+				pretty_flush_output(pretty)) {
+			BT_COMP_LOGE_APPEND_CAUSE(pretty->self_comp,
+				"Failed to write the pending events.");
+			status = BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_ERROR;
+		}
+
 		goto end;
 	}
 
@@ -293,9 +328,140 @@ end:
 	return ret;
 }
 
+static
+void destroy_field_spec(struct pretty_field_spec *spec)
+{
+	if (!spec) {
+		goto end;
+	}
+
+	g_free(spec->event_class_glob);
+	g_strfreev(spec->path);
+	g_free(spec->display_name);
+	g_free(spec);
+
+end:
+	return;
+}
+
+static
+const struct {
+	const char *prefix;
+	enum pretty_field_scope scope;
+} field_scope_prefixes[] = {
+	{ "stream.packet.context.", PRETTY_FIELD_SCOPE_PACKET_CONTEXT },
+	{ "stream.event.context.", PRETTY_FIELD_SCOPE_COMMON_CONTEXT },
+	{ "event.context.", PRETTY_FIELD_SCOPE_SPECIFIC_CONTEXT },
+	{ "event.fields.", PRETTY_FIELD_SCOPE_PAYLOAD },
+};
+
+/*
+ * Parses the `fields` parameter entry `str`, of the form
+ * `[GLOB:]PATH`, where `GLOB` is a star globbing pattern of event class
+ * names (`*` if missing) and `PATH` a dot-separated list of structure
+ * member names, optionally starting with a scope name (event payload
+ * if missing).
+ *
+ * The globbing pattern ends with the last colon, as event class
+ * names often contain colons, but member names don't.
+ *
+ * Returns `NULL` if `str` is invalid.
+ */
+static
+struct pretty_field_spec *create_field_spec(const char *str)
+{
+	struct pretty_field_spec *spec = g_new0(struct pretty_field_spec, 1);
+	const char *colon = strrchr(str, ':');
+	const char *path = str;
+	uint64_t i;
+
+	if (colon) {
+		spec->event_class_glob = g_strndup(str, colon - str);
+		path = colon + 1;
+	} else {
+		spec->event_class_glob = g_strdup("*");
+	}
+
+	bt_common_normalize_star_glob_pattern(spec->event_class_glob);
+	spec->display_name = g_strdup(path);
+	spec->scope = PRETTY_FIELD_SCOPE_PAYLOAD;
+
+	for (i = 0; i < G_N_ELEMENTS(field_scope_prefixes); i++) {
+		if (g_str_has_prefix(path, field_scope_prefixes[i].prefix)) {
+			spec->scope = field_scope_prefixes[i].scope;
+			path += strlen(field_scope_prefixes[i].prefix);
+			break;
+		}
+	}
+
+	spec->path = g_strsplit(path, ".", 0);
+
+	for (i = 0; spec->path[i]; i++) {
+		if (strlen(spec->path[i]) == 0) {
+			goto error;
+		}
+	}
+
+	if (i == 0) {
+		goto error;
+	}
+
+	goto end;
+
+error:
+	destroy_field_spec(spec);
+	spec = NULL;
+
+end:
+	return spec;
+}
+
+static
+int apply_fields(struct pretty_component *pretty, const bt_value *params)
+{
+	int ret = 0;
+	const bt_value *value;
+	uint64_t i;
+
+	value = bt_value_map_borrow_entry_value_const(params, "fields");
+	if (!value) {
+		goto end;
+	}
+
+	pretty->options.field_specs = g_ptr_array_new_with_free_func(
+		(GDestroyNotify) destroy_field_spec);
+	pretty->projections = g_hash_table_new_full(g_direct_hash,
+		g_direct_equal, (GDestroyNotify) bt_event_class_put_ref,
+		(GDestroyNotify) pretty_destroy_event_class_projection);
+
+	for (i = 0; i < bt_value_array_get_length(value); i++) {
+		const char *str = bt_value_string_get(
+			bt_value_array_borrow_element_by_index_const(value, i));
+		struct pretty_field_spec *spec = create_field_spec(str);
+
+		if (!spec) {
+			BT_COMP_LOGE_APPEND_CAUSE(pretty->self_comp,
+				"Invalid `fields` parameter entry: entry=\"%s\"",
+				str);
+			ret = -1;
+			goto end;
+		}
+
+		g_ptr_array_add(pretty->options.field_specs, spec);
+	}
+
+end:
+	return ret;
+}
+
 static const char *color_choices[] = { "never", "auto", "always", NULL };
 static const char *show_hide_choices[] = { "show", "hide", NULL };
 
+static
+const struct bt_param_validation_value_descr fields_entry_descr = {
+	.type = BT_VALUE_TYPE_STRING,
+};
+
 static
 struct bt_param_validation_map_value_entry_descr pretty_params[] = {
 	{ "color", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { BT_VALUE_TYPE_STRING, .string = {
@@ -329,6 +495,11 @@ struct bt_param_validation_map_value_entry_descr pretty_params[] = {
 	{ "field-emf", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "field-callsite", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "print-enum-flags", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "fields", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_ARRAY, .array = {
+		.min_length = 1,
+		.max_length = BT_PARAM_VALIDATION_INFINITE,
+		.element_type = &fields_entry_descr,
+	} } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
@@ -525,6 +696,12 @@ bt_component_class_initialize_method_status apply_params(
 	apply_one_bool_if_specified("field-callsite", params,
 		&pretty->options.print_callsite_field);
 
+	ret = apply_fields(pretty, params);
+	if (ret) {
+		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+		goto end;
+	}
+
 	pretty_print_init();
 	status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_OK;
 
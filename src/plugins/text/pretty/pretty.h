@@ -19,6 +19,12 @@
  */
 #define ENUMERATION_MAX_BITFLAGS_COUNT (sizeof(uint64_t) * 8)
 
+/*
+ * Length of pending formatted events from which to write them to the
+ * output stream.
+ */
+#define PRETTY_OUTPUT_FLUSH_THRESHOLD (256 * 1024)
+
 enum pretty_default {
 	PRETTY_DEFAULT_UNSET,
 	PRETTY_DEFAULT_SHOW,
@@ -31,9 +37,68 @@ enum pretty_color_option {
 	PRETTY_COLOR_OPT_ALWAYS,
 };
 
+/*
+ * Scope of a field path of the `fields` parameter.
+ */
+enum pretty_field_scope {
+	PRETTY_FIELD_SCOPE_PACKET_CONTEXT,
+	PRETTY_FIELD_SCOPE_COMMON_CONTEXT,
+	PRETTY_FIELD_SCOPE_SPECIFIC_CONTEXT,
+	PRETTY_FIELD_SCOPE_PAYLOAD,
+};
+
+/*
+ * Entry of the `fields` parameter, as parsed.
+ */
+struct pretty_field_spec {
+	/* Normalized star globbing pattern of event class names */
+	char *event_class_glob;
+
+	enum pretty_field_scope scope;
+
+	/* Member names, from the scope structure field (NULL-terminated) */
+	char **path;
+
+	/* Field path as written, without the globbing pattern */
+	char *display_name;
+};
+
+/*
+ * Field of an event class, resolved from a `struct pretty_field_spec`.
+ */
+struct pretty_resolved_field {
+	enum pretty_field_scope scope;
+
+	/* Structure member indexes (`uint64_t`), from the scope field */
+	GArray *indexes;
+
+	/* Borrowed from the `struct pretty_field_spec` */
+	const char *display_name;
+};
+
+/*
+ * Fields to print for the events of a given event class.
+ */
+struct pretty_event_class_projection {
+	/*
+	 * False if the name of the event class matches no globbing
+	 * pattern of the `fields` parameter: print the whole event.
+	 */
+	bool selected;
+
+	/* `struct pretty_resolved_field` */
+	GArray *fields;
+};
+
 struct pretty_options {
 	char *output_path;
 
+	/*
+	 * `struct pretty_field_spec *`, or `NULL` without the `fields`
+	 * parameter.
+	 */
+	GPtrArray *field_specs;
+
 	enum pretty_default name_default;
 	enum pretty_default field_default;
 
@@ -68,6 +133,11 @@ struct pretty_component {
 	FILE *out, *err;
 	int depth;	/* nesting, used for tabulation alignment. */
 	bool start_line;
+
+	/*
+	 * Formatted events which aren't written to `out` yet, followed
+	 * with the event being formatted.
+	 */
 	GString *string;
 	GString *tmp_string;
 	bool use_colors;
@@ -80,6 +150,19 @@ struct pretty_component {
 
 	bool negative_timestamp_warning_done;
 
+	/*
+	 * Formatted date (if needed) and time of day, including the
+	 * trailing `.`, of the second `wall_prefix_sec`, if
+	 * `wall_prefix_valid` is true.
+	 *
+	 * Consecutive events mostly occur within the same second: this
+	 * avoids a bt_localtime_r()/bt_gmtime_r() and a strftime() call
+	 * per event.
+	 */
+	GString *wall_prefix;
+	uint64_t wall_prefix_sec;
+	bool wall_prefix_valid;
+
 	/*
 	 * For each bit of the integer backing the enumeration we have a list
 	 * (GPtrArray) of labels (char *) for that bit.
@@ -92,6 +175,16 @@ struct pretty_component {
 	 */
 	GPtrArray *enum_bit_labels[ENUMERATION_MAX_BITFLAGS_COUNT];
 
+	/*
+	 * Resolved fields of the `fields` parameter for each event
+	 * class seen so far (`const bt_event_class *` (owned reference)
+	 * to `struct pretty_event_class_projection *`), so that projecting
+	 * an event doesn't involve any name matching or lookup.
+	 *
+	 * `NULL` without the `fields` parameter.
+	 */
+	GHashTable *projections;
+
 	bt_logging_level log_level;
 	bt_self_component *self_comp;
 };
@@ -122,6 +215,14 @@ int pretty_print_event(struct pretty_component *pretty,
 int pretty_print_discarded_items(struct pretty_component *pretty,
 		const bt_message *msg);
 
+/*
+ * Writes the pending formatted events to the output stream.
+ */
+int pretty_flush_output(struct pretty_component *pretty);
+
 void pretty_print_init(void);
 
+void pretty_destroy_event_class_projection(
+		struct pretty_event_class_projection *projection);
+
 #endif /* BABELTRACE_PLUGINS_TEXT_PRETTY_PRETTY_H */
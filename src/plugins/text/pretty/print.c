@@ -71,7 +71,7 @@ void print_timestamp_cycles(struct pretty_component *pretty,
 	uint64_t cycles;
 
 	cycles = bt_clock_snapshot_get_value(clock_snapshot);
-	bt_common_g_string_append_printf(pretty->string, "%020" PRIu64, cycles);
+	bt_common_g_string_append_uint64(pretty->string, cycles, 20);
 
 	if (update_last) {
 		if (pretty->last_cycles_timestamp != -1ULL) {
@@ -145,6 +145,17 @@ void print_timestamp_wall(struct pretty_component *pretty,
 		struct tm tm;
 		time_t time_s = (time_t) ts_sec_abs;
 
+		if (G_LIKELY(!is_negative && pretty->wall_prefix_valid &&
+				ts_sec_abs == pretty->wall_prefix_sec)) {
+			/* Same second as the last time: reuse the prefix */
+			bt_common_g_string_append_len(pretty->string,
+				pretty->wall_prefix->str,
+				pretty->wall_prefix->len);
+			bt_common_g_string_append_uint64(pretty->string,
+				ts_nsec_abs, 9);
+			goto end;
+		}
+
 		if (is_negative && !pretty->negative_timestamp_warning_done) {
 			// TODO: log instead
 			fprintf(stderr, "[warning] Fallback to [sec.ns] to print negative time value. Use --clock-seconds.\n");
@@ -171,6 +182,9 @@ void print_timestamp_wall(struct pretty_component *pretty,
 				goto seconds;
 			}
 		}
+		g_string_truncate(pretty->wall_prefix, 0);
+		pretty->wall_prefix_valid = false;
+
 		if (pretty->options.clock_date) {
 			char timestr[26];
 			size_t res;
@@ -184,18 +198,39 @@ void print_timestamp_wall(struct pretty_component *pretty,
 				goto seconds;
 			}
 
-			bt_common_g_string_append(pretty->string, timestr);
+			bt_common_g_string_append_len(pretty->wall_prefix,
+				timestr, res);
 		}
 
 		/* Print time in HH:MM:SS.ns */
-		bt_common_g_string_append_printf(pretty->string,
-			"%02d:%02d:%02d.%09" PRIu64, tm.tm_hour, tm.tm_min,
-			tm.tm_sec, ts_nsec_abs);
+		bt_common_g_string_append_uint64(pretty->wall_prefix,
+			tm.tm_hour, 2);
+		bt_common_g_string_append_c(pretty->wall_prefix, ':');
+		bt_common_g_string_append_uint64(pretty->wall_prefix,
+			tm.tm_min, 2);
+		bt_common_g_string_append_c(pretty->wall_prefix, ':');
+		bt_common_g_string_append_uint64(pretty->wall_prefix,
+			tm.tm_sec, 2);
+		bt_common_g_string_append_c(pretty->wall_prefix, '.');
+		bt_common_g_string_append_len(pretty->string,
+			pretty->wall_prefix->str, pretty->wall_prefix->len);
+		bt_common_g_string_append_uint64(pretty->string, ts_nsec_abs, 9);
+
+		if (!is_negative) {
+			pretty->wall_prefix_sec = ts_sec_abs;
+			pretty->wall_prefix_valid = true;
+		}
+
 		goto end;
 	}
 seconds:
-	bt_common_g_string_append_printf(pretty->string, "%s%" PRId64 ".%09" PRIu64,
-		is_negative ? "-" : "", ts_sec_abs, ts_nsec_abs);
+	if (is_negative) {
+		bt_common_g_string_append_c(pretty->string, '-');
+	}
+
+	bt_common_g_string_append_uint64(pretty->string, ts_sec_abs, 0);
+	bt_common_g_string_append_c(pretty->string, '.');
+	bt_common_g_string_append_uint64(pretty->string, ts_nsec_abs, 9);
 end:
 	return;
 }
@@ -248,8 +283,9 @@ int print_event_timestamp(struct pretty_component *pretty,
 				bt_common_g_string_append(pretty->string,
 					"+??????????\?\?"); /* Not a trigraph. */
 			} else {
-				bt_common_g_string_append_printf(pretty->string,
-					"+%012" PRIu64, pretty->delta_cycles);
+				bt_common_g_string_append_c(pretty->string, '+');
+				bt_common_g_string_append_uint64(pretty->string,
+					pretty->delta_cycles, 12);
 			}
 		} else {
 			if (pretty->delta_real_timestamp != -1ULL) {
@@ -258,9 +294,12 @@ int print_event_timestamp(struct pretty_component *pretty,
 				delta = pretty->delta_real_timestamp;
 				delta_sec = delta / NSEC_PER_SEC;
 				delta_nsec = delta % NSEC_PER_SEC;
-				bt_common_g_string_append_printf(pretty->string,
-					"+%" PRIu64 ".%09" PRIu64,
-					delta_sec, delta_nsec);
+				bt_common_g_string_append_c(pretty->string, '+');
+				bt_common_g_string_append_uint64(pretty->string,
+					delta_sec, 0);
+				bt_common_g_string_append_c(pretty->string, '.');
+				bt_common_g_string_append_uint64(pretty->string,
+					delta_nsec, 9);
 			} else {
 				bt_common_g_string_append(pretty->string, "+?.?????????");
 			}
@@ -565,9 +604,9 @@ int print_integer(struct pretty_component *pretty,
 	case BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_DECIMAL:
 		if (bt_field_class_type_is(ft_type,
 				BT_FIELD_CLASS_TYPE_UNSIGNED_INTEGER)) {
-			bt_common_g_string_append_printf(pretty->string, "%" PRIu64, v.u);
+			bt_common_g_string_append_uint64(pretty->string, v.u, 0);
 		} else {
-			bt_common_g_string_append_printf(pretty->string, "%" PRId64, v.s);
+			bt_common_g_string_append_int64(pretty->string, v.s);
 		}
 		break;
 	case BT_FIELD_CLASS_INTEGER_PREFERRED_DISPLAY_BASE_HEXADECIMAL:
@@ -582,7 +621,8 @@ int print_integer(struct pretty_component *pretty,
 			v.u &= ((uint64_t) 1 << rounded_len) - 1;
 		}
 
-		bt_common_g_string_append_printf(pretty->string, "0x%" PRIX64, v.u);
+		bt_common_g_string_append(pretty->string, "0x");
+		bt_common_g_string_append_uint64_hex(pretty->string, v.u);
 		break;
 	}
 	default:
@@ -1032,7 +1072,8 @@ int print_bit_array(struct pretty_component *pretty, const bt_field *field)
 			color_number_value);
 	}
 
-	bt_common_g_string_append_printf(pretty->string, "0x%" PRIX64, v);
+	bt_common_g_string_append(pretty->string, "0x");
+	bt_common_g_string_append_uint64_hex(pretty->string, v);
 
 	if (pretty->use_colors) {
 		bt_common_g_string_append(pretty->string, color_rst);
@@ -1165,7 +1206,9 @@ int print_array_field(struct pretty_component *pretty,
 		bt_common_g_string_append(pretty->string, " ");
 	}
 	if (print_names) {
-		bt_common_g_string_append_printf(pretty->string, "[%" PRIu64 "] = ", i);
+		bt_common_g_string_append_c(pretty->string, '[');
+		bt_common_g_string_append_uint64(pretty->string, i, 0);
+		bt_common_g_string_append(pretty->string, "] = ");
 	}
 
 	field = bt_field_array_borrow_element_field_by_index_const(array, i);
@@ -1209,7 +1252,9 @@ int print_sequence_field(struct pretty_component *pretty,
 		bt_common_g_string_append(pretty->string, " ");
 	}
 	if (print_names) {
-		bt_common_g_string_append_printf(pretty->string, "[%" PRIu64 "] = ", i);
+		bt_common_g_string_append_c(pretty->string, '[');
+		bt_common_g_string_append_uint64(pretty->string, i, 0);
+		bt_common_g_string_append(pretty->string, "] = ");
 	}
 
 	field = bt_field_array_borrow_element_field_by_index_const(seq, i);
@@ -1508,6 +1553,249 @@ end:
 	return ret;
 }
 
+void pretty_destroy_event_class_projection(
+		struct pretty_event_class_projection *projection)
+{
+	uint64_t i;
+
+	if (!projection) {
+		goto end;
+	}
+
+	if (projection->fields) {
+		for (i = 0; i < projection->fields->len; i++) {
+			struct pretty_resolved_field *field = &g_array_index(
+				projection->fields,
+				struct pretty_resolved_field, i);
+
+			g_array_free(field->indexes, TRUE);
+		}
+
+		g_array_free(projection->fields, TRUE);
+	}
+
+	g_free(projection);
+
+end:
+	return;
+}
+
+static
+const bt_field_class *borrow_scope_field_class(
+		const bt_event_class *event_class, enum pretty_field_scope scope)
+{
+	const bt_stream_class *stream_class =
+		bt_event_class_borrow_stream_class_const(event_class);
+
+	switch (scope) {
+	case PRETTY_FIELD_SCOPE_PACKET_CONTEXT:
+		return bt_stream_class_borrow_packet_context_field_class_const(
+			stream_class);
+	case PRETTY_FIELD_SCOPE_COMMON_CONTEXT:
+		return bt_stream_class_borrow_event_common_context_field_class_const(
+			stream_class);
+	case PRETTY_FIELD_SCOPE_SPECIFIC_CONTEXT:
+		return bt_event_class_borrow_specific_context_field_class_const(
+			event_class);
+	case PRETTY_FIELD_SCOPE_PAYLOAD:
+		return bt_event_class_borrow_payload_field_class_const(
+			event_class);
+	}
+
+	bt_common_abort();
+}
+
+static
+const bt_field *borrow_scope_field(const bt_event *event,
+		enum pretty_field_scope scope)
+{
+	const bt_packet *packet;
+
+	switch (scope) {
+	case PRETTY_FIELD_SCOPE_PACKET_CONTEXT:
+		packet = bt_event_borrow_packet_const(event);
+		return packet ? bt_packet_borrow_context_field_const(packet) : NULL;
+	case PRETTY_FIELD_SCOPE_COMMON_CONTEXT:
+		return bt_event_borrow_common_context_field_const(event);
+	case PRETTY_FIELD_SCOPE_SPECIFIC_CONTEXT:
+		return bt_event_borrow_specific_context_field_const(event);
+	case PRETTY_FIELD_SCOPE_PAYLOAD:
+		return bt_event_borrow_payload_field_const(event);
+	}
+
+	bt_common_abort();
+}
+
+/*
+ * Appends to `indexes` the member indexes of the structure field path
+ * `path`, from the structure field class `fc`.
+ *
+ * Returns false if `path` doesn't exist within `fc`.
+ */
+static
+bool resolve_field_path(const bt_field_class *fc, char * const *path,
+		GArray *indexes)
+{
+	for (; *path; path++) {
+		const bt_field_class_structure_member *member = NULL;
+		uint64_t count, i;
+
+		if (!fc || bt_field_class_get_type(fc) !=
+				BT_FIELD_CLASS_TYPE_STRUCTURE) {
+			return false;
+		}
+
+		count = bt_field_class_structure_get_member_count(fc);
+
+		for (i = 0; i < count; i++) {
+			member = bt_field_class_structure_borrow_member_by_index_const(
+				fc, i);
+
+			if (strcmp(bt_field_class_structure_member_get_name(member),
+					*path) == 0) {
+				break;
+			}
+		}
+
+		if (i == count) {
+			return false;
+		}
+
+		g_array_append_val(indexes, i);
+		fc = bt_field_class_structure_member_borrow_field_class_const(
+			member);
+	}
+
+	return true;
+}
+
+/*
+ * Resolves the `fields` parameter entries which apply to the event
+ * class `event_class`, skipping the ones of which the field path
+ * doesn't exist.
+ */
+static
+struct pretty_event_class_projection *create_event_class_projection(
+		struct pretty_component *pretty,
+		const bt_event_class *event_class)
+{
+	struct pretty_event_class_projection *projection =
+		g_new0(struct pretty_event_class_projection, 1);
+	const char *name = bt_event_class_get_name(event_class);
+	uint64_t i;
+
+	projection->fields = g_array_new(FALSE, FALSE,
+		sizeof(struct pretty_resolved_field));
+
+	if (!name) {
+		goto end;
+	}
+
+	for (i = 0; i < pretty->options.field_specs->len; i++) {
+		const struct pretty_field_spec *spec =
+			g_ptr_array_index(pretty->options.field_specs, i);
+		struct pretty_resolved_field field;
+
+		if (!bt_common_star_glob_match(spec->event_class_glob,
+				SIZE_MAX, name, SIZE_MAX)) {
+			continue;
+		}
+
+		projection->selected = true;
+		field.scope = spec->scope;
+		field.display_name = spec->display_name;
+		field.indexes = g_array_new(FALSE, FALSE, sizeof(uint64_t));
+
+		if (!resolve_field_path(
+				borrow_scope_field_class(event_class, spec->scope),
+				spec->path, field.indexes)) {
+			g_array_free(field.indexes, TRUE);
+			continue;
+		}
+
+		g_array_append_val(projection->fields, field);
+	}
+
+end:
+	return projection;
+}
+
+static
+const struct pretty_event_class_projection *borrow_event_class_projection(
+		struct pretty_component *pretty,
+		const bt_event_class *event_class)
+{
+	struct pretty_event_class_projection *projection =
+		g_hash_table_lookup(pretty->projections, event_class);
+
+	if (!projection) {
+		projection = create_event_class_projection(pretty, event_class);
+		bt_event_class_get_ref(event_class);
+		g_hash_table_insert(pretty->projections, (gpointer) event_class,
+			projection);
+	}
+
+	return projection;
+}
+
+/*
+ * Prints, as a single structure, the fields of `projection` of the event
+ * `event`, skipping the ones which `event` doesn't have.
+ */
+static
+int print_projected_fields(struct pretty_component *pretty,
+		const bt_event *event,
+		const struct pretty_event_class_projection *projection)
+{
+	int ret = 0;
+	uint64_t nr_printed_fields = 0;
+	uint64_t i, j;
+
+	if (!pretty->start_line) {
+		bt_common_g_string_append(pretty->string, ", ");
+	}
+	pretty->start_line = false;
+	bt_common_g_string_append(pretty->string, "{");
+	pretty->depth++;
+
+	for (i = 0; i < projection->fields->len; i++) {
+		const struct pretty_resolved_field *resolved = &g_array_index(
+			projection->fields, struct pretty_resolved_field, i);
+		const bt_field *field = borrow_scope_field(event,
+			resolved->scope);
+
+		for (j = 0; field && j < resolved->indexes->len; j++) {
+			field = bt_field_structure_borrow_member_field_by_index_const(
+				field, g_array_index(resolved->indexes, uint64_t, j));
+		}
+
+		if (!field) {
+			continue;
+		}
+
+		if (nr_printed_fields > 0) {
+			bt_common_g_string_append(pretty->string, ", ");
+		} else {
+			bt_common_g_string_append(pretty->string, " ");
+		}
+
+		print_field_name_equal(pretty, resolved->display_name);
+		ret = print_field(pretty, field,
+			pretty->options.print_payload_field_names);
+		if (ret != 0) {
+			goto end;
+		}
+
+		nr_printed_fields++;
+	}
+
+	pretty->depth--;
+	bt_common_g_string_append(pretty->string, " }");
+
+end:
+	return ret;
+}
+
 static
 int flush_buf(FILE *stream, struct pretty_component *pretty)
 {
@@ -1525,6 +1813,14 @@ end:
 	return ret;
 }
 
+int pretty_flush_output(struct pretty_component *pretty)
+{
+	int ret = flush_buf(pretty->out, pretty);
+
+	g_string_truncate(pretty->string, 0);
+	return ret;
+}
+
 int pretty_print_event(struct pretty_component *pretty,
 		const bt_message *event_msg)
 {
@@ -1532,14 +1828,32 @@ int pretty_print_event(struct pretty_component *pretty,
 	const bt_event *event =
 		bt_message_event_borrow_event_const(event_msg);
 
+	/* Append to the pending formatted events */
+	const gsize event_offset = pretty->string->len;
+
 	BT_ASSERT_DBG(event);
 	pretty->start_line = true;
-	g_string_assign(pretty->string, "");
 	ret = print_event_header(pretty, event_msg);
 	if (ret != 0) {
 		goto end;
 	}
 
+	if (pretty->projections) {
+		const struct pretty_event_class_projection *projection =
+			borrow_event_class_projection(pretty,
+				bt_event_borrow_class_const(event));
+
+		if (projection->selected) {
+			ret = print_projected_fields(pretty, event,
+				projection);
+			if (ret != 0) {
+				goto end;
+			}
+
+			goto end_event;
+		}
+	}
+
 	ret = print_stream_packet_context(pretty, event);
 	if (ret != 0) {
 		goto end;
@@ -1560,13 +1874,23 @@ int pretty_print_event(struct pretty_component *pretty,
 		goto end;
 	}
 
+end_event:
 	bt_common_g_string_append_c(pretty->string, '\n');
-	if (flush_buf(pretty->out, pretty)) {
-		ret = -1;
-		goto end;
+
+	/*
+	 * Write many events at once instead of calling fwrite() for
+	 * each one of them.
+	 */
+	if (pretty->string->len >= PRETTY_OUTPUT_FLUSH_THRESHOLD) {
+		ret = pretty_flush_output(pretty);
 	}
 
 end:
+	if (ret) {
+		/* Discard the partially formatted event */
+		g_string_truncate(pretty->string, event_offset);
+	}
+
 	return ret;
 }
 
@@ -1617,8 +1941,13 @@ int print_discarded_elements_msg(struct pretty_component *pretty,
 		trace_uid = bt_trace_get_uid(trace);
 	}
 
+	/* Keep the output order of the pending events */
+	if (pretty_flush_output(pretty)) {
+		ret = -1;
+		goto end;
+	}
+
 	/* Format message */
-	g_string_assign(pretty->string, "");
 
 	if (count == UINT64_C(-1)) {
 		init_msg = "Tracer may have discarded";
@@ -1695,6 +2024,9 @@ int print_discarded_elements_msg(struct pretty_component *pretty,
 		ret = -1;
 	}
 
+	g_string_truncate(pretty->string, 0);
+
+end:
 	return ret;
 }
 
@@ -0,0 +1,366 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <cstring>
+#include <set>
+
+#include "common/common.h"
+#include "cpp-common/bt2s/optional.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "comp.hpp"
+
+namespace bt2agg {
+namespace {
+
+/* Returns the default output member name of the field path `fieldPath` */
+std::string defMemberName(const FieldPath& fieldPath)
+{
+    std::string name;
+
+    for (const auto& memberName : fieldPath.memberNames) {
+        if (!name.empty()) {
+            name += '_';
+        }
+
+        name += memberName;
+    }
+
+    return name;
+}
+
+/* Returns the numeric value of `val`, or `bt2s::nullopt` if it's not a number */
+bt2s::optional<double> numVal(const bt2::ConstValue val) noexcept
+{
+    if (val.isUnsignedInteger()) {
+        return static_cast<double>(val.asUnsignedInteger().value());
+    } else if (val.isSignedInteger()) {
+        return static_cast<double>(val.asSignedInteger().value());
+    } else if (val.isReal()) {
+        return val.asReal().value();
+    }
+
+    return bt2s::nullopt;
+}
+
+} /* namespace */
+
+Comp::Comp(const bt2::SelfFilterComponent selfComp, const bt2::ConstMapValue params, void *) :
+    bt2::UserFilterComponent<Comp, MsgIter> {selfComp, "PLUGIN/FLT.UTILS.AGGREGATE"}
+{
+    BT_CPPLOGI("Initializing component.");
+
+    auto knownParamCount = 1ULL;
+
+    if (const auto nameVal = params["name"]) {
+        if (!nameVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "`name` parameter: expecting a string.");
+        }
+
+        _mNamePattern = nameVal->asString().value().data();
+        bt_common_normalize_star_glob_pattern(&_mNamePattern[0]);
+        _mNamePattern.resize(std::strlen(_mNamePattern.c_str()));
+        ++knownParamCount;
+    }
+
+    if (const auto windowVal = params["window"]) {
+        if (!windowVal->isUnsignedInteger() || windowVal->asUnsignedInteger().value() == 0) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`window` parameter: expecting a positive unsigned integer.");
+        }
+
+        _mWindowDurNs = windowVal->asUnsignedInteger().value();
+        ++knownParamCount;
+    }
+
+    if (const auto groupByVal = params["group-by"]) {
+        if (!groupByVal->isArray()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "`group-by` parameter: expecting an array.");
+        }
+
+        if (groupByVal->asArray().length() > maxGroupKeyCount) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`group-by` parameter: too many keys: key-count={}, max-key-count={}",
+                groupByVal->asArray().length(), maxGroupKeyCount);
+        }
+
+        for (std::uint64_t i = 0; i < groupByVal->asArray().length(); ++i) {
+            const auto keyVal = groupByVal->asArray()[i];
+
+            if (!keyVal.isString()) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                    bt2c::Error, "`group-by[{}]` parameter: expecting a string.", i);
+            }
+
+            GroupKey key;
+
+            key.fieldPath = this->_parseFieldPath(keyVal.asString().value(),
+                                                  fmt::format("group-by[{}]", i));
+            key.name = defMemberName(key.fieldPath);
+            _mGroupKeys.emplace_back(std::move(key));
+        }
+
+        ++knownParamCount;
+    }
+
+    const auto aggsVal = params["aggregates"];
+
+    if (!aggsVal || !aggsVal->isArray() || aggsVal->asArray().isEmpty()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Missing or invalid `aggregates` parameter: "
+                                          "expecting a non-empty array.");
+    }
+
+    for (std::uint64_t i = 0; i < aggsVal->asArray().length(); ++i) {
+        _mAggs.emplace_back(this->_parseAgg(aggsVal->asArray()[i], i));
+    }
+
+    if (params.length() != knownParamCount) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "This component expects no parameters other than "
+                                          "'aggregates', 'group-by', 'name', and 'window': "
+                                          "param-count={}",
+                                          params.length());
+    }
+
+    this->_checkMemberNames();
+
+    try {
+        this->_addInputPort("in");
+        this->_addOutputPort("out");
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to add the ports.");
+    }
+
+    BT_CPPLOGI("Initialized component: name-pattern={}, window-ns={}, group-key-count={}, "
+               "aggregate-count={}",
+               _mNamePattern, _mWindowDurNs, _mGroupKeys.size(), _mAggs.size());
+}
+
+FieldPath Comp::_parseFieldPath(const bt2c::CStringView str, const std::string& what) const
+{
+    FieldPath fieldPath;
+    const std::string fullStr {str.data()};
+    std::string::size_type begin = 0;
+
+    while (true) {
+        const auto end = fullStr.find('.', begin);
+
+        fieldPath.memberNames.emplace_back(fullStr.substr(begin, end - begin));
+
+        if (end == std::string::npos) {
+            break;
+        }
+
+        begin = end + 1;
+    }
+
+    /* Scope */
+    const auto& first = fieldPath.memberNames.front();
+
+    if (!first.empty() && first[0] == '$') {
+        if (first == "$payload") {
+            fieldPath.scope = Scope::Payload;
+        } else if (first == "$specific_ctx") {
+            fieldPath.scope = Scope::SpecificContext;
+        } else if (first == "$common_ctx") {
+            fieldPath.scope = Scope::CommonContext;
+        } else {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "`{}` parameter: unknown scope `{}`: "
+                                              "expecting `$payload`, `$specific_ctx`, or "
+                                              "`$common_ctx`.",
+                                              what, first);
+        }
+
+        fieldPath.memberNames.erase(fieldPath.memberNames.begin());
+    }
+
+    if (fieldPath.memberNames.empty()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "`{}` parameter: missing member name: {}",
+                                          what, fullStr);
+    }
+
+    for (const auto& memberName : fieldPath.memberNames) {
+        if (memberName.empty()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "`{}` parameter: empty member name: {}", what,
+                                              fullStr);
+        }
+    }
+
+    return fieldPath;
+}
+
+Agg Comp::_parseAgg(const bt2::ConstValue aggVal, const std::uint64_t index) const
+{
+    if (!aggVal.isMap()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "`aggregates[{}]` parameter: expecting a map.", index);
+    }
+
+    const auto aggMapVal = aggVal.asMap();
+    auto knownEntryCount = 1ULL;
+    Agg agg;
+
+    /* Function */
+    {
+        const auto funcVal = aggMapVal["function"];
+
+        if (!funcVal || !funcVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "Missing or invalid `aggregates[{}].function` parameter: expecting a string.",
+                index);
+        }
+
+        const auto func = funcVal->asString().value();
+
+        if (func == "count") {
+            agg.func = AggFunc::Count;
+        } else if (func == "sum") {
+            agg.func = AggFunc::Sum;
+        } else if (func == "min") {
+            agg.func = AggFunc::Min;
+        } else if (func == "max") {
+            agg.func = AggFunc::Max;
+        } else if (func == "histogram") {
+            agg.func = AggFunc::Histogram;
+        } else {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "`aggregates[{}].function` parameter: unknown function `{}`: expecting "
+                "`count`, `sum`, `min`, `max`, or `histogram`.",
+                index, func);
+        }
+    }
+
+    /* Field */
+    if (const auto fieldVal = aggMapVal["field"]) {
+        if (agg.func == AggFunc::Count) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`aggregates[{}].field` parameter: unexpected with `count`.", index);
+        }
+
+        if (!fieldVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`aggregates[{}].field` parameter: expecting a string.", index);
+        }
+
+        agg.fieldPath = this->_parseFieldPath(fieldVal->asString().value(),
+                                              fmt::format("aggregates[{}].field", index));
+        ++knownEntryCount;
+    } else if (agg.func != AggFunc::Count) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "Missing `aggregates[{}].field` parameter.", index);
+    }
+
+    /* Bounds */
+    if (const auto boundsVal = aggMapVal["bounds"]) {
+        if (agg.func != AggFunc::Histogram) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`aggregates[{}].bounds` parameter: only valid with `histogram`.",
+                index);
+        }
+
+        if (!boundsVal->isArray() || boundsVal->asArray().isEmpty()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`aggregates[{}].bounds` parameter: expecting a non-empty array.",
+                index);
+        }
+
+        for (std::uint64_t i = 0; i < boundsVal->asArray().length(); ++i) {
+            const auto bound = numVal(boundsVal->asArray()[i]);
+
+            if (!bound) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                    bt2c::Error, "`aggregates[{}].bounds[{}]` parameter: expecting a number.",
+                    index, i);
+            }
+
+            if (!agg.bounds.empty() && !(*bound > agg.bounds.back())) {
+                BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                    bt2c::Error,
+                    "`aggregates[{}].bounds` parameter: expecting strictly increasing numbers.",
+                    index);
+            }
+
+            agg.bounds.push_back(*bound);
+        }
+
+        ++knownEntryCount;
+    } else if (agg.func == AggFunc::Histogram) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "Missing `aggregates[{}].bounds` parameter.", index);
+    }
+
+    /* Output member name */
+    if (const auto nameVal = aggMapVal["name"]) {
+        if (!nameVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`aggregates[{}].name` parameter: expecting a string.", index);
+        }
+
+        agg.name = nameVal->asString().value().data();
+        ++knownEntryCount;
+    } else if (agg.func == AggFunc::Count) {
+        agg.name = "count";
+    } else {
+        agg.name = fmt::format("{}_{}", aggMapVal["function"]->asString().value(),
+                               defMemberName(agg.fieldPath));
+    }
+
+    if (aggMapVal.length() != knownEntryCount) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "`aggregates[{}]` parameter: expecting no entries "
+                                          "other than 'function', 'field', 'bounds', and "
+                                          "'name': entry-count={}",
+                                          index, aggMapVal.length());
+    }
+
+    return agg;
+}
+
+void Comp::_checkMemberNames() const
+{
+    std::set<std::string> names;
+
+    const auto check = [this, &names](const std::string& name) {
+        if (name.empty()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "Empty output member name.");
+        }
+
+        if (!names.insert(name).second) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "Duplicate output member name `{}`: use the `name` entry of an aggregate.", name);
+        }
+    };
+
+    for (const auto& key : _mGroupKeys) {
+        check(key.name);
+    }
+
+    for (const auto& agg : _mAggs) {
+        check(agg.name);
+    }
+}
+
+bool Comp::eventClsNameMatches(const bt2c::CStringView name) const noexcept
+{
+    return bt_common_star_glob_match(_mNamePattern.data(), _mNamePattern.size(), name.data(),
+                                     name.len());
+}
+
+void Comp::_getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue, bt2::LoggingLevel,
+                                    const bt2::UnsignedIntegerRangeSet ranges)
+{
+    ranges.addRange(0, 1);
+}
+
+} /* namespace bt2agg */
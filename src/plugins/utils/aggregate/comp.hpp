@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_AGGREGATE_COMP_HPP
+#define BABELTRACE_PLUGINS_UTILS_AGGREGATE_COMP_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpp-common/bt2/plugin-dev.hpp"
+#include "cpp-common/bt2c/c-string-view.hpp"
+
+#include "field-path.hpp"
+#include "msg-iter.hpp"
+
+namespace bt2agg {
+
+/* Group-by key */
+struct GroupKey final
+{
+    FieldPath fieldPath;
+
+    /* Name of the output member */
+    std::string name;
+};
+
+/* Aggregate function */
+enum class AggFunc
+{
+    Count,
+    Sum,
+    Min,
+    Max,
+    Histogram,
+};
+
+/* Aggregate */
+struct Agg final
+{
+    AggFunc func = AggFunc::Count;
+
+    /* Aggregated field (not for `AggFunc::Count`) */
+    FieldPath fieldPath;
+
+    /* Name of the output member */
+    std::string name;
+
+    /* Strictly increasing bucket bounds for `AggFunc::Histogram` */
+    std::vector<double> bounds;
+};
+
+class MsgIter;
+
+class Comp final : public bt2::UserFilterComponent<Comp, MsgIter>
+{
+    friend class MsgIter;
+    friend bt2::UserFilterComponent<Comp, MsgIter>;
+
+public:
+    /* Maximum number of group-by keys */
+    static constexpr std::size_t maxGroupKeyCount = 64;
+
+    explicit Comp(bt2::SelfFilterComponent selfComp, bt2::ConstMapValue params, void *);
+
+    /* Whether or not the event class name `name` matches the `name` parameter */
+    bool eventClsNameMatches(bt2c::CStringView name) const noexcept;
+
+    /* Duration of a window (ns) */
+    std::uint64_t windowDurNs() const noexcept
+    {
+        return _mWindowDurNs;
+    }
+
+    const std::vector<GroupKey>& groupKeys() const noexcept
+    {
+        return _mGroupKeys;
+    }
+
+    const std::vector<Agg>& aggs() const noexcept
+    {
+        return _mAggs;
+    }
+
+protected:
+    static void _getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue,
+                                         bt2::LoggingLevel, bt2::UnsignedIntegerRangeSet ranges);
+
+private:
+    /* Parses the field path `str`, the value of the parameter `what` */
+    FieldPath _parseFieldPath(bt2c::CStringView str, const std::string& what) const;
+
+    /* Parses the aggregate `aggVal`, the element at the index `index` of `aggregates` */
+    Agg _parseAgg(bt2::ConstValue aggVal, std::uint64_t index) const;
+
+    /* Throws if two output members have the same name */
+    void _checkMemberNames() const;
+
+    std::string _mNamePattern = "*";
+    std::uint64_t _mWindowDurNs = 1000000000;
+    std::vector<GroupKey> _mGroupKeys;
+    std::vector<Agg> _mAggs;
+};
+
+} /* namespace bt2agg */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_AGGREGATE_COMP_HPP */
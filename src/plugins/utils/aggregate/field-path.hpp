@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_AGGREGATE_FIELD_PATH_HPP
+#define BABELTRACE_PLUGINS_UTILS_AGGREGATE_FIELD_PATH_HPP
+
+#include <string>
+#include <vector>
+
+namespace bt2agg {
+
+/* Root field of a field path */
+enum class Scope
+{
+    Payload,
+    SpecificContext,
+    CommonContext,
+};
+
+/* Path to a field of an event, from one of its root fields */
+struct FieldPath final
+{
+    Scope scope = Scope::Payload;
+    std::vector<std::string> memberNames;
+};
+
+} /* namespace bt2agg */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_AGGREGATE_FIELD_PATH_HPP */
@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+
+#include <glib.h>
+
+#include "common/assert.h"
+
+#include "group-table.hpp"
+
+namespace bt2agg {
+namespace {
+
+/* Initial number of slots (power of two) */
+constexpr std::size_t initSlotCount = 64;
+
+} /* namespace */
+
+GroupTable::GroupTable(const std::size_t keyWordCount) :
+    _mKeyWordCount {keyWordCount}, _mSlots(initSlotCount, 0)
+{
+}
+
+std::uint64_t GroupTable::_hash(const std::uint64_t * const key) const noexcept
+{
+    auto hash = UINT64_C(0xcbf29ce484222325);
+
+    for (std::size_t i = 0; i < _mKeyWordCount; ++i) {
+        hash ^= key[i];
+        hash *= UINT64_C(0x9e3779b97f4a7c15);
+        hash ^= hash >> 32;
+    }
+
+    return hash;
+}
+
+bool GroupTable::_keyEquals(const std::uint64_t index, const std::uint64_t * const key) const noexcept
+{
+    return std::equal(key, key + _mKeyWordCount, this->key(index));
+}
+
+std::uint64_t GroupTable::insert(const std::uint64_t * const key, bool& isNew)
+{
+    const auto hash = this->_hash(key);
+    const auto mask = _mSlots.size() - 1;
+
+    for (auto slotIndex = hash & mask;; slotIndex = (slotIndex + 1) & mask) {
+        const auto slot = _mSlots[slotIndex];
+
+        if (slot == 0) {
+            /* New group */
+            const auto index = _mHashes.size();
+
+            BT_ASSERT_DBG(index < UINT32_MAX);
+            _mSlots[slotIndex] = static_cast<std::uint32_t>(index + 1);
+            _mHashes.push_back(hash);
+            _mKeys.insert(_mKeys.end(), key, key + _mKeyWordCount);
+
+            if (G_UNLIKELY(_mHashes.size() * 2 > _mSlots.size())) {
+                this->_grow();
+            }
+
+            isNew = true;
+            return index;
+        }
+
+        if (_mHashes[slot - 1] == hash && this->_keyEquals(slot - 1, key)) {
+            isNew = false;
+            return slot - 1;
+        }
+    }
+}
+
+void GroupTable::_grow()
+{
+    _mSlots.assign(_mSlots.size() * 2, 0);
+
+    const auto mask = _mSlots.size() - 1;
+
+    for (std::size_t index = 0; index < _mHashes.size(); ++index) {
+        auto slotIndex = _mHashes[index] & mask;
+
+        while (_mSlots[slotIndex] != 0) {
+            slotIndex = (slotIndex + 1) & mask;
+        }
+
+        _mSlots[slotIndex] = static_cast<std::uint32_t>(index + 1);
+    }
+}
+
+void GroupTable::clear() noexcept
+{
+    std::fill(_mSlots.begin(), _mSlots.end(), 0);
+    _mHashes.clear();
+    _mKeys.clear();
+}
+
+} /* namespace bt2agg */
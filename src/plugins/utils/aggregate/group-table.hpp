@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_AGGREGATE_GROUP_TABLE_HPP
+#define BABELTRACE_PLUGINS_UTILS_AGGREGATE_GROUP_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bt2agg {
+
+/*
+ * Flat open-addressing hash table of groups.
+ *
+ * A group key is a fixed number of 64-bit words. The table maps each
+ * distinct key to a dense group index, in insertion order, so that the
+ * state of a group may live at the same index in other flat arrays.
+ *
+ * Collisions are resolved with linear probing, and the table keeps its
+ * load factor under 1/2.
+ */
+class GroupTable final
+{
+public:
+    explicit GroupTable(std::size_t keyWordCount);
+
+    /*
+     * Returns the index of the group of the key `key` (of which the
+     * length is the key word count of this table), adding it first if
+     * needed, in which case this method sets `isNew` to true.
+     */
+    std::uint64_t insert(const std::uint64_t *key, bool& isNew);
+
+    /* Number of groups */
+    std::uint64_t size() const noexcept
+    {
+        return _mHashes.size();
+    }
+
+    /* Key of the group at the index `index` */
+    const std::uint64_t *key(const std::uint64_t index) const noexcept
+    {
+        return &_mKeys[index * _mKeyWordCount];
+    }
+
+    /* Removes all the groups, keeping the allocated memory */
+    void clear() noexcept;
+
+private:
+    std::uint64_t _hash(const std::uint64_t *key) const noexcept;
+    bool _keyEquals(std::uint64_t index, const std::uint64_t *key) const noexcept;
+
+    /* Doubles the number of slots and reinserts all the groups */
+    void _grow();
+
+    std::size_t _mKeyWordCount;
+
+    /*
+     * Group index plus one of each slot, or 0 for an empty slot.
+     *
+     * The number of slots is always a power of two.
+     */
+    std::vector<std::uint32_t> _mSlots;
+
+    /* Hash of the key of each group */
+    std::vector<std::uint64_t> _mHashes;
+
+    /* Keys of the groups, `_mKeyWordCount` words each */
+    std::vector<std::uint64_t> _mKeys;
+};
+
+} /* namespace bt2agg */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_AGGREGATE_GROUP_TABLE_HPP */
@@ -0,0 +1,839 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glib.h>
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "comp.hpp"
+#include "msg-iter.hpp"
+
+namespace bt2agg {
+
+MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
+                 const bt2::SelfMessageIteratorConfiguration, bt2::SelfComponentOutputPort) :
+    bt2::UserMessageIterator<MsgIter, Comp> {selfMsgIter, "MSG-ITER"},
+    _mUpstreamMsgIter {this->_createMessageIterator(this->_component()._inputPorts()["in"])},
+    _mGroups {this->_component().groupKeys().size() + 1}
+{
+    const auto& comp = this->_component();
+
+    _mKeyKinds.resize(comp.groupKeys().size());
+    _mAggKinds.resize(comp.aggs().size());
+    _mCurKey.resize(comp.groupKeys().size() + 1);
+
+    for (const auto& agg : comp.aggs()) {
+        _mHistoOffsets.push_back(_mHistoBucketCount);
+
+        if (agg.func == AggFunc::Histogram) {
+            _mHistoBucketCount += agg.bounds.size() + 1;
+        }
+    }
+}
+
+MsgIter::_FieldReader MsgIter::_fieldReader(const FieldPath& fieldPath,
+                                            const bt2::ConstEventClass eventCls)
+{
+    bt2::OptionalBorrowedObject<bt2::ConstStructureFieldClass> rootFc;
+
+    switch (fieldPath.scope) {
+    case Scope::Payload:
+        rootFc = eventCls.payloadFieldClass();
+        break;
+    case Scope::SpecificContext:
+        rootFc = eventCls.specificContextFieldClass();
+        break;
+    case Scope::CommonContext:
+        rootFc = eventCls.streamClass().commonEventContextFieldClass();
+        break;
+    }
+
+    _FieldReader reader;
+
+    if (!rootFc) {
+        return reader;
+    }
+
+    reader.scope = fieldPath.scope;
+
+    /* Resolve the member indexes */
+    bt2::ConstFieldClass fc = *rootFc;
+
+    for (const auto& memberName : fieldPath.memberNames) {
+        if (!fc.isStructure()) {
+            return _FieldReader {};
+        }
+
+        const auto structFc = fc.asStructure();
+        bt2s::optional<std::uint64_t> memberIndex;
+
+        for (std::uint64_t i = 0; i < structFc.length(); ++i) {
+            if (std::strcmp(structFc[i].name(), memberName.c_str()) == 0) {
+                memberIndex = i;
+                break;
+            }
+        }
+
+        if (!memberIndex) {
+            return _FieldReader {};
+        }
+
+        reader.memberIndexes.push_back(*memberIndex);
+        fc = structFc[*memberIndex].fieldClass();
+    }
+
+    if (fc.isBool()) {
+        reader.type = _FieldReader::Type::Bool;
+    } else if (fc.isUnsignedInteger()) {
+        reader.type = _FieldReader::Type::UInt;
+    } else if (fc.isSignedInteger()) {
+        reader.type = _FieldReader::Type::SInt;
+    } else if (fc.isSinglePrecisionReal()) {
+        reader.type = _FieldReader::Type::SinglePrecisionReal;
+    } else if (fc.isDoublePrecisionReal()) {
+        reader.type = _FieldReader::Type::DoublePrecisionReal;
+    } else if (fc.isString()) {
+        reader.type = _FieldReader::Type::Str;
+    } else {
+        return _FieldReader {};
+    }
+
+    return reader;
+}
+
+const MsgIter::_EventClsState& MsgIter::_eventClsState(const bt2::ConstEventClass eventCls)
+{
+    if (G_LIKELY(_mLastEventClsState &&
+                 _mLastEventClsState->eventCls->libObjPtr() == eventCls.libObjPtr())) {
+        return *_mLastEventClsState;
+    }
+
+    auto it = _mEventClsStates.find(eventCls.libObjPtr());
+
+    if (it == _mEventClsStates.end()) {
+        const auto& comp = this->_component();
+        const auto name = eventCls.name();
+        _EventClsState state;
+
+        state.eventCls = eventCls.shared();
+
+        /* Without a default clock class, there's no window */
+        state.isAggregated = comp.eventClsNameMatches(name ? name : bt2c::CStringView {""}) &&
+                             eventCls.streamClass().defaultClockClass();
+
+        if (state.isAggregated) {
+            /* Group-by keys */
+            for (std::size_t i = 0; i < comp.groupKeys().size(); ++i) {
+                auto reader = _fieldReader(comp.groupKeys()[i].fieldPath, eventCls);
+                bt2s::optional<_KeyKind> kind;
+
+                switch (reader.type) {
+                case _FieldReader::Type::Bool:
+                case _FieldReader::Type::UInt:
+                    kind = _KeyKind::UInt;
+                    break;
+                case _FieldReader::Type::SInt:
+                    kind = _KeyKind::SInt;
+                    break;
+                case _FieldReader::Type::Str:
+                    kind = _KeyKind::Str;
+                    break;
+                default:
+                    /* Not a valid key */
+                    break;
+                }
+
+                if (kind && !_mKeyKinds[i]) {
+                    _mKeyKinds[i] = kind;
+                }
+
+                if (!kind || ((*kind == _KeyKind::Str) != (*_mKeyKinds[i] == _KeyKind::Str))) {
+                    /* String key versus integral key: missing */
+                    reader = _FieldReader {};
+                }
+
+                state.keyReaders.emplace_back(std::move(reader));
+            }
+
+            /* Aggregated fields */
+            for (std::size_t i = 0; i < comp.aggs().size(); ++i) {
+                const auto& agg = comp.aggs()[i];
+
+                if (agg.func == AggFunc::Count) {
+                    state.aggReaders.emplace_back();
+                    continue;
+                }
+
+                auto reader = _fieldReader(agg.fieldPath, eventCls);
+                bt2s::optional<_NumKind> kind;
+
+                switch (reader.type) {
+                case _FieldReader::Type::Bool:
+                case _FieldReader::Type::UInt:
+                    kind = _NumKind::UInt;
+                    break;
+                case _FieldReader::Type::SInt:
+                    kind = _NumKind::SInt;
+                    break;
+                case _FieldReader::Type::SinglePrecisionReal:
+                case _FieldReader::Type::DoublePrecisionReal:
+                    kind = _NumKind::Real;
+                    break;
+                default:
+                    /* Not a number */
+                    reader = _FieldReader {};
+                    break;
+                }
+
+                if (kind && !_mAggKinds[i]) {
+                    _mAggKinds[i] = kind;
+                }
+
+                state.aggReaders.emplace_back(std::move(reader));
+            }
+        }
+
+        BT_CPPLOGD("Resolved the aggregation of an event class: "
+                   "event-class-addr={}, event-class-name={}, is-aggregated={}",
+                   fmt::ptr(eventCls.libObjPtr()), name ? name.data() : "",
+                   state.isAggregated);
+        it = _mEventClsStates.emplace(eventCls.libObjPtr(), std::move(state)).first;
+    }
+
+    /* Element addresses of an `std::unordered_map` never change */
+    _mLastEventClsState = &it->second;
+    return it->second;
+}
+
+bt2::ConstField MsgIter::_readField(const _FieldReader& reader,
+                                    const bt2::ConstEvent event) noexcept
+{
+    bt2::OptionalBorrowedObject<bt2::ConstStructureField> rootField;
+
+    switch (reader.scope) {
+    case Scope::Payload:
+        rootField = event.payloadField();
+        break;
+    case Scope::SpecificContext:
+        rootField = event.specificContextField();
+        break;
+    case Scope::CommonContext:
+        rootField = event.commonContextField();
+        break;
+    }
+
+    BT_ASSERT_DBG(rootField);
+
+    bt2::ConstField field = *rootField;
+
+    for (const auto index : reader.memberIndexes) {
+        field = field.asStructure()[index];
+    }
+
+    return field;
+}
+
+MsgIter::_Num MsgIter::_readNum(const _FieldReader& reader, const bt2::ConstEvent event,
+                                const _NumKind kind) noexcept
+{
+    const auto field = _readField(reader, event);
+    _Num num;
+
+    switch (reader.type) {
+    case _FieldReader::Type::Bool:
+    case _FieldReader::Type::UInt:
+    {
+        const auto val = reader.type == _FieldReader::Type::Bool ?
+                             static_cast<std::uint64_t>(field.asBool().value()) :
+                             field.asUnsignedInteger().value();
+
+        switch (kind) {
+        case _NumKind::UInt:
+            num.u = val;
+            break;
+        case _NumKind::SInt:
+            num.s = static_cast<std::int64_t>(val);
+            break;
+        case _NumKind::Real:
+            num.r = static_cast<double>(val);
+            break;
+        }
+
+        break;
+    }
+    case _FieldReader::Type::SInt:
+    {
+        const auto val = field.asSignedInteger().value();
+
+        switch (kind) {
+        case _NumKind::UInt:
+            num.u = static_cast<std::uint64_t>(val);
+            break;
+        case _NumKind::SInt:
+            num.s = val;
+            break;
+        case _NumKind::Real:
+            num.r = static_cast<double>(val);
+            break;
+        }
+
+        break;
+    }
+    case _FieldReader::Type::SinglePrecisionReal:
+    case _FieldReader::Type::DoublePrecisionReal:
+    {
+        const auto val = _readReal(reader, event);
+
+        /* Saturate: converting an out-of-range real is undefined */
+        switch (kind) {
+        case _NumKind::UInt:
+            num.u = !(val > 0) ? 0 :
+                    val >= 18446744073709551616.0 ? UINT64_MAX :
+                                                    static_cast<std::uint64_t>(val);
+            break;
+        case _NumKind::SInt:
+            num.s = std::isnan(val)                 ? 0 :
+                    val <= -9223372036854775808.0 ? INT64_MIN :
+                    val >= 9223372036854775808.0  ? INT64_MAX :
+                                                    static_cast<std::int64_t>(val);
+            break;
+        case _NumKind::Real:
+            num.r = val;
+            break;
+        }
+
+        break;
+    }
+    default:
+        bt_common_abort();
+    }
+
+    return num;
+}
+
+double MsgIter::_readReal(const _FieldReader& reader, const bt2::ConstEvent event) noexcept
+{
+    const auto field = _readField(reader, event);
+
+    switch (reader.type) {
+    case _FieldReader::Type::Bool:
+        return field.asBool().value() ? 1 : 0;
+    case _FieldReader::Type::UInt:
+        return static_cast<double>(field.asUnsignedInteger().value());
+    case _FieldReader::Type::SInt:
+        return static_cast<double>(field.asSignedInteger().value());
+    case _FieldReader::Type::SinglePrecisionReal:
+        return field.asSinglePrecisionReal().value();
+    case _FieldReader::Type::DoublePrecisionReal:
+        return field.asDoublePrecisionReal().value();
+    default:
+        bt_common_abort();
+    }
+}
+
+void MsgIter::_aggregate(const _EventClsState& eventClsState, const bt2::ConstEvent event)
+{
+    const auto& comp = this->_component();
+    const auto& aggs = comp.aggs();
+
+    /* Make the group key */
+    _mCurKey[0] = 0;
+
+    for (std::size_t i = 0; i < eventClsState.keyReaders.size(); ++i) {
+        const auto& reader = eventClsState.keyReaders[i];
+        auto& word = _mCurKey[i + 1];
+
+        if (reader.type == _FieldReader::Type::Missing) {
+            word = 0;
+            continue;
+        }
+
+        const auto field = _readField(reader, event);
+
+        switch (reader.type) {
+        case _FieldReader::Type::Bool:
+            word = field.asBool().value();
+            break;
+        case _FieldReader::Type::UInt:
+            word = field.asUnsignedInteger().value();
+            break;
+        case _FieldReader::Type::SInt:
+            word = static_cast<std::uint64_t>(field.asSignedInteger().value());
+            break;
+        case _FieldReader::Type::Str:
+        {
+            const auto str = field.asString().value();
+
+            /* Reuse the capacity of `_mStrBuf` to avoid an allocation */
+            _mStrBuf.assign(str.data(), str.len());
+
+            auto it = _mStrIds.find(_mStrBuf);
+
+            if (it == _mStrIds.end()) {
+                it = _mStrIds.emplace(_mStrBuf, _mStrs.size()).first;
+                _mStrs.push_back(&it->first);
+            }
+
+            word = it->second;
+            break;
+        }
+        default:
+            bt_common_abort();
+        }
+
+        _mCurKey[0] |= UINT64_C(1) << i;
+    }
+
+    /* Find or add the group */
+    bool isNew;
+    const auto groupIndex = _mGroups.insert(_mCurKey.data(), isNew);
+
+    if (isNew) {
+        _mAccs.resize(_mAccs.size() + aggs.size());
+        _mHistoCounts.resize(_mHistoCounts.size() + _mHistoBucketCount, 0);
+    }
+
+    /* Update the accumulators */
+    const auto accs = &_mAccs[groupIndex * aggs.size()];
+
+    for (std::size_t i = 0; i < aggs.size(); ++i) {
+        const auto& agg = aggs[i];
+        const auto& reader = eventClsState.aggReaders[i];
+        auto& acc = accs[i];
+
+        if (agg.func == AggFunc::Count) {
+            ++acc.count;
+            continue;
+        }
+
+        if (reader.type == _FieldReader::Type::Missing) {
+            continue;
+        }
+
+        if (agg.func == AggFunc::Histogram) {
+            const auto val = _readReal(reader, event);
+            const auto bucket =
+                std::upper_bound(agg.bounds.begin(), agg.bounds.end(), val) - agg.bounds.begin();
+
+            ++_mHistoCounts[groupIndex * _mHistoBucketCount + _mHistoOffsets[i] + bucket];
+            ++acc.count;
+            continue;
+        }
+
+        const auto kind = *_mAggKinds[i];
+        const auto num = _readNum(reader, event, kind);
+
+        if (acc.count == 0) {
+            acc.val = num;
+        } else {
+            switch (agg.func) {
+            case AggFunc::Sum:
+                switch (kind) {
+                case _NumKind::UInt:
+                    acc.val.u += num.u;
+                    break;
+                case _NumKind::SInt:
+                    /* Wrap instead of signed overflow */
+                    acc.val.s = static_cast<std::int64_t>(static_cast<std::uint64_t>(acc.val.s) +
+                                                          static_cast<std::uint64_t>(num.s));
+                    break;
+                case _NumKind::Real:
+                    acc.val.r += num.r;
+                    break;
+                }
+
+                break;
+            case AggFunc::Min:
+                switch (kind) {
+                case _NumKind::UInt:
+                    acc.val.u = std::min(acc.val.u, num.u);
+                    break;
+                case _NumKind::SInt:
+                    acc.val.s = std::min(acc.val.s, num.s);
+                    break;
+                case _NumKind::Real:
+                    acc.val.r = std::min(acc.val.r, num.r);
+                    break;
+                }
+
+                break;
+            case AggFunc::Max:
+                switch (kind) {
+                case _NumKind::UInt:
+                    acc.val.u = std::max(acc.val.u, num.u);
+                    break;
+                case _NumKind::SInt:
+                    acc.val.s = std::max(acc.val.s, num.s);
+                    break;
+                case _NumKind::Real:
+                    acc.val.r = std::max(acc.val.r, num.r);
+                    break;
+                }
+
+                break;
+            default:
+                bt_common_abort();
+            }
+        }
+
+        ++acc.count;
+    }
+}
+
+bt2::FieldClass::Shared MsgIter::_createOptionFc(const bt2::TraceClass traceCls,
+                                                 const bt2::FieldClass fc)
+{
+    if (this->_component()._graphMipVersion() == 0) {
+        return traceCls.createOptionFieldClass(fc);
+    }
+
+    return traceCls.createOptionWithoutSelectorFieldLocationFieldClass(fc);
+}
+
+void MsgIter::_ensureStream()
+{
+    if (_mStream) {
+        return;
+    }
+
+    auto& comp = this->_component();
+    const bt2::SelfComponent selfComp {comp._selfComp()};
+
+    _mTraceCls = selfComp.createTraceClass();
+
+    /* Clock class: ns from the origin of the upstream clock class */
+    const auto clkCls = selfComp.createClockClass();
+
+    clkCls->name("aggregate");
+
+    if (_mOriginIsUnixEpoch.value_or(false)) {
+        clkCls->setOriginIsUnixEpoch();
+    } else {
+        clkCls->setOriginIsUnknown();
+    }
+
+    const auto streamCls = _mTraceCls->createStreamClass();
+
+    streamCls->defaultClockClass(*clkCls);
+
+    /*
+     * Payload field class: one member per group-by key, then one
+     * member per aggregate.
+     *
+     * This fixes the kinds which no event class set so far.
+     */
+    const auto payloadFc = _mTraceCls->createStructureFieldClass();
+
+    for (std::size_t i = 0; i < comp.groupKeys().size(); ++i) {
+        if (!_mKeyKinds[i]) {
+            _mKeyKinds[i] = _KeyKind::SInt;
+        }
+
+        bt2::FieldClass::Shared fc;
+
+        switch (*_mKeyKinds[i]) {
+        case _KeyKind::UInt:
+            fc = _mTraceCls->createUnsignedIntegerFieldClass();
+            break;
+        case _KeyKind::SInt:
+            fc = _mTraceCls->createSignedIntegerFieldClass();
+            break;
+        case _KeyKind::Str:
+            fc = _mTraceCls->createStringFieldClass();
+            break;
+        }
+
+        payloadFc->appendMember(comp.groupKeys()[i].name,
+                                *this->_createOptionFc(*_mTraceCls, *fc));
+    }
+
+    for (std::size_t i = 0; i < comp.aggs().size(); ++i) {
+        const auto& agg = comp.aggs()[i];
+
+        switch (agg.func) {
+        case AggFunc::Count:
+            payloadFc->appendMember(agg.name, *_mTraceCls->createUnsignedIntegerFieldClass());
+            break;
+        case AggFunc::Sum:
+        case AggFunc::Min:
+        case AggFunc::Max:
+        {
+            if (!_mAggKinds[i]) {
+                _mAggKinds[i] = _NumKind::SInt;
+            }
+
+            bt2::FieldClass::Shared fc;
+
+            switch (*_mAggKinds[i]) {
+            case _NumKind::UInt:
+                fc = _mTraceCls->createUnsignedIntegerFieldClass();
+                break;
+            case _NumKind::SInt:
+                fc = _mTraceCls->createSignedIntegerFieldClass();
+                break;
+            case _NumKind::Real:
+                fc = _mTraceCls->createDoublePrecisionRealFieldClass();
+                break;
+            }
+
+            payloadFc->appendMember(agg.name, *this->_createOptionFc(*_mTraceCls, *fc));
+            break;
+        }
+        case AggFunc::Histogram:
+            payloadFc->appendMember(
+                agg.name, *_mTraceCls->createStaticArrayFieldClass(
+                              *_mTraceCls->createUnsignedIntegerFieldClass(),
+                              agg.bounds.size() + 1));
+            break;
+        }
+    }
+
+    _mEventCls = streamCls->createEventClass();
+    _mEventCls->name("aggregate");
+    _mEventCls->payloadFieldClass(*payloadFc);
+
+    /* Trace and stream */
+    const auto trace = _mTraceCls->instantiate();
+
+    _mStream = streamCls->instantiate(*trace);
+    _mOutMsgs.emplace_back(this->_createStreamBeginningMessage(*_mStream));
+    BT_CPPLOGI("Created the output stream: key-count={}, aggregate-count={}",
+               comp.groupKeys().size(), comp.aggs().size());
+}
+
+void MsgIter::_closeWindow()
+{
+    if (_mGroups.size() == 0) {
+        return;
+    }
+
+    this->_ensureStream();
+
+    const auto& comp = this->_component();
+    const auto& keys = comp.groupKeys();
+    const auto& aggs = comp.aggs();
+
+    for (std::uint64_t groupIndex = 0; groupIndex < _mGroups.size(); ++groupIndex) {
+        auto msg = this->_createEventMessage(*_mEventCls, *_mStream,
+                                             static_cast<std::uint64_t>(*_mWindowBegin));
+        const auto payloadField = *msg->event().payloadField();
+        const auto key = _mGroups.key(groupIndex);
+        std::uint64_t memberIndex = 0;
+
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const auto optField = payloadField[memberIndex].asOption();
+
+            ++memberIndex;
+
+            if (!(key[0] & (UINT64_C(1) << i))) {
+                optField.hasField(false);
+                continue;
+            }
+
+            optField.hasField(true);
+
+            const auto field = *optField.field();
+
+            switch (*_mKeyKinds[i]) {
+            case _KeyKind::UInt:
+                field.asUnsignedInteger().value(key[i + 1]);
+                break;
+            case _KeyKind::SInt:
+                field.asSignedInteger().value(static_cast<std::int64_t>(key[i + 1]));
+                break;
+            case _KeyKind::Str:
+                field.asString().value(_mStrs[key[i + 1]]->c_str());
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < aggs.size(); ++i) {
+            const auto& acc = _mAccs[groupIndex * aggs.size() + i];
+            const auto field = payloadField[memberIndex];
+
+            ++memberIndex;
+
+            switch (aggs[i].func) {
+            case AggFunc::Count:
+                field.asUnsignedInteger().value(acc.count);
+                break;
+            case AggFunc::Sum:
+            case AggFunc::Min:
+            case AggFunc::Max:
+            {
+                const auto optField = field.asOption();
+
+                optField.hasField(acc.count > 0);
+
+                if (acc.count == 0) {
+                    break;
+                }
+
+                const auto valField = *optField.field();
+
+                switch (*_mAggKinds[i]) {
+                case _NumKind::UInt:
+                    valField.asUnsignedInteger().value(acc.val.u);
+                    break;
+                case _NumKind::SInt:
+                    valField.asSignedInteger().value(acc.val.s);
+                    break;
+                case _NumKind::Real:
+                    valField.asDoublePrecisionReal().value(acc.val.r);
+                    break;
+                }
+
+                break;
+            }
+            case AggFunc::Histogram:
+            {
+                const auto arrayField = field.asArray();
+                const auto counts =
+                    &_mHistoCounts[groupIndex * _mHistoBucketCount + _mHistoOffsets[i]];
+
+                for (std::uint64_t bucket = 0; bucket < arrayField.length(); ++bucket) {
+                    arrayField[bucket].asUnsignedInteger().value(counts[bucket]);
+                }
+
+                break;
+            }
+            }
+        }
+
+        _mOutMsgs.emplace_back(std::move(msg));
+    }
+
+    BT_CPPLOGD("Closed a window: window-begin-ns={}, group-count={}", *_mWindowBegin,
+               _mGroups.size());
+
+    /* Forget the groups, keeping the allocated memory */
+    _mGroups.clear();
+    _mAccs.clear();
+    _mHistoCounts.clear();
+    _mStrIds.clear();
+    _mStrs.clear();
+}
+
+void MsgIter::_advanceTime(const std::int64_t ns)
+{
+    BT_ASSERT_DBG(ns >= 0);
+
+    const auto windowDurNs = this->_component().windowDurNs();
+    const auto windowBegin =
+        ns - static_cast<std::int64_t>(static_cast<std::uint64_t>(ns) % windowDurNs);
+
+    if (!_mWindowBegin) {
+        _mWindowBegin = windowBegin;
+        return;
+    }
+
+    if (ns >= *_mWindowBegin && static_cast<std::uint64_t>(ns - *_mWindowBegin) >= windowDurNs) {
+        this->_closeWindow();
+        _mWindowBegin = windowBegin;
+    }
+}
+
+void MsgIter::_handleMsg(const bt2::ConstMessage msg)
+{
+    if (msg.isEvent()) {
+        const auto eventMsg = msg.asEvent();
+        const auto& eventClsState = this->_eventClsState(eventMsg.event().cls());
+
+        if (!eventClsState.isAggregated) {
+            return;
+        }
+
+        std::int64_t ns;
+
+        try {
+            ns = eventMsg.defaultClockSnapshot().nsFromOrigin();
+        } catch (const bt2::OverflowError&) {
+            return;
+        }
+
+        if (ns < 0) {
+            /* Not representable with the output clock class */
+            return;
+        }
+
+        if (!_mOriginIsUnixEpoch) {
+            _mOriginIsUnixEpoch =
+                eventMsg.event().cls().streamClass().defaultClockClass()->origin().isUnixEpoch();
+        }
+
+        if (_mWindowBegin && ns < *_mWindowBegin) {
+            /* Aggregate into the current window anyway */
+            ++_mLateEventCount;
+        }
+
+        this->_advanceTime(ns);
+        this->_aggregate(eventClsState, eventMsg.event());
+    } else if (msg.isMessageIteratorInactivity() && _mWindowBegin) {
+        /* Close the current window without waiting for the next event */
+        try {
+            const auto ns =
+                msg.asMessageIteratorInactivity().clockSnapshot().nsFromOrigin();
+
+            if (ns >= 0) {
+                this->_advanceTime(ns);
+            }
+        } catch (const bt2::OverflowError&) {
+        }
+    }
+}
+
+void MsgIter::_next(bt2::ConstMessageArray& msgs)
+{
+    while (msgs.isEmpty()) {
+        if (!_mOutMsgs.empty()) {
+            while (!_mOutMsgs.empty() && !msgs.isFull()) {
+                msgs.append(std::move(_mOutMsgs.front()));
+                _mOutMsgs.pop_front();
+            }
+
+            continue;
+        }
+
+        if (_mUpstreamIsDone) {
+            /* Ended */
+            return;
+        }
+
+        /* This may throw `bt2::TryAgain` */
+        const auto upstreamMsgs = _mUpstreamMsgIter->next();
+
+        if (!upstreamMsgs) {
+            this->_closeWindow();
+
+            if (_mStream) {
+                _mOutMsgs.emplace_back(this->_createStreamEndMessage(*_mStream));
+            }
+
+            _mUpstreamIsDone = true;
+
+            if (_mLateEventCount > 0) {
+                BT_CPPLOGW("Aggregated events into a later window than the one of their time: "
+                           "the upstream messages aren't ordered by time: late-event-count={}",
+                           _mLateEventCount);
+            }
+
+            continue;
+        }
+
+        for (std::uint64_t i = 0; i < upstreamMsgs->length(); ++i) {
+            this->_handleMsg((*upstreamMsgs)[i]);
+        }
+    }
+}
+
+} /* namespace bt2agg */
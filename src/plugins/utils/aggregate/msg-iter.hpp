@@ -0,0 +1,239 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_AGGREGATE_MSG_ITER_HPP
+#define BABELTRACE_PLUGINS_UTILS_AGGREGATE_MSG_ITER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpp-common/bt2/component-class-dev.hpp"
+#include "cpp-common/bt2/self-message-iterator-configuration.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "field-path.hpp"
+#include "group-table.hpp"
+
+namespace bt2agg {
+
+class Comp;
+
+class MsgIter final : public bt2::UserMessageIterator<MsgIter, Comp>
+{
+    friend bt2::UserMessageIterator<MsgIter, Comp>;
+
+private:
+    /* Kind of a numeric value */
+    enum class _NumKind
+    {
+        UInt,
+        SInt,
+        Real,
+    };
+
+    /* Kind of a group-by key value */
+    enum class _KeyKind
+    {
+        UInt,
+        SInt,
+        Str,
+    };
+
+    /* Numeric value of which the kind is known from the context */
+    union _Num
+    {
+        std::uint64_t u;
+        std::int64_t s;
+        double r;
+    };
+
+    /*
+     * Field of an event class, resolved to member indexes, to read from
+     * the events of this class.
+     */
+    struct _FieldReader final
+    {
+        enum class Type
+        {
+            /* No such field, or not compatible: missing value */
+            Missing,
+
+            Bool,
+            UInt,
+            SInt,
+            SinglePrecisionReal,
+            DoublePrecisionReal,
+            Str,
+        };
+
+        Type type = Type::Missing;
+        Scope scope = Scope::Payload;
+        std::vector<std::uint64_t> memberIndexes;
+    };
+
+    /* Aggregation state of a given event class */
+    struct _EventClsState final
+    {
+        /* Keeps the event class, and therefore its address, alive */
+        bt2::ConstEventClass::Shared eventCls;
+
+        /* Whether or not to aggregate the events of this class */
+        bool isAggregated = false;
+
+        /* Readers of the group-by keys */
+        std::vector<_FieldReader> keyReaders;
+
+        /* Readers of the aggregated fields, indexed like `Comp::aggs()` */
+        std::vector<_FieldReader> aggReaders;
+    };
+
+    /* Accumulator of an aggregate for a given group */
+    struct _Acc final
+    {
+        /* Number of values */
+        std::uint64_t count = 0;
+
+        /* Sum, minimum, or maximum, of kind `_mAggKinds[i]` */
+        _Num val;
+    };
+
+public:
+    explicit MsgIter(bt2::SelfMessageIterator selfMsgIter,
+                     bt2::SelfMessageIteratorConfiguration config,
+                     bt2::SelfComponentOutputPort selfPort);
+
+private:
+    void _next(bt2::ConstMessageArray& msgs);
+
+    /* Handles the upstream message `msg` */
+    void _handleMsg(bt2::ConstMessage msg);
+
+    /* Returns the state of `eventCls`, creating it first if needed */
+    const _EventClsState& _eventClsState(bt2::ConstEventClass eventCls);
+
+    /*
+     * Returns a reader of the field `fieldPath` for the events of the
+     * class `eventCls`.
+     */
+    static _FieldReader _fieldReader(const FieldPath& fieldPath, bt2::ConstEventClass eventCls);
+
+    /* Returns the field which `reader` designates within `event` */
+    static bt2::ConstField _readField(const _FieldReader& reader, bt2::ConstEvent event) noexcept;
+
+    /*
+     * Reads the numeric field which `reader` designates within `event`
+     * as a value of kind `kind`.
+     */
+    static _Num _readNum(const _FieldReader& reader, bt2::ConstEvent event,
+                         _NumKind kind) noexcept;
+
+    /* Reads the numeric field which `reader` designates within `event` as a real */
+    static double _readReal(const _FieldReader& reader, bt2::ConstEvent event) noexcept;
+
+    /*
+     * Makes the time `ns` (ns from origin) current, closing the
+     * current window if `ns` is past its end.
+     */
+    void _advanceTime(std::int64_t ns);
+
+    /* Aggregates `event` of which the state of the class is `eventClsState` */
+    void _aggregate(const _EventClsState& eventClsState, bt2::ConstEvent event);
+
+    /*
+     * Appends one event message per group of the current window to
+     * the output message queue, and forgets all the groups.
+     */
+    void _closeWindow();
+
+    /*
+     * Creates the output trace class, trace, and stream, and appends
+     * a stream beginning message to the output message queue, if not
+     * already done.
+     */
+    void _ensureStream();
+
+    /* Creates an optional field class of which the optional field class is `fc` */
+    bt2::FieldClass::Shared _createOptionFc(bt2::TraceClass traceCls, bt2::FieldClass fc);
+
+    bt2::MessageIterator::Shared _mUpstreamMsgIter;
+
+    /* Whether or not the upstream message iterator ended */
+    bool _mUpstreamIsDone = false;
+
+    /* Messages to return */
+    std::deque<bt2::ConstMessage::Shared> _mOutMsgs;
+
+    /* Event class states, keyed by event class */
+    std::unordered_map<const bt_event_class *, _EventClsState> _mEventClsStates;
+
+    /* Last event class state which _eventClsState() returned */
+    const _EventClsState *_mLastEventClsState = nullptr;
+
+    /*
+     * Kinds of the group-by keys and of the values of the aggregates,
+     * set when resolving the first event class having a compatible
+     * field, and fixed once the output trace class exists.
+     */
+    std::vector<bt2s::optional<_KeyKind>> _mKeyKinds;
+    std::vector<bt2s::optional<_NumKind>> _mAggKinds;
+
+    /* Whether or not the origin of the output clock class is the Unix epoch */
+    bt2s::optional<bool> _mOriginIsUnixEpoch;
+
+    /* Beginning of the current window (ns from origin), if any */
+    bt2s::optional<std::int64_t> _mWindowBegin;
+
+    /*
+     * Groups of the current window.
+     *
+     * A key is a presence bitmask (bit N: whether or not the event has
+     * the key field N) followed with one word per group-by key:
+     * the integral value, or the index of a string within `_mStrs`.
+     */
+    GroupTable _mGroups;
+
+    /* Current group key */
+    std::vector<std::uint64_t> _mCurKey;
+
+    /*
+     * Accumulators of the groups of the current window, indexed by
+     * group index times the number of aggregates plus the aggregate
+     * index.
+     */
+    std::vector<_Acc> _mAccs;
+
+    /*
+     * Histogram bucket counts of the groups of the current window: each
+     * group has `_mHistoBucketCount` counts, and the first bucket of
+     * the aggregate `i` is at the offset `_mHistoOffsets[i]` within
+     * them.
+     */
+    std::vector<std::uint64_t> _mHistoCounts;
+    std::vector<std::uint64_t> _mHistoOffsets;
+    std::uint64_t _mHistoBucketCount = 0;
+
+    /* Interned string key values of the current window */
+    std::unordered_map<std::string, std::uint64_t> _mStrIds;
+    std::vector<const std::string *> _mStrs;
+
+    /* Lookup buffer for `_mStrIds` */
+    std::string _mStrBuf;
+
+    /* Number of aggregated events which were earlier than their window */
+    std::uint64_t _mLateEventCount = 0;
+
+    /* Output objects */
+    bt2::TraceClass::Shared _mTraceCls;
+    bt2::EventClass::Shared _mEventCls;
+    bt2::Stream::Shared _mStream;
+};
+
+} /* namespace bt2agg */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_AGGREGATE_MSG_ITER_HPP */
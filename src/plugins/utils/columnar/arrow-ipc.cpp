@@ -0,0 +1,420 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include "common/assert.h"
+#include "compat/endian.h" /* IWYU pragma: keep  */
+#include "cpp-common/bt2c/exc.hpp"
+
+#include "arrow-ipc.hpp"
+
+namespace bt2col {
+namespace {
+
+/*
+ * Values of the Arrow FlatBuffers schema (see `Schema.fbs`,
+ * `Message.fbs`, and `File.fbs` of the Arrow format).
+ */
+constexpr std::int16_t metadataVersionV5 = 4;
+constexpr std::uint8_t msgHeaderSchema = 1;
+constexpr std::uint8_t msgHeaderRecordBatch = 3;
+constexpr std::uint8_t typeInt = 2;
+constexpr std::uint8_t typeFloatingPoint = 3;
+constexpr std::uint8_t typeUtf8 = 5;
+constexpr std::uint8_t typeBool = 6;
+constexpr std::uint8_t typeTimestamp = 10;
+constexpr std::int16_t precisionSingle = 1;
+constexpr std::int16_t precisionDouble = 2;
+constexpr std::int16_t timeUnitNs = 3;
+constexpr std::int16_t endiannessLittle = 0;
+constexpr std::int16_t endiannessBig = 1;
+
+constexpr char fileMagic[] = "ARROW1";
+
+std::size_t padLen(const std::size_t len) noexcept
+{
+    return (8 - len % 8) % 8;
+}
+
+/* Appends the little-endian encoding of `val` to `bytes` */
+void appendLe64(std::vector<std::uint8_t>& bytes, const std::uint64_t val)
+{
+    for (std::size_t i = 0; i < 8; ++i) {
+        bytes.push_back(static_cast<std::uint8_t>(val >> (i * 8)));
+    }
+}
+
+FlatBufBuilder::Offset buildType(FlatBufBuilder& builder, const ColumnType type)
+{
+    switch (type) {
+    case ColumnType::UInt64:
+    case ColumnType::SInt64:
+        builder.startTable();
+        builder.addS32(0, 64);
+        builder.addBool(1, type == ColumnType::SInt64);
+        return builder.endTable();
+    case ColumnType::Float32:
+    case ColumnType::Float64:
+        builder.startTable();
+        builder.addS16(0, type == ColumnType::Float32 ? precisionSingle : precisionDouble);
+        return builder.endTable();
+    case ColumnType::TimestampNs:
+    {
+        const auto tz = builder.createString("UTC");
+
+        builder.startTable();
+        builder.addS16(0, timeUnitNs);
+        builder.addOffset(1, tz);
+        return builder.endTable();
+    }
+    case ColumnType::Bool:
+    case ColumnType::Utf8:
+        builder.startTable();
+        return builder.endTable();
+    }
+
+    bt_common_abort();
+}
+
+std::uint8_t typeType(const ColumnType type) noexcept
+{
+    switch (type) {
+    case ColumnType::Bool:
+        return typeBool;
+    case ColumnType::UInt64:
+    case ColumnType::SInt64:
+        return typeInt;
+    case ColumnType::Float32:
+    case ColumnType::Float64:
+        return typeFloatingPoint;
+    case ColumnType::Utf8:
+        return typeUtf8;
+    case ColumnType::TimestampNs:
+        return typeTimestamp;
+    }
+
+    bt_common_abort();
+}
+
+} /* namespace */
+
+ColumnBuf::ColumnBuf(const ColumnType type) : _mType {type}
+{
+    if (_mType == ColumnType::Utf8) {
+        _mOffsets.push_back(0);
+    }
+}
+
+void ColumnBuf::_appendBit(std::vector<std::uint8_t>& bits, const bool val)
+{
+    if (_mLen % 8 == 0) {
+        bits.push_back(0);
+    }
+
+    if (val) {
+        bits.back() |= static_cast<std::uint8_t>(1 << (_mLen % 8));
+    }
+}
+
+void ColumnBuf::appendNull()
+{
+    switch (_mType) {
+    case ColumnType::Bool:
+        this->_appendBit(_mValues, false);
+        break;
+    case ColumnType::Utf8:
+        _mOffsets.push_back(_mOffsets.back());
+        break;
+    case ColumnType::Float32:
+        _mValues.insert(_mValues.end(), 4, 0);
+        break;
+    default:
+        _mValues.insert(_mValues.end(), 8, 0);
+        break;
+    }
+
+    this->_appendValidity(false);
+}
+
+void ColumnBuf::appendStr(const char * const str, const std::size_t len)
+{
+    BT_ASSERT_DBG(_mType == ColumnType::Utf8);
+    _mValues.insert(_mValues.end(), str, str + len);
+    _mOffsets.push_back(static_cast<std::int32_t>(_mValues.size()));
+    this->_appendValidity(true);
+}
+
+void ColumnBuf::clear() noexcept
+{
+    _mLen = 0;
+    _mNullCount = 0;
+    _mValidity.clear();
+    _mValues.clear();
+
+    if (_mType == ColumnType::Utf8) {
+        _mOffsets.resize(1);
+    }
+}
+
+void ColumnBuf::clearAndShrink()
+{
+    this->clear();
+    _mValidity.shrink_to_fit();
+    _mValues.shrink_to_fit();
+    _mOffsets.shrink_to_fit();
+}
+
+ArrowIpcFileWriter::ArrowIpcFileWriter(std::string path, std::vector<ColumnDescr> columns,
+                                       Metadata metadata, const bt2c::Logger& parentLogger) :
+    _mPath {std::move(path)},
+    _mColumns {std::move(columns)}, _mMetadata {std::move(metadata)},
+    _mFile {std::fopen(_mPath.c_str(), "wb")}, _mLogger {parentLogger, "ARROW-IPC"}
+{
+    if (!_mFile) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to open file",
+                                                ": path=\"{}\"", _mPath);
+    }
+
+    /* Magic, padded to eight bytes */
+    this->_write(fileMagic, sizeof(fileMagic) - 1);
+    this->_pad();
+
+    /* Schema message (no body) */
+    FlatBufBuilder builder;
+    const auto schema = this->_buildSchema(builder);
+
+    builder.startTable();
+    builder.addS16(0, metadataVersionV5);
+    builder.addU8(1, msgHeaderSchema);
+    builder.addOffset(2, schema);
+    builder.addS64(3, 0);
+    this->_writeMsgMetadata(builder.finish(builder.endTable()));
+
+    BT_CPPLOGI("Created Arrow IPC file: path=\"{}\", column-count={}", _mPath, _mColumns.size());
+}
+
+FlatBufBuilder::Offset ArrowIpcFileWriter::_buildSchema(FlatBufBuilder& builder) const
+{
+    std::vector<FlatBufBuilder::Offset> fields;
+
+    for (const auto& column : _mColumns) {
+        const auto name = builder.createString(column.name);
+        const auto type = buildType(builder, column.type);
+
+        /* Arrow readers require the vector of children, even empty */
+        const auto children = builder.createOffsetVector({});
+
+        builder.startTable();
+        builder.addOffset(0, name);
+        builder.addBool(1, column.nullable);
+        builder.addU8(2, typeType(column.type));
+        builder.addOffset(3, type);
+        builder.addOffset(5, children);
+        fields.push_back(builder.endTable());
+    }
+
+    const auto fieldsVec = builder.createOffsetVector(fields);
+    std::vector<FlatBufBuilder::Offset> keyVals;
+
+    for (const auto& keyVal : _mMetadata) {
+        const auto key = builder.createString(keyVal.first);
+        const auto val = builder.createString(keyVal.second);
+
+        builder.startTable();
+        builder.addOffset(0, key);
+        builder.addOffset(1, val);
+        keyVals.push_back(builder.endTable());
+    }
+
+    const auto keyValsVec = builder.createOffsetVector(keyVals);
+
+    builder.startTable();
+    builder.addS16(0, BYTE_ORDER == LITTLE_ENDIAN ? endiannessLittle : endiannessBig);
+    builder.addOffset(1, fieldsVec);
+    builder.addOffset(2, keyValsVec);
+    return builder.endTable();
+}
+
+void ArrowIpcFileWriter::_write(const void * const data, const std::size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+
+    if (std::fwrite(data, 1, len, _mFile.get()) != len) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write file",
+                                                ": path=\"{}\"", _mPath);
+    }
+
+    _mOffset += len;
+}
+
+void ArrowIpcFileWriter::_pad()
+{
+    static const std::uint8_t zeros[8] = {};
+
+    this->_write(zeros, padLen(_mOffset));
+}
+
+ArrowIpcFileWriter::_Block
+ArrowIpcFileWriter::_writeMsgMetadata(const std::vector<std::uint8_t>& metadata)
+{
+    BT_ASSERT_DBG(metadata.size() % 8 == 0);
+    BT_ASSERT_DBG(_mOffset % 8 == 0);
+
+    _Block block;
+
+    block.offset = static_cast<std::int64_t>(_mOffset);
+    block.metadataLen = static_cast<std::int32_t>(8 + metadata.size());
+    block.bodyLen = 0;
+
+    /* Continuation marker, then the little-endian metadata length */
+    const std::uint8_t prefix[] = {
+        0xff, 0xff, 0xff, 0xff,
+        static_cast<std::uint8_t>(metadata.size()),
+        static_cast<std::uint8_t>(metadata.size() >> 8),
+        static_cast<std::uint8_t>(metadata.size() >> 16),
+        static_cast<std::uint8_t>(metadata.size() >> 24),
+    };
+
+    this->_write(prefix, sizeof(prefix));
+    this->_write(metadata.data(), metadata.size());
+    return block;
+}
+
+void ArrowIpcFileWriter::writeRecordBatch(const std::vector<ColumnBuf>& bufs,
+                                          const std::uint64_t len)
+{
+    BT_ASSERT(bufs.size() == _mColumns.size());
+
+    /*
+     * Body layout: for each column, the validity bitmap (empty without
+     * nulls), then the offsets (`ColumnType::Utf8`), then the values,
+     * each one padded to eight bytes.
+     */
+    struct BodyBuf final
+    {
+        const void *data;
+        std::size_t len;
+    };
+
+    std::vector<BodyBuf> bodyBufs;
+    std::vector<std::uint8_t> nodes;
+    std::vector<std::uint8_t> bufDescrs;
+    std::uint64_t bodyLen = 0;
+
+    const auto addBodyBuf = [&](const void * const data, const std::size_t bufLen) {
+        bodyBufs.push_back({data, bufLen});
+        appendLe64(bufDescrs, bodyLen);
+        appendLe64(bufDescrs, bufLen);
+        bodyLen += bufLen + padLen(bufLen);
+    };
+
+    for (const auto& buf : bufs) {
+        BT_ASSERT(buf.length() == len);
+        appendLe64(nodes, buf.length());
+        appendLe64(nodes, buf._mNullCount);
+
+        if (buf._mNullCount == 0) {
+            addBodyBuf(nullptr, 0);
+        } else {
+            addBodyBuf(buf._mValidity.data(), buf._mValidity.size());
+        }
+
+        if (buf._mType == ColumnType::Utf8) {
+            addBodyBuf(buf._mOffsets.data(), buf._mOffsets.size() * sizeof(std::int32_t));
+        }
+
+        addBodyBuf(buf._mValues.data(), buf._mValues.size());
+    }
+
+    /* Record batch message */
+    FlatBufBuilder builder;
+    const auto nodesVec = builder.createStructVector(nodes.data(), bufs.size(), 16, 8);
+    const auto bufDescrsVec =
+        builder.createStructVector(bufDescrs.data(), bodyBufs.size(), 16, 8);
+
+    builder.startTable();
+    builder.addS64(0, static_cast<std::int64_t>(len));
+    builder.addOffset(1, nodesVec);
+    builder.addOffset(2, bufDescrsVec);
+
+    const auto recordBatch = builder.endTable();
+
+    builder.startTable();
+    builder.addS16(0, metadataVersionV5);
+    builder.addU8(1, msgHeaderRecordBatch);
+    builder.addOffset(2, recordBatch);
+    builder.addS64(3, static_cast<std::int64_t>(bodyLen));
+
+    auto block = this->_writeMsgMetadata(builder.finish(builder.endTable()));
+
+    /* Body */
+    for (const auto& bodyBuf : bodyBufs) {
+        this->_write(bodyBuf.data, bodyBuf.len);
+        this->_pad();
+    }
+
+    block.bodyLen = static_cast<std::int64_t>(bodyLen);
+    _mRecordBatchBlocks.push_back(block);
+    BT_CPPLOGD("Wrote record batch: path=\"{}\", row-count={}, body-len={}", _mPath, len,
+               bodyLen);
+}
+
+void ArrowIpcFileWriter::close()
+{
+    if (!_mFile) {
+        return;
+    }
+
+    /* End-of-stream marker */
+    const std::uint8_t eos[] = {0xff, 0xff, 0xff, 0xff, 0, 0, 0, 0};
+
+    this->_write(eos, sizeof(eos));
+
+    /* Footer */
+    std::vector<std::uint8_t> blocks;
+
+    for (const auto& block : _mRecordBatchBlocks) {
+        appendLe64(blocks, static_cast<std::uint64_t>(block.offset));
+        appendLe64(blocks, static_cast<std::uint32_t>(block.metadataLen));
+        appendLe64(blocks, static_cast<std::uint64_t>(block.bodyLen));
+    }
+
+    FlatBufBuilder builder;
+    const auto schema = this->_buildSchema(builder);
+    const auto dicts = builder.createStructVector(nullptr, 0, 24, 8);
+    const auto recordBatches =
+        builder.createStructVector(blocks.data(), _mRecordBatchBlocks.size(), 24, 8);
+
+    builder.startTable();
+    builder.addS16(0, metadataVersionV5);
+    builder.addOffset(1, schema);
+    builder.addOffset(2, dicts);
+    builder.addOffset(3, recordBatches);
+
+    const auto footer = builder.finish(builder.endTable());
+    const std::uint8_t footerLen[] = {
+        static_cast<std::uint8_t>(footer.size()),
+        static_cast<std::uint8_t>(footer.size() >> 8),
+        static_cast<std::uint8_t>(footer.size() >> 16),
+        static_cast<std::uint8_t>(footer.size() >> 24),
+    };
+
+    this->_write(footer.data(), footer.size());
+    this->_write(footerLen, sizeof(footerLen));
+    this->_write(fileMagic, sizeof(fileMagic) - 1);
+
+    if (std::fflush(_mFile.get()) != 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to write file",
+                                                ": path=\"{}\"", _mPath);
+    }
+
+    _mFile.reset();
+    BT_CPPLOGI("Closed Arrow IPC file: path=\"{}\", record-batch-count={}", _mPath,
+               _mRecordBatchBlocks.size());
+}
+
+} /* namespace bt2col */
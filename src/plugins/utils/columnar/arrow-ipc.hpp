@@ -0,0 +1,222 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_COLUMNAR_ARROW_IPC_HPP
+#define BABELTRACE_PLUGINS_UTILS_COLUMNAR_ARROW_IPC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cpp-common/bt2c/libc-up.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+#include "flatbuf-builder.hpp"
+
+namespace bt2col {
+
+/*
+ * Arrow data type of a column.
+ */
+enum class ColumnType
+{
+    Bool,
+    UInt64,
+    SInt64,
+    Float32,
+    Float64,
+    Utf8,
+
+    /* Nanoseconds since the Unix epoch, UTC */
+    TimestampNs,
+};
+
+/*
+ * Description of a column of an Arrow schema.
+ */
+struct ColumnDescr final
+{
+    std::string name;
+    ColumnType type;
+    bool nullable;
+};
+
+/*
+ * Values of a column for the current record batch.
+ */
+class ColumnBuf final
+{
+    friend class ArrowIpcFileWriter;
+
+public:
+    explicit ColumnBuf(ColumnType type);
+
+    void appendNull();
+
+    void appendBool(const bool val)
+    {
+        this->_appendBit(_mValues, val);
+        this->_appendValidity(true);
+    }
+
+    void appendUInt(const std::uint64_t val)
+    {
+        this->_appendRaw(&val, sizeof(val));
+    }
+
+    void appendSInt(const std::int64_t val)
+    {
+        this->_appendRaw(&val, sizeof(val));
+    }
+
+    void appendFloat32(const float val)
+    {
+        this->_appendRaw(&val, sizeof(val));
+    }
+
+    void appendFloat64(const double val)
+    {
+        this->_appendRaw(&val, sizeof(val));
+    }
+
+    void appendStr(const char *str, std::size_t len);
+
+    std::uint64_t length() const noexcept
+    {
+        return _mLen;
+    }
+
+    /* Size of the values, excluding the validity bitmap and offsets */
+    std::size_t dataSize() const noexcept
+    {
+        return _mValues.size();
+    }
+
+    /* Size of the memory which this buffer holds */
+    std::size_t memSize() const noexcept
+    {
+        return _mValidity.capacity() + _mValues.capacity() +
+               _mOffsets.capacity() * sizeof(std::int32_t);
+    }
+
+    void clear() noexcept;
+
+    /* Like clear(), also releasing the memory */
+    void clearAndShrink();
+
+private:
+    void _appendBit(std::vector<std::uint8_t>& bits, bool val);
+
+    void _appendValidity(bool isValid)
+    {
+        this->_appendBit(_mValidity, isValid);
+        ++_mLen;
+
+        if (!isValid) {
+            ++_mNullCount;
+        }
+    }
+
+    void _appendRaw(const void * const val, const std::size_t size)
+    {
+        const auto curSize = _mValues.size();
+
+        _mValues.resize(curSize + size);
+        std::memcpy(&_mValues[curSize], val, size);
+        this->_appendValidity(true);
+    }
+
+    ColumnType _mType;
+    std::uint64_t _mLen = 0;
+    std::uint64_t _mNullCount = 0;
+
+    /* Bit-packed validity bitmap, least significant bit first */
+    std::vector<std::uint8_t> _mValidity;
+
+    /*
+     * Values: native scalars, bits (`ColumnType::Bool`), or UTF-8
+     * characters (`ColumnType::Utf8`).
+     */
+    std::vector<std::uint8_t> _mValues;
+
+    /* Offsets of the strings within `_mValues` (`ColumnType::Utf8`) */
+    std::vector<std::int32_t> _mOffsets;
+};
+
+/*
+ * Writer of an Arrow IPC file (also known as Feather V2), that is, a
+ * schema message, record batch messages, and a footer locating the
+ * record batches for random access.
+ *
+ * All the columns are top-level fields: no nesting, no dictionary,
+ * no compression.
+ *
+ * Record batch bodies use the native byte order, which the schema
+ * announces.
+ */
+class ArrowIpcFileWriter final
+{
+public:
+    using Metadata = std::vector<std::pair<std::string, std::string>>;
+
+    /*
+     * Creates the file `path` and writes the schema made of `columns`
+     * with the custom metadata `metadata`.
+     */
+    explicit ArrowIpcFileWriter(std::string path, std::vector<ColumnDescr> columns,
+                                Metadata metadata, const bt2c::Logger& parentLogger);
+
+    /*
+     * Writes a record batch of `len` rows made of `bufs`, one buffer
+     * per column of the schema, each one of length `len`.
+     */
+    void writeRecordBatch(const std::vector<ColumnBuf>& bufs, std::uint64_t len);
+
+    /* Writes the footer and closes the file */
+    void close();
+
+    const std::string& path() const noexcept
+    {
+        return _mPath;
+    }
+
+private:
+    /* Arrow `Block` struct, as written to the footer */
+    struct _Block final
+    {
+        std::int64_t offset;
+        std::int32_t metadataLen;
+        std::int64_t bodyLen;
+    };
+
+    FlatBufBuilder::Offset _buildSchema(FlatBufBuilder& builder) const;
+
+    /*
+     * Writes an encapsulated message having the metadata `metadata`,
+     * returning its block.
+     */
+    _Block _writeMsgMetadata(const std::vector<std::uint8_t>& metadata);
+
+    void _write(const void *data, std::size_t len);
+
+    /* Writes zeros until the file offset is a multiple of eight */
+    void _pad();
+
+    std::string _mPath;
+    std::vector<ColumnDescr> _mColumns;
+    Metadata _mMetadata;
+    bt2c::FileUP _mFile;
+    std::uint64_t _mOffset = 0;
+    std::vector<_Block> _mRecordBatchBlocks;
+    bt2c::Logger _mLogger;
+};
+
+} /* namespace bt2col */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_COLUMNAR_ARROW_IPC_HPP */
@@ -0,0 +1,212 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <cctype>
+
+#include <glib.h>
+
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "comp.hpp"
+
+namespace bt2col {
+namespace {
+
+/* Number of events between two memory usage updates */
+constexpr std::uint64_t memUpdatePeriod = 4096;
+
+} /* namespace */
+
+Comp::Comp(const bt2::SelfSinkComponent selfComp, const bt2::ConstMapValue params, void *) :
+    bt2::UserSinkComponent<Comp> {selfComp, "PLUGIN/SINK.UTILS.COLUMNAR"}
+{
+    BT_CPPLOGI("Initializing component.");
+
+    auto knownParamCount = 1ULL;
+    const auto pathVal = params["path"];
+
+    if (!pathVal || !pathVal->isString()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Missing or invalid `path` parameter: "
+                                          "expecting a string.");
+    }
+
+    _mDirPath = pathVal->asString().value().data();
+
+    if (const auto batchSizeVal = params["batch-size"]) {
+        if (batchSizeVal->isUnsignedInteger()) {
+            _mBatchLen = batchSizeVal->asUnsignedInteger().value();
+        } else if (batchSizeVal->isSignedInteger() &&
+                   batchSizeVal->asSignedInteger().value() > 0) {
+            _mBatchLen = static_cast<std::uint64_t>(batchSizeVal->asSignedInteger().value());
+        } else {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`batch-size` parameter: expecting a positive integer.");
+        }
+
+        if (_mBatchLen == 0) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`batch-size` parameter: expecting a positive integer.");
+        }
+
+        ++knownParamCount;
+    }
+
+    if (params.length() != knownParamCount) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error,
+            "This component expects no parameters other than 'path' and 'batch-size': param-count={}",
+            params.length());
+    }
+
+    if (g_mkdir_with_parents(_mDirPath.c_str(), 0755) != 0) {
+        BT_CPPLOGE_ERRNO_APPEND_CAUSE_AND_THROW(bt2c::Error, "Failed to create output directory",
+                                                ": path=\"{}\"", _mDirPath);
+    }
+
+    try {
+        this->_addInputPort("in");
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to add the input port.");
+    }
+
+    BT_CPPLOGI("Initialized component: path=\"{}\", batch-size={}", _mDirPath, _mBatchLen);
+}
+
+Comp::~Comp()
+{
+    /*
+     * Graph ending early (error or interruption): still make the files
+     * readable, with the rows so far.
+     */
+    try {
+        this->_closeTables();
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGW("Failed to close the tables.");
+    }
+
+    this->_addMemoryUsage(-static_cast<std::int64_t>(_mMemUsage));
+}
+
+void Comp::_getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue, bt2::LoggingLevel,
+                                    const bt2::UnsignedIntegerRangeSet ranges)
+{
+    ranges.addRange(0, 1);
+}
+
+void Comp::_graphIsConfigured()
+{
+    _mMsgIter = this->_createMessageIterator(this->_inputPorts()["in"]);
+}
+
+Table& Comp::_table(const bt2::ConstEventClass eventCls)
+{
+    const auto it = _mTables.find(eventCls.libObjPtr());
+
+    if (G_LIKELY(it != _mTables.end())) {
+        return *it->second;
+    }
+
+    /*
+     * File name: index of the table, to avoid any clash, then the event
+     * class name, keeping only safe characters.
+     */
+    std::string name = eventCls.name() ? eventCls.name().data() : "";
+
+    for (auto& ch : name) {
+        if (!std::isalnum(static_cast<unsigned char>(ch)) && ch != '-' && ch != '_' &&
+            ch != '.') {
+            ch = '_';
+        }
+    }
+
+    const auto path = fmt::format("{}" G_DIR_SEPARATOR_S "{}-{}.arrow", _mDirPath,
+                                  _mTables.size(), name.empty() ? "event" : name);
+
+    try {
+        Table::UP table {new Table {eventCls, path, _mBatchLen, _mLogger}};
+
+        return *_mTables.emplace(eventCls.libObjPtr(), std::move(table)).first->second;
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to create table: path=\"{}\"", path);
+    }
+}
+
+void Comp::_closeTables()
+{
+    if (_mTablesClosed) {
+        return;
+    }
+
+    _mTablesClosed = true;
+
+    for (auto& entry : _mTables) {
+        entry.second->close();
+        BT_CPPLOGI("Closed table: row-count={}", entry.second->rowCount());
+    }
+}
+
+void Comp::_updateMemUsage()
+{
+    const auto computeMemUsage = [this] {
+        std::size_t memUsage = 0;
+
+        for (const auto& entry : _mTables) {
+            memUsage += entry.second->memSize();
+        }
+
+        return memUsage;
+    };
+
+    auto memUsage = computeMemUsage();
+
+    this->_addMemoryUsage(static_cast<std::int64_t>(memUsage) -
+                          static_cast<std::int64_t>(_mMemUsage));
+    _mMemUsage = memUsage;
+    _mEventCountSinceMemUpdate = 0;
+
+    if (this->_graphMemoryBudgetIsExceeded()) {
+        BT_CPPLOGD("Graph exceeds its memory budget: writing pending rows: mem-usage={}",
+                   memUsage);
+
+        for (auto& entry : _mTables) {
+            entry.second->flushAndShrink();
+        }
+
+        memUsage = computeMemUsage();
+        this->_addMemoryUsage(static_cast<std::int64_t>(memUsage) -
+                              static_cast<std::int64_t>(_mMemUsage));
+        _mMemUsage = memUsage;
+    }
+}
+
+bool Comp::_consume()
+{
+    /* This may throw `bt2::TryAgain` */
+    const auto msgs = _mMsgIter->next();
+
+    if (!msgs) {
+        this->_closeTables();
+        return false;
+    }
+
+    for (const auto msg : *msgs) {
+        if (msg.isEvent()) {
+            const auto eventMsg = msg.asEvent();
+
+            this->_table(eventMsg.event().cls()).append(eventMsg);
+            ++_mEventCountSinceMemUpdate;
+        }
+    }
+
+    if (_mEventCountSinceMemUpdate >= memUpdatePeriod) {
+        this->_updateMemUsage();
+    }
+
+    return true;
+}
+
+} /* namespace bt2col */
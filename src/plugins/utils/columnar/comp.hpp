@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_COLUMNAR_COMP_HPP
+#define BABELTRACE_PLUGINS_UTILS_COLUMNAR_COMP_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "cpp-common/bt2/component-class-dev.hpp"
+#include "cpp-common/bt2/message-iterator.hpp"
+
+#include "table.hpp"
+
+namespace bt2col {
+
+/*
+ * Sink component which writes the events of each event class, as the
+ * rows of a columnar table (see `Table`), to its own Arrow IPC file
+ * within the output directory.
+ */
+class Comp final : public bt2::UserSinkComponent<Comp>
+{
+    friend bt2::UserSinkComponent<Comp>;
+
+public:
+    explicit Comp(bt2::SelfSinkComponent selfComp, bt2::ConstMapValue params, void *);
+    ~Comp();
+
+protected:
+    static void _getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue,
+                                         bt2::LoggingLevel, bt2::UnsignedIntegerRangeSet ranges);
+
+    void _graphIsConfigured();
+    bool _consume();
+
+private:
+    /* Returns the table of `eventCls`, creating it first if needed */
+    Table& _table(bt2::ConstEventClass eventCls);
+
+    /* Closes all the tables, making their files complete */
+    void _closeTables();
+
+    /*
+     * Reports the memory which the tables hold, first writing their
+     * pending rows and releasing their memory if the graph exceeds its
+     * memory budget.
+     */
+    void _updateMemUsage();
+
+    /* Path of the output directory */
+    std::string _mDirPath;
+
+    /* Number of rows of a record batch */
+    std::uint64_t _mBatchLen = 65536;
+
+    bt2::MessageIterator::Shared _mMsgIter;
+
+    /* Tables, keyed by event class */
+    std::unordered_map<const bt_event_class *, Table::UP> _mTables;
+
+    bool _mTablesClosed = false;
+
+    /* Memory usage which this component reported */
+    std::size_t _mMemUsage = 0;
+
+    /* Number of events since the last _updateMemUsage() call */
+    std::uint64_t _mEventCountSinceMemUpdate = 0;
+};
+
+} /* namespace bt2col */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_COLUMNAR_COMP_HPP */
@@ -0,0 +1,176 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+
+#include "common/assert.h"
+
+#include "flatbuf-builder.hpp"
+
+namespace bt2col {
+
+void FlatBufBuilder::_preAlign(const std::size_t len, const std::size_t align)
+{
+    const auto rem = (_mBuf.size() + len) % align;
+
+    if (rem != 0) {
+        _mBuf.insert(_mBuf.end(), align - rem, 0);
+    }
+
+    _mMinAlign = std::max(_mMinAlign, align);
+}
+
+void FlatBufBuilder::_prepend(const std::uint64_t val, const std::size_t size)
+{
+    /* Most significant byte first: it ends up last in the final buffer */
+    for (auto i = size; i > 0; --i) {
+        _mBuf.push_back(static_cast<std::uint8_t>(val >> ((i - 1) * 8)));
+    }
+}
+
+void FlatBufBuilder::_patch32(const Offset offset, const std::uint32_t val) noexcept
+{
+    BT_ASSERT_DBG(offset >= 4 && offset <= _mBuf.size());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        _mBuf[offset - i - 1] = static_cast<std::uint8_t>(val >> (i * 8));
+    }
+}
+
+FlatBufBuilder::Offset FlatBufBuilder::createString(const std::string& str)
+{
+    this->_preAlign(str.size() + 1, 4);
+
+    /* Null terminator, then the characters, in reverse order */
+    _mBuf.push_back(0);
+    _mBuf.insert(_mBuf.end(), str.rbegin(), str.rend());
+    this->_prepend(str.size(), 4);
+    return this->_size();
+}
+
+FlatBufBuilder::Offset FlatBufBuilder::createStructVector(const std::uint8_t * const data,
+                                                          const std::size_t count,
+                                                          const std::size_t size,
+                                                          const std::size_t align)
+{
+    const auto len = count * size;
+
+    this->_preAlign(len, 4);
+    this->_preAlign(len, align);
+
+    for (auto i = len; i > 0; --i) {
+        _mBuf.push_back(data[i - 1]);
+    }
+
+    this->_prepend(count, 4);
+    return this->_size();
+}
+
+FlatBufBuilder::Offset FlatBufBuilder::createOffsetVector(const std::vector<Offset>& offsets)
+{
+    this->_preAlign(offsets.size() * 4, 4);
+
+    for (auto it = offsets.rbegin(); it != offsets.rend(); ++it) {
+        /* Relative to the element itself, once prepended */
+        this->_prepend(this->_size() + 4 - *it, 4);
+    }
+
+    this->_prepend(offsets.size(), 4);
+    return this->_size();
+}
+
+void FlatBufBuilder::startTable()
+{
+    BT_ASSERT(_mTableFields.empty());
+    _mTableBegin = this->_size();
+}
+
+void FlatBufBuilder::_addScalar(const unsigned int slot, const std::uint64_t val,
+                                const std::size_t size)
+{
+    this->_preAlign(size, size);
+    this->_prepend(val, size);
+    _mTableFields.emplace_back(slot, this->_size());
+}
+
+void FlatBufBuilder::addBool(const unsigned int slot, const bool val)
+{
+    this->_addScalar(slot, val ? 1 : 0, 1);
+}
+
+void FlatBufBuilder::addU8(const unsigned int slot, const std::uint8_t val)
+{
+    this->_addScalar(slot, val, 1);
+}
+
+void FlatBufBuilder::addS16(const unsigned int slot, const std::int16_t val)
+{
+    this->_addScalar(slot, static_cast<std::uint16_t>(val), 2);
+}
+
+void FlatBufBuilder::addS32(const unsigned int slot, const std::int32_t val)
+{
+    this->_addScalar(slot, static_cast<std::uint32_t>(val), 4);
+}
+
+void FlatBufBuilder::addS64(const unsigned int slot, const std::int64_t val)
+{
+    this->_addScalar(slot, static_cast<std::uint64_t>(val), 8);
+}
+
+void FlatBufBuilder::addOffset(const unsigned int slot, const Offset offset)
+{
+    this->_preAlign(4, 4);
+    this->_addScalar(slot, this->_size() + 4 - offset, 4);
+}
+
+FlatBufBuilder::Offset FlatBufBuilder::endTable()
+{
+    /* Placeholder of the offset to the vtable */
+    this->_preAlign(4, 4);
+    this->_prepend(0, 4);
+
+    const auto tableOffset = this->_size();
+    unsigned int slotCount = 0;
+
+    for (const auto& field : _mTableFields) {
+        slotCount = std::max(slotCount, field.first + 1);
+    }
+
+    /* Position of each field relative to the table, 0 when absent */
+    std::vector<std::uint16_t> fieldPositions(slotCount, 0);
+
+    for (const auto& field : _mTableFields) {
+        fieldPositions[field.first] = static_cast<std::uint16_t>(tableOffset - field.second);
+    }
+
+    /* vtable: its size, the size of the table, then the field positions */
+    for (auto it = fieldPositions.rbegin(); it != fieldPositions.rend(); ++it) {
+        this->_prepend(*it, 2);
+    }
+
+    this->_prepend(tableOffset - _mTableBegin, 2);
+    this->_prepend(4 + slotCount * 2, 2);
+
+    /* The vtable precedes the table: positive offset */
+    this->_patch32(tableOffset, this->_size() - tableOffset);
+    _mTableFields.clear();
+    return tableOffset;
+}
+
+std::vector<std::uint8_t> FlatBufBuilder::finish(const Offset root)
+{
+    this->_preAlign(4, std::max<std::size_t>(_mMinAlign, 8));
+    this->_prepend(this->_size() + 4 - root, 4);
+
+    std::vector<std::uint8_t> bytes {_mBuf.rbegin(), _mBuf.rend()};
+
+    _mBuf.clear();
+    _mMinAlign = 1;
+    return bytes;
+}
+
+} /* namespace bt2col */
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_COLUMNAR_FLATBUF_BUILDER_HPP
+#define BABELTRACE_PLUGINS_UTILS_COLUMNAR_FLATBUF_BUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bt2col {
+
+/*
+ * Minimal FlatBuffers builder, just enough to encode the Arrow IPC
+ * metadata (tables, scalars, strings, unions, and vectors of tables or
+ * of structs).
+ *
+ * Like the reference implementation, this builder writes the buffer
+ * from its end to its beginning: build the children of a table before
+ * the table itself.
+ *
+ * An `Offset` is the position of an object, as the distance from the
+ * end of the buffer.
+ *
+ * All the values are encoded as little-endian, as FlatBuffers requires.
+ */
+class FlatBufBuilder final
+{
+public:
+    using Offset = std::uint32_t;
+
+    Offset createString(const std::string& str);
+
+    /*
+     * Creates a vector of `count` structs, each one of `size` bytes,
+     * from the little-endian struct data `data`, aligning the elements
+     * on `align` bytes.
+     */
+    Offset createStructVector(const std::uint8_t *data, std::size_t count, std::size_t size,
+                              std::size_t align);
+
+    Offset createOffsetVector(const std::vector<Offset>& offsets);
+
+    void startTable();
+
+    /*
+     * Adds the field `slot` to the current table.
+     *
+     * Unlike the reference implementation, this builder always writes
+     * scalars, even when they're equal to their default value.
+     */
+    void addBool(unsigned int slot, bool val);
+    void addU8(unsigned int slot, std::uint8_t val);
+    void addS16(unsigned int slot, std::int16_t val);
+    void addS32(unsigned int slot, std::int32_t val);
+    void addS64(unsigned int slot, std::int64_t val);
+    void addOffset(unsigned int slot, Offset offset);
+
+    Offset endTable();
+
+    /*
+     * Finishes the buffer with `root` as its root table, and returns its
+     * bytes, the size of which is a multiple of eight.
+     *
+     * Resets this builder.
+     */
+    std::vector<std::uint8_t> finish(Offset root);
+
+private:
+    Offset _size() const noexcept
+    {
+        return static_cast<Offset>(_mBuf.size());
+    }
+
+    /* Pads so that the buffer is aligned on `align` after prepending `len` bytes */
+    void _preAlign(std::size_t len, std::size_t align);
+
+    /* Prepends the `size` least significant bytes of `val`, as little-endian */
+    void _prepend(std::uint64_t val, std::size_t size);
+
+    /* Prepends the scalar `val` of `size` bytes for the field `slot` */
+    void _addScalar(unsigned int slot, std::uint64_t val, std::size_t size);
+
+    /* Overwrites the 32-bit value at the position `offset` */
+    void _patch32(Offset offset, std::uint32_t val) noexcept;
+
+    /*
+     * Bytes, in reverse order: the last byte is the first one of the
+     * final buffer.
+     */
+    std::vector<std::uint8_t> _mBuf;
+
+    /* Alignment of the most aligned object so far */
+    std::size_t _mMinAlign = 1;
+
+    /* Size of the buffer when the current table started */
+    Offset _mTableBegin = 0;
+
+    /* Slot and position of each field of the current table */
+    std::vector<std::pair<unsigned int, Offset>> _mTableFields;
+};
+
+} /* namespace bt2col */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_COLUMNAR_FLATBUF_BUILDER_HPP */
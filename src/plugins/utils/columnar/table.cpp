@@ -0,0 +1,262 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include "common/assert.h"
+#include "cpp-common/bt2/clock-class.hpp"
+#include "cpp-common/bt2/exc.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "table.hpp"
+
+namespace bt2col {
+namespace {
+
+/*
+ * Maximum size of the characters of a string column within a single
+ * record batch, as Arrow string offsets are 32-bit.
+ */
+constexpr std::size_t maxStrDataSize = 1024 * 1024 * 1024;
+
+} /* namespace */
+
+Table::Table(const bt2::ConstEventClass eventCls, std::string path, const std::uint64_t batchLen,
+             const bt2c::Logger& parentLogger) :
+    _mEventCls {eventCls.shared()},
+    _mBatchLen {batchLen}, _mLogger {parentLogger, "TABLE"}
+{
+    std::vector<ColumnDescr> descrs;
+    const auto streamCls = eventCls.streamClass();
+
+    if (const auto clkCls = streamCls.defaultClockClass()) {
+        _mHasTimestamp = true;
+        descrs.push_back({"timestamp",
+                          clkCls->origin().isUnixEpoch() ? ColumnType::TimestampNs :
+                                                           ColumnType::SInt64,
+                          true});
+    }
+
+    std::vector<_Step> steps;
+
+    if (const auto fc = streamCls.packetContextFieldClass()) {
+        this->_addColumns(*fc, "packet_context", _Scope::PacketContext, steps, descrs);
+    }
+
+    if (const auto fc = streamCls.commonEventContextFieldClass()) {
+        this->_addColumns(*fc, "common_context", _Scope::CommonContext, steps, descrs);
+    }
+
+    if (const auto fc = eventCls.specificContextFieldClass()) {
+        this->_addColumns(*fc, "specific_context", _Scope::SpecificContext, steps, descrs);
+    }
+
+    if (const auto fc = eventCls.payloadFieldClass()) {
+        this->_addColumns(*fc, "payload", _Scope::Payload, steps, descrs);
+    }
+
+    for (const auto& descr : descrs) {
+        _mBufs.emplace_back(descr.type);
+    }
+
+    ArrowIpcFileWriter::Metadata metadata {
+        {"babeltrace.event-class-name", eventCls.name() ? eventCls.name().data() : ""},
+        {"babeltrace.event-class-id", fmt::to_string(eventCls.id())},
+        {"babeltrace.stream-class-id", fmt::to_string(streamCls.id())},
+    };
+
+    _mWriter.reset(
+        new ArrowIpcFileWriter {std::move(path), std::move(descrs), std::move(metadata), _mLogger});
+}
+
+void Table::_addColumns(const bt2::ConstFieldClass fc, const std::string& name, const _Scope scope,
+                        std::vector<_Step>& steps, std::vector<ColumnDescr>& descrs)
+{
+    ColumnType type;
+
+    if (fc.isStructure()) {
+        const auto structFc = fc.asStructure();
+
+        for (std::uint64_t i = 0; i < structFc.length(); ++i) {
+            const auto member = structFc[i];
+
+            steps.push_back({false, i});
+            this->_addColumns(member.fieldClass(), fmt::format("{}.{}", name, member.name()),
+                              scope, steps, descrs);
+            steps.pop_back();
+        }
+
+        return;
+    } else if (fc.isOption()) {
+        steps.push_back({true, 0});
+        this->_addColumns(fc.asOption().fieldClass(), name, scope, steps, descrs);
+        steps.pop_back();
+        return;
+    } else if (fc.isBool()) {
+        type = ColumnType::Bool;
+    } else if (fc.isBitArray() || fc.isUnsignedInteger()) {
+        type = ColumnType::UInt64;
+    } else if (fc.isSignedInteger()) {
+        type = ColumnType::SInt64;
+    } else if (fc.isSinglePrecisionReal()) {
+        type = ColumnType::Float32;
+    } else if (fc.isDoublePrecisionReal()) {
+        type = ColumnType::Float64;
+    } else if (fc.isString()) {
+        type = ColumnType::Utf8;
+    } else {
+        BT_CPPLOGD("Skipping field without column type: event-class-name=\"{}\", field=\"{}\"",
+                   _mEventCls->name() ? _mEventCls->name().data() : "", name);
+        return;
+    }
+
+    /*
+     * Any column is nullable: the content of an option field or the
+     * packet context field (event without a packet) may be missing.
+     */
+    _mColumns.push_back({scope, steps, type});
+    descrs.push_back({name, type, true});
+}
+
+void Table::_appendField(ColumnBuf& buf, const ColumnType type,
+                         const bt2::OptionalBorrowedObject<bt2::ConstField> field)
+{
+    if (!field) {
+        buf.appendNull();
+        return;
+    }
+
+    switch (type) {
+    case ColumnType::Bool:
+        buf.appendBool(field->asBool().value());
+        break;
+    case ColumnType::UInt64:
+        if (field->isBitArray()) {
+            buf.appendUInt(field->asBitArray().valueAsInteger());
+        } else {
+            buf.appendUInt(field->asUnsignedInteger().value());
+        }
+
+        break;
+    case ColumnType::SInt64:
+        buf.appendSInt(field->asSignedInteger().value());
+        break;
+    case ColumnType::Float32:
+        buf.appendFloat32(field->asSinglePrecisionReal().value());
+        break;
+    case ColumnType::Float64:
+        buf.appendFloat64(field->asDoublePrecisionReal().value());
+        break;
+    case ColumnType::Utf8:
+    {
+        const auto strField = field->asString();
+
+        buf.appendStr(strField.value(), strField.length());
+        break;
+    }
+    case ColumnType::TimestampNs:
+        bt_common_abort();
+    }
+}
+
+void Table::append(const bt2::ConstEventMessage msg)
+{
+    const auto event = msg.event();
+    auto bufIt = _mBufs.begin();
+
+    if (_mHasTimestamp) {
+        try {
+            bufIt->appendSInt(msg.defaultClockSnapshot().nsFromOrigin());
+        } catch (const bt2::OverflowError&) {
+            bufIt->appendNull();
+        }
+
+        ++bufIt;
+    }
+
+    /* Scope fields, by `_Scope` */
+    const auto packet = event.packet();
+    const bt2::OptionalBorrowedObject<bt2::ConstField> scopeFields[] = {
+        packet ? packet->contextField() : bt2::OptionalBorrowedObject<bt2::ConstStructureField> {},
+        event.commonContextField(),
+        event.specificContextField(),
+        event.payloadField(),
+    };
+
+    bool mustFlush = false;
+
+    for (const auto& column : _mColumns) {
+        auto field = scopeFields[static_cast<int>(column.scope)];
+
+        for (const auto& step : column.steps) {
+            if (!field) {
+                break;
+            }
+
+            if (step.isOption) {
+                field = field->asOption().field();
+            } else {
+                field = field->asStructure()[step.memberIndex];
+            }
+        }
+
+        _appendField(*bufIt, column.type, field);
+
+        if (column.type == ColumnType::Utf8 && bufIt->dataSize() >= maxStrDataSize) {
+            mustFlush = true;
+        }
+
+        ++bufIt;
+    }
+
+    BT_ASSERT_DBG(bufIt == _mBufs.end());
+    ++_mRowCount;
+    ++_mPendingRowCount;
+
+    if (mustFlush || _mPendingRowCount >= _mBatchLen) {
+        this->_flush();
+    }
+}
+
+void Table::_flush()
+{
+    if (_mPendingRowCount == 0) {
+        return;
+    }
+
+    _mWriter->writeRecordBatch(_mBufs, _mPendingRowCount);
+    _mPendingRowCount = 0;
+
+    for (auto& buf : _mBufs) {
+        buf.clear();
+    }
+}
+
+void Table::flushAndShrink()
+{
+    this->_flush();
+
+    for (auto& buf : _mBufs) {
+        buf.clearAndShrink();
+    }
+}
+
+std::size_t Table::memSize() const noexcept
+{
+    std::size_t size = 0;
+
+    for (const auto& buf : _mBufs) {
+        size += buf.memSize();
+    }
+
+    return size;
+}
+
+void Table::close()
+{
+    this->_flush();
+    _mWriter->close();
+}
+
+} /* namespace bt2col */
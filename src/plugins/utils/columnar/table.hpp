@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_COLUMNAR_TABLE_HPP
+#define BABELTRACE_PLUGINS_UTILS_COLUMNAR_TABLE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpp-common/bt2/message.hpp"
+#include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+#include "arrow-ipc.hpp"
+
+namespace bt2col {
+
+/*
+ * Columnar table of the events of a given event class, written to an
+ * Arrow IPC file.
+ *
+ * The columns are, in order:
+ *
+ * `timestamp`:
+ *     Value of the default clock snapshot of the event message, in
+ *     nanoseconds from the clock origin (timestamp type if the origin
+ *     is the Unix epoch), if the stream class has a default clock
+ *     class.
+ *
+ * `packet_context.PATH`, `common_context.PATH`,
+ * `specific_context.PATH`, and `payload.PATH`:
+ *     One column for each boolean, bit array, integer, enumeration,
+ *     real, and string field of the scope, structure fields being
+ *     flattened, `PATH` being the dot-separated member names.
+ *
+ *     The content of an option field is a nullable column, null when
+ *     the option field is empty.
+ *
+ * There's no column for array, variant, and BLOB fields.
+ *
+ * The table resolves the locations of the fields once, for its event
+ * class, so that appending an event only involves indexed member
+ * borrowing.
+ */
+class Table final
+{
+public:
+    using UP = std::unique_ptr<Table>;
+
+    /*
+     * Creates the Arrow IPC file `path`, writing a record batch every
+     * `batchLen` events.
+     */
+    explicit Table(bt2::ConstEventClass eventCls, std::string path, std::uint64_t batchLen,
+                   const bt2c::Logger& parentLogger);
+
+    void append(bt2::ConstEventMessage msg);
+
+    /* Writes the pending rows and the footer, and closes the file */
+    void close();
+
+    /*
+     * Writes the pending rows as a record batch, and releases the
+     * memory of the column buffers.
+     */
+    void flushAndShrink();
+
+    /* Size of the memory which the column buffers hold */
+    std::size_t memSize() const noexcept;
+
+    std::uint64_t rowCount() const noexcept
+    {
+        return _mRowCount;
+    }
+
+private:
+    enum class _Scope
+    {
+        PacketContext,
+        CommonContext,
+        SpecificContext,
+        Payload,
+    };
+
+    /* Step from a field to one of its members, or to its optional content */
+    struct _Step final
+    {
+        bool isOption;
+        std::uint64_t memberIndex;
+    };
+
+    struct _Column final
+    {
+        _Scope scope;
+        std::vector<_Step> steps;
+        ColumnType type;
+    };
+
+    /*
+     * Appends the columns of the field class `fc`, named `name`, of the
+     * scope `scope`, at the location `steps` within the scope field.
+     */
+    void _addColumns(bt2::ConstFieldClass fc, const std::string& name, _Scope scope,
+                     std::vector<_Step>& steps, std::vector<ColumnDescr>& descrs);
+
+    /* Appends the value of `field` (null if missing) to `buf` */
+    static void _appendField(ColumnBuf& buf, ColumnType type,
+                             bt2::OptionalBorrowedObject<bt2::ConstField> field);
+
+    /* Writes the pending rows as a record batch */
+    void _flush();
+
+    bt2::ConstEventClass::Shared _mEventCls;
+    std::uint64_t _mBatchLen;
+    bt2c::Logger _mLogger;
+    bool _mHasTimestamp = false;
+    std::vector<_Column> _mColumns;
+
+    /* Column buffers: the timestamp one first, if any, then one per `_mColumns` entry */
+    std::vector<ColumnBuf> _mBufs;
+
+    std::unique_ptr<ArrowIpcFileWriter> _mWriter;
+    std::uint64_t _mRowCount = 0;
+
+    /* Number of rows which aren't written yet */
+    std::uint64_t _mPendingRowCount = 0;
+};
+
+} /* namespace bt2col */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_COLUMNAR_TABLE_HPP */
@@ -81,6 +81,143 @@ void print_count(struct counter *counter)
 	counter->last_printed_total = total;
 }
 
+static
+void print_event_class_counts(struct counter *counter)
+{
+	guint i;
+
+	printf("\nEvents per event class:\n");
+
+	for (i = 0; i < counter->stream_class_stats->len; i++) {
+		const struct counter_stream_class_stats *sc_stats =
+			g_ptr_array_index(counter->stream_class_stats, i);
+		const uint64_t sc_id = bt_stream_class_get_id(
+			sc_stats->stream_class);
+		GHashTableIter iter;
+		gpointer key, value;
+		guint id;
+
+		for (id = 0; id < sc_stats->event_counts->len; id++) {
+			const uint64_t count = g_array_index(
+				sc_stats->event_counts, uint64_t, id);
+			const bt_event_class *ec;
+			const char *name;
+
+			if (count == 0) {
+				continue;
+			}
+
+			ec = bt_stream_class_borrow_event_class_by_id_const(
+				sc_stats->stream_class, id);
+			BT_ASSERT(ec);
+			name = bt_event_class_get_name(ec);
+			printf("%15" PRIu64 " event%s: stream class %" PRIu64
+				", event class %u (%s%s%s)\n",
+				count, count == 1 ? "" : "s", sc_id, id,
+				name ? "`" : "", name ? name : "unnamed",
+				name ? "`" : "");
+		}
+
+		if (!sc_stats->sparse_event_counts) {
+			continue;
+		}
+
+		g_hash_table_iter_init(&iter, sc_stats->sparse_event_counts);
+
+		while (g_hash_table_iter_next(&iter, &key, &value)) {
+			const uint64_t ec_id = *(uint64_t *) key;
+			const uint64_t count = *(uint64_t *) value;
+			const bt_event_class *ec =
+				bt_stream_class_borrow_event_class_by_id_const(
+					sc_stats->stream_class, ec_id);
+			const char *name;
+
+			BT_ASSERT(ec);
+			name = bt_event_class_get_name(ec);
+			printf("%15" PRIu64 " event%s: stream class %" PRIu64
+				", event class %" PRIu64 " (%s%s%s)\n",
+				count, count == 1 ? "" : "s", sc_id, ec_id,
+				name ? "`" : "", name ? name : "unnamed",
+				name ? "`" : "");
+		}
+	}
+}
+
+static
+void print_stream_counts(struct counter *counter)
+{
+	guint i;
+
+	printf("\nEvents per stream:\n");
+
+	for (i = 0; i < counter->stream_stats->len; i++) {
+		const struct counter_stream_stats *stream_stats =
+			g_ptr_array_index(counter->stream_stats, i);
+		const char *name = bt_stream_get_name(stream_stats->stream);
+		const char *trace_name = bt_trace_get_name(
+			bt_stream_borrow_trace_const(stream_stats->stream));
+
+		if (stream_stats->event_count == 0 && counter->hide_zero) {
+			continue;
+		}
+
+		printf("%15" PRIu64 " event%s: stream %" PRIu64
+			" (%s%s%s) of trace %s%s%s\n",
+			stream_stats->event_count,
+			stream_stats->event_count == 1 ? "" : "s",
+			bt_stream_get_id(stream_stats->stream),
+			name ? "`" : "", name ? name : "unnamed",
+			name ? "`" : "",
+			trace_name ? "`" : "", trace_name ? trace_name : "(unnamed)",
+			trace_name ? "`" : "");
+	}
+}
+
+static
+void print_inter_arrival_histogram(struct counter *counter)
+{
+	unsigned int i;
+
+	printf("\nTime since the previous event of the same stream:\n");
+
+	for (i = 0; i < COUNTER_INTER_ARRIVAL_BUCKET_COUNT; i++) {
+		const uint64_t count = counter->inter_arrival_buckets[i];
+
+		if (count == 0) {
+			continue;
+		}
+
+		if (i == 0) {
+			printf("%15" PRIu64 " event%s: 0 ns\n", count,
+				count == 1 ? "" : "s");
+		} else if (i == COUNTER_INTER_ARRIVAL_BUCKET_COUNT - 1) {
+			printf("%15" PRIu64 " event%s: [%" PRIu64 ", ...) ns\n",
+				count, count == 1 ? "" : "s",
+				UINT64_C(1) << (i - 1));
+		} else {
+			printf("%15" PRIu64 " event%s: [%" PRIu64 ", %" PRIu64 ") ns\n",
+				count, count == 1 ? "" : "s",
+				UINT64_C(1) << (i - 1), UINT64_C(1) << i);
+		}
+	}
+}
+
+static
+void print_details(struct counter *counter)
+{
+	if (counter->per_event_class) {
+		print_event_class_counts(counter);
+	}
+
+	if (counter->per_stream) {
+		print_stream_counts(counter);
+	}
+
+	if (counter->inter_arrival_histogram) {
+		print_inter_arrival_histogram(counter);
+	}
+}
+
 static
 void try_print_count(struct counter *counter, uint64_t msg_count)
 {
@@ -106,6 +243,39 @@ void try_print_last(struct counter *counter)
 	if (total != counter->last_printed_total) {
 		print_count(counter);
 	}
+
+	if (counter->has_details && !counter->printed_details) {
+		/* Detailed statistics only appear once, at the end */
+		print_details(counter);
+		counter->printed_details = true;
+	}
+}
+
+static
+void destroy_stream_class_stats(gpointer data)
+{
+	struct counter_stream_class_stats *sc_stats = data;
+
+	bt_stream_class_put_ref(sc_stats->stream_class);
+
+	if (sc_stats->event_counts) {
+		g_array_free(sc_stats->event_counts, TRUE);
+	}
+
+	if (sc_stats->sparse_event_counts) {
+		g_hash_table_destroy(sc_stats->sparse_event_counts);
+	}
+
+	g_free(sc_stats);
+}
+
+static
+void destroy_stream_stats(gpointer data)
+{
+	struct counter_stream_stats *stream_stats = data;
+
+	bt_stream_put_ref(stream_stats->stream);
+	g_free(stream_stats);
 }
 
 static
@@ -114,6 +284,19 @@ void destroy_private_counter_data(struct counter *counter)
 	if (counter) {
 		bt_message_iterator_put_ref(
 			counter->msg_iter);
+
+		if (counter->stream_stats_map) {
+			g_hash_table_destroy(counter->stream_stats_map);
+		}
+
+		if (counter->stream_stats) {
+			g_ptr_array_free(counter->stream_stats, TRUE);
+		}
+
+		if (counter->stream_class_stats) {
+			g_ptr_array_free(counter->stream_class_stats, TRUE);
+		}
+
 		g_free(counter);
 	}
 }
@@ -127,14 +310,223 @@ void counter_finalize(bt_self_component_sink *comp)
 			bt_self_component_sink_as_self_component(comp));
 	BT_ASSERT(counter);
 	try_print_last(counter);
-	bt_message_iterator_put_ref(counter->msg_iter);
-	g_free(counter);
+	destroy_private_counter_data(counter);
+}
+
+/*
+ * Returns the statistics of the stream class `sc`, creating them if
+ * needed, or `NULL` on memory error.
+ */
+static
+struct counter_stream_class_stats *borrow_stream_class_stats(
+		struct counter *counter, const bt_stream_class *sc)
+{
+	struct counter_stream_class_stats *sc_stats = NULL;
+	guint i;
+
+	/* Only called once per new stream: linear search is fine */
+	for (i = 0; i < counter->stream_class_stats->len; i++) {
+		sc_stats = g_ptr_array_index(counter->stream_class_stats, i);
+
+		if (sc_stats->stream_class == sc) {
+			goto end;
+		}
+	}
+
+	sc_stats = g_new0(struct counter_stream_class_stats, 1);
+	if (!sc_stats) {
+		goto end;
+	}
+
+	sc_stats->stream_class = sc;
+	bt_stream_class_get_ref(sc);
+	sc_stats->event_counts = g_array_new(FALSE, TRUE, sizeof(uint64_t));
+	if (!sc_stats->event_counts) {
+		destroy_stream_class_stats(sc_stats);
+		sc_stats = NULL;
+		goto end;
+	}
+
+	g_ptr_array_add(counter->stream_class_stats, sc_stats);
+
+end:
+	return sc_stats;
+}
+
+/*
+ * Returns the statistics of the stream `stream`, creating them if
+ * needed, or `NULL` on memory error.
+ */
+static inline
+struct counter_stream_stats *borrow_stream_stats(struct counter *counter,
+		const bt_stream *stream)
+{
+	struct counter_stream_stats *stream_stats;
+
+	/* Consecutive events typically belong to the same stream */
+	if (G_LIKELY(stream == counter->last_stream)) {
+		return counter->last_stream_stats;
+	}
+
+	stream_stats = g_hash_table_lookup(counter->stream_stats_map, stream);
+	if (!stream_stats) {
+		const bt_stream_class *sc = bt_stream_borrow_class_const(stream);
+
+		stream_stats = g_new0(struct counter_stream_stats, 1);
+		if (!stream_stats) {
+			goto end;
+		}
+
+		stream_stats->stream_class_stats =
+			borrow_stream_class_stats(counter, sc);
+		if (!stream_stats->stream_class_stats) {
+			g_free(stream_stats);
+			stream_stats = NULL;
+			goto end;
+		}
+
+		/*
+		 * Keep a strong reference so that no other stream may get
+		 * allocated at the same address.
+		 */
+		stream_stats->stream = stream;
+		bt_stream_get_ref(stream);
+		stream_stats->has_default_clock_class =
+			bt_stream_class_borrow_default_clock_class_const(sc);
+		g_ptr_array_add(counter->stream_stats, stream_stats);
+		g_hash_table_insert(counter->stream_stats_map, (gpointer) stream,
+			stream_stats);
+	}
+
+	counter->last_stream = stream;
+	counter->last_stream_stats = stream_stats;
+
+end:
+	return stream_stats;
+}
+
+static inline
+unsigned int inter_arrival_bucket(uint64_t delta_ns)
+{
+	unsigned int bucket = 0;
+
+	/* Number of significant bits of `delta_ns` */
+	while (delta_ns != 0) {
+		bucket++;
+		delta_ns >>= 1;
+	}
+
+	return bucket;
+}
+
+/*
+ * Updates the detailed statistics of `counter` with the event message
+ * `msg`.
+ *
+ * Returns a negative value on memory error.
+ */
+static
+int count_event_details(struct counter *counter, const bt_message *msg)
+{
+	const bt_event *event = bt_message_event_borrow_event_const(msg);
+	struct counter_stream_stats *stream_stats;
+	int ret = 0;
+
+	stream_stats = borrow_stream_stats(counter,
+		bt_event_borrow_stream_const(event));
+	if (G_UNLIKELY(!stream_stats)) {
+		ret = -1;
+		goto end;
+	}
+
+	stream_stats->event_count++;
+
+	if (counter->per_event_class) {
+		struct counter_stream_class_stats *sc_stats =
+			stream_stats->stream_class_stats;
+		const uint64_t ec_id = bt_event_class_get_id(
+			bt_event_borrow_class_const(event));
+
+		if (G_LIKELY(ec_id < COUNTER_MAX_DENSE_EVENT_CLASS_ID)) {
+			if (G_UNLIKELY(ec_id >= sc_stats->event_counts->len)) {
+				/* New elements are zeroed */
+				g_array_set_size(sc_stats->event_counts,
+					ec_id + 1);
+			}
+
+			g_array_index(sc_stats->event_counts, uint64_t, ec_id)++;
+		} else {
+			uint64_t *count;
+
+			if (!sc_stats->sparse_event_counts) {
+				sc_stats->sparse_event_counts =
+					g_hash_table_new_full(g_int64_hash,
+						g_int64_equal, g_free, g_free);
+				if (!sc_stats->sparse_event_counts) {
+					ret = -1;
+					goto end;
+				}
+			}
+
+			count = g_hash_table_lookup(
+				sc_stats->sparse_event_counts, &ec_id);
+			if (!count) {
+				uint64_t *key = g_new(uint64_t, 1);
+
+				count = g_new0(uint64_t, 1);
+				if (!key || !count) {
+					g_free(key);
+					g_free(count);
+					ret = -1;
+					goto end;
+				}
+
+				*key = ec_id;
+				g_hash_table_insert(
+					sc_stats->sparse_event_counts, key,
+					count);
+			}
+
+			(*count)++;
+		}
+	}
+
+	if (counter->inter_arrival_histogram &&
+			stream_stats->has_default_clock_class) {
+		int64_t ns;
+
+		if (bt_clock_snapshot_get_ns_from_origin(
+				bt_message_event_borrow_default_clock_snapshot_const(msg),
+				&ns)) {
+			/* Not representable: ignore this event */
+			goto end;
+		}
+
+		if (stream_stats->has_last_event_ns) {
+			const uint64_t delta_ns =
+				ns > stream_stats->last_event_ns ?
+					(uint64_t) ns - (uint64_t) stream_stats->last_event_ns :
+					0;
+
+			counter->inter_arrival_buckets[
+				inter_arrival_bucket(delta_ns)]++;
+		}
+
+		stream_stats->last_event_ns = ns;
+		stream_stats->has_last_event_ns = true;
+	}
+
+end:
+	return ret;
 }
 
 static
 struct bt_param_validation_map_value_entry_descr counter_params[] = {
 	{ "step", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_UNSIGNED_INTEGER } },
 	{ "hide-zero", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "per-event-class", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "per-stream", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
+	{ "inter-arrival-histogram", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
@@ -149,6 +541,7 @@ bt_component_class_initialize_method_status counter_init(
 	struct counter *counter = g_new0(struct counter, 1);
 	const bt_value *step = NULL;
 	const bt_value *hide_zero = NULL;
+	const bt_value *value;
 	enum bt_param_validation_status validation_status;
 	gchar *validate_error = NULL;
 
@@ -192,6 +585,40 @@ bt_component_class_initialize_method_status counter_init(
 		counter->hide_zero = (bool) bt_value_bool_get(hide_zero);
 	}
 
+	value = bt_value_map_borrow_entry_value_const(params, "per-event-class");
+	if (value) {
+		counter->per_event_class = (bool) bt_value_bool_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params, "per-stream");
+	if (value) {
+		counter->per_stream = (bool) bt_value_bool_get(value);
+	}
+
+	value = bt_value_map_borrow_entry_value_const(params,
+		"inter-arrival-histogram");
+	if (value) {
+		counter->inter_arrival_histogram =
+			(bool) bt_value_bool_get(value);
+	}
+
+	counter->has_details = counter->per_event_class ||
+		counter->per_stream || counter->inter_arrival_histogram;
+
+	if (counter->has_details) {
+		counter->stream_class_stats = g_ptr_array_new_with_free_func(
+			destroy_stream_class_stats);
+		counter->stream_stats = g_ptr_array_new_with_free_func(
+			destroy_stream_stats);
+		counter->stream_stats_map = g_hash_table_new(g_direct_hash,
+			g_direct_equal);
+		if (!counter->stream_class_stats || !counter->stream_stats ||
+				!counter->stream_stats_map) {
+			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+			goto error;
+		}
+	}
+
 	bt_self_component_set_data(
 		bt_self_component_sink_as_self_component(component),
 		counter);
@@ -267,6 +694,20 @@ bt_component_class_sink_consume_method_status counter_consume(
 			switch (bt_message_get_type(msg)) {
 			case BT_MESSAGE_TYPE_EVENT:
 				counter->count.event++;
+
+				if (G_UNLIKELY(counter->has_details) &&
+						count_event_details(counter, msg)) {
+					BT_CURRENT_THREAD_ERROR_APPEND_CAUSE_FROM_COMPONENT(
+						self_comp,
+						"Failed to update detailed statistics.");
+
+					for (; i < msg_count; i++) {
+						bt_message_put_ref(msgs[i]);
+					}
+
+					return BT_COMPONENT_CLASS_SINK_CONSUME_METHOD_STATUS_MEMORY_ERROR;
+				}
+
 				break;
 			case BT_MESSAGE_TYPE_PACKET_BEGINNING:
 				counter->count.packet_begin++;
@@ -17,6 +17,52 @@
 extern "C" {
 #endif
 
+/*
+ * Event class IDs below this value index a flat array of counts;
+ * the other ones go to a hash table.
+ */
+#define COUNTER_MAX_DENSE_EVENT_CLASS_ID	4096
+
+/* Number of buckets of the inter-arrival time histogram */
+#define COUNTER_INTER_ARRIVAL_BUCKET_COUNT	65
+
+/* Statistics of a given stream class */
+struct counter_stream_class_stats {
+	/* Owned by this */
+	const bt_stream_class *stream_class;
+
+	/*
+	 * Array of `uint64_t`: event counts indexed by event class ID,
+	 * for IDs less than `COUNTER_MAX_DENSE_EVENT_CLASS_ID`.
+	 */
+	GArray *event_counts;
+
+	/*
+	 * Owned `uint64_t *` (event class ID) to owned `uint64_t *`
+	 * (event count), for the other event class IDs, or `NULL` if
+	 * not needed yet.
+	 */
+	GHashTable *sparse_event_counts;
+};
+
+/* Statistics of a given stream */
+struct counter_stream_stats {
+	/* Owned by this */
+	const bt_stream *stream;
+
+	/* Weak: statistics of the class of `stream` */
+	struct counter_stream_class_stats *stream_class_stats;
+
+	uint64_t event_count;
+
+	/* True if the class of `stream` has a default clock class */
+	bool has_default_clock_class;
+
+	/* Time of the last event of `stream`, valid if `has_last_event_ns` */
+	bool has_last_event_ns;
+	int64_t last_event_ns;
+};
+
 struct counter {
 	bt_message_iterator *msg_iter;
 	struct {
@@ -34,6 +80,40 @@ struct counter {
 	uint64_t at;
 	uint64_t step;
 	bool hide_zero;
+
+	/* Detailed statistics (`per-event-class`, `per-stream`, `inter-arrival-histogram` parameters) */
+	bool per_event_class;
+	bool per_stream;
+	bool inter_arrival_histogram;
+
+	/* True if any of the above is true */
+	bool has_details;
+
+	/* True if the detailed statistics are already printed */
+	bool printed_details;
+
+	/*
+	 * Array of owned `struct counter_stream_class_stats *` and of
+	 * owned `struct counter_stream_stats *`, in order of first
+	 * appearance.
+	 */
+	GPtrArray *stream_class_stats;
+	GPtrArray *stream_stats;
+
+	/* Weak `bt_stream *` to weak `struct counter_stream_stats *` */
+	GHashTable *stream_stats_map;
+
+	/* Weak: last stream and its statistics */
+	const bt_stream *last_stream;
+	struct counter_stream_stats *last_stream_stats;
+
+	/*
+	 * Number of events of which the time since the previous event
+	 * of the same stream, in nanoseconds, is 0 (bucket 0) or within
+	 * [2^(i - 1), 2^i) (bucket i).
+	 */
+	uint64_t inter_arrival_buckets[COUNTER_INTER_ARRIVAL_BUCKET_COUNT];
+
 	bt_logging_level log_level;
 	bt_self_component *self_comp;
 };
@@ -10,14 +10,132 @@
 #include "logging/comp-logging.h"
 
 #include <babeltrace2/babeltrace.h>
+#include <inttypes.h>
+#include <stdio.h>
+#ifndef __MINGW32__
+# include <sys/resource.h>
+#endif
 #include "common/macros.h"
 #include "common/assert.h"
+#include "common/common.h"
 #include "dummy.h"
 #include "plugins/common/param-validation/param-validation.h"
 
 static
 const char * const in_port_name = "in";
 
+/* Names of the message types, by message type index */
+static
+const char * const msg_type_names[DUMMY_MSG_TYPE_COUNT] = {
+	"stream-beginning",
+	"stream-end",
+	"event",
+	"packet-beginning",
+	"packet-end",
+	"discarded-events",
+	"discarded-packets",
+	"message-iterator-inactivity",
+};
+
+static inline
+unsigned int msg_type_index(const enum bt_message_type type)
+{
+	switch (type) {
+	case BT_MESSAGE_TYPE_STREAM_BEGINNING:
+		return 0;
+	case BT_MESSAGE_TYPE_STREAM_END:
+		return 1;
+	case BT_MESSAGE_TYPE_EVENT:
+		return 2;
+	case BT_MESSAGE_TYPE_PACKET_BEGINNING:
+		return 3;
+	case BT_MESSAGE_TYPE_PACKET_END:
+		return 4;
+	case BT_MESSAGE_TYPE_DISCARDED_EVENTS:
+		return 5;
+	case BT_MESSAGE_TYPE_DISCARDED_PACKETS:
+		return 6;
+	case BT_MESSAGE_TYPE_MESSAGE_ITERATOR_INACTIVITY:
+		return 7;
+	}
+
+	bt_common_abort();
+}
+
+/*
+ * Returns the CPU time (µs) of the process so far, or -1 if not
+ * available.
+ */
+static
+int64_t process_cpu_time_us(void)
+{
+#ifdef __MINGW32__
+	return -1;
+#else
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return -1;
+	}
+
+	return ((int64_t) usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+			INT64_C(1000000) +
+		usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+#endif
+}
+
+/*
+ * Prints the throughput summary of `dummy`, as a JSON object, to the
+ * standard output.
+ */
+static
+void print_stats(struct dummy *dummy)
+{
+	int64_t wall_time_us = 0;
+	int64_t cpu_time_us = -1;
+	uint64_t total_count = 0;
+	unsigned int i;
+
+	if (dummy->has_first_msg) {
+		wall_time_us = dummy->last_msg_time_us -
+			dummy->first_msg_time_us;
+
+		if (!dummy->ended) {
+			/* Interrupted or failed: up to now */
+			dummy->end_cpu_time_us = process_cpu_time_us();
+		}
+
+		if (dummy->first_msg_cpu_time_us >= 0 &&
+				dummy->end_cpu_time_us >= 0) {
+			cpu_time_us = dummy->end_cpu_time_us -
+				dummy->first_msg_cpu_time_us;
+		}
+	}
+
+	printf("{\n  \"message-counts\": {");
+
+	for (i = 0; i < DUMMY_MSG_TYPE_COUNT; i++) {
+		printf("%s\n    \"%s\": %" PRIu64, i == 0 ? "" : ",",
+			msg_type_names[i], dummy->msg_counts[i]);
+		total_count += dummy->msg_counts[i];
+	}
+
+	printf("\n  },\n  \"message-count\": %" PRIu64 ",\n", total_count);
+	printf("  \"ended\": %s,\n", dummy->ended ? "true" : "false");
+	printf("  \"wall-time-us\": %" PRId64 ",\n", wall_time_us);
+
+	if (cpu_time_us >= 0) {
+		printf("  \"cpu-time-us\": %" PRId64 ",\n", cpu_time_us);
+	} else {
+		printf("  \"cpu-time-us\": null,\n");
+	}
+
+	printf("  \"messages-per-second\": %.3f\n}\n",
+		wall_time_us == 0 ? 0. :
+			(double) total_count * 1e6 / (double) wall_time_us);
+	fflush(stdout);
+}
+
 bt_component_class_get_supported_mip_versions_method_status
 dummy_supported_mip_versions(
 		bt_self_component_class_sink *self_component_class __attribute__((unused)),
@@ -44,11 +162,17 @@ void dummy_finalize(bt_self_component_sink *comp)
 	dummy = bt_self_component_get_data(
 			bt_self_component_sink_as_self_component(comp));
 	BT_ASSERT(dummy);
+
+	if (dummy->stats) {
+		print_stats(dummy);
+	}
+
 	destroy_private_dummy_data(dummy);
 }
 
 static
 struct bt_param_validation_map_value_entry_descr dummy_params[] = {
+	{ "stats", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
@@ -67,6 +191,7 @@ bt_component_class_initialize_method_status dummy_init(
 	struct dummy *dummy = g_new0(struct dummy, 1);
 	enum bt_param_validation_status validation_status;
 	gchar *validate_error = NULL;
+	const bt_value *value;
 
 	if (!dummy) {
 		status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
@@ -84,6 +209,11 @@ bt_component_class_initialize_method_status dummy_init(
 		goto error;
 	}
 
+	value = bt_value_map_borrow_entry_value_const(params, "stats");
+	if (value) {
+		dummy->stats = (bool) bt_value_bool_get(value);
+	}
+
 	add_port_status = bt_self_component_sink_add_input_port(self_comp_sink,
 		"in", NULL, NULL);
 	if (add_port_status != BT_SELF_COMPONENT_ADD_PORT_STATUS_OK) {
@@ -149,13 +279,34 @@ bt_component_class_sink_consume_method_status dummy_consume(
 	BT_ASSERT_DBG(dummy);
 	BT_ASSERT_DBG(dummy->msg_iter);
 
-	/* Consume one message  */
+	/* Consume one message array */
 	next_status = bt_message_iterator_next(
 		dummy->msg_iter, &msgs, &count);
 	switch (next_status) {
 	case BT_MESSAGE_ITERATOR_NEXT_STATUS_OK:
-		for (i = 0; i < count; i++) {
-			bt_message_put_ref(msgs[i]);
+		if (G_UNLIKELY(dummy->stats)) {
+			dummy->last_msg_time_us = g_get_monotonic_time();
+
+			if (G_UNLIKELY(!dummy->has_first_msg)) {
+				dummy->has_first_msg = true;
+				dummy->first_msg_time_us =
+					dummy->last_msg_time_us;
+				dummy->first_msg_cpu_time_us =
+					process_cpu_time_us();
+			}
+
+			for (i = 0; i < count; i++) {
+				dummy->msg_counts[msg_type_index(
+					bt_message_get_type(msgs[i]))]++;
+			}
+		}
+
+		bt_message_put_refs(msgs, count);
+		break;
+	case BT_MESSAGE_ITERATOR_NEXT_STATUS_END:
+		if (dummy->stats && !dummy->ended) {
+			dummy->ended = true;
+			dummy->end_cpu_time_us = process_cpu_time_us();
 		}
 
 		break;
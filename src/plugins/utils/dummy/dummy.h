@@ -8,6 +8,8 @@
 #define BABELTRACE_PLUGINS_UTILS_DUMMY_DUMMY_H
 
 #include <glib.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <babeltrace2/babeltrace.h>
 #include "common/macros.h"
 
@@ -15,8 +17,31 @@
 extern "C" {
 #endif
 
+/* Number of message types */
+#define DUMMY_MSG_TYPE_COUNT	8
+
 struct dummy {
 	bt_message_iterator *msg_iter;
+
+	/* True to print a throughput summary when finalized */
+	bool stats;
+
+	/* Whether or not the message iterator ended */
+	bool ended;
+
+	/* Number of consumed messages, by message type index */
+	uint64_t msg_counts[DUMMY_MSG_TYPE_COUNT];
+
+	/*
+	 * Monotonic times (µs) of the first and last consumed message
+	 * batches, and process CPU times (µs) at the first message batch
+	 * and when the message iterator ended (negative if unavailable).
+	 */
+	bool has_first_msg;
+	int64_t first_msg_time_us;
+	int64_t last_msg_time_us;
+	int64_t first_msg_cpu_time_us;
+	int64_t end_cpu_time_us;
 };
 
 bt_component_class_get_supported_mip_versions_method_status
@@ -4,6 +4,8 @@
  * Copyright 2017-2023 Philippe Proulx <pproulx@efficios.com>
  */
 
+#include <limits>
+
 #include "cpp-common/vendor/fmt/core.h"
 
 #include "comp.hpp"
@@ -17,12 +19,72 @@ Comp::Comp(const bt2::SelfFilterComponent selfComp, const bt2::ConstMapValue par
 
     this->live_mode = false;
     /* Either parameters expected, or live mode gets passed and decoded */
+    auto knownParamCount = 0ULL;
+
     if (params.hasEntry("live")) {
         live_mode = bool(params["live"]);
-    } else if (!params.isEmpty()) {
+        ++knownParamCount;
+    }
+
+    if (const auto mergeStructureVal = params["merge-structure"]) {
+        if (!mergeStructureVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                              "`merge-structure` parameter: expecting a string.");
+        }
+
+        const auto mergeStructureStr = mergeStructureVal->asString().value();
+
+        if (mergeStructureStr == "heap") {
+            _mMergeStructure = MergeStructure::Heap;
+        } else if (mergeStructureStr == "loser-tree") {
+            _mMergeStructure = MergeStructure::LoserTree;
+        } else {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "`merge-structure` parameter: expecting `heap` or `loser-tree`: value=\"{}\"",
+                mergeStructureStr);
+        }
+
+        ++knownParamCount;
+    }
+
+    if (const auto reorderWindowVal = params["reorder-window-ns"]) {
+        if (!reorderWindowVal->isUnsignedInteger() ||
+            reorderWindowVal->asUnsignedInteger().value() >
+                static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "`reorder-window-ns` parameter: expecting an unsigned integer less than 2^63.");
+        }
+
+        _mReorderWindow = static_cast<std::int64_t>(reorderWindowVal->asUnsignedInteger().value());
+        ++knownParamCount;
+    }
+
+    if (const auto reorderDelayVal = params["reorder-delay-ms"]) {
+        if (!_mReorderWindow) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "`reorder-delay-ms` parameter: only valid with the `reorder-window-ns` parameter.");
+        }
+
+        if (!reorderDelayVal->isUnsignedInteger() ||
+            reorderDelayVal->asUnsignedInteger().value() >
+                static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max())) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error,
+                "`reorder-delay-ms` parameter: expecting an unsigned integer less than 2^31.");
+        }
+
+        _mReorderDelay = std::chrono::milliseconds {reorderDelayVal->asUnsignedInteger().value()};
+        ++knownParamCount;
+    }
+
+    if (params.length() != knownParamCount) {
         BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
             bt2c::Error,
-            "This component expects no parameters, or just the 'live' parameter: param-count={}",
+            "This component expects no parameters other than 'live', 'merge-structure', "
+            "'reorder-window-ns', and 'reorder-delay-ms': param-count={}",
             params.length());
     }
 
@@ -8,8 +8,13 @@
 #ifndef BABELTRACE_PLUGINS_UTILS_MUXER_COMP_HPP
 #define BABELTRACE_PLUGINS_UTILS_MUXER_COMP_HPP
 
+#include <chrono>
+#include <cstdint>
+
 #include "cpp-common/bt2/plugin-dev.hpp"
+#include "cpp-common/bt2s/optional.hpp"
 
+#include "merge-queue.hpp"
 #include "msg-iter.hpp"
 
 namespace bt2mux {
@@ -25,6 +30,23 @@ public:
     explicit Comp(bt2::SelfFilterComponent selfComp, bt2::ConstMapValue params, void *);
     bool live_mode;
 
+    MergeStructure mergeStructure() const noexcept
+    {
+        return _mMergeStructure;
+    }
+
+    /* Value of the `reorder-window-ns` parameter, if any */
+    const bt2s::optional<std::int64_t>& reorderWindow() const noexcept
+    {
+        return _mReorderWindow;
+    }
+
+    /* Value of the `reorder-delay-ms` parameter */
+    std::chrono::milliseconds reorderDelay() const noexcept
+    {
+        return _mReorderDelay;
+    }
+
 protected:
     static void _getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue,
                                          bt2::LoggingLevel, bt2::UnsignedIntegerRangeSet ranges);
@@ -32,6 +54,15 @@ protected:
 private:
     void _inputPortConnected(bt2::SelfComponentInputPort selfPort, bt2::ConstOutputPort otherPort);
     void _addAvailInputPort();
+
+    /* Value of the `merge-structure` parameter */
+    MergeStructure _mMergeStructure = MergeStructure::Heap;
+
+    /* Value of the `reorder-window-ns` parameter (ns) */
+    bt2s::optional<std::int64_t> _mReorderWindow;
+
+    /* Value of the `reorder-delay-ms` parameter */
+    std::chrono::milliseconds _mReorderDelay {0};
 };
 
 } /* namespace bt2mux */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_MUXER_MERGE_QUEUE_HPP
+#define BABELTRACE_PLUGINS_UTILS_MUXER_MERGE_QUEUE_HPP
+
+#include <cstddef>
+
+#include "cpp-common/bt2c/loser-tree.hpp"
+#include "cpp-common/bt2c/prio-heap.hpp"
+
+namespace bt2mux {
+
+/*
+ * Structure with which a muxer message iterator selects its oldest
+ * upstream message iterator.
+ */
+enum class MergeStructure
+{
+    /* Binary heap (`bt2c::PrioHeap`) */
+    Heap,
+
+    /* Tournament tree of losers (`bt2c::LoserTree`) */
+    LoserTree,
+};
+
+/*
+ * Priority queue which forwards to either a `bt2c::PrioHeap` or a
+ * `bt2c::LoserTree`, as selected at construction time.
+ *
+ * The interface is the common subset of both.
+ */
+template <typename T, typename CompT>
+class MergeQueue final
+{
+public:
+    explicit MergeQueue(const CompT& comp, const MergeStructure structure) :
+        _mStructure {structure}, _mHeap {comp}, _mLoserTree {comp}
+    {
+    }
+
+    MergeStructure structure() const noexcept
+    {
+        return _mStructure;
+    }
+
+    std::size_t len() const noexcept
+    {
+        return this->_isHeap() ? _mHeap.len() : _mLoserTree.len();
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return this->_isHeap() ? _mHeap.isEmpty() : _mLoserTree.isEmpty();
+    }
+
+    void clear()
+    {
+        if (this->_isHeap()) {
+            _mHeap.clear();
+        } else {
+            _mLoserTree.clear();
+        }
+    }
+
+    T& top()
+    {
+        return this->_isHeap() ? _mHeap.top() : _mLoserTree.top();
+    }
+
+    const T *secondTop() const
+    {
+        return this->_isHeap() ? _mHeap.secondTop() : _mLoserTree.secondTop();
+    }
+
+    const CompT& comp() const noexcept
+    {
+        return this->_isHeap() ? _mHeap.comp() : _mLoserTree.comp();
+    }
+
+    void insert(const T& elem)
+    {
+        if (this->_isHeap()) {
+            _mHeap.insert(elem);
+        } else {
+            _mLoserTree.insert(elem);
+        }
+    }
+
+    void removeTop()
+    {
+        if (this->_isHeap()) {
+            _mHeap.removeTop();
+        } else {
+            _mLoserTree.removeTop();
+        }
+    }
+
+    void replaceTop(const T& elem)
+    {
+        if (this->_isHeap()) {
+            _mHeap.replaceTop(elem);
+        } else {
+            _mLoserTree.replaceTop(elem);
+        }
+    }
+
+private:
+    bool _isHeap() const noexcept
+    {
+        return _mStructure == MergeStructure::Heap;
+    }
+
+    MergeStructure _mStructure;
+
+    /* Only the one which `_mStructure` selects is ever used */
+    bt2c::PrioHeap<T, CompT> _mHeap;
+    bt2c::LoserTree<T, CompT> _mLoserTree;
+};
+
+} /* namespace bt2mux */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_MUXER_MERGE_QUEUE_HPP */
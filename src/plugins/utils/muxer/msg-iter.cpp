@@ -5,6 +5,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 
 #include <glib.h>
 
@@ -24,7 +25,9 @@ namespace bt2mux {
 MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
                  const bt2::SelfMessageIteratorConfiguration cfg, bt2::SelfComponentOutputPort) :
     bt2::UserMessageIterator<MsgIter, Comp> {selfMsgIter, "MSG-ITER"},
-    _mHeap {_HeapComparator {_mLogger, selfMsgIter.component().graphMipVersion()}}
+    _mStreamOrdinals {selfMsgIter.component().graphMipVersion()},
+    _mHeap {_HeapComparator {_mLogger, selfMsgIter.component().graphMipVersion()},
+            this->_component().mergeStructure()}
 {
     /*
      * Create one upstream message iterator for each connected
@@ -32,6 +35,7 @@ MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
      */
     auto canSeekForward = true;
     this->isLive = this->_component().live_mode;
+    _mReorderWindow = this->_component().reorderWindow();
 
     for (const auto inputPort : this->_component()._inputPorts()) {
         if (!inputPort.isConnected()) {
@@ -45,7 +49,7 @@ MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
          * deal with it when downstream calls next()).
          */
         auto upstreamMsgIter = bt2s::make_unique<UpstreamMsgIter>(
-            this->_createMessageIterator(inputPort), inputPort.name(), _mLogger);
+            this->_createMessageIterator(inputPort), inputPort.name(), _mStreamOrdinals, _mLogger);
 
         canSeekForward = canSeekForward && upstreamMsgIter->canSeekForward();
         _mUpstreamMsgItersToReload.emplace_back(upstreamMsgIter.get());
@@ -56,6 +60,14 @@ MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
     cfg.canSeekForward(canSeekForward);
 }
 
+MsgIter::~MsgIter()
+{
+    if (_mLateMsgCount > 0) {
+        BT_CPPLOGW("Emitted messages outside of the reorder window: late-msg-count={}",
+                   _mLateMsgCount);
+    }
+}
+
 namespace {
 
 std::string optMsgTsStr(const bt2s::optional<std::int64_t>& ts)
@@ -76,19 +88,60 @@ void MsgIter::reset()
     for (auto& it : _mUpstreamMsgIters) {
         _mUpstreamMsgItersToReload.push_back(it.get());
     }
+
+    if (_mReorderWindow) {
+        /* _next() reloads them within the reorder window */
+        return;
+    }
+
     this->_ensureFullHeap();
 }
 
 void MsgIter::_next(bt2::ConstMessageArray& msgs)
 {
-    /* Make sure all upstream message iterators are part of the heap */
-    this->_ensureFullHeap();
+    /*
+     * With a reorder window, timestamp of the newest message to emit
+     * while some upstream message iterator is lagging, if any.
+     */
+    bt2s::optional<std::int64_t> emitBound;
+
+    if (_mReorderWindow) {
+        emitBound = this->_ensureHeapWithinReorderWindow();
+    } else {
+        /* Make sure all upstream message iterators are part of the heap */
+        this->_ensureFullHeap();
+    }
+
+    /*
+     * Second oldest upstream message iterator of `_mHeap` while the
+     * oldest one remains the same (a run), or `nullptr` if not known
+     * yet.
+     *
+     * As long as the new current message of the oldest upstream
+     * message iterator is still older than the current message of
+     * `*runRival`, there's no need to touch `_mHeap`: this turns a run
+     * of messages of a single upstream message iterator into a single
+     * comparison per message and a single heap rebalance at the end of
+     * the run.
+     */
+    const UpstreamMsgIter *runRival = nullptr;
+    bool runRivalIsKnown = false;
 
     while (msgs.length() < msgs.capacity()) {
         /* Empty heap? */
         if (G_UNLIKELY(_mHeap.isEmpty())) {
+            if (_mReorderWindow && !_mUpstreamMsgItersToReload.empty()) {
+                /* Only lagging upstream message iterators remain */
+                throw bt2::TryAgain {};
+            }
+
             if (this->isLive) {
                 reset();
+
+                if (_mReorderWindow) {
+                    /* Reload all of them during the next call */
+                    throw bt2::TryAgain {};
+                }
             }
             // Reset to the beginning
             return;
@@ -99,19 +152,39 @@ void MsgIter::_next(bt2::ConstMessageArray& msgs)
          */
         auto& oldestUpstreamMsgIter = *_mHeap.top();
 
+        /*
+         * Don't emit a message within the reorder window while some
+         * upstream message iterator is lagging: it could still provide
+         * an older message.
+         */
+        if (emitBound && oldestUpstreamMsgIter.msgTs() &&
+            *oldestUpstreamMsgIter.msgTs() > *emitBound) {
+            BT_CPPLOGD("Oldest message is within the reorder window: "
+                       "port-name={}, ts={}, emit-bound-ts={}",
+                       oldestUpstreamMsgIter.portName(), *oldestUpstreamMsgIter.msgTs(),
+                       *emitBound);
+            throw bt2::TryAgain {};
+        }
+
         /* Validate the clock class of the oldest message */
         this->_validateMsgClkCls(oldestUpstreamMsgIter.msg());
 
-        /* Append the oldest message and discard it */
-        msgs.append(oldestUpstreamMsgIter.msg().shared());
-
         if (_mLogger.wouldLogD()) {
-            BT_CPPLOGD("Appended message to array: port-name={}, ts={}",
+            BT_CPPLOGD("Appending message to array: port-name={}, ts={}",
                        oldestUpstreamMsgIter.portName(),
                        optMsgTsStr(oldestUpstreamMsgIter.msgTs()));
         }
 
-        oldestUpstreamMsgIter.discard();
+        if (_mReorderWindow) {
+            this->_checkLateMsg(oldestUpstreamMsgIter);
+        }
+
+        /*
+         * Move the oldest message to the array: this also discards it
+         * from `oldestUpstreamMsgIter`, without any reference count
+         * change.
+         */
+        msgs.append(oldestUpstreamMsgIter.take());
 
         /*
          * Immediately try to reload `oldestUpstreamMsgIter`.
@@ -139,11 +212,31 @@ void MsgIter::_next(bt2::ConstMessageArray& msgs)
             oldestUpstreamMsgIter.portName());
         try {
             if (G_LIKELY(oldestUpstreamMsgIter.reload() == UpstreamMsgIter::ReloadStatus::More)) {
-                /* New current message: update heap */
+                if (_mReorderWindow) {
+                    this->_updateNewestTs(oldestUpstreamMsgIter);
+                }
+
+                if (!runRivalIsKnown) {
+                    const auto secondTop = _mHeap.secondTop();
+
+                    runRival = secondTop ? *secondTop : nullptr;
+                    runRivalIsKnown = true;
+                }
+
+                if (!runRival || !_mHeap.comp()(runRival, &oldestUpstreamMsgIter)) {
+                    /* Still the oldest message: continue the run */
+                    BT_CPPLOGD("More messages available; still the oldest: port-name={}",
+                               oldestUpstreamMsgIter.portName());
+                    continue;
+                }
+
+                /* New current message: update heap, ending the run */
                 _mHeap.replaceTop(&oldestUpstreamMsgIter);
+                runRivalIsKnown = false;
                 BT_CPPLOGD("More messages available; updated heap: port-name={}, heap-len={}",
                            oldestUpstreamMsgIter.portName(), _mHeap.len());
             } else {
+                runRivalIsKnown = false;
                 _mHeap.removeTop();
                 BT_CPPLOGD("Upstream message iterator has no more messages; removed from heap: "
                            "port-name{}, heap-len={}",
@@ -200,6 +293,130 @@ void MsgIter::_ensureFullHeap()
     }
 }
 
+bt2s::optional<std::int64_t> MsgIter::_ensureHeapWithinReorderWindow()
+{
+    /*
+     * Unlike _ensureFullHeap(), remove from `_mUpstreamMsgItersToReload`
+     * each upstream message iterator of which reload() doesn't throw,
+     * and keep the other (lagging) ones to retry them during the next
+     * call.
+     */
+    auto it = _mUpstreamMsgItersToReload.begin();
+
+    while (it != _mUpstreamMsgItersToReload.end()) {
+        auto& upstreamMsgIter = **it;
+
+        BT_CPPLOGD("Handling upstream message iterator to reload: "
+                   "port-name={}, heap-len={}, to-reload-len={}",
+                   upstreamMsgIter.portName(), _mHeap.len(), _mUpstreamMsgItersToReload.size());
+
+        try {
+            if (G_LIKELY(upstreamMsgIter.reload() == UpstreamMsgIter::ReloadStatus::More)) {
+                const auto& ts = upstreamMsgIter.msgTs();
+
+                if (G_UNLIKELY(ts && _mLastEmittedTs && *ts < *_mLastEmittedTs)) {
+                    BT_CPPLOGW("Lagging upstream message iterator is back with a message outside "
+                               "of the reorder window: port-name={}, ts={}, last-emitted-ts={}",
+                               upstreamMsgIter.portName(), *ts, *_mLastEmittedTs);
+                }
+
+                this->_updateNewestTs(upstreamMsgIter);
+                _mHeap.insert(&upstreamMsgIter);
+                BT_CPPLOGD("More messages available; "
+                           "inserted upstream message iterator into heap from \"to reload\" set: "
+                           "port-name={}, heap-len={}",
+                           upstreamMsgIter.portName(), _mHeap.len());
+            } else {
+                BT_CPPLOGD("Not inserting upstream message iterator into heap (no more messages): "
+                           "port-name={}",
+                           upstreamMsgIter.portName());
+            }
+
+            it = _mUpstreamMsgItersToReload.erase(it);
+        } catch (const bt2::TryAgain&) {
+            BT_CPPLOGD("Upstream message iterator is lagging: port-name={}",
+                       upstreamMsgIter.portName());
+            ++it;
+        }
+    }
+
+    if (_mUpstreamMsgItersToReload.empty()) {
+        /* Full heap: no emission bound */
+        _mLagBegin.reset();
+        return bt2s::nullopt;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (!_mLagBegin) {
+        _mLagBegin = now;
+    }
+
+    if (now - *_mLagBegin < this->_component().reorderDelay()) {
+        /* Still waiting for the lagging upstream message iterators */
+        throw bt2::TryAgain {};
+    }
+
+    if (!_mNewestTs) {
+        /* No known time: only emit the messages without a timestamp */
+        return std::numeric_limits<std::int64_t>::min();
+    }
+
+    /*
+     * Stop waiting: emit the messages which are older than the
+     * estimated current time by more than the reorder window.
+     *
+     * Advancing the estimated current time with the wall clock makes
+     * sure that the messages of an active upstream message iterator
+     * eventually leave the reorder window, even if the heap only holds
+     * messages which are within it (the muxer only reloads an upstream
+     * message iterator after having emitted its current message).
+     */
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _mNewestTsTime);
+    const auto nowTs =
+        *_mNewestTs > std::numeric_limits<std::int64_t>::max() - elapsed.count() ?
+            std::numeric_limits<std::int64_t>::max() :
+            *_mNewestTs + elapsed.count();
+    const auto emitBound = nowTs < std::numeric_limits<std::int64_t>::min() + *_mReorderWindow ?
+                               std::numeric_limits<std::int64_t>::min() :
+                               nowTs - *_mReorderWindow;
+
+    BT_CPPLOGD("Not waiting for lagging upstream message iterators anymore: "
+               "lagging-count={}, newest-ts={}, now-ts={}, emit-bound-ts={}",
+               _mUpstreamMsgItersToReload.size(), *_mNewestTs, nowTs, emitBound);
+    return emitBound;
+}
+
+void MsgIter::_checkLateMsg(const UpstreamMsgIter& upstreamMsgIter)
+{
+    const auto& ts = upstreamMsgIter.msgTs();
+
+    if (!ts) {
+        return;
+    }
+
+    if (G_UNLIKELY(_mLastEmittedTs && *ts < *_mLastEmittedTs)) {
+        /*
+         * Can't reorder anymore: emit it anyway, as dropping it could
+         * break the message sequence of its stream.
+         */
+        ++_mLateMsgCount;
+        BT_CPPLOGD("Emitting late message: port-name={}, ts={}, last-emitted-ts={}, "
+                   "late-msg-count={}",
+                   upstreamMsgIter.portName(), *ts, *_mLastEmittedTs, _mLateMsgCount);
+        return;
+    }
+
+    _mLastEmittedTs = *ts;
+}
+
+void MsgIter::_resetReorderWindowState() noexcept
+{
+    _mLagBegin.reset();
+    _mNewestTs.reset();
+    _mLastEmittedTs.reset();
+}
+
 bool MsgIter::_canSeekBeginning()
 {
     /*
@@ -235,6 +452,7 @@ void MsgIter::_seekBeginning()
      */
     _mHeap.clear();
     _mUpstreamMsgItersToReload.clear();
+    this->_resetReorderWindowState();
 
     /* Make each upstream message iterator seek */
     for (auto& upstreamMsgIter : _mUpstreamMsgIters) {
@@ -242,6 +460,9 @@ void MsgIter::_seekBeginning()
         upstreamMsgIter->seekBeginning();
     }
 
+    /* All the upstream message iterators released their streams */
+    _mStreamOrdinals.clear();
+
     /*
      * All sought successfully: fill `_mUpstreamMsgItersToReload`; the
      * next call to _next() will deal with those.
@@ -251,6 +472,47 @@ void MsgIter::_seekBeginning()
     }
 }
 
+bool MsgIter::_canSeekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    /*
+     * We can only seek if all our upstream message iterators also can,
+     * whether they do it themselves or with the automatic seeking of
+     * the library.
+     *
+     * Without this method, the library would make this message iterator
+     * seek its beginning and then consume messages up to
+     * `nsFromOrigin`, even if all the upstream message iterators can
+     * seek directly (for example thanks to a packet index).
+     */
+    return std::all_of(_mUpstreamMsgIters.begin(), _mUpstreamMsgIters.end(),
+                       [nsFromOrigin](UpstreamMsgIter::UP& upstreamMsgIter) {
+                           return upstreamMsgIter->canSeekNsFromOrigin(nsFromOrigin);
+                       });
+}
+
+void MsgIter::_seekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    /*
+     * Same approach as _seekBeginning(): once all the upstream message
+     * iterators sought, their messages are at or after `nsFromOrigin`,
+     * so that muxing them as usual yields the expected messages.
+     */
+    _mHeap.clear();
+    _mUpstreamMsgItersToReload.clear();
+    this->_resetReorderWindowState();
+
+    for (auto& upstreamMsgIter : _mUpstreamMsgIters) {
+        /* This may throw! */
+        upstreamMsgIter->seekNsFromOrigin(nsFromOrigin);
+    }
+
+    _mStreamOrdinals.clear();
+
+    for (auto& upstreamMsgIter : _mUpstreamMsgIters) {
+        _mUpstreamMsgItersToReload.push_back(upstreamMsgIter.get());
+    }
+}
+
 namespace {
 
 std::string formatClkClsOrigin(const bt2::ClockOriginView clkClsOrigin, const char * const prefix)
@@ -515,8 +777,29 @@ bool MsgIter::_HeapComparator::operator()(
     }
 
     /*
-     * Comparison failed using timestamps: determine an ordering using
-     * arbitrary properties, but in a deterministic way.
+     * Comparison failed using timestamps: try to use the stream
+     * ordinals.
+     *
+     * Two messages of which the streams have different ordinals are
+     * ordered by those ordinals, exactly like
+     * common_muxing_compare_messages() would order them by comparing
+     * their streams first, but with a single integer comparison.
+     */
+    {
+        const auto streamOrdA = upstreamMsgIterA->msgStreamOrdinal();
+        const auto streamOrdB = upstreamMsgIterB->msgStreamOrdinal();
+
+        if (streamOrdA && streamOrdB && *streamOrdA != *streamOrdB) {
+            BT_CPPLOGT("Timestamps are considered equal; comparing stream ordinals: oldest={}",
+                       *streamOrdA < *streamOrdB ? "A" : "B");
+            return *streamOrdA < *streamOrdB;
+        }
+    }
+
+    /*
+     * Comparison failed using timestamps and stream ordinals: determine
+     * an ordering using arbitrary properties, but in a deterministic
+     * way.
      *
      * common_muxing_compare_messages() returns less than 0 if the first
      * message is considered older than the second, which corresponds to
@@ -8,16 +8,20 @@
 #ifndef BABELTRACE_PLUGINS_UTILS_MUXER_MSG_ITER_HPP
 #define BABELTRACE_PLUGINS_UTILS_MUXER_MSG_ITER_HPP
 
+#include <chrono>
+#include <cstdint>
 #include <unordered_set>
 #include <vector>
 
 #include "cpp-common/bt2/component-class-dev.hpp"
 #include "cpp-common/bt2/self-message-iterator-configuration.hpp"
-#include "cpp-common/bt2c/prio-heap.hpp"
+#include "cpp-common/bt2s/optional.hpp"
 
 #include "plugins/common/muxing/muxing.hpp"
 
 #include "clock-correlation-validator/clock-correlation-validator.hpp"
+#include "merge-queue.hpp"
+#include "stream-ordinals.hpp"
 #include "upstream-msg-iter.hpp"
 
 namespace bt2mux {
@@ -50,11 +54,14 @@ public:
     explicit MsgIter(bt2::SelfMessageIterator selfMsgIter,
                      bt2::SelfMessageIteratorConfiguration config,
                      bt2::SelfComponentOutputPort selfPort);
+    ~MsgIter();
     void reset();
 
 private:
     bool _canSeekBeginning();
     void _seekBeginning();
+    bool _canSeekNsFromOrigin(std::int64_t nsFromOrigin);
+    void _seekNsFromOrigin(std::int64_t nsFromOrigin);
     void _next(bt2::ConstMessageArray& msgs);
 
     /*
@@ -65,6 +72,56 @@ private:
      */
     void _ensureFullHeap();
 
+    /*
+     * Reorder window version of _ensureFullHeap(): tries to reload
+     * each upstream message iterator of `_mUpstreamMsgItersToReload`
+     * once, keeping the ones which throw `bt2::TryAgain`.
+     *
+     * Returns no value when `_mUpstreamMsgItersToReload` becomes empty
+     * (the heap is full).
+     *
+     * Otherwise, once some upstream message iterator is lagging for
+     * more than the `reorder-delay-ms` parameter, returns the
+     * timestamp (ns from origin) of the newest message to emit without
+     * waiting for the lagging ones. Throws `bt2::TryAgain` before.
+     *
+     * This bound is the estimated current time minus the reorder
+     * window, where the estimated current time is `_mNewestTs` plus
+     * the wall clock time elapsed since it last changed: the bound
+     * keeps moving forward even when all the messages which the heap
+     * holds are within the reorder window.
+     */
+    bt2s::optional<std::int64_t> _ensureHeapWithinReorderWindow();
+
+    /*
+     * Makes the timestamp of the newest message which
+     * `upstreamMsgIter`, of which the current message enters the heap,
+     * already holds (look-ahead) the newest known timestamp if it's
+     * newer.
+     *
+     * Only reads the clock when the newest known timestamp changes,
+     * that is, at most once per upstream message batch.
+     */
+    void _updateNewestTs(const UpstreamMsgIter& upstreamMsgIter)
+    {
+        const auto ts = upstreamMsgIter.batchNewestMsgTs() ? upstreamMsgIter.batchNewestMsgTs() :
+                                                             upstreamMsgIter.msgTs();
+
+        if (ts && (!_mNewestTs || *ts > *_mNewestTs)) {
+            _mNewestTs = *ts;
+            _mNewestTsTime = std::chrono::steady_clock::now();
+        }
+    }
+
+    /*
+     * Counts the message of `upstreamMsgIter`, about to be emitted, as
+     * late if it's older than the last emitted message.
+     */
+    void _checkLateMsg(const UpstreamMsgIter& upstreamMsgIter);
+
+    /* Forgets the reorder window state (after seeking) */
+    void _resetReorderWindowState() noexcept;
+
     /*
      * Validates the clock class of the received message `msg`, setting
      * the expectation if this is the first one.
@@ -73,6 +130,12 @@ private:
      */
     void _validateMsgClkCls(bt2::ConstMessage msg);
 
+    /*
+     * Stream ordinal registry which the upstream message iterators
+     * of `_mUpstreamMsgIters` share.
+     */
+    StreamOrdinals _mStreamOrdinals;
+
     /*
      * Container of all the upstream message iterators.
      *
@@ -82,10 +145,11 @@ private:
     std::vector<UpstreamMsgIter::UP> _mUpstreamMsgIters;
 
     /*
-     * Heap of ready-to-use upstream message iterators (pointers to
-     * owned objects in `_mUpstreamMsgIters` above).
+     * Heap (or loser tree, depending on the `merge-structure`
+     * parameter) of ready-to-use upstream message iterators (pointers
+     * to owned objects in `_mUpstreamMsgIters` above).
      */
-    bt2c::PrioHeap<UpstreamMsgIter *, _HeapComparator> _mHeap;
+    MergeQueue<UpstreamMsgIter *, _HeapComparator> _mHeap;
 
     /*
      * Current upstream message iterators to reload, on which we must
@@ -99,6 +163,33 @@ private:
     std::vector<UpstreamMsgIter *> _mUpstreamMsgItersToReload;
     std::unordered_set<UpstreamMsgIter *> _mReloadedThisCycle;
 
+    /*
+     * Reorder window (ns), if enabled with the `reorder-window-ns`
+     * parameter.
+     */
+    bt2s::optional<std::int64_t> _mReorderWindow;
+
+    /*
+     * Time since which `_mUpstreamMsgItersToReload` isn't empty, if
+     * it's not (reorder window only).
+     */
+    bt2s::optional<std::chrono::steady_clock::time_point> _mLagBegin;
+
+    /*
+     * Newest timestamp of a message which an upstream message iterator
+     * of the heap holds (reorder window only).
+     */
+    bt2s::optional<std::int64_t> _mNewestTs;
+
+    /* Time at which `_mNewestTs` last changed */
+    std::chrono::steady_clock::time_point _mNewestTsTime;
+
+    /* Timestamp of the newest emitted message (reorder window only) */
+    bt2s::optional<std::int64_t> _mLastEmittedTs;
+
+    /* Number of emitted messages older than `_mLastEmittedTs` */
+    std::uint64_t _mLateMsgCount = 0;
+
     /* Clock class correlation validator */
     bt2ccv::ClockCorrelationValidator _mClkCorrValidator;
 };
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <algorithm>
+
+#include <glib.h>
+
+#include "common/assert.h"
+#include "cpp-common/bt2s/make-unique.hpp"
+
+#include "stream-ordinals.hpp"
+
+namespace bt2mux {
+
+StreamOrdinals::StreamOrdinals(const std::uint64_t graphMipVersion) :
+    _mComparator {graphMipVersion}
+{
+}
+
+const StreamOrdinals::Entry& StreamOrdinals::acquire(const bt2::ConstStream stream)
+{
+    const auto mapIt = _mEntryMap.find(stream.libObjPtr());
+
+    if (G_LIKELY(mapIt != _mEntryMap.end())) {
+        ++mapIt->second->_mRefCount;
+        return *mapIt->second;
+    }
+
+    /* New stream: insert it at its sorted position */
+    auto entry = bt2s::make_unique<Entry>(stream);
+    auto& entryRef = *entry;
+    const auto it =
+        std::upper_bound(_mEntries.begin(), _mEntries.end(), stream,
+                         [this](const bt2::ConstStream streamA, const std::unique_ptr<Entry>& entryB) {
+                             return _mComparator.compareStreams(streamA, *entryB->_mStream) < 0;
+                         });
+
+    _mEntries.insert(it, std::move(entry));
+    _mEntryMap.emplace(stream.libObjPtr(), &entryRef);
+    this->_renumber();
+    ++entryRef._mRefCount;
+    return entryRef;
+}
+
+void StreamOrdinals::release(const Entry& entry, const bool streamEnded) noexcept
+{
+    auto& mutEntry = const_cast<Entry&>(entry);
+
+    BT_ASSERT_DBG(mutEntry._mRefCount > 0);
+    --mutEntry._mRefCount;
+
+    if (!streamEnded || mutEntry._mRefCount > 0) {
+        return;
+    }
+
+    /*
+     * Removing an entry doesn't change the relative order of the
+     * remaining ones: no need to renumber.
+     */
+    _mEntryMap.erase(mutEntry._mStream->libObjPtr());
+    _mEntries.erase(std::find_if(_mEntries.begin(), _mEntries.end(),
+                                 [&mutEntry](const std::unique_ptr<Entry>& otherEntry) {
+                                     return otherEntry.get() == &mutEntry;
+                                 }));
+}
+
+void StreamOrdinals::clear() noexcept
+{
+    _mEntryMap.clear();
+    _mEntries.clear();
+}
+
+void StreamOrdinals::_renumber() noexcept
+{
+    std::uint64_t ordinal = 0;
+
+    for (auto it = _mEntries.begin(); it != _mEntries.end(); ++it) {
+        if (it != _mEntries.begin() &&
+            _mComparator.compareStreams(*(*(it - 1))->_mStream, *(*it)->_mStream) != 0) {
+            ++ordinal;
+        }
+
+        (*it)->_mOrdinal = ordinal;
+    }
+}
+
+} /* namespace bt2mux */
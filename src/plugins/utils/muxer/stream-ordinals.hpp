@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 EfficiOS, Inc.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_MUXER_STREAM_ORDINALS_HPP
+#define BABELTRACE_PLUGINS_UTILS_MUXER_STREAM_ORDINALS_HPP
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "cpp-common/bt2/trace-ir.hpp"
+
+#include "plugins/common/muxing/muxing.hpp"
+
+namespace bt2mux {
+
+/*
+ * Registry of the streams of the current messages of the upstream
+ * message iterators of a muxer message iterator.
+ *
+ * This registry assigns an ordinal to each stream so that, for two
+ * registered streams A and B:
+ *
+ * • The ordinal of A is less than the ordinal of B if and only if
+ *   muxing::MessageComparator::compareStreams() considers that A comes
+ *   before B.
+ *
+ * • The ordinals of A and B are equal if and only if
+ *   muxing::MessageComparator::compareStreams() considers that A and B
+ *   are equal.
+ *
+ * This makes it possible to break a timestamp tie between two messages
+ * of different streams with a single integer comparison instead of
+ * comparing trace identities, trace names, and stream (class) IDs
+ * each time.
+ *
+ * Adding a stream may change the ordinals of the other streams, but
+ * never their relative order.
+ */
+class StreamOrdinals final
+{
+public:
+    /* Registered stream */
+    class Entry final
+    {
+        friend class StreamOrdinals;
+
+    public:
+        explicit Entry(const bt2::ConstStream stream) : _mStream {stream.shared()}
+        {
+        }
+
+        std::uint64_t ordinal() const noexcept
+        {
+            return _mOrdinal;
+        }
+
+    private:
+        bt2::ConstStream::Shared _mStream;
+        std::uint64_t _mOrdinal = 0;
+
+        /* Number of acquire() calls without a matching release() call */
+        std::uint64_t _mRefCount = 0;
+    };
+
+    explicit StreamOrdinals(std::uint64_t graphMipVersion);
+
+    /* Some protection */
+    StreamOrdinals(const StreamOrdinals&) = delete;
+    StreamOrdinals& operator=(const StreamOrdinals&) = delete;
+
+    /*
+     * Returns the entry of `stream`, registering `stream` if needed.
+     *
+     * The returned entry remains valid until you call release() as
+     * many times as you called acquire() for `stream` or until you call
+     * clear().
+     */
+    const Entry& acquire(bt2::ConstStream stream);
+
+    /*
+     * Releases `entry`, as returned by acquire().
+     *
+     * If `streamEnded` is true, then this method unregisters the
+     * stream of `entry` once it's not acquired anymore.
+     */
+    void release(const Entry& entry, bool streamEnded) noexcept;
+
+    /*
+     * Unregisters all the streams.
+     */
+    void clear() noexcept;
+
+private:
+    /* Assigns the ordinals of `_mEntries` from scratch */
+    void _renumber() noexcept;
+
+    muxing::MessageComparator _mComparator;
+
+    /* Registered streams, sorted with `_mComparator` */
+    std::vector<std::unique_ptr<Entry>> _mEntries;
+
+    /* Stream library pointer to entry within `_mEntries` */
+    std::unordered_map<const bt_stream *, Entry *> _mEntryMap;
+};
+
+} /* namespace bt2mux */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_MUXER_STREAM_ORDINALS_HPP */
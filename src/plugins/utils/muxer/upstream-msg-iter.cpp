@@ -16,8 +16,9 @@
 namespace bt2mux {
 
 UpstreamMsgIter::UpstreamMsgIter(bt2::MessageIterator::Shared msgIter, std::string portName,
+                                 StreamOrdinals& streamOrdinals,
                                  const bt2c::Logger& parentLogger) :
-    _mMsgIter {std::move(msgIter)},
+    _mMsgIter {std::move(msgIter)}, _mStreamOrdinals {&streamOrdinals},
     _mLogger {parentLogger, fmt::format("{}/[{}]", parentLogger.tag(), portName)},
     _mPortName {std::move(portName)}
 {
@@ -108,6 +109,7 @@ UpstreamMsgIter::ReloadStatus UpstreamMsgIter::reload()
     if (G_UNLIKELY(!_mMsgs.msgs)) {
         /* Still none: no more */
         _mMsgTs.reset();
+        _mBatchNewestMsgTs.reset();
         return ReloadStatus::NoMore;
     } else {
         if (const auto cs = msgCs(this->msg())) {
@@ -119,6 +121,18 @@ UpstreamMsgIter::ReloadStatus UpstreamMsgIter::reload()
             BT_CPPLOGD("Reset the timestamp of the current message: this={}", fmt::ptr(this));
         }
 
+        /*
+         * Cache the stream ordinal entry for the heap comparator.
+         *
+         * Release the current one first in case the user calls this
+         * method again without calling discard().
+         */
+        this->_releaseStreamOrdinalEntry();
+
+        if (const auto stream = muxing::borrowStream(this->msg())) {
+            _mMsgStreamOrdinalEntry = &_mStreamOrdinals->acquire(*stream);
+        }
+
         _mDiscardRequired = true;
         return ReloadStatus::More;
     }
@@ -152,6 +166,19 @@ void UpstreamMsgIter::_tryGetNewMsgs()
     _mMsgs.index = 0;
     BT_CPPLOGD("Got {1} messages from upstream: this={0}, count={1}", fmt::ptr(this),
                _mMsgs.msgs->length());
+
+    /*
+     * The messages of a batch are in order: the last one having a
+     * timestamp is the newest one.
+     */
+    _mBatchNewestMsgTs.reset();
+
+    for (auto i = _mMsgs.msgs->length(); i > 0; --i) {
+        if (const auto cs = msgCs((*_mMsgs.msgs)[i - 1])) {
+            _mBatchNewestMsgTs = cs->nsFromOrigin();
+            break;
+        }
+    }
 }
 
 bool UpstreamMsgIter::canSeekBeginning()
@@ -161,9 +188,26 @@ bool UpstreamMsgIter::canSeekBeginning()
 
 void UpstreamMsgIter::seekBeginning()
 {
+    this->_releaseStreamOrdinalEntry();
     _mMsgIter->seekBeginning();
     _mMsgs.msgs.reset();
     _mMsgTs.reset();
+    _mBatchNewestMsgTs.reset();
+    _mDiscardRequired = false;
+}
+
+bool UpstreamMsgIter::canSeekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    return _mMsgIter->canSeekNsFromOrigin(nsFromOrigin);
+}
+
+void UpstreamMsgIter::seekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    this->_releaseStreamOrdinalEntry();
+    _mMsgIter->seekNsFromOrigin(nsFromOrigin);
+    _mMsgs.msgs.reset();
+    _mMsgTs.reset();
+    _mBatchNewestMsgTs.reset();
     _mDiscardRequired = false;
 }
 
@@ -8,6 +8,7 @@
 #ifndef BABELTRACE_PLUGINS_UTILS_MUXER_UPSTREAM_MSG_ITER_HPP
 #define BABELTRACE_PLUGINS_UTILS_MUXER_UPSTREAM_MSG_ITER_HPP
 
+#include <cstdint>
 #include <memory>
 
 #include "common/assert.h"
@@ -16,6 +17,8 @@
 #include "cpp-common/bt2c/logging.hpp"
 #include "cpp-common/bt2s/optional.hpp"
 
+#include "stream-ordinals.hpp"
+
 namespace bt2mux {
 
 /*
@@ -43,9 +46,12 @@ public:
      * This constructor doesn't immediately gets the next messages from
      * `*msgIter` (you always need to call reload() before you call
      * msg()), therefore it won't throw `bt2::Error` or `bt2::TryAgain`.
+     *
+     * The stream of each current message is registered within
+     * `streamOrdinals`, which must outlive this.
      */
     explicit UpstreamMsgIter(bt2::MessageIterator::Shared msgIter, std::string portName,
-                             const bt2c::Logger& parentLogger);
+                             StreamOrdinals& streamOrdinals, const bt2c::Logger& parentLogger);
 
     /* Some protection */
     UpstreamMsgIter(const UpstreamMsgIter&) = delete;
@@ -84,6 +90,32 @@ public:
         return _mMsgTs;
     }
 
+    /*
+     * Timestamp, if any, of the newest message of the current message
+     * batch, that is, the last one having a timestamp (look-ahead).
+     *
+     * It must be valid to call msg() when you call this method.
+     */
+    bt2s::optional<std::int64_t> batchNewestMsgTs() const noexcept
+    {
+        return _mBatchNewestMsgTs;
+    }
+
+    /*
+     * Stream ordinal (see `StreamOrdinals`), if any, of the current
+     * message.
+     *
+     * It must be valid to call msg() when you call this method.
+     */
+    const bt2s::optional<std::uint64_t> msgStreamOrdinal() const noexcept
+    {
+        if (_mMsgStreamOrdinalEntry) {
+            return _mMsgStreamOrdinalEntry->ordinal();
+        }
+
+        return bt2s::nullopt;
+    }
+
     /*
      * Discards the current message, making this upstream message
      * iterator ready for a reload (reload()).
@@ -96,6 +128,7 @@ public:
         BT_ASSERT_DBG(_mMsgs.msgs && _mMsgs.index < _mMsgs.msgs->length());
         BT_ASSERT_DBG(_mDiscardRequired);
         _mDiscardRequired = false;
+        this->_releaseStreamOrdinalEntry();
         ++_mMsgs.index;
 
         if (_mMsgs.index == _mMsgs.msgs->length()) {
@@ -103,6 +136,31 @@ public:
         }
     }
 
+    /*
+     * Like discard(), but moves the reference of the current message
+     * to the caller instead of putting it, without changing its
+     * reference count.
+     */
+    bt2::ConstMessage::Shared take() noexcept
+    {
+        BT_ASSERT_DBG(_mMsgs.msgs && _mMsgs.index < _mMsgs.msgs->length());
+        BT_ASSERT_DBG(_mDiscardRequired);
+        _mDiscardRequired = false;
+
+        /* Needs the current message: release before taking it */
+        this->_releaseStreamOrdinalEntry();
+
+        auto msg = _mMsgs.msgs->take(_mMsgs.index);
+
+        ++_mMsgs.index;
+
+        if (_mMsgs.index == _mMsgs.msgs->length()) {
+            _mMsgs.msgs.reset();
+        }
+
+        return msg;
+    }
+
     /*
      * Retrieves the next message, making it available afterwards
      * through the msg() method.
@@ -116,7 +174,8 @@ public:
      * If this method returns `ReloadStatus::NO_MORE`, then the
      * underlying libbabeltrace2 message iterator is ended, meaning you
      * may not call msg(), msgTs(), or reload() again for this message
-     * iterator until you successfully call seekBeginning().
+     * iterator until you successfully call seekBeginning() or
+     * seekNsFromOrigin().
      */
     ReloadStatus reload();
 
@@ -134,6 +193,18 @@ public:
      */
     void seekBeginning();
 
+    /*
+     * Forwards to bt2::MessageIterator::canSeekNsFromOrigin().
+     */
+    bool canSeekNsFromOrigin(std::int64_t nsFromOrigin);
+
+    /*
+     * Forwards to bt2::MessageIterator::seekNsFromOrigin().
+     *
+     * Same rules as seekBeginning().
+     */
+    void seekNsFromOrigin(std::int64_t nsFromOrigin);
+
     /*
      * Forwards to bt2::MessageIterator::canSeekForward().
      */
@@ -154,6 +225,19 @@ private:
      */
     void _tryGetNewMsgs();
 
+    /*
+     * Releases `*_mMsgStreamOrdinalEntry`, if any, unregistering its
+     * stream if the current message is a stream end message.
+     */
+    void _releaseStreamOrdinalEntry() noexcept
+    {
+        if (_mMsgStreamOrdinalEntry) {
+            _mStreamOrdinals->release(*_mMsgStreamOrdinalEntry,
+                                      _mMsgs.msgs && this->msg().isStreamEnd());
+            _mMsgStreamOrdinalEntry = nullptr;
+        }
+    }
+
     /* Actual upstream message iterator */
     bt2::MessageIterator::Shared _mMsgIter;
 
@@ -172,6 +256,15 @@ private:
     /* Timestamp of the current message, if any */
     bt2s::optional<std::int64_t> _mMsgTs;
 
+    /* Timestamp of the newest message of `_mMsgs.msgs`, if any */
+    bt2s::optional<std::int64_t> _mBatchNewestMsgTs;
+
+    /* Stream ordinal registry (not owned) */
+    StreamOrdinals *_mStreamOrdinals;
+
+    /* Stream ordinal entry of the current message, if any */
+    const StreamOrdinals::Entry *_mMsgStreamOrdinalEntry = nullptr;
+
     /*
      * Only relevant in debug mode: true if a call to discard() is
      * required before calling reload().
@@ -8,10 +8,17 @@
 
 #include "cpp-common/bt2/plugin-dev.hpp"
 
+#include "aggregate/comp.hpp"
+#include "aggregate/msg-iter.hpp"
+#include "columnar/comp.hpp"
 #include "counter/counter.h"
 #include "dummy/dummy.h"
 #include "muxer/comp.hpp"
 #include "muxer/msg-iter.hpp"
+#include "sample/comp.hpp"
+#include "sample/msg-iter.hpp"
+#include "select/comp.hpp"
+#include "select/msg-iter.hpp"
 #include "trimmer/trimmer.h"
 
 #ifndef BT_BUILT_IN_PLUGINS
@@ -45,6 +52,13 @@ BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(counter, "Count messages and print th
 BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(counter,
                                     "See the babeltrace2-sink.utils.counter(7) manual page.");
 
+/* sink.utils.columnar */
+BT_CPP_PLUGIN_SINK_COMPONENT_CLASS(columnar, bt2col::Comp);
+BT_PLUGIN_SINK_COMPONENT_CLASS_DESCRIPTION(
+    columnar, "Write the events of each event class as a table to an Arrow IPC file.");
+BT_PLUGIN_SINK_COMPONENT_CLASS_HELP(columnar,
+                                    "See the babeltrace2-sink.utils.columnar(7) manual page.");
+
 /* flt.utils.trimmer */
 BT_PLUGIN_FILTER_COMPONENT_CLASS(trimmer, trimmer_msg_iter_next);
 BT_PLUGIN_FILTER_COMPONENT_CLASS_GET_SUPPORTED_MIP_VERSIONS_METHOD(trimmer,
@@ -66,3 +80,24 @@ BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
     muxer, "Sort messages from multiple input ports to a single output port by time.");
 BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(muxer,
                                       "See the babeltrace2-filter.utils.muxer(7) manual page.");
+
+/* flt.utils.select */
+BT_CPP_PLUGIN_FILTER_COMPONENT_CLASS(select, bt2sel::Comp);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
+    select, "Discard the event messages which don't satisfy an expression.");
+BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(select,
+                                      "See the babeltrace2-filter.utils.select(7) manual page.");
+
+/* flt.utils.sample */
+BT_CPP_PLUGIN_FILTER_COMPONENT_CLASS(sample, bt2smp::Comp);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
+    sample, "Decimate and rate-limit event messages by event class.");
+BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(sample,
+                                      "See the babeltrace2-filter.utils.sample(7) manual page.");
+
+/* flt.utils.aggregate */
+BT_CPP_PLUGIN_FILTER_COMPONENT_CLASS(aggregate, bt2agg::Comp);
+BT_PLUGIN_FILTER_COMPONENT_CLASS_DESCRIPTION(
+    aggregate, "Summarize event messages as periodic aggregates of their fields.");
+BT_PLUGIN_FILTER_COMPONENT_CLASS_HELP(aggregate,
+                                      "See the babeltrace2-filter.utils.aggregate(7) manual page.");
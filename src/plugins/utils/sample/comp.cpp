@@ -0,0 +1,198 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/common.h"
+
+#include "comp.hpp"
+
+namespace bt2smp {
+namespace {
+
+/* Returns the numeric value of `val`, or `bt2s::nullopt` if it's not a number */
+bt2s::optional<double> numVal(const bt2::ConstValue val) noexcept
+{
+    if (val.isUnsignedInteger()) {
+        return static_cast<double>(val.asUnsignedInteger().value());
+    } else if (val.isSignedInteger()) {
+        return static_cast<double>(val.asSignedInteger().value());
+    } else if (val.isReal()) {
+        return val.asReal().value();
+    }
+
+    return bt2s::nullopt;
+}
+
+/*
+ * Returns the value of `val` if it's a positive integer, or
+ * `bt2s::nullopt` otherwise.
+ */
+bt2s::optional<std::uint64_t> posIntVal(const bt2::ConstValue val) noexcept
+{
+    if (val.isUnsignedInteger() && val.asUnsignedInteger().value() > 0) {
+        return val.asUnsignedInteger().value();
+    } else if (val.isSignedInteger() && val.asSignedInteger().value() > 0) {
+        return static_cast<std::uint64_t>(val.asSignedInteger().value());
+    }
+
+    return bt2s::nullopt;
+}
+
+} /* namespace */
+
+Comp::Comp(const bt2::SelfFilterComponent selfComp, const bt2::ConstMapValue params, void *) :
+    bt2::UserFilterComponent<Comp, MsgIter> {selfComp, "PLUGIN/FLT.UTILS.SAMPLE"}
+{
+    BT_CPPLOGI("Initializing component.");
+
+    auto knownParamCount = 1ULL;
+    const auto rulesVal = params["rules"];
+
+    if (!rulesVal || !rulesVal->isArray() || rulesVal->asArray().isEmpty()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Missing or invalid `rules` parameter: "
+                                          "expecting a non-empty array.");
+    }
+
+    for (std::uint64_t i = 0; i < rulesVal->asArray().length(); ++i) {
+        _mRules.emplace_back(this->_parseRule(rulesVal->asArray()[i], i));
+    }
+
+    if (const auto emitVal = params["emit-discarded-events"]) {
+        if (!emitVal->isBool()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`emit-discarded-events` parameter: expecting a boolean.");
+        }
+
+        _mEmitDiscardedEvents = emitVal->asBool().value();
+        ++knownParamCount;
+    }
+
+    if (params.length() != knownParamCount) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "This component expects no parameters other than "
+                                          "'rules' and 'emit-discarded-events': param-count={}",
+                                          params.length());
+    }
+
+    try {
+        this->_addInputPort("in");
+        this->_addOutputPort("out");
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to add the ports.");
+    }
+
+    BT_CPPLOGI("Initialized component: rule-count={}, emit-discarded-events={}", _mRules.size(),
+               _mEmitDiscardedEvents);
+}
+
+Rule Comp::_parseRule(const bt2::ConstValue ruleVal, const std::uint64_t index) const
+{
+    if (!ruleVal.isMap()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error, "`rules[{}]` parameter: expecting a map.",
+                                          index);
+    }
+
+    const auto ruleMapVal = ruleVal.asMap();
+    auto knownEntryCount = 0ULL;
+    Rule rule;
+
+    if (const auto nameVal = ruleMapVal["name"]) {
+        if (!nameVal->isString()) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`rules[{}].name` parameter: expecting a string.", index);
+        }
+
+        rule.namePattern = nameVal->asString().value().data();
+        ++knownEntryCount;
+    } else {
+        rule.namePattern = "*";
+    }
+
+    bt_common_normalize_star_glob_pattern(&rule.namePattern[0]);
+    rule.namePattern.resize(std::strlen(rule.namePattern.c_str()));
+
+    if (const auto everyVal = ruleMapVal["every"]) {
+        const auto every = posIntVal(*everyVal);
+
+        if (!every) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`rules[{}].every` parameter: expecting a positive integer.", index);
+        }
+
+        rule.every = *every;
+        ++knownEntryCount;
+    }
+
+    if (const auto rateVal = ruleMapVal["rate"]) {
+        const auto rate = numVal(*rateVal);
+
+        if (!rate || !(*rate > 0)) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`rules[{}].rate` parameter: expecting a positive number.", index);
+        }
+
+        rule.rate = *rate;
+
+        /* By default, allow one second worth of events at once */
+        rule.burst = std::max(1.0, *rate);
+        ++knownEntryCount;
+    }
+
+    if (const auto burstVal = ruleMapVal["burst"]) {
+        const auto burst = posIntVal(*burstVal);
+
+        if (!burst) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`rules[{}].burst` parameter: expecting a positive integer.", index);
+        }
+
+        if (!rule.rate) {
+            BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+                bt2c::Error, "`rules[{}].burst` parameter: missing `rate` entry.", index);
+        }
+
+        rule.burst = static_cast<double>(*burst);
+        ++knownEntryCount;
+    }
+
+    if (!ruleMapVal["every"] && !rule.rate) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error, "`rules[{}]` parameter: expecting an `every` or a `rate` entry.", index);
+    }
+
+    if (ruleMapVal.length() != knownEntryCount) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "`rules[{}]` parameter: expecting no entries other "
+                                          "than 'name', 'every', 'rate', and 'burst': "
+                                          "entry-count={}",
+                                          index, ruleMapVal.length());
+    }
+
+    return rule;
+}
+
+const Rule *Comp::rule(const bt2c::CStringView name) const noexcept
+{
+    for (const auto& rule : _mRules) {
+        if (bt_common_star_glob_match(rule.namePattern.data(), rule.namePattern.size(),
+                                      name.data(), name.len())) {
+            return &rule;
+        }
+    }
+
+    return nullptr;
+}
+
+void Comp::_getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue, bt2::LoggingLevel,
+                                    const bt2::UnsignedIntegerRangeSet ranges)
+{
+    ranges.addRange(0, 1);
+}
+
+} /* namespace bt2smp */
@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_SAMPLE_COMP_HPP
+#define BABELTRACE_PLUGINS_UTILS_SAMPLE_COMP_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpp-common/bt2/plugin-dev.hpp"
+#include "cpp-common/bt2c/c-string-view.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "msg-iter.hpp"
+
+namespace bt2smp {
+
+/*
+ * Sampling rule of the event classes of which the name matches
+ * a pattern.
+ */
+struct Rule final
+{
+    /* Normalized star globbing pattern */
+    std::string namePattern;
+
+    /* Keep one event out of `every` */
+    std::uint64_t every = 1;
+
+    /* Maximum number of events per second, if any */
+    bt2s::optional<double> rate;
+
+    /* Maximum number of consecutive events exceeding `rate` */
+    double burst = 1;
+};
+
+class MsgIter;
+
+class Comp final : public bt2::UserFilterComponent<Comp, MsgIter>
+{
+    friend class MsgIter;
+    friend bt2::UserFilterComponent<Comp, MsgIter>;
+
+public:
+    explicit Comp(bt2::SelfFilterComponent selfComp, bt2::ConstMapValue params, void *);
+
+    /*
+     * Returns the first rule matching the event class name `name`, or
+     * `nullptr` if none matches.
+     */
+    const Rule *rule(bt2c::CStringView name) const noexcept;
+
+    /* Value of the `emit-discarded-events` parameter */
+    bool emitDiscardedEvents() const noexcept
+    {
+        return _mEmitDiscardedEvents;
+    }
+
+protected:
+    static void _getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue,
+                                         bt2::LoggingLevel, bt2::UnsignedIntegerRangeSet ranges);
+
+private:
+    /* Parses the rule `ruleVal`, the element at the index `index` of `rules` */
+    Rule _parseRule(bt2::ConstValue ruleVal, std::uint64_t index) const;
+
+    std::vector<Rule> _mRules;
+    bool _mEmitDiscardedEvents = true;
+};
+
+} /* namespace bt2smp */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_SAMPLE_COMP_HPP */
@@ -0,0 +1,287 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <algorithm>
+
+#include <glib.h>
+
+#include "cpp-common/bt2/exc.hpp"
+
+#include "comp.hpp"
+#include "msg-iter.hpp"
+
+namespace bt2smp {
+namespace {
+
+/* Maximum ID of an event class of which the state is in `eventClsStates` */
+constexpr std::uint64_t maxDenseEventClsId = 4095;
+
+} /* namespace */
+
+MsgIter::_StreamClsState::_StreamClsState(const bt2::ConstStreamClass streamClsParam) :
+    streamCls {streamClsParam.shared()},
+    hasDefClkCls {static_cast<bool>(streamClsParam.defaultClockClass())},
+    supportsDiscardedEvents {streamClsParam.supportsDiscardedEvents()},
+    discardedEventsHaveDefClkSnapshots {streamClsParam.supportsDiscardedEvents() &&
+                                        streamClsParam.discardedEventsHaveDefaultClockSnapshots()}
+{
+}
+
+MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
+                 const bt2::SelfMessageIteratorConfiguration cfg, bt2::SelfComponentOutputPort) :
+    bt2::UserMessageIterator<MsgIter, Comp> {selfMsgIter, "MSG-ITER"},
+    _mUpstreamMsgIter {this->_createMessageIterator(this->_component()._inputPorts()["in"])}
+{
+    cfg.canSeekForward(_mUpstreamMsgIter->canSeekForward());
+}
+
+MsgIter::_StreamClsState& MsgIter::_streamClsState(const bt2::ConstStreamClass streamCls)
+{
+    if (G_LIKELY(_mLastStreamClsState &&
+                 _mLastStreamClsState->streamCls->libObjPtr() == streamCls.libObjPtr())) {
+        return *_mLastStreamClsState;
+    }
+
+    auto it = _mStreamClsStates.find(streamCls.libObjPtr());
+
+    if (it == _mStreamClsStates.end()) {
+        it = _mStreamClsStates.emplace(streamCls.libObjPtr(), _StreamClsState {streamCls}).first;
+    }
+
+    /* Element addresses of an `std::unordered_map` never change */
+    _mLastStreamClsState = &it->second;
+    return it->second;
+}
+
+MsgIter::_EventClsState& MsgIter::_eventClsState(_StreamClsState& streamClsState,
+                                                 const bt2::ConstEventClass eventCls)
+{
+    const auto id = eventCls.id();
+    _EventClsState *state;
+
+    if (G_LIKELY(id <= maxDenseEventClsId)) {
+        if (G_UNLIKELY(id >= streamClsState.eventClsStates.size())) {
+            streamClsState.eventClsStates.resize(id + 1);
+        }
+
+        state = &streamClsState.eventClsStates[id];
+    } else {
+        state = &streamClsState.sparseEventClsStates[id];
+    }
+
+    if (G_UNLIKELY(!state->isResolved)) {
+        const auto name = eventCls.name();
+
+        state->isResolved = true;
+        state->rule = this->_component().rule(name ? name : bt2c::CStringView {""});
+
+        if (state->rule) {
+            /* Start with a full bucket */
+            state->tokens = state->rule->burst;
+        }
+
+        BT_CPPLOGD("Resolved the sampling rule of an event class: "
+                   "event-class-id={}, event-class-name={}, rule-name-pattern={}",
+                   id, name ? name.data() : "",
+                   state->rule ? state->rule->namePattern.c_str() : "(none)");
+    }
+
+    return *state;
+}
+
+bool MsgIter::_mustDrop(const bt2::ConstEventMessage msg, _StreamClsState& streamClsState)
+{
+    auto& state = this->_eventClsState(streamClsState, msg.event().cls());
+
+    if (!state.rule) {
+        /* No rule: keep all the events */
+        return false;
+    }
+
+    const auto& rule = *state.rule;
+
+    if (rule.every > 1) {
+        const auto keep = state.count % rule.every == 0;
+
+        ++state.count;
+
+        if (!keep) {
+            return true;
+        }
+    }
+
+    if (!rule.rate || !streamClsState.hasDefClkCls) {
+        /* No rate limit, or no time to apply it */
+        return false;
+    }
+
+    std::int64_t ns;
+
+    try {
+        ns = msg.defaultClockSnapshot().nsFromOrigin();
+    } catch (const bt2::OverflowError&) {
+        return false;
+    }
+
+    /* Refill the bucket according to the elapsed time */
+    if (state.lastNs && ns > *state.lastNs) {
+        const auto elapsedNs = static_cast<double>(ns) - static_cast<double>(*state.lastNs);
+
+        state.tokens = std::min(rule.burst, state.tokens + elapsedNs * *rule.rate / 1e9);
+    }
+
+    if (!state.lastNs || ns > *state.lastNs) {
+        state.lastNs = ns;
+    }
+
+    if (state.tokens < 1) {
+        return true;
+    }
+
+    state.tokens -= 1;
+    return false;
+}
+
+void MsgIter::_addDrop(const bt2::ConstEventMessage msg, const _StreamClsState& streamClsState,
+                       bt2::ConstMessageArray& msgs)
+{
+    if (!this->_component().emitDiscardedEvents() || !streamClsState.supportsDiscardedEvents) {
+        /* Drop silently */
+        return;
+    }
+
+    const auto stream = msg.event().stream();
+
+    if (_mPendingDrops.count > 0 && _mPendingDrops.stream->libObjPtr() != stream.libObjPtr()) {
+        /*
+         * One stream at a time: the time range of a discarded events
+         * message may not overlap the one of the previous message.
+         */
+        msgs.append(this->_takePendingDrops());
+    }
+
+    if (_mPendingDrops.count == 0) {
+        _mPendingDrops.stream = stream.shared();
+
+        if (streamClsState.discardedEventsHaveDefClkSnapshots) {
+            _mPendingDrops.beginClkVal = msg.defaultClockSnapshot().value();
+        }
+    }
+
+    ++_mPendingDrops.count;
+
+    if (streamClsState.discardedEventsHaveDefClkSnapshots) {
+        _mPendingDrops.endClkVal = msg.defaultClockSnapshot().value();
+    }
+}
+
+bt2::ConstMessage::Shared MsgIter::_takePendingDrops()
+{
+    BT_ASSERT_DBG(_mPendingDrops.count > 0);
+
+    auto msg = _mPendingDrops.beginClkVal ?
+                   this->_createDiscardedEventsMessage(*_mPendingDrops.stream,
+                                                       *_mPendingDrops.beginClkVal,
+                                                       *_mPendingDrops.endClkVal) :
+                   this->_createDiscardedEventsMessage(*_mPendingDrops.stream);
+
+    msg->count(_mPendingDrops.count);
+    _mPendingDrops = _PendingDrops {};
+    return bt2::ConstMessage::Shared {std::move(msg)};
+}
+
+void MsgIter::_next(bt2::ConstMessageArray& msgs)
+{
+    /*
+     * Keep on consuming upstream messages until at least one of them
+     * passes so that we never return an empty array before the upstream
+     * message iterator ends.
+     */
+    while (msgs.isEmpty()) {
+        if (!_mUpstreamMsgs) {
+            /* This may throw `bt2::TryAgain` */
+            _mUpstreamMsgs = _mUpstreamMsgIter->next();
+            _mUpstreamMsgIndex = 0;
+
+            if (!_mUpstreamMsgs) {
+                /* Ended (the stream end messages flushed the pending drops) */
+                BT_ASSERT_DBG(_mPendingDrops.count == 0);
+                return;
+            }
+        }
+
+        while (_mUpstreamMsgIndex < _mUpstreamMsgs->length() && !msgs.isFull()) {
+            if (!_mCurMsgIsKept) {
+                const auto msg = (*_mUpstreamMsgs)[_mUpstreamMsgIndex];
+
+                if (msg.isEvent()) {
+                    const auto eventMsg = msg.asEvent();
+                    auto& streamClsState = this->_streamClsState(eventMsg.event().stream().cls());
+
+                    if (this->_mustDrop(eventMsg, streamClsState)) {
+                        this->_addDrop(eventMsg, streamClsState, msgs);
+                        ++_mUpstreamMsgIndex;
+                        continue;
+                    }
+                }
+            }
+
+            if (_mPendingDrops.count > 0) {
+                /*
+                 * Report the pending drops before any message which we
+                 * keep: this is where their time range ends.
+                 */
+                msgs.append(this->_takePendingDrops());
+                _mCurMsgIsKept = true;
+                continue;
+            }
+
+            /* Forward without any reference count change */
+            _mCurMsgIsKept = false;
+            msgs.append(_mUpstreamMsgs->take(_mUpstreamMsgIndex));
+            ++_mUpstreamMsgIndex;
+        }
+
+        if (_mUpstreamMsgIndex == _mUpstreamMsgs->length()) {
+            _mUpstreamMsgs.reset();
+            _mUpstreamMsgIndex = 0;
+        }
+    }
+}
+
+void MsgIter::_reset() noexcept
+{
+    _mUpstreamMsgs.reset();
+    _mUpstreamMsgIndex = 0;
+    _mCurMsgIsKept = false;
+    _mStreamClsStates.clear();
+    _mLastStreamClsState = nullptr;
+    _mPendingDrops = _PendingDrops {};
+}
+
+bool MsgIter::_canSeekBeginning()
+{
+    return _mUpstreamMsgIter->canSeekBeginning();
+}
+
+void MsgIter::_seekBeginning()
+{
+    this->_reset();
+    _mUpstreamMsgIter->seekBeginning();
+}
+
+bool MsgIter::_canSeekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    return _mUpstreamMsgIter->canSeekNsFromOrigin(nsFromOrigin);
+}
+
+void MsgIter::_seekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    this->_reset();
+    _mUpstreamMsgIter->seekNsFromOrigin(nsFromOrigin);
+}
+
+} /* namespace bt2smp */
@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_SAMPLE_MSG_ITER_HPP
+#define BABELTRACE_PLUGINS_UTILS_SAMPLE_MSG_ITER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "cpp-common/bt2/component-class-dev.hpp"
+#include "cpp-common/bt2/self-message-iterator-configuration.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+namespace bt2smp {
+
+class Comp;
+struct Rule;
+
+class MsgIter final : public bt2::UserMessageIterator<MsgIter, Comp>
+{
+    friend bt2::UserMessageIterator<MsgIter, Comp>;
+
+private:
+    /* Sampling state of a given event class */
+    struct _EventClsState final
+    {
+        bool isResolved = false;
+
+        /* Rule of the event class, or `nullptr` to keep all its events */
+        const Rule *rule = nullptr;
+
+        /* Number of events so far, for `Rule::every` */
+        std::uint64_t count = 0;
+
+        /* Token bucket, for `Rule::rate` */
+        double tokens = 0;
+        bt2s::optional<std::int64_t> lastNs;
+    };
+
+    /* Sampling states of the event classes of a given stream class */
+    struct _StreamClsState final
+    {
+        explicit _StreamClsState(bt2::ConstStreamClass streamCls);
+
+        /* Keeps the stream class, and therefore its address, alive */
+        bt2::ConstStreamClass::Shared streamCls;
+
+        bool hasDefClkCls;
+        bool supportsDiscardedEvents;
+        bool discardedEventsHaveDefClkSnapshots;
+
+        /* Event class states, indexed by event class ID */
+        std::vector<_EventClsState> eventClsStates;
+
+        /*
+         * Event class states of which the ID is too large for
+         * `eventClsStates`, by event class ID.
+         */
+        std::unordered_map<std::uint64_t, _EventClsState> sparseEventClsStates;
+    };
+
+    /*
+     * Events which this message iterator dropped from a given stream
+     * since it last returned a message.
+     */
+    struct _PendingDrops final
+    {
+        bt2::ConstStream::Shared stream;
+        std::uint64_t count = 0;
+
+        /* Default clock snapshots of the first and last dropped events */
+        bt2s::optional<std::uint64_t> beginClkVal;
+        bt2s::optional<std::uint64_t> endClkVal;
+    };
+
+public:
+    explicit MsgIter(bt2::SelfMessageIterator selfMsgIter,
+                     bt2::SelfMessageIteratorConfiguration config,
+                     bt2::SelfComponentOutputPort selfPort);
+
+private:
+    bool _canSeekBeginning();
+    void _seekBeginning();
+    bool _canSeekNsFromOrigin(std::int64_t nsFromOrigin);
+    void _seekNsFromOrigin(std::int64_t nsFromOrigin);
+    void _next(bt2::ConstMessageArray& msgs);
+
+    /* Returns the state of `streamCls`, creating it first if needed */
+    _StreamClsState& _streamClsState(bt2::ConstStreamClass streamCls);
+
+    /* Returns the state of `eventCls`, resolving its rule first if needed */
+    _EventClsState& _eventClsState(_StreamClsState& streamClsState,
+                                   bt2::ConstEventClass eventCls);
+
+    /*
+     * Returns whether or not to drop `msg`, updating the counters of its
+     * event class.
+     */
+    bool _mustDrop(bt2::ConstEventMessage msg, _StreamClsState& streamClsState);
+
+    /*
+     * Adds the dropped event message `msg` to the pending drops,
+     * possibly appending a discarded events message for another
+     * stream to `msgs` first.
+     */
+    void _addDrop(bt2::ConstEventMessage msg, const _StreamClsState& streamClsState,
+                  bt2::ConstMessageArray& msgs);
+
+    /* Creates a discarded events message from the pending drops and resets them */
+    bt2::ConstMessage::Shared _takePendingDrops();
+
+    /* Forgets the remaining upstream messages and all the sampling states */
+    void _reset() noexcept;
+
+    bt2::MessageIterator::Shared _mUpstreamMsgIter;
+
+    /*
+     * Current upstream messages and index of the next one to handle
+     * within them.
+     */
+    bt2s::optional<bt2::ConstMessageArray> _mUpstreamMsgs;
+    std::uint64_t _mUpstreamMsgIndex = 0;
+
+    /*
+     * Whether or not this message iterator already decided to keep the
+     * upstream message at `_mUpstreamMsgIndex`, but had to return a
+     * discarded events message first.
+     */
+    bool _mCurMsgIsKept = false;
+
+    /* Stream class states, keyed by stream class */
+    std::unordered_map<const bt_stream_class *, _StreamClsState> _mStreamClsStates;
+
+    /* Last stream class state which _streamClsState() returned */
+    _StreamClsState *_mLastStreamClsState = nullptr;
+
+    _PendingDrops _mPendingDrops;
+};
+
+} /* namespace bt2smp */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_SAMPLE_MSG_ITER_HPP */
@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include "comp.hpp"
+
+namespace bt2sel {
+
+Comp::Comp(const bt2::SelfFilterComponent selfComp, const bt2::ConstMapValue params, void *) :
+    bt2::UserFilterComponent<Comp, MsgIter> {selfComp, "PLUGIN/FLT.UTILS.SELECT"}
+{
+    BT_CPPLOGI("Initializing component.");
+
+    const auto exprVal = params["expression"];
+
+    if (!exprVal || !exprVal->isString()) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Missing or invalid `expression` parameter: "
+                                          "expecting a string.");
+    }
+
+    if (params.length() != 1) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(
+            bt2c::Error,
+            "This component expects no parameters other than 'expression': param-count={}",
+            params.length());
+    }
+
+    try {
+        _mExpr = parseExpr(exprVal->asString().value(), _mLogger);
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Invalid `expression` parameter.");
+    }
+
+    try {
+        this->_addInputPort("in");
+        this->_addOutputPort("out");
+    } catch (const bt2c::Error&) {
+        BT_CPPLOGE_APPEND_CAUSE_AND_RETHROW("Failed to add the ports.");
+    }
+
+    BT_CPPLOGI("Initialized component.");
+}
+
+void Comp::_getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue, bt2::LoggingLevel,
+                                    const bt2::UnsignedIntegerRangeSet ranges)
+{
+    ranges.addRange(0, 1);
+}
+
+} /* namespace bt2sel */
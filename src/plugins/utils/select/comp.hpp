@@ -0,0 +1,43 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_SELECT_COMP_HPP
+#define BABELTRACE_PLUGINS_UTILS_SELECT_COMP_HPP
+
+#include "cpp-common/bt2/plugin-dev.hpp"
+
+#include "expr.hpp"
+#include "msg-iter.hpp"
+
+namespace bt2sel {
+
+class MsgIter;
+
+class Comp final : public bt2::UserFilterComponent<Comp, MsgIter>
+{
+    friend class MsgIter;
+    friend bt2::UserFilterComponent<Comp, MsgIter>;
+
+public:
+    explicit Comp(bt2::SelfFilterComponent selfComp, bt2::ConstMapValue params, void *);
+
+    /* Parsed value of the `expression` parameter */
+    const Expr& expr() const noexcept
+    {
+        return *_mExpr;
+    }
+
+protected:
+    static void _getSupportedMipVersions(bt2::SelfComponentClass, bt2::ConstValue,
+                                         bt2::LoggingLevel, bt2::UnsignedIntegerRangeSet ranges);
+
+private:
+    Expr::UP _mExpr;
+};
+
+} /* namespace bt2sel */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_SELECT_COMP_HPP */
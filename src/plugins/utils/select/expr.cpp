@@ -0,0 +1,736 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/assert.h"
+#include "common/common.h"
+#include "cpp-common/bt2c/exc.hpp"
+#include "cpp-common/bt2s/make-unique.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "expr.hpp"
+
+namespace bt2sel {
+namespace {
+
+/*
+ * Recursive descent parser of an expression (see the grammar in
+ * `expr.hpp`).
+ */
+class Parser final
+{
+public:
+    explicit Parser(const bt2c::CStringView str, const bt2c::Logger& parentLogger) :
+        _mLogger {parentLogger, fmt::format("{}/EXPR-PARSER", parentLogger.tag())}, _mStr {str}
+    {
+    }
+
+    Expr::UP parse()
+    {
+        auto expr = this->_parseOr();
+
+        this->_skipWs();
+
+        if (_mAt != _mStr.len()) {
+            this->_throwError("expecting `&&`, `||`, or the end of the expression");
+        }
+
+        return expr;
+    }
+
+private:
+    [[noreturn]] void _throwError(const char * const msg) const
+    {
+        BT_CPPLOGE_APPEND_CAUSE_AND_THROW(bt2c::Error,
+                                          "Invalid expression at offset {}: {}: expr=\"{}\"", _mAt,
+                                          msg, _mStr.data());
+    }
+
+    void _skipWs() noexcept
+    {
+        while (_mAt < _mStr.len() && std::strchr(" \t\n\r", _mStr[_mAt])) {
+            ++_mAt;
+        }
+    }
+
+    /*
+     * Skips whitespaces and then consumes `token` if it's next,
+     * returning whether or not it did.
+     */
+    bool _tryConsume(const char * const token) noexcept
+    {
+        const auto len = std::strlen(token);
+
+        this->_skipWs();
+
+        if (_mStr.len() - _mAt >= len && std::strncmp(_mStr.data() + _mAt, token, len) == 0) {
+            _mAt += len;
+            return true;
+        }
+
+        return false;
+    }
+
+    static bool _isIdentFirstChar(const char ch) noexcept
+    {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+    }
+
+    static bool _isIdentChar(const char ch) noexcept
+    {
+        return _isIdentFirstChar(ch) || (ch >= '0' && ch <= '9');
+    }
+
+    /*
+     * Skips whitespaces and then consumes an identifier, returning an
+     * empty string if there's none.
+     */
+    std::string _tryConsumeIdent()
+    {
+        this->_skipWs();
+
+        const auto begin = _mAt;
+
+        if (_mAt < _mStr.len() && _isIdentFirstChar(_mStr[_mAt])) {
+            while (_mAt < _mStr.len() && _isIdentChar(_mStr[_mAt])) {
+                ++_mAt;
+            }
+        }
+
+        return std::string {_mStr.data() + begin, _mAt - begin};
+    }
+
+    std::string _consumeIdent()
+    {
+        auto ident = this->_tryConsumeIdent();
+
+        if (ident.empty()) {
+            this->_throwError("expecting a member name");
+        }
+
+        return ident;
+    }
+
+    Expr::UP _parseOr()
+    {
+        auto expr = this->_parseAnd();
+
+        if (!this->_tryConsume("||")) {
+            return expr;
+        }
+
+        auto orExpr = bt2s::make_unique<Expr>();
+
+        orExpr->kind = Expr::Kind::Or;
+        orExpr->operands.emplace_back(std::move(expr));
+
+        do {
+            orExpr->operands.emplace_back(this->_parseAnd());
+        } while (this->_tryConsume("||"));
+
+        return orExpr;
+    }
+
+    Expr::UP _parseAnd()
+    {
+        auto expr = this->_parseNot();
+
+        if (!this->_tryConsume("&&")) {
+            return expr;
+        }
+
+        auto andExpr = bt2s::make_unique<Expr>();
+
+        andExpr->kind = Expr::Kind::And;
+        andExpr->operands.emplace_back(std::move(expr));
+
+        do {
+            andExpr->operands.emplace_back(this->_parseNot());
+        } while (this->_tryConsume("&&"));
+
+        return andExpr;
+    }
+
+    Expr::UP _parseNot()
+    {
+        if (this->_tryConsume("!")) {
+            auto notExpr = bt2s::make_unique<Expr>();
+
+            notExpr->kind = Expr::Kind::Not;
+            notExpr->operands.emplace_back(this->_parseNot());
+            return notExpr;
+        }
+
+        if (this->_tryConsume("(")) {
+            auto expr = this->_parseOr();
+
+            if (!this->_tryConsume(")")) {
+                this->_throwError("expecting `)`");
+            }
+
+            return expr;
+        }
+
+        return this->_parseCmp();
+    }
+
+    Expr::UP _parseCmp()
+    {
+        auto expr = bt2s::make_unique<Expr>();
+
+        this->_skipWs();
+
+        if (_mAt < _mStr.len() && _mStr[_mAt] == '$') {
+            ++_mAt;
+
+            const auto scopeName = this->_tryConsumeIdent();
+
+            if (scopeName == "name") {
+                expr->kind = Expr::Kind::EventClassNameCmp;
+                expr->op = this->_parseCmpOp();
+
+                if (expr->op != CmpOp::Eq && expr->op != CmpOp::Ne) {
+                    this->_throwError("expecting `==` or `!=` after `$name`");
+                }
+
+                expr->literal = this->_parseLiteral();
+
+                if (expr->literal.type != Literal::Type::Str) {
+                    this->_throwError("expecting a string literal after `$name ==` or `$name !=`");
+                }
+
+                return expr;
+            }
+
+            if (scopeName == "payload") {
+                expr->scope = Scope::Payload;
+            } else if (scopeName == "specific_ctx") {
+                expr->scope = Scope::SpecificContext;
+            } else if (scopeName == "common_ctx") {
+                expr->scope = Scope::CommonContext;
+            } else {
+                this->_throwError(
+                    "expecting `$name`, `$payload`, `$specific_ctx`, or `$common_ctx`");
+            }
+
+            if (!this->_tryConsume(".")) {
+                this->_throwError("expecting `.` after the scope");
+            }
+        }
+
+        expr->kind = Expr::Kind::FieldCmp;
+        expr->memberNames.emplace_back(this->_consumeIdent());
+
+        while (this->_tryConsume(".")) {
+            expr->memberNames.emplace_back(this->_consumeIdent());
+        }
+
+        expr->op = this->_parseCmpOp();
+        expr->literal = this->_parseLiteral();
+        return expr;
+    }
+
+    CmpOp _parseCmpOp()
+    {
+        if (this->_tryConsume("==")) {
+            return CmpOp::Eq;
+        } else if (this->_tryConsume("!=")) {
+            return CmpOp::Ne;
+        } else if (this->_tryConsume("<=")) {
+            return CmpOp::Le;
+        } else if (this->_tryConsume("<")) {
+            return CmpOp::Lt;
+        } else if (this->_tryConsume(">=")) {
+            return CmpOp::Ge;
+        } else if (this->_tryConsume(">")) {
+            return CmpOp::Gt;
+        }
+
+        this->_throwError("expecting a comparison operator");
+    }
+
+    Literal _parseLiteral()
+    {
+        Literal literal;
+
+        this->_skipWs();
+
+        if (_mAt == _mStr.len()) {
+            this->_throwError("expecting a literal");
+        }
+
+        if (_mStr[_mAt] == '"') {
+            literal.type = Literal::Type::Str;
+            literal.strVal = this->_parseStrLiteral();
+            return literal;
+        }
+
+        if (this->_tryConsume("true")) {
+            literal.type = Literal::Type::Bool;
+            literal.boolVal = true;
+            return literal;
+        } else if (this->_tryConsume("false")) {
+            literal.type = Literal::Type::Bool;
+            literal.boolVal = false;
+            return literal;
+        }
+
+        return this->_parseNumberLiteral();
+    }
+
+    /*
+     * Parses a string literal, keeping any escape sequence other than
+     * `\"` as is so that `\*` remains a literal asterisk for star
+     * globbing.
+     */
+    std::string _parseStrLiteral()
+    {
+        std::string str;
+
+        BT_ASSERT(_mStr[_mAt] == '"');
+        ++_mAt;
+
+        while (true) {
+            if (_mAt == _mStr.len()) {
+                this->_throwError("unterminated string literal");
+            }
+
+            const auto ch = _mStr[_mAt];
+
+            ++_mAt;
+
+            if (ch == '"') {
+                break;
+            }
+
+            if (ch == '\\' && _mAt < _mStr.len()) {
+                if (_mStr[_mAt] != '"') {
+                    str += ch;
+                }
+
+                str += _mStr[_mAt];
+                ++_mAt;
+                continue;
+            }
+
+            str += ch;
+        }
+
+        /* Normalize as a star globbing pattern */
+        bt_common_normalize_star_glob_pattern(&str[0]);
+        str.resize(std::strlen(str.c_str()));
+        return str;
+    }
+
+    Literal _parseNumberLiteral()
+    {
+        Literal literal;
+        const auto begin = _mStr.data() + _mAt;
+        const auto isNeg = *begin == '-';
+        char *end;
+
+        /* Real literal? */
+        {
+            const auto intEnd = begin + std::strspn(begin, "-+0123456789");
+
+            if (*intEnd == '.' || *intEnd == 'e' || *intEnd == 'E') {
+                errno = 0;
+                literal.type = Literal::Type::Real;
+                literal.realVal = std::strtod(begin, &end);
+
+                if (end == begin || errno == ERANGE) {
+                    this->_throwError("invalid real number literal");
+                }
+
+                _mAt += end - begin;
+                return literal;
+            }
+        }
+
+        /* Integer literal (decimal or hexadecimal) */
+        const auto absBegin = isNeg ? begin + 1 : begin;
+
+        if (*absBegin < '0' || *absBegin > '9') {
+            this->_throwError("expecting a literal");
+        }
+
+        errno = 0;
+
+        const auto isHex = absBegin[0] == '0' && (absBegin[1] == 'x' || absBegin[1] == 'X');
+        const auto absVal = std::strtoull(absBegin, &end, isHex ? 16 : 10);
+
+        if (errno == ERANGE || (isNeg && absVal > static_cast<std::uint64_t>(INT64_MAX) + 1)) {
+            this->_throwError("integer literal is out of range");
+        }
+
+        _mAt += end - begin;
+
+        if (_mAt < _mStr.len() && _isIdentChar(_mStr[_mAt])) {
+            this->_throwError("invalid integer literal");
+        }
+
+        if (isNeg && absVal != 0) {
+            literal.type = Literal::Type::SInt;
+            literal.sIntVal = absVal == static_cast<std::uint64_t>(INT64_MAX) + 1 ?
+                                  INT64_MIN :
+                                  -static_cast<std::int64_t>(absVal);
+        } else {
+            literal.type = Literal::Type::UInt;
+            literal.uIntVal = absVal;
+        }
+
+        return literal;
+    }
+
+    bt2c::Logger _mLogger;
+    bt2c::CStringView _mStr;
+    std::size_t _mAt = 0;
+};
+
+/*
+ * Returns -1, 0, or 1 depending on whether `a` is less than, equal to,
+ * or greater than `b`.
+ */
+template <typename ValT>
+int cmpVals(const ValT a, const ValT b) noexcept
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+bool cmpResult(const CmpOp op, const int res) noexcept
+{
+    switch (op) {
+    case CmpOp::Eq:
+        return res == 0;
+    case CmpOp::Ne:
+        return res != 0;
+    case CmpOp::Lt:
+        return res < 0;
+    case CmpOp::Le:
+        return res <= 0;
+    case CmpOp::Gt:
+        return res > 0;
+    case CmpOp::Ge:
+        return res >= 0;
+    }
+
+    bt_common_abort();
+}
+
+bool cmpUInt(const std::uint64_t val, const CmpOp op, const Literal& literal) noexcept
+{
+    switch (literal.type) {
+    case Literal::Type::UInt:
+        return cmpResult(op, cmpVals(val, literal.uIntVal));
+    case Literal::Type::SInt:
+        /* Negative literal */
+        return cmpResult(op, 1);
+    case Literal::Type::Real:
+        return cmpResult(op, cmpVals(static_cast<double>(val), literal.realVal));
+    default:
+        bt_common_abort();
+    }
+}
+
+bool cmpSInt(const std::int64_t val, const CmpOp op, const Literal& literal) noexcept
+{
+    switch (literal.type) {
+    case Literal::Type::UInt:
+        if (val < 0) {
+            return cmpResult(op, -1);
+        }
+
+        return cmpResult(op, cmpVals(static_cast<std::uint64_t>(val), literal.uIntVal));
+    case Literal::Type::SInt:
+        return cmpResult(op, cmpVals(val, literal.sIntVal));
+    case Literal::Type::Real:
+        return cmpResult(op, cmpVals(static_cast<double>(val), literal.realVal));
+    default:
+        bt_common_abort();
+    }
+}
+
+bool cmpReal(const double val, const CmpOp op, const Literal& literal) noexcept
+{
+    if (std::isnan(val)) {
+        /* Not a number is unordered */
+        return op == CmpOp::Ne;
+    }
+
+    switch (literal.type) {
+    case Literal::Type::UInt:
+        return cmpResult(op, cmpVals(val, static_cast<double>(literal.uIntVal)));
+    case Literal::Type::SInt:
+        return cmpResult(op, cmpVals(val, static_cast<double>(literal.sIntVal)));
+    case Literal::Type::Real:
+        return cmpResult(op, cmpVals(val, literal.realVal));
+    default:
+        bt_common_abort();
+    }
+}
+
+bool cmpStr(const bt2c::CStringView val, const CmpOp op, const Literal& literal) noexcept
+{
+    BT_ASSERT_DBG(literal.type == Literal::Type::Str);
+
+    if (op == CmpOp::Eq || op == CmpOp::Ne) {
+        const auto matches = bt_common_star_glob_match(literal.strVal.data(), literal.strVal.size(),
+                                                       val.data(), val.len());
+
+        return op == CmpOp::Eq ? matches : !matches;
+    }
+
+    return cmpResult(op, std::strcmp(val.data(), literal.strVal.c_str()));
+}
+
+} /* namespace */
+
+Expr::UP parseExpr(const bt2c::CStringView str, const bt2c::Logger& parentLogger)
+{
+    return Parser {str, parentLogger}.parse();
+}
+
+Predicate::Predicate(const Expr& expr, const bt2::ConstEventClass eventCls) :
+    _mRoot {_compile(expr, eventCls)}
+{
+}
+
+Predicate::_Node Predicate::_constNode(const bool val)
+{
+    _Node node;
+
+    node.kind = _Node::Kind::Const;
+    node.constVal = val;
+    return node;
+}
+
+Predicate::_Node Predicate::_compile(const Expr& expr, const bt2::ConstEventClass eventCls)
+{
+    switch (expr.kind) {
+    case Expr::Kind::Or:
+    case Expr::Kind::And:
+    {
+        /* Value of an operand which determines the result */
+        const auto decisiveVal = expr.kind == Expr::Kind::Or;
+        _Node node;
+
+        node.kind = expr.kind == Expr::Kind::Or ? _Node::Kind::Or : _Node::Kind::And;
+
+        for (const auto& operand : expr.operands) {
+            auto operandNode = _compile(*operand, eventCls);
+
+            if (operandNode.kind == _Node::Kind::Const) {
+                if (operandNode.constVal == decisiveVal) {
+                    return _constNode(decisiveVal);
+                }
+
+                /* Neutral operand */
+                continue;
+            }
+
+            node.operands.emplace_back(std::move(operandNode));
+        }
+
+        if (node.operands.empty()) {
+            return _constNode(!decisiveVal);
+        } else if (node.operands.size() == 1) {
+            return std::move(node.operands.front());
+        }
+
+        return node;
+    }
+    case Expr::Kind::Not:
+    {
+        auto operandNode = _compile(*expr.operands.front(), eventCls);
+
+        if (operandNode.kind == _Node::Kind::Const) {
+            return _constNode(!operandNode.constVal);
+        }
+
+        _Node node;
+
+        node.kind = _Node::Kind::Not;
+        node.operands.emplace_back(std::move(operandNode));
+        return node;
+    }
+    case Expr::Kind::EventClassNameCmp:
+    {
+        const auto name = eventCls.name();
+
+        if (!name) {
+            return _constNode(false);
+        }
+
+        return _constNode(cmpStr(name, expr.op, expr.literal));
+    }
+    case Expr::Kind::FieldCmp:
+        return _compileFieldCmp(expr, eventCls);
+    }
+
+    bt_common_abort();
+}
+
+Predicate::_Node Predicate::_compileFieldCmp(const Expr& expr, const bt2::ConstEventClass eventCls)
+{
+    bt2::OptionalBorrowedObject<bt2::ConstStructureFieldClass> rootFc;
+
+    switch (expr.scope) {
+    case Scope::Payload:
+        rootFc = eventCls.payloadFieldClass();
+        break;
+    case Scope::SpecificContext:
+        rootFc = eventCls.specificContextFieldClass();
+        break;
+    case Scope::CommonContext:
+        rootFc = eventCls.streamClass().commonEventContextFieldClass();
+        break;
+    }
+
+    if (!rootFc) {
+        /* No such field: always false */
+        return _constNode(false);
+    }
+
+    _Node node;
+
+    node.kind = _Node::Kind::FieldCmp;
+    node.scope = expr.scope;
+    node.op = expr.op;
+    node.literal = &expr.literal;
+
+    /* Resolve the member indexes */
+    bt2::ConstFieldClass fc = *rootFc;
+
+    for (const auto& memberName : expr.memberNames) {
+        if (!fc.isStructure()) {
+            return _constNode(false);
+        }
+
+        const auto structFc = fc.asStructure();
+        bt2s::optional<std::uint64_t> memberIndex;
+
+        for (std::uint64_t i = 0; i < structFc.length(); ++i) {
+            if (std::strcmp(structFc[i].name(), memberName.c_str()) == 0) {
+                memberIndex = i;
+                break;
+            }
+        }
+
+        if (!memberIndex) {
+            return _constNode(false);
+        }
+
+        node.memberIndexes.push_back(*memberIndex);
+        fc = structFc[*memberIndex].fieldClass();
+    }
+
+    /* Check the compatibility of the field and of the literal */
+    const auto litType = expr.literal.type;
+    const auto litIsNumber = litType == Literal::Type::UInt || litType == Literal::Type::SInt ||
+                             litType == Literal::Type::Real;
+
+    if (fc.isBool() && litType == Literal::Type::Bool) {
+        node.fieldType = _Node::FieldType::Bool;
+    } else if (fc.isUnsignedInteger() && litIsNumber) {
+        node.fieldType = _Node::FieldType::UInt;
+    } else if (fc.isSignedInteger() && litIsNumber) {
+        node.fieldType = _Node::FieldType::SInt;
+    } else if (fc.isSinglePrecisionReal() && litIsNumber) {
+        node.fieldType = _Node::FieldType::SinglePrecisionReal;
+    } else if (fc.isDoublePrecisionReal() && litIsNumber) {
+        node.fieldType = _Node::FieldType::DoublePrecisionReal;
+    } else if (fc.isString() && litType == Literal::Type::Str) {
+        node.fieldType = _Node::FieldType::Str;
+    } else {
+        return _constNode(false);
+    }
+
+    return node;
+}
+
+bool Predicate::_eval(const _Node& node, const bt2::ConstEvent event) const noexcept
+{
+    switch (node.kind) {
+    case _Node::Kind::Const:
+        return node.constVal;
+    case _Node::Kind::Or:
+        for (const auto& operand : node.operands) {
+            if (this->_eval(operand, event)) {
+                return true;
+            }
+        }
+
+        return false;
+    case _Node::Kind::And:
+        for (const auto& operand : node.operands) {
+            if (!this->_eval(operand, event)) {
+                return false;
+            }
+        }
+
+        return true;
+    case _Node::Kind::Not:
+        return !this->_eval(node.operands.front(), event);
+    case _Node::Kind::FieldCmp:
+    {
+        bt2::OptionalBorrowedObject<bt2::ConstStructureField> rootField;
+
+        switch (node.scope) {
+        case Scope::Payload:
+            rootField = event.payloadField();
+            break;
+        case Scope::SpecificContext:
+            rootField = event.specificContextField();
+            break;
+        case Scope::CommonContext:
+            rootField = event.commonContextField();
+            break;
+        }
+
+        BT_ASSERT_DBG(rootField);
+
+        bt2::ConstField field = *rootField;
+
+        for (const auto index : node.memberIndexes) {
+            field = field.asStructure()[index];
+        }
+
+        return _evalFieldCmp(node, field);
+    }
+    }
+
+    bt_common_abort();
+}
+
+bool Predicate::_evalFieldCmp(const _Node& node, const bt2::ConstField field) noexcept
+{
+    const auto& literal = *node.literal;
+
+    switch (node.fieldType) {
+    case _Node::FieldType::Bool:
+        return cmpResult(node.op, cmpVals(static_cast<int>(field.asBool().value()),
+                                          static_cast<int>(literal.boolVal)));
+    case _Node::FieldType::UInt:
+        return cmpUInt(field.asUnsignedInteger().value(), node.op, literal);
+    case _Node::FieldType::SInt:
+        return cmpSInt(field.asSignedInteger().value(), node.op, literal);
+    case _Node::FieldType::SinglePrecisionReal:
+        return cmpReal(field.asSinglePrecisionReal().value(), node.op, literal);
+    case _Node::FieldType::DoublePrecisionReal:
+        return cmpReal(field.asDoublePrecisionReal().value(), node.op, literal);
+    case _Node::FieldType::Str:
+        return cmpStr(field.asString().value(), node.op, literal);
+    }
+
+    bt_common_abort();
+}
+
+} /* namespace bt2sel */
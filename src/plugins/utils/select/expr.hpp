@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_SELECT_EXPR_HPP
+#define BABELTRACE_PLUGINS_UTILS_SELECT_EXPR_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpp-common/bt2/trace-ir.hpp"
+#include "cpp-common/bt2c/c-string-view.hpp"
+#include "cpp-common/bt2c/logging.hpp"
+
+namespace bt2sel {
+
+/* Comparison operator */
+enum class CmpOp
+{
+    Eq,
+    Ne,
+    Lt,
+    Le,
+    Gt,
+    Ge,
+};
+
+/* Root field of a field reference */
+enum class Scope
+{
+    Payload,
+    SpecificContext,
+    CommonContext,
+};
+
+/* Literal operand of a comparison */
+struct Literal final
+{
+    enum class Type
+    {
+        Bool,
+        UInt,
+        SInt,
+        Real,
+        Str,
+    };
+
+    Type type;
+
+    /* Value for the `Type::Bool` type */
+    bool boolVal = false;
+
+    /* Value for the `Type::UInt` type */
+    std::uint64_t uIntVal = 0;
+
+    /* Value for the `Type::SInt` type (always negative) */
+    std::int64_t sIntVal = 0;
+
+    /* Value for the `Type::Real` type */
+    double realVal = 0.;
+
+    /* Normalized star globbing pattern for the `Type::Str` type */
+    std::string strVal;
+};
+
+/*
+ * Parsed expression, independent of any trace class.
+ *
+ * Grammar:
+ *
+ *     expr   = and-expr { "||" and-expr }
+ *     and-expr = not-expr { "&&" not-expr }
+ *     not-expr = "!" not-expr | "(" expr ")" | cmp
+ *     cmp    = "$name" ("==" | "!=") string
+ *            | field-ref cmp-op literal
+ *     field-ref = [scope "."] member-name { "." member-name }
+ *     scope  = "$payload" | "$specific_ctx" | "$common_ctx"
+ *     cmp-op = "==" | "!=" | "<" | "<=" | ">" | ">="
+ *     literal = "true" | "false" | integer | real | string
+ *
+ * A field reference without a scope is relative to the payload field.
+ * A string literal is a star globbing pattern when the operator is
+ * `==` or `!=`.
+ */
+struct Expr final
+{
+    using UP = std::unique_ptr<const Expr>;
+
+    enum class Kind
+    {
+        Or,
+        And,
+        Not,
+        EventClassNameCmp,
+        FieldCmp,
+    };
+
+    Kind kind;
+
+    /* Operands of a `Kind::Or`, `Kind::And`, or `Kind::Not` expression */
+    std::vector<UP> operands;
+
+    /* Operator and literal of a comparison */
+    CmpOp op = CmpOp::Eq;
+    Literal literal;
+
+    /* Field reference of a `Kind::FieldCmp` expression */
+    Scope scope = Scope::Payload;
+    std::vector<std::string> memberNames;
+};
+
+/*
+ * Parses the expression `str`, throwing `bt2c::Error` on error.
+ */
+Expr::UP parseExpr(bt2c::CStringView str, const bt2c::Logger& parentLogger);
+
+/*
+ * Expression compiled against a specific event class: field references
+ * are member indexes and the event class name comparisons, as well as
+ * the comparisons involving missing or incompatible fields (which are
+ * false), are constant.
+ */
+class Predicate final
+{
+public:
+    explicit Predicate(const Expr& expr, bt2::ConstEventClass eventCls);
+
+    /*
+     * Returns whether or not `event`, of which the class is the one of
+     * this predicate, satisfies this predicate.
+     */
+    bool operator()(bt2::ConstEvent event) const noexcept
+    {
+        return this->_eval(_mRoot, event);
+    }
+
+    /*
+     * Whether or not the result of this predicate is constant, in which
+     * case it's constVal().
+     */
+    bool isConst() const noexcept
+    {
+        return _mRoot.kind == _Node::Kind::Const;
+    }
+
+    bool constVal() const noexcept
+    {
+        return _mRoot.constVal;
+    }
+
+private:
+    struct _Node final
+    {
+        enum class Kind
+        {
+            Const,
+            Or,
+            And,
+            Not,
+            FieldCmp,
+        };
+
+        /* Type of the compared field */
+        enum class FieldType
+        {
+            Bool,
+            UInt,
+            SInt,
+            SinglePrecisionReal,
+            DoublePrecisionReal,
+            Str,
+        };
+
+        Kind kind;
+
+        /* Value of a `Kind::Const` node */
+        bool constVal = false;
+
+        /* Operands of a `Kind::Or`, `Kind::And`, or `Kind::Not` node */
+        std::vector<_Node> operands;
+
+        /* Field comparison of a `Kind::FieldCmp` node */
+        Scope scope = Scope::Payload;
+        std::vector<std::uint64_t> memberIndexes;
+        FieldType fieldType = FieldType::Bool;
+        CmpOp op = CmpOp::Eq;
+        const Literal *literal = nullptr;
+    };
+
+    static _Node _compile(const Expr& expr, bt2::ConstEventClass eventCls);
+    static _Node _compileFieldCmp(const Expr& expr, bt2::ConstEventClass eventCls);
+    static _Node _constNode(bool val);
+    bool _eval(const _Node& node, bt2::ConstEvent event) const noexcept;
+    static bool _evalFieldCmp(const _Node& node, bt2::ConstField field) noexcept;
+
+    _Node _mRoot;
+};
+
+} /* namespace bt2sel */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_SELECT_EXPR_HPP */
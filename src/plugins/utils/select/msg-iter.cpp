@@ -0,0 +1,117 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#include "cpp-common/vendor/fmt/format.h"
+
+#include "comp.hpp"
+#include "msg-iter.hpp"
+
+namespace bt2sel {
+
+MsgIter::MsgIter(const bt2::SelfMessageIterator selfMsgIter,
+                 const bt2::SelfMessageIteratorConfiguration cfg, bt2::SelfComponentOutputPort) :
+    bt2::UserMessageIterator<MsgIter, Comp> {selfMsgIter, "MSG-ITER"},
+    _mUpstreamMsgIter {this->_createMessageIterator(this->_component()._inputPorts()["in"])}
+{
+    cfg.canSeekForward(_mUpstreamMsgIter->canSeekForward());
+}
+
+const Predicate& MsgIter::_predicate(const bt2::ConstEventClass eventCls)
+{
+    const auto it = _mPredicates.find(eventCls.libObjPtr());
+
+    if (G_LIKELY(it != _mPredicates.end())) {
+        return it->second.predicate;
+    }
+
+    _PredicateEntry entry {eventCls.shared(), Predicate {this->_component().expr(), eventCls}};
+
+    if (entry.predicate.isConst()) {
+        BT_CPPLOGD("Compiled the expression for an event class: "
+                   "event-class-addr={}, event-class-name={}, const-val={}",
+                   fmt::ptr(eventCls.libObjPtr()), eventCls.name() ? eventCls.name().data() : "",
+                   entry.predicate.constVal());
+    } else {
+        BT_CPPLOGD("Compiled the expression for an event class: "
+                   "event-class-addr={}, event-class-name={}",
+                   fmt::ptr(eventCls.libObjPtr()), eventCls.name() ? eventCls.name().data() : "");
+    }
+
+    return _mPredicates.emplace(eventCls.libObjPtr(), std::move(entry)).first->second.predicate;
+}
+
+void MsgIter::_next(bt2::ConstMessageArray& msgs)
+{
+    /*
+     * Keep on consuming upstream messages until at least one of them
+     * passes so that we never return an empty array before the upstream
+     * message iterator ends.
+     */
+    while (msgs.isEmpty()) {
+        if (!_mUpstreamMsgs) {
+            /* This may throw `bt2::TryAgain` */
+            _mUpstreamMsgs = _mUpstreamMsgIter->next();
+            _mUpstreamMsgIndex = 0;
+
+            if (!_mUpstreamMsgs) {
+                /* Ended */
+                return;
+            }
+        }
+
+        for (; _mUpstreamMsgIndex < _mUpstreamMsgs->length() && !msgs.isFull();
+             ++_mUpstreamMsgIndex) {
+            const auto msg = (*_mUpstreamMsgs)[_mUpstreamMsgIndex];
+
+            if (msg.isEvent()) {
+                const auto event = msg.asEvent().event();
+                const auto& predicate = this->_predicate(event.cls());
+
+                if (!(predicate.isConst() ? predicate.constVal() : predicate(event))) {
+                    /* Drop event message */
+                    continue;
+                }
+            }
+
+            /* Forward without any reference count change */
+            msgs.append(_mUpstreamMsgs->take(_mUpstreamMsgIndex));
+        }
+
+        if (_mUpstreamMsgIndex == _mUpstreamMsgs->length()) {
+            this->_resetUpstreamMsgs();
+        }
+    }
+}
+
+void MsgIter::_resetUpstreamMsgs() noexcept
+{
+    _mUpstreamMsgs.reset();
+    _mUpstreamMsgIndex = 0;
+}
+
+bool MsgIter::_canSeekBeginning()
+{
+    return _mUpstreamMsgIter->canSeekBeginning();
+}
+
+void MsgIter::_seekBeginning()
+{
+    this->_resetUpstreamMsgs();
+    _mUpstreamMsgIter->seekBeginning();
+}
+
+bool MsgIter::_canSeekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    return _mUpstreamMsgIter->canSeekNsFromOrigin(nsFromOrigin);
+}
+
+void MsgIter::_seekNsFromOrigin(const std::int64_t nsFromOrigin)
+{
+    this->_resetUpstreamMsgs();
+    _mUpstreamMsgIter->seekNsFromOrigin(nsFromOrigin);
+}
+
+} /* namespace bt2sel */
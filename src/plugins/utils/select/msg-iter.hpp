@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Copyright 2026 EfficiOS, Inc.
+ */
+
+#ifndef BABELTRACE_PLUGINS_UTILS_SELECT_MSG_ITER_HPP
+#define BABELTRACE_PLUGINS_UTILS_SELECT_MSG_ITER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "cpp-common/bt2/component-class-dev.hpp"
+#include "cpp-common/bt2/self-message-iterator-configuration.hpp"
+#include "cpp-common/bt2s/optional.hpp"
+
+#include "expr.hpp"
+
+namespace bt2sel {
+
+class Comp;
+
+class MsgIter final : public bt2::UserMessageIterator<MsgIter, Comp>
+{
+    friend bt2::UserMessageIterator<MsgIter, Comp>;
+
+private:
+    /* Compiled expression for a given event class */
+    struct _PredicateEntry final
+    {
+        /* Keeps the event class, and therefore its address, alive */
+        bt2::ConstEventClass::Shared eventCls;
+
+        Predicate predicate;
+    };
+
+public:
+    explicit MsgIter(bt2::SelfMessageIterator selfMsgIter,
+                     bt2::SelfMessageIteratorConfiguration config,
+                     bt2::SelfComponentOutputPort selfPort);
+
+private:
+    bool _canSeekBeginning();
+    void _seekBeginning();
+    bool _canSeekNsFromOrigin(std::int64_t nsFromOrigin);
+    void _seekNsFromOrigin(std::int64_t nsFromOrigin);
+    void _next(bt2::ConstMessageArray& msgs);
+
+    /*
+     * Returns the expression compiled against `eventCls`, compiling it
+     * first if needed.
+     */
+    const Predicate& _predicate(bt2::ConstEventClass eventCls);
+
+    /* Discards the remaining upstream messages, if any */
+    void _resetUpstreamMsgs() noexcept;
+
+    bt2::MessageIterator::Shared _mUpstreamMsgIter;
+
+    /*
+     * Current upstream messages and index of the next one to handle
+     * within them.
+     */
+    bt2s::optional<bt2::ConstMessageArray> _mUpstreamMsgs;
+    std::uint64_t _mUpstreamMsgIndex = 0;
+
+    /* Compiled expressions, keyed by event class */
+    std::unordered_map<const bt_event_class *, _PredicateEntry> _mPredicates;
+};
+
+} /* namespace bt2sel */
+
+#endif /* BABELTRACE_PLUGINS_UTILS_SELECT_MSG_ITER_HPP */
@@ -55,8 +55,17 @@ struct trimmer_bound {
 	struct trimmer_time time;
 };
 
-struct trimmer_comp {
+struct trimmer_range {
 	struct trimmer_bound begin, end;
+};
+
+struct trimmer_comp {
+	/*
+	 * Array of `struct trimmer_range`, sorted and disjoint once all
+	 * their bounds are set (see validate_trimmer_ranges()).
+	 */
+	GArray *ranges;
+
 	bool is_gmt;
 	bt_logging_level log_level;
 	bt_self_component *self_comp;
@@ -71,7 +80,15 @@ enum trimmer_iterator_state {
 	TRIMMER_ITERATOR_STATE_SET_BOUNDS_NS_FROM_ORIGIN,
 
 	/*
-	 * Initially seek to the trimming range's beginning time.
+	 * Initially, and between two trimming ranges, seek to the
+	 * beginning time of the current trimming range.
+	 *
+	 * This is where whole packets preceding the trimming range get
+	 * skipped: a native seeking implementation (for example,
+	 * `source.ctf.fs` with its packet index, possibly through
+	 * `filter.utils.muxer`) can start decoding at the first packet
+	 * which doesn't end before the beginning time instead of making
+	 * this iterator inspect each preceding message.
 	 */
 	TRIMMER_ITERATOR_STATE_SEEK_INITIALLY,
 
@@ -99,6 +116,18 @@ struct trimmer_iterator {
 
 	/* Owned by this */
 	bt_message_iterator *upstream_iter;
+
+	/*
+	 * Array of `struct trimmer_range`: copy of the trimming ranges
+	 * of the component of which this iterator sets the missing
+	 * dates.
+	 */
+	GArray *ranges;
+
+	/* Index of the current trimming range within `ranges` */
+	guint cur_range_index;
+
+	/* Bounds of the current trimming range */
 	struct trimmer_bound begin, end;
 
 	/*
@@ -125,6 +154,13 @@ struct trimmer_iterator_stream_state {
 
 	/* Owned by this (`NULL` initially and between packets) */
 	const bt_packet *cur_packet;
+
+	/*
+	 * True if this stream ended within a trimming range which isn't
+	 * the last one: this iterator drops any other message of this
+	 * stream, and `stream` is a strong reference in that case.
+	 */
+	bool is_ended;
 };
 
 bt_component_class_get_supported_mip_versions_method_status
@@ -142,13 +178,32 @@ static
 void destroy_trimmer_comp(struct trimmer_comp *trimmer_comp)
 {
 	BT_ASSERT(trimmer_comp);
+
+	if (trimmer_comp->ranges) {
+		g_array_free(trimmer_comp->ranges, TRUE);
+	}
+
 	g_free(trimmer_comp);
 }
 
 static
 struct trimmer_comp *create_trimmer_comp(void)
 {
-	return g_new0(struct trimmer_comp, 1);
+	struct trimmer_comp *trimmer_comp = g_new0(struct trimmer_comp, 1);
+
+	if (!trimmer_comp) {
+		goto end;
+	}
+
+	trimmer_comp->ranges = g_array_new(FALSE, TRUE,
+		sizeof(struct trimmer_range));
+	if (!trimmer_comp->ranges) {
+		g_free(trimmer_comp);
+		trimmer_comp = NULL;
+	}
+
+end:
+	return trimmer_comp;
 }
 
 void trimmer_finalize(bt_self_component_filter *self_comp)
@@ -505,6 +560,77 @@ end:
 	return ret;
 }
 
+static
+bool trimmer_ranges_are_set(const GArray *ranges)
+{
+	guint i;
+
+	for (i = 0; i < ranges->len; i++) {
+		const struct trimmer_range *range =
+			&g_array_index(ranges, struct trimmer_range, i);
+
+		if (!range->begin.is_set || !range->end.is_set) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Validates each trimming range of `ranges`, as well as their order:
+ * a trimming range must end before the following one begins.
+ *
+ * Only the first trimming range may have an infinite beginning time and
+ * only the last one may have an infinite end time.
+ */
+static
+int validate_trimmer_ranges(struct trimmer_comp *trimmer_comp,
+		GArray *ranges)
+{
+	int ret = 0;
+	guint i;
+
+	for (i = 0; i < ranges->len; i++) {
+		struct trimmer_range *range =
+			&g_array_index(ranges, struct trimmer_range, i);
+		const struct trimmer_range *prev_range;
+
+		/* validate_trimmer_bounds() logs errors */
+		ret = validate_trimmer_bounds(trimmer_comp, &range->begin,
+			&range->end);
+		if (ret) {
+			goto end;
+		}
+
+		if (i == 0) {
+			continue;
+		}
+
+		prev_range = &g_array_index(ranges, struct trimmer_range, i - 1);
+
+		if (prev_range->end.is_infinite || range->begin.is_infinite ||
+				prev_range->end.ns_from_origin >=
+					range->begin.ns_from_origin) {
+			BT_COMP_LOGE_APPEND_CAUSE(trimmer_comp->self_comp,
+				"Trimming time range doesn't begin after the end of the previous one: "
+				"index=%u, "
+				"begin-ns-from-origin=%" PRId64 ", "
+				"prev-end-ns-from-origin=%" PRId64,
+				i,
+				range->begin.is_infinite ? INT64_MIN :
+					range->begin.ns_from_origin,
+				prev_range->end.is_infinite ? INT64_MAX :
+					prev_range->end.ns_from_origin);
+			ret = -1;
+			goto end;
+		}
+	}
+
+end:
+	return ret;
+}
+
 static
 enum bt_param_validation_status validate_bound_type(
 		const bt_value *value,
@@ -524,14 +650,78 @@ enum bt_param_validation_status validate_bound_type(
 	return status;
 }
 
+static
+struct bt_param_validation_map_value_entry_descr trimmer_range_params[] = {
+	{ "begin", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .validation_func = validate_bound_type } },
+	{ "end", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .validation_func = validate_bound_type } },
+	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
+};
+
+static
+const struct bt_param_validation_value_descr trimmer_range_descr = {
+	.type = BT_VALUE_TYPE_MAP,
+	.map = { .entries = trimmer_range_params },
+};
+
 static
 struct bt_param_validation_map_value_entry_descr trimmer_params[] = {
 	{ "gmt", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_BOOL } },
 	{ "begin", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .validation_func = validate_bound_type } },
 	{ "end", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .validation_func = validate_bound_type } },
+	{ "ranges", BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_OPTIONAL, { .type = BT_VALUE_TYPE_ARRAY, .array = {
+		.min_length = 1,
+		.max_length = BT_PARAM_VALIDATION_INFINITE,
+		.element_type = &trimmer_range_descr,
+	} } },
 	BT_PARAM_VALIDATION_MAP_VALUE_ENTRY_END
 };
 
+/*
+ * Appends a trimming range to the trimming ranges of `trimmer_comp`
+ * from the `begin` and `end` entries of the map value `map`.
+ *
+ * Returns a negative value if anything goes wrong.
+ */
+static
+int append_range_from_param(struct trimmer_comp *trimmer_comp,
+		const bt_value *map)
+{
+	struct trimmer_range range = {0};
+	const bt_value *value;
+	int ret = 0;
+
+	value = bt_value_map_borrow_entry_value_const(map, "begin");
+	if (value) {
+		/* set_bound_from_param() logs errors */
+		ret = set_bound_from_param(trimmer_comp, value,
+			&range.begin, trimmer_comp->is_gmt);
+		if (ret) {
+			goto end;
+		}
+	} else {
+		range.begin.is_infinite = true;
+		range.begin.is_set = true;
+	}
+
+	value = bt_value_map_borrow_entry_value_const(map, "end");
+	if (value) {
+		/* set_bound_from_param() logs errors */
+		ret = set_bound_from_param(trimmer_comp, value,
+			&range.end, trimmer_comp->is_gmt);
+		if (ret) {
+			goto end;
+		}
+	} else {
+		range.end.is_infinite = true;
+		range.end.is_set = true;
+	}
+
+	g_array_append_val(trimmer_comp->ranges, range);
+
+end:
+	return ret;
+}
+
 static
 bt_component_class_initialize_method_status init_trimmer_comp_from_params(
 		struct trimmer_comp *trimmer_comp,
@@ -560,36 +750,39 @@ bt_component_class_initialize_method_status init_trimmer_comp_from_params(
 		trimmer_comp->is_gmt = (bool) bt_value_bool_get(value);
 	}
 
-        value = bt_value_map_borrow_entry_value_const(params, "begin");
+	value = bt_value_map_borrow_entry_value_const(params, "ranges");
 	if (value) {
-		if (set_bound_from_param(trimmer_comp, value,
-				&trimmer_comp->begin, trimmer_comp->is_gmt)) {
-			/* set_bound_from_param() logs errors */
+		uint64_t i;
+
+		if (bt_value_map_has_entry(params, "begin") ||
+				bt_value_map_has_entry(params, "end")) {
+			BT_COMP_LOGE_APPEND_CAUSE(trimmer_comp->self_comp,
+				"The `ranges` parameter is mutually exclusive with the `begin` and `end` parameters.");
 			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
 			goto end;
 		}
-	} else {
-		trimmer_comp->begin.is_infinite = true;
-		trimmer_comp->begin.is_set = true;
-	}
 
-        value = bt_value_map_borrow_entry_value_const(params, "end");
-	if (value) {
-		if (set_bound_from_param(trimmer_comp, value,
-				&trimmer_comp->end, trimmer_comp->is_gmt)) {
-			/* set_bound_from_param() logs errors */
+		for (i = 0; i < bt_value_array_get_length(value); i++) {
+			/* append_range_from_param() logs errors */
+			if (append_range_from_param(trimmer_comp,
+					bt_value_array_borrow_element_by_index_const(
+						value, i))) {
+				status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
+				goto end;
+			}
+		}
+	} else {
+		/* Single trimming range from the `begin` and `end` parameters */
+		if (append_range_from_param(trimmer_comp, params)) {
 			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
 			goto end;
 		}
-	} else {
-		trimmer_comp->end.is_infinite = true;
-		trimmer_comp->end.is_set = true;
 	}
 
-	if (trimmer_comp->begin.is_set && trimmer_comp->end.is_set) {
-		/* validate_trimmer_bounds() logs errors */
-		if (validate_trimmer_bounds(trimmer_comp,
-			&trimmer_comp->begin, &trimmer_comp->end)) {
+	if (trimmer_ranges_are_set(trimmer_comp->ranges)) {
+		/* validate_trimmer_ranges() logs errors */
+		if (validate_trimmer_ranges(trimmer_comp,
+				trimmer_comp->ranges)) {
 			status = BT_COMPONENT_CLASS_INITIALIZE_METHOD_STATUS_ERROR;
 			goto end;
 		}
@@ -676,6 +869,10 @@ void destroy_trimmer_iterator(struct trimmer_iterator *trimmer_it)
 		g_hash_table_destroy(trimmer_it->stream_states);
 	}
 
+	if (trimmer_it->ranges) {
+		g_array_free(trimmer_it->ranges, TRUE);
+	}
+
 	g_free(trimmer_it);
 end:
 	return;
@@ -687,6 +884,11 @@ void destroy_trimmer_iterator_stream_state(
 {
 	BT_ASSERT(sstate);
 	BT_PACKET_PUT_REF_AND_RESET(sstate->cur_packet);
+
+	if (sstate->is_ended) {
+		bt_stream_put_ref(sstate->stream);
+	}
+
 	g_free(sstate);
 }
 
@@ -711,19 +913,32 @@ bt_message_iterator_class_initialize_method_status trimmer_msg_iter_init(
 	trimmer_it->trimmer_comp = bt_self_component_get_data(self_comp);
 	BT_ASSERT(trimmer_it->trimmer_comp);
 
-	if (trimmer_it->trimmer_comp->begin.is_set &&
-			trimmer_it->trimmer_comp->end.is_set) {
+	if (trimmer_ranges_are_set(trimmer_it->trimmer_comp->ranges)) {
 		/*
-		 * Both trimming time range's bounds are set, so skip
-		 * the
+		 * All the bounds of the trimming time ranges are set,
+		 * so skip the
 		 * `TRIMMER_ITERATOR_STATE_SET_BOUNDS_NS_FROM_ORIGIN`
 		 * phase.
 		 */
 		trimmer_it->state = TRIMMER_ITERATOR_STATE_SEEK_INITIALLY;
 	}
 
-	trimmer_it->begin = trimmer_it->trimmer_comp->begin;
-	trimmer_it->end = trimmer_it->trimmer_comp->end;
+	trimmer_it->ranges = g_array_sized_new(FALSE, TRUE,
+		sizeof(struct trimmer_range),
+		trimmer_it->trimmer_comp->ranges->len);
+	if (!trimmer_it->ranges) {
+		status = BT_MESSAGE_ITERATOR_CLASS_INITIALIZE_METHOD_STATUS_MEMORY_ERROR;
+		goto error;
+	}
+
+	g_array_append_vals(trimmer_it->ranges,
+		trimmer_it->trimmer_comp->ranges->data,
+		trimmer_it->trimmer_comp->ranges->len);
+	BT_ASSERT(trimmer_it->ranges->len > 0);
+	trimmer_it->begin = g_array_index(trimmer_it->ranges,
+		struct trimmer_range, 0).begin;
+	trimmer_it->end = g_array_index(trimmer_it->ranges,
+		struct trimmer_range, 0).end;
 	msg_iter_status =
 		bt_message_iterator_create_from_message_iterator(
 			self_msg_iter,
@@ -971,8 +1186,7 @@ state_set_trimmer_iterator_bounds(
 	uint64_t i;
 	int ret;
 
-	BT_ASSERT(!trimmer_it->begin.is_set ||
-		!trimmer_it->end.is_set);
+	BT_ASSERT(!trimmer_ranges_are_set(trimmer_it->ranges));
 
 	while (true) {
 		upstream_iter_status =
@@ -1005,30 +1219,42 @@ state_set_trimmer_iterator_bounds(
 	}
 
 found:
-	if (!trimmer_it->begin.is_set) {
-		BT_ASSERT(!trimmer_it->begin.is_infinite);
-		ret = set_trimmer_iterator_bound(trimmer_it, &trimmer_it->begin,
-			ns_from_origin, trimmer_comp->is_gmt);
-		if (ret) {
-			goto error;
+	for (i = 0; i < trimmer_it->ranges->len; i++) {
+		struct trimmer_range *range = &g_array_index(
+			trimmer_it->ranges, struct trimmer_range, i);
+
+		if (!range->begin.is_set) {
+			BT_ASSERT(!range->begin.is_infinite);
+			ret = set_trimmer_iterator_bound(trimmer_it,
+				&range->begin, ns_from_origin,
+				trimmer_comp->is_gmt);
+			if (ret) {
+				goto error;
+			}
 		}
-	}
 
-	if (!trimmer_it->end.is_set) {
-		BT_ASSERT(!trimmer_it->end.is_infinite);
-		ret = set_trimmer_iterator_bound(trimmer_it, &trimmer_it->end,
-			ns_from_origin, trimmer_comp->is_gmt);
-		if (ret) {
-			goto error;
+		if (!range->end.is_set) {
+			BT_ASSERT(!range->end.is_infinite);
+			ret = set_trimmer_iterator_bound(trimmer_it,
+				&range->end, ns_from_origin,
+				trimmer_comp->is_gmt);
+			if (ret) {
+				goto error;
+			}
 		}
 	}
 
-	ret = validate_trimmer_bounds(trimmer_it->trimmer_comp,
-		&trimmer_it->begin, &trimmer_it->end);
+	ret = validate_trimmer_ranges(trimmer_it->trimmer_comp,
+		trimmer_it->ranges);
 	if (ret) {
 		goto error;
 	}
 
+	BT_ASSERT(trimmer_it->cur_range_index == 0);
+	trimmer_it->begin = g_array_index(trimmer_it->ranges,
+		struct trimmer_range, 0).begin;
+	trimmer_it->end = g_array_index(trimmer_it->ranges,
+		struct trimmer_range, 0).end;
 	goto end;
 
 error:
@@ -1250,6 +1476,11 @@ bt_message_iterator_class_next_method_status end_iterator_streams(
 	g_hash_table_iter_init(&iter, trimmer_it->stream_states);
 
 	while (g_hash_table_iter_next(&iter, &key, &sstate)) {
+		if (((struct trimmer_iterator_stream_state *) sstate)->is_ended) {
+			/* Already ended within a previous trimming range */
+			continue;
+		}
+
 		status = end_stream(trimmer_it, sstate);
 		if (status) {
 			goto end;
@@ -1263,6 +1494,107 @@ end:
 	return status;
 }
 
+static inline
+bool is_last_range(struct trimmer_iterator *trimmer_it)
+{
+	return trimmer_it->cur_range_index + 1 == trimmer_it->ranges->len;
+}
+
+/*
+ * Ends the current packet of each stream which has one, making the
+ * time of each packet end message the current trimming range's end
+ * time.
+ *
+ * Unlike end_iterator_streams(), this function keeps the streams
+ * alive: the next trimming range continues them.
+ */
+static
+bt_message_iterator_class_next_method_status end_iterator_packets(
+		struct trimmer_iterator *trimmer_it)
+{
+	bt_message_iterator_class_next_method_status status =
+		BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK;
+	GHashTableIter iter;
+	gpointer key, value;
+
+	BT_ASSERT(!trimmer_it->end.is_infinite);
+	g_hash_table_iter_init(&iter, trimmer_it->stream_states);
+
+	while (g_hash_table_iter_next(&iter, &key, &value)) {
+		struct trimmer_iterator_stream_state *sstate = value;
+		const bt_clock_class *clock_class;
+		uint64_t raw_value;
+		bt_message *msg;
+
+		if (!sstate->cur_packet) {
+			continue;
+		}
+
+		/* See the comment in end_stream() */
+		BT_ASSERT(sstate->seen_clock_snapshot);
+		clock_class = bt_stream_class_borrow_default_clock_class_const(
+			bt_stream_borrow_class_const(sstate->stream));
+		BT_ASSERT(clock_class);
+
+		if (clock_raw_value_from_ns_from_origin(clock_class,
+				trimmer_it->end.ns_from_origin, &raw_value)) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_ERROR;
+			goto end;
+		}
+
+		msg = bt_message_packet_end_create_with_default_clock_snapshot(
+			trimmer_it->self_msg_iter, sstate->cur_packet,
+			raw_value);
+		if (!msg) {
+			status = BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_MEMORY_ERROR;
+			goto end;
+		}
+
+		push_message(trimmer_it, msg);
+		BT_PACKET_PUT_REF_AND_RESET(sstate->cur_packet);
+	}
+
+end:
+	return status;
+}
+
+/*
+ * Ends the current trimming range.
+ *
+ * If it's the last one, this function ends all the streams (see
+ * end_iterator_streams()). Otherwise, it only ends the current packets
+ * (see end_iterator_packets()), makes the next trimming range the
+ * current one, and sets the state of the iterator so as to seek its
+ * beginning time.
+ */
+static
+bt_message_iterator_class_next_method_status end_current_range(
+		struct trimmer_iterator *trimmer_it)
+{
+	bt_message_iterator_class_next_method_status status;
+	const struct trimmer_range *next_range;
+
+	if (is_last_range(trimmer_it)) {
+		status = end_iterator_streams(trimmer_it);
+		goto end;
+	}
+
+	status = end_iterator_packets(trimmer_it);
+	if (status != BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+		goto end;
+	}
+
+	trimmer_it->cur_range_index++;
+	next_range = &g_array_index(trimmer_it->ranges, struct trimmer_range,
+		trimmer_it->cur_range_index);
+	trimmer_it->begin = next_range->begin;
+	trimmer_it->end = next_range->end;
+	trimmer_it->state = TRIMMER_ITERATOR_STATE_SEEK_INITIALLY;
+
+end:
+	return status;
+}
+
 static
 bt_message_iterator_class_next_method_status
 create_stream_state_entry(
@@ -1430,6 +1762,22 @@ handle_message_with_stream(
 	 */
 	if (msg_type != BT_MESSAGE_TYPE_STREAM_BEGINNING) {
 		sstate = get_stream_state_entry(trimmer_it, stream);
+	} else {
+		/*
+		 * Still look for an existing stream state: after having
+		 * sought the beginning of a trimming range which isn't
+		 * the first one, the upstream message iterator begins
+		 * again the streams which this iterator continues.
+		 */
+		sstate = g_hash_table_lookup(trimmer_it->stream_states, stream);
+	}
+
+	if (G_UNLIKELY(sstate && sstate->is_ended)) {
+		/*
+		 * This stream ended within a previous trimming range:
+		 * drop any message of it.
+		 */
+		goto end;
 	}
 
 	switch (msg_type) {
@@ -1443,7 +1791,7 @@ handle_message_with_stream(
 
 		if (G_UNLIKELY(!trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
@@ -1465,7 +1813,7 @@ handle_message_with_stream(
 
 		if (G_UNLIKELY(!trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
@@ -1491,7 +1839,7 @@ handle_message_with_stream(
 
 		if (G_UNLIKELY(!trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
@@ -1545,7 +1893,7 @@ handle_message_with_stream(
 
 		if (!trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
@@ -1612,11 +1960,20 @@ handle_message_with_stream(
 		 */
 		if (G_UNLIKELY(ns_from_origin && !trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
 
+		if (sstate) {
+			/*
+			 * This stream began within a previous trimming
+			 * range and continues: drop this redundant
+			 * message.
+			 */
+			break;
+		}
+
 		/* Learn about this stream. */
 		status = create_stream_state_entry(trimmer_it, stream, &sstate);
 		if (status != BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
@@ -1640,7 +1997,7 @@ handle_message_with_stream(
 		 */
 		if (G_UNLIKELY(ns_from_origin && !trimmer_it->end.is_infinite &&
 				*ns_from_origin > trimmer_it->end.ns_from_origin)) {
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 			break;
 		}
@@ -1653,6 +2010,21 @@ handle_message_with_stream(
 		push_message(trimmer_it, msg);
 		msg = NULL;
 
+		if (!is_last_range(trimmer_it)) {
+			/*
+			 * Remember that this stream is ended in case the
+			 * upstream message iterator begins it again after
+			 * seeking the beginning of the next trimming
+			 * range.
+			 *
+			 * Keep a strong reference so that no other stream
+			 * may get allocated at the same address.
+			 */
+			bt_stream_get_ref(sstate->stream);
+			sstate->is_ended = true;
+			break;
+		}
+
 		/* Forget about this stream. */
 		removed = g_hash_table_remove(trimmer_it->stream_states, sstate->stream);
 		BT_ASSERT(removed);
@@ -1745,7 +2117,7 @@ bt_message_iterator_class_next_method_status handle_message(
 		 */
 		if (G_UNLIKELY(ns_from_origin > trimmer_it->end.ns_from_origin)) {
 			BT_MESSAGE_PUT_REF_AND_RESET(msg);
-			status = end_iterator_streams(trimmer_it);
+			status = end_current_range(trimmer_it);
 			*reached_end = true;
 		} else {
 			push_message(trimmer_it, msg);
@@ -1853,6 +2225,34 @@ state_trim(struct trimmer_iterator *trimmer_it,
 			}
 
 			if (G_UNLIKELY(reached_end)) {
+				put_messages(my_msgs, my_count);
+
+				if (trimmer_it->state ==
+						TRIMMER_ITERATOR_STATE_SEEK_INITIALLY) {
+					/*
+					 * This message's time was past
+					 * the end time of a trimming
+					 * time range which isn't the
+					 * last one: seek the beginning
+					 * of the next one (now the
+					 * current one) and continue.
+					 *
+					 * The output message queue
+					 * keeps the packet end messages
+					 * of the previous trimming range
+					 * in front of the next
+					 * messages.
+					 */
+					status = state_seek_initially(
+						trimmer_it);
+					if (status != BT_MESSAGE_ITERATOR_CLASS_NEXT_METHOD_STATUS_OK) {
+						goto end;
+					}
+
+					reached_end = false;
+					break;
+				}
+
 				/*
 				 * This message's time was passed the
 				 * trimming time range's end time: we
@@ -1863,7 +2263,6 @@ state_trim(struct trimmer_iterator *trimmer_it,
 				 * state_trim() is called within the
 				 * "next" method.
 				 */
-				put_messages(my_msgs, my_count);
 				trimmer_it->state =
 					TRIMMER_ITERATOR_STATE_ENDING;
 				status = state_ending(trimmer_it, msgs,
@@ -0,0 +1,612 @@
+# Copyright (c) 2026 Analog Devices, Inc.
+# Copyright (c) 2026 Antmicro <www.antmicro.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Synthetic CTF 1 and CTF 2 trace generator for the benchmark suite.
+
+Each scenario targets a specific hot path of the `src.ctf.fs` decoder
+(and, downstream, of the muxer and of the sinks):
+
+`flat-ints`
+    Events with only fixed-length integer fields.
+
+`strings`
+    Events with mostly null-terminated string fields.
+
+`variants`
+    Events with a variant field (and, with CTF 2, optional fields).
+
+`varints`
+    Events with variable-length (LEB128) integer fields (CTF 2 only).
+
+`many-streams`
+    Flat integer events spread over many data streams.
+
+`small-packets`
+    Flat integer events in many packets containing a few events each.
+
+`large-metadata`
+    A few flat integer events, but thousands of event record classes:
+    use it with the `init` pipeline of `run_bench.py` to measure the
+    metadata stream parsing time.
+
+The generator writes a `scenarios.json` manifest in the output
+directory which records, for each generated trace, its CTF version,
+path, event count, and data size: `run_bench.py` reads it to compute
+throughputs.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import struct
+import sys
+import uuid as uuidlib
+
+_MAGIC = 0xC1FC1FC1
+_TS_STEP = 100
+
+# Dynamic scope sizes (bytes): both versions use the same layout.
+_PKT_HEADER = struct.Struct("<I16sIQ")
+_PKT_CTX = struct.Struct("<QQQQQ")
+_EV_HEADER = struct.Struct("<IQ")
+_FLAT = struct.Struct("<BHIQbhiq")
+
+_STRINGS = [
+    b"lorem",
+    b"ipsum dolor sit amet",
+    b"consectetur adipiscing elit, sed do eiusmod tempor",
+    b"incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam",
+    b"quis",
+    b"nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo",
+]
+
+
+def _leb128(value: int) -> bytes:
+    out = bytearray()
+
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _sleb128(value: int) -> bytes:
+    out = bytearray()
+
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+
+        if (value == 0 and not byte & 0x40) or (value == -1 and byte & 0x40):
+            out.append(byte)
+            return bytes(out)
+
+        out.append(byte | 0x80)
+
+
+# Payload builders: index -> payload bytes.
+#
+# Each builder only depends on `index`, so that the generator can
+# precompute a cycle of distinct payloads instead of packing each
+# event.
+
+
+def _flat_payload(i: int) -> bytes:
+    return _FLAT.pack(
+        i & 0xFF,
+        i & 0xFFFF,
+        (i * 2654435761) & 0xFFFFFFFF,
+        i * 11400714819323198485 & 0xFFFFFFFFFFFFFFFF,
+        -(i & 0x7F),
+        -(i & 0x7FFF),
+        -(i & 0x7FFFFFFF),
+        -i,
+    )
+
+
+def _strings_payload(i: int) -> bytes:
+    n = len(_STRINGS)
+    parts = [_STRINGS[(i + k) % n] + b"\0" for k in range(4)]
+    return struct.pack("<I", i & 0xFFFFFFFF) + b"".join(parts)
+
+
+def _variant_payload(i: int, with_optionals: bool) -> bytes:
+    tag = i % 3
+
+    if tag == 0:
+        opt = struct.pack("<q", -i)
+    elif tag == 1:
+        opt = _STRINGS[i % len(_STRINGS)] + b"\0"
+    else:
+        opt = struct.pack("<d", i / 7.0)
+
+    out = struct.pack("<B", tag) + opt
+
+    if with_optionals:
+        has = i % 2
+        out += struct.pack("<B", has)
+
+        if has:
+            out += struct.pack("<I", i & 0xFFFFFFFF)
+
+        has = (i // 2) % 2
+        out += struct.pack("<B", has)
+
+        if has:
+            out += _STRINGS[i % len(_STRINGS)] + b"\0"
+
+    return out
+
+
+def _varints_payload(i: int) -> bytes:
+    return (
+        _leb128(i & 0x7F)
+        + _leb128(i * 131)
+        + _leb128(i * 2654435761)
+        + _leb128((i * 11400714819323198485) & 0xFFFFFFFFFFFFFFFF)
+        + _sleb128(-i)
+        + _sleb128(i * 40503 - 2**31)
+    )
+
+
+def _tsdl_int(size: int, signed: bool) -> str:
+    return "integer {{ size = {}; align = 8; signed = {}; }}".format(
+        size, "true" if signed else "false"
+    )
+
+
+def _ctf2_int(size: int, signed: bool, roles=None) -> dict:
+    fc = {
+        "type": "fixed-length-{}-integer".format("signed" if signed else "unsigned"),
+        "length": size,
+        "byte-order": "little-endian",
+        "alignment": 8,
+    }
+
+    if roles:
+        fc["roles"] = roles
+
+    return fc
+
+
+_CTF2_STR = {"type": "null-terminated-string"}
+
+
+# Payload members, as `(name, TSDL declaration, CTF 2 field class)`
+# tuples (no TSDL declaration for CTF 2-only members).
+
+
+def _flat_members():
+    names = ["u8", "u16", "u32", "u64", "s8", "s16", "s32", "s64"]
+    sizes = [8, 16, 32, 64] * 2
+    signs = [False] * 4 + [True] * 4
+    return [
+        (n, _tsdl_int(sz, sg) + " " + n + ";", _ctf2_int(sz, sg))
+        for n, sz, sg in zip(names, sizes, signs)
+    ]
+
+
+def _strings_members():
+    members = [("seq", _tsdl_int(32, False) + " seq;", _ctf2_int(32, False))]
+    members += [
+        ("s{}".format(k), "string s{};".format(k), _CTF2_STR) for k in range(4)
+    ]
+    return members
+
+
+def _variant_members(with_optionals: bool):
+    tsdl_tag = "enum : {} {{ INT = 0, STR = 1, DBL = 2 }} tag;".format(
+        _tsdl_int(8, False)
+    )
+    tsdl_var = (
+        "variant <tag> {{ {} INT; string STR; "
+        "floating_point {{ exp_dig = 11; mant_dig = 53; align = 8; }} DBL; }} v;"
+    ).format(_tsdl_int(64, True))
+    ctf2_var = {
+        "type": "variant",
+        "selector-field-location": {"origin": "event-record-payload", "path": ["tag"]},
+        "options": [
+            {
+                "name": "INT",
+                "selector-field-ranges": [[0, 0]],
+                "field-class": _ctf2_int(64, True),
+            },
+            {
+                "name": "STR",
+                "selector-field-ranges": [[1, 1]],
+                "field-class": _CTF2_STR,
+            },
+            {
+                "name": "DBL",
+                "selector-field-ranges": [[2, 2]],
+                "field-class": {
+                    "type": "fixed-length-floating-point-number",
+                    "length": 64,
+                    "byte-order": "little-endian",
+                    "alignment": 8,
+                },
+            },
+        ],
+    }
+    members = [
+        ("tag", tsdl_tag, _ctf2_int(8, False)),
+        ("v", tsdl_var, ctf2_var),
+    ]
+
+    if with_optionals:
+        for has, name, fc in (
+            ("has_opt_int", "opt_int", _ctf2_int(32, False)),
+            ("has_opt_str", "opt_str", _CTF2_STR),
+        ):
+            members.append(
+                (
+                    has,
+                    None,
+                    {
+                        "type": "fixed-length-boolean",
+                        "length": 8,
+                        "byte-order": "little-endian",
+                        "alignment": 8,
+                    },
+                )
+            )
+            members.append(
+                (
+                    name,
+                    None,
+                    {
+                        "type": "optional",
+                        "selector-field-location": {
+                            "origin": "event-record-payload",
+                            "path": [has],
+                        },
+                        "field-class": fc,
+                    },
+                )
+            )
+
+    return members
+
+
+def _varints_members():
+    return [
+        (n, None, {"type": "variable-length-{}-integer".format(t)})
+        for n, t in (
+            ("v7", "unsigned"),
+            ("v14", "unsigned"),
+            ("v35", "unsigned"),
+            ("v64", "unsigned"),
+            ("sv_small", "signed"),
+            ("sv_large", "signed"),
+        )
+    ]
+
+
+class _Scenario:
+    def __init__(
+        self,
+        name,
+        members,
+        payload,
+        stream_count=1,
+        events_per_packet=1024,
+        ctf_versions=(1, 2),
+        event_class_count=1,
+        max_event_count=None,
+    ):
+        self.name = name
+        self.members = members
+        self.payload = payload
+        self.stream_count = stream_count
+        self.events_per_packet = events_per_packet
+        self.ctf_versions = ctf_versions
+        self.event_class_count = event_class_count
+        self.max_event_count = max_event_count
+
+
+def _scenarios():
+    return [
+        _Scenario("flat-ints", lambda v: _flat_members(), lambda v: _flat_payload),
+        _Scenario("strings", lambda v: _strings_members(), lambda v: _strings_payload),
+        _Scenario(
+            "variants",
+            lambda v: _variant_members(v == 2),
+            lambda v: lambda i: _variant_payload(i, v == 2),
+        ),
+        _Scenario(
+            "varints",
+            lambda v: _varints_members(),
+            lambda v: _varints_payload,
+            ctf_versions=(2,),
+        ),
+        _Scenario(
+            "many-streams",
+            lambda v: _flat_members(),
+            lambda v: _flat_payload,
+            stream_count=256,
+        ),
+        _Scenario(
+            "small-packets",
+            lambda v: _flat_members(),
+            lambda v: _flat_payload,
+            events_per_packet=4,
+        ),
+        _Scenario(
+            "large-metadata",
+            lambda v: _flat_members(),
+            lambda v: _flat_payload,
+            event_class_count=5000,
+            max_event_count=10000,
+        ),
+    ]
+
+
+def _tsdl_metadata(trace_uuid: uuidlib.UUID, members, event_class_count) -> str:
+    fields = "\n\t\t".join(decl for _, decl, _ in members)
+    events = "".join(
+        """
+event {{
+	name = "bench_{id}";
+	id = {id};
+	stream_id = 0;
+	fields := struct {{
+		{fields}
+	}};
+}};
+""".format(
+            id=i, fields=fields
+        )
+        for i in range(event_class_count)
+    )
+    return """/* CTF 1.8 */
+
+trace {{
+	major = 1;
+	minor = 8;
+	byte_order = le;
+	uuid = "{uuid}";
+	packet.header := struct {{
+		{u32} magic;
+		{u8} uuid[16];
+		{u32} stream_id;
+		{u64} stream_instance_id;
+	}};
+}};
+
+clock {{
+	name = "default";
+	uuid = "{uuid}";
+	freq = 1000000000;
+	offset = 0;
+}};
+
+typealias integer {{ size = 64; align = 8; signed = false; map = clock.default.value; }} := uint64_clock_t;
+
+stream {{
+	id = 0;
+	packet.context := struct {{
+		uint64_clock_t timestamp_begin;
+		uint64_clock_t timestamp_end;
+		{u64} content_size;
+		{u64} packet_size;
+		{u64} packet_seq_num;
+	}};
+	event.header := struct {{
+		{u32} id;
+		uint64_clock_t timestamp;
+	}};
+}};
+""".format(
+        uuid=str(trace_uuid),
+        u8=_tsdl_int(8, False),
+        u32=_tsdl_int(32, False),
+        u64=_tsdl_int(64, False),
+    ) + events
+
+
+def _ctf2_metadata(trace_uuid: uuidlib.UUID, members, event_class_count) -> str:
+    def member(name, fc):
+        return {"name": name, "field-class": fc}
+
+    fragments = [
+        {"type": "preamble", "version": 2, "uuid": list(trace_uuid.bytes)},
+        {
+            "type": "trace-class",
+            "packet-header-field-class": {
+                "type": "structure",
+                "member-classes": [
+                    member("magic", _ctf2_int(32, False, ["packet-magic-number"])),
+                    member(
+                        "uuid",
+                        {
+                            "type": "static-length-blob",
+                            "length": 16,
+                            "roles": ["metadata-stream-uuid"],
+                        },
+                    ),
+                    member("stream_id", _ctf2_int(32, False, ["data-stream-class-id"])),
+                    member(
+                        "stream_instance_id", _ctf2_int(64, False, ["data-stream-id"])
+                    ),
+                ],
+            },
+        },
+        {
+            "type": "clock-class",
+            "id": "default",
+            "name": "default",
+            "frequency": 1000000000,
+            "uuid": list(trace_uuid.bytes),
+        },
+        {
+            "type": "data-stream-class",
+            "id": 0,
+            "default-clock-class-id": "default",
+            "packet-context-field-class": {
+                "type": "structure",
+                "member-classes": [
+                    member(
+                        "timestamp_begin",
+                        _ctf2_int(64, False, ["default-clock-timestamp"]),
+                    ),
+                    member(
+                        "timestamp_end",
+                        _ctf2_int(64, False, ["packet-end-default-clock-timestamp"]),
+                    ),
+                    member(
+                        "content_size",
+                        _ctf2_int(64, False, ["packet-content-length"]),
+                    ),
+                    member("packet_size", _ctf2_int(64, False, ["packet-total-length"])),
+                    member(
+                        "packet_seq_num",
+                        _ctf2_int(64, False, ["packet-sequence-number"]),
+                    ),
+                ],
+            },
+            "event-record-header-field-class": {
+                "type": "structure",
+                "member-classes": [
+                    member("id", _ctf2_int(32, False, ["event-record-class-id"])),
+                    member(
+                        "timestamp", _ctf2_int(64, False, ["default-clock-timestamp"])
+                    ),
+                ],
+            },
+        },
+    ]
+    payload_fc = {
+        "type": "structure",
+        "member-classes": [member(name, fc) for name, _, fc in members],
+    }
+    fragments += [
+        {
+            "type": "event-record-class",
+            "id": i,
+            "data-stream-class-id": 0,
+            "name": "bench_{}".format(i),
+            "payload-field-class": payload_fc,
+        }
+        for i in range(event_class_count)
+    ]
+
+    # Compact, like the metadata streams of LTTng
+    return "".join("\x1e" + json.dumps(f) + "\n" for f in fragments)
+
+
+def _write_streams(path, trace_uuid, scenario, payload, event_count):
+    # Cycle through a fixed set of distinct payloads: packing each
+    # event in Python would dominate the generation time.
+    cycle = [payload(i) for i in range(min(event_count, 997))]
+    epp = scenario.events_per_packet
+    streams = scenario.stream_count
+    per_stream = (event_count + streams - 1) // streams
+    size = 0
+
+    for s in range(streams):
+        with open(os.path.join(path, "stream_{}".format(s)), "wb") as f:
+            seq = 0
+
+            for first in range(0, per_stream, epp):
+                last = min(first + epp, per_stream)
+                body = bytearray()
+
+                for k in range(first, last):
+                    index = k * streams + s
+                    body += _EV_HEADER.pack(
+                        index % scenario.event_class_count, index * _TS_STEP
+                    )
+                    body += cycle[index % len(cycle)]
+
+                ts_begin = (first * streams + s) * _TS_STEP
+                ts_end = ((last - 1) * streams + s) * _TS_STEP
+                total = _PKT_HEADER.size + _PKT_CTX.size + len(body)
+                f.write(_PKT_HEADER.pack(_MAGIC, trace_uuid.bytes, 0, s))
+                f.write(_PKT_CTX.pack(ts_begin, ts_end, total * 8, total * 8, seq))
+                f.write(body)
+                size += total
+                seq += 1
+
+    return per_stream * streams, size
+
+
+def generate(out_dir: str, event_count: int, only=None):
+    manifest = {}
+
+    for scenario in _scenarios():
+        if only and scenario.name not in only:
+            continue
+
+        for version in scenario.ctf_versions:
+            key = "ctf{}/{}".format(version, scenario.name)
+            path = os.path.join(out_dir, "ctf{}".format(version), scenario.name)
+            shutil.rmtree(path, ignore_errors=True)
+            os.makedirs(path)
+            trace_uuid = uuidlib.uuid5(uuidlib.NAMESPACE_URL, "bt2-bench:" + key)
+            members = scenario.members(version)
+
+            if version == 1:
+                metadata = _tsdl_metadata(trace_uuid, members, scenario.event_class_count)
+            else:
+                metadata = _ctf2_metadata(trace_uuid, members, scenario.event_class_count)
+
+            with open(os.path.join(path, "metadata"), "w") as f:
+                f.write(metadata)
+
+            count, size = _write_streams(
+                path,
+                trace_uuid,
+                scenario,
+                scenario.payload(version),
+                min(event_count, scenario.max_event_count or event_count),
+            )
+            manifest[key] = {
+                "ctf-version": version,
+                "scenario": scenario.name,
+                "path": os.path.relpath(path, out_dir),
+                "stream-count": scenario.stream_count,
+                "event-class-count": scenario.event_class_count,
+                "metadata-size-bytes": len(metadata.encode()),
+                "event-count": count,
+                "size-bytes": size,
+            }
+            print("{}: {} events, {} bytes".format(key, count, size), file=sys.stderr)
+
+    with open(os.path.join(out_dir, "scenarios.json"), "w") as f:
+        json.dump(manifest, f, indent=2)
+
+    return manifest
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument("output_dir", help="directory in which to write the traces")
+    parser.add_argument(
+        "-n",
+        "--event-count",
+        type=int,
+        default=500000,
+        help="number of events per trace (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-s",
+        "--scenario",
+        action="append",
+        help="only generate this scenario (repeatable)",
+    )
+    args = parser.parse_args()
+    os.makedirs(args.output_dir, exist_ok=True)
+    generate(args.output_dir, args.event_count, args.scenario)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,269 @@
+# Copyright (c) 2026 Analog Devices, Inc.
+# Copyright (c) 2026 Antmicro <www.antmicro.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Benchmark of in-band metadata stream appends of `source.ctf.live`.
+
+Starts a `source.ctf.live` component with in-band metadata, connects
+to it as a TCP client, and sends one empty data packet so that the
+data stream starts. Then sends `--updates` packetized TSDL metadata
+stream packets, each one adding `--batch` event record classes to the
+single data stream class, and measures, for each one, the time until
+the new event record classes are part of the trace IR stream class.
+
+Each section only holds new event record classes: the cost of an
+update must stay constant as the whole metadata stream grows. Compare
+the `first-median` and `last-median` latencies of the report.
+
+Prints a JSON report to the standard output (or to the file of
+`--output`) containing, for each update, the total metadata stream
+size, the total count of event record classes, and the latency, as
+well as the median latencies of the first and last tenths of the
+updates.
+"""
+
+import argparse
+import json
+import shutil
+import socket
+import statistics
+import struct
+import sys
+import tempfile
+import time
+import uuid
+
+import bt2
+
+_PKT_MAGIC = 0xC1FC1FC1
+_METADATA_PKT_MAGIC = 0x75D11D57
+
+
+def _tsdl_preamble(trace_uuid):
+    return """/* CTF 1.8 */
+
+typealias integer {{ size = 8; align = 8; signed = false; }} := uint8_t;
+typealias integer {{ size = 32; align = 8; signed = false; }} := uint32_t;
+typealias integer {{ size = 64; align = 8; signed = false; }} := uint64_t;
+
+trace {{
+    major = 1;
+    minor = 8;
+    uuid = "{}";
+    byte_order = le;
+    packet.header := struct {{
+        uint32_t magic;
+        uint8_t uuid[16];
+        uint32_t stream_id;
+    }};
+}};
+
+stream {{
+    id = 0;
+    packet.context := struct {{
+        uint64_t packet_size;
+        uint64_t content_size;
+    }};
+    event.header := struct {{
+        uint32_t id;
+    }};
+}};
+""".format(
+        trace_uuid
+    )
+
+
+def _tsdl_event_record_classes(first_id, count):
+    return "".join(
+        """
+event {{
+    name = "ev-{0}";
+    id = {0};
+    stream_id = 0;
+    fields := struct {{
+        uint32_t a;
+        uint64_t b;
+        string s;
+    }};
+}};
+""".format(
+            first_id + i
+        )
+        for i in range(count)
+    )
+
+
+def _metadata_pkt(trace_uuid, text):
+    # Packetized metadata stream packet header (37 bytes), then text.
+    text = text.encode()
+    size = (37 + len(text)) * 8
+    header = struct.pack(
+        "<I16sIIIBBBBB",
+        _METADATA_PKT_MAGIC,
+        trace_uuid.bytes,
+        0,
+        size,
+        size,
+        0,
+        0,
+        0,
+        1,
+        8,
+    )
+    return header + text
+
+
+def _empty_data_pkt(trace_uuid):
+    size = 40 * 8
+    return struct.pack("<I16sIQQ", _PKT_MAGIC, trace_uuid.bytes, 0, size, size)
+
+
+class _State:
+    def __init__(self):
+        self.stream_cls = None
+
+
+class _Sink(bt2._UserSinkComponent):
+    def __init__(self, config, params, state):
+        self._state = state
+        self._port = self._add_input_port("in")
+
+    def _user_graph_is_configured(self):
+        self._it = self._create_message_iterator(self._port)
+
+    def _user_consume(self):
+        msg = next(self._it)
+
+        if type(msg) is bt2._StreamBeginningMessageConst:
+            self._state.stream_cls = msg.stream.cls
+
+
+def _run_once(graph):
+    try:
+        graph.run_once()
+    except bt2.TryAgain:
+        pass
+
+
+def run(updates, batch, port):
+    ctf = bt2.find_plugin("ctf")
+
+    if ctf is None:
+        raise RuntimeError("Cannot find the `ctf` plugin")
+
+    trace_uuid = uuid.uuid4()
+    metadata_dir = tempfile.mkdtemp(prefix="bt2-bench-")
+
+    try:
+        # Initial metadata stream: the data stream class and one event
+        # record class, so that the data stream class has a port.
+        metadata = _metadata_pkt(
+            trace_uuid, _tsdl_preamble(trace_uuid) + _tsdl_event_record_classes(0, 1)
+        )
+
+        with open("{}/metadata".format(metadata_dir), "wb") as f:
+            f.write(metadata)
+
+        metadata_size = len(metadata)
+        state = _State()
+        graph = bt2.Graph(0)
+        src = graph.add_component(
+            ctf.source_component_classes["live"],
+            "src",
+            {
+                "transport": "tcp",
+                "port": port,
+                "metadata-path": metadata_dir,
+                "inband-metadata": True,
+                "inactivity-timeout-ms": 1,
+            },
+        )
+        sink = graph.add_component(_Sink, "sink", obj=state)
+        graph.connect_ports(src.output_ports["out0"], sink.input_ports["in"])
+        client = socket.create_connection(("127.0.0.1", port))
+
+        try:
+            client.sendall(_empty_data_pkt(trace_uuid))
+
+            while state.stream_cls is None:
+                _run_once(graph)
+
+            results = []
+            ev_cls_count = 1
+
+            for _ in range(updates):
+                pkt = _metadata_pkt(
+                    trace_uuid, _tsdl_event_record_classes(ev_cls_count, batch)
+                )
+                ev_cls_count += batch
+                metadata_size += len(pkt)
+                begin = time.perf_counter()
+                client.sendall(pkt)
+
+                while len(state.stream_cls) < ev_cls_count:
+                    _run_once(graph)
+
+                results.append(
+                    {
+                        "metadata-size": metadata_size,
+                        "event-record-class-count": ev_cls_count,
+                        "latency": time.perf_counter() - begin,
+                    }
+                )
+        finally:
+            client.close()
+    finally:
+        shutil.rmtree(metadata_dir, ignore_errors=True)
+
+    latencies = [r["latency"] for r in results]
+    tenth = max(1, len(latencies) // 10)
+    return {
+        "updates": results,
+        "first-median": statistics.median(latencies[:tenth]),
+        "last-median": statistics.median(latencies[-tenth:]),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument(
+        "-u",
+        "--updates",
+        type=int,
+        default=500,
+        help="number of metadata stream updates (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-b",
+        "--batch",
+        type=int,
+        default=10,
+        help="number of event record classes per update (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-p",
+        "--port",
+        type=int,
+        default=42674,
+        help="TCP port of the source component (default: %(default)s)",
+    )
+    parser.add_argument("-o", "--output", help="write the JSON report to this file")
+    args = parser.parse_args()
+
+    if args.updates < 1 or args.batch < 1:
+        parser.error("expecting at least one update of at least one event record class")
+
+    report = run(args.updates, args.batch, args.port)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
+
+
+if __name__ == "__main__":
+    main()
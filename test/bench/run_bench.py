@@ -0,0 +1,278 @@
+# Copyright (c) 2026 Analog Devices, Inc.
+# Copyright (c) 2026 Antmicro <www.antmicro.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Benchmark runner for the traces which `gen_traces.py` generates.
+
+For each generated trace, builds and runs one trace processing graph
+per pipeline, each one measuring a hot path on top of the decoder:
+
+`init`
+    Only the initialization of the `src.ctf.fs` component, which
+    parses the metadata stream: use it with the `large-metadata`
+    scenario or with `--trace` on real-world traces. Build Babeltrace
+    with `BABELTRACE_CTF_SRC_STATS=1` and pass `--stats` to also get
+    the time and heap growth of each parsing stage.
+
+`decode`
+    `src.ctf.fs` → `flt.utils.muxer` → `sink.utils.dummy`: the CTF
+    decoder (item sequence iterator, message iterator, and file system
+    medium) and, with a single stream, a pass-through muxer.
+
+`fs-sink`
+    `src.ctf.fs` → `flt.utils.muxer` → `sink.ctf.fs`: writing the
+    messages back as a CTF trace of the same version.
+
+`pretty`
+    `src.ctf.fs` → `flt.utils.muxer` → `sink.text.pretty`, writing to
+    the null device: text formatting.
+
+Measure the cost of the muxer by comparing the `decode` results of the
+`many-streams` and `flat-ints` scenarios, which have the same events.
+
+Prints a JSON report to the standard output (or to the file of
+`--output`) containing, for each trace and pipeline, the duration of
+each measured run and the best, median, and mean durations, as well as
+the best event and byte (metadata bytes for the `init` pipeline)
+throughputs, when known.
+"""
+
+import argparse
+import json
+import os
+import shutil
+import statistics
+import sys
+import tempfile
+import time
+
+import bt2
+
+_PIPELINES = ("init", "decode", "fs-sink", "pretty")
+
+
+class _Context:
+    def __init__(self, src_logging_level):
+        self.src_logging_level = src_logging_level
+        self.ctf = bt2.find_plugin("ctf")
+        self.utils = bt2.find_plugin("utils")
+        self.text = bt2.find_plugin("text")
+
+        if self.ctf is None or self.utils is None or self.text is None:
+            raise RuntimeError("Cannot find the `ctf`, `utils`, and `text` plugins")
+
+
+def _add_src(ctx, graph, trace_path):
+    return graph.add_component(
+        ctx.ctf.source_component_classes["fs"],
+        "src",
+        {"inputs": [trace_path]},
+        logging_level=ctx.src_logging_level,
+    )
+
+
+def _build_graph(ctx, pipeline, trace, trace_path, out_dir):
+    graph = bt2.Graph(1 if trace["ctf-version"] == 2 else 0)
+    src = _add_src(ctx, graph, trace_path)
+    mux = graph.add_component(ctx.utils.filter_component_classes["muxer"], "mux")
+
+    if pipeline == "decode":
+        sink = graph.add_component(ctx.utils.sink_component_classes["dummy"], "sink")
+    elif pipeline == "fs-sink":
+        sink = graph.add_component(
+            ctx.ctf.sink_component_classes["fs"],
+            "sink",
+            {
+                "path": out_dir,
+                "assume-single-trace": True,
+                "quiet": True,
+                "ctf-version": str(trace["ctf-version"]),
+            },
+        )
+    else:
+        sink = graph.add_component(
+            ctx.text.sink_component_classes["pretty"], "sink", {"path": os.devnull}
+        )
+
+    for port in list(src.output_ports.values()):
+        # The muxer always has a single unconnected input port.
+        in_port = next(p for p in mux.input_ports.values() if not p.is_connected)
+        graph.connect_ports(port, in_port)
+
+    graph.connect_ports(mux.output_ports["out"], sink.input_ports["in"])
+    return graph
+
+
+def _run_once(ctx, pipeline, trace, trace_path):
+    if pipeline == "init":
+        graph = bt2.Graph(1 if trace["ctf-version"] == 2 else 0)
+        begin = time.perf_counter()
+        _add_src(ctx, graph, trace_path)
+        return time.perf_counter() - begin
+
+    out_dir = tempfile.mkdtemp(prefix="bt2-bench-")
+
+    try:
+        # Only measure the graph run, not the graph creation (which
+        # includes opening the trace and parsing its metadata).
+        graph = _build_graph(ctx, pipeline, trace, trace_path, out_dir)
+        begin = time.perf_counter()
+
+        while True:
+            try:
+                graph.run()
+                break
+            except bt2.TryAgain:
+                pass
+
+        return time.perf_counter() - begin
+    finally:
+        shutil.rmtree(out_dir, ignore_errors=True)
+
+
+def _external_trace(path):
+    # CTF 2 metadata streams start with a record separator
+    with open(os.path.join(path, "metadata"), "rb") as f:
+        version = 2 if f.read(1) == b"\x1e" else 1
+
+    return {
+        "ctf-version": version,
+        "scenario": None,
+        "path": os.path.abspath(path),
+        "metadata-size-bytes": os.path.getsize(os.path.join(path, "metadata")),
+    }
+
+
+def _throughput(trace, key, duration):
+    return trace[key] / duration if key in trace else None
+
+
+def run(
+    trace_dir,
+    pipelines,
+    repetitions,
+    warmups,
+    only=None,
+    extra_traces=(),
+    src_logging_level=bt2.LoggingLevel.NONE,
+):
+    manifest = {}
+
+    if trace_dir is not None:
+        with open(os.path.join(trace_dir, "scenarios.json")) as f:
+            manifest = json.load(f)
+
+    for path in extra_traces:
+        manifest[path] = _external_trace(path)
+
+    ctx = _Context(src_logging_level)
+    results = []
+
+    for key, trace in manifest.items():
+        if only and trace["scenario"] not in only:
+            continue
+
+        trace_path = os.path.join(trace_dir or "", trace["path"])
+
+        for pipeline in pipelines:
+            for _ in range(warmups):
+                _run_once(ctx, pipeline, trace, trace_path)
+
+            durations = [
+                _run_once(ctx, pipeline, trace, trace_path)
+                for _ in range(repetitions)
+            ]
+            best = min(durations)
+            size_key = "metadata-size-bytes" if pipeline == "init" else "size-bytes"
+            result = {
+                "trace": key,
+                "pipeline": pipeline,
+                "event-count": trace.get("event-count"),
+                "durations-s": durations,
+                "best-s": best,
+                "median-s": statistics.median(durations),
+                "mean-s": statistics.mean(durations),
+                "events-per-s": None
+                if pipeline == "init"
+                else _throughput(trace, "event-count", best),
+                "bytes-per-s": _throughput(trace, size_key, best),
+            }
+            results.append(result)
+            print("{} {}: {:.3f} s".format(key, pipeline, best), file=sys.stderr)
+
+    return {"benchmarks": results}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0].strip())
+    parser.add_argument(
+        "trace_dir", nargs="?", help="output directory of `gen_traces.py`"
+    )
+    parser.add_argument(
+        "-t",
+        "--trace",
+        action="append",
+        default=[],
+        help="also benchmark the CTF trace in this directory (repeatable)",
+    )
+    parser.add_argument(
+        "-p",
+        "--pipeline",
+        action="append",
+        choices=_PIPELINES,
+        help="only run this pipeline (repeatable)",
+    )
+    parser.add_argument(
+        "-s",
+        "--scenario",
+        action="append",
+        help="only run the traces of this scenario (repeatable)",
+    )
+    parser.add_argument(
+        "-r",
+        "--repetitions",
+        type=int,
+        default=5,
+        help="number of measured runs (default: %(default)s)",
+    )
+    parser.add_argument(
+        "-w",
+        "--warmups",
+        type=int,
+        default=1,
+        help="number of unmeasured warm-up runs (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--stats",
+        action="store_true",
+        help="make the source components log their statistics (requires a "
+        "build with `BABELTRACE_CTF_SRC_STATS=1`)",
+    )
+    parser.add_argument("-o", "--output", help="write the JSON report to this file")
+    args = parser.parse_args()
+
+    if args.trace_dir is None and not args.trace:
+        parser.error("expecting a trace directory or at least one `--trace` option")
+
+    report = run(
+        args.trace_dir,
+        args.pipeline or _PIPELINES,
+        args.repetitions,
+        args.warmups,
+        args.scenario,
+        args.trace,
+        bt2.LoggingLevel.INFO if args.stats else bt2.LoggingLevel.NONE,
+    )
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,79 @@
+# Copyright (c) 2026 Analog Devices, Inc.
+# Copyright (c) 2026 Antmicro <www.antmicro.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import gc
+
+import bt2
+
+_BATCH_COUNT = 50
+_BATCH_LEN = 64
+
+
+class _Iter(bt2._UserMessageIterator):
+    def __init__(self, config, output_port):
+        self._stream, self._ev_cls = output_port.user_data
+        self._batch_index = 0
+
+    def __next__(self):
+        if self._batch_index == _BATCH_COUNT:
+            raise StopIteration
+
+        msgs = []
+
+        if self._batch_index == 0:
+            msgs.append(self._create_stream_beginning_message(self._stream))
+
+        # Many event messages alive at once: more than the pool keeps
+        msgs += [
+            self._create_event_message(self._ev_cls, self._stream)
+            for _ in range(_BATCH_LEN)
+        ]
+        self._batch_index += 1
+
+        if self._batch_index == _BATCH_COUNT:
+            msgs.append(self._create_stream_end_message(self._stream))
+
+        return msgs
+
+
+class _Src(bt2._UserSourceComponent, message_iterator_class=_Iter):
+    def __init__(self, config, params, obj):
+        tc = self._create_trace_class()
+        sc = tc.create_stream_class()
+        ev_cls = sc.create_event_class(name="ev")
+        self._add_output_port("out", (tc().create_stream(sc), ev_cls))
+
+
+class _Sink(bt2._UserSinkComponent):
+    def __init__(self, config, params, counts):
+        self._counts = counts
+        self._port = self._add_input_port("in")
+
+    def _user_graph_is_configured(self):
+        self._it = self._create_message_iterator(self._port)
+
+    def _user_consume(self):
+        msg = next(self._it)
+
+        if type(msg) is bt2._EventMessageConst:
+            self._counts[0] += 1
+
+
+def test_graph_past_msg_pool_max_size(monkeypatch):
+    # Makes the event message pool destroy most of the recycled
+    # messages while the graph is alive.
+    monkeypatch.setenv("LIBBABELTRACE2_MSG_POOL_MAX_SIZE", "2")
+    counts = [0]
+    graph = bt2.Graph(0)
+    src = graph.add_component(_Src, "src")
+    sink = graph.add_component(_Sink, "sink", obj=counts)
+    graph.connect_ports(src.output_ports["out"], sink.input_ports["in"])
+    graph.run()
+    assert counts[0] == _BATCH_COUNT * _BATCH_LEN
+
+    # Destroying the graph unlinks the messages it still knows about:
+    # none of them may be a destroyed one.
+    del graph, src, sink
+    gc.collect()
@@ -0,0 +1,104 @@
+# Copyright (c) 2026 Analog Devices, Inc.
+# Copyright (c) 2026 Antmicro <www.antmicro.com>
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import time
+
+import bt2
+
+_EVENT_COUNT = 100
+_REORDER_WINDOW_NS = 50 * 1000 * 1000
+_TIMEOUT_S = 10
+
+
+class _QuietIter(bt2._UserMessageIterator):
+    def __init__(self, config, output_port):
+        pass
+
+    def __next__(self):
+        raise bt2.TryAgain
+
+
+class _QuietSrc(bt2._UserSourceComponent, message_iterator_class=_QuietIter):
+    def __init__(self, config, params, obj):
+        self._add_output_port("out")
+
+
+class _ActiveIter(bt2._UserMessageIterator):
+    def __init__(self, config, output_port):
+        self._stream, self._ev_cls = output_port.user_data
+        self._sent = False
+
+    def __next__(self):
+        if self._sent:
+            # Live stream without any new message (yet)
+            raise bt2.TryAgain
+
+        self._sent = True
+        msgs = [self._create_stream_beginning_message(self._stream, 0)]
+
+        # All within the reorder window
+        for ts in range(1, _EVENT_COUNT + 1):
+            msgs.append(self._create_event_message(self._ev_cls, self._stream, ts))
+
+        return msgs
+
+
+class _ActiveSrc(bt2._UserSourceComponent, message_iterator_class=_ActiveIter):
+    def __init__(self, config, params, obj):
+        tc = self._create_trace_class()
+        cc = self._create_clock_class(frequency=1000000000)
+        sc = tc.create_stream_class(default_clock_class=cc)
+        ev_cls = sc.create_event_class(name="ev")
+        self._add_output_port("out", (tc().create_stream(sc), ev_cls))
+
+
+class _Sink(bt2._UserSinkComponent):
+    def __init__(self, config, params, event_tss):
+        self._event_tss = event_tss
+        self._port = self._add_input_port("in")
+
+    def _user_graph_is_configured(self):
+        self._it = self._create_message_iterator(self._port)
+
+    def _user_consume(self):
+        msg = next(self._it)
+
+        if type(msg) is bt2._EventMessageConst:
+            self._event_tss.append(msg.default_clock_snapshot.value)
+
+
+def test_quiet_and_active_upstreams():
+    utils = bt2.find_plugin("utils")
+    assert utils is not None
+
+    event_tss = []
+    graph = bt2.Graph(0)
+    quiet = graph.add_component(_QuietSrc, "quiet")
+    active = graph.add_component(_ActiveSrc, "active")
+    muxer = graph.add_component(
+        utils.filter_component_classes["muxer"],
+        "muxer",
+        {
+            "reorder-window-ns": bt2.UnsignedIntegerValue(_REORDER_WINDOW_NS),
+            "reorder-delay-ms": bt2.UnsignedIntegerValue(0),
+        },
+    )
+    sink = graph.add_component(_Sink, "sink", obj=event_tss)
+    graph.connect_ports(quiet.output_ports["out"], muxer.input_ports["in0"])
+    graph.connect_ports(active.output_ports["out"], muxer.input_ports["in1"])
+    graph.connect_ports(muxer.output_ports["out"], sink.input_ports["in"])
+
+    # The quiet upstream never ends: the active one's messages, which
+    # are all within the reorder window, must still come out once the
+    # window elapses.
+    deadline = time.monotonic() + _TIMEOUT_S
+
+    while len(event_tss) < _EVENT_COUNT and time.monotonic() < deadline:
+        try:
+            graph.run_once()
+        except bt2.TryAgain:
+            time.sleep(0.001)
+
+    assert event_tss == list(range(1, _EVENT_COUNT + 1))